@@ -0,0 +1,70 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "activation.h"
+#include "vmath/vmath.h"
+
+// ReLU, which is cheap enough for LMUL=8
+#define act_relu_def_gen(sew)                                                  \
+  static inline vfloat##sew##m8_t act_relu_f##sew##m8(vfloat##sew##m8_t x,     \
+                                                      size_t vl) {             \
+    return vfmax_vf_f##sew##m8(x, 0, vl);                                      \
+  }
+
+act_relu_def_gen(64);
+act_relu_def_gen(32);
+#ifndef VMATH_NO_F16
+act_relu_def_gen(16);
+#endif
+
+// Strip-mine loop of y = op(x + bias) over the rows, with LMUL lmul. GELU and
+// SiLU keep the temporaries of tanh and sigmoid live, and run with LMUL=2.
+#define act_def_gen(name, DATA_TYPE, sew, lmul, op)                            \
+  void name##_f##sew(DATA_TYPE *y, const DATA_TYPE *x, const DATA_TYPE *bias,  \
+                     uint64_t rows, uint64_t cols) {                           \
+    size_t vl;                                                                 \
+                                                                               \
+    /* Without a bias, the rows are contiguous */                              \
+    if (!bias) {                                                               \
+      cols *= rows;                                                            \
+      rows = 1;                                                                \
+    }                                                                          \
+                                                                               \
+    for (uint64_t r = 0; r < rows; ++r) {                                      \
+      const DATA_TYPE *x_ = x + r * cols;                                      \
+      DATA_TYPE *y_ = y + r * cols;                                            \
+      for (uint64_t c = 0; c < cols; c += vl) {                                \
+        vl = vsetvl_e##sew##lmul(cols - c);                                    \
+        vfloat##sew##lmul##_t t = vle##sew##_v_f##sew##lmul(x_ + c, vl);       \
+        if (bias)                                                              \
+          t = vfadd_vv_f##sew##lmul(                                           \
+              t, vle##sew##_v_f##sew##lmul(bias + c, vl), vl);                 \
+        vse##sew##_v_f##sew##lmul(y_ + c, op##_f##sew##lmul(t, vl), vl);       \
+      }                                                                        \
+    }                                                                          \
+  }
+
+act_def_gen(relu, double, 64, m8, act_relu);
+act_def_gen(gelu, double, 64, m2, vmath_gelu);
+act_def_gen(silu, double, 64, m2, vmath_silu);
+act_def_gen(relu, float, 32, m8, act_relu);
+act_def_gen(gelu, float, 32, m2, vmath_gelu);
+act_def_gen(silu, float, 32, m2, vmath_silu);
+#ifndef VMATH_NO_F16
+act_def_gen(relu, _Float16, 16, m8, act_relu);
+act_def_gen(gelu, _Float16, 16, m2, vmath_gelu);
+act_def_gen(silu, _Float16, 16, m2, vmath_silu);
+#endif
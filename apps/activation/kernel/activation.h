@@ -0,0 +1,49 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Elementwise activations of a rows x cols row-major matrix, in FP64, FP32,
+// and FP16, fused with the addition of a bias along the columns:
+//   relu: y = max(x + bias, 0)
+//   gelu: y = z/2 (1 + tanh(sqrt(2/pi) (z + 0.044715 z^3))), z = x + bias
+//   silu: y = z sigmoid(z), z = x + bias
+// GELU and SiLU come from vmath, in the tier selected by VMATH_FAST. With a
+// NULL bias, the matrix is processed as a single vector of rows * cols
+// elements. y can be x.
+// The GEMMs with the same epilogue are fmatmul_tiled_epilogue() in FP64, which
+// applies it before the stores of C.
+
+#ifndef _ACTIVATION_H_
+#define _ACTIVATION_H_
+
+#include <stdint.h>
+
+#include "riscv_vector.h"
+
+#define act_dec_gen(DATA_TYPE, sew)                                            \
+  void relu_f##sew(DATA_TYPE *y, const DATA_TYPE *x, const DATA_TYPE *bias,    \
+                   uint64_t rows, uint64_t cols);                              \
+  void gelu_f##sew(DATA_TYPE *y, const DATA_TYPE *x, const DATA_TYPE *bias,    \
+                   uint64_t rows, uint64_t cols);                              \
+  void silu_f##sew(DATA_TYPE *y, const DATA_TYPE *x, const DATA_TYPE *bias,    \
+                   uint64_t rows, uint64_t cols);
+
+act_dec_gen(double, 64);
+act_dec_gen(float, 32);
+#ifndef VMATH_NO_F16
+act_dec_gen(_Float16, 16);
+#endif
+
+#endif
@@ -0,0 +1,149 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdint.h>
+#include <string.h>
+
+#include "kernel/activation.h"
+#include "kernel/fmatmul.h"
+#include "runtime.h"
+#include "util.h"
+#include "vcheck.h"
+
+#ifndef SPIKE
+#include "printf.h"
+#else
+#include <stdio.h>
+#endif
+
+#define THRESHOLD_F64 0.000001
+#define THRESHOLD_F32 0.0001
+#define THRESHOLD_F16 0.05
+
+extern uint64_t rows;
+extern uint64_t cols;
+extern uint64_t n;
+
+extern float x32[] __attribute__((aligned(4 * NR_LANES)));
+extern float bias32[] __attribute__((aligned(4 * NR_LANES)));
+extern float y32[] __attribute__((aligned(4 * NR_LANES)));
+extern float gold_relu32[] __attribute__((aligned(4 * NR_LANES)));
+extern float gold_gelu32[] __attribute__((aligned(4 * NR_LANES)));
+extern float gold_silu32[] __attribute__((aligned(4 * NR_LANES)));
+
+extern _Float16 x16[] __attribute__((aligned(4 * NR_LANES)));
+extern _Float16 bias16[] __attribute__((aligned(4 * NR_LANES)));
+extern _Float16 y16[] __attribute__((aligned(4 * NR_LANES)));
+extern _Float16 gold_relu16[] __attribute__((aligned(4 * NR_LANES)));
+extern _Float16 gold_gelu16[] __attribute__((aligned(4 * NR_LANES)));
+extern _Float16 gold_silu16[] __attribute__((aligned(4 * NR_LANES)));
+
+// GEMMs act(AB + bias) with A=[rows x n], B=[n x cols]
+extern double a64[] __attribute__((aligned(4 * NR_LANES)));
+extern double b64[] __attribute__((aligned(4 * NR_LANES)));
+extern double bias64[] __attribute__((aligned(4 * NR_LANES)));
+extern double c64[] __attribute__((aligned(4 * NR_LANES)));
+extern double gold_relu64[] __attribute__((aligned(4 * NR_LANES)));
+extern double gold_gelu64[] __attribute__((aligned(4 * NR_LANES)));
+extern double gold_silu64[] __attribute__((aligned(4 * NR_LANES)));
+
+static int report(const char *name, int64_t idx) {
+  printf("The %s execution took %ld cycles.\n", name, get_timer());
+  return vcheck_report(name, idx);
+}
+
+int main() {
+  printf("\n");
+  printf("================\n");
+  printf("=  ACTIVATION  =\n");
+  printf("================\n");
+  printf("\n");
+  printf("\n");
+
+  printf("Rows: %lu\nColumns: %lu\nGEMM inner dimension: %lu\n", rows, cols,
+         n);
+
+  const uint64_t len = rows * cols;
+  int error = 0;
+
+  /*
+    Standalone activations, with the bias
+  */
+
+  start_timer();
+  relu_f32(y32, x32, bias32, rows, cols);
+  stop_timer();
+  error |= report("relu_f32", vcheck_f32(y32, gold_relu32, len, THRESHOLD_F32));
+
+  start_timer();
+  gelu_f32(y32, x32, bias32, rows, cols);
+  stop_timer();
+  error |= report("gelu_f32", vcheck_f32(y32, gold_gelu32, len, THRESHOLD_F32));
+
+  start_timer();
+  silu_f32(y32, x32, bias32, rows, cols);
+  stop_timer();
+  error |= report("silu_f32", vcheck_f32(y32, gold_silu32, len, THRESHOLD_F32));
+
+  start_timer();
+  relu_f16(y16, x16, bias16, rows, cols);
+  stop_timer();
+  error |= report("relu_f16", vcheck_f16(y16, gold_relu16, len, THRESHOLD_F16));
+
+  start_timer();
+  gelu_f16(y16, x16, bias16, rows, cols);
+  stop_timer();
+  error |= report("gelu_f16", vcheck_f16(y16, gold_gelu16, len, THRESHOLD_F16));
+
+  start_timer();
+  silu_f16(y16, x16, bias16, rows, cols);
+  stop_timer();
+  error |= report("silu_f16", vcheck_f16(y16, gold_silu16, len, THRESHOLD_F16));
+
+  /*
+    GEMMs with the fused epilogue, and with a separate pass
+  */
+
+  start_timer();
+  fmatmul_tiled_epilogue(c64, a64, b64, rows, n, cols, n, cols, cols, bias64,
+                         FMATMUL_ACT_RELU);
+  stop_timer();
+  error |= report("fmatmul_tiled_epilogue (ReLU)",
+                  vcheck_f64(c64, gold_relu64, len, THRESHOLD_F64));
+
+  start_timer();
+  fmatmul_tiled_epilogue(c64, a64, b64, rows, n, cols, n, cols, cols, bias64,
+                         FMATMUL_ACT_GELU);
+  stop_timer();
+  error |= report("fmatmul_tiled_epilogue (GELU)",
+                  vcheck_f64(c64, gold_gelu64, len, THRESHOLD_F64));
+
+  start_timer();
+  fmatmul_tiled_epilogue(c64, a64, b64, rows, n, cols, n, cols, cols, bias64,
+                         FMATMUL_ACT_SILU);
+  stop_timer();
+  error |= report("fmatmul_tiled_epilogue (SiLU)",
+                  vcheck_f64(c64, gold_silu64, len, THRESHOLD_F64));
+
+  start_timer();
+  fmatmul_tiled(c64, a64, b64, rows, n, cols, n, cols, cols);
+  gelu_f64(c64, c64, bias64, rows, cols);
+  stop_timer();
+  error |= report("fmatmul_tiled + gelu_f64",
+                  vcheck_f64(c64, gold_gelu64, len, THRESHOLD_F64));
+
+  return error;
+}
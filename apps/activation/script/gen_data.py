@@ -0,0 +1,88 @@
+#!/usr/bin/env python3
+# Copyright 2022 ETH Zurich and University of Bologna.
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+# arg1: rows, arg2: columns, arg3: inner dimension of the GEMMs
+# The GEMMs compute act(AB + bias) with A=[rows x n], B=[n x cols]
+
+import numpy as np
+import os
+import sys
+
+sys.path.insert(0, os.path.join(os.path.dirname(__file__), '../../common/script'))
+from data_emit import emit
+
+def relu(z):
+  return np.maximum(z, 0)
+
+# Tanh approximation, as in vmath
+def gelu(z):
+  return 0.5 * z * (1 + np.tanh(np.sqrt(2 / np.pi) * (z + 0.044715 * z ** 3)))
+
+def silu(z):
+  return z / (1 + np.exp(-z))
+
+def emit_acts(suffix, x, bias, dtype):
+  z = x.astype(np.float64) + bias.astype(np.float64)
+  emit("gold_relu" + suffix, relu(z).astype(dtype), 'NR_LANES*4')
+  emit("gold_gelu" + suffix, gelu(z).astype(dtype), 'NR_LANES*4')
+  emit("gold_silu" + suffix, silu(z).astype(dtype), 'NR_LANES*4')
+
+############
+## SCRIPT ##
+############
+
+if len(sys.argv) == 4:
+  rows = int(sys.argv[1])
+  cols = int(sys.argv[2])
+  n = int(sys.argv[3])
+else:
+  print("Error. Give me three arguments: the number of rows, of columns, and")
+  print("the inner dimension of the GEMMs.")
+  sys.exit()
+
+# Pre-activations around zero, where the activations bend
+x = (3 * np.random.randn(rows, cols)).astype(np.float32)
+bias = (np.random.rand(cols) - 0.5).astype(np.float32)
+x16 = x.astype(np.float16)
+bias16 = bias.astype(np.float16)
+
+# GEMM operands with a zero-mean product
+a = (np.random.rand(rows, n) - 0.5).astype(np.float64)
+b = (np.random.rand(n, cols) - 0.5).astype(np.float64)
+bias64 = (np.random.rand(cols) - 0.5).astype(np.float64)
+
+# Create the file
+print(".section .data,\"aw\",@progbits")
+emit("rows", np.array(rows, dtype=np.uint64))
+emit("cols", np.array(cols, dtype=np.uint64))
+emit("n", np.array(n, dtype=np.uint64))
+
+emit("x32", x, 'NR_LANES*4')
+emit("bias32", bias, 'NR_LANES*4')
+emit("y32", np.zeros(rows * cols, dtype=np.float32), 'NR_LANES*4')
+emit_acts("32", x, bias, np.float32)
+
+emit("x16", x16, 'NR_LANES*4')
+emit("bias16", bias16, 'NR_LANES*4')
+emit("y16", np.zeros(rows * cols, dtype=np.float16), 'NR_LANES*4')
+emit_acts("16", x16, bias16, np.float16)
+
+emit("a64", a, 'NR_LANES*4')
+emit("b64", b, 'NR_LANES*4')
+emit("bias64", bias64, 'NR_LANES*4')
+emit("c64", np.zeros(rows * cols, dtype=np.float64), 'NR_LANES*4')
+emit_acts("64", np.matmul(a, b), bias64, np.float64)
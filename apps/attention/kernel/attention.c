@@ -0,0 +1,157 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <math.h>
+
+#include "vmath/vmath.h"
+
+#include "attention.h"
+
+// Online softmax of the scores s of a row with a tile of vlk keys. The
+// probabilities are stored to p, to be broadcast in O += P V, and the partial
+// row of O is rescaled to the new maximum m of the row. l is the running sum
+// of the probabilities. The first tile has no previous maximum.
+static inline vfloat32m2_t attention_online_row(vfloat32m2_t s,
+                                                vfloat32m2_t o_v, float *m,
+                                                float *l, float *p, int first,
+                                                size_t vlk, size_t vld) {
+  vfloat32m1_t red_v = vfmv_v_f_f32m1(-INFINITY, 1);
+  red_v = vfredmax_vs_f32m2_f32m1(red_v, s, red_v, vlk);
+  float m_new = vfmv_f_s_f32m1_f32(red_v);
+  if (!first && *m > m_new)
+    m_new = *m;
+
+  s = vfsub_vf_f32m2(s, m_new, vlk);
+  s = vmath_exp_f32m2(s, vlk);
+  vse32_v_f32m2(p, s, vlk);
+  red_v = vfmv_v_f_f32m1(0, 1);
+  red_v = vfredusum_vs_f32m2_f32m1(red_v, s, red_v, vlk);
+  const float sum = vfmv_f_s_f32m1_f32(red_v);
+
+  if (first) {
+    *m = m_new;
+    *l = sum;
+    return o_v;
+  }
+  const float alpha = expf(*m - m_new);
+  *m = m_new;
+  *l = *l * alpha + sum;
+  return vfmul_vf_f32m2(o_v, alpha, vld);
+}
+
+// ATTENTION_ROWS rows of O. Each tile of keys computes the scores as the
+// 4xN micro-kernel of fmatmul, with the rows of Kt as the rows of B and the
+// elements of Q broadcast from the scalar registers.
+static void attention_rows_4(const float *q, const float *kt, const float *v,
+                             float *o, uint64_t n, uint64_t d,
+                             float p[][ATTENTION_TILE]) {
+  const size_t vld = vsetvl_e32m2(d);
+  size_t vlk;
+
+  float m0, m1, m2, m3;
+  float l0, l1, l2, l3;
+  vfloat32m2_t o0 = vfmv_v_f_f32m2(0, vld);
+  vfloat32m2_t o1 = vfmv_v_f_f32m2(0, vld);
+  vfloat32m2_t o2 = vfmv_v_f_f32m2(0, vld);
+  vfloat32m2_t o3 = vfmv_v_f_f32m2(0, vld);
+
+  for (uint64_t j = 0; j < n; j += vlk) {
+    vlk = vsetvl_e32m2(n - j);
+
+    /*
+      S = Q K^T, for 4 rows and vlk keys
+    */
+
+    vfloat32m2_t kt_v = vle32_v_f32m2(kt + j, vlk);
+    vfloat32m2_t s0 = vfmul_vf_f32m2(kt_v, q[0], vlk);
+    vfloat32m2_t s1 = vfmul_vf_f32m2(kt_v, q[d], vlk);
+    vfloat32m2_t s2 = vfmul_vf_f32m2(kt_v, q[2 * d], vlk);
+    vfloat32m2_t s3 = vfmul_vf_f32m2(kt_v, q[3 * d], vlk);
+    for (uint64_t k = 1; k < d; ++k) {
+      kt_v = vle32_v_f32m2(kt + k * n + j, vlk);
+      s0 = vfmacc_vf_f32m2(s0, q[k], kt_v, vlk);
+      s1 = vfmacc_vf_f32m2(s1, q[d + k], kt_v, vlk);
+      s2 = vfmacc_vf_f32m2(s2, q[2 * d + k], kt_v, vlk);
+      s3 = vfmacc_vf_f32m2(s3, q[3 * d + k], kt_v, vlk);
+    }
+
+    /*
+      P = exp(S - m), and rescale O to the new maximum
+    */
+
+    const int first = j == 0;
+    o0 = attention_online_row(s0, o0, &m0, &l0, p[0], first, vlk, vld);
+    o1 = attention_online_row(s1, o1, &m1, &l1, p[1], first, vlk, vld);
+    o2 = attention_online_row(s2, o2, &m2, &l2, p[2], first, vlk, vld);
+    o3 = attention_online_row(s3, o3, &m3, &l3, p[3], first, vlk, vld);
+
+    /*
+      O += P V
+    */
+
+    for (size_t jj = 0; jj < vlk; ++jj) {
+      vfloat32m2_t v_v = vle32_v_f32m2(v + (j + jj) * d, vld);
+      o0 = vfmacc_vf_f32m2(o0, p[0][jj], v_v, vld);
+      o1 = vfmacc_vf_f32m2(o1, p[1][jj], v_v, vld);
+      o2 = vfmacc_vf_f32m2(o2, p[2][jj], v_v, vld);
+      o3 = vfmacc_vf_f32m2(o3, p[3][jj], v_v, vld);
+    }
+  }
+
+  // Normalize by the sums of the probabilities
+  vse32_v_f32m2(o, vfmul_vf_f32m2(o0, 1.0f / l0, vld), vld);
+  vse32_v_f32m2(o + d, vfmul_vf_f32m2(o1, 1.0f / l1, vld), vld);
+  vse32_v_f32m2(o + 2 * d, vfmul_vf_f32m2(o2, 1.0f / l2, vld), vld);
+  vse32_v_f32m2(o + 3 * d, vfmul_vf_f32m2(o3, 1.0f / l3, vld), vld);
+}
+
+// One row of O, for the last n % ATTENTION_ROWS rows
+static void attention_rows_1(const float *q, const float *kt, const float *v,
+                             float *o, uint64_t n, uint64_t d, float *p) {
+  const size_t vld = vsetvl_e32m2(d);
+  size_t vlk;
+
+  float m0, l0;
+  vfloat32m2_t o0 = vfmv_v_f_f32m2(0, vld);
+
+  for (uint64_t j = 0; j < n; j += vlk) {
+    vlk = vsetvl_e32m2(n - j);
+
+    vfloat32m2_t s0 = vfmul_vf_f32m2(vle32_v_f32m2(kt + j, vlk), q[0], vlk);
+    for (uint64_t k = 1; k < d; ++k)
+      s0 = vfmacc_vf_f32m2(s0, q[k], vle32_v_f32m2(kt + k * n + j, vlk), vlk);
+
+    o0 = attention_online_row(s0, o0, &m0, &l0, p, j == 0, vlk, vld);
+
+    for (size_t jj = 0; jj < vlk; ++jj)
+      o0 = vfmacc_vf_f32m2(o0, p[jj], vle32_v_f32m2(v + (j + jj) * d, vld),
+                           vld);
+  }
+
+  vse32_v_f32m2(o, vfmul_vf_f32m2(o0, 1.0f / l0, vld), vld);
+}
+
+void attention_fused(const float *q, const float *kt, const float *v, float *o,
+                     uint64_t n, uint64_t d) {
+  // Probabilities of the current tile of each row of the block
+  float p[ATTENTION_ROWS][ATTENTION_TILE];
+
+  uint64_t i = 0;
+  for (; i + ATTENTION_ROWS <= n; i += ATTENTION_ROWS)
+    attention_rows_4(q + i * d, kt, v, o + i * d, n, d, p);
+  for (; i < n; ++i)
+    attention_rows_1(q + i * d, kt, v, o + i * d, n, d, p[0]);
+}
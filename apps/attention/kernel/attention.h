@@ -0,0 +1,39 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Scaled dot-product attention, O = softmax(Q K^T) V, in FP32, with Q [n x d]
+// already scaled by 1/sqrt(d), K transposed (Kt [d x n]), V and O [n x d].
+
+#ifndef _ATTENTION_H_
+#define _ATTENTION_H_
+
+#include <stdint.h>
+
+#include "riscv_vector.h"
+#include "vconfig.h"
+
+// Rows of Q of a block, and keys of a score tile (LMUL=2). d must not be
+// larger than ATTENTION_TILE either, since a row of O is one register group.
+#define ATTENTION_ROWS 4
+#define ATTENTION_TILE VLMAX(32, 2)
+
+// Flash-attention style: the scores of ATTENTION_ROWS queries with a tile of
+// keys stay in the vector registers, through the online softmax, and only the
+// rows of O are stored. The score matrix is never written to memory.
+void attention_fused(const float *q, const float *kt, const float *v, float *o,
+                     uint64_t n, uint64_t d);
+
+#endif
@@ -0,0 +1,74 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdint.h>
+#include <string.h>
+
+#include "kernel/attention.h"
+#include "runtime.h"
+#include "util.h"
+#include "vcheck.h"
+
+#ifndef SPIKE
+#include "printf.h"
+#else
+#include <stdio.h>
+#endif
+
+#define THRESHOLD 0.0001
+
+extern uint64_t n;
+extern uint64_t d;
+extern float q[] __attribute__((aligned(4 * NR_LANES)));
+extern float kt[] __attribute__((aligned(4 * NR_LANES)));
+extern float v[] __attribute__((aligned(4 * NR_LANES)));
+extern float o[] __attribute__((aligned(4 * NR_LANES)));
+extern float gold[] __attribute__((aligned(4 * NR_LANES)));
+
+int main() {
+  printf("\n");
+  printf("===============\n");
+  printf("=  ATTENTION  =\n");
+  printf("===============\n");
+  printf("\n");
+  printf("\n");
+
+  printf("Sequence length: %lu\nHead dimension: %lu\n", n, d);
+
+  if (d > ATTENTION_TILE) {
+    printf("Error: the head dimension must not be larger than %d.\n",
+           ATTENTION_TILE);
+    return 1;
+  }
+
+  start_timer();
+  attention_fused(q, kt, v, o, n, d);
+  stop_timer();
+
+  int64_t runtime = get_timer();
+  float performance = 4.0 * n * n * d / runtime;
+  printf("The fused attention took %d cycles, %f FLOP/cycle.\n", runtime,
+         performance);
+
+  int64_t idx = vcheck_f32(o, gold, n * d, THRESHOLD);
+  if (idx >= 0) {
+    printf("Error at index %d: %f != %f\n", idx, o[idx], gold[idx]);
+    return 1;
+  }
+  printf("Check okay. No errors.\n");
+
+  return 0;
+}
@@ -0,0 +1,58 @@
+#!/usr/bin/env python3
+# Copyright 2022 ETH Zurich and University of Bologna.
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+# arg1: sequence length n, arg2: head dimension d
+
+import numpy as np
+import os
+import sys
+
+sys.path.insert(0, os.path.join(os.path.dirname(__file__), '../../common/script'))
+from data_emit import emit
+
+############
+## SCRIPT ##
+############
+
+if len(sys.argv) == 3:
+  n = int(sys.argv[1])
+  d = int(sys.argv[2])
+else:
+  print("Error. Give me two arguments: the sequence length and the head dimension.")
+  sys.exit()
+
+# Q is scaled by 1/sqrt(d), as when the scale is folded in its projection
+q = (np.random.randn(n, d) / np.sqrt(d)).astype(np.float32)
+k = np.random.randn(n, d).astype(np.float32)
+v = np.random.randn(n, d).astype(np.float32)
+
+# Golden model, in FP64
+s = q.astype(np.float64) @ k.astype(np.float64).T
+p = np.exp(s - s.max(axis=1, keepdims=True))
+gold = (p / p.sum(axis=1, keepdims=True)) @ v.astype(np.float64)
+
+# Create the file
+print(".section .data,\"aw\",@progbits")
+emit("n", np.array(n, dtype=np.uint64))
+emit("d", np.array(d, dtype=np.uint64))
+emit("q", q, 'NR_LANES*4')
+emit("kt", np.ascontiguousarray(k.T), 'NR_LANES*4')
+emit("v", v, 'NR_LANES*4')
+emit("o", np.zeros(n * d, dtype=np.float32), 'NR_LANES*4')
+emit("gold", gold.astype(np.float32), 'NR_LANES*4')
+# Score matrix of the unfused benchmark
+emit("s", np.zeros(n * n, dtype=np.float32), 'NR_LANES*4')
@@ -0,0 +1 @@
+../../activation/kernel/activation.c
\ No newline at end of file
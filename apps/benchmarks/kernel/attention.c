@@ -0,0 +1 @@
+../../attention/kernel/attention.c
\ No newline at end of file
@@ -0,0 +1 @@
+../../attention/kernel/attention.h
\ No newline at end of file
@@ -0,0 +1 @@
+../../bfs/kernel/bfs.c
\ No newline at end of file
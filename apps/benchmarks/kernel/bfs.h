@@ -0,0 +1 @@
+../../bfs/kernel/bfs.h
\ No newline at end of file
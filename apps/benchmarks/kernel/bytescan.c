@@ -0,0 +1 @@
+../../bytescan/kernel/bytescan.c
\ No newline at end of file
@@ -0,0 +1 @@
+../../bytescan/kernel/bytescan.h
\ No newline at end of file
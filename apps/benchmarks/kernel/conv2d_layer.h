@@ -0,0 +1 @@
+../../conv2d_layer/kernel/conv2d_layer.h
\ No newline at end of file
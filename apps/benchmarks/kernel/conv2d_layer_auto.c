@@ -0,0 +1 @@
+../../conv2d_layer/kernel/conv2d_layer_auto.c
\ No newline at end of file
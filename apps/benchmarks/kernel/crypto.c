@@ -0,0 +1 @@
+../../crypto/kernel/crypto.c
\ No newline at end of file
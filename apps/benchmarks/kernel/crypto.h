@@ -0,0 +1 @@
+../../crypto/kernel/crypto.h
\ No newline at end of file
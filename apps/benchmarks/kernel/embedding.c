@@ -0,0 +1 @@
+../../embedding/kernel/embedding.c
\ No newline at end of file
@@ -0,0 +1 @@
+../../embedding/kernel/embedding.h
\ No newline at end of file
@@ -0,0 +1 @@
+../../fconv2d/fconv2d_KxK.c
\ No newline at end of file
@@ -0,0 +1 @@
+../../fft/kernel/fft_r4.c
\ No newline at end of file
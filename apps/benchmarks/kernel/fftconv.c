@@ -0,0 +1 @@
+../../fftconv/kernel/fftconv.c
\ No newline at end of file
@@ -0,0 +1 @@
+../../fftconv/kernel/fftconv.h
\ No newline at end of file
@@ -0,0 +1 @@
+../../fftconv/kernel/fftconv_threshold.h
\ No newline at end of file
@@ -0,0 +1 @@
+../../fgemv/kernel/fgemv.c
\ No newline at end of file
@@ -0,0 +1 @@
+../../fgemv/kernel/fgemv.h
\ No newline at end of file
@@ -0,0 +1 @@
+../../fmatmul_batched/kernel/fmatmul_batched.c
\ No newline at end of file
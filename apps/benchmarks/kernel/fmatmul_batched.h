@@ -0,0 +1 @@
+../../fmatmul_batched/kernel/fmatmul_batched.h
\ No newline at end of file
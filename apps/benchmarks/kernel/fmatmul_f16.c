@@ -0,0 +1 @@
+../../fmatmul_f16/kernel/fmatmul_f16.c
\ No newline at end of file
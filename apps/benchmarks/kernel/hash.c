@@ -0,0 +1 @@
+../../hash/kernel/hash.c
\ No newline at end of file
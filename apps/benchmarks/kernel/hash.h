@@ -0,0 +1 @@
+../../hash/kernel/hash.h
\ No newline at end of file
@@ -0,0 +1 @@
+../../iconv2d/iconv2d_i8.c
\ No newline at end of file
@@ -0,0 +1 @@
+../../imatmul_i16/kernel/imatmul_i16.c
\ No newline at end of file
@@ -0,0 +1 @@
+../../imgproc/kernel/imgproc.c
\ No newline at end of file
@@ -0,0 +1 @@
+../../imgproc/kernel/imgproc.h
\ No newline at end of file
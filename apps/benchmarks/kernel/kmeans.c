@@ -0,0 +1 @@
+../../kmeans/kernel/kmeans.c
\ No newline at end of file
@@ -0,0 +1 @@
+../../kmeans/kernel/kmeans.h
\ No newline at end of file
@@ -0,0 +1 @@
+../../knn/kernel/knn.c
\ No newline at end of file
@@ -0,0 +1 @@
+../../knn/kernel/knn.h
\ No newline at end of file
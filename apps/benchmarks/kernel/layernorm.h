@@ -0,0 +1 @@
+../../layernorm/kernel/layernorm.h
\ No newline at end of file
@@ -0,0 +1 @@
+../../linsolve/kernel/linsolve.c
\ No newline at end of file
@@ -0,0 +1 @@
+../../linsolve/kernel/linsolve.h
\ No newline at end of file
@@ -0,0 +1 @@
+../../imgproc/kernel/median.c
\ No newline at end of file
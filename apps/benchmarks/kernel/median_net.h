@@ -0,0 +1 @@
+../../imgproc/kernel/median_net.h
\ No newline at end of file
@@ -0,0 +1 @@
+../../option/kernel/option.c
\ No newline at end of file
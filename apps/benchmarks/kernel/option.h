@@ -0,0 +1 @@
+../../option/kernel/option.h
\ No newline at end of file
@@ -0,0 +1 @@
+../../dwconv/kernel/pool.c
\ No newline at end of file
@@ -0,0 +1 @@
+../../quant/kernel/quant.c
\ No newline at end of file
@@ -0,0 +1 @@
+../../quant/kernel/quant.h
\ No newline at end of file
@@ -0,0 +1 @@
+../../rnn/kernel/rnn.c
\ No newline at end of file
@@ -0,0 +1 @@
+../../rnn/kernel/rnn.h
\ No newline at end of file
@@ -0,0 +1 @@
+../../sort/kernel/sort.c
\ No newline at end of file
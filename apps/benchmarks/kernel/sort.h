@@ -0,0 +1 @@
+../../sort/kernel/sort.h
\ No newline at end of file
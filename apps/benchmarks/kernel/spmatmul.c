@@ -0,0 +1 @@
+../../spmatmul/kernel/spmatmul.c
\ No newline at end of file
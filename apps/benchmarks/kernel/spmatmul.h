@@ -0,0 +1 @@
+../../spmatmul/kernel/spmatmul.h
\ No newline at end of file
@@ -0,0 +1 @@
+../../spmv/kernel/spmv.h
\ No newline at end of file
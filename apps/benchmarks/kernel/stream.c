@@ -0,0 +1 @@
+../../stream/kernel/stream.c
\ No newline at end of file
@@ -0,0 +1 @@
+../../stream/kernel/stream.h
\ No newline at end of file
@@ -0,0 +1 @@
+../../vfredsum_repro/kernel/vfredsum_repro.c
\ No newline at end of file
@@ -22,6 +22,8 @@
 #include <stdio.h>
 #include <string.h>
 
+#include "bench.h"
+#include "data_image.h"
 #include "runtime.h"
 
 #ifndef SPIKE
@@ -31,15 +33,36 @@
 #if defined(IMATMUL)
 #include "benchmark/imatmul.bmark"
 
+#elif defined(IMATMUL_I8)
+#include "benchmark/imatmul_i8.bmark"
+
+#elif defined(IMATMUL_I16)
+#include "benchmark/imatmul_i16.bmark"
+
 #elif defined(FMATMUL)
 #include "benchmark/fmatmul.bmark"
 
+#elif defined(FMATMUL_F32)
+#include "benchmark/fmatmul_f32.bmark"
+
+#elif defined(FMATMUL_F16)
+#include "benchmark/fmatmul_f16.bmark"
+
+#elif defined(FMATMUL_BATCHED)
+#include "benchmark/fmatmul_batched.bmark"
+
+#elif defined(FGEMV)
+#include "benchmark/fgemv.bmark"
+
 #elif defined(ICONV2D)
 #include "benchmark/iconv2d.bmark"
 
 #elif defined(FCONV2D)
 #include "benchmark/fconv2d.bmark"
 
+#elif defined(CONV2D_LAYER)
+#include "benchmark/conv2d_layer.bmark"
+
 #elif defined(FCONV3D)
 #include "benchmark/fconv3d.bmark"
 
@@ -73,6 +96,81 @@
 #elif defined(ROI_ALIGN)
 #include "benchmark/roi_align.bmark"
 
+#elif defined(SPMV)
+#include "benchmark/spmv.bmark"
+
+#elif defined(LAYERNORM)
+#include "benchmark/layernorm.bmark"
+
+#elif defined(ATTENTION)
+#include "benchmark/attention.bmark"
+
+#elif defined(SORT)
+#include "benchmark/sort.bmark"
+
+#elif defined(HIST_SCAN)
+#include "benchmark/hist_scan.bmark"
+
+#elif defined(BLAS1)
+#include "benchmark/blas1.bmark"
+
+#elif defined(VFREDSUM_REPRO)
+#include "benchmark/vfredsum_repro.bmark"
+
+#elif defined(DWCONV)
+#include "benchmark/dwconv.bmark"
+
+#elif defined(ACTIVATION)
+#include "benchmark/activation.bmark"
+
+#elif defined(QUANT)
+#include "benchmark/quant.bmark"
+
+#elif defined(TRANSPOSE)
+#include "benchmark/transpose.bmark"
+
+#elif defined(LINSOLVE)
+#include "benchmark/linsolve.bmark"
+
+#elif defined(KNN)
+#include "benchmark/knn.bmark"
+
+#elif defined(STREAM)
+#include "benchmark/stream.bmark"
+
+#elif defined(HASH)
+#include "benchmark/hash.bmark"
+
+#elif defined(IMGPROC)
+#include "benchmark/imgproc.bmark"
+
+#elif defined(OPTION)
+#include "benchmark/option.bmark"
+
+#elif defined(EMBEDDING)
+#include "benchmark/embedding.bmark"
+
+#elif defined(RNN)
+#include "benchmark/rnn.bmark"
+
+#elif defined(SPMATMUL)
+#include "benchmark/spmatmul.bmark"
+
+#elif defined(FFTCONV)
+#include "benchmark/fftconv.bmark"
+
+#elif defined(CRYPTO)
+#include "benchmark/crypto.bmark"
+
+#elif defined(BFS)
+#include "benchmark/bfs.bmark"
+
+#elif defined(KMEANS)
+#include "benchmark/kmeans.bmark"
+
+#elif defined(BYTESCAN)
+#include "benchmark/bytescan.bmark"
+
 #else
 #error                                                                         \
     "Error, no kernel was specified. Please, run 'make bin/benchmarks ENV_DEFINES=-D${KERNEL}', where KERNEL contains the kernel to benchmark. For example: 'make bin/benchmarks ENV_DEFINES=-DIMATMUL'."
@@ -0,0 +1,281 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "bfs.h"
+
+// The strips of the vertices are vl = VLMAX(32, 4) long but the last one, so
+// that they start at a byte of the bitmaps, which are read and written as
+// masks with vlm and vsm
+
+// All the levels to -1, but the one of src
+static void bfs_init(const bfs_graph_t *g, uint32_t src, int32_t *level) {
+  size_t vl;
+
+  for (uint64_t i = 0; i < g->n; i += vl) {
+    vl = vsetvl_e32m4(g->n - i);
+    vse32_v_i32m4(level + i, vmv_v_x_i32m4(-1, vl), vl);
+  }
+  level[src] = 0;
+}
+
+// Sum of the degrees of the cnt vertices of queue
+static uint64_t bfs_degrees(const bfs_graph_t *g, const uint32_t *queue,
+                            uint64_t cnt) {
+  vuint32m1_t sum = vmv_v_x_u32m1(0, 1);
+  size_t vl;
+
+  for (uint64_t i = 0; i < cnt; i += vl) {
+    vl = vsetvl_e32m4(cnt - i);
+    vuint32m4_t off = vsll_vx_u32m4(vle32_v_u32m4(queue + i, vl), 2, vl);
+    vuint32m4_t deg =
+        vsub_vv_u32m4(vluxei32_v_u32m4(g->row_ptr + 1, off, vl),
+                      vluxei32_v_u32m4(g->row_ptr, off, vl), vl);
+    sum = vredsum_vs_u32m4_u32m1(sum, deg, sum, vl);
+  }
+  return vmv_x_s_u32m1_u32(sum);
+}
+
+// Bitmaps of the visited vertices and of the vertices of level d
+static void bfs_to_bitmaps(const bfs_graph_t *g, const int32_t *level,
+                           int32_t d, uint8_t *visited, uint8_t *front) {
+  size_t vl;
+
+  for (uint64_t i = 0; i < g->n; i += vl) {
+    vl = vsetvl_e32m4(g->n - i);
+    vint32m4_t lv = vle32_v_i32m4(level + i, vl);
+    vsm_v_b8(visited + i / 8, vmsge_vx_i32m4_b8(lv, 0, vl), vl);
+    vsm_v_b8(front + i / 8, vmseq_vx_i32m4_b8(lv, d, vl), vl);
+  }
+}
+
+// Queue of the vertices of the bitmap front, and their number
+static uint64_t bfs_to_queue(const bfs_graph_t *g, const uint8_t *front,
+                             uint32_t *queue) {
+  uint64_t nq = 0;
+  size_t vl;
+
+  for (uint64_t i = 0; i < g->n; i += vl) {
+    vl = vsetvl_e32m4(g->n - i);
+    vbool8_t m = vlm_v_b8(front + i / 8, vl);
+    const uint32_t cnt = vcpop_m_b8(m, vl);
+    if (!cnt)
+      continue;
+    vuint32m4_t id = vadd_vx_u32m4(vid_v_u32m4(vl), i, vl);
+    vse32_v_u32m4(queue + nq, vcompress_vm_u32m4(m, id, id, vl), cnt);
+    nq += cnt;
+  }
+  return nq;
+}
+
+// Expand the nq vertices of level d of queue, and return the vertices of next.
+// The neighbors of a strip are distinct, and the levels written by a strip are
+// read by the next ones, so that next has no duplicates
+static uint64_t bfs_top_down_step(const bfs_graph_t *g, int32_t *level,
+                                  int32_t d, const uint32_t *queue,
+                                  uint64_t nq, uint32_t *next) {
+  uint64_t nn = 0;
+  size_t vl;
+
+  for (uint64_t q = 0; q < nq; ++q) {
+    const uint32_t u = queue[q];
+    const uint32_t beg = g->row_ptr[u];
+    const uint32_t deg = g->row_ptr[u + 1] - beg;
+
+    for (uint32_t j = 0; j < deg; j += vl) {
+      vl = vsetvl_e32m4(deg - j);
+      vuint32m4_t v = vle32_v_u32m4(g->col_idx + beg + j, vl);
+      vuint32m4_t off = vsll_vx_u32m4(v, 2, vl);
+      vbool8_t fresh =
+          vmslt_vx_i32m4_b8(vluxei32_v_i32m4(level, off, vl), 0, vl);
+      const uint32_t cnt = vcpop_m_b8(fresh, vl);
+      if (!cnt)
+        continue;
+      vsuxei32_v_i32m4_m(fresh, level, off, vmv_v_x_i32m4(d + 1, vl), vl);
+      vse32_v_u32m4(next + nn, vcompress_vm_u32m4(fresh, v, v, vl), cnt);
+      nn += cnt;
+    }
+  }
+  return nn;
+}
+
+// Find a parent in the bitmap front for each unvisited vertex, and return the
+// vertices found, in front_next, and the sum of their degrees in edges. Each
+// element walks the neighbor list of its vertex, and stops at the first
+// neighbor whose bit of front is set, which it gathers with the 32-bit word
+// of the bitmap
+static uint64_t bfs_bottom_up_step(const bfs_graph_t *g, int32_t *level,
+                                   int32_t d, uint8_t *visited,
+                                   const uint8_t *front, uint8_t *front_next,
+                                   uint64_t *edges) {
+  const uint32_t *front_w = (const uint32_t *)front;
+  vuint32m1_t sum = vmv_v_x_u32m1(0, 1);
+  uint64_t nn = 0;
+  size_t vl;
+
+  for (uint64_t i = 0; i < g->n; i += vl) {
+    vl = vsetvl_e32m4(g->n - i);
+    const vuint32m4_t zero = vmv_v_x_u32m4(0, vl);
+    vbool8_t seen = vlm_v_b8(visited + i / 8, vl);
+    vuint32m4_t pos = vle32_v_u32m4(g->row_ptr + i, vl);
+    vuint32m4_t end = vle32_v_u32m4(g->row_ptr + i + 1, vl);
+    vuint32m4_t deg = vsub_vv_u32m4(end, pos, vl);
+
+    vbool8_t act = vmandn_mm_b8(vmsltu_vv_u32m4_b8(pos, end, vl), seen, vl);
+    vbool8_t fresh = vmclr_m_b8(vl);
+    while (vcpop_m_b8(act, vl)) {
+      vuint32m4_t nb = vluxei32_v_u32m4_m(act, zero, g->col_idx,
+                                          vsll_vx_u32m4(pos, 2, vl), vl);
+      vuint32m4_t w = vluxei32_v_u32m4_m(
+          act, zero, front_w, vsll_vx_u32m4(vsrl_vx_u32m4(nb, 5, vl), 2, vl),
+          vl);
+      // The shift takes the 5 LSBs of the neighbor
+      vbool8_t hit = vmand_mm_b8(
+          act,
+          vmsne_vx_u32m4_b8(vand_vx_u32m4(vsrl_vv_u32m4(w, nb, vl), 1, vl), 0,
+                            vl),
+          vl);
+      fresh = vmor_mm_b8(fresh, hit, vl);
+      pos = vadd_vx_u32m4(pos, 1, vl);
+      act = vmandn_mm_b8(vmand_mm_b8(act, vmsltu_vv_u32m4_b8(pos, end, vl), vl),
+                         hit, vl);
+    }
+
+    vsm_v_b8(front_next + i / 8, fresh, vl);
+    const uint32_t cnt = vcpop_m_b8(fresh, vl);
+    if (!cnt)
+      continue;
+    vsm_v_b8(visited + i / 8, vmor_mm_b8(seen, fresh, vl), vl);
+    vse32_v_i32m4_m(fresh, level + i, vmv_v_x_i32m4(d + 1, vl), vl);
+    sum = vredsum_vs_u32m4_u32m1_m(fresh, sum, deg, sum, vl);
+    nn += cnt;
+  }
+  *edges = vmv_x_s_u32m1_u32(sum);
+  return nn;
+}
+
+uint64_t bfs_top_down_v(const bfs_graph_t *g, uint32_t src, int32_t *level,
+                        bfs_ws_t *ws) {
+  uint32_t *queue = ws->queue;
+  uint32_t *next = ws->next;
+
+  bfs_init(g, src, level);
+  queue[0] = src;
+
+  uint64_t reached = 1;
+  for (uint64_t nq = 1, d = 0; nq; ++d) {
+    nq = bfs_top_down_step(g, level, d, queue, nq, next);
+    reached += nq;
+    uint32_t *tmp = queue;
+    queue = next;
+    next = tmp;
+  }
+  return reached;
+}
+
+uint64_t bfs_bottom_up_v(const bfs_graph_t *g, uint32_t src, int32_t *level,
+                         bfs_ws_t *ws) {
+  uint8_t *front = ws->front;
+  uint8_t *front_next = ws->front_next;
+  uint64_t edges;
+
+  bfs_init(g, src, level);
+  bfs_to_bitmaps(g, level, 0, ws->visited, front);
+
+  uint64_t reached = 1;
+  for (uint64_t nf = 1, d = 0; nf; ++d) {
+    nf = bfs_bottom_up_step(g, level, d, ws->visited, front, front_next,
+                            &edges);
+    reached += nf;
+    uint8_t *tmp = front;
+    front = front_next;
+    front_next = tmp;
+  }
+  return reached;
+}
+
+// The frontier is a queue in the top-down steps, and a bitmap in the
+// bottom-up ones. The edges of the frontier m_f and of the unvisited vertices
+// m_u pick the direction of each step, as in Beamer et al., "Direction-
+// Optimizing Breadth-First Search", SC 2012
+uint64_t bfs_v(const bfs_graph_t *g, uint32_t src, int32_t *level,
+               bfs_ws_t *ws) {
+  uint32_t *queue = ws->queue;
+  uint32_t *next = ws->next;
+  uint8_t *front = ws->front;
+  uint8_t *front_next = ws->front_next;
+
+  bfs_init(g, src, level);
+  queue[0] = src;
+
+  uint64_t m_f = g->row_ptr[src + 1] - g->row_ptr[src];
+  uint64_t m_u = g->row_ptr[g->n] - m_f;
+  uint64_t reached = 1;
+  int bottom_up = 0, growing = 1;
+
+  for (uint64_t nf = 1, d = 0; nf; ++d) {
+    if (!bottom_up && m_f > m_u / BFS_ALPHA) {
+      bfs_to_bitmaps(g, level, d, ws->visited, front);
+      bottom_up = 1;
+    } else if (bottom_up && !growing && nf < g->n / BFS_BETA) {
+      bfs_to_queue(g, front, queue);
+      bottom_up = 0;
+    }
+
+    uint64_t nn;
+    if (bottom_up) {
+      nn = bfs_bottom_up_step(g, level, d, ws->visited, front, front_next,
+                              &m_f);
+      uint8_t *tmp = front;
+      front = front_next;
+      front_next = tmp;
+    } else {
+      nn = bfs_top_down_step(g, level, d, queue, nf, next);
+      m_f = bfs_degrees(g, next, nn);
+      uint32_t *tmp = queue;
+      queue = next;
+      next = tmp;
+    }
+
+    growing = nn > nf;
+    nf = nn;
+    reached += nf;
+    m_u -= m_f;
+  }
+  return reached;
+}
+
+uint64_t bfs_s(const bfs_graph_t *g, uint32_t src, int32_t *level,
+               bfs_ws_t *ws) {
+  uint32_t *queue = ws->queue;
+  uint64_t head = 0, tail = 0;
+
+  for (uint64_t v = 0; v < g->n; ++v)
+    level[v] = -1;
+  level[src] = 0;
+  queue[tail++] = src;
+
+  while (head < tail) {
+    const uint32_t u = queue[head++];
+    for (uint32_t j = g->row_ptr[u]; j < g->row_ptr[u + 1]; ++j) {
+      const uint32_t v = g->col_idx[j];
+      if (level[v] < 0) {
+        level[v] = level[u] + 1;
+        queue[tail++] = v;
+      }
+    }
+  }
+  return tail;
+}
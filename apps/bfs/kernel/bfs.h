@@ -0,0 +1,72 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Breadth-first search of an undirected graph, from the vertex src. level[v]
+// is the depth of v, or -1 if src does not reach it, and the functions return
+// the vertices reached:
+//   bfs_top_down_v: each step expands the queue of the frontier, a neighbor
+//                   list at a time: the levels of the neighbors are gathered,
+//                   and the unvisited ones are written and compacted to the
+//                   next queue with vcompress
+//   bfs_bottom_up_v: each step looks for a parent of the unvisited vertices,
+//                    one per element: the visited bitmap is loaded as a mask,
+//                    and each vertex walks its neighbor list until one of
+//                    them is in the bitmap of the frontier
+//   bfs_v: direction-optimizing, top-down while the frontier is small, and
+//          bottom-up while its edges are more than 1 / BFS_ALPHA of the edges
+//          of the unvisited vertices, until it falls below BFS_BETA of the
+//          vertices
+//   bfs_s: scalar top-down reference
+
+#ifndef _BFS_H_
+#define _BFS_H_
+
+#include <stdint.h>
+
+#include "riscv_vector.h"
+
+// Thresholds of the direction switches of bfs_v
+#define BFS_ALPHA 14
+#define BFS_BETA 24
+
+// Bytes of a bitmap of n vertices, a multiple of 8
+#define BFS_BITMAP_BYTES(n) ((((n) + 63) / 64) * 8)
+
+// Undirected graph of n vertices in CSR: the neighbors of v are col_idx[j],
+// row_ptr[v] <= j < row_ptr[v + 1]
+typedef struct {
+  uint64_t n;
+  const uint32_t *row_ptr, *col_idx;
+} bfs_graph_t;
+
+// Queues of n vertices, and bitmaps of BFS_BITMAP_BYTES(n) bytes of the
+// visited vertices and of the current and next frontiers
+typedef struct {
+  uint32_t *queue, *next;
+  uint8_t *visited, *front, *front_next;
+} bfs_ws_t;
+
+uint64_t bfs_top_down_v(const bfs_graph_t *g, uint32_t src, int32_t *level,
+                        bfs_ws_t *ws);
+uint64_t bfs_bottom_up_v(const bfs_graph_t *g, uint32_t src, int32_t *level,
+                         bfs_ws_t *ws);
+uint64_t bfs_v(const bfs_graph_t *g, uint32_t src, int32_t *level,
+               bfs_ws_t *ws);
+
+uint64_t bfs_s(const bfs_graph_t *g, uint32_t src, int32_t *level,
+               bfs_ws_t *ws);
+
+#endif
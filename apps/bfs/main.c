@@ -0,0 +1,96 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdint.h>
+
+#include "kernel/bfs.h"
+#include "runtime.h"
+#include "util.h"
+#include "vcheck.h"
+
+#ifndef SPIKE
+#include "printf.h"
+#else
+#include <stdio.h>
+#endif
+
+extern uint64_t n;
+extern uint64_t src;
+extern uint32_t row_ptr[] __attribute__((aligned(4 * NR_LANES)));
+extern uint32_t col_idx[] __attribute__((aligned(4 * NR_LANES)));
+extern int32_t level[] __attribute__((aligned(4 * NR_LANES)));
+extern uint32_t queue[] __attribute__((aligned(4 * NR_LANES)));
+extern uint32_t next[] __attribute__((aligned(4 * NR_LANES)));
+extern uint8_t visited[] __attribute__((aligned(4 * NR_LANES)));
+extern uint8_t front[] __attribute__((aligned(4 * NR_LANES)));
+extern uint8_t front_next[] __attribute__((aligned(4 * NR_LANES)));
+extern int32_t gold_level[] __attribute__((aligned(4 * NR_LANES)));
+
+typedef uint64_t (*bfs_t)(const bfs_graph_t *g, uint32_t src, int32_t *level,
+                          bfs_ws_t *ws);
+
+// Search from src, and compare the levels with the golden ones. The edges of
+// the component of src, over the cycles, are the traversed edges per cycle
+static int run(const char *name, bfs_t bfs, const bfs_graph_t *g,
+               bfs_ws_t *ws, uint64_t edges) {
+  start_timer();
+  uint64_t reached = bfs(g, src, level, ws);
+  stop_timer();
+
+  int64_t runtime = get_timer();
+  printf("%s: %d cycles, %lu vertices, %f edges/cycle.\n", name, runtime,
+         reached, (float)edges / runtime);
+
+  int64_t idx = vcheck_i32(level, gold_level, n);
+  if (idx >= 0) {
+    printf("%s: Error at vertex %d. %d != %d\n", name, idx, level[idx],
+           gold_level[idx]);
+    return 1;
+  }
+  printf("%s: Check okay. No errors.\n", name);
+  return 0;
+}
+
+int main() {
+  printf("\n");
+  printf("=========\n");
+  printf("=  BFS  =\n");
+  printf("=========\n");
+  printf("\n");
+  printf("\n");
+
+  const bfs_graph_t g = {n, row_ptr, col_idx};
+  bfs_ws_t ws = {queue, next, visited, front, front_next};
+
+  // Undirected edges of the component of src
+  uint64_t edges = 0;
+  for (uint64_t v = 0; v < n; ++v)
+    if (gold_level[v] >= 0)
+      edges += row_ptr[v + 1] - row_ptr[v];
+  edges /= 2;
+
+  printf("Vertices: %lu, edges: %lu, source: %lu\n", n,
+         (uint64_t)row_ptr[n] / 2, src);
+
+  int error = 0;
+
+  error |= run("bfs_s", bfs_s, &g, &ws, edges);
+  error |= run("bfs_top_down_v", bfs_top_down_v, &g, &ws, edges);
+  error |= run("bfs_bottom_up_v", bfs_bottom_up_v, &g, &ws, edges);
+  error |= run("bfs_v", bfs_v, &g, &ws, edges);
+
+  return error;
+}
@@ -0,0 +1,99 @@
+#!/usr/bin/env python3
+# Copyright 2022 ETH Zurich and University of Bologna.
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+# arg1: scale, the graph has 2^scale vertices, arg2: edge factor, the R-MAT
+# generator draws 2^scale * edge factor edges, as in the Graph500
+#
+# The graph is undirected, without self loops and multiple edges, and its
+# vertices are relabeled at random. The search starts from the vertex of
+# highest degree.
+
+import numpy as np
+import os
+import sys
+from collections import deque
+
+sys.path.insert(0, os.path.join(os.path.dirname(__file__), '../../common/script'))
+from data_emit import emit
+
+# Probabilities of the quadrants of the R-MAT recursion (Graph500)
+A, B, C = 0.57, 0.19, 0.19
+
+def rmat(scale, edge_factor):
+  n = 1 << scale
+  m = edge_factor * n
+  u = np.zeros(m, dtype=np.int64)
+  v = np.zeros(m, dtype=np.int64)
+  for l in range(scale):
+    r = np.random.random(m)
+    u |= (r >= A + B).astype(np.int64) << l
+    v |= (((r >= A) & (r < A + B)) | (r >= A + B + C)).astype(np.int64) << l
+  perm = np.random.permutation(n)
+  u, v = perm[u], perm[v]
+  keep = u != v
+  e = np.concatenate([np.stack([u[keep], v[keep]], axis=1),
+                      np.stack([v[keep], u[keep]], axis=1)])
+  # Sorted by source, then destination
+  e = np.unique(e, axis=0)
+  row_ptr = np.zeros(n + 1, dtype=np.uint32)
+  row_ptr[1:] = np.cumsum(np.bincount(e[:, 0], minlength=n))
+  return n, row_ptr, e[:, 1].astype(np.uint32)
+
+def bfs(n, row_ptr, col_idx, src):
+  rp, ci = row_ptr.tolist(), col_idx.tolist()
+  level = [-1] * n
+  level[src] = 0
+  queue = deque([src])
+  while queue:
+    u = queue.popleft()
+    for v in ci[rp[u]:rp[u + 1]]:
+      if level[v] < 0:
+        level[v] = level[u] + 1
+        queue.append(v)
+  return np.array(level, dtype=np.int32)
+
+############
+## SCRIPT ##
+############
+
+if len(sys.argv) == 3:
+  scale       = int(sys.argv[1])
+  edge_factor = int(sys.argv[2])
+else:
+  print("Error. Give me two arguments: the scale and the edge factor of the graph.")
+  sys.exit()
+
+n, row_ptr, col_idx = rmat(scale, edge_factor)
+src = int(np.argmax(np.diff(row_ptr)))
+gold_level = bfs(n, row_ptr, col_idx, src)
+
+# Bytes of the bitmaps, as BFS_BITMAP_BYTES
+bitmap_bytes = (n + 63) // 64 * 8
+
+# Create the file
+print(".section .data,\"aw\",@progbits")
+emit("n", np.array(n, dtype=np.uint64))
+emit("src", np.array(src, dtype=np.uint64))
+emit("row_ptr", row_ptr, 'NR_LANES*4')
+emit("col_idx", col_idx, 'NR_LANES*4')
+emit("level", np.zeros(n, dtype=np.int32), 'NR_LANES*4')
+emit("queue", np.zeros(n, dtype=np.uint32), 'NR_LANES*4')
+emit("next", np.zeros(n, dtype=np.uint32), 'NR_LANES*4')
+emit("visited", np.zeros(bitmap_bytes, dtype=np.uint8), 'NR_LANES*4')
+emit("front", np.zeros(bitmap_bytes, dtype=np.uint8), 'NR_LANES*4')
+emit("front_next", np.zeros(bitmap_bytes, dtype=np.uint8), 'NR_LANES*4')
+emit("gold_level", gold_level, 'NR_LANES*4')
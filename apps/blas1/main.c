@@ -0,0 +1,131 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdint.h>
+#include <string.h>
+
+#include "bench.h"
+#include "runtime.h"
+#include "util.h"
+#include "vblas1/vblas1.h"
+#include "vcheck.h"
+
+#ifndef SPIKE
+#include "printf.h"
+#else
+#include <stdio.h>
+#endif
+
+#define THRESHOLD 0.0000001
+#define THRESHOLD_F32 0.0001
+
+extern uint64_t n;
+extern int64_t inc;
+extern double a;
+extern float af;
+extern double x[] __attribute__((aligned(4 * NR_LANES)));
+extern double y[] __attribute__((aligned(4 * NR_LANES)));
+extern double w[] __attribute__((aligned(4 * NR_LANES)));
+extern float xf[] __attribute__((aligned(4 * NR_LANES)));
+extern float yf[] __attribute__((aligned(4 * NR_LANES)));
+extern float wf[] __attribute__((aligned(4 * NR_LANES)));
+extern double gold_daxpy[] __attribute__((aligned(4 * NR_LANES)));
+extern float gold_saxpy[] __attribute__((aligned(4 * NR_LANES)));
+extern double gold_dscal[] __attribute__((aligned(4 * NR_LANES)));
+extern double gold_dcopy[] __attribute__((aligned(4 * NR_LANES)));
+extern double gold_dnrm2;
+extern double gold_dasum;
+extern uint64_t gold_idamax;
+
+static int check_scalar(const char *name, double res, double gold) {
+  double diff = res > gold ? res - gold : gold - res;
+  double mag = gold > 0 ? gold : -gold;
+  if (diff > THRESHOLD * (mag > 1 ? mag : 1)) {
+    printf("%s: Error. %f != %f\n", name, res, gold);
+    return 1;
+  }
+  printf("%s: Check okay. No errors.\n", name);
+  return 0;
+}
+
+int main() {
+  printf("\n");
+  printf("===========\n");
+  printf("=  BLAS1  =\n");
+  printf("===========\n");
+  printf("\n");
+  printf("\n");
+
+  printf("Elements: %lu, stride: %ld\n", n, inc);
+
+  const uint64_t len = n * inc;
+  const uint64_t bytes = n * sizeof(double);
+  int error = 0;
+
+  memcpy(w, y, len * sizeof(double));
+  start_timer();
+  daxpy(n, a, x, inc, w, inc);
+  stop_timer();
+  bench_report_bw("daxpy", 3 * bytes);
+  error |= vcheck_report("daxpy", vcheck_f64(w, gold_daxpy, len, THRESHOLD));
+
+  memcpy(wf, yf, len * sizeof(float));
+  start_timer();
+  saxpy(n, af, xf, inc, wf, inc);
+  stop_timer();
+  bench_report_bw("saxpy", 3 * n * sizeof(float));
+  error |= vcheck_report("saxpy",
+                         vcheck_f32(wf, gold_saxpy, len, THRESHOLD_F32));
+
+  memcpy(w, x, len * sizeof(double));
+  start_timer();
+  dscal(n, a, w, inc);
+  stop_timer();
+  bench_report_bw("dscal", 2 * bytes);
+  error |= vcheck_report("dscal", vcheck_f64(w, gold_dscal, len, THRESHOLD));
+
+  memcpy(w, y, len * sizeof(double));
+  start_timer();
+  dcopy(n, x, inc, w, inc);
+  stop_timer();
+  bench_report_bw("dcopy", 2 * bytes);
+  error |= vcheck_report("dcopy", vcheck_f64(w, gold_dcopy, len, THRESHOLD));
+
+  start_timer();
+  double nrm2 = dnrm2(n, x, inc);
+  stop_timer();
+  bench_report_bw("dnrm2", bytes);
+  error |= check_scalar("dnrm2", nrm2, gold_dnrm2);
+
+  start_timer();
+  double asum = dasum(n, x, inc);
+  stop_timer();
+  bench_report_bw("dasum", bytes);
+  error |= check_scalar("dasum", asum, gold_dasum);
+
+  start_timer();
+  uint64_t imax = idamax(n, x, inc);
+  stop_timer();
+  bench_report_bw("idamax", bytes);
+  if (imax != gold_idamax) {
+    printf("idamax: Error. %lu != %lu\n", imax, gold_idamax);
+    error = 1;
+  } else {
+    printf("idamax: Check okay. No errors.\n");
+  }
+
+  return error;
+}
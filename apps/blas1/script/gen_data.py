@@ -0,0 +1,82 @@
+#!/usr/bin/env python3
+# Copyright 2022 ETH Zurich and University of Bologna.
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+# arg1: number of elements, arg2: stride of the vectors (incx = incy)
+
+import numpy as np
+import os
+import sys
+
+sys.path.insert(0, os.path.join(os.path.dirname(__file__), '../../common/script'))
+from data_emit import emit as emit_data
+
+# Pad the FP32 arrays to whole double words
+def emit(name, array, alignment='8'):
+  emit_data(name, array, alignment, pad=8)
+
+############
+## SCRIPT ##
+############
+
+if len(sys.argv) == 3:
+  n   = int(sys.argv[1])
+  inc = int(sys.argv[2])
+else:
+  print("Error. Give me two arguments: the number of elements, and the stride.")
+  sys.exit()
+
+if inc < 1:
+  print("Error. The stride must be positive.")
+  sys.exit()
+
+# The vectors are the elements 0, inc, ..., (n - 1) * inc of the arrays
+length = n * inc
+a  = np.random.uniform(0.5, 1.5)
+x  = np.random.uniform(-1, 1, length)
+y  = np.random.uniform(-1, 1, length)
+xf = x.astype(np.float32)
+yf = y.astype(np.float32)
+xs = x[::inc]
+
+gold_daxpy = y.copy()
+gold_daxpy[::inc] += a * xs
+gold_saxpy = yf.copy()
+gold_saxpy[::inc] += np.float32(a) * xf[::inc]
+gold_dscal = x.copy()
+gold_dscal[::inc] *= a
+gold_dcopy = y.copy()
+gold_dcopy[::inc] = xs
+
+# Create the file
+print(".section .data,\"aw\",@progbits")
+emit("n", np.array(n, dtype=np.uint64))
+emit("inc", np.array(inc, dtype=np.int64))
+emit("a", np.array(a, dtype=np.float64))
+emit("af", np.array(a, dtype=np.float32))
+emit("x", x, 'NR_LANES*4')
+emit("y", y, 'NR_LANES*4')
+emit("w", np.zeros(length), 'NR_LANES*4')
+emit("xf", xf, 'NR_LANES*4')
+emit("yf", yf, 'NR_LANES*4')
+emit("wf", np.zeros(length, dtype=np.float32), 'NR_LANES*4')
+emit("gold_daxpy", gold_daxpy, 'NR_LANES*4')
+emit("gold_saxpy", gold_saxpy, 'NR_LANES*4')
+emit("gold_dscal", gold_dscal, 'NR_LANES*4')
+emit("gold_dcopy", gold_dcopy, 'NR_LANES*4')
+emit("gold_dnrm2", np.array(np.sqrt(np.dot(xs, xs)), dtype=np.float64))
+emit("gold_dasum", np.array(np.sum(np.abs(xs)), dtype=np.float64))
+emit("gold_idamax", np.array(np.argmax(np.abs(xs)), dtype=np.uint64))
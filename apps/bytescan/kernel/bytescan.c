@@ -0,0 +1,141 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "bytescan.h"
+
+// Bytes of b in the set
+static inline vbool1_t vin_set_u8m8(vuint8m8_t b, const uint8_t *set,
+                                    size_t nset, size_t vl) {
+  vbool1_t m = vmseq_vx_u8m8_b1(b, set[0], vl);
+  for (size_t j = 1; j < nset; ++j)
+    m = vmor_mm_b1(m, vmseq_vx_u8m8_b1(b, set[j], vl), vl);
+  return m;
+}
+
+static inline vbool4_t vin_set_u8m2(vuint8m2_t b, const uint8_t *set,
+                                    size_t nset, size_t vl) {
+  vbool4_t m = vmseq_vx_u8m2_b4(b, set[0], vl);
+  for (size_t j = 1; j < nset; ++j)
+    m = vmor_mm_b4(m, vmseq_vx_u8m2_b4(b, set[j], vl), vl);
+  return m;
+}
+
+void *vmemchr(const void *s, int c, size_t n) {
+  const uint8_t *p = s;
+  size_t vl;
+
+  for (; n > 0; n -= vl, p += vl) {
+    vl = vsetvl_e8m8(n);
+    vuint8m8_t b = vle8ff_v_u8m8(p, &vl, vl);
+    long first = vfirst_m_b1(vmseq_vx_u8m8_b1(b, (uint8_t)c, vl), vl);
+    if (first >= 0)
+      return (void *)(p + first);
+  }
+  return NULL;
+}
+
+size_t vfind_any(const uint8_t *s, size_t n, const uint8_t *set, size_t nset) {
+  size_t vl;
+
+  for (size_t i = 0; i < n; i += vl) {
+    vl = vsetvl_e8m8(n - i);
+    vuint8m8_t b = vle8ff_v_u8m8(s + i, &vl, vl);
+    long first = vfirst_m_b1(vin_set_u8m8(b, set, nset, vl), vl);
+    if (first >= 0)
+      return i + first;
+  }
+  return n;
+}
+
+size_t vsplit_any(const uint8_t *s, size_t n, const uint8_t *set, size_t nset,
+                  uint32_t *pos) {
+  size_t vl, cnt = 0;
+
+  for (size_t i = 0; i < n; i += vl) {
+    vl = vsetvl_e32m8(n - i);
+    vbool4_t m = vin_set_u8m2(vle8_v_u8m2(s + i, vl), set, nset, vl);
+    size_t found = vcpop_m_b4(m, vl);
+    if (found) {
+      vuint32m8_t idx = vadd_vx_u32m8(vid_v_u32m8(vl), i, vl);
+      vse32_v_u32m8(pos + cnt, vcompress_vm_u32m8(m, idx, idx, vl), found);
+      cnt += found;
+    }
+  }
+  return cnt;
+}
+
+int64_t vutf8_check(const uint8_t *s, size_t n) {
+  size_t vl;
+
+  for (size_t i = 0; i < n; i += vl) {
+    vl = vsetvl_e8m8(n - i);
+    vuint8m8_t b = vle8_v_u8m8(s + i, vl);
+
+    // An ASCII strip is valid after an ASCII byte: a sequence cut by the
+    // strip would have an error at its continuation bytes
+    const uint8_t c1 = i > 0 ? s[i - 1] : 0;
+    if (c1 < 0x80 && vfirst_m_b1(vmsgtu_vx_u8m8_b1(b, 0x7F, vl), vl) < 0)
+      continue;
+    const uint8_t c2 = i > 1 ? s[i - 2] : 0;
+    const uint8_t c3 = i > 2 ? s[i - 3] : 0;
+
+    // Bytes that are never in UTF-8
+    vbool1_t err = vmor_mm_b1(vmseq_vx_u8m8_b1(b, 0xC0, vl),
+                              vmseq_vx_u8m8_b1(b, 0xC1, vl), vl);
+    err = vmor_mm_b1(err, vmsgtu_vx_u8m8_b1(b, 0xF4, vl), vl);
+
+    // Second bytes of the overlong (E0, F0), surrogate (ED), and above
+    // U+10FFFF (F4) sequences
+    vuint8m8_t p1 = vslide1up_vx_u8m8(b, c1, vl);
+    err = vmor_mm_b1(err,
+                     vmand_mm_b1(vmseq_vx_u8m8_b1(p1, 0xE0, vl),
+                                 vmsltu_vx_u8m8_b1(b, 0xA0, vl), vl),
+                     vl);
+    err = vmor_mm_b1(err,
+                     vmand_mm_b1(vmseq_vx_u8m8_b1(p1, 0xED, vl),
+                                 vmsgtu_vx_u8m8_b1(b, 0x9F, vl), vl),
+                     vl);
+    err = vmor_mm_b1(err,
+                     vmand_mm_b1(vmseq_vx_u8m8_b1(p1, 0xF0, vl),
+                                 vmsltu_vx_u8m8_b1(b, 0x90, vl), vl),
+                     vl);
+    err = vmor_mm_b1(err,
+                     vmand_mm_b1(vmseq_vx_u8m8_b1(p1, 0xF4, vl),
+                                 vmsgtu_vx_u8m8_b1(b, 0x8F, vl), vl),
+                     vl);
+
+    // A continuation byte is due after a lead byte of 2 to 4 bytes, within
+    // its length. Only two groups of previous bytes are live
+    vbool1_t due = vmsgeu_vx_u8m8_b1(p1, 0xC0, vl);
+    vuint8m8_t p2 = vslide1up_vx_u8m8(p1, c2, vl);
+    due = vmor_mm_b1(due, vmsgeu_vx_u8m8_b1(p2, 0xE0, vl), vl);
+    p1 = vslide1up_vx_u8m8(p2, c3, vl);
+    due = vmor_mm_b1(due, vmsgeu_vx_u8m8_b1(p1, 0xF0, vl), vl);
+    vbool1_t cont = vmand_mm_b1(vmsgeu_vx_u8m8_b1(b, 0x80, vl),
+                                vmsltu_vx_u8m8_b1(b, 0xC0, vl), vl);
+    err = vmor_mm_b1(err, vmxor_mm_b1(cont, due, vl), vl);
+
+    long first = vfirst_m_b1(err, vl);
+    if (first >= 0)
+      return i + first;
+  }
+
+  // A sequence cut by the end
+  if ((n > 0 && s[n - 1] >= 0xC0) || (n > 1 && s[n - 2] >= 0xE0) ||
+      (n > 2 && s[n - 3] >= 0xF0))
+    return n;
+  return -1;
+}
@@ -0,0 +1,53 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Scans of byte streams, e.g., of text logs, at SEW 8 and LMUL 8. The bytes
+// of a strip are compared with vmseq, and the first match found with vfirst.m:
+//   vmemchr: as memchr, the first of the n bytes at s equal to c, or NULL.
+//            The fault-only-first loads stop at the end of the mapped memory,
+//            so that n can exceed the buffer if c is in it
+//   vfind_any: index of the first of the n bytes in the nset >= 1 bytes of
+//              set, or n, as strcspn on a buffer, e.g., the end of a JSON
+//              string at a quote or an escape. Same loads as vmemchr
+//   vsplit_any: writes to pos the indices of all the bytes of the set, the
+//               delimiters of the fields and the records of a CSV, and
+//               returns their number. The strips are of SEW 32 and LMUL 8,
+//               with the bytes at LMUL 2, so that vcompress packs the 32-bit
+//               indices of the matches
+//   vutf8_check: index of the first invalid byte of the n bytes at s, n if
+//                the last sequence is truncated, or -1 if s is valid UTF-8.
+//                A byte is invalid if it cannot be in UTF-8 (C0, C1, F5-FF),
+//                if it is a continuation byte where none is due after the
+//                previous three, or the other way around, or if it is the
+//                second byte of an overlong, surrogate, or out-of-range
+//                sequence. The previous bytes are the strip slid up with
+//                vslide1up, and the strips of ASCII bytes take a compare
+
+#ifndef _BYTESCAN_H_
+#define _BYTESCAN_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "riscv_vector.h"
+
+void *vmemchr(const void *s, int c, size_t n);
+size_t vfind_any(const uint8_t *s, size_t n, const uint8_t *set, size_t nset);
+size_t vsplit_any(const uint8_t *s, size_t n, const uint8_t *set, size_t nset,
+                  uint32_t *pos);
+int64_t vutf8_check(const uint8_t *s, size_t n);
+
+#endif
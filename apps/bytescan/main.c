@@ -0,0 +1,113 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdint.h>
+#include <string.h>
+
+#include "bench.h"
+#include "kernel/bytescan.h"
+#include "runtime.h"
+#include "util.h"
+#include "vcheck.h"
+
+#ifndef SPIKE
+#include "printf.h"
+#else
+#include <stdio.h>
+#endif
+
+extern uint64_t len;
+extern uint64_t needle;
+extern uint64_t njset;
+extern uint64_t ndset;
+extern uint8_t text[] __attribute__((aligned(4 * NR_LANES)));
+extern uint8_t bad[] __attribute__((aligned(4 * NR_LANES)));
+extern uint8_t jset[];
+extern uint8_t dset[];
+extern uint32_t pos[] __attribute__((aligned(4 * NR_LANES)));
+extern uint64_t gold_chr;
+extern uint64_t gold_any;
+extern uint64_t gold_npos;
+extern uint32_t gold_pos[] __attribute__((aligned(4 * NR_LANES)));
+extern int64_t gold_bad;
+
+static int check(const char *name, int64_t result, int64_t gold) {
+  if (result != gold) {
+    printf("%s: Error. %ld != %ld\n", name, result, gold);
+    return 1;
+  }
+  printf("%s: Check okay. No errors.\n", name);
+  return 0;
+}
+
+int main() {
+  printf("\n");
+  printf("==============\n");
+  printf("=  BYTESCAN  =\n");
+  printf("==============\n");
+  printf("\n");
+  printf("\n");
+
+  printf("Bytes: %lu, delimiters: %lu\n", len, gold_npos);
+
+  int error = 0;
+
+  start_timer();
+  size_t l = strlen((const char *)text);
+  stop_timer();
+  bench_report_bw("strlen", len);
+  error |= check("strlen", l, len);
+
+  start_timer();
+  const uint8_t *c = vmemchr(text, needle, len);
+  stop_timer();
+  bench_report_bw("vmemchr", gold_chr + 1);
+  error |= check("vmemchr", c ? c - text : -1, gold_chr);
+
+  start_timer();
+  size_t any = vfind_any(text, len, jset, njset);
+  stop_timer();
+  bench_report_bw("vfind_any", gold_any + 1);
+  error |= check("vfind_any", any, gold_any);
+
+  start_timer();
+  size_t npos = vsplit_any(text, len, dset, ndset, pos);
+  stop_timer();
+  bench_report_bw("vsplit_any", len);
+  error |= check("vsplit_any", npos, gold_npos);
+  if (npos == gold_npos) {
+    int64_t idx = vcheck_i32((int32_t *)pos, (int32_t *)gold_pos, npos);
+    if (idx >= 0) {
+      printf("vsplit_any: Error at delimiter %d. %d != %d\n", idx, pos[idx],
+             gold_pos[idx]);
+      error = 1;
+    }
+  }
+
+  start_timer();
+  int64_t valid = vutf8_check(text, len);
+  stop_timer();
+  bench_report_bw("vutf8_check", len);
+  error |= check("vutf8_check", valid, -1);
+
+  start_timer();
+  int64_t invalid = vutf8_check(bad, len);
+  stop_timer();
+  bench_report_bw("vutf8_check (invalid)", gold_bad);
+  error |= check("vutf8_check (invalid)", invalid, gold_bad);
+
+  return error;
+}
@@ -0,0 +1,100 @@
+#!/usr/bin/env python3
+# Copyright 2022 ETH Zurich and University of Bologna.
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+# arg1: bytes of the text, arg2: percentage of the non-ASCII words
+#
+# The text is a CSV log, a line per record, of UTF-8 messages, closed by a
+# quote, as the end of a JSON string value: vmemchr looks for the quote, and
+# vfind_any for the quote or a backslash, so that both scan the whole text.
+# vsplit_any looks for the commas and the newlines. The invalid copy of the
+# text has an ASCII byte instead of the continuation byte of its first
+# multi-byte character after the middle, or an 0xFF byte in the middle.
+
+import numpy as np
+import os
+import random
+import sys
+
+sys.path.insert(0, os.path.join(os.path.dirname(__file__), '../../common/script'))
+from data_emit import emit
+
+ASCII_WORDS = ['request', 'served', 'in', 'ms', 'user', 'login', 'failed', 'cache',
+               'miss', 'for', 'key', 'retry', 'timeout', 'connection', 'closed', 'ok']
+UTF8_WORDS = ['café', 'naïve', 'Zürich', 'Ω', '日本語', 'данные', '🚀', 'señal', '€']
+LEVELS = ['INFO', 'WARN', 'ERROR', 'DEBUG']
+
+def line(i, pct):
+  words = [random.choice(UTF8_WORDS) if random.random() * 100 < pct
+           else random.choice(ASCII_WORDS) for _ in range(random.randint(3, 12))]
+  return '%d,node%02d,%s,%s\n' % (1700000000 + i, random.randint(0, 63),
+                                  random.choice(LEVELS), ' '.join(words))
+
+############
+## SCRIPT ##
+############
+
+if len(sys.argv) == 3:
+  length = int(sys.argv[1])
+  pct    = float(sys.argv[2])
+else:
+  print("Error. Give me two arguments: the bytes of the text, and the percentage of the non-ASCII words.")
+  sys.exit()
+
+assert length >= 2, "the text needs at least two bytes"
+
+buf = bytearray()
+i = 0
+while len(buf) < length:
+  buf += line(i, pct).encode('utf-8')
+  i += 1
+# Cut at a character, pad with spaces, and close with the quote
+cut = length - 1
+while cut > 0 and 0x80 <= buf[cut] < 0xC0:
+  cut -= 1
+buf = buf[:cut] + b' ' * (length - 1 - cut) + b'"'
+text = np.frombuffer(bytes(buf), dtype=np.uint8)
+
+jset = np.frombuffer(b'"\\', dtype=np.uint8)
+dset = np.frombuffer(b',\n', dtype=np.uint8)
+gold_pos = np.flatnonzero(np.isin(text, dset)).astype(np.uint32)
+
+bad = text.copy()
+lead = np.flatnonzero(bad[length // 2:] >= 0xC2)
+if len(lead) > 0 and length // 2 + lead[0] + 1 < length:
+  gold_bad = length // 2 + int(lead[0]) + 1
+  bad[gold_bad] = ord('x')
+else:
+  gold_bad = length // 2
+  bad[gold_bad] = 0xFF
+assert bytes(text).decode('utf-8')
+
+# Create the file. The texts are NUL-terminated for strlen
+print(".section .data,\"aw\",@progbits")
+emit("len", np.array(length, dtype=np.uint64))
+emit("needle", np.array(ord('"'), dtype=np.uint64))
+emit("njset", np.array(len(jset), dtype=np.uint64))
+emit("ndset", np.array(len(dset), dtype=np.uint64))
+emit("text", np.append(text, np.uint8(0)), 'NR_LANES*4')
+emit("bad", np.append(bad, np.uint8(0)), 'NR_LANES*4')
+emit("jset", jset)
+emit("dset", dset)
+emit("pos", np.zeros(max(len(gold_pos), 1), dtype=np.uint32), 'NR_LANES*4')
+emit("gold_chr", np.array(length - 1, dtype=np.uint64))
+emit("gold_any", np.array(length - 1, dtype=np.uint64))
+emit("gold_npos", np.array(len(gold_pos), dtype=np.uint64))
+emit("gold_pos", gold_pos, 'NR_LANES*4')
+emit("gold_bad", np.array(gold_bad, dtype=np.int64))
@@ -0,0 +1,142 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Benchmarking harness of the apps/benchmarks kernels
+
+#include "bench.h"
+#include "runtime.h"
+#include "trace.h"
+#include "util.h"
+
+#if BENCH_ITER > BENCH_MAX_ITER
+#error "BENCH_ITER cannot be larger than BENCH_MAX_ITER"
+#endif
+
+// Time one call of the kernel
+static int64_t bench_once(bench_kernel_t kernel, uint64_t n) {
+  start_timer();
+  kernel(n);
+  stop_timer();
+  return get_timer();
+}
+
+// Sort the runtimes (few elements)
+static void bench_sort(int64_t *runtimes, int nr) {
+  for (int i = 1; i < nr; ++i) {
+    int64_t r = runtimes[i];
+    int j = i - 1;
+    for (; j >= 0 && runtimes[j] > r; --j)
+      runtimes[j + 1] = runtimes[j];
+    runtimes[j + 1] = r;
+  }
+}
+
+// Time nr calls of kernel(n), and return the median runtime
+static int64_t bench_median(bench_kernel_t kernel, uint64_t n, int nr,
+                            int64_t *min, int64_t *max) {
+  int64_t runtimes[BENCH_MAX_ITER];
+  for (int i = 0; i < nr; ++i)
+    runtimes[i] = bench_once(kernel, n);
+  bench_sort(runtimes, nr);
+  *min = runtimes[0];
+  *max = runtimes[nr - 1];
+  return runtimes[nr / 2];
+}
+
+int64_t bench_run(bench_kernel_t kernel, uint64_t n) {
+  int64_t runtimes[BENCH_MAX_ITER];
+  int nr = BENCH_ITER;
+
+  // The HW counter measures the first repetition only
+  HW_CNT_READY;
+  runtimes[0] = bench_once(kernel, n);
+  HW_CNT_NOT_READY;
+#ifdef TRACE_EN
+  trace_record(TRACE_SW_CYCLES, runtimes[0]);
+#else
+  printf("[sw-cycles]: %ld\n", runtimes[0]);
+#endif
+
+#ifdef SPIKE
+  // The vector trace must contain only the HW-counted repetition
+  nr = 1;
+#endif
+
+  for (int i = 1; i < nr; ++i)
+    runtimes[i] = bench_once(kernel, n);
+  bench_sort(runtimes, nr);
+#ifdef TRACE_EN
+  trace_record(TRACE_SW_CYCLES_STATS | TRACE_MORE, runtimes[0]);
+  trace_record(TRACE_SW_CYCLES_STATS | TRACE_MORE, runtimes[nr / 2]);
+  trace_record(TRACE_SW_CYCLES_STATS | TRACE_MORE, runtimes[nr - 1]);
+  trace_record(TRACE_SW_CYCLES_STATS, nr);
+#else
+  printf("[sw-cycles-stats]: %ld %ld %ld %d\n", runtimes[0], runtimes[nr / 2],
+         runtimes[nr - 1], nr);
+#endif
+
+  return runtimes[nr / 2];
+}
+
+void bench_fit(bench_kernel_t kernel, uint64_t n_max, uint64_t align) {
+#ifndef SPIKE
+  double sx = 0, sy = 0, sxx = 0, sxy = 0;
+  int nr = 0;
+  uint64_t last_n = 0;
+
+  for (int k = 1; k <= BENCH_FIT_SIZES; ++k) {
+    uint64_t n = (n_max * k / BENCH_FIT_SIZES) / align * align;
+    if (n == 0 || n == last_n)
+      continue;
+    int64_t min, max;
+    double x = n;
+    double y = bench_median(kernel, n, BENCH_ITER, &min, &max);
+    sx += x;
+    sy += y;
+    sxx += x * x;
+    sxy += x * y;
+    last_n = n;
+    nr++;
+  }
+
+  // Least-squares fit of cycles = intercept + slope * n
+  double den = nr * sxx - sx * sx;
+  if (nr < 2 || den == 0) {
+    printf("[cycles-per-elem]: too few sizes to fit\n");
+    return;
+  }
+  double slope = (nr * sxy - sx * sy) / den;
+  double intercept = (sy - slope * sx) / nr;
+  printf("[cycles-per-elem]: %f %f\n", slope, intercept);
+#endif
+}
+
+void bench_report_bw(const char *name, uint64_t bytes) {
+  int64_t runtime = get_timer();
+  float bw = (float)bytes / runtime;
+  printf("%s: %ld cycles, %f B/cycle (%f%% of the %d B/cycle peak).\n", name,
+         runtime, bw, 100 * bw / BENCH_AXI_PEAK_BYTES, BENCH_AXI_PEAK_BYTES);
+}
+
+void bench_report_rate(const char *name, uint64_t items, const char *unit) {
+  int64_t runtime = get_timer();
+  printf("%s: %ld cycles, %f %s/cycle.\n", name, runtime,
+         (float)items / runtime, unit);
+}
+
+void bench_report_flops(const char *name, uint64_t flops) {
+  bench_report_rate(name, flops, "FLOP");
+}
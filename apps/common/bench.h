@@ -0,0 +1,72 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Benchmarking harness of the apps/benchmarks kernels (header file)
+//
+// The kernel under test is wrapped in a bench_kernel_t, called with the
+// problem size. bench_run() times BENCH_ITER repetitions, and bench_fit()
+// estimates the steady-state cycles per element over BENCH_FIT_SIZES sizes.
+// The results are printed as:
+//   [sw-cycles]: first repetition, measured also by the HW counter
+//   [sw-cycles-stats]: min median max repetitions
+//   [cycles-per-elem]: slope intercept, of cycles = intercept + slope * n
+//
+// With SPIKE, the kernel runs once and nothing is fitted, so that the vector
+// trace of the ideal dispatcher matches the HW-counted repetition.
+
+#ifndef __BENCH_H__
+#define __BENCH_H__
+
+#include <stdint.h>
+
+// Timed repetitions of bench_run()
+#ifndef BENCH_ITER
+#define BENCH_ITER 1
+#endif
+
+#define BENCH_MAX_ITER 64
+
+// Sizes of bench_fit(), fractions of the full size
+#ifndef BENCH_FIT_SIZES
+#define BENCH_FIT_SIZES 4
+#endif
+
+// Kernel under test, called with the problem size n
+typedef void (*bench_kernel_t)(uint64_t n);
+
+// Time BENCH_ITER calls of kernel(n), and return the median runtime.
+// The HW counter is enabled only for the first call.
+int64_t bench_run(bench_kernel_t kernel, uint64_t n);
+
+// Time kernel(n) for BENCH_FIT_SIZES sizes up to n_max, multiple of align,
+// and fit the median runtimes with a line
+void bench_fit(bench_kernel_t kernel, uint64_t n_max, uint64_t align);
+
+// Peak bandwidth of the AXI bus of Ara, 32 bits per lane
+#define BENCH_AXI_PEAK_BYTES (4 * NR_LANES)
+
+// Print the cycles of the last timed region, and the bytes it moved from/to
+// memory per cycle with respect to the AXI peak
+void bench_report_bw(const char *name, uint64_t bytes);
+
+// Print the cycles of the last timed region, and the items it processed per
+// cycle, e.g., bench_report_rate("blur5_u8", n, "pixels")
+void bench_report_rate(const char *name, uint64_t items, const char *unit);
+
+// bench_report_rate() in FLOP
+void bench_report_flops(const char *name, uint64_t flops);
+
+#endif
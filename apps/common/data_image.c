@@ -0,0 +1,65 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stddef.h>
+#include <string.h>
+
+#include "data_image.h"
+#include "printf.h"
+
+#ifndef SPIKE
+// Defined by the linker script
+extern uint8_t data_image[];
+extern uint8_t l2_alloc_base[];
+extern volatile uint64_t eoc_address_reg;
+#endif
+
+const data_image_hdr_t *data_image_hdr() {
+#ifdef SPIKE
+  return NULL;
+#else
+  const data_image_hdr_t *hdr = (const data_image_hdr_t *)data_image;
+  // The image must not overlap the sections of the program
+  if (hdr->magic != DATA_IMAGE_MAGIC || (uintptr_t)data_image < (uintptr_t)l2_alloc_base)
+    return NULL;
+  return hdr;
+#endif
+}
+
+void *data_image_get(const char *name, void *linked) {
+  const data_image_hdr_t *hdr = data_image_hdr();
+  if (!hdr)
+    return linked;
+
+  for (uint64_t i = 0; i < hdr->nr_entries; ++i)
+    if (!strcmp(hdr->entries[i].name, name))
+      return (uint8_t *)hdr + hdr->entries[i].offset;
+
+  printf("Error: the data image (%s) has no symbol %s.\n", hdr->args, name);
+#ifndef SPIKE
+  eoc_address_reg = -1;
+#endif
+  while (1)
+    ;
+}
+
+void data_image_print() {
+  const data_image_hdr_t *hdr = data_image_hdr();
+  if (hdr)
+    printf("[data-image]: %s\n", hdr->args);
+  else
+    printf("[data-image]: linked\n");
+}
@@ -0,0 +1,77 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Datasets loaded at runtime. A data image is the content of a data.S (the
+// output of the gen_data.py of an app), converted by scripts/data_image.py into
+// a raw binary that the Verilator testbench loads at data_image, in the upper
+// half of the DRAM (make -C hardware simv data_bin=FILE). The image starts
+// with a header that lists its symbols, so that one binary can run a whole
+// sweep of problem sizes, without being compiled and linked again.
+// The programs built with -DDATA_IMAGE (data_image=1) access the symbols of
+// data.S through DATA_SYM(sym), which reads sym from the image if one is
+// loaded, and the symbol linked from data.S otherwise (e.g., on Spike).
+
+#ifndef _DATA_IMAGE_H_
+#define _DATA_IMAGE_H_
+
+#include <stdint.h>
+
+// "ARADATA1", little endian
+#define DATA_IMAGE_MAGIC 0x3141544144415241ULL
+#define DATA_IMAGE_NAME_LEN 32
+#define DATA_IMAGE_ARGS_LEN 64
+
+// A symbol of the image, at offset bytes from the header
+typedef struct {
+  char name[DATA_IMAGE_NAME_LEN];
+  uint64_t offset;
+  uint64_t size;
+} data_image_entry_t;
+
+typedef struct {
+  uint64_t magic;
+  // Bytes of the image, header included
+  uint64_t size;
+  uint64_t nr_entries;
+  // Description of the dataset, e.g., the arguments of gen_data.py
+  char args[DATA_IMAGE_ARGS_LEN];
+  data_image_entry_t entries[];
+} data_image_hdr_t;
+
+// Return the header of the loaded image, or NULL if there is none
+const data_image_hdr_t *data_image_hdr();
+
+// Return the address of the symbol name of the loaded image, or linked if
+// there is no image. Stop the program if the image has no such symbol.
+void *data_image_get(const char *name, void *linked);
+
+// Print the description of the dataset in use
+void data_image_print();
+
+#ifdef DATA_IMAGE
+// The address of sym is looked up once per use site
+#define DATA_SYM(sym)                                                          \
+  (*({                                                                         \
+    static __typeof__(&(sym)) data_sym_addr_;                                  \
+    if (!data_sym_addr_)                                                       \
+      data_sym_addr_ = data_image_get(#sym, (void *)&(sym));                   \
+    data_sym_addr_;                                                            \
+  }))
+#else
+#define DATA_SYM(sym) (sym)
+#endif
+
+#endif // _DATA_IMAGE_H_
@@ -2,17 +2,29 @@
 
 # Matrix sizes
 def_args_imatmul     = "128 128 128"
+def_args_imatmul_i8  = "128 128 128"
+def_args_imatmul_i16 = "128 128 128"
 def_args_fmatmul     = "128 128 128"
+def_args_fmatmul_f32 = "128 128 128"
+def_args_fmatmul_f16 = "128 128 128"
+# Matrix sizes, batch size
+def_args_fmatmul_batched = "16 16 16 32"
+# Matrix sizes
+def_args_fgemv       = "128 256"
 # Matrix size, filter size
 def_args_iconv2d     = "112 7"
 def_args_fconv2d     = "112 7"
 def_args_fconv3d     = "112 7"
+# Batch, input channels, output channels, height, width, filter size, stride, padding
+def_args_conv2d_layer = "1 16 16 32 32 3 1 1"
 # Vector size
 def_args_fdotproduct = "512"
 # Vector size
 def_args_dotproduct  = "512"
 # Matrix padded size 0, matrix padded size 1, onlyvec
 def_args_jacobi2d    = "130 130"
+# Depth, rows, and columns of the grid
+def_args_stencil     = "4 64 64"
 # Vector size
 def_args_dropout     = "1024"
 # Vector size, data-type
@@ -29,3 +41,63 @@ def_args_softmax     = "3 256"
 def_args_pathfinder  = "1 1024 64"
 # Batch_size, depth, height, width, n_boxes (in total), crop_h, crop_w
 def_args_roi_align   = "1 32 4 4 4 2 2"
+# Rows, columns, non-zeros per row, and sparsity pattern of the matrix
+def_args_spmv        = "128 128 8 uniform"
+# Rows and columns of the activations
+def_args_layernorm   = "4 256"
+# Sequence length and head dimension
+def_args_attention   = "64 32"
+# Number of keys, or rsort for the dataset of the riscv-tests
+def_args_sort        = "rsort"
+# Elements, and bins of the 16-bit histogram
+def_args_hist_scan   = "4096 1024"
+# Elements, and stride of the vectors
+def_args_blas1       = "4096 1"
+# Number of elements
+def_args_vfredsum_repro = "4096"
+# Channels, height (= width), stride, and pooling window
+def_args_dwconv      = "32 28 1 3"
+# Rows, columns, and inner dimension of the GEMMs
+def_args_activation  = "4 256 64"
+# Rows and columns, and shift of the requantization
+def_args_quant       = "16 256 8"
+# Batches, channels, and height * width of the tensors
+def_args_transpose   = "1 32 256"
+# Size of the systems
+def_args_linsolve    = "64"
+# Queries, database vectors, vector size, and neighbors
+def_args_knn         = "8 1024 64 10"
+# Elements of the STREAM kernels and of the strided loads and gathers, and stride
+def_args_stream      = "4096 256 8"
+# Number of keys, and bytes per key
+def_args_hash        = "1024 64"
+# Rows and columns of the RGB image, and of the resize of its blurred luma
+def_args_imgproc     = "36 68 24 48"
+# Options of Black-Scholes, and paths and steps of the Monte-Carlo simulation
+def_args_option      = "256 1024 16"
+# Rows and columns of the table, bags, their average length, and Zipf exponent
+def_args_embedding   = "4096 16 64 8 1.05"
+# Inputs, hidden units, batch, and timesteps of the recurrent cells
+def_args_rnn         = "64 128 8 4"
+# Height and width, channels, and expansion of the images, and tokens and model
+# dimension of the encoder layer
+def_args_dnn         = "8 32 4 64 64"
+# Rows and columns of the 2:4 sparse matrix, and columns of the dense one
+def_args_spmatmul    = "64 128 64"
+# Input and output channels, height and width of the images, and filter size of
+# the 2D correlation, and samples and filter size of the 1D one
+def_args_fftconv     = "2 2 64 64 11 4096 127"
+# AES blocks, SHA-256 messages, and blocks per message
+def_args_crypto      = "256 32 4"
+# Scale (log2 of the vertices) and edge factor of the R-MAT graph
+def_args_bfs         = "10 8"
+# Points, dimensions, centroids, and iterations of the k-means clustering
+def_args_kmeans      = "1024 8 16 4"
+# Bytes of the text, and percentage of its non-ASCII words
+def_args_bytescan    = "16384 10"
+# SEW and LMUL of the instruction tests
+def_args_vinsn_bench = "64 1"
+# Vector size
+def_args_mt-vvadd    = "4096"
+# Matrix sizes
+def_args_mt-matmul   = "64 64 64"
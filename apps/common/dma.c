@@ -0,0 +1,77 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdint.h>
+
+#include "dma.h"
+
+// Registers of the DMA engine, see ara_dma.sv
+enum dma_reg_e {
+  DMA_SRC = 0,
+  DMA_DST,
+  DMA_LEN,
+  DMA_SRC_STRIDE,
+  DMA_DST_STRIDE,
+  DMA_REPS,
+  DMA_LAUNCH,
+  DMA_DONE
+};
+
+extern volatile uint64_t dma_reg[];
+
+// Number of copies queued since the reset. crt0 does not clear the .bss.
+static uint64_t dma_launched __attribute__((section(".data"))) = 0;
+
+static inline void dma_fence() { asm volatile("fence" ::: "memory"); }
+
+uint64_t dma_start_2d(void *dst, const void *src, uint64_t len, uint64_t reps,
+                      uint64_t dst_stride, uint64_t src_stride) {
+#ifdef SPIKE
+  for (uint64_t r = 0; r < reps; ++r)
+    for (uint64_t b = 0; b < len; ++b)
+      ((uint8_t *)dst)[r * dst_stride + b] =
+          ((const uint8_t *)src)[r * src_stride + b];
+#else
+  dma_fence();
+
+  // Wait for a free entry of the queue
+  while (dma_launched - dma_reg[DMA_DONE] >= DMA_QUEUE_DEPTH)
+    ;
+
+  dma_reg[DMA_SRC] = (uint64_t)src;
+  dma_reg[DMA_DST] = (uint64_t)dst;
+  dma_reg[DMA_LEN] = len;
+  dma_reg[DMA_SRC_STRIDE] = src_stride;
+  dma_reg[DMA_DST_STRIDE] = dst_stride;
+  dma_reg[DMA_REPS] = reps;
+  dma_reg[DMA_LAUNCH] = 1;
+#endif
+
+  return ++dma_launched;
+}
+
+void dma_wait(uint64_t ticket) {
+#ifndef SPIKE
+  while (dma_reg[DMA_DONE] < ticket)
+    ;
+
+  dma_fence();
+#else
+  (void)ticket;
+#endif
+}
+
+void dma_wait_all() { dma_wait(dma_launched); }
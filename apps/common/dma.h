@@ -0,0 +1,50 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Driver of the DMA engine of the SoC, which copies 1D and 2D tiles between
+// regions of the L2 memory while the harts compute. The copies are queued and
+// executed in order. A single hart programs the engine.
+// The engine reads and writes the L2 directly: dma_start fences, so that the
+// source is in the L2 and Ara is done with it, and dma_wait fences, so that
+// CVA6 does not read stale lines of the destination from its data cache.
+// On Spike, the copies are executed synchronously by the hart.
+
+#ifndef _DMA_H_
+#define _DMA_H_
+
+#include <stdint.h>
+
+// Descriptors that the engine can queue
+#define DMA_QUEUE_DEPTH 4
+
+// Queue the copy of reps rows of len bytes from src to dst. The rows start
+// every src_stride bytes in the source, and every dst_stride bytes in the
+// destination. Return the ticket of the copy, to wait for it.
+uint64_t dma_start_2d(void *dst, const void *src, uint64_t len, uint64_t reps,
+                      uint64_t dst_stride, uint64_t src_stride);
+
+// Queue the copy of len bytes from src to dst
+static inline uint64_t dma_start(void *dst, const void *src, uint64_t len) {
+  return dma_start_2d(dst, src, len, 1, 0, 0);
+}
+
+// Wait until the copy with the ticket, and the ones before it, are complete
+void dma_wait(uint64_t ticket);
+
+// Wait until all the queued copies are complete
+void dma_wait_all();
+
+#endif // _DMA_H_
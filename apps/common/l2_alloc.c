@@ -0,0 +1,78 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdint.h>
+
+#include "data_image.h"
+#include "l2_alloc.h"
+#include "printf.h"
+
+// The stacks of the harts are at the end of the DRAM, HART_STACK_SIZE each,
+// as set up by crt0.S
+#define HART_STACK_SIZE 0x100000
+
+#ifdef SPIKE
+static uint8_t l2_arena[L2_ARENA_SPIKE_SIZE]
+    __attribute__((aligned(L2_ALIGN), section(".l2")));
+#define L2_ARENA_BASE ((uintptr_t)l2_arena)
+#define L2_ARENA_END ((uintptr_t)l2_arena + L2_ARENA_SPIKE_SIZE)
+#else
+// Defined by the linker script
+extern uint8_t l2_alloc_base[];
+extern volatile uint64_t dram_end_address_reg;
+#define L2_ARENA_BASE ((uintptr_t)l2_alloc_base)
+#define L2_ARENA_END l2_arena_end()
+
+// The arena ends at the data image, if one is loaded (data_image.h)
+static uintptr_t l2_arena_end() {
+  const data_image_hdr_t *hdr = data_image_hdr();
+  if (hdr)
+    return (uintptr_t)hdr;
+  return dram_end_address_reg - NR_CORES * HART_STACK_SIZE;
+}
+#endif
+
+// Top of the arena, 0 before the first allocation. crt0 does not clear the
+// .bss.
+static uintptr_t l2_top __attribute__((section(".data"))) = 0;
+
+static inline uintptr_t l2_top_get() { return l2_top ? l2_top : L2_ARENA_BASE; }
+
+void *l2_alloc(size_t size, size_t align) {
+  if (!align)
+    align = L2_ALIGN;
+
+  uintptr_t addr = (l2_top_get() + align - 1) & ~(uintptr_t)(align - 1);
+  uintptr_t end = L2_ARENA_END;
+  if (addr > end || size > end - addr) {
+    printf("Error: l2_alloc of %ld bytes overflows the L2 arena (%ld free).\n",
+           (long)size, (long)l2_free());
+    return NULL;
+  }
+
+  l2_top = addr + size;
+  return (void *)addr;
+}
+
+l2_mark_t l2_mark() { return l2_top_get(); }
+
+void l2_release(l2_mark_t mark) { l2_top = mark; }
+
+size_t l2_free() {
+  uintptr_t top = l2_top_get();
+  uintptr_t end = L2_ARENA_END;
+  return top < end ? end - top : 0;
+}
@@ -0,0 +1,53 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Arena allocator of the L2 memory left free after the sections of the
+// binary, from l2_alloc_base up to the stacks of the harts at the end of the
+// DRAM, or up to the data image if one is loaded (data_image.h). The buffers
+// are allocated by bumping a pointer, and are freed together by releasing the
+// arena to a previous mark. A single hart allocates.
+// On Spike, the arena is a static buffer of L2_ARENA_SPIKE_SIZE bytes.
+
+#ifndef _L2_ALLOC_H_
+#define _L2_ALLOC_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Default alignment of the buffers, that of the .l2 sections of data.S
+#define L2_ALIGN (32 * NR_LANES)
+
+#ifndef L2_ARENA_SPIKE_SIZE
+#define L2_ARENA_SPIKE_SIZE 0x400000
+#endif
+
+// Position of the arena, to release the buffers allocated after it
+typedef uintptr_t l2_mark_t;
+
+// Allocate size bytes aligned to align bytes, a power of two, or to L2_ALIGN
+// if align is 0. Return NULL if the buffer would overlap the stacks.
+void *l2_alloc(size_t size, size_t align);
+
+// Mark the current position of the arena
+l2_mark_t l2_mark();
+
+// Free all the buffers allocated after the mark
+void l2_release(l2_mark_t mark);
+
+// Free bytes of the arena
+size_t l2_free();
+
+#endif // _L2_ALLOC_H_
@@ -0,0 +1,101 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "prof.h"
+#include "trace.h"
+
+// crt0 does not clear the .bss
+static struct prof_region prof_regions[PROF_MAX_REGIONS]
+    __attribute__((section(".data"))) = {{0}};
+static const char *prof_names[PROF_MAX_REGIONS]
+    __attribute__((section(".data"))) = {0};
+// Stack of the open regions
+static uint32_t prof_stack[PROF_MAX_DEPTH] __attribute__((section(".data"))) = {
+    0};
+static uint32_t prof_depth __attribute__((section(".data"))) = 0;
+
+void prof_begin(uint32_t id) {
+  if (id >= PROF_MAX_REGIONS || prof_depth == PROF_MAX_DEPTH)
+    return;
+
+  struct prof_region *r = &prof_regions[id];
+  if (!r->calls)
+    r->parent = prof_depth ? prof_stack[prof_depth - 1] : PROF_NO_PARENT;
+  prof_stack[prof_depth++] = id;
+
+  // Read the cycles last, so that the region does not count the reads of the
+  // performance counters
+  for (int e = 0; e < PERF_NR_EVENTS; ++e)
+    r->start_perf_cnt[e] = read_perf_cnt(e);
+  r->start_cycles = get_cycle_count();
+}
+
+void prof_end(uint32_t id) {
+  int64_t cycles = get_cycle_count();
+
+  // Close the regions in the order they were opened
+  if (!prof_depth || prof_stack[prof_depth - 1] != id)
+    return;
+  --prof_depth;
+
+  struct prof_region *r = &prof_regions[id];
+  r->cycles += cycles - r->start_cycles;
+  for (int e = 0; e < PERF_NR_EVENTS; ++e)
+    r->perf_cnt[e] += read_perf_cnt(e) - r->start_perf_cnt[e];
+  r->calls++;
+}
+
+void prof_name(uint32_t id, const char *name) {
+  if (id < PROF_MAX_REGIONS)
+    prof_names[id] = name;
+}
+
+void prof_dump() {
+  // The trace records carry no strings
+  for (uint32_t id = 0; id < PROF_MAX_REGIONS; ++id)
+    if (prof_regions[id].calls && prof_names[id])
+      printf("[prof-name]: %d %s\n", id, prof_names[id]);
+
+  for (uint32_t id = 0; id < PROF_MAX_REGIONS; ++id) {
+    struct prof_region *r = &prof_regions[id];
+    if (!r->calls)
+      continue;
+#ifdef TRACE_EN
+    trace_record(TRACE_PROF | TRACE_MORE, id);
+    trace_record(TRACE_PROF | TRACE_MORE, r->parent);
+    trace_record(TRACE_PROF | TRACE_MORE, r->calls);
+    trace_record(TRACE_PROF | TRACE_MORE, r->cycles);
+    for (int e = 0; e < PERF_NR_EVENTS - 1; ++e)
+      trace_record(TRACE_PROF | TRACE_MORE, r->perf_cnt[e]);
+    trace_record(TRACE_PROF, r->perf_cnt[PERF_NR_EVENTS - 1]);
+#else
+    printf("[prof]: %d %d %ld %ld", id, r->parent, r->calls, r->cycles);
+    for (int e = 0; e < PERF_NR_EVENTS; ++e)
+      printf(" %ld", r->perf_cnt[e]);
+    printf("\n");
+#endif
+  }
+}
+
+void prof_reset() {
+  for (uint32_t id = 0; id < PROF_MAX_REGIONS; ++id) {
+    prof_regions[id].calls = 0;
+    prof_regions[id].cycles = 0;
+    for (int e = 0; e < PERF_NR_EVENTS; ++e)
+      prof_regions[id].perf_cnt[e] = 0;
+  }
+  prof_depth = 0;
+}
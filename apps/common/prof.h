@@ -0,0 +1,72 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Profiling of the regions of a program. PROF_BEGIN(id) and PROF_END(id)
+// enclose a region, and accumulate its cycles and the hardware performance
+// counters into the entry id of a table. The regions can be nested, and the
+// parent of a region is the region open when it is entered for the first
+// time. PROF_DUMP() prints the table, and scripts/prof_report.py prints it as
+// a hierarchical profile.
+// The macros expand to nothing, unless the program is built with -DPROF
+// (prof=1). The performance counters count only while the HW counter is
+// enabled (HW_CNT_READY), and are zero on Spike.
+// A single hart profiles.
+
+#ifndef _PROF_H_
+#define _PROF_H_
+
+#include <stdint.h>
+
+#include "runtime.h"
+
+// Entries of the table, and maximum nesting of the regions
+#define PROF_MAX_REGIONS 16
+#define PROF_MAX_DEPTH 8
+// Parent of the top-level regions
+#define PROF_NO_PARENT PROF_MAX_REGIONS
+
+struct prof_region {
+  uint64_t calls;
+  int64_t cycles;
+  uint64_t perf_cnt[PERF_NR_EVENTS];
+  uint32_t parent;
+  // Snapshots at the beginning of the open region
+  int64_t start_cycles;
+  uint64_t start_perf_cnt[PERF_NR_EVENTS];
+};
+
+void prof_begin(uint32_t id);
+void prof_end(uint32_t id);
+// Name the region id in the dump
+void prof_name(uint32_t id, const char *name);
+// Print the table: one "[prof-name]: id name" line per named region, and one
+// "[prof]: id parent calls cycles perf_cnt..." record per entered region
+void prof_dump();
+void prof_reset();
+
+#ifdef PROF
+#define PROF_BEGIN(id) prof_begin(id)
+#define PROF_END(id) prof_end(id)
+#define PROF_NAME(id, name) prof_name(id, name)
+#define PROF_DUMP() prof_dump()
+#else
+#define PROF_BEGIN(id)
+#define PROF_END(id)
+#define PROF_NAME(id, name)
+#define PROF_DUMP()
+#endif
+
+#endif // _PROF_H_
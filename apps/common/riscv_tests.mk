@@ -17,7 +17,7 @@ rv64ua_ara_tests := $(addprefix rv64ua-ara-, $(rv64ua_sc_tests))
 rv64uc_ara_tests := $(addprefix rv64uc-ara-, $(rv64uc_sc_tests))
 rv64uf_ara_tests := $(addprefix rv64uf-ara-, $(rv64uf_sc_tests))
 rv64ud_ara_tests := $(addprefix rv64ud-ara-, $(rv64ud_sc_tests))
-rv64uv_ara_tests := $(addprefix rv64uv-ara-, $(rv64uv_sc_tests))
+rv64uv_ara_tests := $(addprefix rv64uv-ara-, $(rv64uv_sc_tests) $(rv64uv_ara_only_tests))
 rv64si_ara_tests := $(addprefix rv64si-ara-, $(rv64si_sc_tests))
 
 cva6_tests := $(rv64ui_ara_tests) \
@@ -11,6 +11,43 @@ extern int64_t event_trigger;
 extern int64_t timer;
 // SoC-level CSR
 extern uint64_t hw_cnt_en_reg;
+// Lanes used by the vector instructions (0 for all of them)
+extern volatile uint64_t active_lanes_reg;
+// Hardware performance counters, one per event
+extern volatile uint64_t perf_cnt_reg[];
+
+// Events counted by the hardware performance counters.
+// Keep in sync with perf_events_t in ara_pkg.sv
+enum perf_event_e {
+  PERF_VALU_BUSY = 0,
+  PERF_VMFPU_BUSY,
+  PERF_VLDU_BUSY,
+  PERF_VSTU_BUSY,
+  PERF_SLDU_BUSY,
+  PERF_MASKU_BUSY,
+  PERF_STALL_LANES_DESYNCH,
+  PERF_STALL_VINSN_FULL,
+  PERF_STALL_HAZARD,
+  PERF_VRF_BANK_CONFLICT,
+  PERF_AXI_R_BEAT,
+  PERF_AXI_W_BEAT,
+  PERF_ACC_REQ_STALL,
+  PERF_VALU_CLK_ON,
+  PERF_VMFPU_CLK_ON,
+  PERF_SLDU_CLK_ON,
+  PERF_ACC_EARLY_ACK,
+  PERF_VCACHE_HIT,
+  PERF_VCACHE_MISS,
+  PERF_PREFETCH_BEAT,
+  PERF_PREFETCH_HIT,
+  PERF_ST_MERGE,
+  PERF_ST_WCB_BEAT,
+  PERF_VMFPU2_BUSY,
+  PERF_VMXU_BUSY,
+  PERF_VRF_RW_CONFLICT,
+  PERF_VMFPU2_CLK_ON,
+  PERF_NR_EVENTS
+};
 
 // Return the current value of the cycle counter
 inline int64_t get_cycle_count() {
@@ -36,6 +73,28 @@ inline void stop_timer() { timer += get_cycle_count(); }
 
 // Get the value of the timer
 inline int64_t get_timer() { return timer; }
+
+// The performance counters count the events only while the HW counter is
+// enabled (HW_CNT_READY). Clear them while it is disabled.
+inline void reset_perf_cnts() {
+  for (int i = 0; i < PERF_NR_EVENTS; ++i)
+    perf_cnt_reg[i] = 0;
+}
+// The fence is needed to be sure that Ara is idle before reading
+inline uint64_t read_perf_cnt(enum perf_event_e event) {
+  asm volatile("fence");
+  return perf_cnt_reg[event];
+}
+
+// Scale VLMAX to the first `lanes` lanes, rounded down to a power of two, for
+// the short-vector phases: vsetvl then returns at most
+// VLMAX * lanes / NR_LANES. 0 restores VLMAX. The fence makes the following
+// vsetvl see the new value.
+inline void set_active_lanes(uint64_t lanes) {
+  active_lanes_reg = lanes;
+  asm volatile("fence");
+}
+inline uint64_t get_active_lanes() { return active_lanes_reg; }
 #else
 #define HW_CNT_READY ;
 #define HW_CNT_NOT_READY ;
@@ -51,6 +110,17 @@ inline void stop_timer() {
 
 // Get the value of the timer
 inline int64_t get_timer() { return 0; }
+
+inline void reset_perf_cnts() {
+  while (0)
+    ;
+}
+inline uint64_t read_perf_cnt(enum perf_event_e event) { return 0; }
+inline void set_active_lanes(uint64_t lanes) {
+  while (0)
+    ;
+}
+inline uint64_t get_active_lanes() { return 0; }
 #endif
 
 #endif // _RUNTIME_H_
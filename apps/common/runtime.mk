@@ -67,6 +67,8 @@ RISCV_SIM     ?= $(ISA_SIM_INSTALL_DIR)/bin/spike
 RISCV_SIM_MOD ?= $(ISA_SIM_MOD_INSTALL_DIR)/bin/spike
 RISCV_SIM_OPT ?= --isa=rv64gcv_zfh --varch="vlen:4096,elen:64"
 RISCV_SIM_MOD_OPT ?= --isa=rv64gcv_zfh --varch="vlen:4096,elen:64" -d
+# Fast-forward of the boot of the Ara binaries, with the memory map of the SoC
+RISCV_SIM_FFWD_OPT ?= --isa=rv64gcv_zfh --varch="vlen:$(vlen),elen:64" -m0x80000000:$(dram_size) -d
 
 # Python
 PYTHON ?= python3
@@ -76,7 +78,24 @@ ENV_DEFINES ?=
 ifeq ($(vcd_dump),1)
 ENV_DEFINES += -DVCD_DUMP=1
 endif
-MAKE_DEFINES = -DNR_LANES=$(nr_lanes) -DVLEN=$(vlen)
+# Print the cycles and the checks with trace records, see common/trace.h
+ifeq ($(trace_records),1)
+ENV_DEFINES += -DTRACE_RECORDS=1
+endif
+# Profile the regions with PROF_BEGIN and PROF_END, see common/prof.h
+ifeq ($(prof),1)
+ENV_DEFINES += -DPROF=1
+endif
+# Read the symbols of data.S from the image loaded at runtime, see common/data_image.h
+ifeq ($(data_image),1)
+ENV_DEFINES += -DDATA_IMAGE=1
+endif
+# Tiles of the MXU of the hardware, for the kernels with outer products
+mxu_tiles ?= 0
+# Instructions of the loop buffer of the hardware, for the kernels that replay their loops
+loop_buf_depth ?= 0
+MAKE_DEFINES = -DNR_LANES=$(nr_lanes) -DVLEN=$(vlen) -DNR_CORES=$(nr_cores) -DMXU_TILES=$(mxu_tiles)
+MAKE_DEFINES += -DLOOP_BUF_DEPTH=$(loop_buf_depth)
 DEFINES += $(ENV_DEFINES) $(MAKE_DEFINES)
 
 # Common flags
@@ -88,6 +107,12 @@ LLVM_V_FLAGS   ?= -fno-vectorize -mllvm -scalable-vectorization=off -mllvm -risc
 RISCV_FLAGS    ?= $(LLVM_FLAGS) $(LLVM_V_FLAGS) -mcmodel=medany -I$(CURDIR)/common -std=gnu99 -O3 -ffast-math -fno-common -fno-builtin-printf $(DEFINES) $(RISCV_WARNINGS)
 RISCV_CCFLAGS  ?= $(RISCV_FLAGS) -ffunction-sections -fdata-sections
 RISCV_CCFLAGS_SPIKE  ?= $(RISCV_FLAGS) $(SPIKE_CCFLAGS) -ffunction-sections -fdata-sections
+# Let LLVM vectorize the scalar code for a VLEN-bit machine, to compare it with the hand-written kernels
+LLVM_AUTOVEC_FLAGS    ?= -fvectorize -fslp-vectorize -mllvm -scalable-vectorization=on -mllvm -riscv-v-vector-bits-min=$(vlen) -Xclang -target-feature -Xclang +no-optimized-zero-stride-load
+RISCV_CCFLAGS_AUTOVEC ?= $(LLVM_FLAGS) $(LLVM_AUTOVEC_FLAGS) -mcmodel=medany -I$(CURDIR)/common -std=gnu99 -O3 -ffast-math -fno-common -fno-builtin-printf $(DEFINES) -DAUTOVEC=1 $(RISCV_WARNINGS) -ffunction-sections -fdata-sections
+ifeq ($(autovec),1)
+RISCV_CCFLAGS = $(RISCV_CCFLAGS_AUTOVEC)
+endif
 RISCV_CXXFLAGS ?= $(RISCV_FLAGS) -ffunction-sections -fdata-sections
 RISCV_LDFLAGS  ?= -static -nostartfiles -lm -Wl,--gc-sections
 RISCV_LDFLAGS_SPIKE  ?= $(RISCV_LDFLAGS) $(SPIKE_LDFLAGS) -Wl,--gc-sections
@@ -105,9 +130,16 @@ else
 endif
 
 # Compile two different versions of the runtime, since we cannot link code compiled with two different toolchains
-RUNTIME_GCC   ?= common/crt0-gcc.S.o common/printf-gcc.c.o common/string-gcc.c.o common/serial-gcc.c.o common/util-gcc.c.o
-RUNTIME_LLVM  ?= common/crt0-llvm.S.o common/printf-llvm.c.o common/string-llvm.c.o common/serial-llvm.c.o common/util-llvm.c.o
-RUNTIME_SPIKE ?= $(spike_env_dir)/benchmarks/common/crt.S.o.spike $(spike_env_dir)/benchmarks/common/syscalls.c.o.spike common/util.c.o.spike
+RUNTIME_GCC   ?= common/crt0-gcc.S.o common/printf-gcc.c.o common/string-gcc.c.o common/serial-gcc.c.o common/util-gcc.c.o common/bench-gcc.c.o common/sync-gcc.c.o common/dma-gcc.c.o common/l2_alloc-gcc.c.o common/tile-gcc.c.o common/vcheck-gcc.c.o common/prof-gcc.c.o common/data_image-gcc.c.o
+RUNTIME_LLVM  ?= common/crt0-llvm.S.o common/printf-llvm.c.o common/string-llvm.c.o common/serial-llvm.c.o common/util-llvm.c.o common/bench-llvm.c.o common/sync-llvm.c.o common/dma-llvm.c.o common/l2_alloc-llvm.c.o common/tile-llvm.c.o common/vcheck-llvm.c.o common/prof-llvm.c.o common/data_image-llvm.c.o
+RUNTIME_SPIKE ?= $(spike_env_dir)/benchmarks/common/crt.S.o.spike $(spike_env_dir)/benchmarks/common/syscalls.c.o.spike common/util.c.o.spike common/bench.c.o.spike common/sync.c.o.spike common/dma.c.o.spike common/l2_alloc.c.o.spike common/tile.c.o.spike common/vcheck.c.o.spike common/prof.c.o.spike common/data_image.c.o.spike
+
+# Link the vector memcpy, memset, and memcmp, instead of the scalar ones
+vstring ?= 1
+ifeq ($(vstring),1)
+RUNTIME_GCC   += common/vstring-gcc.c.o
+RUNTIME_LLVM  += common/vstring-llvm.c.o
+endif
 
 .INTERMEDIATE: $(RUNTIME_GCC) $(RUNTIME_LLVM)
 
@@ -1,7 +1,10 @@
 #!/usr/bin/env bash
 
-# Takes as input the number of lanes ($1) and the linker script to process ($2)
+# Takes as input the number of lanes ($1), the linker script to process ($2),
+# and the size of the DRAM ($3)
 # Align the sections by AxiWideBeWidth
 # NB: this script modify ALL the ALIGN directives
 let ALIGNMENT=4*$1;
 sed -i "s/ALIGNMENT/$ALIGNMENT/g" $2
+# Size the L2 region as the DRAM
+sed -i "s/DRAM_SIZE/${3:-0x02000000}/g" $2
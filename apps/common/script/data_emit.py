@@ -0,0 +1,99 @@
+# Copyright 2022 ETH Zurich and University of Bologna.
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+# Emission of the data of the gen_data.py scripts, imported by each of them:
+#   sys.path.insert(0, os.path.join(os.path.dirname(__file__), '../../common/script'))
+#   from data_emit import emit
+#
+# emit(name, array, alignment) prints a global symbol name, aligned to
+# alignment (an assembler expression, e.g. 'NR_LANES*4'), with the bytes of
+# array. When the output of the script is redirected to a file, e.g. data.S,
+# the bytes are written to the raw binary data.S.<name>.bin next to it, which
+# data.S includes with .incbin, so that the assembler does not parse a text line
+# per word. Otherwise (e.g., on a pipe), or with GEN_DATA_TEXT=1, the bytes are
+# printed as .word lines. The arrays of zeros, e.g. the output buffers, go to
+# .bss instead, which crt0.S clears with vector stores, so that they take no
+# space in the binary and no time in its preload.
+#
+# golden(name, array, rtol, atol) records the expected value of the symbol name,
+# e.g. a results buffer, in the golden file data.S.golden next to data.S. With
+# golden=1, the Verilator testbench compares the symbol with it at the end of
+# the simulation, element by element, within atol + rtol * |golden|
+# (hardware/tb/verilator/golden_check.cc).
+
+import atexit
+import os
+import stat
+import struct
+import sys
+
+def _output_file():
+  # Path of the file stdout is redirected to, or None
+  if os.environ.get('GEN_DATA_TEXT') == '1':
+    return None
+  try:
+    if not stat.S_ISREG(os.fstat(sys.stdout.fileno()).st_mode):
+      return None
+    path = os.readlink('/proc/self/fd/{}'.format(sys.stdout.fileno()))
+  except (OSError, ValueError, AttributeError):
+    return None
+  return path if os.path.isfile(path) else None
+
+_output = _output_file()
+_golden = []
+
+def _write_golden():
+  with open(_output + '.golden', 'wb') as f:
+    f.write(b'ARAGOLD1')
+    for name, array, rtol, atol in _golden:
+      bs = array.tobytes()
+      f.write(struct.pack('<I', len(name)) + name.encode())
+      f.write(struct.pack('<cBHddQ', array.dtype.kind.encode(), array.dtype.itemsize, 0,
+                          rtol, atol, len(bs)))
+      f.write(bs)
+
+def emit(name, array, alignment='8', pad=4):
+  # The bytes are padded to a multiple of pad
+  bs = array.tobytes()
+  bs += bytes(-len(bs) % pad)
+  zeros = not any(bs)
+  if zeros:
+    print(".pushsection .bss")
+  print(".global %s" % name)
+  print(".balign " + alignment)
+  print("%s:" % name)
+  if zeros:
+    print("    .space %d" % len(bs))
+    print(".popsection")
+    return
+  if _output is not None:
+    blob = '{}.{}.bin'.format(_output, name)
+    with open(blob, 'wb') as f:
+      f.write(bs)
+    print('    .incbin "%s"' % blob)
+    return
+  for i in range(0, len(bs), 4):
+    print("    .word 0x%08x" % int.from_bytes(bs[i:i+4], 'little'))
+
+def golden(name, array, rtol=0, atol=0):
+  # The golden file is only written next to a redirected output
+  if _output is None:
+    return
+  if array.dtype.kind not in 'fiu':
+    sys.exit('Error: no golden check for the {} elements of {}'.format(array.dtype, name))
+  if not _golden:
+    atexit.register(_write_golden)
+  _golden.append((name, array.ravel(), float(rtol), float(atol)))
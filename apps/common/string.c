@@ -2,7 +2,9 @@
 #include <stdint.h>
 #include <string.h>
 
-void *memcpy(void *dest, const void *src, size_t len) {
+// memcpy, memset, and memcmp are weak, so that the vector ones of vstring.c
+// replace them when it is linked
+__attribute__((weak)) void *memcpy(void *dest, const void *src, size_t len) {
   if ((((uintptr_t)dest | (uintptr_t)src | len) & (sizeof(uintptr_t) - 1)) ==
       0) {
     const uintptr_t *s = src;
@@ -18,7 +20,7 @@ void *memcpy(void *dest, const void *src, size_t len) {
   return dest;
 }
 
-void *memset(void *dest, int byte, size_t len) {
+__attribute__((weak)) void *memset(void *dest, int byte, size_t len) {
   if ((((uintptr_t)dest | len) & (sizeof(uintptr_t) - 1)) == 0) {
     uintptr_t word = byte & 0xFF;
     word |= word << 8;
@@ -37,10 +39,26 @@ void *memset(void *dest, int byte, size_t len) {
 }
 
 size_t strlen(const char *s) {
+#ifdef __riscv_vector
+  // The fault-only-first loads do not fault past the end of the string
+  const char *p = s;
+  size_t vl;
+  long first;
+  do {
+    asm volatile("vsetvli %0, zero, e8, m8, ta, ma" : "=r"(vl));
+    asm volatile("vle8ff.v v8, (%0)" ::"r"(p) : "memory");
+    asm volatile("csrr %0, vl" : "=r"(vl));
+    asm volatile("vmseq.vi v0, v8, 0");
+    asm volatile("vfirst.m %0, v0" : "=r"(first));
+    p += vl;
+  } while (first < 0);
+  return (size_t)(p - vl + first - s);
+#else
   const char *p = s;
   while (*p)
     p++;
   return (size_t)(p - s);
+#endif
 }
 
 int strcmp(const char *s1, const char *s2) {
@@ -54,7 +72,7 @@ int strcmp(const char *s1, const char *s2) {
   return c1 - c2;
 }
 
-int memcmp(const void *s1, const void *s2, size_t n) {
+__attribute__((weak)) int memcmp(const void *s1, const void *s2, size_t n) {
   if ((((uintptr_t)s1 | (uintptr_t)s2) & (sizeof(uintptr_t) - 1)) == 0) {
     const uintptr_t *u1 = s1;
     const uintptr_t *u2 = s2;
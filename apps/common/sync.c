@@ -0,0 +1,98 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdint.h>
+
+#include "sync.h"
+
+// Larger than the cache line of CVA6
+#define SYNC_LINE_BYTES 64
+
+typedef struct {
+  volatile uint64_t val;
+  uint8_t pad[SYNC_LINE_BYTES - sizeof(uint64_t)];
+} sync_flag_t;
+
+// In .data, not .bss: hart 0 clears the .bss in crt0 while the other harts
+// already run thread_main, and could race with the clearing of their flags
+#define SYNC_FLAGS __attribute__((aligned(SYNC_LINE_BYTES), section(".data")))
+
+// Number of barriers reached by each hart
+static sync_flag_t barrier_cnt[NR_CORES] SYNC_FLAGS = {{0}};
+// Lamport's bakery: is the hart taking a ticket, and its ticket (0 if none)
+static sync_flag_t bakery_choosing[NR_CORES] SYNC_FLAGS = {{0}};
+static sync_flag_t bakery_ticket[NR_CORES] SYNC_FLAGS = {{0}};
+
+static inline void sync_fence() { asm volatile("fence" ::: "memory"); }
+
+int hart_id() {
+#ifdef SPIKE
+  return 0;
+#else
+  int id;
+  asm volatile("mv %0, tp" : "=r"(id));
+  return id;
+#endif
+}
+
+void barrier() {
+  const int id = hart_id();
+  const uint64_t gen = barrier_cnt[id].val + 1;
+
+  // Publish the previous stores, and then the arrival
+  sync_fence();
+  barrier_cnt[id].val = gen;
+  sync_fence();
+
+  for (int i = 0; i < NR_CORES; ++i)
+    while (barrier_cnt[i].val < gen)
+      sync_fence();
+}
+
+void mutex_lock() {
+  const int id = hart_id();
+  uint64_t ticket = 0;
+
+  // Take a ticket larger than all the others
+  bakery_choosing[id].val = 1;
+  sync_fence();
+  for (int i = 0; i < NR_CORES; ++i)
+    if (bakery_ticket[i].val > ticket)
+      ticket = bakery_ticket[i].val;
+  bakery_ticket[id].val = ++ticket;
+  sync_fence();
+  bakery_choosing[id].val = 0;
+  sync_fence();
+
+  // Wait for the harts with a smaller ticket, or the same one and a smaller ID
+  for (int i = 0; i < NR_CORES; ++i) {
+    if (i == id)
+      continue;
+    while (bakery_choosing[i].val)
+      sync_fence();
+    while (bakery_ticket[i].val != 0 &&
+           (bakery_ticket[i].val < ticket ||
+            (bakery_ticket[i].val == ticket && i < id)))
+      sync_fence();
+  }
+}
+
+void mutex_unlock() {
+  // Publish the stores of the critical section before the release
+  sync_fence();
+  bakery_ticket[hart_id()].val = 0;
+  sync_fence();
+}
@@ -0,0 +1,41 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Synchronization of the NR_CORES harts of the SoC.
+// The L2 memory does not support atomics, and the data caches of the CVA6s are
+// not coherent. The primitives exchange flags that are written by a single hart
+// and padded to their own cache line, and fence, which writes back and
+// invalidates the data cache of CVA6 (and waits for Ara), around the accesses.
+// The harts must not write the same cache line with scalar stores.
+
+#ifndef _SYNC_H_
+#define _SYNC_H_
+
+#ifndef NR_CORES
+#define NR_CORES 1
+#endif
+
+// ID of the calling hart, set by crt0 in tp
+int hart_id();
+
+// Wait until all the harts reach the barrier
+void barrier();
+
+// Mutual exclusion among the harts
+void mutex_lock();
+void mutex_unlock();
+
+#endif // _SYNC_H_
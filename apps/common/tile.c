@@ -0,0 +1,63 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdint.h>
+
+#include "dma.h"
+#include "l2_alloc.h"
+#include "tile.h"
+
+void tile_run(size_t ntiles, size_t max_bytes, tile_next_fn next,
+              tile_compute_fn compute, void *ctx) {
+  if (!ntiles)
+    return;
+
+  const l2_mark_t mark = l2_mark();
+  uint8_t *buf[2];
+  buf[0] = l2_alloc(max_bytes, 0);
+  buf[1] = buf[0] ? l2_alloc(max_bytes, 0) : NULL;
+
+  // No room for the buffers: compute in place
+  if (!buf[1]) {
+    l2_release(mark);
+    for (size_t i = 0; i < ntiles; ++i) {
+      const tile_t t = next(i, ctx);
+      compute(t.src, t.stride, i, ctx);
+    }
+    return;
+  }
+
+  tile_t t = next(0, ctx);
+  uint64_t ticket = dma_start_2d(buf[0], t.src, t.len, t.reps, t.len, t.stride);
+
+  for (size_t i = 0; i < ntiles; ++i) {
+    const uint64_t len = t.len;
+    const uint64_t cur = ticket;
+
+    // Queue the copy of the next tile into the buffer of tile i - 1. The
+    // fence of dma_start waits for Ara to be done with it.
+    if (i + 1 < ntiles) {
+      t = next(i + 1, ctx);
+      ticket = dma_start_2d(buf[(i + 1) & 1], t.src, t.len, t.reps, t.len,
+                            t.stride);
+    }
+
+    dma_wait(cur);
+    compute(buf[i & 1], len, i, ctx);
+  }
+
+  l2_release(mark);
+}
@@ -0,0 +1,52 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Double buffering of the tiles of a kernel in the L2. The DMA engine copies
+// tile i + 1 into one of two buffers while the kernel computes on tile i in
+// the other one, so that the gather of a strided tile into a dense one costs
+// no time of CVA6 or Ara. A single hart runs the tiles.
+// If the arena of l2_alloc has no room for the two buffers, the kernel
+// computes on the tiles in place.
+
+#ifndef _TILE_H_
+#define _TILE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+// A tile: reps rows of len bytes, the first one at src, every stride bytes
+typedef struct {
+  const void *src;
+  uint64_t len;
+  uint64_t reps;
+  uint64_t stride;
+} tile_t;
+
+// Tile iterator: the tile with index i, i < ntiles
+typedef tile_t (*tile_next_fn)(size_t i, void *ctx);
+
+// Compute on the tile with index i, whose rows start at tile, every stride
+// bytes: len bytes apart in its buffer, or the stride of the source in place
+typedef void (*tile_compute_fn)(const void *tile, uint64_t stride, size_t i,
+                                void *ctx);
+
+// Compute on the ntiles tiles of next in order, with the copy of each tile
+// overlapped with the compute on the previous one. No tile has more than
+// max_bytes bytes (len * reps).
+void tile_run(size_t ntiles, size_t max_bytes, tile_next_fn next,
+              tile_compute_fn compute, void *ctx);
+
+#endif // _TILE_H_
@@ -0,0 +1,64 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Trace records: (tag, value) pairs that the software writes to two registers
+// of ctrl_registers, and that the testbench prints, in place of the formatting
+// of printf on CVA6 and of the characters sent one at a time to the UART.
+// A record prints "[<name of the tag>]: <value>". The values of the records
+// with TRACE_MORE in the tag are printed on the line of the next record.
+// The records are enabled with -DTRACE_RECORDS (trace_records=1), except on
+// Spike, which prints with printf. The names of the tags are in
+// ara_testharness.sv.
+
+#ifndef _TRACE_H_
+#define _TRACE_H_
+
+#include <stdint.h>
+
+#ifndef SPIKE
+#include "printf.h"
+#else
+#include <stdio.h>
+#endif
+
+// Tags of the records
+#define TRACE_SW_CYCLES 1
+#define TRACE_SW_CYCLES_STATS 2
+#define TRACE_CHECK_ERRORS 3
+#define TRACE_CHECK_MISMATCH 4
+#define TRACE_PROF 5
+#define TRACE_MORE (1 << 8)
+
+#if defined(TRACE_RECORDS) && !defined(SPIKE)
+#define TRACE_EN
+
+// Defined by the linker script
+extern volatile uint64_t trace_value_reg;
+extern volatile uint64_t trace_tag_reg;
+
+// The write of the tag completes the record
+static inline void trace_record(uint64_t tag, int64_t value) {
+  trace_value_reg = value;
+  trace_tag_reg = tag;
+}
+
+// Report the mismatch of the element idx of a check
+#define trace_mismatch(idx, ...) trace_record(TRACE_CHECK_MISMATCH, (idx))
+#else
+#define trace_mismatch(idx, ...) printf(__VA_ARGS__)
+#endif
+
+#endif // _TRACE_H_
@@ -0,0 +1,290 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// BLAS level-1 kernels, named and ordered as the reference BLAS:
+//   daxpy, saxpy : y = a * x + y
+//   dscal        : x = a * x
+//   dcopy        : y = x
+//   dnrm2        : sqrt(x' * x), with no scaling against overflow
+//   dasum        : sum of |x|
+//   idamax       : index of the first maximum |x|, from 0 as in CBLAS
+// incx and incy are the strides in elements: 1 loads and stores with vle/vse,
+// the others with vlse/vsse. Negative strides walk the vectors backwards from
+// element (n - 1) * |inc|, as in BLAS, and the reductions return 0 for
+// incx <= 0. All the kernels strip-mine at LMUL = 8, but idamax at LMUL = 4.
+//
+// The reductions accumulate element-wise on the full strips, i.e., on VLMAX
+// independent partial results, and reduce once at the end, as fdotp_v64b. The
+// last partial strip is reduced on its own, so that no accumulator depends on
+// the tail policy.
+
+#ifndef _VBLAS1_H_
+#define _VBLAS1_H_
+
+#include <stdint.h>
+
+#include "riscv_vector.h"
+
+// First element of a vector of n elements and stride inc
+#define VBLAS1_BASE(x, n, inc)                                                 \
+  ((inc) < 0 ? (x) + (1 - (int64_t)(n)) * (inc) : (x))
+
+/*
+  Loads and stores
+*/
+
+static inline vfloat64m8_t vblas1_ld_f64m8(const double *x, int64_t inc,
+                                           size_t vl) {
+  return inc == 1 ? vle64_v_f64m8(x, vl)
+                  : vlse64_v_f64m8(x, inc * sizeof(double), vl);
+}
+
+static inline vfloat64m4_t vblas1_ld_f64m4(const double *x, int64_t inc,
+                                           size_t vl) {
+  return inc == 1 ? vle64_v_f64m4(x, vl)
+                  : vlse64_v_f64m4(x, inc * sizeof(double), vl);
+}
+
+static inline vfloat32m8_t vblas1_ld_f32m8(const float *x, int64_t inc,
+                                           size_t vl) {
+  return inc == 1 ? vle32_v_f32m8(x, vl)
+                  : vlse32_v_f32m8(x, inc * sizeof(float), vl);
+}
+
+static inline void vblas1_st_f64m8(double *x, int64_t inc, vfloat64m8_t v,
+                                   size_t vl) {
+  if (inc == 1)
+    vse64_v_f64m8(x, v, vl);
+  else
+    vsse64_v_f64m8(x, inc * sizeof(double), v, vl);
+}
+
+static inline void vblas1_st_f32m8(float *x, int64_t inc, vfloat32m8_t v,
+                                   size_t vl) {
+  if (inc == 1)
+    vse32_v_f32m8(x, v, vl);
+  else
+    vsse32_v_f32m8(x, inc * sizeof(float), v, vl);
+}
+
+/*
+  Vector operations
+*/
+
+#if LOOP_BUF_DEPTH
+// The toolchain does not know the bounds of the body of the loop buffer:
+// vlbeg.vx and vlend.vx are the OPMVX instructions of funct6 000011 and 000100.
+// vlend.vx takes the avl left after the first strip, and returns the avl left
+// after the ones that the loop buffer replayed: 0, unless it did not replay.
+static inline void daxpy_loop_buf(uint64_t n, double a, const double *x,
+                                  double *y) {
+  while (n) {
+    uint64_t vl, left;
+    asm volatile(".insn r 0x57, 6, 0x07, x0, x0, x0\n"
+                 "vsetvli %[vl], %[n], e64, m8, ta, ma\n"
+                 "vle64.v v8, (%[x])\n"
+                 "vle64.v v16, (%[y])\n"
+                 "vfmacc.vf v16, %[a], v8\n"
+                 "vse64.v v16, (%[y])\n"
+                 "sub %[left], %[n], %[vl]\n"
+                 ".insn r 0x57, 6, 0x09, %[left], %[left], x0\n"
+                 : [vl] "=&r"(vl), [left] "=&r"(left)
+                 : [n] "r"(n), [a] "f"(a), [x] "r"(x), [y] "r"(y)
+                 // The whole m8 groups of v8 and v16
+                 : "v8", "v9", "v10", "v11", "v12", "v13", "v14", "v15", "v16",
+                   "v17", "v18", "v19", "v20", "v21", "v22", "v23", "memory");
+    x += n - left;
+    y += n - left;
+    n = left;
+  }
+}
+#endif
+
+static inline void daxpy(uint64_t n, double a, const double *x, int64_t incx,
+                         double *y, int64_t incy) {
+#if LOOP_BUF_DEPTH
+  if (incx == 1 && incy == 1) {
+    daxpy_loop_buf(n, a, x, y);
+    return;
+  }
+#endif
+  x = VBLAS1_BASE(x, n, incx);
+  y = VBLAS1_BASE(y, n, incy);
+  size_t vl;
+
+  for (uint64_t i = 0; i < n; i += vl) {
+    vl = vsetvl_e64m8(n - i);
+    vfloat64m8_t vy = vblas1_ld_f64m8(y, incy, vl);
+    vy = vfmacc_vf_f64m8(vy, a, vblas1_ld_f64m8(x, incx, vl), vl);
+    vblas1_st_f64m8(y, incy, vy, vl);
+    x += vl * incx;
+    y += vl * incy;
+  }
+}
+
+static inline void saxpy(uint64_t n, float a, const float *x, int64_t incx,
+                         float *y, int64_t incy) {
+  x = VBLAS1_BASE(x, n, incx);
+  y = VBLAS1_BASE(y, n, incy);
+  size_t vl;
+
+  for (uint64_t i = 0; i < n; i += vl) {
+    vl = vsetvl_e32m8(n - i);
+    vfloat32m8_t vy = vblas1_ld_f32m8(y, incy, vl);
+    vy = vfmacc_vf_f32m8(vy, a, vblas1_ld_f32m8(x, incx, vl), vl);
+    vblas1_st_f32m8(y, incy, vy, vl);
+    x += vl * incx;
+    y += vl * incy;
+  }
+}
+
+static inline void dscal(uint64_t n, double a, double *x, int64_t incx) {
+  x = VBLAS1_BASE(x, n, incx);
+  size_t vl;
+
+  for (uint64_t i = 0; i < n; i += vl) {
+    vl = vsetvl_e64m8(n - i);
+    vblas1_st_f64m8(x, incx,
+                    vfmul_vf_f64m8(vblas1_ld_f64m8(x, incx, vl), a, vl), vl);
+    x += vl * incx;
+  }
+}
+
+static inline void dcopy(uint64_t n, const double *x, int64_t incx, double *y,
+                         int64_t incy) {
+  x = VBLAS1_BASE(x, n, incx);
+  y = VBLAS1_BASE(y, n, incy);
+  size_t vl;
+
+  for (uint64_t i = 0; i < n; i += vl) {
+    vl = vsetvl_e64m8(n - i);
+    vblas1_st_f64m8(y, incy, vblas1_ld_f64m8(x, incx, vl), vl);
+    x += vl * incx;
+    y += vl * incy;
+  }
+}
+
+/*
+  Reductions
+*/
+
+static inline double dnrm2(uint64_t n, const double *x, int64_t incx) {
+  if (!n || incx <= 0)
+    return 0;
+
+  const size_t vlmax = vsetvlmax_e64m8();
+  vfloat64m8_t acc = vfmv_v_f_f64m8(0, vlmax);
+  vfloat64m1_t red = vfmv_v_f_f64m1(0, 1);
+  uint64_t i = 0;
+
+  for (; i + vlmax <= n; i += vlmax) {
+    vfloat64m8_t v = vblas1_ld_f64m8(x, incx, vlmax);
+    acc = vfmacc_vv_f64m8(acc, v, v, vlmax);
+    x += vlmax * incx;
+  }
+  if (i)
+    red = vfredusum_vs_f64m8_f64m1(red, acc, red, vlmax);
+
+  if (i < n) {
+    const size_t vl = vsetvl_e64m8(n - i);
+    vfloat64m8_t v = vblas1_ld_f64m8(x, incx, vl);
+    red = vfredusum_vs_f64m8_f64m1(red, vfmul_vv_f64m8(v, v, vl), red, vl);
+  }
+
+  return vfmv_f_s_f64m1_f64(vfsqrt_v_f64m1(red, 1));
+}
+
+static inline double dasum(uint64_t n, const double *x, int64_t incx) {
+  if (!n || incx <= 0)
+    return 0;
+
+  const size_t vlmax = vsetvlmax_e64m8();
+  vfloat64m8_t acc = vfmv_v_f_f64m8(0, vlmax);
+  vfloat64m1_t red = vfmv_v_f_f64m1(0, 1);
+  uint64_t i = 0;
+
+  for (; i + vlmax <= n; i += vlmax) {
+    acc = vfadd_vv_f64m8(acc, vfabs_v_f64m8(vblas1_ld_f64m8(x, incx, vlmax),
+                                            vlmax),
+                         vlmax);
+    x += vlmax * incx;
+  }
+  if (i)
+    red = vfredusum_vs_f64m8_f64m1(red, acc, red, vlmax);
+
+  if (i < n) {
+    const size_t vl = vsetvl_e64m8(n - i);
+    red = vfredusum_vs_f64m8_f64m1(
+        red, vfabs_v_f64m8(vblas1_ld_f64m8(x, incx, vl), vl), red, vl);
+  }
+
+  return vfmv_f_s_f64m1_f64(red);
+}
+
+// First index of the elements equal to the maximum m of v
+static inline uint64_t vblas1_first_f64m4(vfloat64m4_t v, vuint64m4_t idx,
+                                          double m, size_t vl) {
+  vbool16_t eq = vmfeq_vf_f64m4_b16(v, m, vl);
+  vuint64m1_t red = vmv_v_x_u64m1(UINT64_MAX, 1);
+  red = vredminu_vs_u64m4_u64m1_m(eq, red, idx, red, vl);
+  return vmv_x_s_u64m1_u64(red);
+}
+
+// Each element keeps its maximum and its first index, updated only by the
+// greater values, so that the first index is kept on ties. The four groups
+// of the maxima, the indices, the current indices, and the loads do not fit
+// in the register file at LMUL = 8, with the mask in v0
+static inline uint64_t idamax(uint64_t n, const double *x, int64_t incx) {
+  if (!n || incx <= 0)
+    return 0;
+
+  const size_t vlmax = vsetvlmax_e64m4();
+  vfloat64m4_t vmax = vfmv_v_f_f64m4(-1, vlmax);
+  vuint64m4_t vidx = vmv_v_x_u64m4(0, vlmax);
+  vuint64m4_t cur = vid_v_u64m4(vlmax);
+  double max = -1;
+  uint64_t imax = 0;
+  uint64_t i = 0;
+
+  for (; i + vlmax <= n; i += vlmax) {
+    vfloat64m4_t v = vfabs_v_f64m4(vblas1_ld_f64m4(x, incx, vlmax), vlmax);
+    vbool16_t gt = vmflt_vv_f64m4_b16(vmax, v, vlmax);
+    vmax = vmerge_vvm_f64m4(gt, vmax, v, vlmax);
+    vidx = vmerge_vvm_u64m4(gt, vidx, cur, vlmax);
+    cur = vadd_vx_u64m4(cur, vlmax, vlmax);
+    x += vlmax * incx;
+  }
+  if (i) {
+    vfloat64m1_t red = vfmv_v_f_f64m1(-1, 1);
+    max = vfmv_f_s_f64m1_f64(
+        vfredmax_vs_f64m4_f64m1(red, vmax, red, vlmax));
+    imax = vblas1_first_f64m4(vmax, vidx, max, vlmax);
+  }
+
+  if (i < n) {
+    const size_t vl = vsetvl_e64m4(n - i);
+    vfloat64m4_t v = vfabs_v_f64m4(vblas1_ld_f64m4(x, incx, vl), vl);
+    vfloat64m1_t red = vfmv_v_f_f64m1(-1, 1);
+    const double tmax =
+        vfmv_f_s_f64m1_f64(vfredmax_vs_f64m4_f64m1(red, v, red, vl));
+    if (tmax > max)
+      imax = i + vblas1_first_f64m4(v, vid_v_u64m4(vl), tmax, vl);
+  }
+
+  return imax;
+}
+
+#endif // _VBLAS1_H_
@@ -0,0 +1,107 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stddef.h>
+
+#include "vcheck.h"
+
+#ifndef SPIKE
+#include "printf.h"
+#else
+#include <stdio.h>
+#endif
+
+// v0 holds the mismatches of the strip starting at i
+#define VCHECK_FIRST(i)                                                        \
+  do {                                                                         \
+    long first;                                                                \
+    asm volatile("vfirst.m %0, v0" : "=r"(first));                             \
+    if (first >= 0)                                                            \
+      return (i) + first;                                                      \
+  } while (0)
+
+// The mismatches are where |result - gold| <= threshold is false, so that NaN
+// fails the check
+#define VCHECK_FP(sew, type)                                                   \
+  int64_t vcheck_f##sew(const type *result, const type *gold, uint64_t n,      \
+                        type threshold) {                                      \
+    size_t vl;                                                                 \
+    for (uint64_t i = 0; i < n; i += vl) {                                     \
+      asm volatile("vsetvli %0, %1, e" #sew ", m8, ta, ma"                     \
+                   : "=r"(vl)                                                  \
+                   : "r"(n - i));                                              \
+      asm volatile("vle" #sew ".v v8, (%0)" ::"r"(result + i) : "memory");     \
+      asm volatile("vle" #sew ".v v16, (%0)" ::"r"(gold + i) : "memory");      \
+      asm volatile("vfsub.vv v8, v8, v16");                                    \
+      asm volatile("vfabs.v v8, v8");                                          \
+      asm volatile("vmfle.vf v0, v8, %0" ::"f"(threshold));                    \
+      asm volatile("vmnot.m v0, v0");                                          \
+      VCHECK_FIRST(i);                                                         \
+    }                                                                          \
+    return -1;                                                                 \
+  }
+
+#define VCHECK_INT(sew, type)                                                  \
+  int64_t vcheck_i##sew(const type *result, const type *gold, uint64_t n) {    \
+    size_t vl;                                                                 \
+    for (uint64_t i = 0; i < n; i += vl) {                                     \
+      asm volatile("vsetvli %0, %1, e" #sew ", m8, ta, ma"                     \
+                   : "=r"(vl)                                                  \
+                   : "r"(n - i));                                              \
+      asm volatile("vle" #sew ".v v8, (%0)" ::"r"(result + i) : "memory");     \
+      asm volatile("vle" #sew ".v v16, (%0)" ::"r"(gold + i) : "memory");      \
+      asm volatile("vmsne.vv v0, v8, v16");                                    \
+      VCHECK_FIRST(i);                                                         \
+    }                                                                          \
+    return -1;                                                                 \
+  }
+
+VCHECK_FP(64, double)
+VCHECK_FP(32, float)
+
+int64_t vcheck_f16(const void *result, const void *gold, uint64_t n,
+                   float threshold) {
+  const uint16_t *r = result;
+  const uint16_t *g = gold;
+  size_t vl;
+  for (uint64_t i = 0; i < n; i += vl) {
+    asm volatile("vsetvli %0, %1, e16, m4, ta, ma" : "=r"(vl) : "r"(n - i));
+    asm volatile("vle16.v v8, (%0)" ::"r"(r + i) : "memory");
+    asm volatile("vle16.v v12, (%0)" ::"r"(g + i) : "memory");
+    asm volatile("vfwsub.vv v16, v8, v12");
+    // Same SEW/LMUL ratio, and so same vl
+    asm volatile("vsetvli zero, zero, e32, m8, ta, ma");
+    asm volatile("vfabs.v v16, v16");
+    asm volatile("vmfle.vf v0, v16, %0" ::"f"(threshold));
+    asm volatile("vmnot.m v0, v0");
+    VCHECK_FIRST(i);
+  }
+  return -1;
+}
+
+VCHECK_INT(64, int64_t)
+VCHECK_INT(32, int32_t)
+VCHECK_INT(16, int16_t)
+VCHECK_INT(8, int8_t)
+
+int vcheck_report(const char *name, int64_t idx) {
+  if (idx >= 0) {
+    printf("%s: Error at index %ld.\n", name, idx);
+    return 1;
+  }
+  printf("%s: Check okay. No errors.\n", name);
+  return 0;
+}
@@ -0,0 +1,46 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Vector checks of the results against the golden ones, which find the first
+// mismatch a strip at a time instead of comparing the elements one by one.
+// The floating-point checks fail where |result - gold| > threshold, or where
+// the difference is NaN. The integer checks fail where result != gold.
+// All the checks return the index of the first mismatch, or -1 if there is
+// none.
+
+#ifndef _VCHECK_H_
+#define _VCHECK_H_
+
+#include <stdint.h>
+
+int64_t vcheck_f64(const double *result, const double *gold, uint64_t n,
+                   double threshold);
+int64_t vcheck_f32(const float *result, const float *gold, uint64_t n,
+                   float threshold);
+// The halves are compared on their differences widened to FP32
+int64_t vcheck_f16(const void *result, const void *gold, uint64_t n,
+                   float threshold);
+
+int64_t vcheck_i64(const int64_t *result, const int64_t *gold, uint64_t n);
+int64_t vcheck_i32(const int32_t *result, const int32_t *gold, uint64_t n);
+int64_t vcheck_i16(const int16_t *result, const int16_t *gold, uint64_t n);
+int64_t vcheck_i8(const int8_t *result, const int8_t *gold, uint64_t n);
+
+// Print the outcome of the check name from the index of its first mismatch, or
+// -1, as returned by the checks above. Return 1 if the check failed.
+int vcheck_report(const char *name, int64_t idx);
+
+#endif // _VCHECK_H_
@@ -0,0 +1,37 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Vector configuration of the build, from the -DNR_LANES and -DVLEN of the
+// configuration (config/*.mk). The kernels size their blocks and pick their
+// micro-kernels and LMUL with these constants, instead of deriving them from
+// a vsetvlmax at runtime or assuming the default configuration.
+
+#ifndef _VCONFIG_H_
+#define _VCONFIG_H_
+
+#if !defined(VLEN) || !defined(NR_LANES)
+#error "VLEN and NR_LANES must be defined by the configuration"
+#endif
+
+// Elements of a register group of lmul registers, with elements of sew bits
+#define VLMAX(sew, lmul) ((lmul) * (VLEN) / (sew))
+
+#define VLMAX_E64M1 VLMAX(64, 1)
+#define VLMAX_E64M2 VLMAX(64, 2)
+#define VLMAX_E64M4 VLMAX(64, 4)
+#define VLMAX_E32M4 VLMAX(32, 4)
+
+#endif // _VCONFIG_H_
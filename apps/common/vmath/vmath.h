@@ -0,0 +1,132 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Vector math library: exp, log, sin, cos, tanh, sigmoid, and erf, for each
+// floating-point type and LMUL, e.g., vmath_exp_f32m1(x, vl), sincos, which
+// returns sin(x) and writes cos(x) from one range reduction, e.g.,
+// vmath_sincos_f32m1(x, &c, vl), and the GELU (tanh approximation) and SiLU
+// activations built on them.
+//
+// Each function comes in two tiers:
+//   vmath_<fn>_acc_<type>  : accurate, with longer series and divisions
+//   vmath_<fn>_fast_<type> : fast, with shorter series and reciprocals seeded
+//                            by vfrec7 and refined by Newton-Raphson
+// vmath_<fn>_<type> is the accurate tier, or the fast one if VMATH_FAST is
+// defined at compile time.
+//
+// The range reductions and the coefficients are shared by all the types, in
+// vmath_consts.h. Define VMATH_NO_F16 if the target has no Zvfh.
+
+#ifndef _VMATH_H_
+#define _VMATH_H_
+
+#include <math.h>
+#include <stdint.h>
+
+#include "riscv_vector.h"
+
+#include "vmath_consts.h"
+
+#define VMATH_CAT3_(a, b, c) a##b##c
+#define VMATH_CAT3(a, b, c) VMATH_CAT3_(a, b, c)
+#define VMATH_CAT4_(a, b, c, d) a##b##c##d
+#define VMATH_CAT4(a, b, c, d) VMATH_CAT4_(a, b, c, d)
+#define VMATH_CAT5_(a, b, c, d, e) a##b##c##d##e
+#define VMATH_CAT5(a, b, c, d, e) VMATH_CAT5_(a, b, c, d, e)
+
+/*
+  FP64
+*/
+
+#define VMATH_ST double
+#define VMATH_SEW 64
+
+#define VMATH_LMUL m1
+#define VMATH_MR 64
+#include "vmath_impl.h"
+#define VMATH_LMUL m2
+#define VMATH_MR 32
+#include "vmath_impl.h"
+#define VMATH_LMUL m4
+#define VMATH_MR 16
+#include "vmath_impl.h"
+#define VMATH_LMUL m8
+#define VMATH_MR 8
+#include "vmath_impl.h"
+
+#undef VMATH_ST
+#undef VMATH_SEW
+
+/*
+  FP32
+*/
+
+#define VMATH_ST float
+#define VMATH_SEW 32
+
+#define VMATH_LMUL mf2
+#define VMATH_MR 64
+#include "vmath_impl.h"
+#define VMATH_LMUL m1
+#define VMATH_MR 32
+#include "vmath_impl.h"
+#define VMATH_LMUL m2
+#define VMATH_MR 16
+#include "vmath_impl.h"
+#define VMATH_LMUL m4
+#define VMATH_MR 8
+#include "vmath_impl.h"
+#define VMATH_LMUL m8
+#define VMATH_MR 4
+#include "vmath_impl.h"
+
+#undef VMATH_ST
+#undef VMATH_SEW
+
+/*
+  FP16
+*/
+
+#ifndef VMATH_NO_F16
+
+#define VMATH_ST _Float16
+#define VMATH_SEW 16
+
+#define VMATH_LMUL mf4
+#define VMATH_MR 64
+#include "vmath_impl.h"
+#define VMATH_LMUL mf2
+#define VMATH_MR 32
+#include "vmath_impl.h"
+#define VMATH_LMUL m1
+#define VMATH_MR 16
+#include "vmath_impl.h"
+#define VMATH_LMUL m2
+#define VMATH_MR 8
+#include "vmath_impl.h"
+#define VMATH_LMUL m4
+#define VMATH_MR 4
+#include "vmath_impl.h"
+#define VMATH_LMUL m8
+#define VMATH_MR 2
+#include "vmath_impl.h"
+
+#undef VMATH_ST
+#undef VMATH_SEW
+
+#endif
+
+#endif
@@ -0,0 +1,236 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Constants shared by the vmath functions of all the types and tiers.
+// The polynomials are truncated series, whose coefficients come from the
+// tables below; their number of terms sets the accuracy of each type and tier.
+
+#ifndef _VMATH_CONSTS_H_
+#define _VMATH_CONSTS_H_
+
+// 1/k!, for exp, sin, and cos
+static const double vmath_inv_fact[] = {
+    1.0,
+    1.0,
+    5.00000000000000000000e-01,
+    1.66666666666666666667e-01,
+    4.16666666666666666667e-02,
+    8.33333333333333333333e-03,
+    1.38888888888888888889e-03,
+    1.98412698412698412698e-04,
+    2.48015873015873015873e-05,
+    2.75573192239858906526e-06,
+    2.75573192239858906526e-07,
+    2.50521083854417187751e-08,
+    2.08767569878680989792e-09,
+    1.60590438368216145994e-10,
+    1.14707455977297247139e-11,
+    7.64716373181981647590e-13,
+    4.77947733238738529744e-14,
+    2.81145725434552076320e-15,
+    1.56192069685862264622e-16,
+    8.22063524662432971696e-18,
+};
+
+// 1/(2k+1), for log (atanh series)
+static const double vmath_inv_odd[] = {
+    1.0,
+    3.33333333333333333333e-01,
+    2.00000000000000000000e-01,
+    1.42857142857142857143e-01,
+    1.11111111111111111111e-01,
+    9.09090909090909090909e-02,
+    7.69230769230769230769e-02,
+    6.66666666666666666667e-02,
+    5.88235294117647058824e-02,
+    5.26315789473684210526e-02,
+    4.76190476190476190476e-02,
+    4.34782608695652173913e-02,
+};
+
+// 1/(k! (2k+1)), series of erf(x) sqrt(pi) / (2x) in -x^2
+static const double vmath_erf_series[] = {
+    1.0,
+    3.33333333333333333333e-01,
+    1.00000000000000000000e-01,
+    2.38095238095238095238e-02,
+    4.62962962962962962963e-03,
+    7.57575757575757575758e-04,
+    1.06837606837606837607e-04,
+    1.32275132275132275132e-05,
+    1.45891690009337068161e-06,
+    1.45038522231504687645e-07,
+    1.31225329638028050726e-08,
+    1.08922210371485733805e-09,
+};
+
+// Taylor series of tanh(x)/x in x^2
+static const double vmath_tanh_coef[] = {
+    1.0,
+    -3.33333333333333333333e-01,
+    1.33333333333333333333e-01,
+    -5.39682539682539682540e-02,
+    2.18694885361552028219e-02,
+    -8.86323552990219656886e-03,
+    3.59212803657248101692e-03,
+    -1.45583438705131826825e-03,
+};
+
+/*
+  Range reduction
+*/
+
+#define VMATH_LOG2E 1.44269504088896340736
+#define VMATH_SQRT2 1.41421356237309504880
+#define VMATH_2_PI 0.63661977236758134308
+#define VMATH_2_SQRTPI 1.12837916709551257390
+
+// GELU, tanh approximation
+#define VMATH_SQRT_2_PI 0.79788456080286535588
+#define VMATH_GELU_C 0.044715
+
+// ln(2) = LN2_HI + LN2_LO, with LN2_HI short enough for n * LN2_HI to be exact
+#define VMATH_LN2_HI_16 0.6875
+#define VMATH_LN2_LO_16 5.64718055994528623e-3
+#define VMATH_LN2_HI_32 0.693359375
+#define VMATH_LN2_LO_32 -2.12194440054690583e-4
+#define VMATH_LN2_HI_64 6.93147180369123816490e-01
+#define VMATH_LN2_LO_64 1.90821492927058770002e-10
+
+// pi/2 = PIO2_1 + PIO2_2 + PIO2_3 (Cody-Waite)
+#define VMATH_PIO2_1_16 1.5625
+#define VMATH_PIO2_2_16 8.29315185546875e-3
+#define VMATH_PIO2_3_16 3.17493942780799900e-6
+#define VMATH_PIO2_1_32 1.5703125
+#define VMATH_PIO2_2_32 4.837512969970703125e-4
+#define VMATH_PIO2_3_32 7.54978995489188216e-8
+#define VMATH_PIO2_1_64 1.57079632673412561417e+00
+#define VMATH_PIO2_2_64 6.07710050650619224932e-11
+#define VMATH_PIO2_3_64 2.02226624879595063154e-21
+
+/*
+  Floating-point formats
+*/
+
+#define VMATH_MANT_16 10
+#define VMATH_BIAS_16 15
+#define VMATH_MANT_32 23
+#define VMATH_BIAS_32 127
+#define VMATH_MANT_64 52
+#define VMATH_BIAS_64 1023
+
+// Smallest normal number
+#define VMATH_MIN_NORMAL_16 6.103515625e-05
+#define VMATH_MIN_NORMAL_32 1.17549435082228750797e-38
+#define VMATH_MIN_NORMAL_64 2.22507385850720138309e-308
+
+// exp(x) is clamped to [EXP_LO, EXP_HI], so that 2^round(x * log2(e)) is normal
+#define VMATH_EXP_HI_16 10.7
+#define VMATH_EXP_LO_16 -10.0
+#define VMATH_EXP_HI_32 88.3
+#define VMATH_EXP_LO_32 -87.6
+#define VMATH_EXP_HI_64 709.4
+#define VMATH_EXP_LO_64 -708.3
+
+// erf(x) is +-1 in this type beyond ERF_MAX
+#define VMATH_ERF_MAX_16 3.0
+#define VMATH_ERF_MAX_32 4.0
+#define VMATH_ERF_MAX_64 6.0
+
+/*
+  Terms of the polynomials, and Newton-Raphson steps after vfrec7
+*/
+
+// exp: degree of the series of exp(r), |r| <= ln(2)/2
+#define VMATH_EXP_DEG_ACC_16 4
+#define VMATH_EXP_DEG_FAST_16 3
+#define VMATH_EXP_DEG_ACC_32 7
+#define VMATH_EXP_DEG_FAST_32 5
+#define VMATH_EXP_DEG_ACC_64 12
+#define VMATH_EXP_DEG_FAST_64 8
+
+// log: terms of the series of atanh(s)/s in s^2, |s| <= 3 - 2 sqrt(2)
+#define VMATH_LOG_TERMS_ACC_16 3
+#define VMATH_LOG_TERMS_FAST_16 2
+#define VMATH_LOG_TERMS_ACC_32 5
+#define VMATH_LOG_TERMS_FAST_32 3
+#define VMATH_LOG_TERMS_ACC_64 10
+#define VMATH_LOG_TERMS_FAST_64 6
+
+// sin, cos: terms of the series in r^2, |r| <= pi/4
+#define VMATH_SIN_TERMS_ACC_16 4
+#define VMATH_SIN_TERMS_FAST_16 3
+#define VMATH_SIN_TERMS_ACC_32 5
+#define VMATH_SIN_TERMS_FAST_32 4
+#define VMATH_SIN_TERMS_ACC_64 9
+#define VMATH_SIN_TERMS_FAST_64 6
+
+// tanh: terms of the series, used for |x| < VMATH_TANH_SMALL (accurate tier)
+#define VMATH_TANH_SMALL 0.125
+#define VMATH_TANH_TERMS_16 2
+#define VMATH_TANH_TERMS_32 4
+#define VMATH_TANH_TERMS_64 8
+
+// erf: terms of the series, used for |x| < VMATH_ERF_SMALL
+#define VMATH_ERF_SMALL 0.5
+#define VMATH_ERF_TERMS_16 3
+#define VMATH_ERF_TERMS_32 6
+#define VMATH_ERF_TERMS_64 12
+
+// Newton-Raphson steps of the fast reciprocal, each doubling the 7 bits of vfrec7
+#define VMATH_REC_STEPS_16 1
+#define VMATH_REC_STEPS_32 2
+#define VMATH_REC_STEPS_64 3
+
+/*
+  Live vector registers
+*/
+
+// Do groups register groups of LMUL l fit besides v0 and masks masks?
+#define VMATH_LMUL_FITS(groups, masks, l)                                      \
+  ((groups) * (l) + ((masks) + (l)) / (l) * (l) <= 32)
+
+// Largest LMUL whose register groups and masks fit in the register file
+#define VMATH_LMUL_FOR(groups, masks)                                          \
+  (VMATH_LMUL_FITS(groups, masks, 8)   ? 8                                     \
+   : VMATH_LMUL_FITS(groups, masks, 4) ? 4                                     \
+   : VMATH_LMUL_FITS(groups, masks, 2) ? 2                                     \
+                                       : 1)
+
+// LMUL of the strip-mine loops of exp, log, sin/cos, and sincos. Their
+// coefficients are scalar operands, so only the temporaries are live: the
+// groups and masks of the series, of the range reduction, and of the special
+// cases
+#define VMATH_EXP_LMUL VMATH_LMUL_FOR(4, 0)
+#define VMATH_LOG_LMUL VMATH_LMUL_FOR(5, 3)
+#define VMATH_SINCOS_LMUL VMATH_LMUL_FOR(6, 1)
+#define VMATH_SINCOS2_LMUL VMATH_LMUL_FOR(7, 1)
+
+// erfc(x) = t exp(-x^2 + P(t)), t = 1 / (1 + x/2), with a relative error below
+// 1.2e-7 (Numerical Recipes, erfcc)
+static const double vmath_erfc_coef[] = {
+    -1.26551223, 1.00002368,  0.37409196, 0.09678418, -0.18628806,
+    0.27886807,  -1.13520398, 1.48851587, -0.82215223, 0.17087277,
+};
+
+// erf(x) = 1 - t P(t) exp(-x^2), t = 1 / (1 + p x), with an absolute error
+// below 1.5e-7 (Abramowitz and Stegun, 7.1.26)
+#define VMATH_ERF_AS_P 0.3275911
+static const double vmath_erf_as_coef[] = {
+    0.254829592, -0.284496736, 1.421413741, -1.453152027, 1.061405429,
+};
+
+#endif
@@ -0,0 +1,412 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Functions of one type, included by vmath.h once per SEW and LMUL with:
+//   VMATH_ST   : scalar type (_Float16, float, double)
+//   VMATH_SEW  : element width (16, 32, 64)
+//   VMATH_LMUL : LMUL suffix of the intrinsics (mf4, mf2, m1, m2, m4, m8)
+//   VMATH_MR   : SEW/LMUL, suffix of the mask type
+// No include guard: this file is meant to be included many times.
+
+// Types
+#define VM_T VMATH_CAT4(vfloat, VMATH_SEW, VMATH_LMUL, _t)
+#define VM_IT VMATH_CAT4(vint, VMATH_SEW, VMATH_LMUL, _t)
+#define VM_BT VMATH_CAT3(vbool, VMATH_MR, _t)
+#define VM_TF VMATH_CAT3(f, VMATH_SEW, VMATH_LMUL)
+#define VM_TI VMATH_CAT3(i, VMATH_SEW, VMATH_LMUL)
+
+// Intrinsics: VM_F(vfadd_vv) is vfadd_vv_f32m1, VM_CMPF(vmflt_vf) is
+// vmflt_vf_f32m1_b32, VM_M(vmor_mm) is vmor_mm_b32
+#define VM_F(op) VMATH_CAT3(op, _, VM_TF)
+#define VM_I(op) VMATH_CAT3(op, _, VM_TI)
+#define VM_CMPF(op) VMATH_CAT5(op, _, VM_TF, _b, VMATH_MR)
+#define VM_CMPI(op) VMATH_CAT5(op, _, VM_TI, _b, VMATH_MR)
+#define VM_M(op) VMATH_CAT3(op, _b, VMATH_MR)
+#define VM_F2I(v) VMATH_CAT4(vreinterpret_v_, VM_TF, _, VM_TI)(v)
+#define VM_I2F(v) VMATH_CAT4(vreinterpret_v_, VM_TI, _, VM_TF)(v)
+
+// Names and constants: VM_FN(exp_acc) is vmath_exp_acc_f32m1, VM_P(BIAS) is
+// VMATH_BIAS_32
+#define VM_FN(name) VMATH_CAT4(vmath_, name, _, VM_TF)
+#define VM_P(name) VMATH_CAT4(VMATH_, name, _, VMATH_SEW)
+#define VM_C(c) ((VMATH_ST)(c))
+#define VM_SPLAT(c) VM_F(vfmv_v_f)(VM_C(c), vl)
+
+#ifdef VMATH_FAST
+#define VM_TIER(name) VM_FN(name##_fast)
+#else
+#define VM_TIER(name) VM_FN(name##_acc)
+#endif
+
+/*
+  Building blocks
+*/
+
+// sum_k c[k * stride + off] w^k, for k < terms, in Horner form in w^2:
+// y = y w^2 + c[2j + 1] w + c[2j]. The coefficients are scalar operands of
+// vfmacc.vf and vfadd.vf, so that none of them is broadcast to a register.
+static inline VM_T VM_FN(poly_n)(VM_T w, const double *c, int stride, int off,
+                                 int terms, size_t vl) {
+#define VM_COEF(k) VM_C(c[(k) * stride + off])
+  if (terms == 1)
+    return VM_SPLAT(c[off]);
+
+  VM_T w2 = VM_F(vfmul_vv)(w, w, vl);
+  int j = (terms - 2) / 2;
+  VM_T y;
+  if (terms % 2)
+    y = VM_F(vfmacc_vf)(VM_F(vfmul_vf)(w2, VM_COEF(terms - 1), vl),
+                        VM_COEF(2 * j + 1), w, vl);
+  else
+    y = VM_F(vfmul_vf)(w, VM_COEF(2 * j + 1), vl);
+  y = VM_F(vfadd_vf)(y, VM_COEF(2 * j), vl);
+
+  for (--j; j >= 0; --j) {
+    y = VM_F(vfmul_vv)(y, w2, vl);
+    y = VM_F(vfmacc_vf)(y, VM_COEF(2 * j + 1), w, vl);
+    y = VM_F(vfadd_vf)(y, VM_COEF(2 * j), vl);
+  }
+  return y;
+#undef VM_COEF
+}
+
+// 1/d, with vfrec7 and steps Newton-Raphson iterations, or with a division if
+// steps < 0
+static inline VM_T VM_FN(rec_n)(VM_T d, int steps, size_t vl) {
+  if (steps < 0)
+    return VM_F(vfrdiv_vf)(d, VM_C(1), vl);
+
+  VM_T r = VM_F(vfrec7_v)(d, vl);
+  for (int k = 0; k < steps; ++k) {
+    // r = r (2 - d r)
+    VM_T e = VM_F(vfrsub_vf)(VM_F(vfmul_vv)(d, r, vl), VM_C(2), vl);
+    r = VM_F(vfmul_vv)(r, e, vl);
+  }
+  return r;
+}
+
+// n/d, as rec_n
+static inline VM_T VM_FN(div_n)(VM_T n, VM_T d, int steps, size_t vl) {
+  if (steps < 0)
+    return VM_F(vfdiv_vv)(n, d, vl);
+  return VM_F(vfmul_vv)(n, VM_FN(rec_n)(d, steps, vl), vl);
+}
+
+// exp(x), with a series of degree deg
+static inline VM_T VM_FN(exp_n)(VM_T x, int deg, size_t vl) {
+  x = VM_F(vfmin_vf)(x, VM_C(VM_P(EXP_HI)), vl);
+  x = VM_F(vfmax_vf)(x, VM_C(VM_P(EXP_LO)), vl);
+
+  // x = n ln(2) + r, |r| <= ln(2)/2
+  VM_IT n = VM_I(vfcvt_x_f_v)(VM_F(vfmul_vf)(x, VM_C(VMATH_LOG2E), vl), vl);
+  VM_T fn = VM_F(vfcvt_f_x_v)(n, vl);
+  VM_T r = VM_F(vfnmsac_vf)(x, VM_C(VM_P(LN2_HI)), fn, vl);
+  r = VM_F(vfnmsac_vf)(r, VM_C(VM_P(LN2_LO)), fn, vl);
+
+  VM_T y = VM_FN(poly_n)(r, vmath_inv_fact, 1, 0, deg + 1, vl);
+
+  // 2^n
+  n = VM_I(vadd_vx)(n, VM_P(BIAS), vl);
+  n = VM_I(vsll_vx)(n, VM_P(MANT), vl);
+  return VM_F(vfmul_vv)(y, VM_I2F(n), vl);
+}
+
+// log(x), with terms terms of the atanh series
+static inline VM_T VM_FN(log_n)(VM_T x, int terms, int steps, size_t vl) {
+  VM_BT invalid = VM_M(vmor_mm)(VM_CMPF(vmflt_vf)(x, VM_C(0), vl),
+                            VM_CMPF(vmfne_vv)(x, x, vl), vl);
+  VM_BT zero = VM_CMPF(vmfeq_vf)(x, VM_C(0), vl);
+  VM_BT inf = VM_CMPF(vmfeq_vf)(x, VM_C(INFINITY), vl);
+
+  // Flush the subnormals
+  x = VM_F(vfmax_vf)(x, VM_C(VM_P(MIN_NORMAL)), vl);
+
+  // x = m 2^e, m in [1, 2)
+  VM_IT bits = VM_F2I(x);
+  VM_IT e = VM_I(vsra_vx)(bits, VM_P(MANT), vl);
+  e = VM_I(vsub_vx)(e, VM_P(BIAS), vl);
+  bits = VM_I(vand_vx)(bits, ((int64_t)1 << VM_P(MANT)) - 1, vl);
+  bits = VM_I(vor_vx)(bits, (int64_t)VM_P(BIAS) << VM_P(MANT), vl);
+  VM_T m = VM_I2F(bits);
+
+  // m in [sqrt(2)/2, sqrt(2))
+  VM_BT big = VM_CMPF(vmfge_vf)(m, VM_C(VMATH_SQRT2), vl);
+  m = VM_F(vmerge_vvm)(big, m, VM_F(vfmul_vf)(m, VM_C(0.5), vl), vl);
+  e = VM_I(vmerge_vvm)(big, e, VM_I(vadd_vx)(e, 1, vl), vl);
+  VM_T fe = VM_F(vfcvt_f_x_v)(e, vl);
+
+  // log(m) = 2 atanh(s), s = (m - 1) / (m + 1)
+  VM_T s = VM_FN(div_n)(VM_F(vfsub_vf)(m, VM_C(1), vl),
+                        VM_F(vfadd_vf)(m, VM_C(1), vl), steps, vl);
+  VM_T p = VM_FN(poly_n)(VM_F(vfmul_vv)(s, s, vl), vmath_inv_odd, 1, 0, terms,
+                         vl);
+
+  // log(x) = e LN2_HI + (2 s p + e LN2_LO)
+  VM_T y = VM_F(vfmul_vv)(VM_F(vfadd_vv)(s, s, vl), p, vl);
+  y = VM_F(vfmacc_vf)(y, VM_C(VM_P(LN2_LO)), fe, vl);
+  y = VM_F(vfmacc_vf)(y, VM_C(VM_P(LN2_HI)), fe, vl);
+
+  y = VM_F(vfmerge_vfm)(zero, y, VM_C(-INFINITY), vl);
+  y = VM_F(vfmerge_vfm)(inf, y, VM_C(INFINITY), vl);
+  return VM_F(vfmerge_vfm)(invalid, y, VM_C(NAN), vl);
+}
+
+// x = n pi/2 + r, |r| <= pi/4, and sin(r) and cos(r) with terms terms of their
+// series. Returns n.
+static inline VM_IT VM_FN(sincos_red_n)(VM_T x, int terms, VM_T *s, VM_T *c,
+                                        size_t vl) {
+  VM_IT n = VM_I(vfcvt_x_f_v)(VM_F(vfmul_vf)(x, VM_C(VMATH_2_PI), vl), vl);
+  VM_T fn = VM_F(vfcvt_f_x_v)(n, vl);
+  VM_T r = VM_F(vfnmsac_vf)(x, VM_C(VM_P(PIO2_1)), fn, vl);
+  r = VM_F(vfnmsac_vf)(r, VM_C(VM_P(PIO2_2)), fn, vl);
+  r = VM_F(vfnmsac_vf)(r, VM_C(VM_P(PIO2_3)), fn, vl);
+
+  // sin(r) and cos(r), as series in z = -r^2
+  VM_T z = VM_F(vfmul_vv)(VM_F(vfneg_v)(r, vl), r, vl);
+  *s = VM_F(vfmul_vv)(r, VM_FN(poly_n)(z, vmath_inv_fact, 2, 1, terms, vl),
+                      vl);
+  *c = VM_FN(poly_n)(z, vmath_inv_fact, 2, 0, terms, vl);
+  return n;
+}
+
+// sin(x + quadrant pi/2), with terms terms of the sin and cos series
+static inline VM_T VM_FN(sincos_n)(VM_T x, int terms, int quadrant,
+                                   size_t vl) {
+  VM_T s, c;
+  VM_IT n = VM_FN(sincos_red_n)(x, terms, &s, &c, vl);
+
+  // The odd quadrants swap sin and cos, quadrants 2 and 3 flip the sign
+  VM_IT q = VM_I(vadd_vx)(n, quadrant, vl);
+  VM_BT swap = VM_CMPI(vmsne_vx)(VM_I(vand_vx)(q, 1, vl), 0, vl);
+  VM_T y = VM_F(vmerge_vvm)(swap, s, c, vl);
+  VM_IT sign = VM_I(vsll_vx)(VM_I(vand_vx)(q, 2, vl), VMATH_SEW - 2, vl);
+  return VM_I2F(VM_I(vxor_vv)(VM_F2I(y), sign, vl));
+}
+
+// sin(x), and cos(x) in *cos_x, from one range reduction and one evaluation of
+// each series. The quadrant of cos is the one of sin plus one, so the mask that
+// swaps the series of sin also picks the other one for cos, with no branch.
+static inline VM_T VM_FN(sincos2_n)(VM_T x, int terms, VM_T *cos_x,
+                                    size_t vl) {
+  VM_T s, c;
+  VM_IT n = VM_FN(sincos_red_n)(x, terms, &s, &c, vl);
+
+  VM_BT swap = VM_CMPI(vmsne_vx)(VM_I(vand_vx)(n, 1, vl), 0, vl);
+  VM_T ys = VM_F(vmerge_vvm)(swap, s, c, vl);
+  VM_T yc = VM_F(vmerge_vvm)(swap, c, s, vl);
+  VM_IT sign_s = VM_I(vsll_vx)(VM_I(vand_vx)(n, 2, vl), VMATH_SEW - 2, vl);
+  VM_IT sign_c = VM_I(vsll_vx)(
+      VM_I(vand_vx)(VM_I(vadd_vx)(n, 1, vl), 2, vl), VMATH_SEW - 2, vl);
+  *cos_x = VM_I2F(VM_I(vxor_vv)(VM_F2I(yc), sign_c, vl));
+  return VM_I2F(VM_I(vxor_vv)(VM_F2I(ys), sign_s, vl));
+}
+
+// tanh(x) = (1 - t) / (1 + t), t = exp(-2|x|), and the series of tanh with
+// terms terms for small |x|, where 1 - t cancels
+static inline VM_T VM_FN(tanh_n)(VM_T x, int deg, int steps, int terms,
+                                 size_t vl) {
+  VM_T a = VM_F(vfabs_v)(x, vl);
+  VM_T t = VM_FN(exp_n)(VM_F(vfmul_vf)(a, VM_C(-2), vl), deg, vl);
+  VM_T y = VM_FN(div_n)(VM_F(vfrsub_vf)(t, VM_C(1), vl),
+                        VM_F(vfadd_vf)(t, VM_C(1), vl), steps, vl);
+
+  if (terms > 0) {
+    VM_BT small = VM_CMPF(vmflt_vf)(a, VM_C(VMATH_TANH_SMALL), vl);
+    VM_T ys = VM_FN(poly_n)(VM_F(vfmul_vv)(a, a, vl), vmath_tanh_coef, 1, 0,
+                            terms, vl);
+    y = VM_F(vmerge_vvm)(small, y, VM_F(vfmul_vv)(a, ys, vl), vl);
+  }
+
+  return VM_F(vfsgnj_vv)(y, x, vl);
+}
+
+// 1 / (1 + exp(-x))
+static inline VM_T VM_FN(sigmoid_n)(VM_T x, int deg, int steps, size_t vl) {
+  VM_T t = VM_FN(exp_n)(VM_F(vfneg_v)(x, vl), deg, vl);
+  return VM_FN(rec_n)(VM_F(vfadd_vf)(t, VM_C(1), vl), steps, vl);
+}
+
+// erf(a) = 2/sqrt(pi) a sum_k (-a^2)^k / (k! (2k + 1)) where a is small, y
+// elsewhere
+static inline VM_T VM_FN(erf_small_n)(VM_T y, VM_T a, VM_T a2, size_t vl) {
+  VM_T ys = VM_FN(poly_n)(VM_F(vfneg_v)(a2, vl), vmath_erf_series, 1, 0,
+                          VM_P(ERF_TERMS), vl);
+  ys = VM_F(vfmul_vf)(VM_F(vfmul_vv)(ys, a, vl), VM_C(VMATH_2_SQRTPI), vl);
+
+  VM_BT small = VM_CMPF(vmflt_vf)(a, VM_C(VMATH_ERF_SMALL), vl);
+  return VM_F(vmerge_vvm)(small, y, ys, vl);
+}
+
+/*
+  Accurate tier
+*/
+
+static inline VM_T VM_FN(exp_acc)(VM_T x, size_t vl) {
+  return VM_FN(exp_n)(x, VM_P(EXP_DEG_ACC), vl);
+}
+
+static inline VM_T VM_FN(log_acc)(VM_T x, size_t vl) {
+  return VM_FN(log_n)(x, VM_P(LOG_TERMS_ACC), -1, vl);
+}
+
+static inline VM_T VM_FN(sin_acc)(VM_T x, size_t vl) {
+  return VM_FN(sincos_n)(x, VM_P(SIN_TERMS_ACC), 0, vl);
+}
+
+static inline VM_T VM_FN(cos_acc)(VM_T x, size_t vl) {
+  return VM_FN(sincos_n)(x, VM_P(SIN_TERMS_ACC), 1, vl);
+}
+
+static inline VM_T VM_FN(sincos_acc)(VM_T x, VM_T *cos_x, size_t vl) {
+  return VM_FN(sincos2_n)(x, VM_P(SIN_TERMS_ACC), cos_x, vl);
+}
+
+static inline VM_T VM_FN(tanh_acc)(VM_T x, size_t vl) {
+  return VM_FN(tanh_n)(x, VM_P(EXP_DEG_ACC), -1, VM_P(TANH_TERMS), vl);
+}
+
+static inline VM_T VM_FN(sigmoid_acc)(VM_T x, size_t vl) {
+  return VM_FN(sigmoid_n)(x, VM_P(EXP_DEG_ACC), -1, vl);
+}
+
+// erfc(|x|) with the Numerical Recipes approximation, and the series of erf for
+// small |x|, where 1 - erfc cancels
+static inline VM_T VM_FN(erf_acc)(VM_T x, size_t vl) {
+  VM_T a = VM_F(vfmin_vf)(VM_F(vfabs_v)(x, vl), VM_C(VM_P(ERF_MAX)), vl);
+  VM_T a2 = VM_F(vfmul_vv)(a, a, vl);
+
+  // 1 - t exp(-a^2 + P(t)), t = 1 / (1 + a/2)
+  VM_T t = VM_FN(rec_n)(VM_F(vfadd_vf)(VM_F(vfmul_vf)(a, VM_C(0.5), vl),
+                                       VM_C(1), vl),
+                        -1, vl);
+  VM_T p = VM_FN(poly_n)(t, vmath_erfc_coef, 1, 0, 10, vl);
+  p = VM_FN(exp_n)(VM_F(vfsub_vv)(p, a2, vl), VM_P(EXP_DEG_ACC), vl);
+  VM_T y = VM_F(vfrsub_vf)(VM_F(vfmul_vv)(t, p, vl), VM_C(1), vl);
+
+  y = VM_FN(erf_small_n)(y, a, a2, vl);
+  return VM_F(vfsgnj_vv)(y, x, vl);
+}
+
+/*
+  Fast tier
+*/
+
+static inline VM_T VM_FN(exp_fast)(VM_T x, size_t vl) {
+  return VM_FN(exp_n)(x, VM_P(EXP_DEG_FAST), vl);
+}
+
+static inline VM_T VM_FN(log_fast)(VM_T x, size_t vl) {
+  return VM_FN(log_n)(x, VM_P(LOG_TERMS_FAST), VM_P(REC_STEPS), vl);
+}
+
+static inline VM_T VM_FN(sin_fast)(VM_T x, size_t vl) {
+  return VM_FN(sincos_n)(x, VM_P(SIN_TERMS_FAST), 0, vl);
+}
+
+static inline VM_T VM_FN(cos_fast)(VM_T x, size_t vl) {
+  return VM_FN(sincos_n)(x, VM_P(SIN_TERMS_FAST), 1, vl);
+}
+
+static inline VM_T VM_FN(sincos_fast)(VM_T x, VM_T *cos_x, size_t vl) {
+  return VM_FN(sincos2_n)(x, VM_P(SIN_TERMS_FAST), cos_x, vl);
+}
+
+static inline VM_T VM_FN(tanh_fast)(VM_T x, size_t vl) {
+  return VM_FN(tanh_n)(x, VM_P(EXP_DEG_FAST), VM_P(REC_STEPS), 0, vl);
+}
+
+static inline VM_T VM_FN(sigmoid_fast)(VM_T x, size_t vl) {
+  return VM_FN(sigmoid_n)(x, VM_P(EXP_DEG_FAST), VM_P(REC_STEPS), vl);
+}
+
+// Abramowitz and Stegun 7.1.26: 1 - t P(t) exp(-a^2), t = 1 / (1 + p a), and
+// the series of erf for small |x|, where the coefficients of P cancel
+static inline VM_T VM_FN(erf_fast)(VM_T x, size_t vl) {
+  VM_T a = VM_F(vfmin_vf)(VM_F(vfabs_v)(x, vl), VM_C(VM_P(ERF_MAX)), vl);
+  VM_T a2 = VM_F(vfmul_vv)(a, a, vl);
+
+  VM_T t = VM_FN(rec_n)(VM_F(vfadd_vf)(VM_F(vfmul_vf)(a, VM_C(VMATH_ERF_AS_P),
+                                                      vl),
+                                       VM_C(1), vl),
+                        VM_P(REC_STEPS), vl);
+  VM_T p = VM_F(vfmul_vv)(t, VM_FN(poly_n)(t, vmath_erf_as_coef, 1, 0, 5, vl),
+                          vl);
+  VM_T e = VM_FN(exp_n)(VM_F(vfneg_v)(a2, vl), VM_P(EXP_DEG_FAST), vl);
+  VM_T y = VM_F(vfrsub_vf)(VM_F(vfmul_vv)(p, e, vl), VM_C(1), vl);
+
+  y = VM_FN(erf_small_n)(y, a, a2, vl);
+  return VM_F(vfsgnj_vv)(y, x, vl);
+}
+
+/*
+  Tier selected at compile time, with VMATH_FAST
+*/
+
+static inline VM_T VM_FN(exp)(VM_T x, size_t vl) { return VM_TIER(exp)(x, vl); }
+static inline VM_T VM_FN(log)(VM_T x, size_t vl) { return VM_TIER(log)(x, vl); }
+static inline VM_T VM_FN(sin)(VM_T x, size_t vl) { return VM_TIER(sin)(x, vl); }
+static inline VM_T VM_FN(cos)(VM_T x, size_t vl) { return VM_TIER(cos)(x, vl); }
+static inline VM_T VM_FN(sincos)(VM_T x, VM_T *cos_x, size_t vl) {
+  return VM_TIER(sincos)(x, cos_x, vl);
+}
+static inline VM_T VM_FN(tanh)(VM_T x, size_t vl) {
+  return VM_TIER(tanh)(x, vl);
+}
+static inline VM_T VM_FN(sigmoid)(VM_T x, size_t vl) {
+  return VM_TIER(sigmoid)(x, vl);
+}
+static inline VM_T VM_FN(erf)(VM_T x, size_t vl) { return VM_TIER(erf)(x, vl); }
+
+/*
+  Activations, on the tier selected at compile time
+*/
+
+// GELU, tanh approximation: x/2 (1 + tanh(u)),
+// u = sqrt(2/pi) (x + VMATH_GELU_C x^3)
+static inline VM_T VM_FN(gelu)(VM_T x, size_t vl) {
+  VM_T x2 = VM_F(vfmul_vv)(x, x, vl);
+  VM_T u = VM_F(vfmul_vf)(x2, VM_C(VMATH_GELU_C * VMATH_SQRT_2_PI), vl);
+  u = VM_F(vfmul_vv)(VM_F(vfadd_vf)(u, VM_C(VMATH_SQRT_2_PI), vl), x, vl);
+  VM_T t = VM_FN(tanh)(u, vl);
+  return VM_F(vfmul_vv)(VM_F(vfmul_vf)(x, VM_C(0.5), vl),
+                        VM_F(vfadd_vf)(t, VM_C(1), vl), vl);
+}
+
+// SiLU: x sigmoid(x)
+static inline VM_T VM_FN(silu)(VM_T x, size_t vl) {
+  return VM_F(vfmul_vv)(x, VM_FN(sigmoid)(x, vl), vl);
+}
+
+#undef VM_T
+#undef VM_IT
+#undef VM_BT
+#undef VM_TF
+#undef VM_TI
+#undef VM_F
+#undef VM_I
+#undef VM_CMPF
+#undef VM_CMPI
+#undef VM_M
+#undef VM_F2I
+#undef VM_I2F
+#undef VM_FN
+#undef VM_P
+#undef VM_C
+#undef VM_SPLAT
+#undef VM_TIER
+
+#undef VMATH_LMUL
+#undef VMATH_MR
@@ -0,0 +1,131 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Counter-based vector random number generators: the i-th number of a stream
+// is a function of (seed, i) only, so that any slice of the stream can be
+// generated in parallel, with no state to carry between the strips, e.g.,
+// vrand_u32m8(seed, ctr, vl) returns the numbers ctr to ctr + vl - 1 of the
+// stream seed.
+//
+// Two generators:
+//   vrand_hash_<type>   : xorshift-multiply hash of the counter (lowbias32),
+//                         5 vector operations per number
+//   vrand_philox_<type> : Philox-2x32 with VRAND_PHILOX_ROUNDS rounds
+//                         (default: 10), 4 vector operations per round
+// vrand_<type> is the hash, or Philox if VRAND_PHILOX is defined at compile
+// time. vrand_<gen>_scalar(seed, ctr) is the scalar reference of each one.
+
+#ifndef _VRAND_H_
+#define _VRAND_H_
+
+#include <stdint.h>
+
+#include "riscv_vector.h"
+
+#ifndef VRAND_PHILOX_ROUNDS
+#define VRAND_PHILOX_ROUNDS 10
+#endif
+
+// Philox-2x32 multiplier and Weyl key increment
+#define VRAND_PHILOX_M 0xD256D347u
+#define VRAND_PHILOX_W 0x9E3779B9u
+
+// lowbias32 multipliers
+#define VRAND_HASH_M0 0x7FEB352Du
+#define VRAND_HASH_M1 0x846CA68Bu
+
+static inline uint32_t vrand_hash_mix(uint32_t x) {
+  x ^= x >> 16;
+  x *= VRAND_HASH_M0;
+  x ^= x >> 15;
+  x *= VRAND_HASH_M1;
+  x ^= x >> 16;
+  return x;
+}
+
+// The seed is mixed once, so that close seeds give unrelated streams
+static inline uint32_t vrand_hash_scalar(uint32_t seed, uint32_t ctr) {
+  return vrand_hash_mix(ctr ^ vrand_hash_mix(seed));
+}
+
+static inline uint32_t vrand_philox_scalar(uint32_t seed, uint32_t ctr) {
+  uint32_t x0 = ctr, x1 = 0, key = seed;
+  for (int r = 0; r < VRAND_PHILOX_ROUNDS; ++r) {
+    uint64_t prod = (uint64_t)x0 * VRAND_PHILOX_M;
+    x0 = (uint32_t)(prod >> 32) ^ key ^ x1;
+    x1 = (uint32_t)prod;
+    key += VRAND_PHILOX_W;
+  }
+  return x0;
+}
+
+#define VRAND_DEF(LMUL)                                                        \
+  static inline vuint32##LMUL##_t vrand_ctr_##LMUL(uint32_t ctr, size_t vl) {  \
+    return vadd_vx_u32##LMUL(vid_v_u32##LMUL(vl), ctr, vl);                    \
+  }                                                                            \
+                                                                               \
+  static inline vuint32##LMUL##_t vrand_hash_u32##LMUL(uint32_t seed,          \
+                                                       uint32_t ctr,           \
+                                                       size_t vl) {            \
+    vuint32##LMUL##_t x = vxor_vx_u32##LMUL(vrand_ctr_##LMUL(ctr, vl),         \
+                                            vrand_hash_mix(seed), vl);         \
+    x = vxor_vv_u32##LMUL(x, vsrl_vx_u32##LMUL(x, 16, vl), vl);                \
+    x = vmul_vx_u32##LMUL(x, VRAND_HASH_M0, vl);                               \
+    x = vxor_vv_u32##LMUL(x, vsrl_vx_u32##LMUL(x, 15, vl), vl);                \
+    x = vmul_vx_u32##LMUL(x, VRAND_HASH_M1, vl);                               \
+    return vxor_vv_u32##LMUL(x, vsrl_vx_u32##LMUL(x, 16, vl), vl);             \
+  }                                                                            \
+                                                                               \
+  static inline vuint32##LMUL##_t vrand_philox_u32##LMUL(uint32_t seed,        \
+                                                         uint32_t ctr,         \
+                                                         size_t vl) {          \
+    vuint32##LMUL##_t x0 = vrand_ctr_##LMUL(ctr, vl);                          \
+    /* The first round, with x1 == 0 */                                        \
+    vuint32##LMUL##_t x1 = vmul_vx_u32##LMUL(x0, VRAND_PHILOX_M, vl);          \
+    x0 = vxor_vx_u32##LMUL(vmulhu_vx_u32##LMUL(x0, VRAND_PHILOX_M, vl), seed,  \
+                           vl);                                                \
+    uint32_t key = seed + VRAND_PHILOX_W;                                      \
+    for (int r = 1; r < VRAND_PHILOX_ROUNDS; ++r) {                            \
+      vuint32##LMUL##_t hi = vmulhu_vx_u32##LMUL(x0, VRAND_PHILOX_M, vl);      \
+      x0 = vmul_vx_u32##LMUL(x0, VRAND_PHILOX_M, vl);                          \
+      hi = vxor_vv_u32##LMUL(hi, x1, vl);                                      \
+      x1 = x0;                                                                 \
+      x0 = vxor_vx_u32##LMUL(hi, key, vl);                                     \
+      key += VRAND_PHILOX_W;                                                   \
+    }                                                                          \
+    return x0;                                                                 \
+  }
+
+VRAND_DEF(m1)
+VRAND_DEF(m2)
+VRAND_DEF(m4)
+VRAND_DEF(m8)
+
+#ifdef VRAND_PHILOX
+#define vrand_scalar vrand_philox_scalar
+#define vrand_u32m1 vrand_philox_u32m1
+#define vrand_u32m2 vrand_philox_u32m2
+#define vrand_u32m4 vrand_philox_u32m4
+#define vrand_u32m8 vrand_philox_u32m8
+#else
+#define vrand_scalar vrand_hash_scalar
+#define vrand_u32m1 vrand_hash_u32m1
+#define vrand_u32m2 vrand_hash_u32m2
+#define vrand_u32m4 vrand_hash_u32m4
+#define vrand_u32m8 vrand_hash_u32m8
+#endif
+
+#endif
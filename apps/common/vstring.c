@@ -0,0 +1,101 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// RVV implementations of memcpy, memset, and memcmp, which override the scalar
+// ones of string.c when this file is linked (vstring=1 in runtime.mk). The
+// buffers are strip-mined with LMUL=8. If the buffers and the length are
+// 64-bit aligned, the strips are of 64-bit elements: the same bytes per strip
+// with an eighth of the elements, and the loads and stores are full AXI beats.
+
+#include <stdint.h>
+#include <string.h>
+
+#define VSTRING_ALIGNED(x) (((uintptr_t)(x) & (sizeof(uint64_t) - 1)) == 0)
+
+void *memcpy(void *dest, const void *src, size_t len) {
+  char *d = dest;
+  const char *s = src;
+  size_t vl;
+
+  if (VSTRING_ALIGNED((uintptr_t)d | (uintptr_t)s | len)) {
+    for (size_t n = len / sizeof(uint64_t); n > 0; n -= vl) {
+      asm volatile("vsetvli %0, %1, e64, m8, ta, ma" : "=r"(vl) : "r"(n));
+      asm volatile("vle64.v v8, (%0)" ::"r"(s) : "memory");
+      asm volatile("vse64.v v8, (%0)" ::"r"(d) : "memory");
+      s += vl * sizeof(uint64_t);
+      d += vl * sizeof(uint64_t);
+    }
+  } else {
+    for (size_t n = len; n > 0; n -= vl) {
+      asm volatile("vsetvli %0, %1, e8, m8, ta, ma" : "=r"(vl) : "r"(n));
+      asm volatile("vle8.v v8, (%0)" ::"r"(s) : "memory");
+      asm volatile("vse8.v v8, (%0)" ::"r"(d) : "memory");
+      s += vl;
+      d += vl;
+    }
+  }
+  return dest;
+}
+
+void *memset(void *dest, int byte, size_t len) {
+  char *d = dest;
+  size_t vl;
+
+  // The byte is splatted once, on the whole register group
+  if (VSTRING_ALIGNED((uintptr_t)d | len)) {
+    uint64_t word = byte & 0xFF;
+    word |= word << 8;
+    word |= word << 16;
+    word |= word << 32;
+    asm volatile("vsetvli %0, zero, e64, m8, ta, ma" : "=r"(vl));
+    asm volatile("vmv.v.x v8, %0" ::"r"(word));
+    for (size_t n = len / sizeof(uint64_t); n > 0; n -= vl) {
+      asm volatile("vsetvli %0, %1, e64, m8, ta, ma" : "=r"(vl) : "r"(n));
+      asm volatile("vse64.v v8, (%0)" ::"r"(d) : "memory");
+      d += vl * sizeof(uint64_t);
+    }
+  } else {
+    asm volatile("vsetvli %0, zero, e8, m8, ta, ma" : "=r"(vl));
+    asm volatile("vmv.v.x v8, %0" ::"r"(byte));
+    for (size_t n = len; n > 0; n -= vl) {
+      asm volatile("vsetvli %0, %1, e8, m8, ta, ma" : "=r"(vl) : "r"(n));
+      asm volatile("vse8.v v8, (%0)" ::"r"(d) : "memory");
+      d += vl;
+    }
+  }
+  return dest;
+}
+
+int memcmp(const void *s1, const void *s2, size_t n) {
+  const unsigned char *p1 = s1;
+  const unsigned char *p2 = s2;
+  size_t vl;
+  long first;
+
+  // Compare a strip at a time, and stop at the first one with a difference
+  for (; n > 0; n -= vl) {
+    asm volatile("vsetvli %0, %1, e8, m8, ta, ma" : "=r"(vl) : "r"(n));
+    asm volatile("vle8.v v8, (%0)" ::"r"(p1) : "memory");
+    asm volatile("vle8.v v16, (%0)" ::"r"(p2) : "memory");
+    asm volatile("vmsne.vv v0, v8, v16");
+    asm volatile("vfirst.m %0, v0" : "=r"(first));
+    if (first >= 0)
+      return p1[first] - p2[first];
+    p1 += vl;
+    p2 += vl;
+  }
+  return 0;
+}
@@ -0,0 +1,231 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "conv2d_layer.h"
+
+#define MIN(a, b) ((a) < (b) ? (a) : (b))
+
+// The output rows are vectorized over their columns, at LMUL=2. Each input
+// vector is loaded once for CONV2D_LAYER_CO_BLOCK output channels, whose rows
+// are accumulated in v0-v14. The input vectors alternate between v16 and v18.
+// The columns whose taps fall in the padding are computed by the scalar core.
+void conv2d_layer(double *o, const double *i, const double *f, const double *b,
+                  const unsigned long int N, const unsigned long int C_in,
+                  const unsigned long int C_out, const unsigned long int H,
+                  const unsigned long int W, const unsigned long int K,
+                  const unsigned long int stride,
+                  const unsigned long int pad) {
+  const unsigned long int Ho = (H + 2 * pad - K) / stride + 1;
+  const unsigned long int Wo = (W + 2 * pad - K) / stride + 1;
+
+  // Output columns [ox0, ox1) have all their taps within the input columns
+  const unsigned long int ox0 = MIN(Wo, (pad + stride - 1) / stride);
+  unsigned long int ox1 =
+      (W + pad >= K) ? MIN(Wo, (W + pad - K) / stride + 1) : 0;
+  if (ox1 < ox0)
+    ox1 = ox0;
+
+  for (unsigned long int n = 0; n < N; ++n) {
+    const double *i_ = i + n * C_in * H * W;
+
+    for (unsigned long int co = 0; co < C_out; co += CONV2D_LAYER_CO_BLOCK) {
+      const unsigned long int nco = MIN(C_out - co, CONV2D_LAYER_CO_BLOCK);
+      const double *f_ = f + co * C_in * K * K;
+      double *o_ = o + (n * C_out + co) * Ho * Wo;
+
+      for (unsigned long int oy = 0; oy < Ho; ++oy) {
+        const long int iy = (long int)(oy * stride) - (long int)pad;
+        double *o__ = o_ + oy * Wo;
+
+        unsigned long int vl;
+        for (unsigned long int ox = ox0; ox < ox1; ox += vl) {
+          asm volatile("vsetvli %0, %1, e64, m2, ta, ma"
+                       : "=r"(vl)
+                       : "r"(ox1 - ox));
+          conv2d_layer_vec(o__ + ox, i_ + ox * stride - pad, f_, b + co, nco,
+                           C_in, H, W, K, stride, iy, Ho * Wo);
+        }
+
+        for (unsigned long int ox = 0; ox < ox0; ++ox)
+          conv2d_layer_scalar(o__ + ox, i_, f_, b + co, nco, C_in, H, W, K, iy,
+                              (long int)(ox * stride) - (long int)pad, Ho * Wo);
+        for (unsigned long int ox = ox1; ox < Wo; ++ox)
+          conv2d_layer_scalar(o__ + ox, i_, f_, b + co, nco, C_in, H, W, K, iy,
+                              (long int)(ox * stride) - (long int)pad, Ho * Wo);
+      }
+    }
+  }
+}
+
+// vl output columns of nco output channels, starting from the input row iy.
+// i points to the first input column of the taps, in the channel 0 and row 0.
+void conv2d_layer_vec(double *o, const double *i, const double *f,
+                      const double *b, const unsigned long int nco,
+                      const unsigned long int C_in, const unsigned long int H,
+                      const unsigned long int W, const unsigned long int K,
+                      const unsigned long int stride, const long int iy,
+                      const unsigned long int ldo) {
+  const unsigned long int ldf = C_in * K * K;
+  const double zero = 0;
+
+  // Start from the bias
+  asm volatile("vfmv.v.f v0, %0" ::"f"(b[0]));
+  if (nco > 1)
+    asm volatile("vfmv.v.f v2, %0" ::"f"(b[1]));
+  if (nco > 2)
+    asm volatile("vfmv.v.f v4, %0" ::"f"(b[2]));
+  if (nco > 3)
+    asm volatile("vfmv.v.f v6, %0" ::"f"(b[3]));
+  if (nco > 4)
+    asm volatile("vfmv.v.f v8, %0" ::"f"(b[4]));
+  if (nco > 5)
+    asm volatile("vfmv.v.f v10, %0" ::"f"(b[5]));
+  if (nco > 6)
+    asm volatile("vfmv.v.f v12, %0" ::"f"(b[6]));
+  if (nco > 7)
+    asm volatile("vfmv.v.f v14, %0" ::"f"(b[7]));
+
+  for (unsigned long int ci = 0; ci < C_in; ++ci) {
+    for (unsigned long int ky = 0; ky < K; ++ky) {
+      const long int y = iy + (long int)ky;
+      // Rows in the padding do not contribute
+      if (y < 0 || y >= (long int)H)
+        continue;
+
+      const double *i_ = i + (ci * H + y) * W;
+      const double *f_ = f + (ci * K + ky) * K;
+
+      unsigned long int kx = 0;
+      for (; kx + 2 <= K; kx += 2) {
+        conv2d_layer_tap_v16(i_ + kx, f_ + kx, nco, stride, ldf);
+        conv2d_layer_tap_v18(i_ + kx + 1, f_ + kx + 1, nco, stride, ldf);
+      }
+      if (kx < K)
+        conv2d_layer_tap_v16(i_ + kx, f_ + kx, nco, stride, ldf);
+    }
+  }
+
+  // ReLU, and store
+  asm volatile("vfmax.vf v0, v0, %0" ::"f"(zero));
+  asm volatile("vse64.v v0, (%0);" ::"r"(o));
+  if (nco > 1) {
+    asm volatile("vfmax.vf v2, v2, %0" ::"f"(zero));
+    asm volatile("vse64.v v2, (%0);" ::"r"(o + 1 * ldo));
+  }
+  if (nco > 2) {
+    asm volatile("vfmax.vf v4, v4, %0" ::"f"(zero));
+    asm volatile("vse64.v v4, (%0);" ::"r"(o + 2 * ldo));
+  }
+  if (nco > 3) {
+    asm volatile("vfmax.vf v6, v6, %0" ::"f"(zero));
+    asm volatile("vse64.v v6, (%0);" ::"r"(o + 3 * ldo));
+  }
+  if (nco > 4) {
+    asm volatile("vfmax.vf v8, v8, %0" ::"f"(zero));
+    asm volatile("vse64.v v8, (%0);" ::"r"(o + 4 * ldo));
+  }
+  if (nco > 5) {
+    asm volatile("vfmax.vf v10, v10, %0" ::"f"(zero));
+    asm volatile("vse64.v v10, (%0);" ::"r"(o + 5 * ldo));
+  }
+  if (nco > 6) {
+    asm volatile("vfmax.vf v12, v12, %0" ::"f"(zero));
+    asm volatile("vse64.v v12, (%0);" ::"r"(o + 6 * ldo));
+  }
+  if (nco > 7) {
+    asm volatile("vfmax.vf v14, v14, %0" ::"f"(zero));
+    asm volatile("vse64.v v14, (%0);" ::"r"(o + 7 * ldo));
+  }
+}
+
+// Load the input vector of a tap, and accumulate it on the nco output channels
+void conv2d_layer_tap_v16(const double *i, const double *f,
+                          const unsigned long int nco,
+                          const unsigned long int stride,
+                          const unsigned long int ldf) {
+  if (stride == 1)
+    asm volatile("vle64.v v16, (%0);" ::"r"(i));
+  else
+    asm volatile("vlse64.v v16, (%0), %1;" ::"r"(i), "r"(stride << 3));
+  asm volatile("vfmacc.vf v0, %0, v16" ::"f"(f[0]));
+  if (nco > 1)
+    asm volatile("vfmacc.vf v2, %0, v16" ::"f"(f[1 * ldf]));
+  if (nco > 2)
+    asm volatile("vfmacc.vf v4, %0, v16" ::"f"(f[2 * ldf]));
+  if (nco > 3)
+    asm volatile("vfmacc.vf v6, %0, v16" ::"f"(f[3 * ldf]));
+  if (nco > 4)
+    asm volatile("vfmacc.vf v8, %0, v16" ::"f"(f[4 * ldf]));
+  if (nco > 5)
+    asm volatile("vfmacc.vf v10, %0, v16" ::"f"(f[5 * ldf]));
+  if (nco > 6)
+    asm volatile("vfmacc.vf v12, %0, v16" ::"f"(f[6 * ldf]));
+  if (nco > 7)
+    asm volatile("vfmacc.vf v14, %0, v16" ::"f"(f[7 * ldf]));
+}
+
+void conv2d_layer_tap_v18(const double *i, const double *f,
+                          const unsigned long int nco,
+                          const unsigned long int stride,
+                          const unsigned long int ldf) {
+  if (stride == 1)
+    asm volatile("vle64.v v18, (%0);" ::"r"(i));
+  else
+    asm volatile("vlse64.v v18, (%0), %1;" ::"r"(i), "r"(stride << 3));
+  asm volatile("vfmacc.vf v0, %0, v18" ::"f"(f[0]));
+  if (nco > 1)
+    asm volatile("vfmacc.vf v2, %0, v18" ::"f"(f[1 * ldf]));
+  if (nco > 2)
+    asm volatile("vfmacc.vf v4, %0, v18" ::"f"(f[2 * ldf]));
+  if (nco > 3)
+    asm volatile("vfmacc.vf v6, %0, v18" ::"f"(f[3 * ldf]));
+  if (nco > 4)
+    asm volatile("vfmacc.vf v8, %0, v18" ::"f"(f[4 * ldf]));
+  if (nco > 5)
+    asm volatile("vfmacc.vf v10, %0, v18" ::"f"(f[5 * ldf]));
+  if (nco > 6)
+    asm volatile("vfmacc.vf v12, %0, v18" ::"f"(f[6 * ldf]));
+  if (nco > 7)
+    asm volatile("vfmacc.vf v14, %0, v18" ::"f"(f[7 * ldf]));
+}
+
+// One output column of nco output channels, whose first tap is at (iy, ix)
+void conv2d_layer_scalar(double *o, const double *i, const double *f,
+                         const double *b, const unsigned long int nco,
+                         const unsigned long int C_in,
+                         const unsigned long int H, const unsigned long int W,
+                         const unsigned long int K, const long int iy,
+                         const long int ix, const unsigned long int ldo) {
+  for (unsigned long int c = 0; c < nco; ++c) {
+    const double *f_ = f + c * C_in * K * K;
+    double acc = b[c];
+
+    for (unsigned long int ci = 0; ci < C_in; ++ci)
+      for (unsigned long int ky = 0; ky < K; ++ky) {
+        const long int y = iy + (long int)ky;
+        if (y < 0 || y >= (long int)H)
+          continue;
+        for (unsigned long int kx = 0; kx < K; ++kx) {
+          const long int x = ix + (long int)kx;
+          if (x < 0 || x >= (long int)W)
+            continue;
+          acc += f_[(ci * K + ky) * K + kx] * i[(ci * H + y) * W + x];
+        }
+      }
+
+    o[c * ldo] = acc > 0 ? acc : 0;
+  }
+}
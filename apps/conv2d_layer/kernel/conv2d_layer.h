@@ -0,0 +1,142 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _CONV2D_LAYER_H_
+#define _CONV2D_LAYER_H_
+
+#include <stdint.h>
+
+// Output channels computed at once, on the same input vectors
+#define CONV2D_LAYER_CO_BLOCK 8
+
+// Words of the work buffer of the im2col and Winograd algorithms. The shapes
+// that do not fit in it fall back to the direct convolution.
+#ifndef CONV2D_LAYER_WORK_WORDS
+#define CONV2D_LAYER_WORK_WORDS (1 << 17)
+#endif
+
+extern double conv2d_layer_work[];
+
+// Convolution algorithms
+typedef enum {
+  CONV2D_LAYER_DIRECT = 0,
+  CONV2D_LAYER_IM2COL = 1,
+  CONV2D_LAYER_WINOGRAD = 2
+} conv2d_layer_algo_t;
+
+// Measured fastest algorithm of a shape, from conv2d_layer_table.h
+typedef struct {
+  unsigned int nr_lanes;
+  unsigned int K;
+  unsigned int stride;
+  unsigned int c_in;
+  unsigned int c_out;
+  unsigned int hw;
+  conv2d_layer_algo_t algo;
+} conv2d_layer_entry_t;
+
+// Convolution layer on NCHW tensors, with bias and ReLU:
+// o[n][co][y][x] = max(0, b[co] + sum_{ci, ky, kx} f[co][ci][ky][kx] *
+//                  i[n][ci][y * stride + ky - pad][x * stride + kx - pad])
+// with i=[N x C_in x H x W], f=[C_out x C_in x K x K], b=[C_out], and
+// o=[N x C_out x Ho x Wo], Ho = (H + 2 * pad - K) / stride + 1, and the same
+// for Wo. The input is zero outside of its H x W elements.
+void conv2d_layer(double *o, const double *i, const double *f, const double *b,
+                  unsigned long int N, unsigned long int C_in,
+                  unsigned long int C_out, unsigned long int H,
+                  unsigned long int W, unsigned long int K,
+                  unsigned long int stride, unsigned long int pad);
+
+// Same layer, with the algorithm that is the fastest for its shape on NR_LANES
+// lanes: the one of the nearest measured shape of conv2d_layer_table.h, or a
+// heuristic if the table has no shape with the same filter size and stride
+void conv2d_layer_auto(double *o, const double *i, const double *f,
+                       const double *b, unsigned long int N,
+                       unsigned long int C_in, unsigned long int C_out,
+                       unsigned long int H, unsigned long int W,
+                       unsigned long int K, unsigned long int stride,
+                       unsigned long int pad);
+conv2d_layer_algo_t conv2d_layer_select(unsigned long int C_in,
+                                        unsigned long int C_out,
+                                        unsigned long int H,
+                                        unsigned long int W,
+                                        unsigned long int K,
+                                        unsigned long int stride);
+void conv2d_layer_run(conv2d_layer_algo_t algo, double *o, const double *i,
+                      const double *f, const double *b, unsigned long int N,
+                      unsigned long int C_in, unsigned long int C_out,
+                      unsigned long int H, unsigned long int W,
+                      unsigned long int K, unsigned long int stride,
+                      unsigned long int pad);
+
+// im2col matrix of a band of output rows, multiplied by the filters with
+// fmatmul_tiled
+void conv2d_layer_im2col(double *o, const double *i, const double *f,
+                         const double *b, unsigned long int N,
+                         unsigned long int C_in, unsigned long int C_out,
+                         unsigned long int H, unsigned long int W,
+                         unsigned long int K, unsigned long int stride,
+                         unsigned long int pad);
+void conv2d_layer_im2col_band(double *col, const double *i,
+                              unsigned long int C_in, unsigned long int H,
+                              unsigned long int W, unsigned long int K,
+                              unsigned long int stride, unsigned long int pad,
+                              unsigned long int oy, unsigned long int oyn,
+                              unsigned long int Wo);
+void conv2d_layer_bias_relu(double *o, const double *b,
+                            unsigned long int C_out, unsigned long int P,
+                            unsigned long int ldo);
+void conv2d_layer_zero(double *o, unsigned long int len);
+void conv2d_layer_copy(double *o, const double *i, unsigned long int len);
+
+// Winograd F(2x2, 3x3), for K = 3 and stride = 1 only
+void conv2d_layer_winograd(double *o, const double *i, const double *f,
+                           const double *b, unsigned long int N,
+                           unsigned long int C_in, unsigned long int C_out,
+                           unsigned long int H, unsigned long int W,
+                           unsigned long int K, unsigned long int stride,
+                           unsigned long int pad);
+void conv2d_layer_winograd_filter(double *u, const double *f,
+                                  unsigned long int C_in,
+                                  unsigned long int C_out);
+void conv2d_layer_winograd_input(double *v, const double *i,
+                                 unsigned long int Wp, unsigned long int tx_n,
+                                 unsigned long int ldv);
+void conv2d_layer_winograd_output(double *o, const double *m,
+                                  unsigned long int ldm, double bias,
+                                  unsigned long int oy, unsigned long int Ho,
+                                  unsigned long int Wo,
+                                  unsigned long int tx_n);
+
+void conv2d_layer_vec(double *o, const double *i, const double *f,
+                      const double *b, unsigned long int nco,
+                      unsigned long int C_in, unsigned long int H,
+                      unsigned long int W, unsigned long int K,
+                      unsigned long int stride, long int iy,
+                      unsigned long int ldo);
+void conv2d_layer_tap_v16(const double *i, const double *f,
+                          unsigned long int nco, unsigned long int stride,
+                          unsigned long int ldf);
+void conv2d_layer_tap_v18(const double *i, const double *f,
+                          unsigned long int nco, unsigned long int stride,
+                          unsigned long int ldf);
+void conv2d_layer_scalar(double *o, const double *i, const double *f,
+                         const double *b, unsigned long int nco,
+                         unsigned long int C_in, unsigned long int H,
+                         unsigned long int W, unsigned long int K, long int iy,
+                         long int ix, unsigned long int ldo);
+
+#endif
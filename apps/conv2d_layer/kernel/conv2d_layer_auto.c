@@ -0,0 +1,98 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "conv2d_layer.h"
+#include "conv2d_layer_table.h"
+
+double conv2d_layer_work[CONV2D_LAYER_WORK_WORDS]
+    __attribute__((aligned(32 * NR_LANES)));
+
+static unsigned long int conv2d_layer_ilog2(unsigned long int x) {
+  unsigned long int l = 0;
+  while (x >>= 1)
+    ++l;
+  return l;
+}
+
+static unsigned long int conv2d_layer_dist(const unsigned long int a,
+                                           const unsigned long int b) {
+  const unsigned long int la = conv2d_layer_ilog2(a);
+  const unsigned long int lb = conv2d_layer_ilog2(b);
+  return la > lb ? la - lb : lb - la;
+}
+
+// The measured shapes are compared by the ratios of their channels and of
+// their image size
+conv2d_layer_algo_t conv2d_layer_select(const unsigned long int C_in,
+                                        const unsigned long int C_out,
+                                        const unsigned long int H,
+                                        const unsigned long int W,
+                                        const unsigned long int K,
+                                        const unsigned long int stride) {
+  const conv2d_layer_entry_t *best = 0;
+  unsigned long int best_dist = -1;
+
+  for (const conv2d_layer_entry_t *e = conv2d_layer_table; e->nr_lanes != 0;
+       ++e) {
+    if (e->nr_lanes != NR_LANES || e->K != K || e->stride != stride)
+      continue;
+    const unsigned long int dist = conv2d_layer_dist(e->c_in, C_in) +
+                                   conv2d_layer_dist(e->c_out, C_out) +
+                                   conv2d_layer_dist(e->hw, H * W);
+    if (dist < best_dist) {
+      best = e;
+      best_dist = dist;
+    }
+  }
+  if (best)
+    return best->algo;
+
+  // Winograd saves most of the multiplications of the 3x3 filters, and im2col
+  // turns the layer into a single large matmul, as long as there are enough
+  // channels to amortize the transforms
+  if (K == 3 && stride == 1 && C_in >= 16 && C_out >= 16)
+    return CONV2D_LAYER_WINOGRAD;
+  if (C_in * K * K >= 64 && C_out >= 16)
+    return CONV2D_LAYER_IM2COL;
+  return CONV2D_LAYER_DIRECT;
+}
+
+void conv2d_layer_run(const conv2d_layer_algo_t algo, double *o,
+                      const double *i, const double *f, const double *b,
+                      const unsigned long int N, const unsigned long int C_in,
+                      const unsigned long int C_out, const unsigned long int H,
+                      const unsigned long int W, const unsigned long int K,
+                      const unsigned long int stride,
+                      const unsigned long int pad) {
+  if (algo == CONV2D_LAYER_WINOGRAD)
+    conv2d_layer_winograd(o, i, f, b, N, C_in, C_out, H, W, K, stride, pad);
+  else if (algo == CONV2D_LAYER_IM2COL)
+    conv2d_layer_im2col(o, i, f, b, N, C_in, C_out, H, W, K, stride, pad);
+  else
+    conv2d_layer(o, i, f, b, N, C_in, C_out, H, W, K, stride, pad);
+}
+
+void conv2d_layer_auto(double *o, const double *i, const double *f,
+                       const double *b, const unsigned long int N,
+                       const unsigned long int C_in,
+                       const unsigned long int C_out,
+                       const unsigned long int H, const unsigned long int W,
+                       const unsigned long int K,
+                       const unsigned long int stride,
+                       const unsigned long int pad) {
+  conv2d_layer_run(conv2d_layer_select(C_in, C_out, H, W, K, stride), o, i, f,
+                   b, N, C_in, C_out, H, W, K, stride, pad);
+}
@@ -0,0 +1,150 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "conv2d_layer.h"
+#include "fmatmul.h"
+
+#define MIN(a, b) ((a) < (b) ? (a) : (b))
+
+// The output rows of an image are computed in bands. The im2col matrix of a
+// band, [C_in * K * K x rows * Wo], is built in conv2d_layer_work, and
+// multiplied by the filters, [C_out x C_in * K * K], with fmatmul_tiled. The
+// bias and the ReLU are then applied to the band in place.
+void conv2d_layer_im2col(double *o, const double *i, const double *f,
+                         const double *b, const unsigned long int N,
+                         const unsigned long int C_in,
+                         const unsigned long int C_out,
+                         const unsigned long int H, const unsigned long int W,
+                         const unsigned long int K,
+                         const unsigned long int stride,
+                         const unsigned long int pad) {
+  const unsigned long int Ho = (H + 2 * pad - K) / stride + 1;
+  const unsigned long int Wo = (W + 2 * pad - K) / stride + 1;
+  const unsigned long int rows = C_in * K * K;
+
+  // Output rows per band
+  const unsigned long int band =
+      MIN(Ho, CONV2D_LAYER_WORK_WORDS / (rows * Wo));
+  if (band == 0) {
+    conv2d_layer(o, i, f, b, N, C_in, C_out, H, W, K, stride, pad);
+    return;
+  }
+
+  for (unsigned long int n = 0; n < N; ++n) {
+    const double *i_ = i + n * C_in * H * W;
+    double *o_ = o + n * C_out * Ho * Wo;
+
+    for (unsigned long int oy = 0; oy < Ho; oy += band) {
+      const unsigned long int P = MIN(Ho - oy, band) * Wo;
+
+      conv2d_layer_im2col_band(conv2d_layer_work, i_, C_in, H, W, K, stride,
+                               pad, oy, P / Wo, Wo);
+      fmatmul_tiled(o_ + oy * Wo, f, conv2d_layer_work, C_out, rows, P, rows,
+                    P, Ho * Wo);
+      conv2d_layer_bias_relu(o_ + oy * Wo, b, C_out, P, Ho * Wo);
+    }
+  }
+}
+
+// Rows (ci, ky, kx) of the im2col matrix, for the output rows [oy, oy + oyn)
+void conv2d_layer_im2col_band(double *col, const double *i,
+                              const unsigned long int C_in,
+                              const unsigned long int H,
+                              const unsigned long int W,
+                              const unsigned long int K,
+                              const unsigned long int stride,
+                              const unsigned long int pad,
+                              const unsigned long int oy,
+                              const unsigned long int oyn,
+                              const unsigned long int Wo) {
+  const unsigned long int P = oyn * Wo;
+
+  for (unsigned long int ci = 0; ci < C_in; ++ci)
+    for (unsigned long int ky = 0; ky < K; ++ky)
+      for (unsigned long int kx = 0; kx < K; ++kx) {
+        double *col_ = col + ((ci * K + ky) * K + kx) * P;
+
+        // Output columns [x0, x1) read within the input columns
+        const unsigned long int x0 =
+            (pad > kx) ? MIN(Wo, (pad - kx + stride - 1) / stride) : 0;
+        unsigned long int x1 =
+            (W + pad > kx) ? MIN(Wo, (W + pad - kx - 1) / stride + 1) : 0;
+        if (x1 < x0)
+          x1 = x0;
+
+        for (unsigned long int r = 0; r < oyn; ++r) {
+          const long int y =
+              (long int)((oy + r) * stride + ky) - (long int)pad;
+          double *dst = col_ + r * Wo;
+
+          // Rows in the padding are zero
+          if (y < 0 || y >= (long int)H) {
+            conv2d_layer_zero(dst, Wo);
+            continue;
+          }
+
+          for (unsigned long int x = 0; x < x0; ++x)
+            dst[x] = 0;
+          for (unsigned long int x = x1; x < Wo; ++x)
+            dst[x] = 0;
+
+          const double *src = i + (ci * H + y) * W + x0 * stride + kx - pad;
+          unsigned long int vl;
+          for (unsigned long int x = x0; x < x1; x += vl) {
+            asm volatile("vsetvli %0, %1, e64, m8, ta, ma"
+                         : "=r"(vl)
+                         : "r"(x1 - x));
+            if (stride == 1)
+              asm volatile("vle64.v v0, (%0);" ::"r"(src));
+            else
+              asm volatile("vlse64.v v0, (%0), %1;" ::"r"(src),
+                           "r"(stride << 3));
+            asm volatile("vse64.v v0, (%0);" ::"r"(dst + x));
+            src += vl * stride;
+          }
+        }
+      }
+}
+
+// o[co][p] = max(0, o[co][p] + b[co]) for p < P
+void conv2d_layer_bias_relu(double *o, const double *b,
+                            const unsigned long int C_out,
+                            const unsigned long int P,
+                            const unsigned long int ldo) {
+  const double zero = 0;
+
+  for (unsigned long int co = 0; co < C_out; ++co) {
+    double *o_ = o + co * ldo;
+    unsigned long int vl;
+    for (unsigned long int p = 0; p < P; p += vl) {
+      asm volatile("vsetvli %0, %1, e64, m8, ta, ma" : "=r"(vl) : "r"(P - p));
+      asm volatile("vle64.v v0, (%0);" ::"r"(o_ + p));
+      asm volatile("vfadd.vf v0, v0, %0" ::"f"(b[co]));
+      asm volatile("vfmax.vf v0, v0, %0" ::"f"(zero));
+      asm volatile("vse64.v v0, (%0);" ::"r"(o_ + p));
+    }
+  }
+}
+
+// Zero len elements
+void conv2d_layer_zero(double *o, const unsigned long int len) {
+  unsigned long int vl;
+  for (unsigned long int p = 0; p < len; p += vl) {
+    asm volatile("vsetvli %0, %1, e64, m8, ta, ma" : "=r"(vl) : "r"(len - p));
+    asm volatile("vmv.v.i v0, 0");
+    asm volatile("vse64.v v0, (%0);" ::"r"(o + p));
+  }
+}
@@ -0,0 +1,28 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Generated by scripts/conv2d_layer_table.py from no results. Do not edit.
+// Fastest algorithm of the measured shapes, terminated by nr_lanes = 0.
+
+#ifndef _CONV2D_LAYER_TABLE_H_
+#define _CONV2D_LAYER_TABLE_H_
+
+#include "conv2d_layer.h"
+
+static const conv2d_layer_entry_t conv2d_layer_table[] = {
+  {0, 0, 0, 0, 0, 0, CONV2D_LAYER_DIRECT}};
+
+#endif
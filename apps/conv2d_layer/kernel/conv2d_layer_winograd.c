@@ -0,0 +1,317 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "conv2d_layer.h"
+#include "fmatmul.h"
+
+#define MIN(a, b) ((a) < (b) ? (a) : (b))
+
+// Winograd F(2x2, 3x3) for 3x3 filters with stride 1. Each 2x2 output tile is
+// Y = A^T [sum_ci (G g G^T) . (B^T d B)] A, where d is the 4x4 input tile and
+// g the 3x3 filter. For each of the 16 elements of the transformed tiles, the
+// sum over the input channels is a matmul [C_out x C_in] x [C_in x tiles],
+// computed by fmatmul_tiled. This takes 16 multiplications per tile and
+// channel pair, instead of 36.
+//
+// conv2d_layer_work holds, in order: the transformed filters U, [16 x C_out x
+// C_in], the zero-padded image, [C_in x Hp x Wp], and for a band of tile rows
+// the transformed input tiles V, [16 x C_in x T], and the products M, [16 x
+// C_out x T], where T is the number of tiles of the band.
+void conv2d_layer_winograd(double *o, const double *i, const double *f,
+                           const double *b, const unsigned long int N,
+                           const unsigned long int C_in,
+                           const unsigned long int C_out,
+                           const unsigned long int H,
+                           const unsigned long int W,
+                           const unsigned long int K,
+                           const unsigned long int stride,
+                           const unsigned long int pad) {
+  if (K != 3 || stride != 1) {
+    conv2d_layer(o, i, f, b, N, C_in, C_out, H, W, K, stride, pad);
+    return;
+  }
+
+  const unsigned long int Ho = H + 2 * pad - 2;
+  const unsigned long int Wo = W + 2 * pad - 2;
+  // Tiles, and padded image that covers them
+  const unsigned long int ty_n = (Ho + 1) / 2;
+  const unsigned long int tx_n = (Wo + 1) / 2;
+  const unsigned long int Hp = 2 * ty_n + 2;
+  const unsigned long int Wp = 2 * tx_n + 2;
+
+  // Tile rows per band
+  const unsigned long int fixed = 16 * C_out * C_in + C_in * Hp * Wp;
+  const unsigned long int band =
+      (fixed < CONV2D_LAYER_WORK_WORDS)
+          ? MIN(ty_n, (CONV2D_LAYER_WORK_WORDS - fixed) /
+                          (16 * (C_in + C_out) * tx_n))
+          : 0;
+  if (band == 0) {
+    conv2d_layer(o, i, f, b, N, C_in, C_out, H, W, K, stride, pad);
+    return;
+  }
+
+  double *u = conv2d_layer_work;
+  double *ip = u + 16 * C_out * C_in;
+  double *v = ip + C_in * Hp * Wp;
+  double *m = v + 16 * C_in * band * tx_n;
+
+  conv2d_layer_winograd_filter(u, f, C_in, C_out);
+
+  for (unsigned long int n = 0; n < N; ++n) {
+    const double *i_ = i + n * C_in * H * W;
+    double *o_ = o + n * C_out * Ho * Wo;
+
+    // Zero-padded image
+    conv2d_layer_zero(ip, C_in * Hp * Wp);
+    for (unsigned long int ci = 0; ci < C_in; ++ci)
+      for (unsigned long int y = 0; y < H; ++y)
+        conv2d_layer_copy(ip + (ci * Hp + y + pad) * Wp + pad,
+                          i_ + (ci * H + y) * W, W);
+
+    for (unsigned long int ty = 0; ty < ty_n; ty += band) {
+      const unsigned long int tyn = MIN(ty_n - ty, band);
+      const unsigned long int T = tyn * tx_n;
+
+      for (unsigned long int ci = 0; ci < C_in; ++ci)
+        for (unsigned long int r = 0; r < tyn; ++r)
+          conv2d_layer_winograd_input(v + ci * T + r * tx_n,
+                                      ip + (ci * Hp + 2 * (ty + r)) * Wp, Wp,
+                                      tx_n, C_in * T);
+
+      for (unsigned long int e = 0; e < 16; ++e)
+        fmatmul_tiled(m + e * C_out * T, u + e * C_out * C_in,
+                      v + e * C_in * T, C_out, C_in, T, C_in, T, T);
+
+      for (unsigned long int co = 0; co < C_out; ++co)
+        for (unsigned long int r = 0; r < tyn; ++r)
+          conv2d_layer_winograd_output(o_ + co * Ho * Wo,
+                                       m + co * T + r * tx_n, C_out * T,
+                                       b[co], 2 * (ty + r), Ho, Wo, tx_n);
+    }
+  }
+}
+
+// U[e][co][ci] = (G g G^T)[e], with g the 3x3 filter f[co][ci]
+void conv2d_layer_winograd_filter(double *u, const double *f,
+                                  const unsigned long int C_in,
+                                  const unsigned long int C_out) {
+  for (unsigned long int co = 0; co < C_out; ++co)
+    for (unsigned long int ci = 0; ci < C_in; ++ci) {
+      const double *g = f + (co * C_in + ci) * 9;
+      double t[4][3];
+
+      // G g
+      for (int c = 0; c < 3; ++c) {
+        t[0][c] = g[c];
+        t[1][c] = 0.5 * (g[c] + g[3 + c] + g[6 + c]);
+        t[2][c] = 0.5 * (g[c] - g[3 + c] + g[6 + c]);
+        t[3][c] = g[6 + c];
+      }
+
+      // (G g) G^T
+      for (int r = 0; r < 4; ++r) {
+        double *u_ = u + (4 * r) * C_out * C_in + co * C_in + ci;
+        u_[0 * C_out * C_in] = t[r][0];
+        u_[1 * C_out * C_in] = 0.5 * (t[r][0] + t[r][1] + t[r][2]);
+        u_[2 * C_out * C_in] = 0.5 * (t[r][0] - t[r][1] + t[r][2]);
+        u_[3 * C_out * C_in] = t[r][2];
+      }
+    }
+}
+
+// V[e][tx] = (B^T d B)[e] for the tx_n tiles of a tile row, whose 4 input rows
+// start at i, with leading dimension Wp. The 16 elements are ldv apart.
+void conv2d_layer_winograd_input(double *v, const double *i,
+                                 const unsigned long int Wp,
+                                 const unsigned long int tx_n,
+                                 const unsigned long int ldv) {
+  unsigned long int vl;
+  for (unsigned long int tx = 0; tx < tx_n; tx += vl) {
+    asm volatile("vsetvli %0, %1, e64, m1, ta, ma" : "=r"(vl) : "r"(tx_n - tx));
+    const double *s = i + 2 * tx;
+
+    // Column 0 of the tiles: B^T d
+    asm volatile("vlse64.v v16, (%0), %1;" ::"r"(s + 0), "r"(16));
+    asm volatile("vlse64.v v17, (%0), %1;" ::"r"(s + 0 + 1 * Wp), "r"(16));
+    asm volatile("vlse64.v v18, (%0), %1;" ::"r"(s + 0 + 2 * Wp), "r"(16));
+    asm volatile("vlse64.v v19, (%0), %1;" ::"r"(s + 0 + 3 * Wp), "r"(16));
+    asm volatile("vfsub.vv v0, v16, v18");
+    asm volatile("vfadd.vv v4, v17, v18");
+    asm volatile("vfsub.vv v8, v18, v17");
+    asm volatile("vfsub.vv v12, v17, v19");
+    // Column 1 of the tiles: B^T d
+    asm volatile("vlse64.v v16, (%0), %1;" ::"r"(s + 1), "r"(16));
+    asm volatile("vlse64.v v17, (%0), %1;" ::"r"(s + 1 + 1 * Wp), "r"(16));
+    asm volatile("vlse64.v v18, (%0), %1;" ::"r"(s + 1 + 2 * Wp), "r"(16));
+    asm volatile("vlse64.v v19, (%0), %1;" ::"r"(s + 1 + 3 * Wp), "r"(16));
+    asm volatile("vfsub.vv v1, v16, v18");
+    asm volatile("vfadd.vv v5, v17, v18");
+    asm volatile("vfsub.vv v9, v18, v17");
+    asm volatile("vfsub.vv v13, v17, v19");
+    // Column 2 of the tiles: B^T d
+    asm volatile("vlse64.v v16, (%0), %1;" ::"r"(s + 2), "r"(16));
+    asm volatile("vlse64.v v17, (%0), %1;" ::"r"(s + 2 + 1 * Wp), "r"(16));
+    asm volatile("vlse64.v v18, (%0), %1;" ::"r"(s + 2 + 2 * Wp), "r"(16));
+    asm volatile("vlse64.v v19, (%0), %1;" ::"r"(s + 2 + 3 * Wp), "r"(16));
+    asm volatile("vfsub.vv v2, v16, v18");
+    asm volatile("vfadd.vv v6, v17, v18");
+    asm volatile("vfsub.vv v10, v18, v17");
+    asm volatile("vfsub.vv v14, v17, v19");
+    // Column 3 of the tiles: B^T d
+    asm volatile("vlse64.v v16, (%0), %1;" ::"r"(s + 3), "r"(16));
+    asm volatile("vlse64.v v17, (%0), %1;" ::"r"(s + 3 + 1 * Wp), "r"(16));
+    asm volatile("vlse64.v v18, (%0), %1;" ::"r"(s + 3 + 2 * Wp), "r"(16));
+    asm volatile("vlse64.v v19, (%0), %1;" ::"r"(s + 3 + 3 * Wp), "r"(16));
+    asm volatile("vfsub.vv v3, v16, v18");
+    asm volatile("vfadd.vv v7, v17, v18");
+    asm volatile("vfsub.vv v11, v18, v17");
+    asm volatile("vfsub.vv v15, v17, v19");
+    // Row 0 of the tiles: (B^T d) B
+    asm volatile("vfsub.vv v20, v0, v2");
+    asm volatile("vfadd.vv v21, v1, v2");
+    asm volatile("vfsub.vv v22, v2, v1");
+    asm volatile("vfsub.vv v23, v1, v3");
+    asm volatile("vse64.v v20, (%0);" ::"r"(v + 0 * ldv + tx));
+    asm volatile("vse64.v v21, (%0);" ::"r"(v + 1 * ldv + tx));
+    asm volatile("vse64.v v22, (%0);" ::"r"(v + 2 * ldv + tx));
+    asm volatile("vse64.v v23, (%0);" ::"r"(v + 3 * ldv + tx));
+    // Row 1 of the tiles: (B^T d) B
+    asm volatile("vfsub.vv v20, v4, v6");
+    asm volatile("vfadd.vv v21, v5, v6");
+    asm volatile("vfsub.vv v22, v6, v5");
+    asm volatile("vfsub.vv v23, v5, v7");
+    asm volatile("vse64.v v20, (%0);" ::"r"(v + 4 * ldv + tx));
+    asm volatile("vse64.v v21, (%0);" ::"r"(v + 5 * ldv + tx));
+    asm volatile("vse64.v v22, (%0);" ::"r"(v + 6 * ldv + tx));
+    asm volatile("vse64.v v23, (%0);" ::"r"(v + 7 * ldv + tx));
+    // Row 2 of the tiles: (B^T d) B
+    asm volatile("vfsub.vv v20, v8, v10");
+    asm volatile("vfadd.vv v21, v9, v10");
+    asm volatile("vfsub.vv v22, v10, v9");
+    asm volatile("vfsub.vv v23, v9, v11");
+    asm volatile("vse64.v v20, (%0);" ::"r"(v + 8 * ldv + tx));
+    asm volatile("vse64.v v21, (%0);" ::"r"(v + 9 * ldv + tx));
+    asm volatile("vse64.v v22, (%0);" ::"r"(v + 10 * ldv + tx));
+    asm volatile("vse64.v v23, (%0);" ::"r"(v + 11 * ldv + tx));
+    // Row 3 of the tiles: (B^T d) B
+    asm volatile("vfsub.vv v20, v12, v14");
+    asm volatile("vfadd.vv v21, v13, v14");
+    asm volatile("vfsub.vv v22, v14, v13");
+    asm volatile("vfsub.vv v23, v13, v15");
+    asm volatile("vse64.v v20, (%0);" ::"r"(v + 12 * ldv + tx));
+    asm volatile("vse64.v v21, (%0);" ::"r"(v + 13 * ldv + tx));
+    asm volatile("vse64.v v22, (%0);" ::"r"(v + 14 * ldv + tx));
+    asm volatile("vse64.v v23, (%0);" ::"r"(v + 15 * ldv + tx));
+  }
+}
+
+// Output rows oy and oy + 1 of the tx_n tiles of a tile row, from the 16
+// elements of M, ldm apart
+void conv2d_layer_winograd_output(double *o, const double *m,
+                                  const unsigned long int ldm,
+                                  const double bias,
+                                  const unsigned long int oy,
+                                  const unsigned long int Ho,
+                                  const unsigned long int Wo,
+                                  const unsigned long int tx_n) {
+  const double zero = 0;
+
+  unsigned long int vl;
+  for (unsigned long int tx = 0; tx < tx_n; tx += vl) {
+    asm volatile("vsetvli %0, %1, e64, m1, ta, ma" : "=r"(vl) : "r"(tx_n - tx));
+
+    // Column 0 of the tiles: A^T m
+    asm volatile("vle64.v v16, (%0);" ::"r"(m + 0 * ldm + tx));
+    asm volatile("vle64.v v17, (%0);" ::"r"(m + 4 * ldm + tx));
+    asm volatile("vle64.v v18, (%0);" ::"r"(m + 8 * ldm + tx));
+    asm volatile("vle64.v v19, (%0);" ::"r"(m + 12 * ldm + tx));
+    asm volatile("vfadd.vv v0, v16, v17");
+    asm volatile("vfadd.vv v0, v0, v18");
+    asm volatile("vfsub.vv v4, v17, v18");
+    asm volatile("vfsub.vv v4, v4, v19");
+    // Column 1 of the tiles: A^T m
+    asm volatile("vle64.v v16, (%0);" ::"r"(m + 1 * ldm + tx));
+    asm volatile("vle64.v v17, (%0);" ::"r"(m + 5 * ldm + tx));
+    asm volatile("vle64.v v18, (%0);" ::"r"(m + 9 * ldm + tx));
+    asm volatile("vle64.v v19, (%0);" ::"r"(m + 13 * ldm + tx));
+    asm volatile("vfadd.vv v1, v16, v17");
+    asm volatile("vfadd.vv v1, v1, v18");
+    asm volatile("vfsub.vv v5, v17, v18");
+    asm volatile("vfsub.vv v5, v5, v19");
+    // Column 2 of the tiles: A^T m
+    asm volatile("vle64.v v16, (%0);" ::"r"(m + 2 * ldm + tx));
+    asm volatile("vle64.v v17, (%0);" ::"r"(m + 6 * ldm + tx));
+    asm volatile("vle64.v v18, (%0);" ::"r"(m + 10 * ldm + tx));
+    asm volatile("vle64.v v19, (%0);" ::"r"(m + 14 * ldm + tx));
+    asm volatile("vfadd.vv v2, v16, v17");
+    asm volatile("vfadd.vv v2, v2, v18");
+    asm volatile("vfsub.vv v6, v17, v18");
+    asm volatile("vfsub.vv v6, v6, v19");
+    // Column 3 of the tiles: A^T m
+    asm volatile("vle64.v v16, (%0);" ::"r"(m + 3 * ldm + tx));
+    asm volatile("vle64.v v17, (%0);" ::"r"(m + 7 * ldm + tx));
+    asm volatile("vle64.v v18, (%0);" ::"r"(m + 11 * ldm + tx));
+    asm volatile("vle64.v v19, (%0);" ::"r"(m + 15 * ldm + tx));
+    asm volatile("vfadd.vv v3, v16, v17");
+    asm volatile("vfadd.vv v3, v3, v18");
+    asm volatile("vfsub.vv v7, v17, v18");
+    asm volatile("vfsub.vv v7, v7, v19");
+    // (A^T m) A
+    asm volatile("vfadd.vv v8, v0, v1");
+    asm volatile("vfadd.vv v8, v8, v2");
+    asm volatile("vfsub.vv v9, v1, v2");
+    asm volatile("vfsub.vv v9, v9, v3");
+    asm volatile("vfadd.vv v10, v4, v5");
+    asm volatile("vfadd.vv v10, v10, v6");
+    asm volatile("vfsub.vv v11, v5, v6");
+    asm volatile("vfsub.vv v11, v11, v7");
+
+    // Bias and ReLU
+    asm volatile("vfadd.vf v8, v8, %0" ::"f"(bias));
+    asm volatile("vfmax.vf v8, v8, %0" ::"f"(zero));
+    asm volatile("vfadd.vf v9, v9, %0" ::"f"(bias));
+    asm volatile("vfmax.vf v9, v9, %0" ::"f"(zero));
+    asm volatile("vfadd.vf v10, v10, %0" ::"f"(bias));
+    asm volatile("vfmax.vf v10, v10, %0" ::"f"(zero));
+    asm volatile("vfadd.vf v11, v11, %0" ::"f"(bias));
+    asm volatile("vfmax.vf v11, v11, %0" ::"f"(zero));
+
+    // The even columns, and then the odd ones, which are one less if Wo is odd
+    double *o_ = o + oy * Wo + 2 * tx;
+    asm volatile("vsse64.v v8, (%0), %1;" ::"r"(o_), "r"(16));
+    if (oy + 1 < Ho)
+      asm volatile("vsse64.v v10, (%0), %1;" ::"r"(o_ + Wo), "r"(16));
+    const unsigned long int vl_odd = (Wo / 2 > tx) ? MIN(vl, Wo / 2 - tx) : 0;
+    if (vl_odd != 0) {
+      asm volatile("vsetvli zero, %0, e64, m1, ta, ma" ::"r"(vl_odd));
+      asm volatile("vsse64.v v9, (%0), %1;" ::"r"(o_ + 1), "r"(16));
+      if (oy + 1 < Ho)
+        asm volatile("vsse64.v v11, (%0), %1;" ::"r"(o_ + Wo + 1), "r"(16));
+    }
+  }
+}
+
+// Copy len elements
+void conv2d_layer_copy(double *o, const double *i,
+                       const unsigned long int len) {
+  unsigned long int vl;
+  for (unsigned long int p = 0; p < len; p += vl) {
+    asm volatile("vsetvli %0, %1, e64, m8, ta, ma" : "=r"(vl) : "r"(len - p));
+    asm volatile("vle64.v v0, (%0);" ::"r"(i + p));
+    asm volatile("vse64.v v0, (%0);" ::"r"(o + p));
+  }
+}
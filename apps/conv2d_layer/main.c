@@ -0,0 +1,111 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdint.h>
+#include <string.h>
+
+#include "kernel/conv2d_layer.h"
+#include "runtime.h"
+#include "util.h"
+
+#ifndef SPIKE
+#include "printf.h"
+#else
+#include <stdio.h>
+#endif
+
+// o = ReLU(conv(i, f) + b), with i=[N x C_in x H x W],
+// f=[C_out x C_in x K x K], b=[C_out], o=[N x C_out x Ho x Wo]
+extern uint64_t N;
+extern uint64_t C_in;
+extern uint64_t C_out;
+extern uint64_t H;
+extern uint64_t W;
+extern uint64_t K;
+extern uint64_t stride;
+extern uint64_t pad;
+
+extern double i[] __attribute__((aligned(32 * NR_LANES), section(".l2")));
+extern double f[] __attribute__((aligned(32 * NR_LANES), section(".l2")));
+extern double b[] __attribute__((aligned(32 * NR_LANES), section(".l2")));
+extern double o[] __attribute__((aligned(32 * NR_LANES), section(".l2")));
+extern double golden_o[]
+    __attribute__((aligned(32 * NR_LANES), section(".l2")));
+
+#define THRESHOLD 0.000000001
+
+// Verify the output tensor
+int verify_tensor(double *result, double *gold, size_t len) {
+  for (size_t i = 0; i < len; ++i)
+    if (!similarity_check(result[i], gold[i], THRESHOLD)) {
+      printf("Error: o[%d] = %lf, instead of %lf\n", i, result[i], gold[i]);
+      return i == 0 ? -1 : i;
+    }
+  return 0;
+}
+
+int main() {
+  printf("\n");
+  printf("==================\n");
+  printf("=  CONV2D_LAYER  =\n");
+  printf("==================\n");
+  printf("\n");
+  printf("\n");
+
+  const uint64_t Ho = (H + 2 * pad - K) / stride + 1;
+  const uint64_t Wo = (W + 2 * pad - K) / stride + 1;
+
+  printf("Batch: %d, input: %dx%dx%d, output: %dx%dx%d\n", N, C_in, H, W, C_out,
+         Ho, Wo);
+  printf("Filter size: %dx%d, stride: %d, padding: %d\n", K, K, stride, pad);
+
+  static const char *algo_name[] = {"direct", "im2col", "winograd"};
+  const conv2d_layer_algo_t selected =
+      conv2d_layer_select(C_in, C_out, H, W, K, stride);
+
+  // The algorithms, and then the one selected for the shape
+  for (int algo = 0; algo <= 3; ++algo) {
+    const conv2d_layer_algo_t a = (algo == 3) ? selected : algo;
+    printf("Algorithm: %s%s\n", algo_name[a], (algo == 3) ? " (auto)" : "");
+    memset(o, 0, N * C_out * Ho * Wo * sizeof(double));
+
+    start_timer();
+    if (algo == 3)
+      conv2d_layer_auto(o, i, f, b, N, C_in, C_out, H, W, K, stride, pad);
+    else
+      conv2d_layer_run(a, o, i, f, b, N, C_in, C_out, H, W, K, stride, pad);
+    stop_timer();
+
+    // Metrics
+    int64_t runtime = get_timer();
+    float performance = 2.0 * N * C_out * Ho * Wo * C_in * K * K / runtime;
+    float utilization = 100 * performance / (2.0 * NR_LANES);
+
+    printf("The execution took %d cycles.\n", runtime);
+    printf("The performance is %f DPFLOP/cycle (%f%% utilization).\n",
+           performance, utilization);
+
+    printf("Verifying result...\n");
+    int error = verify_tensor(o, golden_o, N * C_out * Ho * Wo);
+    if (error != 0) {
+      printf("Fail.\n");
+      return error;
+    }
+  }
+  printf("Passed.\n");
+
+  return 0;
+}
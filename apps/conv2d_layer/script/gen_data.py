@@ -0,0 +1,81 @@
+#!/usr/bin/env python3
+# Copyright 2022 ETH Zurich and University of Bologna.
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+# o = ReLU(conv(i, f) + b), with i=[N x C_in x H x W], f=[C_out x C_in x K x K],
+# b=[C_out], o=[N x C_out x Ho x Wo]
+# arg1 ... arg8: N, C_in, C_out, H, W, K, stride, pad
+
+import numpy as np
+import os
+import sys
+
+sys.path.insert(0, os.path.join(os.path.dirname(__file__), '../../common/script'))
+from data_emit import emit
+
+def conv2d_layer(i, f, b, stride, pad):
+  N, C_in, H, W = i.shape
+  C_out, _, K, _ = f.shape
+  Ho = (H + 2 * pad - K) // stride + 1
+  Wo = (W + 2 * pad - K) // stride + 1
+  ip = np.pad(i, ((0, 0), (0, 0), (pad, pad), (pad, pad)))
+  o = np.zeros((N, C_out, Ho, Wo), dtype=i.dtype)
+  for ky in range(K):
+    for kx in range(K):
+      patch = ip[:, :, ky:ky + stride * (Ho - 1) + 1:stride, kx:kx + stride * (Wo - 1) + 1:stride]
+      o += np.einsum('nchw,oc->nohw', patch, f[:, :, ky, kx])
+  o += b.reshape(1, C_out, 1, 1)
+  return np.maximum(o, 0)
+
+############
+## SCRIPT ##
+############
+
+if len(sys.argv) == 9:
+  N, C_in, C_out, H, W, K, stride, pad = [int(a) for a in sys.argv[1:9]]
+else:
+  print("Error. Give me eight arguments: N, C_in, C_out, H, W, K, stride, pad.")
+  print("o = ReLU(conv(i, f) + b), with i=[N x C_in x H x W], f=[C_out x C_in x K x K]")
+  sys.exit()
+
+if H + 2 * pad < K or W + 2 * pad < K:
+  print("Error. The padded input must be at least as large as the filter.")
+  sys.exit()
+
+dtype = np.float64
+
+# Centered data, so that the ReLU clips part of the outputs
+I = (np.random.rand(N, C_in, H, W) - 0.5).astype(dtype)
+F = (np.random.rand(C_out, C_in, K, K) - 0.5).astype(dtype)
+B = (np.random.rand(C_out) - 0.5).astype(dtype)
+G = conv2d_layer(I, F, B, stride, pad).astype(dtype)
+O = np.zeros(G.shape, dtype=dtype)
+
+# Create the file
+print(".section .data,\"aw\",@progbits")
+emit("N", np.array(N, dtype=np.uint64))
+emit("C_in", np.array(C_in, dtype=np.uint64))
+emit("C_out", np.array(C_out, dtype=np.uint64))
+emit("H", np.array(H, dtype=np.uint64))
+emit("W", np.array(W, dtype=np.uint64))
+emit("K", np.array(K, dtype=np.uint64))
+emit("stride", np.array(stride, dtype=np.uint64))
+emit("pad", np.array(pad, dtype=np.uint64))
+emit("i", I, 'NR_LANES*4')
+emit("f", F, 'NR_LANES*4')
+emit("b", B, 'NR_LANES*4')
+emit("o", O, 'NR_LANES*4')
+emit("golden_o", G, 'NR_LANES*4')
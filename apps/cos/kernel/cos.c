@@ -18,27 +18,90 @@
 
 #include "cos.h"
 
-void cos_1xf64_bmark(double *angles, double *results, size_t len) {
+// Strip-mine loop over vmath_cos with LMUL lmul. The full strips run with
+// vl = VLMAX, which does not depend on the loop, and the last strip is a tail.
+#define cos_bmark_def_gen(DATA_TYPE, sew, lmul)                                \
+  void cos_f##sew##lmul##_bmark(DATA_TYPE *angles, DATA_TYPE *results,         \
+                                size_t len) {                                  \
+    const size_t vlmax = vsetvlmax_e##sew##lmul();                             \
+    vfloat##sew##lmul##_t cos_vec, res_vec;                                    \
+                                                                               \
+    /* Full strips, with a loop-invariant vl */                                \
+    for (; len >= vlmax; len -= vlmax) {                                       \
+      cos_vec = vle##sew##_v_f##sew##lmul(angles, vlmax);                      \
+      res_vec = vmath_cos_f##sew##lmul(cos_vec, vlmax);                        \
+      vse##sew##_v_f##sew##lmul(results, res_vec, vlmax);                      \
+      angles += vlmax;                                                         \
+      results += vlmax;                                                        \
+    }                                                                          \
+                                                                               \
+    /* Tail */                                                                 \
+    if (len) {                                                                 \
+      size_t vl = vsetvl_e##sew##lmul(len);                                    \
+      cos_vec = vle##sew##_v_f##sew##lmul(angles, vl);                         \
+      res_vec = vmath_cos_f##sew##lmul(cos_vec, vl);                           \
+      vse##sew##_v_f##sew##lmul(results, res_vec, vl);                         \
+    }                                                                          \
+  }
 
-  size_t avl = len;
-  vfloat64m1_t cos_vec, res_vec;
+cos_bmark_def_gen(double, 64, m1);
+cos_bmark_def_gen(double, 64, m2);
+cos_bmark_def_gen(double, 64, m4);
+cos_bmark_def_gen(float, 32, m1);
+cos_bmark_def_gen(float, 32, m2);
+cos_bmark_def_gen(float, 32, m4);
+
+// sin and cos of the same angles in one pass, from one range reduction
+#define sincos_bmark_def_gen(DATA_TYPE, sew, lmul)                             \
+  void sincos_f##sew##lmul##_bmark(DATA_TYPE *angles, DATA_TYPE *sin_res,      \
+                                   DATA_TYPE *cos_res, size_t len) {           \
+    const size_t vlmax = vsetvlmax_e##sew##lmul();                             \
+    vfloat##sew##lmul##_t ang_vec, sin_vec, cos_vec;                           \
+                                                                               \
+    /* Full strips, with a loop-invariant vl */                                \
+    for (; len >= vlmax; len -= vlmax) {                                       \
+      ang_vec = vle##sew##_v_f##sew##lmul(angles, vlmax);                      \
+      sin_vec = vmath_sincos_f##sew##lmul(ang_vec, &cos_vec, vlmax);           \
+      vse##sew##_v_f##sew##lmul(sin_res, sin_vec, vlmax);                      \
+      vse##sew##_v_f##sew##lmul(cos_res, cos_vec, vlmax);                      \
+      angles += vlmax;                                                         \
+      sin_res += vlmax;                                                        \
+      cos_res += vlmax;                                                        \
+    }                                                                          \
+                                                                               \
+    /* Tail */                                                                 \
+    if (len) {                                                                 \
+      size_t vl = vsetvl_e##sew##lmul(len);                                    \
+      ang_vec = vle##sew##_v_f##sew##lmul(angles, vl);                         \
+      sin_vec = vmath_sincos_f##sew##lmul(ang_vec, &cos_vec, vl);              \
+      vse##sew##_v_f##sew##lmul(sin_res, sin_vec, vl);                         \
+      vse##sew##_v_f##sew##lmul(cos_res, cos_vec, vl);                         \
+    }                                                                          \
+  }
 
+sincos_bmark_def_gen(double, 64, m1);
+sincos_bmark_def_gen(double, 64, m2);
+sincos_bmark_def_gen(double, 64, m4);
+sincos_bmark_def_gen(float, 32, m1);
+sincos_bmark_def_gen(float, 32, m2);
+sincos_bmark_def_gen(float, 32, m4);
+
+// The largest LMUL such that the temporaries of the kernel stay in the
+// register file
+void cos_1xf64_bmark(double *angles, double *results, size_t len) {
 #ifdef VCD_DUMP
   // Start dumping VCD
   event_trigger = +1;
 #endif
-  for (size_t vl = vsetvl_e64m1(avl); avl > 0; avl -= vl) {
-    // Strip-mine
-    vl = vsetvl_e64m1(avl);
-    // Load vector
-    cos_vec = vle64_v_f64m1(angles, vl);
-    // Compute
-    res_vec = __cos_1xf64(cos_vec, vl);
-    // Store
-    vse64_v_f64m1(results, res_vec, vl);
-    // Bump pointers
-    angles += vl;
-    results += vl;
+  switch (VMATH_SINCOS_LMUL) {
+  case 1:
+    cos_f64m1_bmark(angles, results, len);
+    break;
+  case 2:
+    cos_f64m2_bmark(angles, results, len);
+    break;
+  default:
+    cos_f64m4_bmark(angles, results, len);
   }
 #ifdef VCD_DUMP
   // Stop dumping VCD
@@ -47,29 +110,50 @@ void cos_1xf64_bmark(double *angles, double *results, size_t len) {
 }
 
 void cos_2xf32_bmark(float *angles, float *results, size_t len) {
-
-  size_t avl = len;
-  vfloat32m1_t cos_vec, res_vec;
-
 #ifdef VCD_DUMP
   // Start dumping VCD
   event_trigger = +1;
 #endif
-  for (size_t vl = vsetvl_e32m1(avl); avl > 0; avl -= vl) {
-    // Strip-mine
-    vl = vsetvl_e32m1(avl);
-    // Load vector
-    cos_vec = vle32_v_f32m1(angles, vl);
-    // Compute
-    res_vec = __cos_2xf32(cos_vec, vl);
-    // Store
-    vse32_v_f32m1(results, res_vec, vl);
-    // Bump pointers
-    angles += vl;
-    results += vl;
+  switch (VMATH_SINCOS_LMUL) {
+  case 1:
+    cos_f32m1_bmark(angles, results, len);
+    break;
+  case 2:
+    cos_f32m2_bmark(angles, results, len);
+    break;
+  default:
+    cos_f32m4_bmark(angles, results, len);
   }
 #ifdef VCD_DUMP
   // Stop dumping VCD
   event_trigger = -1;
 #endif
 }
+
+void sincos_1xf64_bmark(double *angles, double *sin_res, double *cos_res,
+                        size_t len) {
+  switch (VMATH_SINCOS2_LMUL) {
+  case 1:
+    sincos_f64m1_bmark(angles, sin_res, cos_res, len);
+    break;
+  case 2:
+    sincos_f64m2_bmark(angles, sin_res, cos_res, len);
+    break;
+  default:
+    sincos_f64m4_bmark(angles, sin_res, cos_res, len);
+  }
+}
+
+void sincos_2xf32_bmark(float *angles, float *sin_res, float *cos_res,
+                        size_t len) {
+  switch (VMATH_SINCOS2_LMUL) {
+  case 1:
+    sincos_f32m1_bmark(angles, sin_res, cos_res, len);
+    break;
+  case 2:
+    sincos_f32m2_bmark(angles, sin_res, cos_res, len);
+    break;
+  default:
+    sincos_f32m4_bmark(angles, sin_res, cos_res, len);
+  }
+}
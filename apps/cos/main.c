@@ -22,17 +22,24 @@
 #include "kernel/cos.h"
 #include "printf.h"
 #include "runtime.h"
+#include "trace.h"
 #include "util.h"
 
 extern size_t N_f64;
 extern double angles_f64[] __attribute__((aligned(4 * NR_LANES)));
 extern double results_f64[] __attribute__((aligned(4 * NR_LANES)));
 extern double gold_results_f64[] __attribute__((aligned(4 * NR_LANES)));
+extern double sin_results_f64[] __attribute__((aligned(4 * NR_LANES)));
+extern double cos_results_f64[] __attribute__((aligned(4 * NR_LANES)));
+extern double gold_sin_f64[] __attribute__((aligned(4 * NR_LANES)));
 
 extern size_t N_f32;
 extern float angles_f32[] __attribute__((aligned(4 * NR_LANES)));
 extern float results_f32[] __attribute__((aligned(4 * NR_LANES)));
 extern float gold_results_f32[] __attribute__((aligned(4 * NR_LANES)));
+extern float sin_results_f32[] __attribute__((aligned(4 * NR_LANES)));
+extern float cos_results_f32[] __attribute__((aligned(4 * NR_LANES)));
+extern float gold_sin_f32[] __attribute__((aligned(4 * NR_LANES)));
 
 #define THRESHOLD 1
 
@@ -66,21 +73,53 @@ int main() {
   runtime = get_timer();
   printf("The execution took %d cycles.\n", runtime);
 
+  printf("Executing sincos on %d 64-bit data...\n", N_f64);
+  start_timer();
+  sincos_1xf64_bmark(angles_f64, sin_results_f64, cos_results_f64, N_f64);
+  stop_timer();
+
+  runtime = get_timer();
+  printf("The execution took %d cycles.\n", runtime);
+
+  printf("Executing sincos on %d 32-bit data...\n", N_f32);
+  start_timer();
+  sincos_2xf32_bmark(angles_f32, sin_results_f32, cos_results_f32, N_f32);
+  stop_timer();
+
+  runtime = get_timer();
+  printf("The execution took %d cycles.\n", runtime);
+
 #ifdef CHECK
   printf("Checking results:\n");
 
   for (uint64_t i = 0; i < N_f64; ++i) {
     if (!similarity_check(results_f64[i], gold_results_f64[i], THRESHOLD)) {
       error = 1;
-      printf("64-bit error at index %d. %f != %f\n", i, results_f64[i],
-             gold_results_f64[i]);
+      trace_mismatch(i, "64-bit error at index %d. %f != %f\n", i,
+                     results_f64[i], gold_results_f64[i]);
+    }
+    if (!similarity_check(sin_results_f64[i], gold_sin_f64[i], THRESHOLD) ||
+        !similarity_check(cos_results_f64[i], gold_results_f64[i],
+                          THRESHOLD)) {
+      error = 1;
+      trace_mismatch(i, "64-bit sincos error at index %d. %f, %f != %f, %f\n",
+                     i, sin_results_f64[i], cos_results_f64[i],
+                     gold_sin_f64[i], gold_results_f64[i]);
     }
   }
   for (uint64_t i = 0; i < N_f32; ++i) {
     if (!similarity_check(results_f32[i], gold_results_f32[i], THRESHOLD)) {
       error = 1;
-      printf("32-bit error at index %d. %f != %f\n", i, results_f32[i],
-             gold_results_f32[i]);
+      trace_mismatch(i, "32-bit error at index %d. %f != %f\n", i,
+                     results_f32[i], gold_results_f32[i]);
+    }
+    if (!similarity_check(sin_results_f32[i], gold_sin_f32[i], THRESHOLD) ||
+        !similarity_check(cos_results_f32[i], gold_results_f32[i],
+                          THRESHOLD)) {
+      error = 1;
+      trace_mismatch(i, "32-bit sincos error at index %d. %f, %f != %f, %f\n",
+                     i, sin_results_f32[i], cos_results_f32[i],
+                     gold_sin_f32[i], gold_results_f32[i]);
     }
   }
 #endif
@@ -19,18 +19,11 @@
 
 import random as rand
 import numpy as np
+import os
 import sys
 
-def emit(name, array, alignment='8'):
-  print(".global %s" % name)
-  print(".balign " + alignment)
-  print("%s:" % name)
-  bs = array.tobytes()
-  for i in range(0, len(bs), 4):
-    s = ""
-    for n in range(4):
-      s += "%02x" % bs[i+3-n]
-    print("    .word 0x%s" % s)
+sys.path.insert(0, os.path.join(os.path.dirname(__file__), '../../common/script'))
+from data_emit import emit
 
 def rand_matrix(N, dtype):
   return np.random.rand(N).astype(dtype)
@@ -53,10 +46,16 @@ angles_f32 = rand_matrix(N_f32, np.float32).astype(np.float32)
 # Results buffer
 results_f64 = np.zeros(N_f64, dtype=np.float64)
 results_f32 = np.zeros(N_f32, dtype=np.float32)
+sin_results_f64 = np.zeros(N_f64, dtype=np.float64)
+cos_results_f64 = np.zeros(N_f64, dtype=np.float64)
+sin_results_f32 = np.zeros(N_f32, dtype=np.float32)
+cos_results_f32 = np.zeros(N_f32, dtype=np.float32)
 
 # Gold results
 gold_results_f64 = np.cos(angles_f64, dtype=np.float64)
 gold_results_f32 = np.cos(angles_f32, dtype=np.float32)
+gold_sin_f64 = np.sin(angles_f64, dtype=np.float64)
+gold_sin_f32 = np.sin(angles_f32, dtype=np.float32)
 
 # Create the file
 print(".section .data,\"aw\",@progbits")
@@ -64,7 +63,13 @@ emit("N_f64", np.array(N_f64, dtype=np.uint64))
 emit("angles_f64", angles_f64, 'NR_LANES*4')
 emit("results_f64", results_f64, 'NR_LANES*4')
 emit("gold_results_f64", gold_results_f64, 'NR_LANES*4')
+emit("sin_results_f64", sin_results_f64, 'NR_LANES*4')
+emit("cos_results_f64", cos_results_f64, 'NR_LANES*4')
+emit("gold_sin_f64", gold_sin_f64, 'NR_LANES*4')
 emit("N_f32", np.array(N_f32, dtype=np.uint32))
 emit("angles_f32", angles_f32, 'NR_LANES*4')
 emit("results_f32", results_f32, 'NR_LANES*4')
 emit("gold_results_f32", gold_results_f32, 'NR_LANES*4')
+emit("sin_results_f32", sin_results_f32, 'NR_LANES*4')
+emit("cos_results_f32", cos_results_f32, 'NR_LANES*4')
+emit("gold_sin_f32", gold_sin_f32, 'NR_LANES*4')
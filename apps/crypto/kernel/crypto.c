@@ -0,0 +1,363 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "crypto.h"
+
+#include <stddef.h>
+
+#include "vconfig.h"
+
+// The toolchain does not know the vector crypto extensions, which are OP-VE
+// (0x77) instructions of OPMVV. The unary AES instructions take their
+// operation from the rs1 field, the .vs forms use element group 0 of vs2 for
+// all the element groups, and vaeskf1.vi takes the round in the rs1 field
+#define VAESZ_VS(vd, vs2)                                                      \
+  asm volatile(".insn r 0x77, 2, 0x53, x" #vd ", x7, x" #vs2)
+#define VAESEM_VS(vd, vs2)                                                     \
+  asm volatile(".insn r 0x77, 2, 0x53, x" #vd ", x2, x" #vs2)
+#define VAESEF_VS(vd, vs2)                                                     \
+  asm volatile(".insn r 0x77, 2, 0x53, x" #vd ", x3, x" #vs2)
+#define VAESKF1_VI(vd, vs2, rnd)                                               \
+  asm volatile(".insn r 0x77, 2, 0x45, x" #vd ", x%0, x" #vs2 ::"i"(rnd))
+#define VGMUL_VV(vd, vs2)                                                      \
+  asm volatile(".insn r 0x77, 2, 0x51, x" #vd ", x17, x" #vs2)
+#define VGHSH_VV(vd, vs2, vs1)                                                 \
+  asm volatile(".insn r 0x77, 2, 0x59, x" #vd ", x" #vs1 ", x" #vs2)
+#define VSHA2MS_VV(vd, vs2, vs1)                                               \
+  asm volatile(".insn r 0x77, 2, 0x5b, x" #vd ", x" #vs1 ", x" #vs2)
+#define VSHA2CH_VV(vd, vs2, vs1)                                               \
+  asm volatile(".insn r 0x77, 2, 0x5d, x" #vd ", x" #vs1 ", x" #vs2)
+#define VSHA2CL_VV(vd, vs2, vs1)                                               \
+  asm volatile(".insn r 0x77, 2, 0x5f, x" #vd ", x" #vs1 ", x" #vs2)
+// vrev8.v of Zvbb
+#define VREV8_V(vd, vs2)                                                       \
+  asm volatile(".insn r 0x57, 2, 0x25, x" #vd ", x9, x" #vs2)
+
+/*
+  AES-128
+*/
+
+// Encrypt the blocks of v<vd>, with the round keys in v1-v11
+#define AES128_ENC(vd)                                                         \
+  do {                                                                         \
+    VAESZ_VS(vd, 1);                                                           \
+    VAESEM_VS(vd, 2);                                                          \
+    VAESEM_VS(vd, 3);                                                          \
+    VAESEM_VS(vd, 4);                                                          \
+    VAESEM_VS(vd, 5);                                                          \
+    VAESEM_VS(vd, 6);                                                          \
+    VAESEM_VS(vd, 7);                                                          \
+    VAESEM_VS(vd, 8);                                                          \
+    VAESEM_VS(vd, 9);                                                          \
+    VAESEM_VS(vd, 10);                                                         \
+    VAESEF_VS(vd, 11);                                                         \
+  } while (0)
+
+void aes128_expand_v(const uint8_t *key, uint32_t *rk) {
+  asm volatile("vsetivli zero, 4, e32, m1, ta, ma");
+  asm volatile("vle32.v v1, (%0)" ::"r"(key));
+  VAESKF1_VI(2, 1, 1);
+  VAESKF1_VI(3, 2, 2);
+  VAESKF1_VI(4, 3, 3);
+  VAESKF1_VI(5, 4, 4);
+  VAESKF1_VI(6, 5, 5);
+  VAESKF1_VI(7, 6, 6);
+  VAESKF1_VI(8, 7, 7);
+  VAESKF1_VI(9, 8, 8);
+  VAESKF1_VI(10, 9, 9);
+  VAESKF1_VI(11, 10, 10);
+  asm volatile("vse32.v v1, (%0)" ::"r"(rk));
+  asm volatile("vse32.v v2, (%0)" ::"r"(rk + 4));
+  asm volatile("vse32.v v3, (%0)" ::"r"(rk + 8));
+  asm volatile("vse32.v v4, (%0)" ::"r"(rk + 12));
+  asm volatile("vse32.v v5, (%0)" ::"r"(rk + 16));
+  asm volatile("vse32.v v6, (%0)" ::"r"(rk + 20));
+  asm volatile("vse32.v v7, (%0)" ::"r"(rk + 24));
+  asm volatile("vse32.v v8, (%0)" ::"r"(rk + 28));
+  asm volatile("vse32.v v9, (%0)" ::"r"(rk + 32));
+  asm volatile("vse32.v v10, (%0)" ::"r"(rk + 36));
+  asm volatile("vse32.v v11, (%0)" ::"r"(rk + 40));
+}
+
+// Round keys in v1-v11
+static inline __attribute__((always_inline)) void
+aes128_load_keys(const uint32_t *rk) {
+  asm volatile("vsetivli zero, 4, e32, m1, ta, ma");
+  asm volatile("vle32.v v1, (%0)" ::"r"(rk));
+  asm volatile("vle32.v v2, (%0)" ::"r"(rk + 4));
+  asm volatile("vle32.v v3, (%0)" ::"r"(rk + 8));
+  asm volatile("vle32.v v4, (%0)" ::"r"(rk + 12));
+  asm volatile("vle32.v v5, (%0)" ::"r"(rk + 16));
+  asm volatile("vle32.v v6, (%0)" ::"r"(rk + 20));
+  asm volatile("vle32.v v7, (%0)" ::"r"(rk + 24));
+  asm volatile("vle32.v v8, (%0)" ::"r"(rk + 28));
+  asm volatile("vle32.v v9, (%0)" ::"r"(rk + 32));
+  asm volatile("vle32.v v10, (%0)" ::"r"(rk + 36));
+  asm volatile("vle32.v v11, (%0)" ::"r"(rk + 40));
+}
+
+// Counter mode at e32, m2, with the counter block ctr in all the element
+// groups of v16, the words of the groups (i & 3) in v14 and their byte offsets
+// in v12, the group of each element in v18, and the last word of each group,
+// the counter, in v0. Return the counter of ctr
+static inline __attribute__((always_inline)) uint32_t
+aes128_ctr_setup(const uint8_t *ctr) {
+  asm volatile("vsetvli zero, %0, e32, m2, ta, ma" ::"r"(VLMAX(32, 2)));
+  asm volatile("vid.v v12");
+  asm volatile("vsrl.vi v18, v12, 2");
+  asm volatile("vand.vi v14, v12, 3");
+  asm volatile("vmseq.vi v0, v14, 3");
+  asm volatile("vsll.vi v12, v14, 2");
+  asm volatile("vluxei32.v v16, (%0), v12" ::"r"(ctr));
+  return __builtin_bswap32(((const uint32_t *)ctr)[3]);
+}
+
+// Encrypt the vl / 4 blocks at in to out, with the counters c, c + 1, ...,
+// and leave the output in v20
+static inline __attribute__((always_inline)) void
+aes128_ctr_strip(const uint8_t *in, uint8_t *out, uint32_t c) {
+  // The counters are big-endian
+  asm volatile("vadd.vx v20, v18, %0" ::"r"(c));
+  VREV8_V(20, 20);
+  asm volatile("vmerge.vvm v20, v16, v20, v0");
+  AES128_ENC(20);
+  asm volatile("vle32.v v22, (%0)" ::"r"(in));
+  asm volatile("vxor.vv v20, v20, v22");
+  asm volatile("vse32.v v20, (%0)" ::"r"(out));
+}
+
+void aes128_ctr_v(const uint32_t *rk, const uint8_t *ctr, const uint8_t *in,
+                  uint8_t *out, uint64_t nblocks) {
+  size_t vl;
+
+  aes128_load_keys(rk);
+  uint32_t c = aes128_ctr_setup(ctr);
+
+  for (uint64_t b = 0; b < nblocks; b += vl / 4) {
+    asm volatile("vsetvli %0, %1, e32, m2, ta, ma"
+                 : "=r"(vl)
+                 : "r"(4 * (nblocks - b)));
+    aes128_ctr_strip(in + 16 * b, out + 16 * b, c + b);
+  }
+}
+
+/*
+  AES-128-GCM
+*/
+
+// XOR the first cnt element groups of v<vr> into its group 0, with v30 as
+// a temporary
+#define GCM_FOLD(vr, cnt)                                                      \
+  do {                                                                         \
+    for (uint64_t n = (cnt); n > 1;) {                                         \
+      uint64_t h = n / 2;                                                      \
+      asm volatile("vsetvli zero, %0, e32, m2, ta, ma" ::"r"(4 * h));          \
+      asm volatile("vslidedown.vx v30, v" #vr ", %0" ::"r"(4 * (n - h)));      \
+      asm volatile("vxor.vv v" #vr ", v" #vr ", v30");                         \
+      n -= h;                                                                  \
+    }                                                                          \
+  } while (0)
+
+void aes128_gcm_v(const uint32_t *rk, const uint8_t *iv, const uint8_t *in,
+                  uint8_t *out, uint64_t nblocks, uint8_t *tag) {
+  // Blocks of a full strip, each one with its GHASH accumulator
+  const uint64_t groups = VLMAX(32, 2) / 4;
+  const uint64_t full = nblocks / groups;
+  const uint64_t rem = nblocks % groups;
+
+  // J0 = iv || 1, and the length block, with the bit length of the ciphertext
+  static uint32_t j0[4] __attribute__((aligned(16)));
+  static uint32_t len_blk[4] __attribute__((aligned(16)));
+  for (int i = 0; i < 3; ++i)
+    j0[i] = ((const uint32_t *)iv)[i];
+  j0[3] = __builtin_bswap32(1);
+  len_blk[0] = 0;
+  len_blk[1] = 0;
+  len_blk[2] = __builtin_bswap32((uint32_t)((nblocks * 128) >> 32));
+  len_blk[3] = __builtin_bswap32((uint32_t)(nblocks * 128));
+
+  aes128_load_keys(rk);
+
+  // H = E(0)
+  asm volatile("vmv.v.i v30, 0");
+  AES128_ENC(30);
+
+  uint32_t c = aes128_ctr_setup((const uint8_t *)j0) + 1;
+
+  // H in all the element groups of v26, and H^(groups - g) in the group g of
+  // v24: the group g is multiplied by H for each k < groups - g
+  asm volatile("vrgather.vv v26, v30, v14");
+  asm volatile("vmv.v.v v24, v26");
+  for (uint64_t k = 1; k < groups; ++k) {
+    asm volatile("vsetvli zero, %0, e32, m2, tu, ma" ::"r"(4 * (groups - k)));
+    VGMUL_VV(24, 26);
+  }
+  // H^groups in all the element groups of v26
+  asm volatile("vsetvli zero, %0, e32, m2, ta, ma" ::"r"(VLMAX(32, 2)));
+  asm volatile("vrgather.vv v26, v24, v14");
+  asm volatile("vmv.v.i v28, 0");
+
+  // Each accumulator takes a block of the strip: the accumulators move by
+  // H^groups, up to the last strip, which brings each one to its power of H
+  for (uint64_t s = 0; s < full; ++s) {
+    const uint64_t b = s * groups;
+    aes128_ctr_strip(in + 16 * b, out + 16 * b, c + b);
+    if (s + 1 < full) {
+      VGHSH_VV(28, 26, 20);
+    } else {
+      VGHSH_VV(28, 24, 20);
+    }
+  }
+  if (full)
+    GCM_FOLD(28, groups);
+
+  // The rem blocks left: Y goes into the first one, and the block g takes
+  // H^(rem - g)
+  if (rem) {
+    const uint64_t b = full * groups;
+    asm volatile("vsetvli zero, %0, e32, m2, ta, ma" ::"r"(4 * rem));
+    aes128_ctr_strip(in + 16 * b, out + 16 * b, c + b);
+    asm volatile("vsetivli zero, 4, e32, m1, tu, ma");
+    asm volatile("vxor.vv v20, v20, v28");
+    asm volatile("vsetvli zero, %0, e32, m2, ta, ma" ::"r"(4 * rem));
+    asm volatile("vslidedown.vx v30, v24, %0" ::"r"(4 * (groups - rem)));
+    VGMUL_VV(20, 30);
+    GCM_FOLD(20, rem);
+    asm volatile("vsetivli zero, 4, e32, m1, ta, ma");
+    asm volatile("vmv.v.v v28, v20");
+  }
+
+  // The length block, with H from the last group of v24, and the tag E(J0) ^ Y
+  asm volatile("vsetivli zero, 4, e32, m2, ta, ma");
+  asm volatile("vslidedown.vx v30, v24, %0" ::"r"(4 * (groups - 1)));
+  asm volatile("vsetivli zero, 4, e32, m1, ta, ma");
+  asm volatile("vle32.v v22, (%0)" ::"r"(len_blk));
+  VGHSH_VV(28, 30, 22);
+  asm volatile("vle32.v v20, (%0)" ::"r"(j0));
+  AES128_ENC(20);
+  asm volatile("vxor.vv v20, v20, v28");
+  asm volatile("vse32.v v20, (%0)" ::"r"(tag));
+}
+
+/*
+  SHA-256
+*/
+
+static const uint32_t sha256_k[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1,
+    0x923f82a4, 0xab1c5ed5, 0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+    0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174, 0xe49b69c1, 0xefbe4786,
+    0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147,
+    0x06ca6351, 0x14292967, 0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
+    0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85, 0xa2bfe8a1, 0xa81a664b,
+    0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a,
+    0x5b9cca4f, 0x682e6ff3, 0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+    0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2};
+
+// Initial state, in the order of the element groups of vsha2c[hl]
+static const uint32_t sha256_abef[4] = {0x9b05688c, 0x510e527f, 0xbb67ae85,
+                                        0x6a09e667};
+static const uint32_t sha256_cdgh[4] = {0x5be0cd19, 0x1f83d9ab, 0xa54ff53a,
+                                        0x3c6ef372};
+// Byte offsets of f, e, b, a in the digest (h, g, d, c are 8 bytes further)
+static const uint32_t sha256_abef_off[4] = {20, 16, 4, 0};
+
+// Four rounds with the words in v<q0>, then the next four words of the
+// schedule in v<q0>, from the words in v<q1>, v<q2>, v<q3> that follow it
+#define SHA256_QUAD(i, q0, q1, q2, q3)                                         \
+  do {                                                                         \
+    asm volatile("vluxei32.v v28, (%0), v2" ::"r"(sha256_k + 4 * (i)));        \
+    asm volatile("vadd.vv v24, v28, v" #q0);                                   \
+    VSHA2CL_VV(10, 8, 24);                                                     \
+    VSHA2CH_VV(8, 10, 24);                                                     \
+    if ((i) < 12) {                                                            \
+      asm volatile("vmerge.vvm v26, v" #q2 ", v" #q1 ", v0");                  \
+      VSHA2MS_VV(q0, 26, q3);                                                  \
+    }                                                                          \
+  } while (0)
+
+void sha256_v(const uint8_t *msgs, uint64_t n, uint64_t nblk,
+              uint8_t *digests) {
+  const uint64_t len = 64 * nblk;
+  size_t vl;
+
+  for (uint64_t k = 0; k < n; k += vl / 4) {
+    const uint8_t *msg = msgs + k * len;
+
+    asm volatile("vsetvli %0, %1, e32, m2, ta, ma"
+                 : "=r"(vl)
+                 : "r"(4 * (n - k)));
+    // The first element of each group in v0, the byte offsets of the words of
+    // the groups in v2, and of the words of the messages in v4
+    asm volatile("vid.v v4");
+    asm volatile("vand.vi v2, v4, 3");
+    asm volatile("vmseq.vi v0, v2, 0");
+    asm volatile("vsll.vi v2, v2, 2");
+    asm volatile("vsrl.vi v4, v4, 2");
+    asm volatile("vsll.vi v6, v4, 5");
+    asm volatile("vmul.vx v4, v4, %0" ::"r"(len));
+    asm volatile("vadd.vv v4, v4, v2");
+    // Offsets of the words of the digests in v6
+    asm volatile("vluxei32.v v30, (%0), v2" ::"r"(sha256_abef_off));
+    asm volatile("vadd.vv v6, v6, v30");
+
+    asm volatile("vluxei32.v v8, (%0), v2" ::"r"(sha256_abef));
+    asm volatile("vluxei32.v v10, (%0), v2" ::"r"(sha256_cdgh));
+
+    for (uint64_t blk = 0; blk < nblk; ++blk) {
+      const uint8_t *w = msg + 64 * blk;
+
+      asm volatile("vmv.v.v v12, v8");
+      asm volatile("vmv.v.v v14, v10");
+      // The words of the blocks are big-endian
+      asm volatile("vluxei32.v v16, (%0), v4" ::"r"(w));
+      asm volatile("vluxei32.v v18, (%0), v4" ::"r"(w + 16));
+      asm volatile("vluxei32.v v20, (%0), v4" ::"r"(w + 32));
+      asm volatile("vluxei32.v v22, (%0), v4" ::"r"(w + 48));
+      VREV8_V(16, 16);
+      VREV8_V(18, 18);
+      VREV8_V(20, 20);
+      VREV8_V(22, 22);
+
+      SHA256_QUAD(0, 16, 18, 20, 22);
+      SHA256_QUAD(1, 18, 20, 22, 16);
+      SHA256_QUAD(2, 20, 22, 16, 18);
+      SHA256_QUAD(3, 22, 16, 18, 20);
+      SHA256_QUAD(4, 16, 18, 20, 22);
+      SHA256_QUAD(5, 18, 20, 22, 16);
+      SHA256_QUAD(6, 20, 22, 16, 18);
+      SHA256_QUAD(7, 22, 16, 18, 20);
+      SHA256_QUAD(8, 16, 18, 20, 22);
+      SHA256_QUAD(9, 18, 20, 22, 16);
+      SHA256_QUAD(10, 20, 22, 16, 18);
+      SHA256_QUAD(11, 22, 16, 18, 20);
+      SHA256_QUAD(12, 16, 18, 20, 22);
+      SHA256_QUAD(13, 18, 20, 22, 16);
+      SHA256_QUAD(14, 20, 22, 16, 18);
+      SHA256_QUAD(15, 22, 16, 18, 20);
+
+      asm volatile("vadd.vv v8, v8, v12");
+      asm volatile("vadd.vv v10, v10, v14");
+    }
+
+    VREV8_V(8, 8);
+    VREV8_V(10, 10);
+    asm volatile("vsuxei32.v v8, (%0), v6" ::"r"(digests + 32 * k));
+    asm volatile("vsuxei32.v v10, (%0), v6" ::"r"(digests + 32 * k + 8));
+  }
+}
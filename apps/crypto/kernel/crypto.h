@@ -0,0 +1,48 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// AES-128 and SHA-256 with the vector crypto extensions (Zvkned, Zvknha, and
+// Zvkg), which work on element groups of four 32-bit elements:
+//   aes128_expand_v: the 11 round keys of key (44 words), with vaeskf1
+//   aes128_ctr_v: nblocks blocks of 16 bytes in counter mode, from the counter
+//                 block ctr, whose last 32-bit word is a big-endian counter.
+//                 Each element group encrypts its own counter block
+//   aes128_gcm_v: AES-128-GCM with the 12-byte iv and no additional data, the
+//                 ciphertext and the 16-byte tag. GHASH runs on the blocks of
+//                 a strip in parallel, one accumulator per element group,
+//                 which are combined with the powers of H at the end
+//   sha256_v: the digests of n messages, already padded to nblk blocks of 64
+//             bytes each, stored one after the other. Each element group
+//             hashes its own message
+// The round keys of the AES kernels come from aes128_expand_v.
+
+#ifndef _CRYPTO_H_
+#define _CRYPTO_H_
+
+#include <stdint.h>
+
+void aes128_expand_v(const uint8_t *key, uint32_t *rk);
+
+void aes128_ctr_v(const uint32_t *rk, const uint8_t *ctr, const uint8_t *in,
+                  uint8_t *out, uint64_t nblocks);
+
+void aes128_gcm_v(const uint32_t *rk, const uint8_t *iv, const uint8_t *in,
+                  uint8_t *out, uint64_t nblocks, uint8_t *tag);
+
+void sha256_v(const uint8_t *msgs, uint64_t n, uint64_t nblk,
+              uint8_t *digests);
+
+#endif
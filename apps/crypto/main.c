@@ -0,0 +1,98 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdint.h>
+
+#include "bench.h"
+#include "kernel/crypto.h"
+#include "runtime.h"
+#include "util.h"
+#include "vcheck.h"
+
+#ifndef SPIKE
+#include "printf.h"
+#else
+#include <stdio.h>
+#endif
+
+extern uint64_t nblocks;
+extern uint64_t nmsg;
+extern uint64_t msg_blk;
+extern uint8_t key[] __attribute__((aligned(4 * NR_LANES)));
+extern uint8_t iv[] __attribute__((aligned(4 * NR_LANES)));
+extern uint8_t ctr0[] __attribute__((aligned(4 * NR_LANES)));
+extern uint8_t pt[] __attribute__((aligned(4 * NR_LANES)));
+extern uint8_t msgs[] __attribute__((aligned(4 * NR_LANES)));
+extern uint32_t rk[] __attribute__((aligned(4 * NR_LANES)));
+extern uint8_t ct[] __attribute__((aligned(4 * NR_LANES)));
+extern uint8_t tag[] __attribute__((aligned(4 * NR_LANES)));
+extern uint8_t digests[] __attribute__((aligned(4 * NR_LANES)));
+extern uint8_t gold_rk[] __attribute__((aligned(4 * NR_LANES)));
+extern uint8_t gold_ct[] __attribute__((aligned(4 * NR_LANES)));
+extern uint8_t gold_tag[] __attribute__((aligned(4 * NR_LANES)));
+extern uint8_t gold_digests[] __attribute__((aligned(4 * NR_LANES)));
+
+// Check n bytes of result against gold, and report the index of the first
+// wrong one
+static void check(const char *name, const uint8_t *result, const uint8_t *gold,
+                  uint64_t n, int *error) {
+  int64_t idx = vcheck_i8((const int8_t *)result, (const int8_t *)gold, n);
+  if (idx >= 0) {
+    printf("%s: Error at byte %d.\n", name, idx);
+    *error = 1;
+  } else {
+    printf("%s: Check okay. No errors.\n", name);
+  }
+}
+
+// Report the cycles of the last timed kernel on bytes bytes
+int main() {
+  printf("\n");
+  printf("============\n");
+  printf("=  CRYPTO  =\n");
+  printf("============\n");
+  printf("\n");
+  printf("\n");
+
+  printf("AES blocks: %lu, SHA-256 messages: %lu of %lu blocks\n", nblocks,
+         nmsg, msg_blk);
+
+  int error = 0;
+
+  aes128_expand_v(key, rk);
+  check("aes128_expand_v", (const uint8_t *)rk, gold_rk, 176, &error);
+
+  start_timer();
+  aes128_ctr_v(rk, ctr0, pt, ct, nblocks);
+  stop_timer();
+  bench_report_rate("aes128_ctr_v", 16 * nblocks, "bytes");
+  check("aes128_ctr_v", ct, gold_ct, 16 * nblocks, &error);
+
+  start_timer();
+  aes128_gcm_v(rk, iv, pt, ct, nblocks, tag);
+  stop_timer();
+  bench_report_rate("aes128_gcm_v", 16 * nblocks, "bytes");
+  check("aes128_gcm_v", ct, gold_ct, 16 * nblocks, &error);
+  check("aes128_gcm_v tag", tag, gold_tag, 16, &error);
+
+  start_timer();
+  sha256_v(msgs, nmsg, msg_blk, digests);
+  stop_timer();
+  bench_report_rate("sha256_v", 64 * nmsg * msg_blk, "bytes");
+  check("sha256_v", digests, gold_digests, 32 * nmsg, &error);
+
+  return error;
+}
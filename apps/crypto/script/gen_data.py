@@ -0,0 +1,158 @@
+#!/usr/bin/env python3
+# Copyright 2022 ETH Zurich and University of Bologna.
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+# arg1: AES blocks of 16 bytes, arg2: number of SHA-256 messages, arg3: blocks of
+# 64 bytes per padded message
+
+import hashlib
+import numpy as np
+import os
+import sys
+
+sys.path.insert(0, os.path.join(os.path.dirname(__file__), '../../common/script'))
+from data_emit import emit
+
+def xtime(b):
+  return ((b << 1) ^ (0x1b if b & 0x80 else 0)) & 0xff
+
+def gmul(a, b):
+  r = 0
+  for i in range(8):
+    if (b >> i) & 1:
+      r ^= a
+    a = xtime(a)
+  return r
+
+def sbox():
+  # Multiplicative inverse in GF(2^8), then the affine transformation
+  s = []
+  for a in range(256):
+    x = next((y for y in range(1, 256) if gmul(a, y) == 1), 0)
+    b = x
+    for i in range(1, 5):
+      b ^= ((x << i) | (x >> (8 - i))) & 0xff
+    s.append(b ^ 0x63)
+  return s
+
+SBOX = sbox()
+
+def aes128_expand(key):
+  # The 44 words of the round keys, as bytes
+  w, rcon = [list(key[4*i:4*i+4]) for i in range(4)], 1
+  for i in range(4, 44):
+    t = list(w[i-1])
+    if i % 4 == 0:
+      t = [SBOX[b] for b in t[1:] + t[:1]]
+      t[0] ^= rcon
+      rcon = xtime(rcon)
+    w.append([a ^ b for a, b in zip(w[i-4], t)])
+  return bytes(sum(w, []))
+
+def aes128_encrypt(rk, block):
+  s = [a ^ b for a, b in zip(block, rk[:16])]
+  for r in range(1, 11):
+    s = [SBOX[b] for b in s]
+    # Byte 4c+r is the row r of column c
+    s = [s[4*((c + r) % 4) + r] for c in range(4) for r in range(4)]
+    if r < 10:
+      s = sum(([gmul(col[0], 2) ^ gmul(col[1], 3) ^ col[2] ^ col[3],
+                col[0] ^ gmul(col[1], 2) ^ gmul(col[2], 3) ^ col[3],
+                col[0] ^ col[1] ^ gmul(col[2], 2) ^ gmul(col[3], 3),
+                gmul(col[0], 3) ^ col[1] ^ col[2] ^ gmul(col[3], 2)]
+               for col in (s[4*c:4*c+4] for c in range(4))), [])
+    s = [a ^ b for a, b in zip(s, rk[16*r:16*r+16])]
+  return bytes(s)
+
+def inc32(block, k):
+  return block[:12] + ((int.from_bytes(block[12:], 'big') + k) & 0xffffffff).to_bytes(4, 'big')
+
+def ghash_mul(x, y):
+  # Multiplication in GF(2^128) of GCM (NIST SP 800-38D), on the blocks as integers
+  z, v = 0, y
+  for i in range(127, -1, -1):
+    if (x >> i) & 1:
+      z ^= v
+    v = (v >> 1) ^ (0xe1 << 120) if v & 1 else v >> 1
+  return z
+
+def aes128_gcm(rk, iv, pt):
+  # Without additional data
+  h  = int.from_bytes(aes128_encrypt(rk, bytes(16)), 'big')
+  j0 = iv + bytes([0, 0, 0, 1])
+  ct = b''.join(bytes(a ^ b for a, b in zip(aes128_encrypt(rk, inc32(j0, 1 + i)), pt[16*i:16*i+16]))
+                for i in range(len(pt) // 16))
+  y = 0
+  for i in range(len(ct) // 16):
+    y = ghash_mul(y ^ int.from_bytes(ct[16*i:16*i+16], 'big'), h)
+  y = ghash_mul(y ^ (len(ct) * 8), h)
+  tag = bytes(a ^ b for a, b in zip(aes128_encrypt(rk, j0), y.to_bytes(16, 'big')))
+  return ct, tag
+
+def sha256_pad(msg):
+  m = msg + b'\x80' + bytes(-(len(msg) + 9) % 64)
+  return m + (8 * len(msg)).to_bytes(8, 'big')
+
+############
+## SCRIPT ##
+############
+
+if len(sys.argv) == 4:
+  nblocks = int(sys.argv[1])
+  nmsg    = int(sys.argv[2])
+  msg_blk = int(sys.argv[3])
+else:
+  print("Error. Give me three arguments: the AES blocks, the SHA-256 messages, and the blocks per message.")
+  sys.exit()
+
+if nblocks == 0 or nmsg == 0 or msg_blk == 0:
+  print("Error. The sizes must be positive.")
+  sys.exit()
+
+key = np.random.randint(0, 256, size=16).astype(np.uint8).tobytes()
+iv  = np.random.randint(0, 256, size=12).astype(np.uint8).tobytes()
+pt  = np.random.randint(0, 256, size=16 * nblocks).astype(np.uint8).tobytes()
+rk  = aes128_expand(key)
+ct, tag = aes128_gcm(rk, iv, pt)
+
+# Messages of different lengths, which fill their last block after the padding
+msgs = [np.random.randint(0, 256, size=64 * msg_blk - 9 - (i % 56)).astype(np.uint8).tobytes()
+        for i in range(nmsg)]
+padded  = b''.join(sha256_pad(m) for m in msgs)
+digests = b''.join(hashlib.sha256(m).digest() for m in msgs)
+
+def u8(b):
+  return np.frombuffer(b, dtype=np.uint8)
+
+# Create the file
+print(".section .data,\"aw\",@progbits")
+emit("nblocks", np.array(nblocks, dtype=np.uint64))
+emit("nmsg", np.array(nmsg, dtype=np.uint64))
+emit("msg_blk", np.array(msg_blk, dtype=np.uint64))
+emit("key", u8(key), 'NR_LANES*4')
+# The first counter block of the ciphertext, after the one of the tag
+emit("iv", u8(iv + bytes(4)), 'NR_LANES*4')
+emit("ctr0", u8(inc32(iv + bytes([0, 0, 0, 1]), 1)), 'NR_LANES*4')
+emit("pt", u8(pt), 'NR_LANES*4')
+emit("msgs", u8(padded), 'NR_LANES*4')
+emit("rk", np.zeros(44, dtype=np.uint32), 'NR_LANES*4')
+emit("ct", np.zeros(16 * nblocks, dtype=np.uint8), 'NR_LANES*4')
+emit("tag", np.zeros(16, dtype=np.uint8), 'NR_LANES*4')
+emit("digests", np.zeros(32 * nmsg, dtype=np.uint8), 'NR_LANES*4')
+emit("gold_rk", u8(rk), 'NR_LANES*4')
+emit("gold_ct", u8(ct), 'NR_LANES*4')
+emit("gold_tag", u8(tag), 'NR_LANES*4')
+emit("gold_digests", u8(digests), 'NR_LANES*4')
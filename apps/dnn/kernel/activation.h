@@ -0,0 +1 @@
+../../activation/kernel/activation.h
\ No newline at end of file
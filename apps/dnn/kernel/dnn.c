@@ -0,0 +1,256 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dnn.h"
+#include "activation.h"
+#include "dwconv.h"
+#include "fmatmul_f32.h"
+#include "layernorm.h"
+#include "prof.h"
+#include "runtime.h"
+#include "softmax.h"
+#include "transpose.h"
+
+dnn_stage_t dnn_stages[DNN_MAX_STAGES];
+uint64_t dnn_nr_stages = 0;
+
+static int64_t stage_start;
+
+static void stage_begin(uint32_t prof) {
+  PROF_BEGIN(prof);
+  stage_start = get_cycle_count();
+}
+
+static void stage_end(uint32_t prof, const char *name, uint64_t flop,
+                      uint64_t bytes) {
+  const int64_t cycles = get_cycle_count() - stage_start;
+  PROF_END(prof);
+  if (dnn_nr_stages < DNN_MAX_STAGES)
+    dnn_stages[dnn_nr_stages++] = (dnn_stage_t){name, flop, bytes, cycles};
+}
+
+// FLOP and compulsory bytes of a GEMM [m x n] by [n x p]
+#define GEMM_FLOP(m, n, p) (2 * (m) * (n) * (p))
+#define GEMM_BYTES(m, n, p) (4 * ((m) * (n) + (n) * (p) + (m) * (p)))
+
+void dnn_prof_names() {
+  PROF_NAME(DNN_PROF_RESNET_LAYOUT, "resnet.im2col");
+  PROF_NAME(DNN_PROF_RESNET_GEMM, "resnet.gemm");
+  PROF_NAME(DNN_PROF_RESNET_ACT, "resnet.relu");
+  PROF_NAME(DNN_PROF_RESNET_ADD, "resnet.residual");
+  PROF_NAME(DNN_PROF_MBV2_GEMM, "mbv2.gemm");
+  PROF_NAME(DNN_PROF_MBV2_ACT, "mbv2.relu");
+  PROF_NAME(DNN_PROF_MBV2_DWCONV, "mbv2.dwconv");
+  PROF_NAME(DNN_PROF_MBV2_ADD, "mbv2.residual");
+  PROF_NAME(DNN_PROF_ENC_GEMM, "encoder.gemm");
+  PROF_NAME(DNN_PROF_ENC_LAYOUT, "encoder.transpose");
+  PROF_NAME(DNN_PROF_ENC_SOFTMAX, "encoder.softmax");
+  PROF_NAME(DNN_PROF_ENC_NORM, "encoder.layernorm");
+  PROF_NAME(DNN_PROF_ENC_ACT, "encoder.gelu");
+  PROF_NAME(DNN_PROF_ENC_ADD, "encoder.residual");
+}
+
+////////////
+// Blocks //
+////////////
+
+void dnn_resnet_block(float *y, const float *x, const dnn_resnet_t *p,
+                      uint64_t H, uint64_t W, uint64_t C) {
+  const uint64_t P = H * W;
+
+  stage_begin(DNN_PROF_RESNET_LAYOUT);
+  dnn_im2col3x3(p->col, x, H, W, C);
+  stage_end(DNN_PROF_RESNET_LAYOUT, "im2col", 0, 4 * 10 * P * C);
+
+  stage_begin(DNN_PROF_RESNET_GEMM);
+  fmatmul_f32(p->y1, p->col, p->w1, P, 9 * C, C);
+  stage_end(DNN_PROF_RESNET_GEMM, "conv1", GEMM_FLOP(P, 9 * C, C),
+            GEMM_BYTES(P, 9 * C, C));
+
+  stage_begin(DNN_PROF_RESNET_ACT);
+  relu_f32(p->y1, p->y1, p->b1, P, C);
+  stage_end(DNN_PROF_RESNET_ACT, "bias+relu1", 2 * P * C, 4 * (2 * P + 1) * C);
+
+  stage_begin(DNN_PROF_RESNET_LAYOUT);
+  dnn_im2col3x3(p->col, p->y1, H, W, C);
+  stage_end(DNN_PROF_RESNET_LAYOUT, "im2col", 0, 4 * 10 * P * C);
+
+  stage_begin(DNN_PROF_RESNET_GEMM);
+  fmatmul_f32(y, p->col, p->w2, P, 9 * C, C);
+  stage_end(DNN_PROF_RESNET_GEMM, "conv2", GEMM_FLOP(P, 9 * C, C),
+            GEMM_BYTES(P, 9 * C, C));
+
+  stage_begin(DNN_PROF_RESNET_ADD);
+  dnn_add(y, y, x, p->b2, P, C);
+  stage_end(DNN_PROF_RESNET_ADD, "bias+residual", 2 * P * C,
+            4 * (3 * P + 1) * C);
+
+  stage_begin(DNN_PROF_RESNET_ACT);
+  relu_f32(y, y, NULL, P, C);
+  stage_end(DNN_PROF_RESNET_ACT, "relu2", P * C, 4 * 2 * P * C);
+}
+
+void dnn_mbv2_block(float *y, const float *x, const dnn_mbv2_t *p, uint64_t H,
+                    uint64_t W, uint64_t C, uint64_t t) {
+  const uint64_t P = H * W, E = t * C;
+
+  stage_begin(DNN_PROF_MBV2_GEMM);
+  fmatmul_f32(p->e, x, p->we, P, C, E);
+  stage_end(DNN_PROF_MBV2_GEMM, "expand", GEMM_FLOP(P, C, E),
+            GEMM_BYTES(P, C, E));
+
+  stage_begin(DNN_PROF_MBV2_ACT);
+  relu_f32(p->e, p->e, p->be, P, E);
+  stage_end(DNN_PROF_MBV2_ACT, "bias+relu", 2 * P * E, 4 * (2 * P + 1) * E);
+
+  // 9 MACs per output, with the bias and the ReLU6
+  stage_begin(DNN_PROF_MBV2_DWCONV);
+  dwconv3x3_nhwc(p->d, p->e, p->wd, p->bd, E, H, W, 1, 1);
+  stage_end(DNN_PROF_MBV2_DWCONV, "dwconv3x3", 2 * 9 * P * E,
+            4 * (2 * P + 10) * E);
+
+  stage_begin(DNN_PROF_MBV2_GEMM);
+  fmatmul_f32(y, p->d, p->wp, P, E, C);
+  stage_end(DNN_PROF_MBV2_GEMM, "project", GEMM_FLOP(P, E, C),
+            GEMM_BYTES(P, E, C));
+
+  stage_begin(DNN_PROF_MBV2_ADD);
+  dnn_add(y, y, x, p->bp, P, C);
+  stage_end(DNN_PROF_MBV2_ADD, "bias+residual", 2 * P * C,
+            4 * (3 * P + 1) * C);
+}
+
+void dnn_encoder_layer(float *y, const float *x, const dnn_encoder_t *p,
+                       uint64_t tokens, uint64_t dim, uint64_t ffn) {
+  const uint64_t n = tokens, d = dim;
+
+  stage_begin(DNN_PROF_ENC_GEMM);
+  fmatmul_f32(p->q, x, p->wq, n, d, d);
+  fmatmul_f32(p->k, x, p->wk, n, d, d);
+  fmatmul_f32(p->v, x, p->wv, n, d, d);
+  stage_end(DNN_PROF_ENC_GEMM, "qkv", 3 * GEMM_FLOP(n, d, d),
+            4 * (n * d + 3 * d * d + 3 * n * d));
+
+  // The scores need k^T as the [dim x tokens] B matrix of the GEMM
+  stage_begin(DNN_PROF_ENC_LAYOUT);
+  transpose_e32(p->kt, p->k, n, d);
+  stage_end(DNN_PROF_ENC_LAYOUT, "transpose(k)", 0, 4 * 2 * n * d);
+
+  stage_begin(DNN_PROF_ENC_GEMM);
+  fmatmul_f32(p->s, p->q, p->kt, n, d, n);
+  stage_end(DNN_PROF_ENC_GEMM, "q k^T", GEMM_FLOP(n, d, n),
+            GEMM_BYTES(n, d, n));
+
+  // The max, the exponential and the sum, and the division of each score
+  stage_begin(DNN_PROF_ENC_SOFTMAX);
+  softmax_rows_vec(p->s, p->s, n, n);
+  stage_end(DNN_PROF_ENC_SOFTMAX, "softmax", 4 * n * n, 4 * 2 * n * n);
+
+  stage_begin(DNN_PROF_ENC_GEMM);
+  fmatmul_f32(p->a, p->s, p->v, n, n, d);
+  stage_end(DNN_PROF_ENC_GEMM, "s v", GEMM_FLOP(n, n, d),
+            GEMM_BYTES(n, n, d));
+
+  stage_begin(DNN_PROF_ENC_GEMM);
+  fmatmul_f32(p->r, p->a, p->wo, n, d, d);
+  stage_end(DNN_PROF_ENC_GEMM, "out", GEMM_FLOP(n, d, d), GEMM_BYTES(n, d, d));
+
+  stage_begin(DNN_PROF_ENC_ADD);
+  dnn_add(p->r, p->r, x, p->bo, n, d);
+  stage_end(DNN_PROF_ENC_ADD, "bias+residual", 2 * n * d, 4 * (3 * n + 1) * d);
+
+  // The sums of the statistics, then a multiply-add per element
+  stage_begin(DNN_PROF_ENC_NORM);
+  layernorm_f32(p->r, p->g1, p->be1, p->h, n, d);
+  stage_end(DNN_PROF_ENC_NORM, "layernorm1", 5 * n * d, 4 * (2 * n + 2) * d);
+
+  stage_begin(DNN_PROF_ENC_GEMM);
+  fmatmul_f32(p->f, p->h, p->w1, n, d, ffn);
+  stage_end(DNN_PROF_ENC_GEMM, "ffn1", GEMM_FLOP(n, d, ffn),
+            GEMM_BYTES(n, d, ffn));
+
+  stage_begin(DNN_PROF_ENC_ACT);
+  gelu_f32(p->f, p->f, p->b1, n, ffn);
+  stage_end(DNN_PROF_ENC_ACT, "bias+gelu", 2 * n * ffn, 4 * (2 * n + 1) * ffn);
+
+  stage_begin(DNN_PROF_ENC_GEMM);
+  fmatmul_f32(p->r, p->f, p->w2, n, ffn, d);
+  stage_end(DNN_PROF_ENC_GEMM, "ffn2", GEMM_FLOP(n, ffn, d),
+            GEMM_BYTES(n, ffn, d));
+
+  stage_begin(DNN_PROF_ENC_ADD);
+  dnn_add(p->r, p->r, p->h, p->b2, n, d);
+  stage_end(DNN_PROF_ENC_ADD, "bias+residual", 2 * n * d, 4 * (3 * n + 1) * d);
+
+  stage_begin(DNN_PROF_ENC_NORM);
+  layernorm_f32(p->r, p->g2, p->be2, y, n, d);
+  stage_end(DNN_PROF_ENC_NORM, "layernorm2", 5 * n * d, 4 * (2 * n + 2) * d);
+}
+
+//////////
+// Glue //
+//////////
+
+void dnn_im2col3x3(float *col, const float *x, uint64_t H, uint64_t W,
+                   uint64_t C) {
+  size_t vl;
+
+  // Each row of col is the 9 C elements of the 3x3 window of a pixel, which
+  // are the C contiguous channels of each tap, or zeros outside of x
+  for (uint64_t y = 0; y < H; ++y) {
+    for (uint64_t xo = 0; xo < W; ++xo) {
+      float *row = col + (y * W + xo) * 9 * C;
+      for (int64_t ky = -1; ky <= 1; ++ky) {
+        for (int64_t kx = -1; kx <= 1; ++kx, row += C) {
+          const int64_t iy = (int64_t)y + ky, ix = (int64_t)xo + kx;
+          const int inside =
+              iy >= 0 && iy < (int64_t)H && ix >= 0 && ix < (int64_t)W;
+          const float *src = x + (iy * (int64_t)W + ix) * (int64_t)C;
+          for (uint64_t c = 0; c < C; c += vl) {
+            vl = vsetvl_e32m8(C - c);
+            vfloat32m8_t v = inside ? vle32_v_f32m8(src + c, vl)
+                                    : vfmv_v_f_f32m8(0, vl);
+            vse32_v_f32m8(row + c, v, vl);
+          }
+        }
+      }
+    }
+  }
+}
+
+void dnn_add(float *y, const float *a, const float *b, const float *bias,
+             uint64_t rows, uint64_t cols) {
+  size_t vl;
+
+  // Without a bias, the rows are contiguous
+  if (!bias) {
+    cols *= rows;
+    rows = 1;
+  }
+
+  for (uint64_t r = 0; r < rows; ++r) {
+    const float *a_ = a + r * cols, *b_ = b + r * cols;
+    float *y_ = y + r * cols;
+    for (uint64_t c = 0; c < cols; c += vl) {
+      vl = vsetvl_e32m8(cols - c);
+      vfloat32m8_t v = vfadd_vv_f32m8(vle32_v_f32m8(a_ + c, vl),
+                                      vle32_v_f32m8(b_ + c, vl), vl);
+      if (bias)
+        v = vfadd_vv_f32m8(v, vle32_v_f32m8(bias + c, vl), vl);
+      vse32_v_f32m8(y_ + c, v, vl);
+    }
+  }
+}
@@ -0,0 +1,126 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// End-to-end blocks of DNN inference in FP32, composed of the kernels of the
+// other apps, with the activations in the NHWC layout ([H W x C] matrices) or
+// as [tokens x dim] matrices:
+//   dnn_resnet_block:   ResNet basic block, y = relu(conv3x3(relu(conv3x3(x)
+//                       + b1)) + b2 + x), with the convolutions as an im2col
+//                       and a GEMM of fmatmul_f32
+//   dnn_mbv2_block:     MobileNetV2 inverted residual, with an expansion by t
+//                       of the channels, e = relu(conv1x1(x) + be), and
+//                       y = x + bp + conv1x1(relu6(dwconv3x3(e) + bd)). The
+//                       expansion has a ReLU, as the activation kernels have
+//                       no ReLU6.
+//   dnn_encoder_layer:  post-LN Transformer encoder layer with a single head,
+//                       h = layernorm(x + softmax(q k^T) v wo + bo),
+//                       y = layernorm(h + gelu(h w1 + b1) w2 + b2), with
+//                       q = x wq (wq already scaled by 1/sqrt(dim)), k = x wk,
+//                       v = x wv, and the GELU of vmath
+// The glue between the kernels (im2col, transpose_e32 of k, residual
+// additions) is vectorized, and timed as the kernels are. Every kernel is a stage, whose
+// cycles, FLOP, and compulsory bytes (each operand read once, each result
+// written once) are appended to dnn_stages, and which is also a region of
+// common/prof.h with prof=1, for the performance counters.
+// The GEMMs need rows that are a multiple of 16, and an even inner dimension.
+
+#ifndef _DNN_H_
+#define _DNN_H_
+
+#include <stdint.h>
+
+#include "riscv_vector.h"
+
+// Roofline of an FP32 stage, as in scripts/roofline.py: 2 FLOP per FMA, two
+// FP32 FMAs per lane and cycle, and one AXI beat of 32 NR_LANES bits per cycle
+#define DNN_PEAK_FLOP (4 * NR_LANES)
+#define DNN_PEAK_BYTES (4 * NR_LANES)
+
+#define DNN_MAX_STAGES 16
+
+typedef struct {
+  const char *name;
+  uint64_t flop;
+  uint64_t bytes;
+  int64_t cycles;
+} dnn_stage_t;
+
+extern dnn_stage_t dnn_stages[DNN_MAX_STAGES];
+extern uint64_t dnn_nr_stages;
+
+// Regions of the stages, profiled with prof=1, one per block and kind of
+// kernel
+enum dnn_prof_e {
+  DNN_PROF_RESNET_LAYOUT = 0,
+  DNN_PROF_RESNET_GEMM,
+  DNN_PROF_RESNET_ACT,
+  DNN_PROF_RESNET_ADD,
+  DNN_PROF_MBV2_GEMM,
+  DNN_PROF_MBV2_ACT,
+  DNN_PROF_MBV2_DWCONV,
+  DNN_PROF_MBV2_ADD,
+  DNN_PROF_ENC_GEMM,
+  DNN_PROF_ENC_LAYOUT,
+  DNN_PROF_ENC_SOFTMAX,
+  DNN_PROF_ENC_NORM,
+  DNN_PROF_ENC_ACT,
+  DNN_PROF_ENC_ADD
+};
+
+// Name the regions of dnn_prof_e
+void dnn_prof_names();
+
+// Weights [9 C x C] of the taps (ky, kx, c_in) by c_out, and the buffers of
+// the col matrix [H W x 9 C] and of the first convolution [H W x C]
+typedef struct {
+  const float *w1, *b1, *w2, *b2;
+  float *col, *y1;
+} dnn_resnet_t;
+
+// Weights of the expansion [C x t C], of the depthwise convolution [3 x 3 x
+// t C], and of the projection [t C x C], and the buffers of the expanded
+// activations [H W x t C]
+typedef struct {
+  const float *we, *be, *wd, *bd, *wp, *bp;
+  float *e, *d;
+} dnn_mbv2_t;
+
+// Weights [dim x dim] of the attention, [dim x ffn] and [ffn x dim] of the
+// feed-forward network, and the buffers [tokens x dim] of q, k, its transpose,
+// v, the attention, h and the residuals, [tokens x tokens] of the scores, and
+// [tokens x ffn] of the hidden layer
+typedef struct {
+  const float *wq, *wk, *wv, *wo, *bo, *g1, *be1;
+  const float *w1, *b1, *w2, *b2, *g2, *be2;
+  float *q, *k, *kt, *v, *s, *a, *r, *h, *f;
+} dnn_encoder_t;
+
+void dnn_resnet_block(float *y, const float *x, const dnn_resnet_t *p,
+                      uint64_t H, uint64_t W, uint64_t C);
+void dnn_mbv2_block(float *y, const float *x, const dnn_mbv2_t *p, uint64_t H,
+                    uint64_t W, uint64_t C, uint64_t t);
+void dnn_encoder_layer(float *y, const float *x, const dnn_encoder_t *p,
+                       uint64_t tokens, uint64_t dim, uint64_t ffn);
+
+// Glue: the im2col of the 3x3 taps of x [H W x C], with zero padding, into
+// col [H W x 9 C], and y = a + b + bias, with the cols elements of bias added
+// to every row, or no bias if it is NULL
+void dnn_im2col3x3(float *col, const float *x, uint64_t H, uint64_t W,
+                   uint64_t C);
+void dnn_add(float *y, const float *a, const float *b, const float *bias,
+             uint64_t rows, uint64_t cols);
+
+#endif
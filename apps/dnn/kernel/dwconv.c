@@ -0,0 +1 @@
+../../dwconv/kernel/dwconv.c
\ No newline at end of file
@@ -0,0 +1 @@
+../../dwconv/kernel/dwconv.h
\ No newline at end of file
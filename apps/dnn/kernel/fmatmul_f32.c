@@ -0,0 +1 @@
+../../fmatmul_f32/kernel/fmatmul_f32.c
\ No newline at end of file
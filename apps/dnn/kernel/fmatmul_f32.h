@@ -0,0 +1 @@
+../../fmatmul_f32/kernel/fmatmul_f32.h
\ No newline at end of file
@@ -0,0 +1 @@
+../../layernorm/kernel/layernorm.c
\ No newline at end of file
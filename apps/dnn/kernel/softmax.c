@@ -0,0 +1 @@
+../../softmax/kernel/softmax.c
\ No newline at end of file
@@ -0,0 +1 @@
+../../softmax/kernel/softmax.h
\ No newline at end of file
@@ -0,0 +1 @@
+../../transpose/kernel/transpose.c
\ No newline at end of file
@@ -0,0 +1 @@
+../../transpose/kernel/transpose.h
\ No newline at end of file
@@ -0,0 +1,207 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// End-to-end inference blocks, from cold caches: a ResNet basic block and a
+// MobileNetV2 inverted residual on the same H x W x C activations, and a
+// Transformer encoder layer on tokens x dim ones. Each block prints its total
+// cycles, and the cycles, FLOP/cycle, and share of the roofline of each of
+// its kernels, then its cycles once warm, to show what the cold caches and
+// the glue between the kernels cost. The [hw-cycles] of the simulation cover
+// the three cold blocks.
+
+#include <stdint.h>
+#include <string.h>
+
+#include "kernel/dnn.h"
+#include "prof.h"
+#include "runtime.h"
+#include "util.h"
+#include "vcheck.h"
+
+#ifndef SPIKE
+#include "printf.h"
+#else
+#include <stdio.h>
+#endif
+
+// Absolute error of the FP32 outputs against the FP64 golden ones
+#define THRESHOLD 0.001
+
+extern uint64_t H;
+extern uint64_t W;
+extern uint64_t C;
+extern uint64_t t;
+extern uint64_t tokens;
+extern uint64_t dim;
+extern uint64_t ffn;
+
+extern float x_img[] __attribute__((aligned(4 * NR_LANES)));
+extern float rn_w1[] __attribute__((aligned(4 * NR_LANES)));
+extern float rn_b1[] __attribute__((aligned(4 * NR_LANES)));
+extern float rn_w2[] __attribute__((aligned(4 * NR_LANES)));
+extern float rn_b2[] __attribute__((aligned(4 * NR_LANES)));
+extern float rn_col[] __attribute__((aligned(4 * NR_LANES)));
+extern float rn_y1[] __attribute__((aligned(4 * NR_LANES)));
+extern float rn_y[] __attribute__((aligned(4 * NR_LANES)));
+extern float gold_rn_y[] __attribute__((aligned(4 * NR_LANES)));
+
+extern float mb_we[] __attribute__((aligned(4 * NR_LANES)));
+extern float mb_be[] __attribute__((aligned(4 * NR_LANES)));
+extern float mb_wd[] __attribute__((aligned(4 * NR_LANES)));
+extern float mb_bd[] __attribute__((aligned(4 * NR_LANES)));
+extern float mb_wp[] __attribute__((aligned(4 * NR_LANES)));
+extern float mb_bp[] __attribute__((aligned(4 * NR_LANES)));
+extern float mb_e[] __attribute__((aligned(4 * NR_LANES)));
+extern float mb_d[] __attribute__((aligned(4 * NR_LANES)));
+extern float mb_y[] __attribute__((aligned(4 * NR_LANES)));
+extern float gold_mb_y[] __attribute__((aligned(4 * NR_LANES)));
+
+extern float x_tok[] __attribute__((aligned(4 * NR_LANES)));
+extern float en_wq[] __attribute__((aligned(4 * NR_LANES)));
+extern float en_wk[] __attribute__((aligned(4 * NR_LANES)));
+extern float en_wv[] __attribute__((aligned(4 * NR_LANES)));
+extern float en_wo[] __attribute__((aligned(4 * NR_LANES)));
+extern float en_bo[] __attribute__((aligned(4 * NR_LANES)));
+extern float en_g1[] __attribute__((aligned(4 * NR_LANES)));
+extern float en_be1[] __attribute__((aligned(4 * NR_LANES)));
+extern float en_w1[] __attribute__((aligned(4 * NR_LANES)));
+extern float en_b1[] __attribute__((aligned(4 * NR_LANES)));
+extern float en_w2[] __attribute__((aligned(4 * NR_LANES)));
+extern float en_b2[] __attribute__((aligned(4 * NR_LANES)));
+extern float en_g2[] __attribute__((aligned(4 * NR_LANES)));
+extern float en_be2[] __attribute__((aligned(4 * NR_LANES)));
+extern float en_q[] __attribute__((aligned(4 * NR_LANES)));
+extern float en_k[] __attribute__((aligned(4 * NR_LANES)));
+extern float en_kt[] __attribute__((aligned(4 * NR_LANES)));
+extern float en_v[] __attribute__((aligned(4 * NR_LANES)));
+extern float en_s[] __attribute__((aligned(4 * NR_LANES)));
+extern float en_a[] __attribute__((aligned(4 * NR_LANES)));
+extern float en_r[] __attribute__((aligned(4 * NR_LANES)));
+extern float en_h[] __attribute__((aligned(4 * NR_LANES)));
+extern float en_f[] __attribute__((aligned(4 * NR_LANES)));
+extern float en_y[] __attribute__((aligned(4 * NR_LANES)));
+extern float gold_en_y[] __attribute__((aligned(4 * NR_LANES)));
+
+enum { BLOCK_RESNET, BLOCK_MBV2, BLOCK_ENCODER, NR_BLOCKS };
+
+static const char *block_names[NR_BLOCKS] = {"resnet_block", "mbv2_block",
+                                             "encoder_layer"};
+
+static const dnn_resnet_t resnet = {rn_w1, rn_b1, rn_w2, rn_b2, rn_col, rn_y1};
+static const dnn_mbv2_t mbv2 = {mb_we, mb_be, mb_wd, mb_bd,
+                                mb_wp, mb_bp, mb_e, mb_d};
+static const dnn_encoder_t encoder = {
+    en_wq, en_wk, en_wv, en_wo, en_bo, en_g1, en_be1, en_w1, en_b1, en_w2,
+    en_b2, en_g2, en_be2, en_q, en_k, en_kt, en_v, en_s, en_a, en_r,
+    en_h, en_f};
+
+// The stages of the cold run of each block
+static dnn_stage_t cold_stages[NR_BLOCKS][DNN_MAX_STAGES];
+static uint64_t cold_nr_stages[NR_BLOCKS];
+
+static int64_t run(int block) {
+  dnn_nr_stages = 0;
+  start_timer();
+  if (block == BLOCK_RESNET)
+    dnn_resnet_block(rn_y, x_img, &resnet, H, W, C);
+  else if (block == BLOCK_MBV2)
+    dnn_mbv2_block(mb_y, x_img, &mbv2, H, W, C, t);
+  else
+    dnn_encoder_layer(en_y, x_tok, &encoder, tokens, dim, ffn);
+  stop_timer();
+  return get_timer();
+}
+
+// Roofline cycles of a stage: its FLOP at the peak of the FPUs, or its bytes
+// at the bandwidth of the AXI port, whichever takes longer
+static float roof_cycles(const dnn_stage_t *s) {
+  const float compute = (float)s->flop / DNN_PEAK_FLOP;
+  const float memory = (float)s->bytes / DNN_PEAK_BYTES;
+  return compute > memory ? compute : memory;
+}
+
+static void report(int block, int64_t cold, int64_t warm) {
+  const dnn_stage_t *stages = cold_stages[block];
+  uint64_t flop = 0;
+  float roof = 0;
+  int64_t glue = 0;
+
+  printf("%s: %d cycles cold, %d cycles warm.\n", block_names[block], cold,
+         warm);
+  printf("  %-16s %10s %7s %10s %9s\n", "stage", "cycles", "share",
+         "FLOP/cycle", "roofline");
+  for (uint64_t i = 0; i < cold_nr_stages[block]; ++i) {
+    const dnn_stage_t *s = &stages[i];
+    printf("  %-16s %10d %6.1f%% %10.3f %8.1f%%\n", s->name, s->cycles,
+           100.0f * s->cycles / cold, (float)s->flop / s->cycles,
+           100.0f * roof_cycles(s) / s->cycles);
+    flop += s->flop;
+    roof += roof_cycles(s);
+    // The kernels without FLOP reorder the data between the others
+    if (!s->flop)
+      glue += s->cycles;
+  }
+  printf("  %-16s %10d %6.1f%% %10.3f %8.1f%%\n", "total", cold, 100.0f,
+         (float)flop / cold, 100.0f * roof / cold);
+  printf("%s: %f FLOP/cycle, %.1f%% of the roofline, %.1f%% in layout "
+         "changes, %.1f%% lost to the cold caches.\n",
+         block_names[block], (float)flop / cold, 100.0f * roof / cold,
+         100.0f * glue / cold, 100.0f * (cold - warm) / cold);
+}
+
+int main() {
+  printf("\n");
+  printf("=========\n");
+  printf("=  DNN  =\n");
+  printf("=========\n");
+  printf("\n");
+  printf("\n");
+
+  printf("Images %lux%lux%lu (expansion %lu), %lu tokens of %lu (FFN %lu).\n",
+         H, W, C, t, tokens, dim, ffn);
+
+  int64_t cold[NR_BLOCKS], warm[NR_BLOCKS];
+  int error = 0;
+
+  dnn_prof_names();
+
+  // The first run of each block starts from the caches left by the previous
+  // one, as in a network
+  HW_CNT_READY;
+  for (int b = 0; b < NR_BLOCKS; ++b) {
+    cold[b] = run(b);
+    cold_nr_stages[b] = dnn_nr_stages;
+    memcpy(cold_stages[b], dnn_stages, dnn_nr_stages * sizeof(dnn_stage_t));
+  }
+  HW_CNT_NOT_READY;
+
+  // The regions of the cold runs, while the performance counters count
+  PROF_DUMP();
+
+  error |= vcheck_report("resnet_block",
+                         vcheck_f32(rn_y, gold_rn_y, H * W * C, THRESHOLD));
+  error |= vcheck_report("mbv2_block",
+                         vcheck_f32(mb_y, gold_mb_y, H * W * C, THRESHOLD));
+  error |= vcheck_report("encoder_layer",
+                         vcheck_f32(en_y, gold_en_y, tokens * dim, THRESHOLD));
+
+  for (int b = 0; b < NR_BLOCKS; ++b) {
+    warm[b] = run(b);
+    report(b, cold[b], warm[b]);
+  }
+
+  return error;
+}
@@ -0,0 +1,170 @@
+#!/usr/bin/env python3
+# Copyright 2022 ETH Zurich and University of Bologna.
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+# arg1: height and width of the images, arg2: channels, arg3: expansion of
+# the inverted residual, arg4: tokens, arg5: model dimension of the encoder
+# (its FFN is 4x wider). H * W and the tokens must be multiples of 16, the
+# channels and the model dimension even, as the GEMMs of fmatmul_f32 need.
+# The golden outputs are computed in FP64, from the FP32 inputs and weights
+
+import numpy as np
+import os
+import sys
+
+sys.path.insert(0, os.path.join(os.path.dirname(__file__), '../../common/script'))
+from data_emit import emit, golden
+
+def f32(*shape, bound=1.0):
+  return np.random.uniform(-bound, bound, shape).astype(np.float32)
+
+def im2col3x3(x, h, w):
+  # [h w x c] to [h w x 9 c], taps (ky, kx) then channels, zero padded
+  c = x.shape[1]
+  xp = np.pad(x.reshape(h, w, c), ((1, 1), (1, 1), (0, 0)))
+  cols = [xp[ky:ky + h, kx:kx + w, :] for ky in range(3) for kx in range(3)]
+  return np.concatenate(cols, axis=2).reshape(h * w, 9 * c)
+
+def dwconv3x3(x, f, b, h, w):
+  c = x.shape[1]
+  xp = np.pad(x.reshape(h, w, c), ((1, 1), (1, 1), (0, 0)))
+  y = np.zeros((h, w, c)) + b
+  for ky in range(3):
+    for kx in range(3):
+      y += xp[ky:ky + h, kx:kx + w, :] * f[ky, kx]
+  return y.reshape(h * w, c)
+
+def relu(x):
+  return np.maximum(x, 0)
+
+def layernorm(x, g, b):
+  m = x.mean(axis=1, keepdims=True)
+  v = x.var(axis=1, keepdims=True)
+  return (x - m) / np.sqrt(v + 1e-5) * g + b
+
+def softmax(x):
+  e = np.exp(x - x.max(axis=1, keepdims=True))
+  return e / e.sum(axis=1, keepdims=True)
+
+# The tanh approximation of vmath_gelu
+def gelu(x):
+  return 0.5 * x * (1 + np.tanh(np.sqrt(2 / np.pi) * (x + 0.044715 * x ** 3)))
+
+############
+## SCRIPT ##
+############
+
+if len(sys.argv) == 6:
+  hw     = int(sys.argv[1])
+  c      = int(sys.argv[2])
+  t      = int(sys.argv[3])
+  tokens = int(sys.argv[4])
+  dim    = int(sys.argv[5])
+else:
+  print("Error. Give me five arguments: the height and width of the images, the channels, "
+        "the expansion, the tokens, and the model dimension.")
+  sys.exit()
+
+if (hw * hw) % 16 or tokens % 16 or c % 2 or dim % 2:
+  print("Error. The pixels and the tokens must be multiples of 16, and the channels and the "
+        "model dimension even.")
+  sys.exit()
+
+p = hw * hw
+e = t * c
+ffn = 4 * dim
+
+# The initialization of PyTorch, uniform within 1 / sqrt(fan_in)
+x_img = f32(p, c)
+rn_w1, rn_b1 = f32(9 * c, c, bound=1 / np.sqrt(9 * c)), f32(c, bound=1 / np.sqrt(9 * c))
+rn_w2, rn_b2 = f32(9 * c, c, bound=1 / np.sqrt(9 * c)), f32(c, bound=1 / np.sqrt(9 * c))
+mb_we, mb_be = f32(c, e, bound=1 / np.sqrt(c)), f32(e, bound=1 / np.sqrt(c))
+mb_wd, mb_bd = f32(3, 3, e, bound=1 / 3), f32(e, bound=1 / 3)
+mb_wp, mb_bp = f32(e, c, bound=1 / np.sqrt(e)), f32(c, bound=1 / np.sqrt(e))
+
+x_tok = f32(tokens, dim)
+bound = 1 / np.sqrt(dim)
+# The scale of the scores is folded into wq
+en_wq = (f32(dim, dim, bound=bound) / np.float32(np.sqrt(dim))).astype(np.float32)
+en_wk, en_wv, en_wo = f32(dim, dim, bound=bound), f32(dim, dim, bound=bound), f32(dim, dim, bound=bound)
+en_bo = f32(dim, bound=bound)
+en_g1, en_be1 = (1 + f32(dim, bound=0.1)).astype(np.float32), f32(dim, bound=0.1)
+en_w1, en_b1 = f32(dim, ffn, bound=bound), f32(ffn, bound=bound)
+en_w2, en_b2 = f32(ffn, dim, bound=1 / np.sqrt(ffn)), f32(dim, bound=1 / np.sqrt(ffn))
+en_g2, en_be2 = (1 + f32(dim, bound=0.1)).astype(np.float32), f32(dim, bound=0.1)
+
+d = lambda a: a.astype(np.float64)
+
+# ResNet basic block
+y1 = relu(im2col3x3(d(x_img), hw, hw) @ d(rn_w1) + d(rn_b1))
+rn_y = relu(im2col3x3(y1, hw, hw) @ d(rn_w2) + d(rn_b2) + d(x_img))
+
+# MobileNetV2 inverted residual
+me = relu(d(x_img) @ d(mb_we) + d(mb_be))
+md = np.clip(dwconv3x3(me, d(mb_wd), d(mb_bd), hw, hw), 0, 6)
+mb_y = md @ d(mb_wp) + d(mb_bp) + d(x_img)
+
+# Transformer encoder layer
+x = d(x_tok)
+att = softmax((x @ d(en_wq)) @ (x @ d(en_wk)).T) @ (x @ d(en_wv))
+h = layernorm(x + att @ d(en_wo) + d(en_bo), d(en_g1), d(en_be1))
+en_y = layernorm(h + gelu(h @ d(en_w1) + d(en_b1)) @ d(en_w2) + d(en_b2), d(en_g2), d(en_be2))
+
+# Create the file
+print(".section .data,\"aw\",@progbits")
+emit("H", np.array(hw, dtype=np.uint64))
+emit("W", np.array(hw, dtype=np.uint64))
+emit("C", np.array(c, dtype=np.uint64))
+emit("t", np.array(t, dtype=np.uint64))
+emit("tokens", np.array(tokens, dtype=np.uint64))
+emit("dim", np.array(dim, dtype=np.uint64))
+emit("ffn", np.array(ffn, dtype=np.uint64))
+
+emit("x_img", x_img, 'NR_LANES*4')
+emit("rn_w1", rn_w1, 'NR_LANES*4')
+emit("rn_b1", rn_b1, 'NR_LANES*4')
+emit("rn_w2", rn_w2, 'NR_LANES*4')
+emit("rn_b2", rn_b2, 'NR_LANES*4')
+emit("rn_col", np.zeros(p * 9 * c, dtype=np.float32), 'NR_LANES*4')
+emit("rn_y1", np.zeros(p * c, dtype=np.float32), 'NR_LANES*4')
+emit("rn_y", np.zeros(p * c, dtype=np.float32), 'NR_LANES*4')
+emit("gold_rn_y", rn_y.astype(np.float32), 'NR_LANES*4')
+
+emit("mb_we", mb_we, 'NR_LANES*4')
+emit("mb_be", mb_be, 'NR_LANES*4')
+emit("mb_wd", mb_wd, 'NR_LANES*4')
+emit("mb_bd", mb_bd, 'NR_LANES*4')
+emit("mb_wp", mb_wp, 'NR_LANES*4')
+emit("mb_bp", mb_bp, 'NR_LANES*4')
+emit("mb_e", np.zeros(p * e, dtype=np.float32), 'NR_LANES*4')
+emit("mb_d", np.zeros(p * e, dtype=np.float32), 'NR_LANES*4')
+emit("mb_y", np.zeros(p * c, dtype=np.float32), 'NR_LANES*4')
+emit("gold_mb_y", mb_y.astype(np.float32), 'NR_LANES*4')
+
+emit("x_tok", x_tok, 'NR_LANES*4')
+for name, array in [('wq', en_wq), ('wk', en_wk), ('wv', en_wv), ('wo', en_wo), ('bo', en_bo),
+                    ('g1', en_g1), ('be1', en_be1), ('w1', en_w1), ('b1', en_b1), ('w2', en_w2),
+                    ('b2', en_b2), ('g2', en_g2), ('be2', en_be2)]:
+  emit("en_" + name, array, 'NR_LANES*4')
+for name, size in [('q', tokens * dim), ('k', tokens * dim), ('kt', tokens * dim), ('v', tokens * dim),
+                   ('s', tokens * tokens), ('a', tokens * dim), ('r', tokens * dim), ('h', tokens * dim),
+                   ('f', tokens * ffn), ('y', tokens * dim)]:
+  emit("en_" + name, np.zeros(size, dtype=np.float32), 'NR_LANES*4')
+emit("gold_en_y", en_y.astype(np.float32), 'NR_LANES*4')
+
+golden("rn_y", rn_y.astype(np.float32), atol=0.001)
+golden("mb_y", mb_y.astype(np.float32), atol=0.001)
+golden("en_y", en_y.astype(np.float32), atol=0.001)
@@ -18,438 +18,118 @@
 
 #include "dotproduct.h"
 
-int64_t dotp_v64b(int64_t *a, int64_t *b, uint64_t avl) {
-#ifdef INTRINSICS
-
-  size_t orig_avl = avl;
-  size_t vl = vsetvl_e64m8(avl);
-
-  vint64m8_t acc, buf_a, buf_b;
-  vint64m1_t red;
-
-  int64_t *a_ = (int64_t *)a;
-  int64_t *b_ = (int64_t *)b;
-
-  // Clean the accumulator
-  red = vmv_s_x_i64m1(red, 0, vl);
-  // Stripmine and accumulate a partial reduced vector
-  for (; avl > 0; avl -= vl) {
-    vl = vsetvl_e64m8(avl);
-    // Load chunk a and b
-    buf_a = vle64_v_i64m8(a_, vl);
-    buf_b = vle64_v_i64m8(b_, vl);
-    // Multiply and accumulate
-    if (avl == orig_avl) {
-      acc = vmul_vv_i64m8(buf_a, buf_b, vl);
-    } else {
-      acc = vmacc_vv_i64m8(acc, buf_a, buf_b, vl);
-    }
-    // Bump pointers
-    a_ += vl;
-    b_ += vl;
-  }
-
-  // Reduce and return
-  red = vredsum_vs_i64m8_i64m1(red, acc, red, vl);
-  return vmv_x_s_i64m1_i64(red);
-
-#else
-
-  size_t orig_avl = avl;
-  size_t vl;
-  asm volatile("vsetvli %0, %1, e64, m8, ta, ma" : "=r"(vl) : "r"(avl));
-
-  int64_t red;
-
-  int64_t *a_ = (int64_t *)a;
-  int64_t *b_ = (int64_t *)b;
-
-  // Clean the accumulator
-  asm volatile("vmv.s.x v0, zero");
-  // Stripmine and accumulate a partial reduced vector
-  for (; avl > 0; avl -= vl) {
-    asm volatile("vsetvli %0, %1, e64, m8, ta, ma" : "=r"(vl) : "r"(avl));
-    // Load chunk a and b
-    asm volatile("vle64.v v8,  (%0)" ::"r"(a_));
-    asm volatile("vle64.v v16, (%0)" ::"r"(b_));
-    // Multiply and accumulate
-    if (avl == orig_avl) {
-      asm volatile("vmul.vv v24, v8, v16");
-    } else {
-      asm volatile("vmacc.vv v24, v8, v16");
-    }
-    // Bump pointers
-    a_ += vl;
-    b_ += vl;
+/*
+  Vector kernels
+*/
+
+// Multiply-accumulate of a strip of vl elements into acc (dotp_mac_*), and
+// products of the last partial strip in the type of the accumulator
+// (dotp_mul_*). The 64-bit and 32-bit elements are loaded at LMUL 8, and
+// accumulated in their SEW.
+#define DOTP_OPS_NATIVE(sew)                                                   \
+  static inline vint##sew##m8_t dotp_mac_##sew##b(                             \
+      vint##sew##m8_t acc, const int##sew##_t *a, const int##sew##_t *b,       \
+      size_t vl) {                                                             \
+    return vmacc_vv_i##sew##m8(acc, vle##sew##_v_i##sew##m8(a, vl),            \
+                               vle##sew##_v_i##sew##m8(b, vl), vl);            \
+  }                                                                            \
+  static inline vint##sew##m8_t dotp_mul_##sew##b(                             \
+      const int##sew##_t *a, const int##sew##_t *b, size_t vl) {               \
+    return vmul_vv_i##sew##m8(vle##sew##_v_i##sew##m8(a, vl),                  \
+                              vle##sew##_v_i##sew##m8(b, vl), vl);             \
   }
 
-  // Reduce and return
-  asm volatile("vredsum.vs v0, v24, v0");
-  asm volatile("vmv.x.s %0, v0" : "=r"(red));
-  return red;
-
-#endif
-}
-
-int32_t dotp_v32b(int32_t *a, int32_t *b, uint64_t avl) {
-#ifdef INTRINSICS
-
-  size_t orig_avl = avl;
-  size_t vl = vsetvl_e32m8(avl);
-
-  vint32m8_t acc, buf_a, buf_b;
-  vint32m1_t red;
-
-  int32_t *a_ = (int32_t *)a;
-  int32_t *b_ = (int32_t *)b;
-
-  // Clean the accumulator
-  red = vmv_s_x_i32m1(red, 0, vl);
-  // Stripmine and accumulate a partial reduced vector
-  for (; avl > 0; avl -= vl) {
-    vl = vsetvl_e32m8(avl);
-    // Load chunk a and b
-    buf_a = vle32_v_i32m8(a_, vl);
-    buf_b = vle32_v_i32m8(b_, vl);
-    // Multiply and accumulate
-    if (avl == orig_avl) {
-      acc = vmul_vv_i32m8(buf_a, buf_b, vl);
-    } else {
-      acc = vmacc_vv_i32m8(acc, buf_a, buf_b, vl);
-    }
-    // Bump pointers
-    a_ += vl;
-    b_ += vl;
-  }
-
-  // Reduce and return
-  red = vredsum_vs_i32m8_i32m1(red, acc, red, vl);
-  return vmv_x_s_i32m1_i32(red);
-
-#else
-
-  size_t orig_avl = avl;
-  size_t vl;
-  asm volatile("vsetvli %0, %1, e32, m8, ta, ma" : "=r"(vl) : "r"(avl));
-
-  int32_t red;
-
-  int32_t *a_ = (int32_t *)a;
-  int32_t *b_ = (int32_t *)b;
-
-  // Clean the accumulator
-  asm volatile("vmv.s.x v0, zero");
-  // Stripmine and accumulate a partial reduced vector
-  for (; avl > 0; avl -= vl) {
-    asm volatile("vsetvli %0, %1, e32, m8, ta, ma" : "=r"(vl) : "r"(avl));
-    // Load chunk a and b
-    asm volatile("vle32.v v8,  (%0)" ::"r"(a_));
-    asm volatile("vle32.v v16, (%0)" ::"r"(b_));
-    // Multiply and accumulate
-    if (avl == orig_avl) {
-      asm volatile("vmul.vv v24, v8, v16");
-    } else {
-      asm volatile("vmacc.vv v24, v8, v16");
-    }
-    // Bump pointers
-    a_ += vl;
-    b_ += vl;
+// The 16-bit and 8-bit elements are loaded at LMUL 2: vwmul computes the exact
+// products in psew = 2 * sew, and vwadd.wv accumulates them at LMUL 8 in
+// asew = 4 * sew
+#define DOTP_OPS_WIDE(sew, psew, asew)                                         \
+  static inline vint##asew##m8_t dotp_mac_##sew##b(                            \
+      vint##asew##m8_t acc, const int##sew##_t *a, const int##sew##_t *b,      \
+      size_t vl) {                                                             \
+    return vwadd_wv_i##asew##m8(                                               \
+        acc,                                                                   \
+        vwmul_vv_i##psew##m4(vle##sew##_v_i##sew##m2(a, vl),                   \
+                             vle##sew##_v_i##sew##m2(b, vl), vl),              \
+        vl);                                                                   \
+  }                                                                            \
+  static inline vint##asew##m8_t dotp_mul_##sew##b(                            \
+      const int##sew##_t *a, const int##sew##_t *b, size_t vl) {               \
+    return vwadd_vx_i##asew##m8(                                               \
+        vwmul_vv_i##psew##m4(vle##sew##_v_i##sew##m2(a, vl),                   \
+                             vle##sew##_v_i##sew##m2(b, vl), vl),              \
+        0, vl);                                                                \
   }
 
-  // Reduce and return
-  asm volatile("vredsum.vs v0, v24, v0");
-  asm volatile("vmv.x.s %0, v0" : "=r"(red));
-  return red;
-
-#endif
-}
-
-int16_t dotp_v16b(int16_t *a, int16_t *b, uint64_t avl) {
-#ifdef INTRINSICS
-
-  size_t orig_avl = avl;
-  size_t vl = vsetvl_e16m8(avl);
-
-  vint16m8_t acc, buf_a, buf_b;
-  vint16m1_t red;
-
-  int16_t *a_ = (int16_t *)a;
-  int16_t *b_ = (int16_t *)b;
-
-  // Clean the accumulator
-  red = vmv_s_x_i16m1(red, 0, vl);
-  // Stripmine and accumulate a partial reduced vector
-  for (; avl > 0; avl -= vl) {
-    vl = vsetvl_e16m8(avl);
-    // Load chunk a and b
-    buf_a = vle16_v_i16m8(a_, vl);
-    buf_b = vle16_v_i16m8(b_, vl);
-    // Multiply and accumulate
-    if (avl == orig_avl) {
-      acc = vmul_vv_i16m8(buf_a, buf_b, vl);
-    } else {
-      acc = vmacc_vv_i16m8(acc, buf_a, buf_b, vl);
-    }
-    // Bump pointers
-    a_ += vl;
-    b_ += vl;
+// Dot product of sew-bit elements, accumulated in asew bits and returned in
+// rsew bits. The full strips accumulate element-wise in two register groups,
+// on alternate strips, so that a MAC does not wait for the previous one. The
+// two groups are added and reduced once at the end with REDSUM, and the last
+// partial strip is reduced on its own, so that no accumulator depends on the
+// tail policy.
+#define DOTP_V(sew, asew, rsew, REDSUM)                                        \
+  int##rsew##_t dotp_v##sew##b(const int##sew##_t *a, const int##sew##_t *b,   \
+                               uint64_t avl) {                                 \
+    const size_t vlmax = vsetvlmax_e##asew##m8();                              \
+    vint##rsew##m1_t red = vmv_v_x_i##rsew##m1(0, 1);                          \
+    uint64_t i = 0;                                                            \
+                                                                               \
+    if (avl >= vlmax) {                                                        \
+      vint##asew##m8_t acc0 = vmv_v_x_i##asew##m8(0, vlmax);                   \
+      vint##asew##m8_t acc1 = vmv_v_x_i##asew##m8(0, vlmax);                   \
+      for (; i + 2 * vlmax <= avl; i += 2 * vlmax) {                           \
+        acc0 = dotp_mac_##sew##b(acc0, a + i, b + i, vlmax);                   \
+        acc1 = dotp_mac_##sew##b(acc1, a + i + vlmax, b + i + vlmax, vlmax);   \
+      }                                                                        \
+      if (i + vlmax <= avl) {                                                  \
+        acc0 = dotp_mac_##sew##b(acc0, a + i, b + i, vlmax);                   \
+        i += vlmax;                                                            \
+      }                                                                        \
+      acc0 = vadd_vv_i##asew##m8(acc0, acc1, vlmax);                           \
+      red = REDSUM(red, acc0, red, vlmax);                                     \
+    }                                                                          \
+                                                                               \
+    if (i < avl) {                                                             \
+      const size_t vl = vsetvl_e##asew##m8(avl - i);                           \
+      red = REDSUM(red, dotp_mul_##sew##b(a + i, b + i, vl), red, vl);         \
+    }                                                                          \
+                                                                               \
+    return vmv_x_s_i##rsew##m1_i##rsew(red);                                   \
   }
 
-  // Reduce and store
-  red = vredsum_vs_i16m8_i16m1(red, acc, red, vl);
-  return vmv_x_s_i16m1_i16(red);
-
-#else
-
-  size_t orig_avl = avl;
-  size_t vl;
-  asm volatile("vsetvli %0, %1, e16, m8, ta, ma" : "=r"(vl) : "r"(avl));
-
-  int16_t red;
-
-  int16_t *a_ = (int16_t *)a;
-  int16_t *b_ = (int16_t *)b;
-
-  // Clean the accumulator
-  asm volatile("vmv.s.x v0, zero");
-  // Stripmine and accumulate a partial reduced vector
-  for (; avl > 0; avl -= vl) {
-    asm volatile("vsetvli %0, %1, e16, m8, ta, ma" : "=r"(vl) : "r"(avl));
-    // Load chunk a and b
-    asm volatile("vle16.v v8,  (%0)" ::"r"(a_));
-    asm volatile("vle16.v v16, (%0)" ::"r"(b_));
-    // Multiply and accumulate
-    if (avl == orig_avl) {
-      asm volatile("vmul.vv v24, v8, v16");
-    } else {
-      asm volatile("vmacc.vv v24, v8, v16");
-    }
-    // Bump pointers
-    a_ += vl;
-    b_ += vl;
+DOTP_OPS_NATIVE(64)
+DOTP_OPS_NATIVE(32)
+DOTP_OPS_WIDE(16, 32, 64)
+DOTP_OPS_WIDE(8, 16, 32)
+
+DOTP_V(64, 64, 64, vredsum_vs_i64m8_i64m1)
+DOTP_V(32, 32, 32, vredsum_vs_i32m8_i32m1)
+DOTP_V(16, 64, 64, vredsum_vs_i64m8_i64m1)
+// The 32-bit partial sums are reduced in 64 bits
+DOTP_V(8, 32, 64, vwredsum_vs_i32m8_i64m1)
+
+/*
+  Scalar kernels
+*/
+
+// Eight independent accumulators of rsew bits. The products of the 16-bit and
+// 8-bit elements are exact in rsew bits.
+#define DOTP_S(sew, rsew)                                                      \
+  int##rsew##_t dotp_s##sew##b(const int##sew##_t *a, const int##sew##_t *b,   \
+                               uint64_t avl) {                                 \
+    int##rsew##_t acc[8] = {0};                                                \
+    uint64_t i = 0;                                                            \
+                                                                               \
+    for (; i + 8 <= avl; i += 8)                                               \
+      for (int k = 0; k < 8; ++k)                                              \
+        acc[k] += (int##rsew##_t)a[i + k] * b[i + k];                          \
+    for (; i < avl; ++i)                                                       \
+      acc[0] += (int##rsew##_t)a[i] * b[i];                                    \
+                                                                               \
+    return ((acc[0] + acc[1]) + (acc[2] + acc[3])) +                           \
+           ((acc[4] + acc[5]) + (acc[6] + acc[7]));                            \
   }
 
-  // Reduce and return
-  asm volatile("vredsum.vs v0, v24, v0");
-  asm volatile("vmv.x.s %0, v0" : "=r"(red));
-  return red;
-
-#endif
-}
-
-int8_t dotp_v8b(int8_t *a, int8_t *b, uint64_t avl) {
-#ifdef INTRINSICS
-
-  size_t orig_avl = avl;
-  size_t vl = vsetvl_e8m8(avl);
-
-  vint8m8_t acc, buf_a, buf_b;
-  vint8m1_t red;
-
-  int8_t *a_ = (int8_t *)a;
-  int8_t *b_ = (int8_t *)b;
-
-  // Clean the accumulator
-  red = vmv_s_x_i8m1(red, 0, vl);
-  // Stripmine and accumulate a partial reduced vector
-  for (; avl > 0; avl -= vl) {
-    vl = vsetvl_e8m8(avl);
-    // Load chunk a and b
-    buf_a = vle8_v_i8m8(a_, vl);
-    buf_b = vle8_v_i8m8(b_, vl);
-    // Multiply and accumulate
-    if (avl == orig_avl) {
-      acc = vmul_vv_i8m8(buf_a, buf_b, vl);
-    } else {
-      acc = vmacc_vv_i8m8(acc, buf_a, buf_b, vl);
-    }
-    // Bump pointers
-    a_ += vl;
-    b_ += vl;
-  }
-
-  // Reduce and store
-  red = vredsum_vs_i8m8_i8m1(red, acc, red, vl);
-  return vmv_x_s_i8m1_i8(red);
-
-#else
-
-  size_t orig_avl = avl;
-  size_t vl;
-  asm volatile("vsetvli %0, %1, e8, m8, ta, ma" : "=r"(vl) : "r"(avl));
-
-  int8_t red;
-
-  int8_t *a_ = (int8_t *)a;
-  int8_t *b_ = (int8_t *)b;
-
-  // Clean the accumulator
-  asm volatile("vmv.s.x v0, zero");
-  // Stripmine and accumulate a partial reduced vector
-  for (; avl > 0; avl -= vl) {
-    asm volatile("vsetvli %0, %1, e8, m8, ta, ma" : "=r"(vl) : "r"(avl));
-    // Load chunk a and b
-    asm volatile("vle8.v v8,  (%0)" ::"r"(a_));
-    asm volatile("vle8.v v16, (%0)" ::"r"(b_));
-    // Multiply and accumulate
-    if (avl == orig_avl) {
-      asm volatile("vmul.vv v24, v8, v16");
-    } else {
-      asm volatile("vmacc.vv v24, v8, v16");
-    }
-    // Bump pointers
-    a_ += vl;
-    b_ += vl;
-  }
-
-  // Reduce and return
-  asm volatile("vredsum.vs v0, v24, v0");
-  asm volatile("vmv.x.s %0, v0" : "=r"(red));
-  return red;
-
-#endif
-}
-
-int64_t dotp_s64b(int64_t *a, int64_t *b, uint64_t avl) {
-  int64_t acc0, acc1, acc2, acc3, acc4, acc5, acc6, acc7;
-
-  acc0 = 0;
-  acc1 = 0;
-  acc2 = 0;
-  acc3 = 0;
-  acc4 = 0;
-  acc5 = 0;
-  acc6 = 0;
-  acc7 = 0;
-
-  for (uint64_t i = 0; i < avl; i += 8) {
-    acc0 += a[i + 0] * b[i + 0];
-    acc1 += a[i + 1] * b[i + 1];
-    acc2 += a[i + 2] * b[i + 2];
-    acc3 += a[i + 3] * b[i + 3];
-    acc4 += a[i + 4] * b[i + 4];
-    acc5 += a[i + 5] * b[i + 5];
-    acc6 += a[i + 6] * b[i + 6];
-    acc7 += a[i + 7] * b[i + 7];
-  }
-
-  acc0 += acc1;
-  acc2 += acc3;
-  acc4 += acc5;
-  acc6 += acc7;
-
-  acc0 += acc2;
-  acc4 += acc6;
-
-  acc0 += acc4;
-
-  return acc0;
-}
-
-int32_t dotp_s32b(int32_t *a, int32_t *b, uint64_t avl) {
-  int32_t acc0, acc1, acc2, acc3, acc4, acc5, acc6, acc7;
-
-  acc0 = 0;
-  acc1 = 0;
-  acc2 = 0;
-  acc3 = 0;
-  acc4 = 0;
-  acc5 = 0;
-  acc6 = 0;
-  acc7 = 0;
-
-  for (uint64_t i = 0; i < avl; i += 8) {
-    acc0 += a[i + 0] * b[i + 0];
-    acc1 += a[i + 1] * b[i + 1];
-    acc2 += a[i + 2] * b[i + 2];
-    acc3 += a[i + 3] * b[i + 3];
-    acc4 += a[i + 4] * b[i + 4];
-    acc5 += a[i + 5] * b[i + 5];
-    acc6 += a[i + 6] * b[i + 6];
-    acc7 += a[i + 7] * b[i + 7];
-  }
-
-  acc0 += acc1;
-  acc2 += acc3;
-  acc4 += acc5;
-  acc6 += acc7;
-
-  acc0 += acc2;
-  acc4 += acc6;
-
-  acc0 += acc4;
-
-  return acc0;
-}
-
-int16_t dotp_s16b(int16_t *a, int16_t *b, uint64_t avl) {
-  int16_t acc0, acc1, acc2, acc3, acc4, acc5, acc6, acc7;
-
-  acc0 = 0;
-  acc1 = 0;
-  acc2 = 0;
-  acc3 = 0;
-  acc4 = 0;
-  acc5 = 0;
-  acc6 = 0;
-  acc7 = 0;
-
-  for (uint64_t i = 0; i < avl; i += 8) {
-    acc0 += a[i + 0] * b[i + 0];
-    acc1 += a[i + 1] * b[i + 1];
-    acc2 += a[i + 2] * b[i + 2];
-    acc3 += a[i + 3] * b[i + 3];
-    acc4 += a[i + 4] * b[i + 4];
-    acc5 += a[i + 5] * b[i + 5];
-    acc6 += a[i + 6] * b[i + 6];
-    acc7 += a[i + 7] * b[i + 7];
-  }
-
-  acc0 += acc1;
-  acc2 += acc3;
-  acc4 += acc5;
-  acc6 += acc7;
-
-  acc0 += acc2;
-  acc4 += acc6;
-
-  acc0 += acc4;
-
-  return acc0;
-}
-
-int8_t dotp_s8b(int8_t *a, int8_t *b, uint64_t avl) {
-  int8_t acc0, acc1, acc2, acc3, acc4, acc5, acc6, acc7;
-
-  acc0 = 0;
-  acc1 = 0;
-  acc2 = 0;
-  acc3 = 0;
-  acc4 = 0;
-  acc5 = 0;
-  acc6 = 0;
-  acc7 = 0;
-
-  for (uint64_t i = 0; i < avl; i += 8) {
-    acc0 += a[i + 0] * b[i + 0];
-    acc1 += a[i + 1] * b[i + 1];
-    acc2 += a[i + 2] * b[i + 2];
-    acc3 += a[i + 3] * b[i + 3];
-    acc4 += a[i + 4] * b[i + 4];
-    acc5 += a[i + 5] * b[i + 5];
-    acc6 += a[i + 6] * b[i + 6];
-    acc7 += a[i + 7] * b[i + 7];
-  }
-
-  acc0 += acc1;
-  acc2 += acc3;
-  acc4 += acc5;
-  acc6 += acc7;
-
-  acc0 += acc2;
-  acc4 += acc6;
-
-  acc0 += acc4;
-
-  return acc0;
-}
+DOTP_S(64, 64)
+DOTP_S(32, 32)
+DOTP_S(16, 64)
+DOTP_S(8, 64)
@@ -24,14 +24,19 @@
 
 #include <riscv_vector.h>
 
-int64_t dotp_v64b(int64_t *a, int64_t *b, uint64_t avl);
-int32_t dotp_v32b(int32_t *a, int32_t *b, uint64_t avl);
-int16_t dotp_v16b(int16_t *a, int16_t *b, uint64_t avl);
-int8_t dotp_v8b(int8_t *a, int8_t *b, uint64_t avl);
+// Dot products of a and b, with avl elements. The 64-bit and 32-bit ones wrap
+// around in their SEW. The 16-bit and 8-bit ones are accumulated and returned
+// in 64 bits: the vector kernels accumulate the 8-bit products in 32-bit
+// partial sums of avl / VLMAX(32, 8) products each, which do not overflow up
+// to avl = 2^17 * VLMAX(32, 8).
+int64_t dotp_v64b(const int64_t *a, const int64_t *b, uint64_t avl);
+int32_t dotp_v32b(const int32_t *a, const int32_t *b, uint64_t avl);
+int64_t dotp_v16b(const int16_t *a, const int16_t *b, uint64_t avl);
+int64_t dotp_v8b(const int8_t *a, const int8_t *b, uint64_t avl);
 
-int64_t dotp_s64b(int64_t *a, int64_t *b, uint64_t avl);
-int32_t dotp_s32b(int32_t *a, int32_t *b, uint64_t avl);
-int16_t dotp_s16b(int16_t *a, int16_t *b, uint64_t avl);
-int8_t dotp_s8b(int8_t *a, int8_t *b, uint64_t avl);
+int64_t dotp_s64b(const int64_t *a, const int64_t *b, uint64_t avl);
+int32_t dotp_s32b(const int32_t *a, const int32_t *b, uint64_t avl);
+int64_t dotp_s16b(const int16_t *a, const int16_t *b, uint64_t avl);
+int64_t dotp_s8b(const int8_t *a, const int8_t *b, uint64_t avl);
 
 #endif
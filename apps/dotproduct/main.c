@@ -49,8 +49,8 @@ extern int8_t v8b[] __attribute__((aligned(32 * NR_LANES), section(".l2")));
 // Output vectors
 extern int64_t res64_v, res64_s;
 extern int32_t res32_v, res32_s;
-extern int16_t res16_v, res16_s;
-extern int8_t res8_v, res8_s;
+extern int64_t res16_v, res16_s;
+extern int64_t res8_v, res8_s;
 
 int main() {
   printf("\n");
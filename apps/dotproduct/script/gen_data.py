@@ -18,20 +18,11 @@
 # arg: #elements per vector
 
 import numpy as np
-import random
-from functools import reduce
+import os
 import sys
 
-def emit(name, array, alignment='8'):
-  print(".global %s" % name)
-  print(".balign " + alignment)
-  print("%s:" % name)
-  bs = array.tobytes()
-  for i in range(0, len(bs), 4):
-    s = ""
-    for n in range(4):
-      s += "%02x" % bs[i+3-n]
-    print("    .word 0x%s" % s)
+sys.path.insert(0, os.path.join(os.path.dirname(__file__), '../../common/script'))
+from data_emit import emit
 
 # Vector length
 if len(sys.argv) > 1:
@@ -50,18 +41,11 @@ v64a = np.random.randint(-2**(50), high=2**(50)-1, size=avl64, dtype=np.int64)
 v64b = np.random.randint(-2**(50), high=2**(50)-1, size=avl64, dtype=np.int64)
 v32a = np.random.randint(-2**(20), high=2**(20)-1, size=avl32, dtype=np.int32)
 v32b = np.random.randint(-2**(20), high=2**(20)-1, size=avl32, dtype=np.int32)
-v16a = np.random.randint(-2**(10), high=2**(10)-1, size=avl16, dtype=np.int16)
-v16b = np.random.randint(-2**(10), high=2**(10)-1, size=avl16, dtype=np.int16)
-v8a  = np.random.randint( -2**(2), high=2**(2)-1,  size=avl8,  dtype=np.int8)
-v8b  = np.random.randint( -2**(2), high=2**(2)-1,  size=avl8,  dtype=np.int8)
-
-# Create the golden output
-gold64 = reduce(lambda a, b: a+b, np.multiply(v64a, v64b))
-gold32 = reduce(lambda a, b: a+b, np.multiply(v32a, v32b))
-gold16 = reduce(lambda a, b: a+b, np.multiply(v16a, v16b))
-gold16 = np.array([gold16, gold16])
-gold8  = reduce(lambda a, b: a+b, np.multiply(v8a, v8b))
-gold8  = np.array([gold8, gold8, gold8, gold8])
+# The 16-bit and 8-bit dot products are accumulated in 64 bits: full range
+v16a = np.random.randint(-2**(15), high=2**(15)-1, size=avl16, dtype=np.int16)
+v16b = np.random.randint(-2**(15), high=2**(15)-1, size=avl16, dtype=np.int16)
+v8a  = np.random.randint( -2**(7), high=2**(7)-1,  size=avl8,  dtype=np.int8)
+v8b  = np.random.randint( -2**(7), high=2**(7)-1,  size=avl8,  dtype=np.int8)
 
 # Create the empty result vectors
 res64 = 0
@@ -80,15 +64,11 @@ emit("v16a", v16a, 'NR_LANES*4')
 emit("v16b", v16b, 'NR_LANES*4')
 emit("v8a",  v8a,  'NR_LANES*4')
 emit("v8b",  v8b,  'NR_LANES*4')
-#emit("gold64", np.array(gold64, dtype=np.int64));
-#emit("gold32", np.array(gold32, dtype=np.int32));
-#emit("gold16", gold16, 'NR_LANES*4');
-#emit("gold8",  gold8,  'NR_LANES*4');
 emit("res64_v", np.array(res64, dtype=np.int64));
 emit("res32_v", np.array(res32, dtype=np.int32));
-emit("res16_v", np.array(res16, dtype=np.int32));
-emit("res8_v",  np.array(res8, dtype=np.int32));
+emit("res16_v", np.array(res16, dtype=np.int64));
+emit("res8_v",  np.array(res8, dtype=np.int64));
 emit("res64_s", np.array(res64, dtype=np.int64));
 emit("res32_s", np.array(res32, dtype=np.int32));
-emit("res16_s", np.array(res16, dtype=np.int32));
-emit("res8_s",  np.array(res8, dtype=np.int32));
+emit("res16_s", np.array(res16, dtype=np.int64));
+emit("res8_s",  np.array(res8, dtype=np.int64));
@@ -95,3 +95,44 @@ void dropout_vec(const unsigned int n, const float *i, const float scale,
 #endif
 }
 #endif
+
+// Scalar dropout, with the mask generated at runtime
+void dropout_gold_rng(const unsigned int n, const float *i, const float scale,
+                      const uint32_t threshold, const uint32_t seed, float *o) {
+  for (unsigned int k = 0; k < n; ++k)
+    o[k] = (vrand_scalar(seed, k) < threshold) ? (i[k] * scale) : 0;
+}
+
+// The mask is generated in the registers, and never touches the memory
+void dropout_vec_rng(const unsigned int n, const float *i, const float scale,
+                     const uint32_t threshold, const uint32_t seed, float *o) {
+  unsigned int vl;
+
+  vuint32m8_t vr;
+  vfloat32m8_t vi, vo;
+  vbool4_t vsel_m;
+
+#ifdef VCD_DUMP
+  // Start dumping VCD
+  event_trigger = +1;
+#endif
+
+  for (unsigned int k = 0, avl = n; avl > 0; avl -= vl, k += vl) {
+    vl = vsetvl_e32m8(avl);
+    // Generate the mask vector (1 = keep, 0 = drop)
+    vr = vrand_u32m8(seed, k, vl);
+    vsel_m = vmsltu_vx_u32m8_b4(vr, threshold, vl);
+    // Initialize output vector with zeroes
+    vo = vfmv_v_f_f32m8((float)0, vl);
+    // Load input vector
+    vi = vle32_v_f32m8(&i[k], vl);
+    // Calculate output vector
+    vo = vfmul_vf_f32m8_m(vsel_m, vo, vi, scale, vl);
+    vse32_v_f32m8(&o[k], vo, vl);
+  }
+
+#ifdef VCD_DUMP
+  // Stop dumping VCD
+  event_trigger = -1;
+#endif
+}
@@ -28,6 +28,7 @@
 #undef INTRINSICS
 
 #include "runtime.h"
+#include "vrand/vrand.h"
 
 #ifndef SPIKE
 #include "printf.h"
@@ -38,4 +39,11 @@ void dropout_gold(const unsigned int n, const float *i, const float scale,
 void dropout_vec(const unsigned int n, const float *i, const float scale,
                  const uint8_t *sel_ptr, float *o);
 
+// Keep element k if vrand_scalar(seed, k) < threshold, i.e., with probability
+// threshold / 2^32
+void dropout_gold_rng(const unsigned int n, const float *i, const float scale,
+                      const uint32_t threshold, const uint32_t seed, float *o);
+void dropout_vec_rng(const unsigned int n, const float *i, const float scale,
+                     const uint32_t threshold, const uint32_t seed, float *o);
+
 #endif
@@ -27,6 +27,8 @@ extern const unsigned int N;
 extern const float SCALE;
 extern const float I[] __attribute__((aligned(4 * NR_LANES)));
 extern const uint8_t SEL[] __attribute__((aligned(4 * NR_LANES)));
+extern const uint32_t THRESHOLD;
+extern const uint32_t SEED;
 extern float o[] __attribute__((aligned(4 * NR_LANES)));
 extern float o_gold[] __attribute__((aligned(4 * NR_LANES)));
 
@@ -70,5 +72,24 @@ int main() {
   }
   printf("Passed.\n");
 
+  // Generate the mask at runtime
+  printf("Running Dropout with a runtime mask, threshold %u, seed %u.\n",
+         THRESHOLD, SEED);
+  start_timer();
+  dropout_vec_rng(N, I, SCALE, THRESHOLD, SEED, o);
+  stop_timer();
+  runtime = get_timer();
+  printf("The execution took %d cycles.\n", runtime);
+
+  dropout_gold_rng(N, I, SCALE, THRESHOLD, SEED, o_gold);
+
+  for (unsigned int k = 0; k < N; ++k) {
+    if (o[k] != o_gold[k]) {
+      printf("Error: o[%d] = %f != %f\n", k, o[k], o_gold[k]);
+      return k ? k : -1;
+    }
+  }
+  printf("Passed.\n");
+
   return 0;
 }
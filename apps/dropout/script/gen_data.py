@@ -19,6 +19,7 @@
 
 import numpy as np
 import random
+import os
 import sys
 
 def rand_array(N, dtype):
@@ -27,16 +28,8 @@ def rand_array(N, dtype):
 def rand_sel(N, dtype):
   return np.random.randint(0, 256, N, dtype)
 
-def emit(name, array, alignment='8'):
-	print(".global %s" % name)
-	print(".balign " + alignment)
-	print("%s:" % name)
-	bs = array.tobytes()
-	for i in range(0, len(bs), 4):
-		s = ""
-		for n in range(4):
-			s += "%02x" % bs[i+3-n]
-		print("    .word 0x%s" % s)
+sys.path.insert(0, os.path.join(os.path.dirname(__file__), '../../common/script'))
+from data_emit import emit
 
 if len(sys.argv) > 1:
   N = int(sys.argv[1])
@@ -47,6 +40,9 @@ else:
 I     = rand_array(N, np.float32)
 SCALE = rand_array(1, np.float32)[0]
 SEL   = rand_sel(N, np.uint8)
+# Keep probability of the runtime mask is THRESHOLD / 2^32
+THRESHOLD = np.random.randint(0, 2**32, dtype=np.uint64)
+SEED      = np.random.randint(0, 2**32, dtype=np.uint64)
 
 # Create the empty o matrix
 o = np.zeros(N).astype(np.float32)
@@ -58,5 +54,7 @@ emit("N", np.array(N, dtype=np.uint64))
 emit("SCALE", np.array(SCALE, dtype=np.float32))
 emit("I", I, 'NR_LANES*4')
 emit("SEL", SEL, 'NR_LANES*4')
+emit("THRESHOLD", np.array(THRESHOLD, dtype=np.uint32))
+emit("SEED", np.array(SEED, dtype=np.uint32))
 emit("o", o, 'NR_LANES*4')
 emit("o_gold", o_gold, 'NR_LANES*4')
@@ -0,0 +1,216 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dwconv.h"
+#include "riscv_vector.h"
+
+// Each input row (NCHW) or column (NHWC) is loaded once, and added to the
+// accumulators of all the output rows (columns) that use it: with stride 1,
+// row y is the bottom row of output y - 1, the middle one of output y, and
+// the top one of output y + 1, which are in flight together; with stride 2,
+// the odd rows are shared by two outputs, and the even ones are used by one.
+// The top and bottom padding rows add nothing.
+
+static inline vfloat32m2_t dw_relu6_m2(vfloat32m2_t v, int relu6, size_t vl) {
+  return relu6 ? vfmin_vf_f32m2(vfmax_vf_f32m2(v, 0, vl), 6, vl) : v;
+}
+
+static inline vfloat32m1_t dw_relu6_m1(vfloat32m1_t v, int relu6, size_t vl) {
+  return relu6 ? vfmin_vf_f32m1(vfmax_vf_f32m1(v, 0, vl), 6, vl) : v;
+}
+
+/*
+  NCHW
+*/
+
+// One filter row w on the left, middle, and right inputs of a row
+static inline vfloat32m2_t dw_row(vfloat32m2_t acc, const float *w,
+                                  vfloat32m2_t xl, vfloat32m2_t xc,
+                                  vfloat32m2_t xr, size_t vl) {
+  acc = vfmacc_vf_f32m2(acc, w[0], xl, vl);
+  acc = vfmacc_vf_f32m2(acc, w[1], xc, vl);
+  return vfmacc_vf_f32m2(acc, w[2], xr, vl);
+}
+
+// Stride 1, as fconv2d_3x3: the left and right inputs are the row slid by one
+// element, with the neighbors of the strip, or the padding, slid in
+static void dwconv3x3_nchw_s1(float *o, const float *i, const float *f,
+                              float b, unsigned long int H,
+                              unsigned long int W, int relu6) {
+  size_t vl;
+  for (unsigned long int x0 = 0; x0 < W; x0 += vl) {
+    vl = vsetvl_e32m2(W - x0);
+    vfloat32m2_t bias = vfmv_v_f_f32m2(b, vl);
+    vfloat32m2_t prev = bias, cur = bias, next = bias;
+
+    for (unsigned long int y = 0; y < H; ++y) {
+      const float *row = i + y * W;
+      vfloat32m2_t xc = vle32_v_f32m2(row + x0, vl);
+      vfloat32m2_t xl = vfslide1up_vf_f32m2(xc, x0 ? row[x0 - 1] : 0, vl);
+      vfloat32m2_t xr =
+          vfslide1down_vf_f32m2(xc, x0 + vl < W ? row[x0 + vl] : 0, vl);
+
+      if (y) {
+        prev = dw_row(prev, f + 6, xl, xc, xr, vl);
+        vse32_v_f32m2(o + (y - 1) * W + x0, dw_relu6_m2(prev, relu6, vl), vl);
+      }
+      prev = dw_row(cur, f + 3, xl, xc, xr, vl);
+      cur = dw_row(next, f, xl, xc, xr, vl);
+      next = bias;
+    }
+    vse32_v_f32m2(o + (H - 1) * W + x0, dw_relu6_m2(prev, relu6, vl), vl);
+  }
+}
+
+// Stride 2: the middle inputs are the even elements, the right ones the odd
+// elements, and the left ones the odd elements slid by one. The last odd
+// element is padding if W is odd
+static inline void dw_row_s2(const float *row, unsigned long int x0,
+                             unsigned long int W, size_t vl,
+                             vfloat32m2_t *xl, vfloat32m2_t *xc,
+                             vfloat32m2_t *xr) {
+  const unsigned long int odd = W / 2 > x0 ? W / 2 - x0 : 0;
+  *xc = vlse32_v_f32m2(row + 2 * x0, 2 * sizeof(float), vl);
+  if (odd >= vl) {
+    *xr = vlse32_v_f32m2(row + 2 * x0 + 1, 2 * sizeof(float), vl);
+  } else {
+    vbool16_t valid = vmsltu_vx_u32m2_b16(vid_v_u32m2(vl), odd, vl);
+    *xr = vlse32_v_f32m2_m(valid, vfmv_v_f_f32m2(0, vl), row + 2 * x0 + 1,
+                           2 * sizeof(float), vl);
+  }
+  *xl = vfslide1up_vf_f32m2(*xr, x0 ? row[2 * x0 - 1] : 0, vl);
+}
+
+static void dwconv3x3_nchw_s2(float *o, const float *i, const float *f,
+                              float b, unsigned long int H,
+                              unsigned long int W, int relu6) {
+  const unsigned long int Ho = (H - 1) / 2 + 1;
+  const unsigned long int Wo = (W - 1) / 2 + 1;
+  vfloat32m2_t xl, xc, xr;
+  size_t vl;
+
+  for (unsigned long int x0 = 0; x0 < Wo; x0 += vl) {
+    vl = vsetvl_e32m2(Wo - x0);
+    vfloat32m2_t bias = vfmv_v_f_f32m2(b, vl);
+    // Output y, and the top row of output y + 1
+    vfloat32m2_t cur = bias, next = bias;
+
+    for (unsigned long int y = 0; y < Ho; ++y) {
+      dw_row_s2(i + 2 * y * W, x0, W, vl, &xl, &xc, &xr);
+      cur = dw_row(cur, f + 3, xl, xc, xr, vl);
+      if (2 * y + 1 < H) {
+        dw_row_s2(i + (2 * y + 1) * W, x0, W, vl, &xl, &xc, &xr);
+        cur = dw_row(cur, f + 6, xl, xc, xr, vl);
+        next = dw_row(bias, f, xl, xc, xr, vl);
+      }
+      vse32_v_f32m2(o + y * Wo + x0, dw_relu6_m2(cur, relu6, vl), vl);
+      cur = next;
+    }
+  }
+}
+
+void dwconv3x3_nchw(float *o, const float *i, const float *f, const float *b,
+                    unsigned long int C, unsigned long int H,
+                    unsigned long int W, unsigned long int stride, int relu6) {
+  const unsigned long int Ho = (H - 1) / stride + 1;
+  const unsigned long int Wo = (W - 1) / stride + 1;
+  for (unsigned long int c = 0; c < C; ++c) {
+    if (stride == 1)
+      dwconv3x3_nchw_s1(o + c * Ho * Wo, i + c * H * W, f + 9 * c, b[c], H, W,
+                        relu6);
+    else
+      dwconv3x3_nchw_s2(o + c * Ho * Wo, i + c * H * W, f + 9 * c, b[c], H, W,
+                        relu6);
+  }
+}
+
+/*
+  NHWC
+*/
+
+// The nine filter vectors of the channels of a strip, w[ky][kx], stay in the
+// registers, and each input column adds its three rows to the outputs with
+// the filter column kx
+#define DW_COL(acc, kx)                                                        \
+  vfmacc_vv_f32m1(                                                             \
+      vfmacc_vv_f32m1(vfmacc_vv_f32m1(acc, w0##kx, x0, vl), w1##kx, x1, vl),   \
+      w2##kx, x2, vl)
+
+// Input column x of rows y - 1, y, and y + 1 of channels c0 to c0 + vl - 1
+#define DW_LOAD_COL(x)                                                         \
+  do {                                                                         \
+    const float *col = i + (y * W + (x)) * C + c0;                             \
+    x0 = y ? vle32_v_f32m1(col - W * C, vl) : zero;                            \
+    x1 = vle32_v_f32m1(col, vl);                                               \
+    x2 = y + 1 < H ? vle32_v_f32m1(col + W * C, vl) : zero;                    \
+  } while (0)
+
+void dwconv3x3_nhwc(float *o, const float *i, const float *f, const float *b,
+                    unsigned long int C, unsigned long int H,
+                    unsigned long int W, unsigned long int stride, int relu6) {
+  const unsigned long int Ho = (H - 1) / stride + 1;
+  const unsigned long int Wo = (W - 1) / stride + 1;
+  size_t vl;
+
+  for (unsigned long int c0 = 0; c0 < C; c0 += vl) {
+    vl = vsetvl_e32m1(C - c0);
+    vfloat32m1_t w00 = vle32_v_f32m1(f + 0 * C + c0, vl);
+    vfloat32m1_t w01 = vle32_v_f32m1(f + 1 * C + c0, vl);
+    vfloat32m1_t w02 = vle32_v_f32m1(f + 2 * C + c0, vl);
+    vfloat32m1_t w10 = vle32_v_f32m1(f + 3 * C + c0, vl);
+    vfloat32m1_t w11 = vle32_v_f32m1(f + 4 * C + c0, vl);
+    vfloat32m1_t w12 = vle32_v_f32m1(f + 5 * C + c0, vl);
+    vfloat32m1_t w20 = vle32_v_f32m1(f + 6 * C + c0, vl);
+    vfloat32m1_t w21 = vle32_v_f32m1(f + 7 * C + c0, vl);
+    vfloat32m1_t w22 = vle32_v_f32m1(f + 8 * C + c0, vl);
+    vfloat32m1_t bias = vle32_v_f32m1(b + c0, vl);
+    vfloat32m1_t zero = vfmv_v_f_f32m1(0, vl);
+    vfloat32m1_t x0, x1, x2;
+
+    for (unsigned long int yo = 0; yo < Ho; ++yo) {
+      const unsigned long int y = yo * stride;
+      float *out = o + yo * Wo * C + c0;
+
+      if (stride == 1) {
+        vfloat32m1_t prev = bias, cur = bias, next = bias;
+        for (unsigned long int x = 0; x < W; ++x) {
+          DW_LOAD_COL(x);
+          if (x) {
+            prev = DW_COL(prev, 2);
+            vse32_v_f32m1(out + (x - 1) * C, dw_relu6_m1(prev, relu6, vl), vl);
+          }
+          prev = DW_COL(cur, 1);
+          cur = DW_COL(next, 0);
+          next = bias;
+        }
+        vse32_v_f32m1(out + (W - 1) * C, dw_relu6_m1(prev, relu6, vl), vl);
+      } else {
+        vfloat32m1_t cur = bias, next = bias;
+        for (unsigned long int xo = 0; xo < Wo; ++xo) {
+          DW_LOAD_COL(2 * xo);
+          cur = DW_COL(cur, 1);
+          if (2 * xo + 1 < W) {
+            DW_LOAD_COL(2 * xo + 1);
+            cur = DW_COL(cur, 2);
+            next = DW_COL(bias, 0);
+          }
+          vse32_v_f32m1(out + xo * C, dw_relu6_m1(cur, relu6, vl), vl);
+          cur = next;
+        }
+      }
+    }
+  }
+}
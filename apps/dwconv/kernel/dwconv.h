@@ -0,0 +1,58 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Depthwise 3x3 convolution and pooling layers in FP32, on a C x H x W tensor
+// in the NCHW layout, i[c][y][x], or in the NHWC layout, i[y][x][c]:
+//   dwconv3x3_<layout>: o[c][y][x] = b[c] + sum_{ky, kx} f[c][ky][kx] *
+//                       i[c][y * stride + ky - 1][x * stride + kx - 1],
+//                       with one element of zero padding on each side
+//                       (Ho = (H - 1) / stride + 1), and ReLU6 if relu6. The
+//                       filters are f[c][3][3] in NCHW, and f[3][3][c] in NHWC
+//   pool_<layout>: max or average of each K x K window, without padding
+//                  (Ho = (H - K) / stride + 1)
+//   global_pool_<layout>: max or average of each channel, o[c]
+// The NCHW kernels vectorize along the rows, and the NHWC ones along the
+// channels.
+
+#ifndef _DWCONV_H_
+#define _DWCONV_H_
+
+#include <stdint.h>
+
+typedef enum { POOL_MAX = 0, POOL_AVG = 1 } pool_type_t;
+
+void dwconv3x3_nchw(float *o, const float *i, const float *f, const float *b,
+                    unsigned long int C, unsigned long int H,
+                    unsigned long int W, unsigned long int stride, int relu6);
+void dwconv3x3_nhwc(float *o, const float *i, const float *f, const float *b,
+                    unsigned long int C, unsigned long int H,
+                    unsigned long int W, unsigned long int stride, int relu6);
+
+void pool_nchw(float *o, const float *i, unsigned long int C,
+               unsigned long int H, unsigned long int W, unsigned long int K,
+               unsigned long int stride, pool_type_t type);
+void pool_nhwc(float *o, const float *i, unsigned long int C,
+               unsigned long int H, unsigned long int W, unsigned long int K,
+               unsigned long int stride, pool_type_t type);
+
+void global_pool_nchw(float *o, const float *i, unsigned long int C,
+                      unsigned long int H, unsigned long int W,
+                      pool_type_t type);
+void global_pool_nhwc(float *o, const float *i, unsigned long int C,
+                      unsigned long int H, unsigned long int W,
+                      pool_type_t type);
+
+#endif
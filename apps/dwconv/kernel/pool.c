@@ -0,0 +1,151 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <math.h>
+
+#include "dwconv.h"
+#include "riscv_vector.h"
+
+// The windows are reduced with vfmax, as the max pass of softmax, or with
+// vfadd and a final product by the reciprocal of their size
+
+static inline vfloat32m4_t pool_op(vfloat32m4_t acc, vfloat32m4_t v,
+                                   pool_type_t type, size_t vl) {
+  return type == POOL_MAX ? vfmax_vv_f32m4(acc, v, vl)
+                          : vfadd_vv_f32m4(acc, v, vl);
+}
+
+static inline vfloat32m4_t pool_init(pool_type_t type, size_t vl) {
+  return vfmv_v_f_f32m4(type == POOL_MAX ? -INFINITY : 0, vl);
+}
+
+static inline vfloat32m4_t pool_end(vfloat32m4_t acc, pool_type_t type,
+                                    float size, size_t vl) {
+  return type == POOL_MAX ? acc : vfmul_vf_f32m4(acc, 1 / size, vl);
+}
+
+/*
+  Window pooling
+*/
+
+// With stride 1, each row is loaded once per output row, with K - 1 more
+// elements, and slid down for the other columns of the windows. With a larger
+// stride, each column of the windows is a strided load
+void pool_nchw(float *o, const float *i, unsigned long int C,
+               unsigned long int H, unsigned long int W, unsigned long int K,
+               unsigned long int stride, pool_type_t type) {
+  const unsigned long int Ho = (H - K) / stride + 1;
+  const unsigned long int Wo = (W - K) / stride + 1;
+  const size_t vlmax = vsetvlmax_e32m4();
+  size_t vl;
+
+  for (unsigned long int c = 0; c < C; ++c) {
+    const float *ch = i + c * H * W;
+    for (unsigned long int y = 0; y < Ho; ++y) {
+      for (unsigned long int x0 = 0; x0 < Wo; x0 += vl) {
+        vl = Wo - x0;
+        if (stride == 1 && vl > vlmax - (K - 1))
+          vl = vlmax - (K - 1);
+        vl = vsetvl_e32m4(vl);
+        vfloat32m4_t acc = pool_init(type, vl);
+
+        for (unsigned long int ky = 0; ky < K; ++ky) {
+          const float *row = ch + (y * stride + ky) * W + x0 * stride;
+          if (stride == 1) {
+            vfloat32m4_t v = vle32_v_f32m4(row, vl + K - 1);
+            acc = pool_op(acc, v, type, vl);
+            for (unsigned long int kx = 1; kx < K; ++kx)
+              acc = pool_op(acc, vslidedown_vx_f32m4(v, v, kx, vl), type, vl);
+          } else {
+            for (unsigned long int kx = 0; kx < K; ++kx)
+              acc = pool_op(
+                  acc,
+                  vlse32_v_f32m4(row + kx, stride * sizeof(float), vl), type,
+                  vl);
+          }
+        }
+
+        vse32_v_f32m4(o + (c * Ho + y) * Wo + x0,
+                      pool_end(acc, type, K * K, vl), vl);
+      }
+    }
+  }
+}
+
+void pool_nhwc(float *o, const float *i, unsigned long int C,
+               unsigned long int H, unsigned long int W, unsigned long int K,
+               unsigned long int stride, pool_type_t type) {
+  const unsigned long int Ho = (H - K) / stride + 1;
+  const unsigned long int Wo = (W - K) / stride + 1;
+  size_t vl;
+
+  for (unsigned long int y = 0; y < Ho; ++y) {
+    for (unsigned long int x = 0; x < Wo; ++x) {
+      const float *win = i + (y * stride * W + x * stride) * C;
+      for (unsigned long int c0 = 0; c0 < C; c0 += vl) {
+        vl = vsetvl_e32m4(C - c0);
+        vfloat32m4_t acc = pool_init(type, vl);
+        for (unsigned long int ky = 0; ky < K; ++ky)
+          for (unsigned long int kx = 0; kx < K; ++kx)
+            acc = pool_op(
+                acc, vle32_v_f32m4(win + (ky * W + kx) * C + c0, vl), type,
+                vl);
+        vse32_v_f32m4(o + (y * Wo + x) * C + c0,
+                      pool_end(acc, type, K * K, vl), vl);
+      }
+    }
+  }
+}
+
+/*
+  Global pooling
+*/
+
+// Vectorized along the channels in both layouts, so that no reduction is
+// needed: strided loads of one element per channel in NCHW, unit-stride
+// loads of one pixel in NHWC
+
+void global_pool_nchw(float *o, const float *i, unsigned long int C,
+                      unsigned long int H, unsigned long int W,
+                      pool_type_t type) {
+  const unsigned long int HW = H * W;
+  size_t vl;
+
+  for (unsigned long int c0 = 0; c0 < C; c0 += vl) {
+    vl = vsetvl_e32m4(C - c0);
+    vfloat32m4_t acc = pool_init(type, vl);
+    for (unsigned long int p = 0; p < HW; ++p)
+      acc = pool_op(acc,
+                    vlse32_v_f32m4(i + c0 * HW + p, HW * sizeof(float), vl),
+                    type, vl);
+    vse32_v_f32m4(o + c0, pool_end(acc, type, HW, vl), vl);
+  }
+}
+
+void global_pool_nhwc(float *o, const float *i, unsigned long int C,
+                      unsigned long int H, unsigned long int W,
+                      pool_type_t type) {
+  const unsigned long int HW = H * W;
+  size_t vl;
+
+  for (unsigned long int c0 = 0; c0 < C; c0 += vl) {
+    vl = vsetvl_e32m4(C - c0);
+    vfloat32m4_t acc = pool_init(type, vl);
+    for (unsigned long int p = 0; p < HW; ++p)
+      acc = pool_op(acc, vle32_v_f32m4(i + p * C + c0, vl), type, vl);
+    vse32_v_f32m4(o + c0, pool_end(acc, type, HW, vl), vl);
+  }
+}
@@ -0,0 +1,127 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdint.h>
+
+#include "kernel/dwconv.h"
+#include "runtime.h"
+#include "util.h"
+#include "vcheck.h"
+
+#ifndef SPIKE
+#include "printf.h"
+#else
+#include <stdio.h>
+#endif
+
+#define THRESHOLD 0.0001
+
+extern uint64_t C;
+extern uint64_t H;
+extern uint64_t W;
+extern uint64_t stride;
+extern uint64_t K;
+extern float i_nchw[] __attribute__((aligned(4 * NR_LANES)));
+extern float i_nhwc[] __attribute__((aligned(4 * NR_LANES)));
+extern float f_nchw[] __attribute__((aligned(4 * NR_LANES)));
+extern float f_nhwc[] __attribute__((aligned(4 * NR_LANES)));
+extern float b[] __attribute__((aligned(4 * NR_LANES)));
+extern float o[] __attribute__((aligned(4 * NR_LANES)));
+extern float gold_dw[] __attribute__((aligned(4 * NR_LANES)));
+extern float gold_max[] __attribute__((aligned(4 * NR_LANES)));
+extern float gold_avg[] __attribute__((aligned(4 * NR_LANES)));
+extern float gold_gmax[] __attribute__((aligned(4 * NR_LANES)));
+extern float gold_gavg[] __attribute__((aligned(4 * NR_LANES)));
+
+// Compare a NHWC result with its NCHW gold, of C x h x w elements
+static int64_t check_nhwc(const float *res, const float *gold, uint64_t h,
+                          uint64_t w) {
+  for (uint64_t c = 0; c < C; ++c)
+    for (uint64_t p = 0; p < h * w; ++p) {
+      float diff = res[p * C + c] - gold[c * h * w + p];
+      if (diff > THRESHOLD || diff < -THRESHOLD)
+        return c * h * w + p;
+    }
+  return -1;
+}
+
+static int report(const char *name, int64_t idx) {
+  printf("%s: %ld cycles.\n", name, get_timer());
+  return vcheck_report(name, idx);
+}
+
+int main() {
+  printf("\n");
+  printf("============\n");
+  printf("=  DWCONV  =\n");
+  printf("============\n");
+  printf("\n");
+  printf("\n");
+
+  printf("Input: %lu x %lu x %lu, stride: %lu, pooling window: %lu\n", C, H, W,
+         stride, K);
+
+  const uint64_t dh = (H - 1) / stride + 1, dw = (W - 1) / stride + 1;
+  const uint64_t ph = (H - K) / stride + 1, pw = (W - K) / stride + 1;
+  int error = 0;
+
+  start_timer();
+  dwconv3x3_nchw(o, i_nchw, f_nchw, b, C, H, W, stride, 1);
+  stop_timer();
+  error |= report("dwconv3x3_nchw",
+                  vcheck_f32(o, gold_dw, C * dh * dw, THRESHOLD));
+
+  start_timer();
+  dwconv3x3_nhwc(o, i_nhwc, f_nhwc, b, C, H, W, stride, 1);
+  stop_timer();
+  error |= report("dwconv3x3_nhwc", check_nhwc(o, gold_dw, dh, dw));
+
+  start_timer();
+  pool_nchw(o, i_nchw, C, H, W, K, stride, POOL_MAX);
+  stop_timer();
+  error |= report("pool_nchw (max)",
+                  vcheck_f32(o, gold_max, C * ph * pw, THRESHOLD));
+
+  start_timer();
+  pool_nhwc(o, i_nhwc, C, H, W, K, stride, POOL_MAX);
+  stop_timer();
+  error |= report("pool_nhwc (max)", check_nhwc(o, gold_max, ph, pw));
+
+  start_timer();
+  pool_nchw(o, i_nchw, C, H, W, K, stride, POOL_AVG);
+  stop_timer();
+  error |= report("pool_nchw (avg)",
+                  vcheck_f32(o, gold_avg, C * ph * pw, THRESHOLD));
+
+  start_timer();
+  pool_nhwc(o, i_nhwc, C, H, W, K, stride, POOL_AVG);
+  stop_timer();
+  error |= report("pool_nhwc (avg)", check_nhwc(o, gold_avg, ph, pw));
+
+  start_timer();
+  global_pool_nchw(o, i_nchw, C, H, W, POOL_MAX);
+  stop_timer();
+  error |= report("global_pool_nchw (max)",
+                  vcheck_f32(o, gold_gmax, C, THRESHOLD));
+
+  start_timer();
+  global_pool_nhwc(o, i_nhwc, C, H, W, POOL_AVG);
+  stop_timer();
+  error |= report("global_pool_nhwc (avg)",
+                  vcheck_f32(o, gold_gavg, C, THRESHOLD));
+
+  return error;
+}
@@ -0,0 +1,88 @@
+#!/usr/bin/env python3
+# Copyright 2022 ETH Zurich and University of Bologna.
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+# arg1: channels, arg2: height and width, arg3: stride, arg4: pooling window
+
+import numpy as np
+import os
+import sys
+
+sys.path.insert(0, os.path.join(os.path.dirname(__file__), '../../common/script'))
+from data_emit import emit as emit_data
+
+# Pad the FP32 arrays to whole double words
+def emit(name, array, alignment='8'):
+  emit_data(name, array, alignment, pad=8)
+
+# Depthwise 3x3 convolution with padding 1, bias, and ReLU6, in FP64
+def dwconv3x3(x, f, b, stride):
+  C, H, W = x.shape
+  Ho = (H - 1) // stride + 1
+  Wo = (W - 1) // stride + 1
+  p = np.pad(x.astype(np.float64), ((0, 0), (1, 1), (1, 1)))
+  o = np.zeros((C, Ho, Wo)) + b.astype(np.float64)[:, None, None]
+  for ky in range(3):
+    for kx in range(3):
+      win = p[:, ky:ky + stride * (Ho - 1) + 1:stride, kx:kx + stride * (Wo - 1) + 1:stride]
+      o += f[:, ky, kx, None, None] * win
+  return np.clip(o, 0, 6).astype(np.float32)
+
+# K x K pooling without padding
+def pool(x, K, stride, op):
+  C, H, W = x.shape
+  Ho = (H - K) // stride + 1
+  Wo = (W - K) // stride + 1
+  wins = [x[:, ky:ky + stride * (Ho - 1) + 1:stride, kx:kx + stride * (Wo - 1) + 1:stride]
+          for ky in range(K) for kx in range(K)]
+  return op(np.stack(wins), axis=0).astype(np.float32)
+
+############
+## SCRIPT ##
+############
+
+if len(sys.argv) == 5:
+  C      = int(sys.argv[1])
+  H      = int(sys.argv[2])
+  stride = int(sys.argv[3])
+  K      = int(sys.argv[4])
+else:
+  print("Error. Give me four arguments: the channels, the height (= width), the stride, and the pooling window.")
+  sys.exit()
+
+W = H
+x = np.random.uniform(-3, 3, (C, H, W)).astype(np.float32)
+f = np.random.uniform(-1, 1, (C, 3, 3)).astype(np.float32)
+b = np.random.uniform(-1, 1, C).astype(np.float32)
+
+# The outputs of all the kernels fit in C x H x W elements
+print(".section .data,\"aw\",@progbits")
+emit("C", np.array(C, dtype=np.uint64))
+emit("H", np.array(H, dtype=np.uint64))
+emit("W", np.array(W, dtype=np.uint64))
+emit("stride", np.array(stride, dtype=np.uint64))
+emit("K", np.array(K, dtype=np.uint64))
+emit("i_nchw", x, 'NR_LANES*4')
+emit("i_nhwc", np.ascontiguousarray(x.transpose(1, 2, 0)), 'NR_LANES*4')
+emit("f_nchw", f, 'NR_LANES*4')
+emit("f_nhwc", np.ascontiguousarray(f.transpose(1, 2, 0)), 'NR_LANES*4')
+emit("b", b, 'NR_LANES*4')
+emit("o", np.zeros(C * H * W, dtype=np.float32), 'NR_LANES*4')
+emit("gold_dw", dwconv3x3(x, f, b, stride), 'NR_LANES*4')
+emit("gold_max", pool(x, K, stride, np.max), 'NR_LANES*4')
+emit("gold_avg", pool(x, K, stride, np.mean), 'NR_LANES*4')
+emit("gold_gmax", x.max(axis=(1, 2)).astype(np.float32), 'NR_LANES*4')
+emit("gold_gavg", x.astype(np.float64).mean(axis=(1, 2)).astype(np.float32), 'NR_LANES*4')
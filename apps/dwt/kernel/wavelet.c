@@ -76,37 +76,64 @@ void gsl_wavelet_transform(float *data, size_t n, float *buf,
   }
 }
 
+// 2D DWT, non-standard decomposition: each level transforms the rows and then
+// the columns of the top-left block that holds the approximation of the
+// previous level, until one of its sides is 1 element long
+void gsl_wavelet2d_transform(float *data, size_t rows, size_t cols,
+                             float *buf) {
+
+  gsl_wavelet haar;
+  gsl_wavelet *w;
+  size_t r, c, i, j;
+
+  w = &haar;
+  w->h1 = ch_2;
+  w->g1 = cg_2;
+  w->nc = 2;
+  w->offset = 0;
+
+  for (r = rows, c = cols; r >= 2 && c >= 2; r >>= 1, c >>= 1) {
+    for (i = 0; i < r; ++i)
+      dwt_step(w, &data[i * cols], c, buf);
+
+    // The columns, through a contiguous copy
+    for (j = 0; j < c; ++j) {
+      for (i = 0; i < r; ++i)
+        buf[r + i] = data[i * cols + j];
+      dwt_step(w, &buf[r], r, buf);
+      for (i = 0; i < r; ++i)
+        data[i * cols + j] = buf[r + i];
+    }
+  }
+}
+
 // For now, compatible with order 2 filters
 // For higher filter orders, pad the input sample vector first
 // Then, use vslide1down selectively
-static inline void dwt_step_vector(const gsl_wavelet *w, float *samples,
-                                   size_t n, float *buf) {
+// Transform the n samples of src into the n/2 samples g_dst and h_dst. The
+// pairs are processed from the last one, so h_dst may be the upper half of
+// src: the samples it overwrites have already been read.
+static inline void dwt_step_vector(const gsl_wavelet *w, const float *src,
+                                   size_t n, float *g_dst, float *h_dst) {
 
-  size_t avl = n;
+  size_t vl;
   vfloat32m4_t sample_vec_0;
   vfloat32m4_t sample_vec_1;
   vfloat32m4_t g_vec;
   vfloat32m4_t h_vec;
 
-  float *samples_r = samples;
-  float *samples_w = samples;
-  float *buf_r = buf;
-  float *buf_w = buf;
-
-  // Strip-Mining loop
-  for (size_t vl = vsetvl_e32m4(avl); avl > 0; avl -= vl) {
+  // Strip-Mining loop, on the pairs of samples
+  for (size_t avl = n / 2; avl > 0; avl -= vl) {
     vl = vsetvl_e32m4(avl);
-    // If we have enough samples, fill the vector registers!
-    if (avl >= 2 * vl)
-      vl *= 2;
-#ifdef SEGMENT
-    // Segment load the vectors. ToDo: check if vl/2 is correct
-    vlseg2e32_v_f32m4(sample_vec_0, sample_vec_1, samples_r, vl / 2);
+    const size_t p = avl - vl;
+
+#ifdef DWT_STRIDED
+    // Strided load
+    sample_vec_0 = vlse32_v_f32m4(&src[2 * p], 2 * sizeof(*src), vl);
+    sample_vec_1 = vlse32_v_f32m4(&src[2 * p + 1], 2 * sizeof(*src), vl);
 #else
-    // Strided load (inefficient!)
-    sample_vec_0 = vlse32_v_f32m4(samples_r, 2 * sizeof(*samples_r), vl / 2);
-    sample_vec_1 =
-        vlse32_v_f32m4(samples_r + 1, 2 * sizeof(*samples_r), vl / 2);
+    // Segment load the even and odd samples
+    vlseg2e32_v_f32m4(&sample_vec_0, &sample_vec_1, &src[2 * p], vl);
 #endif
 
     // First implementation
@@ -114,38 +141,63 @@ static inline void dwt_step_vector(const gsl_wavelet *w, float *samples,
 
     // Generate the g vector and store it back
     // Generate the h vector and store it back
-    g_vec = vfmul_vf_f32m4(sample_vec_0, w->g1[0], vl / 2);
-    h_vec = vfmul_vf_f32m4(sample_vec_0, w->h1[0], vl / 2);
+    g_vec = vfmul_vf_f32m4(sample_vec_0, w->g1[0], vl);
+    h_vec = vfmul_vf_f32m4(sample_vec_0, w->h1[0], vl);
 
-    g_vec = vfmacc_vf_f32m4(g_vec, w->g1[1], sample_vec_1, vl / 2);
-    h_vec = vfmacc_vf_f32m4(h_vec, w->h1[1], sample_vec_1, vl / 2);
+    g_vec = vfmacc_vf_f32m4(g_vec, w->g1[1], sample_vec_1, vl);
+    h_vec = vfmacc_vf_f32m4(h_vec, w->h1[1], sample_vec_1, vl);
 
-    vse32_v_f32m4(samples_w, g_vec, vl / 2);
-    vse32_v_f32m4(buf_w, h_vec, vl / 2);
-
-    // Bump pointers
-    samples_r += vl;
-    samples_w += vl / 2;
-    buf_w += vl / 2;
+    vse32_v_f32m4(&g_dst[p], g_vec, vl);
+    vse32_v_f32m4(&h_dst[p], h_vec, vl);
   }
+}
+
+// Transform the r rows of src, cols elements each, into the r/2 rows g_dst and
+// h_dst. The rows are stride elements apart.
+static inline void dwt_step_cols_vector(const gsl_wavelet *w, const float *src,
+                                        size_t r, size_t cols, size_t stride,
+                                        float *g_dst, float *h_dst) {
+
+  size_t vl;
+  vfloat32m4_t sample_vec_0;
+  vfloat32m4_t sample_vec_1;
+  vfloat32m4_t g_vec;
+  vfloat32m4_t h_vec;
+
+  for (size_t i = 0; i < r / 2; ++i) {
+    const float *src_0 = &src[2 * i * stride];
+    const float *src_1 = src_0 + stride;
 
-  // Memcpy h_vec to the samples vector
-  avl = n / 2;
-  for (size_t vl = vsetvl_e32m4(avl); avl > 0; avl -= vl) {
-    h_vec = vle32_v_f32m4(buf_r, vl);
-    vse32_v_f32m4(samples_w, h_vec, vl);
-    buf_r += vl;
-    samples_w += vl;
+    for (size_t j = 0, avl = cols; avl > 0; avl -= vl, j += vl) {
+      vl = vsetvl_e32m4(avl);
+      sample_vec_0 = vle32_v_f32m4(&src_0[j], vl);
+      sample_vec_1 = vle32_v_f32m4(&src_1[j], vl);
+
+      g_vec = vfmul_vf_f32m4(sample_vec_0, w->g1[0], vl);
+      h_vec = vfmul_vf_f32m4(sample_vec_0, w->h1[0], vl);
+
+      g_vec = vfmacc_vf_f32m4(g_vec, w->g1[1], sample_vec_1, vl);
+      h_vec = vfmacc_vf_f32m4(h_vec, w->h1[1], sample_vec_1, vl);
+
+      vse32_v_f32m4(&g_dst[i * stride + j], g_vec, vl);
+      vse32_v_f32m4(&h_dst[i * stride + j], h_vec, vl);
+    }
   }
 }
 
 // The signal should be already padded
+// The h samples of each level are stored in their final place in data, while
+// the g samples, i.e., the input of the next level, alternate between buf and
+// data, so that nothing is copied back. buf holds n/2 samples.
 void gsl_wavelet_transform_vector(float *data, size_t n, float *buf,
                                   int first_iter_only) {
 
   gsl_wavelet haar;
   gsl_wavelet *w;
   size_t i;
+  float *src = data;
+  float *dst = buf;
+  float *tmp;
 
   w = &haar;
   w->h1 = ch_2;
@@ -162,8 +214,56 @@ void gsl_wavelet_transform_vector(float *data, size_t n, float *buf,
     if (i == (n >> 1))
       event_trigger = -1;
 #endif
-    dwt_step_vector(w, data, i, buf);
-    if (first_iter_only)
+    // The last g sample of the transform goes to data
+    if (i == 2)
+      dst = data;
+    dwt_step_vector(w, src, i, dst, &data[i / 2]);
+    if (first_iter_only) {
+      // Memcpy the g samples to data
+      size_t vl;
+      for (size_t avl = (dst == buf) ? i / 2 : 0, j = 0; avl > 0;
+           avl -= vl, j += vl) {
+        vl = vsetvl_e32m4(avl);
+        vse32_v_f32m4(&data[j], vle32_v_f32m4(&buf[j], vl), vl);
+      }
       i = 0;
+    }
+    // Swap the buffers
+    tmp = src;
+    src = dst;
+    dst = tmp;
+  }
+}
+
+// The image should be already padded
+// Each level transforms the rows of the block from data to buf, and its
+// columns back from buf to data. buf holds rows * cols samples.
+void gsl_wavelet2d_transform_vector(float *data, size_t rows, size_t cols,
+                                    float *buf) {
+
+  gsl_wavelet haar;
+  gsl_wavelet *w;
+  size_t r, c, i;
+
+  w = &haar;
+  w->h1 = ch_2;
+  w->g1 = cg_2;
+  w->nc = 2;
+  w->offset = 0;
+
+  for (r = rows, c = cols; r >= 2 && c >= 2; r >>= 1, c >>= 1) {
+#ifdef VCD_DUMP
+    // Start dumping VCD
+    if (r == rows)
+      event_trigger = +1;
+    // Stop dumping VCD
+    if (r == (rows >> 1))
+      event_trigger = -1;
+#endif
+    for (i = 0; i < r; ++i)
+      dwt_step_vector(w, &data[i * cols], c, &buf[i * cols],
+                      &buf[i * cols + c / 2]);
+
+    dwt_step_cols_vector(w, buf, r, c, cols, data, &data[(r / 2) * cols]);
   }
 }
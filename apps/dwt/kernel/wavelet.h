@@ -58,7 +58,14 @@ void gsl_wavelet_transform(float *data, size_t n, float *buf,
                            int first_iter_only);
 void gsl_wavelet_transform_vector(float *data, size_t n, float *buf,
                                   int first_iter_only);
+void gsl_wavelet2d_transform(float *data, size_t rows, size_t cols,
+                             float *buf);
+void gsl_wavelet2d_transform_vector(float *data, size_t rows, size_t cols,
+                                    float *buf);
 static inline void dwt_step(const gsl_wavelet *w, float *samples, size_t n,
                             float *buf);
-static inline void dwt_step_vector(const gsl_wavelet *w, float *samples,
-                                   size_t n, float *buf);
+static inline void dwt_step_vector(const gsl_wavelet *w, const float *src,
+                                   size_t n, float *g_dst, float *h_dst);
+static inline void dwt_step_cols_vector(const gsl_wavelet *w, const float *src,
+                                        size_t r, size_t cols, size_t stride,
+                                        float *g_dst, float *h_dst);
@@ -15,33 +15,29 @@
 # See the License for the specific language governing permissions and
 # limitations under the License.
 
-# arg1: vector size, arg2: filter size
+# arg1: vector size, arg2, arg3 (optional): rows and columns of the 2D image
 
 import random as rand
 import numpy as np
+import os
 import sys
 
-def emit(name, array, alignment='8'):
-  print(".global %s" % name)
-  print(".balign " + alignment)
-  print("%s:" % name)
-  bs = array.tobytes()
-  for i in range(0, len(bs), 4):
-    s = ""
-    for n in range(4):
-      s += "%02x" % bs[i+3-n]
-    print("    .word 0x%s" % s)
+sys.path.insert(0, os.path.join(os.path.dirname(__file__), '../../common/script'))
+from data_emit import emit
 
 ############
 ## SCRIPT ##
 ############
 
-if len(sys.argv) == 2:
+if len(sys.argv) == 2 or len(sys.argv) == 4:
   NDWT = int(sys.argv[1])
 else:
-  print("Error. Give me one argument: the number of vector elements.")
+  print("Error. Give me one or three arguments: the number of vector elements, and optionally the rows and columns of the image.")
   sys.exit()
 
+ROWS = int(sys.argv[2]) if len(sys.argv) == 4 else 32
+COLS = int(sys.argv[3]) if len(sys.argv) == 4 else 32
+
 dtype = np.float32
 
 # Vector of samples
@@ -50,9 +46,18 @@ data = np.random.rand(NDWT).astype(dtype);
 # Buffer
 buf = np.zeros(int(NDWT/2), dtype=dtype)
 
+# Image and its buffer
+img     = np.random.rand(ROWS * COLS).astype(dtype);
+img_buf = np.zeros(ROWS * COLS, dtype=dtype)
+
 # Create the file
 print(".section .data,\"aw\",@progbits")
 emit("DWT_LEN", np.array(NDWT, dtype=np.uint64))
 emit("data_s", data, 'NR_LANES*4')
 emit("data_v", data, 'NR_LANES*4')
 emit("buf", buf, 'NR_LANES*4')
+emit("DWT2D_ROWS", np.array(ROWS, dtype=np.uint64))
+emit("DWT2D_COLS", np.array(COLS, dtype=np.uint64))
+emit("img_s", img, 'NR_LANES*4')
+emit("img_v", img, 'NR_LANES*4')
+emit("img_buf", img_buf, 'NR_LANES*4')
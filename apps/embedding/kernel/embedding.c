@@ -0,0 +1,142 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "embedding.h"
+
+// Columns of a chunk of the bags kernel, each one with an LMUL=1 accumulator
+#define EMBEDDING_COLS 8
+
+// Sum of a strip of a row, and masked sum of the gathered elements of a column
+static inline vfloat32m8_t embedding_row_f32(vfloat32m8_t acc, const float *p,
+                                             size_t vl) {
+  return vfadd_vv_f32m8(acc, vle32_v_f32m8(p, vl), vl);
+}
+
+static inline vfloat32m8_t embedding_row_f16(vfloat32m8_t acc,
+                                             const _Float16 *p, size_t vl) {
+  return vfwadd_wv_f32m8(acc, vle16_v_f16m4(p, vl), vl);
+}
+
+static inline vfloat32m1_t embedding_col_f32(vbool32_t m, vfloat32m1_t acc,
+                                             const float *p, vuint32m1_t row,
+                                             size_t vl) {
+  return vfadd_vv_f32m1_m(m, acc, acc, vluxei32_v_f32m1_m(m, acc, p, row, vl),
+                          vl);
+}
+
+static inline vfloat32m1_t embedding_col_f16(vbool32_t m, vfloat32m1_t acc,
+                                             const _Float16 *p,
+                                             vuint32m1_t row, size_t vl) {
+  vfloat16mf2_t x = vluxei32_v_f16mf2_m(m, vfmv_v_f_f16mf2(0, vl), p, row, vl);
+  return vfwadd_wv_f32m1_m(m, acc, acc, x, vl);
+}
+
+#define EMBEDDING_COL_ACC(sfx, c)                                              \
+  if (c < cols)                                                                \
+    acc##c = embedding_col_##sfx(m, acc##c, table + d + c, row, vl);
+
+#define EMBEDDING_COL_STORE(c)                                                 \
+  if (c < cols)                                                                \
+    vsse32_v_f32m1(out + b * dim + d + c, dim * sizeof(float), acc##c, vl);
+
+// The rows kernel keeps a strip of the columns of one bag in an LMUL=8
+// accumulator, and adds the strips of its rows with unit-stride loads.
+//
+// The bags kernel loads the offsets of vl bags, and gathers their j-th index,
+// then the elements of the j-th rows in EMBEDDING_COLS columns at a time, for
+// j up to the length of the longest bag. The bags shorter than j are masked
+// off. The sums of a chunk of columns are written with strided stores. The hot
+// rows of skewed indices make the gathers of close elements hit the same AXI
+// blocks, which the indexed loads coalesce.
+#define embedding_def_gen(sfx, T)                                              \
+  void embedding_bag_rows_##sfx(float *out, const T *table, uint64_t dim,      \
+                                const uint32_t *indices,                       \
+                                const uint32_t *offsets, uint64_t bags) {      \
+    size_t vl;                                                                 \
+                                                                               \
+    for (uint64_t b = 0; b < bags; ++b) {                                      \
+      for (uint64_t d = 0; d < dim; d += vl) {                                 \
+        vl = vsetvl_e32m8(dim - d);                                            \
+        vfloat32m8_t acc = vfmv_v_f_f32m8(0, vl);                              \
+        for (uint32_t j = offsets[b]; j < offsets[b + 1]; ++j)                 \
+          acc = embedding_row_##sfx(acc, table + indices[j] * dim + d, vl);    \
+        vse32_v_f32m8(out + b * dim + d, acc, vl);                             \
+      }                                                                        \
+    }                                                                          \
+  }                                                                            \
+                                                                               \
+  void embedding_bag_bags_##sfx(float *out, const T *table, uint64_t dim,      \
+                                const uint32_t *indices,                       \
+                                const uint32_t *offsets, uint64_t bags) {      \
+    const vuint32m1_t zero = vmv_v_x_u32m1(0, 1);                              \
+    size_t vl;                                                                 \
+                                                                               \
+    for (uint64_t b = 0; b < bags; b += vl) {                                  \
+      vl = vsetvl_e32m1(bags - b);                                             \
+      vuint32m1_t first = vle32_v_u32m1(offsets + b, vl);                      \
+      vuint32m1_t len =                                                        \
+          vsub_vv_u32m1(vle32_v_u32m1(offsets + b + 1, vl), first, vl);        \
+      const uint32_t max_len =                                                 \
+          vmv_x_s_u32m1_u32(vredmaxu_vs_u32m1_u32m1(zero, len, zero, vl));     \
+                                                                               \
+      for (uint64_t d = 0; d < dim; d += EMBEDDING_COLS) {                     \
+        const uint64_t cols = dim - d;                                         \
+        vfloat32m1_t acc0, acc1, acc2, acc3, acc4, acc5, acc6, acc7;           \
+        acc0 = acc1 = acc2 = acc3 = acc4 = acc5 = acc6 = acc7 =                \
+            vfmv_v_f_f32m1(0, vl);                                             \
+        /* Byte offsets of the j-th indices */                                 \
+        vuint32m1_t pos = vsll_vx_u32m1(first, 2, vl);                         \
+                                                                               \
+        for (uint32_t j = 0; j < max_len; ++j) {                               \
+          vbool32_t m = vmsgtu_vx_u32m1_b32(len, j, vl);                       \
+          /* Byte offsets of the j-th rows */                                  \
+          vuint32m1_t row = vmul_vx_u32m1(                                     \
+              vluxei32_v_u32m1_m(m, zero, indices, pos, vl),                   \
+              dim * sizeof(T), vl);                                            \
+          EMBEDDING_COL_ACC(sfx, 0)                                            \
+          EMBEDDING_COL_ACC(sfx, 1)                                            \
+          EMBEDDING_COL_ACC(sfx, 2)                                            \
+          EMBEDDING_COL_ACC(sfx, 3)                                            \
+          EMBEDDING_COL_ACC(sfx, 4)                                            \
+          EMBEDDING_COL_ACC(sfx, 5)                                            \
+          EMBEDDING_COL_ACC(sfx, 6)                                            \
+          EMBEDDING_COL_ACC(sfx, 7)                                            \
+          pos = vadd_vx_u32m1(pos, sizeof(uint32_t), vl);                      \
+        }                                                                      \
+                                                                               \
+        EMBEDDING_COL_STORE(0)                                                 \
+        EMBEDDING_COL_STORE(1)                                                 \
+        EMBEDDING_COL_STORE(2)                                                 \
+        EMBEDDING_COL_STORE(3)                                                 \
+        EMBEDDING_COL_STORE(4)                                                 \
+        EMBEDDING_COL_STORE(5)                                                 \
+        EMBEDDING_COL_STORE(6)                                                 \
+        EMBEDDING_COL_STORE(7)                                                 \
+      }                                                                        \
+    }                                                                          \
+  }                                                                            \
+                                                                               \
+  void embedding_bag_##sfx(float *out, const T *table, uint64_t dim,           \
+                           const uint32_t *indices, const uint32_t *offsets,   \
+                           uint64_t bags) {                                    \
+    if (dim >= EMBEDDING_ROW_DIM)                                              \
+      embedding_bag_rows_##sfx(out, table, dim, indices, offsets, bags);       \
+    else                                                                       \
+      embedding_bag_bags_##sfx(out, table, dim, indices, offsets, bags);       \
+  }
+
+embedding_def_gen(f32, float);
+embedding_def_gen(f16, _Float16);
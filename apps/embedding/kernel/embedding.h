@@ -0,0 +1,57 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Embedding-bag lookups, in sum mode: bag b sums the rows
+// indices[offsets[b]] to indices[offsets[b + 1] - 1] of a table of dim
+// columns, i.e.,
+//   out[b * dim + d] = sum_j table[indices[j] * dim + d]
+// offsets has bags + 1 entries, and the empty bags are zero. The FP16 tables
+// are summed in FP32, and every sum adds the rows in the order of indices, so
+// that the results match a sequential scalar sum.
+//   embedding_bag_rows_<type>: one bag at a time, vectorized along the
+//                              columns, with unit-stride loads of the rows
+//   embedding_bag_bags_<type>: vl bags at a time, one per element, with
+//                              vluxei gathers of the indices and of the rows,
+//                              for the short rows
+//   embedding_bag_<type>:      the rows kernel if dim >= EMBEDDING_ROW_DIM,
+//                              the bags one otherwise
+
+#ifndef _EMBEDDING_H_
+#define _EMBEDDING_H_
+
+#include <stdint.h>
+
+#include "riscv_vector.h"
+
+#ifndef EMBEDDING_ROW_DIM
+#define EMBEDDING_ROW_DIM 32
+#endif
+
+#define embedding_dec_gen(sfx, T)                                              \
+  void embedding_bag_rows_##sfx(float *out, const T *table, uint64_t dim,      \
+                                const uint32_t *indices,                       \
+                                const uint32_t *offsets, uint64_t bags);       \
+  void embedding_bag_bags_##sfx(float *out, const T *table, uint64_t dim,      \
+                                const uint32_t *indices,                       \
+                                const uint32_t *offsets, uint64_t bags);       \
+  void embedding_bag_##sfx(float *out, const T *table, uint64_t dim,           \
+                           const uint32_t *indices, const uint32_t *offsets,   \
+                           uint64_t bags);
+
+embedding_dec_gen(f32, float);
+embedding_dec_gen(f16, _Float16);
+
+#endif
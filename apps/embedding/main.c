@@ -0,0 +1,86 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdint.h>
+#include <string.h>
+
+#include "bench.h"
+#include "kernel/embedding.h"
+#include "runtime.h"
+#include "util.h"
+#include "vcheck.h"
+
+#ifndef SPIKE
+#include "printf.h"
+#else
+#include <stdio.h>
+#endif
+
+extern uint64_t rows;
+extern uint64_t dim;
+extern uint64_t bags;
+extern float table[] __attribute__((aligned(4 * NR_LANES)));
+extern _Float16 table16[] __attribute__((aligned(4 * NR_LANES)));
+extern uint32_t indices[] __attribute__((aligned(4 * NR_LANES)));
+extern uint32_t offsets[] __attribute__((aligned(4 * NR_LANES)));
+extern float out[] __attribute__((aligned(4 * NR_LANES)));
+extern float gold[] __attribute__((aligned(4 * NR_LANES)));
+extern float gold16[] __attribute__((aligned(4 * NR_LANES)));
+
+// Elements of the rows summed per cycle
+// The sums are in the same order as the golden ones, and match them exactly
+static int check(const char *name, const float *result, const float *ref) {
+  int64_t idx = vcheck_f32(result, ref, bags * dim, 0);
+  if (idx >= 0) {
+    printf("%s: Error at index %d. %f != %f\n", name, idx, result[idx],
+           ref[idx]);
+    return 1;
+  }
+  printf("%s: Check okay. No errors.\n", name);
+  return 0;
+}
+
+#define EMBEDDING_CHECK(kernel, t, ref)                                        \
+  do {                                                                         \
+    memset(out, 0, bags * dim * sizeof(float));                                \
+    start_timer();                                                             \
+    kernel(out, t, dim, indices, offsets, bags);                               \
+    stop_timer();                                                              \
+    bench_report_rate(#kernel, elements, "elements");                          \
+    error |= check(#kernel, out, ref);                                         \
+  } while (0)
+
+int main() {
+  printf("\n");
+  printf("===============\n");
+  printf("=  EMBEDDING  =\n");
+  printf("===============\n");
+  printf("\n");
+  printf("\n");
+
+  const uint64_t elements = offsets[bags] * dim;
+  int error = 0;
+
+  printf("Table: %lu x %lu, %lu bags, %lu lookups.\n", rows, dim, bags,
+         offsets[bags]);
+
+  EMBEDDING_CHECK(embedding_bag_rows_f32, table, gold);
+  EMBEDDING_CHECK(embedding_bag_bags_f32, table, gold);
+  EMBEDDING_CHECK(embedding_bag_rows_f16, table16, gold16);
+  EMBEDDING_CHECK(embedding_bag_bags_f16, table16, gold16);
+
+  return error;
+}
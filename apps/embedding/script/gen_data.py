@@ -0,0 +1,76 @@
+#!/usr/bin/env python3
+# Copyright 2022 ETH Zurich and University of Bologna.
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+# arg1: rows, arg2: columns of the table, arg3: bags, arg4: average length of
+# the bags, arg5: exponent of the Zipf distribution of the indices (0 for a
+# uniform one)
+# The lengths of the bags vary, with empty ones, but always sum to
+# bags * length. The hot rows of the Zipf distribution are spread over the
+# table. The golden sums add the rows of each bag in order, in FP32, as the
+# kernels do.
+
+import numpy as np
+import os
+import sys
+
+sys.path.insert(0, os.path.join(os.path.dirname(__file__), '../../common/script'))
+from data_emit import emit
+
+def embedding_bag(table, indices, offsets):
+  lens = np.diff(offsets)
+  acc = np.zeros((len(lens), table.shape[1]), dtype=np.float32)
+  for j in range(lens.max(initial=0)):
+    valid = lens > j
+    acc[valid] += table[indices[offsets[:-1][valid] + j]].astype(np.float32)
+  return acc
+
+############
+## SCRIPT ##
+############
+
+if len(sys.argv) == 6:
+  rows   = int(sys.argv[1])
+  dim    = int(sys.argv[2])
+  bags   = int(sys.argv[3])
+  length = int(sys.argv[4])
+  skew   = float(sys.argv[5])
+else:
+  print("Error. Give me five arguments: the rows and the columns of the table, the bags, their average length, and the Zipf exponent.")
+  sys.exit()
+
+table   = np.random.normal(0, 1, (rows, dim)).astype(np.float32)
+table16 = table.astype(np.float16)
+
+lens    = np.random.multinomial(bags * length, np.ones(bags) / bags)
+offsets = np.concatenate(([0], np.cumsum(lens))).astype(np.uint32)
+
+p = 1 / np.arange(1, rows + 1) ** skew
+hot = np.random.permutation(rows)
+indices = hot[np.random.choice(rows, bags * length, p=p / p.sum())].astype(np.uint32)
+
+# Create the file
+print(".section .data,\"aw\",@progbits")
+emit("rows", np.array(rows, dtype=np.uint64))
+emit("dim", np.array(dim, dtype=np.uint64))
+emit("bags", np.array(bags, dtype=np.uint64))
+emit("table", table, 'NR_LANES*4')
+emit("table16", table16, 'NR_LANES*4')
+emit("indices", indices, 'NR_LANES*4')
+emit("offsets", offsets, 'NR_LANES*4')
+emit("out", np.zeros((bags, dim), dtype=np.float32), 'NR_LANES*4')
+emit("gold", embedding_bag(table, indices, offsets), 'NR_LANES*4')
+emit("gold16", embedding_bag(table16, indices, offsets), 'NR_LANES*4')
@@ -35,27 +35,55 @@
 
 #include "exp.h"
 
-void exp_1xf64_bmark(double *exponents, double *results, size_t len) {
+// Strip-mine loop over vmath_exp with LMUL lmul. The full strips run with
+// vl = VLMAX, which does not depend on the loop, and the last strip is a tail.
+#define exp_bmark_def_gen(DATA_TYPE, sew, lmul)                                \
+  void exp_f##sew##lmul##_bmark(DATA_TYPE *exponents, DATA_TYPE *results,      \
+                                size_t len) {                                  \
+    const size_t vlmax = vsetvlmax_e##sew##lmul();                             \
+    vfloat##sew##lmul##_t exp_vec, res_vec;                                    \
+                                                                               \
+    /* Full strips, with a loop-invariant vl */                                \
+    for (; len >= vlmax; len -= vlmax) {                                       \
+      exp_vec = vle##sew##_v_f##sew##lmul(exponents, vlmax);                   \
+      res_vec = vmath_exp_f##sew##lmul(exp_vec, vlmax);                        \
+      vse##sew##_v_f##sew##lmul(results, res_vec, vlmax);                      \
+      exponents += vlmax;                                                      \
+      results += vlmax;                                                        \
+    }                                                                          \
+                                                                               \
+    /* Tail */                                                                 \
+    if (len) {                                                                 \
+      size_t vl = vsetvl_e##sew##lmul(len);                                    \
+      exp_vec = vle##sew##_v_f##sew##lmul(exponents, vl);                      \
+      res_vec = vmath_exp_f##sew##lmul(exp_vec, vl);                           \
+      vse##sew##_v_f##sew##lmul(results, res_vec, vl);                         \
+    }                                                                          \
+  }
 
-  size_t avl = len;
-  vfloat64m1_t exp_vec, res_vec;
+exp_bmark_def_gen(double, 64, m1);
+exp_bmark_def_gen(double, 64, m2);
+exp_bmark_def_gen(double, 64, m4);
+exp_bmark_def_gen(float, 32, m1);
+exp_bmark_def_gen(float, 32, m2);
+exp_bmark_def_gen(float, 32, m4);
 
+// The largest LMUL such that the temporaries of the kernel stay in the
+// register file
+void exp_1xf64_bmark(double *exponents, double *results, size_t len) {
 #ifdef VCD_DUMP
   // Start dumping VCD
   event_trigger = +1;
 #endif
-  for (size_t vl = vsetvl_e64m1(avl); avl > 0; avl -= vl) {
-    // Strip-mine
-    vl = vsetvl_e64m1(avl);
-    // Load vector
-    exp_vec = vle64_v_f64m1(exponents, vl);
-    // Compute
-    res_vec = __exp_1xf64(exp_vec, vl);
-    // Store
-    vse64_v_f64m1(results, res_vec, vl);
-    // Bump pointers
-    exponents += vl;
-    results += vl;
+  switch (VMATH_EXP_LMUL) {
+  case 1:
+    exp_f64m1_bmark(exponents, results, len);
+    break;
+  case 2:
+    exp_f64m2_bmark(exponents, results, len);
+    break;
+  default:
+    exp_f64m4_bmark(exponents, results, len);
   }
 #ifdef VCD_DUMP
   // Stop dumping VCD
@@ -64,26 +92,19 @@ void exp_1xf64_bmark(double *exponents, double *results, size_t len) {
 }
 
 void exp_2xf32_bmark(float *exponents, float *results, size_t len) {
-
-  size_t avl = len;
-  vfloat32m1_t exp_vec, res_vec;
-
 #ifdef VCD_DUMP
   // Start dumping VCD
   event_trigger = +1;
 #endif
-  for (size_t vl = vsetvl_e32m1(avl); avl > 0; avl -= vl) {
-    // Strip-mine
-    vl = vsetvl_e32m1(avl);
-    // Load vector
-    exp_vec = vle32_v_f32m1(exponents, vl);
-    // Compute
-    res_vec = __exp_2xf32(exp_vec, vl);
-    // Store
-    vse32_v_f32m1(results, res_vec, vl);
-    // Bump pointers
-    exponents += vl;
-    results += vl;
+  switch (VMATH_EXP_LMUL) {
+  case 1:
+    exp_f32m1_bmark(exponents, results, len);
+    break;
+  case 2:
+    exp_f32m2_bmark(exponents, results, len);
+    break;
+  default:
+    exp_f32m4_bmark(exponents, results, len);
   }
 #ifdef VCD_DUMP
   // Stop dumping VCD
@@ -21,7 +21,9 @@
 
 #include "kernel/exp.h"
 #include "runtime.h"
+#include "trace.h"
 #include "util.h"
+#include "vcheck.h"
 
 #ifndef SPIKE
 #include "printf.h"
@@ -74,19 +76,18 @@ int main() {
 #ifdef CHECK
   printf("Checking results:\n");
 
-  for (uint64_t i = 0; i < N_f64; ++i) {
-    if (!similarity_check(results_f64[i], gold_results_f64[i], THRESHOLD)) {
-      error = 1;
-      printf("64-bit error at index %d. %f != %f\n", i, results_f64[i],
-             gold_results_f64[i]);
-    }
+  // Report the first mismatch of each precision
+  int64_t i = vcheck_f64(results_f64, gold_results_f64, N_f64, THRESHOLD);
+  if (i >= 0) {
+    error = 1;
+    trace_mismatch(i, "64-bit error at index %d. %f != %f\n", i,
+                   results_f64[i], gold_results_f64[i]);
   }
-  for (uint64_t i = 0; i < N_f32; ++i) {
-    if (!similarity_check(results_f32[i], gold_results_f32[i], THRESHOLD)) {
-      error = 1;
-      printf("32-bit error at index %d. %f != %f\n", i, results_f32[i],
-             gold_results_f32[i]);
-    }
+  i = vcheck_f32(results_f32, gold_results_f32, N_f32, THRESHOLD);
+  if (i >= 0) {
+    error = 1;
+    trace_mismatch(i, "32-bit error at index %d. %f != %f\n", i,
+                   results_f32[i], gold_results_f32[i]);
   }
   if (!error)
     printf("Test result: PASS. No errors found.\n");
@@ -22,6 +22,12 @@
 #include <stdint.h>
 #include <stdio.h>
 
+#include "vconfig.h"
+
+// Widest output of fconv2d_3x3(), which keeps a padded row in a register group
+// of LMUL = 2
+#define FCONV2D_3X3_MAX_C (VLMAX_E64M2 - 2)
+
 void fconv2d_3x3(double *o, double *i, double *f, int64_t R, int64_t C,
                  int64_t F);
 void fconv2d_vec_4xC_slice_init_3x3(double *o, int64_t C);
@@ -34,6 +40,17 @@ void fconv2d_7x7(double *o, double *i, double *f, int64_t R, int64_t C,
 void fconv2d_7x7_block(double *o, double *i, double *f, int64_t R, int64_t C,
                        int64_t n_, int64_t F);
 
+// Output rows computed at once by fconv2d_KxK()
+#ifndef FCONV2D_KXK_BLOCK
+#define FCONV2D_KXK_BLOCK 4
+#endif
+// Largest filter size supported by fconv2d_KxK()
+#define FCONV2D_KXK_MAX_F 11
+
+// Any odd F up to FCONV2D_KXK_MAX_F, and R multiple of FCONV2D_KXK_BLOCK
+void fconv2d_KxK(double *o, double *i, double *f, int64_t R, int64_t C,
+                 int64_t F);
+
 #define MIN(a, b) ((a) < (b) ? (a) : (b))
 
 // Threshold for FP numbers comparison during the final check
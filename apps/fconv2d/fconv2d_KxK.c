@@ -0,0 +1,272 @@
+// Copyright 2020 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/*
+  Generic KxK convolution for Ara, for any odd filter size up to
+  FCONV2D_KXK_MAX_F
+
+  It follows the row-reuse strategy of fconv2d_3x3():
+  a) Preload the first F - 1 input rows (slice_preload)
+  b) Load the next FCONV2D_KXK_BLOCK input rows, and calculate the
+  FCONV2D_KXK_BLOCK output rows that depend on the F + FCONV2D_KXK_BLOCK - 1
+  input rows in the VRF. Every input row is slid down once per filter column,
+  and the slid row is multiplied by the coefficients of that column on all the
+  output rows that need it
+  c) Store the output rows, and move the last F - 1 input rows to the first
+  registers (slice_move)
+  d) Repeat from b)
+
+  The schedule is generated at compile time from the filter size: the vector
+  registers are selected by switches on their number, and every loop of
+  fconv2d_KxK_block() has a trip count that depends on F only. Once F is a
+  constant, the loops are fully unrolled and every switch folds into a single
+  instruction. Each supported F gets its own instance of the kernel.
+
+  The rows are processed in vertical slices of columns that fit in a vector
+  register together with their F - 1 elements of padding, so there is no limit
+  on the number of columns.
+*/
+
+#include "fconv2d.h"
+
+//////////////////////
+// Vector registers //
+//////////////////////
+
+#define FCONV2D_VREGS(X, a)                                                    \
+  X(a, 0) X(a, 1) X(a, 2) X(a, 3) X(a, 4) X(a, 5) X(a, 6) X(a, 7) X(a, 8)      \
+  X(a, 9) X(a, 10) X(a, 11) X(a, 12) X(a, 13) X(a, 14) X(a, 15) X(a, 16)       \
+  X(a, 17) X(a, 18) X(a, 19) X(a, 20) X(a, 21) X(a, 22) X(a, 23) X(a, 24)      \
+  X(a, 25) X(a, 26) X(a, 27) X(a, 28) X(a, 29) X(a, 30) X(a, 31)
+
+// Same as FCONV2D_VREGS, to nest the switches on two registers
+#define FCONV2D_VREGS_(X, a)                                                   \
+  X(a, 0) X(a, 1) X(a, 2) X(a, 3) X(a, 4) X(a, 5) X(a, 6) X(a, 7) X(a, 8)      \
+  X(a, 9) X(a, 10) X(a, 11) X(a, 12) X(a, 13) X(a, 14) X(a, 15) X(a, 16)       \
+  X(a, 17) X(a, 18) X(a, 19) X(a, 20) X(a, 21) X(a, 22) X(a, 23) X(a, 24)      \
+  X(a, 25) X(a, 26) X(a, 27) X(a, 28) X(a, 29) X(a, 30) X(a, 31)
+
+#define FCONV2D_INLINE static inline __attribute__((always_inline))
+
+FCONV2D_INLINE unsigned long int fconv2d_KxK_setvl(unsigned long int avl,
+                                                   int64_t lmul) {
+  unsigned long int vl;
+
+  if (lmul == 1)
+    asm volatile("vsetvli %0, %1, e64, m1, ta, ma" : "=r"(vl) : "r"(avl));
+  else
+    asm volatile("vsetvli %0, %1, e64, m2, ta, ma" : "=r"(vl) : "r"(avl));
+
+  return vl;
+}
+
+FCONV2D_INLINE void fconv2d_KxK_vle64(int vd, const double *i) {
+#define FCONV2D_VLE64(a, d)                                                    \
+  case d:                                                                      \
+    asm volatile("vle64.v v" #d ", (%0)" ::"r"(i));                            \
+    break;
+  switch (vd) { FCONV2D_VREGS(FCONV2D_VLE64, _) }
+#undef FCONV2D_VLE64
+}
+
+FCONV2D_INLINE void fconv2d_KxK_vse64(int vs, double *o) {
+#define FCONV2D_VSE64(a, s)                                                    \
+  case s:                                                                      \
+    asm volatile("vse64.v v" #s ", (%0)" ::"r"(o));                            \
+    break;
+  switch (vs) { FCONV2D_VREGS(FCONV2D_VSE64, _) }
+#undef FCONV2D_VSE64
+}
+
+// vd = vs * f, or vd += vs * f
+FCONV2D_INLINE void fconv2d_KxK_vfmacc(int init, int vd, double f, int vs) {
+#define FCONV2D_VFMACC_VS(d, s)                                                \
+  case s:                                                                      \
+    if (init)                                                                  \
+      asm volatile("vfmul.vf v" #d ", v" #s ", %0" ::"f"(f));                  \
+    else                                                                       \
+      asm volatile("vfmacc.vf v" #d ", %0, v" #s ::"f"(f));                    \
+    break;
+#define FCONV2D_VFMACC_VD(a, d)                                                \
+  case d:                                                                      \
+    switch (vs) { FCONV2D_VREGS_(FCONV2D_VFMACC_VS, d) }                       \
+    break;
+  switch (vd) { FCONV2D_VREGS(FCONV2D_VFMACC_VD, _) }
+#undef FCONV2D_VFMACC_VD
+#undef FCONV2D_VFMACC_VS
+}
+
+// vd = vs slid down by off elements
+FCONV2D_INLINE void fconv2d_KxK_vslidedown(int vd, int vs, int64_t off) {
+#define FCONV2D_VSLIDEDOWN_VS(d, s)                                            \
+  case s:                                                                      \
+    asm volatile("vslidedown.vx v" #d ", v" #s ", %0" ::"r"(off));             \
+    break;
+#define FCONV2D_VSLIDEDOWN_VD(a, d)                                            \
+  case d:                                                                      \
+    switch (vs) { FCONV2D_VREGS_(FCONV2D_VSLIDEDOWN_VS, d) }                   \
+    break;
+  switch (vd) { FCONV2D_VREGS(FCONV2D_VSLIDEDOWN_VD, _) }
+#undef FCONV2D_VSLIDEDOWN_VD
+#undef FCONV2D_VSLIDEDOWN_VS
+}
+
+FCONV2D_INLINE void fconv2d_KxK_vmv(int vd, int vs) {
+#define FCONV2D_VMV_VS(d, s)                                                   \
+  case s:                                                                      \
+    asm volatile("vmv.v.v v" #d ", v" #s);                                     \
+    break;
+#define FCONV2D_VMV_VD(a, d)                                                   \
+  case d:                                                                      \
+    switch (vs) { FCONV2D_VREGS_(FCONV2D_VMV_VS, d) }                          \
+    break;
+  switch (vd) { FCONV2D_VREGS(FCONV2D_VMV_VD, _) }
+#undef FCONV2D_VMV_VD
+#undef FCONV2D_VMV_VS
+}
+
+////////////
+// Kernel //
+////////////
+
+// The VRF holds FCONV2D_KXK_BLOCK output rows, F + FCONV2D_KXK_BLOCK - 1
+// input rows, and two slid input rows. Use LMUL = 2 if they fit.
+FCONV2D_INLINE int64_t fconv2d_KxK_lmul(int64_t F) {
+  return (2 * FCONV2D_KXK_BLOCK + F + 1 <= 16) ? 2 : 1;
+}
+
+// Register of the output row b
+FCONV2D_INLINE int fconv2d_KxK_vo(int64_t b, int64_t F) {
+  return fconv2d_KxK_lmul(F) * b;
+}
+
+// Register of the input row r of the block
+FCONV2D_INLINE int fconv2d_KxK_vi(int64_t r, int64_t F) {
+  return fconv2d_KxK_lmul(F) * (FCONV2D_KXK_BLOCK + r);
+}
+
+// Register of the slid input row, alternating between two to let a slide run
+// while the previous one is in use
+FCONV2D_INLINE int fconv2d_KxK_vs(int64_t k, int64_t F) {
+  return fconv2d_KxK_lmul(F) * (2 * FCONV2D_KXK_BLOCK + F - 1 + (k & 1));
+}
+
+// Convolve a slice of n_ columns
+FCONV2D_INLINE void fconv2d_KxK_block(double *o, double *i, double *f,
+                                      int64_t R, int64_t C, int64_t n_,
+                                      int64_t F) {
+  const int64_t lmul = fconv2d_KxK_lmul(F);
+  const int64_t ldi = C + F - 1;
+
+  // Preload the first F - 1 input rows
+  fconv2d_KxK_setvl(n_ + F - 1, lmul);
+#pragma clang loop unroll(full)
+  for (int64_t r = 0; r < F - 1; ++r)
+    fconv2d_KxK_vle64(fconv2d_KxK_vi(r, F), i + r * ldi);
+  i += (F - 1) * ldi;
+
+  for (int64_t r = 0; r < R; r += FCONV2D_KXK_BLOCK) {
+    // Fetch n_ + F - 1 elements (padding included) of the next input rows
+    fconv2d_KxK_setvl(n_ + F - 1, lmul);
+#pragma clang loop unroll(full)
+    for (int64_t b = 0; b < FCONV2D_KXK_BLOCK; ++b)
+      fconv2d_KxK_vle64(fconv2d_KxK_vi(F - 1 + b, F), i + b * ldi);
+    i += FCONV2D_KXK_BLOCK * ldi;
+
+    // Compute on n_ elements
+    fconv2d_KxK_setvl(n_, lmul);
+
+    // Contributions of the input row j, on the output rows j - F + 1 to j
+#pragma clang loop unroll(full)
+    for (int64_t j = 0; j < F + FCONV2D_KXK_BLOCK - 1; ++j) {
+#pragma clang loop unroll(full)
+      for (int64_t k = 0; k < F; ++k) {
+        int vs = fconv2d_KxK_vi(j, F);
+        if (k != 0) {
+          fconv2d_KxK_vslidedown(fconv2d_KxK_vs(k, F), vs, k);
+          vs = fconv2d_KxK_vs(k, F);
+        }
+#pragma clang loop unroll(full)
+        for (int64_t b = 0; b < FCONV2D_KXK_BLOCK; ++b)
+          if (b <= j && j - b < F)
+            fconv2d_KxK_vfmacc(j == b && k == 0, fconv2d_KxK_vo(b, F),
+                               f[(j - b) * F + k], vs);
+      }
+
+      // The output row j - F + 1 is complete
+      if (j >= F - 1)
+        fconv2d_KxK_vse64(fconv2d_KxK_vo(j - F + 1, F), o + (j - F + 1) * C);
+    }
+    o += FCONV2D_KXK_BLOCK * C;
+
+    // Re-use the last F - 1 input rows
+    fconv2d_KxK_setvl(n_ + F - 1, lmul);
+#pragma clang loop unroll(full)
+    for (int64_t r = 0; r < F - 1; ++r)
+      fconv2d_KxK_vmv(fconv2d_KxK_vi(r, F),
+                      fconv2d_KxK_vi(FCONV2D_KXK_BLOCK + r, F));
+  }
+}
+
+FCONV2D_INLINE void fconv2d_KxK_slices(double *o, double *i, double *f,
+                                       int64_t R, int64_t C, int64_t F) {
+  // Every slice of columns must fit in a vector register with its padding
+  const int64_t lmul = fconv2d_KxK_lmul(F);
+  const int64_t block_size_n = MIN(C + F - 1, VLMAX(64, lmul)) - (F - 1);
+
+  for (int64_t n = 0; n < C; n += block_size_n) {
+    const int64_t n_ = MIN(C - n, block_size_n);
+    fconv2d_KxK_block(o + n, i + n, f, R, C, n_, F);
+  }
+}
+
+// One instance of the kernel per filter size
+#define FCONV2D_KXK_INSTANCE(K)                                                \
+  static void fconv2d_KxK_##K(double *o, double *i, double *f, int64_t R,    \
+                              int64_t C) {                                     \
+    fconv2d_KxK_slices(o, i, f, R, C, K);                                      \
+  }
+
+FCONV2D_KXK_INSTANCE(1)
+FCONV2D_KXK_INSTANCE(3)
+FCONV2D_KXK_INSTANCE(5)
+FCONV2D_KXK_INSTANCE(7)
+FCONV2D_KXK_INSTANCE(9)
+FCONV2D_KXK_INSTANCE(11)
+
+void fconv2d_KxK(double *o, double *i, double *f, int64_t R, int64_t C,
+                 int64_t F) {
+  switch (F) {
+  case 1:
+    fconv2d_KxK_1(o, i, f, R, C);
+    break;
+  case 3:
+    fconv2d_KxK_3(o, i, f, R, C);
+    break;
+  case 5:
+    fconv2d_KxK_5(o, i, f, R, C);
+    break;
+  case 7:
+    fconv2d_KxK_7(o, i, f, R, C);
+    break;
+  case 9:
+    fconv2d_KxK_9(o, i, f, R, C);
+    break;
+  case 11:
+    fconv2d_KxK_11(o, i, f, R, C);
+    break;
+  }
+}
@@ -76,14 +76,25 @@ int main() {
   printf("\n");
   printf("\n");
 
+  if (F % 2 == 0 || F > FCONV2D_KXK_MAX_F) {
+    printf("Error: the filter size must be odd, and at most %d.\n",
+           FCONV2D_KXK_MAX_F);
+    return -1;
+  }
+
   // Call the main kernel, and measure cycles
+  // The hand-tuned kernels are used for 3x3 and 7x7, unless FCONV2D_KXK is
+  // defined to compare them with the generic one. The 3x3 one does not slice
+  // the columns: wider images use the generic one.
   start_timer();
-  if (F == 3)
+#ifndef FCONV2D_KXK
+  if (F == 3 && N <= FCONV2D_3X3_MAX_C)
     fconv2d_3x3(o, i, f, M, N, F);
   else if (F == 7)
     fconv2d_7x7(o, i, f, M, N, F);
   else
-    printf("Error: the filter size is different from 3 or 5 or 7.\n");
+#endif
+    fconv2d_KxK(o, i, f, M, N, F);
   stop_timer();
 
   // Performance metrics
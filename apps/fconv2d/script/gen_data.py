@@ -19,6 +19,7 @@
 # arg1: image size, arg2: filter size
 
 import numpy as np
+import os
 import sys
 
 def convolve2D(kernel, image, padding):
@@ -56,22 +57,12 @@ def convolve2D(kernel, image, padding):
 
     return output
 
-def emit(name, array, alignment='8'):
-	print(".global %s" % name)
-	print(".balign " + alignment)
-	print("%s:" % name)
-	bs = array.tobytes()
-	for i in range(0, len(bs), 4):
-		s = ""
-		for n in range(4):
-			s += "%02x" % bs[i+3-n]
-		print("    .word 0x%s" % s)
-
-# Define the filter size and the matrix dimension (max, for now, is 128 64-bit elements)
+sys.path.insert(0, os.path.join(os.path.dirname(__file__), '../../common/script'))
+from data_emit import emit
+
+# Define the filter size and the matrix dimension
 if len(sys.argv) > 1:
 	matrix_width = int(sys.argv[1])
-	assert(matrix_width <= 128), "The width of the image cannot be greater than 128 64-bit \
-	                                  elements. If this is not enough, modify the algorithm."
 	f = int(sys.argv[2])
 	# Filter size must be odd
 	assert(f % 2 == 1), "The filter size must be an odd integer number"
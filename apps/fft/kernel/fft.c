@@ -531,21 +531,24 @@ vfloat32m1_t cmplx_mul_im_vv(vfloat32m1_t v0_re, vfloat32m1_t v0_im,
 float *cmplx2reim(v2f *cmplx, float *buf, size_t len) {
 
   float *cmplx_flat_ptr = (float *)cmplx;
+  size_t vl;
 
-  // Divide the real and img parts
-  for (unsigned int i = 0; i < len; ++i) {
-    // Backup the img parts
-    buf[i] = cmplx[i][1];
-  }
-  for (unsigned int i = 0; i < len; ++i) {
+  // Divide the real and img parts with segment loads
+  for (size_t i = 0; i < len; i += vl) {
+    vl = vsetvl_e32m4(len - i);
+    vfloat32m4_t re, im;
+    vlseg2e32_v_f32m4(&re, &im, cmplx_flat_ptr + 2 * i, vl);
     // Save the real parts
-    // No RAW hazards on mem in this way
-    cmplx_flat_ptr[i] = cmplx[i][0];
+    // No RAW hazards on mem in this way, as i + vl <= 2 * (i + vl)
+    vse32_v_f32m4(cmplx_flat_ptr + i, re, vl);
+    // Backup the img parts
+    vse32_v_f32m4(buf + i, im, vl);
   }
 
-  for (unsigned int i = 0; i < len; ++i) {
+  for (size_t i = 0; i < len; i += vl) {
+    vl = vsetvl_e32m4(len - i);
     // Save the img parts
-    cmplx_flat_ptr[i + len] = buf[i];
+    vse32_v_f32m4(cmplx_flat_ptr + len + i, vle32_v_f32m4(buf + i, vl), vl);
   }
 
   return cmplx_flat_ptr;
@@ -746,3 +749,83 @@ void fft_r2dif_vec(float *samples_re, float *samples_im,
   vsuxei32_v_f32m1(samples_re + vl, bindex, lower_wing_re, vl);
   vsuxei32_v_f32m1(samples_im + vl, bindex, lower_wing_im, vl);
 }
+
+// Q15 version of fft_r2dif_vec, with the same masks, output indices, and split
+// layout of the samples and twiddles. As in Radix2FFT_DIF, the wings of every
+// stage but the last are halved, so the output is the FFT scaled down by
+// n_fft / 2. The products round to nearest (vsmul) instead of truncating.
+// LMUL == 1: n_fft / 2 must not exceed VLMAX at SEW=16
+void fft_r2dif_q15_vec(int16_t *samples_re, int16_t *samples_im,
+                       const int16_t *twiddles_re, const int16_t *twiddles_im,
+                       const uint8_t **mask_addr_vec, const uint32_t *index_ptr,
+                       size_t n_fft) {
+
+  // vl of the vectors (each vector contains half of the samples)
+  size_t vl = n_fft / 2;
+  size_t vl_slamt = vl / 2;
+  unsigned int log2_nfft = 31 - __builtin_clz(n_fft);
+  vint16m1_t upper_wing_re, upper_wing_im;
+  vint16m1_t lower_wing_re, lower_wing_im;
+  vint16m1_t twiddle_re, twiddle_im;
+  vint16m1_t diff_re, diff_im, vbuf_re, vbuf_im;
+  vbool16_t mask_vec, mask_vec_buf;
+  vuint32m2_t index, bindex;
+
+  // Round to nearest up
+  asm volatile("csrwi vxrm, 0");
+  vsetvl_e16m1(vl);
+
+  upper_wing_re = vle16_v_i16m1(samples_re, vl);
+  lower_wing_re = vle16_v_i16m1(samples_re + vl, vl);
+  upper_wing_im = vle16_v_i16m1(samples_im, vl);
+  lower_wing_im = vle16_v_i16m1(samples_im + vl, vl);
+
+  for (unsigned int i = 0; i < log2_nfft - 1; ++i) {
+    twiddle_re = vle16_v_i16m1(twiddles_re + i * vl, vl);
+    twiddle_im = vle16_v_i16m1(twiddles_im + i * vl, vl);
+    mask_vec = vlm_v_b16(mask_addr_vec[i], vl);
+
+    // 1) Get the upper wing output, halved
+    vbuf_re = vaadd_vv_i16m1(upper_wing_re, lower_wing_re, vl);
+    vbuf_im = vaadd_vv_i16m1(upper_wing_im, lower_wing_im, vl);
+    // 2) Get the lower wing output, halved
+    diff_re = vasub_vv_i16m1(upper_wing_re, lower_wing_re, vl);
+    diff_im = vasub_vv_i16m1(upper_wing_im, lower_wing_im, vl);
+    // 3) Multiply lower wing for the twiddle factor
+    lower_wing_re = vssub_vv_i16m1(vsmul_vv_i16m1(diff_re, twiddle_re, vl),
+                                   vsmul_vv_i16m1(diff_im, twiddle_im, vl), vl);
+    lower_wing_im = vsadd_vv_i16m1(vsmul_vv_i16m1(diff_re, twiddle_im, vl),
+                                   vsmul_vv_i16m1(diff_im, twiddle_re, vl), vl);
+
+    // Permutate the numbers
+    mask_vec_buf = vmnot_m_b16(mask_vec, vl);
+    diff_re =
+        vslidedown_vx_i16m1_m(mask_vec_buf, diff_re, vbuf_re, vl_slamt, vl);
+    diff_im =
+        vslidedown_vx_i16m1_m(mask_vec_buf, diff_im, vbuf_im, vl_slamt, vl);
+    upper_wing_re =
+        vslideup_vx_i16m1_m(mask_vec, vbuf_re, lower_wing_re, vl_slamt, vl);
+    upper_wing_im =
+        vslideup_vx_i16m1_m(mask_vec, vbuf_im, lower_wing_im, vl_slamt, vl);
+    lower_wing_re = vmerge_vvm_i16m1(mask_vec, diff_re, lower_wing_re, vl);
+    lower_wing_im = vmerge_vvm_i16m1(mask_vec, diff_im, lower_wing_im, vl);
+
+    vl_slamt >>= 1;
+  }
+
+  // Last stage: the twiddles are all (1, 0), and there is no scaling
+  vbuf_re = vsadd_vv_i16m1(upper_wing_re, lower_wing_re, vl);
+  vbuf_im = vsadd_vv_i16m1(upper_wing_im, lower_wing_im, vl);
+  lower_wing_re = vssub_vv_i16m1(upper_wing_re, lower_wing_re, vl);
+  lower_wing_im = vssub_vv_i16m1(upper_wing_im, lower_wing_im, vl);
+
+  // Get the indexes for the final store
+  index = vle32_v_u32m2(index_ptr, vl);
+  bindex = vmul_vx_u32m2(index, sizeof(int16_t), vl);
+
+  // Store indexed
+  vsuxei32_v_i16m1(samples_re, bindex, vbuf_re, vl);
+  vsuxei32_v_i16m1(samples_im, bindex, vbuf_im, vl);
+  vsuxei32_v_i16m1(samples_re + vl, bindex, lower_wing_re, vl);
+  vsuxei32_v_i16m1(samples_im + vl, bindex, lower_wing_im, vl);
+}
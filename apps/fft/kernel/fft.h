@@ -11,6 +11,52 @@ void fft_r2dif_vec(float *samples_re, float *samples_im,
                    const float *twiddles_re, const float *twiddles_im,
                    const uint8_t **mask_addr_vec, const uint32_t *index_ptr,
                    size_t n_fft);
+void fft_r2dif_q15_vec(int16_t *samples_re, int16_t *samples_im,
+                       const int16_t *twiddles_re, const int16_t *twiddles_im,
+                       const uint8_t **mask_addr_vec, const uint32_t *index_ptr,
+                       size_t n_fft);
+
+// Plan of the radix-4 Stockham FFT of n samples, n a power of two. tw holds
+// the twiddles of the radix-4 stages, and buf is the ping-pong buffer of the
+// stages, both of FFT_PLAN_LEN(n) floats.
+typedef struct {
+  size_t n;
+  unsigned int log2_n;
+  const float *tw;
+  float *buf;
+} fft_plan_t;
+
+#define FFT_PLAN_LEN(n) (2 * (n))
+
+void fft_plan_init(fft_plan_t *plan, size_t n, float *tw, float *buf);
+void fft_r4_vec(const fft_plan_t *plan, float *samples_re, float *samples_im);
+void fft_r4_vec_cplx(const fft_plan_t *plan, v2f *samples);
+void SetupTwiddlesLUT_float(v2f *Twiddles, int Nfft, int Inverse);
+
+// FFT of n real samples, and its inverse, through the complex FFT of the plan
+// of n/2 points. tw holds the FFT_RFFT_TW_LEN(n) twiddles of fft_rfft_init, and
+// the n/2 + 1 bins are split into real and imaginary parts.
+#define FFT_RFFT_TW_LEN(n) (n)
+
+void fft_rfft_init(float *tw, size_t n);
+void fft_rfft_vec(const fft_plan_t *plan, const float *tw, float *x,
+                  float *out_re, float *out_im);
+void fft_irfft_vec(const fft_plan_t *plan, const float *tw, const float *in_re,
+                   const float *in_im, float *x);
+
+// Batched FFTs of n points, vectorized across the batch, and 2D FFT. work has
+// FFT_BATCH_LEN(n, batch) floats.
+#define FFT_BATCH_LEN(n, batch) (2 * (n) * (batch))
+
+void fft_r4_vec_batch(const fft_plan_t *plan, float *samples_re,
+                      float *samples_im, size_t batch, size_t stride,
+                      size_t dist, float *work);
+void fft_r4_vec_batch_cplx(const fft_plan_t *plan, v2f *samples, size_t batch,
+                           size_t stride, size_t dist, float *work);
+void fft2d_r4_vec(const fft_plan_t *plan_rows, const fft_plan_t *plan_cols,
+                  float *samples_re, float *samples_im, size_t rows,
+                  size_t cols, float *work);
+
 static inline v2s cplxmuls(v2s x, v2s y);
 static inline v2f cplxmuls_float(v2f x, v2f y);
 static inline v2s cplxmulsdiv2(v2s x, v2s y);
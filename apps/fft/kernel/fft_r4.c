@@ -0,0 +1,525 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <math.h>
+
+#include "fft.h"
+#include "vmath/vmath.h"
+
+// Radix-4 Stockham FFT, with a final radix-2 stage if log2(n) is odd.
+//
+// The stage of length l (l = n, n/4, ...) and stride s = n/l reads the four
+// quarters of x, and writes its butterflies in the order of the next stage:
+//   a = x[q + s*p], b = x[q + s*(p + m)], c = x[q + s*(p + 2m)],
+//   d = x[q + s*(p + 3m)], with m = l/4, p < m, q < s
+//   y[q + s*4p]       = (a + c) + (b + d)
+//   y[q + s*(4p + 1)] = w^p  ((a - c) - j(b - d))
+//   y[q + s*(4p + 2)] = w^2p ((a + c) - (b + d))
+//   y[q + s*(4p + 3)] = w^3p ((a - c) + j(b - d)),  w = exp(-2 pi j / l)
+// so that the output is in natural order, without a bit-reversal. The stages
+// alternate between the samples and the buffer of the plan. The butterflies
+// are vectorized over p, with strided accesses, in the first stages, and over
+// q, with unit-stride accesses, once s >= m.
+
+/////////////////
+// Plan setup //
+/////////////////
+
+/* Setup floating-point twiddles factors: exp(-+2 pi j i / Nfft), i < Nfft,
+   with the cos and sin of each angle from one range reduction */
+void SetupTwiddlesLUT_float(v2f *Twiddles, int Nfft, int Inverse) {
+  const float Theta = (2 * M_PI) / Nfft;
+  const float Step = Inverse ? Theta : -Theta;
+  size_t vl;
+  for (size_t i = 0; i < (size_t)Nfft; i += vl) {
+    vl = vsetvl_e32m2(Nfft - i);
+    vuint32m2_t idx = vadd_vx_u32m2(vid_v_u32m2(vl), i, vl);
+    vfloat32m2_t phi = vfmul_vf_f32m2(vfcvt_f_xu_v_f32m2(idx, vl), Step, vl);
+    vfloat32m2_t c;
+    vfloat32m2_t s = vmath_sincos_f32m2(phi, &c, vl);
+    vsseg2e32_v_f32m2((float *)(Twiddles + i), c, s, vl);
+  }
+}
+
+// The radix-4 stage of length l keeps w^p, w^2p, w^3p for p < l/4: their real
+// parts, and then their imaginary parts
+void fft_plan_init(fft_plan_t *plan, size_t n, float *tw, float *buf) {
+  v2f *w_n = (v2f *)buf;
+  float *tw_ = tw;
+
+  plan->n = n;
+  plan->log2_n = 31 - __builtin_clz(n);
+  plan->tw = tw;
+  plan->buf = buf;
+
+  // w_l^k = w_n^(k * n / l). The buffer holds the twiddles of length n until
+  // the first transform.
+  SetupTwiddlesLUT_float(w_n, n, 0);
+  for (size_t l = n; l >= 4; l >>= 2) {
+    const size_t m = l >> 2;
+    for (size_t k = 1; k <= 3; ++k)
+      for (size_t p = 0; p < m; ++p) {
+        const v2f w = w_n[(k * p * (n / l)) % n];
+        tw_[(2 * (k - 1)) * m + p] = w[0];
+        tw_[(2 * (k - 1) + 1) * m + p] = w[1];
+      }
+    tw_ += 6 * m;
+  }
+}
+
+//////////////////////
+// Vector butterfly //
+//////////////////////
+
+// Samples, either split into real and imaginary parts, or interleaved. The
+// elements of a transform are es samples apart.
+typedef struct {
+  float *re;
+  float *im;
+  int cplx;
+  size_t es;
+} fft_r4_data_t;
+
+// Sample i, and element e of the transform
+static inline fft_r4_data_t fft_r4_off(fft_r4_data_t d, size_t i) {
+  if (d.cplx)
+    d.re += 2 * i;
+  else {
+    d.re += i;
+    d.im += i;
+  }
+  return d;
+}
+
+static inline fft_r4_data_t fft_r4_at(fft_r4_data_t d, size_t e) {
+  return fft_r4_off(d, e * d.es);
+}
+
+// Load and store vl samples, stride samples apart
+static inline void fft_r4_load(vfloat32m2_t *re, vfloat32m2_t *im,
+                               fft_r4_data_t d, size_t stride, size_t vl) {
+  if (d.cplx) {
+    if (stride == 1)
+      vlseg2e32_v_f32m2(re, im, d.re, vl);
+    else
+      vlsseg2e32_v_f32m2(re, im, d.re, 2 * stride * sizeof(float), vl);
+  } else if (stride == 1) {
+    *re = vle32_v_f32m2(d.re, vl);
+    *im = vle32_v_f32m2(d.im, vl);
+  } else {
+    *re = vlse32_v_f32m2(d.re, stride * sizeof(float), vl);
+    *im = vlse32_v_f32m2(d.im, stride * sizeof(float), vl);
+  }
+}
+
+static inline void fft_r4_store(fft_r4_data_t d, vfloat32m2_t re,
+                                vfloat32m2_t im, size_t stride, size_t vl) {
+  if (d.cplx) {
+    if (stride == 1)
+      vsseg2e32_v_f32m2(d.re, re, im, vl);
+    else
+      vssseg2e32_v_f32m2(d.re, 2 * stride * sizeof(float), re, im, vl);
+  } else if (stride == 1) {
+    vse32_v_f32m2(d.re, re, vl);
+    vse32_v_f32m2(d.im, im, vl);
+  } else {
+    vsse32_v_f32m2(d.re, stride * sizeof(float), re, vl);
+    vsse32_v_f32m2(d.im, stride * sizeof(float), im, vl);
+  }
+}
+
+// Multiply by the twiddles w_re[0], w_im[0], either vectors (vtw) or scalars
+static inline void fft_r4_twiddle(fft_r4_data_t y, vfloat32m2_t v_re,
+                                  vfloat32m2_t v_im, const float *w_re,
+                                  const float *w_im, int vtw, size_t ys,
+                                  size_t vl) {
+  vfloat32m2_t o_re, o_im;
+
+  if (vtw) {
+    vfloat32m2_t tw_re = vle32_v_f32m2(w_re, vl);
+    vfloat32m2_t tw_im = vle32_v_f32m2(w_im, vl);
+    o_re = vfmul_vv_f32m2(v_re, tw_re, vl);
+    o_re = vfnmsac_vv_f32m2(o_re, v_im, tw_im, vl);
+    o_im = vfmul_vv_f32m2(v_re, tw_im, vl);
+    o_im = vfmacc_vv_f32m2(o_im, v_im, tw_re, vl);
+  } else {
+    o_re = vfmul_vf_f32m2(v_re, w_re[0], vl);
+    o_re = vfnmsac_vf_f32m2(o_re, w_im[0], v_im, vl);
+    o_im = vfmul_vf_f32m2(v_re, w_im[0], vl);
+    o_im = vfmacc_vf_f32m2(o_im, w_re[0], v_im, vl);
+  }
+  fft_r4_store(y, o_re, o_im, ys, vl);
+}
+
+// vl butterflies of a radix-4 stage. x and y point to the first input and
+// output, which are xs and ys samples apart, and the quarters of x are s * m
+// samples apart. The twiddles of k = 1, 2, 3 are at w_re[2 * (k - 1) * m],
+// w_im[2 * (k - 1) * m].
+static inline void fft_r4_butterfly(fft_r4_data_t y, fft_r4_data_t x,
+                                    const float *w_re, const float *w_im,
+                                    int vtw, size_t s, size_t m, size_t xs,
+                                    size_t ys, size_t vl) {
+  vfloat32m2_t a_re, a_im, b_re, b_im, c_re, c_im, d_re, d_im;
+  vfloat32m2_t t_re, t_im, u_re, u_im;
+
+  fft_r4_load(&a_re, &a_im, x, xs, vl);
+  fft_r4_load(&c_re, &c_im, fft_r4_at(x, 2 * s * m), xs, vl);
+  fft_r4_load(&b_re, &b_im, fft_r4_at(x, s * m), xs, vl);
+  fft_r4_load(&d_re, &d_im, fft_r4_at(x, 3 * s * m), xs, vl);
+
+  // a + c, a - c, b + d, b - d
+  t_re = vfadd_vv_f32m2(a_re, c_re, vl);
+  t_im = vfadd_vv_f32m2(a_im, c_im, vl);
+  a_re = vfsub_vv_f32m2(a_re, c_re, vl);
+  a_im = vfsub_vv_f32m2(a_im, c_im, vl);
+  u_re = vfadd_vv_f32m2(b_re, d_re, vl);
+  u_im = vfadd_vv_f32m2(b_im, d_im, vl);
+  b_re = vfsub_vv_f32m2(b_re, d_re, vl);
+  b_im = vfsub_vv_f32m2(b_im, d_im, vl);
+
+  // y0 = (a + c) + (b + d)
+  fft_r4_store(y, vfadd_vv_f32m2(t_re, u_re, vl),
+               vfadd_vv_f32m2(t_im, u_im, vl), ys, vl);
+
+  // (a + c) - (b + d), (a - c) - j(b - d), (a - c) + j(b - d)
+  c_re = vfsub_vv_f32m2(t_re, u_re, vl);
+  c_im = vfsub_vv_f32m2(t_im, u_im, vl);
+  t_re = vfadd_vv_f32m2(a_re, b_im, vl);
+  t_im = vfsub_vv_f32m2(a_im, b_re, vl);
+  d_re = vfsub_vv_f32m2(a_re, b_im, vl);
+  d_im = vfadd_vv_f32m2(a_im, b_re, vl);
+
+  // y1, y2, y3, with the twiddles of k = 1, 2, 3
+  fft_r4_twiddle(fft_r4_at(y, s), t_re, t_im, w_re, w_im, vtw, ys, vl);
+  fft_r4_twiddle(fft_r4_at(y, 2 * s), c_re, c_im, w_re + 2 * m, w_im + 2 * m,
+                 vtw, ys, vl);
+  fft_r4_twiddle(fft_r4_at(y, 3 * s), d_re, d_im, w_re + 4 * m, w_im + 4 * m,
+                 vtw, ys, vl);
+}
+
+static void fft_r4_stage(fft_r4_data_t y, fft_r4_data_t x, const float *tw,
+                         size_t n, size_t l) {
+  const size_t s = n / l;
+  const size_t m = l >> 2;
+  // w^kp, real and imaginary parts, of k = 1 are at tw[p], tw[m + p]
+  const float *w_re = tw;
+  const float *w_im = tw + m;
+  size_t vl;
+
+  if (s < m) {
+    // Vectors of p, with strided accesses
+    for (size_t q = 0; q < s; ++q)
+      for (size_t p = 0; p < m; p += vl) {
+        vl = vsetvl_e32m2(m - p);
+        fft_r4_butterfly(fft_r4_at(y, q + 4 * s * p), fft_r4_at(x, q + s * p),
+                         w_re + p, w_im + p, 1, s, m, s, 4 * s, vl);
+      }
+  } else {
+    // Vectors of q, with unit-stride accesses and scalar twiddles
+    for (size_t p = 0; p < m; ++p)
+      for (size_t q = 0; q < s; q += vl) {
+        vl = vsetvl_e32m2(s - q);
+        fft_r4_butterfly(fft_r4_at(y, q + 4 * s * p), fft_r4_at(x, q + s * p),
+                         w_re + p, w_im + p, 0, s, m, 1, 1, vl);
+      }
+  }
+}
+
+// Last stage of an odd log2(n): y[q] = x[q] + x[q + n/2],
+// y[q + n/2] = x[q] - x[q + n/2]
+static void fft_r2_stage(fft_r4_data_t y, fft_r4_data_t x, size_t n) {
+  const size_t s = n >> 1;
+  size_t vl;
+
+  for (size_t q = 0; q < s; q += vl) {
+    vfloat32m2_t a_re, a_im, b_re, b_im;
+    vl = vsetvl_e32m2(s - q);
+
+    fft_r4_load(&a_re, &a_im, fft_r4_at(x, q), 1, vl);
+    fft_r4_load(&b_re, &b_im, fft_r4_at(x, q + s), 1, vl);
+    fft_r4_store(fft_r4_at(y, q), vfadd_vv_f32m2(a_re, b_re, vl),
+                 vfadd_vv_f32m2(a_im, b_im, vl), 1, vl);
+    fft_r4_store(fft_r4_at(y, q + s), vfsub_vv_f32m2(a_re, b_re, vl),
+                 vfsub_vv_f32m2(a_im, b_im, vl), 1, vl);
+  }
+}
+
+static void fft_r4_run(const fft_plan_t *plan, fft_r4_data_t x,
+                       fft_r4_data_t buf) {
+  const size_t n = plan->n;
+  const float *tw = plan->tw;
+  fft_r4_data_t src = x, dst = buf;
+
+  for (size_t l = n; l >= 4; l >>= 2) {
+    fft_r4_stage(dst, src, tw, n, l);
+    tw += 6 * (l >> 2);
+    fft_r4_data_t t = src;
+    src = dst;
+    dst = t;
+  }
+  if (plan->log2_n & 1) {
+    fft_r2_stage(dst, src, n);
+    fft_r4_data_t t = src;
+    src = dst;
+    dst = t;
+  }
+
+  // The result is in the buffer after an odd number of stages
+  if (src.re != x.re) {
+    const size_t len = x.cplx ? 2 * n : n;
+    size_t vl;
+    for (size_t i = 0; i < len; i += vl) {
+      vl = vsetvl_e32m8(len - i);
+      vse32_v_f32m8(x.re + i, vle32_v_f32m8(src.re + i, vl), vl);
+      if (!x.cplx)
+        vse32_v_f32m8(x.im + i, vle32_v_f32m8(src.im + i, vl), vl);
+    }
+  }
+}
+
+// In-place FFT of split real and imaginary parts
+void fft_r4_vec(const fft_plan_t *plan, float *samples_re, float *samples_im) {
+  fft_r4_data_t x = {samples_re, samples_im, 0, 1};
+  fft_r4_data_t buf = {plan->buf, plan->buf + plan->n, 0, 1};
+  fft_r4_run(plan, x, buf);
+}
+
+// In-place FFT of interleaved complex samples, with segment memory operations
+void fft_r4_vec_cplx(const fft_plan_t *plan, v2f *samples) {
+  fft_r4_data_t x = {(float *)samples, 0, 1, 1};
+  fft_r4_data_t buf = {plan->buf, 0, 1, 1};
+  fft_r4_run(plan, x, buf);
+}
+
+/////////////////////
+// Batched and 2D //
+/////////////////////
+
+// The transforms of a batch are vectorized across the batch: each butterfly
+// of the 1D FFT is computed on vl transforms at once, with scalar twiddles, so
+// that vl does not shrink in the later stages of small FFTs. The vector
+// elements are xs and ys samples apart.
+static void fft_r4_stage_batch(fft_r4_data_t y, fft_r4_data_t x,
+                               const float *tw, size_t n, size_t l, size_t xs,
+                               size_t ys, size_t vl) {
+  const size_t s = n / l;
+  const size_t m = l >> 2;
+
+  for (size_t p = 0; p < m; ++p)
+    for (size_t q = 0; q < s; ++q)
+      fft_r4_butterfly(fft_r4_at(y, q + 4 * s * p), fft_r4_at(x, q + s * p),
+                       tw + p, tw + m + p, 0, s, m, xs, ys, vl);
+}
+
+static void fft_r2_stage_batch(fft_r4_data_t y, fft_r4_data_t x, size_t n,
+                               size_t xs, size_t ys, size_t vl) {
+  const size_t s = n >> 1;
+
+  for (size_t q = 0; q < s; ++q) {
+    vfloat32m2_t a_re, a_im, b_re, b_im;
+
+    fft_r4_load(&a_re, &a_im, fft_r4_at(x, q), xs, vl);
+    fft_r4_load(&b_re, &b_im, fft_r4_at(x, q + s), xs, vl);
+    fft_r4_store(fft_r4_at(y, q), vfadd_vv_f32m2(a_re, b_re, vl),
+                 vfadd_vv_f32m2(a_im, b_im, vl), ys, vl);
+    fft_r4_store(fft_r4_at(y, q + s), vfsub_vv_f32m2(a_re, b_re, vl),
+                 vfsub_vv_f32m2(a_im, b_im, vl), ys, vl);
+  }
+}
+
+// All the stages of a chunk of vl transforms, which are dist samples apart in
+// x. The chunk ping-pongs with work, where its transforms are contiguous.
+static void fft_r4_run_batch(const fft_plan_t *plan, fft_r4_data_t x,
+                             size_t batch, size_t dist, fft_r4_data_t work) {
+  const size_t n = plan->n;
+  size_t vl;
+
+  for (size_t b = 0; b < batch; b += vl) {
+    vl = vsetvl_e32m2(batch - b);
+
+    const float *tw = plan->tw;
+    fft_r4_data_t src = fft_r4_off(x, b * dist), dst = work;
+    size_t src_vs = dist, dst_vs = 1;
+    dst.es = vl;
+
+    for (size_t l = n; l >= 2; l >>= 2) {
+      if (l >= 4) {
+        fft_r4_stage_batch(dst, src, tw, n, l, src_vs, dst_vs, vl);
+        tw += 6 * (l >> 2);
+      } else {
+        fft_r2_stage_batch(dst, src, n, src_vs, dst_vs, vl);
+      }
+      fft_r4_data_t t = src;
+      size_t t_vs = src_vs;
+      src = dst;
+      src_vs = dst_vs;
+      dst = t;
+      dst_vs = t_vs;
+    }
+
+    // The result is in the work buffer after an odd number of stages
+    if (src.re == work.re) {
+      for (size_t i = 0; i < n; ++i) {
+        vfloat32m2_t re, im;
+        fft_r4_load(&re, &im, fft_r4_at(src, i), 1, vl);
+        fft_r4_store(fft_r4_at(dst, i), re, im, dist, vl);
+      }
+    }
+  }
+}
+
+// In-place FFTs of a batch of split samples. Element i of the transform b is
+// the sample i * stride + b * dist.
+void fft_r4_vec_batch(const fft_plan_t *plan, float *samples_re,
+                      float *samples_im, size_t batch, size_t stride,
+                      size_t dist, float *work) {
+  fft_r4_data_t x = {samples_re, samples_im, 0, stride};
+  fft_r4_data_t buf = {work, work + plan->n * batch, 0, 1};
+  fft_r4_run_batch(plan, x, batch, dist, buf);
+}
+
+// In-place FFTs of a batch of interleaved samples
+void fft_r4_vec_batch_cplx(const fft_plan_t *plan, v2f *samples, size_t batch,
+                           size_t stride, size_t dist, float *work) {
+  fft_r4_data_t x = {(float *)samples, 0, 1, stride};
+  fft_r4_data_t buf = {work, 0, 1, 1};
+  fft_r4_run_batch(plan, x, batch, dist, buf);
+}
+
+// In-place 2D FFT of a rows x cols image of split samples, stored by rows:
+// the FFTs of the rows, vectorized across the rows with strided accesses, and
+// then the FFTs of the columns, vectorized across the columns with unit-stride
+// accesses. plan_rows is the plan of cols points, and plan_cols of rows points.
+// They can be the same plan for a square image.
+void fft2d_r4_vec(const fft_plan_t *plan_rows, const fft_plan_t *plan_cols,
+                  float *samples_re, float *samples_im, size_t rows,
+                  size_t cols, float *work) {
+  fft_r4_vec_batch(plan_rows, samples_re, samples_im, rows, 1, cols, work);
+  fft_r4_vec_batch(plan_cols, samples_re, samples_im, cols, cols, 1, work);
+}
+
+////////////////
+// Real input //
+////////////////
+
+// The n real samples x are the n/2 complex samples z[i] = x[2i] + j x[2i+1],
+// whose FFT Z gives the n/2 + 1 bins of x, with w = exp(-2 pi j / n):
+//   X[k] = (Z[k] + conj(Z[n/2-k])) / 2 - j w^k (Z[k] - conj(Z[n/2-k])) / 2
+// and the other way around for the inverse. The mirrored Z[n/2-k] are read
+// with negative strides.
+
+// w^k, k < n/2: their real parts, and then their imaginary parts
+void fft_rfft_init(float *tw, size_t n) {
+  const size_t m = n >> 1;
+  const float theta = (2 * M_PI) / n;
+  size_t vl;
+  for (size_t k = 0; k < m; k += vl) {
+    vl = vsetvl_e32m2(m - k);
+    vuint32m2_t idx = vadd_vx_u32m2(vid_v_u32m2(vl), k, vl);
+    vfloat32m2_t phi = vfmul_vf_f32m2(vfcvt_f_xu_v_f32m2(idx, vl), theta, vl);
+    vfloat32m2_t c;
+    vfloat32m2_t s = vmath_sincos_f32m2(phi, &c, vl);
+    vse32_v_f32m2(tw + k, c, vl);
+    vse32_v_f32m2(tw + m + k, vfneg_v_f32m2(s, vl), vl);
+  }
+}
+
+// FFT of the n real samples x, with the plan of n/2 points. x is overwritten,
+// and the n/2 + 1 bins go to out_re and out_im.
+void fft_rfft_vec(const fft_plan_t *plan, const float *tw, float *x,
+                  float *out_re, float *out_im) {
+  const size_t m = plan->n;
+  size_t vl;
+
+  fft_r4_vec_cplx(plan, (v2f *)x);
+
+  // The bins 0 and n/2 are real
+  out_re[0] = x[0] + x[1];
+  out_im[0] = 0;
+  out_re[m] = x[0] - x[1];
+  out_im[m] = 0;
+
+  for (size_t k = 1; k < m; k += vl) {
+    vfloat32m2_t a_re, a_im, b_re, b_im, s_re, s_im, d_re, d_im, w_re, w_im, y;
+    vl = vsetvl_e32m2(m - k);
+
+    vlseg2e32_v_f32m2(&a_re, &a_im, x + 2 * k, vl);
+    vlsseg2e32_v_f32m2(&b_re, &b_im, x + 2 * (m - k),
+                       -2 * (ptrdiff_t)sizeof(float), vl);
+    w_re = vle32_v_f32m2(tw + k, vl);
+    w_im = vle32_v_f32m2(tw + m + k, vl);
+
+    s_re = vfadd_vv_f32m2(a_re, b_re, vl);
+    d_re = vfsub_vv_f32m2(a_re, b_re, vl);
+    s_im = vfadd_vv_f32m2(a_im, b_im, vl);
+    d_im = vfsub_vv_f32m2(a_im, b_im, vl);
+
+    // 2 Re(X) = s_re + w_re s_im + w_im d_re
+    y = vfmacc_vv_f32m2(s_re, w_re, s_im, vl);
+    y = vfmacc_vv_f32m2(y, w_im, d_re, vl);
+    vse32_v_f32m2(out_re + k, vfmul_vf_f32m2(y, 0.5f, vl), vl);
+    // 2 Im(X) = d_im - w_re d_re + w_im s_im
+    y = vfnmsac_vv_f32m2(d_im, w_re, d_re, vl);
+    y = vfmacc_vv_f32m2(y, w_im, s_im, vl);
+    vse32_v_f32m2(out_im + k, vfmul_vf_f32m2(y, 0.5f, vl), vl);
+  }
+}
+
+// Inverse of fft_rfft_vec: the n real samples x of the n/2 + 1 bins in_re,
+// in_im. The inverse FFT of n/2 points is the forward one of the conjugates,
+// which the twiddle stage writes, and the final scaling conjugates back.
+void fft_irfft_vec(const fft_plan_t *plan, const float *tw, const float *in_re,
+                   const float *in_im, float *x) {
+  const size_t m = plan->n;
+  const float scale = 1.0f / (2 * m);
+  size_t vl;
+
+  for (size_t k = 0; k < m; k += vl) {
+    vfloat32m2_t a_re, a_im, b_re, b_im, s_re, s_im, d_re, d_im, w_re, w_im;
+    vfloat32m2_t z_re, z_im;
+    vl = vsetvl_e32m2(m - k);
+
+    a_re = vle32_v_f32m2(in_re + k, vl);
+    a_im = vle32_v_f32m2(in_im + k, vl);
+    b_re = vlse32_v_f32m2(in_re + m - k, -(ptrdiff_t)sizeof(float), vl);
+    b_im = vlse32_v_f32m2(in_im + m - k, -(ptrdiff_t)sizeof(float), vl);
+    w_re = vle32_v_f32m2(tw + k, vl);
+    w_im = vle32_v_f32m2(tw + m + k, vl);
+
+    s_re = vfadd_vv_f32m2(a_re, b_re, vl);
+    d_re = vfsub_vv_f32m2(a_re, b_re, vl);
+    s_im = vfadd_vv_f32m2(a_im, b_im, vl);
+    d_im = vfsub_vv_f32m2(a_im, b_im, vl);
+
+    // 2 conj(Z) = (s_re + w_im d_re - w_re s_im) - j(d_im + w_re d_re + w_im s_im)
+    z_re = vfmacc_vv_f32m2(s_re, w_im, d_re, vl);
+    z_re = vfnmsac_vv_f32m2(z_re, w_re, s_im, vl);
+    z_im = vfnmacc_vv_f32m2(d_im, w_re, d_re, vl);
+    z_im = vfnmsac_vv_f32m2(z_im, w_im, s_im, vl);
+    vsseg2e32_v_f32m2(x + 2 * k, z_re, z_im, vl);
+  }
+
+  fft_r4_vec_cplx(plan, (v2f *)x);
+
+  // x = conj(z) / (n/2), and the 2 of the twiddle stage
+  for (size_t i = 0; i < m; i += vl) {
+    vfloat32m2_t re, im;
+    vl = vsetvl_e32m2(m - i);
+    vlseg2e32_v_f32m2(&re, &im, x + 2 * i, vl);
+    vsseg2e32_v_f32m2(x + 2 * i, vfmul_vf_f32m2(re, scale, vl),
+                      vfmul_vf_f32m2(im, -scale, vl), vl);
+  }
+}
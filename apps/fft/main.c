@@ -30,6 +30,7 @@
 #endif
 
 #define MAX_NFFT 256
+#define MAX_BATCH 64
 
 #define DEBUG
 #undef DEBUG
@@ -51,11 +52,53 @@ v2f samples_copy[MAX_NFFT]
 v2f samples_vec[MAX_NFFT]
     __attribute__((aligned(32 * NR_LANES), section(".l2")));
 extern v2f gold_out[] __attribute__((aligned(32 * NR_LANES), section(".l2")));
+// Q15 samples, twiddles, and golden output of the fixed-point vector FFT
+extern int16_t samples_reim_q15[]
+    __attribute__((aligned(32 * NR_LANES), section(".l2")));
+extern int16_t twiddle_vec_reim_q15[]
+    __attribute__((aligned(32 * NR_LANES), section(".l2")));
+extern int16_t gold_q15[]
+    __attribute__((aligned(32 * NR_LANES), section(".l2")));
+// Real signal of the real-input FFT, an untouched copy, and its golden bins
+extern float rfft_x[] __attribute__((aligned(32 * NR_LANES), section(".l2")));
+extern float rfft_x_s[] __attribute__((aligned(32 * NR_LANES), section(".l2")));
+extern float gold_rfft[] __attribute__((aligned(32 * NR_LANES), section(".l2")));
+float rfft_tw[FFT_RFFT_TW_LEN(MAX_NFFT)]
+    __attribute__((aligned(32 * NR_LANES), section(".l2")));
+float rfft_bins[2 * (MAX_NFFT / 2 + 1)]
+    __attribute__((aligned(32 * NR_LANES), section(".l2")));
+float plan_tw_half[FFT_PLAN_LEN(MAX_NFFT / 2)]
+    __attribute__((aligned(32 * NR_LANES), section(".l2")));
+// Untouched copies of the samples, for the radix-4 FFT
+extern v2f samples_s[] __attribute__((aligned(32 * NR_LANES), section(".l2")));
+extern float samples_reim_s[]
+    __attribute__((aligned(32 * NR_LANES), section(".l2")));
+// Twiddles and buffer of the radix-4 plan
+float plan_tw[FFT_PLAN_LEN(MAX_NFFT)]
+    __attribute__((aligned(32 * NR_LANES), section(".l2")));
+float plan_buf[FFT_PLAN_LEN(MAX_NFFT)]
+    __attribute__((aligned(32 * NR_LANES), section(".l2")));
+// Batch of BATCH FFTs of NFFT points, and BATCH x NFFT image of the 2D FFT
+extern unsigned long int BATCH;
+extern float batch_reim[]
+    __attribute__((aligned(32 * NR_LANES), section(".l2")));
+extern float batch_2d_reim[]
+    __attribute__((aligned(32 * NR_LANES), section(".l2")));
+extern v2f gold_batch[] __attribute__((aligned(32 * NR_LANES), section(".l2")));
+extern v2f gold_2d[] __attribute__((aligned(32 * NR_LANES), section(".l2")));
+float plan_tw_2d[FFT_PLAN_LEN(MAX_BATCH)]
+    __attribute__((aligned(32 * NR_LANES), section(".l2")));
+float batch_work[FFT_BATCH_LEN(MAX_NFFT, MAX_BATCH)]
+    __attribute__((aligned(32 * NR_LANES), section(".l2")));
 signed short SwapTable[MAX_NFFT]
     __attribute__((aligned(32 * NR_LANES), section(".l2")));
 
 // Threshold for FP numbers comparison during the final check
 #define THRESHOLD 1
+// Threshold of the radix-4 FFT, compared with the golden output
+#define THRESHOLD_R4 0.01
+// Threshold of the Q15 FFT, in LSBs of the golden output
+#define THRESHOLD_Q15 16
 
 int main() {
   printf("\n");
@@ -241,6 +284,147 @@ int main() {
     }
   }
 
+  ////////////////////////
+  // Vector Q15 DIF FFT //
+  ////////////////////////
+
+  start_timer();
+  fft_r2dif_q15_vec(samples_reim_q15, samples_reim_q15 + NFFT,
+                    twiddle_vec_reim_q15,
+                    twiddle_vec_reim_q15 +
+                        ((NFFT >> 1) * (31 - __builtin_clz(NFFT))),
+                    mask_addr_vec, index_ptr, NFFT);
+  stop_timer();
+  runtime = get_timer();
+  printf("The Q15 execution took %d cycles.\n", runtime);
+
+  for (unsigned int i = 0; i < 2 * NFFT; ++i) {
+    int diff = samples_reim_q15[i] - gold_q15[i];
+    if (diff > THRESHOLD_Q15 || diff < -THRESHOLD_Q15) {
+      printf("Q15 error at index %d: %d instead of %d\n", i,
+             samples_reim_q15[i], gold_q15[i]);
+      error = 1;
+    }
+  }
+
+  /////////////////////////////
+  // Vector radix-4 Stockham //
+  /////////////////////////////
+
+  // The plan is set up once per size, out of the timed region
+  fft_plan_t plan;
+  fft_plan_init(&plan, NFFT, plan_tw, plan_buf);
+
+  start_timer();
+  fft_r4_vec(&plan, samples_reim_s, samples_reim_s + NFFT);
+  stop_timer();
+  runtime = get_timer();
+  printf("The radix-4 execution took %d cycles.\n", runtime);
+
+  start_timer();
+  fft_r4_vec_cplx(&plan, samples_s);
+  stop_timer();
+  runtime = get_timer();
+  printf("The interleaved radix-4 execution took %d cycles.\n", runtime);
+
+  // Both are in natural order
+  for (unsigned int i = 0; i < NFFT; ++i) {
+    if (!similarity_check_32b(samples_reim_s[i], gold_out[i][0],
+                              THRESHOLD_R4) ||
+        !similarity_check_32b(samples_reim_s[i + NFFT], gold_out[i][1],
+                              THRESHOLD_R4)) {
+      printf("Radix-4 error at index %d\n", i);
+      error = 1;
+    }
+    if (!similarity_check_32b(samples_s[i][0], gold_out[i][0],
+                              THRESHOLD_R4) ||
+        !similarity_check_32b(samples_s[i][1], gold_out[i][1],
+                              THRESHOLD_R4)) {
+      printf("Interleaved radix-4 error at index %d\n", i);
+      error = 1;
+    }
+  }
+
+  /////////////////////
+  // Real-input FFT //
+  /////////////////////
+
+  // Complex FFT of NFFT / 2 points
+  fft_plan_t plan_half;
+  fft_plan_init(&plan_half, NFFT / 2, plan_tw_half, plan_buf);
+  fft_rfft_init(rfft_tw, NFFT);
+  const unsigned long int nbins = NFFT / 2 + 1;
+
+  start_timer();
+  fft_rfft_vec(&plan_half, rfft_tw, rfft_x, rfft_bins, rfft_bins + nbins);
+  stop_timer();
+  runtime = get_timer();
+  printf("The real-input execution took %d cycles.\n", runtime);
+
+  for (unsigned int i = 0; i < 2 * nbins; ++i)
+    if (!similarity_check_32b(rfft_bins[i], gold_rfft[i], THRESHOLD_R4)) {
+      printf("Real-input error at index %d\n", i);
+      error = 1;
+    }
+
+  start_timer();
+  fft_irfft_vec(&plan_half, rfft_tw, rfft_bins, rfft_bins + nbins, rfft_x);
+  stop_timer();
+  runtime = get_timer();
+  printf("The inverse real-input execution took %d cycles.\n", runtime);
+
+  for (unsigned int i = 0; i < NFFT; ++i)
+    if (!similarity_check_32b(rfft_x[i], rfft_x_s[i], THRESHOLD_R4)) {
+      printf("Inverse real-input error at index %d\n", i);
+      error = 1;
+    }
+
+  /////////////////////////
+  // Batched and 2D FFTs //
+  /////////////////////////
+
+  if (BATCH > MAX_BATCH) {
+    printf("Error: the batch must be at most %d.\n", MAX_BATCH);
+    return -1;
+  }
+
+  const unsigned long int len = BATCH * NFFT;
+
+  start_timer();
+  fft_r4_vec_batch(&plan, batch_reim, batch_reim + len, BATCH, 1, NFFT,
+                   batch_work);
+  stop_timer();
+  runtime = get_timer();
+  printf("The batched execution (%d FFTs) took %d cycles.\n", BATCH, runtime);
+
+  // The rows reuse the plan of NFFT points
+  fft_plan_t plan_2d;
+  fft_plan_init(&plan_2d, BATCH, plan_tw_2d, plan_buf);
+
+  start_timer();
+  fft2d_r4_vec(&plan, &plan_2d, batch_2d_reim, batch_2d_reim + len, BATCH,
+               NFFT, batch_work);
+  stop_timer();
+  runtime = get_timer();
+  printf("The 2D execution (%dx%d) took %d cycles.\n", BATCH, NFFT, runtime);
+
+  for (unsigned int i = 0; i < len; ++i) {
+    if (!similarity_check_32b(batch_reim[i], gold_batch[i][0], THRESHOLD_R4) ||
+        !similarity_check_32b(batch_reim[i + len], gold_batch[i][1],
+                              THRESHOLD_R4)) {
+      printf("Batched error at index %d\n", i);
+      error = 1;
+    }
+    // The 2D output grows with the size of the image
+    if (!similarity_check_32b(batch_2d_reim[i], gold_2d[i][0],
+                              THRESHOLD_R4 * BATCH) ||
+        !similarity_check_32b(batch_2d_reim[i + len], gold_2d[i][1],
+                              THRESHOLD_R4 * BATCH)) {
+      printf("2D error at index %d\n", i);
+      error = 1;
+    }
+  }
+
   if (!error)
     printf("\n");
   if (!error)
@@ -15,9 +15,10 @@
 # See the License for the specific language governing permissions and
 # limitations under the License.
 
-# arg1: image size, arg2: filter size
+# arg1: number of samples, arg2: data type, arg3: batch (optional)
 
 import numpy as np
+import os
 import sys
 
 FFT2_SAMPLE_DYN = 13
@@ -84,26 +85,23 @@ def setupInput(samples, Nfft, dyn):
       samp[...]['re'] = np.random.rand(1)
       samp[...]['im'] = np.random.rand(1)
 
-def emit(name, array, alignment='8'):
-	print(".global %s" % name)
-	print(".balign " + alignment)
-	print("%s:" % name)
-	bs = array.tobytes()
-	for i in range(0, len(bs), 4):
-		s = ""
-		for n in range(4):
-			s += "%02x" % bs[i+3-n]
-		print("    .word 0x%s" % s)
+sys.path.insert(0, os.path.join(os.path.dirname(__file__), '../../common/script'))
+from data_emit import emit
 
 ############
 ## SCRIPT ##
 ############
 
-if len(sys.argv) == 3:
+# Transforms of the batched FFT, and rows of the 2D FFT (a power of two)
+BATCH = 16
+
+if len(sys.argv) == 3 or len(sys.argv) == 4:
   NFFT = int(sys.argv[1])
   dtype = sys.argv[2]
+  if len(sys.argv) == 4:
+    BATCH = int(sys.argv[3])
 else:
-  print("Error. Give me two arguments: the number of samples and the data type.")
+  print("Error. Give me two or three arguments: the number of samples, the data type, and the batch.")
   sys.exit()
 
 if   dtype == "int16":
@@ -152,10 +150,34 @@ samples_reim              = np.empty(2 * NFFT, dtype=dtype)
 samples_reim[   0:  NFFT] = samples_s[0::2]
 samples_reim[NFFT:2*NFFT] = samples_s[1::2]
 
+# Batch of BATCH transforms of NFFT samples, also the BATCH x NFFT image of the
+# 2D FFT, split into real and imaginary parts
+batch      = np.random.rand(BATCH, NFFT) + 1j * np.random.rand(BATCH, NFFT)
+batch_reim = np.concatenate((np.real(batch).flatten(), np.imag(batch).flatten()))
+gold_batch = serialize_cmplx(np.fft.fft(batch, axis=1).flatten(), BATCH * NFFT, dtype)
+gold_2d    = serialize_cmplx(np.fft.fft2(batch).flatten(), BATCH * NFFT, dtype)
+
 twiddle_vec_reim                      = np.empty(2*N_TWID_V, dtype=dtype)
 twiddle_vec_reim[   0:      N_TWID_V] = twiddle_v_s[0::2]
 twiddle_vec_reim[N_TWID_V:2*N_TWID_V] = twiddle_v_s[1::2]
 
+# Q15 data of the fixed-point vector FFT: the samples have FFT2_SAMPLE_DYN
+# fractional bits, and the output is scaled down by NFFT / 2 (Radix2FFT_DIF).
+# Its twiddles are the conjugates of twiddle_vec_reim, for the forward FFT.
+def q15(x, scale):
+  return np.clip(np.round(np.asarray(x, dtype=np.float64) * scale), -(1 << 15), (1 << 15) - 1).astype(np.int16)
+
+samples_reim_q15     = q15(samples_reim, 1 << FFT2_SAMPLE_DYN)
+twiddle_vec_reim_q15 = q15(np.concatenate((twiddle_vec_reim[:N_TWID_V], -twiddle_vec_reim[N_TWID_V:])), 1 << FFT_TWIDDLE_DYN)
+gold_q15_cplx        = np.fft.fft(samples_reim_q15[:NFFT] + 1j * samples_reim_q15[NFFT:]) / (NFFT / 2)
+gold_q15             = q15(np.concatenate((np.real(gold_q15_cplx), np.imag(gold_q15_cplx))), 1)
+
+# Real signal of the real-input FFT, and its NFFT / 2 + 1 bins, split into real
+# and imaginary parts
+rfft_x    = np.random.rand(NFFT)
+gold_rfft = np.fft.rfft(rfft_x)
+gold_rfft = np.concatenate((np.real(gold_rfft), np.imag(gold_rfft)))
+
 # Create the file
 print(".section .data,\"aw\",@progbits")
 emit("NFFT", np.array(NFFT, dtype=np.uint64))
@@ -167,3 +189,14 @@ emit("twiddle", twiddle_s.astype(dtype), 'NR_LANES*4')
 emit("twiddle_vec", twiddle_v_s.astype(dtype), 'NR_LANES*4')
 emit("twiddle_vec_reim", twiddle_vec_reim.astype(dtype), 'NR_LANES*4')
 emit("gold_out", gold_out_s.astype(dtype), 'NR_LANES*4')
+emit("samples_reim_q15", samples_reim_q15, 'NR_LANES*4')
+emit("twiddle_vec_reim_q15", twiddle_vec_reim_q15, 'NR_LANES*4')
+emit("gold_q15", gold_q15, 'NR_LANES*4')
+emit("rfft_x", rfft_x.astype(dtype), 'NR_LANES*4')
+emit("rfft_x_s", rfft_x.astype(dtype), 'NR_LANES*4')
+emit("gold_rfft", gold_rfft.astype(dtype), 'NR_LANES*4')
+emit("BATCH", np.array(BATCH, dtype=np.uint64))
+emit("batch_reim", batch_reim.astype(dtype), 'NR_LANES*4')
+emit("batch_2d_reim", batch_reim.astype(dtype), 'NR_LANES*4')
+emit("gold_batch", gold_batch.astype(dtype), 'NR_LANES*4')
+emit("gold_2d", gold_2d.astype(dtype), 'NR_LANES*4')
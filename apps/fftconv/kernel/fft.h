@@ -0,0 +1 @@
+../../fft/kernel/fft.h
\ No newline at end of file
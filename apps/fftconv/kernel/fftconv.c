@@ -0,0 +1,447 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "fftconv.h"
+#include "fft.h"
+#include "fftconv_threshold.h"
+
+#define MIN(a, b) ((a) < (b) ? (a) : (b))
+#define MAX(a, b) ((a) > (b) ? (a) : (b))
+
+float fftconv_work[FFTCONV_WORK_WORDS] __attribute__((aligned(32 * NR_LANES)));
+
+// Plan of the last transform size, and twiddles of the last real-input FFT,
+// so that the layers of the same size do not recompute them
+static float fftconv_tw[FFT_PLAN_LEN(FFTCONV_MAX_N)]
+    __attribute__((aligned(32 * NR_LANES)));
+static float fftconv_buf[FFT_PLAN_LEN(FFTCONV_MAX_N)]
+    __attribute__((aligned(32 * NR_LANES)));
+static float fftconv_rfft_tw[FFT_RFFT_TW_LEN(FFTCONV_MAX_N)]
+    __attribute__((aligned(32 * NR_LANES)));
+static fft_plan_t fftconv_plan;
+static unsigned long int fftconv_rfft_n;
+
+static const fft_plan_t *fftconv_plan_get(const unsigned long int n) {
+  if (fftconv_plan.n != n)
+    fft_plan_init(&fftconv_plan, n, fftconv_tw, fftconv_buf);
+  return &fftconv_plan;
+}
+
+// Plan of n / 2 points of the real-input FFT of n points
+static const fft_plan_t *fftconv_rfft_get(const unsigned long int n) {
+  if (fftconv_rfft_n != n) {
+    fft_rfft_init(fftconv_rfft_tw, n);
+    fftconv_rfft_n = n;
+  }
+  return fftconv_plan_get(n >> 1);
+}
+
+static unsigned long int fftconv_log2(unsigned long int x) {
+  unsigned long int l = 0;
+  while (x >>= 1)
+    ++l;
+  return l;
+}
+
+/////////////
+// Helpers //
+/////////////
+
+static void fftconv_zero(float *x, const unsigned long int len) {
+  size_t vl;
+  for (unsigned long int j = 0; j < len; j += vl) {
+    vl = vsetvl_e32m8(len - j);
+    vse32_v_f32m8(x + j, vfmv_v_f_f32m8(0, vl), vl);
+  }
+}
+
+static void fftconv_copy(float *y, const float *x,
+                         const unsigned long int len) {
+  size_t vl;
+  for (unsigned long int j = 0; j < len; j += vl) {
+    vl = vsetvl_e32m8(len - j);
+    vse32_v_f32m8(y + j, vle32_v_f32m8(x + j, vl), vl);
+  }
+}
+
+// y += a * x
+static void fftconv_axpy(float *y, const float *x, const float a,
+                         const unsigned long int len) {
+  size_t vl;
+  for (unsigned long int j = 0; j < len; j += vl) {
+    vl = vsetvl_e32m8(len - j);
+    vfloat32m8_t v = vle32_v_f32m8(y + j, vl);
+    v = vfmacc_vf_f32m8(v, a, vle32_v_f32m8(x + j, vl), vl);
+    vse32_v_f32m8(y + j, v, vl);
+  }
+}
+
+// o += scale * c, for the outputs of a tile of l samples at x0. The output
+// x0 + d, -K < d < l, is c[d mod n], so that the negative offsets wrap to the
+// end of c.
+static void fftconv_add(float *o, const float *c, const long int x0,
+                        const long int l, const long int len,
+                        const unsigned long int K, const unsigned long int n,
+                        const float scale) {
+  const long int xb = MIN(x0 + l, len);
+  long int x = MAX(x0 - (long int)K + 1, 0);
+
+  if (x < x0) {
+    const long int e = MIN(x0, xb);
+    fftconv_axpy(o + x, c + n + (x - x0), scale, e - x);
+    x = e;
+  }
+  if (x < xb)
+    fftconv_axpy(o + x, c + (x - x0), scale, xb - x);
+}
+
+////////////
+// Direct //
+////////////
+
+void fftconv2d_direct_f32(float *o, const float *i, const float *f,
+                          const unsigned long int C_in,
+                          const unsigned long int C_out,
+                          const unsigned long int H, const unsigned long int W,
+                          const unsigned long int K) {
+  const unsigned long int Ho = H - K + 1;
+  const unsigned long int Wo = W - K + 1;
+  size_t vl;
+
+  for (unsigned long int co = 0; co < C_out; ++co)
+    for (unsigned long int y = 0; y < Ho; ++y)
+      for (unsigned long int x = 0; x < Wo; x += vl) {
+        vl = vsetvl_e32m8(Wo - x);
+        vfloat32m8_t acc = vfmv_v_f_f32m8(0, vl);
+        const float *fk = f + co * C_in * K * K;
+
+        for (unsigned long int ci = 0; ci < C_in; ++ci)
+          for (unsigned long int ky = 0; ky < K; ++ky) {
+            const float *row = i + (ci * H + y + ky) * W + x;
+            for (unsigned long int kx = 0; kx < K; ++kx)
+              acc = vfmacc_vf_f32m8(acc, *fk++, vle32_v_f32m8(row + kx, vl),
+                                    vl);
+          }
+        vse32_v_f32m8(o + (co * Ho + y) * Wo + x, acc, vl);
+      }
+}
+
+void fftconv1d_direct_f32(float *o, const float *x, const float *f,
+                          const unsigned long int len,
+                          const unsigned long int K) {
+  const unsigned long int lo = len - K + 1;
+  size_t vl;
+
+  for (unsigned long int y = 0; y < lo; y += vl) {
+    vl = vsetvl_e32m8(lo - y);
+    vfloat32m8_t acc = vfmv_v_f_f32m8(0, vl);
+    for (unsigned long int k = 0; k < K; ++k)
+      acc = vfmacc_vf_f32m8(acc, f[k], vle32_v_f32m8(x + y + k, vl), vl);
+    vse32_v_f32m8(o + y, acc, vl);
+  }
+}
+
+/////////////////////
+// Transform sizes //
+/////////////////////
+
+// The complex FFTs cost about 5 N log2(N) FLOP, and the complex MACs 8 FLOP.
+// The tiles have at least K + 1 samples per dimension, and the sizes above the
+// one that holds the whole input only cost more.
+unsigned long int fftconv2d_size(const unsigned long int C_in,
+                                 const unsigned long int C_out,
+                                 const unsigned long int H,
+                                 const unsigned long int W,
+                                 const unsigned long int K) {
+  unsigned long int best = 0, best_cost = -1;
+
+  for (unsigned long int n = 4; n <= FFTCONV_MAX_N; n <<= 1) {
+    if (FFTCONV2D_WORK_LEN(C_in, n) + FFTCONV2D_FS_LEN(C_out, C_in, n) >
+        FFTCONV_WORK_WORDS)
+      break;
+    if ((H > n || W > n) && n < 2 * K)
+      continue;
+
+    const unsigned long int ly = H <= n ? H : n - K + 1;
+    const unsigned long int lx = W <= n ? W : n - K + 1;
+    const unsigned long int tiles = ((H + ly - 1) / ly) * ((W + lx - 1) / lx);
+    const unsigned long int nn = n * n;
+    const unsigned long int cost =
+        5 * (tiles * (C_in + C_out) + C_in * C_out) * nn * fftconv_log2(n) +
+        8 * tiles * C_in * C_out * nn;
+    if (cost < best_cost) {
+      best = n;
+      best_cost = cost;
+    }
+    if (H <= n && W <= n)
+      break;
+  }
+  return best;
+}
+
+// The real-input FFTs go through complex FFTs of n / 2 points, and the complex
+// multiplications cost 6 FLOP per bin
+unsigned long int fftconv1d_size(const unsigned long int len,
+                                 const unsigned long int K) {
+  unsigned long int best = 0, best_cost = -1;
+
+  for (unsigned long int n = 4; n <= FFTCONV_MAX_N; n <<= 1) {
+    if (FFTCONV1D_WORK_LEN(n) + FFTCONV1D_FS_LEN(n) > FFTCONV_WORK_WORDS)
+      break;
+    if (len > n && n < 2 * K)
+      continue;
+
+    const unsigned long int l = len <= n ? len : n - K + 1;
+    const unsigned long int tiles = (len + l - 1) / l;
+    const unsigned long int cost =
+        5 * (2 * tiles + 1) * (n >> 1) * (fftconv_log2(n) - 1) +
+        6 * tiles * ((n >> 1) + 1);
+    if (cost < best_cost) {
+      best = n;
+      best_cost = cost;
+    }
+    if (len <= n)
+      break;
+  }
+  return best;
+}
+
+////////
+// 2D //
+////////
+
+// Zero-padded n x n tile, split into real and imaginary parts, of rows x cols
+// samples ld apart
+static void fftconv2d_tile(float *t, const float *x,
+                           const unsigned long int rows,
+                           const unsigned long int cols,
+                           const unsigned long int ld,
+                           const unsigned long int n) {
+  fftconv_zero(t, 2 * n * n);
+  for (unsigned long int r = 0; r < rows; ++r)
+    fftconv_copy(t + r * n, x + r * ld, cols);
+}
+
+// acc = sum_ci fs[ci] conj(spec[ci]), the conjugate spectrum of the
+// correlation, over the nn points of the spectra
+static void fftconv2d_mac(float *acc, const float *fs, const float *spec,
+                          const unsigned long int C_in,
+                          const unsigned long int nn) {
+  size_t vl;
+
+  for (unsigned long int j = 0; j < nn; j += vl) {
+    vl = vsetvl_e32m4(nn - j);
+    vfloat32m4_t y_re = vfmv_v_f_f32m4(0, vl);
+    vfloat32m4_t y_im = vfmv_v_f_f32m4(0, vl);
+
+    for (unsigned long int ci = 0; ci < C_in; ++ci) {
+      const float *f = fs + 2 * nn * ci + j;
+      const float *s = spec + 2 * nn * ci + j;
+      vfloat32m4_t f_re = vle32_v_f32m4(f, vl);
+      vfloat32m4_t f_im = vle32_v_f32m4(f + nn, vl);
+      vfloat32m4_t s_re = vle32_v_f32m4(s, vl);
+      vfloat32m4_t s_im = vle32_v_f32m4(s + nn, vl);
+
+      // (f_re + j f_im) (s_re - j s_im)
+      y_re = vfmacc_vv_f32m4(y_re, f_re, s_re, vl);
+      y_re = vfmacc_vv_f32m4(y_re, f_im, s_im, vl);
+      y_im = vfmacc_vv_f32m4(y_im, f_im, s_re, vl);
+      y_im = vfnmsac_vv_f32m4(y_im, f_re, s_im, vl);
+    }
+    vse32_v_f32m4(acc + j, y_re, vl);
+    vse32_v_f32m4(acc + nn + j, y_im, vl);
+  }
+}
+
+// The 2D FFTs use the start of the work buffer, so that fs can follow the
+// tiles in it
+void fftconv2d_filter_f32(float *fs, const float *f,
+                          const unsigned long int C_out,
+                          const unsigned long int C_in,
+                          const unsigned long int K,
+                          const unsigned long int n) {
+  const fft_plan_t *plan = fftconv_plan_get(n);
+  const unsigned long int nn = n * n;
+
+  for (unsigned long int j = 0; j < C_out * C_in; ++j) {
+    float *t = fs + 2 * nn * j;
+    fftconv2d_tile(t, f + K * K * j, K, K, K, n);
+    fft2d_r4_vec(plan, plan, t, t + nn, n, n, fftconv_work);
+  }
+}
+
+// The work buffer holds the buffer of the 2D FFTs, the accumulated spectrum of
+// an output channel, and the spectra of the input channels of a tile
+void fftconv2d_fft_f32(float *o, const float *i, const float *fs,
+                       const unsigned long int C_in,
+                       const unsigned long int C_out,
+                       const unsigned long int H, const unsigned long int W,
+                       const unsigned long int K, const unsigned long int n) {
+  const fft_plan_t *plan = fftconv_plan_get(n);
+  const unsigned long int nn = n * n;
+  const unsigned long int Ho = H - K + 1;
+  const unsigned long int Wo = W - K + 1;
+  const unsigned long int ty = H <= n ? H : n - K + 1;
+  const unsigned long int tx = W <= n ? W : n - K + 1;
+  const float scale = 1.0f / nn;
+  float *acc = fftconv_work + 2 * nn;
+  float *spec = acc + 2 * nn;
+
+  fftconv_zero(o, C_out * Ho * Wo);
+
+  for (unsigned long int y0 = 0; y0 < H; y0 += ty)
+    for (unsigned long int x0 = 0; x0 < W; x0 += tx) {
+      const unsigned long int ly = MIN(ty, H - y0);
+      const unsigned long int lx = MIN(tx, W - x0);
+
+      for (unsigned long int ci = 0; ci < C_in; ++ci) {
+        float *s = spec + 2 * nn * ci;
+        fftconv2d_tile(s, i + (ci * H + y0) * W + x0, ly, lx, W, n);
+        fft2d_r4_vec(plan, plan, s, s + nn, n, n, fftconv_work);
+      }
+
+      for (unsigned long int co = 0; co < C_out; ++co) {
+        fftconv2d_mac(acc, fs + 2 * nn * C_in * co, spec, C_in, nn);
+        fft2d_r4_vec(plan, plan, acc, acc + nn, n, n, fftconv_work);
+
+        // The rows y0 + d, -K < d < ly, of the output channel
+        const long int ya = MAX((long int)y0 - (long int)K + 1, 0);
+        const long int yb = MIN((long int)(y0 + ly), (long int)Ho);
+        for (long int y = ya; y < yb; ++y)
+          fftconv_add(o + (co * Ho + y) * Wo,
+                      acc + ((y - (long int)y0) & (n - 1)) * n, x0, lx, Wo,
+                      K, n, scale);
+      }
+    }
+}
+
+////////
+// 1D //
+////////
+
+void fftconv1d_filter_f32(float *fs_re, float *fs_im, const float *f,
+                          const unsigned long int K,
+                          const unsigned long int n) {
+  const fft_plan_t *plan = fftconv_rfft_get(n);
+  float *t = fftconv_work;
+
+  fftconv_zero(t, n);
+  fftconv_copy(t, f, K);
+  fft_rfft_vec(plan, fftconv_rfft_tw, t, fs_re, fs_im);
+}
+
+// The work buffer holds a tile, and its n / 2 + 1 bins
+void fftconv1d_fft_f32(float *o, const float *x, const float *fs_re,
+                       const float *fs_im, const unsigned long int len,
+                       const unsigned long int K, const unsigned long int n) {
+  const fft_plan_t *plan = fftconv_rfft_get(n);
+  const unsigned long int bins = (n >> 1) + 1;
+  const unsigned long int lo = len - K + 1;
+  const unsigned long int tl = len <= n ? len : n - K + 1;
+  float *t = fftconv_work;
+  float *b_re = t + n;
+  float *b_im = b_re + bins;
+  size_t vl;
+
+  fftconv_zero(o, lo);
+
+  for (unsigned long int x0 = 0; x0 < len; x0 += tl) {
+    const unsigned long int lx = MIN(tl, len - x0);
+
+    fftconv_zero(t, n);
+    fftconv_copy(t, x + x0, lx);
+    fft_rfft_vec(plan, fftconv_rfft_tw, t, b_re, b_im);
+
+    // conj(F) X
+    for (unsigned long int j = 0; j < bins; j += vl) {
+      vl = vsetvl_e32m4(bins - j);
+      vfloat32m4_t f_re = vle32_v_f32m4(fs_re + j, vl);
+      vfloat32m4_t f_im = vle32_v_f32m4(fs_im + j, vl);
+      vfloat32m4_t x_re = vle32_v_f32m4(b_re + j, vl);
+      vfloat32m4_t x_im = vle32_v_f32m4(b_im + j, vl);
+      vfloat32m4_t y_re = vfmul_vv_f32m4(x_re, f_re, vl);
+      vfloat32m4_t y_im = vfmul_vv_f32m4(x_im, f_re, vl);
+      y_re = vfmacc_vv_f32m4(y_re, x_im, f_im, vl);
+      y_im = vfnmsac_vv_f32m4(y_im, x_re, f_im, vl);
+      vse32_v_f32m4(b_re + j, y_re, vl);
+      vse32_v_f32m4(b_im + j, y_im, vl);
+    }
+
+    fft_irfft_vec(plan, fftconv_rfft_tw, b_re, b_im, t);
+    fftconv_add(o, t, x0, lx, lo, K, n, 1.0f);
+  }
+}
+
+///////////////
+// Selection //
+///////////////
+
+unsigned long int fftconv_threshold(const unsigned int dims) {
+  for (const fftconv_threshold_t *e = fftconv_threshold_table;
+       e->nr_lanes != 0; ++e)
+    if (e->nr_lanes == NR_LANES && e->dims == dims)
+      return e->k;
+  return dims == 1 ? FFTCONV1D_K_THRESHOLD : FFTCONV2D_K_THRESHOLD;
+}
+
+fftconv_path_t fftconv_select(const unsigned int dims,
+                              const unsigned long int K) {
+  const unsigned long int k = fftconv_threshold(dims);
+  return k != 0 && K >= k ? FFTCONV_FFT : FFTCONV_DIRECT;
+}
+
+void fftconv2d_run(const fftconv_path_t path, float *o, const float *i,
+                   const float *f, const unsigned long int C_in,
+                   const unsigned long int C_out, const unsigned long int H,
+                   const unsigned long int W, const unsigned long int K) {
+  const unsigned long int n =
+      path == FFTCONV_FFT ? fftconv2d_size(C_in, C_out, H, W, K) : 0;
+
+  if (n == 0) {
+    fftconv2d_direct_f32(o, i, f, C_in, C_out, H, W, K);
+    return;
+  }
+  float *fs = fftconv_work + FFTCONV2D_WORK_LEN(C_in, n);
+  fftconv2d_filter_f32(fs, f, C_out, C_in, K, n);
+  fftconv2d_fft_f32(o, i, fs, C_in, C_out, H, W, K, n);
+}
+
+void fftconv1d_run(const fftconv_path_t path, float *o, const float *x,
+                   const float *f, const unsigned long int len,
+                   const unsigned long int K) {
+  const unsigned long int n = path == FFTCONV_FFT ? fftconv1d_size(len, K) : 0;
+
+  if (n == 0) {
+    fftconv1d_direct_f32(o, x, f, len, K);
+    return;
+  }
+  float *fs_re = fftconv_work + FFTCONV1D_WORK_LEN(n);
+  float *fs_im = fs_re + (n >> 1) + 1;
+  fftconv1d_filter_f32(fs_re, fs_im, f, K, n);
+  fftconv1d_fft_f32(o, x, fs_re, fs_im, len, K, n);
+}
+
+void fftconv2d_f32(float *o, const float *i, const float *f,
+                   const unsigned long int C_in, const unsigned long int C_out,
+                   const unsigned long int H, const unsigned long int W,
+                   const unsigned long int K) {
+  fftconv2d_run(fftconv_select(2, K), o, i, f, C_in, C_out, H, W, K);
+}
+
+void fftconv1d_f32(float *o, const float *x, const float *f,
+                   const unsigned long int len, const unsigned long int K) {
+  fftconv1d_run(fftconv_select(1, K), o, x, f, len, K);
+}
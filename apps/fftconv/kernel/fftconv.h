@@ -0,0 +1,134 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _FFTCONV_H_
+#define _FFTCONV_H_
+
+#include <stdint.h>
+
+// Valid correlations of FP32 images and signals, computed directly, or through
+// the FFTs of fft_r4.c with overlap-add:
+//   2D: o[co][y][x] = sum_{ci, ky, kx} f[co][ci][ky][kx] * i[ci][y + ky][x + kx]
+//       with i=[C_in x H x W], f=[C_out x C_in x K x K], and
+//       o=[C_out x (H - K + 1) x (W - K + 1)]
+//   1D: o[y] = sum_k f[k] * x[y + k], with x=[len], f=[K], o=[len - K + 1]
+// The inputs are already padded, as in fconv2d.
+//
+// The FFT path splits the input into tiles of n - K + 1 samples per
+// dimension, or a single tile if the dimension fits in n. The correlation of
+// a tile with the filter is circular over the transform of n points, with no
+// aliasing, and the tiles add their overlapping outputs. The spectrum of the
+// correlation is conj(F) X. As the correlation is real, it is the real part of
+// the forward FFT of the conjugate spectrum F conj(X), over n^2 points, so that
+// the 2D path needs no inverse FFT. The 1D path uses the real-input FFT and
+// its inverse.
+
+// Largest transform, in points, of the 2D tiles and of the 1D signals
+#ifndef FFTCONV_MAX_N
+#define FFTCONV_MAX_N 1024
+#endif
+
+// Words of the work buffer of the FFT path. The shapes whose transforms do not
+// fit in it fall back to the direct correlation.
+#ifndef FFTCONV_WORK_WORDS
+#define FFTCONV_WORK_WORDS (1 << 18)
+#endif
+
+// Smallest filter size of the FFT path, if fftconv_threshold.h has no measure
+// for NR_LANES lanes
+#ifndef FFTCONV2D_K_THRESHOLD
+#define FFTCONV2D_K_THRESHOLD 11
+#endif
+#ifndef FFTCONV1D_K_THRESHOLD
+#define FFTCONV1D_K_THRESHOLD 64
+#endif
+
+// Words of the work buffer of the tiles, and of the spectra of the filters, for
+// transforms of n points
+#define FFTCONV2D_WORK_LEN(c_in, n) (2 * ((c_in) + 2) * (n) * (n))
+#define FFTCONV2D_FS_LEN(c_out, c_in, n) (2 * (c_out) * (c_in) * (n) * (n))
+#define FFTCONV1D_WORK_LEN(n) (2 * (n) + 2)
+#define FFTCONV1D_FS_LEN(n) ((n) + 2)
+
+extern float fftconv_work[];
+
+// Paths of the correlations
+typedef enum { FFTCONV_DIRECT = 0, FFTCONV_FFT = 1 } fftconv_path_t;
+
+// Measured smallest filter size of 1D or 2D correlations from which the FFT
+// path is faster, from fftconv_threshold.h. k = 0 if it is never faster.
+typedef struct {
+  unsigned int nr_lanes;
+  unsigned int dims;
+  unsigned int k;
+} fftconv_threshold_t;
+
+// The path that is the fastest for the filter size on NR_LANES lanes: the FFT
+// from the measured threshold on, or from FFTCONV2D_K_THRESHOLD and
+// FFTCONV1D_K_THRESHOLD if fftconv_threshold.h has no measure. The FFT path
+// computes the spectra of the filters in the work buffer, with the transform
+// size of fftconv2d_size or fftconv1d_size.
+void fftconv2d_f32(float *o, const float *i, const float *f,
+                   unsigned long int C_in, unsigned long int C_out,
+                   unsigned long int H, unsigned long int W,
+                   unsigned long int K);
+void fftconv1d_f32(float *o, const float *x, const float *f,
+                   unsigned long int len, unsigned long int K);
+unsigned long int fftconv_threshold(unsigned int dims);
+fftconv_path_t fftconv_select(unsigned int dims, unsigned long int K);
+
+// The path given, or the direct one if no transform fits in the work buffer
+void fftconv2d_run(fftconv_path_t path, float *o, const float *i,
+                   const float *f, unsigned long int C_in,
+                   unsigned long int C_out, unsigned long int H,
+                   unsigned long int W, unsigned long int K);
+void fftconv1d_run(fftconv_path_t path, float *o, const float *x,
+                   const float *f, unsigned long int len, unsigned long int K);
+
+// Vectorized over the output columns, with one load of the input per tap
+void fftconv2d_direct_f32(float *o, const float *i, const float *f,
+                          unsigned long int C_in, unsigned long int C_out,
+                          unsigned long int H, unsigned long int W,
+                          unsigned long int K);
+void fftconv1d_direct_f32(float *o, const float *x, const float *f,
+                          unsigned long int len, unsigned long int K);
+
+// Transform size of the fewest estimated FLOP whose buffers fit in the work
+// buffer, with the 2D filter spectra, or 0 if none does
+unsigned long int fftconv2d_size(unsigned long int C_in,
+                                 unsigned long int C_out, unsigned long int H,
+                                 unsigned long int W, unsigned long int K);
+unsigned long int fftconv1d_size(unsigned long int len, unsigned long int K);
+
+// Spectra fs of the filters, FFTCONV2D_FS_LEN(C_out, C_in, n) words of the
+// real parts, and then the imaginary parts, of the n x n transform of each
+// filter. They can be computed once for all the inputs of a layer.
+void fftconv2d_filter_f32(float *fs, const float *f, unsigned long int C_out,
+                          unsigned long int C_in, unsigned long int K,
+                          unsigned long int n);
+void fftconv2d_fft_f32(float *o, const float *i, const float *fs,
+                       unsigned long int C_in, unsigned long int C_out,
+                       unsigned long int H, unsigned long int W,
+                       unsigned long int K, unsigned long int n);
+
+// Same for the 1D filter, whose spectrum has n / 2 + 1 bins
+void fftconv1d_filter_f32(float *fs_re, float *fs_im, const float *f,
+                          unsigned long int K, unsigned long int n);
+void fftconv1d_fft_f32(float *o, const float *x, const float *fs_re,
+                       const float *fs_im, unsigned long int len,
+                       unsigned long int K, unsigned long int n);
+
+#endif
@@ -0,0 +1,133 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdint.h>
+#include <string.h>
+
+#include "bench.h"
+#include "kernel/fftconv.h"
+#include "runtime.h"
+#include "util.h"
+#include "vcheck.h"
+
+#ifndef SPIKE
+#include "printf.h"
+#else
+#include <stdio.h>
+#endif
+
+#define THRESHOLD 0.001
+
+extern uint64_t C_in;
+extern uint64_t C_out;
+extern uint64_t H;
+extern uint64_t W;
+extern uint64_t K;
+extern uint64_t L;
+extern uint64_t K1;
+extern float i[] __attribute__((aligned(4 * NR_LANES)));
+extern float f[] __attribute__((aligned(4 * NR_LANES)));
+extern float o[] __attribute__((aligned(4 * NR_LANES)));
+extern float gold_o[] __attribute__((aligned(4 * NR_LANES)));
+extern float x[] __attribute__((aligned(4 * NR_LANES)));
+extern float f1[] __attribute__((aligned(4 * NR_LANES)));
+extern float o1[] __attribute__((aligned(4 * NR_LANES)));
+extern float gold_o1[] __attribute__((aligned(4 * NR_LANES)));
+
+// The performance is in the FLOP of the direct correlation, so that the paths
+// compare
+int main() {
+  printf("\n");
+  printf("=============\n");
+  printf("=  FFTCONV  =\n");
+  printf("=============\n");
+  printf("\n");
+  printf("\n");
+
+  const uint64_t Ho = H - K + 1, Wo = W - K + 1, Lo = L - K1 + 1;
+  const uint64_t flops = 2 * C_out * Ho * Wo * C_in * K * K;
+  const uint64_t flops1 = 2 * Lo * K1;
+  const unsigned long int n = fftconv2d_size(C_in, C_out, H, W, K);
+  const unsigned long int n1 = fftconv1d_size(L, K1);
+  int error = 0;
+
+  printf("2D: %lu -> %lu channels of %lux%lu, %lux%lu filters, %lux%lu "
+         "transforms\n",
+         C_in, C_out, H, W, K, K, n, n);
+  printf("2D: the FFT path from K = %lu\n", fftconv_threshold(2));
+
+  start_timer();
+  fftconv2d_run(FFTCONV_DIRECT, o, i, f, C_in, C_out, H, W, K);
+  stop_timer();
+  bench_report_flops("fftconv2d_direct", flops);
+  error |= vcheck_report("fftconv2d_direct",
+                         vcheck_f32(o, gold_o, C_out * Ho * Wo, THRESHOLD));
+
+  memset(o, 0, C_out * Ho * Wo * sizeof(float));
+  start_timer();
+  fftconv2d_run(FFTCONV_FFT, o, i, f, C_in, C_out, H, W, K);
+  stop_timer();
+  bench_report_flops("fftconv2d_fft", flops);
+  error |= vcheck_report("fftconv2d_fft",
+                         vcheck_f32(o, gold_o, C_out * Ho * Wo, THRESHOLD));
+
+  // With the filter spectra of a previous call, as in the inference of a layer
+  if (n != 0) {
+    memset(o, 0, C_out * Ho * Wo * sizeof(float));
+    start_timer();
+    fftconv2d_fft_f32(o, i, fftconv_work + FFTCONV2D_WORK_LEN(C_in, n), C_in,
+                      C_out, H, W, K, n);
+    stop_timer();
+    bench_report_flops("fftconv2d_fft (filter spectra)", flops);
+    error |= vcheck_report("fftconv2d_fft (filter spectra)",
+                           vcheck_f32(o, gold_o, C_out * Ho * Wo, THRESHOLD));
+  }
+
+  memset(o, 0, C_out * Ho * Wo * sizeof(float));
+  start_timer();
+  fftconv2d_f32(o, i, f, C_in, C_out, H, W, K);
+  stop_timer();
+  bench_report_flops("fftconv2d", flops);
+  error |= vcheck_report("fftconv2d",
+                         vcheck_f32(o, gold_o, C_out * Ho * Wo, THRESHOLD));
+
+  printf("1D: %lu samples, %lu taps, transforms of %lu samples\n", L, K1, n1);
+  printf("1D: the FFT path from K = %lu\n", fftconv_threshold(1));
+
+  start_timer();
+  fftconv1d_run(FFTCONV_DIRECT, o1, x, f1, L, K1);
+  stop_timer();
+  bench_report_flops("fftconv1d_direct", flops1);
+  error |= vcheck_report("fftconv1d_direct",
+                         vcheck_f32(o1, gold_o1, Lo, THRESHOLD));
+
+  memset(o1, 0, Lo * sizeof(float));
+  start_timer();
+  fftconv1d_run(FFTCONV_FFT, o1, x, f1, L, K1);
+  stop_timer();
+  bench_report_flops("fftconv1d_fft", flops1);
+  error |= vcheck_report("fftconv1d_fft",
+                         vcheck_f32(o1, gold_o1, Lo, THRESHOLD));
+
+  memset(o1, 0, Lo * sizeof(float));
+  start_timer();
+  fftconv1d_f32(o1, x, f1, L, K1);
+  stop_timer();
+  bench_report_flops("fftconv1d", flops1);
+  error |= vcheck_report("fftconv1d", vcheck_f32(o1, gold_o1, Lo, THRESHOLD));
+
+  return error;
+}
@@ -0,0 +1,79 @@
+#!/usr/bin/env python3
+# Copyright 2022 ETH Zurich and University of Bologna.
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+# arg1, arg2, arg3, arg4, arg5: input and output channels, height and width of
+# the (padded) images, and filter size of the 2D correlation
+# arg6, arg7: samples of the signal, and filter size of the 1D correlation
+
+import numpy as np
+import os
+import sys
+
+sys.path.insert(0, os.path.join(os.path.dirname(__file__), '../../common/script'))
+from data_emit import emit
+
+from numpy.lib.stride_tricks import sliding_window_view
+
+############
+## SCRIPT ##
+############
+
+if len(sys.argv) == 8:
+  C_in  = int(sys.argv[1])
+  C_out = int(sys.argv[2])
+  H     = int(sys.argv[3])
+  W     = int(sys.argv[4])
+  K     = int(sys.argv[5])
+  L     = int(sys.argv[6])
+  K1    = int(sys.argv[7])
+else:
+  print("Error. Give me seven arguments: the input and output channels, the "
+        "height and width of the images, the filter size, the samples of the "
+        "signal, and its filter size.")
+  sys.exit()
+
+if K > H or K > W or K1 > L:
+  print("Error. The filters must not be larger than the inputs.")
+  sys.exit()
+
+i  = np.random.uniform(-1, 1, (C_in, H, W)).astype(np.float32)
+f  = np.random.uniform(-1, 1, (C_out, C_in, K, K)).astype(np.float32)
+x  = np.random.uniform(-1, 1, L).astype(np.float32)
+f1 = np.random.uniform(-1, 1, K1).astype(np.float32)
+
+# Valid correlations, in FP64
+win     = sliding_window_view(i.astype(np.float64), (K, K), axis=(1, 2))
+gold_o  = np.einsum('cyxkl,ockl->oyx', win, f.astype(np.float64))
+gold_o1 = sliding_window_view(x.astype(np.float64), K1) @ f1.astype(np.float64)
+
+# Create the file
+print(".section .data,\"aw\",@progbits")
+emit("C_in", np.array(C_in, dtype=np.uint64))
+emit("C_out", np.array(C_out, dtype=np.uint64))
+emit("H", np.array(H, dtype=np.uint64))
+emit("W", np.array(W, dtype=np.uint64))
+emit("K", np.array(K, dtype=np.uint64))
+emit("L", np.array(L, dtype=np.uint64))
+emit("K1", np.array(K1, dtype=np.uint64))
+emit("i", i, 'NR_LANES*4')
+emit("f", f, 'NR_LANES*4')
+emit("o", np.zeros(gold_o.shape, dtype=np.float32), 'NR_LANES*4')
+emit("gold_o", gold_o.astype(np.float32), 'NR_LANES*4')
+emit("x", x, 'NR_LANES*4')
+emit("f1", f1, 'NR_LANES*4')
+emit("o1", np.zeros(gold_o1.shape, dtype=np.float32), 'NR_LANES*4')
+emit("gold_o1", gold_o1.astype(np.float32), 'NR_LANES*4')
@@ -0,0 +1,277 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "fgemv.h"
+
+// y = A x: the rows of A are reduced 4 at a time against the same chunk of x
+void fgemv_n_64b(double *y, const double *a, const double *x,
+                 const unsigned long int M, const unsigned long int N) {
+  size_t vlmax;
+  asm volatile("vsetvli %0, %1, e64, m4, tu, ma" : "=r"(vlmax) : "r"(N));
+
+  unsigned long int m = 0;
+
+  for (; m + 4 <= M; m += 4) {
+    const double *a_ = a + m * N;
+    const double *x_ = x;
+    double r0, r1, r2, r3;
+    size_t vl;
+
+    // Stripmine and accumulate the partial products of the 4 rows. The
+    // accumulators are tail-undisturbed, so that the last, shorter chunk
+    // keeps the partial sums of the previous ones.
+    for (size_t avl = N; avl > 0; avl -= vl) {
+      asm volatile("vsetvli %0, %1, e64, m4, tu, ma" : "=r"(vl) : "r"(avl));
+      asm volatile("vle64.v v0, (%0)" ::"r"(x_));
+      asm volatile("vle64.v v24, (%0)" ::"r"(a_));
+      asm volatile("vle64.v v28, (%0)" ::"r"(a_ + N));
+      if (avl == N) {
+        asm volatile("vfmul.vv v8, v24, v0");
+        asm volatile("vle64.v v24, (%0)" ::"r"(a_ + 2 * N));
+        asm volatile("vfmul.vv v12, v28, v0");
+        asm volatile("vle64.v v28, (%0)" ::"r"(a_ + 3 * N));
+        asm volatile("vfmul.vv v16, v24, v0");
+        asm volatile("vfmul.vv v20, v28, v0");
+      } else {
+        asm volatile("vfmacc.vv v8, v24, v0");
+        asm volatile("vle64.v v24, (%0)" ::"r"(a_ + 2 * N));
+        asm volatile("vfmacc.vv v12, v28, v0");
+        asm volatile("vle64.v v28, (%0)" ::"r"(a_ + 3 * N));
+        asm volatile("vfmacc.vv v16, v24, v0");
+        asm volatile("vfmacc.vv v20, v28, v0");
+      }
+      // Bump pointers
+      a_ += vl;
+      x_ += vl;
+    }
+
+    // Reduce the full accumulators
+    asm volatile("vsetvli zero, %0, e64, m4, ta, ma" ::"r"(vlmax));
+    asm volatile("vmv.s.x v4, zero");
+    asm volatile("vfredusum.vs v5, v8, v4");
+    asm volatile("vfredusum.vs v6, v12, v4");
+    asm volatile("vfredusum.vs v7, v16, v4");
+    asm volatile("vfredusum.vs v4, v20, v4");
+    asm volatile("vfmv.f.s %0, v5" : "=f"(r0));
+    asm volatile("vfmv.f.s %0, v6" : "=f"(r1));
+    asm volatile("vfmv.f.s %0, v7" : "=f"(r2));
+    asm volatile("vfmv.f.s %0, v4" : "=f"(r3));
+    y[m] = r0;
+    y[m + 1] = r1;
+    y[m + 2] = r2;
+    y[m + 3] = r3;
+  }
+
+  // Remaining rows
+  for (; m < M; ++m) {
+    const double *a_ = a + m * N;
+    const double *x_ = x;
+    double r0;
+    size_t vl;
+
+    for (size_t avl = N; avl > 0; avl -= vl) {
+      asm volatile("vsetvli %0, %1, e64, m4, tu, ma" : "=r"(vl) : "r"(avl));
+      asm volatile("vle64.v v0, (%0)" ::"r"(x_));
+      asm volatile("vle64.v v24, (%0)" ::"r"(a_));
+      if (avl == N) {
+        asm volatile("vfmul.vv v8, v24, v0");
+      } else {
+        asm volatile("vfmacc.vv v8, v24, v0");
+      }
+      a_ += vl;
+      x_ += vl;
+    }
+
+    asm volatile("vsetvli zero, %0, e64, m4, ta, ma" ::"r"(vlmax));
+    asm volatile("vmv.s.x v4, zero");
+    asm volatile("vfredusum.vs v4, v8, v4");
+    asm volatile("vfmv.f.s %0, v4" : "=f"(r0));
+    y[m] = r0;
+  }
+}
+
+// y = A^T x: axpy of the rows of A, scaled by the elements of x, on a chunk of
+// y at a time
+void fgemv_t_64b(double *y, const double *a, const double *x,
+                 const unsigned long int M, const unsigned long int N) {
+  size_t vl;
+
+  for (unsigned long int n = 0; n < N; n += vl) {
+    asm volatile("vsetvli %0, %1, e64, m8, ta, ma" : "=r"(vl) : "r"(N - n));
+
+    const double *a_ = a + n;
+
+    // Prefetch one row of A
+    asm volatile("vle64.v v8, (%0)" ::"r"(a_));
+    a_ += N;
+    asm volatile("vmv.v.i v0, 0");
+
+    unsigned long int m = 0;
+
+    while (1) {
+      // Load the next row of A
+      if (++m != M) {
+        asm volatile("vle64.v v16, (%0)" ::"r"(a_));
+        a_ += N;
+      }
+      asm volatile("vfmacc.vf v0, %0, v8" ::"f"(x[m - 1]));
+
+      if (m == M)
+        break;
+
+      if (++m != M) {
+        asm volatile("vle64.v v8, (%0)" ::"r"(a_));
+        a_ += N;
+      }
+      asm volatile("vfmacc.vf v0, %0, v16" ::"f"(x[m - 1]));
+
+      if (m == M)
+        break;
+    }
+
+    asm volatile("vse64.v v0, (%0)" ::"r"(y + n));
+  }
+}
+
+// y = A x: the rows of A are reduced 4 at a time against the same chunk of x
+void fgemv_n_32b(float *y, const float *a, const float *x,
+                 const unsigned long int M, const unsigned long int N) {
+  size_t vlmax;
+  asm volatile("vsetvli %0, %1, e32, m4, tu, ma" : "=r"(vlmax) : "r"(N));
+
+  unsigned long int m = 0;
+
+  for (; m + 4 <= M; m += 4) {
+    const float *a_ = a + m * N;
+    const float *x_ = x;
+    float r0, r1, r2, r3;
+    size_t vl;
+
+    // Stripmine and accumulate the partial products of the 4 rows. The
+    // accumulators are tail-undisturbed, so that the last, shorter chunk
+    // keeps the partial sums of the previous ones.
+    for (size_t avl = N; avl > 0; avl -= vl) {
+      asm volatile("vsetvli %0, %1, e32, m4, tu, ma" : "=r"(vl) : "r"(avl));
+      asm volatile("vle32.v v0, (%0)" ::"r"(x_));
+      asm volatile("vle32.v v24, (%0)" ::"r"(a_));
+      asm volatile("vle32.v v28, (%0)" ::"r"(a_ + N));
+      if (avl == N) {
+        asm volatile("vfmul.vv v8, v24, v0");
+        asm volatile("vle32.v v24, (%0)" ::"r"(a_ + 2 * N));
+        asm volatile("vfmul.vv v12, v28, v0");
+        asm volatile("vle32.v v28, (%0)" ::"r"(a_ + 3 * N));
+        asm volatile("vfmul.vv v16, v24, v0");
+        asm volatile("vfmul.vv v20, v28, v0");
+      } else {
+        asm volatile("vfmacc.vv v8, v24, v0");
+        asm volatile("vle32.v v24, (%0)" ::"r"(a_ + 2 * N));
+        asm volatile("vfmacc.vv v12, v28, v0");
+        asm volatile("vle32.v v28, (%0)" ::"r"(a_ + 3 * N));
+        asm volatile("vfmacc.vv v16, v24, v0");
+        asm volatile("vfmacc.vv v20, v28, v0");
+      }
+      // Bump pointers
+      a_ += vl;
+      x_ += vl;
+    }
+
+    // Reduce the full accumulators
+    asm volatile("vsetvli zero, %0, e32, m4, ta, ma" ::"r"(vlmax));
+    asm volatile("vmv.s.x v4, zero");
+    asm volatile("vfredusum.vs v5, v8, v4");
+    asm volatile("vfredusum.vs v6, v12, v4");
+    asm volatile("vfredusum.vs v7, v16, v4");
+    asm volatile("vfredusum.vs v4, v20, v4");
+    asm volatile("vfmv.f.s %0, v5" : "=f"(r0));
+    asm volatile("vfmv.f.s %0, v6" : "=f"(r1));
+    asm volatile("vfmv.f.s %0, v7" : "=f"(r2));
+    asm volatile("vfmv.f.s %0, v4" : "=f"(r3));
+    y[m] = r0;
+    y[m + 1] = r1;
+    y[m + 2] = r2;
+    y[m + 3] = r3;
+  }
+
+  // Remaining rows
+  for (; m < M; ++m) {
+    const float *a_ = a + m * N;
+    const float *x_ = x;
+    float r0;
+    size_t vl;
+
+    for (size_t avl = N; avl > 0; avl -= vl) {
+      asm volatile("vsetvli %0, %1, e32, m4, tu, ma" : "=r"(vl) : "r"(avl));
+      asm volatile("vle32.v v0, (%0)" ::"r"(x_));
+      asm volatile("vle32.v v24, (%0)" ::"r"(a_));
+      if (avl == N) {
+        asm volatile("vfmul.vv v8, v24, v0");
+      } else {
+        asm volatile("vfmacc.vv v8, v24, v0");
+      }
+      a_ += vl;
+      x_ += vl;
+    }
+
+    asm volatile("vsetvli zero, %0, e32, m4, ta, ma" ::"r"(vlmax));
+    asm volatile("vmv.s.x v4, zero");
+    asm volatile("vfredusum.vs v4, v8, v4");
+    asm volatile("vfmv.f.s %0, v4" : "=f"(r0));
+    y[m] = r0;
+  }
+}
+
+// y = A^T x: axpy of the rows of A, scaled by the elements of x, on a chunk of
+// y at a time
+void fgemv_t_32b(float *y, const float *a, const float *x,
+                 const unsigned long int M, const unsigned long int N) {
+  size_t vl;
+
+  for (unsigned long int n = 0; n < N; n += vl) {
+    asm volatile("vsetvli %0, %1, e32, m8, ta, ma" : "=r"(vl) : "r"(N - n));
+
+    const float *a_ = a + n;
+
+    // Prefetch one row of A
+    asm volatile("vle32.v v8, (%0)" ::"r"(a_));
+    a_ += N;
+    asm volatile("vmv.v.i v0, 0");
+
+    unsigned long int m = 0;
+
+    while (1) {
+      // Load the next row of A
+      if (++m != M) {
+        asm volatile("vle32.v v16, (%0)" ::"r"(a_));
+        a_ += N;
+      }
+      asm volatile("vfmacc.vf v0, %0, v8" ::"f"(x[m - 1]));
+
+      if (m == M)
+        break;
+
+      if (++m != M) {
+        asm volatile("vle32.v v8, (%0)" ::"r"(a_));
+        a_ += N;
+      }
+      asm volatile("vfmacc.vf v0, %0, v16" ::"f"(x[m - 1]));
+
+      if (m == M)
+        break;
+    }
+
+    asm volatile("vse32.v v0, (%0)" ::"r"(y + n));
+  }
+}
@@ -0,0 +1,35 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _FGEMV_H_
+#define _FGEMV_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+// A=[MxN] is stored by rows
+// y = A x, with x of N elements and y of M elements
+void fgemv_n_64b(double *y, const double *a, const double *x,
+                 unsigned long int m, unsigned long int n);
+void fgemv_n_32b(float *y, const float *a, const float *x,
+                 unsigned long int m, unsigned long int n);
+// y = A^T x, with x of M elements and y of N elements
+void fgemv_t_64b(double *y, const double *a, const double *x,
+                 unsigned long int m, unsigned long int n);
+void fgemv_t_32b(float *y, const float *a, const float *x,
+                 unsigned long int m, unsigned long int n);
+
+#endif
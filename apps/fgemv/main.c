@@ -0,0 +1,114 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdint.h>
+#include <string.h>
+
+#include "kernel/fgemv.h"
+#include "runtime.h"
+#include "util.h"
+
+#ifndef SPIKE
+#include "printf.h"
+#else
+#include <stdio.h>
+#endif
+
+// y = A x and yt = A^T xt, with A=[MxN]
+extern uint64_t M;
+extern uint64_t N;
+
+extern double a64[] __attribute__((aligned(32 * NR_LANES), section(".l2")));
+extern double x64[] __attribute__((aligned(32 * NR_LANES), section(".l2")));
+extern double xt64[] __attribute__((aligned(32 * NR_LANES), section(".l2")));
+extern double y64[] __attribute__((aligned(32 * NR_LANES), section(".l2")));
+extern double yt64[] __attribute__((aligned(32 * NR_LANES), section(".l2")));
+extern double g64[] __attribute__((aligned(32 * NR_LANES), section(".l2")));
+extern double gt64[] __attribute__((aligned(32 * NR_LANES), section(".l2")));
+
+extern float a32[] __attribute__((aligned(32 * NR_LANES), section(".l2")));
+extern float x32[] __attribute__((aligned(32 * NR_LANES), section(".l2")));
+extern float xt32[] __attribute__((aligned(32 * NR_LANES), section(".l2")));
+extern float y32[] __attribute__((aligned(32 * NR_LANES), section(".l2")));
+extern float yt32[] __attribute__((aligned(32 * NR_LANES), section(".l2")));
+extern float g32[] __attribute__((aligned(32 * NR_LANES), section(".l2")));
+extern float gt32[] __attribute__((aligned(32 * NR_LANES), section(".l2")));
+
+#define THRESHOLD_64b 0.000001
+#define THRESHOLD_32b 0.001
+
+// Verify a vector, and print the outcome
+int verify_64b(const char *name, double *res, double *gold, size_t len,
+               int64_t runtime) {
+  printf("%s: %d cycles, %f FLOP/cycle.\n", name, runtime,
+         2.0 * M * N / runtime);
+  for (size_t i = 0; i < len; ++i)
+    if (!similarity_check(res[i], gold[i], THRESHOLD_64b)) {
+      printf("Error: %s[%d] = %f != %f\n", name, i, res[i], gold[i]);
+      return 1;
+    }
+  return 0;
+}
+
+int verify_32b(const char *name, float *res, float *gold, size_t len,
+               int64_t runtime) {
+  printf("%s: %d cycles, %f FLOP/cycle.\n", name, runtime,
+         2.0 * M * N / runtime);
+  for (size_t i = 0; i < len; ++i)
+    if (!similarity_check_32b(res[i], gold[i], THRESHOLD_32b)) {
+      printf("Error: %s[%d] = %f != %f\n", name, i, res[i], gold[i]);
+      return 1;
+    }
+  return 0;
+}
+
+int main() {
+  printf("\n");
+  printf("===========\n");
+  printf("=  FGEMV  =\n");
+  printf("===========\n");
+  printf("\n");
+  printf("\n");
+
+  printf("Calculating a (%d x %d) matrix-vector product...\n", M, N);
+
+  int error = 0;
+
+  start_timer();
+  fgemv_n_64b(y64, a64, x64, M, N);
+  stop_timer();
+  error |= verify_64b("fgemv_n_64b", y64, g64, M, get_timer());
+
+  start_timer();
+  fgemv_t_64b(yt64, a64, xt64, M, N);
+  stop_timer();
+  error |= verify_64b("fgemv_t_64b", yt64, gt64, N, get_timer());
+
+  start_timer();
+  fgemv_n_32b(y32, a32, x32, M, N);
+  stop_timer();
+  error |= verify_32b("fgemv_n_32b", y32, g32, M, get_timer());
+
+  start_timer();
+  fgemv_t_32b(yt32, a32, xt32, M, N);
+  stop_timer();
+  error |= verify_32b("fgemv_t_32b", yt32, gt32, N, get_timer());
+
+  if (!error)
+    printf("Passed.\n");
+
+  return error;
+}
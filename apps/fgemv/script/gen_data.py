@@ -0,0 +1,61 @@
+#!/usr/bin/env python3
+# Copyright 2022 ETH Zurich and University of Bologna.
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+# Author: Matteo Perotti
+
+# y = A x and yt = A^T xt, with A=[MxN]
+# arg1, arg2: M, N
+
+import numpy as np
+import os
+import sys
+
+sys.path.insert(0, os.path.join(os.path.dirname(__file__), '../../common/script'))
+from data_emit import emit
+
+############
+## SCRIPT ##
+############
+
+if len(sys.argv) == 3:
+  M = int(sys.argv[1])
+  N = int(sys.argv[2])
+else:
+  print("Error. Give me two arguments: M, N.")
+  print("y = A x and yt = A^T xt, with A=[MxN]")
+  sys.exit()
+
+print(".section .data,\"aw\",@progbits")
+emit("M", np.array(M, dtype=np.uint64))
+emit("N", np.array(N, dtype=np.uint64))
+
+for bits, dtype in ((64, np.float64), (32, np.float32)):
+  # Matrix and vectors
+  A  = np.random.rand(M, N).astype(dtype)
+  X  = np.random.rand(N).astype(dtype)
+  XT = np.random.rand(M).astype(dtype)
+  # Golden results
+  G  = np.matmul(A.astype(np.float64), X.astype(np.float64)).astype(dtype)
+  GT = np.matmul(A.T.astype(np.float64), XT.astype(np.float64)).astype(dtype)
+
+  emit("a%d" % bits, A, 'NR_LANES*4')
+  emit("x%d" % bits, X, 'NR_LANES*4')
+  emit("xt%d" % bits, XT, 'NR_LANES*4')
+  emit("y%d" % bits, np.zeros(M, dtype=dtype), 'NR_LANES*4')
+  emit("yt%d" % bits, np.zeros(N, dtype=dtype), 'NR_LANES*4')
+  emit("g%d" % bits, G, 'NR_LANES*4')
+  emit("gt%d" % bits, GT, 'NR_LANES*4')
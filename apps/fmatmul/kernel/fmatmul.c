@@ -18,29 +18,78 @@
 //         Samuel Riedel, ETH Zurich
 
 #include "fmatmul.h"
+#include "tile.h"
+#include "vconfig.h"
+#include "vmath/vmath.h"
+
+// Winners of scripts/autotune.py fmatmul, if it was run
+#if __has_include("tuned/fmatmul_tuned.h")
+#include "tuned/fmatmul_tuned.h"
+#endif
 
 #define MIN(a, b) ((a) < (b) ? (a) : (b))
 
+// Rows of the micro-kernel for M: FMATMUL_KERNEL, or the winner of the
+// largest tuned size not above M, if it divides M. 0 picks the kernel by size.
+static unsigned long int fmatmul_rows(const unsigned long int M) {
+#if defined(FMATMUL_KERNEL)
+  (void)M;
+  return FMATMUL_KERNEL;
+#elif defined(FMATMUL_TUNED_TABLE)
+  static const unsigned long int table[][2] = FMATMUL_TUNED_TABLE;
+  unsigned long int rows = 0;
+  for (unsigned long int t = 0; t < sizeof(table) / sizeof(table[0]); ++t)
+    if (table[t][0] <= M)
+      rows = table[t][1];
+  return (rows && M % rows == 0) ? rows : 0;
+#else
+  (void)M;
+  return 0;
+#endif
+}
+
 void fmatmul(double *c, const double *a, const double *b,
              const unsigned long int M, const unsigned long int N,
              const unsigned long int P) {
-  if (M <= 4) {
+  const unsigned long int rows = fmatmul_rows(M);
+  if (rows == 16) {
+    fmatmul_16x16(c, a, b, M, N, P);
+  } else if (rows == 8) {
+    fmatmul_8x8(c, a, b, M, N, P);
+  } else if (rows == 4) {
+    fmatmul_4x4(c, a, b, M, N, P);
+  } else if (M <= 4) {
     fmatmul_4x4(c, a, b, M, N, P);
   } else if (M <= 8) {
     fmatmul_8x8(c, a, b, M, N, P);
-  } else if (M <= 64) {
+  } else if (M <= VLMAX_E64M1) {
+    // A row of C fits in a vector register
     fmatmul_16x16(c, a, b, M, N, P);
-  } else if (M <= 128) {
-    // Vector length is 64 elements. With an 8x8 matmul,
-    // we can use LMUL=2, having a vl of 128.
+  } else if (M <= VLMAX_E64M2) {
+    // With an 8x8 matmul, we can use LMUL=2, having a vl of 2 * VLMAX_E64M1
     fmatmul_8x8(c, a, b, M, N, P);
   } else {
-    // Vector length is 64 elements. With an 4x4 matmul,
-    // we can use LMUL=4, having a vl of 256.
+    // With an 4x4 matmul, we can use LMUL=4, having a vl of 4 * VLMAX_E64M1
     fmatmul_4x4(c, a, b, M, N, P);
   }
 }
 
+// Scalar reference, in the i-k-j order, whose inner loop runs on the rows of B
+// and C. autovec=1 (common/runtime.mk) lets LLVM vectorize it.
+void fmatmul_scalar(double *c, const double *a, const double *b,
+                    const unsigned long int M, const unsigned long int N,
+                    const unsigned long int P) {
+  for (unsigned long int m = 0; m < M; ++m) {
+    for (unsigned long int p = 0; p < P; ++p)
+      c[m * P + p] = 0;
+    for (unsigned long int n = 0; n < N; ++n) {
+      const double a_mn = a[m * N + n];
+      for (unsigned long int p = 0; p < P; ++p)
+        c[m * P + p] += a_mn * b[n * P + p];
+    }
+  }
+}
+
 // ---------------
 // 4x4
 // ---------------
@@ -562,3 +611,757 @@ void fmatmul_vec_16x16(double *c, const double *a, const double *b,
   asm volatile("vfmacc.vf v15, %0, v17" ::"f"(t15));
   asm volatile("vse64.v v15, (%0);" ::"r"(c));
 }
+
+// ---------------
+// Tiled
+// ---------------
+
+// Set the vector length for e64 and the given LMUL
+static unsigned long int fmatmul_tiled_setvl(const unsigned long int avl,
+                                             const unsigned long int lmul) {
+  unsigned long int vl;
+
+  if (lmul == 1)
+    asm volatile("vsetvli %0, %1, e64, m1, ta, ma" : "=r"(vl) : "r"(avl));
+  else if (lmul == 2)
+    asm volatile("vsetvli %0, %1, e64, m2, ta, ma" : "=r"(vl) : "r"(avl));
+  else
+    asm volatile("vsetvli %0, %1, e64, m4, ta, ma" : "=r"(vl) : "r"(avl));
+
+  return vl;
+}
+
+// GELU or SiLU of the rows x cols block of C at c, right after the
+// micro-kernels have stored it. vmath needs more temporaries than the
+// micro-kernels leave free, so this runs with LMUL=2 on its own.
+static void fmatmul_tiled_act(double *c, const unsigned long int rows,
+                              const unsigned long int cols,
+                              const unsigned long int ldc,
+                              const fmatmul_act_t act) {
+  size_t vl;
+
+  for (unsigned long int r = 0; r < rows; ++r) {
+    for (unsigned long int j = 0; j < cols; j += vl) {
+      vl = vsetvl_e64m2(cols - j);
+      vfloat64m2_t t = vle64_v_f64m2(c + r * ldc + j, vl);
+      if (act == FMATMUL_ACT_GELU)
+        t = vmath_gelu_f64m2(t, vl);
+      else
+        t = vmath_silu_f64m2(t, vl);
+      vse64_v_f64m2(c + r * ldc + j, t, vl);
+    }
+  }
+}
+
+static void fmatmul_tiled_run(double *c, const double *a, const double *b,
+                              unsigned long int M, unsigned long int N,
+                              unsigned long int P, unsigned long int lda,
+                              unsigned long int ldb, unsigned long int ldc,
+                              const double *bias, fmatmul_act_t act, int acc);
+
+// C = AB, with no epilogue
+void fmatmul_tiled(double *c, const double *a, const double *b,
+                   const unsigned long int M, const unsigned long int N,
+                   const unsigned long int P, const unsigned long int lda,
+                   const unsigned long int ldb, const unsigned long int ldc) {
+  fmatmul_tiled_run(c, a, b, M, N, P, lda, ldb, ldc, 0, FMATMUL_ACT_NONE, 0);
+}
+
+// C += AB: the first K tile starts from C, instead of from zero
+void fmatmul_tiled_acc(double *c, const double *a, const double *b,
+                       const unsigned long int M, const unsigned long int N,
+                       const unsigned long int P, const unsigned long int lda,
+                       const unsigned long int ldb,
+                       const unsigned long int ldc) {
+  fmatmul_tiled_run(c, a, b, M, N, P, lda, ldb, ldc, 0, FMATMUL_ACT_NONE, 1);
+}
+
+void fmatmul_tiled_epilogue(double *c, const double *a, const double *b,
+                            const unsigned long int M,
+                            const unsigned long int N,
+                            const unsigned long int P,
+                            const unsigned long int lda,
+                            const unsigned long int ldb,
+                            const unsigned long int ldc, const double *bias,
+                            const fmatmul_act_t act) {
+  fmatmul_tiled_run(c, a, b, M, N, P, lda, ldb, ldc, bias, act, 0);
+}
+
+// Shape of the tiles of fmatmul_tiled_run
+typedef struct {
+  unsigned long int lmul, rows, kc, mc;
+} fmatmul_tiling_t;
+
+static fmatmul_tiling_t fmatmul_tiling(const unsigned long int M,
+                                       const unsigned long int N,
+                                       const unsigned long int P) {
+  fmatmul_tiling_t t;
+
+  // The micro-kernel keeps 16 rows of C with LMUL=1, 8 rows with LMUL=2, and
+  // 4 rows with LMUL=4. Pick the shortest vectors that cover P, unless M is
+  // too small to use all the rows.
+  t.lmul = (P <= VLMAX_E64M1) ? 1 : (P <= VLMAX_E64M2) ? 2 : 4;
+  if (M <= 4)
+    t.lmul = 4;
+  else if (M <= 8 && t.lmul == 1)
+    t.lmul = 2;
+  t.rows = 16 / t.lmul;
+
+  // K tile, and panel of rows of A that share it
+  t.kc = MIN(N, FMATMUL_KC);
+  t.mc = FMATMUL_L1_BYTES / (t.kc * sizeof(double));
+  t.mc = (t.mc < t.rows) ? t.rows : t.mc - t.mc % t.rows;
+  return t;
+}
+
+// The m_ x P block of C at c from the panel of m_ x k_ elements of A at a and
+// the k_ rows of B at b, which is the last K tile of C if last
+static void fmatmul_tiled_panel(double *c, const double *a, const double *b,
+                                const fmatmul_tiling_t *t,
+                                const unsigned long int m_,
+                                const unsigned long int k_,
+                                const unsigned long int P,
+                                const unsigned long int lda,
+                                const unsigned long int ldb,
+                                const unsigned long int ldc, const double *bias,
+                                const fmatmul_act_t act, const int accumulate,
+                                const int last) {
+  const unsigned long int rows = t->rows;
+  const int relu = last && act == FMATMUL_ACT_RELU;
+
+  // Slice the matrix into a manageable number of columns p_
+  unsigned long int p_;
+  for (unsigned long int p = 0; p < P; p += p_) {
+    p_ = fmatmul_tiled_setvl(P - p, t->lmul);
+
+    // Find pointers to the submatrices
+    const double *b_ = b + p;
+    double *c_ = c + p;
+    const double *bias_ = (last && bias) ? bias + p : 0;
+
+    // Iterate over the rows. The kernels with fewer rows work with any
+    // smaller LMUL, and finish the rows that do not fill a full block.
+    unsigned long int r = 0;
+    for (; r + rows <= m_; r += rows) {
+      if (rows == 16)
+        fmatmul_tile_16(c_ + r * ldc, a + r * lda, b_, k_, lda, ldb, ldc,
+                        accumulate, bias_, relu);
+      else if (rows == 8)
+        fmatmul_tile_8(c_ + r * ldc, a + r * lda, b_, k_, lda, ldb, ldc,
+                       accumulate, bias_, relu);
+      else
+        fmatmul_tile_4(c_ + r * ldc, a + r * lda, b_, k_, lda, ldb, ldc,
+                       accumulate, bias_, relu);
+    }
+    for (; r + 8 <= m_ && t->lmul <= 2; r += 8)
+      fmatmul_tile_8(c_ + r * ldc, a + r * lda, b_, k_, lda, ldb, ldc,
+                     accumulate, bias_, relu);
+    for (; r + 4 <= m_; r += 4)
+      fmatmul_tile_4(c_ + r * ldc, a + r * lda, b_, k_, lda, ldb, ldc,
+                     accumulate, bias_, relu);
+    for (; r < m_; ++r)
+      fmatmul_tile_1(c_ + r * ldc, a + r * lda, b_, k_, lda, ldb, ldc,
+                     accumulate, bias_, relu);
+
+    if (last && (act == FMATMUL_ACT_GELU || act == FMATMUL_ACT_SILU))
+      fmatmul_tiled_act(c_, m_, p_, ldc, act);
+  }
+}
+
+// C = act(AB + bias), or act(C + AB + bias) with acc, with A=[MxN], B=[NxP],
+// C=[MxP], stored by rows with leading dimensions lda, ldb, and ldc.
+// The matrices are computed in K tiles of FMATMUL_KC columns of A (rows of
+// B), and the partial sums of C stay in the VRF for a whole K tile. Ara loads
+// B from the L2, while CVA6 reads the scalars of A through its data cache:
+// the rows of A are then grouped into panels of at most FMATMUL_L1_BYTES per K
+// tile, which stay cached while the kernel sweeps the P columns.
+// The micro-kernels add the bias and apply the ReLU in the VRF before their
+// stores of the last K tile, so that this epilogue costs no pass over C. GELU
+// and SiLU rewrite each slice of p_ columns of a panel right after its stores.
+static void fmatmul_tiled_run(double *c, const double *a, const double *b,
+                              const unsigned long int M,
+                              const unsigned long int N,
+                              const unsigned long int P,
+                              const unsigned long int lda,
+                              const unsigned long int ldb,
+                              const unsigned long int ldc, const double *bias,
+                              const fmatmul_act_t act, const int acc) {
+  if (M == 0 || N == 0 || P == 0)
+    return;
+
+  const fmatmul_tiling_t t = fmatmul_tiling(M, N, P);
+
+  for (unsigned long int m = 0; m < M; m += t.mc) {
+    const unsigned long int m_ = MIN(M - m, t.mc);
+
+    for (unsigned long int k = 0; k < N; k += t.kc) {
+      const unsigned long int k_ = MIN(N - k, t.kc);
+      fmatmul_tiled_panel(c + m * ldc, a + m * lda + k, b + k * ldb, &t, m_,
+                          k_, P, lda, ldb, ldc, bias, act, acc || k != 0,
+                          k + k_ == N);
+    }
+  }
+}
+
+// Panels of A of fmatmul_tiled_packed, in the order of fmatmul_tiled_run
+typedef struct {
+  double *c;
+  const double *a, *b;
+  unsigned long int M, N, P, lda, ldb, ldc, nk;
+  fmatmul_tiling_t t;
+} fmatmul_packed_t;
+
+static tile_t fmatmul_packed_next(size_t i, void *ctx) {
+  const fmatmul_packed_t *s = ctx;
+  const unsigned long int m = (i / s->nk) * s->t.mc;
+  const unsigned long int k = (i % s->nk) * s->t.kc;
+  const tile_t tile = {s->a + m * s->lda + k,
+                       MIN(s->N - k, s->t.kc) * sizeof(double),
+                       MIN(s->M - m, s->t.mc), s->lda * sizeof(double)};
+  return tile;
+}
+
+static void fmatmul_packed_compute(const void *tile, uint64_t stride, size_t i,
+                                   void *ctx) {
+  const fmatmul_packed_t *s = ctx;
+  const unsigned long int m = (i / s->nk) * s->t.mc;
+  const unsigned long int k = (i % s->nk) * s->t.kc;
+  const unsigned long int k_ = MIN(s->N - k, s->t.kc);
+  fmatmul_tiled_panel(s->c + m * s->ldc, tile, s->b + k * s->ldb, &s->t,
+                      MIN(s->M - m, s->t.mc), k_, s->P,
+                      stride / sizeof(double), s->ldb, s->ldc, 0,
+                      FMATMUL_ACT_NONE, k != 0, k + k_ == s->N);
+}
+
+// C = AB as fmatmul_tiled, with each panel of A packed into a dense buffer by
+// the DMA engine while the kernel computes on the previous one
+void fmatmul_tiled_packed(double *c, const double *a, const double *b,
+                          const unsigned long int M, const unsigned long int N,
+                          const unsigned long int P,
+                          const unsigned long int lda,
+                          const unsigned long int ldb,
+                          const unsigned long int ldc) {
+  if (M == 0 || N == 0 || P == 0)
+    return;
+
+  fmatmul_packed_t s = {c, a, b, M, N, P, lda, ldb, ldc, 0,
+                        fmatmul_tiling(M, N, P)};
+  s.nk = (N + s.t.kc - 1) / s.t.kc;
+  const size_t nm = (M + s.t.mc - 1) / s.t.mc;
+  tile_run(nm * s.nk, s.t.mc * s.t.kc * sizeof(double), fmatmul_packed_next,
+           fmatmul_packed_compute, &s);
+}
+
+void fmatmul_tile_16(double *c, const double *a, const double *b,
+                     const unsigned long int K, const unsigned long int lda,
+                     const unsigned long int ldb, const unsigned long int ldc,
+                     const int accumulate, const double *bias, const int relu) {
+  // Temporary variables
+  double t0, t1, t2, t3, t4, t5, t6, t7, t8, t9, t10, t11, t12, t13, t14, t15;
+
+  // Start from the partial sums of the previous K tiles, or from zero
+  if (accumulate) {
+    asm volatile("vle64.v v0, (%0);" ::"r"(c));
+    asm volatile("vle64.v v1, (%0);" ::"r"(c + 1 * ldc));
+    asm volatile("vle64.v v2, (%0);" ::"r"(c + 2 * ldc));
+    asm volatile("vle64.v v3, (%0);" ::"r"(c + 3 * ldc));
+    asm volatile("vle64.v v4, (%0);" ::"r"(c + 4 * ldc));
+    asm volatile("vle64.v v5, (%0);" ::"r"(c + 5 * ldc));
+    asm volatile("vle64.v v6, (%0);" ::"r"(c + 6 * ldc));
+    asm volatile("vle64.v v7, (%0);" ::"r"(c + 7 * ldc));
+    asm volatile("vle64.v v8, (%0);" ::"r"(c + 8 * ldc));
+    asm volatile("vle64.v v9, (%0);" ::"r"(c + 9 * ldc));
+    asm volatile("vle64.v v10, (%0);" ::"r"(c + 10 * ldc));
+    asm volatile("vle64.v v11, (%0);" ::"r"(c + 11 * ldc));
+    asm volatile("vle64.v v12, (%0);" ::"r"(c + 12 * ldc));
+    asm volatile("vle64.v v13, (%0);" ::"r"(c + 13 * ldc));
+    asm volatile("vle64.v v14, (%0);" ::"r"(c + 14 * ldc));
+    asm volatile("vle64.v v15, (%0);" ::"r"(c + 15 * ldc));
+  } else {
+    asm volatile("vmv.v.i v0, 0");
+    asm volatile("vmv.v.i v1, 0");
+    asm volatile("vmv.v.i v2, 0");
+    asm volatile("vmv.v.i v3, 0");
+    asm volatile("vmv.v.i v4, 0");
+    asm volatile("vmv.v.i v5, 0");
+    asm volatile("vmv.v.i v6, 0");
+    asm volatile("vmv.v.i v7, 0");
+    asm volatile("vmv.v.i v8, 0");
+    asm volatile("vmv.v.i v9, 0");
+    asm volatile("vmv.v.i v10, 0");
+    asm volatile("vmv.v.i v11, 0");
+    asm volatile("vmv.v.i v12, 0");
+    asm volatile("vmv.v.i v13, 0");
+    asm volatile("vmv.v.i v14, 0");
+    asm volatile("vmv.v.i v15, 0");
+  }
+
+  // Prefetch one row of matrix B
+  asm volatile("vle64.v v16, (%0);" ::"r"(b));
+  b += ldb;
+
+  // Compute the multiplication. The odd K are handled by the early exits.
+  unsigned long int k = 0;
+
+  while (1) {
+    // Load one column of scalar values
+    t0 = a[0];
+    t1 = a[1 * lda];
+    t2 = a[2 * lda];
+    t3 = a[3 * lda];
+    t4 = a[4 * lda];
+    t5 = a[5 * lda];
+    t6 = a[6 * lda];
+    t7 = a[7 * lda];
+    t8 = a[8 * lda];
+    t9 = a[9 * lda];
+    t10 = a[10 * lda];
+    t11 = a[11 * lda];
+    t12 = a[12 * lda];
+    t13 = a[13 * lda];
+    t14 = a[14 * lda];
+    t15 = a[15 * lda];
+    a++;
+
+    // Load the next row of B
+    if (++k != K) {
+      asm volatile("vle64.v v17, (%0);" ::"r"(b));
+      b += ldb;
+    }
+
+    asm volatile("vfmacc.vf v0, %0, v16" ::"f"(t0));
+    asm volatile("vfmacc.vf v1, %0, v16" ::"f"(t1));
+    asm volatile("vfmacc.vf v2, %0, v16" ::"f"(t2));
+    asm volatile("vfmacc.vf v3, %0, v16" ::"f"(t3));
+    asm volatile("vfmacc.vf v4, %0, v16" ::"f"(t4));
+    asm volatile("vfmacc.vf v5, %0, v16" ::"f"(t5));
+    asm volatile("vfmacc.vf v6, %0, v16" ::"f"(t6));
+    asm volatile("vfmacc.vf v7, %0, v16" ::"f"(t7));
+    asm volatile("vfmacc.vf v8, %0, v16" ::"f"(t8));
+    asm volatile("vfmacc.vf v9, %0, v16" ::"f"(t9));
+    asm volatile("vfmacc.vf v10, %0, v16" ::"f"(t10));
+    asm volatile("vfmacc.vf v11, %0, v16" ::"f"(t11));
+    asm volatile("vfmacc.vf v12, %0, v16" ::"f"(t12));
+    asm volatile("vfmacc.vf v13, %0, v16" ::"f"(t13));
+    asm volatile("vfmacc.vf v14, %0, v16" ::"f"(t14));
+    asm volatile("vfmacc.vf v15, %0, v16" ::"f"(t15));
+
+    if (k == K)
+      break;
+
+    // Load one column of scalar values
+    t0 = a[0];
+    t1 = a[1 * lda];
+    t2 = a[2 * lda];
+    t3 = a[3 * lda];
+    t4 = a[4 * lda];
+    t5 = a[5 * lda];
+    t6 = a[6 * lda];
+    t7 = a[7 * lda];
+    t8 = a[8 * lda];
+    t9 = a[9 * lda];
+    t10 = a[10 * lda];
+    t11 = a[11 * lda];
+    t12 = a[12 * lda];
+    t13 = a[13 * lda];
+    t14 = a[14 * lda];
+    t15 = a[15 * lda];
+    a++;
+
+    // Load the next row of B
+    if (++k != K) {
+      asm volatile("vle64.v v16, (%0);" ::"r"(b));
+      b += ldb;
+    }
+
+    asm volatile("vfmacc.vf v0, %0, v17" ::"f"(t0));
+    asm volatile("vfmacc.vf v1, %0, v17" ::"f"(t1));
+    asm volatile("vfmacc.vf v2, %0, v17" ::"f"(t2));
+    asm volatile("vfmacc.vf v3, %0, v17" ::"f"(t3));
+    asm volatile("vfmacc.vf v4, %0, v17" ::"f"(t4));
+    asm volatile("vfmacc.vf v5, %0, v17" ::"f"(t5));
+    asm volatile("vfmacc.vf v6, %0, v17" ::"f"(t6));
+    asm volatile("vfmacc.vf v7, %0, v17" ::"f"(t7));
+    asm volatile("vfmacc.vf v8, %0, v17" ::"f"(t8));
+    asm volatile("vfmacc.vf v9, %0, v17" ::"f"(t9));
+    asm volatile("vfmacc.vf v10, %0, v17" ::"f"(t10));
+    asm volatile("vfmacc.vf v11, %0, v17" ::"f"(t11));
+    asm volatile("vfmacc.vf v12, %0, v17" ::"f"(t12));
+    asm volatile("vfmacc.vf v13, %0, v17" ::"f"(t13));
+    asm volatile("vfmacc.vf v14, %0, v17" ::"f"(t14));
+    asm volatile("vfmacc.vf v15, %0, v17" ::"f"(t15));
+
+    if (k == K)
+      break;
+  }
+
+  // Epilogue of the last K tile, in the VRF: add the bias, then clamp at 0
+  if (bias) {
+    asm volatile("vle64.v v24, (%0);" ::"r"(bias));
+    asm volatile("vfadd.vv v0, v0, v24");
+    asm volatile("vfadd.vv v1, v1, v24");
+    asm volatile("vfadd.vv v2, v2, v24");
+    asm volatile("vfadd.vv v3, v3, v24");
+    asm volatile("vfadd.vv v4, v4, v24");
+    asm volatile("vfadd.vv v5, v5, v24");
+    asm volatile("vfadd.vv v6, v6, v24");
+    asm volatile("vfadd.vv v7, v7, v24");
+    asm volatile("vfadd.vv v8, v8, v24");
+    asm volatile("vfadd.vv v9, v9, v24");
+    asm volatile("vfadd.vv v10, v10, v24");
+    asm volatile("vfadd.vv v11, v11, v24");
+    asm volatile("vfadd.vv v12, v12, v24");
+    asm volatile("vfadd.vv v13, v13, v24");
+    asm volatile("vfadd.vv v14, v14, v24");
+    asm volatile("vfadd.vv v15, v15, v24");
+  }
+  if (relu) {
+    asm volatile("vfmax.vf v0, v0, %0" ::"f"(0.0));
+    asm volatile("vfmax.vf v1, v1, %0" ::"f"(0.0));
+    asm volatile("vfmax.vf v2, v2, %0" ::"f"(0.0));
+    asm volatile("vfmax.vf v3, v3, %0" ::"f"(0.0));
+    asm volatile("vfmax.vf v4, v4, %0" ::"f"(0.0));
+    asm volatile("vfmax.vf v5, v5, %0" ::"f"(0.0));
+    asm volatile("vfmax.vf v6, v6, %0" ::"f"(0.0));
+    asm volatile("vfmax.vf v7, v7, %0" ::"f"(0.0));
+    asm volatile("vfmax.vf v8, v8, %0" ::"f"(0.0));
+    asm volatile("vfmax.vf v9, v9, %0" ::"f"(0.0));
+    asm volatile("vfmax.vf v10, v10, %0" ::"f"(0.0));
+    asm volatile("vfmax.vf v11, v11, %0" ::"f"(0.0));
+    asm volatile("vfmax.vf v12, v12, %0" ::"f"(0.0));
+    asm volatile("vfmax.vf v13, v13, %0" ::"f"(0.0));
+    asm volatile("vfmax.vf v14, v14, %0" ::"f"(0.0));
+    asm volatile("vfmax.vf v15, v15, %0" ::"f"(0.0));
+  }
+
+  // Store the results
+  asm volatile("vse64.v v0, (%0);" ::"r"(c));
+  c += ldc;
+  asm volatile("vse64.v v1, (%0);" ::"r"(c));
+  c += ldc;
+  asm volatile("vse64.v v2, (%0);" ::"r"(c));
+  c += ldc;
+  asm volatile("vse64.v v3, (%0);" ::"r"(c));
+  c += ldc;
+  asm volatile("vse64.v v4, (%0);" ::"r"(c));
+  c += ldc;
+  asm volatile("vse64.v v5, (%0);" ::"r"(c));
+  c += ldc;
+  asm volatile("vse64.v v6, (%0);" ::"r"(c));
+  c += ldc;
+  asm volatile("vse64.v v7, (%0);" ::"r"(c));
+  c += ldc;
+  asm volatile("vse64.v v8, (%0);" ::"r"(c));
+  c += ldc;
+  asm volatile("vse64.v v9, (%0);" ::"r"(c));
+  c += ldc;
+  asm volatile("vse64.v v10, (%0);" ::"r"(c));
+  c += ldc;
+  asm volatile("vse64.v v11, (%0);" ::"r"(c));
+  c += ldc;
+  asm volatile("vse64.v v12, (%0);" ::"r"(c));
+  c += ldc;
+  asm volatile("vse64.v v13, (%0);" ::"r"(c));
+  c += ldc;
+  asm volatile("vse64.v v14, (%0);" ::"r"(c));
+  c += ldc;
+  asm volatile("vse64.v v15, (%0);" ::"r"(c));
+}
+
+void fmatmul_tile_8(double *c, const double *a, const double *b,
+                    const unsigned long int K, const unsigned long int lda,
+                    const unsigned long int ldb, const unsigned long int ldc,
+                    const int accumulate, const double *bias, const int relu) {
+  // Temporary variables
+  double t0, t1, t2, t3, t4, t5, t6, t7;
+
+  // Start from the partial sums of the previous K tiles, or from zero
+  if (accumulate) {
+    asm volatile("vle64.v v0, (%0);" ::"r"(c));
+    asm volatile("vle64.v v2, (%0);" ::"r"(c + 1 * ldc));
+    asm volatile("vle64.v v4, (%0);" ::"r"(c + 2 * ldc));
+    asm volatile("vle64.v v6, (%0);" ::"r"(c + 3 * ldc));
+    asm volatile("vle64.v v8, (%0);" ::"r"(c + 4 * ldc));
+    asm volatile("vle64.v v10, (%0);" ::"r"(c + 5 * ldc));
+    asm volatile("vle64.v v12, (%0);" ::"r"(c + 6 * ldc));
+    asm volatile("vle64.v v14, (%0);" ::"r"(c + 7 * ldc));
+  } else {
+    asm volatile("vmv.v.i v0, 0");
+    asm volatile("vmv.v.i v2, 0");
+    asm volatile("vmv.v.i v4, 0");
+    asm volatile("vmv.v.i v6, 0");
+    asm volatile("vmv.v.i v8, 0");
+    asm volatile("vmv.v.i v10, 0");
+    asm volatile("vmv.v.i v12, 0");
+    asm volatile("vmv.v.i v14, 0");
+  }
+
+  // Prefetch one row of matrix B
+  asm volatile("vle64.v v16, (%0);" ::"r"(b));
+  b += ldb;
+
+  // Compute the multiplication. The odd K are handled by the early exits.
+  unsigned long int k = 0;
+
+  while (1) {
+    // Load one column of scalar values
+    t0 = a[0];
+    t1 = a[1 * lda];
+    t2 = a[2 * lda];
+    t3 = a[3 * lda];
+    t4 = a[4 * lda];
+    t5 = a[5 * lda];
+    t6 = a[6 * lda];
+    t7 = a[7 * lda];
+    a++;
+
+    // Load the next row of B
+    if (++k != K) {
+      asm volatile("vle64.v v18, (%0);" ::"r"(b));
+      b += ldb;
+    }
+
+    asm volatile("vfmacc.vf v0, %0, v16" ::"f"(t0));
+    asm volatile("vfmacc.vf v2, %0, v16" ::"f"(t1));
+    asm volatile("vfmacc.vf v4, %0, v16" ::"f"(t2));
+    asm volatile("vfmacc.vf v6, %0, v16" ::"f"(t3));
+    asm volatile("vfmacc.vf v8, %0, v16" ::"f"(t4));
+    asm volatile("vfmacc.vf v10, %0, v16" ::"f"(t5));
+    asm volatile("vfmacc.vf v12, %0, v16" ::"f"(t6));
+    asm volatile("vfmacc.vf v14, %0, v16" ::"f"(t7));
+
+    if (k == K)
+      break;
+
+    // Load one column of scalar values
+    t0 = a[0];
+    t1 = a[1 * lda];
+    t2 = a[2 * lda];
+    t3 = a[3 * lda];
+    t4 = a[4 * lda];
+    t5 = a[5 * lda];
+    t6 = a[6 * lda];
+    t7 = a[7 * lda];
+    a++;
+
+    // Load the next row of B
+    if (++k != K) {
+      asm volatile("vle64.v v16, (%0);" ::"r"(b));
+      b += ldb;
+    }
+
+    asm volatile("vfmacc.vf v0, %0, v18" ::"f"(t0));
+    asm volatile("vfmacc.vf v2, %0, v18" ::"f"(t1));
+    asm volatile("vfmacc.vf v4, %0, v18" ::"f"(t2));
+    asm volatile("vfmacc.vf v6, %0, v18" ::"f"(t3));
+    asm volatile("vfmacc.vf v8, %0, v18" ::"f"(t4));
+    asm volatile("vfmacc.vf v10, %0, v18" ::"f"(t5));
+    asm volatile("vfmacc.vf v12, %0, v18" ::"f"(t6));
+    asm volatile("vfmacc.vf v14, %0, v18" ::"f"(t7));
+
+    if (k == K)
+      break;
+  }
+
+  // Epilogue of the last K tile, in the VRF: add the bias, then clamp at 0
+  if (bias) {
+    asm volatile("vle64.v v24, (%0);" ::"r"(bias));
+    asm volatile("vfadd.vv v0, v0, v24");
+    asm volatile("vfadd.vv v2, v2, v24");
+    asm volatile("vfadd.vv v4, v4, v24");
+    asm volatile("vfadd.vv v6, v6, v24");
+    asm volatile("vfadd.vv v8, v8, v24");
+    asm volatile("vfadd.vv v10, v10, v24");
+    asm volatile("vfadd.vv v12, v12, v24");
+    asm volatile("vfadd.vv v14, v14, v24");
+  }
+  if (relu) {
+    asm volatile("vfmax.vf v0, v0, %0" ::"f"(0.0));
+    asm volatile("vfmax.vf v2, v2, %0" ::"f"(0.0));
+    asm volatile("vfmax.vf v4, v4, %0" ::"f"(0.0));
+    asm volatile("vfmax.vf v6, v6, %0" ::"f"(0.0));
+    asm volatile("vfmax.vf v8, v8, %0" ::"f"(0.0));
+    asm volatile("vfmax.vf v10, v10, %0" ::"f"(0.0));
+    asm volatile("vfmax.vf v12, v12, %0" ::"f"(0.0));
+    asm volatile("vfmax.vf v14, v14, %0" ::"f"(0.0));
+  }
+
+  // Store the results
+  asm volatile("vse64.v v0, (%0);" ::"r"(c));
+  c += ldc;
+  asm volatile("vse64.v v2, (%0);" ::"r"(c));
+  c += ldc;
+  asm volatile("vse64.v v4, (%0);" ::"r"(c));
+  c += ldc;
+  asm volatile("vse64.v v6, (%0);" ::"r"(c));
+  c += ldc;
+  asm volatile("vse64.v v8, (%0);" ::"r"(c));
+  c += ldc;
+  asm volatile("vse64.v v10, (%0);" ::"r"(c));
+  c += ldc;
+  asm volatile("vse64.v v12, (%0);" ::"r"(c));
+  c += ldc;
+  asm volatile("vse64.v v14, (%0);" ::"r"(c));
+}
+
+void fmatmul_tile_4(double *c, const double *a, const double *b,
+                    const unsigned long int K, const unsigned long int lda,
+                    const unsigned long int ldb, const unsigned long int ldc,
+                    const int accumulate, const double *bias, const int relu) {
+  // Temporary variables
+  double t0, t1, t2, t3;
+
+  // Start from the partial sums of the previous K tiles, or from zero
+  if (accumulate) {
+    asm volatile("vle64.v v0, (%0);" ::"r"(c));
+    asm volatile("vle64.v v4, (%0);" ::"r"(c + 1 * ldc));
+    asm volatile("vle64.v v8, (%0);" ::"r"(c + 2 * ldc));
+    asm volatile("vle64.v v12, (%0);" ::"r"(c + 3 * ldc));
+  } else {
+    asm volatile("vmv.v.i v0, 0");
+    asm volatile("vmv.v.i v4, 0");
+    asm volatile("vmv.v.i v8, 0");
+    asm volatile("vmv.v.i v12, 0");
+  }
+
+  // Prefetch one row of matrix B
+  asm volatile("vle64.v v16, (%0);" ::"r"(b));
+  b += ldb;
+
+  // Compute the multiplication. The odd K are handled by the early exits.
+  unsigned long int k = 0;
+
+  while (1) {
+    // Load one column of scalar values
+    t0 = a[0];
+    t1 = a[1 * lda];
+    t2 = a[2 * lda];
+    t3 = a[3 * lda];
+    a++;
+
+    // Load the next row of B
+    if (++k != K) {
+      asm volatile("vle64.v v20, (%0);" ::"r"(b));
+      b += ldb;
+    }
+
+    asm volatile("vfmacc.vf v0, %0, v16" ::"f"(t0));
+    asm volatile("vfmacc.vf v4, %0, v16" ::"f"(t1));
+    asm volatile("vfmacc.vf v8, %0, v16" ::"f"(t2));
+    asm volatile("vfmacc.vf v12, %0, v16" ::"f"(t3));
+
+    if (k == K)
+      break;
+
+    // Load one column of scalar values
+    t0 = a[0];
+    t1 = a[1 * lda];
+    t2 = a[2 * lda];
+    t3 = a[3 * lda];
+    a++;
+
+    // Load the next row of B
+    if (++k != K) {
+      asm volatile("vle64.v v16, (%0);" ::"r"(b));
+      b += ldb;
+    }
+
+    asm volatile("vfmacc.vf v0, %0, v20" ::"f"(t0));
+    asm volatile("vfmacc.vf v4, %0, v20" ::"f"(t1));
+    asm volatile("vfmacc.vf v8, %0, v20" ::"f"(t2));
+    asm volatile("vfmacc.vf v12, %0, v20" ::"f"(t3));
+
+    if (k == K)
+      break;
+  }
+
+  // Epilogue of the last K tile, in the VRF: add the bias, then clamp at 0
+  if (bias) {
+    asm volatile("vle64.v v24, (%0);" ::"r"(bias));
+    asm volatile("vfadd.vv v0, v0, v24");
+    asm volatile("vfadd.vv v4, v4, v24");
+    asm volatile("vfadd.vv v8, v8, v24");
+    asm volatile("vfadd.vv v12, v12, v24");
+  }
+  if (relu) {
+    asm volatile("vfmax.vf v0, v0, %0" ::"f"(0.0));
+    asm volatile("vfmax.vf v4, v4, %0" ::"f"(0.0));
+    asm volatile("vfmax.vf v8, v8, %0" ::"f"(0.0));
+    asm volatile("vfmax.vf v12, v12, %0" ::"f"(0.0));
+  }
+
+  // Store the results
+  asm volatile("vse64.v v0, (%0);" ::"r"(c));
+  c += ldc;
+  asm volatile("vse64.v v4, (%0);" ::"r"(c));
+  c += ldc;
+  asm volatile("vse64.v v8, (%0);" ::"r"(c));
+  c += ldc;
+  asm volatile("vse64.v v12, (%0);" ::"r"(c));
+}
+
+void fmatmul_tile_1(double *c, const double *a, const double *b,
+                    const unsigned long int K, const unsigned long int lda,
+                    const unsigned long int ldb, const unsigned long int ldc,
+                    const int accumulate, const double *bias, const int relu) {
+  // Temporary variables
+  double t0;
+
+  // Start from the partial sums of the previous K tiles, or from zero
+  if (accumulate) {
+    asm volatile("vle64.v v0, (%0);" ::"r"(c));
+  } else {
+    asm volatile("vmv.v.i v0, 0");
+  }
+
+  // Prefetch one row of matrix B
+  asm volatile("vle64.v v16, (%0);" ::"r"(b));
+  b += ldb;
+
+  // Compute the multiplication. The odd K are handled by the early exits.
+  unsigned long int k = 0;
+
+  while (1) {
+    // Load one column of scalar values
+    t0 = a[0];
+    a++;
+
+    // Load the next row of B
+    if (++k != K) {
+      asm volatile("vle64.v v20, (%0);" ::"r"(b));
+      b += ldb;
+    }
+
+    asm volatile("vfmacc.vf v0, %0, v16" ::"f"(t0));
+
+    if (k == K)
+      break;
+
+    // Load one column of scalar values
+    t0 = a[0];
+    a++;
+
+    // Load the next row of B
+    if (++k != K) {
+      asm volatile("vle64.v v16, (%0);" ::"r"(b));
+      b += ldb;
+    }
+
+    asm volatile("vfmacc.vf v0, %0, v20" ::"f"(t0));
+
+    if (k == K)
+      break;
+  }
+
+  // Epilogue of the last K tile, in the VRF: add the bias, then clamp at 0
+  if (bias) {
+    asm volatile("vle64.v v24, (%0);" ::"r"(bias));
+    asm volatile("vfadd.vv v0, v0, v24");
+  }
+  if (relu) {
+    asm volatile("vfmax.vf v0, v0, %0" ::"f"(0.0));
+  }
+
+  // Store the results
+  asm volatile("vse64.v v0, (%0);" ::"r"(c));
+}
@@ -22,9 +22,15 @@
 
 #include <stdint.h>
 
+// Define FMATMUL_KERNEL to 4, 8, or 16 to use the micro-kernel with as many
+// rows for any size, as scripts/autotune.py does
 void fmatmul(double *c, const double *a, const double *b, unsigned long int m,
              unsigned long int n, unsigned long int p);
 
+void fmatmul_scalar(double *c, const double *a, const double *b,
+                    unsigned long int m, unsigned long int n,
+                    unsigned long int p);
+
 void fmatmul_4x4(double *c, const double *a, const double *b,
                  unsigned long int m, unsigned long int n, unsigned long int p);
 void fmatmul_vec_4x4_slice_init();
@@ -44,6 +50,67 @@ void fmatmul_vec_16x16_slice_init();
 void fmatmul_vec_16x16(double *c, const double *a, const double *b,
                        unsigned long int n, unsigned long int p);
 
+// Columns of A (rows of B) of a K tile of fmatmul_tiled
+#ifndef FMATMUL_KC
+#define FMATMUL_KC 64
+#endif
+
+// Bytes of A of a K tile that fmatmul_tiled keeps in the data cache
+#ifndef FMATMUL_L1_BYTES
+#define FMATMUL_L1_BYTES 16384
+#endif
+
+void fmatmul_tiled(double *c, const double *a, const double *b,
+                   unsigned long int m, unsigned long int n,
+                   unsigned long int p, unsigned long int lda,
+                   unsigned long int ldb, unsigned long int ldc);
+
+// Activation of the epilogue of fmatmul_tiled_epilogue
+typedef enum {
+  FMATMUL_ACT_NONE,
+  FMATMUL_ACT_RELU,
+  FMATMUL_ACT_GELU,
+  FMATMUL_ACT_SILU,
+} fmatmul_act_t;
+
+// C = act(AB + bias), with the P elements of bias added to every row of C, or
+// no bias if it is NULL. GELU is the tanh approximation of vmath.
+void fmatmul_tiled_epilogue(double *c, const double *a, const double *b,
+                            unsigned long int m, unsigned long int n,
+                            unsigned long int p, unsigned long int lda,
+                            unsigned long int ldb, unsigned long int ldc,
+                            const double *bias, fmatmul_act_t act);
+
+// C = AB as fmatmul_tiled, with the panels of A double-buffered in the L2 by
+// the DMA engine (common/tile.h)
+void fmatmul_tiled_packed(double *c, const double *a, const double *b,
+                          unsigned long int m, unsigned long int n,
+                          unsigned long int p, unsigned long int lda,
+                          unsigned long int ldb, unsigned long int ldc);
+
+// C += AB, e.g., the rank-k updates of a factorization
+void fmatmul_tiled_acc(double *c, const double *a, const double *b,
+                       unsigned long int m, unsigned long int n,
+                       unsigned long int p, unsigned long int lda,
+                       unsigned long int ldb, unsigned long int ldc);
+
+void fmatmul_tile_16(double *c, const double *a, const double *b,
+                     unsigned long int k, unsigned long int lda,
+                     unsigned long int ldb, unsigned long int ldc,
+                     int accumulate, const double *bias, int relu);
+void fmatmul_tile_8(double *c, const double *a, const double *b,
+                    unsigned long int k, unsigned long int lda,
+                    unsigned long int ldb, unsigned long int ldc,
+                    int accumulate, const double *bias, int relu);
+void fmatmul_tile_4(double *c, const double *a, const double *b,
+                    unsigned long int k, unsigned long int lda,
+                    unsigned long int ldb, unsigned long int ldc,
+                    int accumulate, const double *bias, int relu);
+void fmatmul_tile_1(double *c, const double *a, const double *b,
+                    unsigned long int k, unsigned long int lda,
+                    unsigned long int ldb, unsigned long int ldc,
+                    int accumulate, const double *bias, int relu);
+
 #define DELTA 0.000001
 
 extern int64_t event_trigger;
@@ -24,6 +24,7 @@
 #include "kernel/fmatmul.h"
 #include "runtime.h"
 #include "util.h"
+#include "vcheck.h"
 
 #ifndef SPIKE
 #include "printf.h"
@@ -46,18 +47,16 @@ extern double g[] __attribute__((aligned(32 * NR_LANES), section(".l2")));
 // Verify the matrix
 int verify_matrix(double *result, double *gold, size_t R, size_t C,
                   double threshold) {
-  for (uint64_t i = 0; i < R; ++i) {
-    for (uint64_t j = 0; j < C; ++j) {
-      uint64_t idx = i * C + j;
-      if (!similarity_check(result[idx], gold[idx], threshold)) {
-        return (i + j) == 0 ? -1 : idx;
-      }
-    }
-  }
-  return 0;
+  int64_t idx = vcheck_f64(result, gold, R * C, threshold);
+  if (idx < 0)
+    return 0;
+  return idx == 0 ? -1 : idx;
 }
 
 int main() {
+  // The square matmuls read the first rows of the matrices
+  const uint64_t S = (M < N) ? ((M < P) ? M : P) : ((N < P) ? N : P);
+
   printf("\n");
   printf("=============\n");
   printf("=  FMATMUL  =\n");
@@ -67,9 +66,9 @@ int main() {
 
 #ifdef VCD_DUMP
   // Measure only the full-size matmul
-  for (uint64_t s = M; s <= M; s *= 2) {
+  for (uint64_t s = S; s <= S; s *= 2) {
 #else
-  for (uint64_t s = 4; s <= M; s *= 2) {
+  for (uint64_t s = 4; s <= S; s *= 2) {
 #endif
     printf("\n");
     printf("------------------------------------------------------------\n");
@@ -94,7 +93,7 @@ int main() {
            performance, utilization);
 
     // Verify the result only for s == M (to keep it simple)
-    if (s == M) {
+    if (s == M && M == N && N == P) {
       printf("Verifying result...\n");
       int error = verify_matrix(c, g, s, s, THRESHOLD);
       if (error != 0) {
@@ -107,5 +106,55 @@ int main() {
     }
   }
 
+  printf("\n");
+  printf("------------------------------------------------------------\n");
+  printf("Calculating a (%d x %d) x (%d x %d) tiled matrix "
+         "multiplication...\n",
+         M, N, N, P);
+  printf("------------------------------------------------------------\n");
+  printf("\n");
+
+  printf("Calculating fmatmul_tiled...\n");
+  start_timer();
+  fmatmul_tiled(c, a, b, M, N, P, N, P, P);
+  stop_timer();
+
+  // Metrics
+  int64_t runtime = get_timer();
+  float performance = 2.0 * M * N * P / runtime;
+  float utilization = 100 * performance / (2.0 * NR_LANES);
+
+  printf("The execution took %d cycles.\n", runtime);
+  printf("The performance is %f FLOP/cycle (%f%% utilization).\n", performance,
+         utilization);
+
+  printf("Verifying result...\n");
+  int error = verify_matrix(c, g, M, P, THRESHOLD);
+  if (error != 0) {
+    printf("Error code %d\n", error);
+    printf("c[%d]=%d\n", error, c[error]);
+    return error;
+  } else {
+    printf("Passed.\n");
+  }
+
+  printf("Calculating fmatmul_tiled_packed...\n");
+  start_timer();
+  fmatmul_tiled_packed(c, a, b, M, N, P, N, P, P);
+  stop_timer();
+
+  runtime = get_timer();
+  printf("The execution took %d cycles.\n", runtime);
+
+  printf("Verifying result...\n");
+  error = verify_matrix(c, g, M, P, THRESHOLD);
+  if (error != 0) {
+    printf("Error code %d\n", error);
+    printf("c[%d]=%d\n", error, c[error]);
+    return error;
+  } else {
+    printf("Passed.\n");
+  }
+
   return 0;
 }
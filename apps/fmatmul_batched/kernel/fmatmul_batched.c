@@ -0,0 +1,227 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "fmatmul_batched.h"
+
+// The rows of B live in v16-v31 for the whole matmul, and the batch reuses
+// them if all its matmuls share the same B (stride_b == 0). Each row of C is
+// accumulated in one of v0-v3, so that four rows are independent chains.
+void fmatmul_batched(double *c, const double *a, const double *b,
+                     const unsigned long int M, const unsigned long int N,
+                     const unsigned long int P, const unsigned long int batch,
+                     const unsigned long int stride_a,
+                     const unsigned long int stride_b,
+                     const unsigned long int stride_c) {
+  asm volatile("vsetvli zero, %0, e64, m1, ta, ma" ::"r"(P));
+
+  for (unsigned long int i = 0; i < batch; ++i) {
+    const double *a_ = a + i * stride_a;
+    double *c_ = c + i * stride_c;
+
+    // Load B only once if it is shared
+    if (i == 0 || stride_b != 0)
+      fmatmul_batched_load_b(b + i * stride_b, N, P);
+
+    unsigned long int m = 0;
+    for (; m + 4 <= M; m += 4)
+      fmatmul_batched_4rows(c_ + m * P, a_ + m * N, N, P);
+    for (; m < M; ++m)
+      fmatmul_batched_1row(c_ + m * P, a_ + m * N, N);
+  }
+}
+
+void fmatmul_batched_load_b(const double *b, const unsigned long int N,
+                            const unsigned long int P) {
+  asm volatile("vle64.v v16, (%0);" ::"r"(b));
+  if (N > 1)
+    asm volatile("vle64.v v17, (%0);" ::"r"(b + 1 * P));
+  if (N > 2)
+    asm volatile("vle64.v v18, (%0);" ::"r"(b + 2 * P));
+  if (N > 3)
+    asm volatile("vle64.v v19, (%0);" ::"r"(b + 3 * P));
+  if (N > 4)
+    asm volatile("vle64.v v20, (%0);" ::"r"(b + 4 * P));
+  if (N > 5)
+    asm volatile("vle64.v v21, (%0);" ::"r"(b + 5 * P));
+  if (N > 6)
+    asm volatile("vle64.v v22, (%0);" ::"r"(b + 6 * P));
+  if (N > 7)
+    asm volatile("vle64.v v23, (%0);" ::"r"(b + 7 * P));
+  if (N > 8)
+    asm volatile("vle64.v v24, (%0);" ::"r"(b + 8 * P));
+  if (N > 9)
+    asm volatile("vle64.v v25, (%0);" ::"r"(b + 9 * P));
+  if (N > 10)
+    asm volatile("vle64.v v26, (%0);" ::"r"(b + 10 * P));
+  if (N > 11)
+    asm volatile("vle64.v v27, (%0);" ::"r"(b + 11 * P));
+  if (N > 12)
+    asm volatile("vle64.v v28, (%0);" ::"r"(b + 12 * P));
+  if (N > 13)
+    asm volatile("vle64.v v29, (%0);" ::"r"(b + 13 * P));
+  if (N > 14)
+    asm volatile("vle64.v v30, (%0);" ::"r"(b + 14 * P));
+  if (N > 15)
+    asm volatile("vle64.v v31, (%0);" ::"r"(b + 15 * P));
+}
+
+void fmatmul_batched_4rows(double *c, const double *a,
+                           const unsigned long int N,
+                           const unsigned long int P) {
+  const double *a0 = a;
+  const double *a1 = a + N;
+  const double *a2 = a + 2 * N;
+  const double *a3 = a + 3 * N;
+
+  asm volatile("vfmul.vf v0, %0, v16" ::"f"(a0[0]));
+  asm volatile("vfmul.vf v1, %0, v16" ::"f"(a1[0]));
+  asm volatile("vfmul.vf v2, %0, v16" ::"f"(a2[0]));
+  asm volatile("vfmul.vf v3, %0, v16" ::"f"(a3[0]));
+  if (N > 1) {
+    asm volatile("vfmacc.vf v0, %0, v17" ::"f"(a0[1]));
+    asm volatile("vfmacc.vf v1, %0, v17" ::"f"(a1[1]));
+    asm volatile("vfmacc.vf v2, %0, v17" ::"f"(a2[1]));
+    asm volatile("vfmacc.vf v3, %0, v17" ::"f"(a3[1]));
+  }
+  if (N > 2) {
+    asm volatile("vfmacc.vf v0, %0, v18" ::"f"(a0[2]));
+    asm volatile("vfmacc.vf v1, %0, v18" ::"f"(a1[2]));
+    asm volatile("vfmacc.vf v2, %0, v18" ::"f"(a2[2]));
+    asm volatile("vfmacc.vf v3, %0, v18" ::"f"(a3[2]));
+  }
+  if (N > 3) {
+    asm volatile("vfmacc.vf v0, %0, v19" ::"f"(a0[3]));
+    asm volatile("vfmacc.vf v1, %0, v19" ::"f"(a1[3]));
+    asm volatile("vfmacc.vf v2, %0, v19" ::"f"(a2[3]));
+    asm volatile("vfmacc.vf v3, %0, v19" ::"f"(a3[3]));
+  }
+  if (N > 4) {
+    asm volatile("vfmacc.vf v0, %0, v20" ::"f"(a0[4]));
+    asm volatile("vfmacc.vf v1, %0, v20" ::"f"(a1[4]));
+    asm volatile("vfmacc.vf v2, %0, v20" ::"f"(a2[4]));
+    asm volatile("vfmacc.vf v3, %0, v20" ::"f"(a3[4]));
+  }
+  if (N > 5) {
+    asm volatile("vfmacc.vf v0, %0, v21" ::"f"(a0[5]));
+    asm volatile("vfmacc.vf v1, %0, v21" ::"f"(a1[5]));
+    asm volatile("vfmacc.vf v2, %0, v21" ::"f"(a2[5]));
+    asm volatile("vfmacc.vf v3, %0, v21" ::"f"(a3[5]));
+  }
+  if (N > 6) {
+    asm volatile("vfmacc.vf v0, %0, v22" ::"f"(a0[6]));
+    asm volatile("vfmacc.vf v1, %0, v22" ::"f"(a1[6]));
+    asm volatile("vfmacc.vf v2, %0, v22" ::"f"(a2[6]));
+    asm volatile("vfmacc.vf v3, %0, v22" ::"f"(a3[6]));
+  }
+  if (N > 7) {
+    asm volatile("vfmacc.vf v0, %0, v23" ::"f"(a0[7]));
+    asm volatile("vfmacc.vf v1, %0, v23" ::"f"(a1[7]));
+    asm volatile("vfmacc.vf v2, %0, v23" ::"f"(a2[7]));
+    asm volatile("vfmacc.vf v3, %0, v23" ::"f"(a3[7]));
+  }
+  if (N > 8) {
+    asm volatile("vfmacc.vf v0, %0, v24" ::"f"(a0[8]));
+    asm volatile("vfmacc.vf v1, %0, v24" ::"f"(a1[8]));
+    asm volatile("vfmacc.vf v2, %0, v24" ::"f"(a2[8]));
+    asm volatile("vfmacc.vf v3, %0, v24" ::"f"(a3[8]));
+  }
+  if (N > 9) {
+    asm volatile("vfmacc.vf v0, %0, v25" ::"f"(a0[9]));
+    asm volatile("vfmacc.vf v1, %0, v25" ::"f"(a1[9]));
+    asm volatile("vfmacc.vf v2, %0, v25" ::"f"(a2[9]));
+    asm volatile("vfmacc.vf v3, %0, v25" ::"f"(a3[9]));
+  }
+  if (N > 10) {
+    asm volatile("vfmacc.vf v0, %0, v26" ::"f"(a0[10]));
+    asm volatile("vfmacc.vf v1, %0, v26" ::"f"(a1[10]));
+    asm volatile("vfmacc.vf v2, %0, v26" ::"f"(a2[10]));
+    asm volatile("vfmacc.vf v3, %0, v26" ::"f"(a3[10]));
+  }
+  if (N > 11) {
+    asm volatile("vfmacc.vf v0, %0, v27" ::"f"(a0[11]));
+    asm volatile("vfmacc.vf v1, %0, v27" ::"f"(a1[11]));
+    asm volatile("vfmacc.vf v2, %0, v27" ::"f"(a2[11]));
+    asm volatile("vfmacc.vf v3, %0, v27" ::"f"(a3[11]));
+  }
+  if (N > 12) {
+    asm volatile("vfmacc.vf v0, %0, v28" ::"f"(a0[12]));
+    asm volatile("vfmacc.vf v1, %0, v28" ::"f"(a1[12]));
+    asm volatile("vfmacc.vf v2, %0, v28" ::"f"(a2[12]));
+    asm volatile("vfmacc.vf v3, %0, v28" ::"f"(a3[12]));
+  }
+  if (N > 13) {
+    asm volatile("vfmacc.vf v0, %0, v29" ::"f"(a0[13]));
+    asm volatile("vfmacc.vf v1, %0, v29" ::"f"(a1[13]));
+    asm volatile("vfmacc.vf v2, %0, v29" ::"f"(a2[13]));
+    asm volatile("vfmacc.vf v3, %0, v29" ::"f"(a3[13]));
+  }
+  if (N > 14) {
+    asm volatile("vfmacc.vf v0, %0, v30" ::"f"(a0[14]));
+    asm volatile("vfmacc.vf v1, %0, v30" ::"f"(a1[14]));
+    asm volatile("vfmacc.vf v2, %0, v30" ::"f"(a2[14]));
+    asm volatile("vfmacc.vf v3, %0, v30" ::"f"(a3[14]));
+  }
+  if (N > 15) {
+    asm volatile("vfmacc.vf v0, %0, v31" ::"f"(a0[15]));
+    asm volatile("vfmacc.vf v1, %0, v31" ::"f"(a1[15]));
+    asm volatile("vfmacc.vf v2, %0, v31" ::"f"(a2[15]));
+    asm volatile("vfmacc.vf v3, %0, v31" ::"f"(a3[15]));
+  }
+
+  asm volatile("vse64.v v0, (%0);" ::"r"(c));
+  c += P;
+  asm volatile("vse64.v v1, (%0);" ::"r"(c));
+  c += P;
+  asm volatile("vse64.v v2, (%0);" ::"r"(c));
+  c += P;
+  asm volatile("vse64.v v3, (%0);" ::"r"(c));
+}
+
+void fmatmul_batched_1row(double *c, const double *a,
+                          const unsigned long int N) {
+  asm volatile("vfmul.vf v0, %0, v16" ::"f"(a[0]));
+  if (N > 1)
+    asm volatile("vfmacc.vf v0, %0, v17" ::"f"(a[1]));
+  if (N > 2)
+    asm volatile("vfmacc.vf v0, %0, v18" ::"f"(a[2]));
+  if (N > 3)
+    asm volatile("vfmacc.vf v0, %0, v19" ::"f"(a[3]));
+  if (N > 4)
+    asm volatile("vfmacc.vf v0, %0, v20" ::"f"(a[4]));
+  if (N > 5)
+    asm volatile("vfmacc.vf v0, %0, v21" ::"f"(a[5]));
+  if (N > 6)
+    asm volatile("vfmacc.vf v0, %0, v22" ::"f"(a[6]));
+  if (N > 7)
+    asm volatile("vfmacc.vf v0, %0, v23" ::"f"(a[7]));
+  if (N > 8)
+    asm volatile("vfmacc.vf v0, %0, v24" ::"f"(a[8]));
+  if (N > 9)
+    asm volatile("vfmacc.vf v0, %0, v25" ::"f"(a[9]));
+  if (N > 10)
+    asm volatile("vfmacc.vf v0, %0, v26" ::"f"(a[10]));
+  if (N > 11)
+    asm volatile("vfmacc.vf v0, %0, v27" ::"f"(a[11]));
+  if (N > 12)
+    asm volatile("vfmacc.vf v0, %0, v28" ::"f"(a[12]));
+  if (N > 13)
+    asm volatile("vfmacc.vf v0, %0, v29" ::"f"(a[13]));
+  if (N > 14)
+    asm volatile("vfmacc.vf v0, %0, v30" ::"f"(a[14]));
+  if (N > 15)
+    asm volatile("vfmacc.vf v0, %0, v31" ::"f"(a[15]));
+  asm volatile("vse64.v v0, (%0);" ::"r"(c));
+}
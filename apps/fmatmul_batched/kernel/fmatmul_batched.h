@@ -0,0 +1,37 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _FMATMUL_BATCHED_H_
+#define _FMATMUL_BATCHED_H_
+
+#include <stdint.h>
+
+// C_i = A_i B_i for i < batch, with A_i=[MxN], B_i=[NxP], C_i=[MxP] stored by
+// rows at a + i * stride_a, b + i * stride_b, and c + i * stride_c.
+// N <= 16, and P <= VLMAX at e64, LMUL=1.
+void fmatmul_batched(double *c, const double *a, const double *b,
+                     unsigned long int m, unsigned long int n,
+                     unsigned long int p, unsigned long int batch,
+                     unsigned long int stride_a, unsigned long int stride_b,
+                     unsigned long int stride_c);
+
+void fmatmul_batched_load_b(const double *b, unsigned long int n,
+                            unsigned long int p);
+void fmatmul_batched_4rows(double *c, const double *a, unsigned long int n,
+                           unsigned long int p);
+void fmatmul_batched_1row(double *c, const double *a, unsigned long int n);
+
+#endif
@@ -0,0 +1,87 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdint.h>
+#include <string.h>
+
+#include "kernel/fmatmul_batched.h"
+#include "runtime.h"
+#include "util.h"
+
+#ifndef SPIKE
+#include "printf.h"
+#else
+#include <stdio.h>
+#endif
+
+// C_i = A_i B_i for i < batch, with A_i=[MxN], B_i=[NxP], C_i=[MxP]
+extern uint64_t M;
+extern uint64_t N;
+extern uint64_t P;
+extern uint64_t batch;
+
+extern double a[] __attribute__((aligned(32 * NR_LANES), section(".l2")));
+extern double b[] __attribute__((aligned(32 * NR_LANES), section(".l2")));
+extern double c[] __attribute__((aligned(32 * NR_LANES), section(".l2")));
+// Gold results, with a B per matmul and with a shared B
+extern double g[] __attribute__((aligned(32 * NR_LANES), section(".l2")));
+extern double gs[] __attribute__((aligned(32 * NR_LANES), section(".l2")));
+
+#define THRESHOLD 0.001
+
+// Verify the batch of matrices
+int verify_batch(double *result, double *gold, size_t len) {
+  for (size_t i = 0; i < len; ++i)
+    if (!similarity_check(result[i], gold[i], THRESHOLD))
+      return i == 0 ? -1 : i;
+  return 0;
+}
+
+int main() {
+  printf("\n");
+  printf("=====================\n");
+  printf("=  FMATMUL_BATCHED  =\n");
+  printf("=====================\n");
+  printf("\n");
+  printf("\n");
+
+  printf("Calculating %d (%d x %d) x (%d x %d) matrix multiplications...\n",
+         batch, M, N, N, P);
+
+  for (int shared = 0; shared < 2; ++shared) {
+    start_timer();
+    fmatmul_batched(c, a, b, M, N, P, batch, M * N, shared ? 0 : N * P, M * P);
+    stop_timer();
+
+    // Metrics
+    int64_t runtime = get_timer();
+    float performance = 2.0 * M * N * P * batch / runtime;
+    float utilization = 100 * performance / (2.0 * NR_LANES);
+
+    printf("%s B: %d cycles, %f FLOP/cycle (%f%% utilization).\n",
+           shared ? "Shared" : "Separate", runtime, performance, utilization);
+
+    printf("Verifying result...\n");
+    int error = verify_batch(c, shared ? gs : g, batch * M * P);
+    if (error != 0) {
+      printf("Error code %d\n", error);
+      return error;
+    }
+    printf("Passed.\n");
+  }
+
+  return 0;
+}
@@ -0,0 +1,68 @@
+#!/usr/bin/env python3
+# Copyright 2022 ETH Zurich and University of Bologna.
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+# Author: Matteo Perotti
+
+# C_i = A_i B_i for i < batch, with A_i=[MxN], B_i=[NxP], C_i=[MxP]
+# arg1, arg2, arg3, arg4: M, N, P, batch
+
+import numpy as np
+import os
+import sys
+
+sys.path.insert(0, os.path.join(os.path.dirname(__file__), '../../common/script'))
+from data_emit import emit
+
+############
+## SCRIPT ##
+############
+
+if len(sys.argv) == 5:
+  M = int(sys.argv[1])
+  N = int(sys.argv[2])
+  P = int(sys.argv[3])
+  batch = int(sys.argv[4])
+else:
+  print("Error. Give me four arguments: M, N, P, batch.")
+  print("C_i = A_i B_i for i < batch, with A_i=[MxN], B_i=[NxP], C_i=[MxP]")
+  sys.exit()
+
+if N > 16:
+  print("Error. The kernel keeps at most 16 rows of B in the VRF.")
+  sys.exit()
+
+dtype = np.float64
+
+# Matrices and results
+A = np.random.rand(batch, M, N).astype(dtype)
+B = np.random.rand(batch, N, P).astype(dtype)
+C = np.zeros([batch, M, P], dtype=dtype)
+# Golden result matrices, with a B per matmul and with B[0] shared by the batch
+G = np.matmul(A, B).astype(dtype)
+GS = np.matmul(A, B[0]).astype(dtype)
+
+# Create the file
+print(".section .data,\"aw\",@progbits")
+emit("M", np.array(M, dtype=np.uint64))
+emit("N", np.array(N, dtype=np.uint64))
+emit("P", np.array(P, dtype=np.uint64))
+emit("batch", np.array(batch, dtype=np.uint64))
+emit("a", A, 'NR_LANES*4')
+emit("b", B, 'NR_LANES*4')
+emit("c", C, 'NR_LANES*4')
+emit("g", G, 'NR_LANES*4')
+emit("gs", GS, 'NR_LANES*4')
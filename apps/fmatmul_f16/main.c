@@ -0,0 +1,111 @@
+// Copyright 2020 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Author: Matheus Cavalcante, ETH Zurich
+//         Samuel Riedel, ETH Zurich
+//         Matteo Perotti, ETH Zurich
+
+#include <stdio.h>
+#include <string.h>
+
+#include "kernel/fmatmul_f16.h"
+#include "runtime.h"
+#include "util.h"
+
+#ifndef SPIKE
+#include "printf.h"
+#endif
+
+// Define Matrix dimensions:
+// C = AB with A=[MxN], B=[NxP], C=[MxP]
+extern uint64_t M;
+extern uint64_t N;
+extern uint64_t P;
+
+extern _Float16 a[] __attribute__((aligned(32 * NR_LANES), section(".l2")));
+extern _Float16 b[] __attribute__((aligned(32 * NR_LANES), section(".l2")));
+extern _Float16 c[] __attribute__((aligned(32 * NR_LANES), section(".l2")));
+// Gold results
+extern _Float16 g[] __attribute__((aligned(32 * NR_LANES), section(".l2")));
+
+#define THRESHOLD 0.05
+
+// Verify the matrix
+int verify_matrix(_Float16 *result, _Float16 *gold, size_t R, size_t C,
+                  double threshold) {
+  for (uint64_t i = 0; i < R; ++i) {
+    for (uint64_t j = 0; j < C; ++j) {
+      uint64_t idx = i * C + j;
+      if (!similarity_check(result[idx], gold[idx], threshold)) {
+        return (i + j) == 0 ? -1 : idx;
+      }
+    }
+  }
+  return 0;
+}
+
+int main() {
+  printf("\n");
+  printf("=================\n");
+  printf("=  FMATMUL_F16  =\n");
+  printf("=================\n");
+  printf("\n");
+  printf("\n");
+
+#ifdef VCD_DUMP
+  // Measure only the full-size matmul
+  for (uint64_t s = M; s <= M; s *= 2) {
+#else
+  for (uint64_t s = 4; s <= M; s *= 2) {
+#endif
+    printf("\n");
+    printf("------------------------------------------------------------\n");
+    printf("Calculating a (%d x %d) x (%d x %d) matrix multiplication...\n", s,
+           s, s, s);
+    printf("------------------------------------------------------------\n");
+    printf("\n");
+
+    // Matrices are initialized --> Start calculating
+    printf("Calculating fmatmul_f16...\n");
+    start_timer();
+    fmatmul_f16(c, a, b, s, s, s);
+    stop_timer();
+
+    // Metrics
+    int64_t runtime = get_timer();
+    float performance = 2.0 * s * s * s / runtime;
+    float utilization = 100 * performance / (2.0 * 4 * NR_LANES);
+
+    printf("The execution took %d cycles.\n", runtime);
+    printf("The performance is %f FLOP/cycle (%f%% utilization).\n",
+           performance, utilization);
+
+    // Verify the result only for s == M (to keep it simple)
+    if (s == M) {
+      printf("Verifying result...\n");
+      int error = verify_matrix(c, g, s, s, THRESHOLD);
+      if (error != 0) {
+        printf("Error code %d\n", error);
+        printf("c[%d]=%d\n", error, (int)c[error]);
+        return error;
+      } else {
+        printf("Passed.\n");
+      }
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,680 @@
+// Copyright 2020 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Author: Matheus Cavalcante, ETH Zurich
+//         Samuel Riedel, ETH Zurich
+
+#include "fmatmul_f32.h"
+
+#define MIN(a, b) ((a) < (b) ? (a) : (b))
+
+void fmatmul_f32(float *c, const float *a, const float *b,
+                 const unsigned long int M, const unsigned long int N,
+                 const unsigned long int P) {
+  // A vector register holds 2x the elements of the FP64 kernels, so the
+  // LMUL is picked on the vector length at e32 instead of on M only
+  unsigned long int vlmax_m1;
+  asm volatile("vsetvli %0, %1, e32, m1, ta, ma" : "=r"(vlmax_m1) : "r"(-1));
+
+#if MXU_TILES
+  // The outer products of the MXU cover the rows of C two by two
+  if (!(M & 1)) {
+    fmatmul_f32_mxu(c, a, b, M, N, P);
+    return;
+  }
+#endif
+
+  if (M <= 4) {
+    fmatmul_f32_4x4(c, a, b, M, N, P);
+  } else if (M <= 8) {
+    fmatmul_f32_8x8(c, a, b, M, N, P);
+  } else if (P <= vlmax_m1) {
+    // One register covers the row of C, with LMUL=1
+    fmatmul_f32_16x16(c, a, b, M, N, P);
+  } else if (P <= 2 * vlmax_m1) {
+    // With an 8x8 matmul, we can use LMUL=2
+    fmatmul_f32_8x8(c, a, b, M, N, P);
+  } else {
+    // With an 4x4 matmul, we can use LMUL=4
+    fmatmul_f32_4x4(c, a, b, M, N, P);
+  }
+}
+
+// ---------------
+// 4x4
+// ---------------
+
+void fmatmul_f32_4x4(float *c, const float *a, const float *b,
+                     const unsigned long int M, const unsigned long int N,
+                     const unsigned long int P) {
+  // We work on 4 rows of the matrix at once
+  const unsigned long int block_size = 4;
+  unsigned long int block_size_p;
+
+  // Set the vector configuration
+  asm volatile("vsetvli %0, %1, e32, m4, ta, ma" : "=r"(block_size_p) : "r"(P));
+
+  // Slice the matrix into a manageable number of columns p_
+  for (unsigned long int p = 0; p < P; p += block_size_p) {
+    // Set the vector length
+    const unsigned long int p_ = MIN(P - p, block_size_p);
+
+    // Find pointers to the submatrices
+    const float *b_ = b + p;
+    float *c_ = c + p;
+
+    asm volatile("vsetvli zero, %0, e32, m4, ta, ma" ::"r"(p_));
+
+    // Iterate over the rows
+    for (unsigned long int m = 0; m < M; m += block_size) {
+      // Find pointer to the submatrices
+      const float *a_ = a + m * N;
+      float *c__ = c_ + m * P;
+
+      fmatmul_f32_vec_4x4_slice_init();
+      fmatmul_f32_vec_4x4(c__, a_, b_, N, P);
+    }
+  }
+}
+
+void fmatmul_f32_vec_4x4_slice_init() {
+  asm volatile("vmv.v.i v0,  0");
+  asm volatile("vmv.v.i v4,  0");
+  asm volatile("vmv.v.i v8,  0");
+  asm volatile("vmv.v.i v12, 0");
+}
+
+void fmatmul_f32_vec_4x4(float *c, const float *a, const float *b,
+                         const unsigned long int N, const unsigned long int P) {
+  // Temporary variables
+  float t0, t1, t2, t3;
+
+  // Original pointer
+  const float *a_ = a;
+
+  // Prefetch one row of matrix B
+  asm volatile("vle32.v v16, (%0);" ::"r"(b));
+  b += P;
+
+  // Prefetch one row of scalar values
+  t0 = *a, a += N;
+  t1 = *a, a += N;
+  t2 = *a, a += N;
+  t3 = *a;
+
+  // Compute the multiplication
+  unsigned long int n = 0;
+
+  while (n != N) {
+#ifdef VCD_DUMP
+    // Start dumping VCD
+    if (n == 8)
+      event_trigger = +1;
+    // Stop dumping VCD
+    if (n == 12)
+      event_trigger = -1;
+#endif
+
+    // Calculate pointer to the matrix A
+    a = a_ + ++n;
+
+    asm volatile("vfmacc.vf v0, %0, v16" ::"f"(t0));
+    t0 = *a, a += N;
+
+    // Load one row of B
+    asm volatile("vle32.v v20, (%0);" ::"r"(b));
+    b += P;
+
+    asm volatile("vfmacc.vf v4, %0, v16" ::"f"(t1));
+    t1 = *a, a += N;
+    asm volatile("vfmacc.vf v8, %0, v16" ::"f"(t2));
+    t2 = *a, a += N;
+    asm volatile("vfmacc.vf v12, %0, v16" ::"f"(t3));
+    t3 = *a;
+
+    a = a_ + ++n;
+
+    if (n == N)
+      break;
+
+    asm volatile("vfmacc.vf v0, %0, v20" ::"f"(t0));
+    t0 = *a, a += N;
+
+    // Load one row of B
+    asm volatile("vle32.v v16, (%0);" ::"r"(b));
+    b += P;
+
+    asm volatile("vfmacc.vf v4, %0, v20" ::"f"(t1));
+    t1 = *a, a += N;
+    asm volatile("vfmacc.vf v8, %0, v20" ::"f"(t2));
+    t2 = *a, a += N;
+    asm volatile("vfmacc.vf v12, %0, v20" ::"f"(t3));
+    t3 = *a;
+  }
+
+  // Last iteration: store results
+  asm volatile("vfmacc.vf v0, %0, v20" ::"f"(t0));
+  asm volatile("vse32.v v0, (%0);" ::"r"(c));
+  c += P;
+  asm volatile("vfmacc.vf v4, %0, v20" ::"f"(t1));
+  asm volatile("vse32.v v4, (%0);" ::"r"(c));
+  c += P;
+  asm volatile("vfmacc.vf v8, %0, v20" ::"f"(t2));
+  asm volatile("vse32.v v8, (%0);" ::"r"(c));
+  c += P;
+  asm volatile("vfmacc.vf v12, %0, v20" ::"f"(t3));
+  asm volatile("vse32.v v12, (%0);" ::"r"(c));
+}
+
+// ---------------
+// 8x8
+// ---------------
+
+void fmatmul_f32_8x8(float *c, const float *a, const float *b,
+                     const unsigned long int M, const unsigned long int N,
+                     const unsigned long int P) {
+  // We work on 4 rows of the matrix at once
+  const unsigned long int block_size = 8;
+  unsigned long int block_size_p;
+
+  // Set the vector configuration
+  asm volatile("vsetvli %0, %1, e32, m2, ta, ma" : "=r"(block_size_p) : "r"(P));
+
+  // Slice the matrix into a manageable number of columns p_
+  for (unsigned long int p = 0; p < P; p += block_size_p) {
+    // Set the vector length
+    const unsigned long int p_ = MIN(P - p, block_size_p);
+
+    // Find pointers to the submatrices
+    const float *b_ = b + p;
+    float *c_ = c + p;
+
+    asm volatile("vsetvli zero, %0, e32, m2, ta, ma" ::"r"(p_));
+
+    // Iterate over the rows
+    for (unsigned long int m = 0; m < M; m += block_size) {
+      // Find pointer to the submatrices
+      const float *a_ = a + m * N;
+      float *c__ = c_ + m * P;
+
+      fmatmul_f32_vec_8x8_slice_init();
+      fmatmul_f32_vec_8x8(c__, a_, b_, N, P);
+    }
+  }
+}
+
+void fmatmul_f32_vec_8x8_slice_init() {
+  asm volatile("vmv.v.i v0,  0");
+  asm volatile("vmv.v.i v2,  0");
+  asm volatile("vmv.v.i v4,  0");
+  asm volatile("vmv.v.i v6,  0");
+  asm volatile("vmv.v.i v8,  0");
+  asm volatile("vmv.v.i v10, 0");
+  asm volatile("vmv.v.i v12, 0");
+  asm volatile("vmv.v.i v14, 0");
+}
+
+void fmatmul_f32_vec_8x8(float *c, const float *a, const float *b,
+                         const unsigned long int N, const unsigned long int P) {
+  // Temporary variables
+  float t0, t1, t2, t3, t4, t5, t6, t7;
+
+  // Original pointer
+  const float *a_ = a;
+
+  // Prefetch one row of matrix B
+  asm volatile("vle32.v v18, (%0);" ::"r"(b));
+  b += P;
+
+  // Prefetch one row of scalar values
+  t0 = *a, a += N;
+  t1 = *a, a += N;
+  t2 = *a, a += N;
+  t3 = *a, a += N;
+  t4 = *a, a += N;
+  t5 = *a, a += N;
+  t6 = *a, a += N;
+  t7 = *a;
+
+  // Compute the multiplication
+  unsigned long int n = 0;
+
+  while (n != N) {
+#ifdef VCD_DUMP
+    // Start dumping VCD
+    if (n == 8)
+      event_trigger = +1;
+    // Stop dumping VCD
+    if (n == 12)
+      event_trigger = -1;
+#endif
+
+    // Calculate pointer to the matrix A
+    a = a_ + ++n;
+
+    asm volatile("vfmacc.vf v0, %0, v18" ::"f"(t0));
+    t0 = *a, a += N;
+
+    // Load one row of B
+    asm volatile("vle32.v v20, (%0);" ::"r"(b));
+    b += P;
+
+    asm volatile("vfmacc.vf v2, %0, v18" ::"f"(t1));
+    t1 = *a, a += N;
+    asm volatile("vfmacc.vf v4, %0, v18" ::"f"(t2));
+    t2 = *a, a += N;
+    asm volatile("vfmacc.vf v6, %0, v18" ::"f"(t3));
+    t3 = *a, a += N;
+    asm volatile("vfmacc.vf v8, %0, v18" ::"f"(t4));
+    t4 = *a, a += N;
+    asm volatile("vfmacc.vf v10, %0, v18" ::"f"(t5));
+    t5 = *a, a += N;
+    asm volatile("vfmacc.vf v12, %0, v18" ::"f"(t6));
+    t6 = *a, a += N;
+    asm volatile("vfmacc.vf v14, %0, v18" ::"f"(t7));
+    t7 = *a;
+
+    a = a_ + ++n;
+
+    if (n == N)
+      break;
+
+    asm volatile("vfmacc.vf v0, %0, v20" ::"f"(t0));
+    t0 = *a, a += N;
+
+    // Load one row of B
+    asm volatile("vle32.v v18, (%0);" ::"r"(b));
+    b += P;
+
+    asm volatile("vfmacc.vf v2, %0, v20" ::"f"(t1));
+    t1 = *a, a += N;
+    asm volatile("vfmacc.vf v4, %0, v20" ::"f"(t2));
+    t2 = *a, a += N;
+    asm volatile("vfmacc.vf v6, %0, v20" ::"f"(t3));
+    t3 = *a, a += N;
+    asm volatile("vfmacc.vf v8, %0, v20" ::"f"(t4));
+    t4 = *a, a += N;
+    asm volatile("vfmacc.vf v10, %0, v20" ::"f"(t5));
+    t5 = *a, a += N;
+    asm volatile("vfmacc.vf v12, %0, v20" ::"f"(t6));
+    t6 = *a, a += N;
+    asm volatile("vfmacc.vf v14, %0, v20" ::"f"(t7));
+    t7 = *a;
+  }
+
+  // Last iteration: store results
+  asm volatile("vfmacc.vf v0, %0, v20" ::"f"(t0));
+  asm volatile("vse32.v v0, (%0);" ::"r"(c));
+  c += P;
+  asm volatile("vfmacc.vf v2, %0, v20" ::"f"(t1));
+  asm volatile("vse32.v v2, (%0);" ::"r"(c));
+  c += P;
+  asm volatile("vfmacc.vf v4, %0, v20" ::"f"(t2));
+  asm volatile("vse32.v v4, (%0);" ::"r"(c));
+  c += P;
+  asm volatile("vfmacc.vf v6, %0, v20" ::"f"(t3));
+  asm volatile("vse32.v v6, (%0);" ::"r"(c));
+  c += P;
+  asm volatile("vfmacc.vf v8, %0, v20" ::"f"(t4));
+  asm volatile("vse32.v v8, (%0);" ::"r"(c));
+  c += P;
+  asm volatile("vfmacc.vf v10, %0, v20" ::"f"(t5));
+  asm volatile("vse32.v v10, (%0);" ::"r"(c));
+  c += P;
+  asm volatile("vfmacc.vf v12, %0, v20" ::"f"(t6));
+  asm volatile("vse32.v v12, (%0);" ::"r"(c));
+  c += P;
+  asm volatile("vfmacc.vf v14, %0, v20" ::"f"(t7));
+  asm volatile("vse32.v v14, (%0);" ::"r"(c));
+}
+
+// ---------------
+// 16x16
+// ---------------
+
+void fmatmul_f32_16x16(float *c, const float *a, const float *b,
+                       unsigned long int M, unsigned long int N,
+                       unsigned long int P) {
+  // We work on 4 rows of the matrix at once
+  const unsigned long int block_size = 16;
+  unsigned long int block_size_p;
+
+  // Set the vector configuration
+  asm volatile("vsetvli %0, %1, e32, m1, ta, ma" : "=r"(block_size_p) : "r"(P));
+
+  // Slice the matrix into a manageable number of columns p_
+  for (unsigned long int p = 0; p < P; p += block_size_p) {
+    // Set the vector length
+    const unsigned long int p_ = MIN(P - p, block_size_p);
+
+    // Find pointers to the submatrices
+    const float *b_ = b + p;
+    float *c_ = c + p;
+
+    asm volatile("vsetvli zero, %0, e32, m1, ta, ma" ::"r"(p_));
+
+    // Iterate over the rows
+    for (unsigned long int m = 0; m < M; m += block_size) {
+      // Find pointer to the submatrices
+      const float *a_ = a + m * N;
+      float *c__ = c_ + m * P;
+
+      fmatmul_f32_vec_16x16_slice_init();
+      fmatmul_f32_vec_16x16(c__, a_, b_, N, P);
+    }
+  }
+}
+
+void fmatmul_f32_vec_16x16_slice_init() {
+  asm volatile("vmv.v.i v0,  0");
+  asm volatile("vmv.v.i v1,  0");
+  asm volatile("vmv.v.i v2,  0");
+  asm volatile("vmv.v.i v3,  0");
+  asm volatile("vmv.v.i v4,  0");
+  asm volatile("vmv.v.i v5,  0");
+  asm volatile("vmv.v.i v6,  0");
+  asm volatile("vmv.v.i v7,  0");
+  asm volatile("vmv.v.i v8,  0");
+  asm volatile("vmv.v.i v9,  0");
+  asm volatile("vmv.v.i v10, 0");
+  asm volatile("vmv.v.i v11, 0");
+  asm volatile("vmv.v.i v12, 0");
+  asm volatile("vmv.v.i v13, 0");
+  asm volatile("vmv.v.i v14, 0");
+  asm volatile("vmv.v.i v15, 0");
+}
+
+void fmatmul_f32_vec_16x16(float *c, const float *a, const float *b,
+                           const unsigned long int N,
+                           const unsigned long int P) {
+  // Temporary variables
+  float t0, t1, t2, t3, t4, t5, t6, t7, t8, t9, t10, t11, t12, t13, t14, t15;
+
+  // Original pointer
+  const float *a_ = a;
+
+  // Prefetch one row of scalar values
+  t0 = *a, a += N;
+  t1 = *a, a += N;
+  t2 = *a, a += N;
+  t3 = *a, a += N;
+  t4 = *a, a += N;
+  t5 = *a, a += N;
+  t6 = *a, a += N;
+  t7 = *a, a += N;
+  t8 = *a, a += N;
+  t9 = *a, a += N;
+  t10 = *a, a += N;
+  t11 = *a, a += N;
+  t12 = *a, a += N;
+  t13 = *a, a += N;
+  t14 = *a, a += N;
+  t15 = *a;
+
+  // Prefetch one row of matrix B
+  asm volatile("vle32.v v16, (%0);" ::"r"(b));
+  b += P;
+
+  // Compute the multiplication
+  unsigned long int n = 0;
+
+  while (n != N) {
+#ifdef VCD_DUMP
+    // Start dumping VCD
+    if (n == 8)
+      event_trigger = +1;
+    // Stop dumping VCD
+    if (n == 12)
+      event_trigger = -1;
+#endif
+
+    // Calculate pointer to the matrix A
+    a = a_ + ++n;
+
+    asm volatile("vfmacc.vf v0, %0, v16" ::"f"(t0));
+    t0 = *a, a += N;
+
+    // Load one row of B
+    asm volatile("vle32.v v17, (%0);" ::"r"(b));
+    b += P;
+
+    asm volatile("vfmacc.vf v1, %0, v16" ::"f"(t1));
+    t1 = *a, a += N;
+    asm volatile("vfmacc.vf v2, %0, v16" ::"f"(t2));
+    t2 = *a, a += N;
+    asm volatile("vfmacc.vf v3, %0, v16" ::"f"(t3));
+    t3 = *a, a += N;
+    asm volatile("vfmacc.vf v4, %0, v16" ::"f"(t4));
+    t4 = *a, a += N;
+    asm volatile("vfmacc.vf v5, %0, v16" ::"f"(t5));
+    t5 = *a, a += N;
+    asm volatile("vfmacc.vf v6, %0, v16" ::"f"(t6));
+    t6 = *a, a += N;
+    asm volatile("vfmacc.vf v7, %0, v16" ::"f"(t7));
+    t7 = *a, a += N;
+    asm volatile("vfmacc.vf v8, %0, v16" ::"f"(t8));
+    t8 = *a, a += N;
+    asm volatile("vfmacc.vf v9, %0, v16" ::"f"(t9));
+    t9 = *a, a += N;
+    asm volatile("vfmacc.vf v10, %0, v16" ::"f"(t10));
+    t10 = *a, a += N;
+    asm volatile("vfmacc.vf v11, %0, v16" ::"f"(t11));
+    t11 = *a, a += N;
+    asm volatile("vfmacc.vf v12, %0, v16" ::"f"(t12));
+    t12 = *a, a += N;
+    asm volatile("vfmacc.vf v13, %0, v16" ::"f"(t13));
+    t13 = *a, a += N;
+    asm volatile("vfmacc.vf v14, %0, v16" ::"f"(t14));
+    t14 = *a, a += N;
+    asm volatile("vfmacc.vf v15, %0, v16" ::"f"(t15));
+    t15 = *a;
+
+    a = a_ + ++n;
+
+    if (n == N)
+      break;
+
+    asm volatile("vfmacc.vf v0, %0, v17" ::"f"(t0));
+    t0 = *a, a += N;
+
+    // Load one row of B
+    asm volatile("vle32.v v16, (%0);" ::"r"(b));
+    b += P;
+
+    asm volatile("vfmacc.vf v1, %0, v17" ::"f"(t1));
+    t1 = *a, a += N;
+    asm volatile("vfmacc.vf v2, %0, v17" ::"f"(t2));
+    t2 = *a, a += N;
+    asm volatile("vfmacc.vf v3, %0, v17" ::"f"(t3));
+    t3 = *a, a += N;
+    asm volatile("vfmacc.vf v4, %0, v17" ::"f"(t4));
+    t4 = *a, a += N;
+    asm volatile("vfmacc.vf v5, %0, v17" ::"f"(t5));
+    t5 = *a, a += N;
+    asm volatile("vfmacc.vf v6, %0, v17" ::"f"(t6));
+    t6 = *a, a += N;
+    asm volatile("vfmacc.vf v7, %0, v17" ::"f"(t7));
+    t7 = *a, a += N;
+    asm volatile("vfmacc.vf v8, %0, v17" ::"f"(t8));
+    t8 = *a, a += N;
+    asm volatile("vfmacc.vf v9, %0, v17" ::"f"(t9));
+    t9 = *a, a += N;
+    asm volatile("vfmacc.vf v10, %0, v17" ::"f"(t10));
+    t10 = *a, a += N;
+    asm volatile("vfmacc.vf v11, %0, v17" ::"f"(t11));
+    t11 = *a, a += N;
+    asm volatile("vfmacc.vf v12, %0, v17" ::"f"(t12));
+    t12 = *a, a += N;
+    asm volatile("vfmacc.vf v13, %0, v17" ::"f"(t13));
+    t13 = *a, a += N;
+    asm volatile("vfmacc.vf v14, %0, v17" ::"f"(t14));
+    t14 = *a, a += N;
+    asm volatile("vfmacc.vf v15, %0, v17" ::"f"(t15));
+    t15 = *a;
+  }
+
+  // Last iteration: store results
+  asm volatile("vfmacc.vf v0, %0, v17" ::"f"(t0));
+  asm volatile("vse32.v v0, (%0);" ::"r"(c));
+  c += P;
+  asm volatile("vfmacc.vf v1, %0, v17" ::"f"(t1));
+  asm volatile("vse32.v v1, (%0);" ::"r"(c));
+  c += P;
+  asm volatile("vfmacc.vf v2, %0, v17" ::"f"(t2));
+  asm volatile("vse32.v v2, (%0);" ::"r"(c));
+  c += P;
+  asm volatile("vfmacc.vf v3, %0, v17" ::"f"(t3));
+  asm volatile("vse32.v v3, (%0);" ::"r"(c));
+  c += P;
+  asm volatile("vfmacc.vf v4, %0, v17" ::"f"(t4));
+  asm volatile("vse32.v v4, (%0);" ::"r"(c));
+  c += P;
+  asm volatile("vfmacc.vf v5, %0, v17" ::"f"(t5));
+  asm volatile("vse32.v v5, (%0);" ::"r"(c));
+  c += P;
+  asm volatile("vfmacc.vf v6, %0, v17" ::"f"(t6));
+  asm volatile("vse32.v v6, (%0);" ::"r"(c));
+  c += P;
+  asm volatile("vfmacc.vf v7, %0, v17" ::"f"(t7));
+  asm volatile("vse32.v v7, (%0);" ::"r"(c));
+  c += P;
+  asm volatile("vfmacc.vf v8, %0, v17" ::"f"(t8));
+  asm volatile("vse32.v v8, (%0);" ::"r"(c));
+  c += P;
+  asm volatile("vfmacc.vf v9, %0, v17" ::"f"(t9));
+  asm volatile("vse32.v v9, (%0);" ::"r"(c));
+  c += P;
+  asm volatile("vfmacc.vf v10, %0, v17" ::"f"(t10));
+  asm volatile("vse32.v v10, (%0);" ::"r"(c));
+  c += P;
+  asm volatile("vfmacc.vf v11, %0, v17" ::"f"(t11));
+  asm volatile("vse32.v v11, (%0);" ::"r"(c));
+  c += P;
+  asm volatile("vfmacc.vf v12, %0, v17" ::"f"(t12));
+  asm volatile("vse32.v v12, (%0);" ::"r"(c));
+  c += P;
+  asm volatile("vfmacc.vf v13, %0, v17" ::"f"(t13));
+  asm volatile("vse32.v v13, (%0);" ::"r"(c));
+  c += P;
+  asm volatile("vfmacc.vf v14, %0, v17" ::"f"(t14));
+  asm volatile("vse32.v v14, (%0);" ::"r"(c));
+  c += P;
+  asm volatile("vfmacc.vf v15, %0, v17" ::"f"(t15));
+  asm volatile("vse32.v v15, (%0);" ::"r"(c));
+}
+
+
+#if MXU_TILES
+// ---------------
+// MXU
+// ---------------
+
+// The toolchain does not know the outer products of the MXU: vfmop.vx,
+// vfmopa.vx and vfmtr.vx are the OPMVX instructions of funct6 000000, 000001
+// and 000010, with the tile in rd and two FP32 elements of A in rs1
+#define VFMOP_VX(t, rs1, vs2)                                                  \
+  asm volatile(".insn r 0x57, 6, 0x01, x" #t ", %0, x" #vs2 ::"r"(rs1))
+#define VFMOPA_VX(t, rs1, vs2)                                                 \
+  asm volatile(".insn r 0x57, 6, 0x03, x" #t ", %0, x" #vs2 ::"r"(rs1))
+#define VFMTR_VX(vd, rs1)                                                      \
+  asm volatile(".insn r 0x57, 6, 0x05, x" #vd ", %0, x0" ::"r"(rs1))
+
+// The kernel unrolls up to 4 tiles, i.e., 8 rows of C
+#define MXU_T (MXU_TILES < 4 ? MXU_TILES : 4)
+
+// Elements a[0] and a[N] in the two halves of a scalar register
+static inline uint64_t fmatmul_f32_mxu_pair(const float *a,
+                                            const unsigned long int N) {
+  union {
+    float f;
+    uint32_t u;
+  } lo = {.f = a[0]}, hi = {.f = a[N]};
+  return ((uint64_t)hi.u << 32) | lo.u;
+}
+
+// Outer product of the row k of B, in v<vs2>, with the column k of A on the
+// tile t, which holds the rows 2t and 2t+1 of the block
+#define MXU_STEP(t, vs2)                                                       \
+  if (MXU_T > t && t < tiles) {                                                \
+    const uint64_t a_pair = fmatmul_f32_mxu_pair(a_ + 2 * t * N + k, N);      \
+    if (k == 0)                                                                \
+      VFMOP_VX(t, a_pair, vs2);                                                \
+    else                                                                       \
+      VFMOPA_VX(t, a_pair, vs2);                                               \
+  }
+#define MXU_STEPS(vs2)                                                         \
+  do {                                                                         \
+    MXU_STEP(0, vs2);                                                          \
+    MXU_STEP(1, vs2);                                                          \
+    MXU_STEP(2, vs2);                                                          \
+    MXU_STEP(3, vs2);                                                          \
+  } while (0)
+
+void fmatmul_f32_mxu(float *c, const float *a, const float *b,
+                     const unsigned long int M, const unsigned long int N,
+                     const unsigned long int P) {
+  // We work on 2 rows of the matrix per tile
+  const unsigned long int block_size = 2 * MXU_T;
+  unsigned long int block_size_p;
+
+  // The tiles hold one vector register of each row, with LMUL=1
+  asm volatile("vsetvli %0, %1, e32, m1, ta, ma" : "=r"(block_size_p) : "r"(P));
+
+  // Slice the matrix into a manageable number of columns p_
+  for (unsigned long int p = 0; p < P; p += block_size_p) {
+    // Set the vector length
+    const unsigned long int p_ = MIN(P - p, block_size_p);
+
+    // Find pointers to the submatrices
+    const float *b_ = b + p;
+    float *c_ = c + p;
+
+    asm volatile("vsetvli zero, %0, e32, m1, ta, ma" ::"r"(p_));
+
+    // Iterate over the rows
+    for (unsigned long int m = 0; m < M; m += block_size) {
+      // Find pointer to the submatrices
+      const float *a_ = a + m * N;
+      float *c__ = c_ + m * P;
+      // The last block can use fewer tiles
+      const unsigned long int tiles = MIN(M - m, block_size) / 2;
+
+      // Alternate between two rows of B, so that a load does not wait for
+      // the outer products of the previous row
+      for (unsigned long int k = 0; k < N; ++k) {
+        if (k & 1) {
+          asm volatile("vle32.v v17, (%0);" ::"r"(b_ + k * P));
+          MXU_STEPS(17);
+        } else {
+          asm volatile("vle32.v v16, (%0);" ::"r"(b_ + k * P));
+          MXU_STEPS(16);
+        }
+      }
+
+      // Move the rows of the tiles to C
+      for (unsigned long int r = 0; r < 2 * tiles; ++r) {
+        if (r & 1) {
+          VFMTR_VX(25, r);
+          asm volatile("vse32.v v25, (%0);" ::"r"(c__ + r * P));
+        } else {
+          VFMTR_VX(24, r);
+          asm volatile("vse32.v v24, (%0);" ::"r"(c__ + r * P));
+        }
+      }
+    }
+  }
+}
+#endif
@@ -0,0 +1,171 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "hash.h"
+
+#include <stddef.h>
+
+#define XXH_P1 0x9E3779B1u
+#define XXH_P2 0x85EBCA77u
+#define XXH_P3 0xC2B2AE3Du
+
+// The toolchain does not know Zvbb: vror.vi is an OPIVI instruction of funct6
+// 01010, whose immediate (below 32 here) takes the place of rs1, and vrev8.v
+// is the VXUNARY0 instruction 01001 of OPMVV
+#define VROR_VI(vd, vs2, imm)                                                  \
+  asm volatile(".insn r 0x57, 3, 0x29, x" #vd ", x%0, x" #vs2 ::"i"(imm))
+#define VREV8_V(vd, vs2)                                                       \
+  asm volatile(".insn r 0x57, 2, 0x25, x" #vd ", x9, x" #vs2)
+
+// v<vd> = rotl(v<vd>, r), with v24 as a temporary without Zvbb
+#define VROTL(vd, r, zvbb)                                                     \
+  do {                                                                         \
+    if (zvbb) {                                                                \
+      VROR_VI(vd, vd, 32 - (r));                                               \
+    } else {                                                                   \
+      asm volatile("vsll.vi v24, v" #vd ", %0" ::"i"(r));                      \
+      asm volatile("vsrl.vi v" #vd ", v" #vd ", %0" ::"i"(32 - (r)));          \
+      asm volatile("vor.vv v" #vd ", v" #vd ", v24");                          \
+    }                                                                          \
+  } while (0)
+
+/*
+  xxHash32
+*/
+
+// Accumulator v<va> of the keys of the strip, with their 32-bit words at ptr
+#define XXH_ROUND(va, ptr, len, zvbb)                                          \
+  do {                                                                         \
+    asm volatile("vlse32.v v20, (%0), %1" ::"r"(ptr), "r"(len));               \
+    asm volatile("vmacc.vx v" #va ", %0, v20" ::"r"(XXH_P2));                  \
+    VROTL(va, 13, zvbb);                                                       \
+    asm volatile("vmul.vx v" #va ", v" #va ", %0" ::"r"(XXH_P1));              \
+  } while (0)
+
+static inline __attribute__((always_inline)) void
+xxh32_strips(const uint8_t *keys, uint64_t n, uint64_t len, uint32_t seed,
+             uint32_t *out, const int zvbb) {
+  size_t vl;
+
+  for (uint64_t k = 0; k < n; k += vl) {
+    const uint8_t *key = keys + k * len;
+
+    asm volatile("vsetvli %0, %1, e32, m4, ta, ma" : "=r"(vl) : "r"(n - k));
+    // The four accumulators of each key
+    asm volatile("vmv.v.x v4, %0" ::"r"(seed + XXH_P1 + XXH_P2));
+    asm volatile("vmv.v.x v8, %0" ::"r"(seed + XXH_P2));
+    asm volatile("vmv.v.x v12, %0" ::"r"(seed));
+    asm volatile("vmv.v.x v16, %0" ::"r"(seed - XXH_P1));
+
+    // A stripe of 16 bytes of each key at a time
+    for (uint64_t s = 0; s < len; s += 16) {
+      XXH_ROUND(4, key + s, len, zvbb);
+      XXH_ROUND(8, key + s + 4, len, zvbb);
+      XXH_ROUND(12, key + s + 8, len, zvbb);
+      XXH_ROUND(16, key + s + 12, len, zvbb);
+    }
+
+    // Merge the accumulators
+    VROTL(4, 1, zvbb);
+    VROTL(8, 7, zvbb);
+    VROTL(12, 12, zvbb);
+    VROTL(16, 18, zvbb);
+    asm volatile("vadd.vv v4, v4, v8");
+    asm volatile("vadd.vv v12, v12, v16");
+    asm volatile("vadd.vv v4, v4, v12");
+    asm volatile("vadd.vx v4, v4, %0" ::"r"(len));
+
+    // Avalanche
+    asm volatile("vsrl.vi v24, v4, 15");
+    asm volatile("vxor.vv v4, v4, v24");
+    asm volatile("vmul.vx v4, v4, %0" ::"r"(XXH_P2));
+    asm volatile("vsrl.vi v24, v4, 13");
+    asm volatile("vxor.vv v4, v4, v24");
+    asm volatile("vmul.vx v4, v4, %0" ::"r"(XXH_P3));
+    asm volatile("vsrl.vi v24, v4, 16");
+    asm volatile("vxor.vv v4, v4, v24");
+
+    asm volatile("vse32.v v4, (%0)" ::"r"(out + k));
+  }
+}
+
+void xxh32_v(const uint8_t *keys, uint64_t n, uint64_t len, uint32_t seed,
+             uint32_t *out) {
+  xxh32_strips(keys, n, len, seed, out, 1);
+}
+
+void xxh32_v_base(const uint8_t *keys, uint64_t n, uint64_t len, uint32_t seed,
+                  uint32_t *out) {
+  xxh32_strips(keys, n, len, seed, out, 0);
+}
+
+/*
+  CRC-32/MPEG-2
+*/
+
+static inline __attribute__((always_inline)) void
+crc32_strips(const uint8_t *keys, uint64_t n, uint64_t len,
+             const uint32_t *table, uint32_t *out, const int zvbb) {
+  size_t vl;
+
+  for (uint64_t k = 0; k < n; k += vl) {
+    const uint8_t *key = keys + k * len;
+
+    asm volatile("vsetvli %0, %1, e32, m4, ta, ma" : "=r"(vl) : "r"(n - k));
+    asm volatile("vmv.v.i v4, -1");
+
+    for (uint64_t w = 0; w < len; w += 4) {
+      asm volatile("vlse32.v v8, (%0), %1" ::"r"(key + w), "r"(len));
+
+      // The little-endian load reversed the bytes of the MSB-first word
+      if (zvbb) {
+        VREV8_V(8, 8);
+      } else {
+        asm volatile("vsll.vi v24, v8, 24");
+        asm volatile("vsrl.vi v28, v8, 24");
+        asm volatile("vor.vv v24, v24, v28");
+        asm volatile("vsrl.vi v28, v8, 8");
+        asm volatile("vand.vx v28, v28, %0" ::"r"(0xff00));
+        asm volatile("vor.vv v24, v24, v28");
+        asm volatile("vsll.vi v28, v8, 8");
+        asm volatile("vand.vx v28, v28, %0" ::"r"(0xff0000));
+        asm volatile("vor.vv v8, v24, v28");
+      }
+      asm volatile("vxor.vv v4, v4, v8");
+
+      // crc = (crc << 8) ^ table[crc >> 24], for each byte of the word
+      for (int b = 0; b < 4; ++b) {
+        asm volatile("vsrl.vi v12, v4, 24");
+        asm volatile("vsll.vi v12, v12, 2");
+        asm volatile("vluxei32.v v12, (%0), v12" ::"r"(table));
+        asm volatile("vsll.vi v4, v4, 8");
+        asm volatile("vxor.vv v4, v4, v12");
+      }
+    }
+
+    asm volatile("vse32.v v4, (%0)" ::"r"(out + k));
+  }
+}
+
+void crc32_mpeg2_v(const uint8_t *keys, uint64_t n, uint64_t len,
+                   const uint32_t *table, uint32_t *out) {
+  crc32_strips(keys, n, len, table, out, 1);
+}
+
+void crc32_mpeg2_v_base(const uint8_t *keys, uint64_t n, uint64_t len,
+                        const uint32_t *table, uint32_t *out) {
+  crc32_strips(keys, n, len, table, out, 0);
+}
@@ -0,0 +1,44 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Hashes and checksums of n keys of len bytes, stored one after the other.
+// Each element of a strip processes its own key, which it reads with strided
+// loads of stride len:
+//   xxh32_v: xxHash32 of each key with seed, for len a multiple of 16. The
+//            rotations are single Zvbb instructions (vror.vi)
+//   crc32_mpeg2_v: CRC-32/MPEG-2 (MSB first, no final XOR) of each key, for
+//                  len a multiple of 4, a 32-bit big-endian word at a time,
+//                  with the 256-entry table. vrev8.v swaps the bytes of the
+//                  words
+// The _base variants run the same kernels without Zvbb, with shifts and
+// logic, to measure its speedup.
+
+#ifndef _HASH_H_
+#define _HASH_H_
+
+#include <stdint.h>
+
+void xxh32_v(const uint8_t *keys, uint64_t n, uint64_t len, uint32_t seed,
+             uint32_t *out);
+void xxh32_v_base(const uint8_t *keys, uint64_t n, uint64_t len, uint32_t seed,
+                  uint32_t *out);
+
+void crc32_mpeg2_v(const uint8_t *keys, uint64_t n, uint64_t len,
+                   const uint32_t *table, uint32_t *out);
+void crc32_mpeg2_v_base(const uint8_t *keys, uint64_t n, uint64_t len,
+                        const uint32_t *table, uint32_t *out);
+
+#endif
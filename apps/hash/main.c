@@ -0,0 +1,90 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdint.h>
+
+#include "kernel/hash.h"
+#include "runtime.h"
+#include "util.h"
+#include "vcheck.h"
+
+#ifndef SPIKE
+#include "printf.h"
+#else
+#include <stdio.h>
+#endif
+
+extern uint64_t n;
+extern uint64_t len_key;
+extern uint32_t seed;
+extern uint8_t keys[] __attribute__((aligned(4 * NR_LANES)));
+extern uint32_t crc_table[] __attribute__((aligned(4 * NR_LANES)));
+extern uint32_t out[] __attribute__((aligned(4 * NR_LANES)));
+extern uint32_t gold_xxh[] __attribute__((aligned(4 * NR_LANES)));
+extern uint32_t gold_crc[] __attribute__((aligned(4 * NR_LANES)));
+
+// Report the cycles of the last timed kernel, and return them
+static int64_t report(const char *name, const uint32_t *gold, int *error) {
+  int64_t runtime = get_timer();
+  int64_t idx = vcheck_i32((int32_t *)out, (int32_t *)gold, n);
+  printf("%s: %d cycles, %f bytes/cycle.\n", name, runtime,
+         (float)(n * len_key) / runtime);
+  if (idx >= 0) {
+    printf("%s: Error at key %d.\n", name, idx);
+    *error = 1;
+  } else {
+    printf("%s: Check okay. No errors.\n", name);
+  }
+  return runtime;
+}
+
+int main() {
+  printf("\n");
+  printf("==========\n");
+  printf("=  HASH  =\n");
+  printf("==========\n");
+  printf("\n");
+  printf("\n");
+
+  printf("Keys: %lu, bytes per key: %lu\n", n, len_key);
+
+  int error = 0;
+  int64_t zvbb, base;
+
+  start_timer();
+  xxh32_v(keys, n, len_key, seed, out);
+  stop_timer();
+  zvbb = report("xxh32_v", gold_xxh, &error);
+
+  start_timer();
+  xxh32_v_base(keys, n, len_key, seed, out);
+  stop_timer();
+  base = report("xxh32_v_base", gold_xxh, &error);
+  printf("xxh32: Zvbb speedup %f.\n", (float)base / zvbb);
+
+  start_timer();
+  crc32_mpeg2_v(keys, n, len_key, crc_table, out);
+  stop_timer();
+  zvbb = report("crc32_mpeg2_v", gold_crc, &error);
+
+  start_timer();
+  crc32_mpeg2_v_base(keys, n, len_key, crc_table, out);
+  stop_timer();
+  base = report("crc32_mpeg2_v_base", gold_crc, &error);
+  printf("crc32: Zvbb speedup %f.\n", (float)base / zvbb);
+
+  return error;
+}
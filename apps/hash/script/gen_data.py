@@ -0,0 +1,106 @@
+#!/usr/bin/env python3
+# Copyright 2022 ETH Zurich and University of Bologna.
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+# arg1: number of keys, arg2: bytes per key (a multiple of 16)
+
+import numpy as np
+import os
+import sys
+
+sys.path.insert(0, os.path.join(os.path.dirname(__file__), '../../common/script'))
+from data_emit import emit
+
+P1, P2, P3, P4, P5 = 0x9E3779B1, 0x85EBCA77, 0xC2B2AE3D, 0x27D4EB2F, 0x165667B1
+M32 = 0xffffffff
+
+def rotl(x, r):
+  return ((x << r) | (x >> (32 - r))) & M32
+
+def xxh32(data, seed):
+  # Reference xxHash32, with the tail of the keys that are not a multiple of 16 bytes
+  n, i = len(data), 0
+  if n >= 16:
+    v = [(seed + P1 + P2) & M32, (seed + P2) & M32, seed, (seed - P1) & M32]
+    while i + 16 <= n:
+      for j in range(4):
+        w = int.from_bytes(data[i+4*j:i+4*j+4], 'little')
+        v[j] = (rotl((v[j] + w * P2) & M32, 13) * P1) & M32
+      i += 16
+    h = (rotl(v[0], 1) + rotl(v[1], 7) + rotl(v[2], 12) + rotl(v[3], 18)) & M32
+  else:
+    h = (seed + P5) & M32
+  h = (h + n) & M32
+  while i + 4 <= n:
+    h = (rotl((h + int.from_bytes(data[i:i+4], 'little') * P3) & M32, 17) * P4) & M32
+    i += 4
+  while i < n:
+    h = (rotl((h + data[i] * P5) & M32, 11) * P1) & M32
+    i += 1
+  h ^= h >> 15
+  h = (h * P2) & M32
+  h ^= h >> 13
+  h = (h * P3) & M32
+  return h ^ (h >> 16)
+
+def crc32_mpeg2_table():
+  table = []
+  for b in range(256):
+    c = b << 24
+    for _ in range(8):
+      c = ((c << 1) ^ 0x04C11DB7) & M32 if c & 0x80000000 else (c << 1) & M32
+    table.append(c)
+  return table
+
+def crc32_mpeg2(data, table):
+  # CRC-32/MPEG-2: MSB first, initial value 0xffffffff, no final XOR
+  c = M32
+  for b in data:
+    c = ((c << 8) & M32) ^ table[(c >> 24) ^ b]
+  return c
+
+############
+## SCRIPT ##
+############
+
+if len(sys.argv) == 3:
+  n       = int(sys.argv[1])
+  len_key = int(sys.argv[2])
+else:
+  print("Error. Give me two arguments: the number of keys, and the bytes per key.")
+  sys.exit()
+
+if len_key == 0 or len_key % 16:
+  print("Error. The bytes per key must be a multiple of 16.")
+  sys.exit()
+
+seed  = 0x2c6fe996
+table = crc32_mpeg2_table()
+keys  = np.random.randint(0, 256, size=(n, len_key)).astype(np.uint8)
+
+gold_xxh = np.array([xxh32(bytes(k), seed) for k in keys], dtype=np.uint32)
+gold_crc = np.array([crc32_mpeg2(bytes(k), table) for k in keys], dtype=np.uint32)
+
+# Create the file
+print(".section .data,\"aw\",@progbits")
+emit("n", np.array(n, dtype=np.uint64))
+emit("len_key", np.array(len_key, dtype=np.uint64))
+emit("seed", np.array(seed, dtype=np.uint32))
+emit("keys", keys, 'NR_LANES*4')
+emit("crc_table", np.array(table, dtype=np.uint32), 'NR_LANES*4')
+emit("out", np.zeros(n, dtype=np.uint32), 'NR_LANES*4')
+emit("gold_xxh", gold_xxh, 'NR_LANES*4')
+emit("gold_crc", gold_crc, 'NR_LANES*4')
@@ -0,0 +1,166 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "hist_scan.h"
+
+/*
+  Histograms
+*/
+
+// Clear the copies of the histogram used by n keys
+static inline uint64_t vhist_clear(uint32_t *sub, uint64_t n, uint64_t bins) {
+  const uint64_t copies = n < VHIST_COPIES ? n : VHIST_COPIES;
+  const uint64_t len = copies * bins;
+  size_t vl;
+
+  for (uint64_t i = 0; i < len; i += vl) {
+    vl = vsetvl_e32m8(len - i);
+    vse32_v_u32m8(sub + i, vmv_v_x_u32m8(0, vl), vl);
+  }
+
+  return copies;
+}
+
+// Element e of the strip increments counter key of copy e. The counters of a
+// strip are all different, so the gather and the scatter do not conflict
+static inline void vhist_count(uint32_t *sub, vuint32m1_t base,
+                               vuint32m1_t key, size_t vl) {
+  vuint32m1_t off = vadd_vv_u32m1(base, vsll_vx_u32m1(key, 2, vl), vl);
+  vuint32m1_t cnt = vluxei32_v_u32m1(sub, off, vl);
+  vsuxei32_v_u32m1(sub, off, vadd_vx_u32m1(cnt, 1, vl), vl);
+}
+
+// Sum the copies, bin by bin
+static inline void vhist_merge(const uint32_t *sub, uint32_t *hist,
+                               uint64_t copies, uint64_t bins) {
+  size_t vl;
+
+  for (uint64_t b = 0; b < bins; b += vl) {
+    vl = vsetvl_e32m8(bins - b);
+    vuint32m8_t acc = vmv_v_x_u32m8(0, vl);
+    for (uint64_t c = 0; c < copies; ++c)
+      acc = vadd_vv_u32m8(acc, vle32_v_u32m8(sub + c * bins + b, vl), vl);
+    vse32_v_u32m8(hist + b, acc, vl);
+  }
+}
+
+// Byte offset of copy e, for the elements e of a strip
+static inline vuint32m1_t vhist_base(uint64_t bins) {
+  const size_t vl = vsetvl_e32m1(VHIST_COPIES);
+  return vmul_vx_u32m1(vid_v_u32m1(vl), bins * sizeof(uint32_t), vl);
+}
+
+void vhist_u8(const uint8_t *in, uint64_t n, uint32_t *hist, uint32_t *sub) {
+  const uint64_t copies = vhist_clear(sub, n, VHIST_U8_BINS);
+  vuint32m1_t base = vhist_base(VHIST_U8_BINS);
+  size_t vl;
+
+  for (uint64_t i = 0; i < n; i += vl) {
+    vl = vsetvl_e32m1(n - i);
+    vuint32m1_t key = vzext_vf4_u32m1(vle8_v_u8mf4(in + i, vl), vl);
+    vhist_count(sub, base, key, vl);
+  }
+
+  vhist_merge(sub, hist, copies, VHIST_U8_BINS);
+}
+
+void vhist_u16(const uint16_t *in, uint64_t n, uint32_t *hist, uint32_t *sub,
+               uint64_t bins) {
+  const uint64_t copies = vhist_clear(sub, n, bins);
+  vuint32m1_t base = vhist_base(bins);
+  size_t vl;
+
+  for (uint64_t i = 0; i < n; i += vl) {
+    vl = vsetvl_e32m1(n - i);
+    vuint32m1_t key = vzext_vf2_u32m1(vle16_v_u16mf2(in + i, vl), vl);
+    vhist_count(sub, base, key, vl);
+  }
+
+  vhist_merge(sub, hist, copies, bins);
+}
+
+// The sums of the copies are cleared as their counters: 0 is +0.0
+void vhist_add_f32(const uint16_t *key, const float *val, uint64_t n,
+                   float *hist, float *sub, uint64_t bins) {
+  const uint64_t copies = vhist_clear((uint32_t *)sub, n, bins);
+  vuint32m1_t base = vhist_base(bins);
+  size_t vl;
+
+  for (uint64_t i = 0; i < n; i += vl) {
+    vl = vsetvl_e32m1(n - i);
+    vuint32m1_t k = vzext_vf2_u32m1(vle16_v_u16mf2(key + i, vl), vl);
+    vuint32m1_t off = vadd_vv_u32m1(base, vsll_vx_u32m1(k, 2, vl), vl);
+    vfloat32m1_t acc = vluxei32_v_f32m1(sub, off, vl);
+    acc = vfadd_vv_f32m1(acc, vle32_v_f32m1(val + i, vl), vl);
+    vsuxei32_v_f32m1(sub, off, acc, vl);
+  }
+
+  for (uint64_t b = 0; b < bins; b += vl) {
+    vl = vsetvl_e32m8(bins - b);
+    vfloat32m8_t acc = vfmv_v_f_f32m8(0, vl);
+    for (uint64_t c = 0; c < copies; ++c)
+      acc = vfadd_vv_f32m8(acc, vle32_v_f32m8(sub + c * bins + b, vl), vl);
+    vse32_v_f32m8(hist + b, acc, vl);
+  }
+}
+
+/*
+  Prefix sums
+*/
+
+// Each step adds the strip slid up by s elements, with zeros below s: after
+// step s, element e holds the sum of the 2 * s elements up to e. The last
+// element of the strip is the carry of the next strips. The exclusive sum
+// slides the inclusive one by one more element.
+
+void vscan_add_i32(const int32_t *in, int32_t *out, uint64_t n, int exclusive) {
+  int32_t carry = 0;
+  size_t vl;
+
+  for (uint64_t i = 0; i < n; i += vl) {
+    vl = vsetvl_e32m4(n - i);
+    vint32m4_t zero = vmv_v_x_i32m4(0, vl);
+    vint32m4_t x = vle32_v_i32m4(in + i, vl);
+    for (size_t s = 1; s < vl; s <<= 1)
+      x = vadd_vv_i32m4(x, vslideup_vx_i32m4(zero, x, s, vl), vl);
+
+    const int32_t sum = vmv_x_s_i32m4_i32(vslidedown_vx_i32m4(x, x, vl - 1, vl));
+    if (exclusive)
+      x = vslide1up_vx_i32m4(x, 0, vl);
+    vse32_v_i32m4(out + i, vadd_vx_i32m4(x, carry, vl), vl);
+    carry += sum;
+  }
+}
+
+void vscan_add_f32(const float *in, float *out, uint64_t n, int exclusive) {
+  float carry = 0;
+  size_t vl;
+
+  for (uint64_t i = 0; i < n; i += vl) {
+    vl = vsetvl_e32m4(n - i);
+    vfloat32m4_t zero = vfmv_v_f_f32m4(0, vl);
+    vfloat32m4_t x = vle32_v_f32m4(in + i, vl);
+    for (size_t s = 1; s < vl; s <<= 1)
+      x = vfadd_vv_f32m4(x, vslideup_vx_f32m4(zero, x, s, vl), vl);
+
+    const float sum =
+        vfmv_f_s_f32m4_f32(vslidedown_vx_f32m4(x, x, vl - 1, vl));
+    if (exclusive)
+      x = vfslide1up_vf_f32m4(x, 0, vl);
+    vse32_v_f32m4(out + i, vfadd_vf_f32m4(x, carry, vl), vl);
+    carry += sum;
+  }
+}
@@ -0,0 +1,56 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Histograms and prefix sums:
+//   vhist_u8/u16: histogram of n keys in bins bins (256 for vhist_u8). Each
+//                 element of a strip counts in its own copy of the histogram,
+//                 so that the indexed loads and stores of a strip never hit
+//                 the same counter. The VHIST_COPIES copies are summed at the
+//                 end. The keys of vhist_u16 are below bins. sub is a buffer
+//                 of vhist_sub_size(bins) bytes
+//   vhist_add_f32: scatter-add of n FP32 values to bins bins, hist[key[i]] +=
+//                  val[i], with the same copies as vhist_u16. The sums of a
+//                  bin are in the order of the copies, not of the keys
+//   vscan_add_i32/f32: inclusive (exclusive = 0) or exclusive prefix sum of
+//                      n elements, in log2(vl) slides per strip, plus the
+//                      carry of the previous strips. out can be in
+
+#ifndef _HIST_SCAN_H_
+#define _HIST_SCAN_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "riscv_vector.h"
+#include "vconfig.h"
+
+#define VHIST_U8_BINS 256
+#define VHIST_COPIES VLMAX(32, 1)
+
+static inline size_t vhist_sub_size(uint64_t bins) {
+  return VHIST_COPIES * bins * sizeof(uint32_t);
+}
+
+void vhist_u8(const uint8_t *in, uint64_t n, uint32_t *hist, uint32_t *sub);
+void vhist_u16(const uint16_t *in, uint64_t n, uint32_t *hist, uint32_t *sub,
+               uint64_t bins);
+void vhist_add_f32(const uint16_t *key, const float *val, uint64_t n,
+                   float *hist, float *sub, uint64_t bins);
+
+void vscan_add_i32(const int32_t *in, int32_t *out, uint64_t n, int exclusive);
+void vscan_add_f32(const float *in, float *out, uint64_t n, int exclusive);
+
+#endif
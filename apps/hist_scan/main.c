@@ -0,0 +1,109 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdint.h>
+
+#include "kernel/hist_scan.h"
+#include "l2_alloc.h"
+#include "runtime.h"
+#include "util.h"
+#include "vcheck.h"
+
+#ifndef SPIKE
+#include "printf.h"
+#else
+#include <stdio.h>
+#endif
+
+#define THRESHOLD 0.001
+
+extern uint64_t n;
+extern uint64_t bins;
+extern uint8_t k8[] __attribute__((aligned(4 * NR_LANES)));
+extern uint16_t k16[] __attribute__((aligned(4 * NR_LANES)));
+extern uint32_t hist[] __attribute__((aligned(4 * NR_LANES)));
+extern uint32_t gold_h8[] __attribute__((aligned(4 * NR_LANES)));
+extern uint32_t gold_h16[] __attribute__((aligned(4 * NR_LANES)));
+extern int32_t xi[] __attribute__((aligned(4 * NR_LANES)));
+extern int32_t yi[] __attribute__((aligned(4 * NR_LANES)));
+extern int32_t gold_si[] __attribute__((aligned(4 * NR_LANES)));
+extern int32_t gold_ei[] __attribute__((aligned(4 * NR_LANES)));
+extern float xf[] __attribute__((aligned(4 * NR_LANES)));
+extern float yf[] __attribute__((aligned(4 * NR_LANES)));
+extern float gold_sf[] __attribute__((aligned(4 * NR_LANES)));
+extern float gold_ef[] __attribute__((aligned(4 * NR_LANES)));
+
+static int report(const char *name, int64_t idx) {
+  int64_t runtime = get_timer();
+  printf("%s: %ld cycles, %f cycles/element.\n", name, runtime,
+         (float)runtime / n);
+  return vcheck_report(name, idx);
+}
+
+int main() {
+  printf("\n");
+  printf("===============\n");
+  printf("=  HIST_SCAN  =\n");
+  printf("===============\n");
+  printf("\n");
+  printf("\n");
+
+  printf("Elements: %lu, 16-bit bins: %lu, copies: %lu\n", n, bins,
+         (uint64_t)VHIST_COPIES);
+
+  uint32_t *sub = l2_alloc(vhist_sub_size(bins > 256 ? bins : 256), 0);
+  if (!sub) {
+    printf("The sub-histograms do not fit in the L2 arena.\n");
+    return 1;
+  }
+
+  int error = 0;
+
+  start_timer();
+  vhist_u8(k8, n, hist, sub);
+  stop_timer();
+  error |= report("vhist_u8", vcheck_i32((int32_t *)hist, (int32_t *)gold_h8,
+                                         VHIST_U8_BINS));
+
+  start_timer();
+  vhist_u16(k16, n, hist, sub, bins);
+  stop_timer();
+  error |= report("vhist_u16",
+                  vcheck_i32((int32_t *)hist, (int32_t *)gold_h16, bins));
+
+  start_timer();
+  vscan_add_i32(xi, yi, n, 0);
+  stop_timer();
+  error |= report("vscan_add_i32", vcheck_i32(yi, gold_si, n));
+
+  start_timer();
+  vscan_add_i32(xi, yi, n, 1);
+  stop_timer();
+  error |= report("vscan_add_i32 (exclusive)", vcheck_i32(yi, gold_ei, n));
+
+  start_timer();
+  vscan_add_f32(xf, yf, n, 0);
+  stop_timer();
+  error |= report("vscan_add_f32", vcheck_f32(yf, gold_sf, n, THRESHOLD));
+
+  start_timer();
+  vscan_add_f32(xf, yf, n, 1);
+  stop_timer();
+  error |= report("vscan_add_f32 (exclusive)",
+                  vcheck_f32(yf, gold_ef, n, THRESHOLD));
+
+  return error;
+}
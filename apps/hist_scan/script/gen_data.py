@@ -0,0 +1,66 @@
+#!/usr/bin/env python3
+# Copyright 2022 ETH Zurich and University of Bologna.
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+# arg1: number of elements, arg2: bins of the 16-bit histogram
+
+import numpy as np
+import os
+import sys
+
+sys.path.insert(0, os.path.join(os.path.dirname(__file__), '../../common/script'))
+from data_emit import emit
+
+############
+## SCRIPT ##
+############
+
+if len(sys.argv) == 3:
+  n    = int(sys.argv[1])
+  bins = int(sys.argv[2])
+else:
+  print("Error. Give me two arguments: the number of elements, and the bins of the 16-bit histogram.")
+  sys.exit()
+
+# Activations-like 8-bit keys, crowded around the middle, as in a calibration
+k8  = np.clip(np.rint(np.random.normal(128, 32, n)), 0, 255).astype(np.uint8)
+k16 = np.random.randint(0, bins, size=n).astype(np.uint16)
+xi  = np.random.randint(-1000, 1000, size=n).astype(np.int32)
+xf  = np.random.uniform(-1, 1, n).astype(np.float32)
+
+# Sums in FP64, and exclusive sums as the inclusive ones slid by one element
+cum_i = np.cumsum(xi, dtype=np.int64).astype(np.int32)
+cum_f = np.cumsum(xf.astype(np.float64))
+exc_i = np.concatenate(([0], cum_i))[:n].astype(np.int32)
+exc_f = np.concatenate(([0], cum_f))[:n]
+
+# Create the file
+print(".section .data,\"aw\",@progbits")
+emit("n", np.array(n, dtype=np.uint64))
+emit("bins", np.array(bins, dtype=np.uint64))
+emit("k8", k8, 'NR_LANES*4')
+emit("k16", k16, 'NR_LANES*4')
+emit("hist", np.zeros(max(bins, 256), dtype=np.uint32), 'NR_LANES*4')
+emit("gold_h8", np.bincount(k8, minlength=256).astype(np.uint32), 'NR_LANES*4')
+emit("gold_h16", np.bincount(k16, minlength=bins).astype(np.uint32), 'NR_LANES*4')
+emit("xi", xi, 'NR_LANES*4')
+emit("yi", np.zeros(n, dtype=np.int32), 'NR_LANES*4')
+emit("gold_si", cum_i, 'NR_LANES*4')
+emit("gold_ei", exc_i, 'NR_LANES*4')
+emit("xf", xf, 'NR_LANES*4')
+emit("yf", np.zeros(n, dtype=np.float32), 'NR_LANES*4')
+emit("gold_sf", cum_f.astype(np.float32), 'NR_LANES*4')
+emit("gold_ef", exc_f.astype(np.float32), 'NR_LANES*4')
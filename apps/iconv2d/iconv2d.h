@@ -21,6 +21,8 @@
 
 #include <stdint.h>
 
+#include "vconfig.h"
+
 void iconv2d_3x3(int64_t *o, int64_t *i, int64_t *f, int64_t R, int64_t C,
                  int64_t F);
 void iconv2d_vec_4xC_slice_init_3x3(int64_t *o, int64_t C);
@@ -42,6 +44,20 @@ void iconv2d_7x7(int64_t *o, int64_t *i, int64_t *f, int64_t M, int64_t N,
 void iconv2d_7x7_block(int64_t *o, int64_t *i, int64_t *f, int64_t R, int64_t C,
                        int64_t n_, int64_t F);
 
+// Output rows computed at once by iconv2d_i8()
+#ifndef ICONV2D_I8_BLOCK
+#define ICONV2D_I8_BLOCK 4
+#endif
+// Largest filter size supported by iconv2d_i8()
+#define ICONV2D_I8_MAX_F 11
+
+// int8 input and filter, with 32-bit accumulators, for any odd F up to
+// ICONV2D_I8_MAX_F and R multiple of ICONV2D_I8_BLOCK. The results are stored
+// to o, or with q requantized to int8 with the Q31 multiplier mult:
+// q = sat8(rnu(((o * mult) >> 32) >> shift))
+void iconv2d_i8(int32_t *o, int8_t *q, const int8_t *i, const int8_t *f,
+                int32_t mult, int64_t shift, int64_t R, int64_t C, int64_t F);
+
 #define MIN(a, b) ((a) < (b) ? (a) : (b))
 
 #endif
@@ -0,0 +1,360 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/*
+  int8 KxK convolution for Ara, for any odd filter size up to
+  ICONV2D_I8_MAX_F, with the row-reuse strategy of fconv2d_KxK()
+
+  The input rows are loaded once per block of ICONV2D_I8_BLOCK output rows,
+  sign-extended to 16 bits, and slid down once per filter column, as in
+  imatmul_i8: the 16-bit rows are multiplied by the filter coefficients with
+  vwmacc.vx into 32-bit accumulators, which do not overflow up to 11x11
+  filters. The operands are at SEW 16 and LMUL 1, the accumulators at SEW 32
+  and LMUL 2, so that a vector of 16-bit elements holds four times the
+  elements of the 64-bit rows of iconv2d_3x3().
+
+  With q, the accumulators are requantized on store: scaled by the Q31
+  multiplier with vmulh, then rounded, shifted, and saturated to 16 and 8 bits
+  with vnclip, as imatmul_i8_q(). Otherwise, they are stored to o.
+
+  The schedule is generated at compile time from the filter size, with the
+  vector registers selected by switches, as in fconv2d_KxK().
+*/
+
+#include <stddef.h>
+
+#include "iconv2d.h"
+
+//////////////////////
+// Vector registers //
+//////////////////////
+
+#define ICONV2D_I8_VREGS(X, a)                                                 \
+  X(a, 0) X(a, 1) X(a, 2) X(a, 3) X(a, 4) X(a, 5) X(a, 6) X(a, 7) X(a, 8)      \
+  X(a, 9) X(a, 10) X(a, 11) X(a, 12) X(a, 13) X(a, 14) X(a, 15) X(a, 16)       \
+  X(a, 17) X(a, 18) X(a, 19) X(a, 20) X(a, 21) X(a, 22) X(a, 23) X(a, 24)      \
+  X(a, 25) X(a, 26) X(a, 27) X(a, 28) X(a, 29) X(a, 30) X(a, 31)
+
+// Same as ICONV2D_I8_VREGS, to nest the switches on two registers
+#define ICONV2D_I8_VREGS_(X, a)                                                \
+  X(a, 0) X(a, 1) X(a, 2) X(a, 3) X(a, 4) X(a, 5) X(a, 6) X(a, 7) X(a, 8)      \
+  X(a, 9) X(a, 10) X(a, 11) X(a, 12) X(a, 13) X(a, 14) X(a, 15) X(a, 16)       \
+  X(a, 17) X(a, 18) X(a, 19) X(a, 20) X(a, 21) X(a, 22) X(a, 23) X(a, 24)      \
+  X(a, 25) X(a, 26) X(a, 27) X(a, 28) X(a, 29) X(a, 30) X(a, 31)
+
+// The register groups of LMUL = 2 of the accumulators
+#define ICONV2D_I8_VREGS_M2(X, a)                                              \
+  X(a, 0) X(a, 2) X(a, 4) X(a, 6) X(a, 8) X(a, 10) X(a, 12) X(a, 14) X(a, 16)  \
+  X(a, 18) X(a, 20) X(a, 22) X(a, 24) X(a, 26) X(a, 28) X(a, 30)
+
+#define ICONV2D_I8_INLINE static inline __attribute__((always_inline))
+
+// The three configurations have the same VLMAX, and switch keeping vl
+ICONV2D_I8_INLINE void iconv2d_i8_setvl(unsigned long int avl) {
+  asm volatile("vsetvli zero, %0, e16, m1, ta, ma" ::"r"(avl));
+}
+
+ICONV2D_I8_INLINE void iconv2d_i8_e8() {
+  asm volatile("vsetvli zero, zero, e8, mf2, ta, ma");
+}
+
+ICONV2D_I8_INLINE void iconv2d_i8_e16() {
+  asm volatile("vsetvli zero, zero, e16, m1, ta, ma");
+}
+
+ICONV2D_I8_INLINE void iconv2d_i8_e32() {
+  asm volatile("vsetvli zero, zero, e32, m2, ta, ma");
+}
+
+ICONV2D_I8_INLINE void iconv2d_i8_vle8(int vd, const int8_t *i) {
+#define ICONV2D_I8_VLE8(a, d)                                                  \
+  case d:                                                                      \
+    asm volatile("vle8.v v" #d ", (%0)" ::"r"(i));                             \
+    break;
+  switch (vd) { ICONV2D_I8_VREGS(ICONV2D_I8_VLE8, _) }
+#undef ICONV2D_I8_VLE8
+}
+
+ICONV2D_I8_INLINE void iconv2d_i8_vse8(int vs, int8_t *q) {
+#define ICONV2D_I8_VSE8(a, s)                                                  \
+  case s:                                                                      \
+    asm volatile("vse8.v v" #s ", (%0)" ::"r"(q));                             \
+    break;
+  switch (vs) { ICONV2D_I8_VREGS(ICONV2D_I8_VSE8, _) }
+#undef ICONV2D_I8_VSE8
+}
+
+ICONV2D_I8_INLINE void iconv2d_i8_vse32(int vs, int32_t *o) {
+#define ICONV2D_I8_VSE32(a, s)                                                 \
+  case s:                                                                      \
+    asm volatile("vse32.v v" #s ", (%0)" ::"r"(o));                            \
+    break;
+  switch (vs) { ICONV2D_I8_VREGS_M2(ICONV2D_I8_VSE32, _) }
+#undef ICONV2D_I8_VSE32
+}
+
+// vd = sext(vs), from 8 to 16 bits
+ICONV2D_I8_INLINE void iconv2d_i8_vsext(int vd, int vs) {
+#define ICONV2D_I8_VSEXT_VS(d, s)                                              \
+  case s:                                                                      \
+    asm volatile("vsext.vf2 v" #d ", v" #s);                                   \
+    break;
+#define ICONV2D_I8_VSEXT_VD(a, d)                                              \
+  case d:                                                                      \
+    switch (vs) { ICONV2D_I8_VREGS_(ICONV2D_I8_VSEXT_VS, d) }                  \
+    break;
+  switch (vd) { ICONV2D_I8_VREGS(ICONV2D_I8_VSEXT_VD, _) }
+#undef ICONV2D_I8_VSEXT_VD
+#undef ICONV2D_I8_VSEXT_VS
+}
+
+// vd = vs * f, or vd += vs * f, with the products widened to 32 bits
+ICONV2D_I8_INLINE void iconv2d_i8_vwmacc(int init, int vd, int64_t f, int vs) {
+#define ICONV2D_I8_VWMACC_VS(d, s)                                             \
+  case s:                                                                      \
+    if (init)                                                                  \
+      asm volatile("vwmul.vx v" #d ", v" #s ", %0" ::"r"(f));                  \
+    else                                                                       \
+      asm volatile("vwmacc.vx v" #d ", %0, v" #s ::"r"(f));                    \
+    break;
+#define ICONV2D_I8_VWMACC_VD(a, d)                                             \
+  case d:                                                                      \
+    switch (vs) { ICONV2D_I8_VREGS_(ICONV2D_I8_VWMACC_VS, d) }                 \
+    break;
+  switch (vd) { ICONV2D_I8_VREGS_M2(ICONV2D_I8_VWMACC_VD, _) }
+#undef ICONV2D_I8_VWMACC_VD
+#undef ICONV2D_I8_VWMACC_VS
+}
+
+// vd = vs slid down by off elements
+ICONV2D_I8_INLINE void iconv2d_i8_vslidedown(int vd, int vs, int64_t off) {
+#define ICONV2D_I8_VSLIDEDOWN_VS(d, s)                                         \
+  case s:                                                                      \
+    asm volatile("vslidedown.vx v" #d ", v" #s ", %0" ::"r"(off));             \
+    break;
+#define ICONV2D_I8_VSLIDEDOWN_VD(a, d)                                         \
+  case d:                                                                      \
+    switch (vs) { ICONV2D_I8_VREGS_(ICONV2D_I8_VSLIDEDOWN_VS, d) }             \
+    break;
+  switch (vd) { ICONV2D_I8_VREGS(ICONV2D_I8_VSLIDEDOWN_VD, _) }
+#undef ICONV2D_I8_VSLIDEDOWN_VD
+#undef ICONV2D_I8_VSLIDEDOWN_VS
+}
+
+ICONV2D_I8_INLINE void iconv2d_i8_vmv(int vd, int vs) {
+#define ICONV2D_I8_VMV_VS(d, s)                                                \
+  case s:                                                                      \
+    asm volatile("vmv.v.v v" #d ", v" #s);                                     \
+    break;
+#define ICONV2D_I8_VMV_VD(a, d)                                                \
+  case d:                                                                      \
+    switch (vs) { ICONV2D_I8_VREGS_(ICONV2D_I8_VMV_VS, d) }                    \
+    break;
+  switch (vd) { ICONV2D_I8_VREGS(ICONV2D_I8_VMV_VD, _) }
+#undef ICONV2D_I8_VMV_VD
+#undef ICONV2D_I8_VMV_VS
+}
+
+// vd = sat(rnu(vs >> shift)), narrowed by 2x: from 32 to 16 bits with shift,
+// or from 16 to 8 bits with shift = 0
+ICONV2D_I8_INLINE void iconv2d_i8_vnclip(int vd, int vs, int64_t shift) {
+#define ICONV2D_I8_VNCLIP_VS(d, s)                                             \
+  case s:                                                                      \
+    asm volatile("vnclip.wx v" #d ", v" #s ", %0" ::"r"(shift));               \
+    break;
+#define ICONV2D_I8_VNCLIP_VD(a, d)                                             \
+  case d:                                                                      \
+    switch (vs) { ICONV2D_I8_VREGS_(ICONV2D_I8_VNCLIP_VS, d) }                 \
+    break;
+  switch (vd) { ICONV2D_I8_VREGS(ICONV2D_I8_VNCLIP_VD, _) }
+#undef ICONV2D_I8_VNCLIP_VD
+#undef ICONV2D_I8_VNCLIP_VS
+}
+
+// vd = (vd * mult) >> 32
+ICONV2D_I8_INLINE void iconv2d_i8_vmulh(int vd, int32_t mult) {
+#define ICONV2D_I8_VMULH(a, d)                                                 \
+  case d:                                                                      \
+    asm volatile("vmulh.vx v" #d ", v" #d ", %0" ::"r"(mult));                 \
+    break;
+  switch (vd) { ICONV2D_I8_VREGS_M2(ICONV2D_I8_VMULH, _) }
+#undef ICONV2D_I8_VMULH
+}
+
+////////////
+// Kernel //
+////////////
+
+// Register group of the accumulators of the output row b
+ICONV2D_I8_INLINE int iconv2d_i8_vo(int64_t b) { return 2 * b; }
+
+// Register of the 16-bit input row r of the block
+ICONV2D_I8_INLINE int iconv2d_i8_vi(int64_t r) {
+  return 2 * ICONV2D_I8_BLOCK + r;
+}
+
+// Register of the slid input row, alternating between two to let a slide run
+// while the previous one is in use
+ICONV2D_I8_INLINE int iconv2d_i8_vs(int64_t k, int64_t F) {
+  return 3 * ICONV2D_I8_BLOCK + F - 1 + (k & 1);
+}
+
+// Register of the 8-bit input row b, before its sign extension
+ICONV2D_I8_INLINE int iconv2d_i8_vt(int64_t b, int64_t F) {
+  return 3 * ICONV2D_I8_BLOCK + F + 1 + b;
+}
+
+// Load n 8-bit input rows, and sign-extend them to the input rows r0 to
+// r0 + n - 1
+ICONV2D_I8_INLINE void iconv2d_i8_load(const int8_t *i, int64_t ldi,
+                                       int64_t r0, int64_t n, int64_t F) {
+#pragma clang loop unroll(full)
+  for (int64_t r = 0; r < n; ++r) {
+    iconv2d_i8_e8();
+    iconv2d_i8_vle8(iconv2d_i8_vt(r % ICONV2D_I8_BLOCK, F), i + r * ldi);
+    iconv2d_i8_e16();
+    iconv2d_i8_vsext(iconv2d_i8_vi(r0 + r),
+                     iconv2d_i8_vt(r % ICONV2D_I8_BLOCK, F));
+  }
+}
+
+// Convolve a slice of n_ columns
+ICONV2D_I8_INLINE void iconv2d_i8_block(int32_t *o, int8_t *q, const int8_t *i,
+                                        const int8_t *f, int32_t mult,
+                                        int64_t shift, int64_t R, int64_t C,
+                                        int64_t n_, int64_t F) {
+  const int64_t ldi = C + F - 1;
+
+  // Preload the first F - 1 input rows
+  iconv2d_i8_setvl(n_ + F - 1);
+  iconv2d_i8_load(i, ldi, 0, F - 1, F);
+  i += (F - 1) * ldi;
+
+  for (int64_t r = 0; r < R; r += ICONV2D_I8_BLOCK) {
+    // Fetch n_ + F - 1 elements (padding included) of the next input rows
+    iconv2d_i8_setvl(n_ + F - 1);
+    iconv2d_i8_load(i, ldi, F - 1, ICONV2D_I8_BLOCK, F);
+    i += ICONV2D_I8_BLOCK * ldi;
+
+    // Compute on n_ elements
+    iconv2d_i8_setvl(n_);
+
+    // Contributions of the input row j, on the output rows j - F + 1 to j
+#pragma clang loop unroll(full)
+    for (int64_t j = 0; j < F + ICONV2D_I8_BLOCK - 1; ++j) {
+#pragma clang loop unroll(full)
+      for (int64_t k = 0; k < F; ++k) {
+        int vs = iconv2d_i8_vi(j);
+        if (k != 0) {
+          iconv2d_i8_vslidedown(iconv2d_i8_vs(k, F), vs, k);
+          vs = iconv2d_i8_vs(k, F);
+        }
+#pragma clang loop unroll(full)
+        for (int64_t b = 0; b < ICONV2D_I8_BLOCK; ++b)
+          if (b <= j && j - b < F)
+            iconv2d_i8_vwmacc(j == b && k == 0, iconv2d_i8_vo(b),
+                              f[(j - b) * F + k], vs);
+      }
+
+      // The output row j - F + 1 is complete. The requantized row goes
+      // through a slid row and an 8-bit row, which are free until the next
+      // input row
+      if (j >= F - 1) {
+        const int64_t b = j - F + 1;
+        iconv2d_i8_e32();
+        if (q) {
+          iconv2d_i8_vmulh(iconv2d_i8_vo(b), mult);
+          iconv2d_i8_e16();
+          iconv2d_i8_vnclip(iconv2d_i8_vs(0, F), iconv2d_i8_vo(b), shift);
+          iconv2d_i8_e8();
+          iconv2d_i8_vnclip(iconv2d_i8_vt(0, F), iconv2d_i8_vs(0, F), 0);
+          iconv2d_i8_vse8(iconv2d_i8_vt(0, F), q + b * C);
+        } else {
+          iconv2d_i8_vse32(iconv2d_i8_vo(b), o + b * C);
+        }
+        iconv2d_i8_e16();
+      }
+    }
+    if (q)
+      q += ICONV2D_I8_BLOCK * C;
+    else
+      o += ICONV2D_I8_BLOCK * C;
+
+    // Re-use the last F - 1 input rows
+    iconv2d_i8_setvl(n_ + F - 1);
+#pragma clang loop unroll(full)
+    for (int64_t r = 0; r < F - 1; ++r)
+      iconv2d_i8_vmv(iconv2d_i8_vi(r), iconv2d_i8_vi(ICONV2D_I8_BLOCK + r));
+  }
+}
+
+ICONV2D_I8_INLINE void iconv2d_i8_slices(int32_t *o, int8_t *q,
+                                         const int8_t *i, const int8_t *f,
+                                         int32_t mult, int64_t shift,
+                                         int64_t R, int64_t C, int64_t F) {
+  // Every slice of columns must fit in a vector register with its padding
+  const int64_t block_size_n = MIN(C + F - 1, VLMAX(16, 1)) - (F - 1);
+
+  for (int64_t n = 0; n < C; n += block_size_n) {
+    const int64_t n_ = MIN(C - n, block_size_n);
+    iconv2d_i8_block(o ? o + n : NULL, q ? q + n : NULL, i + n, f, mult, shift,
+                     R, C, n_, F);
+  }
+}
+
+// One instance of the kernel per filter size
+#define ICONV2D_I8_INSTANCE(K)                                                 \
+  static void iconv2d_i8_##K(int32_t *o, int8_t *q, const int8_t *i,           \
+                             const int8_t *f, int32_t mult, int64_t shift,     \
+                             int64_t R, int64_t C) {                           \
+    iconv2d_i8_slices(o, q, i, f, mult, shift, R, C, K);                       \
+  }
+
+ICONV2D_I8_INSTANCE(1)
+ICONV2D_I8_INSTANCE(3)
+ICONV2D_I8_INSTANCE(5)
+ICONV2D_I8_INSTANCE(7)
+ICONV2D_I8_INSTANCE(9)
+ICONV2D_I8_INSTANCE(11)
+
+void iconv2d_i8(int32_t *o, int8_t *q, const int8_t *i, const int8_t *f,
+                int32_t mult, int64_t shift, int64_t R, int64_t C,
+                int64_t F) {
+  // Round to the nearest, ties up, when shifting the scaled results
+  if (q)
+    asm volatile("csrwi vxrm, 0");
+
+  switch (F) {
+  case 1:
+    iconv2d_i8_1(o, q, i, f, mult, shift, R, C);
+    break;
+  case 3:
+    iconv2d_i8_3(o, q, i, f, mult, shift, R, C);
+    break;
+  case 5:
+    iconv2d_i8_5(o, q, i, f, mult, shift, R, C);
+    break;
+  case 7:
+    iconv2d_i8_7(o, q, i, f, mult, shift, R, C);
+    break;
+  case 9:
+    iconv2d_i8_9(o, q, i, f, mult, shift, R, C);
+    break;
+  case 11:
+    iconv2d_i8_11(o, q, i, f, mult, shift, R, C);
+    break;
+  }
+}
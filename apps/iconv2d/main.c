@@ -41,6 +41,16 @@ extern int64_t golden_o[] __attribute__((aligned(4 * NR_LANES))); // [ M*N ]
 extern int64_t M;
 extern int64_t N;
 extern int64_t F;
+// int8 image and filter, of the same sizes
+extern int8_t i8[] __attribute__((aligned(4 * NR_LANES)));
+extern int8_t f8[] __attribute__((aligned(4 * NR_LANES)));
+extern int32_t o32[] __attribute__((aligned(4 * NR_LANES)));
+extern int8_t q8[] __attribute__((aligned(4 * NR_LANES)));
+extern int32_t golden_o32[] __attribute__((aligned(4 * NR_LANES)));
+extern int8_t golden_q8[] __attribute__((aligned(4 * NR_LANES)));
+// Q31 multiplier and shift of the requantization
+extern int32_t mult;
+extern int64_t shift;
 
 // Verify the matrices
 int verify_matrix(int64_t *matrix, int64_t *golden_matrix, int64_t R,
@@ -55,6 +65,28 @@ int verify_matrix(int64_t *matrix, int64_t *golden_matrix, int64_t R,
   return 0;
 }
 
+// Verify the int8 results, of size bytes. The elements are compared as bytes
+int verify_bytes(const char *name, const void *res, const void *golden,
+                 int64_t size) {
+  const int8_t *r = res, *g = golden;
+  for (int64_t k = 0; k < size; ++k)
+    if (r[k] != g[k]) {
+      printf("%s: Error at byte %ld\n", name, k);
+      return 1;
+    }
+  printf("%s: Passed.\n", name);
+  return 0;
+}
+
+// OP/cycle of the int8 kernel, against the peak of the 16-bit products
+void report_i8(const char *name) {
+  int64_t runtime = get_timer();
+  float performance = 2.0 * F * F * M * N / runtime;
+  float utilization = 100 * performance / (2.0 * 4 * NR_LANES);
+  printf("%s: %d cycles, %f OP/cycle (%f%% utilization).\n", name, runtime,
+         performance, utilization);
+}
+
 void print_matrix(int64_t const *matrix, uint64_t num_rows,
                   uint64_t num_columns) {
   printf("0x%8X\n", (uint64_t)matrix);
@@ -104,5 +136,20 @@ int main() {
     printf("Passed.\n");
   }
 
+  // int8 kernel, with 32-bit and requantized results
+  if (F % 2 == 1 && F <= ICONV2D_I8_MAX_F) {
+    start_timer();
+    iconv2d_i8(o32, NULL, i8, f8, mult, shift, M, N, F);
+    stop_timer();
+    report_i8("iconv2d_i8");
+    error |= verify_bytes("iconv2d_i8", o32, golden_o32, M * N * 4);
+
+    start_timer();
+    iconv2d_i8(NULL, q8, i8, f8, mult, shift, M, N, F);
+    stop_timer();
+    report_i8("iconv2d_i8 (requantized)");
+    error |= verify_bytes("iconv2d_i8 (requantized)", q8, golden_q8, M * N);
+  }
+
   return error;
 }
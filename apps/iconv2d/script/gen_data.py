@@ -19,6 +19,7 @@
 # arg1: image size, arg2: filter size
 
 import numpy as np
+import os
 import sys
 
 def convolve2D(kernel, image, padding):
@@ -56,16 +57,8 @@ def convolve2D(kernel, image, padding):
 
     return output
 
-def emit(name, array, alignment='8'):
-	print(".global %s" % name)
-	print(".balign " + alignment)
-	print("%s:" % name)
-	bs = array.tobytes()
-	for i in range(0, len(bs), 4):
-		s = ""
-		for n in range(4):
-			s += "%02x" % bs[i+3-n]
-		print("    .word 0x%s" % s)
+sys.path.insert(0, os.path.join(os.path.dirname(__file__), '../../common/script'))
+from data_emit import emit
 
 # Define the filter size and the matrix dimension (max, for now, is 128 64-bit elements)
 if len(sys.argv) > 1:
@@ -104,6 +97,22 @@ empty_o = np.zeros((M, N)).astype(np.int64)
 # Calculate the output matrix
 result = np.around(convolve2D(gen_filter, image, padding)).astype(np.int64)
 
+# int8 image and filter of the same sizes, and their 32-bit results
+image8 = np.random.randint(-128, 128, M_pad * N_pad).astype(np.int8).reshape(M_pad, N_pad)
+filter8 = np.random.randint(-128, 128, F * F).astype(np.int8).reshape(F, F)
+result32 = np.around(convolve2D(filter8.astype(np.int64), image8.astype(np.int64),
+                                padding)).astype(np.int32)
+
+# Requantization: vmulh by the Q31 multiplier, then vnclip with
+# round-to-nearest-up to 16 and 8 bits, as imatmul_i8
+mult = np.random.randint(2**30, 2**31)
+H = (result32.astype(np.int64) * mult) >> 32
+# Shift the largest result into the int8 range
+shift = max(0, int(np.abs(H).max()).bit_length() - 7)
+if shift > 0:
+  H = (H + (1 << (shift - 1))) >> shift
+result8 = np.clip(H, -128, 127).astype(np.int8)
+
 # Print information on file
 print(".section .data,\"aw\",@progbits")
 emit("M", np.array(M, dtype=np.uint64))
@@ -113,3 +122,11 @@ emit("i", image, 'NR_LANES*4')
 emit("f", gen_filter, 'NR_LANES*4')
 emit("o", empty_o, 'NR_LANES*4')
 emit("golden_o", result, 'NR_LANES*4')
+emit("i8", image8, 'NR_LANES*4')
+emit("f8", filter8, 'NR_LANES*4')
+emit("o32", np.zeros((M, N), dtype=np.int32), 'NR_LANES*4')
+emit("q8", np.zeros((M, N), dtype=np.int8), 'NR_LANES*4')
+emit("golden_o32", result32, 'NR_LANES*4')
+emit("golden_q8", result8, 'NR_LANES*4')
+emit("mult", np.array(mult, dtype=np.int32))
+emit("shift", np.array(shift, dtype=np.int64))
@@ -18,6 +18,7 @@
 //         Samuel Riedel, ETH Zurich
 
 #include "imatmul.h"
+#include "vconfig.h"
 
 #define MIN(a, b) ((a) < (b) ? (a) : (b))
 
@@ -26,11 +27,11 @@ void imatmul(int64_t *c, const int64_t *a, const int64_t *b,
              const unsigned long int P) {
   if (M <= 4) {
     imatmul_4x4(c, a, b, M, N, P);
-  } else if (M <= 128) {
+  } else if (M <= VLMAX_E64M2) {
+    // With an 8x8 matmul, we can use LMUL=2, having a vl of 2 * VLMAX_E64M1
     imatmul_8x8(c, a, b, M, N, P);
   } else {
-    // Vector length is 64 elements. With an 4x4 matmul,
-    // we can use LMUL=4, having a vl of 256.
+    // With an 4x4 matmul, we can use LMUL=4, having a vl of 4 * VLMAX_E64M1
     imatmul_4x4(c, a, b, M, N, P);
   }
 }
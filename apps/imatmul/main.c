@@ -24,6 +24,7 @@
 #include "kernel/imatmul.h"
 #include "runtime.h"
 #include "util.h"
+#include "vcheck.h"
 
 #ifndef SPIKE
 #include "printf.h"
@@ -43,15 +44,10 @@ extern int64_t g[] __attribute__((aligned(32 * NR_LANES), section(".l2")));
 
 // Verify the matrix
 int verify_matrix(int64_t *result, int64_t *gold, size_t R, size_t C) {
-  for (uint64_t i = 0; i < R; ++i) {
-    for (uint64_t j = 0; j < C; ++j) {
-      uint64_t idx = i * C + j;
-      if (result[idx] != gold[idx]) {
-        return (i + j) == 0 ? -1 : idx;
-      }
-    }
-  }
-  return 0;
+  int64_t idx = vcheck_i64(result, gold, R * C);
+  if (idx < 0)
+    return 0;
+  return idx == 0 ? -1 : idx;
 }
 
 int main() {
@@ -0,0 +1,417 @@
+// Copyright 2020 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "imatmul_i8.h"
+
+#define MIN(a, b) ((a) < (b) ? (a) : (b))
+
+void imatmul_i8(int32_t *c, const int8_t *a, const int8_t *b,
+                const unsigned long int M, const unsigned long int N,
+                const unsigned long int P) {
+  // The products are accumulated at twice the SEW of B. With e16 operands and
+  // e32 accumulators, the 8x8 kernel uses LMUL=1 (2 for the accumulators).
+  unsigned long int vlmax_m1;
+  asm volatile("vsetvli %0, %1, e16, m1, ta, ma" : "=r"(vlmax_m1) : "r"(-1));
+
+  if (M <= 4 || P > vlmax_m1) {
+    imatmul_i8_4x4(c, NULL, a, b, NULL, 0, M, N, P);
+  } else {
+    imatmul_i8_8x8(c, NULL, a, b, NULL, 0, M, N, P);
+  }
+}
+
+void imatmul_i8_q(int8_t *q, const int8_t *a, const int8_t *b,
+                  const int32_t *mult, const unsigned long int shift,
+                  const unsigned long int M, const unsigned long int N,
+                  const unsigned long int P) {
+  // Round to the nearest, ties up, when shifting the scaled results
+  asm volatile("csrwi vxrm, 0");
+
+  unsigned long int vlmax_m1;
+  asm volatile("vsetvli %0, %1, e16, m1, ta, ma" : "=r"(vlmax_m1) : "r"(-1));
+
+  if (M <= 4 || P > vlmax_m1) {
+    imatmul_i8_4x4(NULL, q, a, b, mult, shift, M, N, P);
+  } else {
+    imatmul_i8_8x8(NULL, q, a, b, mult, shift, M, N, P);
+  }
+}
+
+// ---------------
+// 4x4
+// ---------------
+
+void imatmul_i8_4x4(int32_t *c, int8_t *q, const int8_t *a, const int8_t *b,
+                    const int32_t *mult, const unsigned long int shift,
+                    const unsigned long int M, const unsigned long int N,
+                    const unsigned long int P) {
+  // We work on 4 rows of the matrix at once
+  const unsigned long int block_size = 4;
+  unsigned long int block_size_p;
+
+  // Set the vector configuration
+  asm volatile("vsetvli %0, %1, e16, m2, ta, ma" : "=r"(block_size_p) : "r"(P));
+
+  // Slice the matrix into a manageable number of columns p_
+  for (unsigned long int p = 0; p < P; p += block_size_p) {
+    // Set the vector length
+    const unsigned long int p_ = MIN(P - p, block_size_p);
+
+    // Find pointers to the submatrices
+    const int8_t *b_ = b + p;
+    int32_t *c_ = c ? c + p : NULL;
+    int8_t *q_ = q ? q + p : NULL;
+    const int32_t *mult_ = mult ? mult + p : NULL;
+
+    asm volatile("vsetvli zero, %0, e16, m2, ta, ma" ::"r"(p_));
+
+    // Iterate over the rows
+    for (unsigned long int m = 0; m < M; m += block_size) {
+      // Find pointer to the submatrices
+      const int8_t *a_ = a + m * N;
+      int32_t *c__ = c_ ? c_ + m * P : NULL;
+      int8_t *q__ = q_ ? q_ + m * P : NULL;
+
+      imatmul_i8_vec_4x4_slice_init();
+      imatmul_i8_vec_4x4(c__, q__, a_, b_, mult_, shift, N, P);
+    }
+  }
+}
+
+void imatmul_i8_vec_4x4_slice_init() {
+  // The accumulators are twice as wide as the operands
+  asm volatile("vsetvli zero, zero, e32, m4, ta, ma");
+  asm volatile("vmv.v.i v0, 0");
+  asm volatile("vmv.v.i v4, 0");
+  asm volatile("vmv.v.i v8, 0");
+  asm volatile("vmv.v.i v12, 0");
+  asm volatile("vsetvli zero, zero, e16, m2, ta, ma");
+}
+
+void imatmul_i8_vec_4x4(int32_t *c, int8_t *q, const int8_t *a, const int8_t *b,
+                        const int32_t *mult, const unsigned long int shift,
+                        const unsigned long int N, const unsigned long int P) {
+  // Temporary variables
+  int64_t t0, t1, t2, t3;
+
+  // Prefetch one row of matrix B, and sign-extend it to 16 bits
+  asm volatile("vle8.v v20, (%0);" ::"r"(b));
+  asm volatile("vsext.vf2 v16, v20");
+  b += P;
+
+  // Compute the multiplication
+  unsigned long int n = 0;
+
+  while (1) {
+#ifdef VCD_DUMP
+    // Start dumping VCD
+    if (n == 8)
+      event_trigger = +1;
+    // Stop dumping VCD
+    if (n == 12)
+      event_trigger = -1;
+#endif
+
+    // Load one column of scalar values
+    t0 = a[0];
+    t1 = a[1 * N];
+    t2 = a[2 * N];
+    t3 = a[3 * N];
+    a++;
+
+    // Load the next row of B
+    if (++n != N) {
+      asm volatile("vle8.v v20, (%0);" ::"r"(b));
+      asm volatile("vsext.vf2 v18, v20");
+      b += P;
+    }
+
+    asm volatile("vwmacc.vx v0, %0, v16" ::"r"(t0));
+    asm volatile("vwmacc.vx v4, %0, v16" ::"r"(t1));
+    asm volatile("vwmacc.vx v8, %0, v16" ::"r"(t2));
+    asm volatile("vwmacc.vx v12, %0, v16" ::"r"(t3));
+
+    if (n == N)
+      break;
+
+    // Load one column of scalar values
+    t0 = a[0];
+    t1 = a[1 * N];
+    t2 = a[2 * N];
+    t3 = a[3 * N];
+    a++;
+
+    // Load the next row of B
+    if (++n != N) {
+      asm volatile("vle8.v v20, (%0);" ::"r"(b));
+      asm volatile("vsext.vf2 v16, v20");
+      b += P;
+    }
+
+    asm volatile("vwmacc.vx v0, %0, v18" ::"r"(t0));
+    asm volatile("vwmacc.vx v4, %0, v18" ::"r"(t1));
+    asm volatile("vwmacc.vx v8, %0, v18" ::"r"(t2));
+    asm volatile("vwmacc.vx v12, %0, v18" ::"r"(t3));
+
+    if (n == N)
+      break;
+  }
+
+  if (q) {
+    // Requantize: scale each column by the Q31 multiplier of its channel,
+    // then round, shift, and saturate to 8 bits
+    asm volatile("vsetvli zero, zero, e32, m4, ta, ma");
+    asm volatile("vle32.v v24, (%0);" ::"r"(mult));
+    asm volatile("vmulh.vv v0, v0, v24");
+    asm volatile("vmulh.vv v4, v4, v24");
+    asm volatile("vmulh.vv v8, v8, v24");
+    asm volatile("vmulh.vv v12, v12, v24");
+    asm volatile("vsetvli zero, zero, e16, m2, ta, ma");
+    asm volatile("vnclip.wx v16, v0, %0" ::"r"(shift));
+    asm volatile("vnclip.wx v18, v4, %0" ::"r"(shift));
+    asm volatile("vnclip.wx v20, v8, %0" ::"r"(shift));
+    asm volatile("vnclip.wx v22, v12, %0" ::"r"(shift));
+    asm volatile("vsetvli zero, zero, e8, m1, ta, ma");
+    asm volatile("vnclip.wi v24, v16, 0");
+    asm volatile("vnclip.wi v25, v18, 0");
+    asm volatile("vnclip.wi v26, v20, 0");
+    asm volatile("vnclip.wi v27, v22, 0");
+    asm volatile("vse8.v v24, (%0);" ::"r"(q));
+    q += P;
+    asm volatile("vse8.v v25, (%0);" ::"r"(q));
+    q += P;
+    asm volatile("vse8.v v26, (%0);" ::"r"(q));
+    q += P;
+    asm volatile("vse8.v v27, (%0);" ::"r"(q));
+  } else {
+    // Store the 32-bit results
+    asm volatile("vsetvli zero, zero, e32, m4, ta, ma");
+    asm volatile("vse32.v v0, (%0);" ::"r"(c));
+    c += P;
+    asm volatile("vse32.v v4, (%0);" ::"r"(c));
+    c += P;
+    asm volatile("vse32.v v8, (%0);" ::"r"(c));
+    c += P;
+    asm volatile("vse32.v v12, (%0);" ::"r"(c));
+  }
+}
+
+// ---------------
+// 8x8
+// ---------------
+
+void imatmul_i8_8x8(int32_t *c, int8_t *q, const int8_t *a, const int8_t *b,
+                    const int32_t *mult, const unsigned long int shift,
+                    const unsigned long int M, const unsigned long int N,
+                    const unsigned long int P) {
+  // We work on 8 rows of the matrix at once
+  const unsigned long int block_size = 8;
+  unsigned long int block_size_p;
+
+  // Set the vector configuration
+  asm volatile("vsetvli %0, %1, e16, m1, ta, ma" : "=r"(block_size_p) : "r"(P));
+
+  // Slice the matrix into a manageable number of columns p_
+  for (unsigned long int p = 0; p < P; p += block_size_p) {
+    // Set the vector length
+    const unsigned long int p_ = MIN(P - p, block_size_p);
+
+    // Find pointers to the submatrices
+    const int8_t *b_ = b + p;
+    int32_t *c_ = c ? c + p : NULL;
+    int8_t *q_ = q ? q + p : NULL;
+    const int32_t *mult_ = mult ? mult + p : NULL;
+
+    asm volatile("vsetvli zero, %0, e16, m1, ta, ma" ::"r"(p_));
+
+    // Iterate over the rows
+    for (unsigned long int m = 0; m < M; m += block_size) {
+      // Find pointer to the submatrices
+      const int8_t *a_ = a + m * N;
+      int32_t *c__ = c_ ? c_ + m * P : NULL;
+      int8_t *q__ = q_ ? q_ + m * P : NULL;
+
+      imatmul_i8_vec_8x8_slice_init();
+      imatmul_i8_vec_8x8(c__, q__, a_, b_, mult_, shift, N, P);
+    }
+  }
+}
+
+void imatmul_i8_vec_8x8_slice_init() {
+  // The accumulators are twice as wide as the operands
+  asm volatile("vsetvli zero, zero, e32, m2, ta, ma");
+  asm volatile("vmv.v.i v0, 0");
+  asm volatile("vmv.v.i v2, 0");
+  asm volatile("vmv.v.i v4, 0");
+  asm volatile("vmv.v.i v6, 0");
+  asm volatile("vmv.v.i v8, 0");
+  asm volatile("vmv.v.i v10, 0");
+  asm volatile("vmv.v.i v12, 0");
+  asm volatile("vmv.v.i v14, 0");
+  asm volatile("vsetvli zero, zero, e16, m1, ta, ma");
+}
+
+void imatmul_i8_vec_8x8(int32_t *c, int8_t *q, const int8_t *a, const int8_t *b,
+                        const int32_t *mult, const unsigned long int shift,
+                        const unsigned long int N, const unsigned long int P) {
+  // Temporary variables
+  int64_t t0, t1, t2, t3, t4, t5, t6, t7;
+
+  // Prefetch one row of matrix B, and sign-extend it to 16 bits
+  asm volatile("vle8.v v18, (%0);" ::"r"(b));
+  asm volatile("vsext.vf2 v16, v18");
+  b += P;
+
+  // Compute the multiplication
+  unsigned long int n = 0;
+
+  while (1) {
+#ifdef VCD_DUMP
+    // Start dumping VCD
+    if (n == 8)
+      event_trigger = +1;
+    // Stop dumping VCD
+    if (n == 12)
+      event_trigger = -1;
+#endif
+
+    // Load one column of scalar values
+    t0 = a[0];
+    t1 = a[1 * N];
+    t2 = a[2 * N];
+    t3 = a[3 * N];
+    t4 = a[4 * N];
+    t5 = a[5 * N];
+    t6 = a[6 * N];
+    t7 = a[7 * N];
+    a++;
+
+    // Load the next row of B
+    if (++n != N) {
+      asm volatile("vle8.v v18, (%0);" ::"r"(b));
+      asm volatile("vsext.vf2 v17, v18");
+      b += P;
+    }
+
+    asm volatile("vwmacc.vx v0, %0, v16" ::"r"(t0));
+    asm volatile("vwmacc.vx v2, %0, v16" ::"r"(t1));
+    asm volatile("vwmacc.vx v4, %0, v16" ::"r"(t2));
+    asm volatile("vwmacc.vx v6, %0, v16" ::"r"(t3));
+    asm volatile("vwmacc.vx v8, %0, v16" ::"r"(t4));
+    asm volatile("vwmacc.vx v10, %0, v16" ::"r"(t5));
+    asm volatile("vwmacc.vx v12, %0, v16" ::"r"(t6));
+    asm volatile("vwmacc.vx v14, %0, v16" ::"r"(t7));
+
+    if (n == N)
+      break;
+
+    // Load one column of scalar values
+    t0 = a[0];
+    t1 = a[1 * N];
+    t2 = a[2 * N];
+    t3 = a[3 * N];
+    t4 = a[4 * N];
+    t5 = a[5 * N];
+    t6 = a[6 * N];
+    t7 = a[7 * N];
+    a++;
+
+    // Load the next row of B
+    if (++n != N) {
+      asm volatile("vle8.v v18, (%0);" ::"r"(b));
+      asm volatile("vsext.vf2 v16, v18");
+      b += P;
+    }
+
+    asm volatile("vwmacc.vx v0, %0, v17" ::"r"(t0));
+    asm volatile("vwmacc.vx v2, %0, v17" ::"r"(t1));
+    asm volatile("vwmacc.vx v4, %0, v17" ::"r"(t2));
+    asm volatile("vwmacc.vx v6, %0, v17" ::"r"(t3));
+    asm volatile("vwmacc.vx v8, %0, v17" ::"r"(t4));
+    asm volatile("vwmacc.vx v10, %0, v17" ::"r"(t5));
+    asm volatile("vwmacc.vx v12, %0, v17" ::"r"(t6));
+    asm volatile("vwmacc.vx v14, %0, v17" ::"r"(t7));
+
+    if (n == N)
+      break;
+  }
+
+  if (q) {
+    // Requantize: scale each column by the Q31 multiplier of its channel,
+    // then round, shift, and saturate to 8 bits
+    asm volatile("vsetvli zero, zero, e32, m2, ta, ma");
+    asm volatile("vle32.v v20, (%0);" ::"r"(mult));
+    asm volatile("vmulh.vv v0, v0, v20");
+    asm volatile("vmulh.vv v2, v2, v20");
+    asm volatile("vmulh.vv v4, v4, v20");
+    asm volatile("vmulh.vv v6, v6, v20");
+    asm volatile("vmulh.vv v8, v8, v20");
+    asm volatile("vmulh.vv v10, v10, v20");
+    asm volatile("vmulh.vv v12, v12, v20");
+    asm volatile("vmulh.vv v14, v14, v20");
+    asm volatile("vsetvli zero, zero, e16, m1, ta, ma");
+    asm volatile("vnclip.wx v24, v0, %0" ::"r"(shift));
+    asm volatile("vnclip.wx v25, v2, %0" ::"r"(shift));
+    asm volatile("vnclip.wx v26, v4, %0" ::"r"(shift));
+    asm volatile("vnclip.wx v27, v6, %0" ::"r"(shift));
+    asm volatile("vnclip.wx v28, v8, %0" ::"r"(shift));
+    asm volatile("vnclip.wx v29, v10, %0" ::"r"(shift));
+    asm volatile("vnclip.wx v30, v12, %0" ::"r"(shift));
+    asm volatile("vnclip.wx v31, v14, %0" ::"r"(shift));
+    asm volatile("vsetvli zero, zero, e8, mf2, ta, ma");
+    asm volatile("vnclip.wi v16, v24, 0");
+    asm volatile("vnclip.wi v17, v25, 0");
+    asm volatile("vnclip.wi v18, v26, 0");
+    asm volatile("vnclip.wi v19, v27, 0");
+    asm volatile("vnclip.wi v20, v28, 0");
+    asm volatile("vnclip.wi v21, v29, 0");
+    asm volatile("vnclip.wi v22, v30, 0");
+    asm volatile("vnclip.wi v23, v31, 0");
+    asm volatile("vse8.v v16, (%0);" ::"r"(q));
+    q += P;
+    asm volatile("vse8.v v17, (%0);" ::"r"(q));
+    q += P;
+    asm volatile("vse8.v v18, (%0);" ::"r"(q));
+    q += P;
+    asm volatile("vse8.v v19, (%0);" ::"r"(q));
+    q += P;
+    asm volatile("vse8.v v20, (%0);" ::"r"(q));
+    q += P;
+    asm volatile("vse8.v v21, (%0);" ::"r"(q));
+    q += P;
+    asm volatile("vse8.v v22, (%0);" ::"r"(q));
+    q += P;
+    asm volatile("vse8.v v23, (%0);" ::"r"(q));
+  } else {
+    // Store the 32-bit results
+    asm volatile("vsetvli zero, zero, e32, m2, ta, ma");
+    asm volatile("vse32.v v0, (%0);" ::"r"(c));
+    c += P;
+    asm volatile("vse32.v v2, (%0);" ::"r"(c));
+    c += P;
+    asm volatile("vse32.v v4, (%0);" ::"r"(c));
+    c += P;
+    asm volatile("vse32.v v6, (%0);" ::"r"(c));
+    c += P;
+    asm volatile("vse32.v v8, (%0);" ::"r"(c));
+    c += P;
+    asm volatile("vse32.v v10, (%0);" ::"r"(c));
+    c += P;
+    asm volatile("vse32.v v12, (%0);" ::"r"(c));
+    c += P;
+    asm volatile("vse32.v v14, (%0);" ::"r"(c));
+  }
+}
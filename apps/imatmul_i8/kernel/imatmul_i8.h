@@ -0,0 +1,54 @@
+// Copyright 2020 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef IMATMUL_I8_H
+#define IMATMUL_I8_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// C = AB with A=[MxN], B=[NxP] of int8_t, and C=[MxP] of int32_t
+void imatmul_i8(int32_t *c, const int8_t *a, const int8_t *b,
+                const unsigned long int m, const unsigned long int n,
+                const unsigned long int p);
+// Q = AB requantized to int8_t, with the Q31 multiplier of each column:
+// q[i][j] = sat8(rnu(((c[i][j] * mult[j]) >> 32) >> shift))
+void imatmul_i8_q(int8_t *q, const int8_t *a, const int8_t *b,
+                  const int32_t *mult, const unsigned long int shift,
+                  const unsigned long int m, const unsigned long int n,
+                  const unsigned long int p);
+
+void imatmul_i8_4x4(int32_t *c, int8_t *q, const int8_t *a, const int8_t *b,
+                    const int32_t *mult, const unsigned long int shift,
+                    const unsigned long int m, const unsigned long int n,
+                    const unsigned long int p);
+void imatmul_i8_vec_4x4_slice_init();
+void imatmul_i8_vec_4x4(int32_t *c, int8_t *q, const int8_t *a, const int8_t *b,
+                        const int32_t *mult, const unsigned long int shift,
+                        const unsigned long int n, const unsigned long int p);
+
+void imatmul_i8_8x8(int32_t *c, int8_t *q, const int8_t *a, const int8_t *b,
+                    const int32_t *mult, const unsigned long int shift,
+                    const unsigned long int m, const unsigned long int n,
+                    const unsigned long int p);
+void imatmul_i8_vec_8x8_slice_init();
+void imatmul_i8_vec_8x8(int32_t *c, int8_t *q, const int8_t *a, const int8_t *b,
+                        const int32_t *mult, const unsigned long int shift,
+                        const unsigned long int n, const unsigned long int p);
+
+extern int64_t event_trigger;
+
+#endif
@@ -0,0 +1,80 @@
+#!/usr/bin/env python3
+# Copyright 2022 ETH Zurich and University of Bologna.
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+# Author: Matteo Perotti
+
+# C = AB with A=[MxN], B=[NxP] of int8, C=[MxP] of int32
+# Q = C requantized to int8 with a Q31 multiplier per column and a common shift
+# arg1, arg2, arg3: M, N, P
+
+import random as rand
+import numpy as np
+import os
+import sys
+
+sys.path.insert(0, os.path.join(os.path.dirname(__file__), '../../common/script'))
+from data_emit import emit
+
+############
+## SCRIPT ##
+############
+
+if len(sys.argv) == 4:
+  M = int(sys.argv[1])
+  N = int(sys.argv[2])
+  P = int(sys.argv[3])
+else:
+  print("Error. Give me three argument: M, N, P.")
+  print("C = AB with A=[MxN], B=[NxP], C=[MxP]")
+  sys.exit()
+
+dtype = np.int8
+
+UPPER_LIMIT = 127
+LOWER_LIMIT = -128
+
+# Matrices and results
+A = np.random.randint(LOWER_LIMIT, UPPER_LIMIT + 1, size=(M, N)).astype(dtype)
+B = np.random.randint(LOWER_LIMIT, UPPER_LIMIT + 1, size=(N, P)).astype(dtype)
+C = np.zeros([M, P], dtype=np.int32)
+Q = np.zeros([M, P], dtype=np.int8)
+# Golden result matrix, wrapped to 32 bits like the accumulators
+G = np.matmul(A.astype(np.int64), B.astype(np.int64)).astype(np.int32)
+
+# Requantization: vmulh by the multiplier of the column, then vnclip with
+# round-to-nearest-up to 16 and 8 bits
+MULT = np.random.randint(2**30, 2**31, size=P).astype(np.int32)
+H = (G.astype(np.int64) * MULT.astype(np.int64)) >> 32
+# Shift the largest result into the int8 range
+SHIFT = max(0, int(np.abs(H).max()).bit_length() - 7)
+if SHIFT > 0:
+  H = (H + (1 << (SHIFT - 1))) >> SHIFT
+GQ = np.clip(H, -128, 127).astype(np.int8)
+
+# Create the file
+print(".section .data,\"aw\",@progbits")
+emit("M", np.array(M, dtype=np.uint64))
+emit("N", np.array(N, dtype=np.uint64))
+emit("P", np.array(P, dtype=np.uint64))
+emit("a", A, 'NR_LANES*4')
+emit("b", B, 'NR_LANES*4')
+emit("c", C, 'NR_LANES*4')
+emit("g", G, 'NR_LANES*4')
+emit("mult", MULT, 'NR_LANES*4')
+emit("shift", np.array(SHIFT, dtype=np.uint64))
+emit("q", Q, 'NR_LANES*4')
+emit("gq", GQ, 'NR_LANES*4')
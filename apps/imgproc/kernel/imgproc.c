@@ -0,0 +1,287 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "imgproc.h"
+
+// The 8-bit inputs are LMUL=1 groups, widened to LMUL=2 groups of 16 bits
+
+static inline vuint8m1_t imgproc_luma(vuint8m1_t r, vuint8m1_t g,
+                                      vuint8m1_t b, size_t vl) {
+  vuint16m2_t acc = vwmulu_vx_u16m2(r, 77, vl);
+  acc = vwmaccu_vx_u16m2(acc, 150, g, vl);
+  acc = vwmaccu_vx_u16m2(acc, 29, b, vl);
+  return vnclipu_wx_u8m1(acc, 8, vl);
+}
+
+// (128 p - c1 q - c2 s) / 256 + 128, with c1 + c2 = 128: the offset of
+// 128 * 256 keeps the unsigned sums in [128, 65408]
+static inline vuint8m1_t imgproc_chroma(vuint8m1_t p, vuint8m1_t q,
+                                        vuint8m1_t s, uint8_t c1, uint8_t c2,
+                                        size_t vl) {
+  vuint16m2_t acc = vadd_vx_u16m2(vwmulu_vx_u16m2(p, 128, vl), 32768, vl);
+  vuint16m2_t sub = vwmulu_vx_u16m2(q, c1, vl);
+  sub = vwmaccu_vx_u16m2(sub, c2, s, vl);
+  return vnclipu_wx_u8m1(vsub_vv_u16m2(acc, sub, vl), 8, vl);
+}
+
+void rgb_to_yuv_u8(uint8_t *y, uint8_t *u, uint8_t *v, const uint8_t *rgb,
+                   uint64_t n) {
+  // Round to the nearest, ties up, when narrowing
+  asm volatile("csrwi vxrm, 0");
+
+  vuint8m1_t r, g, b;
+  size_t vl;
+
+  for (uint64_t i = 0; i < n; i += vl) {
+    vl = vsetvl_e8m1(n - i);
+    vlseg3e8_v_u8m1(&r, &g, &b, rgb + 3 * i, vl);
+    vse8_v_u8m1(y + i, imgproc_luma(r, g, b, vl), vl);
+    vse8_v_u8m1(u + i, imgproc_chroma(b, r, g, 43, 85, vl), vl);
+    vse8_v_u8m1(v + i, imgproc_chroma(r, g, b, 107, 21, vl), vl);
+  }
+}
+
+void rgb_to_y_u8(uint8_t *y, const uint8_t *rgb, uint64_t n) {
+  asm volatile("csrwi vxrm, 0");
+
+  vuint8m1_t r, g, b;
+  size_t vl;
+
+  for (uint64_t i = 0; i < n; i += vl) {
+    vl = vsetvl_e8m1(n - i);
+    vlseg3e8_v_u8m1(&r, &g, &b, rgb + 3 * i, vl);
+    vse8_v_u8m1(y + i, imgproc_luma(r, g, b, vl), vl);
+  }
+}
+
+// 64 Y + bias, as a signed 16-bit accumulator for the chroma terms
+static inline vint16m2_t imgproc_y64(vuint8m1_t y, int16_t bias, size_t vl) {
+  return vadd_vx_i16m2(vreinterpret_v_u16m2_i16m2(vwmulu_vx_u16m2(y, 64, vl)),
+                       bias, vl);
+}
+
+// The negative values are clamped to 0 before vnclipu, which saturates the
+// others to 255
+static inline vuint8m1_t imgproc_sat_q6(vint16m2_t t, size_t vl) {
+  return vnclipu_wx_u8m1(vreinterpret_v_i16m2_u16m2(vmax_vx_i16m2(t, 0, vl)), 6,
+                         vl);
+}
+
+// The offsets of the chroma samples are folded into the biases, so that
+// c (U - 128) is a widening multiply-add of the signed coefficient and of the
+// unsigned sample (vwmaccsu), and the sums are in [-11520, 30671]
+void yuv_to_rgb_u8(uint8_t *rgb, const uint8_t *y, const uint8_t *u,
+                   const uint8_t *v, uint64_t n) {
+  asm volatile("csrwi vxrm, 0");
+
+  size_t vl;
+
+  for (uint64_t i = 0; i < n; i += vl) {
+    vl = vsetvl_e8m1(n - i);
+    vuint8m1_t y_v = vle8_v_u8m1(y + i, vl);
+    vuint8m1_t u_v = vle8_v_u8m1(u + i, vl);
+    vuint8m1_t v_v = vle8_v_u8m1(v + i, vl);
+
+    vint16m2_t r = vwmaccsu_vx_i16m2(imgproc_y64(y_v, -90 * 128, vl), 90, v_v,
+                                     vl);
+    vint16m2_t g = vwmaccsu_vx_i16m2(imgproc_y64(y_v, 68 * 128, vl), -22, u_v,
+                                     vl);
+    g = vwmaccsu_vx_i16m2(g, -46, v_v, vl);
+    vint16m2_t b = vwmaccsu_vx_i16m2(imgproc_y64(y_v, -113 * 128, vl), 113,
+                                     u_v, vl);
+
+    vsseg3e8_v_u8m1(rgb + 3 * i, imgproc_sat_q6(r, vl), imgproc_sat_q6(g, vl),
+                    imgproc_sat_q6(b, vl), vl);
+  }
+}
+
+// Horizontal taps [1 4 6 4 1] of the samples t0 to t4, each one slid down by
+// one from the previous one. The sums are at most 16 * 255.
+static inline vuint16m2_t blur5_taps(vuint8m1_t t0, vuint8m1_t t1,
+                                     vuint8m1_t t2, vuint8m1_t t3,
+                                     vuint8m1_t t4, size_t vl) {
+  vuint16m2_t acc = vwaddu_vv_u16m2(t0, t4, vl);
+  acc = vwmaccu_vx_u16m2(acc, 4, t1, vl);
+  acc = vwmaccu_vx_u16m2(acc, 6, t2, vl);
+  return vwmaccu_vx_u16m2(acc, 4, t3, vl);
+}
+
+// Vertical taps of five rows of horizontal sums, at most 256 * 255: the
+// separable sums are not rounded before the last narrowing
+static inline vuint8m1_t blur5_vert(vuint16m2_t h0, vuint16m2_t h1,
+                                    vuint16m2_t h2, vuint16m2_t h3,
+                                    vuint16m2_t h4, size_t vl) {
+  vuint16m2_t acc = vadd_vv_u16m2(h0, h4, vl);
+  acc = vmacc_vx_u16m2(acc, 4, h1, vl);
+  acc = vmacc_vx_u16m2(acc, 6, h2, vl);
+  acc = vmacc_vx_u16m2(acc, 4, h3, vl);
+  return vnclipu_wx_u8m1(acc, 8, vl);
+}
+
+// The four samples after the strip enter the taps with vslide1down, as in
+// fconv2d
+static inline vuint16m2_t blur5_row(const uint8_t *s, size_t vl) {
+  vuint8m1_t t0 = vle8_v_u8m1(s, vl);
+  vuint8m1_t t1 = vslide1down_vx_u8m1(t0, s[vl], vl);
+  vuint8m1_t t2 = vslide1down_vx_u8m1(t1, s[vl + 1], vl);
+  vuint8m1_t t3 = vslide1down_vx_u8m1(t2, s[vl + 2], vl);
+  vuint8m1_t t4 = vslide1down_vx_u8m1(t3, s[vl + 3], vl);
+  return blur5_taps(t0, t1, t2, t3, t4, vl);
+}
+
+// Strips of columns, and a window of the horizontal sums of five rows in the
+// VRF: every input row is loaded and filtered horizontally once
+void blur5_u8(uint8_t *dst, const uint8_t *src, uint64_t rows, uint64_t cols) {
+  asm volatile("csrwi vxrm, 0");
+
+  const uint64_t dst_cols = cols - 4;
+  size_t vl;
+
+  for (uint64_t c = 0; c < dst_cols; c += vl) {
+    vl = vsetvl_e8m1(dst_cols - c);
+    const uint8_t *s = src + c;
+
+    vuint16m2_t h0 = blur5_row(s, vl);
+    vuint16m2_t h1 = blur5_row(s + cols, vl);
+    vuint16m2_t h2 = blur5_row(s + 2 * cols, vl);
+    vuint16m2_t h3 = blur5_row(s + 3 * cols, vl);
+    for (uint64_t r = 4; r < rows; ++r) {
+      vuint16m2_t h4 = blur5_row(s + r * cols, vl);
+      vse8_v_u8m1(dst + (r - 4) * dst_cols + c,
+                  blur5_vert(h0, h1, h2, h3, h4, vl), vl);
+      h0 = h1;
+      h1 = h2;
+      h2 = h3;
+      h3 = h4;
+    }
+  }
+}
+
+// Center of the output sample i in Q7 source coordinates, clamped to the
+// samples of the image
+static void resize_coord(uint64_t i, uint64_t src, uint64_t dst, uint16_t *ofs,
+                         uint8_t *w) {
+  int64_t f = (int64_t)((2 * i + 1) * src * 128 / (2 * dst)) - 64;
+  if (f < 0)
+    f = 0;
+  if ((uint64_t)(f >> 7) >= src - 1) {
+    *ofs = src - 2;
+    *w = 128;
+  } else {
+    *ofs = f >> 7;
+    *w = f & 127;
+  }
+}
+
+void resize_init(uint16_t *ofs, uint8_t *w, uint64_t src, uint64_t dst) {
+  for (uint64_t i = 0; i < dst; ++i)
+    resize_coord(i, src, dst, &ofs[i], &w[i]);
+}
+
+// The columns are the outer loop: the offsets and the weights of a strip stay
+// in the VRF for all the rows. The two samples of each row are gathered with
+// vluxei16, and interpolated in 16 bits (at most 128 * 255), then the two rows
+// in 32 bits, and the result is rounded once.
+void resize_u8(uint8_t *dst, const uint8_t *src, uint64_t src_rows,
+               uint64_t src_cols, uint64_t dst_rows, uint64_t dst_cols,
+               const uint16_t *x_ofs, const uint8_t *x_w) {
+  asm volatile("csrwi vxrm, 0");
+
+  size_t vl;
+
+  for (uint64_t c = 0; c < dst_cols; c += vl) {
+    vl = vsetvl_e8m1(dst_cols - c);
+    vuint16m2_t idx = vle16_v_u16m2(x_ofs + c, vl);
+    vuint8m1_t w = vle8_v_u8m1(x_w + c, vl);
+    vuint8m1_t wi = vrsub_vx_u8m1(w, 128, vl);
+
+    for (uint64_t r = 0; r < dst_rows; ++r) {
+      uint16_t y0;
+      uint8_t wy;
+      resize_coord(r, src_rows, dst_rows, &y0, &wy);
+      const uint8_t *s0 = src + y0 * src_cols;
+      const uint8_t *s1 = s0 + src_cols;
+
+      vuint16m2_t t0 = vwmulu_vv_u16m2(vluxei16_v_u8m1(s0, idx, vl), wi, vl);
+      t0 = vwmaccu_vv_u16m2(t0, w, vluxei16_v_u8m1(s0 + 1, idx, vl), vl);
+      vuint16m2_t t1 = vwmulu_vv_u16m2(vluxei16_v_u8m1(s1, idx, vl), wi, vl);
+      t1 = vwmaccu_vv_u16m2(t1, w, vluxei16_v_u8m1(s1 + 1, idx, vl), vl);
+
+      vuint32m4_t acc = vwmulu_vx_u32m4(t0, 128 - wy, vl);
+      acc = vwmaccu_vx_u32m4(acc, wy, t1, vl);
+      vse8_v_u8m1(dst + r * dst_cols + c,
+                  vnclipu_wx_u8m1(vnclipu_wx_u16m2(acc, 14, vl), 0, vl), vl);
+    }
+  }
+}
+
+// Luma of a strip of an RGB row, and its horizontal taps: the strip of luma
+// has 4 more samples than the vl ones of the taps, so that these are slid down
+// within the VRF
+static inline vuint16m2_t imgproc_pipeline_row(const uint8_t *rgb, size_t vl) {
+  vuint8m1_t r, g, b;
+  vlseg3e8_v_u8m1(&r, &g, &b, rgb, vl + 4);
+  vuint8m1_t t0 = imgproc_luma(r, g, b, vl + 4);
+  return blur5_taps(t0, vslidedown_vx_u8m1(t0, t0, 1, vl),
+                    vslidedown_vx_u8m1(t0, t0, 2, vl),
+                    vslidedown_vx_u8m1(t0, t0, 3, vl),
+                    vslidedown_vx_u8m1(t0, t0, 4, vl), vl);
+}
+
+// With half-pixel centers, the 2x bilinear downscale of resize_u8 has weights
+// 1/2 in both directions, i.e., it is the rounded mean of 2x2 blocks. The even
+// and odd columns of the sums of two blurred rows are split with vnsrl, on
+// the pairs of 16-bit sums seen as 32-bit elements.
+void imgproc_pipeline_u8(uint8_t *dst, const uint8_t *rgb, uint64_t rows,
+                         uint64_t cols) {
+  asm volatile("csrwi vxrm, 0");
+
+  const uint64_t blur_cols = cols - 4;
+  const uint64_t dst_cols = blur_cols / 2;
+  size_t vl;
+
+  for (uint64_t c = 0; c < blur_cols; c += vl) {
+    // An even number of columns, and 4 more for the taps
+    vl = (vsetvl_e8m1(blur_cols - c + 4) - 4) & ~(size_t)1;
+    const uint8_t *s = rgb + 3 * c;
+
+    vuint16m2_t h0 = imgproc_pipeline_row(s, vl);
+    vuint16m2_t h1 = imgproc_pipeline_row(s + 3 * cols, vl);
+    vuint16m2_t h2 = imgproc_pipeline_row(s + 6 * cols, vl);
+    vuint16m2_t h3 = imgproc_pipeline_row(s + 9 * cols, vl);
+    vuint8m1_t even_row = vmv_v_x_u8m1(0, vl);
+    for (uint64_t r = 4; r < rows; ++r) {
+      vuint16m2_t h4 = imgproc_pipeline_row(s + 3 * r * cols, vl);
+      vuint8m1_t row = blur5_vert(h0, h1, h2, h3, h4, vl);
+      h0 = h1;
+      h1 = h2;
+      h2 = h3;
+      h3 = h4;
+
+      if (!(r & 1)) {
+        even_row = row;
+        continue;
+      }
+
+      vuint32m2_t pairs =
+          vreinterpret_v_u16m2_u32m2(vwaddu_vv_u16m2(even_row, row, vl));
+      vuint16m1_t sum = vadd_vv_u16m1(vnsrl_wx_u16m1(pairs, 0, vl / 2),
+                                      vnsrl_wx_u16m1(pairs, 16, vl / 2), vl / 2);
+      vse8_v_u8mf2(dst + (r - 4) / 2 * dst_cols + c / 2,
+                   vnclipu_wx_u8mf2(sum, 2, vl / 2), vl / 2);
+    }
+  }
+}
@@ -0,0 +1,73 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// 8-bit kernels of an image pre-processing pipeline, before a CNN:
+//   rgb_to_yuv_u8: Y = rnu((77 R + 150 G + 29 B) / 256),
+//                  U = rnu((128 B - 43 R - 85 G) / 256) + 128,
+//                  V = rnu((128 R - 107 G - 21 B) / 256) + 128
+//   yuv_to_rgb_u8: R = sat(rnu((64 Y + 90 (V - 128)) / 64)),
+//                  G = sat(rnu((64 Y - 22 (U - 128) - 46 (V - 128)) / 64)),
+//                  B = sat(rnu((64 Y + 113 (U - 128)) / 64))
+//   blur5_u8:      5x5 Gaussian blur [1 4 6 4 1] x [1 4 6 4 1] / 256
+//   resize_u8:     bilinear resize, with Q7 weights and half-pixel centers
+//   median<K>x<K>: median of the K x K windows (K = 3, 5), in uint8_t,
+//                  uint16_t, and float (not NaN)
+// The full-range BT.601 (JPEG) coefficients are in Q8 and Q6. rnu rounds to
+// the nearest, ties up (vxrm = 0), and sat saturates to uint8_t with vnclipu.
+// The RGB images are interleaved, and accessed with segment loads and stores.
+// The other ones are single-channel and row-major. The blur has no border:
+// a rows x cols image is blurred into a (rows - 4) x (cols - 4) one, and
+// filtered by a K x K median into a (rows - K + 1) x (cols - K + 1) one.
+
+#ifndef _IMGPROC_H_
+#define _IMGPROC_H_
+
+#include <stdint.h>
+
+#include "riscv_vector.h"
+
+void rgb_to_yuv_u8(uint8_t *y, uint8_t *u, uint8_t *v, const uint8_t *rgb,
+                   uint64_t n);
+void rgb_to_y_u8(uint8_t *y, const uint8_t *rgb, uint64_t n);
+void yuv_to_rgb_u8(uint8_t *rgb, const uint8_t *y, const uint8_t *u,
+                   const uint8_t *v, uint64_t n);
+
+void blur5_u8(uint8_t *dst, const uint8_t *src, uint64_t rows, uint64_t cols);
+
+// Offset of the first of the two source samples of each of the dst output
+// columns of a resize from src ones, and Q7 weight of the second one
+void resize_init(uint16_t *ofs, uint8_t *w, uint64_t src, uint64_t dst);
+void resize_u8(uint8_t *dst, const uint8_t *src, uint64_t src_rows,
+               uint64_t src_cols, uint64_t dst_rows, uint64_t dst_cols,
+               const uint16_t *x_ofs, const uint8_t *x_w);
+
+#define median_dec_gen(sfx, T)                                                 \
+  void median3x3_##sfx(T *dst, const T *src, uint64_t rows, uint64_t cols);    \
+  void median5x5_##sfx(T *dst, const T *src, uint64_t rows, uint64_t cols);    \
+  void median_##sfx##_scalar(T *dst, const T *src, uint64_t rows,              \
+                             uint64_t cols, uint64_t k);
+
+median_dec_gen(u8, uint8_t);
+median_dec_gen(u16, uint16_t);
+median_dec_gen(f32, float);
+
+// rgb_to_y_u8, blur5_u8, and a 2x bilinear downscale of an interleaved
+// rows x cols RGB image, fused on strips of columns: the luma and the blurred
+// rows never leave the VRF. rows and cols must be even.
+void imgproc_pipeline_u8(uint8_t *dst, const uint8_t *rgb, uint64_t rows,
+                         uint64_t cols);
+
+#endif
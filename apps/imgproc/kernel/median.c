@@ -0,0 +1,86 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "imgproc.h"
+#include "median_net.h"
+
+// One output row of a strip at a time: the K rows of the strip are loaded
+// K - 1 samples wider, and their columns sorted element-wise, once for the
+// K windows of each sample. The windows are the sorted columns slid down by
+// 0 to K - 1, and the selection networks of median_net.h, generated by
+// scripts/median_net.py, find their medians with vmin/vmax on LMUL=1 groups.
+#define median_def_gen(K, sfx, T, VT, sew, MIN, MAX, LOAD, STORE, SLIDE)      \
+  void median##K##x##K##_##sfx(T *dst, const T *src, uint64_t rows,            \
+                               uint64_t cols) {                                \
+    const uint64_t dst_rows = rows - (K - 1);                                  \
+    const uint64_t dst_cols = cols - (K - 1);                                  \
+    size_t vl;                                                                 \
+                                                                               \
+    for (uint64_t c = 0; c < dst_cols; c += vl) {                              \
+      const size_t vlw = vsetvl_e##sew##m1(dst_cols - c + K - 1);              \
+      vl = vlw - (K - 1);                                                      \
+      for (uint64_t r = 0; r < dst_rows; ++r) {                                \
+        MEDIAN##K##_LOAD(VT, LOAD, src + r * cols + c, cols, vlw)              \
+        MEDIAN##K##_COLS(VT, MIN, MAX, vlw)                                    \
+        MEDIAN##K##_NET(VT, MIN, MAX, SLIDE, vl)                               \
+        STORE(dst + r * dst_cols + c, MEDIAN##K##_OUT, vl);                    \
+      }                                                                        \
+    }                                                                          \
+  }
+
+median_def_gen(3, u8, uint8_t, vuint8m1_t, 8, vminu_vv_u8m1, vmaxu_vv_u8m1,
+               vle8_v_u8m1, vse8_v_u8m1, vslidedown_vx_u8m1);
+median_def_gen(5, u8, uint8_t, vuint8m1_t, 8, vminu_vv_u8m1, vmaxu_vv_u8m1,
+               vle8_v_u8m1, vse8_v_u8m1, vslidedown_vx_u8m1);
+median_def_gen(3, u16, uint16_t, vuint16m1_t, 16, vminu_vv_u16m1,
+               vmaxu_vv_u16m1, vle16_v_u16m1, vse16_v_u16m1,
+               vslidedown_vx_u16m1);
+median_def_gen(5, u16, uint16_t, vuint16m1_t, 16, vminu_vv_u16m1,
+               vmaxu_vv_u16m1, vle16_v_u16m1, vse16_v_u16m1,
+               vslidedown_vx_u16m1);
+median_def_gen(3, f32, float, vfloat32m1_t, 32, vfmin_vv_f32m1, vfmax_vv_f32m1,
+               vle32_v_f32m1, vse32_v_f32m1, vslidedown_vx_f32m1);
+median_def_gen(5, f32, float, vfloat32m1_t, 32, vfmin_vv_f32m1, vfmax_vv_f32m1,
+               vle32_v_f32m1, vse32_v_f32m1, vslidedown_vx_f32m1);
+
+// Scalar references of the K x K median filters, with an insertion sort of
+// each window
+#define median_scalar_def_gen(sfx, T)                                          \
+  void median_##sfx##_scalar(T *dst, const T *src, uint64_t rows,              \
+                             uint64_t cols, uint64_t k) {                      \
+    const uint64_t dst_cols = cols - (k - 1);                                  \
+    T win[25];                                                                 \
+                                                                               \
+    for (uint64_t r = 0; r < rows - (k - 1); ++r) {                            \
+      for (uint64_t c = 0; c < dst_cols; ++c) {                                \
+        uint64_t n = 0;                                                        \
+        for (uint64_t i = 0; i < k; ++i) {                                     \
+          for (uint64_t j = 0; j < k; ++j) {                                   \
+            T x = src[(r + i) * cols + c + j];                                 \
+            uint64_t p = n++;                                                  \
+            for (; p > 0 && win[p - 1] > x; --p)                               \
+              win[p] = win[p - 1];                                             \
+            win[p] = x;                                                        \
+          }                                                                    \
+        }                                                                      \
+        dst[r * dst_cols + c] = win[n / 2];                                    \
+      }                                                                        \
+    }                                                                          \
+  }
+
+median_scalar_def_gen(u8, uint8_t);
+median_scalar_def_gen(u16, uint16_t);
+median_scalar_def_gen(f32, float);
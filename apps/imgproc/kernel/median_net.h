@@ -0,0 +1,180 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Generated by scripts/median_net.py. Do not edit.
+// Median selection networks of the K x K windows, on the rows c0 to c<K-1>,
+// with the min and max functions MIN and MAX of the vector type VT.
+
+#ifndef _MEDIAN_NET_H_
+#define _MEDIAN_NET_H_
+
+// Compare-exchange, and its min or max output alone
+#define MED_CE(VT, MIN, MAX, a, b, VL)                                         \
+  do {                                                                         \
+    VT t_ = MIN(a, b, VL);                                                     \
+    b = MAX(a, b, VL);                                                         \
+    a = t_;                                                                    \
+  } while (0)
+#define MED_LO(MIN, a, b, VL) a = MIN(a, b, VL)
+#define MED_HI(MAX, a, b, VL) b = MAX(a, b, VL)
+
+// 3x3: 6 min/max on the columns, 6 slides, and 14 min/max on the windows
+#define MEDIAN3_LOAD(VT, LOAD, s, stride, VL)                                  \
+  VT c0 = LOAD(s, VL);                                                         \
+  VT c1 = LOAD((s) + 1 * (stride), VL);                                        \
+  VT c2 = LOAD((s) + 2 * (stride), VL);
+#define MEDIAN3_COLS(VT, MIN, MAX, VL)                                         \
+  MED_CE(VT, MIN, MAX, c1, c2, VL);                                            \
+  MED_CE(VT, MIN, MAX, c0, c2, VL);                                            \
+  MED_CE(VT, MIN, MAX, c0, c1, VL);
+#define MEDIAN3_NET(VT, MIN, MAX, SLIDE, VL)                                   \
+  VT w1_0 = SLIDE(c0, c0, 1, VL);                                              \
+  VT w2_0 = SLIDE(c0, c0, 2, VL);                                              \
+  MED_HI(MAX, w1_0, w2_0, VL);                                                 \
+  VT w0_0 = c0;                                                                \
+  MED_HI(MAX, w0_0, w2_0, VL);                                                 \
+  VT w1_1 = SLIDE(c1, c1, 1, VL);                                              \
+  VT w2_1 = SLIDE(c1, c1, 2, VL);                                              \
+  MED_CE(VT, MIN, MAX, w1_1, w2_1, VL);                                        \
+  VT w0_1 = c1;                                                                \
+  MED_LO(MIN, w0_1, w2_1, VL);                                                 \
+  MED_HI(MAX, w0_1, w1_1, VL);                                                 \
+  VT w1_2 = SLIDE(c2, c2, 1, VL);                                              \
+  VT w2_2 = SLIDE(c2, c2, 2, VL);                                              \
+  MED_CE(VT, MIN, MAX, w1_2, w2_2, VL);                                        \
+  VT w0_2 = c2;                                                                \
+  MED_LO(MIN, w0_2, w2_2, VL);                                                 \
+  MED_LO(MIN, w0_2, w1_2, VL);                                                 \
+  MED_CE(VT, MIN, MAX, w0_2, w2_0, VL);                                        \
+  MED_HI(MAX, w0_2, w1_1, VL);                                                 \
+  MED_LO(MIN, w2_0, w1_1, VL);
+#define MEDIAN3_OUT w2_0
+
+// 5x5: 18 min/max on the columns, 20 slides, and 114 min/max on the windows
+#define MEDIAN5_LOAD(VT, LOAD, s, stride, VL)                                  \
+  VT c0 = LOAD(s, VL);                                                         \
+  VT c1 = LOAD((s) + 1 * (stride), VL);                                        \
+  VT c2 = LOAD((s) + 2 * (stride), VL);                                        \
+  VT c3 = LOAD((s) + 3 * (stride), VL);                                        \
+  VT c4 = LOAD((s) + 4 * (stride), VL);
+#define MEDIAN5_COLS(VT, MIN, MAX, VL)                                         \
+  MED_CE(VT, MIN, MAX, c0, c1, VL);                                            \
+  MED_CE(VT, MIN, MAX, c3, c4, VL);                                            \
+  MED_CE(VT, MIN, MAX, c2, c4, VL);                                            \
+  MED_CE(VT, MIN, MAX, c2, c3, VL);                                            \
+  MED_CE(VT, MIN, MAX, c0, c3, VL);                                            \
+  MED_CE(VT, MIN, MAX, c0, c2, VL);                                            \
+  MED_CE(VT, MIN, MAX, c1, c4, VL);                                            \
+  MED_CE(VT, MIN, MAX, c1, c3, VL);                                            \
+  MED_CE(VT, MIN, MAX, c1, c2, VL);
+#define MEDIAN5_NET(VT, MIN, MAX, SLIDE, VL)                                   \
+  VT w0_0 = c0;                                                                \
+  VT w1_0 = SLIDE(c0, c0, 1, VL);                                              \
+  MED_CE(VT, MIN, MAX, w0_0, w1_0, VL);                                        \
+  VT w3_0 = SLIDE(c0, c0, 3, VL);                                              \
+  VT w4_0 = SLIDE(c0, c0, 4, VL);                                              \
+  MED_CE(VT, MIN, MAX, w3_0, w4_0, VL);                                        \
+  VT w2_0 = SLIDE(c0, c0, 2, VL);                                              \
+  MED_CE(VT, MIN, MAX, w2_0, w4_0, VL);                                        \
+  MED_HI(MAX, w2_0, w3_0, VL);                                                 \
+  MED_HI(MAX, w0_0, w3_0, VL);                                                 \
+  MED_CE(VT, MIN, MAX, w1_0, w4_0, VL);                                        \
+  MED_HI(MAX, w1_0, w3_0, VL);                                                 \
+  VT w0_1 = c1;                                                                \
+  VT w1_1 = SLIDE(c1, c1, 1, VL);                                              \
+  MED_CE(VT, MIN, MAX, w0_1, w1_1, VL);                                        \
+  VT w3_1 = SLIDE(c1, c1, 3, VL);                                              \
+  VT w4_1 = SLIDE(c1, c1, 4, VL);                                              \
+  MED_CE(VT, MIN, MAX, w3_1, w4_1, VL);                                        \
+  VT w2_1 = SLIDE(c1, c1, 2, VL);                                              \
+  MED_CE(VT, MIN, MAX, w2_1, w4_1, VL);                                        \
+  MED_CE(VT, MIN, MAX, w2_1, w3_1, VL);                                        \
+  MED_CE(VT, MIN, MAX, w0_1, w3_1, VL);                                        \
+  MED_HI(MAX, w0_1, w2_1, VL);                                                 \
+  MED_CE(VT, MIN, MAX, w1_1, w4_1, VL);                                        \
+  MED_CE(VT, MIN, MAX, w1_1, w3_1, VL);                                        \
+  MED_HI(MAX, w1_1, w2_1, VL);                                                 \
+  VT w0_2 = c2;                                                                \
+  VT w1_2 = SLIDE(c2, c2, 1, VL);                                              \
+  MED_CE(VT, MIN, MAX, w0_2, w1_2, VL);                                        \
+  VT w3_2 = SLIDE(c2, c2, 3, VL);                                              \
+  VT w4_2 = SLIDE(c2, c2, 4, VL);                                              \
+  MED_CE(VT, MIN, MAX, w3_2, w4_2, VL);                                        \
+  VT w2_2 = SLIDE(c2, c2, 2, VL);                                              \
+  MED_CE(VT, MIN, MAX, w2_2, w4_2, VL);                                        \
+  MED_CE(VT, MIN, MAX, w2_2, w3_2, VL);                                        \
+  MED_CE(VT, MIN, MAX, w0_2, w3_2, VL);                                        \
+  MED_HI(MAX, w0_2, w2_2, VL);                                                 \
+  MED_LO(MIN, w1_2, w4_2, VL);                                                 \
+  MED_CE(VT, MIN, MAX, w1_2, w3_2, VL);                                        \
+  MED_CE(VT, MIN, MAX, w1_2, w2_2, VL);                                        \
+  VT w0_3 = c3;                                                                \
+  VT w1_3 = SLIDE(c3, c3, 1, VL);                                              \
+  MED_CE(VT, MIN, MAX, w0_3, w1_3, VL);                                        \
+  VT w3_3 = SLIDE(c3, c3, 3, VL);                                              \
+  VT w4_3 = SLIDE(c3, c3, 4, VL);                                              \
+  MED_CE(VT, MIN, MAX, w3_3, w4_3, VL);                                        \
+  VT w2_3 = SLIDE(c3, c3, 2, VL);                                              \
+  MED_CE(VT, MIN, MAX, w2_3, w4_3, VL);                                        \
+  MED_CE(VT, MIN, MAX, w2_3, w3_3, VL);                                        \
+  MED_CE(VT, MIN, MAX, w0_3, w3_3, VL);                                        \
+  MED_CE(VT, MIN, MAX, w0_3, w2_3, VL);                                        \
+  MED_LO(MIN, w1_3, w4_3, VL);                                                 \
+  MED_LO(MIN, w1_3, w3_3, VL);                                                 \
+  MED_CE(VT, MIN, MAX, w1_3, w2_3, VL);                                        \
+  VT w0_4 = c4;                                                                \
+  VT w1_4 = SLIDE(c4, c4, 1, VL);                                              \
+  MED_CE(VT, MIN, MAX, w0_4, w1_4, VL);                                        \
+  VT w3_4 = SLIDE(c4, c4, 3, VL);                                              \
+  VT w4_4 = SLIDE(c4, c4, 4, VL);                                              \
+  MED_CE(VT, MIN, MAX, w3_4, w4_4, VL);                                        \
+  VT w2_4 = SLIDE(c4, c4, 2, VL);                                              \
+  MED_CE(VT, MIN, MAX, w2_4, w4_4, VL);                                        \
+  MED_CE(VT, MIN, MAX, w2_4, w3_4, VL);                                        \
+  MED_CE(VT, MIN, MAX, w0_4, w3_4, VL);                                        \
+  MED_CE(VT, MIN, MAX, w0_4, w2_4, VL);                                        \
+  MED_LO(MIN, w1_4, w4_4, VL);                                                 \
+  MED_LO(MIN, w1_4, w3_4, VL);                                                 \
+  MED_LO(MIN, w1_4, w2_4, VL);                                                 \
+  MED_CE(VT, MIN, MAX, w0_3, w3_0, VL);                                        \
+  MED_CE(VT, MIN, MAX, w0_4, w4_0, VL);                                        \
+  MED_CE(VT, MIN, MAX, w3_0, w0_4, VL);                                        \
+  MED_CE(VT, MIN, MAX, w1_2, w2_1, VL);                                        \
+  MED_CE(VT, MIN, MAX, w1_3, w3_1, VL);                                        \
+  MED_CE(VT, MIN, MAX, w2_1, w1_3, VL);                                        \
+  MED_HI(MAX, w0_3, w1_2, VL);                                                 \
+  MED_CE(VT, MIN, MAX, w0_4, w1_3, VL);                                        \
+  MED_HI(MAX, w0_4, w1_2, VL);                                                 \
+  MED_HI(MAX, w3_0, w2_1, VL);                                                 \
+  MED_LO(MIN, w4_0, w3_1, VL);                                                 \
+  MED_CE(VT, MIN, MAX, w4_0, w2_1, VL);                                        \
+  MED_HI(MAX, w4_0, w1_2, VL);                                                 \
+  MED_CE(VT, MIN, MAX, w2_1, w1_3, VL);                                        \
+  MED_CE(VT, MIN, MAX, w2_2, w1_4, VL);                                        \
+  MED_CE(VT, MIN, MAX, w4_1, w2_3, VL);                                        \
+  MED_CE(VT, MIN, MAX, w2_2, w4_1, VL);                                        \
+  MED_LO(MIN, w1_4, w2_3, VL);                                                 \
+  MED_CE(VT, MIN, MAX, w1_4, w4_1, VL);                                        \
+  MED_LO(MIN, w4_1, w3_2, VL);                                                 \
+  MED_CE(VT, MIN, MAX, w1_4, w4_1, VL);                                        \
+  MED_HI(MAX, w1_2, w2_2, VL);                                                 \
+  MED_LO(MIN, w1_3, w4_1, VL);                                                 \
+  MED_LO(MIN, w1_3, w2_2, VL);                                                 \
+  MED_LO(MIN, w2_1, w1_4, VL);                                                 \
+  MED_HI(MAX, w2_1, w1_3, VL);
+#define MEDIAN5_OUT w1_3
+
+#endif
@@ -0,0 +1,192 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdint.h>
+#include <string.h>
+
+#include "bench.h"
+#include "kernel/imgproc.h"
+#include "runtime.h"
+#include "util.h"
+#include "vcheck.h"
+
+#ifndef SPIKE
+#include "printf.h"
+#else
+#include <stdio.h>
+#endif
+
+extern uint64_t rows;
+extern uint64_t cols;
+extern uint64_t dst_rows;
+extern uint64_t dst_cols;
+extern uint8_t rgb[] __attribute__((aligned(4 * NR_LANES)));
+extern uint8_t rgb_o[] __attribute__((aligned(4 * NR_LANES)));
+extern uint8_t y[] __attribute__((aligned(4 * NR_LANES)));
+extern uint8_t u[] __attribute__((aligned(4 * NR_LANES)));
+extern uint8_t v[] __attribute__((aligned(4 * NR_LANES)));
+extern uint8_t blur[] __attribute__((aligned(4 * NR_LANES)));
+extern uint8_t img_o[] __attribute__((aligned(4 * NR_LANES)));
+extern uint16_t x_ofs[] __attribute__((aligned(4 * NR_LANES)));
+extern uint8_t x_w[] __attribute__((aligned(4 * NR_LANES)));
+extern uint8_t gold_y[] __attribute__((aligned(4 * NR_LANES)));
+extern uint8_t gold_u[] __attribute__((aligned(4 * NR_LANES)));
+extern uint8_t gold_v[] __attribute__((aligned(4 * NR_LANES)));
+extern uint8_t gold_rgb[] __attribute__((aligned(4 * NR_LANES)));
+extern uint8_t gold_blur[] __attribute__((aligned(4 * NR_LANES)));
+extern uint8_t gold_resize[] __attribute__((aligned(4 * NR_LANES)));
+extern uint8_t gold_pipe[] __attribute__((aligned(4 * NR_LANES)));
+extern uint16_t img16[] __attribute__((aligned(4 * NR_LANES)));
+extern float img32[] __attribute__((aligned(4 * NR_LANES)));
+extern uint8_t med_o[] __attribute__((aligned(4 * NR_LANES)));
+extern uint16_t med_o16[] __attribute__((aligned(4 * NR_LANES)));
+extern float med_o32[] __attribute__((aligned(4 * NR_LANES)));
+extern uint8_t gold_med3_u8[] __attribute__((aligned(4 * NR_LANES)));
+extern uint16_t gold_med3_u16[] __attribute__((aligned(4 * NR_LANES)));
+extern float gold_med3_f32[] __attribute__((aligned(4 * NR_LANES)));
+extern uint8_t gold_med5_u8[] __attribute__((aligned(4 * NR_LANES)));
+extern uint16_t gold_med5_u16[] __attribute__((aligned(4 * NR_LANES)));
+extern float gold_med5_f32[] __attribute__((aligned(4 * NR_LANES)));
+
+// Input pixels per cycle
+static int check(const char *name, const uint8_t *result, const uint8_t *gold,
+                 uint64_t n) {
+  int64_t idx = vcheck_i8((const int8_t *)result, (const int8_t *)gold, n);
+  if (idx >= 0) {
+    printf("%s: Error at index %d. %d != %d\n", name, idx, result[idx],
+           gold[idx]);
+    return 1;
+  }
+  printf("%s: Check okay. No errors.\n", name);
+  return 0;
+}
+
+static int check_idx(const char *name, int64_t idx) {
+  if (idx >= 0) {
+    printf("%s: Error at index %d.\n", name, idx);
+    return 1;
+  }
+  printf("%s: Check okay. No errors.\n", name);
+  return 0;
+}
+
+// The K x K median filters of the three types, and the speedup of the uint8_t
+// ones on the scalar reference
+#define MEDIAN_CHECK(K)                                                        \
+  do {                                                                         \
+    const uint64_t m = (rows - K + 1) * (cols - K + 1);                        \
+    int64_t scalar;                                                            \
+                                                                               \
+    start_timer();                                                             \
+    median_u8_scalar(med_o, gold_y, rows, cols, K);                            \
+    stop_timer();                                                              \
+    scalar = get_timer();                                                      \
+    bench_report_rate("median_u8_scalar (" #K "x" #K ")", n, "pixels");        \
+    error |= check("median_u8_scalar (" #K "x" #K ")", med_o,                  \
+                   gold_med##K##_u8, m);                                       \
+                                                                               \
+    start_timer();                                                             \
+    median##K##x##K##_u8(med_o, gold_y, rows, cols);                           \
+    stop_timer();                                                              \
+    bench_report_rate("median" #K "x" #K "_u8", n, "pixels");                  \
+    printf("Speedup on the scalar median: %f\n", (float)scalar / get_timer()); \
+    error |= check("median" #K "x" #K "_u8", med_o, gold_med##K##_u8, m);      \
+                                                                               \
+    start_timer();                                                             \
+    median##K##x##K##_u16(med_o16, img16, rows, cols);                         \
+    stop_timer();                                                              \
+    bench_report_rate("median" #K "x" #K "_u16", n, "pixels");                 \
+    error |= check_idx("median" #K "x" #K "_u16",                              \
+                       vcheck_i16((const int16_t *)med_o16,                    \
+                                  (const int16_t *)gold_med##K##_u16, m));     \
+                                                                               \
+    start_timer();                                                             \
+    median##K##x##K##_f32(med_o32, img32, rows, cols);                         \
+    stop_timer();                                                              \
+    bench_report_rate("median" #K "x" #K "_f32", n, "pixels");                 \
+    error |= check_idx("median" #K "x" #K "_f32",                              \
+                       vcheck_f32(med_o32, gold_med##K##_f32, m, 0));          \
+  } while (0)
+
+int main() {
+  printf("\n");
+  printf("=============\n");
+  printf("=  IMGPROC  =\n");
+  printf("=============\n");
+  printf("\n");
+  printf("\n");
+
+  printf("Image: %lu x %lu, resize to %lu x %lu\n", rows, cols, dst_rows,
+         dst_cols);
+
+  const uint64_t n = rows * cols;
+  const uint64_t blur_rows = rows - 4;
+  const uint64_t blur_cols = cols - 4;
+  int error = 0;
+
+  start_timer();
+  rgb_to_yuv_u8(y, u, v, rgb, n);
+  stop_timer();
+  bench_report_rate("rgb_to_yuv_u8", n, "pixels");
+  error |= check("rgb_to_yuv_u8 (Y)", y, gold_y, n);
+  error |= check("rgb_to_yuv_u8 (U)", u, gold_u, n);
+  error |= check("rgb_to_yuv_u8 (V)", v, gold_v, n);
+
+  start_timer();
+  yuv_to_rgb_u8(rgb_o, gold_y, gold_u, gold_v, n);
+  stop_timer();
+  bench_report_rate("yuv_to_rgb_u8", n, "pixels");
+  error |= check("yuv_to_rgb_u8", rgb_o, gold_rgb, 3 * n);
+
+  start_timer();
+  blur5_u8(blur, gold_y, rows, cols);
+  stop_timer();
+  bench_report_rate("blur5_u8", n, "pixels");
+  error |= check("blur5_u8", blur, gold_blur, blur_rows * blur_cols);
+
+  resize_init(x_ofs, x_w, blur_cols, dst_cols);
+  start_timer();
+  resize_u8(img_o, gold_blur, blur_rows, blur_cols, dst_rows, dst_cols, x_ofs,
+            x_w);
+  stop_timer();
+  bench_report_rate("resize_u8", dst_rows * dst_cols, "pixels");
+  error |= check("resize_u8", img_o, gold_resize, dst_rows * dst_cols);
+
+  // The same stages as imgproc_pipeline_u8, one after the other
+  resize_init(x_ofs, x_w, blur_cols, blur_cols / 2);
+  start_timer();
+  rgb_to_y_u8(y, rgb, n);
+  blur5_u8(blur, y, rows, cols);
+  resize_u8(img_o, blur, blur_rows, blur_cols, blur_rows / 2, blur_cols / 2,
+            x_ofs, x_w);
+  stop_timer();
+  bench_report_rate("imgproc unfused", n, "pixels");
+  error |= check("imgproc unfused", img_o, gold_pipe,
+                 blur_rows / 2 * (blur_cols / 2));
+
+  memset(img_o, 0, blur_rows / 2 * (blur_cols / 2));
+  start_timer();
+  imgproc_pipeline_u8(img_o, rgb, rows, cols);
+  stop_timer();
+  bench_report_rate("imgproc_pipeline_u8", n, "pixels");
+  error |= check("imgproc_pipeline_u8", img_o, gold_pipe,
+                 blur_rows / 2 * (blur_cols / 2));
+
+  MEDIAN_CHECK(3);
+  MEDIAN_CHECK(5);
+
+  return error;
+}
@@ -0,0 +1,131 @@
+#!/usr/bin/env python3
+# Copyright 2022 ETH Zurich and University of Bologna.
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+# arg1: rows, arg2: columns of the RGB image (both even, at least 6),
+# arg3: rows, arg4: columns of the resize of its blurred luma
+# The median filters run on the luma, and on 16-bit and FP32 images of the
+# same size
+
+import numpy as np
+import os
+import sys
+
+sys.path.insert(0, os.path.join(os.path.dirname(__file__), '../../common/script'))
+from data_emit import emit
+
+# Round to the nearest, ties up, and saturate to uint8_t, as vnclipu with
+# vxrm = 0
+def rnu_sat(v, shift):
+  return np.clip((v + (1 << (shift - 1))) >> shift, 0, 255).astype(np.uint8)
+
+def rgb_to_yuv(rgb):
+  r, g, b = [rgb[..., k].astype(np.int64) for k in range(3)]
+  y = rnu_sat(77 * r + 150 * g + 29 * b, 8)
+  u = rnu_sat(128 * b - 43 * r - 85 * g + 32768, 8)
+  v = rnu_sat(128 * r - 107 * g - 21 * b + 32768, 8)
+  return y, u, v
+
+def yuv_to_rgb(y, u, v):
+  y, u, v = [p.astype(np.int64) for p in (y, u, v)]
+  r = 64 * y + 90 * (v - 128)
+  g = 64 * y - 22 * (u - 128) - 46 * (v - 128)
+  b = 64 * y + 113 * (u - 128)
+  return np.stack([rnu_sat(np.maximum(p, 0), 6) for p in (r, g, b)], axis=-1)
+
+def blur5(x):
+  k = np.array([1, 4, 6, 4, 1], dtype=np.int64)
+  x = x.astype(np.int64)
+  rows, cols = x.shape
+  h = sum(k[t] * x[:, t:cols - 4 + t] for t in range(5))
+  return rnu_sat(sum(k[t] * h[t:rows - 4 + t, :] for t in range(5)), 8)
+
+# Offsets and Q7 weights of resize_init()
+def resize_coords(src, dst):
+  f = np.maximum((2 * np.arange(dst) + 1) * src * 128 // (2 * dst) - 64, 0)
+  ofs, w = f >> 7, f & 127
+  last = ofs >= src - 1
+  ofs[last], w[last] = src - 2, 128
+  return ofs, w
+
+# Median of the k x k windows, without border
+def median(x, k):
+  rows, cols = x.shape
+  win = np.stack([x[i:rows - k + 1 + i, j:cols - k + 1 + j]
+                  for i in range(k) for j in range(k)])
+  return np.sort(win, axis=0)[k * k // 2]
+
+def resize(x, dst_rows, dst_cols):
+  x = x.astype(np.int64)
+  x0, wx = resize_coords(x.shape[1], dst_cols)
+  y0, wy = resize_coords(x.shape[0], dst_rows)
+  t = x[:, x0] * (128 - wx) + x[:, x0 + 1] * wx
+  acc = t[y0, :] * (128 - wy)[:, None] + t[y0 + 1, :] * wy[:, None]
+  return rnu_sat(acc, 14)
+
+############
+## SCRIPT ##
+############
+
+if len(sys.argv) == 5:
+  rows     = int(sys.argv[1])
+  cols     = int(sys.argv[2])
+  dst_rows = int(sys.argv[3])
+  dst_cols = int(sys.argv[4])
+else:
+  print("Error. Give me four arguments: the rows and the columns of the image, and of the resize.")
+  sys.exit()
+
+rgb = np.random.randint(0, 256, (rows, cols, 3)).astype(np.uint8)
+
+y, u, v = rgb_to_yuv(rgb)
+blur = blur5(y)
+# The pipeline downscales the blurred luma by 2
+pipe = resize(blur, (rows - 4) // 2, (cols - 4) // 2)
+img16 = np.random.randint(0, 2**16, (rows, cols)).astype(np.uint16)
+img32 = np.random.normal(0, 1, (rows, cols)).astype(np.float32)
+
+# Create the file
+print(".section .data,\"aw\",@progbits")
+emit("rows", np.array(rows, dtype=np.uint64))
+emit("cols", np.array(cols, dtype=np.uint64))
+emit("dst_rows", np.array(dst_rows, dtype=np.uint64))
+emit("dst_cols", np.array(dst_cols, dtype=np.uint64))
+emit("rgb", rgb, 'NR_LANES*4')
+emit("rgb_o", np.zeros((rows, cols, 3), dtype=np.uint8), 'NR_LANES*4')
+emit("y", np.zeros((rows, cols), dtype=np.uint8), 'NR_LANES*4')
+emit("u", np.zeros((rows, cols), dtype=np.uint8), 'NR_LANES*4')
+emit("v", np.zeros((rows, cols), dtype=np.uint8), 'NR_LANES*4')
+emit("blur", np.zeros((rows - 4, cols - 4), dtype=np.uint8), 'NR_LANES*4')
+emit("img_o", np.zeros(max(dst_rows * dst_cols, pipe.size), dtype=np.uint8), 'NR_LANES*4')
+emit("x_ofs", np.zeros(max(dst_cols, (cols - 4) // 2), dtype=np.uint16), 'NR_LANES*4')
+emit("x_w", np.zeros(max(dst_cols, (cols - 4) // 2), dtype=np.uint8), 'NR_LANES*4')
+emit("gold_y", y, 'NR_LANES*4')
+emit("gold_u", u, 'NR_LANES*4')
+emit("gold_v", v, 'NR_LANES*4')
+emit("gold_rgb", yuv_to_rgb(y, u, v), 'NR_LANES*4')
+emit("gold_blur", blur, 'NR_LANES*4')
+emit("gold_resize", resize(blur, dst_rows, dst_cols), 'NR_LANES*4')
+emit("gold_pipe", pipe, 'NR_LANES*4')
+emit("img16", img16, 'NR_LANES*4')
+emit("img32", img32, 'NR_LANES*4')
+emit("med_o", np.zeros((rows, cols), dtype=np.uint8), 'NR_LANES*4')
+emit("med_o16", np.zeros((rows, cols), dtype=np.uint16), 'NR_LANES*4')
+emit("med_o32", np.zeros((rows, cols), dtype=np.float32), 'NR_LANES*4')
+for k in (3, 5):
+  emit("gold_med%d_u8" % k, median(y, k), 'NR_LANES*4')
+  emit("gold_med%d_u16" % k, median(img16, k), 'NR_LANES*4')
+  emit("gold_med%d_f32" % k, median(img32, k), 'NR_LANES*4')
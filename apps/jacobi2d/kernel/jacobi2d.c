@@ -236,6 +236,142 @@ void j2d_kernel_asm_v(uint64_t r, uint64_t c, DATA_TYPE *A, DATA_TYPE *B) {
   }
 }
 
+/*
+  Temporal blocking
+
+  j2d_tb_v() computes up to J2D_TB_SWEEPS sweeps per pass over the grid.
+  A pass goes down a strip of columns and keeps, for each sweep, a ring of
+  three rows in the vector registers: as soon as the rows i-1, i, i+1 of a
+  sweep are ready, the row i of the next sweep is computed, and only the rows
+  of the last sweep are stored. The strips overlap by one column per sweep on
+  each side, to compute their edges again instead of exchanging them.
+
+  As in j2d_s(), the even sweeps keep the boundaries of A, and the odd ones
+  those of B. The result ends in A, while B is only used as a buffer.
+  VLMAX must be larger than 2 * J2D_TB_SWEEPS.
+*/
+
+// Boundaries of sweep s
+static inline DATA_TYPE *j2d_tb_bnd(DATA_TYPE *A, DATA_TYPE *B, uint64_t s) {
+  return (s % 2) ? B : A;
+}
+
+// Row m of the strip [j0, j0 + gvl) of a sweep whose boundaries are in bnd.
+// The interior rows are x, the others are loaded from bnd.
+static inline vfloat64m1_t j2d_tb_fix(vfloat64m1_t x, DATA_TYPE *bnd,
+                                      uint64_t r, uint64_t c, uint64_t m,
+                                      uint64_t j0, vbool64_t first,
+                                      vbool64_t last, size_t gvl) {
+  if (m == 0 || m == r - 1)
+    return vle64_v_f64m1(&bnd[m * c + j0], gvl);
+  if (j0 == 0)
+    x = vfmerge_vfm_f64m1(first, x, bnd[m * c], gvl);
+  if (j0 + gvl == c)
+    x = vfmerge_vfm_f64m1(last, x, bnd[m * c + c - 1], gvl);
+  return x;
+}
+
+// Row m of the next sweep, from the rows m-1, m, m+1 of the previous one.
+// The stencil of the elements at the edges of the strip is wrong, and the
+// error moves inwards by one element per sweep.
+static inline vfloat64m1_t j2d_tb_row(vfloat64m1_t top, vfloat64m1_t mid,
+                                      vfloat64m1_t bot, size_t gvl) {
+  vfloat64m1_t left = vfslide1up_vf_f64m1(mid, 0, gvl);
+  vfloat64m1_t right = vfslide1down_vf_f64m1(mid, 0, gvl);
+  vfloat64m1_t x = vfadd_vv_f64m1(left, right, gvl);
+  x = vfadd_vv_f64m1(x, top, gvl);
+  x = vfadd_vv_f64m1(x, bot, gvl);
+  x = vfadd_vv_f64m1(x, mid, gvl);
+  return vfmul_vf_f64m1(x, 0.2, gvl);
+}
+
+// Push the row out##prev into the ring of sweep prev, and compute the row
+// n - k of sweep k from it
+#define J2D_TB_LEVEL(k, prev)                                                  \
+  top##prev = mid##prev;                                                       \
+  mid##prev = bot##prev;                                                       \
+  bot##prev = out##prev;                                                       \
+  if (n >= k && n - k < r)                                                     \
+    out##k = j2d_tb_fix(j2d_tb_row(top##prev, mid##prev, bot##prev, gvl),     \
+                        j2d_tb_bnd(A, B, s + k), r, c, n - k, j0, first, last, \
+                        gvl);
+
+// Sweeps s + 1, ..., s + nlev of the grid, from src to dst
+void j2d_tb_pass(uint64_t r, uint64_t c, DATA_TYPE *A, DATA_TYPE *B,
+                 DATA_TYPE *src, DATA_TYPE *dst, uint64_t s, uint64_t nlev) {
+  for (uint64_t j0 = 0;;) {
+    size_t gvl = vsetvl_e64m1(c - j0);
+
+    // The grid boundaries, and the columns that are correct after nlev sweeps
+    vuint64m1_t idx = vid_v_u64m1(gvl);
+    vbool64_t first = vmseq_vx_u64m1_b64(idx, 0, gvl);
+    vbool64_t last = vmseq_vx_u64m1_b64(idx, gvl - 1, gvl);
+    uint64_t j_begin = (j0 == 0) ? 1 : j0 + nlev;
+    uint64_t j_end = (j0 + gvl == c) ? c - 1 : j0 + gvl - nlev;
+    vbool64_t store = vmand_mm_b64(vmsgeu_vx_u64m1_b64(idx, j_begin - j0, gvl),
+                                   vmsltu_vx_u64m1_b64(idx, j_end - j0, gvl),
+                                   gvl);
+
+    vfloat64m1_t top0, mid0, bot0, top1, mid1, bot1;
+    vfloat64m1_t top2, mid2, bot2, top3, mid3, bot3;
+    vfloat64m1_t out0, out1, out2, out3, out4;
+    top0 = mid0 = bot0 = top1 = mid1 = bot1 = vfmv_v_f_f64m1(0, gvl);
+    top2 = mid2 = bot2 = top3 = mid3 = bot3 = top0;
+    out0 = out1 = out2 = out3 = out4 = top0;
+
+    for (uint64_t n = 0; n < r + nlev; n++) {
+      // Row n of sweep s
+      if (n < r)
+        out0 = j2d_tb_fix(vle64_v_f64m1(&src[n * c + j0], gvl),
+                          j2d_tb_bnd(A, B, s), r, c, n, j0, first, last, gvl);
+
+      J2D_TB_LEVEL(1, 0)
+      if (nlev > 1) {
+        J2D_TB_LEVEL(2, 1)
+        if (nlev > 2) {
+          J2D_TB_LEVEL(3, 2)
+          if (nlev > 3) {
+            J2D_TB_LEVEL(4, 3)
+          }
+        }
+      }
+
+      // Row n - nlev of sweep s + nlev
+      if (n >= nlev + 1 && n - nlev < r - 1) {
+        vfloat64m1_t res = (nlev == 1)   ? out1
+                           : (nlev == 2) ? out2
+                           : (nlev == 3) ? out3
+                                         : out4;
+        vse64_v_f64m1_m(store, &dst[(n - nlev) * c + j0], res, gvl);
+      }
+    }
+
+    if (j_end == c - 1)
+      break;
+    // The next strip starts nlev columns before the first one not stored
+    j0 = j_end - nlev;
+  }
+}
+
+void j2d_tb_v(uint64_t r, uint64_t c, DATA_TYPE *A, DATA_TYPE *B,
+              uint64_t tsteps) {
+  uint64_t sweeps = 2 * tsteps;
+
+  // An even number of passes, as even as possible, to end in A
+  uint64_t passes = (sweeps + J2D_TB_SWEEPS - 1) / J2D_TB_SWEEPS;
+  passes += passes % 2;
+
+  DATA_TYPE *src = A, *dst = B;
+  for (uint64_t p = 0, s = 0; p < passes; p++) {
+    uint64_t nlev = (sweeps - s + passes - p - 1) / (passes - p);
+    j2d_tb_pass(r, c, A, B, src, dst, s, nlev);
+    s += nlev;
+    DATA_TYPE *tmp = src;
+    src = dst;
+    dst = tmp;
+  }
+}
+
 // Debug
 inline void output_printfile(uint64_t r, uint64_t c, DATA_TYPE *A) {
   for (uint32_t i = 0; i < r; i++)
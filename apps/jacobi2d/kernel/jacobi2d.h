@@ -93,6 +93,11 @@ WITH ACCESS OR USE OF THE SOFTWARE.
 // Threshold for FP numbers comparison during the final check
 #define THRESHOLD 0.000001
 
+// Sweeps computed per pass over the grid by j2d_tb_v() (at most 4)
+#ifndef J2D_TB_SWEEPS
+#define J2D_TB_SWEEPS 4
+#endif
+
 // #define SOURCE_PRINT
 // #define RESULT_PRINT
 
@@ -101,6 +106,10 @@ void j2d_v(uint64_t r, uint64_t c, DATA_TYPE *A, DATA_TYPE *B, uint64_t tsteps);
 void j2d_kernel_v(uint64_t r, uint64_t c, DATA_TYPE *A, DATA_TYPE *B);
 void j2d_kernel_opt_v(uint64_t r, uint64_t c, DATA_TYPE *A, DATA_TYPE *B);
 void j2d_kernel_asm_v(uint64_t r, uint64_t c, DATA_TYPE *A, DATA_TYPE *B);
+void j2d_tb_v(uint64_t r, uint64_t c, DATA_TYPE *A, DATA_TYPE *B,
+              uint64_t tsteps);
+void j2d_tb_pass(uint64_t r, uint64_t c, DATA_TYPE *A, DATA_TYPE *B,
+                 DATA_TYPE *src, DATA_TYPE *dst, uint64_t s, uint64_t nlev);
 
 int check_result(uint64_t r, uint64_t c, DATA_TYPE *A_s, DATA_TYPE *B_s,
                  DATA_TYPE *A_v, DATA_TYPE *B_v);
@@ -115,8 +115,7 @@ int main() {
   DATA_TYPE *B_fixed_v = B_v + mtx_offset;
 
   // Check that the matrices are aligned on the actual output data
-  // NR_LANES can be maximum 16 here
-  if (((uint64_t)(B_fixed_v + 1) & (0x3f / (16 / NR_LANES))) != 0) {
+  if (((uint64_t)(B_fixed_v + 1) & (4 * NR_LANES - 1)) != 0) {
     printf("Fatal warning: the matrices are not correctly aligned.\n");
     return -1;
   } else {
@@ -147,7 +146,12 @@ int main() {
   // Measure vector kernel execution
   printf("Processing the vector benchmark\n");
   start_timer();
+#ifdef J2D_TB
+  // Temporally blocked
+  j2d_tb_v(R, C, A_fixed_v, B_fixed_v, TSTEPS);
+#else
   j2d_v(R, C, A_fixed_v, B_fixed_v, TSTEPS);
+#endif
   stop_timer();
   int64_t runtime = get_timer();
   // 2* since we have 2 jacobi kernels, one on A_fixed_v, one on B_fixed_v
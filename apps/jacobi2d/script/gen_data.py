@@ -15,27 +15,20 @@
 # See the License for the specific language governing permissions and
 # limitations under the License.
 
-# arg1: vector size, arg2: filter size
+# arg1: rows, arg2: columns, arg3: time steps (default: 1)
 
 import numpy as np
+import os
 import sys
 
-def emit(name, array, alignment='8'):
-  print(".global %s" % name)
-  print(".balign " + alignment)
-  print("%s:" % name)
-  bs = array.tobytes()
-  for i in range(0, len(bs), 4):
-    s = ""
-    for n in range(4):
-      s += "%02x" % bs[i+3-n]
-    print("    .word 0x%s" % s)
+sys.path.insert(0, os.path.join(os.path.dirname(__file__), '../../common/script'))
+from data_emit import emit
 
 ############
 ## SCRIPT ##
 ############
 
-if len(sys.argv) == 3:
+if len(sys.argv) in (3, 4):
   R = int(sys.argv[1])
   C = int(sys.argv[2])
 else:
@@ -44,7 +37,7 @@ else:
 
 dtype = np.float64
 
-TSTEPS = 1
+TSTEPS = int(sys.argv[3]) if len(sys.argv) == 4 else 1
 
 # Fill in the extra data to align the matrices to 4*NrLanes in SW
 maxNrLanes   = 16
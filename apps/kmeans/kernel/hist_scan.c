@@ -0,0 +1 @@
+../../hist_scan/kernel/hist_scan.c
\ No newline at end of file
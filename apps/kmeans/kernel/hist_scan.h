@@ -0,0 +1 @@
+../../hist_scan/kernel/hist_scan.h
\ No newline at end of file
@@ -0,0 +1,167 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <math.h>
+
+#include "hist_scan.h"
+#include "kmeans.h"
+
+// Centroids of a block, whose distances share the loads of the points
+#define KMEANS_BLOCK 4
+
+// Squared distances of the strip of vl points at xt to the centroid at ct,
+// and to the KMEANS_BLOCK centroids from ct. The columns of xt and ct are n
+// and k elements apart
+static inline vfloat32m2_t kmeans_dist(const float *xt, const float *ct,
+                                       uint64_t n, uint64_t dim, uint64_t k,
+                                       size_t vl) {
+  vfloat32m2_t acc = vfmv_v_f_f32m2(0, vl);
+  for (uint64_t d = 0; d < dim; ++d) {
+    vfloat32m2_t x = vle32_v_f32m2(xt + d * n, vl);
+    vfloat32m2_t t = vfsub_vf_f32m2(x, ct[d * k], vl);
+    acc = vfmacc_vv_f32m2(acc, t, t, vl);
+  }
+  return acc;
+}
+
+static inline void kmeans_dist_block(vfloat32m2_t *a0, vfloat32m2_t *a1,
+                                     vfloat32m2_t *a2, vfloat32m2_t *a3,
+                                     const float *xt, const float *ct,
+                                     uint64_t n, uint64_t dim, uint64_t k,
+                                     size_t vl) {
+  vfloat32m2_t acc0 = vfmv_v_f_f32m2(0, vl);
+  vfloat32m2_t acc1 = acc0, acc2 = acc0, acc3 = acc0;
+  for (uint64_t d = 0; d < dim; ++d) {
+    const float *c = ct + d * k;
+    vfloat32m2_t x = vle32_v_f32m2(xt + d * n, vl);
+    vfloat32m2_t t0 = vfsub_vf_f32m2(x, c[0], vl);
+    vfloat32m2_t t1 = vfsub_vf_f32m2(x, c[1], vl);
+    vfloat32m2_t t2 = vfsub_vf_f32m2(x, c[2], vl);
+    vfloat32m2_t t3 = vfsub_vf_f32m2(x, c[3], vl);
+    acc0 = vfmacc_vv_f32m2(acc0, t0, t0, vl);
+    acc1 = vfmacc_vv_f32m2(acc1, t1, t1, vl);
+    acc2 = vfmacc_vv_f32m2(acc2, t2, t2, vl);
+    acc3 = vfmacc_vv_f32m2(acc3, t3, t3, vl);
+  }
+  *a0 = acc0;
+  *a1 = acc1;
+  *a2 = acc2;
+  *a3 = acc3;
+}
+
+// Keep the distance d of centroid c where it is below the running minimum
+static inline void kmeans_min(vfloat32m2_t *best, vuint32m2_t *idx,
+                              vfloat32m2_t d, uint32_t c, size_t vl) {
+  vbool16_t closer = vmflt_vv_f32m2_b16(d, *best, vl);
+  *best = vmerge_vvm_f32m2(closer, *best, d, vl);
+  *idx = vmerge_vxm_u32m2(closer, *idx, c, vl);
+}
+
+static inline void kmeans_store(uint16_t *label, float *dist,
+                                vfloat32m2_t best, vuint32m2_t idx,
+                                size_t vl) {
+  vse16_v_u16m1(label, vncvt_x_x_w_u16m1(idx, vl), vl);
+  vse32_v_f32m2(dist, best, vl);
+}
+
+void kmeans_assign(uint16_t *label, float *dist, const float *xt,
+                   const float *ct, uint64_t n, uint64_t dim, uint64_t k) {
+  size_t vl;
+
+  for (uint64_t i = 0; i < n; i += vl) {
+    vl = vsetvl_e32m2(n - i);
+    vfloat32m2_t best = vfmv_v_f_f32m2(INFINITY, vl);
+    vuint32m2_t idx = vmv_v_x_u32m2(0, vl);
+
+    uint64_t c = 0;
+    for (; c + KMEANS_BLOCK <= k; c += KMEANS_BLOCK) {
+      vfloat32m2_t d0, d1, d2, d3;
+      kmeans_dist_block(&d0, &d1, &d2, &d3, xt + i, ct + c, n, dim, k, vl);
+      kmeans_min(&best, &idx, d0, c, vl);
+      kmeans_min(&best, &idx, d1, c + 1, vl);
+      kmeans_min(&best, &idx, d2, c + 2, vl);
+      kmeans_min(&best, &idx, d3, c + 3, vl);
+    }
+    for (; c < k; ++c)
+      kmeans_min(&best, &idx, kmeans_dist(xt + i, ct + c, n, dim, k, vl), c,
+                 vl);
+
+    kmeans_store(label + i, dist + i, best, idx, vl);
+  }
+}
+
+void kmeans_assign_unfused(uint16_t *label, float *dist, float *dmat,
+                           const float *xt, const float *ct, uint64_t n,
+                           uint64_t dim, uint64_t k) {
+  size_t vl;
+
+  // Distances, a row of dmat per centroid
+  for (uint64_t i = 0; i < n; i += vl) {
+    vl = vsetvl_e32m2(n - i);
+    uint64_t c = 0;
+    for (; c + KMEANS_BLOCK <= k; c += KMEANS_BLOCK) {
+      vfloat32m2_t d0, d1, d2, d3;
+      kmeans_dist_block(&d0, &d1, &d2, &d3, xt + i, ct + c, n, dim, k, vl);
+      vse32_v_f32m2(dmat + c * n + i, d0, vl);
+      vse32_v_f32m2(dmat + (c + 1) * n + i, d1, vl);
+      vse32_v_f32m2(dmat + (c + 2) * n + i, d2, vl);
+      vse32_v_f32m2(dmat + (c + 3) * n + i, d3, vl);
+    }
+    for (; c < k; ++c)
+      vse32_v_f32m2(dmat + c * n + i,
+                    kmeans_dist(xt + i, ct + c, n, dim, k, vl), vl);
+  }
+
+  // Argmin
+  for (uint64_t i = 0; i < n; i += vl) {
+    vl = vsetvl_e32m2(n - i);
+    vfloat32m2_t best = vfmv_v_f_f32m2(INFINITY, vl);
+    vuint32m2_t idx = vmv_v_x_u32m2(0, vl);
+    for (uint64_t c = 0; c < k; ++c)
+      kmeans_min(&best, &idx, vle32_v_f32m2(dmat + c * n + i, vl), c, vl);
+    kmeans_store(label + i, dist + i, best, idx, vl);
+  }
+}
+
+void kmeans_update(float *ct, uint32_t *count, float *sums, void *sub,
+                   const uint16_t *label, const float *xt, uint64_t n,
+                   uint64_t dim, uint64_t k) {
+  size_t vl;
+
+  vhist_u16(label, n, count, (uint32_t *)sub, k);
+  for (uint64_t d = 0; d < dim; ++d)
+    vhist_add_f32(label, xt + d * n, n, sums + d * k, (float *)sub, k);
+
+  for (uint64_t d = 0; d < dim; ++d) {
+    for (uint64_t j = 0; j < k; j += vl) {
+      vl = vsetvl_e32m8(k - j);
+      vuint32m8_t cnt = vle32_v_u32m8(count + j, vl);
+      vbool4_t some = vmsne_vx_u32m8_b4(cnt, 0, vl);
+      vfloat32m8_t mean = vfdiv_vv_f32m8(vle32_v_f32m8(sums + d * k + j, vl),
+                                         vfcvt_f_xu_v_f32m8(cnt, vl), vl);
+      vse32_v_f32m8_m(some, ct + d * k + j, mean, vl);
+    }
+  }
+}
+
+void kmeans(float *ct, uint16_t *label, float *dist, uint32_t *count,
+            float *sums, void *sub, const float *xt, uint64_t n, uint64_t dim,
+            uint64_t k, uint64_t iters) {
+  for (uint64_t it = 0; it < iters; ++it) {
+    kmeans_assign(label, dist, xt, ct, n, dim, k);
+    kmeans_update(ct, count, sums, sub, label, xt, n, dim, k);
+  }
+}
@@ -0,0 +1,54 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// k-means clustering of n points of dim FP32 elements, the columns of xt
+// (dim x n), i.e., the points are stored transposed, as the database of knn,
+// with k <= 65536 centroids, the columns of ct (dim x k):
+//   kmeans_assign: label of the nearest centroid of each point, and its
+//                  squared distance, in one pass over the centroids. A strip
+//                  of points keeps its running minimum and index in
+//                  registers, updated with vmflt and vmerge, with the first
+//                  centroid on ties
+//   kmeans_assign_unfused: the same, from the k x n distances written to
+//                          dmat, and an argmin pass over them
+//   kmeans_update: each centroid to the mean of its points, from their
+//                  counts (vhist_u16) and the sums of each dimension
+//                  (vhist_add_f32, in sums, dim x k). A centroid without
+//                  points does not move. sub is a buffer of vhist_sub_size(k)
+//                  bytes
+//   kmeans: iters iterations of kmeans_assign and kmeans_update. label and
+//           dist are those of the last assignment
+
+#ifndef _KMEANS_H_
+#define _KMEANS_H_
+
+#include <stdint.h>
+
+#include "riscv_vector.h"
+
+void kmeans_assign(uint16_t *label, float *dist, const float *xt,
+                   const float *ct, uint64_t n, uint64_t dim, uint64_t k);
+void kmeans_assign_unfused(uint16_t *label, float *dist, float *dmat,
+                           const float *xt, const float *ct, uint64_t n,
+                           uint64_t dim, uint64_t k);
+void kmeans_update(float *ct, uint32_t *count, float *sums, void *sub,
+                   const uint16_t *label, const float *xt, uint64_t n,
+                   uint64_t dim, uint64_t k);
+void kmeans(float *ct, uint16_t *label, float *dist, uint32_t *count,
+            float *sums, void *sub, const float *xt, uint64_t n, uint64_t dim,
+            uint64_t k, uint64_t iters);
+
+#endif
@@ -0,0 +1,126 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdint.h>
+
+#include "kernel/kmeans.h"
+#include "l2_alloc.h"
+#include "runtime.h"
+#include "util.h"
+#include "vcheck.h"
+
+#ifndef SPIKE
+#include "printf.h"
+#else
+#include <stdio.h>
+#endif
+
+// Absolute thresholds of the distances and of the centroids, computed in FP32
+// against the FP64 golden ones
+#define DIST_THRESHOLD 1e-2f
+#define CT_THRESHOLD 1e-3f
+
+extern uint64_t n;
+extern uint64_t dim;
+extern uint64_t k;
+extern uint64_t iters;
+extern float xt[] __attribute__((aligned(4 * NR_LANES)));
+extern float ct0[] __attribute__((aligned(4 * NR_LANES)));
+extern float ct[] __attribute__((aligned(4 * NR_LANES)));
+extern uint16_t label[] __attribute__((aligned(4 * NR_LANES)));
+extern float dist[] __attribute__((aligned(4 * NR_LANES)));
+extern float dmat[] __attribute__((aligned(4 * NR_LANES)));
+extern uint32_t count[] __attribute__((aligned(4 * NR_LANES)));
+extern float sums[] __attribute__((aligned(4 * NR_LANES)));
+extern uint16_t gold_label0[] __attribute__((aligned(4 * NR_LANES)));
+extern float gold_dist0[] __attribute__((aligned(4 * NR_LANES)));
+extern float gold_ct[] __attribute__((aligned(4 * NR_LANES)));
+extern uint16_t gold_label[] __attribute__((aligned(4 * NR_LANES)));
+
+// Compare the labels and the distances of an assignment with the golden ones
+static int check_assign(const char *name, const uint16_t *gold_l,
+                        const float *gold_d) {
+  int64_t idx = vcheck_i16((int16_t *)label, (int16_t *)gold_l, n);
+  if (idx >= 0) {
+    printf("%s: Error at the label of point %d. %d != %d\n", name, idx,
+           label[idx], gold_l[idx]);
+    return 1;
+  }
+  if (gold_d) {
+    idx = vcheck_f32(dist, gold_d, n, DIST_THRESHOLD);
+    if (idx >= 0) {
+      printf("%s: Error at the distance of point %d. %f != %f\n", name, idx,
+             dist[idx], gold_d[idx]);
+      return 1;
+    }
+  }
+  printf("%s: Check okay. No errors.\n", name);
+  return 0;
+}
+
+int main() {
+  printf("\n");
+  printf("============\n");
+  printf("=  KMEANS  =\n");
+  printf("============\n");
+  printf("\n");
+  printf("\n");
+
+  printf("Points: %lu, dimensions: %lu, centroids: %lu, iterations: %lu\n", n,
+         dim, k, iters);
+
+  void *sub = l2_alloc(vhist_sub_size(k), 0);
+  if (!sub) {
+    printf("The sub-histograms do not fit in the L2 arena.\n");
+    return 1;
+  }
+
+  int error = 0;
+  int64_t runtime;
+
+  start_timer();
+  kmeans_assign(label, dist, xt, ct0, n, dim, k);
+  stop_timer();
+  runtime = get_timer();
+  printf("kmeans_assign: %d cycles, %f cycles/point/centroid.\n", runtime,
+         (float)runtime / (n * k));
+  error |= check_assign("kmeans_assign", gold_label0, gold_dist0);
+
+  start_timer();
+  kmeans_assign_unfused(label, dist, dmat, xt, ct0, n, dim, k);
+  stop_timer();
+  runtime = get_timer();
+  printf("kmeans_assign_unfused: %d cycles, %f cycles/point/centroid.\n",
+         runtime, (float)runtime / (n * k));
+  error |= check_assign("kmeans_assign_unfused", gold_label0, gold_dist0);
+
+  start_timer();
+  kmeans(ct, label, dist, count, sums, sub, xt, n, dim, k, iters);
+  stop_timer();
+  runtime = get_timer();
+  printf("kmeans: %d cycles, %f cycles/point/centroid/iteration.\n", runtime,
+         (float)runtime / (n * k * iters));
+  error |= check_assign("kmeans", gold_label, 0);
+
+  int64_t idx = vcheck_f32(ct, gold_ct, dim * k, CT_THRESHOLD);
+  if (idx >= 0) {
+    printf("kmeans: Error at element %d of the centroids. %f != %f\n", idx,
+           ct[idx], gold_ct[idx]);
+    error = 1;
+  }
+
+  return error;
+}
@@ -0,0 +1,106 @@
+#!/usr/bin/env python3
+# Copyright 2022 ETH Zurich and University of Bologna.
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+# arg1: points, arg2: dimensions, arg3: centroids, arg4: iterations
+#
+# The points are drawn around k random centers, and the initial centroids are
+# the first k points. The points and the centroids are stored transposed, a
+# point or a centroid per column. The golden assignments and centroids are
+# computed in FP64. The data is drawn again while the nearest two centroids of
+# a point are too close in some iteration, so that the FP32 distances of the
+# kernels cannot pick another one.
+
+import numpy as np
+import os
+import sys
+
+sys.path.insert(0, os.path.join(os.path.dirname(__file__), '../../common/script'))
+from data_emit import emit
+
+# Spread of the centers, and minimum relative gap between the nearest two
+# distances of a point
+SPREAD = 8.0
+MIN_GAP = 1e-4
+
+def assign(x, c):
+  # x: n x dim, c: k x dim. Label, distance, and the distance matrix (k x n)
+  d = ((x[None, :, :] - c[:, None, :]) ** 2).sum(axis=2)
+  label = np.argmin(d, axis=0)
+  s = np.sort(d, axis=0)
+  gap = (s[1] - s[0]) / np.maximum(s[1], 1e-30) if len(c) > 1 else np.ones(1)
+  return label, d[label, np.arange(x.shape[0])], gap.min()
+
+def update(x, c, label):
+  c = c.copy()
+  for j in range(len(c)):
+    if np.any(label == j):
+      c[j] = x[label == j].mean(axis=0)
+  return c
+
+def kmeans(x, c, iters):
+  for _ in range(iters):
+    label, d, gap = assign(x, c)
+    if gap < MIN_GAP:
+      return None
+    c = update(x, c, label)
+  return label, c
+
+############
+## SCRIPT ##
+############
+
+if len(sys.argv) == 5:
+  n     = int(sys.argv[1])
+  dim   = int(sys.argv[2])
+  k     = int(sys.argv[3])
+  iters = int(sys.argv[4])
+else:
+  print("Error. Give me four arguments: the points, the dimensions, the centroids, and the iterations.")
+  sys.exit()
+
+assert 0 < k <= min(n, 65536), "the centroids must be between 1 and min(n, 65536)"
+
+while True:
+  centers = np.random.uniform(-SPREAD, SPREAD, (k, dim))
+  x = centers[np.random.randint(0, k, n)] + np.random.normal(0, 1, (n, dim))
+  # The kernels see the FP32 values
+  x = x.astype(np.float32).astype(np.float64)
+  c0 = x[:k].copy()
+  label0, dist0, gap = assign(x, c0)
+  res = kmeans(x, c0, iters) if gap >= MIN_GAP else None
+  if res is not None:
+    break
+label, c = res
+
+# Create the file
+print(".section .data,\"aw\",@progbits")
+emit("n", np.array(n, dtype=np.uint64))
+emit("dim", np.array(dim, dtype=np.uint64))
+emit("k", np.array(k, dtype=np.uint64))
+emit("iters", np.array(iters, dtype=np.uint64))
+emit("xt", x.T.astype(np.float32), 'NR_LANES*4')
+emit("ct0", c0.T.astype(np.float32), 'NR_LANES*4')
+emit("ct", c0.T.astype(np.float32), 'NR_LANES*4')
+emit("label", np.zeros(n, dtype=np.uint16), 'NR_LANES*4')
+emit("dist", np.zeros(n, dtype=np.float32), 'NR_LANES*4')
+emit("dmat", np.zeros(k * n, dtype=np.float32), 'NR_LANES*4')
+emit("count", np.zeros(k, dtype=np.uint32), 'NR_LANES*4')
+emit("sums", np.zeros(dim * k, dtype=np.float32), 'NR_LANES*4')
+emit("gold_label0", label0.astype(np.uint16), 'NR_LANES*4')
+emit("gold_dist0", dist0.astype(np.float32), 'NR_LANES*4')
+emit("gold_ct", c.T.astype(np.float32), 'NR_LANES*4')
+emit("gold_label", label.astype(np.uint16), 'NR_LANES*4')
@@ -0,0 +1,138 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "knn.h"
+#include "fmatmul_f32.h"
+#include "vconfig.h"
+
+// Squared norm of a row of dim elements
+static float knn_norm(const float *x, uint64_t dim) {
+  vfloat32m1_t red = vfmv_v_f_f32m1(0, 1);
+  size_t vl;
+
+  for (; dim > 0; dim -= vl) {
+    vl = vsetvl_e32m8(dim);
+    vfloat32m8_t v = vle32_v_f32m8(x, vl);
+    red = vfredusum_vs_f32m8_f32m1(red, vfmul_vv_f32m8(v, v, vl), red, vl);
+    x += vl;
+  }
+
+  return vfmv_f_s_f32m1_f32(red);
+}
+
+// The norms of the columns of dt accumulate over its rows, on unit strides
+void knn_norms(float *dn, const float *dt, uint64_t ndb, uint64_t dim) {
+  size_t vl;
+
+  for (uint64_t j = 0; j < ndb; j += vl) {
+    vl = vsetvl_e32m8(ndb - j);
+    vfloat32m8_t acc = vfmv_v_f_f32m8(0, vl);
+    for (uint64_t i = 0; i < dim; ++i) {
+      vfloat32m8_t v = vle32_v_f32m8(dt + i * ndb + j, vl);
+      acc = vfmacc_vv_f32m8(acc, v, v, vl);
+    }
+    vse32_v_f32m8(dn + j, acc, vl);
+  }
+}
+
+// Distances from the dot products of a row of Q D^T, in place
+static void knn_row(float *row, const float *dn, float qn, uint64_t ndb,
+                    knn_metric_t metric) {
+  size_t vl;
+
+  for (uint64_t j = 0; j < ndb; j += vl) {
+    vl = vsetvl_e32m8(ndb - j);
+    vfloat32m8_t dot = vle32_v_f32m8(row + j, vl);
+    vfloat32m8_t n = vle32_v_f32m8(dn + j, vl);
+    vfloat32m8_t d;
+    if (metric == KNN_L2) {
+      d = vfmacc_vf_f32m8(vfadd_vf_f32m8(n, qn, vl), -2, dot, vl);
+      d = vfmax_vf_f32m8(d, 0, vl);
+    } else {
+      vfloat32m8_t norm = vfsqrt_v_f32m8(vfmul_vf_f32m8(n, qn, vl), vl);
+      d = vfrsub_vf_f32m8(vfdiv_vv_f32m8(dot, norm, vl), 1, vl);
+    }
+    vse32_v_f32m8(row + j, d, vl);
+  }
+}
+
+void knn_distances(float *dist, const float *q, const float *dt,
+                   const float *dn, uint64_t nq, uint64_t ndb, uint64_t dim,
+                   knn_metric_t metric) {
+  fmatmul_f32_4x4(dist, q, dt, nq, dim, ndb);
+  for (uint64_t i = 0; i < nq; ++i)
+    knn_row(dist + i * ndb, dn, knn_norm(q + i * dim, dim), ndb, metric);
+}
+
+// Insert v into the sorted list of len <= k elements, after its equals, and
+// drop the last one if the list is full
+static uint64_t knn_insert(float *val, uint32_t *idx, uint64_t len,
+                           uint64_t k, float v, uint32_t i) {
+  uint64_t p = len < k ? len : k - 1;
+  for (; p > 0 && val[p - 1] > v; --p) {
+    val[p] = val[p - 1];
+    idx[p] = idx[p - 1];
+  }
+  val[p] = v;
+  idx[p] = i;
+  return len < k ? len + 1 : k;
+}
+
+// The strips are filtered with vmflt against the k-th smallest distance so
+// far, and the few distances below it are compacted with vcompress and
+// inserted into the sorted list by the scalar core. Once the list is full,
+// most strips have no candidate and cost a compare and a vcpop.
+void knn_topk(float *val, uint32_t *idx, const float *dist, uint64_t n,
+              uint64_t k) {
+  float cand[VLMAX_E32M4];
+  uint32_t cand_idx[VLMAX_E32M4];
+  float thr = __builtin_inff();
+  uint64_t len = 0;
+  size_t vl;
+
+  if (!k)
+    return;
+
+  for (uint64_t j = 0; j < n; j += vl) {
+    vl = vsetvl_e32m4(n - j);
+    vfloat32m4_t d = vle32_v_f32m4(dist + j, vl);
+    // Until the list is full, thr is +inf and every distance is a candidate
+    vbool8_t below = vmflt_vf_f32m4_b8(d, thr, vl);
+    const uint64_t cnt = vcpop_m_b8(below, vl);
+    if (!cnt)
+      continue;
+
+    vuint32m4_t id = vadd_vx_u32m4(vid_v_u32m4(vl), j, vl);
+    vse32_v_f32m4(cand, vcompress_vm_f32m4(below, d, d, vl), cnt);
+    vse32_v_u32m4(cand_idx, vcompress_vm_u32m4(below, id, id, vl), cnt);
+
+    for (uint64_t c = 0; c < cnt; ++c) {
+      if (len == k && !(cand[c] < thr))
+        continue;
+      len = knn_insert(val, idx, len, k, cand[c], cand_idx[c]);
+      if (len == k)
+        thr = val[k - 1];
+    }
+  }
+}
+
+void knn(float *val, uint32_t *idx, float *dist, const float *q,
+         const float *dt, const float *dn, uint64_t nq, uint64_t ndb,
+         uint64_t dim, uint64_t k, knn_metric_t metric) {
+  knn_distances(dist, q, dt, dn, nq, ndb, dim, metric);
+  for (uint64_t i = 0; i < nq; ++i)
+    knn_topk(val + i * k, idx + i * k, dist + i * ndb, ndb, k);
+}
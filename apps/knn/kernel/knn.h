@@ -0,0 +1,59 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// k-nearest neighbors of a batch of nq queries in a database of ndb vectors of
+// dim FP32 elements:
+//  - The queries are the rows of q (nq x dim), and the database vectors are
+//    the columns of dt (dim x ndb), i.e., the database is stored transposed,
+//    as the B of the GEMM Q D^T.
+//  - The distances are formulated on the GEMM with fmatmul_f32_4x4, which
+//    runs with LMUL=4 on any ndb, and the squared norms of the queries (qn)
+//    and of the database vectors (dn, from knn_norms):
+//      KNN_L2:     |q - d|^2 = qn + dn - 2 q.d, clamped to 0
+//      KNN_COSINE: 1 - q.d / sqrt(qn dn), for non-zero vectors
+//    nq is a multiple of 4 and dim is even, as for the micro-kernel.
+//  - knn_topk selects the k <= n smallest of n distances, in ascending
+//    order, with the first index on ties.
+
+#ifndef _KNN_H_
+#define _KNN_H_
+
+#include <stdint.h>
+
+#include "riscv_vector.h"
+
+typedef enum {
+  KNN_L2,
+  KNN_COSINE,
+} knn_metric_t;
+
+void knn_norms(float *dn, const float *dt, uint64_t ndb, uint64_t dim);
+
+// dist (nq x ndb) = the distances between the queries and the database
+void knn_distances(float *dist, const float *q, const float *dt,
+                   const float *dn, uint64_t nq, uint64_t ndb, uint64_t dim,
+                   knn_metric_t metric);
+
+void knn_topk(float *val, uint32_t *idx, const float *dist, uint64_t n,
+              uint64_t k);
+
+// The k nearest neighbors of each query, in the rows of val and idx (nq x k),
+// with dist as the buffer of the distances
+void knn(float *val, uint32_t *idx, float *dist, const float *q,
+         const float *dt, const float *dn, uint64_t nq, uint64_t ndb,
+         uint64_t dim, uint64_t k, knn_metric_t metric);
+
+#endif
@@ -0,0 +1,116 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdint.h>
+#include <string.h>
+
+#include "bench.h"
+#include "kernel/knn.h"
+#include "runtime.h"
+#include "util.h"
+#include "vcheck.h"
+
+#ifndef SPIKE
+#include "printf.h"
+#else
+#include <stdio.h>
+#endif
+
+#define THRESHOLD 0.0001
+
+// The inputs are small integers, so that the dot products and the norms are
+// exact and the golds break the ties as the kernel does
+extern uint64_t nq;
+extern uint64_t ndb;
+extern uint64_t dim;
+extern uint64_t k;
+extern float q[] __attribute__((aligned(4 * NR_LANES)));
+extern float dt[] __attribute__((aligned(4 * NR_LANES)));
+extern float gold_dist_l2[] __attribute__((aligned(4 * NR_LANES)));
+extern float gold_val_l2[] __attribute__((aligned(4 * NR_LANES)));
+extern uint32_t gold_idx_l2[] __attribute__((aligned(4 * NR_LANES)));
+extern float gold_dist_cos[] __attribute__((aligned(4 * NR_LANES)));
+extern float gold_val_cos[] __attribute__((aligned(4 * NR_LANES)));
+extern uint32_t gold_idx_cos[] __attribute__((aligned(4 * NR_LANES)));
+extern float dn[] __attribute__((aligned(4 * NR_LANES)));
+extern float dist[] __attribute__((aligned(4 * NR_LANES)));
+extern float val[] __attribute__((aligned(4 * NR_LANES)));
+extern uint32_t idx[] __attribute__((aligned(4 * NR_LANES)));
+
+static int run(const char *name, knn_metric_t metric, const float *gold_dist,
+               const float *gold_val, const uint32_t *gold_idx) {
+  int error = 0;
+
+  // The distances, 2 nq ndb dim FLOP of the GEMM
+  start_timer();
+  knn_distances(dist, q, dt, dn, nq, ndb, dim, metric);
+  stop_timer();
+  bench_report_flops(name, 2 * nq * ndb * dim);
+  error |= vcheck_report(name,
+                         vcheck_f32(dist, gold_dist, nq * ndb, THRESHOLD));
+
+  // The top-k of the distances, a compare per distance
+  memset(val, 0, nq * k * sizeof(float));
+  memset(idx, 0, nq * k * sizeof(uint32_t));
+  start_timer();
+  for (uint64_t i = 0; i < nq; ++i)
+    knn_topk(val + i * k, idx + i * k, dist + i * ndb, ndb, k);
+  stop_timer();
+  bench_report_flops("knn_topk", nq * ndb);
+  error |= vcheck_report("knn_topk",
+                         vcheck_f32(val, gold_val, nq * k, THRESHOLD));
+  error |= vcheck_report("knn_topk indices",
+                         vcheck_i32((int32_t *)idx, (int32_t *)gold_idx,
+                                    nq * k));
+
+  // The whole search
+  memset(idx, 0, nq * k * sizeof(uint32_t));
+  start_timer();
+  knn(val, idx, dist, q, dt, dn, nq, ndb, dim, k, metric);
+  stop_timer();
+  bench_report_flops("knn", 2 * nq * ndb * dim);
+  error |= vcheck_report("knn indices",
+                         vcheck_i32((int32_t *)idx, (int32_t *)gold_idx,
+                                    nq * k));
+
+  return error;
+}
+
+int main() {
+  printf("\n");
+  printf("=========\n");
+  printf("=  KNN  =\n");
+  printf("=========\n");
+  printf("\n");
+  printf("\n");
+
+  printf("%lu nearest neighbors of %lu queries in %lu vectors of %lu "
+         "elements\n",
+         k, nq, ndb, dim);
+
+  int error = 0;
+
+  start_timer();
+  knn_norms(dn, dt, ndb, dim);
+  stop_timer();
+  bench_report_flops("knn_norms", 2 * ndb * dim);
+
+  error |= run("knn_l2", KNN_L2, gold_dist_l2, gold_val_l2, gold_idx_l2);
+  error |= run("knn_cosine", KNN_COSINE, gold_dist_cos, gold_val_cos,
+               gold_idx_cos);
+
+  return error;
+}
@@ -0,0 +1,88 @@
+#!/usr/bin/env python3
+# Copyright 2022 ETH Zurich and University of Bologna.
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+# arg1, arg2, arg3, arg4: queries (multiple of 4), database vectors, vector
+# size (even), and neighbors
+# The database is stored transposed, as dim x ndb
+
+import numpy as np
+import os
+import sys
+
+sys.path.insert(0, os.path.join(os.path.dirname(__file__), '../../common/script'))
+from data_emit import emit
+
+# The k smallest distances of each row, in ascending order and with the first
+# index on ties, as knn_topk()
+def topk(dist, k):
+  idx = np.argsort(dist, axis=1, kind='stable')[:, :k].astype(np.uint32)
+  return np.take_along_axis(dist, idx.astype(np.int64), axis=1), idx
+
+############
+## SCRIPT ##
+############
+
+if len(sys.argv) == 5:
+  nq  = int(sys.argv[1])
+  ndb = int(sys.argv[2])
+  dim = int(sys.argv[3])
+  k   = int(sys.argv[4])
+else:
+  print("Error. Give me four arguments: the number of queries, the number of "
+        "database vectors, the vector size, and the number of neighbors.")
+  sys.exit()
+
+if nq % 4 or dim % 2 or k > ndb:
+  print("Error. The queries must be a multiple of 4, the vector size even, and "
+        "the neighbors at most the database vectors.")
+  sys.exit()
+
+# Small non-zero integers: the dot products and the norms are exact in FP32,
+# the same ties show up in the kernel and here, and no norm is zero
+vals = np.array([-3, -2, -1, 1, 2, 3], dtype=np.float32)
+q    = np.random.choice(vals, (nq, dim))
+dt   = np.random.choice(vals, (dim, ndb))
+
+# The same FP32 operations as knn_distances(), correctly rounded
+dot  = q @ dt
+qn   = np.sum(q * q, axis=1, keepdims=True)
+dn   = np.sum(dt * dt, axis=0, keepdims=True)
+dist_l2  = np.maximum(qn + dn - np.float32(2) * dot, np.float32(0))
+dist_cos = np.float32(1) - dot / np.sqrt(qn * dn)
+
+val_l2, idx_l2   = topk(dist_l2, k)
+val_cos, idx_cos = topk(dist_cos, k)
+
+# Create the file
+print(".section .data,\"aw\",@progbits")
+emit("nq", np.array(nq, dtype=np.uint64))
+emit("ndb", np.array(ndb, dtype=np.uint64))
+emit("dim", np.array(dim, dtype=np.uint64))
+emit("k", np.array(k, dtype=np.uint64))
+emit("q", q, 'NR_LANES*4')
+emit("dt", dt, 'NR_LANES*4')
+emit("gold_dist_l2", dist_l2.astype(np.float32), 'NR_LANES*4')
+emit("gold_val_l2", val_l2.astype(np.float32), 'NR_LANES*4')
+emit("gold_idx_l2", idx_l2, 'NR_LANES*4')
+emit("gold_dist_cos", dist_cos.astype(np.float32), 'NR_LANES*4')
+emit("gold_val_cos", val_cos.astype(np.float32), 'NR_LANES*4')
+emit("gold_idx_cos", idx_cos, 'NR_LANES*4')
+# The norms of the database, the distances, and the neighbors
+emit("dn", np.zeros(ndb, dtype=np.float32), 'NR_LANES*4')
+emit("dist", np.zeros((nq, ndb), dtype=np.float32), 'NR_LANES*4')
+emit("val", np.zeros((nq, k), dtype=np.float32), 'NR_LANES*4')
+emit("idx", np.zeros((nq, k), dtype=np.uint32), 'NR_LANES*4')
@@ -0,0 +1,241 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "layernorm.h"
+#include "vconfig.h"
+
+// The statistics accumulate whole register groups of LMUL=8, and the last
+// partial group of a row is reduced on its own
+#define LN_VLMAX VLMAX(32, 8)
+
+// Newton-Raphson steps after vfrsqrt7, each doubling its 7 bits
+#define LN_RSQRT_STEPS_32 2
+#define LN_RSQRT_STEPS_16 1
+
+// 1/sqrt(a), with vfrsqrt7 and steps Newton-Raphson iterations
+static inline float ln_rsqrt(float a, int steps) {
+  vfloat32m1_t a_v = vfmv_v_f_f32m1(a, 1);
+  vfloat32m1_t r_v = vfrsqrt7_v_f32m1(a_v, 1);
+  for (int k = 0; k < steps; ++k) {
+    // r = r (1.5 - 0.5 a r^2)
+    vfloat32m1_t e_v = vfmul_vv_f32m1(vfmul_vv_f32m1(a_v, r_v, 1), r_v, 1);
+    e_v = vfrsub_vf_f32m1(vfmul_vf_f32m1(e_v, 0.5f, 1), 1.5f, 1);
+    r_v = vfmul_vv_f32m1(r_v, e_v, 1);
+  }
+  return vfmv_f_s_f32m1_f32(r_v);
+}
+
+// Mean and 1/sqrt(var + eps) from the sums of d = x - shift and of d^2. The
+// shift is the first element of the row, so that the sum of the squares
+// cancels less than with d = x.
+static inline void ln_stats(float sum, float sq, float shift, uint64_t cols,
+                            int steps, float *mean, float *rstd) {
+  const float mean_d = sum / cols;
+  const float var = sq / cols - mean_d * mean_d;
+  *mean = shift + mean_d;
+  *rstd = ln_rsqrt((var > 0 ? var : 0) + LAYERNORM_EPS, steps);
+}
+
+void layernorm_f32(const float *x, const float *gamma, const float *beta,
+                   float *y, uint64_t rows, uint64_t cols) {
+  size_t vl;
+
+  for (uint64_t r = 0; r < rows; ++r) {
+    const float *x_ = x + r * cols;
+    float *y_ = y + r * cols;
+    const float shift = x_[0];
+
+    vfloat32m1_t sum_v = vfmv_v_f_f32m1(0, 1);
+    vfloat32m1_t sq_v = vfmv_v_f_f32m1(0, 1);
+
+    /*
+      Sums of d and d^2, in two accumulators
+    */
+
+    uint64_t c = 0;
+    if (cols >= LN_VLMAX) {
+      vl = vsetvl_e32m8(LN_VLMAX);
+      vfloat32m8_t sum_acc = vfmv_v_f_f32m8(0, vl);
+      vfloat32m8_t sq_acc = vfmv_v_f_f32m8(0, vl);
+      for (; c + LN_VLMAX <= cols; c += LN_VLMAX) {
+        vfloat32m8_t d = vfsub_vf_f32m8(vle32_v_f32m8(x_ + c, vl), shift, vl);
+        sum_acc = vfadd_vv_f32m8(sum_acc, d, vl);
+        sq_acc = vfmacc_vv_f32m8(sq_acc, d, d, vl);
+      }
+      sum_v = vfredusum_vs_f32m8_f32m1(sum_v, sum_acc, sum_v, vl);
+      sq_v = vfredusum_vs_f32m8_f32m1(sq_v, sq_acc, sq_v, vl);
+    }
+    if (c < cols) {
+      vl = vsetvl_e32m8(cols - c);
+      vfloat32m8_t d = vfsub_vf_f32m8(vle32_v_f32m8(x_ + c, vl), shift, vl);
+      sum_v = vfredusum_vs_f32m8_f32m1(sum_v, d, sum_v, vl);
+      sq_v = vfredusum_vs_f32m8_f32m1(sq_v, vfmul_vv_f32m8(d, d, vl), sq_v,
+                                      vl);
+    }
+
+    float mean, rstd;
+    ln_stats(vfmv_f_s_f32m1_f32(sum_v), vfmv_f_s_f32m1_f32(sq_v), shift, cols,
+             LN_RSQRT_STEPS_32, &mean, &rstd);
+
+    /*
+      y = (x - mean) * rstd * gamma + beta
+    */
+
+    for (c = 0; c < cols; c += vl) {
+      vl = vsetvl_e32m8(cols - c);
+      vfloat32m8_t t = vfsub_vf_f32m8(vle32_v_f32m8(x_ + c, vl), mean, vl);
+      t = vfmul_vf_f32m8(t, rstd, vl);
+      t = vfmadd_vv_f32m8(t, vle32_v_f32m8(gamma + c, vl),
+                          vle32_v_f32m8(beta + c, vl), vl);
+      vse32_v_f32m8(y_ + c, t, vl);
+    }
+  }
+}
+
+// The statistics are accumulated in FP32, with widening subtractions
+void layernorm_f16(const _Float16 *x, const _Float16 *gamma,
+                   const _Float16 *beta, _Float16 *y, uint64_t rows,
+                   uint64_t cols) {
+  size_t vl;
+
+  for (uint64_t r = 0; r < rows; ++r) {
+    const _Float16 *x_ = x + r * cols;
+    _Float16 *y_ = y + r * cols;
+    const _Float16 shift = x_[0];
+
+    vfloat32m1_t sum_v = vfmv_v_f_f32m1(0, 1);
+    vfloat32m1_t sq_v = vfmv_v_f_f32m1(0, 1);
+
+    uint64_t c = 0;
+    if (cols >= LN_VLMAX) {
+      vl = vsetvl_e16m4(LN_VLMAX);
+      vfloat32m8_t sum_acc = vfmv_v_f_f32m8(0, vl);
+      vfloat32m8_t sq_acc = vfmv_v_f_f32m8(0, vl);
+      for (; c + LN_VLMAX <= cols; c += LN_VLMAX) {
+        vfloat32m8_t d = vfwsub_vf_f32m8(vle16_v_f16m4(x_ + c, vl), shift, vl);
+        sum_acc = vfadd_vv_f32m8(sum_acc, d, vl);
+        sq_acc = vfmacc_vv_f32m8(sq_acc, d, d, vl);
+      }
+      sum_v = vfredusum_vs_f32m8_f32m1(sum_v, sum_acc, sum_v, vl);
+      sq_v = vfredusum_vs_f32m8_f32m1(sq_v, sq_acc, sq_v, vl);
+    }
+    if (c < cols) {
+      vl = vsetvl_e16m4(cols - c);
+      vfloat32m8_t d = vfwsub_vf_f32m8(vle16_v_f16m4(x_ + c, vl), shift, vl);
+      sum_v = vfredusum_vs_f32m8_f32m1(sum_v, d, sum_v, vl);
+      sq_v = vfredusum_vs_f32m8_f32m1(sq_v, vfmul_vv_f32m8(d, d, vl), sq_v,
+                                      vl);
+    }
+
+    float mean, rstd;
+    ln_stats(vfmv_f_s_f32m1_f32(sum_v), vfmv_f_s_f32m1_f32(sq_v), shift, cols,
+             LN_RSQRT_STEPS_16, &mean, &rstd);
+    const _Float16 mean_h = mean;
+    const _Float16 rstd_h = rstd;
+
+    for (c = 0; c < cols; c += vl) {
+      vl = vsetvl_e16m8(cols - c);
+      vfloat16m8_t t = vfsub_vf_f16m8(vle16_v_f16m8(x_ + c, vl), mean_h, vl);
+      t = vfmul_vf_f16m8(t, rstd_h, vl);
+      t = vfmadd_vv_f16m8(t, vle16_v_f16m8(gamma + c, vl),
+                          vle16_v_f16m8(beta + c, vl), vl);
+      vse16_v_f16m8(y_ + c, t, vl);
+    }
+  }
+}
+
+void rmsnorm_f32(const float *x, const float *gamma, float *y, uint64_t rows,
+                 uint64_t cols) {
+  size_t vl;
+
+  for (uint64_t r = 0; r < rows; ++r) {
+    const float *x_ = x + r * cols;
+    float *y_ = y + r * cols;
+
+    vfloat32m1_t sq_v = vfmv_v_f_f32m1(0, 1);
+
+    uint64_t c = 0;
+    if (cols >= LN_VLMAX) {
+      vl = vsetvl_e32m8(LN_VLMAX);
+      vfloat32m8_t sq_acc = vfmv_v_f_f32m8(0, vl);
+      for (; c + LN_VLMAX <= cols; c += LN_VLMAX) {
+        vfloat32m8_t x_v = vle32_v_f32m8(x_ + c, vl);
+        sq_acc = vfmacc_vv_f32m8(sq_acc, x_v, x_v, vl);
+      }
+      sq_v = vfredusum_vs_f32m8_f32m1(sq_v, sq_acc, sq_v, vl);
+    }
+    if (c < cols) {
+      vl = vsetvl_e32m8(cols - c);
+      vfloat32m8_t x_v = vle32_v_f32m8(x_ + c, vl);
+      sq_v = vfredusum_vs_f32m8_f32m1(sq_v, vfmul_vv_f32m8(x_v, x_v, vl), sq_v,
+                                      vl);
+    }
+
+    const float rstd = ln_rsqrt(vfmv_f_s_f32m1_f32(sq_v) / cols + LAYERNORM_EPS,
+                                LN_RSQRT_STEPS_32);
+
+    /*
+      y = x * rstd * gamma
+    */
+
+    for (c = 0; c < cols; c += vl) {
+      vl = vsetvl_e32m8(cols - c);
+      vfloat32m8_t t = vfmul_vf_f32m8(vle32_v_f32m8(x_ + c, vl), rstd, vl);
+      t = vfmul_vv_f32m8(t, vle32_v_f32m8(gamma + c, vl), vl);
+      vse32_v_f32m8(y_ + c, t, vl);
+    }
+  }
+}
+
+// The sum of the squares is accumulated in FP32, with widening multiply-adds
+void rmsnorm_f16(const _Float16 *x, const _Float16 *gamma, _Float16 *y,
+                 uint64_t rows, uint64_t cols) {
+  size_t vl;
+
+  for (uint64_t r = 0; r < rows; ++r) {
+    const _Float16 *x_ = x + r * cols;
+    _Float16 *y_ = y + r * cols;
+
+    vfloat32m1_t sq_v = vfmv_v_f_f32m1(0, 1);
+
+    uint64_t c = 0;
+    if (cols >= LN_VLMAX) {
+      vl = vsetvl_e16m4(LN_VLMAX);
+      vfloat32m8_t sq_acc = vfmv_v_f_f32m8(0, vl);
+      for (; c + LN_VLMAX <= cols; c += LN_VLMAX) {
+        vfloat16m4_t x_v = vle16_v_f16m4(x_ + c, vl);
+        sq_acc = vfwmacc_vv_f32m8(sq_acc, x_v, x_v, vl);
+      }
+      sq_v = vfredusum_vs_f32m8_f32m1(sq_v, sq_acc, sq_v, vl);
+    }
+    if (c < cols) {
+      vl = vsetvl_e16m4(cols - c);
+      vfloat16m4_t x_v = vle16_v_f16m4(x_ + c, vl);
+      sq_v = vfredusum_vs_f32m8_f32m1(sq_v, vfwmul_vv_f32m8(x_v, x_v, vl),
+                                      sq_v, vl);
+    }
+
+    const _Float16 rstd_h = ln_rsqrt(
+        vfmv_f_s_f32m1_f32(sq_v) / cols + LAYERNORM_EPS, LN_RSQRT_STEPS_16);
+
+    for (c = 0; c < cols; c += vl) {
+      vl = vsetvl_e16m8(cols - c);
+      vfloat16m8_t t = vfmul_vf_f16m8(vle16_v_f16m8(x_ + c, vl), rstd_h, vl);
+      t = vfmul_vv_f16m8(t, vle16_v_f16m8(gamma + c, vl), vl);
+      vse16_v_f16m8(y_ + c, t, vl);
+    }
+  }
+}
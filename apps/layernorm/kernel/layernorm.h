@@ -0,0 +1,44 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Layer normalization and RMSNorm over the last axis of a rows x cols
+// row-major matrix, in FP32 and FP16:
+//   layernorm: y = (x - mean) / sqrt(var + eps) * gamma + beta
+//   rmsnorm:   y = x / sqrt(mean(x^2) + eps) * gamma
+// The statistics of a row are computed in one pass, in FP32 also for the FP16
+// kernels, and the normalization is fused with gamma and beta.
+
+#ifndef _LAYERNORM_H_
+#define _LAYERNORM_H_
+
+#include <stdint.h>
+
+#include "riscv_vector.h"
+
+#define LAYERNORM_EPS 1e-5f
+
+void layernorm_f32(const float *x, const float *gamma, const float *beta,
+                   float *y, uint64_t rows, uint64_t cols);
+void layernorm_f16(const _Float16 *x, const _Float16 *gamma,
+                   const _Float16 *beta, _Float16 *y, uint64_t rows,
+                   uint64_t cols);
+
+void rmsnorm_f32(const float *x, const float *gamma, float *y, uint64_t rows,
+                 uint64_t cols);
+void rmsnorm_f16(const _Float16 *x, const _Float16 *gamma, _Float16 *y,
+                 uint64_t rows, uint64_t cols);
+
+#endif
@@ -0,0 +1,93 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdint.h>
+#include <string.h>
+
+#include "kernel/layernorm.h"
+#include "runtime.h"
+#include "util.h"
+#include "vcheck.h"
+
+#ifndef SPIKE
+#include "printf.h"
+#else
+#include <stdio.h>
+#endif
+
+#define THRESHOLD_F32 0.0001
+#define THRESHOLD_F16 0.02
+
+extern uint64_t rows;
+extern uint64_t cols;
+
+extern float x32[] __attribute__((aligned(4 * NR_LANES)));
+extern float gamma32[] __attribute__((aligned(4 * NR_LANES)));
+extern float beta32[] __attribute__((aligned(4 * NR_LANES)));
+extern float y32[] __attribute__((aligned(4 * NR_LANES)));
+extern float gold_ln32[] __attribute__((aligned(4 * NR_LANES)));
+extern float gold_rms32[] __attribute__((aligned(4 * NR_LANES)));
+
+extern _Float16 x16[] __attribute__((aligned(4 * NR_LANES)));
+extern _Float16 gamma16[] __attribute__((aligned(4 * NR_LANES)));
+extern _Float16 beta16[] __attribute__((aligned(4 * NR_LANES)));
+extern _Float16 y16[] __attribute__((aligned(4 * NR_LANES)));
+extern _Float16 gold_ln16[] __attribute__((aligned(4 * NR_LANES)));
+extern _Float16 gold_rms16[] __attribute__((aligned(4 * NR_LANES)));
+
+static int report(const char *name, int64_t idx) {
+  printf("The %s execution took %ld cycles.\n", name, get_timer());
+  return vcheck_report(name, idx);
+}
+
+int main() {
+  printf("\n");
+  printf("===============\n");
+  printf("=  LAYERNORM  =\n");
+  printf("===============\n");
+  printf("\n");
+  printf("\n");
+
+  printf("Rows: %lu\nColumns: %lu\n", rows, cols);
+
+  int error = 0;
+
+  start_timer();
+  layernorm_f32(x32, gamma32, beta32, y32, rows, cols);
+  stop_timer();
+  error |= report("layernorm_f32",
+                  vcheck_f32(y32, gold_ln32, rows * cols, THRESHOLD_F32));
+
+  start_timer();
+  rmsnorm_f32(x32, gamma32, y32, rows, cols);
+  stop_timer();
+  error |= report("rmsnorm_f32",
+                  vcheck_f32(y32, gold_rms32, rows * cols, THRESHOLD_F32));
+
+  start_timer();
+  layernorm_f16(x16, gamma16, beta16, y16, rows, cols);
+  stop_timer();
+  error |= report("layernorm_f16",
+                  vcheck_f16(y16, gold_ln16, rows * cols, THRESHOLD_F16));
+
+  start_timer();
+  rmsnorm_f16(x16, gamma16, y16, rows, cols);
+  stop_timer();
+  error |= report("rmsnorm_f16",
+                  vcheck_f16(y16, gold_rms16, rows * cols, THRESHOLD_F16));
+
+  return error;
+}
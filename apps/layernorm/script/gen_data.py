@@ -0,0 +1,77 @@
+#!/usr/bin/env python3
+# Copyright 2022 ETH Zurich and University of Bologna.
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+# arg1: rows, arg2: columns
+
+import numpy as np
+import os
+import sys
+
+# Same as in kernel/layernorm.h
+EPS = 1e-5
+
+sys.path.insert(0, os.path.join(os.path.dirname(__file__), '../../common/script'))
+from data_emit import emit
+
+def layernorm(x, gamma, beta):
+  x = x.astype(np.float64)
+  mean = x.mean(axis=1, keepdims=True)
+  var = x.var(axis=1, keepdims=True)
+  return (x - mean) / np.sqrt(var + EPS) * gamma + beta
+
+def rmsnorm(x, gamma):
+  x = x.astype(np.float64)
+  return x / np.sqrt((x * x).mean(axis=1, keepdims=True) + EPS) * gamma
+
+############
+## SCRIPT ##
+############
+
+if len(sys.argv) == 3:
+  rows = int(sys.argv[1])
+  cols = int(sys.argv[2])
+else:
+  print("Error. Give me two arguments: the number of rows and of columns.")
+  sys.exit()
+
+# Activations with a non-zero mean, and per-column scales and offsets
+x = (np.random.randn(rows, cols) + 1).astype(np.float32)
+gamma = (np.random.rand(cols) + 0.5).astype(np.float32)
+beta = (np.random.rand(cols) - 0.5).astype(np.float32)
+
+x16 = x.astype(np.float16)
+gamma16 = gamma.astype(np.float16)
+beta16 = beta.astype(np.float16)
+
+# Create the file
+print(".section .data,\"aw\",@progbits")
+emit("rows", np.array(rows, dtype=np.uint64))
+emit("cols", np.array(cols, dtype=np.uint64))
+
+emit("x32", x, 'NR_LANES*4')
+emit("gamma32", gamma, 'NR_LANES*4')
+emit("beta32", beta, 'NR_LANES*4')
+emit("y32", np.zeros(rows * cols, dtype=np.float32), 'NR_LANES*4')
+emit("gold_ln32", layernorm(x, gamma, beta).astype(np.float32), 'NR_LANES*4')
+emit("gold_rms32", rmsnorm(x, gamma).astype(np.float32), 'NR_LANES*4')
+
+emit("x16", x16, 'NR_LANES*4')
+emit("gamma16", gamma16, 'NR_LANES*4')
+emit("beta16", beta16, 'NR_LANES*4')
+emit("y16", np.zeros(rows * cols, dtype=np.float16), 'NR_LANES*4')
+emit("gold_ln16", layernorm(x16, gamma16, beta16).astype(np.float16), 'NR_LANES*4')
+emit("gold_rms16", rmsnorm(x16, gamma16).astype(np.float16), 'NR_LANES*4')
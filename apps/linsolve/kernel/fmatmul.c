@@ -0,0 +1 @@
+../../fmatmul/kernel/fmatmul.c
\ No newline at end of file
@@ -0,0 +1,295 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "linsolve.h"
+#include "fmatmul.h"
+#include "vblas1/vblas1.h"
+
+#define MIN(a, b) ((a) < (b) ? (a) : (b))
+
+// sqrt on the FPU of CVA6, with no call to libm
+static inline double linsolve_sqrt(double x) {
+  double r;
+  asm volatile("fsqrt.d %0, %1" : "=f"(r) : "f"(x));
+  return r;
+}
+
+static double linsolve_dot(const double *x, const double *y, uint64_t n) {
+  vfloat64m1_t red = vfmv_v_f_f64m1(0, 1);
+  size_t vl;
+
+  for (; n > 0; n -= vl) {
+    vl = vsetvl_e64m8(n);
+    vfloat64m8_t p =
+        vfmul_vv_f64m8(vle64_v_f64m8(x, vl), vle64_v_f64m8(y, vl), vl);
+    red = vfredusum_vs_f64m8_f64m1(red, p, red, vl);
+    x += vl;
+    y += vl;
+  }
+
+  return vfmv_f_s_f64m1_f64(red);
+}
+
+static void linsolve_swap(double *x, double *y, uint64_t n) {
+  size_t vl;
+
+  for (; n > 0; n -= vl) {
+    vl = vsetvl_e64m8(n);
+    vfloat64m8_t t = vle64_v_f64m8(x, vl);
+    vse64_v_f64m8(x, vle64_v_f64m8(y, vl), vl);
+    vse64_v_f64m8(y, t, vl);
+    x += vl;
+    y += vl;
+  }
+}
+
+// Scale the column of m elements at col by s, and gather it into t, where the
+// rank-1 updates read its scalars from
+static void linsolve_scal_col(double *col, double *t, uint64_t m, uint64_t lda,
+                              double s) {
+  const ptrdiff_t stride = lda * sizeof(double);
+  size_t vl;
+
+  for (; m > 0; m -= vl) {
+    vl = vsetvl_e64m8(m);
+    vfloat64m8_t v = vfmul_vf_f64m8(vlse64_v_f64m8(col, stride, vl), s, vl);
+    vsse64_v_f64m8(col, stride, v, vl);
+    vse64_v_f64m8(t, v, vl);
+    col += vl * lda;
+    t += vl;
+  }
+}
+
+// Unblocked right-looking Cholesky of the n x n diagonal block at a, with the
+// rank-1 updates on the rows of its lower triangle
+static int linsolve_potf2(double *a, uint64_t n, uint64_t lda, double *t) {
+  for (uint64_t j = 0; j < n; ++j) {
+    double d = a[j * lda + j];
+    if (!(d > 0))
+      return j + 1;
+    d = linsolve_sqrt(d);
+    a[j * lda + j] = d;
+
+    const uint64_t m = n - j - 1;
+    linsolve_scal_col(a + (j + 1) * lda + j, t, m, lda, 1 / d);
+    for (uint64_t i = 0; i < m; ++i)
+      daxpy(i + 1, -t[i], t, 1, a + (j + 1 + i) * lda + j + 1, 1);
+  }
+
+  return 0;
+}
+
+int cholesky(double *a, uint64_t n, uint64_t lda, double *work) {
+  for (uint64_t k = 0; k < n; k += LINSOLVE_NB) {
+    const uint64_t kb = MIN(n - k, LINSOLVE_NB);
+    double *akk = a + k * lda + k;
+
+    const int info = linsolve_potf2(akk, kb, lda, work);
+    if (info)
+      return k + info;
+
+    const uint64_t m = n - k - kb;
+    if (!m)
+      break;
+
+    // L21^T = L11^-1 A21^T, on the transposed panel in work
+    double *a21 = akk + kb * lda;
+    for (uint64_t j = 0; j < kb; ++j)
+      dcopy(m, a21 + j, lda, work + j * m, 1);
+    trsm_ln(akk, work, kb, m, lda, m, 0);
+    // Store L21, and keep -L21^T for the update
+    for (uint64_t j = 0; j < kb; ++j) {
+      dcopy(m, work + j * m, 1, a21 + j, lda);
+      dscal(m, -1, work + j * m, 1);
+    }
+
+    // A22 -= L21 L21^T, on each block of rows up to its diagonal
+    double *a22 = a21 + kb;
+    for (uint64_t r = 0; r < m; r += LINSOLVE_NB) {
+      const uint64_t rb = MIN(m - r, LINSOLVE_NB);
+      fmatmul_tiled_acc(a22 + r * lda, a21 + r * lda, work, rb, kb, r + rb,
+                        lda, m, lda);
+    }
+  }
+
+  return 0;
+}
+
+// The rows are swapped in full, so that no swap is left for the columns of
+// the other blocks. The pivot is the first maximum |a[i][j]|, with vfredmax
+// (idamax) on the strided column.
+int lu(double *a, uint64_t *piv, uint64_t n, uint64_t lda, double *work) {
+  int info = 0;
+
+  for (uint64_t k = 0; k < n; k += LINSOLVE_NB) {
+    const uint64_t kb = MIN(n - k, LINSOLVE_NB);
+
+    // Unblocked LU of the panel of columns k..k+kb-1
+    for (uint64_t j = k; j < k + kb; ++j) {
+      const uint64_t p = j + idamax(n - j, a + j * lda + j, lda);
+      piv[j] = p;
+      if (p != j)
+        linsolve_swap(a + j * lda, a + p * lda, n);
+
+      const double d = a[j * lda + j];
+      if (d == 0) {
+        // The column below is zero as well
+        if (!info)
+          info = j + 1;
+        continue;
+      }
+
+      const uint64_t m = n - j - 1;
+      linsolve_scal_col(a + (j + 1) * lda + j, work, m, lda, 1 / d);
+      for (uint64_t i = 0; i < m; ++i)
+        daxpy(k + kb - j - 1, -work[i], a + j * lda + j + 1, 1,
+              a + (j + 1 + i) * lda + j + 1, 1);
+    }
+
+    const uint64_t m = n - k - kb;
+    if (!m)
+      break;
+
+    // U12 = L11^-1 A12, in place
+    double *akk = a + k * lda + k;
+    trsm_ln(akk, akk + kb, kb, m, lda, lda, 1);
+
+    // A22 -= L21 U12, with -U12 in work
+    for (uint64_t j = 0; j < kb; ++j) {
+      dcopy(m, akk + j * lda + kb, 1, work + j * m, 1);
+      dscal(m, -1, work + j * m, 1);
+    }
+    fmatmul_tiled_acc(akk + kb * lda + kb, akk + kb * lda, work, m, kb, m, lda,
+                      m, lda);
+  }
+
+  return info;
+}
+
+int cholesky_scalar(double *a, uint64_t n, uint64_t lda) {
+  for (uint64_t j = 0; j < n; ++j) {
+    double d = a[j * lda + j];
+    if (!(d > 0))
+      return j + 1;
+    d = linsolve_sqrt(d);
+    a[j * lda + j] = d;
+
+    for (uint64_t i = j + 1; i < n; ++i)
+      a[i * lda + j] /= d;
+    for (uint64_t i = j + 1; i < n; ++i)
+      for (uint64_t c = j + 1; c <= i; ++c)
+        a[i * lda + c] -= a[i * lda + j] * a[c * lda + j];
+  }
+
+  return 0;
+}
+
+int lu_scalar(double *a, uint64_t *piv, uint64_t n, uint64_t lda) {
+  int info = 0;
+
+  for (uint64_t j = 0; j < n; ++j) {
+    uint64_t p = j;
+    double max = -1;
+    for (uint64_t i = j; i < n; ++i) {
+      const double v = a[i * lda + j] < 0 ? -a[i * lda + j] : a[i * lda + j];
+      if (v > max) {
+        max = v;
+        p = i;
+      }
+    }
+    piv[j] = p;
+    if (p != j)
+      for (uint64_t c = 0; c < n; ++c) {
+        const double t = a[j * lda + c];
+        a[j * lda + c] = a[p * lda + c];
+        a[p * lda + c] = t;
+      }
+
+    const double d = a[j * lda + j];
+    if (d == 0) {
+      if (!info)
+        info = j + 1;
+      continue;
+    }
+
+    for (uint64_t i = j + 1; i < n; ++i)
+      a[i * lda + j] /= d;
+    for (uint64_t i = j + 1; i < n; ++i)
+      for (uint64_t c = j + 1; c < n; ++c)
+        a[i * lda + c] -= a[i * lda + j] * a[j * lda + c];
+  }
+
+  return info;
+}
+
+void cholesky_solve(const double *a, double *x, uint64_t n, uint64_t lda) {
+  trsv_ln(a, x, n, lda, 0);
+  trsv_lt(a, x, n, lda);
+}
+
+void lu_solve(const double *a, const uint64_t *piv, double *x, uint64_t n,
+              uint64_t lda) {
+  for (uint64_t i = 0; i < n; ++i) {
+    const double t = x[i];
+    x[i] = x[piv[i]];
+    x[piv[i]] = t;
+  }
+  trsv_ln(a, x, n, lda, 1);
+  trsv_un(a, x, n, lda);
+}
+
+// By rows, with a dot product on the unit-stride row of a per element
+void trsv_ln(const double *a, double *x, uint64_t n, uint64_t lda, int unit) {
+  for (uint64_t i = 0; i < n; ++i) {
+    const double s = x[i] - linsolve_dot(a + i * lda, x, i);
+    x[i] = unit ? s : s / a[i * lda + i];
+  }
+}
+
+void trsv_un(const double *a, double *x, uint64_t n, uint64_t lda) {
+  for (uint64_t i = n; i-- > 0;) {
+    const double *ai = a + i * lda;
+    x[i] = (x[i] - linsolve_dot(ai + i + 1, x + i + 1, n - i - 1)) / ai[i];
+  }
+}
+
+// By columns of a^T, i.e., with an axpy on the unit-stride row of a per element
+void trsv_lt(const double *a, double *x, uint64_t n, uint64_t lda) {
+  for (uint64_t j = n; j-- > 0;) {
+    x[j] /= a[j * lda + j];
+    daxpy(j, -x[j], a + j * lda, 1, x, 1);
+  }
+}
+
+// By rows of b, on strips of its columns that stay in the VRF until each row
+// is solved
+void trsm_ln(const double *a, double *b, uint64_t n, uint64_t nrhs,
+             uint64_t lda, uint64_t ldb, int unit) {
+  size_t vl;
+
+  for (uint64_t c = 0; c < nrhs; c += vl) {
+    vl = vsetvl_e64m8(nrhs - c);
+    for (uint64_t i = 0; i < n; ++i) {
+      vfloat64m8_t v = vle64_v_f64m8(b + i * ldb + c, vl);
+      for (uint64_t j = 0; j < i; ++j)
+        v = vfnmsac_vf_f64m8(v, a[i * lda + j],
+                             vle64_v_f64m8(b + j * ldb + c, vl), vl);
+      if (!unit)
+        v = vfmul_vf_f64m8(v, 1 / a[i * lda + i], vl);
+      vse64_v_f64m8(b + i * ldb + c, v, vl);
+    }
+  }
+}
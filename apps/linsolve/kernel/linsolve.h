@@ -0,0 +1,63 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Dense FP64 factorizations and triangular solves, for the small systems
+// (n = 32 to 256) of, e.g., Kalman filters. The matrices are n x n and stored
+// by rows with leading dimension lda.
+//  - cholesky: A = L L^T of an SPD matrix. L overwrites the lower triangle of
+//    A, and the strictly upper one is not referenced.
+//  - lu: P A = L U with partial pivoting, with the unit L and U in place of A.
+//    Row j was swapped with row piv[j] > j, after the swaps of rows 0..j-1.
+// Both are right-looking and blocked by LINSOLVE_NB columns: the diagonal
+// blocks and the panels are factorized with vectors, and the trailing matrix
+// is updated with the fmatmul micro-kernels (fmatmul_tiled_acc). work holds
+// LINSOLVE_NB * n doubles, for the panel of the rank-k update.
+// They return 0, or j + 1 if the leading minor of order j + 1 is not positive
+// definite (cholesky), or if U[j][j] is exactly 0 (lu, which completes the
+// factorization as LAPACK does).
+// The _scalar versions are the unblocked references, on the scalar core.
+
+#ifndef _LINSOLVE_H_
+#define _LINSOLVE_H_
+
+#include <stdint.h>
+
+#include "riscv_vector.h"
+
+#ifndef LINSOLVE_NB
+#define LINSOLVE_NB 32
+#endif
+
+int cholesky(double *a, uint64_t n, uint64_t lda, double *work);
+int cholesky_scalar(double *a, uint64_t n, uint64_t lda);
+int lu(double *a, uint64_t *piv, uint64_t n, uint64_t lda, double *work);
+int lu_scalar(double *a, uint64_t *piv, uint64_t n, uint64_t lda);
+
+// Solve A x = b in place of b, with the factors of cholesky or lu
+void cholesky_solve(const double *a, double *x, uint64_t n, uint64_t lda);
+void lu_solve(const double *a, const uint64_t *piv, double *x, uint64_t n,
+              uint64_t lda);
+
+// Triangular solves in place of x, or of the n x nrhs matrix b with leading
+// dimension ldb, with the lower (l) or upper (u) triangle of a, not
+// transposed (n) or transposed (t). unit takes the diagonal as 1.
+void trsv_ln(const double *a, double *x, uint64_t n, uint64_t lda, int unit);
+void trsv_lt(const double *a, double *x, uint64_t n, uint64_t lda);
+void trsv_un(const double *a, double *x, uint64_t n, uint64_t lda);
+void trsm_ln(const double *a, double *b, uint64_t n, uint64_t nrhs,
+             uint64_t lda, uint64_t ldb, int unit);
+
+#endif
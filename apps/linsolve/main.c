@@ -0,0 +1,123 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdint.h>
+#include <string.h>
+
+#include "bench.h"
+#include "kernel/linsolve.h"
+#include "runtime.h"
+#include "util.h"
+#include "vcheck.h"
+
+#ifndef SPIKE
+#include "printf.h"
+#else
+#include <stdio.h>
+#endif
+
+#define THRESHOLD 0.00000001
+
+extern uint64_t n;
+extern double spd[] __attribute__((aligned(4 * NR_LANES)));
+extern double gen[] __attribute__((aligned(4 * NR_LANES)));
+extern double b_spd[] __attribute__((aligned(4 * NR_LANES)));
+extern double b_gen[] __attribute__((aligned(4 * NR_LANES)));
+extern double gold_x[] __attribute__((aligned(4 * NR_LANES)));
+extern double gold_chol[] __attribute__((aligned(4 * NR_LANES)));
+extern double gold_lu[] __attribute__((aligned(4 * NR_LANES)));
+extern uint64_t gold_piv[] __attribute__((aligned(4 * NR_LANES)));
+extern double a[] __attribute__((aligned(4 * NR_LANES)));
+extern double x[] __attribute__((aligned(4 * NR_LANES)));
+extern uint64_t piv[] __attribute__((aligned(4 * NR_LANES)));
+extern double work[] __attribute__((aligned(4 * NR_LANES)));
+
+static int check_info(const char *name, int info) {
+  if (info) {
+    printf("%s: Error. The factorization failed at column %d.\n", name,
+           info - 1);
+    return 1;
+  }
+  return 0;
+}
+
+int main() {
+  printf("\n");
+  printf("==============\n");
+  printf("=  LINSOLVE  =\n");
+  printf("==============\n");
+  printf("\n");
+  printf("\n");
+
+  printf("Systems of %lu equations\n", n);
+
+  const uint64_t len = n * n;
+  int error = 0;
+  int info;
+
+  // Cholesky, n^3 / 3 FLOP
+  memcpy(a, spd, len * sizeof(double));
+  start_timer();
+  info = cholesky(a, n, n, work);
+  stop_timer();
+  bench_report_flops("cholesky", n * n * n / 3);
+  error |= check_info("cholesky", info);
+  error |= vcheck_report("cholesky", vcheck_f64(a, gold_chol, len, THRESHOLD));
+
+  memcpy(x, b_spd, n * sizeof(double));
+  start_timer();
+  cholesky_solve(a, x, n, n);
+  stop_timer();
+  bench_report_flops("cholesky_solve", 2 * n * n);
+  error |= vcheck_report("cholesky_solve", vcheck_f64(x, gold_x, n, THRESHOLD));
+
+  memcpy(a, spd, len * sizeof(double));
+  start_timer();
+  info = cholesky_scalar(a, n, n);
+  stop_timer();
+  bench_report_flops("cholesky_scalar", n * n * n / 3);
+  error |= check_info("cholesky_scalar", info);
+  error |= vcheck_report("cholesky_scalar",
+                         vcheck_f64(a, gold_chol, len, THRESHOLD));
+
+  // LU, 2 n^3 / 3 FLOP
+  memcpy(a, gen, len * sizeof(double));
+  start_timer();
+  info = lu(a, piv, n, n, work);
+  stop_timer();
+  bench_report_flops("lu", 2 * n * n * n / 3);
+  error |= check_info("lu", info);
+  error |= vcheck_report("lu", vcheck_f64(a, gold_lu, len, THRESHOLD));
+  error |= vcheck_report("lu pivots",
+                         vcheck_i64((int64_t *)piv, (int64_t *)gold_piv, n));
+
+  memcpy(x, b_gen, n * sizeof(double));
+  start_timer();
+  lu_solve(a, piv, x, n, n);
+  stop_timer();
+  bench_report_flops("lu_solve", 2 * n * n);
+  error |= vcheck_report("lu_solve", vcheck_f64(x, gold_x, n, THRESHOLD));
+
+  memcpy(a, gen, len * sizeof(double));
+  start_timer();
+  info = lu_scalar(a, piv, n, n);
+  stop_timer();
+  bench_report_flops("lu_scalar", 2 * n * n * n / 3);
+  error |= check_info("lu_scalar", info);
+  error |= vcheck_report("lu_scalar", vcheck_f64(a, gold_lu, len, THRESHOLD));
+
+  return error;
+}
@@ -0,0 +1,77 @@
+#!/usr/bin/env python3
+# Copyright 2022 ETH Zurich and University of Bologna.
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+# arg1: size of the systems
+# An SPD matrix for the Cholesky factorization, and a general one for LU
+
+import numpy as np
+import os
+import sys
+
+sys.path.insert(0, os.path.join(os.path.dirname(__file__), '../../common/script'))
+from data_emit import emit
+
+# P A = L U with partial pivoting, with the first maximum as the pivot, and
+# the rows swapped in full, as lu() and LAPACK getrf
+def lu(a):
+  a = a.copy()
+  n = a.shape[0]
+  piv = np.zeros(n, dtype=np.uint64)
+  for j in range(n):
+    p = j + np.argmax(np.abs(a[j:, j]))
+    piv[j] = p
+    a[[j, p], :] = a[[p, j], :]
+    a[j+1:, j] /= a[j, j]
+    a[j+1:, j+1:] -= np.outer(a[j+1:, j], a[j, j+1:])
+  return a, piv
+
+############
+## SCRIPT ##
+############
+
+if len(sys.argv) == 2:
+  n = int(sys.argv[1])
+else:
+  print("Error. Give me one argument: the size of the systems.")
+  sys.exit()
+
+m     = np.random.uniform(-1, 1, (n, n))
+spd   = m @ m.T + n * np.eye(n)
+gen   = np.random.uniform(-1, 1, (n, n))
+x     = np.random.uniform(-1, 1, n)
+
+# cholesky() leaves the strictly upper triangle of A as it is
+gold_chol = np.tril(np.linalg.cholesky(spd)) + np.triu(spd, 1)
+gold_lu, gold_piv = lu(gen)
+
+# Create the file
+print(".section .data,\"aw\",@progbits")
+emit("n", np.array(n, dtype=np.uint64))
+emit("spd", spd, 'NR_LANES*4')
+emit("gen", gen, 'NR_LANES*4')
+emit("b_spd", spd @ x, 'NR_LANES*4')
+emit("b_gen", gen @ x, 'NR_LANES*4')
+emit("gold_x", x, 'NR_LANES*4')
+emit("gold_chol", gold_chol, 'NR_LANES*4')
+emit("gold_lu", gold_lu, 'NR_LANES*4')
+emit("gold_piv", gold_piv, 'NR_LANES*4')
+# The matrix and the right-hand side to factorize and solve in place, and the
+# panel of the updates
+emit("a", np.zeros((n, n)), 'NR_LANES*4')
+emit("x", np.zeros(n), 'NR_LANES*4')
+emit("piv", np.zeros(n, dtype=np.uint64), 'NR_LANES*4')
+emit("work", np.zeros((n, n)), 'NR_LANES*4')
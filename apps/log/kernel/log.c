@@ -18,27 +18,55 @@
 
 #include "log.h"
 
-void log_1xf64_bmark(double *args, double *results, size_t len) {
+// Strip-mine loop over vmath_log with LMUL lmul. The full strips run with
+// vl = VLMAX, which does not depend on the loop, and the last strip is a tail.
+#define log_bmark_def_gen(DATA_TYPE, sew, lmul)                                \
+  void log_f##sew##lmul##_bmark(DATA_TYPE *args, DATA_TYPE *results,           \
+                                size_t len) {                                  \
+    const size_t vlmax = vsetvlmax_e##sew##lmul();                             \
+    vfloat##sew##lmul##_t log_vec, res_vec;                                    \
+                                                                               \
+    /* Full strips, with a loop-invariant vl */                                \
+    for (; len >= vlmax; len -= vlmax) {                                       \
+      log_vec = vle##sew##_v_f##sew##lmul(args, vlmax);                        \
+      res_vec = vmath_log_f##sew##lmul(log_vec, vlmax);                        \
+      vse##sew##_v_f##sew##lmul(results, res_vec, vlmax);                      \
+      args += vlmax;                                                           \
+      results += vlmax;                                                        \
+    }                                                                          \
+                                                                               \
+    /* Tail */                                                                 \
+    if (len) {                                                                 \
+      size_t vl = vsetvl_e##sew##lmul(len);                                    \
+      log_vec = vle##sew##_v_f##sew##lmul(args, vl);                           \
+      res_vec = vmath_log_f##sew##lmul(log_vec, vl);                           \
+      vse##sew##_v_f##sew##lmul(results, res_vec, vl);                         \
+    }                                                                          \
+  }
 
-  size_t avl = len;
-  vfloat64m1_t log_vec, res_vec;
+log_bmark_def_gen(double, 64, m1);
+log_bmark_def_gen(double, 64, m2);
+log_bmark_def_gen(double, 64, m4);
+log_bmark_def_gen(float, 32, m1);
+log_bmark_def_gen(float, 32, m2);
+log_bmark_def_gen(float, 32, m4);
 
+// The largest LMUL such that the temporaries of the kernel stay in the
+// register file
+void log_1xf64_bmark(double *args, double *results, size_t len) {
 #ifdef VCD_DUMP
   // Start dumping VCD
   event_trigger = +1;
 #endif
-  for (size_t vl = vsetvl_e64m1(avl); avl > 0; avl -= vl) {
-    // Strip-mine
-    vl = vsetvl_e64m1(avl);
-    // Load vector
-    log_vec = vle64_v_f64m1(args, vl);
-    // Compute
-    res_vec = __log_1xf64(log_vec, vl);
-    // Store
-    vse64_v_f64m1(results, res_vec, vl);
-    // Bump pointers
-    args += vl;
-    results += vl;
+  switch (VMATH_LOG_LMUL) {
+  case 1:
+    log_f64m1_bmark(args, results, len);
+    break;
+  case 2:
+    log_f64m2_bmark(args, results, len);
+    break;
+  default:
+    log_f64m4_bmark(args, results, len);
   }
 #ifdef VCD_DUMP
   // Stop dumping VCD
@@ -47,26 +75,19 @@ void log_1xf64_bmark(double *args, double *results, size_t len) {
 }
 
 void log_2xf32_bmark(float *args, float *results, size_t len) {
-
-  size_t avl = len;
-  vfloat32m1_t log_vec, res_vec;
-
 #ifdef VCD_DUMP
   // Start dumping VCD
   event_trigger = +1;
 #endif
-  for (size_t vl = vsetvl_e32m1(avl); avl > 0; avl -= vl) {
-    // Strip-mine
-    vl = vsetvl_e32m1(avl);
-    // Load vector
-    log_vec = vle32_v_f32m1(args, vl);
-    // Compute
-    res_vec = __log_2xf32(log_vec, vl);
-    // Store
-    vse32_v_f32m1(results, res_vec, vl);
-    // Bump pointers
-    args += vl;
-    results += vl;
+  switch (VMATH_LOG_LMUL) {
+  case 1:
+    log_f32m1_bmark(args, results, len);
+    break;
+  case 2:
+    log_f32m2_bmark(args, results, len);
+    break;
+  default:
+    log_f32m4_bmark(args, results, len);
   }
 #ifdef VCD_DUMP
   // Stop dumping VCD
@@ -22,6 +22,7 @@
 #include "kernel/log.h"
 #include "printf.h"
 #include "runtime.h"
+#include "trace.h"
 #include "util.h"
 
 #define THRESHOLD 1
@@ -75,15 +76,15 @@ int main() {
   for (uint64_t i = 0; i < N_f64; ++i) {
     if (!similarity_check(results_f64[i], gold_results_f64[i], THRESHOLD)) {
       error = 1;
-      printf("64-bit error at index %d. %f != %f\n", i, results_f64[i],
-             gold_results_f64[i]);
+      trace_mismatch(i, "64-bit error at index %d. %f != %f\n", i,
+                     results_f64[i], gold_results_f64[i]);
     }
   }
   for (uint64_t i = 0; i < N_f32; ++i) {
     if (!similarity_check(results_f32[i], gold_results_f32[i], THRESHOLD)) {
       error = 1;
-      printf("32-bit error at index %d. %f != %f\n", i, results_f32[i],
-             gold_results_f32[i]);
+      trace_mismatch(i, "32-bit error at index %d. %f != %f\n", i,
+                     results_f32[i], gold_results_f32[i]);
     }
   }
 #endif
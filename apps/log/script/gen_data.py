@@ -19,18 +19,11 @@
 
 import random as rand
 import numpy as np
+import os
 import sys
 
-def emit(name, array, alignment='8'):
-  print(".global %s" % name)
-  print(".balign " + alignment)
-  print("%s:" % name)
-  bs = array.tobytes()
-  for i in range(0, len(bs), 4):
-    s = ""
-    for n in range(4):
-      s += "%02x" % bs[i+3-n]
-    print("    .word 0x%s" % s)
+sys.path.insert(0, os.path.join(os.path.dirname(__file__), '../../common/script'))
+from data_emit import emit, golden
 
 def rand_matrix(N, dtype):
   return np.random.rand(N).astype(dtype)
@@ -68,3 +61,8 @@ emit("N_f32", np.array(N_f32, dtype=np.uint32))
 emit("args_f32", args_f32, 'NR_LANES*4')
 emit("results_f32", results_f32, 'NR_LANES*4')
 emit("gold_results_f32", gold_results_f32, 'NR_LANES*4')
+
+# Check the results at the end of a simulation with golden=1, with the THRESHOLD
+# of main.c
+golden("results_f64", gold_results_f64, atol=1)
+golden("results_f32", gold_results_f32, atol=1)
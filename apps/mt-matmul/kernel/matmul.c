@@ -0,0 +1,42 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "matmul.h"
+
+void imatmul_rows(int64_t *c, const int64_t *a, const int64_t *b, uint64_t m,
+                  uint64_t n, uint64_t p) {
+  uint64_t vl;
+
+  // Stripmine the columns of C
+  for (uint64_t j = 0; j < p; j += vl) {
+    asm volatile("vsetvli %0, %1, e64, m4, ta, ma" : "=r"(vl) : "r"(p - j));
+
+    for (uint64_t i = 0; i < m; ++i) {
+      const int64_t *a_ = a + i * n;
+      const int64_t *b_ = b + j;
+
+      // c[i][j:j+vl] = sum_k a[i][k] * b[k][j:j+vl]
+      asm volatile("vmv.v.i v0, 0");
+      for (uint64_t k = 0; k < n; ++k) {
+        asm volatile("vle64.v v8, (%0)" ::"r"(b_));
+        asm volatile("vmacc.vx v0, %0, v8" ::"r"(a_[k]));
+        b_ += p;
+      }
+      asm volatile("vse64.v v0, (%0)" ::"r"(c + i * p + j));
+    }
+  }
+}
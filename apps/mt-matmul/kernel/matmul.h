@@ -0,0 +1,27 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef _MATMUL_H_
+#define _MATMUL_H_
+
+#include <stdint.h>
+
+// C = AB with A=[MxN], B=[NxP], C=[MxP], on the m rows of C and A
+void imatmul_rows(int64_t *c, const int64_t *a, const int64_t *b, uint64_t m,
+                  uint64_t n, uint64_t p);
+
+#endif
@@ -0,0 +1,98 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Port of the mt-matmul benchmark of riscv-tests. Each of the NR_CORES harts
+// computes a block of rows of C with its Ara.
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "kernel/matmul.h"
+#include "runtime.h"
+#include "sync.h"
+#include "util.h"
+
+#ifndef SPIKE
+#include "printf.h"
+#endif
+
+// Define Matrix dimensions:
+// C = AB with A=[MxN], B=[NxP], C=[MxP]
+extern uint64_t M;
+extern uint64_t N;
+extern uint64_t P;
+
+extern int64_t a[] __attribute__((aligned(32 * NR_LANES), section(".l2")));
+extern int64_t b[] __attribute__((aligned(32 * NR_LANES), section(".l2")));
+extern int64_t c[] __attribute__((aligned(32 * NR_LANES), section(".l2")));
+// Gold results
+extern int64_t g[] __attribute__((aligned(32 * NR_LANES), section(".l2")));
+
+// Compute the block of rows of the hart id
+void matmul_block(int id, int nr_harts) {
+  const uint64_t block = M / nr_harts;
+  const uint64_t start = id * block;
+  const uint64_t rows = (id == nr_harts - 1) ? M - start : block;
+
+  imatmul_rows(c + start * P, a + start * N, b, rows, N, P);
+}
+
+void thread_main(int id, int nr_harts) {
+  barrier();
+  matmul_block(id, nr_harts);
+  barrier();
+}
+
+int main() {
+  printf("\n");
+  printf("===============\n");
+  printf("=  MT-MATMUL  =\n");
+  printf("===============\n");
+  printf("\n");
+  printf("\n");
+
+  printf("Calculating a (%d x %d) x (%d x %d) matrix multiplication on %d "
+         "harts...\n",
+         M, N, N, P, NR_CORES);
+
+  barrier();
+  start_timer();
+  matmul_block(0, NR_CORES);
+  barrier();
+  stop_timer();
+
+  // Metrics
+  int64_t runtime = get_timer();
+  float performance = 2.0 * M * N * P / runtime;
+  float utilization = 100 * performance / (2.0 * NR_CORES * NR_LANES);
+
+  printf("The execution took %d cycles.\n", runtime);
+  printf("The performance is %f OP/cycle (%f%% utilization).\n", performance,
+         utilization);
+
+  printf("Verifying result...\n");
+  for (uint64_t i = 0; i < M * P; ++i) {
+    if (c[i] != g[i]) {
+      printf("Error: c[%d] = %d, g[%d] = %d\n", i, c[i], i, g[i]);
+      return i + 1;
+    }
+  }
+  printf("Passed.\n");
+
+  return 0;
+}
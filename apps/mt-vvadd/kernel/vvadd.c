@@ -0,0 +1,34 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "vvadd.h"
+
+void fvvadd64(double *c, const double *a, const double *b, uint64_t avl) {
+  uint64_t vl;
+
+  // Stripmine
+  for (; avl > 0; avl -= vl) {
+    asm volatile("vsetvli %0, %1, e64, m8, ta, ma" : "=r"(vl) : "r"(avl));
+    asm volatile("vle64.v v0, (%0)" ::"r"(a));
+    asm volatile("vle64.v v8, (%0)" ::"r"(b));
+    asm volatile("vfadd.vv v16, v0, v8");
+    asm volatile("vse64.v v16, (%0)" ::"r"(c));
+    a += vl;
+    b += vl;
+    c += vl;
+  }
+}
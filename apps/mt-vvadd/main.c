@@ -0,0 +1,92 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Port of the mt-vvadd benchmark of riscv-tests. Each of the NR_CORES harts
+// adds a contiguous chunk of the vectors with its Ara.
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "kernel/vvadd.h"
+#include "runtime.h"
+#include "sync.h"
+#include "util.h"
+
+#ifndef SPIKE
+#include "printf.h"
+#endif
+
+extern uint64_t vsize;
+
+extern double a[] __attribute__((aligned(32 * NR_LANES), section(".l2")));
+extern double b[] __attribute__((aligned(32 * NR_LANES), section(".l2")));
+extern double c[] __attribute__((aligned(32 * NR_LANES), section(".l2")));
+// Gold results
+extern double g[] __attribute__((aligned(32 * NR_LANES), section(".l2")));
+
+// Add the chunk of the hart id
+void vvadd_chunk(int id, int nr_harts) {
+  const uint64_t chunk = vsize / nr_harts;
+  const uint64_t start = id * chunk;
+  const uint64_t len = (id == nr_harts - 1) ? vsize - start : chunk;
+
+  fvvadd64(c + start, a + start, b + start, len);
+}
+
+void thread_main(int id, int nr_harts) {
+  barrier();
+  vvadd_chunk(id, nr_harts);
+  barrier();
+}
+
+int main() {
+  printf("\n");
+  printf("==============\n");
+  printf("=  MT-VVADD  =\n");
+  printf("==============\n");
+  printf("\n");
+  printf("\n");
+
+  printf("Adding %d elements on %d harts...\n", vsize, NR_CORES);
+
+  barrier();
+  start_timer();
+  vvadd_chunk(0, NR_CORES);
+  barrier();
+  stop_timer();
+
+  // Metrics
+  int64_t runtime = get_timer();
+  float performance = (float)vsize / runtime;
+  float utilization = 100 * performance / (NR_CORES * NR_LANES);
+
+  printf("The execution took %d cycles.\n", runtime);
+  printf("The performance is %f FLOP/cycle (%f%% utilization).\n", performance,
+         utilization);
+
+  printf("Verifying result...\n");
+  for (uint64_t i = 0; i < vsize; ++i) {
+    if (c[i] != g[i]) {
+      printf("Error: c[%d] = %f, g[%d] = %f\n", i, c[i], i, g[i]);
+      return i + 1;
+    }
+  }
+  printf("Passed.\n");
+
+  return 0;
+}
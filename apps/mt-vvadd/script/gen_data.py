@@ -0,0 +1,44 @@
+#!/usr/bin/env python3
+# Copyright 2022 ETH Zurich and University of Bologna.
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+# Generate the input data of the mt-vvadd benchmark
+# arg: #elements per vector
+
+import numpy as np
+import os
+import sys
+
+sys.path.insert(0, os.path.join(os.path.dirname(__file__), '../../common/script'))
+from data_emit import emit
+
+if len(sys.argv) > 1:
+  vsize = int(sys.argv[1])
+else:
+  vsize = 4096
+
+# Integer values, so that the sums are exact
+a = np.random.randint(0, 1000, size=vsize).astype(np.float64)
+b = np.random.randint(0, 1000, size=vsize).astype(np.float64)
+c = np.zeros(vsize, dtype=np.float64)
+g = a + b
+
+print(".section .data,\"aw\",@progbits")
+emit("vsize", np.array(vsize, dtype=np.uint64))
+emit("a", a, 'NR_LANES*4')
+emit("b", b, 'NR_LANES*4')
+emit("c", c, 'NR_LANES*4')
+emit("g", g, 'NR_LANES*4')
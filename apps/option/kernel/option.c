@@ -0,0 +1,172 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <math.h>
+
+#include "option.h"
+#include "vmath/vmath.h"
+#include "vrand/vrand.h"
+
+// One strip of options at a time, on LMUL=2 groups: the temporaries of vmath
+// and the live vectors of the strip fit in the VRF. N(x) and N(-x) are
+// (1 + erf(x / sqrt(2))) / 2 and (1 - erf(x / sqrt(2))) / 2, from the same
+// erf, so that each option takes one log, one exp, and two erf.
+#define bs_def_gen(sfx, T, sew)                                                \
+  void black_scholes_##sfx(T *call, T *put, const T *s, const T *k,            \
+                           const T *t, T r, T sigma, uint64_t n) {             \
+    const T drift = r + sigma * sigma / 2;                                     \
+    size_t vl;                                                                 \
+                                                                               \
+    for (uint64_t i = 0; i < n; i += vl) {                                     \
+      vl = vsetvl_e##sew##m2(n - i);                                           \
+      vfloat##sew##m2_t vs = vle##sew##_v_##sfx##m2(s + i, vl);                \
+      vfloat##sew##m2_t vk = vle##sew##_v_##sfx##m2(k + i, vl);                \
+      vfloat##sew##m2_t vt = vle##sew##_v_##sfx##m2(t + i, vl);                \
+                                                                               \
+      /* sigma sqrt(t), d1, and d2 */                                          \
+      vfloat##sew##m2_t vol =                                                  \
+          vfmul_vf_##sfx##m2(vfsqrt_v_##sfx##m2(vt, vl), sigma, vl);           \
+      vfloat##sew##m2_t d1 =                                                   \
+          vmath_log_##sfx##m2(vfdiv_vv_##sfx##m2(vs, vk, vl), vl);             \
+      d1 = vfdiv_vv_##sfx##m2(vfmacc_vf_##sfx##m2(d1, drift, vt, vl), vol,     \
+                              vl);                                             \
+      vfloat##sew##m2_t d2 = vfsub_vv_##sfx##m2(d1, vol, vl);                  \
+                                                                               \
+      /* k exp(-r t) */                                                        \
+      vfloat##sew##m2_t disc = vfmul_vv_##sfx##m2(                             \
+          vk, vmath_exp_##sfx##m2(vfmul_vf_##sfx##m2(vt, -r, vl), vl), vl);    \
+      vfloat##sew##m2_t e1 = vmath_erf_##sfx##m2(                              \
+          vfmul_vf_##sfx##m2(d1, (T)(1 / VMATH_SQRT2), vl), vl);               \
+      vfloat##sew##m2_t e2 = vmath_erf_##sfx##m2(                              \
+          vfmul_vf_##sfx##m2(d2, (T)(1 / VMATH_SQRT2), vl), vl);               \
+                                                                               \
+      /* 2 call = s (1 + e1) - disc (1 + e2),                                  \
+         2 put = disc (1 - e2) - s (1 - e1) */                                 \
+      vfloat##sew##m2_t c = vfsub_vv_##sfx##m2(                                \
+          vfmacc_vv_##sfx##m2(vs, vs, e1, vl),                                 \
+          vfmacc_vv_##sfx##m2(disc, disc, e2, vl), vl);                        \
+      vfloat##sew##m2_t p = vfsub_vv_##sfx##m2(                                \
+          vfnmsac_vv_##sfx##m2(disc, disc, e2, vl),                            \
+          vfnmsac_vv_##sfx##m2(vs, vs, e1, vl), vl);                           \
+      vse##sew##_v_##sfx##m2(call + i, vfmul_vf_##sfx##m2(c, 0.5, vl), vl);    \
+      vse##sew##_v_##sfx##m2(put + i, vfmul_vf_##sfx##m2(p, 0.5, vl), vl);     \
+    }                                                                          \
+  }
+
+bs_def_gen(f64, double, 64);
+bs_def_gen(f32, float, 32);
+
+// ((x >> 9) + 1/2) 2^-23, in (0, 1) and exact in FP32, so that the log of
+// Box-Muller is finite
+#define MC_UNIFORM_SHIFT 9
+#define MC_UNIFORM_SCALE 0x1p-23f
+
+static inline float mc_uniform_scalar(uint32_t seed, uint32_t ctr) {
+  const float f = (float)(vrand_scalar(seed, ctr) >> MC_UNIFORM_SHIFT);
+  return (f + 0.5f) * MC_UNIFORM_SCALE;
+}
+
+static inline vfloat32m2_t mc_uniform(uint32_t seed, uint32_t ctr, size_t vl) {
+  vuint32m2_t x = vsrl_vx_u32m2(vrand_u32m2(seed, ctr, vl), MC_UNIFORM_SHIFT,
+                                vl);
+  vfloat32m2_t f = vfadd_vf_f32m2(vfcvt_f_xu_v_f32m2(x, vl), 0.5f, vl);
+  return vfmul_vf_f32m2(f, MC_UNIFORM_SCALE, vl);
+}
+
+// One strip of paths at a time, with the paths on the elements: the log of the
+// price of each path accumulates the drift and the variates of the steps, and
+// exp gives its price, which also accumulates into the sum of the average.
+// The payoffs of the strip are reduced once, after its last step, and their
+// sums are discounted at the end.
+void mc_call_f32(float *eu, float *asian, float s0, float k, float r,
+                 float sigma, float t, uint64_t steps, uint64_t paths,
+                 uint32_t seed) {
+  const float dt = t / steps;
+  const float drift = (r - sigma * sigma / 2) * dt;
+  const float vol = sigma * sqrtf(dt);
+  vfloat32m1_t red_eu = vfmv_v_f_f32m1(0, 1);
+  vfloat32m1_t red_asian = vfmv_v_f_f32m1(0, 1);
+  size_t vl;
+
+  for (uint64_t p = 0; p < paths; p += vl) {
+    vl = vsetvl_e32m2(paths - p);
+    vfloat32m2_t x = vfmv_v_f_f32m2(0, vl);
+    vfloat32m2_t sum = vfmv_v_f_f32m2(0, vl);
+    vfloat32m2_t e;
+
+    for (uint64_t j = 0; j < steps; j += 2) {
+      vfloat32m2_t u = mc_uniform(seed, j * paths + p, vl);
+      vfloat32m2_t v = mc_uniform(seed, (j + 1) * paths + p, vl);
+      // sqrt(-2 log(u)) sigma sqrt(dt), and 2 pi v
+      vfloat32m2_t rad = vfmul_vf_f32m2(
+          vfsqrt_v_f32m2(vfmul_vf_f32m2(vmath_log_f32m2(u, vl), -2, vl), vl),
+          vol, vl);
+      vfloat32m2_t theta = vfmul_vf_f32m2(v, (float)(2 * M_PI), vl);
+
+      x = vfmacc_vv_f32m2(vfadd_vf_f32m2(x, drift, vl), rad,
+                          vmath_cos_f32m2(theta, vl), vl);
+      e = vmath_exp_f32m2(x, vl);
+      sum = vfadd_vv_f32m2(sum, e, vl);
+      if (j + 1 < steps) {
+        x = vfmacc_vv_f32m2(vfadd_vf_f32m2(x, drift, vl), rad,
+                            vmath_sin_f32m2(theta, vl), vl);
+        e = vmath_exp_f32m2(x, vl);
+        sum = vfadd_vv_f32m2(sum, e, vl);
+      }
+    }
+
+    // max(s0 e - k, 0) and max(s0 sum / steps - k, 0)
+    vfloat32m2_t pay = vfmax_vf_f32m2(
+        vfsub_vf_f32m2(vfmul_vf_f32m2(e, s0, vl), k, vl), 0, vl);
+    red_eu = vfredusum_vs_f32m2_f32m1(red_eu, pay, red_eu, vl);
+    pay = vfmax_vf_f32m2(
+        vfsub_vf_f32m2(vfmul_vf_f32m2(sum, s0 / steps, vl), k, vl), 0, vl);
+    red_asian = vfredusum_vs_f32m2_f32m1(red_asian, pay, red_asian, vl);
+  }
+
+  const float disc = expf(-r * t) / paths;
+  *eu = vfmv_f_s_f32m1_f32(red_eu) * disc;
+  *asian = vfmv_f_s_f32m1_f32(red_asian) * disc;
+}
+
+void mc_call_f32_scalar(float *eu, float *asian, float s0, float k, float r,
+                        float sigma, float t, uint64_t steps, uint64_t paths,
+                        uint32_t seed) {
+  const float dt = t / steps;
+  const float drift = (r - sigma * sigma / 2) * dt;
+  const float vol = sigma * sqrtf(dt);
+  float sum_eu = 0, sum_asian = 0;
+
+  for (uint64_t p = 0; p < paths; ++p) {
+    float x = 0, sum = 0, e = 0;
+    for (uint64_t j = 0; j < steps; ++j) {
+      const uint64_t j0 = j & ~(uint64_t)1;
+      const float u = mc_uniform_scalar(seed, j0 * paths + p);
+      const float v = mc_uniform_scalar(seed, (j0 + 1) * paths + p);
+      const float rad = sqrtf(-2 * logf(u)) * vol;
+      const float theta = v * (float)(2 * M_PI);
+      x = x + drift + rad * ((j & 1) ? sinf(theta) : cosf(theta));
+      e = expf(x);
+      sum += e;
+    }
+    sum_eu += fmaxf(s0 * e - k, 0);
+    sum_asian += fmaxf(sum * (s0 / steps) - k, 0);
+  }
+
+  const float disc = expf(-r * t) / paths;
+  *eu = sum_eu * disc;
+  *asian = sum_asian * disc;
+}
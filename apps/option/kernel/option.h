@@ -0,0 +1,56 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Option pricing kernels:
+//   black_scholes_<type>: European call and put prices of n options, with
+//                         spot s, strike k, and maturity t each, and a common
+//                         rate r and volatility sigma
+//   mc_call_f32:          Monte-Carlo prices of a European and of an
+//                         arithmetic-average Asian call, on paths of a
+//                         geometric Brownian motion with steps time steps
+// Black-Scholes: d1 = (log(s / k) + (r + sigma^2 / 2) t) / (sigma sqrt(t)),
+// d2 = d1 - sigma sqrt(t), call = s N(d1) - k exp(-r t) N(d2), and
+// put = k exp(-r t) N(-d2) - s N(-d1), where N(x) = (1 + erf(x / sqrt(2))) / 2
+// is the normal CDF. log, exp, and erf are the ones of vmath.
+//
+// The normal variates of the paths are drawn with Box-Muller from the uniforms
+// of vrand: the variates of the steps 2j and 2j + 1 of path p are
+// sqrt(-2 log(u)) cos(2 pi v) and sqrt(-2 log(u)) sin(2 pi v), where u and v
+// are the uniforms of the counters 2j paths + p and (2j + 1) paths + p of the
+// stream seed, so that steps * paths must be less than 2^32.
+// mc_call_f32_scalar is the scalar reference, on the same uniforms.
+
+#ifndef _OPTION_H_
+#define _OPTION_H_
+
+#include <stdint.h>
+
+#include "riscv_vector.h"
+
+void black_scholes_f64(double *call, double *put, const double *s,
+                       const double *k, const double *t, double r,
+                       double sigma, uint64_t n);
+void black_scholes_f32(float *call, float *put, const float *s, const float *k,
+                       const float *t, float r, float sigma, uint64_t n);
+
+void mc_call_f32(float *eu, float *asian, float s0, float k, float r,
+                 float sigma, float t, uint64_t steps, uint64_t paths,
+                 uint32_t seed);
+void mc_call_f32_scalar(float *eu, float *asian, float s0, float k, float r,
+                        float sigma, float t, uint64_t steps, uint64_t paths,
+                        uint32_t seed);
+
+#endif
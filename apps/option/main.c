@@ -0,0 +1,133 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <math.h>
+#include <stdint.h>
+
+#include "bench.h"
+#include "kernel/option.h"
+#include "runtime.h"
+#include "util.h"
+#include "vcheck.h"
+
+#ifndef SPIKE
+#include "printf.h"
+#else
+#include <stdio.h>
+#endif
+
+// Absolute errors of the prices, mostly the ones of the erf of vmath
+#define THRESHOLD_F64 0.0001
+#define THRESHOLD_F32 0.001
+// Relative error of the Monte-Carlo prices on their scalar reference, which has
+// the same uniforms
+#define THRESHOLD_MC 0.001
+
+extern uint64_t n;
+extern uint64_t paths;
+extern uint64_t steps;
+extern double r;
+extern double sigma;
+extern float mc_s0;
+extern float mc_k;
+extern float mc_t;
+extern uint32_t mc_seed;
+extern float mc_bs;
+extern float mc_tol;
+extern double s64[] __attribute__((aligned(4 * NR_LANES)));
+extern double k64[] __attribute__((aligned(4 * NR_LANES)));
+extern double t64[] __attribute__((aligned(4 * NR_LANES)));
+extern float s32[] __attribute__((aligned(4 * NR_LANES)));
+extern float k32[] __attribute__((aligned(4 * NR_LANES)));
+extern float t32[] __attribute__((aligned(4 * NR_LANES)));
+extern double call64[] __attribute__((aligned(4 * NR_LANES)));
+extern double put64[] __attribute__((aligned(4 * NR_LANES)));
+extern float call32[] __attribute__((aligned(4 * NR_LANES)));
+extern float put32[] __attribute__((aligned(4 * NR_LANES)));
+extern double gold_call64[] __attribute__((aligned(4 * NR_LANES)));
+extern double gold_put64[] __attribute__((aligned(4 * NR_LANES)));
+extern float gold_call32[] __attribute__((aligned(4 * NR_LANES)));
+extern float gold_put32[] __attribute__((aligned(4 * NR_LANES)));
+
+// Options, or path steps, per cycle
+static int check_mc(const char *name, float price, float gold, float thr) {
+  if (!(fabsf(price - gold) <= thr)) {
+    printf("%s: Error. %f != %f (+- %f)\n", name, price, gold, thr);
+    return 1;
+  }
+  printf("%s: Check okay. %f = %f (+- %f)\n", name, price, gold, thr);
+  return 0;
+}
+
+int main() {
+  printf("\n");
+  printf("============\n");
+  printf("=  OPTION  =\n");
+  printf("============\n");
+  printf("\n");
+  printf("\n");
+
+  printf("Black-Scholes: %lu options. Monte-Carlo: %lu paths of %lu steps.\n",
+         n, paths, steps);
+
+  int error = 0;
+
+  start_timer();
+  black_scholes_f64(call64, put64, s64, k64, t64, r, sigma, n);
+  stop_timer();
+  bench_report_rate("black_scholes_f64", n, "options");
+  error |= vcheck_report("black_scholes_f64 (call)",
+                         vcheck_f64(call64, gold_call64, n, THRESHOLD_F64));
+  error |= vcheck_report("black_scholes_f64 (put)",
+                         vcheck_f64(put64, gold_put64, n, THRESHOLD_F64));
+
+  start_timer();
+  black_scholes_f32(call32, put32, s32, k32, t32, (float)r, (float)sigma, n);
+  stop_timer();
+  bench_report_rate("black_scholes_f32", n, "options");
+  error |= vcheck_report("black_scholes_f32 (call)",
+                         vcheck_f32(call32, gold_call32, n, THRESHOLD_F32));
+  error |= vcheck_report("black_scholes_f32 (put)",
+                         vcheck_f32(put32, gold_put32, n, THRESHOLD_F32));
+
+  float eu, asian, eu_gold, asian_gold;
+  int64_t scalar;
+
+  start_timer();
+  mc_call_f32_scalar(&eu_gold, &asian_gold, mc_s0, mc_k, (float)r,
+                     (float)sigma, mc_t, steps, paths, mc_seed);
+  stop_timer();
+  scalar = get_timer();
+  bench_report_rate("mc_call_f32_scalar", paths * steps, "steps");
+
+  start_timer();
+  mc_call_f32(&eu, &asian, mc_s0, mc_k, (float)r, (float)sigma, mc_t, steps,
+              paths, mc_seed);
+  stop_timer();
+  bench_report_rate("mc_call_f32", paths * steps, "steps");
+  printf("Speedup on the scalar Monte-Carlo: %f\n",
+         (float)scalar / get_timer());
+  printf("European call: %f, Asian call: %f\n", eu, asian);
+
+  error |= check_mc("mc_call_f32 (European)", eu, eu_gold,
+                    THRESHOLD_MC * eu_gold);
+  error |= check_mc("mc_call_f32 (Asian)", asian, asian_gold,
+                    THRESHOLD_MC * asian_gold);
+  // The paths and the PRNG, on the Black-Scholes price
+  error |= check_mc("mc_call_f32 (Black-Scholes)", eu, mc_bs, mc_tol);
+
+  return error;
+}
@@ -0,0 +1,105 @@
+#!/usr/bin/env python3
+# Copyright 2022 ETH Zurich and University of Bologna.
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+# arg1: options of Black-Scholes, arg2: paths, arg3: time steps of the
+# Monte-Carlo simulation
+# The Black-Scholes golden prices are computed in FP64, and the Monte-Carlo
+# ones are checked against the Black-Scholes price of their European call,
+# within 4 standard errors
+
+import math
+import numpy as np
+import os
+import sys
+
+sys.path.insert(0, os.path.join(os.path.dirname(__file__), '../../common/script'))
+from data_emit import emit
+
+# The normal CDF
+def cnd(x):
+  return 0.5 * (1 + np.vectorize(math.erf)(x / math.sqrt(2)))
+
+def black_scholes(s, k, t, r, sigma):
+  vol = sigma * np.sqrt(t)
+  d1 = (np.log(s / k) + (r + sigma * sigma / 2) * t) / vol
+  d2 = d1 - vol
+  disc = k * np.exp(-r * t)
+  return s * cnd(d1) - disc * cnd(d2), disc * cnd(-d2) - s * cnd(-d1)
+
+############
+## SCRIPT ##
+############
+
+if len(sys.argv) == 4:
+  n     = int(sys.argv[1])
+  paths = int(sys.argv[2])
+  steps = int(sys.argv[3])
+else:
+  print("Error. Give me three arguments: the options, the paths, and the steps.")
+  sys.exit()
+
+if steps * paths >= 2**32:
+  print("Error. The paths times the steps must be less than 2^32.")
+  sys.exit()
+
+r     = 0.03
+sigma = 0.25
+
+s = np.random.uniform(50, 150, n)
+k = np.random.uniform(50, 150, n)
+t = np.random.uniform(0.1, 2, n)
+call, put = black_scholes(s, k, t, r, sigma)
+
+# An at-the-money call of one year
+mc_s0 = 100.0
+mc_k  = 100.0
+mc_t  = 1.0
+mc_bs = black_scholes(np.array([mc_s0]), np.array([mc_k]), np.array([mc_t]), r, sigma)[0][0]
+# Standard error of the discounted payoff of one path, from its exact terminal
+# price
+z = np.random.normal(0, 1, 2**16)
+st = mc_s0 * np.exp((r - sigma * sigma / 2) * mc_t + sigma * math.sqrt(mc_t) * z)
+pay = math.exp(-r * mc_t) * np.maximum(st - mc_k, 0)
+mc_tol = 4 * np.std(pay) / math.sqrt(paths)
+
+# Create the file
+print(".section .data,\"aw\",@progbits")
+emit("n", np.array(n, dtype=np.uint64))
+emit("paths", np.array(paths, dtype=np.uint64))
+emit("steps", np.array(steps, dtype=np.uint64))
+emit("r", np.array(r, dtype=np.float64))
+emit("sigma", np.array(sigma, dtype=np.float64))
+emit("mc_s0", np.array(mc_s0, dtype=np.float32))
+emit("mc_k", np.array(mc_k, dtype=np.float32))
+emit("mc_t", np.array(mc_t, dtype=np.float32))
+emit("mc_seed", np.array(np.random.randint(0, 2**31), dtype=np.uint32))
+emit("mc_bs", np.array(mc_bs, dtype=np.float32))
+emit("mc_tol", np.array(mc_tol, dtype=np.float32))
+emit("s64", s, 'NR_LANES*4')
+emit("k64", k, 'NR_LANES*4')
+emit("t64", t, 'NR_LANES*4')
+emit("s32", s.astype(np.float32), 'NR_LANES*4')
+emit("k32", k.astype(np.float32), 'NR_LANES*4')
+emit("t32", t.astype(np.float32), 'NR_LANES*4')
+emit("call64", np.zeros(n, dtype=np.float64), 'NR_LANES*4')
+emit("put64", np.zeros(n, dtype=np.float64), 'NR_LANES*4')
+emit("call32", np.zeros(n, dtype=np.float32), 'NR_LANES*4')
+emit("put32", np.zeros(n, dtype=np.float32), 'NR_LANES*4')
+emit("gold_call64", call, 'NR_LANES*4')
+emit("gold_put64", put, 'NR_LANES*4')
+emit("gold_call32", call.astype(np.float32), 'NR_LANES*4')
+emit("gold_put32", put.astype(np.float32), 'NR_LANES*4')
@@ -91,10 +91,83 @@ void run_vector(int *wall, int *result_v, uint32_t cols, uint32_t rows,
   }
 }
 
+// Tiled version, for large grids. A tile of tile rows is computed strip by
+// strip from the row above it, keeping the rows of the strip in the
+// registers, and only its last row is stored: the traffic on the results
+// is divided by tile. The strips overlap by tile ghost columns on each side:
+// the neighbours of the elements at the edges of a strip are wrong, and the
+// error moves inwards by one element per row. The results of the tiles go to
+// buf and result_v in turn, and the last one to result_v.
+void run_vector_tiled(int *wall, int *result_v, int *buf, uint32_t cols,
+                      uint32_t rows, uint32_t num_runs, uint32_t tile,
+                      int neutral_value) {
+
+  size_t gvl;
+
+  vint32m4_t xSrc_slideup;
+  vint32m4_t xSrc_slidedown;
+  vint32m4_t xSrc;
+
+  // The interior strips must store at least an element
+  if (2 * tile >= VLMAX_E32M4)
+    tile = (VLMAX_E32M4 - 1) / 2;
+  if (tile == 0)
+    tile = 1;
+
+  for (uint32_t j = 0; j < num_runs; j++) {
+    uint32_t ntiles = (rows - 1 + tile - 1) / tile;
+    int *src = wall;
+    int *dst = (ntiles % 2) ? result_v : buf;
+
+    // A single row is its own result
+    if (ntiles == 0) {
+      for (uint32_t n = 0; n < cols; n += gvl) {
+        gvl = vsetvl_e32m4(cols - n);
+        vse32_v_i32m4(&result_v[n], vle32_v_i32m4(&wall[n], gvl), gvl);
+      }
+    }
+
+    for (uint32_t t = 1; t < rows; t += tile) {
+      uint32_t height = MIN(tile, rows - t);
+
+      for (uint32_t n = 0;;) {
+        gvl = vsetvl_e32m4(cols - n);
+        // Columns [first, end) are correct after height rows
+        uint32_t first = (n == 0) ? 0 : n + height;
+        uint32_t end = (n + gvl == cols) ? cols : n + gvl - height;
+
+        xSrc = vle32_v_i32m4(&src[n], gvl);
+        for (uint32_t h = 0; h < height; h++) {
+          xSrc_slideup = vslide1up_vx_i32m4(xSrc, neutral_value, gvl);
+          xSrc_slidedown = vslide1down_vx_i32m4(xSrc, neutral_value, gvl);
+
+          xSrc = vmin_vv_i32m4(xSrc, xSrc_slideup, gvl);
+          xSrc = vmin_vv_i32m4(xSrc, xSrc_slidedown, gvl);
+
+          xSrc = vadd_vv_i32m4(
+              xSrc, vle32_v_i32m4(&wall[(t + h) * cols + n], gvl), gvl);
+        }
+
+        // Store the correct columns only
+        if (first > n)
+          xSrc = vslidedown_vx_i32m4(xSrc, xSrc, first - n, end - first);
+        vse32_v_i32m4(&dst[first], xSrc, end - first);
+
+        if (end == cols)
+          break;
+        n = end - height;
+      }
+
+      src = dst;
+      dst = (dst == buf) ? result_v : buf;
+    }
+  }
+}
+
 // This function is optimized for program sizes that satisfy:
-// cols < (m * L * 128) / (2**sew)
-// With m4, int32_t, 8 lanes -> cols < (4 * 8 * 128) / (4) -> cols <= 1024
-// With m4, int32_t, 4 lanes -> cols < (4 * 4 * 128) / (4) -> cols <= 512
+// cols <= PATHFINDER_SHORT_MAX_COLS = (m * VLEN) / sew
+// With m4, int32_t, VLEN = 8192 (8 lanes) -> cols <= 1024
+// With m4, int32_t, VLEN = 4096 (4 lanes) -> cols <= 512
 // Introduced preloading to boost performance
 void run_vector_short_m4(int *wall, int *result_v, uint32_t cols, uint32_t rows,
                          uint32_t num_runs, int neutral_value) {
@@ -181,9 +254,9 @@ void run_vector_short_m4(int *wall, int *result_v, uint32_t cols, uint32_t rows,
 
 /*
 // This function is optimized for program sizes that satisfy:
-// cols < (m * L * 128) / (2**sew)
-// With m4, int32_t, 8 lanes -> cols < (4 * 8 * 128) / (4) -> cols <= 1024
-// With m4, int32_t, 4 lanes -> cols < (4 * 4 * 128) / (4) -> cols <= 512
+// cols <= PATHFINDER_SHORT_MAX_COLS = (m * VLEN) / sew
+// With m4, int32_t, VLEN = 8192 (8 lanes) -> cols <= 1024
+// With m4, int32_t, VLEN = 4096 (4 lanes) -> cols <= 512
 void run_vector_short_m4(int *wall, int *result_v, uint32_t cols, uint32_t rows,
                          uint32_t num_runs, int neutral_value) {
 
@@ -6,6 +6,16 @@
 #include "riscv_vector.h"
 
 #include "util.h"
+#include "vconfig.h"
+
+// Widest grid of run_vector_short_m4(), which keeps a row in a register group
+#define PATHFINDER_SHORT_MAX_COLS VLMAX_E32M4
+
+// Rows per tile of run_vector_tiled(). The 2 * PATHFINDER_TILE ghost columns
+// take 1/16 of the strips in every configuration.
+#ifndef PATHFINDER_TILE
+#define PATHFINDER_TILE (VLMAX_E32M4 / 32)
+#endif
 
 #ifndef SPIKE
 #include "printf.h"
@@ -17,6 +27,9 @@ int *run(int *wall, int *result_s, int *src, uint32_t cols, uint32_t rows,
          uint32_t num_runs);
 void run_vector(int *wall, int *result_v, uint32_t cols, uint32_t rows,
                 uint32_t num_runs);
+void run_vector_tiled(int *wall, int *result_v, int *buf, uint32_t cols,
+                      uint32_t rows, uint32_t num_runs, uint32_t tile,
+                      int neutral_value);
 void run_vector_short_m4(int *wall, int *result_v, uint32_t cols, uint32_t rows,
                          uint32_t num_runs, int neutral_value);
 
@@ -31,6 +31,7 @@ extern int src[] __attribute__((aligned(4 * NR_LANES), section(".l2")));
 extern int wall[] __attribute__((aligned(4 * NR_LANES), section(".l2")));
 extern int result_v[] __attribute__((aligned(4 * NR_LANES), section(".l2")));
 extern int result_s[] __attribute__((aligned(4 * NR_LANES), section(".l2")));
+extern int buf_v[] __attribute__((aligned(4 * NR_LANES), section(".l2")));
 
 int verify_result(int *result_s, int *result_v, uint32_t cols) {
   // Check vector with scalar result
@@ -67,11 +68,20 @@ int main() {
   printf("Scalar code cycles: %d\n", get_timer());
 #endif
 
-  if (cols > NR_LANES * 128) {
+  if (cols > PATHFINDER_SHORT_MAX_COLS) {
+#ifdef PATHFINDER_ROW
     printf("Using the base algorithm.\n");
     start_timer();
     run_vector(wall, result_v, cols, rows, num_runs);
     stop_timer();
+#else
+    printf("Using the tiled algorithm, %d rows per tile.\n", PATHFINDER_TILE);
+    int neutral_value = 0x7fffffff; // Max value for int datatype
+    start_timer();
+    run_vector_tiled(wall, result_v, buf_v, cols, rows, num_runs,
+                     PATHFINDER_TILE, neutral_value);
+    stop_timer();
+#endif
   } else {
     printf("Using the optimized algorithm.\n");
     int neutral_value = 0x7fffffff; // Max value for int datatype
@@ -19,18 +19,11 @@
 
 import random as rand
 import numpy as np
+import os
 import sys
 
-def emit(name, array, alignment='8'):
-  print(".global %s" % name)
-  print(".balign " + alignment)
-  print("%s:" % name)
-  bs = array.tobytes()
-  for i in range(0, len(bs), 4):
-    s = ""
-    for n in range(4):
-      s += "%02x" % bs[i+3-n]
-    print("    .word 0x%s" % s)
+sys.path.insert(0, os.path.join(os.path.dirname(__file__), '../../common/script'))
+from data_emit import emit
 
 def rand_matrix(N, dtype):
   return np.random.rand(N).astype(dtype)
@@ -57,6 +50,7 @@ wall = np.random.randint(10, size=rows * cols, dtype=dtype)
 result_s = np.zeros(cols, dtype=dtype)
 result_v = np.zeros(cols, dtype=dtype)
 src      = np.zeros(cols, dtype=dtype)
+buf_v    = np.zeros(cols, dtype=dtype)
 
 # Create the file
 print(".section .data,\"aw\",@progbits")
@@ -67,3 +61,4 @@ emit("wall",   wall,   'NR_LANES*4')
 emit("result_s", result_s, 'NR_LANES*4')
 emit("result_v", result_v, 'NR_LANES*4')
 emit("src", src, 'NR_LANES*4')
+emit("buf_v", buf_v, 'NR_LANES*4')
@@ -0,0 +1,149 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "quant.h"
+
+// All the kernels run on LMUL=8 groups of 32-bit elements, narrowed to LMUL=2
+// groups of bytes
+
+// x * inv_scale rounded and offset by zp, with saturation to int32_t
+static inline vint32m8_t quant_round(vfloat32m8_t x, vfloat32m8_t inv_scale,
+                                     int32_t zp, size_t vl) {
+  vint32m8_t t = vfcvt_x_f_v_i32m8(vfmul_vv_f32m8(x, inv_scale, vl), vl);
+  return vsadd_vx_i32m8(t, zp, vl);
+}
+
+static inline vint8m2_t quant_sat_i8(vint32m8_t t, size_t vl) {
+  return vnclip_wx_i8m2(vnclip_wx_i16m4(t, 0, vl), 0, vl);
+}
+
+void quantize_i8(int8_t *q, const float *x, uint64_t n, float scale,
+                 int32_t zp) {
+  const float inv_scale = 1.0f / scale;
+  size_t vl;
+
+  for (; n > 0; n -= vl) {
+    vl = vsetvl_e32m8(n);
+    vint32m8_t t = vfcvt_x_f_v_i32m8(
+        vfmul_vf_f32m8(vle32_v_f32m8(x, vl), inv_scale, vl), vl);
+    t = vsadd_vx_i32m8(t, zp, vl);
+    vse8_v_i8m2(q, quant_sat_i8(t, vl), vl);
+    x += vl;
+    q += vl;
+  }
+}
+
+// The negative values are clamped to 0 before vnclipu, which saturates the
+// others to 255
+void quantize_u8(uint8_t *q, const float *x, uint64_t n, float scale,
+                 int32_t zp) {
+  const float inv_scale = 1.0f / scale;
+  size_t vl;
+
+  for (; n > 0; n -= vl) {
+    vl = vsetvl_e32m8(n);
+    vint32m8_t t = vfcvt_x_f_v_i32m8(
+        vfmul_vf_f32m8(vle32_v_f32m8(x, vl), inv_scale, vl), vl);
+    t = vmax_vx_i32m8(vsadd_vx_i32m8(t, zp, vl), 0, vl);
+    vuint16m4_t h = vnclipu_wx_u16m4(vreinterpret_v_i32m8_u32m8(t), 0, vl);
+    vse8_v_u8m2(q, vnclipu_wx_u8m2(h, 0, vl), vl);
+    x += vl;
+    q += vl;
+  }
+}
+
+void dequantize_i8(float *x, const int8_t *q, uint64_t n, float scale,
+                   int32_t zp) {
+  size_t vl;
+
+  for (; n > 0; n -= vl) {
+    vl = vsetvl_e32m8(n);
+    vint32m8_t t = vsub_vx_i32m8(vsext_vf4_i32m8(vle8_v_i8m2(q, vl), vl), zp,
+                                 vl);
+    vse32_v_f32m8(x, vfmul_vf_f32m8(vfcvt_f_x_v_f32m8(t, vl), scale, vl), vl);
+    x += vl;
+    q += vl;
+  }
+}
+
+void dequantize_u8(float *x, const uint8_t *q, uint64_t n, float scale,
+                   int32_t zp) {
+  size_t vl;
+
+  for (; n > 0; n -= vl) {
+    vl = vsetvl_e32m8(n);
+    vint32m8_t t =
+        vreinterpret_v_u32m8_i32m8(vzext_vf4_u32m8(vle8_v_u8m2(q, vl), vl));
+    t = vsub_vx_i32m8(t, zp, vl);
+    vse32_v_f32m8(x, vfmul_vf_f32m8(vfcvt_f_x_v_f32m8(t, vl), scale, vl), vl);
+    x += vl;
+    q += vl;
+  }
+}
+
+// The columns are the outer loop: the reciprocals of a strip of scales are
+// computed once, and stay in the VRF for all the rows
+void quantize_i8_pc(int8_t *q, const float *x, const float *scale,
+                    uint64_t rows, uint64_t cols) {
+  size_t vl;
+
+  for (uint64_t c = 0; c < cols; c += vl) {
+    vl = vsetvl_e32m8(cols - c);
+    vfloat32m8_t inv_scale = vfrdiv_vf_f32m8(vle32_v_f32m8(scale + c, vl),
+                                             1.0f, vl);
+    for (uint64_t r = 0; r < rows; ++r) {
+      vint32m8_t t =
+          quant_round(vle32_v_f32m8(x + r * cols + c, vl), inv_scale, 0, vl);
+      vse8_v_i8m2(q + r * cols + c, quant_sat_i8(t, vl), vl);
+    }
+  }
+}
+
+void dequantize_i8_pc(float *x, const int8_t *q, const float *scale,
+                      uint64_t rows, uint64_t cols) {
+  size_t vl;
+
+  for (uint64_t c = 0; c < cols; c += vl) {
+    vl = vsetvl_e32m8(cols - c);
+    vfloat32m8_t scale_v = vle32_v_f32m8(scale + c, vl);
+    for (uint64_t r = 0; r < rows; ++r) {
+      vint32m8_t t = vsext_vf4_i32m8(vle8_v_i8m2(q + r * cols + c, vl), vl);
+      vse32_v_f32m8(x + r * cols + c,
+                    vfmul_vv_f32m8(vfcvt_f_x_v_f32m8(t, vl), scale_v, vl), vl);
+    }
+  }
+}
+
+// The shift rounds and saturates to int16_t, and the zero point is added with
+// saturation before the last narrowing, as in imatmul_i8_q
+void requantize_i8(int8_t *q, const int32_t *acc, const int32_t *mult,
+                   uint64_t shift, int32_t zp, uint64_t rows, uint64_t cols) {
+  // Round to the nearest, ties up, when shifting the scaled results
+  asm volatile("csrwi vxrm, 0");
+
+  size_t vl;
+
+  for (uint64_t c = 0; c < cols; c += vl) {
+    vl = vsetvl_e32m8(cols - c);
+    vint32m8_t mult_v = vle32_v_i32m8(mult + c, vl);
+    for (uint64_t r = 0; r < rows; ++r) {
+      vint32m8_t t = vmulh_vv_i32m8(vle32_v_i32m8(acc + r * cols + c, vl),
+                                    mult_v, vl);
+      vint16m4_t h = vsadd_vx_i16m4(vnclip_wx_i16m4(t, shift, vl), zp, vl);
+      vse8_v_i8m2(q + r * cols + c, vnclip_wx_i8m2(h, 0, vl), vl);
+    }
+  }
+}
@@ -0,0 +1,55 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Conversions between FP32 tensors and 8-bit quantized ones:
+//   quantize:   q = sat(round(x * (1 / scale)) + zp)
+//   dequantize: x = (q - zp) * scale
+//   requantize: q = sat(rnu(((acc * mult) >> 32) >> shift) + zp)
+// round is to the nearest, ties to even (vfcvt.x.f.v with the default frm),
+// rnu to the nearest, ties up (vxrm), and sat saturates to the 8-bit type with
+// a chain of vnclip (int8_t) or vnclipu (uint8_t) narrowing by 2x.
+// The per-tensor kernels take one scale and zero point for n elements. The
+// per-channel (_pc) ones are symmetric, and take a scale, or a Q31 multiplier,
+// for each column of a rows x cols row-major matrix: the output channels of
+// a weight matrix, or the channels of an NHWC tensor.
+// requantize_i8 takes the int32_t accumulators of an int8_t GEMM, and matches
+// imatmul_i8_q for zp = 0.
+
+#ifndef _QUANT_H_
+#define _QUANT_H_
+
+#include <stdint.h>
+
+#include "riscv_vector.h"
+
+void quantize_i8(int8_t *q, const float *x, uint64_t n, float scale,
+                 int32_t zp);
+void quantize_u8(uint8_t *q, const float *x, uint64_t n, float scale,
+                 int32_t zp);
+void dequantize_i8(float *x, const int8_t *q, uint64_t n, float scale,
+                   int32_t zp);
+void dequantize_u8(float *x, const uint8_t *q, uint64_t n, float scale,
+                   int32_t zp);
+
+void quantize_i8_pc(int8_t *q, const float *x, const float *scale,
+                    uint64_t rows, uint64_t cols);
+void dequantize_i8_pc(float *x, const int8_t *q, const float *scale,
+                      uint64_t rows, uint64_t cols);
+
+void requantize_i8(int8_t *q, const int32_t *acc, const int32_t *mult,
+                   uint64_t shift, int32_t zp, uint64_t rows, uint64_t cols);
+
+#endif
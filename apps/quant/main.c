@@ -0,0 +1,118 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdint.h>
+
+#include "bench.h"
+#include "kernel/quant.h"
+#include "runtime.h"
+#include "util.h"
+#include "vcheck.h"
+
+#ifndef SPIKE
+#include "printf.h"
+#else
+#include <stdio.h>
+#endif
+
+// The dequantized values are exact up to one FP32 rounding
+#define THRESHOLD 0.000001
+
+extern uint64_t rows;
+extern uint64_t cols;
+extern float scale;
+extern int32_t zp;
+extern float scale_u8;
+extern int32_t zp_u8;
+extern uint64_t shift;
+extern float x[] __attribute__((aligned(4 * NR_LANES)));
+extern float xd[] __attribute__((aligned(4 * NR_LANES)));
+extern float scale_pc[] __attribute__((aligned(4 * NR_LANES)));
+extern int32_t acc[] __attribute__((aligned(4 * NR_LANES)));
+extern int32_t mult[] __attribute__((aligned(4 * NR_LANES)));
+extern int8_t q[] __attribute__((aligned(4 * NR_LANES)));
+extern uint8_t qu[] __attribute__((aligned(4 * NR_LANES)));
+extern int8_t gold_q_i8[] __attribute__((aligned(4 * NR_LANES)));
+extern uint8_t gold_q_u8[] __attribute__((aligned(4 * NR_LANES)));
+extern int8_t gold_q_i8_pc[] __attribute__((aligned(4 * NR_LANES)));
+extern float gold_dq_i8[] __attribute__((aligned(4 * NR_LANES)));
+extern float gold_dq_u8[] __attribute__((aligned(4 * NR_LANES)));
+extern float gold_dq_i8_pc[] __attribute__((aligned(4 * NR_LANES)));
+extern int8_t gold_rq_i8[] __attribute__((aligned(4 * NR_LANES)));
+
+int main() {
+  printf("\n");
+  printf("===========\n");
+  printf("=  QUANT  =\n");
+  printf("===========\n");
+  printf("\n");
+  printf("\n");
+
+  printf("Matrix: %lu x %lu, shift: %lu\n", rows, cols, shift);
+
+  const uint64_t n = rows * cols;
+  // Each kernel reads or writes a 32-bit word and a byte per element
+  const uint64_t bytes = 5 * n;
+  int error = 0;
+
+  start_timer();
+  quantize_i8(q, x, n, scale, zp);
+  stop_timer();
+  bench_report_bw("quantize_i8", bytes);
+  error |= vcheck_report("quantize_i8", vcheck_i8(q, gold_q_i8, n));
+
+  start_timer();
+  dequantize_i8(xd, q, n, scale, zp);
+  stop_timer();
+  bench_report_bw("dequantize_i8", bytes);
+  error |= vcheck_report("dequantize_i8",
+                         vcheck_f32(xd, gold_dq_i8, n, THRESHOLD));
+
+  start_timer();
+  quantize_u8(qu, x, n, scale_u8, zp_u8);
+  stop_timer();
+  bench_report_bw("quantize_u8", bytes);
+  error |= vcheck_report("quantize_u8",
+                         vcheck_i8((int8_t *)qu, (int8_t *)gold_q_u8, n));
+
+  start_timer();
+  dequantize_u8(xd, qu, n, scale_u8, zp_u8);
+  stop_timer();
+  bench_report_bw("dequantize_u8", bytes);
+  error |= vcheck_report("dequantize_u8",
+                         vcheck_f32(xd, gold_dq_u8, n, THRESHOLD));
+
+  start_timer();
+  quantize_i8_pc(q, x, scale_pc, rows, cols);
+  stop_timer();
+  bench_report_bw("quantize_i8_pc", bytes);
+  error |= vcheck_report("quantize_i8_pc", vcheck_i8(q, gold_q_i8_pc, n));
+
+  start_timer();
+  dequantize_i8_pc(xd, q, scale_pc, rows, cols);
+  stop_timer();
+  bench_report_bw("dequantize_i8_pc", bytes);
+  error |= vcheck_report("dequantize_i8_pc",
+                         vcheck_f32(xd, gold_dq_i8_pc, n, THRESHOLD));
+
+  start_timer();
+  requantize_i8(q, acc, mult, shift, zp, rows, cols);
+  stop_timer();
+  bench_report_bw("requantize_i8", bytes);
+  error |= vcheck_report("requantize_i8", vcheck_i8(q, gold_rq_i8, n));
+
+  return error;
+}
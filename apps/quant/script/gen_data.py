@@ -0,0 +1,97 @@
+#!/usr/bin/env python3
+# Copyright 2022 ETH Zurich and University of Bologna.
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+# arg1: rows, arg2: columns, arg3: shift of the requantization
+# The per-tensor kernels take the rows x cols elements as one vector
+
+import numpy as np
+import os
+import sys
+
+sys.path.insert(0, os.path.join(os.path.dirname(__file__), '../../common/script'))
+from data_emit import emit
+
+def sat(v, lo, hi):
+  return np.clip(v, lo, hi).astype(np.int64)
+
+# x * (1 / scale) in FP32, rounded to the nearest even, as vfcvt.x.f.v
+def quantize(x, scale, zp, lo, hi):
+  t = x * (np.float32(1) / scale)
+  return sat(sat(np.rint(t.astype(np.float64)), -2**31, 2**31 - 1) + zp, lo, hi)
+
+def dequantize(q, scale, zp):
+  return (q - zp).astype(np.float32) * scale
+
+# Round to the nearest, ties up, as vnclip with vxrm = 0
+def rnu(v, shift):
+  return (v + (1 << (shift - 1))) >> shift if shift > 0 else v
+
+############
+## SCRIPT ##
+############
+
+if len(sys.argv) == 4:
+  rows  = int(sys.argv[1])
+  cols  = int(sys.argv[2])
+  shift = int(sys.argv[3])
+else:
+  print("Error. Give me three arguments: the rows, the columns, and the shift.")
+  sys.exit()
+
+# Outliers beyond the 8-bit range check the saturation
+x = np.random.normal(0, 1, (rows, cols)).astype(np.float32)
+x[np.random.rand(rows, cols) < 0.02] *= 100
+
+scale    = np.float32(3 / 127)
+zp       = np.int32(np.random.randint(-8, 8))
+scale_u8 = np.float32(6 / 255)
+zp_u8    = np.int32(128 + np.random.randint(-8, 8))
+scale_pc = (np.max(np.abs(x), axis=0) / 127 / 4).astype(np.float32)
+
+acc  = np.random.randint(-2**20, 2**20, (rows, cols)).astype(np.int32)
+mult = np.random.randint(2**30, 2**31 - 1, cols).astype(np.int32)
+
+q_i8    = quantize(x, scale, zp, -128, 127)
+q_u8    = quantize(x, scale_u8, zp_u8, 0, 255)
+q_i8_pc = quantize(x, scale_pc, 0, -128, 127)
+rq = (acc.astype(np.int64) * mult.astype(np.int64)) >> 32
+rq = sat(sat(rnu(rq, shift), -2**15, 2**15 - 1) + zp, -2**15, 2**15 - 1)
+rq = sat(rq, -128, 127)
+
+# Create the file
+print(".section .data,\"aw\",@progbits")
+emit("rows", np.array(rows, dtype=np.uint64))
+emit("cols", np.array(cols, dtype=np.uint64))
+emit("scale", np.array(scale, dtype=np.float32))
+emit("zp", np.array(zp, dtype=np.int32))
+emit("scale_u8", np.array(scale_u8, dtype=np.float32))
+emit("zp_u8", np.array(zp_u8, dtype=np.int32))
+emit("shift", np.array(shift, dtype=np.uint64))
+emit("x", x, 'NR_LANES*4')
+emit("xd", np.zeros((rows, cols), dtype=np.float32), 'NR_LANES*4')
+emit("scale_pc", scale_pc, 'NR_LANES*4')
+emit("acc", acc, 'NR_LANES*4')
+emit("mult", mult, 'NR_LANES*4')
+emit("q", np.zeros((rows, cols), dtype=np.int8), 'NR_LANES*4')
+emit("qu", np.zeros((rows, cols), dtype=np.uint8), 'NR_LANES*4')
+emit("gold_q_i8", q_i8.astype(np.int8), 'NR_LANES*4')
+emit("gold_q_u8", q_u8.astype(np.uint8), 'NR_LANES*4')
+emit("gold_q_i8_pc", q_i8_pc.astype(np.int8), 'NR_LANES*4')
+emit("gold_dq_i8", dequantize(q_i8, scale, zp), 'NR_LANES*4')
+emit("gold_dq_u8", dequantize(q_u8, scale_u8, zp_u8), 'NR_LANES*4')
+emit("gold_dq_i8_pc", dequantize(q_i8_pc, scale_pc, 0), 'NR_LANES*4')
+emit("gold_rq_i8", rq.astype(np.int8), 'NR_LANES*4')
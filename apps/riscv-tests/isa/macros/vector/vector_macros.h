@@ -161,8 +161,15 @@ int test_case;
   printf("PASSED.\n");
 
 // Macros to set vector length, type and multiplier
+// The tests check the inactive elements against their previous value, so they run with an
+// undisturbed policy. Ara exploits an agnostic policy, use VSET_TAMA to test it.
 // Don't use this to set VL == 0 since the compiler puts rs1 == x0
 #define VSET(VLEN,VTYPE,LMUL)                                                          \
+  do {                                                                                 \
+  asm volatile ("vsetvli t0, %[A]," #VTYPE "," #LMUL ", tu, mu \n" :: [A] "r" (VLEN)); \
+  } while(0)
+
+#define VSET_TAMA(VLEN,VTYPE,LMUL)                                                     \
   do {                                                                                 \
   asm volatile ("vsetvli t0, %[A]," #VTYPE "," #LMUL ", ta, ma \n" :: [A] "r" (VLEN)); \
   } while(0)
@@ -172,13 +179,13 @@ int test_case;
   do {                                                                                     \
     int vset_zero_buf;                                                                     \
     asm volatile("li %0, 0" : "=r" (vset_zero_buf));                                       \
-    asm volatile("vsetvli x0, %0," #VTYPE "," #LMUL ", ta, ma \n" :: "r" (vset_zero_buf)); \
+    asm volatile("vsetvli x0, %0," #VTYPE "," #LMUL ", tu, mu \n" :: "r" (vset_zero_buf)); \
   } while(0)
 
 #define VSETMAX(VTYPE,LMUL)                                                            \
   do {                                                                                 \
   int64_t scalar = -1;                                                                 \
-  asm volatile ("vsetvli t1, %[A]," #VTYPE "," #LMUL", ta, ma \n":: [A] "r" (scalar)); \
+  asm volatile ("vsetvli t1, %[A]," #VTYPE "," #LMUL", tu, mu \n":: [A] "r" (scalar)); \
   } while(0)
 
 // Macro to load a vector register with data from the stack
@@ -186,6 +186,19 @@ void TEST_CASE7(void) {
   VCMP_U8(25, v3, 2, 4, 6, 8, 10, 12, 14, 16, 2, 4, 6, 8, 10, 12, 14, 16);
 }
 
+// Tail- and mask-agnostic policy
+void TEST_CASE8(void) {
+  VSET_TAMA(16, e32, m1);
+  VLOAD_32(v1, 1, 2, 3, 4, 5, 6, 7, 8, 1, 2, 3, 4, 5, 6, 7, 8);
+  VLOAD_32(v2, 1, 2, 3, 4, 5, 6, 7, 8, 1, 2, 3, 4, 5, 6, 7, 8);
+  VLOAD_8(v0, 0xAA, 0xAA);
+  asm volatile("vadd.vv v3, v1, v2, v0.t");
+  // The masked-off elements are agnostic: zero them to check the active ones
+  asm volatile("vmv.v.i v4, 0");
+  asm volatile("vmerge.vvm v3, v4, v3, v0");
+  VCMP_U32(26, v3, 0, 4, 0, 8, 0, 12, 0, 16, 0, 4, 0, 8, 0, 12, 0, 16);
+}
+
 int main(void) {
   INIT_CHECK();
   enable_vec();
@@ -197,6 +210,7 @@ int main(void) {
   TEST_CASE5();
   TEST_CASE6();
   TEST_CASE7();
+  TEST_CASE8();
 
   EXIT_CHECK();
 }
@@ -0,0 +1,97 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+// Solderpad Hardware License, Version 0.51, see LICENSE for details.
+// SPDX-License-Identifier: SHL-0.51
+
+#include "vector_macros.h"
+
+// Zvkned rounds: vaesdm, vaesdf, vaesem, vaesef in the .vv and .vs forms,
+// and vaesz.vs, on two element groups. The .vs forms use the key of element
+// group 0 of vs2 for both groups
+void TEST_CASE1(void) {
+  // vaesdm.vv
+  VSET(8, e32, m1);
+  VLOAD_32(v2, 0xb29ff1d0, 0x7659c43d, 0x006afff4, 0xecd3a884,
+           0x44d90807, 0xa6a73235, 0x8facd327, 0x0336f273);
+  VLOAD_32(v1, 0x846f2469, 0xc7597597, 0x07ba5f0b, 0x94918827,
+           0xc8bb4920, 0x799ad194, 0x2d67e399, 0x92d99954);
+  asm volatile(".insn r 0x77, 2, 0x51, x1, x0, x2");
+  VCMP_U32(1, v1, 0xddd93fb5, 0x4df3a37c, 0x484b2d0f, 0xacdad85e,
+           0xceb3fb1c, 0xe2b49c90, 0x5201da7c, 0x00881218);
+
+  // vaesdm.vs
+  VLOAD_32(v1, 0x846f2469, 0xc7597597, 0x07ba5f0b, 0x94918827,
+           0xc8bb4920, 0x799ad194, 0x2d67e399, 0x92d99954);
+  asm volatile(".insn r 0x77, 2, 0x53, x1, x0, x2");
+  VCMP_U32(2, v1, 0xddd93fb5, 0x4df3a37c, 0x484b2d0f, 0xacdad85e,
+           0x44fe59e7, 0x0be9e880, 0xae70f26f, 0xd5d9270e);
+
+  // vaesdf.vv
+  VSET(8, e32, m1);
+  VLOAD_32(v2, 0x5924be24, 0x9e61bc3f, 0xbdf6ccfe, 0x7bd214b9,
+           0xd03aa409, 0x8b238e97, 0x2f4265ed, 0x2846afc6);
+  VLOAD_32(v1, 0xaf6eb340, 0xfaf7e321, 0xe652fc35, 0x57c4c963,
+           0x69416640, 0x3d1cc92d, 0x44bcdccd, 0x83f2b625);
+  asm volatile(".insn r 0x77, 2, 0x51, x1, x1, x2");
+  VCMP_U32(3, v1, 0x4d6cac56, 0x6be9f744, 0x67b38127, 0x60f441b9,
+           0x5b42dd7b, 0x0d275d6d, 0x6eba776d, 0xcc823c04);
+
+  // vaesdf.vs
+  VLOAD_32(v1, 0xaf6eb340, 0xfaf7e321, 0xe652fc35, 0x57c4c963,
+           0x69416640, 0x3d1cc92d, 0x44bcdccd, 0x83f2b625);
+  asm volatile(".insn r 0x77, 2, 0x53, x1, x1, x2");
+  VCMP_U32(4, v1, 0x4d6cac56, 0x6be9f744, 0x67b38127, 0x60f441b9,
+           0xd25cc756, 0x18656fc5, 0xfc0ede7e, 0x9f16877b);
+
+  // vaesem.vv
+  VSET(8, e32, m1);
+  VLOAD_32(v2, 0x4115bbb5, 0x797a71aa, 0x8a586de1, 0x78783c11,
+           0x42e5832e, 0x7a9bfa95, 0x45035f8f, 0x6aeba51f);
+  VLOAD_32(v1, 0xbb28ade5, 0x58313b09, 0x5c17164d, 0x91e9e20f,
+           0x396ddc4b, 0x9bc220a9, 0xbf2fd55b, 0x8afc3fe9);
+  asm volatile(".insn r 0x77, 2, 0x51, x1, x2, x2");
+  VCMP_U32(5, v1, 0x3a4d3750, 0xec253695, 0xccf593d1, 0x24d063d4,
+           0xd24904fa, 0x8306f68f, 0x6f0bdc4a, 0xfb21cb9f);
+
+  // vaesem.vs
+  VLOAD_32(v1, 0xbb28ade5, 0x58313b09, 0x5c17164d, 0x91e9e20f,
+           0x396ddc4b, 0x9bc220a9, 0xbf2fd55b, 0x8afc3fe9);
+  asm volatile(".insn r 0x77, 2, 0x53, x1, x2, x2");
+  VCMP_U32(6, v1, 0x3a4d3750, 0xec253695, 0xccf593d1, 0x24d063d4,
+           0xd1b93c61, 0x80e77db0, 0xa050ee24, 0xe9b25291);
+
+  // vaesef.vv
+  VSET(8, e32, m1);
+  VLOAD_32(v2, 0xaa763364, 0x9a60cd53, 0x8d5ff550, 0x7fa98d0f,
+           0x8923c66a, 0xf1a2705f, 0xa2c6c81f, 0x923bdeca);
+  VLOAD_32(v1, 0x2a318909, 0x84821bf3, 0xd80529f4, 0x38fb42ee,
+           0xcc6622e5, 0x5df895f1, 0xc0c3b2a9, 0x0a441c51);
+  asm volatile(".insn r 0x77, 2, 0x51, x1, x3, x2");
+  VCMP_U32(7, v1, 0xad1d9c65, 0x7f6f685e, 0xd298d9ef, 0x1eba2a27,
+           0xee0decb3, 0xbab947fe, 0xeef554cc, 0x287a4d1b);
+
+  // vaesef.vs
+  VLOAD_32(v1, 0x2a318909, 0x84821bf3, 0xd80529f4, 0x38fb42ee,
+           0xcc6622e5, 0x5df895f1, 0xc0c3b2a9, 0x0a441c51);
+  asm volatile(".insn r 0x77, 2, 0x53, x1, x3, x2");
+  VCMP_U32(8, v1, 0xad1d9c65, 0x7f6f685e, 0xd298d9ef, 0x1eba2a27,
+           0xcd5819bd, 0xd17bfaf2, 0xc16c6983, 0xc5e81ede);
+
+  // vaesz.vs
+  VSET(8, e32, m1);
+  VLOAD_32(v2, 0xa01362a0, 0x8e6c0856, 0xd7cd49e2, 0x9c58df55,
+           0x7772dfbb, 0xe9878d89, 0x6608b08b, 0x674b51ab);
+  VLOAD_32(v1, 0x70022da5, 0x0433e90f, 0x19a73a39, 0x06e9f047,
+           0x48bf0a10, 0x06ac3197, 0x5306439b, 0x90f51066);
+  asm volatile(".insn r 0x77, 2, 0x53, x1, x7, x2");
+  VCMP_U32(9, v1, 0xd0114f05, 0x8a5fe159, 0xce6a73db, 0x9ab12f12,
+           0xe8ac68b0, 0x88c039c1, 0x84cb0a79, 0x0cadcf33);
+}
+
+int main(void) {
+  INIT_CHECK();
+  enable_vec();
+
+  TEST_CASE1();
+
+  EXIT_CHECK();
+}
@@ -0,0 +1,46 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+// Solderpad Hardware License, Version 0.51, see LICENSE for details.
+// SPDX-License-Identifier: SHL-0.51
+
+#include "vector_macros.h"
+
+// Zvkned key schedule: vaeskf1.vi and vaeskf2.vi, on two element groups
+void TEST_CASE1(void) {
+  // vaeskf1.vi, from the key of FIPS-197 and a random one
+  VSET(8, e32, m1);
+  VLOAD_32(v2, 0x03020100, 0x07060504, 0x0b0a0908, 0x0f0e0d0c,
+           0x5c273e7d, 0x2f93ae35, 0x938d9364, 0x77ddb58a);
+  asm volatile(".insn r 0x77, 2, 0x45, x1, x1, x2");
+  VCMP_U32(1, v1, 0xfd74aad6, 0xfa72afd2, 0xf178a6da, 0xfe76abd6,
+           0x22d2ffa9, 0x0d41519c, 0x9eccc2f8, 0xe9117772);
+  asm volatile(".insn r 0x77, 2, 0x45, x1, x10, x2");
+  VCMP_U32(2, v1, 0xfd74aae1, 0xfa72afe5, 0xf178a6ed, 0xfe76abe1,
+           0x22d2ff9e, 0x0d4151ab, 0x9eccc2cf, 0xe9117745);
+  // Out of range rounds take rnd ^ 8
+  asm volatile(".insn r 0x77, 2, 0x45, x1, x0, x2");
+  VCMP_U32(3, v1, 0xfd74aa57, 0xfa72af53, 0xf178a65b, 0xfe76ab57,
+           0x22d2ff28, 0x0d41511d, 0x9eccc279, 0xe91177f3);
+
+  // vaeskf2.vi, from the key of FIPS-197 and a random one
+  VLOAD_32(v2, 0x13121110, 0x17161514, 0x1b1a1918, 0x1f1e1d1c,
+           0x4426b0e7, 0x13abe9fc, 0xd4edecba, 0x7901139e);
+  VLOAD_32(v1, 0x03020100, 0x07060504, 0x0b0a0908, 0x0f0e0d0c,
+           0xb01272c7, 0x619481a2, 0x86b56afb, 0x3341c10b);
+  asm volatile(".insn r 0x77, 2, 0x55, x1, x2, x2");
+  VCMP_U32(4, v1, 0x9fc273a5, 0x98c476a1, 0x93ce7fa9, 0x9cc072a5,
+           0xbba40ebb, 0xda308f19, 0x5c85e5e2, 0x6fc424e9);
+  VLOAD_32(v1, 0x03020100, 0x07060504, 0x0b0a0908, 0x0f0e0d0c,
+           0xb01272c7, 0x619481a2, 0x86b56afb, 0x3341c10b);
+  asm volatile(".insn r 0x77, 2, 0x55, x1, x3, x2");
+  VCMP_U32(5, v1, 0xc370a59c, 0xc476a098, 0xcf7ca990, 0xc072a49c,
+           0x066e0fcc, 0x67fa8e6e, 0xe14fe495, 0xd20e259e);
+}
+
+int main(void) {
+  INIT_CHECK();
+  enable_vec();
+
+  TEST_CASE1();
+
+  EXIT_CHECK();
+}
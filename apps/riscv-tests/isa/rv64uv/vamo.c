@@ -0,0 +1,124 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+// Solderpad Hardware License, Version 0.51, see LICENSE for details.
+// SPDX-License-Identifier: SHL-0.51
+
+#include "vector_macros.h"
+
+// The vector AMOs (without wd) are encoded with .insn, since the toolchain no
+// longer knows the Zvamo instructions: funct3 is the index EEW, funct7 encodes
+// {amoop, wd, vm}, rd is vs3, and rs2 is the index register vs2.
+#define VAMOADDEI32(vs3, vs2, base)                                            \
+  asm volatile(".insn r 0x2f, 6, 0x01, x" #vs3 ", %0, x" #vs2 ::"r"(base))
+#define VAMOADDEI32_M(vs3, vs2, base)                                          \
+  asm volatile(".insn r 0x2f, 6, 0x00, x" #vs3 ", %0, x" #vs2 ::"r"(base))
+#define VAMOXOREI32(vs3, vs2, base)                                            \
+  asm volatile(".insn r 0x2f, 6, 0x11, x" #vs3 ", %0, x" #vs2 ::"r"(base))
+#define VAMOANDEI32(vs3, vs2, base)                                            \
+  asm volatile(".insn r 0x2f, 6, 0x31, x" #vs3 ", %0, x" #vs2 ::"r"(base))
+#define VAMOOREI32(vs3, vs2, base)                                             \
+  asm volatile(".insn r 0x2f, 6, 0x21, x" #vs3 ", %0, x" #vs2 ::"r"(base))
+#define VAMOMINEI32(vs3, vs2, base)                                            \
+  asm volatile(".insn r 0x2f, 6, 0x41, x" #vs3 ", %0, x" #vs2 ::"r"(base))
+#define VAMOMAXEI32(vs3, vs2, base)                                            \
+  asm volatile(".insn r 0x2f, 6, 0x51, x" #vs3 ", %0, x" #vs2 ::"r"(base))
+#define VAMOMINUEI32(vs3, vs2, base)                                           \
+  asm volatile(".insn r 0x2f, 6, 0x61, x" #vs3 ", %0, x" #vs2 ::"r"(base))
+#define VAMOMAXUEI32(vs3, vs2, base)                                           \
+  asm volatile(".insn r 0x2f, 6, 0x71, x" #vs3 ", %0, x" #vs2 ::"r"(base))
+#define VAMOADDEI64(vs3, vs2, base)                                            \
+  asm volatile(".insn r 0x2f, 7, 0x01, x" #vs3 ", %0, x" #vs2 ::"r"(base))
+
+static volatile uint32_t BUFFER_O32[4] __attribute__((aligned(16)));
+static volatile uint64_t BUFFER_O64[4] __attribute__((aligned(32)));
+
+void reset_vec32(volatile uint32_t *vec, uint32_t a, uint32_t b, uint32_t c,
+                 uint32_t d) {
+  vec[0] = a;
+  vec[1] = b;
+  vec[2] = c;
+  vec[3] = d;
+}
+
+// Scatter-reduce: the elements with the same index all update the memory
+void TEST_CASE1(void) {
+  reset_vec32(BUFFER_O32, 98, 98, 98, 98);
+  VSET(6, e32, m1);
+  VLOAD_32(v2, 1, 2, 3, 4, 5, 6);
+  VLOAD_32(v4, 0, 4, 4, 12, 4, 0);
+  VAMOADDEI32(2, 4, BUFFER_O32);
+  VVCMP_U32(1, BUFFER_O32, 105, 108, 98, 102);
+
+  reset_vec32(BUFFER_O32, 98, 98, 98, 98);
+  VSET(6, e32, m1);
+  VLOAD_8(v0, 0x2A);
+  VLOAD_32(v2, 1, 2, 3, 4, 5, 6);
+  VLOAD_32(v4, 0, 4, 4, 12, 4, 0);
+  VAMOADDEI32_M(2, 4, BUFFER_O32);
+  VVCMP_U32(2, BUFFER_O32, 104, 100, 98, 102);
+
+  BUFFER_O64[0] = 0xffffffffffffffff;
+  BUFFER_O64[1] = 0x0000000100000000;
+  BUFFER_O64[2] = 0;
+  BUFFER_O64[3] = 0;
+  VSET(3, e64, m1);
+  VLOAD_64(v2, 1, 0xffffffff, 7);
+  VLOAD_64(v4, 0, 8, 0);
+  VAMOADDEI64(2, 4, BUFFER_O64);
+  VVCMP_U64(3, BUFFER_O64, 7, 0x00000001ffffffff, 0, 0);
+}
+
+// Logic operations
+void TEST_CASE2(void) {
+  reset_vec32(BUFFER_O32, 0xff00ff00, 0xff00ff00, 0xff00ff00, 0xff00ff00);
+  VSET(4, e32, m1);
+  VLOAD_32(v2, 0x0ff00ff0, 0xf0f0f0f0, 0x00ff0000, 0xffffffff);
+  VLOAD_32(v4, 0, 4, 8, 12);
+  VAMOANDEI32(2, 4, BUFFER_O32);
+  VVCMP_U32(4, BUFFER_O32, 0x0f000f00, 0xf000f000, 0x00000000, 0xff00ff00);
+
+  reset_vec32(BUFFER_O32, 0xff00ff00, 0xff00ff00, 0xff00ff00, 0xff00ff00);
+  VSET(4, e32, m1);
+  VAMOOREI32(2, 4, BUFFER_O32);
+  VVCMP_U32(5, BUFFER_O32, 0xfff0fff0, 0xfff0fff0, 0xffffff00, 0xffffffff);
+
+  reset_vec32(BUFFER_O32, 0xff00ff00, 0xff00ff00, 0xff00ff00, 0xff00ff00);
+  VSET(4, e32, m1);
+  VAMOXOREI32(2, 4, BUFFER_O32);
+  VVCMP_U32(6, BUFFER_O32, 0xf0f0f0f0, 0x0ff00ff0, 0xffffff00, 0x00ff00ff);
+}
+
+// Signed and unsigned minimum and maximum
+void TEST_CASE3(void) {
+  reset_vec32(BUFFER_O32, 5, 0xfffffff0, 5, 0xfffffff0);
+  VSET(4, e32, m1);
+  VLOAD_32(v2, 0xffffffff, 3, 7, 0x7fffffff);
+  VLOAD_32(v4, 0, 4, 8, 12);
+  VAMOMINEI32(2, 4, BUFFER_O32);
+  VVCMP_U32(7, BUFFER_O32, 0xffffffff, 0xfffffff0, 5, 0xfffffff0);
+
+  reset_vec32(BUFFER_O32, 5, 0xfffffff0, 5, 0xfffffff0);
+  VSET(4, e32, m1);
+  VAMOMAXEI32(2, 4, BUFFER_O32);
+  VVCMP_U32(8, BUFFER_O32, 5, 3, 7, 0x7fffffff);
+
+  reset_vec32(BUFFER_O32, 5, 0xfffffff0, 5, 0xfffffff0);
+  VSET(4, e32, m1);
+  VAMOMINUEI32(2, 4, BUFFER_O32);
+  VVCMP_U32(9, BUFFER_O32, 5, 3, 5, 0x7fffffff);
+
+  reset_vec32(BUFFER_O32, 5, 0xfffffff0, 5, 0xfffffff0);
+  VSET(4, e32, m1);
+  VAMOMAXUEI32(2, 4, BUFFER_O32);
+  VVCMP_U32(10, BUFFER_O32, 0xffffffff, 0xfffffff0, 7, 0xfffffff0);
+}
+
+int main(void) {
+  INIT_CHECK();
+  enable_vec();
+
+  TEST_CASE1();
+  TEST_CASE2();
+  TEST_CASE3();
+
+  EXIT_CHECK();
+}
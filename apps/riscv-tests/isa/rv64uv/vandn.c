@@ -0,0 +1,138 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+// Solderpad Hardware License, Version 0.51, see LICENSE for details.
+// SPDX-License-Identifier: SHL-0.51
+
+#include "vector_macros.h"
+
+// The toolchain does not know Zvbb: the instructions are encoded with .insn,
+// with funct7 = {funct6, vm}
+
+// vandn.vv
+void TEST_CASE1(void) {
+  VSET(8, e8, m1);
+  VLOAD_8(v2, 0x52, 0xf2, 0x26, 0x65, 0xa6, 0x0c, 0x12, 0xd2);
+  VLOAD_8(v3, 0x89, 0x18, 0x5d, 0x95, 0x0e, 0xe8, 0x81, 0x36);
+  asm volatile(".insn r 0x57, 0, 0x03, x1, x3, x2");
+  VCMP_U8(1, v1, 0x52, 0xe2, 0x22, 0x60, 0xa0, 0x04, 0x12, 0xc0);
+
+  VSET(8, e16, m1);
+  VLOAD_16(v2, 0x0999, 0x1600, 0x6f03, 0x6b0d, 0x11e2, 0x3d9c, 0x1738, 0x8d11);
+  VLOAD_16(v3, 0x6cad, 0x0f21, 0xd3ac, 0x90c1, 0x1fb1, 0xf28c, 0x3926, 0xa170);
+  asm volatile(".insn r 0x57, 0, 0x03, x1, x3, x2");
+  VCMP_U16(2, v1, 0x0110, 0x1000, 0x2c03, 0x6b0c, 0x0042, 0x0d10, 0x0618,
+           0x0c01);
+
+  VSET(8, e32, m1);
+  VLOAD_32(v2, 0xa09f76b5, 0x953f48f1, 0xf29d0da9, 0x0fd630f1, 0x93bd04cf,
+           0x95e60af5, 0x658cda14, 0x0cb1e29c);
+  VLOAD_32(v3, 0xf9ebdacc, 0x3898d190, 0x0becd7b0, 0x8e81973e, 0xdbc496cb,
+           0x2217bead, 0x4a23d596, 0x6b4cb242);
+  asm volatile(".insn r 0x57, 0, 0x03, x1, x3, x2");
+  VCMP_U32(3, v1, 0x00142431, 0x85270861, 0xf0110809, 0x015620c1, 0x00390004,
+           0x95e00050, 0x258c0a00, 0x04b1409c);
+
+  VSET(8, e64, m1);
+  VLOAD_64(v2, 0x8a6a63ec24ede6a4, 0x922766581e27a1c0, 0x8f6d05584ef8aa38,
+           0xae97ba94d0eda82f, 0x1a61dbe22e44158b, 0x923a736994e3bf91,
+           0x301850c5a38fd547, 0x18f135d25f557203);
+  VLOAD_64(v3, 0xb64ce4228c38fb29, 0x907a70c31012f037, 0x9e7769b10f4205b4,
+           0x7f15052434b9b5df, 0x881ed162ae2eb154, 0xc6f877186d76b07e,
+           0x7731af10506bf2ef, 0xec66a78795e761d1);
+  asm volatile(".insn r 0x57, 0, 0x03, x1, x3, x2");
+  VCMP_U64(4, v1, 0x082203cc20c50484, 0x020506180e2501c0, 0x0108044840b8aa08,
+           0x8082ba90c0440820, 0x12610a800040048b, 0x1002006190810f81,
+           0x000850c5a3840500, 0x109110504a101202);
+}
+
+// vandn.vv, masked
+void TEST_CASE2(void) {
+  VSET(8, e8, m1);
+  VLOAD_8(v0, 0x6D);
+  VLOAD_8(v2, 0x74, 0x5c, 0x4c, 0x3f, 0xcb, 0x2e, 0xb2, 0xc7);
+  VLOAD_8(v3, 0x3e, 0x14, 0x93, 0x4c, 0x86, 0x7e, 0xe0, 0x57);
+  VLOAD_8(v1, 0xef, 0xef, 0xef, 0xef, 0xef, 0xef, 0xef, 0xef);
+  asm volatile(".insn r 0x57, 0, 0x02, x1, x3, x2");
+  VCMP_U8(5, v1, 0x40, 0xef, 0x4c, 0x33, 0xef, 0x00, 0x12, 0xef);
+
+  VSET(8, e16, m1);
+  VLOAD_8(v0, 0x6D);
+  VLOAD_16(v2, 0xbabc, 0x72e6, 0x49b6, 0x9be4, 0xfaec, 0x12bd, 0x1e39, 0x830e);
+  VLOAD_16(v3, 0x6b0a, 0x2a3a, 0xc1d3, 0x5790, 0x26e8, 0xeeea, 0x7d2c, 0x6bf4);
+  VLOAD_16(v1, 0x00ef, 0x00ef, 0x00ef, 0x00ef, 0x00ef, 0x00ef, 0x00ef, 0x00ef);
+  asm volatile(".insn r 0x57, 0, 0x02, x1, x3, x2");
+  VCMP_U16(6, v1, 0x90b4, 0x00ef, 0x0824, 0x8864, 0x00ef, 0x1015, 0x0211,
+           0x00ef);
+
+  VSET(8, e32, m1);
+  VLOAD_8(v0, 0x6D);
+  VLOAD_32(v2, 0x0a097c97, 0xf646e1f4, 0xab1031d0, 0x13deef86, 0xc3baea9e,
+           0x8ede0d7a, 0x92b1d3f2, 0xca02135e);
+  VLOAD_32(v3, 0xe01f5057, 0xd17f9aca, 0x5051c1cc, 0x57124242, 0xb1fee08f,
+           0x59a54a7b, 0x98289fcd, 0x7f26144b);
+  VLOAD_32(v1, 0x000000ef, 0x000000ef, 0x000000ef, 0x000000ef, 0x000000ef,
+           0x000000ef, 0x000000ef, 0x000000ef);
+  asm volatile(".insn r 0x57, 0, 0x02, x1, x3, x2");
+  VCMP_U32(7, v1, 0x0a002c80, 0x000000ef, 0xab003010, 0x00ccad84, 0x000000ef,
+           0x865a0500, 0x02914032, 0x000000ef);
+
+  VSET(8, e64, m1);
+  VLOAD_8(v0, 0x6D);
+  VLOAD_64(v2, 0xcc011cdd9474031b, 0x119a72d174c9df6a, 0x17f5e837d70820fe,
+           0x451abd81f1d69ed6, 0xb2715945795e8229, 0x10a3d6b2aa05e11a,
+           0xbb2d420f0f88080b, 0x4f426dcbb394fb36);
+  VLOAD_64(v3, 0x93f448b3a5aa3c81, 0xae658f33fe3b890b, 0x72158370d269a9a5,
+           0xb774eb5248db40af, 0xe315128862c33a4f, 0x58d5563dab2cd31e,
+           0xf0ce583505c6af07, 0x5affb2297631a992);
+  VLOAD_64(v1, 0x00000000000000ef, 0x00000000000000ef, 0x00000000000000ef,
+           0x00000000000000ef, 0x00000000000000ef, 0x00000000000000ef,
+           0x00000000000000ef, 0x00000000000000ef);
+  asm volatile(".insn r 0x57, 0, 0x02, x1, x3, x2");
+  VCMP_U64(8, v1, 0x4c01144c1054031a, 0x00000000000000ef, 0x05e068070500005a,
+           0x400a1481b1049e50, 0x00000000000000ef, 0x0022808200012000,
+           0x0b21020a0a080008, 0x00000000000000ef);
+}
+
+// vandn.vx
+void TEST_CASE3(void) {
+  VSET(8, e8, m1);
+  VLOAD_8(v2, 0x2b, 0x9c, 0x1d, 0x7e, 0x0f, 0x37, 0xc4, 0x49);
+  uint64_t scalar = 0x21;
+  asm volatile(".insn r 0x57, 4, 0x03, x1, %0, x2" ::"r"(scalar));
+  VCMP_U8(9, v1, 0x0a, 0x9c, 0x1c, 0x5e, 0x0e, 0x16, 0xc4, 0x48);
+
+  VSET(8, e16, m1);
+  VLOAD_16(v2, 0xbd05, 0x3f63, 0x65dc, 0x6415, 0xeab4, 0xdf15, 0x7f1b, 0x14a0);
+  scalar = 0x2a96;
+  asm volatile(".insn r 0x57, 4, 0x03, x1, %0, x2" ::"r"(scalar));
+  VCMP_U16(10, v1, 0x9501, 0x1561, 0x4548, 0x4401, 0xc020, 0xd501, 0x5509,
+           0x1420);
+
+  VSET(8, e32, m1);
+  VLOAD_32(v2, 0x72fdf202, 0x66d22876, 0x8ca81811, 0x4720771f, 0xe2257159,
+           0x230d977e, 0xd1bc52d9, 0x6e36aab0);
+  scalar = 0xdd2e1609;
+  asm volatile(".insn r 0x57, 4, 0x03, x1, %0, x2" ::"r"(scalar));
+  VCMP_U32(11, v1, 0x22d1e002, 0x22d02876, 0x00800810, 0x02006116, 0x22016150,
+           0x22018176, 0x009040d0, 0x2210a8b0);
+
+  VSET(8, e64, m1);
+  VLOAD_64(v2, 0x47469a4d8cdb305f, 0x6a50df4db4d66a3a, 0x5bd86d40fc891b4a,
+           0xe25a7605aec6f024, 0xf52ddf5d616499c9, 0x26a2c0bd3b1287ff,
+           0x2d1c9af0153e7c2a, 0x3b61867626bb7dbd);
+  scalar = 0x3bbbe9eaa8948c89;
+  asm volatile(".insn r 0x57, 4, 0x03, x1, %0, x2" ::"r"(scalar));
+  VCMP_U64(12, v1, 0x44441205044b3056, 0x4040160514426232, 0x4040040054091342,
+           0xc040160506427024, 0xc404161541601140, 0x0400001513020376,
+           0x04041210152a7022, 0x00400614062b7134);
+}
+
+int main(void) {
+  INIT_CHECK();
+  enable_vec();
+
+  TEST_CASE1();
+  TEST_CASE2();
+  TEST_CASE3();
+
+  EXIT_CHECK();
+}
@@ -0,0 +1,75 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+// Solderpad Hardware License, Version 0.51, see LICENSE for details.
+// SPDX-License-Identifier: SHL-0.51
+
+#include "vector_macros.h"
+
+// vbrev.v
+void TEST_CASE1(void) {
+  VSET(8, e8, m1);
+  VLOAD_8(v2, 0xeb, 0xc9, 0x3a, 0xf8, 0xe0, 0x1a, 0x15, 0x43);
+  asm volatile(".insn r 0x57, 2, 0x25, x1, x10, x2");
+  VCMP_U8(1, v1, 0xd7, 0x93, 0x5c, 0x1f, 0x07, 0x58, 0xa8, 0xc2);
+
+  VSET(8, e16, m1);
+  VLOAD_16(v2, 0x459c, 0x0a22, 0xe7e8, 0xc76c, 0x2e7a, 0x453b, 0xc17a, 0x212a);
+  asm volatile(".insn r 0x57, 2, 0x25, x1, x10, x2");
+  VCMP_U16(2, v1, 0x39a2, 0x4450, 0x17e7, 0x36e3, 0x5e74, 0xdca2, 0x5e83,
+           0x5484);
+
+  VSET(8, e32, m1);
+  VLOAD_32(v2, 0xd1dcec53, 0x6c18d982, 0xd97e967b, 0xe9526a69, 0xad0c9bb6,
+           0xd1a89b37, 0xf22d2882, 0x42343354);
+  asm volatile(".insn r 0x57, 2, 0x25, x1, x10, x2");
+  VCMP_U32(3, v1, 0xca373b8b, 0x419b1836, 0xde697e9b, 0x96564a97, 0x6dd930b5,
+           0xecd9158b, 0x4114b44f, 0x2acc2c42);
+
+  VSET(8, e64, m1);
+  VLOAD_64(v2, 0x263cfa5e67ec326a, 0xeb4ed2e3895e8b6b, 0x9212824c83c8cb28,
+           0xb34e8ece7e9ee51d, 0x16e6fec353b97377, 0x0eba0ea84770a087,
+           0xb02e3d8dccb1c51d, 0x6ce193c22eefa279);
+  asm volatile(".insn r 0x57, 2, 0x25, x1, x10, x2");
+  VCMP_U64(4, v1, 0x564c37e67a5f3c64, 0xd6d17a91c74b72d7, 0x14d313c132414849,
+           0xb8a7797e737172cd, 0xeece9dcac37f6768, 0xe1050ee215705d70,
+           0xb8a38d33b1bc740d, 0x9e45f77443c98736);
+}
+
+// vbrev8.v
+void TEST_CASE2(void) {
+  VSET(8, e8, m1);
+  VLOAD_8(v2, 0xe5, 0x12, 0x44, 0xf0, 0x04, 0xa2, 0x16, 0xcd);
+  asm volatile(".insn r 0x57, 2, 0x25, x1, x8, x2");
+  VCMP_U8(5, v1, 0xa7, 0x48, 0x22, 0x0f, 0x20, 0x45, 0x68, 0xb3);
+
+  VSET(8, e16, m1);
+  VLOAD_16(v2, 0x42b3, 0x1570, 0x9bb1, 0xdb31, 0x38ef, 0x110e, 0x43b3, 0xdcde);
+  asm volatile(".insn r 0x57, 2, 0x25, x1, x8, x2");
+  VCMP_U16(6, v1, 0x42cd, 0xa80e, 0xd98d, 0xdb8c, 0x1cf7, 0x8870, 0xc2cd,
+           0x3b7b);
+
+  VSET(8, e32, m1);
+  VLOAD_32(v2, 0x1f2642aa, 0x742a8063, 0x02f4b342, 0x56d2a68c, 0xfe8ad4a1,
+           0x8d959c31, 0x6af25748, 0xed3a32a8);
+  asm volatile(".insn r 0x57, 2, 0x25, x1, x8, x2");
+  VCMP_U32(7, v1, 0xf8644255, 0x2e5401c6, 0x402fcd42, 0x6a4b6531, 0x7f512b85,
+           0xb1a9398c, 0x564fea12, 0xb75c4c15);
+
+  VSET(8, e64, m1);
+  VLOAD_64(v2, 0x449274d2ea59679a, 0x2114e0689f27f52c, 0x86e3e7260b0f873b,
+           0x3d0a270bb5a432cf, 0x1c0502c6f0290531, 0x2954ba5cf81e54dd,
+           0x0ce5af69430b91ed, 0x33a715682e5f950c);
+  asm volatile(".insn r 0x57, 2, 0x25, x1, x8, x2");
+  VCMP_U64(8, v1, 0x22492e4b579ae659, 0x84280716f9e4af34, 0x61c7e764d0f0e1dc,
+           0xbc50e4d0ad254cf3, 0x38a040630f94a08c, 0x942a5d3a1f782abb,
+           0x30a7f596c2d089b7, 0xcce5a81674faa930);
+}
+
+int main(void) {
+  INIT_CHECK();
+  enable_vec();
+
+  TEST_CASE1();
+  TEST_CASE2();
+
+  EXIT_CHECK();
+}
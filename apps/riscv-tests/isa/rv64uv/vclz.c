@@ -0,0 +1,44 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+// Solderpad Hardware License, Version 0.51, see LICENSE for details.
+// SPDX-License-Identifier: SHL-0.51
+
+#include "vector_macros.h"
+
+// vclz.v
+void TEST_CASE1(void) {
+  VSET(8, e8, m1);
+  VLOAD_8(v2, 0x00, 0xff, 0x01, 0x80, 0x09, 0xb0, 0x37, 0xfb);
+  asm volatile(".insn r 0x57, 2, 0x25, x1, x12, x2");
+  VCMP_U8(1, v1, 0x08, 0x00, 0x07, 0x00, 0x04, 0x00, 0x02, 0x00);
+
+  VSET(8, e16, m1);
+  VLOAD_16(v2, 0x0000, 0xffff, 0x0001, 0x8000, 0x000b, 0xba95, 0xa2cf, 0x23c4);
+  asm volatile(".insn r 0x57, 2, 0x25, x1, x12, x2");
+  VCMP_U16(2, v1, 0x0010, 0x0000, 0x000f, 0x0000, 0x000c, 0x0000, 0x0000,
+           0x0002);
+
+  VSET(8, e32, m1);
+  VLOAD_32(v2, 0x00000000, 0xffffffff, 0x00000001, 0x80000000, 0x0000d644,
+           0x213bca7f, 0x03a63966, 0x121ae3e6);
+  asm volatile(".insn r 0x57, 2, 0x25, x1, x12, x2");
+  VCMP_U32(3, v1, 0x00000020, 0x00000000, 0x0000001f, 0x00000000, 0x00000010,
+           0x00000002, 0x00000006, 0x00000003);
+
+  VSET(8, e64, m1);
+  VLOAD_64(v2, 0x0000000000000000, 0xffffffffffffffff, 0x0000000000000001,
+           0x8000000000000000, 0x055d45cd9c0c2bcb, 0x482cc78ef88ede10,
+           0x3e01aaa699498ac4, 0x4b05e1aeb153d69c);
+  asm volatile(".insn r 0x57, 2, 0x25, x1, x12, x2");
+  VCMP_U64(4, v1, 0x0000000000000040, 0x0000000000000000, 0x000000000000003f,
+           0x0000000000000000, 0x0000000000000005, 0x0000000000000001,
+           0x0000000000000002, 0x0000000000000001);
+}
+
+int main(void) {
+  INIT_CHECK();
+  enable_vec();
+
+  TEST_CASE1();
+
+  EXIT_CHECK();
+}
@@ -11,16 +11,46 @@ void TEST_CASE1() {
   VSET(4, e64, m1);
   VLOAD_64(v4, 1, 2, 3, 4);
   VLOAD_64(v0, 12, 0, 0, 0);
-  CLEAR(v2);
+  VCLEAR(v2);
   __asm__ volatile("vcompress.vm v2, v4, v0");
-  DEBUG_64(v2);
-  VEC_CMP_64(1, v2, 3, 4, 0, 0);
+  VCMP_U64(1, v2, 3, 4, 0, 0);
+}
+
+void TEST_CASE2() {
+  VSET(8, e8, m1);
+  VLOAD_8(v4, 1, 2, 3, 4, 5, 6, 7, 8);
+  VLOAD_8(v6, 0xa5, 0, 0, 0, 0, 0, 0, 0);
+  VCLEAR(v2);
+  __asm__ volatile("vcompress.vm v2, v4, v6");
+  VCMP_U8(2, v2, 1, 3, 6, 8, 0, 0, 0, 0);
+}
+
+// No element is selected
+void TEST_CASE3() {
+  VSET(4, e32, m1);
+  VLOAD_32(v4, 1, 2, 3, 4);
+  VLOAD_32(v6, 0, 0, 0, 0);
+  VLOAD_32(v2, 9, 9, 9, 9);
+  __asm__ volatile("vcompress.vm v2, v4, v6");
+  VCMP_U32(3, v2, 9, 9, 9, 9);
+}
+
+// Register groups
+void TEST_CASE4() {
+  VSET(6, e16, m2);
+  VLOAD_16(v4, 0x10, 0x20, 0x30, 0x40, 0x50, 0x60);
+  VLOAD_8(v1, 0x32, 0, 0, 0, 0, 0);
+  VCLEAR(v2);
+  __asm__ volatile("vcompress.vm v2, v4, v1");
+  VCMP_U16(4, v2, 0x20, 0x50, 0x60, 0, 0, 0);
 }
 
 int main(void) {
   INIT_CHECK();
   enable_vec();
-  enable_fp();
   TEST_CASE1();
+  TEST_CASE2();
+  TEST_CASE3();
+  TEST_CASE4();
   EXIT_CHECK();
 }
@@ -0,0 +1,44 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+// Solderpad Hardware License, Version 0.51, see LICENSE for details.
+// SPDX-License-Identifier: SHL-0.51
+
+#include "vector_macros.h"
+
+// vcpop.v
+void TEST_CASE1(void) {
+  VSET(8, e8, m1);
+  VLOAD_8(v2, 0x4c, 0x4d, 0xa1, 0x3b, 0x15, 0x95, 0xf5, 0x87);
+  asm volatile(".insn r 0x57, 2, 0x25, x1, x14, x2");
+  VCMP_U8(1, v1, 0x03, 0x04, 0x03, 0x05, 0x03, 0x04, 0x06, 0x04);
+
+  VSET(8, e16, m1);
+  VLOAD_16(v2, 0xda6e, 0xc023, 0x27be, 0xa854, 0xe48e, 0xb74b, 0xc8b6, 0xe10c);
+  asm volatile(".insn r 0x57, 2, 0x25, x1, x14, x2");
+  VCMP_U16(2, v1, 0x000a, 0x0005, 0x000a, 0x0006, 0x0008, 0x000a, 0x0008,
+           0x0006);
+
+  VSET(8, e32, m1);
+  VLOAD_32(v2, 0x98b81c66, 0x63b759f5, 0xc3a9e889, 0x537d9128, 0xb87e4e2b,
+           0xfc173498, 0x7e834904, 0x26433798);
+  asm volatile(".insn r 0x57, 2, 0x25, x1, x14, x2");
+  VCMP_U32(3, v1, 0x0000000e, 0x00000014, 0x0000000f, 0x0000000f, 0x00000012,
+           0x00000010, 0x0000000d, 0x0000000e);
+
+  VSET(8, e64, m1);
+  VLOAD_64(v2, 0xb96245d348bfcbcf, 0xa4aa07b49e6397d4, 0x0b35b1de250e7b34,
+           0xd5d5891fd329d65c, 0xe456559cb70af5f2, 0xa098d6918352bc85,
+           0xbbddbb9b6de2fb1f, 0xcfed943bb3783a7c);
+  asm volatile(".insn r 0x57, 2, 0x25, x1, x14, x2");
+  VCMP_U64(4, v1, 0x0000000000000024, 0x0000000000000020, 0x0000000000000020,
+           0x0000000000000023, 0x0000000000000023, 0x000000000000001b,
+           0x000000000000002c, 0x0000000000000026);
+}
+
+int main(void) {
+  INIT_CHECK();
+  enable_vec();
+
+  TEST_CASE1();
+
+  EXIT_CHECK();
+}
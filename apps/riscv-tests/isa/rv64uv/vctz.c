@@ -0,0 +1,44 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+// Solderpad Hardware License, Version 0.51, see LICENSE for details.
+// SPDX-License-Identifier: SHL-0.51
+
+#include "vector_macros.h"
+
+// vctz.v
+void TEST_CASE1(void) {
+  VSET(8, e8, m1);
+  VLOAD_8(v2, 0x00, 0xff, 0x01, 0x80, 0x03, 0x00, 0x43, 0x5d);
+  asm volatile(".insn r 0x57, 2, 0x25, x1, x13, x2");
+  VCMP_U8(1, v1, 0x08, 0x00, 0x00, 0x07, 0x00, 0x08, 0x00, 0x00);
+
+  VSET(8, e16, m1);
+  VLOAD_16(v2, 0x0000, 0xffff, 0x0001, 0x8000, 0x001f, 0x08d1, 0xf735, 0xe1e4);
+  asm volatile(".insn r 0x57, 2, 0x25, x1, x13, x2");
+  VCMP_U16(2, v1, 0x0010, 0x0000, 0x0000, 0x000f, 0x0000, 0x0000, 0x0000,
+           0x0002);
+
+  VSET(8, e32, m1);
+  VLOAD_32(v2, 0x00000000, 0xffffffff, 0x00000001, 0x80000000, 0x00002aec,
+           0x61b2480c, 0x1579da0a, 0x79823eb2);
+  asm volatile(".insn r 0x57, 2, 0x25, x1, x13, x2");
+  VCMP_U32(3, v1, 0x00000020, 0x00000000, 0x00000000, 0x0000001f, 0x00000002,
+           0x00000002, 0x00000001, 0x00000001);
+
+  VSET(8, e64, m1);
+  VLOAD_64(v2, 0x0000000000000000, 0xffffffffffffffff, 0x0000000000000001,
+           0x8000000000000000, 0x344a7419d0e823c1, 0x24d4589c16fa1421,
+           0x963892a766465d28, 0x64dbc8d30aaaaf81);
+  asm volatile(".insn r 0x57, 2, 0x25, x1, x13, x2");
+  VCMP_U64(4, v1, 0x0000000000000040, 0x0000000000000000, 0x0000000000000000,
+           0x000000000000003f, 0x0000000000000000, 0x0000000000000000,
+           0x0000000000000003, 0x0000000000000000);
+}
+
+int main(void) {
+  INIT_CHECK();
+  enable_vec();
+
+  TEST_CASE1();
+
+  EXIT_CHECK();
+}
@@ -431,6 +431,26 @@ void TEST_CASE8(void) {
   CHECK_FFLAGS(0);
 };
 
+// Tail- and mask-agnostic policy
+void TEST_CASE9(void) {
+  VSET_TAMA(16, e32, m1);
+  VLOAD_32(v2, 0xbe9451b0, 0x3ece4bf7, 0x3eadc098, 0x3f09f4f0, 0x3ecc80cc,
+           0xbe8a42c5, 0x3f47fd31, 0xbe201365, 0xbeffeb17, 0xbf314e2e,
+           0xbd0a9c78, 0xbf1fb51f, 0x3b5e1209, 0x3eac9a73, 0xbeb187b6,
+           0x3dea828d);
+  VLOAD_32(v3, 0xbf1f15f7, 0x3f221093, 0x3e87bc88, 0x3f5b7dc5, 0xbf48f0f0,
+           0xbee2fa95, 0xbf58c05e, 0x3e0f2cd8, 0x3f595e1c, 0x3e71592b,
+           0x3eaf8795, 0x3f10f25c, 0x3e6763bf, 0x3f0ef59a, 0x3f082d82,
+           0x3ccdafb0);
+  VLOAD_8(v0, 0xAA, 0xAA);
+  asm volatile("vfadd.vv v1, v2, v3, v0.t");
+  // The masked-off elements are agnostic: zero them to check the active ones
+  asm volatile("vmv.v.i v4, 0");
+  asm volatile("vmerge.vvm v1, v4, v1, v0");
+  VCMP_U32(24, v1, 0, 0x3f849b47, 0, 0x3fb2b95a, 0, 0xbf369ead, 0, 0xbc873468,
+           0, 0xbee9efc6, 0, 0xbd6c2c30, 0, 0x3f6542d4, 0, 0x3e0ef73c);
+};
+
 int main(void) {
   enable_vec();
   enable_fp();
@@ -444,6 +464,7 @@ int main(void) {
   TEST_CASE6();
   TEST_CASE7();
   TEST_CASE8();
+  TEST_CASE9();
 
   EXIT_CHECK();
 }
@@ -0,0 +1,36 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+// Solderpad Hardware License, Version 0.51, see LICENSE for details.
+// SPDX-License-Identifier: SHL-0.51
+
+#include "vector_macros.h"
+
+// Zvkg: vghsh.vv and vgmul.vv, on two element groups
+void TEST_CASE1(void) {
+  // vghsh.vv
+  VSET(8, e32, m1);
+  VLOAD_32(v1, 0xafccda47, 0x4ec0615b, 0x9bddfb74, 0x43f7451e,
+           0x144aab73, 0x72f1b862, 0x8d7b3771, 0xb9b0c663);
+  VLOAD_32(v2, 0x37533bb8, 0x5d53bf08, 0x29e5a60a, 0x783bd580,
+           0xc58e7a38, 0x2d76be9d, 0x0d8742c5, 0xf005e8b6);
+  VLOAD_32(v3, 0xfc72abaa, 0xf43d9b98, 0xdeff3efc, 0x3769ff4f,
+           0x67ae866d, 0x778c32ac, 0xfe908e8a, 0xc5abbc4b);
+  asm volatile(".insn r 0x77, 2, 0x59, x1, x3, x2");
+  VCMP_U32(1, v1, 0xbca76762, 0xcbfe833d, 0x62f15442, 0xc626ab5c,
+           0x1177143a, 0x94862b38, 0x5c5a5004, 0x0580fe0c);
+
+  // vgmul.vv
+  VLOAD_32(v1, 0xafccda47, 0x4ec0615b, 0x9bddfb74, 0x43f7451e,
+           0x144aab73, 0x72f1b862, 0x8d7b3771, 0xb9b0c663);
+  asm volatile(".insn r 0x77, 2, 0x51, x1, x17, x2");
+  VCMP_U32(2, v1, 0xa4c5c0ab, 0x7df121a3, 0x9f33da00, 0x27a41fa4,
+           0xfb36c54f, 0x3d55493f, 0x23a5bd0a, 0x1ffa1eeb);
+}
+
+int main(void) {
+  INIT_CHECK();
+  enable_vec();
+
+  TEST_CASE1();
+
+  EXIT_CHECK();
+}
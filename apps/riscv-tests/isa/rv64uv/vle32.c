@@ -283,6 +283,18 @@ void TEST_CASE19(void) {
   LVCMP_U32(19, v16, LONG_I32);
 }
 
+// Tail- and mask-agnostic policy
+void TEST_CASE20(void) {
+  VSET_TAMA(16, e32, m1);
+  VLOAD_8(v0, 0xAA, 0xAA);
+  asm volatile("vle32.v v3, (%0), v0.t" ::"r"(&ALIGNED_I32[0]));
+  // The masked-off elements are agnostic: zero them to check the active ones
+  asm volatile("vmv.v.i v4, 0");
+  asm volatile("vmerge.vvm v3, v4, v3, v0");
+  VCMP_U32(20, v3, 0, 0xf9aa71f0, 0, 0x99991348, 0, 0x38197598, 0, 0x81937598,
+           0, 0x3eeeeeee, 0, 0xab8b9148, 0, 0x31897598, 0, 0x89139848);
+}
+
 int main(void) {
   INIT_CHECK();
   enable_vec();
@@ -307,5 +319,6 @@ int main(void) {
   TEST_CASE17();
   TEST_CASE18();
   TEST_CASE19();
+  TEST_CASE20();
   EXIT_CHECK();
 }
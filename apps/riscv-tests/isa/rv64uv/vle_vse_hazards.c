@@ -200,6 +200,42 @@ void TEST_CASE12(void) {
   VCMP_U64(12, v12, 8, 16, 24, 32, 40, 48, 56, 64, 72, 80, 88, 96, 104, 112,
            120, 128);
 }
+//******RAW Hazard on the result of a functional unit****//
+void TEST_CASE13(void) {
+  reset_vec64(&BUFFER_O64[0], INIT, 16);
+  VSET(16, e64, m1);
+  VLOAD_64(v13, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16);
+  VLOAD_64(v14, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2);
+  VLOAD_64(v15, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3);
+  asm volatile("vmacc.vv v15, v13, v14");
+  asm volatile("vse64.v v15, (%0)" ::"r"(&BUFFER_O64[0]));
+  VVCMP_U64(13, BUFFER_O64, 5, 7, 9, 11, 13, 15, 17, 19, 21, 23, 25, 27, 29, 31,
+            33, 35);
+}
+
+void TEST_CASE14(void) {
+  reset_vec32(&BUFFER_O32[0], INIT, 16);
+  VSET(16, e32, m1);
+  VLOAD_32(v16, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16);
+  asm volatile("vadd.vi v17, v16, 10");
+  asm volatile("vse32.v v17, (%0)" ::"r"(&BUFFER_O32[0]));
+  VVCMP_U32(14, BUFFER_O32, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23,
+            24, 25, 26);
+}
+
+// The masked result keeps the inactive elements of the destination
+void TEST_CASE15(void) {
+  reset_vec64(&BUFFER_O64[0], INIT, 16);
+  VSET(16, e64, m1);
+  VLOAD_8(v0, 0xAA, 0xAA);
+  VLOAD_64(v18, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16);
+  VLOAD_64(v19, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1);
+  asm volatile("vmul.vv v19, v18, v18, v0.t");
+  asm volatile("vse64.v v19, (%0)" ::"r"(&BUFFER_O64[0]));
+  VVCMP_U64(15, BUFFER_O64, 1, 4, 1, 16, 1, 36, 1, 64, 1, 100, 1, 144, 1, 196,
+            1, 256);
+}
+
 int main(void) {
   INIT_CHECK();
   enable_vec();
@@ -217,6 +253,9 @@ int main(void) {
   TEST_CASE10();
   TEST_CASE11();
   TEST_CASE12();
+  TEST_CASE13();
+  TEST_CASE14();
+  TEST_CASE15();
 
   EXIT_CHECK();
 }
@@ -164,6 +164,64 @@ void TEST_CASE14(void) {
            0x9013930148815808, 0, 0x8319599991911111);
 }
 
+// Strided loads that span several AXI beats, with a base that is not aligned to
+// the beats
+void TEST_CASE15(void) {
+  VSET(12, e16, m1);
+  volatile uint16_t INP1[] = {0x8b33, 0xd5db, 0xf9de, 0x83ec, 0x29ec, 0x9b3b,
+                              0xad6e, 0x0b0e, 0x2508, 0xf7f0, 0x05a6, 0x3acc,
+                              0x9154, 0x3c44, 0x9f40, 0x124e, 0x221d, 0x4520,
+                              0x8b0d, 0x4ee9, 0x6c09, 0xdb55, 0x2660, 0xd0f6,
+                              0x491d, 0x1d48, 0x1078, 0x582c, 0xa42e, 0x80f4,
+                              0xb68c, 0xa3d9, 0x3000, 0xd2a2, 0x2dfd, 0x0adf,
+                              0xa831, 0xa24c, 0xc607, 0x8231, 0x1ea6, 0xfc40,
+                              0xbf52, 0x6b59, 0xb3e3, 0x4fd9, 0x08a6, 0x7fd4};
+  uint64_t stride = 8;
+  VCLEAR(v1);
+  asm volatile("vlse16.v v1, (%0), %1" ::"r"(&INP1[1]), "r"(stride));
+  VCMP_U16(15, v1, 0xd5db, 0x9b3b, 0xf7f0, 0x3c44, 0x4520, 0xdb55,
+           0x1d48, 0x80f4, 0xd2a2, 0xa24c, 0xfc40, 0x4fd9);
+}
+
+// Broadcast loads (rs2 = x0), masked, and over several VRF words from an
+// element that is not aligned to the AXI beats
+void TEST_CASE16(void) {
+  VSET(8, e16, m1);
+  volatile uint16_t INP1[] = {0x8b33, 0xd5db};
+  VLOAD_8(v0, 0x5A);
+  VCLEAR(v1);
+  asm volatile("vlse16.v v1, (%0), x0, v0.t" ::"r"(&INP1[1]));
+  VCMP_U16(16, v1, 0, 0xd5db, 0, 0xd5db, 0xd5db, 0, 0xd5db, 0);
+}
+
+void TEST_CASE17(void) {
+  VSET(16, e32, m4);
+  volatile uint32_t INP1[] = {0x9fe41920, 0x8f2e05e0, 0xf9aa71f0};
+  asm volatile("vlse32.v v4, (%0), x0" ::"r"(&INP1[1]));
+  VCMP_U32(17, v4, 0x8f2e05e0, 0x8f2e05e0, 0x8f2e05e0, 0x8f2e05e0, 0x8f2e05e0,
+           0x8f2e05e0, 0x8f2e05e0, 0x8f2e05e0, 0x8f2e05e0, 0x8f2e05e0,
+           0x8f2e05e0, 0x8f2e05e0, 0x8f2e05e0, 0x8f2e05e0, 0x8f2e05e0,
+           0x8f2e05e0);
+}
+
+// Strides that are not a power of two, with several elements per AXI beat
+void TEST_CASE18(void) {
+  VSET(8, e16, m1);
+  volatile uint16_t INP1[] = {0x8b33, 0xd5db, 0xf9de, 0x83ec, 0x29ec, 0x9b3b,
+                              0xad6e, 0x0b0e, 0x2508, 0xf7f0, 0x05a6, 0x3acc,
+                              0x9154, 0x3c44, 0x9f40, 0x124e, 0x221d, 0x4520,
+                              0x8b0d, 0x4ee9, 0x6c09, 0xdb55, 0x2660, 0xd0f6};
+  uint64_t stride = 6;
+  asm volatile("vlse16.v v1, (%0), %1" ::"r"(INP1), "r"(stride));
+  VCMP_U16(18, v1, 0x8b33, 0x83ec, 0xad6e, 0xf7f0, 0x9154, 0x124e, 0x8b0d,
+           0xdb55);
+
+  stride = -6;
+  asm volatile("vlse16.v v1, (%0), %1" ::"r"(&INP1[23]), "r"(stride));
+  VCMP_U16(19, v1, 0xd0f6, 0x6c09, 0x4520, 0x9f40, 0x3acc, 0x2508, 0x9b3b,
+           0xf9de);
+}
+
 int main(void) {
   INIT_CHECK();
   enable_vec();
@@ -186,5 +244,11 @@ int main(void) {
   TEST_CASE13();
   TEST_CASE14();
 
+  TEST_CASE15();
+
+  TEST_CASE16();
+  TEST_CASE17();
+  TEST_CASE18();
+
   EXIT_CHECK();
 }
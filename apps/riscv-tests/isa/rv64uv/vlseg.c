@@ -0,0 +1,136 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+// Solderpad Hardware License, Version 0.51, see LICENSE for details.
+// SPDX-License-Identifier: SHL-0.51
+
+#include "vector_macros.h"
+
+// Unit-strided segment loads
+void TEST_CASE1(void) {
+  VSET(4, e8, m1);
+  volatile uint8_t INP1[] = {0x00, 0x10, 0x01, 0x11, 0x02, 0x12, 0x03, 0x13};
+  asm volatile("vlseg2e8.v v2, (%0)" ::"r"(INP1));
+  VCMP_U8(1, v2, 0x00, 0x01, 0x02, 0x03);
+  VCMP_U8(2, v3, 0x10, 0x11, 0x12, 0x13);
+}
+
+void TEST_CASE2(void) {
+  VSET(2, e32, m1);
+  volatile uint32_t INP1[] = {0x9fe41920, 0x8f2e05e0, 0xf9aa71f0,
+                              0xc394bbd3, 0xa11a9384, 0xa7163840};
+  asm volatile("vlseg3e32.v v4, (%0)" ::"r"(INP1));
+  VCMP_U32(3, v4, 0x9fe41920, 0xc394bbd3);
+  VCMP_U32(4, v5, 0x8f2e05e0, 0xa11a9384);
+  VCMP_U32(5, v6, 0xf9aa71f0, 0xa7163840);
+}
+
+// Segment loads with LMUL > 1
+void TEST_CASE3(void) {
+  VSET(4, e64, m2);
+  volatile uint64_t INP1[] = {0x9fe419208f2e05e0, 0xf9aa71f0c394bbd3,
+                              0xa11a9384a7163840, 0x99991348a9f38cd1,
+                              0x9fa831c7a11a9384, 0x3840bb1d8f2a05e0,
+                              0xaa71f0c394bbd3a1, 0x1a9384a716384099};
+  asm volatile("vlseg2e64.v v8, (%0)" ::"r"(INP1));
+  VCMP_U64(6, v8, 0x9fe419208f2e05e0, 0xa11a9384a7163840, 0x9fa831c7a11a9384,
+           0xaa71f0c394bbd3a1);
+  VCMP_U64(7, v10, 0xf9aa71f0c394bbd3, 0x99991348a9f38cd1, 0x3840bb1d8f2a05e0,
+           0x1a9384a716384099);
+}
+
+// Strided segment loads
+void TEST_CASE4(void) {
+  VSET(3, e16, m1);
+  volatile uint16_t INP1[] = {0x9fe4, 0x1920, 0x8f2e, 0x05e0, 0xf9aa, 0x71f0,
+                              0xc394, 0xbbd3, 0xa11a, 0x9384, 0xa716, 0x3840};
+  uint64_t stride = 8;
+  asm volatile("vlsseg2e16.v v1, (%0), %1" ::"r"(INP1), "r"(stride));
+  VCMP_U16(8, v1, 0x9fe4, 0xf9aa, 0xa11a);
+  VCMP_U16(9, v2, 0x1920, 0x71f0, 0x9384);
+}
+
+// Indexed segment loads
+void TEST_CASE5(void) {
+  VSET(3, e8, m1);
+  volatile uint8_t INP1[] = {0x00, 0x10, 0x01, 0x11, 0x02, 0x12, 0x03, 0x13};
+  VLOAD_8(v1, 6, 0, 2);
+  asm volatile("vluxseg2ei8.v v2, (%0), v1" ::"r"(INP1));
+  VCMP_U8(10, v2, 0x03, 0x00, 0x01);
+  VCMP_U8(11, v3, 0x13, 0x10, 0x11);
+}
+
+// Masked segment loads
+void TEST_CASE6(void) {
+  VSET(4, e8, m1);
+  volatile uint8_t INP1[] = {0x00, 0x10, 0x01, 0x11, 0x02, 0x12, 0x03, 0x13};
+  VLOAD_8(v0, 0x5, 0x0, 0x0, 0x0);
+  VCLEAR(v2);
+  VCLEAR(v3);
+  asm volatile("vlseg2e8.v v2, (%0), v0.t" ::"r"(INP1));
+  VCMP_U8(12, v2, 0x00, 0x00, 0x02, 0x00);
+  VCMP_U8(13, v3, 0x10, 0x00, 0x12, 0x00);
+}
+
+// Unit-strided segment stores
+void TEST_CASE7(void) {
+  VSET(4, e8, m1);
+  volatile uint8_t OUT1[] = {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
+  VLOAD_8(v2, 0x00, 0x01, 0x02, 0x03);
+  VLOAD_8(v3, 0x10, 0x11, 0x12, 0x13);
+  asm volatile("vsseg2e8.v v2, (%0)" ::"r"(OUT1));
+  VVCMP_U8(14, OUT1, 0x00, 0x10, 0x01, 0x11, 0x02, 0x12, 0x03, 0x13);
+}
+
+void TEST_CASE8(void) {
+  VSET(2, e32, m1);
+  volatile uint32_t OUT1[] = {0x00000000, 0x00000000, 0x00000000,
+                              0x00000000, 0x00000000, 0x00000000};
+  VLOAD_32(v4, 0x9fe41920, 0xc394bbd3);
+  VLOAD_32(v5, 0x8f2e05e0, 0xa11a9384);
+  VLOAD_32(v6, 0xf9aa71f0, 0xa7163840);
+  asm volatile("vsseg3e32.v v4, (%0)" ::"r"(OUT1));
+  VVCMP_U32(15, OUT1, 0x9fe41920, 0x8f2e05e0, 0xf9aa71f0, 0xc394bbd3,
+            0xa11a9384, 0xa7163840);
+}
+
+// Strided segment stores
+void TEST_CASE9(void) {
+  VSET(2, e16, m1);
+  volatile uint16_t OUT1[] = {0x0000, 0x0000, 0x0000, 0x0000,
+                              0x0000, 0x0000, 0x0000, 0x0000};
+  uint64_t stride = 8;
+  VLOAD_16(v1, 0x9fe4, 0xf9aa);
+  VLOAD_16(v2, 0x1920, 0x71f0);
+  asm volatile("vssseg2e16.v v1, (%0), %1" ::"r"(OUT1), "r"(stride));
+  VVCMP_U16(16, OUT1, 0x9fe4, 0x1920, 0x0000, 0x0000, 0xf9aa, 0x71f0, 0x0000,
+            0x0000);
+}
+
+// Indexed segment stores
+void TEST_CASE10(void) {
+  VSET(2, e8, m1);
+  volatile uint8_t OUT1[] = {0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
+  VLOAD_8(v1, 4, 0);
+  VLOAD_8(v2, 0x03, 0x01);
+  VLOAD_8(v3, 0x13, 0x11);
+  asm volatile("vsuxseg2ei8.v v2, (%0), v1" ::"r"(OUT1));
+  VVCMP_U8(17, OUT1, 0x01, 0x11, 0x00, 0x00, 0x03, 0x13);
+}
+
+int main(void) {
+  INIT_CHECK();
+  enable_vec();
+
+  TEST_CASE1();
+  TEST_CASE2();
+  TEST_CASE3();
+  TEST_CASE4();
+  TEST_CASE5();
+  TEST_CASE6();
+
+  TEST_CASE7();
+  TEST_CASE8();
+  TEST_CASE9();
+  TEST_CASE10();
+
+  EXIT_CHECK();
+}
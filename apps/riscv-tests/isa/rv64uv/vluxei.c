@@ -152,6 +152,39 @@ void TEST_CASE5(void) {
            0x9031850931584902, 0x3189759837598759, 0x8913984898951989);
 }
 
+// Clustered indexes, that revisit the same blocks
+void TEST_CASE6(void) {
+  VSET(12, e32, m1);
+  VLOAD_32(v2, 0, 4, 16, 8, 20, 0, 36, 12, 40, 4, 60, 56);
+  asm volatile("vluxei32.v v1, (%0), v2" ::"r"(&ALIGNED_I32[0]));
+  VCMP_U32(19, v1, 0x9fe41920, 0xf9aa71f0, 0x9fa831c7, 0xa11a9384, 0x38197598,
+           0x9fe41920, 0x3eeeeeee, 0x99991348, 0x90139301, 0xf9aa71f0,
+           0x89139848, 0x83195999);
+
+  VCLEAR(v1);
+  asm volatile("vloxei32.v v1, (%0), v2" ::"r"(&ALIGNED_I32[0]));
+  VCMP_U32(20, v1, 0x9fe41920, 0xf9aa71f0, 0x9fa831c7, 0xa11a9384, 0x38197598,
+           0x9fe41920, 0x3eeeeeee, 0x99991348, 0x90139301, 0xf9aa71f0,
+           0x89139848, 0x83195999);
+}
+
+// Indexes that repeat and permute the elements of a block, as several elements
+// of an AXI request
+void TEST_CASE7(void) {
+  VSET(16, e16, m1);
+  VLOAD_8(v2, 6, 2, 2, 0, 14, 12, 30, 28, 6, 6, 6, 6, 16, 18, 4, 8);
+  asm volatile("vluxei8.v v1, (%0), v2" ::"r"(&ALIGNED_I16[0]));
+  VCMP_U16(21, v1, 0x8cd1, 0xbbd3, 0xbbd3, 0x05e0, 0x9388, 0x3489, 0x1989,
+           0x1111, 0x8cd1, 0x8cd1, 0x8cd1, 0x8cd1, 0x8188, 0x11ae, 0x3840,
+           0x9384);
+
+  VLOAD_8(v0, 0x55, 0x5A);
+  VCLEAR(v1);
+  asm volatile("vloxei8.v v1, (%0), v2, v0.t" ::"r"(&ALIGNED_I16[0]));
+  VCMP_U16(22, v1, 0x8cd1, 0, 0xbbd3, 0, 0x9388, 0, 0x1989, 0, 0, 0x8cd1, 0,
+           0x8cd1, 0x8188, 0, 0x3840, 0);
+}
+
 int main(void) {
   INIT_CHECK();
   enable_vec();
@@ -161,6 +194,8 @@ int main(void) {
   TEST_CASE3();
   TEST_CASE4();
   TEST_CASE5();
+  TEST_CASE6();
+  TEST_CASE7();
 
   EXIT_CHECK();
 }
@@ -64,6 +64,16 @@ void TEST_CASE6() {
   VCMP_U8(6, v2, 0, 0, 0, 0, 0, 0, 0, 0);
 }
 
+// Tail-agnostic policy: the old destination is not read
+void TEST_CASE7() {
+  VSET_TAMA(16, e8, m1);
+  VLOAD_8(v2, 0xCD, 0xEF);
+  VLOAD_8(v3, 0x84, 0x21);
+  asm volatile("vmand.mm v1, v2, v3");
+  VSET(2, e8, m1);
+  VCMP_U8(7, v1, 0x84, 0x21);
+}
+
 int main(void) {
   INIT_CHECK();
   enable_vec();
@@ -74,6 +84,7 @@ int main(void) {
   TEST_CASE4();
   TEST_CASE5();
   TEST_CASE6();
+  TEST_CASE7();
 
   EXIT_CHECK();
 }
@@ -291,6 +291,23 @@ void TEST_CASE6(void) {
   VCMP_U8(24, v1, 0x10, 0x10);
 };
 
+// Tail- and mask-agnostic policy: the old destination is not read. The
+// masked-off bits may be ones (Ara) or undisturbed (Spike), so only the active
+// bits are checked.
+void TEST_CASE7(void) {
+  VSET_TAMA(16, e8, m1);
+  VLOAD_8(v2, 0xff, 0x00, 0xf0, 0x0f, 0xff, 0x00, 0xf0, 0x0f, 0xff, 0x00, 0xf0,
+          0x0f, 0xff, 0x00, 0xf0, 0x0f);
+  VLOAD_8(v3, 0xf2, 0x01, 0xf0, 0x0f, 0xf2, 0x01, 0xf0, 0x0f, 0xf2, 0x01, 0xf0,
+          0x0f, 0xf2, 0x01, 0xf0, 0x0f);
+  VLOAD_8(v0, 0xaa, 0xaa);
+  VCLEAR(v1);
+  asm volatile("vmseq.vv v1, v2, v3, v0.t");
+  asm volatile("vmand.mm v1, v1, v0");
+  VSET(2, e8, m1);
+  VCMP_U8(25, v1, 0x88, 0x88);
+};
+
 int main(void) {
   INIT_CHECK();
   enable_vec();
@@ -301,6 +318,7 @@ int main(void) {
   TEST_CASE4();
   TEST_CASE5();
   TEST_CASE6();
+  TEST_CASE7();
 
   EXIT_CHECK();
 }
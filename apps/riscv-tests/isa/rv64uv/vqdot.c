@@ -0,0 +1,174 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+// Solderpad Hardware License, Version 0.51, see LICENSE for details.
+// SPDX-License-Identifier: SHL-0.51
+
+#include "vector_macros.h"
+
+// The toolchain does not know Zvqdotq: the instructions are encoded with .insn,
+// with funct7 = {funct6, vm}. Each 32-bit element of vd gets the sum of the
+// four products of the bytes of vs2 and vs1 (or rs1).
+
+// mcause of the last trap, and number of traps
+volatile uint64_t trap_mcause = 0;
+volatile uint64_t trap_cnt = 0;
+
+// Record the trap and skip the trapping instruction. The trap vector already
+// uses t5 and t6, so the instructions that trap clobber them.
+asm(".global mtvec_handler\n"
+    "mtvec_handler:\n"
+    "  csrr t5, mcause\n"
+    "  la t6, trap_mcause\n"
+    "  sd t5, 0(t6)\n"
+    "  la t6, trap_cnt\n"
+    "  ld t5, 0(t6)\n"
+    "  addi t5, t5, 1\n"
+    "  sd t5, 0(t6)\n"
+    "  csrr t5, mepc\n"
+    "  addi t5, t5, 4\n"
+    "  csrw mepc, t5\n"
+    "  mret\n");
+
+// vqdotu.vv, vqdot.vv, and vqdotsu.vv on a zero vd
+void TEST_CASE1(void) {
+  VSET(8, e32, m1);
+  VLOAD_32(v2, 0xa3b48c4a, 0x6bcefab3, 0x6dd451b2, 0xc12776e4, 0xb96ba5cb,
+           0x1a004483, 0x10f48bb9, 0x5dcc39d7);
+  VLOAD_32(v3, 0xb2a724d8, 0x769dd09f, 0x5ffb86c8, 0x0b2eaa63, 0x9ba845e4,
+           0xaa3fc17d, 0x2b8b1a47, 0x97323aed);
+  VLOAD_32(v1, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+           0x00000000, 0x00000000, 0x00000000);
+  asm volatile(".insn r 0x57, 2, 0x51, x1, x3, x2");
+  VCMP_U32(1, v1, 0x000138e2, 0x0001e9f5, 0x0001adc5, 0x0000b5d5, 0x00019780,
+           0x0000847f, 0x0000c899, 0x000132a8);
+
+  VLOAD_32(v1, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+           0x00000000, 0x00000000, 0x00000000);
+  asm volatile(".insn r 0x57, 2, 0x59, x1, x3, x2");
+  VCMP_U32(2, v1, 0x00001ae2, 0x000062f5, 0x000013c5, 0xffffd1d5, 0xffffe480,
+           0xffffa97f, 0xffffe899, 0xffffdfa8);
+
+  VLOAD_32(v1, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+           0x00000000, 0x00000000, 0x00000000);
+  asm volatile(".insn r 0x57, 2, 0x55, x1, x3, x2");
+  VCMP_U32(3, v1, 0xffffbbe2, 0xffffddf5, 0xffffeac5, 0x000047d5, 0xffffd380,
+           0x0000077f, 0xffffdc99, 0x000013a8);
+}
+
+// vqdotu.vv, vqdot.vv, and vqdotsu.vv, accumulated into vd
+void TEST_CASE2(void) {
+  VSET(8, e32, m1);
+  VLOAD_32(v2, 0xa3b48c4a, 0x6bcefab3, 0x6dd451b2, 0xc12776e4, 0xb96ba5cb,
+           0x1a004483, 0x10f48bb9, 0x5dcc39d7);
+  VLOAD_32(v3, 0xb2a724d8, 0x769dd09f, 0x5ffb86c8, 0x0b2eaa63, 0x9ba845e4,
+           0xaa3fc17d, 0x2b8b1a47, 0x97323aed);
+  VLOAD_32(v1, 0x00005835, 0x000053fa, 0x00004457, 0x0000b5c9, 0x00005458,
+           0x00009f40, 0x0000ba02, 0x00004ecf);
+  asm volatile(".insn r 0x57, 2, 0x51, x1, x3, x2");
+  VCMP_U32(4, v1, 0x00019117, 0x00023def, 0x0001f21c, 0x00016b9e, 0x0001ebd8,
+           0x000123bf, 0x0001829b, 0x00018177);
+
+  VLOAD_32(v1, 0x00005835, 0x000053fa, 0x00004457, 0x0000b5c9, 0x00005458,
+           0x00009f40, 0x0000ba02, 0x00004ecf);
+  asm volatile(".insn r 0x57, 2, 0x59, x1, x3, x2");
+  VCMP_U32(5, v1, 0x00007317, 0x0000b6ef, 0x0000581c, 0x0000879e, 0x000038d8,
+           0x000048bf, 0x0000a29b, 0x00002e77);
+
+  VLOAD_32(v1, 0x00005835, 0x000053fa, 0x00004457, 0x0000b5c9, 0x00005458,
+           0x00009f40, 0x0000ba02, 0x00004ecf);
+  asm volatile(".insn r 0x57, 2, 0x55, x1, x3, x2");
+  VCMP_U32(6, v1, 0x00001417, 0x000031ef, 0x00002f1c, 0x0000fd9e, 0x000027d8,
+           0x0000a6bf, 0x0000969b, 0x00006277);
+}
+
+// vqdotu.vx, vqdot.vx, vqdotsu.vx, and vqdotus.vx, accumulated into vd
+void TEST_CASE3(void) {
+  VSET(8, e32, m1);
+  VLOAD_32(v2, 0xa3b48c4a, 0x6bcefab3, 0x6dd451b2, 0xc12776e4, 0xb96ba5cb,
+           0x1a004483, 0x10f48bb9, 0x5dcc39d7);
+  uint64_t scalar = 0x7919d906;
+  VLOAD_32(v1, 0x00005835, 0x000053fa, 0x00004457, 0x0000b5c9, 0x00005458,
+           0x00009f40, 0x0000ba02, 0x00004ecf);
+  asm volatile(".insn r 0x57, 6, 0x51, x1, %0, x2" ::"r"(scalar));
+  VCMP_U32(7, v1, 0x00012f3c, 0x000172c7, 0x0000d565, 0x00017e2f, 0x000146db,
+           0x0000e840, 0x0001538f, 0x0000c40b);
+
+  VLOAD_32(v1, 0x00005835, 0x000053fa, 0x00004457, 0x0000b5c9, 0x00005458,
+           0x00009f40, 0x0000ba02, 0x00004ecf);
+  asm volatile(".insn r 0x57, 6, 0x59, x1, %0, x2" ::"r"(scalar));
+  VCMP_U32(8, v1, 0x0000383c, 0x000080c7, 0x00006565, 0x0000892f, 0x000049db,
+           0x00009e40, 0x0000d08f, 0x00006c0b);
+
+  VLOAD_32(v1, 0x00005835, 0x000053fa, 0x00004457, 0x0000b5c9, 0x00005458,
+           0x00009f40, 0x0000ba02, 0x00004ecf);
+  asm volatile(".insn r 0x57, 6, 0x55, x1, %0, x2" ::"r"(scalar));
+  VCMP_U32(9, v1, 0xffffc43c, 0x00007ac7, 0x0000b665, 0x0000ff2f, 0xffffeedb,
+           0x0000e240, 0x00005b8f, 0x0000a50b);
+
+  VLOAD_32(v1, 0x00005835, 0x000053fa, 0x00004457, 0x0000b5c9, 0x00005458,
+           0x00009f40, 0x0000ba02, 0x00004ecf);
+  asm volatile(".insn r 0x57, 6, 0x5d, x1, %0, x2" ::"r"(scalar));
+  VCMP_U32(10, v1, 0x0000a33c, 0x000078c7, 0x00008465, 0x0001082f, 0x0000a1db,
+           0x0000a440, 0x0000c88f, 0x00008b0b);
+}
+
+// Masked: the masked-off elements of vd are undisturbed
+void TEST_CASE4(void) {
+  VSET(8, e32, m1);
+  VLOAD_8(v0, 0xaa);
+  VLOAD_32(v2, 0xa3b48c4a, 0x6bcefab3, 0x6dd451b2, 0xc12776e4, 0xb96ba5cb,
+           0x1a004483, 0x10f48bb9, 0x5dcc39d7);
+  VLOAD_32(v3, 0xb2a724d8, 0x769dd09f, 0x5ffb86c8, 0x0b2eaa63, 0x9ba845e4,
+           0xaa3fc17d, 0x2b8b1a47, 0x97323aed);
+  uint64_t scalar = 0x7919d906;
+  VLOAD_32(v1, 0x00005835, 0x000053fa, 0x00004457, 0x0000b5c9, 0x00005458,
+           0x00009f40, 0x0000ba02, 0x00004ecf);
+  asm volatile(".insn r 0x57, 2, 0x50, x1, x3, x2");
+  VCMP_U32(11, v1, 0x00005835, 0x00023def, 0x00004457, 0x00016b9e, 0x00005458,
+           0x000123bf, 0x0000ba02, 0x00018177);
+
+  VLOAD_32(v1, 0x00005835, 0x000053fa, 0x00004457, 0x0000b5c9, 0x00005458,
+           0x00009f40, 0x0000ba02, 0x00004ecf);
+  asm volatile(".insn r 0x57, 2, 0x58, x1, x3, x2");
+  VCMP_U32(12, v1, 0x00005835, 0x0000b6ef, 0x00004457, 0x0000879e, 0x00005458,
+           0x000048bf, 0x0000ba02, 0x00002e77);
+
+  VLOAD_32(v1, 0x00005835, 0x000053fa, 0x00004457, 0x0000b5c9, 0x00005458,
+           0x00009f40, 0x0000ba02, 0x00004ecf);
+  asm volatile(".insn r 0x57, 2, 0x54, x1, x3, x2");
+  VCMP_U32(13, v1, 0x00005835, 0x000031ef, 0x00004457, 0x0000fd9e, 0x00005458,
+           0x0000a6bf, 0x0000ba02, 0x00006277);
+
+  VLOAD_32(v1, 0x00005835, 0x000053fa, 0x00004457, 0x0000b5c9, 0x00005458,
+           0x00009f40, 0x0000ba02, 0x00004ecf);
+  asm volatile(".insn r 0x57, 6, 0x5c, x1, %0, x2" ::"r"(scalar));
+  VCMP_U32(14, v1, 0x00005835, 0x000078c7, 0x00004457, 0x0001082f, 0x00005458,
+           0x0000a440, 0x0000ba02, 0x00008b0b);
+}
+
+// The dot products are illegal with SEW != 32
+void TEST_CASE5(void) {
+  trap_cnt = 0;
+  VSET(16, e8, m1);
+  asm volatile(".insn r 0x57, 2, 0x59, x1, x3, x2" ::: "t5", "t6");
+  XCMP(15, trap_cnt, 1);
+  XCMP(16, trap_mcause, 2);
+
+  VSET(4, e64, m1);
+  uint64_t scalar = 1;
+  asm volatile(".insn r 0x57, 6, 0x51, x1, %0, x2" ::"r"(scalar) : "t5", "t6");
+  XCMP(17, trap_cnt, 2);
+  XCMP(18, trap_mcause, 2);
+}
+
+int main(void) {
+  INIT_CHECK();
+  enable_vec();
+
+  TEST_CASE1();
+  TEST_CASE2();
+  TEST_CASE3();
+  TEST_CASE4();
+  TEST_CASE5();
+
+  EXIT_CHECK();
+}
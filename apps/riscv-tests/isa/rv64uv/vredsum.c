@@ -164,6 +164,19 @@ void TEST_CASE5(void) {
   VCMP_U32(20, v3, 3, 2, 3, 4, 5, 6, 7, 8, 1, 2, 3, 4, 5, 6, 7, 8);
 }
 
+// Tail- and mask-agnostic policy: only the first element of vd is defined
+void TEST_CASE6(void) {
+  VSET_TAMA(16, e32, m1);
+  VLOAD_32(v1, 1, 2, 3, 4, 5, 6, 7, 8, 1, 2, 3, 4, 5, 6, 7, 8);
+  VLOAD_32(v2, 1);
+  asm volatile("vredsum.vs v3, v1, v2");
+  VCMP_U32(21, v3, 73);
+
+  VLOAD_8(v0, 0xAA, 0xAA);
+  asm volatile("vredsum.vs v3, v1, v2, v0.t");
+  VCMP_U32(22, v3, 41);
+}
+
 int main(void) {
   INIT_CHECK();
   enable_vec();
@@ -173,6 +186,7 @@ int main(void) {
   TEST_CASE3();
   TEST_CASE4();
   TEST_CASE5();
+  TEST_CASE6();
 
   EXIT_CHECK();
 }
@@ -0,0 +1,44 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+// Solderpad Hardware License, Version 0.51, see LICENSE for details.
+// SPDX-License-Identifier: SHL-0.51
+
+#include "vector_macros.h"
+
+// vrev8.v
+void TEST_CASE1(void) {
+  VSET(8, e8, m1);
+  VLOAD_8(v2, 0xee, 0x4f, 0xa0, 0x4e, 0x87, 0xc2, 0x34, 0x4a);
+  asm volatile(".insn r 0x57, 2, 0x25, x1, x9, x2");
+  VCMP_U8(1, v1, 0xee, 0x4f, 0xa0, 0x4e, 0x87, 0xc2, 0x34, 0x4a);
+
+  VSET(8, e16, m1);
+  VLOAD_16(v2, 0x7218, 0x8005, 0xac12, 0x2d8a, 0x4540, 0x58d5, 0xcdbd, 0x04a6);
+  asm volatile(".insn r 0x57, 2, 0x25, x1, x9, x2");
+  VCMP_U16(2, v1, 0x1872, 0x0580, 0x12ac, 0x8a2d, 0x4045, 0xd558, 0xbdcd,
+           0xa604);
+
+  VSET(8, e32, m1);
+  VLOAD_32(v2, 0xfe977c56, 0x401d68fb, 0x09758340, 0x03edb920, 0x04b8157d,
+           0xbbab27f6, 0x81728a07, 0x8d118e37);
+  asm volatile(".insn r 0x57, 2, 0x25, x1, x9, x2");
+  VCMP_U32(3, v1, 0x567c97fe, 0xfb681d40, 0x40837509, 0x20b9ed03, 0x7d15b804,
+           0xf627abbb, 0x078a7281, 0x378e118d);
+
+  VSET(8, e64, m1);
+  VLOAD_64(v2, 0x30803889fa619774, 0x7989e9d083a4e629, 0xef44c0d53ee4da5a,
+           0x1b35411b72723b9c, 0xd1a4c01ea887ae22, 0x6ea330a1a66d58b5,
+           0x7eb86c57a81100a1, 0xd5a9422a8bc08311);
+  asm volatile(".insn r 0x57, 2, 0x25, x1, x9, x2");
+  VCMP_U64(4, v1, 0x749761fa89388030, 0x29e6a483d0e98979, 0x5adae43ed5c044ef,
+           0x9c3b72721b41351b, 0x22ae87a81ec0a4d1, 0xb5586da6a130a36e,
+           0xa10011a8576cb87e, 0x1183c08b2a42a9d5);
+}
+
+int main(void) {
+  INIT_CHECK();
+  enable_vec();
+
+  TEST_CASE1();
+
+  EXIT_CHECK();
+}
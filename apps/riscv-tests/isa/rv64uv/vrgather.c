@@ -12,17 +12,17 @@ void TEST_CASE1() {
   VLOAD_8(v4, 10, 20, 30, 40, 50);
   VLOAD_8(v6, 1, 0, 4, 3, 2);
   __asm__ volatile("vrgather.vv v2, v4, v6");
-  VEC_CMP_8(1, v2, 20, 10, 50, 40, 30);
+  VCMP_U8(1, v2, 20, 10, 50, 40, 30);
 }
 
 void TEST_CASE2() {
   VSET(5, e8, m1);
   VLOAD_8(v4, 10, 20, 30, 40, 50);
   VLOAD_8(v6, 1, 0, 4, 3, 2);
-  VLOAD_U8(v0, 26, 0, 0, 0, 0);
-  CLEAR(v2);
+  VLOAD_8(v0, 26, 0, 0, 0, 0);
+  VCLEAR(v2);
   __asm__ volatile("vrgather.vv v2, v4, v6, v0.t");
-  VEC_CMP_8(2, v2, 0, 10, 0, 40, 30);
+  VCMP_U8(2, v2, 0, 10, 0, 40, 30);
 }
 
 void TEST_CASE3() {
@@ -30,33 +30,64 @@ void TEST_CASE3() {
   VLOAD_8(v4, 10, 20, 30, 40, 50);
   uint64_t scalar = 3;
   __asm__ volatile("vrgather.vx v2, v4, %[A]" ::[A] "r"(scalar));
-  VEC_CMP_8(3, v2, 40, 40, 40, 40, 40);
+  VCMP_U8(3, v2, 40, 40, 40, 40, 40);
 }
 
 void TEST_CASE4() {
   VSET(5, e8, m1);
   VLOAD_8(v4, 10, 20, 30, 40, 50);
   uint64_t scalar = 3;
-  VLOAD_U8(v0, 7, 0, 0, 0, 0);
-  CLEAR(v2);
+  VLOAD_8(v0, 7, 0, 0, 0, 0);
+  VCLEAR(v2);
   __asm__ volatile("vrgather.vx v2, v4, %[A], v0.t" ::[A] "r"(scalar));
-  VEC_CMP_8(4, v2, 40, 40, 40, 0, 0);
+  VCMP_U8(4, v2, 40, 40, 40, 0, 0);
 }
 
 void TEST_CASE5() {
   VSET(5, e8, m1);
   VLOAD_8(v4, 10, 20, 30, 40, 50);
   __asm__ volatile("vrgather.vi v2, v4, 3");
-  VEC_CMP_8(5, v2, 40, 40, 40, 40, 40);
+  VCMP_U8(5, v2, 40, 40, 40, 40, 40);
 }
 
 void TEST_CASE6() {
   VSET(5, e8, m1);
   VLOAD_8(v4, 10, 20, 30, 40, 50);
-  VLOAD_U8(v0, 7, 0, 0, 0, 0);
-  CLEAR(v2);
+  VLOAD_8(v0, 7, 0, 0, 0, 0);
+  VCLEAR(v2);
   __asm__ volatile("vrgather.vi v2, v4, 3, v0.t");
-  VEC_CMP_8(6, v2, 40, 40, 40, 0, 0);
+  VCMP_U8(6, v2, 40, 40, 40, 0, 0);
+}
+
+// Out-of-range indices read zero
+void TEST_CASE7() {
+  VSET(4, e64, m1);
+  VLOAD_64(v4, 0x1111, 0x2222, 0x3333, 0x4444);
+  VLOAD_64(v6, 3, 100000, 0, 1);
+  __asm__ volatile("vrgather.vv v2, v4, v6");
+  VCMP_U64(7, v2, 0x4444, 0, 0x1111, 0x2222);
+  uint64_t scalar = 100000;
+  __asm__ volatile("vrgather.vx v2, v4, %[A]" ::[A] "r"(scalar));
+  VCMP_U64(8, v2, 0, 0, 0, 0);
+}
+
+// Register groups
+void TEST_CASE8() {
+  VSET(6, e16, m2);
+  VLOAD_16(v4, 0x10, 0x20, 0x30, 0x40, 0x50, 0x60);
+  VLOAD_16(v8, 5, 5, 0, 2, 1, 4);
+  __asm__ volatile("vrgather.vv v2, v4, v8");
+  VCMP_U16(9, v2, 0x60, 0x60, 0x10, 0x30, 0x20, 0x50);
+}
+
+// 16-bit indices
+void TEST_CASE9() {
+  VSET(4, e16, m1);
+  VLOAD_16(v6, 3, 2, 1, 0);
+  VSET(4, e32, m1);
+  VLOAD_32(v4, 0xdeadbeef, 0xcafebabe, 0x01234567, 0x89abcdef);
+  __asm__ volatile("vrgatherei16.vv v2, v4, v6");
+  VCMP_U32(10, v2, 0x89abcdef, 0x01234567, 0xcafebabe, 0xdeadbeef);
 }
 
 int main(void) {
@@ -68,5 +99,8 @@ int main(void) {
   TEST_CASE4();
   TEST_CASE5();
   TEST_CASE6();
+  TEST_CASE7();
+  TEST_CASE8();
+  TEST_CASE9();
   EXIT_CHECK();
 }
@@ -0,0 +1,138 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+// Solderpad Hardware License, Version 0.51, see LICENSE for details.
+// SPDX-License-Identifier: SHL-0.51
+
+#include "vector_macros.h"
+
+// The toolchain does not know Zvbb: the instructions are encoded with .insn,
+// with funct7 = {funct6, vm}
+
+// vrol.vv
+void TEST_CASE1(void) {
+  VSET(8, e8, m1);
+  VLOAD_8(v2, 0x03, 0x7c, 0xd4, 0x96, 0x2e, 0x43, 0x48, 0x01);
+  VLOAD_8(v3, 0x25, 0x6b, 0x88, 0x5e, 0x9c, 0x90, 0x51, 0xf3);
+  asm volatile(".insn r 0x57, 0, 0x2b, x1, x3, x2");
+  VCMP_U8(1, v1, 0x60, 0xe3, 0xd4, 0xa5, 0xe2, 0x43, 0x90, 0x08);
+
+  VSET(8, e16, m1);
+  VLOAD_16(v2, 0x2020, 0xb0c4, 0xdbf4, 0x83f7, 0xf341, 0x9e1a, 0xa7ab, 0xad1b);
+  VLOAD_16(v3, 0xbd62, 0x0dd2, 0x74e6, 0xe647, 0xdef8, 0xc7ac, 0xf3ae, 0xdfe0);
+  asm volatile(".insn r 0x57, 0, 0x2b, x1, x3, x2");
+  VCMP_U16(2, v1, 0x8080, 0xc312, 0xfd36, 0xfbc1, 0x41f3, 0xa9e1, 0xe9ea,
+           0xad1b);
+
+  VSET(8, e32, m1);
+  VLOAD_32(v2, 0xae3a2b7f, 0xcc4169a3, 0x8f2c6ec8, 0x6472f1a3, 0x65e7e423,
+           0x66237a04, 0x64e50cad, 0x1a81682c);
+  VLOAD_32(v3, 0x7b45145c, 0xa260cd0b, 0x66836886, 0x0fef7928, 0x30cbc97d,
+           0x113db17d, 0xfc132d0d, 0x3571810a);
+  asm volatile(".insn r 0x57, 0, 0x2b, x1, x3, x2");
+  VCMP_U32(3, v1, 0xfae3a2b7, 0x0b4d1e62, 0xcb1bb223, 0x72f1a364, 0x6cbcfc84,
+           0x8cc46f40, 0xa195ac9c, 0x05a0b06a);
+
+  VSET(8, e64, m1);
+  VLOAD_64(v2, 0x298cb3a570ccec31, 0x570dc1951c2442f9, 0x0d75985d99c94309,
+           0x000f49c81a358ca0, 0x26b94c7f9118bb16, 0x19f9919c895fd7b3,
+           0x5d158a2ff2ee4e45, 0x068739fa9d1de2a0);
+  VLOAD_64(v3, 0xdfd43f371200339d, 0x9d33a01c353c631c, 0x2607679d6050914a,
+           0x4093f6dea268aa87, 0x58ee8571f4998d7c, 0x5d39d0a89a2ef80f,
+           0x1f7296ab7961fd92, 0xd953ee261d87cec3);
+  asm volatile(".insn r 0x57, 0, 0x2b, x1, x3, x2");
+  VCMP_U64(4, v1, 0xae199d8625319674, 0x51c2442f9570dc19, 0xd6617667250c2435,
+           0x07a4e40d1ac65000, 0x626b94c7f9118bb1, 0xc8ce44afebd98cfc,
+           0x28bfcbb939157456, 0x3439cfd4e8ef1500);
+}
+
+// vrol.vv, masked
+void TEST_CASE2(void) {
+  VSET(8, e8, m1);
+  VLOAD_8(v0, 0x6D);
+  VLOAD_8(v2, 0x7c, 0xfe, 0xfa, 0x77, 0x7a, 0x7b, 0x4f, 0x15);
+  VLOAD_8(v3, 0x24, 0x1a, 0xbf, 0x57, 0xbd, 0x43, 0x7a, 0xd4);
+  VLOAD_8(v1, 0xef, 0xef, 0xef, 0xef, 0xef, 0xef, 0xef, 0xef);
+  asm volatile(".insn r 0x57, 0, 0x2a, x1, x3, x2");
+  VCMP_U8(5, v1, 0xc7, 0xef, 0x7d, 0xbb, 0xef, 0xdb, 0x3d, 0xef);
+
+  VSET(8, e16, m1);
+  VLOAD_8(v0, 0x6D);
+  VLOAD_16(v2, 0xb12a, 0x2954, 0x842e, 0x05e9, 0x3488, 0xf373, 0xf3b7, 0x873b);
+  VLOAD_16(v3, 0x5c9b, 0x2587, 0xb0a8, 0x8b0d, 0xea05, 0x06ec, 0xc215, 0x8732);
+  VLOAD_16(v1, 0x00ef, 0x00ef, 0x00ef, 0x00ef, 0x00ef, 0x00ef, 0x00ef, 0x00ef);
+  asm volatile(".insn r 0x57, 0, 0x2a, x1, x3, x2");
+  VCMP_U16(6, v1, 0x5589, 0x00ef, 0x2e84, 0x20bd, 0x00ef, 0x3f37, 0x76fe,
+           0x00ef);
+
+  VSET(8, e32, m1);
+  VLOAD_8(v0, 0x6D);
+  VLOAD_32(v2, 0x4c4f9b06, 0xfa7f0eab, 0xa49636a2, 0xdd02de92, 0x174c77a2,
+           0xb239f3c7, 0xd86f40f6, 0x42d87208);
+  VLOAD_32(v3, 0x84b5a818, 0x5de00997, 0xe883a1d4, 0x2ac34446, 0x5b0ee76f,
+           0xc59db916, 0x3908f227, 0x8857f9a4);
+  VLOAD_32(v1, 0x000000ef, 0x000000ef, 0x000000ef, 0x000000ef, 0x000000ef,
+           0x000000ef, 0x000000ef, 0x000000ef);
+  asm volatile(".insn r 0x57, 0, 0x2a, x1, x3, x2");
+  VCMP_U32(7, v1, 0x064c4f9b, 0x000000ef, 0x6a2a4963, 0x40b7a4b7, 0x000000ef,
+           0xf1ec8e7c, 0x37a07b6c, 0x000000ef);
+
+  VSET(8, e64, m1);
+  VLOAD_8(v0, 0x6D);
+  VLOAD_64(v2, 0xc77024208aa4248c, 0x5464ecc280b0c08b, 0x39194242a2eddbbd,
+           0xcfbf33609cfc8652, 0xfc241d0bc9d488b1, 0xda45e18ac2216b02,
+           0xce5b2a9231f51707, 0xd17e44973d4882a5);
+  VLOAD_64(v3, 0xbd68516766934036, 0x3a0b9965cda6c6fd, 0x8483f8b8332dd331,
+           0x5b06258e7e26f36a, 0x076b3e36bb2313f5, 0x0726e25cfd56a926,
+           0x4787f93bca44eb86, 0x4259405278e4b98d);
+  VLOAD_64(v1, 0x00000000000000ef, 0x00000000000000ef, 0x00000000000000ef,
+           0x00000000000000ef, 0x00000000000000ef, 0x00000000000000ef,
+           0x00000000000000ef, 0x00000000000000ef);
+  asm volatile(".insn r 0x57, 0, 0x2a, x1, x3, x2");
+  VCMP_U64(8, v1, 0x2331dc090822a909, 0x00000000000000ef, 0xb77a7232848545db,
+           0xf2194b3efccd8273, 0x00000000000000ef, 0x885ac0b6917862b0,
+           0x96caa48c7d45c1f3, 0x00000000000000ef);
+}
+
+// vrol.vx
+void TEST_CASE3(void) {
+  VSET(8, e8, m1);
+  VLOAD_8(v2, 0x31, 0xb1, 0x9a, 0xf4, 0x58, 0x72, 0xce, 0xef);
+  uint64_t scalar = 0xb9;
+  asm volatile(".insn r 0x57, 4, 0x2b, x1, %0, x2" ::"r"(scalar));
+  VCMP_U8(9, v1, 0x62, 0x63, 0x35, 0xe9, 0xb0, 0xe4, 0x9d, 0xdf);
+
+  VSET(8, e16, m1);
+  VLOAD_16(v2, 0xfcf0, 0x597a, 0xf47a, 0xf979, 0x5d58, 0x149e, 0x3870, 0x1a26);
+  scalar = 0x3a12;
+  asm volatile(".insn r 0x57, 4, 0x2b, x1, %0, x2" ::"r"(scalar));
+  VCMP_U16(10, v1, 0xf3c3, 0x65e9, 0xd1eb, 0xe5e7, 0x7561, 0x5278, 0xe1c0,
+           0x6898);
+
+  VSET(8, e32, m1);
+  VLOAD_32(v2, 0x78572976, 0x325b55dd, 0x5675f6ad, 0x3451d013, 0x7b8f2ab5,
+           0x9fc2d0a1, 0xfc394724, 0xe67a9b75);
+  scalar = 0x9c3a23cd;
+  asm volatile(".insn r 0x57, 4, 0x2b, x1, %0, x2" ::"r"(scalar));
+  VCMP_U32(11, v1, 0xe52ecf0a, 0x6abba64b, 0xbed5aace, 0x3a02668a, 0xe556af71,
+           0x5a1433f8, 0x28e49f87, 0x536ebccf);
+
+  VSET(8, e64, m1);
+  VLOAD_64(v2, 0x007d1034d726c86b, 0xe8c147437abec539, 0x5810d60ea72991b9,
+           0xa4a45effccb573d9, 0xd5ab8b4d15b40aeb, 0x1eb20109a91c2439,
+           0x63771407e8e72789, 0xb6246771c8450070);
+  scalar = 0x330698a1c0093492;
+  asm volatile(".insn r 0x57, 4, 0x2b, x1, %0, x2" ::"r"(scalar));
+  VCMP_U64(12, v1, 0x40d35c9b21ac01f4, 0x1d0deafb14e7a305, 0x583a9ca646e56043,
+           0x7bff32d5cf669291, 0x2d3456d02baf56ae, 0x0426a47090e47ac8,
+           0x501fa39c9e258ddc, 0x9dc7211401c2d891);
+}
+
+int main(void) {
+  INIT_CHECK();
+  enable_vec();
+
+  TEST_CASE1();
+  TEST_CASE2();
+  TEST_CASE3();
+
+  EXIT_CHECK();
+}
@@ -0,0 +1,169 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+// Solderpad Hardware License, Version 0.51, see LICENSE for details.
+// SPDX-License-Identifier: SHL-0.51
+
+#include "vector_macros.h"
+
+// The toolchain does not know Zvbb: the instructions are encoded with .insn,
+// with funct7 = {funct6, vm}
+
+// vror.vv
+void TEST_CASE1(void) {
+  VSET(8, e8, m1);
+  VLOAD_8(v2, 0x7a, 0xe3, 0x2d, 0x6f, 0xca, 0xa2, 0x55, 0x16);
+  VLOAD_8(v3, 0xcd, 0xf2, 0xf8, 0xb8, 0x65, 0x76, 0x66, 0xbe);
+  asm volatile(".insn r 0x57, 0, 0x29, x1, x3, x2");
+  VCMP_U8(1, v1, 0xd3, 0xf8, 0x2d, 0x6f, 0x56, 0x8a, 0x55, 0x58);
+
+  VSET(8, e16, m1);
+  VLOAD_16(v2, 0xf261, 0x15bd, 0xb98c, 0x28aa, 0x2b85, 0xfe3c, 0x2085, 0x070d);
+  VLOAD_16(v3, 0x26b1, 0x973f, 0xe7a4, 0x7721, 0xce76, 0xa7e6, 0x256b, 0x9c90);
+  asm volatile(".insn r 0x57, 0, 0x29, x1, x3, x2");
+  VCMP_U16(2, v1, 0xf930, 0x2b7a, 0xcb98, 0x1455, 0x14ae, 0xf3f8, 0x10a4,
+           0x070d);
+
+  VSET(8, e32, m1);
+  VLOAD_32(v2, 0xd39630d6, 0x988af3fb, 0xfaf55496, 0x796f74ad, 0xa842bc19,
+           0xeffddeea, 0x59b44e92, 0x27e9e06f);
+  VLOAD_32(v3, 0x8c74fc1e, 0x8c5c715f, 0x2188287e, 0x057a40b2, 0x03a56cc1,
+           0xcca2a92b, 0xf88c422b, 0xb9f3635c);
+  asm volatile(".insn r 0x57, 0, 0x29, x1, x3, x2");
+  VCMP_U32(3, v1, 0x4e58c35b, 0x3115e7f7, 0xebd5525b, 0xdd2b5e5b, 0xd4215e0c,
+           0xdd5dffbb, 0xd24b3689, 0x7e9e06f2);
+
+  VSET(8, e64, m1);
+  VLOAD_64(v2, 0x1a4f44f9a6511445, 0xbfdefc1586ce03f9, 0x23a5ef88ef02090b,
+           0xfc8e80b36f0e2289, 0x31dec4f4df2a8b79, 0xdfb85c0dd37ee915,
+           0x072a98d23606defc, 0x3678bc8d40783f0a);
+  VLOAD_64(v3, 0x804c25d64affdcd1, 0xc38084a03d93fd4c, 0x537409029620bf0d,
+           0x8b5ab3ee4265bb31, 0xd58dcdb46b446806, 0x0f977044218e0b7b,
+           0xbd6b881ae8f6e0bd, 0xe5cfedfa5a9196f0);
+  asm volatile(".insn r 0x57, 0, 0x29, x1, x3, x2");
+  VCMP_U64(4, v1, 0x8a228d27a27cd328, 0x3f9bfdefc1586ce0, 0x48591d2f7c477810,
+           0x4059b7871144fe47, 0xe4c77b13d37caa2d, 0xf70b81ba6fdd22bb,
+           0x3954c691b036f7e0, 0xbc8d40783f0a3678);
+}
+
+// vror.vv, masked
+void TEST_CASE2(void) {
+  VSET(8, e8, m1);
+  VLOAD_8(v0, 0x6D);
+  VLOAD_8(v2, 0x75, 0xa9, 0x95, 0xd0, 0xe7, 0x84, 0x6b, 0xd3);
+  VLOAD_8(v3, 0xea, 0xe0, 0x80, 0x21, 0x88, 0x26, 0x86, 0x82);
+  VLOAD_8(v1, 0xef, 0xef, 0xef, 0xef, 0xef, 0xef, 0xef, 0xef);
+  asm volatile(".insn r 0x57, 0, 0x28, x1, x3, x2");
+  VCMP_U8(5, v1, 0x5d, 0xef, 0x95, 0x68, 0xef, 0x12, 0xad, 0xef);
+
+  VSET(8, e16, m1);
+  VLOAD_8(v0, 0x6D);
+  VLOAD_16(v2, 0x04c9, 0xdf70, 0x70ac, 0xc6c9, 0x2ee0, 0x9bca, 0x0101, 0xc6aa);
+  VLOAD_16(v3, 0xcc96, 0x2659, 0x2c1e, 0x243d, 0x7936, 0x9e7d, 0xb9a6, 0x1ece);
+  VLOAD_16(v1, 0x00ef, 0x00ef, 0x00ef, 0x00ef, 0x00ef, 0x00ef, 0x00ef, 0x00ef);
+  asm volatile(".insn r 0x57, 0, 0x28, x1, x3, x2");
+  VCMP_U16(6, v1, 0x2413, 0x00ef, 0xc2b1, 0x364e, 0x00ef, 0xde54, 0x0404,
+           0x00ef);
+
+  VSET(8, e32, m1);
+  VLOAD_8(v0, 0x6D);
+  VLOAD_32(v2, 0x8e752fdf, 0x0fcf31ca, 0x537390e5, 0xaead44b0, 0x84b28054,
+           0x87ddaeb7, 0x8e317041, 0x7b8444d1);
+  VLOAD_32(v3, 0xc8c614b2, 0xc6c80e2b, 0x1b29fc99, 0xe21b37ca, 0x8f6f915f,
+           0x0e8bec94, 0x3f9d52f9, 0x30f97058);
+  VLOAD_32(v1, 0x000000ef, 0x000000ef, 0x000000ef, 0x000000ef, 0x000000ef,
+           0x000000ef, 0x000000ef, 0x000000ef);
+  asm volatile(".insn r 0x57, 0, 0x28, x1, x3, x2");
+  VCMP_U32(7, v1, 0x4bf7e39d, 0x000000ef, 0xb9c872a9, 0x2c2bab51, 0x000000ef,
+           0xdaeb787d, 0x18b820c7, 0x000000ef);
+
+  VSET(8, e64, m1);
+  VLOAD_8(v0, 0x6D);
+  VLOAD_64(v2, 0x0acd8be146e40990, 0x1905d591c5b2e75a, 0x73c1cd2c81f98b52,
+           0x072235c28fcd7f40, 0xe4ddf9b9c28ee907, 0x1038f0b5e998d0ee,
+           0x535b6a437178ba0a, 0xf92e23399ccea098);
+  VLOAD_64(v3, 0x9b2bd6c0816bee06, 0x330c16a3831d03bf, 0x46f5a1b4b156d1ad,
+           0x8216858f73ccef03, 0xceaf4915888564e8, 0x81fc069e7a609683,
+           0x3f665edef10637ce, 0x85f1115bb2fff17b);
+  VLOAD_64(v1, 0x00000000000000ef, 0x00000000000000ef, 0x00000000000000ef,
+           0x00000000000000ef, 0x00000000000000ef, 0x00000000000000ef,
+           0x00000000000000ef, 0x00000000000000ef);
+  asm volatile(".insn r 0x57, 0, 0x28, x1, x3, x2");
+  VCMP_U64(8, v1, 0x402b362f851b9026, 0x00000000000000ef, 0x69640fcc5a939e0e,
+           0x00e446b851f9afe8, 0x00000000000000ef, 0xc2071e16bd331a1d,
+           0xe8294d6da90dc5e2, 0x00000000000000ef);
+}
+
+// vror.vx
+void TEST_CASE3(void) {
+  VSET(8, e8, m1);
+  VLOAD_8(v2, 0xe0, 0xe0, 0xf1, 0xed, 0x42, 0xec, 0x8f, 0xe4);
+  uint64_t scalar = 0xf1;
+  asm volatile(".insn r 0x57, 4, 0x29, x1, %0, x2" ::"r"(scalar));
+  VCMP_U8(9, v1, 0x70, 0x70, 0xf8, 0xf6, 0x21, 0x76, 0xc7, 0x72);
+
+  VSET(8, e16, m1);
+  VLOAD_16(v2, 0x33dc, 0xd70a, 0x7291, 0x231b, 0x6aa8, 0x1f22, 0x6471, 0x712e);
+  scalar = 0x50e4;
+  asm volatile(".insn r 0x57, 4, 0x29, x1, %0, x2" ::"r"(scalar));
+  VCMP_U16(10, v1, 0xc33d, 0xad70, 0x1729, 0xb231, 0x86aa, 0x21f2, 0x1647,
+           0xe712);
+
+  VSET(8, e32, m1);
+  VLOAD_32(v2, 0x12926185, 0xabd0d7fb, 0x3d9a8079, 0x6da79a87, 0x12b80aed,
+           0x3672d6ae, 0xab6286cd, 0x4d82feac);
+  scalar = 0xc8b007ee;
+  asm volatile(".insn r 0x57, 4, 0x29, x1, %0, x2" ::"r"(scalar));
+  VCMP_U32(11, v1, 0x86144a49, 0x5feeaf43, 0x01e4f66a, 0x6a1db69e, 0x2bb44ae0,
+           0x5ab8d9cb, 0x1b36ad8a, 0xfab1360b);
+
+  VSET(8, e64, m1);
+  VLOAD_64(v2, 0xe5a3863e1f525265, 0x2789d059c6e50df2, 0xb753a1eef0836085,
+           0xa906922fa4b9a9c4, 0x249a45845dbe3023, 0xe201552240cbacd0,
+           0xf7b103df23231e1e, 0x3836e86577bd891f);
+  scalar = 0xf3d74f82bf268ea0;
+  asm volatile(".insn r 0x57, 4, 0x29, x1, %0, x2" ::"r"(scalar));
+  VCMP_U64(12, v1, 0x1f525265e5a3863e, 0xc6e50df22789d059, 0xf0836085b753a1ee,
+           0xa4b9a9c4a906922f, 0x5dbe3023249a4584, 0x40cbacd0e2015522,
+           0x23231e1ef7b103df, 0x77bd891f3836e865);
+}
+
+// vror.vi, whose 6-bit immediate has its MSB in funct6
+void TEST_CASE4(void) {
+  VSET(8, e8, m1);
+  VLOAD_8(v2, 0x18, 0x65, 0xe2, 0x7c, 0x29, 0xfd, 0xaa, 0xd5);
+  asm volatile(".insn r 0x57, 3, 0x29, x1, x3, x2");
+  VCMP_U8(13, v1, 0x03, 0xac, 0x5c, 0x8f, 0x25, 0xbf, 0x55, 0xba);
+
+  VSET(8, e16, m1);
+  VLOAD_16(v2, 0x3945, 0x2955, 0xb4d1, 0x6e78, 0xfe7b, 0x83fe, 0x6760, 0x56d0);
+  asm volatile(".insn r 0x57, 3, 0x29, x1, x11, x2");
+  VCMP_U16(14, v1, 0x28a7, 0x2aa5, 0x9a36, 0xcf0d, 0xcf7f, 0x7fd0, 0xec0c,
+           0xda0a);
+
+  VSET(8, e32, m1);
+  VLOAD_32(v2, 0x6bd8c676, 0x321c5296, 0x5b4b1b75, 0x518ae452, 0x179a071e,
+           0xb8dee081, 0x5daf106d, 0x04fcd555);
+  asm volatile(".insn r 0x57, 3, 0x29, x1, x29, x2");
+  VCMP_U32(15, v1, 0x5ec633b3, 0x90e294b1, 0xda58dbaa, 0x8c572292, 0xbcd038f0,
+           0xc6f7040d, 0xed78836a, 0x27e6aaa8);
+
+  VSET(8, e64, m1);
+  VLOAD_64(v2, 0x8dd63cb95685d624, 0x70c1dca1756b7289, 0x04a10547b401ba85,
+           0x54dd0ba5626467ba, 0x9fb9af5084768b8c, 0x83239ef54ba2e161,
+           0x10755c97f5f554ed, 0xfc2e6a591ce3bc0c);
+  asm volatile(".insn r 0x57, 3, 0x2b, x1, x13, x2");
+  VCMP_U64(16, v1, 0xe5cab42eb1246eb1, 0xe50bab5b944b860e, 0x2a3da00dd4282508,
+           0x5d2b13233dd2a6e8, 0x7a8423b45c64fdcd, 0xf7aa5d170b0c191c,
+           0xe4bfafaaa76883aa, 0x52c8e71de067e173);
+}
+
+int main(void) {
+  INIT_CHECK();
+  enable_vec();
+
+  TEST_CASE1();
+  TEST_CASE2();
+  TEST_CASE3();
+  TEST_CASE4();
+
+  EXIT_CHECK();
+}
@@ -0,0 +1,53 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+// Solderpad Hardware License, Version 0.51, see LICENSE for details.
+// SPDX-License-Identifier: SHL-0.51
+
+#include "vector_macros.h"
+
+// Zvknha: vsha2ms.vv, vsha2ch.vv, and vsha2cl.vv, on two element groups
+void TEST_CASE1(void) {
+  // vsha2ms.vv
+  VSET(8, e32, m1);
+  VLOAD_32(v1, 0x0b74eb86, 0x57168f0e, 0x50d5f291, 0x12c16fd9,
+           0x03ccb891, 0xd04c80a7, 0x44a41b7d, 0xaf97063a);
+  VLOAD_32(v2, 0x9d4d8733, 0xa8079b61, 0xa70ae7bd, 0x0679d59e,
+           0x516862c6, 0x43fd3ad5, 0x54413d13, 0x3aa34248);
+  VLOAD_32(v3, 0x9b932bb8, 0x01bcf1f5, 0xb12d46da, 0x037428ec,
+           0x0a31b9bc, 0x96c3151d, 0xb4210f52, 0x11aeb31c);
+  asm volatile(".insn r 0x77, 2, 0x5b, x1, x3, x2");
+  VCMP_U32(1, v1, 0x74a63603, 0xe3ac152b, 0x20b8b10d, 0x4bbccef2,
+           0x63b8f543, 0xa93a3978, 0x847bf689, 0xb3c017f1);
+
+  // vsha2ch.vv
+  VSET(8, e32, m1);
+  VLOAD_32(v1, 0x788e445f, 0x1dee1be7, 0x6ec33e2b, 0x8bf8e123,
+           0x86a6a659, 0x8363252c, 0x2e4fb9c3, 0x5d1b1391);
+  VLOAD_32(v2, 0x8f3c1cf6, 0xa21ced27, 0x233c2b2d, 0x4baf6de7,
+           0xb13a67ae, 0x282cef0d, 0xf6c28f32, 0xfe40c1c7);
+  VLOAD_32(v3, 0xa0980f08, 0xe47a7201, 0x61d6f34f, 0x31c4c094,
+           0xd1206b35, 0xc3ada60d, 0xe904f324, 0x972d95c8);
+  asm volatile(".insn r 0x77, 2, 0x5d, x1, x3, x2");
+  VCMP_U32(2, v1, 0x1d3138b7, 0xafd32350, 0xba907edf, 0xa93967fa,
+           0x04d8eb21, 0xb51d2647, 0xc774927f, 0xfead7653);
+
+  // vsha2cl.vv
+  VSET(8, e32, m1);
+  VLOAD_32(v1, 0xd150aaae, 0xdfeb279f, 0xa22fb3a4, 0x2c662740,
+           0x57f5aaba, 0xb781e974, 0x4d1d9feb, 0xe55e9695);
+  VLOAD_32(v2, 0xf5968808, 0xb96a749c, 0x5ffbf645, 0x2dd2f0e5,
+           0x4502b1fc, 0x2e74120c, 0xb0e7b0c0, 0xdf237a46);
+  VLOAD_32(v3, 0x4ffa883a, 0xc0fa2806, 0xf0fabaa6, 0x2d00cd62,
+           0x99fb5d5f, 0x976100d7, 0x28266d83, 0x14ecf16e);
+  asm volatile(".insn r 0x77, 2, 0x5f, x1, x3, x2");
+  VCMP_U32(3, v1, 0x0f46b457, 0x3ca48c81, 0x22a83d11, 0x4110b815,
+           0x1fc5ba5d, 0x5f89555d, 0xb0270a2c, 0x0b96ea7f);
+}
+
+int main(void) {
+  INIT_CHECK();
+  enable_vec();
+
+  TEST_CASE1();
+
+  EXIT_CHECK();
+}
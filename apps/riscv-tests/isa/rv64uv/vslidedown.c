@@ -166,6 +166,20 @@ void TEST_CASE5() {
   VCMP_U32(17, v1, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19);
 }
 
+// Tail- and mask-agnostic policy
+void TEST_CASE6() {
+  VSET_TAMA(32, e8, m1);
+  VLOAD_8(v2, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19,
+          20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32);
+  VSET_TAMA(16, e8, m1);
+  VLOAD_8(v0, 0xAA, 0xAA);
+  asm volatile("vslidedown.vi v1, v2, 3, v0.t");
+  // The masked-off elements are agnostic: zero them to check the active ones
+  asm volatile("vmv.v.i v4, 0");
+  asm volatile("vmerge.vvm v1, v4, v1, v0");
+  VCMP_U8(18, v1, 0, 5, 0, 7, 0, 9, 0, 11, 0, 13, 0, 15, 0, 17, 0, 19);
+}
+
 int main(void) {
   INIT_CHECK();
   enable_vec();
@@ -176,6 +190,7 @@ int main(void) {
   TEST_CASE4();
 
   TEST_CASE5();
+  TEST_CASE6();
 
   EXIT_CHECK();
 }
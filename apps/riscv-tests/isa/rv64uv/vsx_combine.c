@@ -0,0 +1,83 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+// Solderpad Hardware License, Version 0.51, see LICENSE for details.
+// SPDX-License-Identifier: SHL-0.51
+
+#include "vector_macros.h"
+
+// Corner cases of the write-combining buffer of the strided and indexed stores
+
+#define AXI_DWIDTH 128
+
+static volatile uint8_t OUT8[32] __attribute__((aligned(AXI_DWIDTH)));
+
+void reset_out8(void) {
+  for (int i = 0; i < 32; ++i)
+    OUT8[i] = 0;
+}
+
+// The elements go back and forth between two blocks
+void TEST_CASE1(void) {
+  reset_out8();
+  VSET(6, e8, m1);
+  VLOAD_8(v1, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66);
+  VLOAD_8(v2, 0, 16, 1, 17, 2, 18);
+  asm volatile("vsuxei8.v v1, (%0), v2" ::"r"(&OUT8[0]));
+  VVCMP_U8(1, OUT8, 0x11, 0x33, 0x55, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+           0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x22, 0x44, 0x66, 0x00, 0x00,
+           0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00);
+}
+
+// The ordered store keeps the last one of the elements with the same index
+void TEST_CASE2(void) {
+  reset_out8();
+  VSET(6, e8, m1);
+  VLOAD_8(v1, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66);
+  VLOAD_8(v2, 3, 5, 3, 5, 3, 7);
+  asm volatile("vsoxei8.v v1, (%0), v2" ::"r"(&OUT8[0]));
+  VVCMP_U8(2, OUT8, 0x00, 0x00, 0x00, 0x55, 0x00, 0x44, 0x00, 0x66, 0x00, 0x00,
+           0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+           0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00);
+}
+
+// The masked elements leave their bytes of the merged beat untouched
+void TEST_CASE3(void) {
+  reset_out8();
+  VSET(8, e8, m1);
+  VLOAD_8(v0, 0x5A);
+  VLOAD_8(v1, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88);
+  asm volatile("vsse8.v v1, (%0), %1, v0.t" ::"r"(&OUT8[0]), "r"(2));
+  VVCMP_U8(3, OUT8, 0x00, 0x00, 0x22, 0x00, 0x00, 0x00, 0x44, 0x00, 0x55, 0x00,
+           0x00, 0x00, 0x77, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+           0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00);
+}
+
+// A unit-stride store after a strided one, to the same bytes, and a scalar load
+// right after the strided store
+void TEST_CASE4(void) {
+  reset_out8();
+  VSET(4, e8, m1);
+  VLOAD_8(v1, 0x11, 0x22, 0x33, 0x44);
+  VLOAD_8(v2, 0xaa, 0xbb);
+  asm volatile("vsse8.v v1, (%0), %1" ::"r"(&OUT8[0]), "r"(1));
+  VSET(2, e8, m1);
+  asm volatile("vse8.v v2, (%0)" ::"r"(&OUT8[1]));
+  VVCMP_U8(4, OUT8, 0x11, 0xaa, 0xbb, 0x44, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+           0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+           0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00);
+
+  VSET(4, e8, m1);
+  asm volatile("vsse8.v v1, (%0), %1" ::"r"(&OUT8[16]), "r"(4));
+  XCMP(5, OUT8[28], 0x44);
+}
+
+int main(void) {
+  INIT_CHECK();
+  enable_vec();
+
+  TEST_CASE1();
+  TEST_CASE2();
+  TEST_CASE3();
+  TEST_CASE4();
+
+  EXIT_CHECK();
+}
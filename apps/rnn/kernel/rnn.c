@@ -0,0 +1,251 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "rnn.h"
+#include "vmath/vmath.h"
+
+// Inputs of a batch tile: the four accumulators of each one of them, and the
+// four strips of a row of the weights, fit in the VRF with LMUL=1, as well as
+// the temporaries of vmath for the updates
+#define RNN_TILE 4
+
+#define RNN_FOR_1(M) M(0)
+#define RNN_FOR_4(M) M(0) M(1) M(2) M(3)
+
+// The accumulators of the input q of the tile, initialized with the biases
+#define RNN_ACC_DEF(q)                                                         \
+  vfloat32m1_t a0_##q = b0, a1_##q = b1, a2_##q = b2, a3_##q = b3;
+
+// The k-th row of the weights, of the gates 0 to 3 (LSTM), or 0 to 2 (GRU),
+// times the k-th element of the input q, of n elements
+#define LSTM_MACC(q)                                                           \
+  a0_##q = vfmacc_vf_f32m1(a0_##q, s[q * n + k], w0, vl);                      \
+  a1_##q = vfmacc_vf_f32m1(a1_##q, s[q * n + k], w1, vl);                      \
+  a2_##q = vfmacc_vf_f32m1(a2_##q, s[q * n + k], w2, vl);                      \
+  a3_##q = vfmacc_vf_f32m1(a3_##q, s[q * n + k], w3, vl);
+
+#define GRU_MACC_X(q)                                                          \
+  a0_##q = vfmacc_vf_f32m1(a0_##q, x[q * in + k], w0, vl);                     \
+  a1_##q = vfmacc_vf_f32m1(a1_##q, x[q * in + k], w1, vl);                     \
+  a2_##q = vfmacc_vf_f32m1(a2_##q, x[q * in + k], w2, vl);
+
+#define GRU_MACC_H(q)                                                          \
+  a0_##q = vfmacc_vf_f32m1(a0_##q, h[q * hid + k], w0, vl);                    \
+  a1_##q = vfmacc_vf_f32m1(a1_##q, h[q * hid + k], w1, vl);                    \
+  a3_##q = vfmacc_vf_f32m1(a3_##q, h[q * hid + k], w2, vl);
+
+#define LSTM_UPDATE(q)                                                         \
+  {                                                                            \
+    const uint64_t o = q * hid + j;                                            \
+    vfloat32m1_t cn = vfmul_vv_f32m1(vmath_sigmoid_f32m1(a1_##q, vl),          \
+                                     vle32_v_f32m1(c + o, vl), vl);            \
+    cn = vfmacc_vv_f32m1(cn, vmath_sigmoid_f32m1(a0_##q, vl),                  \
+                         vmath_tanh_f32m1(a2_##q, vl), vl);                    \
+    vse32_v_f32m1(c_out + o, cn, vl);                                          \
+    vse32_v_f32m1(h_out + o,                                                   \
+                  vfmul_vv_f32m1(vmath_sigmoid_f32m1(a3_##q, vl),              \
+                                 vmath_tanh_f32m1(cn, vl), vl),                \
+                  vl);                                                         \
+  }
+
+// h' = n + z (h - n)
+#define GRU_UPDATE(q)                                                          \
+  {                                                                            \
+    const uint64_t o = q * hid + j;                                            \
+    vfloat32m1_t nn = vmath_tanh_f32m1(                                        \
+        vfmacc_vv_f32m1(a2_##q, vmath_sigmoid_f32m1(a0_##q, vl), a3_##q, vl),  \
+        vl);                                                                   \
+    vfloat32m1_t d = vfsub_vv_f32m1(vle32_v_f32m1(h + o, vl), nn, vl);         \
+    vse32_v_f32m1(h_out + o,                                                   \
+                  vfmacc_vv_f32m1(nn, vmath_sigmoid_f32m1(a1_##q, vl), d, vl), \
+                  vl);                                                         \
+  }
+
+// The strip of vl hidden units from j, for a tile of NB inputs: a row of the
+// weights is loaded once for all the inputs of the tile
+#define lstm_strip_def_gen(NB)                                                 \
+  static void lstm_strip_##NB(float *h_out, float *c_out, const float *x,      \
+                              const float *h, const float *c, const float *w,  \
+                              const float *b, uint64_t in, uint64_t hid,       \
+                              uint64_t j, size_t vl) {                         \
+    const uint64_t ld = 4 * hid;                                               \
+    const float *wr = w + j;                                                   \
+    vfloat32m1_t b0 = vle32_v_f32m1(b + j, vl);                                \
+    vfloat32m1_t b1 = vle32_v_f32m1(b + hid + j, vl);                          \
+    vfloat32m1_t b2 = vle32_v_f32m1(b + 2 * hid + j, vl);                      \
+    vfloat32m1_t b3 = vle32_v_f32m1(b + 3 * hid + j, vl);                      \
+    RNN_FOR_##NB(RNN_ACC_DEF)                                                  \
+                                                                               \
+    /* The rows of x, then the ones of h */                                    \
+    for (int part = 0; part < 2; ++part) {                                     \
+      const float *s = part ? h : x;                                           \
+      const uint64_t n = part ? hid : in;                                      \
+      for (uint64_t k = 0; k < n; ++k, wr += ld) {                             \
+        vfloat32m1_t w0 = vle32_v_f32m1(wr, vl);                               \
+        vfloat32m1_t w1 = vle32_v_f32m1(wr + hid, vl);                         \
+        vfloat32m1_t w2 = vle32_v_f32m1(wr + 2 * hid, vl);                     \
+        vfloat32m1_t w3 = vle32_v_f32m1(wr + 3 * hid, vl);                     \
+        RNN_FOR_##NB(LSTM_MACC)                                                \
+      }                                                                        \
+    }                                                                          \
+                                                                               \
+    RNN_FOR_##NB(LSTM_UPDATE)                                                  \
+  }
+
+#define gru_strip_def_gen(NB)                                                  \
+  static void gru_strip_##NB(float *h_out, const float *x, const float *h,     \
+                             const float *w, const float *b, uint64_t in,      \
+                             uint64_t hid, uint64_t j, size_t vl) {            \
+    const uint64_t ld = 3 * hid;                                               \
+    const float *wr = w + j;                                                   \
+    vfloat32m1_t b0 = vle32_v_f32m1(b + j, vl);                                \
+    vfloat32m1_t b1 = vle32_v_f32m1(b + hid + j, vl);                          \
+    vfloat32m1_t b2 = vle32_v_f32m1(b + 2 * hid + j, vl);                      \
+    vfloat32m1_t b3 = vle32_v_f32m1(b + 3 * hid + j, vl);                      \
+    RNN_FOR_##NB(RNN_ACC_DEF)                                                  \
+                                                                               \
+    for (uint64_t k = 0; k < in; ++k, wr += ld) {                              \
+      vfloat32m1_t w0 = vle32_v_f32m1(wr, vl);                                 \
+      vfloat32m1_t w1 = vle32_v_f32m1(wr + hid, vl);                           \
+      vfloat32m1_t w2 = vle32_v_f32m1(wr + 2 * hid, vl);                       \
+      RNN_FOR_##NB(GRU_MACC_X)                                                 \
+    }                                                                          \
+    for (uint64_t k = 0; k < hid; ++k, wr += ld) {                             \
+      vfloat32m1_t w0 = vle32_v_f32m1(wr, vl);                                 \
+      vfloat32m1_t w1 = vle32_v_f32m1(wr + hid, vl);                           \
+      vfloat32m1_t w2 = vle32_v_f32m1(wr + 2 * hid, vl);                       \
+      RNN_FOR_##NB(GRU_MACC_H)                                                 \
+    }                                                                          \
+                                                                               \
+    RNN_FOR_##NB(GRU_UPDATE)                                                   \
+  }
+
+lstm_strip_def_gen(1);
+lstm_strip_def_gen(4);
+gru_strip_def_gen(1);
+gru_strip_def_gen(4);
+
+// Tiles of RNN_TILE inputs, and the last inputs one at a time
+void lstm_cell_f32(float *h_out, float *c_out, const float *x, const float *h,
+                   const float *c, const float *w, const float *b, uint64_t in,
+                   uint64_t hid, uint64_t batch) {
+  size_t vl;
+
+  for (uint64_t j = 0; j < hid; j += vl) {
+    vl = vsetvl_e32m1(hid - j);
+    uint64_t q = 0;
+    for (; q + RNN_TILE <= batch; q += RNN_TILE)
+      lstm_strip_4(h_out + q * hid, c_out + q * hid, x + q * in, h + q * hid,
+                   c + q * hid, w, b, in, hid, j, vl);
+    for (; q < batch; ++q)
+      lstm_strip_1(h_out + q * hid, c_out + q * hid, x + q * in, h + q * hid,
+                   c + q * hid, w, b, in, hid, j, vl);
+  }
+}
+
+void gru_cell_f32(float *h_out, const float *x, const float *h, const float *w,
+                  const float *b, uint64_t in, uint64_t hid, uint64_t batch) {
+  size_t vl;
+
+  for (uint64_t j = 0; j < hid; j += vl) {
+    vl = vsetvl_e32m1(hid - j);
+    uint64_t q = 0;
+    for (; q + RNN_TILE <= batch; q += RNN_TILE)
+      gru_strip_4(h_out + q * hid, x + q * in, h + q * hid, w, b, in, hid, j,
+                  vl);
+    for (; q < batch; ++q)
+      gru_strip_1(h_out + q * hid, x + q * in, h + q * hid, w, b, in, hid, j,
+                  vl);
+  }
+}
+
+/*
+  Unfused LSTM cell
+*/
+
+// gates = xh W + b, for each input, with LMUL=4 strips of the 4 hid gates
+static void lstm_gates_f32(float *gates, const float *x, const float *h,
+                           const float *w, const float *b, uint64_t in,
+                           uint64_t hid, uint64_t batch) {
+  const uint64_t ld = 4 * hid;
+  size_t vl;
+
+  for (uint64_t q = 0; q < batch; ++q) {
+    for (uint64_t j = 0; j < ld; j += vl) {
+      vl = vsetvl_e32m4(ld - j);
+      vfloat32m4_t acc = vle32_v_f32m4(b + j, vl);
+      for (uint64_t k = 0; k < in; ++k)
+        acc = vfmacc_vf_f32m4(acc, x[q * in + k],
+                              vle32_v_f32m4(w + k * ld + j, vl), vl);
+      for (uint64_t k = 0; k < hid; ++k)
+        acc = vfmacc_vf_f32m4(acc, h[q * hid + k],
+                              vle32_v_f32m4(w + (in + k) * ld + j, vl), vl);
+      vse32_v_f32m4(gates + q * ld + j, acc, vl);
+    }
+  }
+}
+
+static void rnn_sigmoid_f32(float *y, const float *x, uint64_t n) {
+  size_t vl;
+  for (uint64_t i = 0; i < n; i += vl) {
+    vl = vsetvl_e32m2(n - i);
+    vse32_v_f32m2(y + i, vmath_sigmoid_f32m2(vle32_v_f32m2(x + i, vl), vl), vl);
+  }
+}
+
+static void rnn_tanh_f32(float *y, const float *x, uint64_t n) {
+  size_t vl;
+  for (uint64_t i = 0; i < n; i += vl) {
+    vl = vsetvl_e32m2(n - i);
+    vse32_v_f32m2(y + i, vmath_tanh_f32m2(vle32_v_f32m2(x + i, vl), vl), vl);
+  }
+}
+
+// y = a b + c d, or y = a b if c is NULL
+static void rnn_mul_add_f32(float *y, const float *a, const float *b,
+                            const float *c, const float *d, uint64_t n) {
+  size_t vl;
+  for (uint64_t i = 0; i < n; i += vl) {
+    vl = vsetvl_e32m8(n - i);
+    vfloat32m8_t t =
+        vfmul_vv_f32m8(vle32_v_f32m8(a + i, vl), vle32_v_f32m8(b + i, vl), vl);
+    if (c)
+      t = vfmacc_vv_f32m8(t, vle32_v_f32m8(c + i, vl),
+                          vle32_v_f32m8(d + i, vl), vl);
+    vse32_v_f32m8(y + i, t, vl);
+  }
+}
+
+void lstm_cell_unfused_f32(float *h_out, float *c_out, float *gates,
+                           const float *x, const float *h, const float *c,
+                           const float *w, const float *b, uint64_t in,
+                           uint64_t hid, uint64_t batch) {
+  lstm_gates_f32(gates, x, h, w, b, in, hid, batch);
+
+  for (uint64_t q = 0; q < batch; ++q) {
+    float *i = gates + q * 4 * hid;
+    float *f = i + hid;
+    float *g = f + hid;
+    float *o = g + hid;
+    rnn_sigmoid_f32(i, i, 2 * hid);
+    rnn_tanh_f32(g, g, hid);
+    rnn_sigmoid_f32(o, o, hid);
+    // c' = f c + i g, then h' = o tanh(c')
+    rnn_mul_add_f32(c_out + q * hid, f, c + q * hid, i, g, hid);
+    rnn_tanh_f32(h_out + q * hid, c_out + q * hid, hid);
+    rnn_mul_add_f32(h_out + q * hid, o, h_out + q * hid, NULL, NULL, hid);
+  }
+}
@@ -0,0 +1,53 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Recurrent cells in FP32, on a batch of batch inputs x of in elements and
+// states h (and c) of hid elements, all stored by rows:
+//   lstm_cell_f32: [i f g o] = xh W + b, with xh = [x h],
+//                  c' = sigmoid(f) c + sigmoid(i) tanh(g),
+//                  h' = sigmoid(o) tanh(c')
+//   gru_cell_f32:  [r z] = sigmoid(xh W_rz + b_rz),
+//                  n = tanh(x W_nx + b_nx + r (h W_nh + b_nh)),
+//                  h' = (1 - z) n + z h
+// The weights of the gates are stacked side by side, in a matrix of in + hid
+// rows stored by rows, the rows of x first: [(in + hid) x 4 hid] for the LSTM
+// (i, f, g, o), and [(in + hid) x 3 hid] for the GRU (r, z, n). The GRU has
+// 4 hid biases: the ones of r and z, and the ones of n on x and on h.
+//
+// The cells are fused: the gate GEMVs of a strip of the hidden units stay in
+// the VRF for the activations of vmath and the updates, and only h' and c'
+// are written. h' must not overlap h, c' can be c.
+// lstm_cell_unfused_f32 runs the same cell as separate passes over gates, of
+// batch x 4 hid elements: the GEMV, then the activations, then the updates.
+
+#ifndef _RNN_H_
+#define _RNN_H_
+
+#include <stdint.h>
+
+#include "riscv_vector.h"
+
+void lstm_cell_f32(float *h_out, float *c_out, const float *x, const float *h,
+                   const float *c, const float *w, const float *b, uint64_t in,
+                   uint64_t hid, uint64_t batch);
+void lstm_cell_unfused_f32(float *h_out, float *c_out, float *gates,
+                           const float *x, const float *h, const float *c,
+                           const float *w, const float *b, uint64_t in,
+                           uint64_t hid, uint64_t batch);
+void gru_cell_f32(float *h_out, const float *x, const float *h, const float *w,
+                  const float *b, uint64_t in, uint64_t hid, uint64_t batch);
+
+#endif
@@ -0,0 +1,131 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdint.h>
+
+#include "bench.h"
+#include "kernel/rnn.h"
+#include "runtime.h"
+#include "util.h"
+#include "vcheck.h"
+
+#ifndef SPIKE
+#include "printf.h"
+#else
+#include <stdio.h>
+#endif
+
+// Absolute error of the states after all the timesteps, mostly the one of the
+// sigmoid and tanh of vmath
+#define THRESHOLD 0.0001
+
+extern uint64_t in;
+extern uint64_t hid;
+extern uint64_t batch;
+extern uint64_t steps;
+// The inputs of all the timesteps, [steps][batch][in]
+extern float xs[] __attribute__((aligned(4 * NR_LANES)));
+extern float h0[] __attribute__((aligned(4 * NR_LANES)));
+extern float c0[] __attribute__((aligned(4 * NR_LANES)));
+extern float w_lstm[] __attribute__((aligned(4 * NR_LANES)));
+extern float b_lstm[] __attribute__((aligned(4 * NR_LANES)));
+extern float w_gru[] __attribute__((aligned(4 * NR_LANES)));
+extern float b_gru[] __attribute__((aligned(4 * NR_LANES)));
+// Ping-pong hidden states, the cell state, and the gates of the unfused cell
+extern float h_a[] __attribute__((aligned(4 * NR_LANES)));
+extern float h_b[] __attribute__((aligned(4 * NR_LANES)));
+extern float c_buf[] __attribute__((aligned(4 * NR_LANES)));
+extern float gates[] __attribute__((aligned(4 * NR_LANES)));
+extern float gold_h_lstm[] __attribute__((aligned(4 * NR_LANES)));
+extern float gold_c_lstm[] __attribute__((aligned(4 * NR_LANES)));
+extern float gold_h_gru[] __attribute__((aligned(4 * NR_LANES)));
+
+enum { CELL_LSTM, CELL_LSTM_UNFUSED, CELL_GRU };
+
+static void copy(float *dst, const float *src, uint64_t n) {
+  for (uint64_t i = 0; i < n; ++i)
+    dst[i] = src[i];
+}
+
+// Run all the timesteps from h0 and c0, and return the last hidden state
+static float *run(int cell) {
+  float *h = h_a, *h_next = h_b;
+  copy(h, h0, batch * hid);
+  copy(c_buf, c0, batch * hid);
+
+  start_timer();
+  for (uint64_t t = 0; t < steps; ++t) {
+    const float *x = xs + t * batch * in;
+    if (cell == CELL_LSTM)
+      lstm_cell_f32(h_next, c_buf, x, h, c_buf, w_lstm, b_lstm, in, hid, batch);
+    else if (cell == CELL_LSTM_UNFUSED)
+      lstm_cell_unfused_f32(h_next, c_buf, gates, x, h, c_buf, w_lstm, b_lstm,
+                            in, hid, batch);
+    else
+      gru_cell_f32(h_next, x, h, w_gru, b_gru, in, hid, batch);
+    float *tmp = h;
+    h = h_next;
+    h_next = tmp;
+  }
+  stop_timer();
+
+  return h;
+}
+
+// Two FLOP per MAC of the GEMVs of the gates, gates_per_unit per hidden unit
+static void report(const char *name, uint64_t gates_per_unit) {
+  bench_report_flops(name,
+                     2 * batch * (in + hid) * gates_per_unit * hid * steps);
+  printf("%s: %ld cycles/timestep.\n", name, get_timer() / steps);
+}
+
+int main() {
+  printf("\n");
+  printf("=========\n");
+  printf("=  RNN  =\n");
+  printf("=========\n");
+  printf("\n");
+  printf("\n");
+
+  printf("Input %lu, hidden %lu, batch %lu, %lu timesteps.\n", in, hid, batch,
+         steps);
+
+  int error = 0;
+  float *h;
+
+  h = run(CELL_LSTM);
+  report("lstm_cell_f32", 4);
+  error |= vcheck_report("lstm_cell_f32 (h)",
+                         vcheck_f32(h, gold_h_lstm, batch * hid, THRESHOLD));
+  error |= vcheck_report("lstm_cell_f32 (c)",
+                         vcheck_f32(c_buf, gold_c_lstm, batch * hid,
+                                    THRESHOLD));
+
+  h = run(CELL_LSTM_UNFUSED);
+  report("lstm_cell_unfused_f32", 4);
+  error |= vcheck_report("lstm_cell_unfused_f32 (h)",
+                         vcheck_f32(h, gold_h_lstm, batch * hid, THRESHOLD));
+  error |= vcheck_report("lstm_cell_unfused_f32 (c)",
+                         vcheck_f32(c_buf, gold_c_lstm, batch * hid,
+                                    THRESHOLD));
+
+  h = run(CELL_GRU);
+  report("gru_cell_f32", 3);
+  error |= vcheck_report("gru_cell_f32 (h)",
+                         vcheck_f32(h, gold_h_gru, batch * hid, THRESHOLD));
+
+  return error;
+}
@@ -0,0 +1,96 @@
+#!/usr/bin/env python3
+# Copyright 2022 ETH Zurich and University of Bologna.
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+# arg1: inputs, arg2: hidden units, arg3: batch, arg4: timesteps
+# The golden states are computed in FP64, from the FP32 inputs and weights
+
+import numpy as np
+import os
+import sys
+
+sys.path.insert(0, os.path.join(os.path.dirname(__file__), '../../common/script'))
+from data_emit import emit
+
+def sigmoid(x):
+  return 1 / (1 + np.exp(-x))
+
+# Gates [i f g o], weights [(in + hid) x 4 hid]
+def lstm(x, h, c, w, b):
+  a = np.concatenate((x, h), axis=1) @ w + b
+  i, f, g, o = np.split(a, 4, axis=1)
+  c = sigmoid(f) * c + sigmoid(i) * np.tanh(g)
+  return sigmoid(o) * np.tanh(c), c
+
+# Gates [r z n], weights [(in + hid) x 3 hid], biases [r z n_x n_h]
+def gru(x, h, w, b, n_in):
+  hid = h.shape[1]
+  ax = x @ w[:n_in]
+  ah = h @ w[n_in:]
+  r = sigmoid(ax[:, :hid] + ah[:, :hid] + b[:hid])
+  z = sigmoid(ax[:, hid:2*hid] + ah[:, hid:2*hid] + b[hid:2*hid])
+  n = np.tanh(ax[:, 2*hid:] + b[2*hid:3*hid] + r * (ah[:, 2*hid:] + b[3*hid:]))
+  return n + z * (h - n)
+
+############
+## SCRIPT ##
+############
+
+if len(sys.argv) == 5:
+  n_in  = int(sys.argv[1])
+  hid   = int(sys.argv[2])
+  batch = int(sys.argv[3])
+  steps = int(sys.argv[4])
+else:
+  print("Error. Give me four arguments: the inputs, the hidden units, the batch, and the timesteps.")
+  sys.exit()
+
+# The initialization of PyTorch
+bound = 1 / np.sqrt(hid)
+xs = np.random.uniform(-1, 1, (steps, batch, n_in)).astype(np.float32)
+h0 = np.random.uniform(-1, 1, (batch, hid)).astype(np.float32)
+c0 = np.random.uniform(-1, 1, (batch, hid)).astype(np.float32)
+w_lstm = np.random.uniform(-bound, bound, (n_in + hid, 4 * hid)).astype(np.float32)
+b_lstm = np.random.uniform(-bound, bound, 4 * hid).astype(np.float32)
+w_gru = np.random.uniform(-bound, bound, (n_in + hid, 3 * hid)).astype(np.float32)
+b_gru = np.random.uniform(-bound, bound, 4 * hid).astype(np.float32)
+
+h, c, hg = h0.astype(np.float64), c0.astype(np.float64), h0.astype(np.float64)
+for t in range(steps):
+  x = xs[t].astype(np.float64)
+  h, c = lstm(x, h, c, w_lstm.astype(np.float64), b_lstm.astype(np.float64))
+  hg = gru(x, hg, w_gru.astype(np.float64), b_gru.astype(np.float64), n_in)
+
+# Create the file
+print(".section .data,\"aw\",@progbits")
+emit("in", np.array(n_in, dtype=np.uint64))
+emit("hid", np.array(hid, dtype=np.uint64))
+emit("batch", np.array(batch, dtype=np.uint64))
+emit("steps", np.array(steps, dtype=np.uint64))
+emit("xs", xs, 'NR_LANES*4')
+emit("h0", h0, 'NR_LANES*4')
+emit("c0", c0, 'NR_LANES*4')
+emit("w_lstm", w_lstm, 'NR_LANES*4')
+emit("b_lstm", b_lstm, 'NR_LANES*4')
+emit("w_gru", w_gru, 'NR_LANES*4')
+emit("b_gru", b_gru, 'NR_LANES*4')
+emit("h_a", np.zeros(batch * hid, dtype=np.float32), 'NR_LANES*4')
+emit("h_b", np.zeros(batch * hid, dtype=np.float32), 'NR_LANES*4')
+emit("c_buf", np.zeros(batch * hid, dtype=np.float32), 'NR_LANES*4')
+emit("gates", np.zeros(batch * 4 * hid, dtype=np.float32), 'NR_LANES*4')
+emit("gold_h_lstm", h.astype(np.float32), 'NR_LANES*4')
+emit("gold_c_lstm", c.astype(np.float32), 'NR_LANES*4')
+emit("gold_h_gru", hg.astype(np.float32), 'NR_LANES*4')
@@ -479,6 +479,184 @@ int64_t CropAndResizePerBox_BHWC_vec(
   return 0;
 }
 
+// Vectorized across the crop positions of all the boxes, instead of across
+// the channels: each element of a vector is a position (box, y, x), whose
+// corners and lerp weights are computed once in the registers and then reused
+// for all the channels, with indexed loads and stores. The image is loaded
+// from (and the crops stored to) plane + pix * pix_stride + d * chan_stride.
+static int64_t crop_and_resize_boxes_vec(
+    const float *image_data, const int batch_size, const int depth,
+    const int image_height, const int image_width,
+
+    const float *boxes_data, const int *box_index_data, const int start_box,
+    const int limit_box,
+
+    float *crops_data, const int crop_height, const int crop_width,
+    const float extrapolation_value, const int bhwc) {
+
+  const int image_channel_elements = image_height * image_width;
+  const int image_elements = depth * image_channel_elements;
+
+  const int channel_elements = crop_height * crop_width;
+  const int crop_elements = depth * channel_elements;
+
+  // Strides, in elements
+  const uint32_t image_pix_stride = bhwc ? depth : 1;
+  const uint32_t image_chan_stride = bhwc ? 1 : image_channel_elements;
+  const uint32_t crops_pix_stride = bhwc ? depth : 1;
+  const uint32_t crops_chan_stride = bhwc ? 1 : channel_elements;
+
+  const float h_max = image_height - 1;
+  const float w_max = image_width - 1;
+
+  for (int b = start_box; b < limit_box; ++b) {
+    const int b_in = box_index_data[b];
+    if (b_in < 0 || b_in >= batch_size) {
+      printf("Error: batch_index %d out of range [0, %d)\n", b_in, batch_size);
+      return -1;
+    }
+  }
+
+  const uint32_t n_pos = (limit_box - start_box) * channel_elements;
+  size_t vl;
+
+  for (uint32_t p0 = 0; p0 < n_pos; p0 += vl) {
+    vl = vsetvl_e32m2(n_pos - p0);
+
+    // Position (b, y, x) of each element
+    vuint32m2_t pos = vadd_vx_u32m2(vid_v_u32m2(vl), p0, vl);
+    vuint32m2_t b = vdivu_vx_u32m2(pos, channel_elements, vl);
+    pos = vnmsac_vx_u32m2(pos, channel_elements, b, vl);
+    vuint32m2_t y = vdivu_vx_u32m2(pos, crop_width, vl);
+    vuint32m2_t x = vnmsac_vx_u32m2(pos, crop_width, y, vl);
+    b = vadd_vx_u32m2(b, start_box, vl);
+
+    // Coordinates and image of the boxes
+    vuint32m2_t off = vsll_vx_u32m2(b, 4, vl);
+    vfloat32m2_t y1 = vluxei32_v_f32m2(&boxes_data[0], off, vl);
+    vfloat32m2_t x1 = vluxei32_v_f32m2(&boxes_data[1], off, vl);
+    vfloat32m2_t y2 = vluxei32_v_f32m2(&boxes_data[2], off, vl);
+    vfloat32m2_t x2 = vluxei32_v_f32m2(&boxes_data[3], off, vl);
+    vuint32m2_t b_in = vreinterpret_v_i32m2_u32m2(
+        vluxei32_v_i32m2(box_index_data, vsll_vx_u32m2(b, 2, vl), vl));
+
+    // Sampling point in the image
+    vfloat32m2_t in_y, in_x;
+    if (crop_height > 1) {
+      vfloat32m2_t height_scale = vfmul_vf_f32m2(vfsub_vv_f32m2(y2, y1, vl),
+                                                 h_max, vl);
+      height_scale = vfdiv_vf_f32m2(height_scale, crop_height - 1, vl);
+      in_y = vfmul_vf_f32m2(y1, h_max, vl);
+      in_y = vfmacc_vv_f32m2(in_y, vfcvt_f_xu_v_f32m2(y, vl), height_scale,
+                             vl);
+    } else {
+      in_y = vfmul_vf_f32m2(vfadd_vv_f32m2(y1, y2, vl), 0.5f * h_max, vl);
+    }
+    if (crop_width > 1) {
+      vfloat32m2_t width_scale = vfmul_vf_f32m2(vfsub_vv_f32m2(x2, x1, vl),
+                                                w_max, vl);
+      width_scale = vfdiv_vf_f32m2(width_scale, crop_width - 1, vl);
+      in_x = vfmul_vf_f32m2(x1, w_max, vl);
+      in_x = vfmacc_vv_f32m2(in_x, vfcvt_f_xu_v_f32m2(x, vl), width_scale,
+                             vl);
+    } else {
+      in_x = vfmul_vf_f32m2(vfadd_vv_f32m2(x1, x2, vl), 0.5f * w_max, vl);
+    }
+
+    // The points out of the image are extrapolated. Move them to (0, 0), so
+    // that their corners can be loaded.
+    vbool16_t out = vmor_mm_b16(vmflt_vf_f32m2_b16(in_y, 0, vl),
+                                vmfgt_vf_f32m2_b16(in_y, h_max, vl), vl);
+    out = vmor_mm_b16(out, vmflt_vf_f32m2_b16(in_x, 0, vl), vl);
+    out = vmor_mm_b16(out, vmfgt_vf_f32m2_b16(in_x, w_max, vl), vl);
+    in_y = vfmerge_vfm_f32m2(out, in_y, 0, vl);
+    in_x = vfmerge_vfm_f32m2(out, in_x, 0, vl);
+
+    // The points are not negative: floor() truncates
+    vuint32m2_t top_y = vfcvt_rtz_xu_f_v_u32m2(in_y, vl);
+    vuint32m2_t left_x = vfcvt_rtz_xu_f_v_u32m2(in_x, vl);
+    vfloat32m2_t y_lerp =
+        vfsub_vv_f32m2(in_y, vfcvt_f_xu_v_f32m2(top_y, vl), vl);
+    vfloat32m2_t x_lerp =
+        vfsub_vv_f32m2(in_x, vfcvt_f_xu_v_f32m2(left_x, vl), vl);
+
+    // Byte offsets of the corners, and of the crops. ceil() is the next index,
+    // unless the point is on the grid.
+    vuint32m2_t off_tl = vmul_vx_u32m2(top_y, image_width, vl);
+    off_tl = vadd_vv_u32m2(off_tl, left_x, vl);
+    off_tl = vmul_vx_u32m2(off_tl, image_pix_stride, vl);
+    off_tl = vmacc_vx_u32m2(off_tl, image_elements, b_in, vl);
+    off_tl = vsll_vx_u32m2(off_tl, 2, vl);
+    const uint32_t next_x = image_pix_stride * sizeof(float);
+    const uint32_t next_y = image_width * next_x;
+    vuint32m2_t off_tr = vadd_vx_u32m2_m(vmfgt_vf_f32m2_b16(x_lerp, 0, vl),
+                                         off_tl, off_tl, next_x, vl);
+    vbool16_t y_next = vmfgt_vf_f32m2_b16(y_lerp, 0, vl);
+    vuint32m2_t off_bl = vadd_vx_u32m2_m(y_next, off_tl, off_tl, next_y, vl);
+    vuint32m2_t off_br = vadd_vx_u32m2_m(y_next, off_tr, off_tr, next_y, vl);
+
+    vuint32m2_t off_crop = vmul_vx_u32m2(b, crop_elements, vl);
+    off_crop = vmacc_vx_u32m2(off_crop, crops_pix_stride, pos, vl);
+    off_crop = vsll_vx_u32m2(off_crop, 2, vl);
+
+    // Same positions, on all the channels
+    const float *pimage = image_data;
+    float *pcrops = crops_data;
+    for (int d = 0; d < depth; ++d) {
+      vfloat32m2_t top_left = vluxei32_v_f32m2(pimage, off_tl, vl);
+      vfloat32m2_t top_right = vluxei32_v_f32m2(pimage, off_tr, vl);
+      vfloat32m2_t bottom_left = vluxei32_v_f32m2(pimage, off_bl, vl);
+      vfloat32m2_t bottom_right = vluxei32_v_f32m2(pimage, off_br, vl);
+
+      vfloat32m2_t top = vfsub_vv_f32m2(top_right, top_left, vl);
+      top = vfmadd_vv_f32m2(top, x_lerp, top_left, vl);
+      vfloat32m2_t bottom = vfsub_vv_f32m2(bottom_right, bottom_left, vl);
+      bottom = vfmadd_vv_f32m2(bottom, x_lerp, bottom_left, vl);
+
+      vfloat32m2_t result = vfsub_vv_f32m2(bottom, top, vl);
+      result = vfmadd_vv_f32m2(result, y_lerp, top, vl);
+      result = vfmerge_vfm_f32m2(out, result, extrapolation_value, vl);
+
+      vsuxei32_v_f32m2(pcrops, off_crop, result, vl);
+
+      pimage += image_chan_stride;
+      pcrops += crops_chan_stride;
+    }
+  }
+
+  return 0;
+}
+
+int64_t CropAndResizeBoxes_BCHW_vec(
+    const float *image_data, const int batch_size, const int depth,
+    const int image_height, const int image_width,
+
+    const float *boxes_data, const int *box_index_data, const int start_box,
+    const int limit_box,
+
+    float *crops_data, const int crop_height, const int crop_width,
+    const float extrapolation_value) {
+  return crop_and_resize_boxes_vec(
+      image_data, batch_size, depth, image_height, image_width, boxes_data,
+      box_index_data, start_box, limit_box, crops_data, crop_height,
+      crop_width, extrapolation_value, 0);
+}
+
+int64_t CropAndResizeBoxes_BHWC_vec(
+    const float *image_data, const int batch_size, const int depth,
+    const int image_height, const int image_width,
+
+    const float *boxes_data, const int *box_index_data, const int start_box,
+    const int limit_box,
+
+    float *crops_data, const int crop_height, const int crop_width,
+    const float extrapolation_value) {
+  return crop_and_resize_boxes_vec(
+      image_data, batch_size, depth, image_height, image_width, boxes_data,
+      box_index_data, start_box, limit_box, crops_data, crop_height,
+      crop_width, extrapolation_value, 1);
+}
+
 // Normalized image
 void init_image(float *vec, size_t size) {
   for (unsigned long int i = 0; i < size; ++i)
@@ -56,6 +56,27 @@ int64_t CropAndResizePerBox_BHWC_vec(
     float *crops_data, const int crop_height, const int crop_width,
     const float extrapolation_value);
 
+// Vectorized across the crop positions of all the boxes
+int64_t CropAndResizeBoxes_BCHW_vec(
+    const float *image_data, const int batch_size, const int depth,
+    const int image_height, const int image_width,
+
+    const float *boxes_data, const int *box_index_data, const int start_box,
+    const int limit_box,
+
+    float *crops_data, const int crop_height, const int crop_width,
+    const float extrapolation_value);
+
+int64_t CropAndResizeBoxes_BHWC_vec(
+    const float *image_data, const int batch_size, const int depth,
+    const int image_height, const int image_width,
+
+    const float *boxes_data, const int *box_index_data, const int start_box,
+    const int limit_box,
+
+    float *crops_data, const int crop_height, const int crop_width,
+    const float extrapolation_value);
+
 // Normalized image
 void init_image(float *vec, size_t size);
 
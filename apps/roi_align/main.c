@@ -98,10 +98,17 @@ int main() {
   // Vector benchmark
   printf("Starting vector benchmark...\n");
   start_timer();
+#ifdef ROI_ALIGN_PER_BOX
   CropAndResizePerBox_BCHW_vec(image_data, BATCH_SIZE, DEPTH, IMAGE_HEIGHT,
                                IMAGE_WIDTH, boxes_data, box_index_data, 0,
                                N_BOXES, crops_data_vec, CROP_HEIGHT, CROP_WIDTH,
                                EXTRAPOLATION_VALUE);
+#else
+  CropAndResizeBoxes_BCHW_vec(image_data, BATCH_SIZE, DEPTH, IMAGE_HEIGHT,
+                              IMAGE_WIDTH, boxes_data, box_index_data, 0,
+                              N_BOXES, crops_data_vec, CROP_HEIGHT, CROP_WIDTH,
+                              EXTRAPOLATION_VALUE);
+#endif
   stop_timer();
   runtime_v = get_timer();
   printf("Vector benchmark complete.\n");
@@ -18,6 +18,7 @@
 # arg1: image size, arg2: filter size
 
 import numpy as np
+import os
 import sys
 
 # Batch * Depth * Height * Width
@@ -25,16 +26,8 @@ def rand_matrix(dims):
         mtx = np.random.rand(*dims).astype(dtype=np.float32)
         return mtx
 
-def emit(name, array, alignment='8'):
-        print(".global %s" % name)
-        print(".balign " + alignment)
-        print("%s:" % name)
-        bs = array.tobytes()
-        for i in range(0, len(bs), 4):
-                s = ""
-                for n in range(4):
-                        s += "%02x" % bs[i+3-n]
-                print("    .word 0x%s" % s)
+sys.path.insert(0, os.path.join(os.path.dirname(__file__), '../../common/script'))
+from data_emit import emit
 
 # Define the filter size and the matrix dimension (max, for now, is 128 64-bit elements)
 if len(sys.argv) > 1:
@@ -21,7 +21,10 @@
 
 #include "riscv_vector.h"
 
-#include "../softmax/lib/exp.h"
+#include "vmath/vmath.h"
+
+#include "prof.h"
+#include "softmax.h"
 
 // Our fdiv cannot receive any X in input
 // The following macro is just a trick and should NOT be used
@@ -107,9 +110,31 @@ void softmax(const float *i, const float *o, const float *buf,
   }
 }
 
-void softmax_vec(const float *i, const float *o, uint64_t channels,
-                 uint64_t innerSize) {
+// Softmax over the last axis of a rows x cols row-major matrix
+void softmax_rows(const float *i, const float *o, uint64_t rows,
+                  uint64_t cols) {
+
+  float *srcPtr = (float *)i;
+  float *dstPtr = (float *)o;
+
+  for (uint64_t r = 0; r < rows; ++r) {
+    float max = srcPtr[r * cols];
+    float sum = 0.f;
+
+    for (uint64_t c = 1; c < cols; ++c)
+      max = fmax(max, srcPtr[r * cols + c]);
+
+    for (uint64_t c = 0; c < cols; ++c) {
+      dstPtr[r * cols + c] = exp(srcPtr[r * cols + c] - max);
+      sum += dstPtr[r * cols + c];
+    }
 
+    for (uint64_t c = 0; c < cols; ++c)
+      dstPtr[r * cols + c] /= sum;
+  }
+}
+
+static void softmax_reset_vregs() {
   /* ONLY FOR DEBUGGING PURPOSE. DELETE THE FOLLOWING ASM LINES
    */
   // Clean the regs from Xes
@@ -122,6 +147,12 @@ void softmax_vec(const float *i, const float *o, uint64_t channels,
   asm volatile("vmv.v.i v16, 0");
   asm volatile("vmv.v.i v24, 0");
 #endif
+}
+
+void softmax_vec(const float *i, const float *o, uint64_t channels,
+                 uint64_t innerSize) {
+
+  softmax_reset_vregs();
 
   size_t avl = innerSize;
   size_t vl;
@@ -149,6 +180,8 @@ void softmax_vec(const float *i, const float *o, uint64_t channels,
       Calculate the maximum along the channel dimension
     */
 
+    PROF_BEGIN(SOFTMAX_PROF_MAX);
+
     // Initialize the max vector
     max_chunk_v = vle32_v_f32m1(__i, vl);
     // Bump the pointer
@@ -164,10 +197,14 @@ void softmax_vec(const float *i, const float *o, uint64_t channels,
     // Restore the channel pointer
     __i = _i;
 
+    PROF_END(SOFTMAX_PROF_MAX);
+
     /*
       Fetch, subtract, exponentiate along the channel dimension
     */
 
+    PROF_BEGIN(SOFTMAX_PROF_EXP);
+
     // Initialize accumulator
     den_chunk_v = vfmv_v_f_f32m1(0, vl);
     for (uint64_t ch = 0; ch < channels; ++ch) {
@@ -176,7 +213,7 @@ void softmax_vec(const float *i, const float *o, uint64_t channels,
       // Subtract the maximum
       buf_chunk_v = vfsub_vv_f32m1(buf_chunk_v, max_chunk_v, vl);
       // Exponentiate
-      buf_chunk_v = __exp_2xf32(buf_chunk_v, vl);
+      buf_chunk_v = vmath_exp_f32m1(buf_chunk_v, vl);
       // Store the numerator to memory
       vse32_v_f32m1(__o, buf_chunk_v, vl);
       // Accumulate
@@ -189,10 +226,14 @@ void softmax_vec(const float *i, const float *o, uint64_t channels,
     __i = _i;
     __o = _o;
 
+    PROF_END(SOFTMAX_PROF_EXP);
+
     /*
       Divide by the computed sum
     */
 
+    PROF_BEGIN(SOFTMAX_PROF_DIV);
+
     for (uint64_t ch = 0; ch < channels; ++ch) {
       // Load numerator from memory
       num_chunk_v = vle32_v_f32m1(__o, vl);
@@ -203,6 +244,9 @@ void softmax_vec(const float *i, const float *o, uint64_t channels,
       // Bump channel pointers
       __o += innerSize;
     }
+
+    PROF_END(SOFTMAX_PROF_DIV);
+
     // Bump stripmining pointers
     _i += vl;
     _o += vl;
@@ -211,3 +255,235 @@ void softmax_vec(const float *i, const float *o, uint64_t channels,
     __o = _o;
   }
 }
+
+// Online softmax: the maximum and the sum of the exponentials are computed in
+// the same pass, rescaling the partial sum whenever the maximum grows.
+// Since the new maximum is either the old one or the new sample, a single
+// exponential per sample is enough: e = exp(-|x - max|) is the new term if the
+// maximum does not change, and the rescaling factor of the sum otherwise.
+// The second pass exponentiates again and multiplies by the reciprocal of the
+// sum, so the input is read twice and the output written once.
+void softmax_vec_online(const float *i, const float *o, uint64_t channels,
+                        uint64_t innerSize) {
+
+  softmax_reset_vregs();
+
+  size_t avl = innerSize;
+  size_t vl;
+
+  // Stripmining pointers
+  float *_i = (float *)i;
+  float *_o = (float *)o;
+
+  // Vector registers
+  vfloat32m1_t max_chunk_v;
+  vfloat32m1_t den_chunk_v;
+  vfloat32m1_t rcp_chunk_v;
+  vfloat32m1_t buf_chunk_v;
+  vfloat32m1_t exp_chunk_v;
+  vfloat32m1_t one_chunk_v;
+  vbool32_t gt_mask;
+
+  // Stripmine on innerSize
+  for (; avl > 0; avl -= vl) {
+
+    vl = vsetvl_e32m1(avl);
+
+    float *__i = _i;
+    float *__o = _o;
+
+    /*
+      Running maximum and sum of exponentials along the channel dimension
+    */
+
+    one_chunk_v = vfmv_v_f_f32m1(1.0f, vl);
+    // The first channel is its own maximum
+    max_chunk_v = vle32_v_f32m1(__i, vl);
+    den_chunk_v = one_chunk_v;
+    __i += innerSize;
+    for (uint64_t ch = 1; ch < channels; ++ch) {
+      buf_chunk_v = vle32_v_f32m1(__i, vl);
+      __i += innerSize;
+      // x - max, and exp(-|x - max|)
+      exp_chunk_v = vfsub_vv_f32m1(buf_chunk_v, max_chunk_v, vl);
+      gt_mask = vmfgt_vf_f32m1_b32(exp_chunk_v, 0, vl);
+      exp_chunk_v = vfsgnj_vf_f32m1(exp_chunk_v, -1.0f, vl);
+      exp_chunk_v = vmath_exp_f32m1(exp_chunk_v, vl);
+      max_chunk_v = vfmax_vv_f32m1(max_chunk_v, buf_chunk_v, vl);
+      // sum + e if x <= max, sum * e + 1 otherwise
+      den_chunk_v = vmerge_vvm_f32m1(
+          gt_mask, vfadd_vv_f32m1(den_chunk_v, exp_chunk_v, vl),
+          vfmadd_vv_f32m1(den_chunk_v, exp_chunk_v, one_chunk_v, vl), vl);
+    }
+
+    // One division per element of the strip
+    rcp_chunk_v = vfrdiv_vf_f32m1(den_chunk_v, 1.0f, vl);
+
+    /*
+      Normalize
+    */
+
+    __i = _i;
+    for (uint64_t ch = 0; ch < channels; ++ch) {
+      buf_chunk_v = vle32_v_f32m1(__i, vl);
+      buf_chunk_v = vfsub_vv_f32m1(buf_chunk_v, max_chunk_v, vl);
+      buf_chunk_v = vmath_exp_f32m1(buf_chunk_v, vl);
+      buf_chunk_v = vfmul_vv_f32m1(buf_chunk_v, rcp_chunk_v, vl);
+      vse32_v_f32m1(__o, buf_chunk_v, vl);
+      __i += innerSize;
+      __o += innerSize;
+    }
+
+    // Bump stripmining pointers
+    _i += vl;
+    _o += vl;
+  }
+}
+
+// Online softmax over the last axis of a rows x cols row-major matrix, as in
+// attention. Each strip of a row is reduced to its own maximum and sum, which
+// are merged with the running ones of the row on the scalar side.
+void softmax_rows_vec(const float *i, const float *o, uint64_t rows,
+                      uint64_t cols) {
+
+  float *_i = (float *)i;
+  float *_o = (float *)o;
+
+  size_t vl;
+
+  vfloat32m1_t buf_chunk_v;
+  vfloat32m1_t red_v;
+
+  for (uint64_t r = 0; r < rows; ++r) {
+    float max = -INFINITY;
+    float sum = 0.f;
+
+    /*
+      Running maximum and sum of exponentials along the row
+    */
+
+    for (uint64_t c = 0; c < cols; c += vl) {
+      vl = vsetvl_e32m1(cols - c);
+
+      buf_chunk_v = vle32_v_f32m1(_i + c, vl);
+      red_v = vfmv_v_f_f32m1(-INFINITY, vl);
+      red_v = vfredmax_vs_f32m1_f32m1(red_v, buf_chunk_v, red_v, vl);
+      float strip_max = vfmv_f_s_f32m1_f32(red_v);
+
+      buf_chunk_v = vfsub_vf_f32m1(buf_chunk_v, strip_max, vl);
+      buf_chunk_v = vmath_exp_f32m1(buf_chunk_v, vl);
+      red_v = vfmv_v_f_f32m1(0, vl);
+      red_v = vfredusum_vs_f32m1_f32m1(red_v, buf_chunk_v, red_v, vl);
+      float strip_sum = vfmv_f_s_f32m1_f32(red_v);
+
+      // Rescale the sum with the smaller maximum
+      if (strip_max > max) {
+        sum = sum * expf(max - strip_max) + strip_sum;
+        max = strip_max;
+      } else {
+        sum += strip_sum * expf(strip_max - max);
+      }
+    }
+
+    /*
+      Normalize
+    */
+
+    float rcp = 1.0f / sum;
+    for (uint64_t c = 0; c < cols; c += vl) {
+      vl = vsetvl_e32m1(cols - c);
+
+      buf_chunk_v = vle32_v_f32m1(_i + c, vl);
+      buf_chunk_v = vfsub_vf_f32m1(buf_chunk_v, max, vl);
+      buf_chunk_v = vmath_exp_f32m1(buf_chunk_v, vl);
+      buf_chunk_v = vfmul_vf_f32m1(buf_chunk_v, rcp, vl);
+      vse32_v_f32m1(_o + c, buf_chunk_v, vl);
+    }
+
+    _i += cols;
+    _o += cols;
+  }
+}
+
+#ifndef VMATH_NO_F16
+// Softmax along the channels of an FP16 input, as softmax_vec. The maximum is
+// exact in FP16, while x - max, the exponentials and their sum are in FP32
+// (LMUL=2), and only the numerators and the results are narrowed to FP16.
+void softmax_vec_f16(const _Float16 *i, const _Float16 *o, uint64_t channels,
+                     uint64_t innerSize) {
+
+  softmax_reset_vregs();
+
+  size_t avl = innerSize;
+  size_t vl;
+
+  // Stripmining pointers
+  _Float16 *_i = (_Float16 *)i;
+  _Float16 *_o = (_Float16 *)o;
+
+  // Vector registers
+  vfloat16m1_t max_chunk_v;
+  vfloat16m1_t buf_chunk_v;
+  vfloat32m2_t exp_chunk_v;
+  vfloat32m2_t den_chunk_v;
+  vfloat32m2_t rcp_chunk_v;
+
+  // Stripmine on innerSize
+  for (; avl > 0; avl -= vl) {
+
+    vl = vsetvl_e16m1(avl);
+
+    _Float16 *__i = _i;
+    _Float16 *__o = _o;
+
+    /*
+      Calculate the maximum along the channel dimension
+    */
+
+    max_chunk_v = vle16_v_f16m1(__i, vl);
+    __i += innerSize;
+    for (uint64_t ch = 1; ch < channels; ++ch) {
+      buf_chunk_v = vle16_v_f16m1(__i, vl);
+      __i += innerSize;
+      max_chunk_v = vfmax_vv_f16m1(max_chunk_v, buf_chunk_v, vl);
+    }
+
+    /*
+      Fetch, subtract, exponentiate along the channel dimension
+    */
+
+    __i = _i;
+    den_chunk_v = vfmv_v_f_f32m2(0, vl);
+    for (uint64_t ch = 0; ch < channels; ++ch) {
+      buf_chunk_v = vle16_v_f16m1(__i, vl);
+      // Widening subtraction of the maximum
+      exp_chunk_v = vfwsub_vv_f32m2(buf_chunk_v, max_chunk_v, vl);
+      exp_chunk_v = vmath_exp_f32m2(exp_chunk_v, vl);
+      // Accumulate in FP32, and store the narrowed numerator
+      den_chunk_v = vfadd_vv_f32m2(den_chunk_v, exp_chunk_v, vl);
+      vse16_v_f16m1(__o, vfncvt_f_f_w_f16m1(exp_chunk_v, vl), vl);
+      __i += innerSize;
+      __o += innerSize;
+    }
+
+    // One division per element of the strip
+    rcp_chunk_v = vfrdiv_vf_f32m2(den_chunk_v, 1.0f, vl);
+
+    /*
+      Normalize
+    */
+
+    __o = _o;
+    for (uint64_t ch = 0; ch < channels; ++ch) {
+      exp_chunk_v = vfwcvt_f_f_v_f32m2(vle16_v_f16m1(__o, vl), vl);
+      exp_chunk_v = vfmul_vv_f32m2(exp_chunk_v, rcp_chunk_v, vl);
+      vse16_v_f16m1(__o, vfncvt_f_f_w_f16m1(exp_chunk_v, vl), vl);
+      __o += innerSize;
+    }
+
+    // Bump stripmining pointers
+    _i += vl;
+    _o += vl;
+  }
+}
+#endif
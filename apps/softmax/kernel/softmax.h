@@ -19,10 +19,32 @@
 #ifndef _SOFTMAX_H_
 #define _SOFTMAX_H_
 
+// Regions of softmax_vec, profiled with prof=1 (common/prof.h)
+enum softmax_prof_e {
+  SOFTMAX_PROF_VEC = 0,
+  SOFTMAX_PROF_MAX,
+  SOFTMAX_PROF_EXP,
+  SOFTMAX_PROF_DIV
+};
+
 void softmax(const float *i, const float *o, const float *buf,
              uint64_t channels, uint64_t innerSize);
 
+void softmax_rows(const float *i, const float *o, uint64_t rows,
+                  uint64_t cols);
+
 void softmax_vec(const float *i, const float *o, uint64_t channels,
                  uint64_t innerSize);
 
+void softmax_vec_online(const float *i, const float *o, uint64_t channels,
+                        uint64_t innerSize);
+
+void softmax_rows_vec(const float *i, const float *o, uint64_t rows,
+                      uint64_t cols);
+
+#ifndef VMATH_NO_F16
+void softmax_vec_f16(const _Float16 *i, const _Float16 *o, uint64_t channels,
+                     uint64_t innerSize);
+#endif
+
 #endif
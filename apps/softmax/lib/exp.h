@@ -1 +0,0 @@
-../../exp/kernel/exp.h
\ No newline at end of file
@@ -20,8 +20,11 @@
 #include <string.h>
 
 #include "kernel/softmax.h"
+#include "prof.h"
 #include "runtime.h"
+#include "trace.h"
 #include "util.h"
+#include "vcheck.h"
 
 #ifndef SPIKE
 #include "printf.h"
@@ -40,6 +43,7 @@
 // #define PRINT_RESULTS
 
 #define THRESHOLD 0.0001
+#define THRESHOLD_F16 0.001
 
 extern uint64_t channels;
 extern uint64_t innerSize;
@@ -47,6 +51,39 @@ extern float i[] __attribute__((aligned(4 * NR_LANES)));
 extern float buf[] __attribute__((aligned(4 * NR_LANES)));
 extern float o_s[] __attribute__((aligned(4 * NR_LANES)));
 extern float o_v[] __attribute__((aligned(4 * NR_LANES)));
+extern _Float16 i16[] __attribute__((aligned(4 * NR_LANES)));
+extern _Float16 o16[] __attribute__((aligned(4 * NR_LANES)));
+extern _Float16 gold16[] __attribute__((aligned(4 * NR_LANES)));
+
+// Compare the vector results with the scalar ones
+int check(const char *name) {
+  int error = 0;
+
+#ifdef PRINT_RESULTS
+  for (uint64_t k = 0; k < channels * innerSize; ++k) {
+    printf("%lu) Vector, Scalar: %x, %x\n", k, *((uint32_t *)&(o_v[k])),
+           *((uint32_t *)&(o_s[k])));
+  }
+#endif
+
+#ifdef CHECK
+  for (uint64_t k = 0; k < channels * innerSize; ++k) {
+#ifdef SANITY_CHECK
+    if (o_s[k] != o_v[k]) {
+#else
+    if (!similarity_check(o_s[k], o_v[k], THRESHOLD)) {
+#endif
+      error = 1;
+      trace_mismatch(k, "%s: Error at index %d. %f != %f\n", name, k, o_v[k],
+                     o_s[k]);
+    }
+  }
+  if (!error)
+    printf("%s: Check okay. No errors.\n", name);
+#endif
+
+  return error;
+}
 
 int main() {
   printf("\n");
@@ -69,35 +106,70 @@ int main() {
   runtime = get_timer();
   printf("The scalar SOFTMAX execution took %d cycles.\n", runtime);
 
+  PROF_NAME(SOFTMAX_PROF_VEC, "softmax_vec");
+  PROF_NAME(SOFTMAX_PROF_MAX, "max");
+  PROF_NAME(SOFTMAX_PROF_EXP, "exp");
+  PROF_NAME(SOFTMAX_PROF_DIV, "normalize");
+
   printf("Vector Softmax...\n");
   start_timer();
+  PROF_BEGIN(SOFTMAX_PROF_VEC);
   softmax_vec(i, o_v, channels, innerSize);
+  PROF_END(SOFTMAX_PROF_VEC);
   stop_timer();
 
   runtime = get_timer();
   printf("The vector Softmax execution took %d cycles.\n", runtime);
 
-#ifdef PRINT_RESULTS
-  for (uint64_t k = 0; k < channels * innerSize; ++k) {
-    printf("%lu) Vector, Scalar: %x, %x\n", k, *((uint32_t *)&(o_v[k])),
-           *((uint32_t *)&(o_s[k])));
-  }
-#endif
+  error |= check("softmax_vec");
 
-#ifdef CHECK
-  for (uint64_t k = 0; k < channels * innerSize; ++k) {
-#ifdef SANITY_CHECK
-    if (o_s[k] != o_v[k]) {
-#else
-    if (!similarity_check(o_s[k], o_v[k], THRESHOLD)) {
-#endif
-      error = 1;
-      printf("Error at index %d. %f != %f\n", k, o_v[k], o_s[k]);
-    }
+  printf("Online Vector Softmax...\n");
+  start_timer();
+  softmax_vec_online(i, o_v, channels, innerSize);
+  stop_timer();
+
+  runtime = get_timer();
+  printf("The online vector Softmax execution took %d cycles.\n", runtime);
+
+  error |= check("softmax_vec_online");
+
+  // FP16 input and output, against the FP32 softmax of the FP16 samples
+  printf("FP16 Vector Softmax...\n");
+  start_timer();
+  softmax_vec_f16(i16, o16, channels, innerSize);
+  stop_timer();
+
+  runtime = get_timer();
+  printf("The FP16 vector Softmax execution took %d cycles.\n", runtime);
+
+  int64_t idx = vcheck_f16(o16, gold16, channels * innerSize, THRESHOLD_F16);
+  if (idx >= 0) {
+    error = 1;
+    printf("softmax_vec_f16: Error at index %d.\n", idx);
+  } else {
+    printf("softmax_vec_f16: Check okay. No errors.\n");
   }
-  if (!error)
-    printf("Check okay. No errors.\n");
-#endif
+
+  // Softmax over the last axis, with one row per channel
+  printf("Scalar Row Softmax...\n");
+  start_timer();
+  softmax_rows(i, o_s, channels, innerSize);
+  stop_timer();
+
+  runtime = get_timer();
+  printf("The scalar row SOFTMAX execution took %d cycles.\n", runtime);
+
+  printf("Vector Row Softmax...\n");
+  start_timer();
+  softmax_rows_vec(i, o_v, channels, innerSize);
+  stop_timer();
+
+  runtime = get_timer();
+  printf("The vector row Softmax execution took %d cycles.\n", runtime);
+
+  error |= check("softmax_rows_vec");
+
+  PROF_DUMP();
 
   return error;
 }
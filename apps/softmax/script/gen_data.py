@@ -19,18 +19,11 @@
 
 import random as rand
 import numpy as np
+import os
 import sys
 
-def emit(name, array, alignment='8'):
-  print(".global %s" % name)
-  print(".balign " + alignment)
-  print("%s:" % name)
-  bs = array.tobytes()
-  for i in range(0, len(bs), 4):
-    s = ""
-    for n in range(4):
-      s += "%02x" % bs[i+3-n]
-    print("    .word 0x%s" % s)
+sys.path.insert(0, os.path.join(os.path.dirname(__file__), '../../common/script'))
+from data_emit import emit
 
 def rand_matrix(N, dtype):
   return np.random.rand(N).astype(dtype)
@@ -54,6 +47,12 @@ buf = np.zeros(channels * innerSize, dtype=np.float32)
 o_s = np.zeros(channels * innerSize, dtype=np.float32)
 o_g = np.zeros(channels * innerSize, dtype=np.float32)
 
+# FP16 samples, and their softmax along the channels computed in FP32
+i16 = i.astype(np.float16)
+e16 = np.exp(i16.astype(np.float32).reshape(channels, innerSize) -
+             i16.astype(np.float32).reshape(channels, innerSize).max(axis=0))
+gold16 = (e16 / e16.sum(axis=0)).astype(np.float16).flatten()
+
 # Create the file
 print(".section .data,\"aw\",@progbits")
 emit("channels", np.array(channels, dtype=np.uint64))
@@ -62,3 +61,6 @@ emit("i", i, 'NR_LANES*4')
 emit("buf", i, 'NR_LANES*4')
 emit("o_s", i, 'NR_LANES*4')
 emit("o_v", i, 'NR_LANES*4')
+emit("i16", i16, 'NR_LANES*4')
+emit("o16", np.zeros(channels * innerSize, dtype=np.float16), 'NR_LANES*4')
+emit("gold16", gold16, 'NR_LANES*4')
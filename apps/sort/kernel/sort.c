@@ -0,0 +1,238 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string.h>
+
+#include "sort.h"
+
+#define SORT_RADIX_MASK (SORT_RADIX_BUCKETS - 1)
+
+/*
+  Radix sort
+*/
+
+// Each pass counts the keys of each digit, and scatters them to the start of
+// their bucket plus the number of keys of the same digit before them: viota
+// ranks the keys of a strip, and the strips are processed in order, so the
+// passes are stable. The passes whose digit is the same for all the keys are
+// skipped.
+void radix_sort_u32(uint32_t *keys, uint32_t *buf, uint64_t n) {
+  uint32_t *src = keys;
+  uint32_t *dst = buf;
+  size_t vl;
+
+  for (uint32_t shift = 0; shift < 32; shift += SORT_RADIX_BITS) {
+    uint32_t offset[SORT_RADIX_BUCKETS];
+    for (uint32_t b = 0; b < SORT_RADIX_BUCKETS; ++b)
+      offset[b] = 0;
+
+    /*
+      Histogram of the digit
+    */
+
+    for (uint64_t i = 0; i < n; i += vl) {
+      vl = vsetvl_e32m4(n - i);
+      vuint32m4_t digit = vand_vx_u32m4(
+          vsrl_vx_u32m4(vle32_v_u32m4(src + i, vl), shift, vl),
+          SORT_RADIX_MASK, vl);
+      for (uint32_t b = 0; b < SORT_RADIX_BUCKETS; ++b)
+        offset[b] += vcpop_m_b8(vmseq_vx_u32m4_b8(digit, b, vl), vl);
+    }
+
+    // Exclusive prefix sum, unless a bucket holds all the keys
+    int skip = 0;
+    uint32_t start = 0;
+    for (uint32_t b = 0; b < SORT_RADIX_BUCKETS; ++b) {
+      const uint32_t count = offset[b];
+      skip |= count == n;
+      offset[b] = start;
+      start += count;
+    }
+    if (skip)
+      continue;
+
+    /*
+      Stable scatter to the buckets
+    */
+
+    for (uint64_t i = 0; i < n; i += vl) {
+      vl = vsetvl_e32m4(n - i);
+      vuint32m4_t key = vle32_v_u32m4(src + i, vl);
+      vuint32m4_t digit = vand_vx_u32m4(vsrl_vx_u32m4(key, shift, vl),
+                                        SORT_RADIX_MASK, vl);
+      for (uint32_t b = 0; b < SORT_RADIX_BUCKETS; ++b) {
+        vbool8_t in_b = vmseq_vx_u32m4_b8(digit, b, vl);
+        const uint32_t count = vcpop_m_b8(in_b, vl);
+        if (!count)
+          continue;
+        vuint32m4_t pos = vadd_vx_u32m4(viota_m_u32m4(in_b, vl), offset[b], vl);
+        vsuxei32_v_u32m4_m(in_b, dst, vsll_vx_u32m4(pos, 2, vl), key, vl);
+        offset[b] += count;
+      }
+    }
+
+    uint32_t *tmp = src;
+    src = dst;
+    dst = tmp;
+  }
+
+  if (src != keys)
+    memcpy(keys, src, n * sizeof(uint32_t));
+}
+
+/*
+  Bitonic sort
+*/
+
+// Sort the n <= SORT_BITONIC_MAX keys of v, padded to a power of two with
+// UINT32_MAX. At each step, lane i compares with lane i ^ j through vrgather,
+// and keeps the maximum in the descending half of each block of k lanes.
+static inline vuint32m1_t bitonic_sort_v(vuint32m1_t v, size_t vl) {
+  vuint32m1_t id = vid_v_u32m1(vl);
+  for (size_t k = 2; k <= vl; k <<= 1) {
+    vbool32_t desc = vmsne_vx_u32m1_b32(vand_vx_u32m1(id, k, vl), 0, vl);
+    for (size_t j = k >> 1; j > 0; j >>= 1) {
+      vuint32m1_t partner = vrgather_vv_u32m1(v, vxor_vx_u32m1(id, j, vl), vl);
+      vbool32_t upper = vmsne_vx_u32m1_b32(vand_vx_u32m1(id, j, vl), 0, vl);
+      vbool32_t take_max = vmxor_mm_b32(upper, desc, vl);
+      v = vmerge_vvm_u32m1(take_max, vminu_vv_u32m1(v, partner, vl),
+                           vmaxu_vv_u32m1(v, partner, vl), vl);
+    }
+  }
+  return v;
+}
+
+void bitonic_sort_u32(uint32_t *keys, uint64_t n) {
+  if (n < 2)
+    return;
+
+  size_t vl = 1;
+  while (vl < n)
+    vl <<= 1;
+  vl = vsetvl_e32m1(vl);
+
+  vuint32m1_t pad = vmv_v_x_u32m1(UINT32_MAX, vl);
+  vbool32_t valid = vmsltu_vx_u32m1_b32(vid_v_u32m1(vl), n, vl);
+  vuint32m1_t v = vle32_v_u32m1_m(valid, pad, keys, vl);
+
+  v = bitonic_sort_v(v, vl);
+
+  vse32_v_u32m1(keys, v, n);
+}
+
+/*
+  Merge sort
+*/
+
+// Merge the sorted a and b to out. Output k takes a[i] or b[k - i], where i,
+// the number of keys of a among the first k outputs, is the crossing of the
+// merge path with the k-th diagonal. Each lane binary searches its own i.
+static void merge_path_u32(const uint32_t *a, uint64_t la, const uint32_t *b,
+                           uint64_t lb, uint32_t *out) {
+  const uint64_t len = la + lb;
+  size_t vl;
+
+  for (uint64_t k = 0; k < len; k += vl) {
+    vl = vsetvl_e32m2(len - k);
+    vuint32m2_t diag = vadd_vx_u32m2(vid_v_u32m2(vl), k, vl);
+
+    // i in [max(0, diag - lb), min(diag, la)]
+    vuint32m2_t lo = vsub_vx_u32m2(vmaxu_vx_u32m2(diag, lb, vl), lb, vl);
+    vuint32m2_t hi = vminu_vx_u32m2(diag, la, vl);
+
+    // Smallest i such that i == hi, or a[i] > b[diag - i - 1]
+    vbool16_t active = vmsltu_vv_u32m2_b16(lo, hi, vl);
+    while (vcpop_m_b16(active, vl)) {
+      vuint32m2_t mid = vsrl_vx_u32m2(vadd_vv_u32m2(lo, hi, vl), 1, vl);
+      vuint32m2_t a_mid = vluxei32_v_u32m2_m(active, mid, a,
+                                             vsll_vx_u32m2(mid, 2, vl), vl);
+      vuint32m2_t b_idx = vsub_vx_u32m2(vsub_vv_u32m2(diag, mid, vl), 1, vl);
+      vuint32m2_t b_mid = vluxei32_v_u32m2_m(active, mid, b,
+                                             vsll_vx_u32m2(b_idx, 2, vl), vl);
+      vbool16_t go_lo =
+          vmand_mm_b16(active, vmsgtu_vv_u32m2_b16(a_mid, b_mid, vl), vl);
+      vbool16_t go_hi = vmand_mm_b16(active, vmnot_m_b16(go_lo, vl), vl);
+      hi = vmerge_vvm_u32m2(go_lo, hi, mid, vl);
+      lo = vmerge_vvm_u32m2(go_hi, lo, vadd_vx_u32m2(mid, 1, vl), vl);
+      active = vmsltu_vv_u32m2_b16(lo, hi, vl);
+    }
+
+    // a[i] if b is exhausted, or if a[i] <= b[diag - i]
+    vuint32m2_t b_i = vsub_vv_u32m2(diag, lo, vl);
+    vbool16_t in_a = vmsltu_vx_u32m2_b16(lo, la, vl);
+    vbool16_t in_b = vmsltu_vx_u32m2_b16(b_i, lb, vl);
+    vuint32m2_t pad = vmv_v_x_u32m2(UINT32_MAX, vl);
+    vuint32m2_t a_k =
+        vluxei32_v_u32m2_m(in_a, pad, a, vsll_vx_u32m2(lo, 2, vl), vl);
+    vuint32m2_t b_k =
+        vluxei32_v_u32m2_m(in_b, pad, b, vsll_vx_u32m2(b_i, 2, vl), vl);
+    vbool16_t take_a =
+        vmand_mm_b16(in_a, vmsleu_vv_u32m2_b16(a_k, b_k, vl), vl);
+    vbool16_t take_b = vmand_mm_b16(in_b, vmnot_m_b16(take_a, vl), vl);
+    vse32_v_u32m2(out + k, vmerge_vvm_u32m2(take_b, a_k, b_k, vl), vl);
+  }
+}
+
+void merge_sort_u32(uint32_t *keys, uint32_t *buf, uint64_t n) {
+  for (uint64_t i = 0; i < n; i += SORT_BITONIC_MAX)
+    bitonic_sort_u32(keys + i,
+                     n - i < SORT_BITONIC_MAX ? n - i : SORT_BITONIC_MAX);
+
+  uint32_t *src = keys;
+  uint32_t *dst = buf;
+  for (uint64_t w = SORT_BITONIC_MAX; w < n; w <<= 1) {
+    for (uint64_t i = 0; i < n; i += 2 * w) {
+      const uint64_t la = n - i < w ? n - i : w;
+      const uint64_t lb = n - i - la < w ? n - i - la : w;
+      merge_path_u32(src + i, la, src + i + la, lb, dst + i);
+    }
+    uint32_t *tmp = src;
+    src = dst;
+    dst = tmp;
+  }
+
+  if (src != keys)
+    memcpy(keys, src, n * sizeof(uint32_t));
+}
+
+/*
+  Scalar reference
+*/
+
+void radix_sort_u32_s(uint32_t *keys, uint32_t *buf, uint64_t n) {
+  uint32_t *src = keys;
+  uint32_t *dst = buf;
+
+  for (uint32_t shift = 0; shift < 32; shift += 8) {
+    uint32_t offset[256];
+    for (uint32_t b = 0; b < 256; ++b)
+      offset[b] = 0;
+    for (uint64_t i = 0; i < n; ++i)
+      offset[(src[i] >> shift) & 0xff]++;
+    uint32_t start = 0;
+    for (uint32_t b = 0; b < 256; ++b) {
+      const uint32_t count = offset[b];
+      offset[b] = start;
+      start += count;
+    }
+    for (uint64_t i = 0; i < n; ++i)
+      dst[offset[(src[i] >> shift) & 0xff]++] = src[i];
+
+    uint32_t *tmp = src;
+    src = dst;
+    dst = tmp;
+  }
+}
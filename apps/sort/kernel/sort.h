@@ -0,0 +1,45 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Sorting of 32-bit unsigned keys, in ascending order:
+//   radix_sort_u32: LSD radix sort, with SORT_RADIX_BITS bits per pass
+//   bitonic_sort_u32: bitonic sorting network in a vector register, for up
+//                     to SORT_BITONIC_MAX keys
+//   merge_sort_u32: blocks of SORT_BITONIC_MAX keys sorted by bitonic_sort_u32,
+//                   and merged by a vector merge path
+// buf is a buffer of n keys. The sorted keys are in keys.
+
+#ifndef _SORT_H_
+#define _SORT_H_
+
+#include <stdint.h>
+
+#include "riscv_vector.h"
+#include "vconfig.h"
+
+#define SORT_RADIX_BITS 4
+#define SORT_RADIX_BUCKETS (1 << SORT_RADIX_BITS)
+
+#define SORT_BITONIC_MAX VLMAX(32, 1)
+
+void radix_sort_u32(uint32_t *keys, uint32_t *buf, uint64_t n);
+void bitonic_sort_u32(uint32_t *keys, uint64_t n);
+void merge_sort_u32(uint32_t *keys, uint32_t *buf, uint64_t n);
+
+// Scalar LSD radix sort, with 8 bits per pass, as rsort of the riscv-tests
+void radix_sort_u32_s(uint32_t *keys, uint32_t *buf, uint64_t n);
+
+#endif
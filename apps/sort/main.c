@@ -0,0 +1,93 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdint.h>
+#include <string.h>
+
+#include "kernel/sort.h"
+#include "runtime.h"
+#include "util.h"
+#include "vcheck.h"
+
+#ifndef SPIKE
+#include "printf.h"
+#else
+#include <stdio.h>
+#endif
+
+extern uint64_t n;
+extern uint32_t keys[] __attribute__((aligned(4 * NR_LANES)));
+extern uint32_t work[] __attribute__((aligned(4 * NR_LANES)));
+extern uint32_t buf[] __attribute__((aligned(4 * NR_LANES)));
+extern uint32_t gold[] __attribute__((aligned(4 * NR_LANES)));
+
+typedef void (*sort_t)(uint32_t *keys, uint32_t *buf, uint64_t n);
+
+// Sort a copy of the keys, and compare it with the sorted ones
+static int run(const char *name, sort_t sort) {
+  memcpy(work, keys, n * sizeof(uint32_t));
+
+  start_timer();
+  sort(work, buf, n);
+  stop_timer();
+
+  int64_t runtime = get_timer();
+  printf("%s: %d cycles, %f cycles/key.\n", name, runtime,
+         (float)runtime / n);
+
+  int64_t idx = vcheck_i32((int32_t *)work, (int32_t *)gold, n);
+  if (idx >= 0) {
+    printf("%s: Error at index %d. %u != %u\n", name, idx, work[idx],
+           gold[idx]);
+    return 1;
+  }
+  printf("%s: Check okay. No errors.\n", name);
+  return 0;
+}
+
+int main() {
+  printf("\n");
+  printf("==========\n");
+  printf("=  SORT  =\n");
+  printf("==========\n");
+  printf("\n");
+  printf("\n");
+
+  printf("Keys: %lu\n", n);
+
+  int error = 0;
+
+  error |= run("radix_sort_u32_s", radix_sort_u32_s);
+  error |= run("radix_sort_u32", radix_sort_u32);
+  error |= run("merge_sort_u32", merge_sort_u32);
+
+  // The first SORT_BITONIC_MAX keys in the vector registers
+  const uint64_t m = n < SORT_BITONIC_MAX ? n : SORT_BITONIC_MAX;
+  memcpy(work, keys, m * sizeof(uint32_t));
+  start_timer();
+  bitonic_sort_u32(work, m);
+  stop_timer();
+  printf("bitonic_sort_u32: %d cycles for %lu keys.\n", get_timer(), m);
+  for (uint64_t i = 1; i < m; ++i)
+    if (work[i - 1] > work[i]) {
+      printf("bitonic_sort_u32: Error at index %d. %u > %u\n", i, work[i - 1],
+             work[i]);
+      error = 1;
+      break;
+    }
+
+  return error;
+}
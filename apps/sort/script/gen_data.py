@@ -0,0 +1,59 @@
+#!/usr/bin/env python3
+# Copyright 2022 ETH Zurich and University of Bologna.
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+# arg1: number of keys, or "rsort" for the dataset of the rsort benchmark of
+# the riscv-tests (2048 keys)
+
+import numpy as np
+import os
+import re
+import sys
+
+sys.path.insert(0, os.path.join(os.path.dirname(__file__), '../../common/script'))
+from data_emit import emit
+
+# input_data of riscv-tests/benchmarks/rsort/dataset1.h
+def rsort_dataset():
+  path = os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', '..',
+                      'riscv-tests', 'benchmarks', 'rsort', 'dataset1.h')
+  with open(path) as f:
+    src = f.read()
+  body = re.search(r'input_data\[DATA_SIZE\]\s*=\s*\{([^}]*)\}', src).group(1)
+  return np.array([int(x) for x in body.replace(',', ' ').split()], dtype=np.uint32)
+
+############
+## SCRIPT ##
+############
+
+if len(sys.argv) == 2:
+  if sys.argv[1] == 'rsort':
+    keys = rsort_dataset()
+  else:
+    keys = np.random.randint(0, 2**32, size=int(sys.argv[1]), dtype=np.uint64).astype(np.uint32)
+else:
+  print("Error. Give me one argument: the number of keys, or rsort.")
+  sys.exit()
+
+n = len(keys)
+
+# Create the file
+print(".section .data,\"aw\",@progbits")
+emit("n", np.array(n, dtype=np.uint64))
+emit("keys", keys, 'NR_LANES*4')
+emit("work", keys, 'NR_LANES*4')
+emit("buf", np.zeros(n, dtype=np.uint32), 'NR_LANES*4')
+emit("gold", np.sort(keys), 'NR_LANES*4')
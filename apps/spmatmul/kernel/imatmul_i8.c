@@ -0,0 +1 @@
+../../imatmul_i8/kernel/imatmul_i8.c
\ No newline at end of file
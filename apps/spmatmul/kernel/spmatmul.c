@@ -0,0 +1,254 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "spmatmul.h"
+
+#define MIN(a, b) ((a) < (b) ? (a) : (b))
+
+// acc += s * (row pos of the tile of registers t0, t1, t2, t3)
+#define SPMATMUL_MACC(insn, cons, acc, s, pos, t0, t1, t2, t3)                \
+  switch (pos) {                                                               \
+  case 0:                                                                      \
+    asm volatile(insn " v" #acc ", %0, v" #t0 ::cons(s));                      \
+    break;                                                                     \
+  case 1:                                                                      \
+    asm volatile(insn " v" #acc ", %0, v" #t1 ::cons(s));                      \
+    break;                                                                     \
+  case 2:                                                                      \
+    asm volatile(insn " v" #acc ", %0, v" #t2 ::cons(s));                      \
+    break;                                                                     \
+  default:                                                                     \
+    asm volatile(insn " v" #acc ", %0, v" #t3 ::cons(s));                      \
+  }
+
+// The 2 non-zeros of row r of the group, on the accumulator acc. Their
+// positions are in the nibble of the index byte at bit sh.
+#define SPMATMUL_ROW(insn, cons, type, r, acc, sh, t0, t1, t2, t3)            \
+  do {                                                                         \
+    const unsigned int pos = idx[(r)*ni] >> (sh);                              \
+    const type s0 = a[(r)*nz];                                                 \
+    const type s1 = a[(r)*nz + 1];                                             \
+    SPMATMUL_MACC(insn, cons, acc, s0, pos & 3, t0, t1, t2, t3);               \
+    SPMATMUL_MACC(insn, cons, acc, s1, (pos >> 2) & 3, t0, t1, t2, t3);        \
+  } while (0)
+
+// The 8 rows of the group, whose tile is in t0, t1, t2, t3
+#define SPMATMUL_GROUP(insn, cons, type, sh, t0, t1, t2, t3)                  \
+  do {                                                                         \
+    SPMATMUL_ROW(insn, cons, type, 0, 0, sh, t0, t1, t2, t3);                  \
+    SPMATMUL_ROW(insn, cons, type, 1, 2, sh, t0, t1, t2, t3);                  \
+    SPMATMUL_ROW(insn, cons, type, 2, 4, sh, t0, t1, t2, t3);                  \
+    SPMATMUL_ROW(insn, cons, type, 3, 6, sh, t0, t1, t2, t3);                  \
+    SPMATMUL_ROW(insn, cons, type, 4, 8, sh, t0, t1, t2, t3);                  \
+    SPMATMUL_ROW(insn, cons, type, 5, 10, sh, t0, t1, t2, t3);                 \
+    SPMATMUL_ROW(insn, cons, type, 6, 12, sh, t0, t1, t2, t3);                 \
+    SPMATMUL_ROW(insn, cons, type, 7, 14, sh, t0, t1, t2, t3);                 \
+  } while (0)
+
+// ---------------
+// FP32
+// ---------------
+
+// 8 rows of C, on LMUL=2 accumulators (v0-v14), with two tiles of 4 rows of B
+// (v16-v22 and v24-v30), so that the next tile loads while the current one is
+// used
+static void spmatmul_f32_vec_8(float *c, const float *a, const uint8_t *idx,
+                               const float *b, const unsigned long int N,
+                               const unsigned long int P) {
+  const unsigned long int nz = N / 2;
+  const unsigned long int ni = N / 8;
+
+  asm volatile("vmv.v.i v0, 0");
+  asm volatile("vmv.v.i v2, 0");
+  asm volatile("vmv.v.i v4, 0");
+  asm volatile("vmv.v.i v6, 0");
+  asm volatile("vmv.v.i v8, 0");
+  asm volatile("vmv.v.i v10, 0");
+  asm volatile("vmv.v.i v12, 0");
+  asm volatile("vmv.v.i v14, 0");
+
+  // Prefetch the tile of the first group
+  asm volatile("vle32.v v16, (%0);" ::"r"(b));
+  b += P;
+  asm volatile("vle32.v v18, (%0);" ::"r"(b));
+  b += P;
+  asm volatile("vle32.v v20, (%0);" ::"r"(b));
+  b += P;
+  asm volatile("vle32.v v22, (%0);" ::"r"(b));
+  b += P;
+
+  // Two groups per index byte
+  for (unsigned long int t = 0; t < ni; ++t) {
+    asm volatile("vle32.v v24, (%0);" ::"r"(b));
+    b += P;
+    asm volatile("vle32.v v26, (%0);" ::"r"(b));
+    b += P;
+    asm volatile("vle32.v v28, (%0);" ::"r"(b));
+    b += P;
+    asm volatile("vle32.v v30, (%0);" ::"r"(b));
+    b += P;
+
+    SPMATMUL_GROUP("vfmacc.vf", "f", float, 0, 16, 18, 20, 22);
+    a += 2;
+
+    if (t + 1 != ni) {
+      asm volatile("vle32.v v16, (%0);" ::"r"(b));
+      b += P;
+      asm volatile("vle32.v v18, (%0);" ::"r"(b));
+      b += P;
+      asm volatile("vle32.v v20, (%0);" ::"r"(b));
+      b += P;
+      asm volatile("vle32.v v22, (%0);" ::"r"(b));
+      b += P;
+    }
+
+    SPMATMUL_GROUP("vfmacc.vf", "f", float, 4, 24, 26, 28, 30);
+    a += 2;
+    idx++;
+  }
+
+  asm volatile("vse32.v v0, (%0);" ::"r"(c));
+  c += P;
+  asm volatile("vse32.v v2, (%0);" ::"r"(c));
+  c += P;
+  asm volatile("vse32.v v4, (%0);" ::"r"(c));
+  c += P;
+  asm volatile("vse32.v v6, (%0);" ::"r"(c));
+  c += P;
+  asm volatile("vse32.v v8, (%0);" ::"r"(c));
+  c += P;
+  asm volatile("vse32.v v10, (%0);" ::"r"(c));
+  c += P;
+  asm volatile("vse32.v v12, (%0);" ::"r"(c));
+  c += P;
+  asm volatile("vse32.v v14, (%0);" ::"r"(c));
+}
+
+void spmatmul_f32(float *c, const float *a_val, const uint8_t *a_idx,
+                  const float *b, const unsigned long int M,
+                  const unsigned long int N, const unsigned long int P) {
+  unsigned long int block_size_p;
+
+  // Set the vector configuration
+  asm volatile("vsetvli %0, %1, e32, m2, ta, ma" : "=r"(block_size_p) : "r"(P));
+
+  // Slice the matrix into a manageable number of columns p_
+  for (unsigned long int p = 0; p < P; p += block_size_p) {
+    // Set the vector length
+    const unsigned long int p_ = MIN(P - p, block_size_p);
+    asm volatile("vsetvli zero, %0, e32, m2, ta, ma" ::"r"(p_));
+
+    // Iterate over the rows
+    for (unsigned long int m = 0; m < M; m += 8)
+      spmatmul_f32_vec_8(c + m * P + p, a_val + m * N / 2, a_idx + m * N / 8,
+                         b + p, N, P);
+  }
+}
+
+// ---------------
+// int8_t
+// ---------------
+
+// Load one row of B, and sign-extend it to 16 bits
+#define SPMATMUL_I8_LOAD(vd, vtmp)                                             \
+  do {                                                                         \
+    asm volatile("vle8.v v" #vtmp ", (%0);" ::"r"(b));                         \
+    asm volatile("vsext.vf2 v" #vd ", v" #vtmp);                               \
+    b += P;                                                                    \
+  } while (0)
+
+// 8 rows of C, as the FP32 kernel, with e16 operands (LMUL=1) and e32
+// accumulators (LMUL=2). The tiles are in v16-v19 and v20-v23.
+static void spmatmul_i8_vec_8(int32_t *c, const int8_t *a, const uint8_t *idx,
+                              const int8_t *b, const unsigned long int N,
+                              const unsigned long int P) {
+  const unsigned long int nz = N / 2;
+  const unsigned long int ni = N / 8;
+
+  // The accumulators are twice as wide as the operands
+  asm volatile("vsetvli zero, zero, e32, m2, ta, ma");
+  asm volatile("vmv.v.i v0, 0");
+  asm volatile("vmv.v.i v2, 0");
+  asm volatile("vmv.v.i v4, 0");
+  asm volatile("vmv.v.i v6, 0");
+  asm volatile("vmv.v.i v8, 0");
+  asm volatile("vmv.v.i v10, 0");
+  asm volatile("vmv.v.i v12, 0");
+  asm volatile("vmv.v.i v14, 0");
+  asm volatile("vsetvli zero, zero, e16, m1, ta, ma");
+
+  SPMATMUL_I8_LOAD(16, 24);
+  SPMATMUL_I8_LOAD(17, 25);
+  SPMATMUL_I8_LOAD(18, 26);
+  SPMATMUL_I8_LOAD(19, 27);
+
+  for (unsigned long int t = 0; t < ni; ++t) {
+    SPMATMUL_I8_LOAD(20, 24);
+    SPMATMUL_I8_LOAD(21, 25);
+    SPMATMUL_I8_LOAD(22, 26);
+    SPMATMUL_I8_LOAD(23, 27);
+
+    SPMATMUL_GROUP("vwmacc.vx", "r", int64_t, 0, 16, 17, 18, 19);
+    a += 2;
+
+    if (t + 1 != ni) {
+      SPMATMUL_I8_LOAD(16, 24);
+      SPMATMUL_I8_LOAD(17, 25);
+      SPMATMUL_I8_LOAD(18, 26);
+      SPMATMUL_I8_LOAD(19, 27);
+    }
+
+    SPMATMUL_GROUP("vwmacc.vx", "r", int64_t, 4, 20, 21, 22, 23);
+    a += 2;
+    idx++;
+  }
+
+  asm volatile("vsetvli zero, zero, e32, m2, ta, ma");
+  asm volatile("vse32.v v0, (%0);" ::"r"(c));
+  c += P;
+  asm volatile("vse32.v v2, (%0);" ::"r"(c));
+  c += P;
+  asm volatile("vse32.v v4, (%0);" ::"r"(c));
+  c += P;
+  asm volatile("vse32.v v6, (%0);" ::"r"(c));
+  c += P;
+  asm volatile("vse32.v v8, (%0);" ::"r"(c));
+  c += P;
+  asm volatile("vse32.v v10, (%0);" ::"r"(c));
+  c += P;
+  asm volatile("vse32.v v12, (%0);" ::"r"(c));
+  c += P;
+  asm volatile("vse32.v v14, (%0);" ::"r"(c));
+  asm volatile("vsetvli zero, zero, e16, m1, ta, ma");
+}
+
+void spmatmul_i8(int32_t *c, const int8_t *a_val, const uint8_t *a_idx,
+                 const int8_t *b, const unsigned long int M,
+                 const unsigned long int N, const unsigned long int P) {
+  unsigned long int block_size_p;
+
+  // The products are accumulated at twice the SEW of B
+  asm volatile("vsetvli %0, %1, e16, m1, ta, ma" : "=r"(block_size_p) : "r"(P));
+
+  for (unsigned long int p = 0; p < P; p += block_size_p) {
+    const unsigned long int p_ = MIN(P - p, block_size_p);
+    asm volatile("vsetvli zero, %0, e16, m1, ta, ma" ::"r"(p_));
+
+    for (unsigned long int m = 0; m < M; m += 8)
+      spmatmul_i8_vec_8(c + m * P + p, a_val + m * N / 2, a_idx + m * N / 8,
+                        b + p, N, P);
+  }
+}
@@ -0,0 +1,46 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// GEMMs with 2:4 structured-sparse weights: C = AB with A=[MxN] sparse,
+// B=[NxP] dense, and C=[MxP], in FP32 (spmatmul_f32) and in int8_t with
+// int32_t results (spmatmul_i8). Each group of 4 consecutive elements of a row
+// of A has at most 2 non-zeros, and A is stored compressed:
+//  - a_val=[MxN/2]: the 2 values of each group, in the order of their
+//    columns (zero if the group has fewer non-zeros)
+//  - a_idx=[MxN/8]: the 2-bit columns of the values in their group. Byte t of
+//    a row holds group 2t in bits [3:0] and group 2t+1 in bits [7:4], the
+//    first value in the lower two bits of the nibble.
+// M and N are multiples of 8.
+//
+// The kernels run on 8 rows of C, and on strips of its columns. The 4 rows of
+// B of a group are a tile of 4 vector registers, which is loaded once and
+// shared by the 8 rows: each non-zero is one vfmacc.vf (vwmacc.vx) on the row
+// of the tile that its index selects, so that the 2 zeros of a group cost no
+// MAC.
+
+#ifndef _SPMATMUL_H_
+#define _SPMATMUL_H_
+
+#include <stdint.h>
+
+void spmatmul_f32(float *c, const float *a_val, const uint8_t *a_idx,
+                  const float *b, unsigned long int m, unsigned long int n,
+                  unsigned long int p);
+void spmatmul_i8(int32_t *c, const int8_t *a_val, const uint8_t *a_idx,
+                 const int8_t *b, unsigned long int m, unsigned long int n,
+                 unsigned long int p);
+
+#endif
@@ -0,0 +1,113 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdint.h>
+#include <string.h>
+
+#include "kernel/fmatmul_f32.h"
+#include "kernel/imatmul_i8.h"
+#include "kernel/spmatmul.h"
+#include "runtime.h"
+#include "util.h"
+#include "vcheck.h"
+
+#ifndef SPIKE
+#include "printf.h"
+#else
+#include <stdio.h>
+#endif
+
+#define THRESHOLD 0.0001
+
+// A is 2:4 sparse, dense in a_f32 and a_i8, and compressed in a_val_f32,
+// a_val_i8, and a_idx. The FP32 inputs are small integers, so that the sums
+// are exact.
+extern uint64_t M;
+extern uint64_t N;
+extern uint64_t P;
+extern uint8_t a_idx[] __attribute__((aligned(4 * NR_LANES)));
+extern float a_f32[] __attribute__((aligned(4 * NR_LANES)));
+extern float a_val_f32[] __attribute__((aligned(4 * NR_LANES)));
+extern float b_f32[] __attribute__((aligned(4 * NR_LANES)));
+extern float c_f32[] __attribute__((aligned(4 * NR_LANES)));
+extern float gold_c_f32[] __attribute__((aligned(4 * NR_LANES)));
+extern int8_t a_i8[] __attribute__((aligned(4 * NR_LANES)));
+extern int8_t a_val_i8[] __attribute__((aligned(4 * NR_LANES)));
+extern int8_t b_i8[] __attribute__((aligned(4 * NR_LANES)));
+extern int32_t c_i32[] __attribute__((aligned(4 * NR_LANES)));
+extern int32_t gold_c_i32[] __attribute__((aligned(4 * NR_LANES)));
+
+// The performance is in the operations of the dense GEMM, so that the sparse
+// and the dense kernels compare
+static int64_t report(const char *name) {
+  int64_t runtime = get_timer();
+  float performance = (float)(2 * M * N * P) / runtime;
+  printf("%s: %d cycles, %f OP/cycle.\n", name, runtime, performance);
+  return runtime;
+}
+
+static void speedup(const char *name, int64_t sparse, int64_t dense) {
+  printf("%s: %f speedup over the dense kernel.\n", name,
+         (float)dense / sparse);
+}
+
+int main() {
+  printf("\n");
+  printf("==============\n");
+  printf("=  SPMATMUL  =\n");
+  printf("==============\n");
+  printf("\n");
+  printf("\n");
+
+  printf("2:4 sparse %lu x %lu by %lu x %lu\n", M, N, N, P);
+
+  int error = 0;
+  int64_t sparse, dense;
+
+  // FP32
+  start_timer();
+  fmatmul_f32(c_f32, a_f32, b_f32, M, N, P);
+  stop_timer();
+  dense = report("fmatmul_f32");
+  error |= vcheck_report("fmatmul_f32",
+                         vcheck_f32(c_f32, gold_c_f32, M * P, THRESHOLD));
+
+  memset(c_f32, 0, M * P * sizeof(float));
+  start_timer();
+  spmatmul_f32(c_f32, a_val_f32, a_idx, b_f32, M, N, P);
+  stop_timer();
+  sparse = report("spmatmul_f32");
+  error |= vcheck_report("spmatmul_f32",
+                         vcheck_f32(c_f32, gold_c_f32, M * P, THRESHOLD));
+  speedup("spmatmul_f32", sparse, dense);
+
+  // INT8
+  start_timer();
+  imatmul_i8(c_i32, a_i8, b_i8, M, N, P);
+  stop_timer();
+  dense = report("imatmul_i8");
+  error |= vcheck_report("imatmul_i8", vcheck_i32(c_i32, gold_c_i32, M * P));
+
+  memset(c_i32, 0, M * P * sizeof(int32_t));
+  start_timer();
+  spmatmul_i8(c_i32, a_val_i8, a_idx, b_i8, M, N, P);
+  stop_timer();
+  sparse = report("spmatmul_i8");
+  error |= vcheck_report("spmatmul_i8", vcheck_i32(c_i32, gold_c_i32, M * P));
+  speedup("spmatmul_i8", sparse, dense);
+
+  return error;
+}
@@ -0,0 +1,94 @@
+#!/usr/bin/env python3
+# Copyright 2022 ETH Zurich and University of Bologna.
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+# arg1, arg2, arg3: M, N, P, with M and N multiples of 8
+# A=[MxN] is 2:4 sparse, and stored dense for the dense path, and compressed
+# for spmatmul_f32() and spmatmul_i8() (see kernel/spmatmul.h)
+
+import numpy as np
+import os
+import sys
+
+sys.path.insert(0, os.path.join(os.path.dirname(__file__), '../../common/script'))
+from data_emit import emit
+
+# 2 random columns in each group of 4 of the rows, in ascending order
+def pattern(m, n):
+  pos = np.sort(np.array([np.random.choice(4, 2, replace=False)
+                          for _ in range(m * n // 4)]), axis=1)
+  return pos.reshape(m, n // 4, 2)
+
+# The dense matrix of the values at the positions
+def expand(val, pos):
+  m, groups = pos.shape[0], pos.shape[1]
+  dense = np.zeros((m, groups, 4), dtype=val.dtype)
+  np.put_along_axis(dense, pos, val.reshape(m, groups, 2), axis=2)
+  return dense.reshape(m, 4 * groups)
+
+# Two groups per byte, the first value in the lower two bits of each nibble
+def pack(pos):
+  nib = pos[:, :, 0] | (pos[:, :, 1] << 2)
+  return (nib[:, 0::2] | (nib[:, 1::2] << 4)).astype(np.uint8)
+
+############
+## SCRIPT ##
+############
+
+if len(sys.argv) == 4:
+  M = int(sys.argv[1])
+  N = int(sys.argv[2])
+  P = int(sys.argv[3])
+else:
+  print("Error. Give me three arguments: M, N, and P.")
+  sys.exit()
+
+if M % 8 or N % 8:
+  print("Error. M and N must be multiples of 8.")
+  sys.exit()
+
+pos   = pattern(M, N)
+a_idx = pack(pos)
+
+# Small non-zero integers, so that the FP32 sums are exact in any order
+vals      = np.array([-3, -2, -1, 1, 2, 3], dtype=np.float32)
+a_val_f32 = np.random.choice(vals, (M, N // 2))
+a_f32     = expand(a_val_f32, pos)
+b_f32     = np.random.choice(vals, (N, P))
+gold_f32  = a_f32 @ b_f32
+
+a_val_i8 = np.random.randint(-128, 128, (M, N // 2)).astype(np.int8)
+a_val_i8[a_val_i8 == 0] = 1
+a_i8     = expand(a_val_i8, pos)
+b_i8     = np.random.randint(-128, 128, (N, P)).astype(np.int8)
+gold_i8  = (a_i8.astype(np.int32) @ b_i8.astype(np.int32)).astype(np.int32)
+
+# Create the file
+print(".section .data,\"aw\",@progbits")
+emit("M", np.array(M, dtype=np.uint64))
+emit("N", np.array(N, dtype=np.uint64))
+emit("P", np.array(P, dtype=np.uint64))
+emit("a_idx", a_idx, 'NR_LANES*4')
+emit("a_f32", a_f32, 'NR_LANES*4')
+emit("a_val_f32", a_val_f32, 'NR_LANES*4')
+emit("b_f32", b_f32, 'NR_LANES*4')
+emit("c_f32", np.zeros((M, P), dtype=np.float32), 'NR_LANES*4')
+emit("gold_c_f32", gold_f32.astype(np.float32), 'NR_LANES*4')
+emit("a_i8", a_i8, 'NR_LANES*4')
+emit("a_val_i8", a_val_i8, 'NR_LANES*4')
+emit("b_i8", b_i8, 'NR_LANES*4')
+emit("c_i32", np.zeros((M, P), dtype=np.int32), 'NR_LANES*4')
+emit("gold_c_i32", gold_i8, 'NR_LANES*4')
@@ -0,0 +1,107 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "spmv.h"
+
+void spmv_csr_s(uint64_t rows, const uint32_t *row_ptr,
+                const uint32_t *col_idx, const double *val, const double *x,
+                double *y) {
+  for (uint64_t i = 0; i < rows; ++i) {
+    double sum = 0;
+    for (uint32_t k = row_ptr[i]; k < row_ptr[i + 1]; ++k)
+      sum += val[k] * x[col_idx[k]];
+    y[i] = sum;
+  }
+}
+
+// One row at a time: the non-zeros are multiplied by the gathered x, and
+// accumulated in a vector that is reduced once per row. Efficient on long
+// rows only: the reduction does not depend on the row length.
+void spmv_csr_v(uint64_t rows, const uint32_t *row_ptr,
+                const uint32_t *col_idx, const double *val, const double *x,
+                double *y) {
+  size_t vl, vl_row;
+
+  vfloat64m4_t acc, val_vec, x_vec;
+  vuint32m2_t off;
+  vfloat64m1_t red, zero;
+
+  zero = vfmv_v_f_f64m1(0, 1);
+
+  for (uint64_t i = 0; i < rows; ++i) {
+    const uint32_t first = row_ptr[i];
+    const uint32_t nnz = row_ptr[i + 1] - first;
+
+    if (nnz == 0) {
+      y[i] = 0;
+      continue;
+    }
+
+    // The first strip is the longest one. The tails of the next ones leave
+    // the accumulator undisturbed.
+    vl_row = vsetvl_e64m4(nnz);
+    for (uint32_t k = 0; k < nnz; k += vl) {
+      vl = vsetvl_e64m4(nnz - k);
+      // Byte offsets of the elements of x
+      off = vsll_vx_u32m2(vle32_v_u32m2(&col_idx[first + k], vl), 3, vl);
+      x_vec = vluxei32_v_f64m4(x, off, vl);
+      val_vec = vle64_v_f64m4(&val[first + k], vl);
+      if (k == 0)
+        acc = vfmul_vv_f64m4(val_vec, x_vec, vl);
+      else
+        acc = vfmacc_vv_f64m4(acc, val_vec, x_vec, vl);
+    }
+
+    // Reduce, and store straight from the vector register
+    red = vfredusum_vs_f64m4_f64m1(red, acc, zero, vl_row);
+    vse64_v_f64m1(&y[i], red, 1);
+  }
+}
+
+// c rows at a time, one per element: each column of the slice is a
+// unit-stride load of the non-zeros and a gather of x, with no reduction. The
+// results are scattered to the rows of A through perm.
+void spmv_sell_v(uint64_t rows, uint64_t c, const uint32_t *slice_ptr,
+                 const uint32_t *slice_width, const uint32_t *col_idx,
+                 const double *val, const uint32_t *perm, const double *x,
+                 double *y) {
+  size_t vl;
+
+  vfloat64m4_t acc, val_vec, x_vec;
+  vuint32m2_t off;
+
+  for (uint64_t s = 0, r0 = 0; r0 < rows; ++s, r0 += c) {
+    const uint64_t height = (rows - r0 < c) ? rows - r0 : c;
+    const uint32_t *slice_col = &col_idx[slice_ptr[s]];
+    const double *slice_val = &val[slice_ptr[s]];
+
+    // Slices taller than VLMAX are split
+    for (uint64_t r = 0; r < height; r += vl) {
+      vl = vsetvl_e64m4(height - r);
+
+      acc = vfmv_v_f_f64m4(0, vl);
+      for (uint32_t j = 0; j < slice_width[s]; ++j) {
+        off = vsll_vx_u32m2(vle32_v_u32m2(&slice_col[j * c + r], vl), 3, vl);
+        x_vec = vluxei32_v_f64m4(x, off, vl);
+        val_vec = vle64_v_f64m4(&slice_val[j * c + r], vl);
+        acc = vfmacc_vv_f64m4(acc, val_vec, x_vec, vl);
+      }
+
+      off = vsll_vx_u32m2(vle32_v_u32m2(&perm[r0 + r], vl), 3, vl);
+      vsuxei32_v_f64m4(y, off, acc, vl);
+    }
+  }
+}
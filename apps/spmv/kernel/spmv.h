@@ -0,0 +1,46 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Sparse matrix-vector multiplication, y = A x, with A in the CSR or in the
+// SELL-C-sigma format, in FP64.
+
+#ifndef _SPMV_H_
+#define _SPMV_H_
+
+#include <stdint.h>
+
+#include "riscv_vector.h"
+
+// CSR: the non-zeros of row i are val[row_ptr[i]] to val[row_ptr[i + 1] - 1],
+// in the columns col_idx[row_ptr[i]] to col_idx[row_ptr[i + 1] - 1]
+void spmv_csr_s(uint64_t rows, const uint32_t *row_ptr,
+                const uint32_t *col_idx, const double *val, const double *x,
+                double *y);
+void spmv_csr_v(uint64_t rows, const uint32_t *row_ptr,
+                const uint32_t *col_idx, const double *val, const double *x,
+                double *y);
+
+// SELL-C-sigma: the rows, sorted by length within windows of sigma rows, are
+// grouped in slices of c rows. Slice s is slice_width[s] non-zeros wide and
+// stored column-major from slice_ptr[s], i.e., the j-th non-zero of its row r
+// is val[slice_ptr[s] + j * c + r], in column col_idx[slice_ptr[s] + j * c + r].
+// The shorter rows are padded with zeros. perm[s * c + r] is the row of A.
+void spmv_sell_v(uint64_t rows, uint64_t c, const uint32_t *slice_ptr,
+                 const uint32_t *slice_width, const uint32_t *col_idx,
+                 const double *val, const uint32_t *perm, const double *x,
+                 double *y);
+
+#endif
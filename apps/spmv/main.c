@@ -0,0 +1,101 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdio.h>
+#include <string.h>
+
+#include "kernel/spmv.h"
+#include "runtime.h"
+#include "util.h"
+
+#ifndef SPIKE
+#include "printf.h"
+#endif
+
+// Threshold for FP numbers comparison during the final check
+#define THRESHOLD 0.000001
+
+extern uint64_t R;
+extern uint64_t C;
+extern uint64_t NNZ;
+extern uint64_t SELL_C;
+
+// CSR
+extern uint32_t row_ptr[] __attribute__((aligned(4 * NR_LANES), section(".l2")));
+extern uint32_t col_idx[] __attribute__((aligned(4 * NR_LANES), section(".l2")));
+extern double val[] __attribute__((aligned(4 * NR_LANES), section(".l2")));
+// SELL-C-sigma
+extern uint32_t slice_ptr[] __attribute__((aligned(4 * NR_LANES), section(".l2")));
+extern uint32_t slice_width[] __attribute__((aligned(4 * NR_LANES), section(".l2")));
+extern uint32_t sell_col[] __attribute__((aligned(4 * NR_LANES), section(".l2")));
+extern double sell_val[] __attribute__((aligned(4 * NR_LANES), section(".l2")));
+extern uint32_t perm[] __attribute__((aligned(4 * NR_LANES), section(".l2")));
+
+extern double x[] __attribute__((aligned(4 * NR_LANES), section(".l2")));
+extern double y_s[] __attribute__((aligned(4 * NR_LANES), section(".l2")));
+extern double y_csr[] __attribute__((aligned(4 * NR_LANES), section(".l2")));
+extern double y_sell[] __attribute__((aligned(4 * NR_LANES), section(".l2")));
+
+static int check(const char *name, const double *y, int64_t runtime) {
+  float performance = 2.0 * NNZ / runtime;
+  printf("%s: %d cycles, %f DPFLOP/cycle (%f%% utilization).\n", name,
+         runtime, performance, 100.0 * performance / (2 * NR_LANES));
+
+  for (uint64_t i = 0; i < R; ++i)
+    if (!similarity_check(y_s[i], y[i], THRESHOLD)) {
+      printf("Error: %s, y[%d] = %f != %f\n", name, i, y[i], y_s[i]);
+      return 1;
+    }
+
+  return 0;
+}
+
+int main() {
+  printf("\n");
+  printf("==========\n");
+  printf("=  SPMV  =\n");
+  printf("==========\n");
+  printf("\n");
+  printf("\n");
+
+  int error = 0;
+  int64_t runtime;
+
+  printf("Matrix of %d x %d elements, with %d non-zeros.\n", R, C, NNZ);
+
+  start_timer();
+  spmv_csr_s(R, row_ptr, col_idx, val, x, y_s);
+  stop_timer();
+  printf("Scalar CSR: %d cycles.\n", get_timer());
+
+  start_timer();
+  spmv_csr_v(R, row_ptr, col_idx, val, x, y_csr);
+  stop_timer();
+  runtime = get_timer();
+  error |= check("Vector CSR", y_csr, runtime);
+
+  start_timer();
+  spmv_sell_v(R, SELL_C, slice_ptr, slice_width, sell_col, sell_val, perm, x,
+              y_sell);
+  stop_timer();
+  runtime = get_timer();
+  error |= check("Vector SELL-C-sigma", y_sell, runtime);
+
+  if (!error)
+    printf("Passed.\n");
+
+  return error;
+}
@@ -0,0 +1,136 @@
+#!/usr/bin/env python3
+# Copyright 2022 ETH Zurich and University of Bologna.
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+# arg1: rows, arg2: columns, arg3: non-zeros per row (on average),
+# arg4: sparsity pattern (uniform, banded, powerlaw),
+# arg5, arg6 (optional): C and sigma of the SELL-C-sigma format
+
+import numpy as np
+import os
+import sys
+
+sys.path.insert(0, os.path.join(os.path.dirname(__file__), '../../common/script'))
+from data_emit import emit
+
+# Number of non-zeros of each row, rows * k in total
+def row_lengths(rows, cols, k, pattern):
+  if pattern != 'powerlaw':
+    return [min(k, cols)] * rows
+  # Zipf-like lengths, in random order. The excess of the rows longer than
+  # cols is moved to the shortest ones.
+  w = 1 / np.arange(1, rows + 1)
+  lengths = [int(l) for l in np.floor(w * rows * k / w.sum())]
+  lengths[-1] += rows * k - sum(lengths)
+  lengths = [min(l, cols) for l in lengths]
+  deficit = min(rows * k, rows * cols) - sum(lengths)
+  i = rows - 1
+  while deficit > 0:
+    add = min(deficit, cols - lengths[i])
+    lengths[i] += add
+    deficit -= add
+    i -= 1
+  np.random.shuffle(lengths)
+  return lengths
+
+# Sorted columns of the non-zeros of row i
+def row_columns(i, rows, cols, length, pattern):
+  if pattern == 'banded':
+    # Centered on the diagonal, within the matrix
+    first = min(max(i * cols // rows - length // 2, 0), cols - length)
+    return list(range(first, first + length))
+  return sorted(np.random.choice(cols, length, replace=False).tolist())
+
+# CSR to SELL-C-sigma
+def csr_to_sell(rows, row_ptr, col_idx, val, c, sigma):
+  lengths = [row_ptr[i + 1] - row_ptr[i] for i in range(rows)]
+  # Sort the rows by decreasing length within each window of sigma rows
+  perm = []
+  for w in range(0, rows, sigma):
+    window = list(range(w, min(w + sigma, rows)))
+    perm += sorted(window, key=lambda i: -lengths[i])
+  slice_ptr, slice_width, sell_col, sell_val = [], [], [], []
+  for s in range(0, rows, c):
+    slice_rows = perm[s:s + c]
+    width = max(lengths[i] for i in slice_rows)
+    slice_ptr.append(len(sell_col))
+    slice_width.append(width)
+    # Column-major, c rows per column, with zero padding
+    for j in range(width):
+      for r in range(c):
+        if r < len(slice_rows) and j < lengths[slice_rows[r]]:
+          k = row_ptr[slice_rows[r]] + j
+          sell_col.append(col_idx[k])
+          sell_val.append(val[k])
+        else:
+          sell_col.append(0)
+          sell_val.append(0)
+  return perm, slice_ptr, slice_width, sell_col, sell_val
+
+############
+## SCRIPT ##
+############
+
+if len(sys.argv) == 5 or len(sys.argv) == 7:
+  R       = int(sys.argv[1])
+  C       = int(sys.argv[2])
+  K       = int(sys.argv[3])
+  pattern = sys.argv[4]
+else:
+  print("Error. Give me four or six arguments: the rows, columns, and non-zeros per row of the matrix, its sparsity pattern (uniform, banded, powerlaw), and optionally the C and sigma of SELL-C-sigma.")
+  sys.exit()
+
+if pattern not in ['uniform', 'banded', 'powerlaw']:
+  print("Error. Unknown sparsity pattern %s." % pattern)
+  sys.exit()
+
+SELL_C     = int(sys.argv[5]) if len(sys.argv) == 7 else 32
+SELL_SIGMA = int(sys.argv[6]) if len(sys.argv) == 7 else 256
+
+# CSR matrix
+row_ptr = [0]
+col_idx = []
+for i, length in enumerate(row_lengths(R, C, K, pattern)):
+  col_idx += row_columns(i, R, C, length, pattern)
+  row_ptr.append(len(col_idx))
+val = np.random.rand(len(col_idx)).tolist()
+
+perm, slice_ptr, slice_width, sell_col, sell_val = csr_to_sell(R, row_ptr, col_idx, val, SELL_C, SELL_SIGMA)
+
+# Dense vector, and the outputs
+x      = np.random.rand(C).astype(np.float64)
+y_s    = np.zeros(R, dtype=np.float64)
+y_csr  = np.zeros(R, dtype=np.float64)
+y_sell = np.zeros(R, dtype=np.float64)
+
+# Create the file
+print(".section .data,\"aw\",@progbits")
+emit("R", np.array(R, dtype=np.uint64))
+emit("C", np.array(C, dtype=np.uint64))
+emit("NNZ", np.array(len(col_idx), dtype=np.uint64))
+emit("SELL_C", np.array(SELL_C, dtype=np.uint64))
+emit("row_ptr", np.array(row_ptr, dtype=np.uint32), 'NR_LANES*4')
+emit("col_idx", np.array(col_idx, dtype=np.uint32), 'NR_LANES*4')
+emit("val", np.array(val, dtype=np.float64), 'NR_LANES*4')
+emit("slice_ptr", np.array(slice_ptr, dtype=np.uint32), 'NR_LANES*4')
+emit("slice_width", np.array(slice_width, dtype=np.uint32), 'NR_LANES*4')
+emit("sell_col", np.array(sell_col, dtype=np.uint32), 'NR_LANES*4')
+emit("sell_val", np.array(sell_val, dtype=np.float64), 'NR_LANES*4')
+emit("perm", np.array(perm, dtype=np.uint32), 'NR_LANES*4')
+emit("x", x, 'NR_LANES*4')
+emit("y_s", y_s, 'NR_LANES*4')
+emit("y_csr", y_csr, 'NR_LANES*4')
+emit("y_sell", y_sell, 'NR_LANES*4')
@@ -0,0 +1,111 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "stencil.h"
+
+// Input rows of an output row: at most (2 * STENCIL_MAX_RADIUS + 1)^2
+#define STENCIL_MAX_ROWS                                                       \
+  ((2 * STENCIL_MAX_RADIUS + 1) * (2 * STENCIL_MAX_RADIUS + 1))
+
+// Output row out[radius, c - radius), from its nrows input rows: in[t][j + dj]
+// is weighted by w[t * n + dj + radius]
+typedef void (*stencil_row_t)(const double **in, const double *w,
+                              uint64_t nrows, uint64_t radius, uint64_t c,
+                              double *out);
+
+static void stencil_row_s(const double **in, const double *w, uint64_t nrows,
+                          uint64_t radius, uint64_t c, double *out) {
+  const uint64_t n = 2 * radius + 1;
+
+  for (uint64_t j = radius; j < c - radius; ++j) {
+    double acc = 0;
+    for (uint64_t t = 0; t < nrows; ++t)
+      for (uint64_t dj = 0; dj < n; ++dj)
+        acc += w[t * n + dj] * in[t][j + dj - radius];
+    out[j] = acc;
+  }
+}
+
+// Each strip is loaded once with its halo of radius elements per side, and
+// the neighbours dj are slides of it by dj elements, so that no scalar reloads
+// the elements at the edges of the strip
+static void stencil_row_v(const double **in, const double *w, uint64_t nrows,
+                          uint64_t radius, uint64_t c, double *out) {
+  const uint64_t n = 2 * radius + 1;
+  const size_t vlmax = vsetvlmax_e64m4();
+
+  // Rows with at least a non-zero weight
+  uint64_t used = 0;
+  for (uint64_t t = 0; t < nrows; ++t)
+    for (uint64_t dj = 0; dj < n; ++dj)
+      if (w[t * n + dj] != 0)
+        used |= (uint64_t)1 << t;
+
+  size_t gvl;
+  for (uint64_t j = radius; j < c - radius; j += gvl) {
+    gvl = vsetvl_e64m4(c - radius - j < vlmax - 2 * radius
+                           ? c - radius - j
+                           : vlmax - 2 * radius);
+
+    vfloat64m4_t acc = vfmv_v_f_f64m4(0, gvl);
+    for (uint64_t t = 0; t < nrows; ++t) {
+      if (!(used & ((uint64_t)1 << t)))
+        continue;
+
+      vfloat64m4_t x = vle64_v_f64m4(&in[t][j - radius], gvl + 2 * radius);
+      for (uint64_t dj = 0; dj < n; ++dj) {
+        double wt = w[t * n + dj];
+        if (wt == 0)
+          continue;
+        vfloat64m4_t xs = dj ? vslidedown_vx_f64m4(x, x, dj, gvl) : x;
+        acc = vfmacc_vf_f64m4(acc, wt, xs, gvl);
+      }
+    }
+
+    vse64_v_f64m4(&out[j], acc, gvl);
+  }
+}
+
+static void stencil(uint64_t d, uint64_t r, uint64_t c, const double *in,
+                    double *out, const stencil_t *st, stencil_row_t row) {
+  const uint64_t radius = st->radius;
+  const uint64_t n = 2 * radius + 1;
+  // Planes of the stencil, and their radius
+  const uint64_t nk = (st->dims == 3) ? n : 1;
+  const uint64_t rk = (st->dims == 3) ? radius : 0;
+  const double *rows[STENCIL_MAX_ROWS];
+
+  if (radius > STENCIL_MAX_RADIUS || d < nk || r < n || c < n)
+    return;
+
+  for (uint64_t k = rk; k < d - rk; ++k)
+    for (uint64_t i = radius; i < r - radius; ++i) {
+      for (uint64_t dk = 0; dk < nk; ++dk)
+        for (uint64_t di = 0; di < n; ++di)
+          rows[dk * n + di] = &in[((k + dk - rk) * r + i + di - radius) * c];
+      row(rows, st->w, nk * n, radius, c, &out[(k * r + i) * c]);
+    }
+}
+
+void stencil_s(uint64_t d, uint64_t r, uint64_t c, const double *in,
+               double *out, const stencil_t *st) {
+  stencil(d, r, c, in, out, st, stencil_row_s);
+}
+
+void stencil_v(uint64_t d, uint64_t r, uint64_t c, const double *in,
+               double *out, const stencil_t *st) {
+  stencil(d, r, c, in, out, st, stencil_row_v);
+}
@@ -0,0 +1,53 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _STENCIL_H_
+#define _STENCIL_H_
+
+#include <stdint.h>
+
+#include <riscv_vector.h>
+
+#include "runtime.h"
+
+#ifndef SPIKE
+#include "printf.h"
+#endif
+
+// Largest radius of a stencil
+#define STENCIL_MAX_RADIUS 3
+
+// Stencil of radius radius over a 2D (dims = 2) or 3D (dims = 3) grid.
+// With n = 2 * radius + 1, the weight of the input point at offset
+// (dk, di, dj) from an output point, each offset in [-radius, radius], is
+//   w[((dk + radius) * n + di + radius) * n + dj + radius]  in 3D, and
+//   w[(di + radius) * n + dj + radius]                       in 2D.
+// The zero weights are skipped.
+typedef struct {
+  uint64_t dims;
+  uint64_t radius;
+  const double *w;
+} stencil_t;
+
+// Apply a stencil to the d x r x c grid in, on the points whose neighbours
+// are all in the grid. A 2D stencil is applied to each of the d planes. The
+// points of out closer than radius to the edges are not written.
+void stencil_s(uint64_t d, uint64_t r, uint64_t c, const double *in,
+               double *out, const stencil_t *st);
+void stencil_v(uint64_t d, uint64_t r, uint64_t c, const double *in,
+               double *out, const stencil_t *st);
+
+#endif
@@ -0,0 +1,136 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdio.h>
+#include <string.h>
+
+#include "kernel/stencil.h"
+#include "runtime.h"
+#include "util.h"
+
+#ifndef SPIKE
+#include "printf.h"
+#endif
+
+// Threshold for FP numbers comparison during the final check
+#define THRESHOLD 0.000001
+
+extern uint64_t D;
+extern uint64_t R;
+extern uint64_t C;
+
+extern double I[] __attribute__((aligned(4 * NR_LANES), section(".l2")));
+extern double o_s[] __attribute__((aligned(4 * NR_LANES), section(".l2")));
+extern double o_v[] __attribute__((aligned(4 * NR_LANES), section(".l2")));
+
+// 2D, radius 1: jacobi2d and the explicit heat equation (alpha = 0.1)
+static const double w_jacobi[] = {0, 0.2, 0, 0.2, 0.2, 0.2, 0, 0.2, 0};
+static const double w_heat[] = {0, 0.1, 0, 0.1, 0.6, 0.1, 0, 0.1, 0};
+// 2D, radius 1: 9-point Laplacian
+static const double w_lap9[] = {1.0 / 6, 4.0 / 6,   1.0 / 6, //
+                                4.0 / 6, -20.0 / 6, 4.0 / 6, //
+                                1.0 / 6, 4.0 / 6,   1.0 / 6};
+// 2D, radius 3: 13-point Laplacian, with the sixth-order second derivatives
+static double w_lap13[7 * 7];
+// 3D, radius 1: 7-point and 27-point Laplacians
+static double w_lap7[3 * 3 * 3];
+static double w_lap27[3 * 3 * 3];
+
+static void init_weights() {
+  const double d2[] = {1.0 / 90, -3.0 / 20, 3.0 / 2, -49.0 / 18};
+
+  for (int k = 0; k < 4; ++k) {
+    w_lap13[3 * 7 + k] = w_lap13[3 * 7 + 6 - k] = d2[k];
+    w_lap13[k * 7 + 3] = w_lap13[(6 - k) * 7 + 3] = d2[k];
+  }
+  w_lap13[3 * 7 + 3] = 2 * d2[3];
+
+  // Weights of the 27-point Laplacian by number of non-zero offsets
+  const double w27[] = {-128.0 / 30, 14.0 / 30, 3.0 / 30, 1.0 / 30};
+  for (int dk = 0; dk < 3; ++dk)
+    for (int di = 0; di < 3; ++di)
+      for (int dj = 0; dj < 3; ++dj) {
+        int far = (dk != 1) + (di != 1) + (dj != 1);
+        w_lap7[(dk * 3 + di) * 3 + dj] = (far == 0) ? -6 : (far == 1) ? 1 : 0;
+        w_lap27[(dk * 3 + di) * 3 + dj] = w27[far];
+      }
+}
+
+static int run(const char *name, const stencil_t *st) {
+  const uint64_t n = 2 * st->radius + 1;
+  const uint64_t nk = (st->dims == 3) ? n : 1;
+  const uint64_t size = D * R * C;
+  int taps = 0;
+
+  for (uint64_t t = 0; t < nk * n * n; ++t)
+    taps += st->w[t] != 0;
+
+  memset(o_s, 0, size * sizeof(double));
+  memset(o_v, 0, size * sizeof(double));
+
+  stencil_s(D, R, C, I, o_s, st);
+
+  start_timer();
+  stencil_v(D, R, C, I, o_v, st);
+  stop_timer();
+  int64_t runtime = get_timer();
+
+  uint64_t points = (D - nk + 1) * (R - n + 1) * (C - n + 1);
+  float performance = 2.0 * taps * points / runtime;
+  printf("%s: %d cycles, %f DPFLOP/cycle (%f%% utilization).\n", name,
+         runtime, performance, 100.0 * performance / (2 * NR_LANES));
+
+  for (uint64_t k = 0; k < size; ++k)
+    if (!similarity_check(o_s[k], o_v[k], THRESHOLD)) {
+      printf("Error: %s, o[%d] = %f != %f\n", name, k, o_v[k], o_s[k]);
+      return 1;
+    }
+
+  return 0;
+}
+
+int main() {
+  printf("\n");
+  printf("=============\n");
+  printf("=  STENCIL  =\n");
+  printf("=============\n");
+  printf("\n");
+  printf("\n");
+
+  init_weights();
+
+  const stencil_t jacobi = {2, 1, w_jacobi};
+  const stencil_t heat = {2, 1, w_heat};
+  const stencil_t lap9 = {2, 1, w_lap9};
+  const stencil_t lap13 = {2, 3, w_lap13};
+  const stencil_t lap7 = {3, 1, w_lap7};
+  const stencil_t lap27 = {3, 1, w_lap27};
+
+  printf("Grid of %d x %d x %d points.\n", D, R, C);
+
+  int error = 0;
+  error |= run("2D 5-point jacobi", &jacobi);
+  error |= run("2D 5-point heat", &heat);
+  error |= run("2D 9-point Laplacian", &lap9);
+  error |= run("2D 13-point Laplacian", &lap13);
+  error |= run("3D 7-point Laplacian", &lap7);
+  error |= run("3D 27-point Laplacian", &lap27);
+
+  if (!error)
+    printf("Passed.\n");
+
+  return error;
+}
@@ -0,0 +1,53 @@
+#!/usr/bin/env python3
+# Copyright 2022 ETH Zurich and University of Bologna.
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+# arg1: depth, arg2: rows, arg3: columns
+
+import numpy as np
+import os
+import sys
+
+sys.path.insert(0, os.path.join(os.path.dirname(__file__), '../../common/script'))
+from data_emit import emit
+
+############
+## SCRIPT ##
+############
+
+if len(sys.argv) == 4:
+  D = int(sys.argv[1])
+  R = int(sys.argv[2])
+  C = int(sys.argv[3])
+else:
+  print("Error. Give me three arguments: the depth, rows, and columns of the grid.")
+  sys.exit()
+
+dtype = np.float64
+
+# Input grid, and the scalar and vector outputs
+I   = np.random.rand(D, R, C).astype(dtype)
+o_s = np.zeros([D, R, C], dtype=dtype)
+o_v = np.zeros([D, R, C], dtype=dtype)
+
+# Create the file
+print(".section .data,\"aw\",@progbits")
+emit("D", np.array(D, dtype=np.uint64))
+emit("R", np.array(R, dtype=np.uint64))
+emit("C", np.array(C, dtype=np.uint64))
+emit("I", I, 'NR_LANES*4')
+emit("o_s", o_s, 'NR_LANES*4')
+emit("o_v", o_v, 'NR_LANES*4')
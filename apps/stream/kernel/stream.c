@@ -0,0 +1,117 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "stream.h"
+
+// Sum of the loaded strips: the full strips are accumulated with vadd, and
+// reduced once at the end, while the last partial one is reduced on its own
+#define stream_sum_gen(sew, load)                                              \
+  const size_t vlmax = vsetvl_e##sew##m8(n);                                   \
+  vuint##sew##m8_t acc = vmv_v_x_u##sew##m8(0, vlmax);                         \
+  vuint##sew##m1_t red = vmv_v_x_u##sew##m1(0, 1);                             \
+  size_t vl;                                                                   \
+                                                                               \
+  for (uint64_t i = 0; i < n; i += vl) {                                       \
+    vl = vsetvl_e##sew##m8(n - i);                                             \
+    vuint##sew##m8_t v = load;                                                 \
+    if (vl == vlmax)                                                           \
+      acc = vadd_vv_u##sew##m8(acc, v, vl);                                    \
+    else                                                                       \
+      red = vredsum_vs_u##sew##m8_u##sew##m1(red, v, red, vl);                 \
+  }                                                                            \
+                                                                               \
+  red = vredsum_vs_u##sew##m8_u##sew##m1(red, acc, red, vlmax);                \
+  return vmv_x_s_u##sew##m1_u##sew(red)
+
+#define stream_def_gen(sew)                                                    \
+  void stream_copy_e##sew(void *d, const void *a, uint64_t n) {                \
+    uint##sew##_t *d_ = d;                                                     \
+    const uint##sew##_t *a_ = a;                                               \
+    size_t vl;                                                                 \
+                                                                               \
+    for (uint64_t i = 0; i < n; i += vl) {                                     \
+      vl = vsetvl_e##sew##m8(n - i);                                           \
+      vse##sew##_v_u##sew##m8(d_ + i, vle##sew##_v_u##sew##m8(a_ + i, vl),     \
+                              vl);                                             \
+    }                                                                          \
+  }                                                                            \
+                                                                               \
+  void stream_scale_e##sew(void *d, const void *a, uint##sew##_t s,            \
+                           uint64_t n) {                                       \
+    uint##sew##_t *d_ = d;                                                     \
+    const uint##sew##_t *a_ = a;                                               \
+    size_t vl;                                                                 \
+                                                                               \
+    for (uint64_t i = 0; i < n; i += vl) {                                     \
+      vl = vsetvl_e##sew##m8(n - i);                                           \
+      vuint##sew##m8_t va = vle##sew##_v_u##sew##m8(a_ + i, vl);               \
+      vse##sew##_v_u##sew##m8(d_ + i, vmul_vx_u##sew##m8(va, s, vl), vl);      \
+    }                                                                          \
+  }                                                                            \
+                                                                               \
+  void stream_add_e##sew(void *d, const void *a, const void *b, uint64_t n) {  \
+    uint##sew##_t *d_ = d;                                                     \
+    const uint##sew##_t *a_ = a;                                               \
+    const uint##sew##_t *b_ = b;                                               \
+    size_t vl;                                                                 \
+                                                                               \
+    for (uint64_t i = 0; i < n; i += vl) {                                     \
+      vl = vsetvl_e##sew##m8(n - i);                                           \
+      vuint##sew##m8_t va = vle##sew##_v_u##sew##m8(a_ + i, vl);               \
+      vuint##sew##m8_t vb = vle##sew##_v_u##sew##m8(b_ + i, vl);               \
+      vse##sew##_v_u##sew##m8(d_ + i, vadd_vv_u##sew##m8(va, vb, vl), vl);     \
+    }                                                                          \
+  }                                                                            \
+                                                                               \
+  void stream_triad_e##sew(void *d, const void *a, const void *b,              \
+                           uint##sew##_t s, uint64_t n) {                      \
+    uint##sew##_t *d_ = d;                                                     \
+    const uint##sew##_t *a_ = a;                                               \
+    const uint##sew##_t *b_ = b;                                               \
+    size_t vl;                                                                 \
+                                                                               \
+    for (uint64_t i = 0; i < n; i += vl) {                                     \
+      vl = vsetvl_e##sew##m8(n - i);                                           \
+      vuint##sew##m8_t va = vle##sew##_v_u##sew##m8(a_ + i, vl);               \
+      vuint##sew##m8_t vb = vle##sew##_v_u##sew##m8(b_ + i, vl);               \
+      vse##sew##_v_u##sew##m8(d_ + i, vmacc_vx_u##sew##m8(va, s, vb, vl),      \
+                              vl);                                             \
+    }                                                                          \
+  }                                                                            \
+                                                                               \
+  uint##sew##_t stream_strided_e##sew(const void *src, uint64_t stride,        \
+                                      uint64_t n) {                            \
+    const uint##sew##_t *s = src;                                              \
+    const ptrdiff_t bstride = stride * sizeof(uint##sew##_t);                  \
+    stream_sum_gen(sew,                                                        \
+                   vlse##sew##_v_u##sew##m8(s + i * stride, bstride, vl));     \
+  }
+
+#define stream_gather_def_gen(sew)                                             \
+  uint##sew##_t stream_gather_e##sew(const void *src,                          \
+                                     const uint##sew##_t *off, uint64_t n) {   \
+    const uint##sew##_t *s = src;                                              \
+    stream_sum_gen(sew, vluxei##sew##_v_u##sew##m8(                            \
+                            s, vle##sew##_v_u##sew##m8(off + i, vl), vl));     \
+  }
+
+stream_def_gen(8);
+stream_def_gen(16);
+stream_def_gen(32);
+stream_def_gen(64);
+
+stream_gather_def_gen(32);
+stream_gather_def_gen(64);
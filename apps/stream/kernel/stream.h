@@ -0,0 +1,58 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Memory bandwidth microbenchmarks of the VLSU, on 8, 16, 32, and 64-bit
+// unsigned integers (the bytes moved do not depend on the arithmetic):
+//  - copy, scale, add, triad: the STREAM kernels on n elements, with unit
+//    strides and the results in d, i.e., d = a, d = s a, d = a + b, and
+//    d = a + s b
+//  - strided: n elements loaded with vlse, stride elements apart
+//  - gather: n elements loaded with vluxei, at the byte offsets off of the
+//    same width as the elements
+// The loaded elements of strided and gather are summed, modulo 2^sew, so that
+// they are not dead and can be checked.
+
+#ifndef _STREAM_H_
+#define _STREAM_H_
+
+#include <stdint.h>
+
+#include "riscv_vector.h"
+
+#define stream_dec_gen(sew)                                                    \
+  void stream_copy_e##sew(void *d, const void *a, uint64_t n);                 \
+  void stream_scale_e##sew(void *d, const void *a, uint##sew##_t s,            \
+                           uint64_t n);                                        \
+  void stream_add_e##sew(void *d, const void *a, const void *b, uint64_t n);   \
+  void stream_triad_e##sew(void *d, const void *a, const void *b,              \
+                           uint##sew##_t s, uint64_t n);                       \
+  uint##sew##_t stream_strided_e##sew(const void *src, uint64_t stride,        \
+                                      uint64_t n)
+
+#define stream_gather_dec_gen(sew)                                             \
+  uint##sew##_t stream_gather_e##sew(const void *src,                          \
+                                     const uint##sew##_t *off, uint64_t n)
+
+stream_dec_gen(8);
+stream_dec_gen(16);
+stream_dec_gen(32);
+stream_dec_gen(64);
+
+// The offsets of 8 and 16 bits cannot span a useful footprint
+stream_gather_dec_gen(32);
+stream_gather_dec_gen(64);
+
+#endif
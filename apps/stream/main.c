@@ -0,0 +1,181 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdint.h>
+
+#include "bench.h"
+#include "kernel/stream.h"
+#include "runtime.h"
+#include "util.h"
+#include "vcheck.h"
+
+#ifndef SPIKE
+#include "printf.h"
+#else
+#include <stdio.h>
+#endif
+
+// Strides of the strided loads, 1 to STREAM_MAX_STRIDE elements
+#define STREAM_MAX_STRIDE 64
+#define STREAM_NR_STRIDES 7
+
+// The arrays hold n 64-bit elements, or their first n elements of a smaller
+// width, and src holds STREAM_MAX_STRIDE * m 64-bit elements
+extern uint64_t n;
+extern uint64_t m;
+extern uint64_t s;
+extern uint64_t a[] __attribute__((aligned(4 * NR_LANES)));
+extern uint64_t b[] __attribute__((aligned(4 * NR_LANES)));
+extern uint64_t d[] __attribute__((aligned(4 * NR_LANES)));
+extern uint64_t src[] __attribute__((aligned(4 * NR_LANES)));
+extern uint32_t off_rand_e32[] __attribute__((aligned(4 * NR_LANES)));
+extern uint32_t off_clust_e32[] __attribute__((aligned(4 * NR_LANES)));
+extern uint64_t off_rand_e64[] __attribute__((aligned(4 * NR_LANES)));
+extern uint64_t off_clust_e64[] __attribute__((aligned(4 * NR_LANES)));
+extern uint8_t gold_scale_e8[] __attribute__((aligned(4 * NR_LANES)));
+extern uint8_t gold_add_e8[] __attribute__((aligned(4 * NR_LANES)));
+extern uint8_t gold_triad_e8[] __attribute__((aligned(4 * NR_LANES)));
+extern uint16_t gold_scale_e16[] __attribute__((aligned(4 * NR_LANES)));
+extern uint16_t gold_add_e16[] __attribute__((aligned(4 * NR_LANES)));
+extern uint16_t gold_triad_e16[] __attribute__((aligned(4 * NR_LANES)));
+extern uint32_t gold_scale_e32[] __attribute__((aligned(4 * NR_LANES)));
+extern uint32_t gold_add_e32[] __attribute__((aligned(4 * NR_LANES)));
+extern uint32_t gold_triad_e32[] __attribute__((aligned(4 * NR_LANES)));
+extern uint64_t gold_scale_e64[] __attribute__((aligned(4 * NR_LANES)));
+extern uint64_t gold_add_e64[] __attribute__((aligned(4 * NR_LANES)));
+extern uint64_t gold_triad_e64[] __attribute__((aligned(4 * NR_LANES)));
+// The sums of the strided loads of each width and stride, and of the gathers
+// with the random and clustered offsets
+extern uint64_t gold_strided_e8[] __attribute__((aligned(4 * NR_LANES)));
+extern uint64_t gold_strided_e16[] __attribute__((aligned(4 * NR_LANES)));
+extern uint64_t gold_strided_e32[] __attribute__((aligned(4 * NR_LANES)));
+extern uint64_t gold_strided_e64[] __attribute__((aligned(4 * NR_LANES)));
+extern uint64_t gold_gather_e32[] __attribute__((aligned(4 * NR_LANES)));
+extern uint64_t gold_gather_e64[] __attribute__((aligned(4 * NR_LANES)));
+
+static int check_sum(const char *name, uint64_t res, uint64_t gold) {
+  if (res != gold) {
+    printf("%s: Error. %lu != %lu\n", name, res, gold);
+    return 1;
+  }
+  printf("%s: Check okay. No errors.\n", name);
+  return 0;
+}
+
+// The STREAM kernels and the strided loads of one width
+#define stream_run_gen(sew)                                                    \
+  static int run_e##sew(void) {                                                \
+    const uint64_t bytes = n * sizeof(uint##sew##_t);                          \
+    int error = 0;                                                             \
+                                                                               \
+    start_timer();                                                             \
+    stream_copy_e##sew(d, a, n);                                               \
+    stop_timer();                                                              \
+    bench_report_bw("stream_copy_e" #sew, 2 * bytes);                          \
+    error |= vcheck_report("stream_copy_e" #sew,                               \
+                           vcheck_i##sew((int##sew##_t *)d,                    \
+                                         (int##sew##_t *)a, n));               \
+                                                                               \
+    start_timer();                                                             \
+    stream_scale_e##sew(d, a, s, n);                                           \
+    stop_timer();                                                              \
+    bench_report_bw("stream_scale_e" #sew, 2 * bytes);                         \
+    error |= vcheck_report("stream_scale_e" #sew,                              \
+                           vcheck_i##sew((int##sew##_t *)d,                    \
+                                         (int##sew##_t *)gold_scale_e##sew,    \
+                                         n));                                  \
+                                                                               \
+    start_timer();                                                             \
+    stream_add_e##sew(d, a, b, n);                                             \
+    stop_timer();                                                             \
+    bench_report_bw("stream_add_e" #sew, 3 * bytes);                           \
+    error |= vcheck_report("stream_add_e" #sew,                                \
+                           vcheck_i##sew((int##sew##_t *)d,                    \
+                                         (int##sew##_t *)gold_add_e##sew, n)); \
+                                                                               \
+    start_timer();                                                             \
+    stream_triad_e##sew(d, a, b, s, n);                                        \
+    stop_timer();                                                             \
+    bench_report_bw("stream_triad_e" #sew, 3 * bytes);                         \
+    error |= vcheck_report("stream_triad_e" #sew,                              \
+                           vcheck_i##sew((int##sew##_t *)d,                    \
+                                         (int##sew##_t *)gold_triad_e##sew,    \
+                                         n));                                  \
+                                                                               \
+    for (uint64_t k = 0, st = 1; k < STREAM_NR_STRIDES; ++k, st *= 2) {        \
+      start_timer();                                                           \
+      uint64_t sum = stream_strided_e##sew(src, st, m);                        \
+      stop_timer();                                                            \
+      printf("Stride %lu:\n", st);                                             \
+      bench_report_bw("stream_strided_e" #sew, m * sizeof(uint##sew##_t));     \
+      error |= check_sum("stream_strided_e" #sew, sum,                         \
+                         gold_strided_e##sew[k]);                              \
+    }                                                                          \
+                                                                               \
+    return error;                                                              \
+  }
+
+stream_run_gen(8);
+stream_run_gen(16);
+stream_run_gen(32);
+stream_run_gen(64);
+
+// The gathers load the offsets and the elements
+#define stream_run_gather_gen(sew)                                             \
+  static int run_gather_e##sew(void) {                                         \
+    const uint64_t bytes = 2 * m * sizeof(uint##sew##_t);                      \
+    int error = 0;                                                             \
+                                                                               \
+    start_timer();                                                             \
+    uint64_t sum = stream_gather_e##sew(src, off_rand_e##sew, m);              \
+    stop_timer();                                                              \
+    bench_report_bw("stream_gather_e" #sew, bytes);                            \
+    error |= check_sum("stream_gather_e" #sew, sum, gold_gather_e##sew[0]);    \
+                                                                               \
+    start_timer();                                                             \
+    sum = stream_gather_e##sew(src, off_clust_e##sew, m);                      \
+    stop_timer();                                                              \
+    bench_report_bw("stream_gather_clust_e" #sew, bytes);                      \
+    error |= check_sum("stream_gather_clust_e" #sew, sum,                      \
+                       gold_gather_e##sew[1]);                                 \
+                                                                               \
+    return error;                                                              \
+  }
+
+stream_run_gather_gen(32);
+stream_run_gather_gen(64);
+
+int main() {
+  printf("\n");
+  printf("============\n");
+  printf("=  STREAM  =\n");
+  printf("============\n");
+  printf("\n");
+  printf("\n");
+
+  printf("Elements: %lu, strided and gathered elements: %lu\n", n, m);
+
+  int error = 0;
+
+  error |= run_e8();
+  error |= run_e16();
+  error |= run_e32();
+  error |= run_e64();
+  error |= run_gather_e32();
+  error |= run_gather_e64();
+
+  return error;
+}
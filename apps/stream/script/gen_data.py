@@ -0,0 +1,92 @@
+#!/usr/bin/env python3
+# Copyright 2022 ETH Zurich and University of Bologna.
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+# arg1: elements of the STREAM kernels, arg2: elements of the strided loads and
+# of the gathers, arg3: stride of the benchmarked strided loads
+# The arrays hold 64-bit elements, and the kernels of smaller widths take their
+# first elements of that width
+
+import numpy as np
+import os
+import sys
+
+sys.path.insert(0, os.path.join(os.path.dirname(__file__), '../../common/script'))
+from data_emit import emit
+
+# The sum modulo 2^sew, zero-extended to 64 bits, as stream_strided() and
+# stream_gather()
+def wsum(x):
+  return np.sum(x, dtype=np.uint64) & np.uint64((1 << (8 * x.itemsize)) - 1)
+
+############
+## SCRIPT ##
+############
+
+if len(sys.argv) == 4:
+  n      = int(sys.argv[1])
+  m      = int(sys.argv[2])
+  stride = int(sys.argv[3])
+else:
+  print("Error. Give me three arguments: the elements of the STREAM kernels, "
+        "the elements of the strided loads and of the gathers, and the stride.")
+  sys.exit()
+
+max_stride = 64
+# Elements of each cluster of the clustered gathers
+cluster    = 8
+
+dtypes = {8: np.uint8, 16: np.uint16, 32: np.uint32, 64: np.uint64}
+rand64 = lambda size: np.random.randint(0, 1 << 64, size, dtype=np.uint64)
+
+s   = 3
+a   = rand64(n)
+b   = rand64(n)
+src = rand64(max_stride * m)
+
+# Create the file
+print(".section .data,\"aw\",@progbits")
+emit("n", np.array(n, dtype=np.uint64))
+emit("m", np.array(m, dtype=np.uint64))
+emit("s", np.array(s, dtype=np.uint64))
+emit("stride", np.array(stride, dtype=np.uint64))
+emit("a", a, 'NR_LANES*4')
+emit("b", b, 'NR_LANES*4')
+emit("d", np.zeros(n, dtype=np.uint64), 'NR_LANES*4')
+emit("src", src, 'NR_LANES*4')
+
+for sew, dt in dtypes.items():
+  a_ = a.view(dt)[:n]
+  b_ = b.view(dt)[:n]
+  emit("gold_scale_e%d" % sew, dt(s) * a_, 'NR_LANES*4')
+  emit("gold_add_e%d" % sew, a_ + b_, 'NR_LANES*4')
+  emit("gold_triad_e%d" % sew, a_ + dt(s) * b_, 'NR_LANES*4')
+  # Strides of 1, 2, 4, ..., max_stride elements
+  strided = [wsum(src.view(dt)[0:m * st:st]) for st in 2 ** np.arange(7)]
+  emit("gold_strided_e%d" % sew, np.array(strided, dtype=np.uint64), 'NR_LANES*4')
+
+# The gathers span src: the random offsets are uniform, and the clustered ones
+# are runs of cluster consecutive elements, at random positions
+for sew in [32, 64]:
+  dt = dtypes[sew]
+  elems = src.view(dt)
+  rand  = np.random.randint(0, len(elems), m)
+  bases = np.random.randint(0, len(elems) - cluster + 1, (m + cluster - 1) // cluster)
+  clust = (np.repeat(bases, cluster) + np.tile(np.arange(cluster), len(bases)))[:m]
+  emit("off_rand_e%d" % sew, (rand * (sew // 8)).astype(dt), 'NR_LANES*4')
+  emit("off_clust_e%d" % sew, (clust * (sew // 8)).astype(dt), 'NR_LANES*4')
+  gather = [wsum(elems[rand]), wsum(elems[clust])]
+  emit("gold_gather_e%d" % sew, np.array(gather, dtype=np.uint64), 'NR_LANES*4')
@@ -0,0 +1,96 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "transpose.h"
+
+// Strip-mine loop over the rows of src. Each strip of vl rows is split into
+// tiles of 4 columns, which vlsseg4 loads into 4 registers, i.e., 4 rows of
+// dst. The last cols % 4 columns are loaded one at a time.
+#define transpose_def_gen(sew)                                                 \
+  void transpose_e##sew(void *dst, const void *src, uint64_t rows,             \
+                        uint64_t cols) {                                       \
+    uint##sew##_t *d = dst;                                                    \
+    const uint##sew##_t *s = src;                                              \
+    const ptrdiff_t stride = cols * sizeof(uint##sew##_t);                     \
+    size_t vl;                                                                 \
+                                                                               \
+    for (uint64_t r = 0; r < rows; r += vl) {                                  \
+      vl = vsetvl_e##sew##m2(rows - r);                                        \
+      const uint##sew##_t *s_ = s + r * cols;                                  \
+      uint##sew##_t *d_ = d + r;                                               \
+      uint64_t c = 0;                                                          \
+      for (; c + 4 <= cols; c += 4) {                                          \
+        vuint##sew##m2_t v0, v1, v2, v3;                                       \
+        vlsseg4e##sew##_v_u##sew##m2(&v0, &v1, &v2, &v3, s_ + c, stride, vl);  \
+        vse##sew##_v_u##sew##m2(d_ + c * rows, v0, vl);                        \
+        vse##sew##_v_u##sew##m2(d_ + (c + 1) * rows, v1, vl);                  \
+        vse##sew##_v_u##sew##m2(d_ + (c + 2) * rows, v2, vl);                  \
+        vse##sew##_v_u##sew##m2(d_ + (c + 3) * rows, v3, vl);                  \
+      }                                                                        \
+      for (; c < cols; ++c)                                                    \
+        vse##sew##_v_u##sew##m2(                                               \
+            d_ + c * rows, vlse##sew##_v_u##sew##m2(s_ + c, stride, vl), vl);  \
+    }                                                                          \
+  }                                                                            \
+                                                                               \
+  void nchw2nhwc_e##sew(void *dst, const void *src, uint64_t n, uint64_t c,    \
+                        uint64_t hw) {                                         \
+    for (uint64_t b = 0; b < n; ++b)                                           \
+      transpose_e##sew((uint##sew##_t *)dst + b * c * hw,                      \
+                       (const uint##sew##_t *)src + b * c * hw, c, hw);        \
+  }                                                                            \
+                                                                               \
+  void nhwc2nchw_e##sew(void *dst, const void *src, uint64_t n, uint64_t c,    \
+                        uint64_t hw) {                                         \
+    for (uint64_t b = 0; b < n; ++b)                                           \
+      transpose_e##sew((uint##sew##_t *)dst + b * c * hw,                      \
+                       (const uint##sew##_t *)src + b * c * hw, hw, c);        \
+  }                                                                            \
+                                                                               \
+  void interleave_e##sew(void *dst, const void *a, const void *b,              \
+                         uint64_t n) {                                         \
+    uint##sew##_t *d = dst;                                                    \
+    const uint##sew##_t *a_ = a;                                               \
+    const uint##sew##_t *b_ = b;                                               \
+    size_t vl;                                                                 \
+                                                                               \
+    for (uint64_t i = 0; i < n; i += vl) {                                     \
+      vl = vsetvl_e##sew##m4(n - i);                                           \
+      vsseg2e##sew##_v_u##sew##m4(d + 2 * i,                                   \
+                                  vle##sew##_v_u##sew##m4(a_ + i, vl),         \
+                                  vle##sew##_v_u##sew##m4(b_ + i, vl), vl);    \
+    }                                                                          \
+  }                                                                            \
+                                                                               \
+  void deinterleave_e##sew(void *a, void *b, const void *src, uint64_t n) {    \
+    uint##sew##_t *a_ = a;                                                     \
+    uint##sew##_t *b_ = b;                                                     \
+    const uint##sew##_t *s = src;                                              \
+    size_t vl;                                                                 \
+                                                                               \
+    for (uint64_t i = 0; i < n; i += vl) {                                     \
+      vl = vsetvl_e##sew##m4(n - i);                                           \
+      vuint##sew##m4_t v0, v1;                                                 \
+      vlseg2e##sew##_v_u##sew##m4(&v0, &v1, s + 2 * i, vl);                    \
+      vse##sew##_v_u##sew##m4(a_ + i, v0, vl);                                 \
+      vse##sew##_v_u##sew##m4(b_ + i, v1, vl);                                 \
+    }                                                                          \
+  }
+
+transpose_def_gen(8);
+transpose_def_gen(16);
+transpose_def_gen(32);
+transpose_def_gen(64);
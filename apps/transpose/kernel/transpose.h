@@ -0,0 +1,53 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Data layout conversions of 8, 16, 32, and 64-bit elements, with their bytes
+// moved as unsigned integers (e.g., the FP32 tensors with the e32 kernels):
+//  - transpose: dst = src^T, from a rows x cols to a cols x rows row-major
+//    matrix
+//  - nchw2nhwc, nhwc2nchw: the transposes of each of the n batches, of c x hw
+//    or hw x c elements
+//  - interleave, deinterleave: between the arrays a and b of n elements, and
+//    the n pairs {a[i], b[i]} (e.g., complex numbers and their real and
+//    imaginary parts)
+// The transposes load tiles of 4 columns with strided segment loads and store
+// them with unit-stride stores. Ara splits the segment accesses into one
+// strided access per field, so the kernels are bound by the elements per
+// cycle of the strided loads, rather than by the bytes of the AXI bus.
+
+#ifndef _TRANSPOSE_H_
+#define _TRANSPOSE_H_
+
+#include <stdint.h>
+
+#include "riscv_vector.h"
+
+#define transpose_dec_gen(sew)                                                 \
+  void transpose_e##sew(void *dst, const void *src, uint64_t rows,             \
+                        uint64_t cols);                                        \
+  void nchw2nhwc_e##sew(void *dst, const void *src, uint64_t n, uint64_t c,    \
+                        uint64_t hw);                                          \
+  void nhwc2nchw_e##sew(void *dst, const void *src, uint64_t n, uint64_t c,    \
+                        uint64_t hw);                                          \
+  void interleave_e##sew(void *dst, const void *a, const void *b, uint64_t n); \
+  void deinterleave_e##sew(void *a, void *b, const void *src, uint64_t n)
+
+transpose_dec_gen(8);
+transpose_dec_gen(16);
+transpose_dec_gen(32);
+transpose_dec_gen(64);
+
+#endif
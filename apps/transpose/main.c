@@ -0,0 +1,124 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdint.h>
+
+#include "bench.h"
+#include "kernel/transpose.h"
+#include "runtime.h"
+#include "util.h"
+#include "vcheck.h"
+
+#ifndef SPIKE
+#include "printf.h"
+#else
+#include <stdio.h>
+#endif
+
+extern uint64_t n;
+extern uint64_t c;
+extern uint64_t hw;
+extern uint8_t s8[] __attribute__((aligned(4 * NR_LANES)));
+extern uint16_t s16[] __attribute__((aligned(4 * NR_LANES)));
+extern uint32_t s32[] __attribute__((aligned(4 * NR_LANES)));
+extern uint64_t s64[] __attribute__((aligned(4 * NR_LANES)));
+extern uint8_t d8[] __attribute__((aligned(4 * NR_LANES)));
+extern uint16_t d16[] __attribute__((aligned(4 * NR_LANES)));
+extern uint32_t d32[] __attribute__((aligned(4 * NR_LANES)));
+extern uint64_t d64[] __attribute__((aligned(4 * NR_LANES)));
+extern uint32_t r32[] __attribute__((aligned(4 * NR_LANES)));
+extern uint8_t gold_t8[] __attribute__((aligned(4 * NR_LANES)));
+extern uint16_t gold_t16[] __attribute__((aligned(4 * NR_LANES)));
+extern uint32_t gold_t32[] __attribute__((aligned(4 * NR_LANES)));
+extern uint64_t gold_t64[] __attribute__((aligned(4 * NR_LANES)));
+extern uint32_t gold_nhwc32[] __attribute__((aligned(4 * NR_LANES)));
+extern uint32_t gold_deint32[] __attribute__((aligned(4 * NR_LANES)));
+
+int main() {
+  printf("\n");
+  printf("===============\n");
+  printf("=  TRANSPOSE  =\n");
+  printf("===============\n");
+  printf("\n");
+  printf("\n");
+
+  printf("Tensor: %lu x %lu x %lu\n", n, c, hw);
+
+  const uint64_t len = n * c * hw;
+  const uint64_t rows = n * c;
+  int error = 0;
+
+  // Each kernel reads and writes every element once
+  start_timer();
+  transpose_e8(d8, s8, rows, hw);
+  stop_timer();
+  bench_report_bw("transpose_e8", 2 * len);
+  error |= vcheck_report("transpose_e8",
+                         vcheck_i8((int8_t *)d8, (int8_t *)gold_t8, len));
+
+  start_timer();
+  transpose_e16(d16, s16, rows, hw);
+  stop_timer();
+  bench_report_bw("transpose_e16", 4 * len);
+  error |= vcheck_report("transpose_e16",
+                         vcheck_i16((int16_t *)d16, (int16_t *)gold_t16, len));
+
+  start_timer();
+  transpose_e32(d32, s32, rows, hw);
+  stop_timer();
+  bench_report_bw("transpose_e32", 8 * len);
+  error |= vcheck_report("transpose_e32",
+                         vcheck_i32((int32_t *)d32, (int32_t *)gold_t32, len));
+
+  start_timer();
+  transpose_e64(d64, s64, rows, hw);
+  stop_timer();
+  bench_report_bw("transpose_e64", 16 * len);
+  error |= vcheck_report("transpose_e64",
+                         vcheck_i64((int64_t *)d64, (int64_t *)gold_t64, len));
+
+  start_timer();
+  nchw2nhwc_e32(d32, s32, n, c, hw);
+  stop_timer();
+  bench_report_bw("nchw2nhwc_e32", 8 * len);
+  error |= vcheck_report("nchw2nhwc_e32",
+                         vcheck_i32((int32_t *)d32, (int32_t *)gold_nhwc32,
+                                    len));
+
+  start_timer();
+  nhwc2nchw_e32(r32, d32, n, c, hw);
+  stop_timer();
+  bench_report_bw("nhwc2nchw_e32", 8 * len);
+  error |= vcheck_report("nhwc2nchw_e32",
+                         vcheck_i32((int32_t *)r32, (int32_t *)s32, len));
+
+  start_timer();
+  deinterleave_e32(d32, d32 + len / 2, s32, len / 2);
+  stop_timer();
+  bench_report_bw("deinterleave_e32", 8 * len);
+  error |= vcheck_report("deinterleave_e32",
+                         vcheck_i32((int32_t *)d32, (int32_t *)gold_deint32,
+                                    len));
+
+  start_timer();
+  interleave_e32(r32, d32, d32 + len / 2, len / 2);
+  stop_timer();
+  bench_report_bw("interleave_e32", 8 * len);
+  error |= vcheck_report("interleave_e32",
+                         vcheck_i32((int32_t *)r32, (int32_t *)s32, len));
+
+  return error;
+}
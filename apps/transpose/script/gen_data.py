@@ -0,0 +1,64 @@
+#!/usr/bin/env python3
+# Copyright 2022 ETH Zurich and University of Bologna.
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+# arg1: batches, arg2: channels, arg3: height * width
+# The transposes take the n * c x hw matrices of the NCHW tensors
+
+import numpy as np
+import os
+import sys
+
+sys.path.insert(0, os.path.join(os.path.dirname(__file__), '../../common/script'))
+from data_emit import emit
+
+############
+## SCRIPT ##
+############
+
+if len(sys.argv) == 4:
+  n  = int(sys.argv[1])
+  c  = int(sys.argv[2])
+  hw = int(sys.argv[3])
+else:
+  print("Error. Give me three arguments: the batches, the channels, and the height * width.")
+  sys.exit()
+
+if (n * c * hw) % 2:
+  print("Error. The tensors must hold an even number of elements, for the pairs of the interleaving.")
+  sys.exit()
+
+# Create the file
+print(".section .data,\"aw\",@progbits")
+emit("n", np.array(n, dtype=np.uint64))
+emit("c", np.array(c, dtype=np.uint64))
+emit("hw", np.array(hw, dtype=np.uint64))
+
+for sew in [8, 16, 32, 64]:
+  dtype = np.dtype('uint%d' % sew)
+  s = np.random.randint(0, 2**sew, (n, c, hw), dtype=dtype)
+  if sew == 32:
+    s32 = s
+  emit("s%d" % sew, s, 'NR_LANES*4')
+  emit("d%d" % sew, np.zeros((n, c, hw), dtype=dtype), 'NR_LANES*4')
+  emit("gold_t%d" % sew, s.reshape(n * c, hw).T.copy(), 'NR_LANES*4')
+
+# The e32 layout conversions, and the deinterleaving of the pairs of s32,
+# converted back to s32 in r32
+emit("r32", np.zeros((n, c, hw), dtype=np.uint32), 'NR_LANES*4')
+emit("gold_nhwc32", s32.transpose(0, 2, 1).copy(), 'NR_LANES*4')
+emit("gold_deint32", np.concatenate((s32.flat[0::2], s32.flat[1::2])),
+     'NR_LANES*4')
@@ -0,0 +1,120 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "vfredsum_repro.h"
+
+// The last partial strip is loaded at VLMAX with zeros in the elements past
+// n, so that all the additions act on VLMAX elements, and no result depends
+// on the tail policy. The tree adds the upper half of the register to the
+// lower one, until one element is left. VLMAX is a power of two.
+
+#define vfredsum_repro_def_gen(DATA_TYPE, sew, mb8, mb4)                       \
+  static inline vfloat##sew##m8_t vfredsum_load_##sew##m8(                     \
+      const DATA_TYPE *x, size_t n, size_t vlmax) {                            \
+    if (n >= vlmax)                                                            \
+      return vle##sew##_v_f##sew##m8(x, vlmax);                                \
+    vbool##mb8##_t valid =                                                     \
+        vmsltu_vx_u##sew##m8_b##mb8(vid_v_u##sew##m8(vlmax), n, vlmax);       \
+    return vle##sew##_v_f##sew##m8_m(valid, vfmv_v_f_f##sew##m8(0, vlmax),     \
+                                     x, vlmax);                                \
+  }                                                                            \
+                                                                               \
+  static inline vfloat##sew##m4_t vfredsum_load_##sew##m4(                     \
+      const DATA_TYPE *x, size_t n, size_t vlmax) {                            \
+    if (n >= vlmax)                                                            \
+      return vle##sew##_v_f##sew##m4(x, vlmax);                                \
+    vbool##mb4##_t valid =                                                     \
+        vmsltu_vx_u##sew##m4_b##mb4(vid_v_u##sew##m4(vlmax), n, vlmax);       \
+    return vle##sew##_v_f##sew##m4_m(valid, vfmv_v_f_f##sew##m4(0, vlmax),     \
+                                     x, vlmax);                                \
+  }                                                                            \
+                                                                               \
+  static inline vfloat##sew##m8_t vfredsum_strips_##sew(const DATA_TYPE *x,    \
+                                                        size_t n,              \
+                                                        size_t vlmax) {        \
+    vfloat##sew##m8_t acc = vfmv_v_f_f##sew##m8(0, vlmax);                     \
+    for (size_t i = 0; i < n; i += vlmax)                                      \
+      acc = vfadd_vv_f##sew##m8(acc, vfredsum_load_##sew##m8(x + i, n - i,     \
+                                                             vlmax),           \
+                                vlmax);                                        \
+    return acc;                                                                \
+  }                                                                            \
+                                                                               \
+  DATA_TYPE vfredsum_repro_##sew(const DATA_TYPE *x, size_t n) {               \
+    const size_t vlmax = vsetvlmax_e##sew##m8();                               \
+    vfloat##sew##m8_t acc = vfredsum_strips_##sew(x, n, vlmax);                \
+                                                                               \
+    for (size_t h = vlmax >> 1; h > 0; h >>= 1)                                \
+      acc = vfadd_vv_f##sew##m8(acc, vslidedown_vx_f##sew##m8(acc, acc, h, h), \
+                                h);                                            \
+                                                                               \
+    return vfmv_f_s_f##sew##m8_f##sew(acc);                                    \
+  }                                                                            \
+                                                                               \
+  /* Kahan sums at LMUL = 4, as the sums, the compensations, the loads, and    \
+     the temporaries take five register groups. Each compensation holds the    \
+     opposite of the error of its sum, until the tree, where the pairs are     \
+     added with the error of TwoSum */                                         \
+  DATA_TYPE vfredsum_repro_kahan_##sew(const DATA_TYPE *x, size_t n) {         \
+    const size_t vlmax = vsetvlmax_e##sew##m4();                               \
+    vfloat##sew##m4_t s = vfmv_v_f_f##sew##m4(0, vlmax);                       \
+    vfloat##sew##m4_t c = vfmv_v_f_f##sew##m4(0, vlmax);                       \
+                                                                               \
+    for (size_t i = 0; i < n; i += vlmax) {                                    \
+      vfloat##sew##m4_t y = vfsub_vv_f##sew##m4(                               \
+          vfredsum_load_##sew##m4(x + i, n - i, vlmax), c, vlmax);             \
+      vfloat##sew##m4_t t = vfadd_vv_f##sew##m4(s, y, vlmax);                  \
+      c = vfsub_vv_f##sew##m4(vfsub_vv_f##sew##m4(t, s, vlmax), y, vlmax);     \
+      s = t;                                                                   \
+    }                                                                          \
+    c = vfneg_v_f##sew##m4(c, vlmax);                                          \
+                                                                               \
+    for (size_t h = vlmax >> 1; h > 0; h >>= 1) {                              \
+      vfloat##sew##m4_t b = vslidedown_vx_f##sew##m4(s, s, h, h);              \
+      vfloat##sew##m4_t cb = vslidedown_vx_f##sew##m4(c, c, h, h);             \
+      vfloat##sew##m4_t sum = vfadd_vv_f##sew##m4(s, b, h);                    \
+      vfloat##sew##m4_t bb = vfsub_vv_f##sew##m4(sum, s, h);                   \
+      vfloat##sew##m4_t err = vfadd_vv_f##sew##m4(                             \
+          vfsub_vv_f##sew##m4(s, vfsub_vv_f##sew##m4(sum, bb, h), h),          \
+          vfsub_vv_f##sew##m4(b, bb, h), h);                                   \
+      c = vfadd_vv_f##sew##m4(vfadd_vv_f##sew##m4(c, cb, h), err, h);          \
+      s = sum;                                                                 \
+    }                                                                          \
+                                                                               \
+    return vfmv_f_s_f##sew##m4_f##sew(s) + vfmv_f_s_f##sew##m4_f##sew(c);      \
+  }                                                                            \
+                                                                               \
+  DATA_TYPE vfredsum_ordered_##sew(const DATA_TYPE *x, size_t n) {             \
+    vfloat##sew##m1_t red = vfmv_v_f_f##sew##m1(0, 1);                         \
+    size_t vl;                                                                 \
+    for (size_t i = 0; i < n; i += vl) {                                       \
+      vl = vsetvl_e##sew##m8(n - i);                                           \
+      red = vfredosum_vs_f##sew##m8_f##sew##m1(                                \
+          red, vle##sew##_v_f##sew##m8(x + i, vl), red, vl);                   \
+    }                                                                          \
+    return vfmv_f_s_f##sew##m1_f##sew(red);                                    \
+  }                                                                            \
+                                                                               \
+  DATA_TYPE vfredsum_unordered_##sew(const DATA_TYPE *x, size_t n) {           \
+    const size_t vlmax = vsetvlmax_e##sew##m8();                               \
+    vfloat##sew##m8_t acc = vfredsum_strips_##sew(x, n, vlmax);                \
+    vfloat##sew##m1_t red = vfmv_v_f_f##sew##m1(0, 1);                         \
+    red = vfredusum_vs_f##sew##m8_f##sew##m1(red, acc, red, vlmax);            \
+    return vfmv_f_s_f##sew##m1_f##sew(red);                                    \
+  }
+
+vfredsum_repro_def_gen(float, 32, 4, 8);
+vfredsum_repro_def_gen(double, 64, 8, 16);
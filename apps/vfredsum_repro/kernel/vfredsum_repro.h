@@ -0,0 +1,49 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Reproducible FP sums of n elements:
+//   vfredsum_repro_<sew>      : element-wise sums of the strips, and a
+//                               pairwise tree in the register, in a fixed
+//                               order
+//   vfredsum_repro_kahan_<sew>: as vfredsum_repro, with Kahan-compensated
+//                               element-wise sums, and a compensated tree
+// and their references:
+//   vfredsum_ordered_<sew>    : vfredosum on each strip, reproducible
+//   vfredsum_unordered_<sew>  : element-wise sums of the strips, reduced by
+//                               one vfredusum, whose order depends on timing
+//
+// The order of the additions of vfredsum_repro depends only on n and VLMAX,
+// so the result is the same bit by bit on every run with the same VLEN,
+// regardless of the stalls and of the bank conflicts on the VRF.
+
+#ifndef _VFREDSUM_REPRO_H_
+#define _VFREDSUM_REPRO_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "riscv_vector.h"
+
+#define vfredsum_repro_dec_gen(DATA_TYPE, sew)                                 \
+  DATA_TYPE vfredsum_repro_##sew(const DATA_TYPE *x, size_t n);                \
+  DATA_TYPE vfredsum_repro_kahan_##sew(const DATA_TYPE *x, size_t n);          \
+  DATA_TYPE vfredsum_ordered_##sew(const DATA_TYPE *x, size_t n);              \
+  DATA_TYPE vfredsum_unordered_##sew(const DATA_TYPE *x, size_t n);
+
+vfredsum_repro_dec_gen(float, 32);
+vfredsum_repro_dec_gen(double, 64);
+
+#endif
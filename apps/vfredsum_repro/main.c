@@ -0,0 +1,112 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdint.h>
+#include <string.h>
+
+#include "kernel/vfredsum_repro.h"
+#include "runtime.h"
+#include "util.h"
+
+#ifndef SPIKE
+#include "printf.h"
+#else
+#include <stdio.h>
+#endif
+
+// Unit roundoffs
+#define EPS64 (1.0 / (1ull << 53))
+#define EPS32 (1.0 / (1ull << 24))
+
+extern uint64_t n;
+extern double x64[] __attribute__((aligned(4 * NR_LANES)));
+extern float x32[] __attribute__((aligned(4 * NR_LANES)));
+extern double gold64;
+extern float gold32;
+
+typedef double (*sum64_t)(const double *x, size_t n);
+typedef float (*sum32_t)(const float *x, size_t n);
+
+static double absd(double x) { return x < 0 ? -x : x; }
+
+// Time a sum, and check its error against n * eps * sum(|x|), the bound of
+// any order of the additions. The error is printed in units of eps * sum(|x|)
+static int check(const char *name, double res, double gold, double eps,
+                 double asum) {
+  const double err = asum ? absd(res - gold) / (eps * asum) : 0;
+  printf("%s: %d cycles, error %f eps * sum(|x|).\n", name, get_timer(), err);
+  if (err > n) {
+    printf("%s: Error. %f != %f\n", name, res, gold);
+    return 1;
+  }
+  return 0;
+}
+
+static int run64(const char *name, sum64_t sum, double asum) {
+  start_timer();
+  double res = sum(x64, n);
+  stop_timer();
+  return check(name, res, gold64, EPS64, asum);
+}
+
+static int run32(const char *name, sum32_t sum, double asum) {
+  start_timer();
+  float res = sum(x32, n);
+  stop_timer();
+  return check(name, res, gold32, EPS32, asum);
+}
+
+int main() {
+  printf("\n");
+  printf("====================\n");
+  printf("=  VFREDSUM_REPRO  =\n");
+  printf("====================\n");
+  printf("\n");
+  printf("\n");
+
+  printf("Elements: %lu\n", n);
+
+  double asum64 = 0, asum32 = 0;
+  for (uint64_t i = 0; i < n; ++i) {
+    asum64 += absd(x64[i]);
+    asum32 += absd(x32[i]);
+  }
+
+  int error = 0;
+
+  error |= run64("vfredsum_repro_64", vfredsum_repro_64, asum64);
+  error |= run64("vfredsum_repro_kahan_64", vfredsum_repro_kahan_64, asum64);
+  error |= run64("vfredsum_ordered_64", vfredsum_ordered_64, asum64);
+  error |= run64("vfredsum_unordered_64", vfredsum_unordered_64, asum64);
+  error |= run32("vfredsum_repro_32", vfredsum_repro_32, asum32);
+  error |= run32("vfredsum_repro_kahan_32", vfredsum_repro_kahan_32, asum32);
+  error |= run32("vfredsum_ordered_32", vfredsum_ordered_32, asum32);
+  error |= run32("vfredsum_unordered_32", vfredsum_unordered_32, asum32);
+
+  // The same bits on every run
+  double r0 = vfredsum_repro_64(x64, n);
+  double r1 = vfredsum_repro_64(x64, n);
+  float s0 = vfredsum_repro_kahan_32(x32, n);
+  float s1 = vfredsum_repro_kahan_32(x32, n);
+  if (memcmp(&r0, &r1, sizeof(r0)) || memcmp(&s0, &s1, sizeof(s0))) {
+    printf("vfredsum_repro: Error. The results differ across runs.\n");
+    error = 1;
+  } else {
+    printf("vfredsum_repro: Check okay. No errors.\n");
+  }
+
+  return error;
+}
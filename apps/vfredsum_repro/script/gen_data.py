@@ -0,0 +1,53 @@
+#!/usr/bin/env python3
+# Copyright 2022 ETH Zurich and University of Bologna.
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+# arg1: number of elements
+
+import math
+import numpy as np
+import os
+import sys
+
+sys.path.insert(0, os.path.join(os.path.dirname(__file__), '../../common/script'))
+from data_emit import emit as emit_data
+
+# Pad the FP32 arrays to whole double words
+def emit(name, array, alignment='8'):
+  emit_data(name, array, alignment, pad=8)
+
+############
+## SCRIPT ##
+############
+
+if len(sys.argv) == 2:
+  n = int(sys.argv[1])
+else:
+  print("Error. Give me one argument: the number of elements.")
+  sys.exit()
+
+# Twelve decades of magnitudes of both signs, so that the order of the sums
+# changes their rounding errors
+x64 = np.random.uniform(-0.5, 0.5, n) * 10.0 ** np.random.randint(-6, 6, n)
+x32 = x64.astype(np.float32)
+
+# Exactly rounded sums
+print(".section .data,\"aw\",@progbits")
+emit("n", np.array(n, dtype=np.uint64))
+emit("x64", x64, 'NR_LANES*4')
+emit("x32", x32, 'NR_LANES*4')
+emit("gold64", np.array(math.fsum(x64), dtype=np.float64))
+emit("gold32", np.array(math.fsum(x32.astype(np.float64)), dtype=np.float32))
@@ -0,0 +1,111 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Latency and throughput of the vector instructions, for the SEW and LMUL of
+// the tests generated by script/gen_data.py, on a few vector lengths up to
+// VLMAX. The results are printed as:
+//   [vinsn]: name sew lmul vl latency cycles-per-instruction
+// with a latency of -1 for the instructions without a latency test.
+//
+// The widening and narrowing instructions also print, at VLMAX, the elements
+// per cycle and lane of the stream and of the chain, e.g., of the widening
+// MACs on one accumulator, and the peak of one 2 * SEW word per cycle and lane:
+//   [vinsn-rate]: name sew lmul vl stream chain peak
+
+#include <stdint.h>
+
+#include "runtime.h"
+#include "util.h"
+
+#ifndef SPIKE
+#include "printf.h"
+#else
+#include <stdio.h>
+#endif
+
+// Test of the generated code, called with the avl and the buffer of the
+// memory operations
+typedef void (*vinsn_fn_t)(uint64_t avl, void *buf);
+
+// The short and the long version of each test
+typedef struct {
+  const char *name;
+  vinsn_fn_t lat[2];
+  vinsn_fn_t thr[2];
+  uint64_t mixed;
+} vinsn_test_t;
+
+extern uint64_t vinsn_sew;
+extern uint64_t vinsn_lmul;
+extern uint64_t vinsn_chain[2];
+extern uint64_t vinsn_nr_tests;
+extern const vinsn_test_t vinsn_tests[];
+extern uint64_t vinsn_vlmax(void);
+
+// The strided accesses of 2 * SEW / 8 bytes, on up to 8 registers
+uint8_t buf[2 * VLEN] __attribute__((aligned(4 * NR_LANES)));
+
+// Cycles per instruction of a test, on the difference of its two versions,
+// after a first call that warms up the caches
+static float run(const vinsn_fn_t *fn, uint64_t vl) {
+  int64_t cycles[2];
+
+  for (int i = 0; i < 2; ++i) {
+    fn[i](vl, buf);
+    start_timer();
+    fn[i](vl, buf);
+    stop_timer();
+    cycles[i] = get_timer();
+  }
+
+  return (float)(cycles[1] - cycles[0]) / (vinsn_chain[1] - vinsn_chain[0]);
+}
+
+int main() {
+  printf("\n");
+  printf("===========\n");
+  printf("=  VINSN  =\n");
+  printf("===========\n");
+  printf("\n");
+  printf("\n");
+
+  const uint64_t vlmax = vinsn_vlmax();
+  printf("SEW: %lu, LMUL: %lu, VLMAX: %lu\n", vinsn_sew, vinsn_lmul, vlmax);
+
+  // One element, and a quarter, a half, and all the vector
+  uint64_t vls[4] = {1, vlmax / 4, vlmax / 2, vlmax};
+
+  for (uint64_t t = 0; t < vinsn_nr_tests; ++t) {
+    const vinsn_test_t *test = &vinsn_tests[t];
+    for (int i = 0; i < 4; ++i) {
+      if (!vls[i] || (i && vls[i] == vls[i - 1]))
+        continue;
+      float lat = test->lat[0] ? run(test->lat, vls[i]) : -1;
+      float cpi = run(test->thr, vls[i]);
+      printf("[vinsn]: %s %lu %lu %lu %f %f\n", test->name, vinsn_sew,
+             vinsn_lmul, vls[i], lat, cpi);
+      if (test->mixed && vls[i] == vlmax) {
+        float peak = 64.0 / (2 * vinsn_sew);
+        float chain = lat > 0 ? (float)vls[i] / lat / NR_LANES : -1;
+        printf("[vinsn-rate]: %s %lu %lu %lu %f %f %f\n", test->name,
+               vinsn_sew, vinsn_lmul, vls[i], (float)vls[i] / cpi / NR_LANES,
+               chain, peak);
+      }
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,403 @@
+#!/usr/bin/env python3
+# Copyright 2022 ETH Zurich and University of Bologna.
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+# arg1: SEW, arg2: LMUL
+# Generate the latency and throughput microbenchmarks of the vector
+# instructions of FUNCTIONALITIES.md, for one SEW and LMUL. Each test is an
+# assembly function of the .text section, called by main.c with the vl and a
+# buffer:
+#   - latency: a chain of dependent instructions, each one reading the result
+#     of the previous one. Only the instructions with a source of the same
+#     kind as their destination (or an accumulator) have one.
+#   - throughput: a stream of instructions with independent destinations,
+#     rotated over the free registers
+# The widening and narrowing instructions, which go through a 2 * SEW word per
+# lane and cycle at full rate, are marked as mixed-precision ones.
+# Each test comes in a short and a long version, and main.c divides the
+# difference of their cycles by the difference of their lengths, which
+# cancels the setup, the call, and the drain of the results.
+#
+# Registers:
+#   v0:      mask source (0x55 bytes)
+#   v1-v7:   masks and scalar operands of the reductions
+#   v8-v31:  groups of 2 * LMUL registers (8 for LMUL=8), for the vectors
+#            and their widened versions
+#   t0 = 1 (scalar operand), t1 = 2 * SEW / 8 (byte stride), ft0 = 1.0,
+#   a0 = avl, a1 = buffer of the memory operations
+
+import os
+import re
+import sys
+
+# Lengths of the short and long chains
+N_SHORT = 8
+N_LONG  = 40
+
+INT = (8, 16, 32, 64)
+WID = (8, 16, 32)
+FP  = (16, 32, 64)
+FPW = (16, 32)
+
+# Forms of the binary instructions: suffix, destination, sources (in the
+# assembly order), and accumulation on the destination
+#   v: vector, w: widened vector (2 * SEW, 2 * LMUL), m: mask, s: scalar
+#   element of a vector register, x: t0, f: ft0, i: immediate, 0: v0
+FORMS = {
+  'vv' : ('.vv',  'v', 'vv',  False),
+  'vx' : ('.vx',  'v', 'vx',  False),
+  'vi' : ('.vi',  'v', 'vi',  False),
+  'vf' : ('.vf',  'v', 'vf',  False),
+  # Widening
+  'wv' : ('.vv',  'w', 'vv',  False),
+  'wx' : ('.vx',  'w', 'vx',  False),
+  'wf' : ('.vf',  'w', 'vf',  False),
+  'ww' : ('.wv',  'w', 'wv',  False),
+  'wwx': ('.wx',  'w', 'wx',  False),
+  'wwf': ('.wf',  'w', 'wf',  False),
+  # Narrowing
+  'nv' : ('.wv',  'v', 'wv',  False),
+  'nx' : ('.wx',  'v', 'wx',  False),
+  'ni' : ('.wi',  'v', 'wi',  False),
+  # Compares
+  'mv' : ('.vv',  'm', 'vv',  False),
+  'mx' : ('.vx',  'm', 'vx',  False),
+  'mi' : ('.vi',  'm', 'vi',  False),
+  'mf' : ('.vf',  'm', 'vf',  False),
+  # Multiply-adds, vd is accumulated
+  'av' : ('.vv',  'v', 'vv',  False),
+  'ax' : ('.vx',  'v', 'xv',  False),
+  'af' : ('.vf',  'v', 'fv',  False),
+  'Av' : ('.vv',  'w', 'vv',  True),
+  'Ax' : ('.vx',  'w', 'xv',  True),
+  'Af' : ('.vf',  'w', 'fv',  True),
+  # With v0 as carry or selector
+  'vvm': ('.vvm', 'v', 'vv0', False),
+  'vxm': ('.vxm', 'v', 'vx0', False),
+  'vim': ('.vim', 'v', 'vi0', False),
+  'vfm': ('.vfm', 'v', 'vf0', False),
+  'mvm': ('.vvm', 'm', 'vv0', False),
+  'mxm': ('.vxm', 'm', 'vx0', False),
+  'mim': ('.vim', 'm', 'vi0', False),
+  # Reductions
+  'vs' : ('.vs',  's', 'vs',  False),
+  'mm' : ('.mm',  'm', 'mm',  False),
+}
+
+# Instructions: (documented name, assembly name, destination, sources,
+# accumulation, SEWs, FP operands)
+INSNS = []
+
+def binary(names, forms, sews=INT, fp=False):
+  for name in names.split():
+    for form in forms.split():
+      suffix, dst, srcs, acc = FORMS[form]
+      # The FP forms with a widened source are listed on their own
+      doc = name + '.w' if fp and form in ('ww', 'wwf') else name
+      INSNS.append((doc, name + suffix, dst, srcs, acc, sews, fp))
+
+def insn(doc, name, dst, srcs, sews=INT, fp=False, acc=False):
+  INSNS.append((doc, name, dst, srcs, acc, sews, fp))
+
+## Loads and stores
+#   a: (a1), t: t1, I: the byte offsets of the elements
+insn('vle<eew>',   'vle{sew}.v',   'v', 'a')
+insn('vl1r.v',     'vl1r.v',       'v', 'a')
+insn('vse<eew>',   'vse{sew}.v',   None, 'va')
+insn('vs1r.v',     'vs1r.v',       None, 'va')
+insn('vle<eew>ff', 'vle{sew}ff.v', 'v', 'a')
+insn('vlse<eew>',  'vlse{sew}.v',  'v', 'at')
+insn('vsse<eew>',  'vsse{sew}.v',  None, 'vat')
+for x in ['u', 'o']:
+  insn('vl%sxei<eew>' % x, 'vl%sxei{sew}.v' % x, 'v', 'aI')
+  insn('vs%sxei<eew>' % x, 'vs%sxei{sew}.v' % x, None, 'vaI')
+# The segments of 2 fields take the 2 * LMUL registers of a widened vector
+insn('vlseg<nf>e<eew>',    'vlseg2e{sew}.v',    'w', 'a')
+insn('vlsseg<nf>e<eew>',   'vlsseg2e{sew}.v',   'w', 'at')
+insn('vluxseg<nf>ei<eew>', 'vluxseg2ei{sew}.v', 'w', 'aI')
+insn('vloxseg<nf>ei<eew>', 'vloxseg2ei{sew}.v', 'w', 'aI')
+insn('vsseg<nf>e<eew>',    'vsseg2e{sew}.v',    None, 'wa')
+insn('vssseg<nf>e<eew>',   'vssseg2e{sew}.v',   None, 'wat')
+insn('vsuxseg<nf>ei<eew>', 'vsuxseg2ei{sew}.v', None, 'waI')
+insn('vsoxseg<nf>ei<eew>', 'vsoxseg2ei{sew}.v', None, 'waI')
+
+## Integer arithmetic
+binary('vadd', 'vv vx vi')
+binary('vsub', 'vv vx')
+binary('vrsub', 'vx vi')
+binary('vwaddu vwsubu vwadd vwsub', 'wv wx ww wwx', WID)
+for k, sews in [(2, (16, 32, 64)), (4, (32, 64)), (8, (64,))]:
+  for name in ['vzext', 'vsext']:
+    insn(name, '%s.vf%d' % (name, k), 'v', 'v', sews)
+binary('vadc', 'vvm vxm vim')
+binary('vmadc', 'mvm mxm mim')
+binary('vsbc', 'vvm vxm')
+binary('vmsbc', 'mvm mxm')
+binary('vand vor vxor vsll vsrl vsra', 'vv vx vi')
+binary('vnsrl vnsra', 'nv nx ni', WID)
+binary('vmseq vmsne vmsleu vmsle', 'mv mx mi')
+binary('vmsltu vmslt', 'mv mx')
+binary('vmsgtu vmsgt', 'mx mi')
+binary('vminu vmin vmaxu vmax', 'vv vx')
+binary('vmul vmulh vmulhu vmulhsu', 'vv vx')
+binary('vdivu vdiv vremu vrem', 'vv vx')
+binary('vwmul vwmulu vwmulsu', 'wv wx', WID)
+binary('vmacc vnmsac vmadd vnmsub', 'av ax')
+binary('vwmaccu vwmacc vwmaccsu', 'Av Ax', WID)
+binary('vwmaccus', 'Ax', WID)
+binary('vmerge', 'vvm vxm vim')
+insn('vmv', 'vmv.v.v', 'v', 'v')
+insn('vmv', 'vmv.v.x', 'v', 'x')
+insn('vmv', 'vmv.v.i', 'v', 'i')
+insn('vmv<nr>r', 'vmv{lmul}r.v', 'v', 'v')
+
+## Floating-point
+binary('vfadd vfsub', 'vv vf', FP, True)
+binary('vfrsub', 'vf', FP, True)
+binary('vfwadd vfwsub', 'wv wf ww wwf', FPW, True)
+binary('vfmul vfdiv', 'vv vf', FP, True)
+binary('vfrdiv', 'vf', FP, True)
+binary('vfwmul', 'wv wf', FPW, True)
+binary('vfmacc vfnmacc vfmsac vfnmsac vfmadd vfnmadd vfmsub vfnmsub', 'av af',
+       FP, True)
+binary('vfwmacc vfwnmacc vfwmsac vfwnmsac', 'Av Af', FPW, True)
+insn('vfsqrt', 'vfsqrt.v', 'v', 'v', FP, True)
+binary('vfmin vfmax vfsgnj vfsgnjn vfsgnjx', 'vv vf', FP, True)
+insn('vfclass', 'vfclass.v', 'v', 'v', FP, True)
+binary('vfmerge', 'vfm', FP, True)
+insn('vfmv', 'vfmv.v.f', 'v', 'f', FP, True)
+binary('vmfeq vmfne vmflt vmfle', 'mv mf', FP, True)
+binary('vmfgt vmfge', 'mf', FP, True)
+TO_INT = ['xu.f', 'x.f', 'rtz.xu.f', 'rtz.x.f']
+TO_FP  = ['f.xu', 'f.x']
+for cvt in TO_INT + TO_FP:
+  insn('vfcvt.' + cvt, 'vfcvt.%s.v' % cvt, 'v', 'v', FP, True)
+# The FP side is the narrow one when widening, and the wide one when narrowing
+for cvt in TO_INT + TO_FP + ['f.f']:
+  sews = WID if cvt in TO_FP else FPW
+  insn('vfwcvt.' + cvt, 'vfwcvt.%s.v' % cvt, 'w', 'v', sews, True)
+for cvt in TO_INT + TO_FP + ['f.f', 'rod.f.f']:
+  sews = WID if cvt in TO_INT else FPW
+  insn('vfncvt.' + cvt, 'vfncvt.%s.w' % cvt, 'v', 'w', sews, True)
+insn('vfrec7', 'vfrec7.v', 'v', 'v', FP, True)
+insn('vfrsqrt7', 'vfrsqrt7.v', 'v', 'v', FP, True)
+
+## Reductions
+binary('vredsum vredmaxu vredmax vredminu vredmin vredand vredor vredxor', 'vs')
+binary('vwredsumu vwredsum', 'vs', WID)
+binary('vfredusum vfredosum vfredmin vfredmax', 'vs', FP, True)
+binary('vfwredusum vfwredosum', 'vs', FPW, True)
+
+## Masks
+binary('vmand vmnand vmandnot vmxor vmor vmnor vmornot vmxnor', 'mm')
+for name in ['vmsbf', 'vmsof', 'vmsif']:
+  insn(name, name + '.m', 'm', 'm')
+insn('viota', 'viota.m', 'v', 'm')
+insn('vid', 'vid.v', 'v', '')
+insn('vcpop.m', 'vpopc.m', 'x', 'm')
+insn('vfirst.m', 'vfirst.m', 'x', 'm')
+
+## Permutations
+insn('vmv.x.s', 'vmv.x.s', 'x', 'v')
+insn('vmv.s.x', 'vmv.s.x', 's', 'x')
+insn('vfmv.f.s', 'vfmv.f.s', 'f', 'v', FP, True)
+insn('vfmv.s.f', 'vfmv.s.f', 's', 'f', FP, True)
+binary('vslideup vslidedown', 'vx vi')
+binary('vslide1up vslide1down', 'vx')
+binary('vfslide1up vfslide1down', 'vf', FP, True)
+binary('vrgather', 'vv vx vi')
+# The indices of 16 bits take at most the registers of the data, if SEW > 8
+insn('vrgatherei16', 'vrgatherei16.vv', 'v', 'vv', FP)
+insn('vcompress', 'vcompress.vm', 'v', 'vm')
+
+## Fixed-point
+binary('vsaddu vsadd', 'vv vx vi')
+binary('vssubu vssub vaadd vaaddu vasub vasubu vsmul', 'vv vx')
+binary('vssra vssrl', 'vv vx vi')
+binary('vnclip vnclipu', 'nv nx ni', WID)
+
+# The names of FUNCTIONALITIES.md that have no test
+def uncovered():
+  path = os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', '..',
+                      '..', 'FUNCTIONALITIES.md')
+  with open(path) as f:
+    text = f.read()
+  text = text[text.index('## Vector Loads and Stores'):]
+  doc = set()
+  for group in re.findall(r'`([^`]*)`', text):
+    doc.update(t.strip() for t in group.split(','))
+  return sorted(doc - set(i[0] for i in INSNS))
+
+############
+## SCRIPT ##
+############
+
+if len(sys.argv) == 3:
+  sew  = int(sys.argv[1])
+  lmul = int(sys.argv[2])
+else:
+  print("Error. Give me two arguments: the SEW and the LMUL.")
+  sys.exit()
+
+if sew not in INT or lmul not in (1, 2, 4, 8):
+  print("Error. The SEW must be 8, 16, 32, or 64, and the LMUL 1, 2, 4, or 8.")
+  sys.exit()
+
+missing = uncovered()
+if missing:
+  sys.stderr.write("Warning: no test for " + ", ".join(missing) + "\n")
+
+# Register groups of the vectors, and registers of the masks and scalars
+width  = min(2 * lmul, 8)
+groups = list(range(8, 32, width))
+masks  = list(range(1, 8))
+
+def operand(kind, reg):
+  return {'x': 't0', 'f': 'ft0', 'i': '1', '0': 'v0', 'a': '(a1)',
+          't': 't1'}.get(kind, 'v%d' % reg if reg is not None else None)
+
+def pool(kind):
+  return masks if kind in 'ms' else groups
+
+# The chain goes through the first source of the kind of the destination, or
+# through the destination if it accumulates
+def chain_src(dst, srcs, acc):
+  if dst is None or dst in 'xf' or acc:
+    return None
+  for i, k in enumerate(srcs):
+    if k == dst:
+      return i
+  return None
+
+def body(name, dst, srcs, acc, kind, n):
+  # One constant register per kind of source, then the destinations
+  regs = {k: list(pool(k)) for k in 'vwmsI'}
+  consts = {}
+  for k in srcs:
+    if k in 'vwmsI' and k not in consts:
+      p = regs[k if k in 'ms' else 'v']
+      consts[k] = p.pop(0)
+      # The vectors, the widened ones, and the offsets share the groups
+      if k in 'vwI':
+        for kk in 'vwI':
+          if kk != k and consts[k] in regs[kk]:
+            regs[kk].remove(consts[k])
+  c = chain_src(dst, srcs, acc)
+  if dst in ('v', 'w', 'm', 's'):
+    free = [r for r in regs[dst if dst in 'ms' else 'v'] if r not in consts.values()]
+    if kind == 'lat':
+      dsts = free[:1] if acc else free[:2]
+    else:
+      dsts = free[:4]
+  else:
+    dsts = [None]
+
+  lines = []
+  for j in range(n):
+    d = dsts[j % len(dsts)]
+    ops = [] if dst is None or dst in 'xf' else ['v%d' % d]
+    if dst == 'x':
+      ops = ['t2']
+    elif dst == 'f':
+      ops = ['ft1']
+    for i, k in enumerate(srcs):
+      if kind == 'lat' and i == c:
+        ops.append('v%d' % dsts[(j + 1) % len(dsts)])
+      else:
+        ops.append(operand(k, consts.get(k)))
+    lines.append('  %s %s' % (name, ', '.join(ops)))
+  drain = ['  vmv.x.s t2, v%d' % d for d in dsts if d is not None]
+  return lines, drain, consts
+
+# Emit the functions of the tests, and their table
+print(".section .text,\"ax\",@progbits")
+print(".global vinsn_vlmax")
+print("vinsn_vlmax:")
+print("  vsetvli a0, zero, e%d, m%d, ta, ma" % (sew, lmul))
+print("  ret")
+
+tests = []
+for idx, (doc, insn_name, dst, srcs, acc, sews, fp) in enumerate(INSNS):
+  name = insn_name.format(sew=sew, lmul=lmul)
+  wide = 'w' in (dst or '') + srcs
+  if sew not in sews or (wide and lmul == 8):
+    continue
+  fns = {}
+  for kind in ['lat', 'thr']:
+    if kind == 'lat' and chain_src(dst, srcs, acc) is None and not acc:
+      continue
+    for n in [N_SHORT, N_LONG]:
+      label = 'vinsn_%d_%s_%d' % (idx, kind, n)
+      lines, drain, consts = body(name, dst, srcs, acc, kind, n)
+      print(".global %s" % label)
+      print("%s:" % label)
+      # Constants: 1 (or 1.0) in the groups, 0x55 in the masks, and the byte
+      # offsets of the elements in the offsets
+      print("  li t0, 1")
+      print("  li t1, %d" % (2 * sew // 8))
+      print("  li t2, 0x55")
+      print("  vsetvli t3, zero, e8, m8, ta, ma")
+      print("  vmv.v.x v0, t2")
+      print("  vsetvli t3, zero, e%d, m%d, ta, ma" % (sew, width))
+      for g in groups:
+        print("  vmv.v.i v%d, 1" % g)
+        if fp and sew in FP:
+          print("  vfcvt.f.x.v v%d, v%d" % (g, g))
+      if fp and sew in FP:
+        print("  vfmv.f.s ft0, v%d" % groups[0])
+      if 'I' in consts:
+        print("  vsetvli t3, zero, e%d, m%d, ta, ma" % (sew, lmul))
+        print("  vid.v v%d" % consts['I'])
+        if sew > 8:
+          print("  vsll.vi v%d, v%d, %d" % (consts['I'], consts['I'],
+                                            (sew // 8).bit_length() - 1))
+      print("  vsetvli zero, a0, e%d, m%d, ta, ma" % (sew, lmul))
+      print("\n".join(lines))
+      # Wait for the results
+      if drain:
+        print("\n".join(drain))
+      print("  ret")
+      fns[(kind, n)] = label
+  # The same name for all the SEWs and LMULs, e.g., vle<sew>.v
+  tests.append((insn_name.format(sew='<sew>', lmul='<lmul>'), fns,
+                wide and dst in ('v', 'w') and 'a' not in srcs))
+
+print(".section .data,\"aw\",@progbits")
+print(".global vinsn_sew")
+print(".balign 8")
+print("vinsn_sew:\n  .dword %d" % sew)
+print(".global vinsn_lmul")
+print(".balign 8")
+print("vinsn_lmul:\n  .dword %d" % lmul)
+print(".global vinsn_chain")
+print(".balign 8")
+print("vinsn_chain:\n  .dword %d\n  .dword %d" % (N_SHORT, N_LONG))
+print(".global vinsn_nr_tests")
+print(".balign 8")
+print("vinsn_nr_tests:\n  .dword %d" % len(tests))
+# vinsn_test_t of main.c: the name, the short and long latency tests (or 0),
+# the short and long throughput tests, and the mixed-precision flag
+print(".global vinsn_tests")
+print(".balign 8")
+print("vinsn_tests:")
+for i, (name, fns, mixed) in enumerate(tests):
+  print("  .dword vinsn_name_%d" % i)
+  for kind in ['lat', 'thr']:
+    for n in [N_SHORT, N_LONG]:
+      print("  .dword %s" % fns.get((kind, n), '0'))
+  print("  .dword %d" % mixed)
+for i, (name, fns, mixed) in enumerate(tests):
+  print("vinsn_name_%d:\n  .asciz \"%s\"" % (i, name))
@@ -23,3 +23,30 @@ nr_lanes ?= 2
 # Length of each vector register (in bits)
 # Constraints: VLEN > 128
 vlen ?= 2048
+
+# Size of the main memory (in bytes)
+# Constraints: power of two, up to 1 GiB
+dram_size ?= 0x02000000
+
+# Timing of the main memory, to model a DRAM in simulation
+# Latencies (in cycles), bandwidth (in bytes per cycle, 0 for the full AXI width),
+# and number of banks, interleaved every AXI word
+# Each bank serves CVA6 or Ara in a cycle
+# Constraints: power of two banks
+dram_rd_latency ?= 1
+dram_wr_latency ?= 1
+dram_bw ?= 0
+dram_banks ?= 8
+
+# Depth of the instruction queues of the functional units
+# Constraints: at least one
+valu_queue_depth ?= 4
+mfpu_queue_depth ?= 4
+vldu_queue_depth ?= 4
+vstu_queue_depth ?= 4
+sldu_queue_depth ?= 2
+masku_queue_depth ?= 1
+
+# Number of systems (CVA6 + Ara) of the SoC, sharing the main memory
+# Constraints: power of two, up to 8
+nr_cores ?= 1
@@ -0,0 +1,52 @@
+# Copyright 2020 ETH Zurich and University of Bologna.
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+# Author: Samuel Riedel, ETH Zurich
+#         Matheus Cavalcante, ETH Zurich
+
+# Number of vector lanes
+nr_lanes ?= 32
+
+# Length of each vector register (in bits)
+# Constraints: VLEN > 128
+vlen ?= 32768
+
+# Size of the main memory (in bytes)
+# Constraints: power of two, up to 1 GiB
+dram_size ?= 0x02000000
+
+# Timing of the main memory, to model a DRAM in simulation
+# Latencies (in cycles), bandwidth (in bytes per cycle, 0 for the full AXI width),
+# and number of banks, interleaved every AXI word
+# Each bank serves CVA6 or Ara in a cycle
+# Constraints: power of two banks
+dram_rd_latency ?= 1
+dram_wr_latency ?= 1
+dram_bw ?= 0
+dram_banks ?= 8
+
+# Depth of the instruction queues of the functional units
+# Constraints: at least one
+valu_queue_depth ?= 4
+mfpu_queue_depth ?= 4
+vldu_queue_depth ?= 4
+vstu_queue_depth ?= 4
+sldu_queue_depth ?= 2
+masku_queue_depth ?= 1
+
+# Number of systems (CVA6 + Ara) of the SoC, sharing the main memory
+# Constraints: power of two, up to 8
+nr_cores ?= 1
@@ -0,0 +1,15 @@
+# Copyright 2021 ETH Zurich and University of Bologna.
+# Solderpad Hardware License, Version 0.51, see LICENSE for details.
+# SPDX-License-Identifier: SHL-0.51
+#
+# JTAG-to-AXI master, through which the host loads the programs into the main
+# memory and accesses the control registers of the FPGA target.
+
+create_ip -name jtag_axi -vendor xilinx.com -library ip -module_name xlnx_jtag_axi
+
+set_property -dict [list \
+  CONFIG.PROTOCOL         {0}  \
+  CONFIG.M_AXI_DATA_WIDTH {64} \
+  CONFIG.M_AXI_ADDR_WIDTH {32} \
+  CONFIG.M_AXI_ID_WIDTH   {1}  \
+] [get_ips xlnx_jtag_axi]
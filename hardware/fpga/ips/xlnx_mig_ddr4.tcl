@@ -0,0 +1,20 @@
+# Copyright 2021 ETH Zurich and University of Bologna.
+# Solderpad Hardware License, Version 0.51, see LICENSE for details.
+# SPDX-License-Identifier: SHL-0.51
+#
+# DDR4 controller of the main memory, with an AXI slave port. It also generates
+# the clock of the SoC (addn_ui_clkout1), at $freq_mhz.
+# Expects $mig_id_width and $freq_mhz to be set by scripts/run.tcl.
+
+create_ip -name ddr4 -vendor xilinx.com -library ip -module_name xlnx_mig_ddr4
+
+set_property -dict [list \
+  CONFIG.C0_CLOCK_BOARD_INTERFACE {default_250mhz_clk1} \
+  CONFIG.C0_DDR4_BOARD_INTERFACE  {ddr4_sdram_c1}       \
+  CONFIG.RESET_BOARD_INTERFACE    {reset}               \
+  CONFIG.C0.DDR4_AxiSelection     {true}                \
+  CONFIG.C0.DDR4_AxiDataWidth     {512}                 \
+  CONFIG.C0.DDR4_AxiAddressWidth  {31}                  \
+  CONFIG.C0.DDR4_AxiIDWidth       $mig_id_width         \
+  CONFIG.ADDN_UI_CLKOUT1_FREQ_HZ  $freq_mhz             \
+] [get_ips xlnx_mig_ddr4]
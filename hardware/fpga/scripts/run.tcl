@@ -0,0 +1,68 @@
+# Copyright 2021 ETH Zurich and University of Bologna.
+# Solderpad Hardware License, Version 0.51, see LICENSE for details.
+# SPDX-License-Identifier: SHL-0.51
+#
+# Build the bitstream of the FPGA target.
+# Usage: vivado -mode batch -source scripts/run.tcl -tclargs CONFIG BOARD FREQ_MHZ NR_CORES [REPORTS]
+# The reports go to REPORTS, by default reports/CONFIG.
+
+lassign $argv config board freq_mhz nr_cores reports
+if {$reports eq ""} {
+  set reports reports/$config
+}
+
+switch $board {
+  vcu118 {
+    set part       xcvu9p-flga2104-2L-e
+    set board_part xilinx.com:vcu118:part0:2.4
+  }
+  default {
+    puts "ERROR: Unsupported board `$board'."
+    exit 1
+  }
+}
+
+set build_dir build/$config
+set project   ara_xilinx
+
+create_project $project $build_dir -part $part -force
+set_property board_part $board_part [current_project]
+set_property XPM_LIBRARIES XPM_MEMORY [current_project]
+
+# IPs. The DDR4 controller also sees the ID bit of the multiplexer of the host
+# and SoC, on top of the AXI ID of the SoC (see src/ara_xilinx.sv).
+set mig_id_width [expr {6 + int(ceil(log($nr_cores + 1) / log(2)))}]
+foreach ip {xlnx_mig_ddr4 xlnx_jtag_axi} {
+  source ips/$ip.tcl
+  generate_target all [get_ips $ip]
+  create_ip_run [get_ips $ip]
+  launch_runs ${ip}_synth_1
+}
+foreach ip {xlnx_mig_ddr4 xlnx_jtag_axi} {
+  wait_on_run ${ip}_synth_1
+}
+
+# RTL, generated by Bender
+source tmp/add_sources_$config.tcl
+set_property top ara_xilinx [current_fileset]
+add_files -fileset constrs_1 -norecurse constraints/$board.xdc
+
+# Synthesis
+launch_runs synth_1 -jobs 8
+wait_on_run synth_1
+open_run synth_1
+exec mkdir -p $reports
+report_utilization -hierarchical -file $reports/utilization_synth.rpt
+
+# Implementation
+launch_runs impl_1 -to_step write_bitstream -jobs 8
+wait_on_run impl_1
+open_run impl_1
+report_utilization -hierarchical -file $reports/utilization_impl.rpt
+report_timing_summary -file $reports/timing_impl.rpt
+
+if {[get_property STATS.WNS [get_runs impl_1]] < 0} {
+  puts "WARNING: The design does not meet timing at $freq_mhz MHz."
+}
+
+file copy -force $build_dir/$project.runs/impl_1/ara_xilinx.bit $build_dir/ara_xilinx.bit
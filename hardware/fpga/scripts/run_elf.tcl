@@ -0,0 +1,113 @@
+# Copyright 2021 ETH Zurich and University of Bologna.
+# Solderpad Hardware License, Version 0.51, see LICENSE for details.
+# SPDX-License-Identifier: SHL-0.51
+#
+# Run a program on the FPGA target, through the JTAG-to-AXI master.
+# Usage: vivado -mode batch -source scripts/run_elf.tcl -tclargs BIN [BITSTREAM] [TIMEOUT_S]
+#
+# BIN is the flat image of the program at the start of the DRAM, with its .bss
+# (see `make fpga-run'). The host holds the SoC in reset, writes the image to
+# the DDR, releases the reset, and waits for the program to exit. It then
+# prints the cycle and performance counters, and exits with the exit code of
+# the program. The output of the program goes to the UART.
+
+lassign $argv bin bitstream timeout_s
+if {$timeout_s eq ""} {
+  set timeout_s 3600
+}
+
+# Memory map of the host (src/ara_xilinx.sv, src/ara_fpga_ctrl.sv)
+set dram_base 0x80000000
+set ctrl_base 0x10000000
+set soc_rst_reg   [expr {$ctrl_base + 0x00}]
+set exit_reg      [expr {$ctrl_base + 0x08}]
+set cycles_reg    [expr {$ctrl_base + 0x10}]
+set hw_cycles_reg [expr {$ctrl_base + 0x18}]
+set perf_cnt_reg  [expr {$ctrl_base + 0x20}]
+# The fields of perf_events_t (hardware/include/ara_pkg.sv), from bit 0
+set perf_events {valu_busy vmfpu_busy vldu_busy vstu_busy sldu_busy masku_busy
+                 stall_lanes_desynch stall_vinsn_full stall_hazard vrf_bank_conflict
+                 axi_r_beat axi_w_beat acc_req_stall valu_clk_on vmfpu_clk_on sldu_clk_on
+                 acc_early_ack vcache_hit vcache_miss prefetch_beat prefetch_hit}
+# Beats of 64 bits per write burst
+set burst_len 256
+
+open_hw_manager
+connect_hw_server
+open_hw_target
+current_hw_device [lindex [get_hw_devices xcvu9p_0] 0]
+if {$bitstream ne ""} {
+  set_property PROGRAM.FILE $bitstream [current_hw_device]
+  program_hw_devices [current_hw_device]
+}
+refresh_hw_device [current_hw_device]
+
+set axi [lindex [get_hw_axis] 0]
+reset_hw_axi $axi
+
+proc axi_write {addr beats} {
+  global axi
+  # The first beat is the least significant one
+  create_hw_axi_txn -force txn $axi -type write -address [format 0x%08x $addr] \
+    -len [llength $beats] -data [join [lreverse $beats] ""]
+  run_hw_axi -quiet [get_hw_axi_txns txn]
+}
+
+proc axi_read {addr} {
+  global axi
+  create_hw_axi_txn -force txn $axi -type read -address [format 0x%08x $addr] -len 1
+  run_hw_axi -quiet [get_hw_axi_txns txn]
+  return [expr 0x[get_property DATA [get_hw_axi_txns txn]]]
+}
+
+# Hold the SoC in reset, and load the image
+axi_write $soc_rst_reg [list [format %016x 1]]
+
+set f [open $bin r]
+fconfigure $f -translation binary
+set image [read $f]
+close $f
+# Pad to a full beat
+while {[string length $image] % 8} {
+  append image \x00
+}
+
+puts "Loading `$bin' ([string length $image] bytes)"
+set beats {}
+set addr  $dram_base
+for {set i 0} {$i < [string length $image]} {incr i 8} {
+  binary scan [string reverse [string range $image $i [expr {$i + 7}]]] H16 beat
+  lappend beats $beat
+  if {[llength $beats] == $burst_len} {
+    axi_write $addr $beats
+    set beats {}
+    incr addr [expr {8 * $burst_len}]
+  }
+}
+if {[llength $beats]} {
+  axi_write $addr $beats
+}
+
+# Run until the program exits
+axi_write $soc_rst_reg [list [format %016x 0]]
+set start [clock seconds]
+while {!([set exit [axi_read $exit_reg]] & 1)} {
+  if {[clock seconds] - $start > $timeout_s} {
+    puts "ERROR: Timeout of $timeout_s seconds reached."
+    exit 1
+  }
+  after 100
+}
+
+set exit_code [expr {$exit >> 1}]
+puts "\[cycles\]: [axi_read $cycles_reg]"
+puts "\[hw-cycles\]: [axi_read $hw_cycles_reg]"
+for {set c 0} {$c < [llength $perf_events]} {incr c} {
+  puts "\[perf-cnt\]: [lindex $perf_events $c] [axi_read [expr {$perf_cnt_reg + 8 * $c}]]"
+}
+if {$exit_code} {
+  puts "Core Test *** FAILED *** (tohost = $exit_code)"
+} else {
+  puts "Core Test *** SUCCESS *** (tohost = 0)"
+}
+exit $exit_code
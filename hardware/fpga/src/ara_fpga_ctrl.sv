@@ -0,0 +1,130 @@
+// Copyright 2021 ETH Zurich and University of Bologna.
+// Solderpad Hardware License, Version 0.51, see LICENSE for details.
+// SPDX-License-Identifier: SHL-0.51
+//
+// Description: AXI-LITE accessible registers of the FPGA target, through which the host
+// holds the SoC in reset while it loads a program, and reads the exit code of the program,
+// the cycle counters, and the performance counters once the program is over.
+
+module ara_fpga_ctrl import ara_pkg::*; #(
+    parameter int unsigned DataWidth       = 64,
+    parameter int unsigned AddrWidth       = 64,
+    // AXI Structs
+    parameter type         axi_lite_req_t  = logic,
+    parameter type         axi_lite_resp_t = logic
+  ) (
+    input  logic                 clk_i,
+    input  logic                 rst_ni,
+    // AXI Bus of the host
+    input  axi_lite_req_t        axi_lite_slave_req_i,
+    output axi_lite_resp_t       axi_lite_slave_resp_o,
+    // Reset of the SoC, held until the host releases it
+    output logic                 soc_rst_o,
+    // Status of the SoC
+    input  logic          [63:0] exit_i,
+    input  logic          [63:0] hw_cnt_en_i,
+    input  perf_events_t         perf_events_i
+  );
+
+  `include "common_cells/registers.svh"
+
+  ///////////////////
+  //  Definitions  //
+  ///////////////////
+
+  // Control registers, followed by one counter per performance event
+  localparam int unsigned NumCtrlRegs      = 4;
+  localparam int unsigned NumRegs          = NumCtrlRegs + NrPerfEvents;
+  localparam int unsigned DataWidthInBytes = (DataWidth + 7) / 8;
+  localparam int unsigned RegNumBytes      = NumRegs * DataWidthInBytes;
+
+  localparam logic [DataWidthInBytes-1:0] ReadOnlyReg  = {DataWidthInBytes{1'b1}};
+  localparam logic [DataWidthInBytes-1:0] ReadWriteReg = {DataWidthInBytes{1'b0}};
+
+  // Memory map
+  // [32+8*NrPerfEvents-1:32]: perf_cnt (ro), one per field of perf_events_t
+  // [31:24]: hw_cycles (ro), cycles with the hardware counter enabled
+  // [23:16]: cycles    (ro), cycles from the release of the reset to the exit
+  // [15:8]:  exit      (ro), exit code of the program, and bit 0 set once it exited
+  // [7:0]:   soc_rst   (rw), holds the SoC in reset while set
+  localparam logic [NumRegs-1:0][DataWidth-1:0] RegRstVal = '{
+    0      : 1,
+    default: 0
+  };
+  localparam logic [NumRegs-1:0][DataWidthInBytes-1:0] AxiReadOnly = '{
+    0      : ReadWriteReg,
+    default: ReadOnlyReg
+  };
+
+  /////////////////
+  //  Registers  //
+  /////////////////
+
+  logic [NumRegs-1:0][DataWidth-1:0]        reg_d, reg_q;
+  logic [NumRegs-1:0][DataWidthInBytes-1:0] reg_load;
+
+  axi_lite_regs #(
+    .RegNumBytes (RegNumBytes    ),
+    .AxiAddrWidth(AddrWidth      ),
+    .AxiDataWidth(DataWidth      ),
+    .AxiReadOnly (AxiReadOnly    ),
+    .RegRstVal   (RegRstVal      ),
+    .req_lite_t  (axi_lite_req_t ),
+    .resp_lite_t (axi_lite_resp_t)
+  ) i_axi_lite_regs (
+    .clk_i      (clk_i                 ),
+    .rst_ni     (rst_ni                ),
+    .axi_req_i  (axi_lite_slave_req_i  ),
+    .axi_resp_o (axi_lite_slave_resp_o ),
+    .wr_active_o(/* Unused */          ),
+    .rd_active_o(/* Unused */          ),
+    .reg_d_i    (reg_d                 ),
+    .reg_load_i (reg_load              ),
+    .reg_q_o    (reg_q                 )
+  );
+
+  ////////////////
+  //  Counters  //
+  ////////////////
+
+  // The exit register of the SoC flags the exit for one cycle only
+  logic exited;
+  assign exited = reg_q[1][0];
+
+  // All the counters restart when the SoC is put in reset again
+  logic soc_rst;
+  assign soc_rst = reg_q[0][0];
+
+  always_comb begin
+    reg_d    = reg_q;
+    reg_load = '0;
+
+    // Exit code
+    if (soc_rst || (exit_i[0] && !exited)) begin
+      reg_d[1]    = soc_rst ? '0 : exit_i;
+      reg_load[1] = '1;
+    end
+
+    // Cycle counters
+    if (soc_rst || !exited) begin
+      reg_d[2]    = soc_rst ? '0 : reg_q[2] + 1;
+      reg_load[2] = '1;
+    end
+    if (soc_rst || hw_cnt_en_i[0]) begin
+      reg_d[3]    = soc_rst ? '0 : reg_q[3] + 1;
+      reg_load[3] = '1;
+    end
+
+    // The performance counters count only when the hardware counter is enabled, like the ones of
+    // the control registers of the SoC
+    for (int c = 0; c < NrPerfEvents; c++) begin
+      if (soc_rst || (hw_cnt_en_i[0] && perf_events_i[c])) begin
+        reg_d[NumCtrlRegs + c]    = soc_rst ? '0 : reg_q[NumCtrlRegs + c] + 1;
+        reg_load[NumCtrlRegs + c] = '1;
+      end
+    end
+  end
+
+  assign soc_rst_o = soc_rst;
+
+endmodule : ara_fpga_ctrl
@@ -0,0 +1,106 @@
+// Copyright 2021 ETH Zurich and University of Bologna.
+// Solderpad Hardware License, Version 0.51, see LICENSE for details.
+// SPDX-License-Identifier: SHL-0.51
+//
+// Description: Transmit-only UART of the FPGA target (8N1).
+//              Like the mock UART of the testbenches, it sends the low byte of every
+//              write to its APB port, so that the programs print through the same
+//              fake_uart symbol in simulation and on the FPGA. The writes stall while
+//              the FIFO is full, so no character is dropped.
+
+module ara_fpga_uart #(
+    // Frequency of the clock (in Hz), and baud rate of the UART
+    parameter int unsigned ClkFreqHz = 50_000_000,
+    parameter int unsigned BaudRate  = 115_200,
+    // Depth of the transmit FIFO (in characters)
+    parameter int unsigned FifoDepth = 64
+  ) (
+    input  logic        clk_i,
+    input  logic        rst_ni,
+    // APB interface
+    input  logic        penable_i,
+    input  logic        pwrite_i,
+    input  logic [31:0] paddr_i,
+    input  logic        psel_i,
+    input  logic [31:0] pwdata_i,
+    output logic [31:0] prdata_o,
+    output logic        pready_o,
+    output logic        pslverr_o,
+    // Serial line
+    output logic        tx_o
+  );
+
+  `include "common_cells/registers.svh"
+
+  localparam int unsigned ClksPerBit = ClkFreqHz / BaudRate;
+
+  //////////////
+  //  Buffer  //
+  //////////////
+
+  logic       fifo_full, fifo_empty, fifo_push, fifo_pop;
+  logic [7:0] fifo_data;
+
+  fifo_v3 #(
+    .DEPTH     (FifoDepth),
+    .DATA_WIDTH(8        )
+  ) i_tx_fifo (
+    .clk_i     (clk_i         ),
+    .rst_ni    (rst_ni        ),
+    .flush_i   (1'b0          ),
+    .testmode_i(1'b0          ),
+    .full_o    (fifo_full     ),
+    .empty_o   (fifo_empty    ),
+    .usage_o   (/* Unused */  ),
+    .data_i    (pwdata_i[7:0] ),
+    .push_i    (fifo_push     ),
+    .data_o    (fifo_data     ),
+    .pop_i     (fifo_pop      )
+  );
+
+  // Accept a write once there is room for it. The reads return zero.
+  assign fifo_push = psel_i & penable_i & pwrite_i & ~fifo_full;
+  assign pready_o  = ~(pwrite_i & fifo_full);
+  assign prdata_o  = '0;
+  assign pslverr_o = 1'b0;
+
+  ///////////////////
+  //  Transmitter  //
+  ///////////////////
+
+  // Start bit, 8 data bits (LSB first), and stop bit
+  logic [9:0]                      shift_d, shift_q;
+  logic [3:0]                      bits_d, bits_q;
+  logic [$clog2(ClksPerBit+1)-1:0] clks_d, clks_q;
+
+  always_comb begin
+    shift_d  = shift_q;
+    bits_d   = bits_q;
+    clks_d   = clks_q;
+    fifo_pop = 1'b0;
+
+    if (bits_q == '0) begin
+      // Idle, load the next character
+      if (!fifo_empty) begin
+        fifo_pop = 1'b1;
+        shift_d  = {1'b1, fifo_data, 1'b0};
+        bits_d   = 10;
+        clks_d   = ClksPerBit - 1;
+      end
+    end else if (clks_q == '0) begin
+      shift_d = {1'b1, shift_q[9:1]};
+      bits_d  = bits_q - 1;
+      clks_d  = ClksPerBit - 1;
+    end else begin
+      clks_d = clks_q - 1;
+    end
+  end
+
+  `FF(shift_q, shift_d, '1);
+  `FF(bits_q, bits_d, '0);
+  `FF(clks_q, clks_d, '0);
+
+  // The line idles high
+  assign tx_o = shift_q[0];
+
+endmodule : ara_fpga_uart
@@ -0,0 +1,527 @@
+// Copyright 2021 ETH Zurich and University of Bologna.
+// Solderpad Hardware License, Version 0.51, see LICENSE for details.
+// SPDX-License-Identifier: SHL-0.51
+//
+// Description: FPGA top-level of Ara (VCU118).
+//              Wraps Ara's SoC with the DDR4 controller as main memory, and a UART.
+//              The host accesses the main memory and the control registers of the
+//              FPGA target (ara_fpga_ctrl) through a JTAG-to-AXI master: it holds the
+//              SoC in reset, writes the program to the DDR, releases the reset, and
+//              polls the exit register.
+
+module ara_xilinx import axi_pkg::*; import ara_pkg::*; (
+    // DDR4 reference clock, and reset button
+    input  logic        c0_sys_clk_p,
+    input  logic        c0_sys_clk_n,
+    input  logic        cpu_reset,
+    // DDR4
+    output logic        c0_ddr4_act_n,
+    output logic [16:0] c0_ddr4_adr,
+    output logic [1:0]  c0_ddr4_ba,
+    output logic [0:0]  c0_ddr4_bg,
+    output logic [0:0]  c0_ddr4_cke,
+    output logic [0:0]  c0_ddr4_odt,
+    output logic [0:0]  c0_ddr4_cs_n,
+    output logic [0:0]  c0_ddr4_ck_t,
+    output logic [0:0]  c0_ddr4_ck_c,
+    output logic        c0_ddr4_reset_n,
+    inout  wire  [7:0]  c0_ddr4_dm_dbi_n,
+    inout  wire  [63:0] c0_ddr4_dq,
+    inout  wire  [7:0]  c0_ddr4_dqs_t,
+    inout  wire  [7:0]  c0_ddr4_dqs_c,
+    // UART
+    output logic        uart_tx_o,
+    // Status
+    output logic [7:0]  led_o
+  );
+
+  `include "axi/typedef.svh"
+
+  /////////////////////
+  //  Configuration  //
+  /////////////////////
+
+  localparam int unsigned NrLanes = `NR_LANES;
+`ifdef NR_CORES
+  localparam int unsigned NrCores = `NR_CORES;
+`else
+  localparam int unsigned NrCores = 1;
+`endif
+  // Frequency of the SoC (in MHz), generated by the DDR4 controller (ips/xlnx_mig_ddr4.tcl)
+`ifdef FPGA_FREQ_MHZ
+  localparam int unsigned SocFreqMHz = `FPGA_FREQ_MHZ;
+`else
+  localparam int unsigned SocFreqMHz = 50;
+`endif
+
+  localparam int unsigned AxiAddrWidth = 64;
+  localparam int unsigned AxiDataWidth = 64 * NrLanes / 2;
+  localparam int unsigned AxiUserWidth = 1;
+  localparam int unsigned AxiIdWidth   = 5 + $clog2(NrCores + 1);
+  // The JTAG-to-AXI master of the host
+  localparam int unsigned HostDataWidth = 64;
+  // The DDR4 controller, which also sees the ID bit of the multiplexer of the host and SoC
+  localparam int unsigned MigDataWidth = 512;
+  localparam int unsigned MigAddrWidth = 31;
+  localparam int unsigned MigIdWidth   = AxiIdWidth + 1;
+
+  // Memory map of the host. Any address below the DRAM selects the control registers of the FPGA
+  // target (scripts/run_elf.tcl accesses them at CtrlBase).
+  localparam logic [63:0] DRAMBase   = 64'h8000_0000;
+  localparam logic [63:0] DRAMLength = 64'h4000_0000;
+  localparam logic [63:0] CtrlBase   = 64'h1000_0000;
+
+  typedef logic [AxiAddrWidth-1:0]      axi_addr_t;
+  typedef logic [AxiUserWidth-1:0]      axi_user_t;
+  typedef logic [AxiIdWidth-1:0]        axi_id_t;
+  typedef logic [AxiDataWidth-1:0]      axi_data_t;
+  typedef logic [AxiDataWidth/8-1:0]    axi_strb_t;
+  typedef logic [HostDataWidth-1:0]     host_data_t;
+  typedef logic [HostDataWidth/8-1:0]   host_strb_t;
+  typedef logic [MigIdWidth-1:0]        mig_id_t;
+  typedef logic [MigDataWidth-1:0]      mig_data_t;
+  typedef logic [MigDataWidth/8-1:0]    mig_strb_t;
+
+  // Wide AXI bus of the SoC
+  `AXI_TYPEDEF_ALL(soc, axi_addr_t, axi_id_t, axi_data_t, axi_strb_t, axi_user_t)
+  // Host, with the ID width of the SoC
+  `AXI_TYPEDEF_ALL(host, axi_addr_t, axi_id_t, host_data_t, host_strb_t, axi_user_t)
+  `AXI_LITE_TYPEDEF_ALL(host_lite, axi_addr_t, host_data_t, host_strb_t)
+  // Main memory, after the multiplexer of the SoC and the host
+  `AXI_TYPEDEF_ALL(mem, axi_addr_t, mig_id_t, axi_data_t, axi_strb_t, axi_user_t)
+  `AXI_TYPEDEF_ALL(mig, axi_addr_t, mig_id_t, mig_data_t, mig_strb_t, axi_user_t)
+
+  /////////////////////////
+  //  Clocks and resets  //
+  /////////////////////////
+
+  // The DDR4 controller runs on its UI clock, and generates the clock of the SoC
+  logic mig_clk, mig_rst, mig_calib_done;
+  logic soc_clk;
+  logic sys_rst_n, soc_rst_n, soc_rst;
+
+  rstgen i_sys_rstgen (
+    .clk_i      (soc_clk                    ),
+    .rst_ni     (~cpu_reset & mig_calib_done),
+    .test_mode_i(1'b0                       ),
+    .rst_no     (sys_rst_n                  ),
+    .init_no    (/* Unused */               )
+  );
+
+  // The host holds the SoC in reset while it loads a program
+  rstgen i_soc_rstgen (
+    .clk_i      (soc_clk             ),
+    .rst_ni     (sys_rst_n & ~soc_rst),
+    .test_mode_i(1'b0                ),
+    .rst_no     (soc_rst_n           ),
+    .init_no    (/* Unused */        )
+  );
+
+  ////////////
+  //  Host  //
+  ////////////
+
+  host_req_t  host_axi_req;
+  host_resp_t host_axi_resp;
+
+  // The JTAG-to-AXI master has a single ID bit
+  logic host_axi_awid, host_axi_arid;
+
+  xlnx_jtag_axi i_jtag_axi (
+    .aclk         (soc_clk                     ),
+    .aresetn      (sys_rst_n                   ),
+    .m_axi_awid   (host_axi_awid               ),
+    .m_axi_awaddr (host_axi_req.aw.addr[31:0]  ),
+    .m_axi_awlen  (host_axi_req.aw.len         ),
+    .m_axi_awsize (host_axi_req.aw.size        ),
+    .m_axi_awburst(host_axi_req.aw.burst       ),
+    .m_axi_awlock (host_axi_req.aw.lock        ),
+    .m_axi_awcache(host_axi_req.aw.cache       ),
+    .m_axi_awprot (host_axi_req.aw.prot        ),
+    .m_axi_awqos  (host_axi_req.aw.qos         ),
+    .m_axi_awvalid(host_axi_req.aw_valid       ),
+    .m_axi_awready(host_axi_resp.aw_ready      ),
+    .m_axi_wdata  (host_axi_req.w.data         ),
+    .m_axi_wstrb  (host_axi_req.w.strb         ),
+    .m_axi_wlast  (host_axi_req.w.last         ),
+    .m_axi_wvalid (host_axi_req.w_valid        ),
+    .m_axi_wready (host_axi_resp.w_ready       ),
+    .m_axi_bid    (host_axi_resp.b.id[0]       ),
+    .m_axi_bresp  (host_axi_resp.b.resp        ),
+    .m_axi_bvalid (host_axi_resp.b_valid       ),
+    .m_axi_bready (host_axi_req.b_ready        ),
+    .m_axi_arid   (host_axi_arid               ),
+    .m_axi_araddr (host_axi_req.ar.addr[31:0]  ),
+    .m_axi_arlen  (host_axi_req.ar.len         ),
+    .m_axi_arsize (host_axi_req.ar.size        ),
+    .m_axi_arburst(host_axi_req.ar.burst       ),
+    .m_axi_arlock (host_axi_req.ar.lock        ),
+    .m_axi_arcache(host_axi_req.ar.cache       ),
+    .m_axi_arprot (host_axi_req.ar.prot        ),
+    .m_axi_arqos  (host_axi_req.ar.qos         ),
+    .m_axi_arvalid(host_axi_req.ar_valid       ),
+    .m_axi_arready(host_axi_resp.ar_ready      ),
+    .m_axi_rid    (host_axi_resp.r.id[0]       ),
+    .m_axi_rdata  (host_axi_resp.r.data        ),
+    .m_axi_rresp  (host_axi_resp.r.resp        ),
+    .m_axi_rlast  (host_axi_resp.r.last        ),
+    .m_axi_rvalid (host_axi_resp.r_valid       ),
+    .m_axi_rready (host_axi_req.r_ready        )
+  );
+
+  assign host_axi_req.aw.id               = axi_id_t'(host_axi_awid);
+  assign host_axi_req.aw.addr[63:32]      = '0;
+  assign host_axi_req.aw.region           = '0;
+  assign host_axi_req.aw.atop             = '0;
+  assign host_axi_req.aw.user             = '0;
+  assign host_axi_req.w.user              = '0;
+  assign host_axi_req.ar.id               = axi_id_t'(host_axi_arid);
+  assign host_axi_req.ar.addr[63:32]      = '0;
+  assign host_axi_req.ar.region           = '0;
+  assign host_axi_req.ar.user             = '0;
+
+  // The host accesses the main memory (1), or the control registers of the FPGA target (0)
+  host_req_t  [1:0] host_demux_axi_req;
+  host_resp_t [1:0] host_demux_axi_resp;
+
+  axi_demux #(
+    .AxiIdWidth (AxiIdWidth        ),
+    .aw_chan_t  (host_aw_chan_t    ),
+    .w_chan_t   (host_w_chan_t     ),
+    .b_chan_t   (host_b_chan_t     ),
+    .ar_chan_t  (host_ar_chan_t    ),
+    .r_chan_t   (host_r_chan_t     ),
+    .req_t      (host_req_t        ),
+    .resp_t     (host_resp_t       ),
+    .NoMstPorts (2                 ),
+    .MaxTrans   (4                 ),
+    .AxiLookBits(AxiIdWidth        )
+  ) i_host_demux (
+    .clk_i          (soc_clk                              ),
+    .rst_ni         (sys_rst_n                            ),
+    .test_i         (1'b0                                 ),
+    .slv_req_i      (host_axi_req                         ),
+    .slv_aw_select_i(host_axi_req.aw.addr >= DRAMBase     ),
+    .slv_ar_select_i(host_axi_req.ar.addr >= DRAMBase     ),
+    .slv_resp_o     (host_axi_resp                        ),
+    .mst_reqs_o     (host_demux_axi_req                   ),
+    .mst_resps_i    (host_demux_axi_resp                  )
+  );
+
+  //////////////////////////////
+  //  FPGA control registers  //
+  //////////////////////////////
+
+  host_lite_req_t  host_lite_req;
+  host_lite_resp_t host_lite_resp;
+
+  logic [63:0]  exit;
+  logic [63:0]  hw_cnt_en;
+  perf_events_t perf_events;
+
+  axi_to_axi_lite #(
+    .AxiAddrWidth   (AxiAddrWidth    ),
+    .AxiDataWidth   (HostDataWidth   ),
+    .AxiIdWidth     (AxiIdWidth      ),
+    .AxiUserWidth   (AxiUserWidth    ),
+    .AxiMaxReadTxns (1               ),
+    .AxiMaxWriteTxns(1               ),
+    .FallThrough    (1'b0            ),
+    .full_req_t     (host_req_t      ),
+    .full_resp_t    (host_resp_t     ),
+    .lite_req_t     (host_lite_req_t ),
+    .lite_resp_t    (host_lite_resp_t)
+  ) i_host_axi_to_axi_lite (
+    .clk_i     (soc_clk               ),
+    .rst_ni    (sys_rst_n             ),
+    .test_i    (1'b0                  ),
+    .slv_req_i (host_demux_axi_req[0] ),
+    .slv_resp_o(host_demux_axi_resp[0]),
+    .mst_req_o (host_lite_req         ),
+    .mst_resp_i(host_lite_resp        )
+  );
+
+  ara_fpga_ctrl #(
+    .DataWidth      (HostDataWidth   ),
+    .AddrWidth      (AxiAddrWidth    ),
+    .axi_lite_req_t (host_lite_req_t ),
+    .axi_lite_resp_t(host_lite_resp_t)
+  ) i_fpga_ctrl (
+    .clk_i                (soc_clk       ),
+    .rst_ni               (sys_rst_n     ),
+    .axi_lite_slave_req_i (host_lite_req ),
+    .axi_lite_slave_resp_o(host_lite_resp),
+    .soc_rst_o            (soc_rst       ),
+    .exit_i               (exit          ),
+    .hw_cnt_en_i          (hw_cnt_en     ),
+    .perf_events_i        (perf_events   )
+  );
+
+  ///////////
+  //  SoC  //
+  ///////////
+
+  soc_req_t  soc_dram_axi_req;
+  soc_resp_t soc_dram_axi_resp;
+
+  logic        uart_penable;
+  logic        uart_pwrite;
+  logic [31:0] uart_paddr;
+  logic        uart_psel;
+  logic [31:0] uart_pwdata;
+  logic [31:0] uart_prdata;
+  logic        uart_pready;
+  logic        uart_pslverr;
+
+  ara_soc #(
+    .NrLanes        (NrLanes     ),
+    .NrCores        (NrCores     ),
+    .AxiAddrWidth   (AxiAddrWidth),
+    .AxiDataWidth   (AxiDataWidth),
+    .AxiIdWidth     (AxiIdWidth  ),
+    .AxiUserWidth   (AxiUserWidth),
+    .dram_axi_req_t (soc_req_t   ),
+    .dram_axi_resp_t(soc_resp_t  )
+  ) i_ara_soc (
+    .clk_i          (soc_clk          ),
+    .rst_ni         (soc_rst_n        ),
+    .exit_o         (exit             ),
+    .hw_cnt_en_o    (hw_cnt_en        ),
+    .scan_enable_i  (1'b0             ),
+    .scan_data_i    (1'b0             ),
+    .scan_data_o    (/* Unused */     ),
+    // UART
+    .uart_penable_o (uart_penable     ),
+    .uart_pwrite_o  (uart_pwrite      ),
+    .uart_paddr_o   (uart_paddr       ),
+    .uart_psel_o    (uart_psel        ),
+    .uart_pwdata_o  (uart_pwdata      ),
+    .uart_prdata_i  (uart_prdata      ),
+    .uart_pready_i  (uart_pready      ),
+    .uart_pslverr_i (uart_pslverr     ),
+    // Main memory
+    .dram_axi_req_o (soc_dram_axi_req ),
+    .dram_axi_resp_i(soc_dram_axi_resp),
+    .perf_events_o  (perf_events      )
+  );
+
+  ////////////
+  //  UART  //
+  ////////////
+
+  ara_fpga_uart #(
+    .ClkFreqHz(SocFreqMHz * 1_000_000)
+  ) i_uart (
+    .clk_i    (soc_clk     ),
+    .rst_ni   (sys_rst_n   ),
+    .penable_i(uart_penable),
+    .pwrite_i (uart_pwrite ),
+    .paddr_i  (uart_paddr  ),
+    .psel_i   (uart_psel   ),
+    .pwdata_i (uart_pwdata ),
+    .prdata_o (uart_prdata ),
+    .pready_o (uart_pready ),
+    .pslverr_o(uart_pslverr),
+    .tx_o     (uart_tx_o   )
+  );
+
+  ///////////////////
+  //  Main memory  //
+  ///////////////////
+
+  // The memory accesses of the host are upsized to the wide AXI bus of the SoC
+  soc_req_t  host_dram_axi_req;
+  soc_resp_t host_dram_axi_resp;
+
+  axi_dw_converter #(
+    .AxiSlvPortDataWidth(HostDataWidth ),
+    .AxiMstPortDataWidth(AxiDataWidth  ),
+    .AxiAddrWidth       (AxiAddrWidth  ),
+    .AxiIdWidth         (AxiIdWidth    ),
+    .AxiMaxReads        (2             ),
+    .ar_chan_t          (host_ar_chan_t),
+    .mst_r_chan_t       (soc_r_chan_t  ),
+    .slv_r_chan_t       (host_r_chan_t ),
+    .aw_chan_t          (host_aw_chan_t),
+    .b_chan_t           (host_b_chan_t ),
+    .mst_w_chan_t       (soc_w_chan_t  ),
+    .slv_w_chan_t       (host_w_chan_t ),
+    .axi_mst_req_t      (soc_req_t     ),
+    .axi_mst_resp_t     (soc_resp_t    ),
+    .axi_slv_req_t      (host_req_t    ),
+    .axi_slv_resp_t     (host_resp_t   )
+  ) i_host_dram_dwc (
+    .clk_i     (soc_clk                ),
+    .rst_ni    (sys_rst_n              ),
+    .slv_req_i (host_demux_axi_req[1]  ),
+    .slv_resp_o(host_demux_axi_resp[1] ),
+    .mst_req_o (host_dram_axi_req      ),
+    .mst_resp_i(host_dram_axi_resp     )
+  );
+
+  mem_req_t  mem_axi_req;
+  mem_resp_t mem_axi_resp;
+
+  axi_mux #(
+    .SlvAxiIDWidth(AxiIdWidth    ),
+    .slv_ar_chan_t(soc_ar_chan_t ),
+    .slv_aw_chan_t(soc_aw_chan_t ),
+    .slv_b_chan_t (soc_b_chan_t  ),
+    .slv_r_chan_t (soc_r_chan_t  ),
+    .slv_req_t    (soc_req_t     ),
+    .slv_resp_t   (soc_resp_t    ),
+    .mst_ar_chan_t(mem_ar_chan_t ),
+    .mst_aw_chan_t(mem_aw_chan_t ),
+    .w_chan_t     (mem_w_chan_t  ),
+    .mst_b_chan_t (mem_b_chan_t  ),
+    .mst_r_chan_t (mem_r_chan_t  ),
+    .mst_req_t    (mem_req_t     ),
+    .mst_resp_t   (mem_resp_t    ),
+    .NoSlvPorts   (2             ),
+    .SpillAr      (1'b1          ),
+    .SpillR       (1'b1          ),
+    .SpillAw      (1'b1          ),
+    .SpillW       (1'b1          ),
+    .SpillB       (1'b1          )
+  ) i_dram_mux (
+    .clk_i      (soc_clk                                ),
+    .rst_ni     (sys_rst_n                              ),
+    .test_i     (1'b0                                   ),
+    .slv_reqs_i ({host_dram_axi_req, soc_dram_axi_req}  ),
+    .slv_resps_o({host_dram_axi_resp, soc_dram_axi_resp}),
+    .mst_req_o  (mem_axi_req                            ),
+    .mst_resp_i (mem_axi_resp                           )
+  );
+
+  // Resize to the data width of the DDR4 controller, and cross to its clock domain
+  mig_req_t  mig_soc_axi_req, mig_axi_req;
+  mig_resp_t mig_soc_axi_resp, mig_axi_resp;
+
+  axi_dw_converter #(
+    .AxiSlvPortDataWidth(AxiDataWidth ),
+    .AxiMstPortDataWidth(MigDataWidth ),
+    .AxiAddrWidth       (AxiAddrWidth ),
+    .AxiIdWidth         (MigIdWidth   ),
+    .AxiMaxReads        (4            ),
+    .ar_chan_t          (mem_ar_chan_t),
+    .mst_r_chan_t       (mig_r_chan_t ),
+    .slv_r_chan_t       (mem_r_chan_t ),
+    .aw_chan_t          (mem_aw_chan_t),
+    .b_chan_t           (mem_b_chan_t ),
+    .mst_w_chan_t       (mig_w_chan_t ),
+    .slv_w_chan_t       (mem_w_chan_t ),
+    .axi_mst_req_t      (mig_req_t    ),
+    .axi_mst_resp_t     (mig_resp_t   ),
+    .axi_slv_req_t      (mem_req_t    ),
+    .axi_slv_resp_t     (mem_resp_t   )
+  ) i_dram_dwc (
+    .clk_i     (soc_clk         ),
+    .rst_ni    (sys_rst_n       ),
+    .slv_req_i (mem_axi_req     ),
+    .slv_resp_o(mem_axi_resp    ),
+    .mst_req_o (mig_soc_axi_req ),
+    .mst_resp_i(mig_soc_axi_resp)
+  );
+
+  axi_cdc #(
+    .aw_chan_t (mig_aw_chan_t),
+    .w_chan_t  (mig_w_chan_t ),
+    .b_chan_t  (mig_b_chan_t ),
+    .ar_chan_t (mig_ar_chan_t),
+    .r_chan_t  (mig_r_chan_t ),
+    .axi_req_t (mig_req_t    ),
+    .axi_resp_t(mig_resp_t   ),
+    .LogDepth  (3            )
+  ) i_dram_cdc (
+    .src_clk_i (soc_clk         ),
+    .src_rst_ni(sys_rst_n       ),
+    .src_req_i (mig_soc_axi_req ),
+    .src_resp_o(mig_soc_axi_resp),
+    .dst_clk_i (mig_clk         ),
+    .dst_rst_ni(~mig_rst        ),
+    .dst_req_o (mig_axi_req     ),
+    .dst_resp_i(mig_axi_resp    )
+  );
+
+  // The DDR4 controller sees the offsets in the DRAM region
+  logic [MigAddrWidth-1:0] mig_awaddr, mig_araddr;
+  assign mig_awaddr = MigAddrWidth'(mig_axi_req.aw.addr & (DRAMLength - 1));
+  assign mig_araddr = MigAddrWidth'(mig_axi_req.ar.addr & (DRAMLength - 1));
+
+  xlnx_mig_ddr4 i_ddr4 (
+    .c0_sys_clk_p             (c0_sys_clk_p          ),
+    .c0_sys_clk_n             (c0_sys_clk_n          ),
+    .sys_rst                  (cpu_reset             ),
+    .c0_init_calib_complete   (mig_calib_done        ),
+    .c0_ddr4_ui_clk           (mig_clk               ),
+    .c0_ddr4_ui_clk_sync_rst  (mig_rst               ),
+    .addn_ui_clkout1          (soc_clk               ),
+    .dbg_clk                  (/* Unused */          ),
+    .dbg_bus                  (/* Unused */          ),
+    // DDR4
+    .c0_ddr4_act_n            (c0_ddr4_act_n         ),
+    .c0_ddr4_adr              (c0_ddr4_adr           ),
+    .c0_ddr4_ba               (c0_ddr4_ba            ),
+    .c0_ddr4_bg               (c0_ddr4_bg            ),
+    .c0_ddr4_cke              (c0_ddr4_cke           ),
+    .c0_ddr4_odt              (c0_ddr4_odt           ),
+    .c0_ddr4_cs_n             (c0_ddr4_cs_n          ),
+    .c0_ddr4_ck_t             (c0_ddr4_ck_t          ),
+    .c0_ddr4_ck_c             (c0_ddr4_ck_c          ),
+    .c0_ddr4_reset_n          (c0_ddr4_reset_n       ),
+    .c0_ddr4_dm_dbi_n         (c0_ddr4_dm_dbi_n      ),
+    .c0_ddr4_dq               (c0_ddr4_dq            ),
+    .c0_ddr4_dqs_t            (c0_ddr4_dqs_t         ),
+    .c0_ddr4_dqs_c            (c0_ddr4_dqs_c         ),
+    // AXI
+    .c0_ddr4_aresetn          (~mig_rst              ),
+    .c0_ddr4_s_axi_awid       (mig_axi_req.aw.id     ),
+    .c0_ddr4_s_axi_awaddr     (mig_awaddr            ),
+    .c0_ddr4_s_axi_awlen      (mig_axi_req.aw.len    ),
+    .c0_ddr4_s_axi_awsize     (mig_axi_req.aw.size   ),
+    .c0_ddr4_s_axi_awburst    (mig_axi_req.aw.burst  ),
+    .c0_ddr4_s_axi_awlock     (mig_axi_req.aw.lock   ),
+    .c0_ddr4_s_axi_awcache    (mig_axi_req.aw.cache  ),
+    .c0_ddr4_s_axi_awprot     (mig_axi_req.aw.prot   ),
+    .c0_ddr4_s_axi_awqos      (mig_axi_req.aw.qos    ),
+    .c0_ddr4_s_axi_awvalid    (mig_axi_req.aw_valid  ),
+    .c0_ddr4_s_axi_awready    (mig_axi_resp.aw_ready ),
+    .c0_ddr4_s_axi_wdata      (mig_axi_req.w.data    ),
+    .c0_ddr4_s_axi_wstrb      (mig_axi_req.w.strb    ),
+    .c0_ddr4_s_axi_wlast      (mig_axi_req.w.last    ),
+    .c0_ddr4_s_axi_wvalid     (mig_axi_req.w_valid   ),
+    .c0_ddr4_s_axi_wready     (mig_axi_resp.w_ready  ),
+    .c0_ddr4_s_axi_bready     (mig_axi_req.b_ready   ),
+    .c0_ddr4_s_axi_bid        (mig_axi_resp.b.id     ),
+    .c0_ddr4_s_axi_bresp      (mig_axi_resp.b.resp   ),
+    .c0_ddr4_s_axi_bvalid     (mig_axi_resp.b_valid  ),
+    .c0_ddr4_s_axi_arid       (mig_axi_req.ar.id     ),
+    .c0_ddr4_s_axi_araddr     (mig_araddr            ),
+    .c0_ddr4_s_axi_arlen      (mig_axi_req.ar.len    ),
+    .c0_ddr4_s_axi_arsize     (mig_axi_req.ar.size   ),
+    .c0_ddr4_s_axi_arburst    (mig_axi_req.ar.burst  ),
+    .c0_ddr4_s_axi_arlock     (mig_axi_req.ar.lock   ),
+    .c0_ddr4_s_axi_arcache    (mig_axi_req.ar.cache  ),
+    .c0_ddr4_s_axi_arprot     (mig_axi_req.ar.prot   ),
+    .c0_ddr4_s_axi_arqos      (mig_axi_req.ar.qos    ),
+    .c0_ddr4_s_axi_arvalid    (mig_axi_req.ar_valid  ),
+    .c0_ddr4_s_axi_arready    (mig_axi_resp.ar_ready ),
+    .c0_ddr4_s_axi_rready     (mig_axi_req.r_ready   ),
+    .c0_ddr4_s_axi_rlast      (mig_axi_resp.r.last   ),
+    .c0_ddr4_s_axi_rvalid     (mig_axi_resp.r_valid  ),
+    .c0_ddr4_s_axi_rresp      (mig_axi_resp.r.resp   ),
+    .c0_ddr4_s_axi_rid        (mig_axi_resp.r.id     ),
+    .c0_ddr4_s_axi_rdata      (mig_axi_resp.r.data   )
+  );
+
+  assign mig_axi_resp.b.user = '0;
+  assign mig_axi_resp.r.user = '0;
+
+  //////////////
+  //  Status  //
+  //////////////
+
+  // Calibration done, SoC out of reset, and hardware counter enabled
+  assign led_o = {5'b0, hw_cnt_en[0], soc_rst_n, mig_calib_done};
+
+endmodule : ara_xilinx
@@ -25,10 +25,11 @@ package ara_pkg;
   localparam int unsigned MAXVL = VLEN; // SEW = EW8, LMUL = 8. VL = 8 * VLEN / 8 = VLEN.
 
   // Number of vector instructions that can run in parallel.
-  localparam int unsigned NrVInsn = 8;
+  // It sizes the vector instruction IDs and the hazard tables. Up to 32.
+  localparam int unsigned NrVInsn = `ifdef NR_VINSN `NR_VINSN `else 8 `endif;
 
   // Maximum number of lanes that Ara can support.
-  localparam int unsigned MaxNrLanes = 16;
+  localparam int unsigned MaxNrLanes = 64;
 
   // Ara Features.
 
@@ -68,36 +69,159 @@ package ara_pkg;
     return e[0];
   endfunction : RVVH
 
+  // Support for BF16, selected by vtype.altfmt with SEW = 16. It needs the FP16 and FP32 support.
+  localparam bit FPAltFmtSupport = `ifdef FP_ALTFMT `FP_ALTFMT `else 0 `endif;
+
+  // Pipeline registers added to the multipliers and to the FMA units of the FPU, which the
+  // synthesis tool retimes, for a higher clock frequency at the cost of latency.
+  localparam int unsigned MulPipeRegs = `ifdef MUL_PIPE_REGS `MUL_PIPE_REGS `else 0 `endif;
+  localparam int unsigned FpuPipeRegs = `ifdef FPU_PIPE_REGS `FPU_PIPE_REGS `else 0 `endif;
+
+  // Cut the results of the SLDU and of the MASKU at the lanes with a spill register, i.e.,
+  // also their grant, instead of a stream register. This costs one cycle on the all-to-all
+  // paths of the permutations and of the mask instructions.
+  localparam bit SlideMaskCut = `ifdef SLIDE_MASK_CUT `SLIDE_MASK_CUT `else 0 `endif;
+
+  // Cut the requests of the main sequencer at the lanes with a spill register, instead of a
+  // fall-through register. This costs one cycle to the start of each instruction in the lanes.
+  localparam bit PeReqCut = `ifdef PE_REQ_CUT `PE_REQ_CUT `else 0 `endif;
+
   // Multiplier latencies.
-  localparam int unsigned LatMultiplierEW64 = 1;
-  localparam int unsigned LatMultiplierEW32 = 1;
-  localparam int unsigned LatMultiplierEW16 = 1;
-  localparam int unsigned LatMultiplierEW8  = 0;
+  localparam int unsigned LatMultiplierEW64 = 1 + MulPipeRegs;
+  localparam int unsigned LatMultiplierEW32 = 1 + MulPipeRegs;
+  localparam int unsigned LatMultiplierEW16 = 1 + MulPipeRegs;
+  localparam int unsigned LatMultiplierEW8  = 0 + MulPipeRegs;
 
   // FPU latencies.
-  localparam int unsigned LatFCompEW64    = 'd5;
-  localparam int unsigned LatFCompEW32    = 'd4;
-  localparam int unsigned LatFCompEW16    = 'd3;
-  localparam int unsigned LatFCompEW8     = 'd2;
-  localparam int unsigned LatFCompEW16Alt = 'd3;
+  localparam int unsigned LatFCompEW64    = 'd5 + FpuPipeRegs;
+  localparam int unsigned LatFCompEW32    = 'd4 + FpuPipeRegs;
+  localparam int unsigned LatFCompEW16    = 'd3 + FpuPipeRegs;
+  localparam int unsigned LatFCompEW8     = 'd2 + FpuPipeRegs;
+  localparam int unsigned LatFCompEW16Alt = 'd3 + FpuPipeRegs;
   localparam int unsigned LatFDivSqrt     = 'd3;
   localparam int unsigned LatFNonComp     = 'd1;
   localparam int unsigned LatFConv        = 'd2;
   // Define the maximum FPU latency
   localparam int unsigned LatFMax = LatFCompEW64;
 
-  // Define the maximum instruction queue depth
-  localparam MaxVInsnQueueDepth = 4;
-  // FUs instruction queue depth.
-  localparam int unsigned MfpuInsnQueueDepth = 4;
-  localparam int unsigned ValuInsnQueueDepth = 4;
-  localparam int unsigned VlduInsnQueueDepth = 4;
-  localparam int unsigned VstuInsnQueueDepth = 4;
-  localparam int unsigned VaddrgenInsnQueueDepth = 4;
-  localparam int unsigned SlduInsnQueueDepth = 2;
+  // Divide the elements of a 64-bit word in parallel (simd_pardiv), instead of one after
+  // the other (simd_div). This takes the area of 2.5 64-bit serial dividers.
+  localparam bit SimdDivParallel = `ifdef DIV_PARALLEL `DIV_PARALLEL `else 0 `endif;
+
+  // Floating-point division and square root units of each lane. With more than one, they
+  // take the words of vfdiv, vfrdiv, and vfsqrt in round-robin order, in parallel.
+  localparam int unsigned FDivSqrtUnits = `ifdef FDIVSQRT_UNITS `FDIVSQRT_UNITS `else 1 `endif;
+
+  // A second VMFPU in each lane, with its own operand queues and VRF port. The main sequencer
+  // sends the unmasked floating-point instructions that are not reductions to the VMFPU with
+  // fewer instructions in its queue, so that two independent ones run at the same time.
+  localparam bit DualMfpu = `ifdef DUAL_MFPU `DUAL_MFPU `else 0 `endif;
+
+  // Tiles of the matrix outer-product unit (MXU) of each lane, from 0 (no MXU) to 16. A tile
+  // holds two rows of one FP32 vector register. vfmop[a].vx accumulates the outer product of
+  // two FP32 scalars with vs2 in a tile, and vfmtr.vx moves one of its rows to vd.
+  localparam int unsigned MxuTiles = `ifdef MXU_TILES `MXU_TILES `else 0 `endif;
+
+  // The SLDU reduces the partial results of all the lanes of an integer reduction with an
+  // adder tree, in a single transaction, instead of log2(NrLanes) + 1 slides.
+  localparam bit SlduRedTree = `ifdef SLDU_RED_TREE `SLDU_RED_TREE `else 1 `endif;
+
+  // Acknowledge vmv.x.s, vfmv.f.s, vcpop.m, and vfirst.m right away, and send their scalar
+  // result to CVA6 later, with their transaction ID, so that the next vector instructions can
+  // be issued in the meanwhile. CVA6 must accept such out-of-order answers.
+  localparam bit ScalarRespAsync = `ifdef SCALAR_RESP_ASYNC `SCALAR_RESP_ASYNC `else 0 `endif;
+
+  // Coalesce the constant-strided loads with a small power-of-two stride into full-width
+  // AXI bursts over their footprint. The VLDU extracts their elements from the R beats.
+  // The strided loads with rs2 = x0 read their element with a single AXI beat, and the VLDU
+  // replicates it, as the RVV spec allows (a zero stride in another register does not).
+  localparam bit StridedCoalesce = `ifdef STRIDED_COALESCE `STRIDED_COALESCE `else 1 `endif;
+
+  // An indexed load reads an AXI-width block only once for consecutive elements, if the block
+  // is one of the last IdxCoalesceWindow ones that the unordered load (vluxei) read, or the
+  // last one for the ordered load (vloxei). 0 disables the coalescing.
+  localparam int unsigned IdxCoalesceWindow = `ifdef IDX_COALESCE_WINDOW `IDX_COALESCE_WINDOW `else 4 `endif;
+
+  // Element addresses made per cycle for the indexed loads and the strided loads that are not
+  // coalesced, up to NrLanes. The consecutive elements that fall in the same AXI-width block
+  // share one AXI request, and the VLDU takes them from its R beat in the same cycle.
+  localparam int unsigned MemAddrsPerCycle = `ifdef MEM_ADDRS_PER_CYCLE `MEM_ADDRS_PER_CYCLE `else 8 `endif;
+
+  // The elements of the strided and indexed stores (not the atomic ones) go through a write-
+  // combining buffer in the VSTU, which merges the consecutive elements of an AXI-width block
+  // into one full-width W beat, with its byte strobes, and one AW.
+  localparam bit StoreCombine = `ifdef STORE_COMBINE `STORE_COMBINE `else 1 `endif;
+
+  // Gate the clock of the VALU and VMFPU of each lane, and of the slide unit, while they
+  // have no instruction to execute.
+  localparam bit FuClkGating = `ifdef FU_CLK_GATING `FU_CLK_GATING `else 1 `endif;
+
+  // The lanes without elements of an unmasked instruction for the VALU or the VMFPU drop it as
+  // soon as it arrives, without reading its operands, and the main sequencer does not wait for
+  // them to finish it.
+  localparam bit ShortVlFastPath = `ifdef SHORT_VL_FAST_PATH `SHORT_VL_FAST_PATH `else 1 `endif;
+
+  // The slides by one element (vslide1up, vslide1down, and the .vi/.vx slides by one) chain with
+  // the instruction that produces their source, instead of waiting for it to finish.
+  localparam bit Slide1Chain = `ifdef SLIDE1_CHAIN `SLIDE1_CHAIN `else 1 `endif;
+
+  // Mask beats of the mask cache of each lane (lane_mask_cache.sv). It keeps the mask bits of the
+  // last masked VALU/VMFPU instruction, so that the next ones with the same vl and SEW run under
+  // the unchanged v0 without reading it and without the Mask Unit. Zero disables the cache.
+  localparam int unsigned MaskCacheBeats = `ifdef MASK_CACHE_BEATS `MASK_CACHE_BEATS `else 0 `endif;
+
+  // FUs instruction queue depth. They are set by the configuration (config/*.mk).
+  localparam int unsigned MfpuInsnQueueDepth = `ifdef MFPU_INSN_QUEUE_DEPTH `MFPU_INSN_QUEUE_DEPTH `else 4 `endif;
+  localparam int unsigned ValuInsnQueueDepth = `ifdef VALU_INSN_QUEUE_DEPTH `VALU_INSN_QUEUE_DEPTH `else 4 `endif;
+  localparam int unsigned VlduInsnQueueDepth = `ifdef VLDU_INSN_QUEUE_DEPTH `VLDU_INSN_QUEUE_DEPTH `else 4 `endif;
+  localparam int unsigned VstuInsnQueueDepth = `ifdef VSTU_INSN_QUEUE_DEPTH `VSTU_INSN_QUEUE_DEPTH `else 4 `endif;
+  // AXI bursts in flight in the VLSU. Their data is received in order.
+  localparam int unsigned VaddrgenInsnQueueDepth = `ifdef AXI_OUTSTANDING `AXI_OUTSTANDING `else 4 `endif;
+  // Unit-strided and strided memory operations whose address generation was acknowledged,
+  // but did not start yet. They let the address generator run ahead of the AXI requests.
+  localparam int unsigned VaddrgenReqQueueDepth = 2;
+  // AXI R beats buffered before the load unit, so that memory does not wait for the lanes.
+  localparam int unsigned VlduRBufDepth = 4;
+  localparam int unsigned SlduInsnQueueDepth = `ifdef SLDU_INSN_QUEUE_DEPTH `SLDU_INSN_QUEUE_DEPTH `else 2 `endif;
   localparam int unsigned NoneInsnQueueDepth = 1;
-  // Ara supports MaskuInsnQueueDepth = 1 only.
-  localparam int unsigned MaskuInsnQueueDepth = 1;
+  // The MASKU runs one instruction at a time. The others wait in its queue.
+  localparam int unsigned MaskuInsnQueueDepth = `ifdef MASKU_INSN_QUEUE_DEPTH `MASKU_INSN_QUEUE_DEPTH `else 1 `endif;
+  // Define the maximum instruction queue depth
+  function automatic int unsigned max_depth(int unsigned a, int unsigned b);
+    max_depth = a > b ? a : b;
+  endfunction : max_depth
+  localparam int unsigned MaxVInsnQueueDepth = max_depth(max_depth(max_depth(MfpuInsnQueueDepth,
+    ValuInsnQueueDepth), max_depth(VlduInsnQueueDepth, VstuInsnQueueDepth)),
+    max_depth(SlduInsnQueueDepth, MaskuInsnQueueDepth));
+
+  // Spare vector registers of the VRF, on top of the 32 architectural ones. With spare registers,
+  // ara_rename.sv writes the instructions that overwrite a whole register to a free physical
+  // register, so that they do not wait for the readers and the writer of the old value.
+  localparam int unsigned NrSpareVRegs = `ifdef VRF_SPARE_REGS `VRF_SPARE_REGS `else 0 `endif;
+  localparam int unsigned NrPhysVRegs  = 32 + NrSpareVRegs;
+
+  // Vector instructions buffered between Ariane and the dispatcher (ara_insn_queue.sv). With a
+  // queue, the arithmetic instructions without a scalar result are acknowledged to Ariane as
+  // soon as they enter it. Zero connects Ariane to the dispatcher directly.
+  localparam int unsigned AccQueueDepth = `ifdef ACC_QUEUE_DEPTH `ACC_QUEUE_DEPTH `else 0 `endif;
+
+  // Instructions of the loop buffer in front of the dispatcher (ara_loop_buffer.sv), which replays
+  // the body of a strip-mined loop between vlbeg.vx and vlend.vx. Zero disables it, and makes
+  // vlbeg.vx and vlend.vx illegal.
+  localparam int unsigned LoopBufDepth = `ifdef LOOP_BUF_DEPTH `LOOP_BUF_DEPTH `else 0 `endif;
+
+  // Bytes of the vector cache between Ara and the L2 (ara_vcache.sv), whose lines are as wide as
+  // Ara's AXI data bus. The number of lines must be a power of two. Zero disables the cache.
+  localparam int unsigned VCacheSize = `ifdef VCACHE_SIZE `VCACHE_SIZE `else 0 `endif;
+
+  // AXI beats of the buffer of the stream prefetcher between Ara and the L2 (ara_prefetcher.sv),
+  // which reads ahead the bursts of the streams with a constant stride. Zero disables it.
+  localparam int unsigned PrefetchBeats = `ifdef PREFETCH_BEATS `PREFETCH_BEATS `else 0 `endif;
+
+  // Entries of the VLSU's TLB (vlsu_tlb.sv), which translates the virtual addresses of the vector
+  // memory operations with CVA6's MMU, one 4 KiB page at a time. Zero supports only physical
+  // addresses.
+  localparam int unsigned VlsuTlbEntries = `ifdef VLSU_TLB_ENTRIES `VLSU_TLB_ENTRIES `else 0 `endif;
 
   ///////////////////
   //  Definitions  //
@@ -105,6 +229,8 @@ package ara_pkg;
 
   typedef logic [$clog2(MAXVL+1)-1:0] vlen_t;
   typedef logic [$clog2(NrVInsn)-1:0] vid_t;
+  // Physical vector register. The first 32 are the homes of the architectural registers.
+  typedef logic [$clog2(NrPhysVRegs)-1:0] vreg_t;
   typedef logic [ELEN-1:0] elen_t;
 
   //////////////////
@@ -118,6 +244,8 @@ package ara_pkg;
     VSADDU, VSADD, VSSUBU, VSSUB, VAADDU, VAADD, VASUBU, VASUB, VSSRL, VSSRA, VNCLIP, VNCLIPU,
     // Shifts,
     VSLL, VSRL, VSRA, VNSRL, VNSRA,
+    // Bit manipulation (Zvbb)
+    VANDN, VROL, VROR, VBREV8, VREV8, VBREV, VCLZ, VCTZ, VCPOPV,
     // Merge
     VMERGE,
     // Scalar moves to VRF
@@ -126,6 +254,8 @@ package ara_pkg;
     VREDSUM, VREDAND, VREDOR, VREDXOR, VREDMINU, VREDMIN, VREDMAXU, VREDMAX, VWREDSUMU, VWREDSUM,
     // Mul/Mul-Add
     VMUL, VMULH, VMULHU, VMULHSU, VMACC, VNMSAC, VMADD, VNMSUB,
+    // Dot products
+    VQDOT, VQDOTU, VQDOTSU, VQDOTUS,
     // Fixed point multiplication
     VSMUL,
     // Div
@@ -144,6 +274,10 @@ package ara_pkg;
     VMADC, VMSBC,
     // Mask operations
     VMANDNOT, VMAND, VMOR, VMXOR, VMORNOT, VMNAND, VMNOR, VMXNOR,
+    // Permutation instructions
+    VRGATHER, VRGATHEREI16, VCOMPRESS,
+    // Vector crypto (Zvkned, Zvknha, Zvkg), on element groups of four 32-bit elements
+    VAESKF1, VAESEF, VAESEM, VAESDF, VAESDM, VAESZ, VAESKF2, VSHA2MS, VSHA2CH, VSHA2CL, VGHSH, VGMUL,
     // Scalar moves from VRF
     VMVXS, VFMVFS,
     // Slide instructions
@@ -151,7 +285,11 @@ package ara_pkg;
     // Load instructions
     VLE, VLSE, VLXE,
     // Store instructions
-    VSE, VSSE, VSXE
+    VSE, VSSE, VSXE,
+    // Vector atomic operations, i.e., indexed stores with an atomic update of each element
+    VAMOADD, VAMOAND, VAMOOR, VAMOXOR, VAMOMIN, VAMOMAX, VAMOMINU, VAMOMAXU,
+    // Matrix outer products, on the tiles of the MXU
+    VFMOP, VFMOPA, VFMTR
   } ara_op_e;
 
   // Return true if op is a load operation
@@ -161,7 +299,7 @@ package ara_pkg;
 
   // Return true if op is a store operation
   function automatic is_store(ara_op_e op);
-    is_store = op inside {[VSE:VSXE]};
+    is_store = op inside {[VSE:VAMOMAXU]};
   endfunction : is_store
 
   // Return true of op is either VCPOP or VFIRST
@@ -169,6 +307,11 @@ package ara_pkg;
     vd_scalar = op inside {[VCPOP:VFIRST]};
   endfunction : vd_scalar
 
+  // Return true if op writes a tile of the MXU, and not a vector register
+  function automatic writes_tile(ara_op_e op);
+    writes_tile = op inside {[VFMOP:VFMOPA]};
+  endfunction : writes_tile
+
   typedef enum logic [1:0] {
     NO_RED,
     ALU_RED,
@@ -268,13 +411,13 @@ package ara_pkg;
     rvv_pkg::vew_e eew_vmask;
 
     // 1st vector register operand
-    logic [4:0] vs1;
+    vreg_t vs1;
     logic use_vs1;
     opqueue_conversion_e conversion_vs1;
     rvv_pkg::vew_e eew_vs1;
 
     // 2nd vector register operand
-    logic [4:0] vs2;
+    vreg_t vs2;
     logic use_vs2;
     opqueue_conversion_e conversion_vs2;
     rvv_pkg::vew_e eew_vs2;
@@ -291,9 +434,14 @@ package ara_pkg;
     // slides
     elen_t stride;
     logic is_stride_np2;
+    // Indexed load with ordered accesses (vloxei)
+    logic is_ordered;
+    // Strided load with rs2 = x0, which reads its element once (see StridedCoalesce). Vector
+    // crypto .vs form, which reads the element group 0 of vs2 for all the element groups.
+    logic is_broadcast;
 
     // Destination vector register
-    logic [4:0] vd;
+    vreg_t vd;
     logic use_vd;
 
     // If asserted: vs2 is kept in MulFPU opqueue C, and vd_op in MulFPU A
@@ -329,6 +477,45 @@ package ara_pkg;
     vlen_t error_vl;
   } ara_resp_t;
 
+  //////////////////////////
+  //  Performance events  //
+  //////////////////////////
+
+  // Events counted by the hardware performance counters of the SoC.
+  // Each field is high during the cycles in which the event happens.
+  // The last field is bit 0, and bit i is counted by the i-th counter.
+  typedef struct packed {
+    logic vmfpu2_clk_on;       // Clock of the second VMFPU enabled, in any lane
+    logic vrf_rw_conflict;     // A read and a write of the VRF target the same bank, in any lane
+    logic vmxu_busy;           // Instructions in the queue of the MXU
+    logic vmfpu2_busy;         // Instructions in the queue of the second VMFPU
+    logic st_wcb_beat;         // W beat of the write-combining buffer of the VSTU
+    logic st_merge;            // Store element merged into the beat of the write-combining buffer
+    logic prefetch_hit;        // R beat of the VLSU answered from the prefetch buffer
+    logic prefetch_beat;       // R beat of a prefetch from the L2
+    logic vcache_miss;         // R beat of the VLSU from the L2, through the vector cache
+    logic vcache_hit;          // R beat of the VLSU answered by the vector cache
+    logic acc_early_ack;       // An instruction is acknowledged to CVA6 as it enters the queue
+    logic sldu_clk_on;         // Clock of the slide unit enabled
+    logic vmfpu_clk_on;        // Clock of the VMFPU enabled, in any lane
+    logic valu_clk_on;         // Clock of the VALU enabled, in any lane
+    logic acc_req_stall;       // CVA6 has a valid request that Ara does not accept
+    logic axi_w_beat;          // AXI W beat of the VLSU
+    logic axi_r_beat;          // AXI R beat of the VLSU
+    logic vrf_bank_conflict;   // Some VRF bank has more requests than it can grant, in any lane
+    logic stall_hazard;        // The sequencer waits on a hazard before issuing
+    logic stall_vinsn_full;    // The sequencer has no free instruction ID
+    logic stall_lanes_desynch; // The sequencer waits for the lanes to synchronize
+    logic masku_busy;          // Instructions in the queue of each unit
+    logic sldu_busy;
+    logic vstu_busy;
+    logic vldu_busy;
+    logic vmfpu_busy;
+    logic valu_busy;
+  } perf_events_t;
+
+  localparam int unsigned NrPerfEvents = $bits(perf_events_t);
+
   ////////////////////
   //  PE interface  //
   ////////////////////
@@ -338,9 +525,9 @@ package ara_pkg;
   // It is important that all the VFUs that can write back to the VRF
   // are grouped towards the beginning of the enumeration. The store unit
   // cannot do so, therefore it is at the end of the enumeration.
-  localparam int unsigned NrVFUs = 7;
+  localparam int unsigned NrVFUs = 9;
   typedef enum logic [$clog2(NrVFUs)-1:0] {
-    VFU_Alu, VFU_MFpu, VFU_SlideUnit, VFU_MaskUnit, VFU_LoadUnit, VFU_StoreUnit, VFU_None
+    VFU_Alu, VFU_MFpu, VFU_MFpu2, VFU_MxUnit, VFU_SlideUnit, VFU_MaskUnit, VFU_LoadUnit, VFU_StoreUnit, VFU_None
   } vfu_e;
 
   // Internally, each lane is treated as a processing element, between indexes
@@ -367,13 +554,13 @@ package ara_pkg;
     logic scale_vl;
 
     // 1st vector register operand
-    logic [4:0] vs1;
+    vreg_t vs1;
     logic use_vs1;
     opqueue_conversion_e conversion_vs1;
     rvv_pkg::vew_e eew_vs1;
 
     // 2nd vector register operand
-    logic [4:0] vs2;
+    vreg_t vs2;
     logic use_vs2;
     opqueue_conversion_e conversion_vs2;
     rvv_pkg::vew_e eew_vs2;
@@ -392,9 +579,14 @@ package ara_pkg;
     // 2nd scalar operand: stride for constant-strided vector load/stores
     elen_t stride;
     logic is_stride_np2;
+    // Indexed load with ordered accesses (vloxei)
+    logic is_ordered;
+    // Strided load with rs2 = x0, which reads its element once (see StridedCoalesce). Vector
+    // crypto .vs form, which reads the element group 0 of vs2 for all the element groups.
+    logic is_broadcast;
 
     // Destination vector register
-    logic [4:0] vd;
+    vreg_t vd;
     logic use_vd;
 
     // Effective length multiplier
@@ -417,6 +609,11 @@ package ara_pkg;
     logic [NrVInsn-1:0] hazard_vs2;
     logic [NrVInsn-1:0] hazard_vm;
     logic [NrVInsn-1:0] hazard_vd;
+
+    // The lanes keep the mask bits of this masked instruction in their mask cache (mask_fill), or
+    // take them from there (mask_hit)
+    logic mask_fill;
+    logic mask_hit;
   } pe_req_t;
 
   typedef struct packed {
@@ -869,7 +1066,17 @@ package ara_pkg;
             return idx[byte_idx[6:0]];
           end
         endcase
-      default: $error("Error. Supported number of lanes are 1, 2, 4, 8, 16.");
+      // Same layout as the tables above. The element e goes to the slot e / NrLanes of the lane
+      // e % NrLanes, and the slots are stored in the 64-bit word of the lane in bit-reversed order.
+      default: begin
+        automatic int unsigned bytes = 1 << int'(ew);
+        automatic int unsigned elem  = (byte_idx % (8*NrLanes)) / bytes;
+        automatic int unsigned slot  = elem / NrLanes;
+        automatic int unsigned pos   = 0;
+        for (int i = 0; i < 3 - int'(ew); i++)
+          pos |= ((slot >> i) & 1) << (2 - int'(ew) - i);
+        return 8*(elem % NrLanes) + bytes*pos + byte_idx % bytes;
+      end
     endcase
 
   /*automatic vlen_t [8*MaxNrLanes-1:0] element_shuffle_index;
@@ -930,11 +1137,15 @@ package ara_pkg;
           index[shuffle_index(b, NrLanes, ew)] = b;
         return index[byte_index[6:0]];
       end
+      // Inverse of the default shuffling
       default: begin
-        automatic vlen_t [31:0] index;
-        for (int b = 0; b < 32; b++)
-          index[shuffle_index(b, NrLanes, ew)] = b;
-        return index[byte_index[4:0]];
+        automatic int unsigned bytes = 1 << int'(ew);
+        automatic int unsigned idx   = byte_index % (8*NrLanes);
+        automatic int unsigned pos   = (idx % 8) / bytes;
+        automatic int unsigned slot  = 0;
+        for (int i = 0; i < 3 - int'(ew); i++)
+          slot |= ((pos >> i) & 1) << (2 - int'(ew) - i);
+        return bytes*(slot*NrLanes + idx / 8) + idx % bytes;
       end
     endcase
   endfunction : deshuffle_index
@@ -967,24 +1178,36 @@ package ara_pkg;
   //  Lane definitions  //
   ////////////////////////
 
-  // There are seven operand queues, serving operands to the different functional units of each lane
-  localparam int unsigned NrOperandQueues = 9;
+  // There are twelve operand queues, serving operands to the different functional units of each
+  // lane. The ones of the second VMFPU are only instantiated with DualMfpu.
+  localparam int unsigned NrOperandQueues = 12;
   typedef enum logic [$clog2(NrOperandQueues)-1:0] {
-    AluA, AluB, MulFPUA, MulFPUB, MulFPUC, MaskB, MaskM, StA, SlideAddrGenA
+    AluA, AluB, MulFPUA, MulFPUB, MulFPUC, MulFPU2A, MulFPU2B, MulFPU2C, MaskB, MaskM, StA, SlideAddrGenA
   } opqueue_e;
 
-  // Each lane has eight VRF banks
-  localparam int unsigned NrVRFBanksPerLane = 8;
+  // Each lane has eight VRF banks. Define VRF_BANKS for another power of two.
+  localparam int unsigned NrVRFBanksPerLane = `ifdef VRF_BANKS `VRF_BANKS `else 8 `endif;
+  // Give each VRF bank a read and a write port (1R1W). The operand queues then only compete
+  // among themselves for the read port, and the VFU results for the write port, so that the
+  // operands of the FMAs and the stores no longer wait for the writebacks of the loads.
+  // Define VRF_DUAL_PORT=1 for it.
+  localparam bit VrfDualPort = `ifdef VRF_DUAL_PORT `VRF_DUAL_PORT `else 0 `endif;
+  // Hash the vector register ID into the VRF bank index, so that the same element of
+  // registers that are a multiple of eight apart (e.g., v0, v8, v16, and v24) is in
+  // different banks. Define VRF_BANK_HASH=0 for the plain interleaving.
+  localparam bit VrfBankHash = `ifdef VRF_BANK_HASH `VRF_BANK_HASH `else 1 `endif;
 
   // Find the starting address of a vector register vid
-  function automatic logic [63:0] vaddr(logic [4:0] vid, int NrLanes);
+  function automatic logic [63:0] vaddr(vreg_t vid, int NrLanes);
     vaddr = vid * (VLENB / NrLanes / 8);
   endfunction: vaddr
 
-  // Differenciate between SLDU and ADDRGEN operands from opqueue
-  typedef enum logic {
-    ALU_SLDU     = 1'b0,
-    MFPU_ADDRGEN = 1'b1
+  // Differenciate between SLDU and ADDRGEN operands from opqueue, and between the VMFPU and
+  // the MXU for the MulFPUA opqueue
+  typedef enum logic [1:0] {
+    ALU_SLDU     = 2'b00,
+    MFPU_ADDRGEN = 2'b01,
+    MXU          = 2'b10
   } target_fu_e;
 
   // This is the interface between the lane's sequencer and the operand request stage, which
@@ -992,7 +1215,7 @@ package ara_pkg;
   typedef struct packed {
     vid_t id; // ID of the vector instruction
 
-    logic [4:0] vs; // Vector register operand
+    vreg_t vs; // Vector register operand
 
     logic scale_vl; // Rescale vl taking into account the new and old EEW
 
@@ -1021,6 +1244,7 @@ package ara_pkg;
     logic [1:0] ntr_red;       // Neutral type for reductions
     logic is_reduct;           // Is this a reduction?
     target_fu_e target_fu;     // Target FU of the opqueue (if it is not clear)
+    logic altfmt;              // The FP operands are BF16
   } operand_queue_cmd_t;
 
   // This is the interface between the lane's sequencer and the lane's VFUs.
@@ -1039,7 +1263,7 @@ package ara_pkg;
 
     vfu_e vfu; // VFU responsible for this instruction
 
-    logic [4:0] vd; // Vector destination register
+    vreg_t vd; // Vector destination register
     logic use_vd;
 
     logic swap_vs2_vd_op; // If asserted: vs2 is kept in MulFPU opqueue C, and vd_op in MulFPU A
@@ -1052,8 +1276,17 @@ package ara_pkg;
     vlen_t vl;
     vlen_t vstart;
     rvv_pkg::vtype_t vtype;
+
+    logic osum_last; // This lane holds the last element of an ordered reduction
   } vfu_operation_t;
 
+  // Does the lane have no elements of an instruction of the VALU, of the VMFPUs, or of the MXU
+  // with vector length vl? All the lanes take part in the reductions anyway.
+  function automatic logic lane_skips_vinsn(ara_op_e op, vfu_e vfu, vlen_t vl, int unsigned lane);
+    lane_skips_vinsn = vfu inside {VFU_Alu, VFU_MFpu, VFU_MFpu2, VFU_MxUnit} && vl <= lane &&
+      !(op inside {[VREDSUM:VWREDSUM], [VFREDUSUM:VFWREDOSUM]});
+  endfunction : lane_skips_vinsn
+
   // Due to the shuffled nature of the vector elements inside one lane, the byte enable
   // signal must be generated differently depending on how many valid elements are there.
   // Considering the lane 0 of the previous example, and vector elements of width 8 bits,
@@ -1103,8 +1336,32 @@ package ara_pkg;
     axi_pkg::size_t size;
     axi_pkg::len_t len;
     logic is_load;
+    // Coalesced indexed loads: the data is in the reuse-th last R beat, without a beat of its own
+    logic [cf_math_pkg::idx_width(IdxCoalesceWindow+1)-1:0] reuse;
+    // Combined stores: the element goes through the write-combining buffer of the VSTU, which
+    // sends the AW of its beat. The address is the physical one.
+    logic combine;
+    // Indexed and strided loads: nr_elems (> 1) elements of the beat, at these byte offsets
+    logic [cf_math_pkg::idx_width(MemAddrsPerCycle+1)-1:0] nr_elems;
+    logic [MemAddrsPerCycle-1:0][$clog2(4*MaxNrLanes)-1:0] elem_offs;
   } addrgen_axi_req_t;
 
+  // Is the constant-strided load coalesced into AXI bursts? Its stride must be a power of two,
+  // at least one element, and at most one AXI beat (AxiBeatBytes), so that every beat holds
+  // at least one element, at the same offset.
+  function automatic logic is_coalesced_stride(elen_t stride, rvv_pkg::vew_e eew,
+      int unsigned AxiBeatBytes);
+    is_coalesced_stride = StridedCoalesce && stride >= (elen_t'(1) << eew) &&
+      stride <= AxiBeatBytes && (stride & (stride - 1)) == '0;
+  endfunction : is_coalesced_stride
+
+  // Log2 of the stride of a coalesced strided load
+  function automatic int unsigned coalesced_stride_log(elen_t stride, int unsigned AxiBeatBytes);
+    coalesced_stride_log = 0;
+    for (int unsigned i = 0; i <= $clog2(AxiBeatBytes); i++)
+      if (stride == (elen_t'(1) << i)) coalesced_stride_log = i;
+  endfunction : coalesced_stride_log
+
 
     ////////////////////////
     // VFREC7 & VFRSQRT7 //
@@ -42,6 +42,7 @@ package rvv_pkg;
   // Vector type register
   typedef struct packed {
     logic vill;
+    logic altfmt; // Alternative FP format: BF16 instead of FP16 (vtype[8])
     logic vma;
     logic vta;
     vew_e vsew;
@@ -60,6 +61,9 @@ package rvv_pkg;
     OPCFG = 3'b111
   } opcodev_func3_e;
 
+  // Major opcode of the vector crypto instructions (OP-VE), which use the func3 values of OpcodeV
+  localparam logic [6:0] OpcodeVecCrypto = 7'b111_0111;
+
   ///////////////////
   //  Vector CSRs  //
   ///////////////////
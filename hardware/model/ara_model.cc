@@ -0,0 +1,1739 @@
+// Copyright 2021 ETH Zurich and University of Bologna.
+// Solderpad Hardware License, Version 0.51, see LICENSE for details.
+// SPDX-License-Identifier: SHL-0.51
+//
+// Description:
+// Cycle-approximate model of Ara, driven by the binary vtrace of the ideal
+// dispatcher (tb/dpi/vtrace_source.cc). It replays the trace in a fraction of
+// the time of the RTL, for design-space exploration, and prints the same
+// [hw-cycles] as the ideal dispatcher.
+//
+// The model steps one cycle at a time, but at the granularity of the 64-bit
+// words of a lane, and of one representative lane:
+//  - The dispatcher models the scalar issue of accel_dispatcher_ideal.sv, the
+//    reshuffles of ara_dispatcher.sv, and its waits for the address generation
+//    of the memory instructions and for the scalar results.
+//  - The sequencer keeps up to nr_vinsn instructions in flight, and each unit
+//    up to its queue depth (ara_pkg.sv), with the hazards and the issue rules
+//    of ara_sequencer.sv (instructions without vector operands and slides wait
+//    for their hazards to clear).
+//  - Every vector operand is a stream of words through an operand queue of
+//    opq_depth words, and every result goes through a write-back queue. The
+//    reads and the writes compete for the vrf_banks VRF banks of the lane, with
+//    the bank hash of operand_requester.sv, or for their read and write port
+//    with vrf_dual_port. A read of a word waits for the word
+//    to be written by a chainable producer, and a write for the older readers
+//    (WAR) and writers (WAW) of the same word.
+//  - The VLSU has one address generator for the loads and the stores, in
+//    order, and an AXI read and write channel of axi_bytes per cycle, with the
+//    DRAM latencies and bandwidth of the configuration.
+//
+// The timing parameters that the RTL does not fix (start-up and pipeline
+// latencies, reduction steps, ...) are calibrated against the RTL with
+// scripts/model_calibrate.py, and read with --params.
+//
+// Usage: ara_model [--config FILE] [--params FILE] [-p name=value ...]
+//                  [--timeline FILE] TRACE
+//   --config FILE:   configuration of the RTL (config/*.mk)
+//   --params FILE:   "name = value" lines, e.g., a calibration
+//   -p name=value:   a single parameter
+//   --timeline FILE: CSV with the issue, start, and end of every instruction
+//   --print-params:  print the parameters and exit
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+////////////////
+// Parameters //
+////////////////
+
+struct Params {
+  // Configuration of the RTL (config/*.mk)
+  int64_t nr_lanes = 4;
+  int64_t vlen = 4096;
+  int64_t nr_vinsn = 8;
+  int64_t valu_queue_depth = 4;
+  int64_t mfpu_queue_depth = 4;
+  int64_t sldu_queue_depth = 2;
+  int64_t masku_queue_depth = 1;
+  int64_t vldu_queue_depth = 4;
+  int64_t vstu_queue_depth = 4;
+  int64_t dram_rd_latency = 1;
+  int64_t dram_wr_latency = 1;
+  int64_t dram_bw = 0;
+  int64_t axi_bytes = 0;
+  int64_t vrf_bank_hash = 1;
+  int64_t vrf_banks = 8;
+  int64_t vrf_dual_port = 0;
+  int64_t fdivsqrt_units = 1;
+  int64_t div_parallel = 0;
+  int64_t fpu_pipe_regs = 0;
+  int64_t mul_pipe_regs = 0;
+  int64_t slide_mask_cut = 0;
+  int64_t pe_req_cut = 0;
+  // Scalar issue model of the ideal dispatcher
+  int64_t ideal_issue_interval = 1;
+  int64_t ideal_scalar_cpi = 0;
+  int64_t ideal_issue_latency = 0;
+  // Timing, calibrated against the RTL
+  int64_t dispatch_lat = 2;
+  int64_t start_lat = 3;
+  int64_t opq_depth = 2;
+  int64_t valu_lat = 2;
+  int64_t mul_lat = 2;
+  int64_t fcomp_lat_e8 = 3;
+  int64_t fcomp_lat_e16 = 4;
+  int64_t fcomp_lat_e32 = 5;
+  int64_t fcomp_lat_e64 = 6;
+  int64_t fnoncomp_lat = 2;
+  int64_t fconv_lat = 3;
+  int64_t idiv_cycles_e8 = 10;
+  int64_t idiv_cycles_e16 = 18;
+  int64_t idiv_cycles_e32 = 34;
+  int64_t idiv_cycles_e64 = 66;
+  int64_t fdiv_cycles_e16 = 9;
+  int64_t fdiv_cycles_e32 = 14;
+  int64_t fdiv_cycles_e64 = 24;
+  int64_t sldu_lat = 3;
+  int64_t masku_lat = 3;
+  int64_t gather_elems = 1;
+  int64_t red_intra = 2;
+  int64_t red_step = 6;
+  int64_t osum_hop = 1;
+  int64_t ld_lat = 4;
+  int64_t st_lat = 2;
+  int64_t addrgen_ack_lat = 2;
+  int64_t scalar_resp_lat = 2;
+};
+
+struct ParamDesc {
+  const char *name;
+  int64_t Params::*field;
+};
+
+#define PARAM(name) {#name, &Params::name}
+const ParamDesc kParams[] = {
+    PARAM(nr_lanes),          PARAM(vlen),
+    PARAM(nr_vinsn),          PARAM(valu_queue_depth),
+    PARAM(mfpu_queue_depth),  PARAM(sldu_queue_depth),
+    PARAM(masku_queue_depth), PARAM(vldu_queue_depth),
+    PARAM(vstu_queue_depth),  PARAM(dram_rd_latency),
+    PARAM(dram_wr_latency),   PARAM(dram_bw),
+    PARAM(axi_bytes),         PARAM(vrf_bank_hash),
+    PARAM(vrf_banks),         PARAM(vrf_dual_port),
+    PARAM(fdivsqrt_units),    PARAM(div_parallel),
+    PARAM(fpu_pipe_regs),     PARAM(mul_pipe_regs),
+    PARAM(slide_mask_cut),    PARAM(pe_req_cut),
+    PARAM(ideal_issue_interval), PARAM(ideal_scalar_cpi),
+    PARAM(ideal_issue_latency),  PARAM(dispatch_lat),
+    PARAM(start_lat),         PARAM(opq_depth),
+    PARAM(valu_lat),          PARAM(mul_lat),
+    PARAM(fcomp_lat_e8),      PARAM(fcomp_lat_e16),
+    PARAM(fcomp_lat_e32),     PARAM(fcomp_lat_e64),
+    PARAM(fnoncomp_lat),      PARAM(fconv_lat),
+    PARAM(idiv_cycles_e8),    PARAM(idiv_cycles_e16),
+    PARAM(idiv_cycles_e32),   PARAM(idiv_cycles_e64),
+    PARAM(fdiv_cycles_e16),   PARAM(fdiv_cycles_e32),
+    PARAM(fdiv_cycles_e64),   PARAM(sldu_lat),
+    PARAM(masku_lat),         PARAM(gather_elems),
+    PARAM(red_intra),         PARAM(red_step),
+    PARAM(osum_hop),          PARAM(ld_lat),
+    PARAM(st_lat),            PARAM(addrgen_ack_lat),
+    PARAM(scalar_resp_lat),
+};
+#undef PARAM
+
+// Set a parameter from "name=value". Return false if it does not exist.
+bool SetParam(Params &p, const std::string &assignment) {
+  size_t eq = assignment.find('=');
+  if (eq == std::string::npos) {
+    return false;
+  }
+  std::string name = assignment.substr(0, eq);
+  // Accept the spelling of the Makefile variables, too
+  std::replace(name.begin(), name.end(), '-', '_');
+  for (const ParamDesc &d : kParams) {
+    if (name == d.name) {
+      p.*d.field = std::stoll(assignment.substr(eq + 1), nullptr, 0);
+      return true;
+    }
+  }
+  return false;
+}
+
+// Read "name = value" lines, with # comments
+bool ReadParams(Params &p, const char *filename) {
+  std::ifstream f(filename);
+  if (!f) {
+    std::cerr << "[model] Cannot open " << filename << std::endl;
+    return false;
+  }
+  std::string line;
+  while (std::getline(f, line)) {
+    line = line.substr(0, line.find('#'));
+    line.erase(std::remove_if(line.begin(), line.end(), ::isspace), line.end());
+    if (!line.empty() && !SetParam(p, line)) {
+      std::cerr << "[model] Unknown parameter " << line << " in " << filename
+                << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+// Read the configuration of the RTL (config/*.mk), "name ?= value" lines.
+// The variables that are not parameters of the model are ignored.
+bool ReadConfig(Params &p, const char *filename) {
+  std::ifstream f(filename);
+  if (!f) {
+    std::cerr << "[model] Cannot open " << filename << std::endl;
+    return false;
+  }
+  std::string line;
+  while (std::getline(f, line)) {
+    line = line.substr(0, line.find('#'));
+    line.erase(std::remove_if(line.begin(), line.end(), ::isspace), line.end());
+    size_t eq = line.find('=');
+    if (eq == std::string::npos || eq == 0) {
+      continue;
+    }
+    std::string name = line.substr(0, line[eq - 1] == '?' ? eq - 1 : eq);
+    std::string value = line.substr(eq + 1);
+    if (value.empty() || !isdigit(value[0])) {
+      continue;
+    }
+    SetParam(p, name + "=" + value);
+  }
+  return true;
+}
+
+////////////
+// Vtrace //
+////////////
+
+// Same format as tb/dpi/vtrace_source.cc
+const char kMagic[4] = {'V', 'T', 'R', 'C'};
+
+struct Record {
+  uint32_t insn;
+  uint64_t rs1;
+  uint64_t rs2;
+  uint32_t gap;
+};
+
+class VtraceReader {
+ public:
+  bool Open(const char *filename) {
+    f_.open(filename, std::ios::binary);
+    char magic[4];
+    uint32_t version = 0;
+    if (!f_ || !f_.read(magic, 4) ||
+        !f_.read(reinterpret_cast<char *>(&version), 4) ||
+        !f_.read(reinterpret_cast<char *>(&nr_insn_), 8) ||
+        memcmp(magic, kMagic, 4) || version < 1 || version > 3) {
+      std::cerr << "[model] " << filename << " is not a binary vtrace."
+                << std::endl;
+      return false;
+    }
+    record_bytes_ = version == 1 ? 20 : version == 2 ? 24 : 32;
+    return true;
+  }
+
+  // Read the next record. Return false past the end of the trace.
+  bool Next(Record &r) {
+    if (read_ == nr_insn_) {
+      return false;
+    }
+    uint8_t rec[32] = {};
+    if (!f_.read(reinterpret_cast<char *>(rec), record_bytes_)) {
+      return false;
+    }
+    memcpy(&r.insn, rec, 4);
+    memcpy(&r.rs1, rec + 4, 8);
+    memcpy(&r.rs2, rec + 12, 8);
+    r.gap = 0;
+    if (record_bytes_ > 20) {
+      memcpy(&r.gap, rec + 20, 4);
+    }
+    ++read_;
+    return true;
+  }
+
+  uint64_t nr_insn() const { return nr_insn_; }
+
+ private:
+  std::ifstream f_;
+  uint64_t nr_insn_ = 0;
+  uint64_t read_ = 0;
+  size_t record_bytes_ = 24;
+};
+
+//////////////
+// Decoding //
+//////////////
+
+enum Unit { kValu, kMfpu, kSldu, kMasku, kVldu, kVstu, kNrUnits };
+const char *const kUnitNames[kNrUnits] = {"valu", "mfpu",  "sldu",
+                                          "masku", "vldu", "vstu"};
+
+enum Kind {
+  kArith,      // Element-wise, one beat per word of the widest operand
+  kReduction,  // Element-wise in the lane, then across the lanes
+  kOrdered,    // One element after the other
+  kSlide,      // Needs the whole source (SLDU)
+  kPermute,    // Needs the whole source, element by element (MASKU)
+  kMemory
+};
+
+enum Access { kUnitStride, kStrided, kIndexed };
+
+struct Operand {
+  int vreg = -1;      // Base vector register
+  int eew = 0;        // Element width in bits, 1 for masks
+  int nregs = 1;      // Registers of the group
+  int64_t words = 0;  // 64-bit words in a lane
+};
+
+const int kMaxSrc = 4;
+
+struct Vinsn {
+  Record rec;
+  Unit unit = kValu;
+  Kind kind = kArith;
+  Access access = kUnitStride;
+  bool store = false;
+  int64_t vl = 0;
+  int sew = 64;
+  Operand src[kMaxSrc];
+  int nr_src = 0;
+  // The source read by the address generator (index of an indexed access)
+  int addr_src = -1;
+  Operand dst;
+  // The result is a mask, or a scalar for the scalar core
+  bool mask_dst = false;
+  bool scalar_result = false;
+  // The sources can be chained, and the result can be chained
+  bool chain_in = true;
+  bool chain_out = true;
+  // For the slides, the issue rules of the sequencer
+  bool slide_up = false;
+  bool slide_down = false;
+  int64_t beats = 1;        // Beats in a lane
+  int64_t beat_cycles = 1;  // Cycles per beat
+  int64_t lat = 1;          // Cycles from a beat to its result
+  int64_t tail = 0;         // Cycles from the last beat to the last result
+  int64_t mem_elems = 0;    // Elements of a memory access
+  int64_t mem_bytes = 0;    // Bytes of a memory access
+  bool reshuffle = false;   // Injected by the dispatcher
+};
+
+class Decoder {
+ public:
+  explicit Decoder(const Params &p) : p_(p) {}
+
+  // Handle the configuration instructions. Return true if insn is one.
+  bool Config(const Record &r) {
+    uint32_t insn = r.insn;
+    if ((insn & 0x7f) != 0x57 || ((insn >> 12) & 7) != 7) {
+      return false;
+    }
+    unsigned rd = (insn >> 7) & 0x1f;
+    unsigned rs1 = (insn >> 15) & 0x1f;
+    uint64_t vtype;
+    uint64_t avl;
+    bool keep_vl = false;
+    if ((insn >> 30) == 3) {
+      // vsetivli
+      vtype = (insn >> 20) & 0x3ff;
+      avl = rs1;
+    } else {
+      vtype = (insn >> 31) ? r.rs2 : (insn >> 20) & 0x7ff;
+      avl = r.rs1;
+      if (rs1 == 0) {
+        keep_vl = rd == 0;
+        avl = UINT64_MAX;
+      }
+    }
+    vsew_ = 8 << ((vtype >> 3) & 7);
+    unsigned vlmul = vtype & 7;
+    // LMUL in eighths
+    lmul8_ = vlmul < 4 ? 8 << vlmul : 8 >> (8 - vlmul);
+    if (vsew_ > 64 || !lmul8_) {
+      vsew_ = 64;
+      lmul8_ = 8;
+    }
+    int64_t vlmax = p_.vlen / vsew_ * lmul8_ / 8;
+    if (!keep_vl) {
+      vl_ = std::min<uint64_t>(avl, vlmax);
+    }
+    vl_ = std::min(vl_, vlmax);
+    return true;
+  }
+
+  // Decode a vector instruction with the current vl and vtype. Return false
+  // if it does nothing (vl = 0).
+  bool Decode(const Record &r, Vinsn &v) {
+    v = Vinsn();
+    v.rec = r;
+    v.vl = vl_;
+    v.sew = vsew_;
+    uint32_t insn = r.insn;
+    unsigned opcode = insn & 0x7f;
+    if (opcode == 0x07 || opcode == 0x27) {
+      DecodeMemory(insn, v);
+    } else {
+      DecodeArith(insn, v);
+    }
+    if (!v.vl) {
+      return false;
+    }
+    Timing(v);
+    return true;
+  }
+
+  int sew() const { return vsew_; }
+  int64_t vl() const { return vl_; }
+
+  // 64-bit words of a lane for elems elements of eew bits
+  int64_t Words(int64_t elems, int eew) const {
+    int64_t per_lane = (elems + p_.nr_lanes - 1) / p_.nr_lanes;
+    return (per_lane * eew + 63) / 64;
+  }
+
+  int VregWords() const { return p_.vlen / 64 / p_.nr_lanes; }
+
+  // Operand of eew bits, with the EMUL of the current LMUL
+  Operand Op(int vreg, int eew, int64_t elems) const {
+    Operand o;
+    o.vreg = vreg;
+    o.eew = eew;
+    o.nregs = eew == 1 ? 1
+                       : std::max<int64_t>(1, lmul8_ * eew / vsew_ / 8);
+    o.words = std::max<int64_t>(1, Words(elems, eew));
+    return o;
+  }
+
+  // Operand of whole registers
+  Operand Whole(int vreg, int nregs) const {
+    Operand o;
+    o.vreg = vreg;
+    o.eew = 64;
+    o.nregs = nregs;
+    o.words = int64_t(nregs) * VregWords();
+    return o;
+  }
+
+  // Reshuffle of a register from old_eew to new_eew (a slide by zero)
+  Vinsn Reshuffle(int vreg, int old_eew, int new_eew) const {
+    Vinsn v;
+    v.unit = kSldu;
+    v.kind = kSlide;
+    v.slide_down = true;
+    v.reshuffle = true;
+    v.sew = new_eew;
+    v.vl = p_.vlen / new_eew;
+    v.src[0] = Whole(vreg, 1);
+    v.src[0].eew = old_eew;
+    v.nr_src = 1;
+    v.dst = Whole(vreg, 1);
+    v.dst.eew = new_eew;
+    v.chain_in = false;
+    Timing(v);
+    return v;
+  }
+
+ private:
+  void AddSrc(Vinsn &v, const Operand &o) { v.src[v.nr_src++] = o; }
+
+  void DecodeMemory(uint32_t insn, Vinsn &v) {
+    unsigned vd = (insn >> 7) & 0x1f;
+    unsigned width = (insn >> 12) & 7;
+    unsigned lumop = (insn >> 20) & 0x1f;
+    unsigned vs2 = (insn >> 20) & 0x1f;
+    unsigned mop = (insn >> 26) & 3;
+    unsigned nf = (insn >> 29) & 7;
+    bool vm = (insn >> 25) & 1;
+    int eew = width == 0 ? 8 : 8 << (width - 4);
+
+    v.unit = (insn & 0x7f) == 0x27 ? kVstu : kVldu;
+    v.store = v.unit == kVstu;
+    v.kind = kMemory;
+    v.access = mop == 0 ? kUnitStride : mop == 2 ? kStrided : kIndexed;
+    int data_eew = v.access == kIndexed ? vsew_ : eew;
+    Operand data;
+    int64_t elems = v.vl;
+    if (v.access == kUnitStride && lumop == 8) {
+      // Whole registers
+      data = Whole(vd, nf + 1);
+      data.eew = eew;
+      elems = int64_t(nf + 1) * p_.vlen / eew;
+    } else if (v.access == kUnitStride && lumop == 0xb) {
+      // Mask
+      data_eew = 8;
+      elems = (v.vl + 7) / 8;
+      data = Op(vd, 8, elems);
+      data.nregs = 1;
+    } else {
+      data = Op(vd, data_eew, v.vl);
+      elems = v.vl * (nf + 1);
+      if (nf) {
+        // Segments: one element per beat
+        data.nregs *= nf + 1;
+        data.words *= nf + 1;
+        if (v.access == kUnitStride) {
+          v.access = kStrided;
+        }
+      }
+    }
+    v.vl = elems;
+    v.mem_elems = elems;
+    v.mem_bytes = elems * data_eew / 8;
+    if (v.store) {
+      AddSrc(v, data);
+    } else {
+      v.dst = data;
+    }
+    if (v.access == kIndexed) {
+      v.addr_src = v.nr_src;
+      AddSrc(v, Op(vs2, eew, elems));
+    }
+    if (!vm) {
+      AddSrc(v, Op(0, 1, elems));
+    }
+  }
+
+  void DecodeArith(uint32_t insn, Vinsn &v) {
+    unsigned vd = (insn >> 7) & 0x1f;
+    unsigned funct3 = (insn >> 12) & 7;
+    unsigned vs1 = (insn >> 15) & 0x1f;
+    unsigned vs2 = (insn >> 20) & 0x1f;
+    bool vm = (insn >> 25) & 1;
+    unsigned funct6 = insn >> 26;
+    const int sew = vsew_;
+    const int64_t vl = v.vl;
+    const bool vv = funct3 == 0 || funct3 == 1 || funct3 == 2;
+
+    // Element-wise by default: vd = f(vs2, vs1)
+    int eew_vd = sew, eew_vs2 = sew, eew_vs1 = sew;
+    bool use_vs1 = vv, use_vs2 = true, use_vd = true, use_vd_op = false;
+    bool use_vm = !vm;
+    v.unit = kValu;
+
+    if (funct3 == 0 || funct3 == 3 || funct3 == 4) {
+      // OPIVV, OPIVI, OPIVX
+      switch (funct6) {
+        case 0x0c:  // vrgather
+        case 0x0e:  // vslideup (vrgatherei16 for OPIVV)
+          if (funct6 == 0x0c || funct3 == 0) {
+            v.unit = kMasku;
+            v.kind = kPermute;
+            if (funct6 == 0x0e) {
+              eew_vs1 = 16;
+            }
+          } else {
+            v.unit = kSldu;
+            v.kind = kSlide;
+            v.slide_up = true;
+          }
+          break;
+        case 0x0f:  // vslidedown
+          v.unit = kSldu;
+          v.kind = kSlide;
+          v.slide_down = true;
+          break;
+        case 0x10:
+        case 0x12:  // vadc, vsbc
+          use_vm = true;
+          break;
+        case 0x11:
+        case 0x13:  // vmadc, vmsbc
+          use_vm = !vm;
+          v.mask_dst = true;
+          break;
+        case 0x17:  // vmerge, vmv.v
+          if (vm) {
+            use_vs2 = false;
+          }
+          break;
+        case 0x18: case 0x19: case 0x1a: case 0x1b:
+        case 0x1c: case 0x1d: case 0x1e: case 0x1f:  // Compares
+          v.mask_dst = true;
+          break;
+        case 0x27:  // vsmul, vmv<nr>r
+          if (funct3 == 3) {
+            int nregs = vs1 + 1;
+            v.src[0] = Whole(vs2, nregs);
+            v.nr_src = 1;
+            v.dst = Whole(vd, nregs);
+            v.vl = int64_t(nregs) * p_.vlen / sew;
+            return;
+          }
+          v.unit = kMfpu;
+          break;
+        case 0x2c: case 0x2d: case 0x2e: case 0x2f:  // Narrowing
+          eew_vs2 = 2 * sew;
+          break;
+        case 0x30:
+        case 0x31:  // vwredsum
+          v.kind = kReduction;
+          eew_vd = eew_vs1 = 2 * sew;
+          use_vs1 = true;
+          break;
+        default:
+          break;
+      }
+    } else if (funct3 == 2 || funct3 == 6) {
+      // OPMVV, OPMVX
+      switch (funct6) {
+        case 0x00: case 0x01: case 0x02: case 0x03:
+        case 0x04: case 0x05: case 0x06: case 0x07:  // Reductions
+          v.kind = kReduction;
+          use_vs1 = true;
+          break;
+        case 0x0e:
+          v.unit = kSldu;
+          v.kind = kSlide;
+          v.slide_up = true;
+          break;
+        case 0x0f:
+          v.unit = kSldu;
+          v.kind = kSlide;
+          v.slide_down = true;
+          break;
+        case 0x10:
+          if (funct3 == 6) {
+            // vmv.s.x
+            use_vs2 = false;
+            v.vl = 1;
+          } else if (vs1 == 0) {
+            // vmv.x.s
+            use_vd = false;
+            v.scalar_result = true;
+            v.vl = 1;
+          } else {
+            // vcpop, vfirst
+            v.unit = kMasku;
+            v.kind = kPermute;
+            use_vd = false;
+            v.scalar_result = true;
+            eew_vs2 = 1;
+          }
+          use_vs1 = false;
+          break;
+        case 0x12:  // vzext, vsext
+          use_vs1 = false;
+          eew_vs2 = sew >> (4 - (vs1 >> 1));
+          if (eew_vs2 < 8) {
+            eew_vs2 = 8;
+          }
+          break;
+        case 0x14:  // vmsbf, vmsof, vmsif, viota, vid
+          v.unit = kMasku;
+          v.kind = kPermute;
+          use_vs1 = false;
+          use_vs2 = vs1 != 0x11;
+          if (vs1 < 0x10) {
+            v.mask_dst = true;
+            eew_vs2 = 1;
+          } else if (vs1 == 0x10) {
+            eew_vs2 = 1;
+          }
+          break;
+        case 0x17:  // vcompress
+          v.unit = kMasku;
+          v.kind = kPermute;
+          eew_vs1 = 1;
+          break;
+        case 0x18: case 0x19: case 0x1a: case 0x1b:
+        case 0x1c: case 0x1d: case 0x1e: case 0x1f:  // Mask logical
+          eew_vd = eew_vs2 = eew_vs1 = 1;
+          break;
+        case 0x20: case 0x21: case 0x22: case 0x23:
+        case 0x24: case 0x25: case 0x26: case 0x27:  // Divisions, mul
+          v.unit = kMfpu;
+          break;
+        case 0x29: case 0x2b: case 0x2d: case 0x2f:  // Multiply-add
+          v.unit = kMfpu;
+          use_vd_op = true;
+          break;
+        case 0x30: case 0x31: case 0x32: case 0x33:  // Widening add
+          eew_vd = 2 * sew;
+          break;
+        case 0x34: case 0x35: case 0x36: case 0x37:  // Widening add .w
+          eew_vd = eew_vs2 = 2 * sew;
+          break;
+        case 0x38: case 0x3a: case 0x3b:  // Widening mul
+          v.unit = kMfpu;
+          eew_vd = 2 * sew;
+          break;
+        case 0x3c: case 0x3d: case 0x3e: case 0x3f:  // Widening mul-add
+          v.unit = kMfpu;
+          eew_vd = 2 * sew;
+          use_vd_op = true;
+          break;
+        default:
+          break;
+      }
+    } else {
+      // OPFVV, OPFVF
+      v.unit = kMfpu;
+      switch (funct6) {
+        case 0x01:
+        case 0x05:
+        case 0x07:  // vfredusum, vfredmin, vfredmax
+          v.kind = kReduction;
+          use_vs1 = true;
+          break;
+        case 0x03:  // vfredosum
+          v.kind = kOrdered;
+          use_vs1 = true;
+          break;
+        case 0x0e:
+          v.unit = kSldu;
+          v.kind = kSlide;
+          v.slide_up = true;
+          break;
+        case 0x0f:
+          v.unit = kSldu;
+          v.kind = kSlide;
+          v.slide_down = true;
+          break;
+        case 0x10:
+          if (funct3 == 5) {
+            // vfmv.s.f
+            v.unit = kValu;
+            use_vs2 = false;
+            v.vl = 1;
+          } else {
+            // vfmv.f.s
+            v.unit = kValu;
+            use_vd = false;
+            use_vs1 = false;
+            v.scalar_result = true;
+            v.vl = 1;
+          }
+          break;
+        case 0x12:  // Conversions
+          use_vs1 = false;
+          if (vs1 >= 0x08 && vs1 < 0x10) {
+            eew_vd = 2 * sew;
+          } else if (vs1 >= 0x10) {
+            eew_vs2 = 2 * sew;
+          }
+          break;
+        case 0x13:  // vfsqrt, vfrsqrt7, vfrec7, vfclass
+          use_vs1 = false;
+          break;
+        case 0x17:  // vfmerge, vfmv.v.f
+          v.unit = kValu;
+          if (vm) {
+            use_vs2 = false;
+          }
+          use_vm = !vm;
+          break;
+        case 0x18: case 0x19: case 0x1b:
+        case 0x1c: case 0x1d: case 0x1f:  // Compares
+          v.mask_dst = true;
+          break;
+        case 0x28: case 0x29: case 0x2a: case 0x2b:
+        case 0x2c: case 0x2d: case 0x2e: case 0x2f:  // Multiply-add
+          use_vd_op = true;
+          break;
+        case 0x30:
+        case 0x32:
+        case 0x38:  // vfwadd, vfwsub, vfwmul
+          eew_vd = 2 * sew;
+          break;
+        case 0x31:  // vfwredusum
+          v.kind = kReduction;
+          eew_vd = eew_vs1 = 2 * sew;
+          use_vs1 = true;
+          break;
+        case 0x33:  // vfwredosum
+          v.kind = kOrdered;
+          eew_vd = eew_vs1 = 2 * sew;
+          use_vs1 = true;
+          break;
+        case 0x34:
+        case 0x36:  // vfwadd.w, vfwsub.w
+          eew_vd = eew_vs2 = 2 * sew;
+          break;
+        case 0x3c: case 0x3d: case 0x3e: case 0x3f:  // Widening mul-add
+          eew_vd = 2 * sew;
+          use_vd_op = true;
+          break;
+        default:
+          break;
+      }
+    }
+
+    const bool red = v.kind == kReduction || v.kind == kOrdered;
+    if (v.mask_dst) {
+      eew_vd = 1;
+    }
+    if (use_vs2) {
+      AddSrc(v, Op(vs2, eew_vs2, v.vl));
+    }
+    if (use_vs1) {
+      // The scalar of the reductions is in the first element
+      AddSrc(v, Op(vs1, eew_vs1, red ? 1 : v.vl));
+    }
+    if (use_vd_op) {
+      AddSrc(v, Op(vd, eew_vd, v.vl));
+    }
+    if (use_vm) {
+      AddSrc(v, Op(0, 1, vl));
+    }
+    if (use_vd) {
+      v.dst = Op(vd, eew_vd, red ? 1 : v.vl);
+      if (red) {
+        v.dst.nregs = 1;
+      }
+    }
+  }
+
+  int64_t FcompLat(int sew) const {
+    switch (sew) {
+      case 8:
+        return p_.fcomp_lat_e8;
+      case 16:
+        return p_.fcomp_lat_e16;
+      case 32:
+        return p_.fcomp_lat_e32;
+      default:
+        return p_.fcomp_lat_e64;
+    }
+  }
+
+  int64_t IdivCycles(int sew) const {
+    switch (sew) {
+      case 8:
+        return p_.idiv_cycles_e8;
+      case 16:
+        return p_.idiv_cycles_e16;
+      case 32:
+        return p_.idiv_cycles_e32;
+      default:
+        return p_.idiv_cycles_e64;
+    }
+  }
+
+  int64_t FdivCycles(int sew) const {
+    switch (sew) {
+      case 16:
+        return p_.fdiv_cycles_e16;
+      case 32:
+        return p_.fdiv_cycles_e32;
+      default:
+        return p_.fdiv_cycles_e64;
+    }
+  }
+
+  // Beats, cycles per beat, and latencies
+  void Timing(Vinsn &v) const {
+    uint32_t insn = v.rec.insn;
+    unsigned funct3 = (insn >> 12) & 7;
+    unsigned funct6 = insn >> 26;
+    unsigned vs1 = (insn >> 15) & 0x1f;
+    const bool fp = (insn & 0x7f) == 0x57 && (funct3 == 1 || funct3 == 5);
+
+    int64_t widest = v.dst.vreg >= 0 ? v.dst.words : 0;
+    for (int i = 0; i < v.nr_src; ++i) {
+      if (v.src[i].eew != 1 || v.nr_src == 1) {
+        widest = std::max(widest, v.src[i].words);
+      }
+    }
+    v.beats = std::max<int64_t>(1, widest);
+    const int64_t elems_per_word = 64 / v.sew;
+    const int64_t log_lanes = 63 - __builtin_clzll(p_.nr_lanes);
+
+    switch (v.unit) {
+      case kValu:
+        v.lat = p_.valu_lat;
+        break;
+      case kMfpu:
+        if (!fp) {
+          const bool div = funct6 >= 0x20 && funct6 <= 0x23 &&
+                           ((funct3 == 2) || (funct3 == 6));
+          v.lat = p_.mul_lat + p_.mul_pipe_regs;
+          if (div) {
+            v.beat_cycles = IdivCycles(v.sew) *
+                            (p_.div_parallel ? 1 : elems_per_word);
+          }
+        } else if (funct6 == 0x20 || funct6 == 0x21 ||
+                   (funct6 == 0x13 && vs1 == 0)) {
+          // vfdiv, vfrdiv, vfsqrt
+          v.lat = FcompLat(v.sew);
+          v.beat_cycles = std::max<int64_t>(
+              1, FdivCycles(v.sew) * elems_per_word / p_.fdivsqrt_units);
+        } else if (funct6 == 0x12) {
+          v.lat = p_.fconv_lat;
+        } else if ((funct6 >= 0x04 && funct6 <= 0x0a) || funct6 == 0x13 ||
+                   v.mask_dst) {
+          v.lat = p_.fnoncomp_lat;
+        } else {
+          v.lat = FcompLat(v.sew) + p_.fpu_pipe_regs;
+        }
+        break;
+      case kSldu:
+        v.lat = p_.sldu_lat + p_.slide_mask_cut;
+        v.chain_in = false;
+        break;
+      case kMasku:
+        v.lat = p_.masku_lat + p_.slide_mask_cut;
+        v.chain_in = false;
+        if (funct6 == 0x0c || funct6 == 0x17 ||
+            (funct6 == 0x0e && funct3 == 0)) {
+          // vrgather, vcompress: element by element
+          v.beats = std::max<int64_t>(1, (v.vl + p_.gather_elems - 1) /
+                                             p_.gather_elems);
+        }
+        break;
+      case kVldu:
+        v.lat = p_.ld_lat;
+        break;
+      case kVstu:
+        v.lat = p_.st_lat;
+        break;
+      default:
+        break;
+    }
+
+    if (v.kind == kReduction) {
+      v.chain_out = false;
+      v.tail = (v.unit == kMfpu ? p_.red_intra * v.lat : 0) +
+               log_lanes * p_.red_step;
+    } else if (v.kind == kOrdered) {
+      // One element after the other, from each lane to the next one, and
+      // the last one back to lane 0 through the SLDU
+      v.chain_out = false;
+      v.beats = v.vl;
+      v.beat_cycles = v.lat + p_.osum_hop;
+      v.tail = p_.sldu_lat;
+    }
+    if (v.mask_dst) {
+      // The mask unit writes the results in the mask layout
+      v.chain_out = false;
+      v.tail += p_.masku_lat;
+    }
+    if (v.kind == kMemory && v.access == kIndexed) {
+      v.chain_in = false;
+    }
+  }
+
+  const Params &p_;
+  int vsew_ = 64;
+  int64_t lmul8_ = 8;
+  int64_t vl_ = 0;
+};
+
+///////////
+// Model //
+///////////
+
+struct Inflight;
+using InflightPtr = std::shared_ptr<Inflight>;
+
+struct Inflight {
+  Vinsn v;
+  uint64_t seq = 0;
+  int64_t issue_cycle = 0;
+  int64_t start_cycle = 0;
+  int64_t first_beat = -1;
+  int64_t end_cycle = -1;
+  bool done = false;
+  // Producers of the sources (RAW), older writer (WAW) and readers (WAR) of vd
+  InflightPtr raw[kMaxSrc];
+  InflightPtr waw;
+  std::vector<std::pair<InflightPtr, int>> war;
+  // Words read of each source, beats, results, and writes
+  int64_t read[kMaxSrc] = {};
+  int64_t beats_done = 0;
+  int64_t busy_until = 0;
+  int64_t produced = 0;
+  int64_t written = 0;
+  std::deque<int64_t> wq;
+  int64_t last_result = 0;
+  // VLSU
+  int64_t agen_ack = -1;    // Acknowledgment to the dispatcher
+  int64_t agen_issued = 0;  // Bytes (unit-stride) or elements requested
+  int64_t mem_done = 0;     // Bytes or elements received or sent
+  int64_t finish_at = -1;   // Last write response
+
+  bool ReadsDone() const {
+    for (int i = 0; i < v.nr_src; ++i) {
+      if (read[i] < v.src[i].words) {
+        return false;
+      }
+    }
+    return true;
+  }
+  bool BeatsDone() const {
+    return v.kind == kMemory || beats_done == v.beats;
+  }
+};
+
+// Words of source i consumed after b beats
+int64_t Consumed(const Vinsn &v, int i, int64_t b) {
+  return std::min(v.src[i].words, b * v.src[i].words / v.beats);
+}
+
+// Bytes (unit-stride) or elements of a memory access
+int64_t MemTotal(const Vinsn &v) {
+  return std::max<int64_t>(1, v.access == kUnitStride ? v.mem_bytes : v.mem_elems);
+}
+
+struct Stats {
+  int64_t unit_busy[kNrUnits] = {};
+  int64_t bank_conflicts = 0;
+  int64_t axi_r_beats = 0;
+  int64_t axi_w_beats = 0;
+  int64_t reshuffles = 0;
+  int64_t stall_window = 0;
+  int64_t stall_queue = 0;
+  int64_t stall_hazard = 0;
+  int64_t stall_ack = 0;
+  int64_t stall_scalar = 0;
+  uint64_t insns = 0;
+};
+
+class Model {
+ public:
+  Model(const Params &p, VtraceReader &trace)
+      : p_(p), dec_(p), trace_(trace) {
+    queue_depth_[kValu] = p.valu_queue_depth;
+    queue_depth_[kMfpu] = p.mfpu_queue_depth;
+    queue_depth_[kSldu] = p.sldu_queue_depth;
+    queue_depth_[kMasku] = p.masku_queue_depth;
+    queue_depth_[kVldu] = p.vldu_queue_depth;
+    queue_depth_[kVstu] = p.vstu_queue_depth;
+    axi_bytes_ = p.axi_bytes ? p.axi_bytes : 4 * p.nr_lanes;
+    vreg_words_ = dec_.VregWords();
+    bank_hash_ = p.vrf_bank_hash && vreg_words_ >= p.vrf_banks;
+    while ((int64_t(1) << bank_bits_) < p.vrf_banks) {
+      ++bank_bits_;
+    }
+  }
+
+  void set_timeline(FILE *f) { timeline_ = f; }
+
+  // Run the whole trace. Return the cycles, or -1 on a deadlock.
+  int64_t Run() {
+    have_next_ = FetchNext();
+    int64_t last_progress = 0;
+    while (have_next_ || !pending_.empty() || have_seq_insn_ ||
+           !window_.empty()) {
+      progress_ = false;
+      Dispatch();
+      Sequence();
+      Execute();
+      Memory();
+      Retire();
+      if (progress_) {
+        last_progress = now_;
+      } else if (now_ - last_progress > 1000000) {
+        std::cerr << "[model] Deadlock at cycle " << now_ << ", "
+                  << window_.size() << " instructions in flight."
+                  << std::endl;
+        return -1;
+      }
+      ++now_;
+    }
+    return now_;
+  }
+
+  const Stats &stats() const { return stats_; }
+
+ private:
+  //////////////////
+  //  Dispatcher  //
+  //////////////////
+
+  bool FetchNext() {
+    if (!trace_.Next(next_)) {
+      return false;
+    }
+    // accel_dispatcher_ideal.sv: issue(i) = max(issue(i-1) + interval +
+    // gap(i) * cpi, accepted(i-1) + 1 - latency)
+    if (!fetched_) {
+      issue_ = int64_t(next_.gap) * p_.ideal_scalar_cpi;
+      fetched_ = true;
+    } else {
+      issue_ = std::max(issue_ + p_.ideal_issue_interval +
+                            int64_t(next_.gap) * p_.ideal_scalar_cpi,
+                        accepted_ + 1 - p_.ideal_issue_latency);
+    }
+    return true;
+  }
+
+  void Dispatch() {
+    // ara_dispatcher waits for the address generation and the scalar results
+    if (wait_ack_ && !(wait_ack_->agen_ack >= 0 && now_ >= wait_ack_->agen_ack)) {
+      if (have_next_) ++stats_.stall_ack;
+      return;
+    }
+    wait_ack_.reset();
+    if (wait_scalar_ &&
+        !(wait_scalar_->done && now_ >= wait_scalar_->end_cycle + p_.scalar_resp_lat)) {
+      if (have_next_) ++stats_.stall_scalar;
+      return;
+    }
+    wait_scalar_.reset();
+    // The dispatcher decodes one instruction at a time, after its reshuffles
+    if (!pending_.empty() || !have_next_) {
+      return;
+    }
+    if (now_ < issue_ + p_.ideal_issue_latency) {
+      return;
+    }
+    Record r = next_;
+    accepted_ = now_;
+    progress_ = true;
+    ++stats_.insns;
+    have_next_ = FetchNext();
+    if (dec_.Config(r)) {
+      return;
+    }
+    Vinsn v;
+    if (!dec_.Decode(r, v)) {
+      return;
+    }
+    Reshuffles(v);
+    pending_.push_back({v, now_ + DispatchLat()});
+  }
+
+  // The register slice of pe_req_cut delays the requests to the lanes
+  int64_t DispatchLat() const { return p_.dispatch_lat + p_.pe_req_cut; }
+
+  // ara_dispatcher.sv: reshuffle the registers read or written with another
+  // EEW than the one they were written with
+  void Reshuffles(const Vinsn &v) {
+    const bool in_lane = v.kind != kMemory && v.unit != kMasku;
+    auto check = [&](const Operand &o, int eew) {
+      for (int r = o.vreg; r < std::min(32, o.vreg + o.nregs); ++r) {
+        if (eew_valid_[r] && eew_[r] != eew) {
+          pending_.push_back({dec_.Reshuffle(r, eew_[r], eew), now_ + DispatchLat()});
+          eew_[r] = eew;
+          ++stats_.reshuffles;
+        }
+      }
+    };
+    // vd is not reshuffled if the instruction overwrites a whole register
+    if (v.dst.vreg >= 0 && v.dst.eew != 1 && v.vl != p_.vlen / v.dst.eew) {
+      check(v.dst, v.dst.eew);
+    }
+    if (in_lane) {
+      for (int i = 0; i < v.nr_src; ++i) {
+        if (v.src[i].eew != 1) {
+          check(v.src[i], v.src[i].eew);
+        }
+      }
+    }
+    if (v.dst.vreg >= 0 && v.dst.eew != 1) {
+      for (int r = v.dst.vreg; r < std::min(32, v.dst.vreg + v.dst.nregs); ++r) {
+        eew_[r] = v.dst.eew;
+        eew_valid_[r] = true;
+      }
+    }
+  }
+
+  /////////////////
+  //  Sequencer  //
+  /////////////////
+
+  void Sequence() {
+    if (!have_seq_insn_) {
+      if (pending_.empty() || now_ < pending_.front().second) {
+        return;
+      }
+      seq_insn_ = pending_.front().first;
+      pending_.pop_front();
+      have_seq_insn_ = true;
+    }
+    const Vinsn &v = seq_insn_;
+    if (int64_t(window_.size()) >= p_.nr_vinsn) {
+      ++stats_.stall_window;
+      return;
+    }
+    if (unit_count_[v.unit] >= queue_depth_[v.unit]) {
+      ++stats_.stall_queue;
+      return;
+    }
+
+    auto in = std::make_shared<Inflight>();
+    in->v = v;
+    bool hazard_src = false, hazard_dst = false;
+    for (int i = 0; i < v.nr_src; ++i) {
+      InflightPtr &w = writer_[v.src[i].vreg];
+      if (w && !w->done) {
+        in->raw[i] = w;
+        hazard_src = true;
+      }
+    }
+    if (v.dst.vreg >= 0) {
+      for (int r = v.dst.vreg; r < std::min(32, v.dst.vreg + v.dst.nregs); ++r) {
+        InflightPtr &w = writer_[r];
+        if (w && !w->done && !in->waw) {
+          in->waw = w;
+        }
+        for (auto &rd : readers_[r]) {
+          if (!rd.first->done &&
+              std::find(in->war.begin(), in->war.end(), rd) == in->war.end()) {
+            in->war.push_back(rd);
+          }
+        }
+      }
+      hazard_dst = in->waw || !in->war.empty();
+    }
+    // ara_sequencer.sv: the instructions without vector operands, and the
+    // slides, wait for their hazards to clear
+    if ((!v.nr_src && (hazard_src || hazard_dst)) ||
+        (v.slide_up && (hazard_src || hazard_dst)) ||
+        (v.slide_down && hazard_src)) {
+      ++stats_.stall_hazard;
+      return;
+    }
+    have_seq_insn_ = false;
+    progress_ = true;
+    in->seq = seq_++;
+    in->issue_cycle = now_;
+    in->start_cycle = now_ + p_.start_lat;
+    for (int i = 0; i < v.nr_src; ++i) {
+      for (int r = v.src[i].vreg; r < std::min(32, v.src[i].vreg + v.src[i].nregs); ++r) {
+        auto &list = readers_[r];
+        list.erase(std::remove_if(list.begin(), list.end(),
+                                  [](const std::pair<InflightPtr, int> &x) {
+                                    return x.first->done;
+                                  }),
+                   list.end());
+        list.push_back({in, i});
+      }
+    }
+    if (v.dst.vreg >= 0) {
+      for (int r = v.dst.vreg; r < std::min(32, v.dst.vreg + v.dst.nregs); ++r) {
+        writer_[r] = in;
+      }
+    }
+    ++unit_count_[v.unit];
+    window_.push_back(in);
+    if (v.kind == kMemory) {
+      agen_q_.push_back(in);
+      wait_ack_ = in;
+    } else if (v.scalar_result) {
+      wait_scalar_ = in;
+    }
+  }
+
+  /////////////////////////
+  //  Functional units  //
+  /////////////////////////
+
+  int Bank(const Operand &o, int64_t w) const {
+    int reg = o.vreg + int(w / vreg_words_);
+    int64_t addr = int64_t(reg) * vreg_words_ + w % vreg_words_;
+    const int mask = (1 << bank_bits_) - 1;
+    int bank = addr & mask;
+    if (bank_hash_) {
+      for (int i = 0; bank_bits_ && i < 5; i += bank_bits_) {
+        bank ^= reg >> i;
+      }
+    }
+    return bank & mask;
+  }
+
+  // The reads and the writes share the port of a bank, or have their own
+  bool Grant(int bank, bool write) {
+    uint64_t &banks = banks_[p_.vrf_dual_port && write];
+    if (banks & (uint64_t(1) << bank)) {
+      ++stats_.bank_conflicts;
+      return false;
+    }
+    banks |= uint64_t(1) << bank;
+    return true;
+  }
+
+  // The word w of source i can be read
+  static bool Readable(const Inflight &c, int i, int64_t w) {
+    const Inflight *p = c.raw[i].get();
+    if (!p || p->done) {
+      return true;
+    }
+    if (!c.v.chain_in || !p->v.chain_out || p->v.dst.vreg != c.v.src[i].vreg ||
+        p->v.dst.eew != c.v.src[i].eew) {
+      return false;
+    }
+    return p->written > w;
+  }
+
+  // The word w of the destination can be written
+  static bool Writable(const Inflight &c, int64_t w) {
+    const Inflight *p = c.waw.get();
+    if (p && !p->done &&
+        !(p->v.dst.vreg == c.v.dst.vreg && p->v.dst.eew == c.v.dst.eew &&
+          p->written > w)) {
+      return false;
+    }
+    for (const auto &rd : c.war) {
+      const Inflight &r = *rd.first;
+      const Operand &o = r.v.src[rd.second];
+      if (!r.done && !(o.vreg == c.v.dst.vreg && o.eew == c.v.dst.eew &&
+                       r.read[rd.second] > w)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  void Execute() {
+    banks_[0] = banks_[1] = 0;
+    bool reading[kNrUnits] = {};
+    bool beating[kNrUnits] = {};
+    int64_t depth = p_.opq_depth;
+
+    // The oldest instructions have the priority on the banks
+    for (const InflightPtr &ip : window_) {
+      Inflight &in = *ip;
+      const Vinsn &v = in.v;
+      const Unit u = v.unit;
+
+      // Write-back
+      if (!in.wq.empty() && in.wq.front() <= now_ && Writable(in, in.written) &&
+          in.written < v.dst.words && Grant(Bank(v.dst, in.written), true)) {
+        in.wq.pop_front();
+        ++in.written;
+        progress_ = true;
+      }
+
+      const bool started = now_ >= in.start_cycle;
+      // Operand requests, in order in each unit
+      if (started && !reading[u]) {
+        for (int i = 0; i < v.nr_src; ++i) {
+          if (in.read[i] >= v.src[i].words) {
+            continue;
+          }
+          // The store data is consumed by the AXI W channel, and the
+          // indices and the masks of the VLSU are buffered
+          int64_t consumed = Consumed(v, i, in.beats_done);
+          int64_t limit = depth;
+          if (v.kind == kMemory) {
+            consumed = v.store && i == 0 ? in.mem_done * v.src[0].words / MemTotal(v)
+                                         : in.read[i];
+            // A W beat can need more than a word of each lane
+            limit = std::max(depth, axi_bytes_ / (8 * p_.nr_lanes) + 1);
+          }
+          if (in.read[i] - consumed < limit && Readable(in, i, in.read[i]) &&
+              Grant(Bank(v.src[i], in.read[i]), false)) {
+            ++in.read[i];
+            progress_ = true;
+          }
+        }
+      }
+      if (!in.ReadsDone()) {
+        reading[u] = true;
+      }
+
+      // Beats of the arithmetic units
+      if (v.kind != kMemory && started && !beating[u] && !in.BeatsDone() &&
+          now_ >= in.busy_until) {
+        bool ready = true;
+        for (int i = 0; i < v.nr_src; ++i) {
+          int64_t need = std::min(v.src[i].words,
+                                  in.beats_done * v.src[i].words / v.beats + 1);
+          if (in.read[i] < need) {
+            ready = false;
+          }
+        }
+        if (ready) {
+          if (in.first_beat < 0) {
+            in.first_beat = now_;
+          }
+          ++in.beats_done;
+          in.busy_until = now_ + v.beat_cycles;
+          ++stats_.unit_busy[u];
+          progress_ = true;
+          const bool last = in.beats_done == v.beats;
+          int64_t results = v.kind == kReduction || v.kind == kOrdered
+                                ? (last ? v.dst.words : 0)
+                                : in.beats_done * v.dst.words / v.beats;
+          if (v.dst.vreg < 0) {
+            results = 0;
+          }
+          int64_t ready_at = now_ + v.beat_cycles - 1 + v.lat + (last ? v.tail : 0);
+          for (; in.produced < results; ++in.produced) {
+            in.wq.push_back(ready_at);
+          }
+          if (last) {
+            in.last_result = ready_at;
+          }
+        }
+      }
+      if (!in.BeatsDone()) {
+        beating[u] = true;
+      }
+    }
+  }
+
+  ////////////
+  //  VLSU  //
+  ////////////
+
+  // Requests of the address generator to the AXI channels
+  struct AxiReq {
+    InflightPtr in;
+    int64_t amount;  // Bytes of a burst, or elements
+    int64_t ready;   // First cycle of the data
+  };
+
+  void Memory() {
+    AddrGen();
+    ReadChannel();
+    WriteChannel();
+    // Loads: the received words go to the write-back queue
+    for (const InflightPtr &ip : window_) {
+      Inflight &in = *ip;
+      if (in.v.kind != kMemory || in.v.store) {
+        continue;
+      }
+      const Vinsn &v = in.v;
+      int64_t total = MemTotal(v);
+      int64_t words = in.mem_done >= total ? v.dst.words : in.mem_done * v.dst.words / total;
+      for (; in.produced < words; ++in.produced) {
+        in.wq.push_back(now_ + v.lat);
+      }
+    }
+  }
+
+  void AddrGen() {
+    if (agen_q_.empty()) {
+      return;
+    }
+    Inflight &in = *agen_q_.front();
+    const Vinsn &v = in.v;
+    if (now_ < in.start_cycle) {
+      return;
+    }
+    if (in.agen_ack < 0) {
+      in.agen_ack = now_ + p_.addrgen_ack_lat;
+    }
+    const int64_t rd_lat = p_.dram_rd_latency;
+    auto &q = v.store ? w_q_ : r_q_;
+    if (v.access == kUnitStride) {
+      // One burst per cycle, up to 256 beats and within 4 KiB
+      uint64_t addr = v.rec.rs1 + in.agen_issued;
+      int64_t bytes = std::min<int64_t>(
+          {v.mem_bytes - in.agen_issued, int64_t(4096 - addr % 4096),
+           256 * axi_bytes_});
+      if (bytes > 0) {
+        q.push_back({agen_q_.front(), bytes, now_ + 1 + (v.store ? 0 : rd_lat)});
+        in.agen_issued += bytes;
+        progress_ = true;
+      }
+      if (in.agen_issued >= v.mem_bytes) {
+        agen_q_.pop_front();
+      }
+      return;
+    }
+    // One element per cycle. The indices are needed first.
+    int64_t avail = v.mem_elems;
+    if (v.access == kIndexed) {
+      const Operand &idx = v.src[v.addr_src];
+      avail = in.read[v.addr_src] >= idx.words
+                  ? v.mem_elems
+                  : in.read[v.addr_src] * (64 / idx.eew) * p_.nr_lanes;
+    }
+    if (in.agen_issued < std::min(avail, v.mem_elems)) {
+      q.push_back({agen_q_.front(), 1, now_ + 1 + (v.store ? 0 : rd_lat)});
+      ++in.agen_issued;
+      progress_ = true;
+    }
+    if (in.agen_issued >= v.mem_elems) {
+      agen_q_.pop_front();
+    }
+  }
+
+  // DRAM bandwidth, shared between the reads and the writes
+  bool DramTokens(int64_t bytes) {
+    if (!p_.dram_bw) {
+      return true;
+    }
+    if (dram_tokens_ < bytes) {
+      return false;
+    }
+    dram_tokens_ -= bytes;
+    return true;
+  }
+
+  void ReadChannel() {
+    if (p_.dram_bw) {
+      dram_tokens_ = std::min(dram_tokens_ + p_.dram_bw, 2 * axi_bytes_);
+    }
+    if (r_q_.empty() || r_q_.front().ready > now_) {
+      return;
+    }
+    AxiReq &r = r_q_.front();
+    Inflight &in = *r.in;
+    int64_t beat = in.v.access == kUnitStride ? std::min(r.amount, axi_bytes_) : 1;
+    int64_t bytes = in.v.access == kUnitStride ? beat : in.v.mem_bytes / in.v.mem_elems;
+    if (!DramTokens(bytes)) {
+      return;
+    }
+    r.amount -= beat;
+    in.mem_done += beat;
+    ++stats_.axi_r_beats;
+    progress_ = true;
+    if (!r.amount) {
+      r_q_.pop_front();
+    }
+  }
+
+  void WriteChannel() {
+    if (w_q_.empty() || w_q_.front().ready > now_) {
+      return;
+    }
+    AxiReq &r = w_q_.front();
+    Inflight &in = *r.in;
+    const Vinsn &v = in.v;
+    const bool unit = v.access == kUnitStride;
+    int64_t beat = unit ? std::min(r.amount, axi_bytes_) : 1;
+    // The data must have been read from all the lanes
+    int64_t total = MemTotal(v);
+    int64_t avail = in.read[0] >= v.src[0].words
+                        ? total
+                        : in.read[0] * total / v.src[0].words;
+    if (in.mem_done + beat > avail) {
+      return;
+    }
+    int64_t bytes = unit ? beat : v.mem_bytes / v.mem_elems;
+    if (!DramTokens(bytes)) {
+      return;
+    }
+    r.amount -= beat;
+    in.mem_done += beat;
+    ++stats_.axi_w_beats;
+    progress_ = true;
+    if (!r.amount) {
+      w_q_.pop_front();
+    }
+    if (in.mem_done == total) {
+      // Write response
+      in.finish_at = now_ + p_.dram_wr_latency + v.lat;
+    }
+  }
+
+  //////////////
+  //  Retire  //
+  //////////////
+
+  void Retire() {
+    for (const InflightPtr &ip : window_) {
+      Inflight &in = *ip;
+      const Vinsn &v = in.v;
+      bool done;
+      if (v.kind == kMemory && v.store) {
+        done = in.finish_at >= 0 && now_ >= in.finish_at;
+      } else if (v.dst.vreg >= 0) {
+        done = in.written == v.dst.words && in.BeatsDone();
+      } else {
+        done = in.BeatsDone() && in.beats_done > 0 && now_ >= in.last_result;
+      }
+      if (done && in.ReadsDone()) {
+        in.done = true;
+        in.end_cycle = now_;
+        progress_ = true;
+      }
+    }
+    while (!window_.empty() && window_.front()->done) {
+      Close(*window_.front());
+      window_.pop_front();
+    }
+    // The younger instructions can be done before the older ones
+    for (auto it = window_.begin(); it != window_.end();) {
+      if ((*it)->done) {
+        Close(**it);
+        it = window_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+
+  void Close(Inflight &in) {
+    --unit_count_[in.v.unit];
+    // Drop the references to the older instructions
+    for (InflightPtr &r : in.raw) {
+      r.reset();
+    }
+    in.waw.reset();
+    in.war.clear();
+    if (timeline_) {
+      fprintf(timeline_, "%" PRIu64 ",%08x,%s,%" PRId64 ",%d,%" PRId64 ",%" PRId64
+              ",%" PRId64 ",%d\n",
+              in.seq, in.v.rec.insn, kUnitNames[in.v.unit], in.v.vl, in.v.sew,
+              in.issue_cycle, in.first_beat, in.end_cycle, int(in.v.reshuffle));
+    }
+  }
+
+  const Params &p_;
+  Decoder dec_;
+  VtraceReader &trace_;
+  FILE *timeline_ = nullptr;
+  Stats stats_;
+
+  int64_t now_ = 0;
+  bool progress_ = false;
+
+  // Ideal dispatcher
+  Record next_{};
+  bool have_next_ = false;
+  bool fetched_ = false;
+  int64_t issue_ = 0;
+  int64_t accepted_ = 0;
+
+  // Ara's dispatcher: decoded instructions (and reshuffles), with the cycle
+  // they reach the sequencer
+  std::deque<std::pair<Vinsn, int64_t>> pending_;
+  InflightPtr wait_ack_;
+  InflightPtr wait_scalar_;
+  int eew_[32] = {};
+  bool eew_valid_[32] = {};
+
+  // Sequencer
+  Vinsn seq_insn_;
+  bool have_seq_insn_ = false;
+  uint64_t seq_ = 0;
+  std::deque<InflightPtr> window_;
+  int64_t unit_count_[kNrUnits] = {};
+  int64_t queue_depth_[kNrUnits] = {};
+  InflightPtr writer_[32];
+  std::vector<std::pair<InflightPtr, int>> readers_[32];
+
+  // Lanes
+  int vreg_words_ = 1;
+  bool bank_hash_ = true;
+  int bank_bits_ = 0;
+  uint64_t banks_[2] = {};
+
+  // VLSU
+  int64_t axi_bytes_ = 16;
+  int64_t dram_tokens_ = 0;
+  std::deque<InflightPtr> agen_q_;
+  std::deque<AxiReq> r_q_;
+  std::deque<AxiReq> w_q_;
+};
+
+void Usage() {
+  std::cerr << "Usage: ara_model [--config FILE] [--params FILE] "
+               "[-p name=value ...] [--timeline FILE] [--print-params] TRACE"
+            << std::endl
+            << "Parameters:";
+  for (const ParamDesc &d : kParams) {
+    std::cerr << " " << d.name;
+  }
+  std::cerr << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  Params p;
+  const char *trace_file = nullptr;
+  const char *timeline_file = nullptr;
+  bool print_params = false;
+  // The parameters are applied in order, so that -p overrides --params, and
+  // --params overrides --config
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    if (arg == "--config" && i + 1 < argc) {
+      if (!ReadConfig(p, argv[++i])) {
+        return 1;
+      }
+    } else if ((arg == "-p" || arg == "--param") && i + 1 < argc) {
+      if (!SetParam(p, argv[++i])) {
+        std::cerr << "[model] Unknown parameter " << argv[i] << std::endl;
+        Usage();
+        return 1;
+      }
+    } else if (arg == "--params" && i + 1 < argc) {
+      if (!ReadParams(p, argv[++i])) {
+        return 1;
+      }
+    } else if (arg == "--timeline" && i + 1 < argc) {
+      timeline_file = argv[++i];
+    } else if (arg == "--print-params") {
+      print_params = true;
+    } else if (arg[0] != '-' && !trace_file) {
+      trace_file = argv[i];
+    } else {
+      Usage();
+      return 1;
+    }
+  }
+  if (print_params) {
+    for (const ParamDesc &d : kParams) {
+      printf("%s = %" PRId64 "\n", d.name, p.*d.field);
+    }
+    return 0;
+  }
+  if (!trace_file) {
+    Usage();
+    return 1;
+  }
+  if (p.nr_lanes < 1 || (p.nr_lanes & (p.nr_lanes - 1)) || p.opq_depth < 1 ||
+      p.gather_elems < 1 || p.fdivsqrt_units < 1) {
+    std::cerr << "[model] Invalid parameters." << std::endl;
+    return 1;
+  }
+
+  VtraceReader trace;
+  if (!trace.Open(trace_file)) {
+    return 1;
+  }
+  FILE *timeline = nullptr;
+  if (timeline_file) {
+    timeline = fopen(timeline_file, "w");
+    if (!timeline) {
+      std::cerr << "[model] Cannot open " << timeline_file << std::endl;
+      return 1;
+    }
+    fprintf(timeline, "seq,insn,unit,vl,sew,issue,first_beat,end,reshuffle\n");
+  }
+
+  Model model(p, trace);
+  model.set_timeline(timeline);
+  int64_t cycles = model.Run();
+  if (timeline) {
+    fclose(timeline);
+  }
+  if (cycles < 0) {
+    return 1;
+  }
+
+  // Same format as the ideal dispatcher, for the scripts
+  const Stats &s = model.stats();
+  printf("[hw-cycles]: %" PRId64 "\n", cycles);
+  printf("[model] instructions: %" PRIu64 ", reshuffles: %" PRId64 "\n",
+         s.insns, s.reshuffles);
+  for (int u = 0; u < kNrUnits; ++u) {
+    printf("[model] %-5s busy: %5.1f%%\n", kUnitNames[u],
+           cycles ? 100.0 * s.unit_busy[u] / cycles : 0.0);
+  }
+  printf("[model] axi r: %5.1f%%, axi w: %5.1f%%, bank conflicts: %" PRId64 "\n",
+         cycles ? 100.0 * s.axi_r_beats / cycles : 0.0,
+         cycles ? 100.0 * s.axi_w_beats / cycles : 0.0, s.bank_conflicts);
+  printf("[model] sequencer stalls: window %" PRId64 ", queue %" PRId64
+         ", hazard %" PRId64 ", addrgen %" PRId64 ", scalar %" PRId64 "\n",
+         s.stall_window, s.stall_queue, s.stall_hazard, s.stall_ack,
+         s.stall_scalar);
+  return 0;
+}
@@ -8,17 +8,27 @@
 //
 // Note: the module does not support answers from Ara,
 // it is just a blind dispatcher
+//
+// By default, the instructions are dispatched as soon as Ara can accept them.
+// The issue bandwidth of a scalar core can be modeled with plusargs:
+//   +ideal_issue_interval=N: at least N cycles between two vector instructions
+//   +ideal_scalar_cpi=N:     N cycles for each scalar instruction that the
+//                            program executed between two vector instructions
+//                            (recorded in the vtrace)
+//   +ideal_issue_latency=N:  N cycles from the scalar issue to Ara
+// The scalar core issues instruction i at
+//   issue(i) = max(issue(i-1) + interval + gap(i) * cpi, accepted(i-1) + 1 - latency)
+// i.e., it stalls until Ara accepts the previous instruction, and Ara sees
+// instruction i from issue(i) + latency.
 
 `define STRINGIFY(x) `"x`"
 `ifndef VTRACE
 `define VTRACE ./
 `endif
 
-// Dummy definition not to throw errors during compilation
-// If N_VINSN is not defined, this file will not be used anyway
-`ifndef N_VINSN
-`define N_VINSN 1
-`endif
+import "DPI-C" function longint vtrace_open(input string filename);
+import "DPI-C" function bit vtrace_read(input longint unsigned idx, output bit [31:0] insn, output longint unsigned rs1, output longint unsigned rs2, output int unsigned gap);
+import "DPI-C" function void vtrace_close();
 
 module accel_dispatcher_ideal import axi_pkg::*; import ara_pkg::*; (
   input logic                     clk_i,
@@ -32,15 +42,16 @@ module accel_dispatcher_ideal import axi_pkg::*; import ara_pkg::*; (
   output logic              acc_resp_ready_o
 );
 
-  localparam string vtrace = `STRINGIFY(`VTRACE);
+  // Default vtrace, overridden by the +vtrace=<file> plusarg
+  localparam string DefaultVtrace = `STRINGIFY(`VTRACE);
 
   //////////
   // Data //
   //////////
 
-  // Width and number of vector instructions in the ideal dispatcher
-  localparam integer unsigned DATA_WIDTH  = 32 + 64 + 64; // vinsn + scalar reg + scalar reg
-  localparam integer unsigned N_VINSN   = `N_VINSN;
+  // The binary vtrace is streamed from a memory-mapped file by a DPI-C
+  // source (tb/dpi/vtrace_source.cc), one instruction at a time. The model
+  // does not depend on the length of the trace.
 
   typedef struct packed {
     riscv::instruction_t insn;
@@ -48,58 +59,75 @@ module accel_dispatcher_ideal import axi_pkg::*; import ara_pkg::*; (
     riscv::xlen_t rs2;
   } fifo_payload_t;
 
-  logic [DATA_WIDTH-1:0] fifo_data_raw;
+  // Next instruction to dispatch
   fifo_payload_t fifo_data;
+  logic [63:0]   read_pointer_q;
+  logic          fifo_empty;
+
+  // Scalar issue model
+  longint issue_interval, scalar_cpi, issue_latency;
+  // Cycles since the reset
+  longint cycle_q;
+  // Cycle in which the scalar core issues the next instruction
+  longint issue_q;
 
-  // FIFO-like structure with no reset
-  // Instantiated here without hierarchy to please questasim
-
-  // FIFO read pointer
-  logic [$clog2(N_VINSN):0] read_pointer_n, read_pointer_q;
-  // FIFO counter
-  logic [$clog2(N_VINSN):0] status_cnt_n, status_cnt_q;
-  // FIFO
-  logic [DATA_WIDTH-1:0] fifo_q [N_VINSN];
-  logic fifo_empty;
-
-  // read and write queue logic
-  always_comb begin : read_write_comb
-    // Default assignment
-    read_pointer_n = read_pointer_q;
-    status_cnt_n   = status_cnt_q;
-    fifo_data_raw  = fifo_q[read_pointer_q];
-
-    if (acc_req_ready_i && ~fifo_empty) begin
-      // read from the queue is a default assignment
-      // but increment the read pointer...
-      if (read_pointer_n == N_VINSN - 1)
-        read_pointer_n = '0;
-      else
-        read_pointer_n = read_pointer_q + 1;
-      // ... and decrement the overall count
-      status_cnt_n = status_cnt_q - 1;
+  initial begin
+    string vtrace;
+    if (!$value$plusargs("vtrace=%s", vtrace))
+      vtrace = DefaultVtrace;
+    if (vtrace_open(vtrace) < 0) begin
+      $error("Cannot read the vtrace %s.", vtrace);
+      $finish(1);
     end
+    if (!$value$plusargs("ideal_issue_interval=%d", issue_interval))
+      issue_interval = 1;
+    if (!$value$plusargs("ideal_scalar_cpi=%d", scalar_cpi))
+      scalar_cpi = 0;
+    if (!$value$plusargs("ideal_issue_latency=%d", issue_latency))
+      issue_latency = 0;
   end
+  final vtrace_close();
+
+  // Read the instruction at idx, and return whether it exists
+  function automatic logic read_vinsn(input logic [63:0] idx, output fifo_payload_t payload,
+      output longint gap);
+    bit [31:0] insn;
+    longint unsigned rs1, rs2;
+    int unsigned scalar_insns;
+    read_vinsn = vtrace_read(idx, insn, rs1, rs2, scalar_insns);
+    payload    = {insn, rs1, rs2};
+    gap        = scalar_insns;
+  endfunction : read_vinsn
 
   // sequential process
   always_ff @(posedge clk_i or negedge rst_ni) begin
+    automatic fifo_payload_t payload;
+    automatic longint gap;
     if (!rst_ni) begin
-      read_pointer_q  <= '0;
-      status_cnt_q    <= N_VINSN;
+      read_pointer_q <= '0;
+      cycle_q        <= '0;
+      fifo_empty     <= !read_vinsn(0, payload, gap);
+      fifo_data      <= payload;
+      issue_q        <= gap * scalar_cpi;
     end else begin
-      read_pointer_q  <= read_pointer_n;
-      status_cnt_q    <= status_cnt_n;
+      cycle_q <= cycle_q + 1;
+      if (acc_req_ready_i && acc_req_valid_o) begin
+        // Fetch the next instruction of the trace
+        read_pointer_q <= read_pointer_q + 1;
+        fifo_empty     <= !read_vinsn(read_pointer_q + 1, payload, gap);
+        fifo_data      <= payload;
+        // The scalar core issues it once it is done with the previous one
+        issue_q        <= (issue_q + issue_interval + gap * scalar_cpi > cycle_q + 1 - issue_latency) ?
+                          issue_q + issue_interval + gap * scalar_cpi : cycle_q + 1 - issue_latency;
+      end
     end
   end
 
-  assign fifo_empty = (status_cnt_q == 0);
-
-  // Always valid until empty
-  assign acc_req_valid_o = ~fifo_empty;
+  // Valid until empty, once the instruction reaches Ara
+  assign acc_req_valid_o = ~fifo_empty && (cycle_q >= issue_q + issue_latency);
   // Flush the answer
   assign acc_resp_ready_o = 1'b1;
   // Output assignment
-  assign fifo_data = fifo_payload_t'(fifo_data_raw);
   assign acc_req_o = '{
     insn    : fifo_data.insn,
     rs1     : fifo_data.rs1,
@@ -107,9 +135,6 @@ module accel_dispatcher_ideal import axi_pkg::*; import ara_pkg::*; (
     default : '0
   };
 
-  // Initialize the perfect dispatcher
-  initial $readmemh(vtrace, fifo_q);
-
   /////////////
   // Control //
   /////////////
@@ -133,7 +158,7 @@ module accel_dispatcher_ideal import axi_pkg::*; import ara_pkg::*; (
   // Stop the computation when the instructions are over and ara has returned idle
   // Just check that we are after reset
   always_ff @(posedge clk_i) begin
-    if (rst_ni && was_reset && !acc_req_valid_o && i_system.i_ara.ara_idle) begin
+    if (rst_ni && was_reset && fifo_empty && i_system.i_ara.ara_idle) begin
       $display("[hw-cycles]: %d", int'(perf_cnt_q));
       $info("Core Test ", $sformatf("*** SUCCESS *** (tohost = %0d)", 0));
       $finish(0);
@@ -0,0 +1,227 @@
+// Copyright 2021 ETH Zurich and University of Bologna.
+// Solderpad Hardware License, Version 0.51, see LICENSE for details.
+// SPDX-License-Identifier: SHL-0.51
+//
+// Description:
+// Spike as the scalar core of Ara, instead of CVA6 (Verilator only, make
+// verilate spike_core=1). Spike runs the program through DPI-C
+// (tb/verilator/spike_core.cc), and sends its vector instructions to Ara, with
+// the scalar operands of its registers. The scalar results of Ara are written
+// back to Spike. Spike shares the DRAM through its backdoor, and accesses the
+// other devices (control registers, UART) over the narrow AXI port, one beat
+// at a time.
+//
+// Spike executes a scalar instruction every +spike_cpi=N cycles (default 1),
+// and waits for the accesses of Ara that it depends on.
+
+import "DPI-C" function int spike_core_reset(input int unsigned hart, input longint unsigned boot_addr,
+  input int unsigned vlenb, input int unsigned trans_id_bits, input int unsigned cpi);
+import "DPI-C" function int spike_core_ara(input int unsigned hart, input bit req_ack,
+  input bit resp_valid, input int unsigned trans_id, input longint unsigned result, input bit error,
+  input bit fflags_valid, input int unsigned fflags, input bit load_complete, input bit store_complete);
+import "DPI-C" function int spike_core_tick(input int unsigned hart, input longint unsigned cycle,
+  output bit req_valid, output int unsigned insn, output longint unsigned rs1,
+  output longint unsigned rs2, output int unsigned frm, output int unsigned trans_id,
+  output bit mmio_valid, output bit mmio_write, output longint unsigned mmio_addr,
+  output int unsigned mmio_len, output longint unsigned mmio_wdata, output longint unsigned pc,
+  output bit write);
+import "DPI-C" function void spike_core_mmio_done(input int unsigned hart,
+  input longint unsigned rdata, input bit error);
+
+module accel_dispatcher_spike import axi_pkg::*; import ara_pkg::*; #(
+    parameter type axi_req_t  = logic,
+    parameter type axi_resp_t = logic
+  ) (
+    input  logic              clk_i,
+    input  logic              rst_ni,
+    input  logic       [63:0] boot_addr_i,
+    input  logic       [63:0] hart_id_i,
+    // Accelerator interface
+    output accelerator_req_t  acc_req_o,
+    output logic              acc_req_valid_o,
+    input  logic              acc_req_ready_i,
+    input  accelerator_resp_t acc_resp_i,
+    input  logic              acc_resp_valid_i,
+    output logic              acc_resp_ready_o,
+    // Narrow AXI port, for the accesses outside of the DRAM
+    output axi_req_t          axi_req_o,
+    input  axi_resp_t         axi_resp_i,
+    // Spike wrote the DRAM through its backdoor
+    output logic              write_o,
+    // PC of the next instruction of Spike
+    output logic       [63:0] pc_o
+  );
+
+  int unsigned cpi;
+
+  initial begin
+    if (!$value$plusargs("spike_cpi=%d", cpi))
+      cpi = 1;
+  end
+
+  //////////////////
+  //  Spike core  //
+  //////////////////
+
+  // State of the AXI access
+  typedef enum logic [2:0] {
+    MmioIdle, MmioWrite, MmioWaitB, MmioRead, MmioWaitR
+  } mmio_state_e;
+  mmio_state_e mmio_state_q;
+  logic        aw_done_q, w_done_q;
+
+  // Requests of Spike
+  logic        req_valid_q, mmio_valid_q, mmio_write_q, write_q;
+  logic [31:0] insn_q;
+  logic [63:0] rs1_q, rs2_q, mmio_addr_q, mmio_wdata_q, pc_q;
+  logic [2:0]  frm_q;
+  logic [3:0]  mmio_len_q;
+  logic [$bits(acc_req_o.trans_id)-1:0] trans_id_q;
+
+  longint unsigned cycle_q;
+
+  always_ff @(posedge clk_i or negedge rst_ni) begin: p_spike_core
+    automatic bit              req_valid, mmio_valid, mmio_write, write;
+    automatic int unsigned     insn, frm, trans_id, mmio_len;
+    automatic longint unsigned rs1, rs2, mmio_addr, mmio_wdata, pc;
+
+    if (!rst_ni) begin
+      if (spike_core_reset(hart_id_i, boot_addr_i, VLENB, $bits(acc_req_o.trans_id), cpi) != 0) begin
+        $error("[spike_core] Cannot reset Spike.");
+        $finish(1);
+      end
+      mmio_state_q <= MmioIdle;
+      aw_done_q    <= 1'b0;
+      w_done_q     <= 1'b0;
+      req_valid_q  <= 1'b0;
+      mmio_valid_q <= 1'b0;
+      mmio_write_q <= 1'b0;
+      write_q      <= 1'b0;
+      insn_q       <= '0;
+      rs1_q        <= '0;
+      rs2_q        <= '0;
+      frm_q        <= '0;
+      trans_id_q   <= '0;
+      mmio_addr_q  <= '0;
+      mmio_len_q   <= '0;
+      mmio_wdata_q <= '0;
+      pc_q         <= boot_addr_i;
+      cycle_q      <= 0;
+    end else begin
+      cycle_q <= cycle_q + 1;
+
+      // Single-beat AXI access of Spike
+      unique case (mmio_state_q)
+        MmioIdle: begin
+          aw_done_q <= 1'b0;
+          w_done_q  <= 1'b0;
+          if (mmio_valid_q) mmio_state_q <= mmio_write_q ? MmioWrite : MmioRead;
+        end
+        MmioWrite: begin
+          if (axi_req_o.aw_valid && axi_resp_i.aw_ready) aw_done_q <= 1'b1;
+          if (axi_req_o.w_valid && axi_resp_i.w_ready) w_done_q <= 1'b1;
+          if ((aw_done_q || axi_resp_i.aw_ready) && (w_done_q || axi_resp_i.w_ready))
+            mmio_state_q <= MmioWaitB;
+        end
+        MmioWaitB: begin
+          if (axi_resp_i.b_valid) begin
+            spike_core_mmio_done(hart_id_i, '0, axi_resp_i.b.resp != RESP_OKAY);
+            mmio_state_q <= MmioIdle;
+          end
+        end
+        MmioRead: begin
+          if (axi_resp_i.ar_ready) mmio_state_q <= MmioWaitR;
+        end
+        MmioWaitR: begin
+          if (axi_resp_i.r_valid) begin
+            spike_core_mmio_done(hart_id_i, axi_resp_i.r.data >> {mmio_addr_q[2:0], 3'b000},
+              axi_resp_i.r.resp != RESP_OKAY);
+            mmio_state_q <= MmioIdle;
+          end
+        end
+        default:;
+      endcase
+
+      // Handshakes with Ara
+      if (spike_core_ara(hart_id_i, acc_req_valid_o && acc_req_ready_i, acc_resp_valid_i,
+            acc_resp_i.trans_id, acc_resp_i.result, acc_resp_i.error, acc_resp_i.fflags_valid,
+            acc_resp_i.fflags, acc_resp_i.load_complete, acc_resp_i.store_complete) != 0) begin
+        $error("[spike_core] Ara rejected an instruction of Spike.");
+        $finish(1);
+      end
+
+      // Next instruction of Spike
+      if (spike_core_tick(hart_id_i, cycle_q, req_valid, insn, rs1, rs2, frm, trans_id,
+            mmio_valid, mmio_write, mmio_addr, mmio_len, mmio_wdata, pc, write) != 0) begin
+        $error("[spike_core] Spike failed.");
+        $finish(1);
+      end
+      req_valid_q  <= req_valid;
+      insn_q       <= insn;
+      rs1_q        <= rs1;
+      rs2_q        <= rs2;
+      frm_q        <= frm[2:0];
+      trans_id_q   <= trans_id;
+      mmio_valid_q <= mmio_valid;
+      mmio_write_q <= mmio_write;
+      mmio_addr_q  <= mmio_addr;
+      mmio_len_q   <= mmio_len[3:0];
+      mmio_wdata_q <= mmio_wdata;
+      pc_q         <= pc;
+      write_q      <= write;
+    end
+  end: p_spike_core
+
+  ///////////////
+  //  Outputs  //
+  ///////////////
+
+  assign acc_req_valid_o  = req_valid_q;
+  // Spike takes the answers as soon as they come
+  assign acc_resp_ready_o = 1'b1;
+  assign acc_req_o        = '{
+    insn    : riscv::instruction_t'(insn_q),
+    rs1     : rs1_q,
+    rs2     : rs2_q,
+    frm     : fpnew_pkg::roundmode_e'(frm_q),
+    trans_id: trans_id_q,
+    default : '0
+  };
+
+  assign write_o = write_q;
+  assign pc_o    = pc_q;
+
+  // Size of the access, from its bytes
+  function automatic logic [2:0] mmio_size(logic [3:0] len);
+    unique case (len)
+      4'd1:    mmio_size = 3'd0;
+      4'd2:    mmio_size = 3'd1;
+      4'd4:    mmio_size = 3'd2;
+      default: mmio_size = 3'd3;
+    endcase
+  endfunction : mmio_size
+
+  always_comb begin: p_mmio_axi
+    axi_req_o = '0;
+
+    axi_req_o.aw.addr  = mmio_addr_q;
+    axi_req_o.aw.size  = mmio_size(mmio_len_q);
+    axi_req_o.aw.burst = BURST_INCR;
+    axi_req_o.aw_valid = mmio_state_q == MmioWrite && !aw_done_q;
+
+    axi_req_o.w.data  = mmio_wdata_q << {mmio_addr_q[2:0], 3'b000};
+    axi_req_o.w.strb  = ((1 << mmio_len_q) - 1) << mmio_addr_q[2:0];
+    axi_req_o.w.last  = 1'b1;
+    axi_req_o.w_valid = mmio_state_q == MmioWrite && !w_done_q;
+
+    axi_req_o.b_ready = mmio_state_q == MmioWaitB;
+
+    axi_req_o.ar.addr  = mmio_addr_q;
+    axi_req_o.ar.size  = mmio_size(mmio_len_q);
+    axi_req_o.ar.burst = BURST_INCR;
+    axi_req_o.ar_valid = mmio_state_q == MmioRead;
+
+    axi_req_o.r_ready = mmio_state_q == MmioWaitR;
+  end: p_mmio_axi
+
+endmodule : accel_dispatcher_spike
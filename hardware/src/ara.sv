@@ -46,7 +46,20 @@ module ara import ara_pkg::*; #(
     input  logic              acc_resp_ready_i,
     // AXI interface
     output axi_req_t          axi_req_o,
-    input  axi_resp_t         axi_resp_i
+    input  axi_resp_t         axi_resp_i,
+    // Interface with CVA6's MMU
+    input  logic              en_ld_st_translation_i,
+    input  logic              flush_tlb_i,
+    output logic              mmu_req_o,
+    output logic [AxiAddrWidth-1:0] mmu_vaddr_o,
+    output logic              mmu_is_store_o,
+    input  logic              mmu_valid_i,
+    input  logic [AxiAddrWidth-1:0] mmu_paddr_i,
+    input  logic              mmu_exception_i,
+    // Lanes used by the vector instructions, from the control registers
+    input  logic [63:0]       active_lanes_i,
+    // Performance events
+    output perf_events_t      perf_events_o
   );
 
   import cf_math_pkg::idx_width;
@@ -57,8 +70,8 @@ module ara import ara_pkg::*; #(
 
   localparam int unsigned MaxVLenPerLane  = VLEN / NrLanes;       // In bits
   localparam int unsigned MaxVLenBPerLane = VLENB / NrLanes;      // In bytes
-  localparam int unsigned VRFSizePerLane  = MaxVLenPerLane * 32;  // In bits
-  localparam int unsigned VRFBSizePerLane = MaxVLenBPerLane * 32; // In bytes
+  localparam int unsigned VRFSizePerLane  = MaxVLenPerLane * NrPhysVRegs;  // In bits
+  localparam int unsigned VRFBSizePerLane = MaxVLenBPerLane * NrPhysVRegs; // In bytes
   // Address of an element in each lane's VRF
   typedef logic [idx_width(VRFBSizePerLane)-1:0] vaddr_t;
 
@@ -66,16 +79,86 @@ module ara import ara_pkg::*; #(
   localparam int unsigned StrbWidth = DataWidth / 8;
   typedef logic [StrbWidth-1:0] strb_t;
 
+  /////////////////////////
+  //  Instruction queue  //
+  /////////////////////////
+
+  // Interface with the dispatcher
+  accelerator_req_t  acc_queue_req;
+  logic              acc_queue_req_valid;
+  logic              acc_queue_req_ready;
+  accelerator_resp_t acc_queue_resp;
+  logic              acc_queue_resp_valid;
+  logic              acc_queue_resp_ready;
+  logic              acc_queue_empty;
+
+  ara_insn_queue i_insn_queue (
+    .clk_i           (clk_i           ),
+    .rst_ni          (rst_ni          ),
+    // Interface with Ariane
+    .acc_req_i       (acc_req_i       ),
+    .acc_req_valid_i (acc_req_valid_i ),
+    .acc_req_ready_o (acc_req_ready_o ),
+    .acc_resp_o      (acc_resp_o      ),
+    .acc_resp_valid_o(acc_resp_valid_o),
+    .acc_resp_ready_i(acc_resp_ready_i),
+    // Interface with the loop buffer
+    .acc_req_o       (acc_queue_req       ),
+    .acc_req_valid_o (acc_queue_req_valid ),
+    .acc_req_ready_i (acc_queue_req_ready ),
+    .acc_resp_i      (acc_queue_resp      ),
+    .acc_resp_valid_i(acc_queue_resp_valid),
+    .acc_resp_ready_o(acc_queue_resp_ready),
+    .empty_o         (acc_queue_empty     ),
+    .early_ack_o     (perf_events_o.acc_early_ack)
+  );
+
+  ///////////////////
+  //  Loop buffer  //
+  ///////////////////
+
+  accelerator_req_t  acc_req;
+  logic              acc_req_valid;
+  logic              acc_req_ready;
+  accelerator_resp_t acc_resp;
+  logic              acc_resp_valid;
+  logic              acc_resp_ready;
+  logic              loop_buf_idle;
+
+  ara_loop_buffer i_loop_buffer (
+    .clk_i           (clk_i               ),
+    .rst_ni          (rst_ni              ),
+    // Interface with the instruction queue
+    .acc_req_i       (acc_queue_req       ),
+    .acc_req_valid_i (acc_queue_req_valid ),
+    .acc_req_ready_o (acc_queue_req_ready ),
+    .acc_resp_o      (acc_queue_resp      ),
+    .acc_resp_valid_o(acc_queue_resp_valid),
+    .acc_resp_ready_i(acc_queue_resp_ready),
+    // Interface with the dispatcher
+    .acc_req_o       (acc_req             ),
+    .acc_req_valid_o (acc_req_valid       ),
+    .acc_req_ready_i (acc_req_ready       ),
+    .acc_resp_i      (acc_resp            ),
+    .acc_resp_valid_i(acc_resp_valid      ),
+    .acc_resp_ready_o(acc_resp_ready      ),
+    .idle_o          (loop_buf_idle       )
+  );
+
   //////////////////
   //  Dispatcher  //
   //////////////////
 
-  // Interface with the sequencer
+  // Interface with the renamer
   ara_req_t                     ara_req;
   logic                         ara_req_valid;
   logic                         ara_req_ready;
+  // Interface with the sequencer
   ara_resp_t                    ara_resp;
   logic                         ara_resp_valid;
+  logic                         seq_idle;
+  // Ara is idle when the sequencer is, no instruction waits in the queue, and the loop buffer
+  // does not replay a loop
   logic                         ara_idle;
   // Interface with the VSTU
   logic                         core_st_pending;
@@ -93,20 +176,20 @@ module ara import ara_pkg::*; #(
   ) i_dispatcher (
     .clk_i             (clk_i           ),
     .rst_ni            (rst_ni          ),
-    // Interface with Ariane
-    .acc_req_i         (acc_req_i       ),
-    .acc_req_valid_i   (acc_req_valid_i ),
-    .acc_req_ready_o   (acc_req_ready_o ),
-    .acc_resp_o        (acc_resp_o      ),
-    .acc_resp_valid_o  (acc_resp_valid_o),
-    .acc_resp_ready_i  (acc_resp_ready_i),
+    // Interface with the loop buffer
+    .acc_req_i         (acc_req         ),
+    .acc_req_valid_i   (acc_req_valid   ),
+    .acc_req_ready_o   (acc_req_ready   ),
+    .acc_resp_o        (acc_resp        ),
+    .acc_resp_valid_o  (acc_resp_valid  ),
+    .acc_resp_ready_i  (acc_resp_ready  ),
     // Interface with the sequencer
     .ara_req_o         (ara_req         ),
     .ara_req_valid_o   (ara_req_valid   ),
     .ara_req_ready_i   (ara_req_ready   ),
     .ara_resp_i        (ara_resp        ),
     .ara_resp_valid_i  (ara_resp_valid  ),
-    .ara_idle_i        (ara_idle        ),
+    .ara_idle_i        (seq_idle        ),
     // Interface with the lanes
     .vxsat_flag_i      (vxsat_flag      ),
     .alu_vxrm_o        (alu_vxrm        ),
@@ -116,7 +199,30 @@ module ara import ara_pkg::*; #(
     .core_st_pending_o (core_st_pending ),
     .load_complete_i   (load_complete   ),
     .store_complete_i  (store_complete  ),
-    .store_pending_i   (store_pending   )
+    .store_pending_i   (store_pending   ),
+    .active_lanes_i    (active_lanes_i  )
+  );
+
+  ///////////////
+  //  Renamer  //
+  ///////////////
+
+  // Interface with the sequencer, on the physical vector registers
+  ara_req_t ara_req_phys;
+  logic     ara_req_phys_valid;
+  logic     ara_req_phys_ready;
+
+  ara_rename i_rename (
+    .clk_i          (clk_i             ),
+    .rst_ni         (rst_ni            ),
+    // Interface with the dispatcher
+    .ara_req_i      (ara_req           ),
+    .ara_req_valid_i(ara_req_valid     ),
+    .ara_req_ready_o(ara_req_ready     ),
+    // Interface with the sequencer
+    .ara_req_o      (ara_req_phys      ),
+    .ara_req_valid_o(ara_req_phys_valid),
+    .ara_req_ready_i(ara_req_phys_ready)
   );
 
   /////////////////
@@ -135,10 +241,14 @@ module ara import ara_pkg::*; #(
   vlen_t                           addrgen_error_vl;
   logic              [NrLanes-1:0] alu_vinsn_done;
   logic              [NrLanes-1:0] mfpu_vinsn_done;
+  logic              [NrLanes-1:0] mfpu2_vinsn_done;
+  logic              [NrLanes-1:0] mxu_vinsn_done;
   // Interface with the operand requesters
   logic [NrVInsn-1:0][NrVInsn-1:0] global_hazard_table;
   // Ready for lane 0 (scalar operand fwd)
   logic pe_scalar_resp_ready;
+  // The scalar result comes from the MASKU
+  logic pe_scalar_resp_masku;
 
   // Mask unit operands
   elen_t     [NrLanes-1:0][NrMaskFUnits+2-1:0] masku_operand;
@@ -157,12 +267,12 @@ module ara import ara_pkg::*; #(
     .clk_i                 (clk_i                    ),
     .rst_ni                (rst_ni                   ),
     // Interface with the dispatcher
-    .ara_req_i             (ara_req                  ),
-    .ara_req_valid_i       (ara_req_valid            ),
-    .ara_req_ready_o       (ara_req_ready            ),
+    .ara_req_i             (ara_req_phys             ),
+    .ara_req_valid_i       (ara_req_phys_valid       ),
+    .ara_req_ready_o       (ara_req_phys_ready       ),
     .ara_resp_o            (ara_resp                 ),
     .ara_resp_valid_o      (ara_resp_valid           ),
-    .ara_idle_o            (ara_idle                 ),
+    .ara_idle_o            (seq_idle                 ),
     // Interface with the PEs
     .pe_req_o              (pe_req                   ),
     .pe_req_valid_o        (pe_req_valid             ),
@@ -171,18 +281,35 @@ module ara import ara_pkg::*; #(
     .pe_resp_i             (pe_resp                  ),
     .alu_vinsn_done_i      (alu_vinsn_done[0]        ),
     .mfpu_vinsn_done_i     (mfpu_vinsn_done[0]       ),
+    .mfpu2_vinsn_done_i    (mfpu2_vinsn_done[0]      ),
+    .mxu_vinsn_done_i      (mxu_vinsn_done[0]        ),
     // Interface with the operand requesters
     .global_hazard_table_o (global_hazard_table      ),
     // Interface with the lane 0
-    .pe_scalar_resp_i      (pe_req.op inside{[VCPOP:VFIRST]} ? result_scalar : masku_operand[0][1]), // MaskB OpQueue
-    .pe_scalar_resp_valid_i(pe_req.op inside{[VCPOP:VFIRST]} ? result_scalar_valid : masku_operand_valid[0][1]), // MaskB OpQueue Valid
+    .pe_scalar_resp_i      (pe_scalar_resp_masku ? result_scalar : masku_operand[0][1]), // MaskB OpQueue
+    .pe_scalar_resp_valid_i(pe_scalar_resp_masku ? result_scalar_valid : masku_operand_valid[0][1]), // MaskB OpQueue Valid
     .pe_scalar_resp_ready_o(pe_scalar_resp_ready     ),
+    .pe_scalar_resp_masku_o(pe_scalar_resp_masku     ),
     // Interface with the address generator
     .addrgen_ack_i         (addrgen_ack              ),
     .addrgen_error_i       (addrgen_error            ),
-    .addrgen_error_vl_i    (addrgen_error_vl         )
+    .addrgen_error_vl_i    (addrgen_error_vl         ),
+    // Performance events
+    .perf_valu_busy_o          (perf_events_o.valu_busy          ),
+    .perf_vmfpu_busy_o         (perf_events_o.vmfpu_busy         ),
+    .perf_vmfpu2_busy_o        (perf_events_o.vmfpu2_busy        ),
+    .perf_vmxu_busy_o          (perf_events_o.vmxu_busy          ),
+    .perf_vldu_busy_o          (perf_events_o.vldu_busy          ),
+    .perf_vstu_busy_o          (perf_events_o.vstu_busy          ),
+    .perf_sldu_busy_o          (perf_events_o.sldu_busy          ),
+    .perf_masku_busy_o         (perf_events_o.masku_busy         ),
+    .perf_stall_lanes_desynch_o(perf_events_o.stall_lanes_desynch),
+    .perf_stall_vinsn_full_o   (perf_events_o.stall_vinsn_full   ),
+    .perf_stall_hazard_o       (perf_events_o.stall_hazard       )
   );
 
+  assign ara_idle = seq_idle && acc_queue_empty && loop_buf_idle;
+
   // Scalar move support
   always_comb begin
     masku_operand_ready_lane = masku_operand_ready_masku;
@@ -207,6 +334,9 @@ module ara import ara_pkg::*; #(
   sldu_mux_e                                   sldu_mux_sel;
   logic                                        addrgen_operand_ready;
   logic      [NrLanes-1:0]                     sldu_red_valid;
+  // Partial sums of the ordered reductions, from each lane to the next one
+  elen_t     [NrLanes-1:0]                     osum_result;
+  logic      [NrLanes-1:0]                     osum_result_valid;
 
   // Results
   // Load Unit
@@ -233,8 +363,17 @@ module ara import ara_pkg::*; #(
   strb_t     [NrLanes-1:0]                     masku_result_be;
   logic      [NrLanes-1:0]                     masku_result_gnt;
   logic      [NrLanes-1:0]                     masku_result_final_gnt;
+  // Performance events
+  logic      [NrLanes-1:0]                     vrf_bank_conflict;
+  logic      [NrLanes-1:0]                     vrf_rw_conflict;
+  logic      [NrLanes-1:0]                     valu_clk_on;
+  logic      [NrLanes-1:0]                     vmfpu_clk_on;
+  logic      [NrLanes-1:0]                     vmfpu2_clk_on;
 
   for (genvar lane = 0; lane < NrLanes; lane++) begin: gen_lanes
+    // The lane that gives this one the partial sums of the ordered reductions
+    localparam int unsigned PrevLane = (lane + NrLanes - 1) % NrLanes;
+
     lane #(
       .NrLanes     (NrLanes     ),
       .FPUSupport  (FPUSupport  ),
@@ -260,6 +399,8 @@ module ara import ara_pkg::*; #(
       .pe_resp_o                       (pe_resp[lane]                       ),
       .alu_vinsn_done_o                (alu_vinsn_done[lane]                ),
       .mfpu_vinsn_done_o               (mfpu_vinsn_done[lane]               ),
+      .mfpu2_vinsn_done_o              (mfpu2_vinsn_done[lane]              ),
+      .mxu_vinsn_done_o                (mxu_vinsn_done[lane]                ),
       .global_hazard_table_i           (global_hazard_table                 ),
       // Interface with the slide unit
       .sldu_result_req_i               (sldu_result_req[lane]               ),
@@ -269,6 +410,11 @@ module ara import ara_pkg::*; #(
       .sldu_result_be_i                (sldu_result_be[lane]                ),
       .sldu_result_gnt_o               (sldu_result_gnt[lane]               ),
       .sldu_result_final_gnt_o         (sldu_result_final_gnt[lane]         ),
+      // Interface with the neighbour lanes
+      .osum_result_o                   (osum_result[lane]                   ),
+      .osum_result_valid_o             (osum_result_valid[lane]             ),
+      .osum_operand_i                  (osum_result[PrevLane]               ),
+      .osum_operand_valid_i            (osum_result_valid[PrevLane]         ),
       // Interface with the load unit
       .ldu_result_req_i                (ldu_result_req[lane]                ),
       .ldu_result_addr_i               (ldu_result_addr[lane]               ),
@@ -302,10 +448,22 @@ module ara import ara_pkg::*; #(
       .masku_result_final_gnt_o        (masku_result_final_gnt[lane]        ),
       .mask_i                          (mask[lane]                          ),
       .mask_valid_i                    (mask_valid[lane] & mask_valid_lane  ),
-      .mask_ready_o                    (lane_mask_ready[lane]               )
+      .mask_ready_o                    (lane_mask_ready[lane]               ),
+      // Performance events
+      .perf_vrf_bank_conflict_o        (vrf_bank_conflict[lane]             ),
+      .perf_vrf_rw_conflict_o          (vrf_rw_conflict[lane]               ),
+      .perf_valu_clk_on_o              (valu_clk_on[lane]                   ),
+      .perf_vmfpu_clk_on_o             (vmfpu_clk_on[lane]                  ),
+      .perf_vmfpu2_clk_on_o            (vmfpu2_clk_on[lane]                 )
     );
   end: gen_lanes
 
+  assign perf_events_o.vrf_bank_conflict = |vrf_bank_conflict;
+  assign perf_events_o.vrf_rw_conflict   = |vrf_rw_conflict;
+  assign perf_events_o.valu_clk_on       = |valu_clk_on;
+  assign perf_events_o.vmfpu_clk_on      = |vmfpu_clk_on;
+  assign perf_events_o.vmfpu2_clk_on     = |vmfpu2_clk_on;
+
 
   //////////////////////////////
   //  Vector Load/Store Unit  //
@@ -369,7 +527,19 @@ module ara import ara_pkg::*; #(
     .ldu_result_wdata_o         (ldu_result_wdata                                      ),
     .ldu_result_be_o            (ldu_result_be                                         ),
     .ldu_result_gnt_i           (ldu_result_gnt                                        ),
-    .ldu_result_final_gnt_i     (ldu_result_final_gnt                                  )
+    .ldu_result_final_gnt_i     (ldu_result_final_gnt                                  ),
+    // Interface with CVA6's MMU
+    .en_ld_st_translation_i     (en_ld_st_translation_i                                ),
+    .flush_tlb_i                (flush_tlb_i                                           ),
+    .mmu_req_o                  (mmu_req_o                                             ),
+    .mmu_vaddr_o                (mmu_vaddr_o                                           ),
+    .mmu_is_store_o             (mmu_is_store_o                                        ),
+    .mmu_valid_i                (mmu_valid_i                                           ),
+    .mmu_paddr_i                (mmu_paddr_i                                           ),
+    .mmu_exception_i            (mmu_exception_i                                       ),
+    // Performance events
+    .perf_st_merge_o            (perf_events_o.st_merge                                ),
+    .perf_st_wcb_beat_o         (perf_events_o.st_wcb_beat                             )
   );
 
   //////////////////
@@ -379,11 +549,39 @@ module ara import ara_pkg::*; #(
   // Interface with the Mask Unit
   logic sldu_mask_ready;
 
+  // The slide unit is clocked while it has instructions, while the sequencer broadcasts a new one,
+  // and while the lanes send operands to it or to the address generator, so that it keeps
+  // tracking their target. The clock stays on for one more cycle after that.
+  logic sldu_clk, sldu_clk_en, sldu_clk_en_q;
+
+  assign sldu_clk_en = pe_req_valid || perf_events_o.sldu_busy || |sldu_addrgen_operand_valid;
+  assign perf_events_o.sldu_clk_on = sldu_clk_en || sldu_clk_en_q;
+
+  always_ff @(posedge clk_i or negedge rst_ni) begin
+    if (!rst_ni) sldu_clk_en_q <= 1'b0;
+    else sldu_clk_en_q <= sldu_clk_en;
+  end
+
+`ifndef VERILATOR
+  if (FuClkGating) begin: gen_sldu_clk_gating
+    tc_clk_gating i_sldu_ckg (
+      .clk_i    (clk_i                    ),
+      .en_i     (perf_events_o.sldu_clk_on),
+      .test_en_i(1'b0                     ),
+      .clk_o    (sldu_clk                 )
+    );
+  end else begin: gen_sldu_clk
+    assign sldu_clk = clk_i;
+  end: gen_sldu_clk
+`else
+  assign sldu_clk = clk_i;
+`endif
+
   sldu #(
     .NrLanes(NrLanes),
     .vaddr_t(vaddr_t)
   ) i_sldu (
-    .clk_i                   (clk_i                            ),
+    .clk_i                   (sldu_clk                         ),
     .rst_ni                  (rst_ni                           ),
     // Interface with the main sequencer
     .pe_req_i                (pe_req                           ),
@@ -450,6 +648,19 @@ module ara import ara_pkg::*; #(
     .sldu_mask_ready_i       (sldu_mask_ready                 )
   );
 
+  //////////////////////////
+  //  Performance events  //
+  //////////////////////////
+
+  assign perf_events_o.axi_r_beat    = axi_resp_i.r_valid && axi_req_o.r_ready;
+  assign perf_events_o.axi_w_beat    = axi_req_o.w_valid && axi_resp_i.w_ready;
+  assign perf_events_o.acc_req_stall = acc_req_valid_i && !acc_req_ready_o;
+  // The vector cache and the prefetcher are outside of Ara, in ara_system
+  assign perf_events_o.vcache_hit    = 1'b0;
+  assign perf_events_o.vcache_miss   = 1'b0;
+  assign perf_events_o.prefetch_beat = 1'b0;
+  assign perf_events_o.prefetch_hit  = 1'b0;
+
   //////////////////
   //  Assertions  //
   //////////////////
@@ -463,6 +674,19 @@ module ara import ara_pkg::*; #(
   if (NrLanes > MaxNrLanes)
     $error("[ara] Ara supports at most MaxNrLanes lanes.");
 
+  if (ValuInsnQueueDepth == 0 || MfpuInsnQueueDepth == 0 || VlduInsnQueueDepth == 0 ||
+      VstuInsnQueueDepth == 0 || SlduInsnQueueDepth == 0 || MaskuInsnQueueDepth == 0)
+    $error("[ara] The instruction queues of the functional units must hold at least one instruction.");
+
+  if (NrVInsn < 2 || NrVInsn > 32 || NrVInsn != 2**$clog2(NrVInsn))
+    $error("[ara] The number of instructions in flight must be a power of two between 2 and 32.");
+
+  if (FPAltFmtSupport && !(RVVH(FPUSupport) && RVVF(FPUSupport)))
+    $error("[ara] The BF16 support needs the FP16 and FP32 support.");
+
+  if (FDivSqrtUnits == 0)
+    $error("[ara] The lanes need at least one floating-point division and square root unit.");
+
   if (ara_pkg::VLEN == 0)
     $error("[ara] The vector length must be greater than zero.");
 
@@ -44,7 +44,9 @@ module ara_dispatcher import ara_pkg::*; import rvv_pkg::*; #(
     output logic                                 core_st_pending_o,
     input  logic                                 load_complete_i,
     input  logic                                 store_complete_i,
-    input  logic                                 store_pending_i
+    input  logic                                 store_pending_i,
+    // Lanes left active by the software, from the control registers
+    input  logic              [63:0]             active_lanes_i
   );
 
   import cf_math_pkg::idx_width;
@@ -68,16 +70,31 @@ module ara_dispatcher import ara_pkg::*; import rvv_pkg::*; #(
   `FF(vtype_q, vtype_d, '{vill: 1'b1, default: '0})
   `FF(vxsat_q, vxsat_d, '0)
   `FF(vxrm_q, vxrm_d, '0)
+
+  // VLMAX is scaled to the lanes that the software left active, rounded down to a power of two.
+  // Zero, or at least NrLanes, keeps all of them.
+  logic [$clog2(NrLanes):0] vlmax_shift_d, vlmax_shift_q;
+
+  always_comb begin: p_vlmax_shift
+    vlmax_shift_d = '0;
+    if (active_lanes_i != '0)
+      for (int unsigned k = 0; k < $clog2(NrLanes); k++)
+        if (active_lanes_i < 64'(NrLanes >> k))
+          vlmax_shift_d += 1;
+  end: p_vlmax_shift
+
+  `FF(vlmax_shift_q, vlmax_shift_d, '0)
   // Converts between the internal representation of `vtype_t` and the full XLEN-bit CSR.
   function automatic riscv::xlen_t xlen_vtype(vtype_t vtype);
-    xlen_vtype = {vtype.vill, {riscv::XLEN-9{1'b0}}, vtype.vma, vtype.vta, vtype.vsew,
-      vtype.vlmul[2:0]};
+    xlen_vtype = {vtype.vill, {riscv::XLEN-10{1'b0}}, vtype.altfmt, vtype.vma, vtype.vta,
+      vtype.vsew, vtype.vlmul[2:0]};
   endfunction: xlen_vtype
 
   // Converts between the XLEN-bit vtype CSR and its internal representation
   function automatic vtype_t vtype_xlen(riscv::xlen_t xlen);
     vtype_xlen = '{
       vill  : xlen[riscv::XLEN-1],
+      altfmt: xlen[8],
       vma   : xlen[7],
       vta   : xlen[6],
       vsew  : vew_e'(xlen[5:3]),
@@ -107,6 +124,21 @@ module ara_dispatcher import ara_pkg::*; import rvv_pkg::*; #(
     endcase
   endfunction : prev_prev_ew
 
+  // Number of vector registers of a register group
+  function automatic int unsigned lmul_regs(vlmul_e lmul);
+    unique case (lmul)
+      LMUL_2 : lmul_regs = 2;
+      LMUL_4 : lmul_regs = 4;
+      LMUL_8 : lmul_regs = 8;
+      default: lmul_regs = 1;
+    endcase
+  endfunction : lmul_regs
+
+  // Do the register groups starting at a and b overlap?
+  function automatic logic vreg_overlap(logic [4:0] a, int unsigned a_regs, logic [4:0] b, int unsigned b_regs);
+    vreg_overlap = (a < b + b_regs) && (b < a + a_regs);
+  endfunction : vreg_overlap
+
   /////////////////////////
   //  Backend interface  //
   /////////////////////////
@@ -158,6 +190,16 @@ module ara_dispatcher import ara_pkg::*; import rvv_pkg::*; #(
   logic [4:0] vs_buffer_d, vs_buffer_q;
   // Keep track of the registers to be reshuffled |vs1|vs2|vd|
   logic [2:0] reshuffle_req_d, reshuffle_req_q;
+  // Segment memory operations are split into one strided (or indexed) operation per field.
+  // Field being issued
+  logic [2:0] seg_field_d, seg_field_q;
+  // Ariane counts one pending memory operation per instruction, so the completions of all the
+  // fields but the last one are hidden from it
+  logic [5:0] seg_load_skip_d, seg_load_skip_q;
+  logic [5:0] seg_store_skip_d, seg_store_skip_q;
+  // vrgather.vv is split into one operation per register of the source register group.
+  // Register being gathered from
+  logic [2:0] perm_pass_d, perm_pass_q;
 
   always_ff @(posedge clk_i or negedge rst_ni) begin
     if (!rst_ni) begin
@@ -171,6 +213,10 @@ module ara_dispatcher import ara_pkg::*; import rvv_pkg::*; #(
       rs_lmul_cnt_q       <= '0;
       rs_lmul_cnt_limit_q <= '0;
       rs_mask_request_q   <= 1'b0;
+      seg_field_q         <= '0;
+      seg_load_skip_q     <= '0;
+      seg_store_skip_q    <= '0;
+      perm_pass_q         <= '0;
     end else begin
       state_q             <= state_d;
       eew_q               <= eew_d;
@@ -182,6 +228,10 @@ module ara_dispatcher import ara_pkg::*; import rvv_pkg::*; #(
       rs_lmul_cnt_q       <= rs_lmul_cnt_d;
       rs_lmul_cnt_limit_q <= rs_lmul_cnt_limit_d;
       rs_mask_request_q   <= rs_mask_request_d;
+      seg_field_q         <= seg_field_d;
+      seg_load_skip_q     <= seg_load_skip_d;
+      seg_store_skip_q    <= seg_store_skip_d;
+      perm_pass_q         <= perm_pass_d;
     end
   end
 
@@ -191,6 +241,8 @@ module ara_dispatcher import ara_pkg::*; import rvv_pkg::*; #(
 
   // Helper signals to discriminate between config/csr, load/store instructions and the others
   logic is_config, is_vload, is_vstore;
+  // Configuration instructions that can bypass a stalled backend
+  logic is_vsetvl;
   // Whole-register memory-ops / move should be executed even when vl == 0
   logic ignore_zero_vl_check;
   // Helper signals to identify memory operations with vl == 0. They must acknoledge Ariane to update
@@ -218,6 +270,21 @@ module ara_dispatcher import ara_pkg::*; import rvv_pkg::*; #(
   `FF(load_complete_q, load_complete_i, 1'b0)
   `FF(store_complete_q, store_complete_i, 1'b0)
 
+  // With ScalarRespAsync, vmv.x.s, vfmv.f.s, vcpop.m, and vfirst.m are acknowledged right away,
+  // and their result is sent to CVA6 with their transaction ID once the back-end returns it.
+  // In the meanwhile, the instructions that wait for an acknowledgment of the back-end
+  // (these ones, and the memory operations) are held.
+  logic      scalar_pending_d, scalar_pending_q;
+  logic      scalar_resp_valid_d, scalar_resp_valid_q;
+  ara_resp_t scalar_resp_d, scalar_resp_q;
+  logic [$bits(acc_req_i.trans_id)-1:0] scalar_trans_id_d, scalar_trans_id_q;
+  // The incoming instruction waits for an acknowledgment of the back-end
+  logic      waits_backend;
+  `FF(scalar_pending_q, scalar_pending_d, 1'b0)
+  `FF(scalar_resp_valid_q, scalar_resp_valid_d, 1'b0)
+  `FF(scalar_resp_q, scalar_resp_d, '0)
+  `FF(scalar_trans_id_q, scalar_trans_id_d, '0)
+
   // NP2 Slide support
   logic is_stride_np2;
   logic [idx_width(idx_width(VLENB << 3)):0] sldu_popc;
@@ -258,6 +325,24 @@ module ara_dispatcher import ara_pkg::*; import rvv_pkg::*; #(
     rs_lmul_cnt_limit_d = '0;
     rs_mask_request_d   = 1'b0;
 
+    seg_field_d      = seg_field_q;
+    seg_load_skip_d  = seg_load_skip_q - (load_complete_q && seg_load_skip_q != '0);
+    seg_store_skip_d = seg_store_skip_q - (store_complete_q && seg_store_skip_q != '0);
+
+    perm_pass_d = perm_pass_q;
+
+    scalar_pending_d    = scalar_pending_q;
+    scalar_resp_valid_d = scalar_resp_valid_q;
+    scalar_resp_d       = scalar_resp_q;
+    scalar_trans_id_d   = scalar_trans_id_q;
+
+    // Keep the scalar result until CVA6 takes it
+    if (scalar_pending_q && ara_resp_valid_i) begin
+      scalar_pending_d    = 1'b0;
+      scalar_resp_valid_d = 1'b1;
+      scalar_resp_d       = ara_resp_i;
+    end
+
     illegal_insn = 1'b0;
     vxsat_d      = vxsat_q;
     vxrm_d       = vxrm_q;
@@ -426,8 +511,20 @@ module ara_dispatcher import ara_pkg::*; import rvv_pkg::*; #(
       end
     endcase
 
+    // vset{i}vl{i} only update vl and vtype, and do not issue anything to the backend. They are
+    // answered right away, even if the backend did not accept the previous request yet.
+    is_vsetvl = acc_req_i.insn.itype.opcode == riscv::OpcodeVec &&
+                rvv_instruction_t'(acc_req_i.insn.instr).varith_type.func3 == OPCFG;
+
+    waits_backend = acc_req_i.insn.itype.opcode inside {riscv::OpcodeLoadFp, riscv::OpcodeStoreFp,
+                                                        riscv::OpcodeAmo} ||
+                    (acc_req_i.insn.itype.opcode == riscv::OpcodeVec &&
+                     rvv_instruction_t'(acc_req_i.insn.instr).varith_type.func3 inside {OPMVV, OPFVV} &&
+                     rvv_instruction_t'(acc_req_i.insn.instr).varith_type.func6 == 6'b010000);
+
     if (state_d == NORMAL_OPERATION && state_q != RESHUFFLE) begin
-      if (acc_req_valid_i && ara_req_ready_i && acc_resp_ready_i) begin
+      if (acc_req_valid_i && (ara_req_ready_i || is_vsetvl) && acc_resp_ready_i &&
+          !scalar_resp_valid_q && !(scalar_pending_q && waits_backend)) begin
         // Decoding
         is_decoding = 1'b1;
         // Acknowledge the request
@@ -460,13 +557,15 @@ module ara_dispatcher import ara_pkg::*; import rvv_pkg::*; #(
                 end else if (insn.vsetivli_type.func2 == 2'b11) begin // vsetivli
                   vtype_d = vtype_xlen(riscv::xlen_t'(insn.vsetivli_type.zimm10));
                 end else if (insn.vsetvl_type.func7 == 7'b100_0000) begin // vsetvl
-                  vtype_d = vtype_xlen(riscv::xlen_t'(acc_req_i.rs2[7:0]));
+                  vtype_d = vtype_xlen(riscv::xlen_t'(acc_req_i.rs2[8:0]));
                 end else
                   acc_resp_o.error = 1'b1;
 
                 // Check whether the updated vtype makes sense
                 if ((vtype_d.vsew > rvv_pkg::vew_e'($clog2(ELENB))) || // SEW <= ELEN
                     (vtype_d.vlmul == LMUL_RSVD) ||                    // reserved value
+                    // The alternative FP format is BF16, at SEW = 16
+                    (vtype_d.altfmt && (!FPAltFmtSupport || vtype_d.vsew != EW16)) ||
                     // LMUL >= SEW/ELEN
                     (signed'($clog2(ELENB)) + signed'(vtype_d.vlmul) < signed'(vtype_d.vsew))) begin
                   vtype_d = '{vill: 1'b1, default: '0};
@@ -488,9 +587,12 @@ module ara_dispatcher import ara_pkg::*; import rvv_pkg::*; #(
                     LMUL_1_8: vlmax >>= 3;
                     default:;
                   endcase
+                  // VLMAX of an Ara with only the active lanes, each with the same VRF
+                  vlmax >>= vlmax_shift_q;
 
                   if (insn.vsetivli_type.func2 == 2'b11) begin // vsetivli
-                    vl_d = vlen_t'(insn.vsetivli_type.uimm5);
+                    vl_d = (insn.vsetivli_type.uimm5 > vlmax) ? vlmax
+                                                              : vlen_t'(insn.vsetivli_type.uimm5);
                   end else begin // vsetvl || vsetvli
                     if (insn.vsetvl_type.rs1 == '0 && insn.vsetvl_type.rd == '0) begin
                       // Do not update the vector length
@@ -533,6 +635,7 @@ module ara_dispatcher import ara_pkg::*; import rvv_pkg::*; #(
                 // Decode based on the func6 field
                 unique case (insn.varith_type.func6)
                   6'b000000: ara_req_d.op = ara_pkg::VADD;
+                  6'b000001: ara_req_d.op = ara_pkg::VANDN;
                   6'b000010: ara_req_d.op = ara_pkg::VSUB;
                   6'b000100: ara_req_d.op = ara_pkg::VMINU;
                   6'b000101: ara_req_d.op = ara_pkg::VMIN;
@@ -541,6 +644,42 @@ module ara_dispatcher import ara_pkg::*; import rvv_pkg::*; #(
                   6'b001001: ara_req_d.op = ara_pkg::VAND;
                   6'b001010: ara_req_d.op = ara_pkg::VOR;
                   6'b001011: ara_req_d.op = ara_pkg::VXOR;
+                  6'b001100: begin
+                    ara_req_d.op     = ara_pkg::VRGATHER;
+                    // Gather from one register of vs2 per pass
+                    ara_req_d.stride = perm_pass_q * (VLENB >> vtype_q.vsew);
+                    // The destination cannot overlap the sources
+                    if (vreg_overlap(insn.varith_type.rd, lmul_regs(ara_req_d.emul), insn.varith_type.rs1,
+                          lmul_regs(ara_req_d.emul)) ||
+                        vreg_overlap(insn.varith_type.rd, lmul_regs(ara_req_d.emul), insn.varith_type.rs2,
+                          lmul_regs(ara_req_d.emul))) illegal_insn = 1'b1;
+                  end
+                  6'b001110: begin
+                    // The 16-bit indices have EMUL = LMUL * 16 / SEW
+                    automatic int unsigned vs1_regs = lmul_regs(ara_req_d.emul) >>
+                      (int'(vtype_q.vsew) - int'(EW16));
+
+                    ara_req_d.op         = ara_pkg::VRGATHEREI16;
+                    ara_req_d.stride     = perm_pass_q * (VLENB >> vtype_q.vsew);
+                    ara_req_d.eew_vs1    = EW16;
+                    skip_vs1_lmul_checks = 1'b1;
+                    if (vs1_regs == 0) vs1_regs = 1;
+
+                    // Zero-extend the indices to SEW. Ara cannot narrow them to 8 bits.
+                    unique case (vtype_q.vsew)
+                      EW16:;
+                      EW32: ara_req_d.conversion_vs1 = OpQueueConversionZExt2;
+                      EW64: ara_req_d.conversion_vs1 = OpQueueConversionZExt4;
+                      default: illegal_insn = 1'b1;
+                    endcase
+
+                    if ((insn.varith_type.rs1 & (vs1_regs - 1)) != 5'b00000) illegal_insn = 1'b1;
+                    // The destination cannot overlap the sources
+                    if (vreg_overlap(insn.varith_type.rd, lmul_regs(ara_req_d.emul), insn.varith_type.rs1,
+                          vs1_regs) ||
+                        vreg_overlap(insn.varith_type.rd, lmul_regs(ara_req_d.emul), insn.varith_type.rs2,
+                          lmul_regs(ara_req_d.emul))) illegal_insn = 1'b1;
+                  end
                   6'b010000: begin
                     ara_req_d.op = ara_pkg::VADC;
 
@@ -603,6 +742,8 @@ module ara_dispatcher import ara_pkg::*; import rvv_pkg::*; #(
                             (insn.varith_type.rs2 == insn.varith_type.rd)) illegal_insn = 1'b1;
                     endcase
                   end
+                  6'b010100: ara_req_d.op = ara_pkg::VROR;
+                  6'b010101: ara_req_d.op = ara_pkg::VROL;
                   6'b011000: begin
                     ara_req_d.op        = ara_pkg::VMSEQ;
                     ara_req_d.use_vd_op = 1'b1;
@@ -718,13 +859,13 @@ module ara_dispatcher import ara_pkg::*; import rvv_pkg::*; #(
                 // Instructions with an integer LMUL have extra constraints on the registers they can
                 // access.
                 unique case (ara_req_d.emul)
-                  LMUL_2: if ((insn.varith_type.rs1 & 5'b00001) != 5'b00000 ||
+                  LMUL_2: if (((insn.varith_type.rs1 & 5'b00001) != 5'b00000 && !skip_vs1_lmul_checks) ||
                         (insn.varith_type.rs2 & 5'b00001) != 5'b00000 ||
                         (insn.varith_type.rd & 5'b00001) != 5'b00000) illegal_insn = 1'b1;
-                  LMUL_4: if ((insn.varith_type.rs1 & 5'b00011) != 5'b00000 ||
+                  LMUL_4: if (((insn.varith_type.rs1 & 5'b00011) != 5'b00000 && !skip_vs1_lmul_checks) ||
                         (insn.varith_type.rs2 & 5'b00011) != 5'b00000 ||
                         (insn.varith_type.rd & 5'b00011) != 5'b00000) illegal_insn = 1'b1;
-                  LMUL_8: if ((insn.varith_type.rs1 & 5'b00111) != 5'b00000 ||
+                  LMUL_8: if (((insn.varith_type.rs1 & 5'b00111) != 5'b00000 && !skip_vs1_lmul_checks) ||
                         (insn.varith_type.rs2 & 5'b00111) != 5'b00000 ||
                         (insn.varith_type.rd & 5'b00111) != 5'b00000) illegal_insn = 1'b1;
                   default:;
@@ -749,6 +890,7 @@ module ara_dispatcher import ara_pkg::*; import rvv_pkg::*; #(
                 // Decode based on the func6 field
                 unique case (insn.varith_type.func6)
                   6'b000000: ara_req_d.op = ara_pkg::VADD;
+                  6'b000001: ara_req_d.op = ara_pkg::VANDN;
                   6'b000010: ara_req_d.op = ara_pkg::VSUB;
                   6'b000011: ara_req_d.op = ara_pkg::VRSUB;
                   6'b000100: ara_req_d.op = ara_pkg::VMINU;
@@ -758,6 +900,15 @@ module ara_dispatcher import ara_pkg::*; import rvv_pkg::*; #(
                   6'b001001: ara_req_d.op = ara_pkg::VAND;
                   6'b001010: ara_req_d.op = ara_pkg::VOR;
                   6'b001011: ara_req_d.op = ara_pkg::VXOR;
+                  6'b001100: begin
+                    ara_req_d.op = ara_pkg::VRGATHER;
+                    // Gather only from the register that holds the element x[rs1], if any
+                    if (acc_req_i.rs1 < ((VLENB * lmul_regs(ara_req_d.emul)) >> vtype_q.vsew))
+                      ara_req_d.stride = acc_req_i.rs1 & ~((VLENB >> vtype_q.vsew) - 1);
+                    // The destination cannot overlap the source
+                    if (vreg_overlap(insn.varith_type.rd, lmul_regs(ara_req_d.emul), insn.varith_type.rs2,
+                          lmul_regs(ara_req_d.emul))) illegal_insn = 1'b1;
+                  end
                   6'b001110: begin
                     ara_req_d.op            = ara_pkg::VSLIDEUP;
                     ara_req_d.stride        = acc_req_i.rs1;
@@ -835,6 +986,8 @@ module ara_dispatcher import ara_pkg::*; import rvv_pkg::*; #(
                       default: if (insn.varith_type.rs2 == insn.varith_type.rd) illegal_insn = 1'b1;
                     endcase
                   end
+                  6'b010100: ara_req_d.op = ara_pkg::VROR;
+                  6'b010101: ara_req_d.op = ara_pkg::VROL;
                   6'b011000: begin
                     ara_req_d.op        = ara_pkg::VMSEQ;
                     ara_req_d.use_vd_op = 1'b1;
@@ -966,6 +1119,16 @@ module ara_dispatcher import ara_pkg::*; import rvv_pkg::*; #(
                   6'b001001: ara_req_d.op = ara_pkg::VAND;
                   6'b001010: ara_req_d.op = ara_pkg::VOR;
                   6'b001011: ara_req_d.op = ara_pkg::VXOR;
+                  6'b001100: begin
+                    ara_req_d.op        = ara_pkg::VRGATHER;
+                    ara_req_d.scalar_op = {{ELEN{1'b0}}, insn.varith_type.rs1};
+                    // Gather only from the register that holds the element uimm, if any
+                    if (ara_req_d.scalar_op < ((VLENB * lmul_regs(ara_req_d.emul)) >> vtype_q.vsew))
+                      ara_req_d.stride = ara_req_d.scalar_op & ~((VLENB >> vtype_q.vsew) - 1);
+                    // The destination cannot overlap the source
+                    if (vreg_overlap(insn.varith_type.rd, lmul_regs(ara_req_d.emul), insn.varith_type.rs2,
+                          lmul_regs(ara_req_d.emul))) illegal_insn = 1'b1;
+                  end
                   6'b001110: begin
                     ara_req_d.op            = ara_pkg::VSLIDEUP;
                     ara_req_d.stride        = {{ELEN{insn.varith_type.rs1[19]}}, insn.varith_type.rs1};
@@ -1014,6 +1177,13 @@ module ara_dispatcher import ara_pkg::*; import rvv_pkg::*; #(
                       default: if (insn.varith_type.rs2 == insn.varith_type.rd) illegal_insn = 1'b1;
                     endcase
                   end
+                  6'b010100,
+                  6'b010101: begin
+                    ara_req_d.op        = ara_pkg::VROR;
+                    // The rotation amount is a 6-bit unsigned immediate, whose MSB is func6[0]
+                    ara_req_d.scalar_op = {{(ELEN-6){1'b0}}, insn.varith_type.func6[0],
+                      insn.varith_type.rs1};
+                  end
                   6'b011000: begin
                     ara_req_d.op        = ara_pkg::VMSEQ;
                     ara_req_d.use_vd_op = 1'b1;
@@ -1253,8 +1423,13 @@ module ara_dispatcher import ara_pkg::*; import rvv_pkg::*; #(
                       default:;
                     endcase
 
-                    // Wait until the back-end answers to acknowledge those instructions
-                    if (ara_resp_valid_i) begin
+                    // Wait until the back-end answers to acknowledge those instructions,
+                    // or acknowledge them now and answer once the back-end does
+                    if (ScalarRespAsync) begin
+                      acc_req_ready_o   = 1'b1;
+                      scalar_pending_d  = 1'b1;
+                      scalar_trans_id_d = acc_req_i.trans_id;
+                    end else if (ara_resp_valid_i) begin
                       acc_req_ready_o   = 1'b1;
                       acc_resp_o.result = ara_resp_i.resp;
                       acc_resp_o.error  = ara_resp_i.error;
@@ -1344,6 +1519,19 @@ module ara_dispatcher import ara_pkg::*; import rvv_pkg::*; #(
                     ara_req_d.vtype.vsew = EW8;
                     ara_req_d.use_vd_op  = 1'b1;
                   end
+                  6'b010111: begin
+                    ara_req_d.op        = ara_pkg::VCOMPRESS;
+                    ara_req_d.emul      = vtype_q.vlmul;
+                    // vs1 is a mask, read as it is
+                    ara_req_d.eew_vs1   = eew_q[insn.varith_type.rs1];
+                    ara_req_d.eew_vmask = eew_q[insn.varith_type.rs1];
+                    lmul_vs1            = LMUL_1;
+                    // vcompress cannot be masked, and the destination cannot overlap the sources
+                    if (!insn.varith_type.vm ||
+                        vreg_overlap(insn.varith_type.rd, lmul_regs(ara_req_d.emul), insn.varith_type.rs1, 1) ||
+                        vreg_overlap(insn.varith_type.rd, lmul_regs(ara_req_d.emul), insn.varith_type.rs2,
+                          lmul_regs(ara_req_d.emul))) illegal_insn = 1'b1;
+                  end
                   6'b010010: begin // VXUNARY0
                     // These instructions do not use vs1
                     ara_req_d.use_vs1    = 1'b0;
@@ -1410,8 +1598,17 @@ module ara_dispatcher import ara_pkg::*; import rvv_pkg::*; #(
                         if (int'(vtype_q.vsew) < int'(EW16) || int'(vtype_q.vlmul) inside {LMUL_1_8})
                           illegal_insn = 1'b1;
                       end
+                      // Zvbb unary operations, on SEW-wide elements of vs2
+                      5'b01000: ara_req_d.op = ara_pkg::VBREV8;
+                      5'b01001: ara_req_d.op = ara_pkg::VREV8;
+                      5'b01010: ara_req_d.op = ara_pkg::VBREV;
+                      5'b01100: ara_req_d.op = ara_pkg::VCLZ;
+                      5'b01101: ara_req_d.op = ara_pkg::VCTZ;
+                      5'b01110: ara_req_d.op = ara_pkg::VCPOPV;
                       default: illegal_insn = 1'b1;
                     endcase
+                    // The Zvbb operations write a whole register group
+                    if (ara_req_d.op inside {[VBREV8:VCPOPV]}) ara_req_d.emul = vtype_q.vlmul;
                   end
                   // Divide instructions
                   6'b100000: ara_req_d.op = ara_pkg::VDIVU;
@@ -1444,6 +1641,22 @@ module ara_dispatcher import ara_pkg::*; import rvv_pkg::*; #(
                     ara_req_d.op        = ara_pkg::VNMSAC;
                     ara_req_d.use_vd_op = 1'b1;
                   end
+                  // 4-way 8-bit dot products, accumulated in SEW = 32 (Zvqdotq)
+                  6'b101000: begin
+                    ara_req_d.op        = ara_pkg::VQDOTU;
+                    ara_req_d.use_vd_op = 1'b1;
+                    if (vtype_q.vsew != EW32) illegal_insn = 1'b1;
+                  end
+                  6'b101010: begin
+                    ara_req_d.op        = ara_pkg::VQDOTSU;
+                    ara_req_d.use_vd_op = 1'b1;
+                    if (vtype_q.vsew != EW32) illegal_insn = 1'b1;
+                  end
+                  6'b101100: begin
+                    ara_req_d.op        = ara_pkg::VQDOT;
+                    ara_req_d.use_vd_op = 1'b1;
+                    if (vtype_q.vsew != EW32) illegal_insn = 1'b1;
+                  end
                   // Widening instructions
                   6'b110000: begin // VWADDU
                     ara_req_d.op             = ara_pkg::VADD;
@@ -1615,6 +1828,24 @@ module ara_dispatcher import ara_pkg::*; import rvv_pkg::*; #(
 
                 // Decode based on the func6 field
                 unique case (insn.varith_type.func6)
+                  // Outer products with the tiles of the MXU (custom)
+                  6'b000000, 6'b000001: begin // vfmop.vx, vfmopa.vx
+                    ara_req_d.op     = insn.varith_type.func6[0] ? ara_pkg::VFMOPA : ara_pkg::VFMOP;
+                    ara_req_d.use_vd = 1'b0;
+                    ara_req_d.fp_rm  = acc_req_i.frm;
+                    if (insn.varith_type.rd >= MxuTiles) illegal_insn = 1'b1;
+                  end
+                  6'b000010: begin // vfmtr.vx
+                    ara_req_d.op      = ara_pkg::VFMTR;
+                    ara_req_d.use_vs2 = 1'b0;
+                    if (acc_req_i.rs1 >= 2 * MxuTiles) illegal_insn = 1'b1;
+                  end
+                  // Bounds of the body of the loop buffer (custom), which handles them. They
+                  // do not reach the backend.
+                  6'b000011, 6'b000100: begin // vlbeg.vx, vlend.vx
+                    ara_req_valid_d = 1'b0;
+                    if (LoopBufDepth == 0) illegal_insn = 1'b1;
+                  end
                   6'b001000: ara_req_d.op = ara_pkg::VAADDU;
                   6'b001001: ara_req_d.op = ara_pkg::VAADD;
                   6'b001010: ara_req_d.op = ara_pkg::VASUBU;
@@ -1676,6 +1907,27 @@ module ara_dispatcher import ara_pkg::*; import rvv_pkg::*; #(
                     ara_req_d.op        = ara_pkg::VNMSAC;
                     ara_req_d.use_vd_op = 1'b1;
                   end
+                  // 4-way 8-bit dot products, accumulated in SEW = 32 (Zvqdotq)
+                  6'b101000: begin
+                    ara_req_d.op        = ara_pkg::VQDOTU;
+                    ara_req_d.use_vd_op = 1'b1;
+                    if (vtype_q.vsew != EW32) illegal_insn = 1'b1;
+                  end
+                  6'b101010: begin
+                    ara_req_d.op        = ara_pkg::VQDOTSU;
+                    ara_req_d.use_vd_op = 1'b1;
+                    if (vtype_q.vsew != EW32) illegal_insn = 1'b1;
+                  end
+                  6'b101100: begin
+                    ara_req_d.op        = ara_pkg::VQDOT;
+                    ara_req_d.use_vd_op = 1'b1;
+                    if (vtype_q.vsew != EW32) illegal_insn = 1'b1;
+                  end
+                  6'b101110: begin
+                    ara_req_d.op        = ara_pkg::VQDOTUS;
+                    ara_req_d.use_vd_op = 1'b1;
+                    if (vtype_q.vsew != EW32) illegal_insn = 1'b1;
+                  end
                   // Widening instructions
                   6'b110000: begin // VWADDU
                     ara_req_d.op             = ara_pkg::VADD;
@@ -1812,6 +2064,11 @@ module ara_dispatcher import ara_pkg::*; import rvv_pkg::*; #(
                   default: illegal_insn = 1'b1;
                 endcase
 
+                // The MXU has FP32 tiles of one vector register, and no masked outer products
+                if (ara_req_d.op inside {[VFMOP:VFMTR]} && (MxuTiles == 0 ||
+                    vtype_q.vsew != EW32 || vtype_q.vlmul != LMUL_1 || !insn.varith_type.vm))
+                  illegal_insn = 1'b1;
+
                 // Instructions with an integer LMUL have extra constraints on the registers they can
                 // access. The constraints can be different for the two source operands and the
                 // destination register.
@@ -1914,8 +2171,13 @@ module ara_dispatcher import ara_pkg::*; import rvv_pkg::*; #(
                         default:;
                       endcase
 
-                      // Wait until the back-end answers to acknowledge those instructions
-                      if (ara_resp_valid_i) begin
+                      // Wait until the back-end answers to acknowledge those instructions,
+                      // or acknowledge them now and answer once the back-end does
+                      if (ScalarRespAsync) begin
+                        acc_req_ready_o   = 1'b1;
+                        scalar_pending_d  = 1'b1;
+                        scalar_trans_id_d = acc_req_i.trans_id;
+                      end else if (ara_resp_valid_i) begin
                         acc_req_ready_o   = 1'b1;
                         acc_resp_o.result = ara_resp_i.resp;
                         acc_resp_o.error  = ara_resp_i.error;
@@ -2487,6 +2749,106 @@ module ara_dispatcher import ara_pkg::*; import rvv_pkg::*; #(
             endcase
           end
 
+          //////////////////////////////////
+          //  Vector crypto instructions  //
+          //////////////////////////////////
+
+          OpcodeVecCrypto: begin
+            // Instruction is of one of the RVV types
+            automatic rvv_instruction_t insn = rvv_instruction_t'(acc_req_i.insn.instr);
+            // Bits of the register numbers within a register group
+            automatic logic [4:0] group_mask = '0;
+
+            // These always respond at the same cycle
+            acc_resp_valid_o = 1'b1;
+
+            // They work on element groups of four 32-bit elements, which the Mask Unit gathers
+            // from the lanes. vd is always read, but by vaeskf1.
+            ara_req_d.vs1       = insn.varith_type.rs1;
+            ara_req_d.vs2       = insn.varith_type.rs2;
+            ara_req_d.use_vs2   = 1'b1;
+            ara_req_d.vd        = insn.varith_type.rd;
+            ara_req_d.use_vd    = 1'b1;
+            ara_req_d.use_vd_op = 1'b1;
+            ara_req_d.vm        = 1'b1;
+            ara_req_valid_d     = 1'b1;
+
+            unique case (insn.varith_type.func6)
+              // The .vv and .vs forms of the AES rounds and of vgmul. vs1 encodes the operation.
+              6'b101000, 6'b101001: begin
+                ara_req_d.is_broadcast = insn.varith_type.func6[0];
+                unique case (insn.varith_type.rs1)
+                  5'b00000: ara_req_d.op = ara_pkg::VAESDM;
+                  5'b00001: ara_req_d.op = ara_pkg::VAESDF;
+                  5'b00010: ara_req_d.op = ara_pkg::VAESEM;
+                  5'b00011: ara_req_d.op = ara_pkg::VAESEF;
+                  5'b00111: begin
+                    ara_req_d.op = ara_pkg::VAESZ;
+                    if (!insn.varith_type.func6[0]) illegal_insn = 1'b1;
+                  end
+                  5'b10001: begin
+                    ara_req_d.op = ara_pkg::VGMUL;
+                    if (insn.varith_type.func6[0]) illegal_insn = 1'b1;
+                  end
+                  default: illegal_insn = 1'b1;
+                endcase
+              end
+              // The round number of the key expansions is in rs1
+              6'b100010: begin
+                ara_req_d.op        = ara_pkg::VAESKF1;
+                ara_req_d.use_vd_op = 1'b0;
+                ara_req_d.scalar_op = elen_t'(insn.varith_type.rs1);
+              end
+              6'b101010: begin
+                ara_req_d.op        = ara_pkg::VAESKF2;
+                ara_req_d.scalar_op = elen_t'(insn.varith_type.rs1);
+              end
+              6'b101100: begin
+                ara_req_d.op      = ara_pkg::VGHSH;
+                ara_req_d.use_vs1 = 1'b1;
+              end
+              6'b101101: begin
+                ara_req_d.op      = ara_pkg::VSHA2MS;
+                ara_req_d.use_vs1 = 1'b1;
+              end
+              6'b101110: begin
+                ara_req_d.op      = ara_pkg::VSHA2CH;
+                ara_req_d.use_vs1 = 1'b1;
+              end
+              6'b101111: begin
+                ara_req_d.op      = ara_pkg::VSHA2CL;
+                ara_req_d.use_vs1 = 1'b1;
+              end
+              default: illegal_insn = 1'b1;
+            endcase
+
+            // All of them are unmasked OPMVV instructions
+            if (insn.varith_type.func3 != OPMVV || !insn.varith_type.vm) illegal_insn = 1'b1;
+
+            // Only SEW = 32 is supported (no vsha2 at SEW = 64), and vl and vstart must be
+            // multiples of the element group size
+            if (vtype_q.vsew != EW32 || vl_q[1:0] != '0 || vstart_q[1:0] != '0) illegal_insn = 1'b1;
+
+            // The register groups must be aligned to LMUL
+            unique case (vtype_q.vlmul)
+              LMUL_2   : group_mask = 5'b00001;
+              LMUL_4   : group_mask = 5'b00011;
+              LMUL_8   : group_mask = 5'b00111;
+              LMUL_RSVD: illegal_insn = 1'b1;
+              default:;
+            endcase
+            if ((insn.varith_type.rd & group_mask) != '0 ||
+                (ara_req_d.use_vs1 && (insn.varith_type.rs1 & group_mask) != '0) ||
+                (!ara_req_d.is_broadcast && (insn.varith_type.rs2 & group_mask) != '0))
+              illegal_insn = 1'b1;
+            // The key of the .vs forms is a single register, which cannot overlap vd
+            if (ara_req_d.is_broadcast && (insn.varith_type.rs2 & ~group_mask) == insn.varith_type.rd)
+              illegal_insn = 1'b1;
+
+            // Instruction is invalid if the vtype is invalid
+            if (vtype_q.vill) illegal_insn = 1'b1;
+          end
+
           ////////////////////
           //  Vector Loads  //
           ////////////////////
@@ -2494,6 +2856,11 @@ module ara_dispatcher import ara_pkg::*; import rvv_pkg::*; #(
           riscv::OpcodeLoadFp: begin
             // Instruction is of one of the RVV types
             automatic rvv_instruction_t insn = rvv_instruction_t'(acc_req_i.insn.instr);
+            // Segment loads: nf encodes the number of fields, but for the whole-register loads
+            automatic logic is_segment = insn.vmem_type.nf != '0 &&
+              (insn.vmem_type.mop != 2'b00 || insn.vmem_type.rs2 == 5'b00000);
+            // Fault-only-first loads trim vl instead of trapping, but on the first element
+            automatic logic is_fof = insn.vmem_type.mop == 2'b00 && insn.vmem_type.rs2 == 5'b10000;
 
             // The instruction is a load
             is_vload = 1'b1;
@@ -2566,10 +2933,12 @@ module ara_dispatcher import ara_pkg::*; import rvv_pkg::*; #(
                     ara_req_d.vtype.vsew = EW8;
                   end
                   5'b10000: begin // Unit-strided, fault-only first
-                    // TODO: Not implemented
-                    illegal_insn     = 1'b1;
-                    acc_req_ready_o  = 1'b1;
-                    acc_resp_valid_o = 1'b1;
+                    // Ara does not support the segment fault-only-first loads
+                    if (insn.vmem_type.nf != '0) begin
+                      illegal_insn     = 1'b1;
+                      acc_req_ready_o  = 1'b1;
+                      acc_resp_valid_o = 1'b1;
+                    end
                   end
                   default: begin // Reserved
                     illegal_insn     = 1'b1;
@@ -2579,15 +2948,17 @@ module ara_dispatcher import ara_pkg::*; import rvv_pkg::*; #(
                 endcase
               end
               2'b10: begin
-                ara_req_d.op     = VLSE;
-                ara_req_d.stride = acc_req_i.rs2;
+                ara_req_d.op           = VLSE;
+                ara_req_d.stride       = acc_req_i.rs2;
+                ara_req_d.is_broadcast = StridedCoalesce && insn.vmem_type.rs2 == '0;
               end
               2'b01, // Indexed-unordered
               2'b11: begin // Indexed-ordered
-                ara_req_d.op      = VLXE;
+                ara_req_d.op         = VLXE;
+                ara_req_d.is_ordered = insn.vmem_type.mop == 2'b11;
                 // These also read vs2
-                ara_req_d.vs2     = insn.vmem_type.rs2;
-                ara_req_d.use_vs2 = 1'b1;
+                ara_req_d.vs2        = insn.vmem_type.rs2;
+                ara_req_d.use_vs2    = 1'b1;
               end
               default:;
             endcase
@@ -2639,8 +3010,33 @@ module ara_dispatcher import ara_pkg::*; import rvv_pkg::*; #(
               default:;
             endcase
 
+            // Segment loads load each field with a strided (or indexed) load, whose base is offset
+            // by the field index, into consecutive register groups
+            if (is_segment) begin
+              // Registers of each field
+              automatic logic [3:0] field_regs = ara_req_d.emul[2] ? 4'd1 : 4'd1 << ara_req_d.emul[1:0];
+              automatic logic [3:0] nr_fields  = insn.vmem_type.nf + 1;
+
+              // The fields of a unit-strided segment are nr_fields elements apart
+              if (ara_req_d.op == VLE) begin
+                ara_req_d.op     = VLSE;
+                ara_req_d.stride = nr_fields << ara_req_d.vtype.vsew;
+              end
+              ara_req_d.vd        = insn.vmem_type.rd + seg_field_q * field_regs;
+              ara_req_d.scalar_op = acc_req_i.rs1 + (seg_field_q << ara_req_d.vtype.vsew);
+
+              // EMUL * NFIELDS <= 8, and the register groups cannot go past v31
+              if (nr_fields * field_regs > 8 || insn.vmem_type.rd + nr_fields * field_regs > 32) begin
+                illegal_insn     = 1'b1;
+                acc_req_ready_o  = 1'b1;
+                acc_resp_valid_o = 1'b1;
+              end
+            end
+
             // Vector whole register loads overwrite all the other decoding information.
-            if (ara_req_d.op == VLE && insn.vmem_type.rs2 == 5'b01000) begin
+            // They keep the EEW of the instruction, so that the registers are not reshuffled
+            // when read back with that EEW. The whole group is a single unit-strided burst.
+            if (ara_req_d.op == VLE && insn.vmem_type.rs2 == 5'b01000 && !acc_resp_o.error) begin
               // Execute also if vl == 0
               ignore_zero_vl_check = 1'b1;
               // The LMUL value is kept in the instruction itself
@@ -2649,41 +3045,63 @@ module ara_dispatcher import ara_pkg::*; import rvv_pkg::*; #(
               acc_resp_valid_o = 1'b0;
               ara_req_valid_d  = 1'b1;
 
-              // Maximum vector length. VLMAX = nf * VLEN / EW8.
-              ara_req_d.vtype.vsew = EW8;
+              // Maximum vector length. VLMAX = nf * VLEN / EEW.
               unique case (insn.vmem_type.nf)
                 3'd0: begin
-                  ara_req_d.vl = VLENB << 0;
+                  ara_req_d.vl = (VLENB << 0) >> ara_req_d.vtype.vsew;
                   ara_req_d.emul = LMUL_1;
                 end
                 3'd1: begin
-                  ara_req_d.vl = VLENB << 1;
+                  ara_req_d.vl = (VLENB << 1) >> ara_req_d.vtype.vsew;
                   ara_req_d.emul = LMUL_2;
                 end
                 3'd3:  begin
-                  ara_req_d.vl = VLENB << 2;
+                  ara_req_d.vl = (VLENB << 2) >> ara_req_d.vtype.vsew;
                   ara_req_d.emul = LMUL_4;
                 end
                 3'd7:  begin
-                  ara_req_d.vl = VLENB << 3;
+                  ara_req_d.vl = (VLENB << 3) >> ara_req_d.vtype.vsew;
                   ara_req_d.emul = LMUL_8;
                 end
                 default: begin
                   // Trigger an error for the reserved simm values
                   illegal_insn     = 1'b1;
+                  acc_req_ready_o  = 1'b1;
+                  acc_resp_valid_o = 1'b1;
                 end
               endcase
+
+              // The destination register group must be aligned to the number of registers
+              if ((insn.vmem_type.rd & insn.vmem_type.nf) != 5'b00000) begin
+                illegal_insn     = 1'b1;
+                acc_req_ready_o  = 1'b1;
+                acc_resp_valid_o = 1'b1;
+              end
             end
 
             // Wait until the back-end answers to acknowledge those instructions
             if (ara_resp_valid_i) begin
-              acc_req_ready_o  = 1'b1;
-              acc_resp_o.error = ara_resp_i.error;
-              acc_resp_valid_o = 1'b1;
-              ara_req_valid_d  = 1'b0;
-              // In case of error, modify vstart
-              if (ara_resp_i.error)
-                vstart_d = ara_resp_i.error_vl;
+              if (is_segment && !ara_resp_i.error && seg_field_q != insn.vmem_type.nf) begin
+                // Issue the next field
+                seg_field_d     = seg_field_q + 1;
+                seg_load_skip_d = seg_load_skip_d + 1;
+                ara_req_valid_d = 1'b0;
+              end else if (is_fof && ara_resp_i.error && ara_resp_i.error_vl != '0) begin
+                // A fault past the first element only trims vl
+                acc_req_ready_o  = 1'b1;
+                acc_resp_valid_o = 1'b1;
+                ara_req_valid_d  = 1'b0;
+                vl_d             = ara_resp_i.error_vl;
+              end else begin
+                acc_req_ready_o  = 1'b1;
+                acc_resp_o.error = ara_resp_i.error;
+                acc_resp_valid_o = 1'b1;
+                ara_req_valid_d  = 1'b0;
+                seg_field_d      = '0;
+                // In case of error, modify vstart
+                if (ara_resp_i.error)
+                  vstart_d = ara_resp_i.error_vl;
+              end
             end
           end
 
@@ -2700,6 +3118,9 @@ module ara_dispatcher import ara_pkg::*; import rvv_pkg::*; #(
           riscv::OpcodeStoreFp: begin
             // Instruction is of one of the RVV types
             automatic rvv_instruction_t insn = rvv_instruction_t'(acc_req_i.insn.instr);
+            // Segment stores: nf encodes the number of fields, but for the whole-register stores
+            automatic logic is_segment = insn.vmem_type.nf != '0 &&
+              (insn.vmem_type.mop != 2'b00 || insn.vmem_type.rs2 == 5'b00000);
 
             // The instruction is a store
             is_vstore = 1'b1;
@@ -2846,11 +3267,39 @@ module ara_dispatcher import ara_pkg::*; import rvv_pkg::*; #(
               default:;
             endcase
 
-            // Vector whole register stores are encoded as stores of length VLENB, length
-            // multiplier LMUL_1 and element width EW8. They overwrite all this decoding.
-            if (ara_req_d.op == VSE && insn.vmem_type.rs2 == 5'b01000) begin
+            // Segment stores store each field with a strided (or indexed) store, whose base is
+            // offset by the field index, from consecutive register groups
+            if (is_segment) begin
+              // Registers of each field
+              automatic logic [3:0] field_regs = ara_req_d.emul[2] ? 4'd1 : 4'd1 << ara_req_d.emul[1:0];
+              automatic logic [3:0] nr_fields  = insn.vmem_type.nf + 1;
+
+              // The fields of a unit-strided segment are nr_fields elements apart
+              if (ara_req_d.op == VSE) begin
+                ara_req_d.op     = VSSE;
+                ara_req_d.stride = nr_fields << ara_req_d.vtype.vsew;
+              end
+              ara_req_d.vs1       = insn.vmem_type.rd + seg_field_q * field_regs;
+              ara_req_d.eew_vs1   = eew_q[ara_req_d.vs1];
+              ara_req_d.scalar_op = acc_req_i.rs1 + (seg_field_q << ara_req_d.vtype.vsew);
+
+              // EMUL * NFIELDS <= 8, and the register groups cannot go past v31
+              if (nr_fields * field_regs > 8 || insn.vmem_type.rd + nr_fields * field_regs > 32) begin
+                illegal_insn     = 1'b1;
+                acc_req_ready_o  = 1'b1;
+                acc_resp_valid_o = 1'b1;
+              end
+            end
+
+            // Vector whole register stores are encoded as stores of length nf * VLENB and
+            // element width EW8, i.e., a single unit-strided burst. They overwrite all this decoding.
+            if (ara_req_d.op == VSE && insn.vmem_type.rs2 == 5'b01000 && !acc_resp_o.error) begin
               // Execute also if vl == 0
               ignore_zero_vl_check = 1'b1;
+              illegal_insn         = 1'b0;
+              acc_req_ready_o      = 1'b0;
+              acc_resp_valid_o     = 1'b0;
+              ara_req_valid_d      = 1'b1;
 
               // Maximum vector length. VLMAX = nf * VLEN / EW8.
               ara_req_d.vtype.vsew = EW8;
@@ -2874,15 +3323,128 @@ module ara_dispatcher import ara_pkg::*; import rvv_pkg::*; #(
                 default: begin
                   // Trigger an error for the reserved simm values
                   illegal_insn     = 1'b1;
+                  acc_req_ready_o  = 1'b1;
+                  acc_resp_valid_o = 1'b1;
                 end
               endcase
 
-              illegal_insn     = 1'b0;
-              acc_req_ready_o  = 1'b0;
-              acc_resp_valid_o = 1'b0;
-              ara_req_valid_d  = 1'b1;
+              // The source register group must be aligned to the number of registers
+              if ((insn.vmem_type.rd & insn.vmem_type.nf) != 5'b00000) begin
+                illegal_insn     = 1'b1;
+                acc_req_ready_o  = 1'b1;
+                acc_resp_valid_o = 1'b1;
+              end
             end
 
+            // Wait until the back-end answers to acknowledge those instructions
+            if (ara_resp_valid_i) begin
+              if (is_segment && !ara_resp_i.error && seg_field_q != insn.vmem_type.nf) begin
+                // Issue the next field
+                seg_field_d      = seg_field_q + 1;
+                seg_store_skip_d = seg_store_skip_d + 1;
+                ara_req_valid_d  = 1'b0;
+              end else begin
+                acc_req_ready_o  = 1'b1;
+                acc_resp_o.error = ara_resp_i.error;
+                acc_resp_valid_o = 1'b1;
+                ara_req_valid_d  = 1'b0;
+                seg_field_d      = '0;
+                // If there is an error, change vstart
+                if (ara_resp_i.error)
+                  vstart_d = ara_resp_i.error_vl;
+              end
+            end
+          end
+
+          //////////////////////////////
+          //  Vector atomic operations  //
+          //////////////////////////////
+
+          // The vector AMOs are indexed stores, which execute an atomic operation on each active
+          // element in memory. Ara does not write the old values back to vd (wd = 1).
+
+          riscv::OpcodeAmo: begin
+            // Instruction is of one of the RVV types
+            automatic rvv_instruction_t insn = rvv_instruction_t'(acc_req_i.insn.instr);
+
+            // The instruction is a store
+            is_vstore = 1'b1;
+
+            // Wait before acknowledging this instruction
+            acc_req_ready_o = 1'b0;
+
+            // These generate a request to Ara's backend
+            ara_req_d.scale_vl   = 1'b1;
+            ara_req_d.vs1        = insn.vamo_type.rd; // vs3 is encoded in the same position as rd
+            ara_req_d.use_vs1    = 1'b1;
+            ara_req_d.eew_vs1    = eew_q[insn.vamo_type.rd];
+            ara_req_d.vs2        = insn.vamo_type.rs2;
+            ara_req_d.use_vs2    = 1'b1;
+            ara_req_d.vm         = insn.vamo_type.vm;
+            ara_req_d.scalar_op  = acc_req_i.rs1;
+            ara_req_d.vtype.vsew = vtype_q.vsew;
+            ara_req_d.emul       = vtype_q.vlmul;
+            ara_req_valid_d      = 1'b1;
+
+            // Decode the EEW of the indices
+            unique case (insn.vamo_type.width)
+              3'b000: ara_req_d.eew_vs2 = EW8;
+              3'b101: ara_req_d.eew_vs2 = EW16;
+              3'b110: ara_req_d.eew_vs2 = EW32;
+              3'b111: ara_req_d.eew_vs2 = EW64;
+              default: begin
+                illegal_insn     = 1'b1;
+                acc_req_ready_o  = 1'b1;
+                acc_resp_valid_o = 1'b1;
+              end
+            endcase
+
+            // Decode the atomic operation
+            unique case (insn.vamo_type.amoop)
+              5'b00000: ara_req_d.op = VAMOADD;
+              5'b00001: ara_req_d.op = VSXE; // Without the old values, a swap is a store
+              5'b00100: ara_req_d.op = VAMOXOR;
+              5'b01100: ara_req_d.op = VAMOAND;
+              5'b01000: ara_req_d.op = VAMOOR;
+              5'b10000: ara_req_d.op = VAMOMIN;
+              5'b10100: ara_req_d.op = VAMOMAX;
+              5'b11000: ara_req_d.op = VAMOMINU;
+              5'b11100: ara_req_d.op = VAMOMAXU;
+              default: begin
+                illegal_insn     = 1'b1;
+                acc_req_ready_o  = 1'b1;
+                acc_resp_valid_o = 1'b1;
+              end
+            endcase
+
+            // The AMOs need SEW >= 32, and Ara does not return the old values
+            if (insn.vamo_type.wd || vtype_q.vsew inside {EW8, EW16}) begin
+              illegal_insn     = 1'b1;
+              acc_req_ready_o  = 1'b1;
+              acc_resp_valid_o = 1'b1;
+            end
+
+            // Instructions with an integer LMUL have extra constraints on the registers they can
+            // access.
+            unique case (ara_req_d.emul)
+              LMUL_2: if ((insn.vamo_type.rd & 5'b00001) != 5'b00000) begin
+                illegal_insn     = 1'b1;
+                acc_req_ready_o  = 1'b1;
+                acc_resp_valid_o = 1'b1;
+              end
+              LMUL_4: if ((insn.vamo_type.rd & 5'b00011) != 5'b00000) begin
+                illegal_insn     = 1'b1;
+                acc_req_ready_o  = 1'b1;
+                acc_resp_valid_o = 1'b1;
+              end
+              LMUL_8: if ((insn.vamo_type.rd & 5'b00111) != 5'b00000) begin
+                illegal_insn     = 1'b1;
+                acc_req_ready_o  = 1'b1;
+                acc_resp_valid_o = 1'b1;
+              end
+              default:;
+            endcase
+
             // Wait until the back-end answers to acknowledge those instructions
             if (ara_resp_valid_i) begin
               acc_req_ready_o  = 1'b1;
@@ -3082,6 +3644,13 @@ module ara_dispatcher import ara_pkg::*; import rvv_pkg::*; #(
         endcase
       end
 
+      // The Mask Unit only reads the old destination of a mask result to merge its masked-off
+      // and tail bits back. Under a tail- and mask-agnostic policy, these bits can be written
+      // with ones instead, so do not read vd at all (and do not wait for its producer).
+      if (ara_req_valid_d && vtype_q.vta && (ara_req_d.vm || vtype_q.vma) &&
+          (ara_req_d.op inside {[VMFEQ:VMSGTU], [VMSGT:VMSBC], [VMANDNOT:VMXNOR]}))
+        ara_req_d.use_vd_op = 1'b0;
+
       // Check that we have fixed-point support if requested
       // vxsat and vxrm are always accessible anyway
       if (ara_req_valid_d && (ara_req_d.op inside {[VSADDU:VNCLIPU], VSMUL}) && (FixPtSupport == FixedPointDisable))
@@ -3091,6 +3660,10 @@ module ara_dispatcher import ara_pkg::*; import rvv_pkg::*; #(
       if (ara_req_valid_d && (ara_req_d.op inside {VFREC7, VFRSQRT7}) && (FPExtSupport == FPExtSupportDisable))
         illegal_insn = 1'b1;
 
+      // There are no BF16 estimates
+      if (ara_req_valid_d && (ara_req_d.op inside {VFREC7, VFRSQRT7}) && vtype_q.altfmt)
+        illegal_insn = 1'b1;
+
       // Check if we need to reshuffle our vector registers involved in the operation
       // This operation is costly when occurs, so avoid it if possible
       if (ara_req_valid_d && !acc_resp_o.error) begin
@@ -3098,7 +3671,7 @@ module ara_dispatcher import ara_pkg::*; import rvv_pkg::*; #(
 
         // Is the instruction an in-lane one and could it be subject to reshuffling?
         in_lane_op = ara_req_d.op inside {[VADD:VMERGE]} || ara_req_d.op inside {[VREDSUM:VMSBC]} ||
-                     ara_req_d.op inside {[VMANDNOT:VMXNOR]} || ara_req_d.op inside {VSLIDEUP, VSLIDEDOWN};
+                     ara_req_d.op inside {[VMANDNOT:VGMUL]} || ara_req_d.op inside {VSLIDEUP, VSLIDEDOWN};
         // Annotate which registers need a reshuffle -> |vs1|vs2|vd|
         // Optimization: reshuffle vs1 and vs2 only if the operation is strictly in-lane
         // Optimization: reshuffle vd only if we are not overwriting the whole vector register!
@@ -3110,9 +3683,9 @@ module ara_dispatcher import ara_pkg::*; import rvv_pkg::*; #(
         // Reshuffle in the following order: vd, v2, v1. The order is arbitrary.
         unique casez (reshuffle_req_d)
           3'b??1: begin
-            eew_old_buffer_d = eew_q[insn.vmem_type.rd];
+            eew_old_buffer_d = eew_q[ara_req_d.vd];
             eew_new_buffer_d = ara_req_d.vtype.vsew;
-            vs_buffer_d      = insn.varith_type.rd;
+            vs_buffer_d      = ara_req_d.vd;
           end
           3'b?10: begin
             eew_old_buffer_d = eew_q[insn.vmem_type.rs2];
@@ -3155,6 +3728,11 @@ module ara_dispatcher import ara_pkg::*; import rvv_pkg::*; #(
     if (illegal_insn) begin
       acc_resp_o.error = 1'b1;
       ara_req_valid_d  = 1'b0;
+      // An illegal scalar instruction is answered right away
+      if (scalar_pending_d && !scalar_pending_q) begin
+        scalar_pending_d = 1'b0;
+        acc_resp_valid_o = 1'b1;
+      end
     end
 
     // Update the EEW
@@ -3208,8 +3786,28 @@ module ara_dispatcher import ara_pkg::*; import rvv_pkg::*; #(
       store_zero_vl    = is_vstore;
     end
 
-    acc_resp_o.load_complete  = load_zero_vl  | load_complete_q;
-    acc_resp_o.store_complete = store_zero_vl | store_complete_q;
+    // Issue vrgather.vv once per register of vs2 before acknowledging it
+    if (is_decoding && ara_req_valid_d && ara_req_d.op inside {[VRGATHER:VRGATHEREI16]} && ara_req_d.use_vs1) begin
+      if (perm_pass_q != lmul_regs(ara_req_d.emul) - 1) begin
+        acc_req_ready_o  = 1'b0;
+        acc_resp_valid_o = 1'b0;
+        perm_pass_d      = perm_pass_q + 1;
+      end else
+        perm_pass_d = '0;
+    end
+
+    // The completions of the fields of a segment operation but the last one are hidden
+    acc_resp_o.load_complete  = load_zero_vl  | (load_complete_q  && seg_load_skip_q  == '0);
+    acc_resp_o.store_complete = store_zero_vl | (store_complete_q && seg_store_skip_q == '0);
+
+    // Answer the acknowledged scalar instruction. Nothing is decoded in this cycle.
+    if (scalar_resp_valid_q && acc_resp_ready_i) begin
+      acc_resp_valid_o    = 1'b1;
+      acc_resp_o.trans_id = scalar_trans_id_q;
+      acc_resp_o.result   = scalar_resp_q.resp;
+      acc_resp_o.error    = scalar_resp_q.error;
+      scalar_resp_valid_d = 1'b0;
+    end
 
     // The token must change at every new instruction
     ara_req_d.token = (ara_req_valid_o && ara_req_ready_i) ? ~ara_req_o.token : ara_req_o.token;
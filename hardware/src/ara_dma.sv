@@ -0,0 +1,369 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+// Solderpad Hardware License, Version 0.51, see LICENSE for details.
+// SPDX-License-Identifier: SHL-0.51
+//
+// Description:
+// DMA engine of the SoC, which copies 1D and 2D tiles between regions of the L2 memory
+// while the systems compute. A descriptor copies reps rows of len bytes from src to dst,
+// and the addresses of the rows advance by src_stride and dst_stride. The descriptors are
+// written through AXI-Lite registers and executed in order, with full-width AXI INCR bursts.
+// The rows can have any alignment: the beats read from src are realigned to dst on the fly.
+
+module ara_dma #(
+    // Descriptors waiting for their execution
+    parameter int  unsigned NrDescs         = 4,
+    // AXI-Lite interface of the registers
+    parameter int  unsigned RegDataWidth    = 64,
+    parameter type          axi_lite_req_t  = logic,
+    parameter type          axi_lite_resp_t = logic,
+    // AXI interface of the copies
+    parameter int  unsigned AxiAddrWidth    = 64,
+    parameter int  unsigned AxiDataWidth    = 64,
+    parameter type          axi_req_t       = logic,
+    parameter type          axi_resp_t      = logic
+  ) (
+    input  logic           clk_i,
+    input  logic           rst_ni,
+    // Registers
+    input  axi_lite_req_t  axi_lite_slave_req_i,
+    output axi_lite_resp_t axi_lite_slave_resp_o,
+    // Copies
+    output axi_req_t       axi_req_o,
+    input  axi_resp_t      axi_resp_i,
+    // There are descriptors to execute
+    output logic           busy_o
+  );
+
+  `include "common_cells/registers.svh"
+
+  ///////////////////
+  //  Definitions  //
+  ///////////////////
+
+  localparam int unsigned NumRegs      = 8;
+  localparam int unsigned RegBytes     = RegDataWidth / 8;
+  localparam int unsigned AxiBeatBytes = AxiDataWidth / 8;
+  localparam int unsigned AxiBeatLog   = $clog2(AxiBeatBytes);
+
+  typedef logic [AxiAddrWidth-1:0] addr_t;
+  typedef logic [AxiDataWidth-1:0] data_t;
+  typedef logic [RegDataWidth-1:0] reg_t;
+  // Bytes of a row, and rows or beats of a descriptor
+  typedef logic [31:0]             cnt_t;
+
+  typedef struct packed {
+    addr_t src;
+    addr_t dst;
+    cnt_t  len;
+    addr_t src_stride;
+    addr_t dst_stride;
+    cnt_t  reps;
+  } desc_t;
+
+  // Address of the AXI beat of addr
+  function automatic addr_t beat_addr(addr_t addr);
+    beat_addr = addr & ~addr_t'(AxiBeatBytes - 1);
+  endfunction : beat_addr
+
+  // Beats of the INCR burst from the beat at addr up to the one at last. A burst has
+  // 256 beats at most, and it does not cross a 4 KiB page.
+  function automatic cnt_t burst_beats(addr_t addr, addr_t last);
+    automatic addr_t page_beats = (addr_t'(4096) - (addr & addr_t'(4095))) >> AxiBeatLog;
+
+    burst_beats = cnt_t'((last - addr) >> AxiBeatLog) + 1;
+    if (burst_beats > page_beats) burst_beats = cnt_t'(page_beats);
+    if (burst_beats > 256) burst_beats = 256;
+  endfunction : burst_beats
+
+  /////////////////
+  //  Registers  //
+  /////////////////
+
+  // Memory map
+  // [63:56]: done       (ro), number of descriptors completed since the reset
+  // [55:48]: launch     (rw), a write queues a descriptor with the registers below
+  // [47:40]: reps       (rw)
+  // [39:32]: dst_stride (rw)
+  // [31:24]: src_stride (rw)
+  // [23:16]: len        (rw)
+  // [15:8]:  dst        (rw)
+  // [7:0]:   src        (rw)
+  // A launch while NrDescs descriptors are waiting is dropped.
+  localparam logic [NumRegs-1:0][RegBytes-1:0] AxiReadOnly = '{
+    7      : {RegBytes{1'b1}},
+    default: {RegBytes{1'b0}}
+  };
+
+  logic [NumRegs*RegBytes-1:0] wr_active;
+  logic                        launch_q;
+
+  reg_t src, dst, len, src_stride, dst_stride, reps, launch, done;
+  logic done_load;
+
+  axi_lite_regs #(
+    .RegNumBytes (NumRegs*RegBytes),
+    .AxiAddrWidth(AxiAddrWidth    ),
+    .AxiDataWidth(RegDataWidth    ),
+    .AxiReadOnly (AxiReadOnly     ),
+    .RegRstVal   ('0              ),
+    .req_lite_t  (axi_lite_req_t  ),
+    .resp_lite_t (axi_lite_resp_t )
+  ) i_axi_lite_regs (
+    .clk_i      (clk_i                                                      ),
+    .rst_ni     (rst_ni                                                     ),
+    .axi_req_i  (axi_lite_slave_req_i                                       ),
+    .axi_resp_o (axi_lite_slave_resp_o                                      ),
+    .wr_active_o(wr_active                                                  ),
+    .rd_active_o(/* Unused */                                               ),
+    .reg_d_i    ({reg_t'(done + 1), {(NumRegs-1)*RegBytes{8'h00}}}          ),
+    .reg_load_i ({{RegBytes{done_load}}, {(NumRegs-1)*RegBytes{1'b0}}}      ),
+    .reg_q_o    ({done, launch, reps, dst_stride, src_stride, len, dst, src})
+  );
+
+  // The other registers hold their new value when the launch is seen
+  `FF(launch_q, |wr_active[6*RegBytes +: RegBytes], 1'b0)
+
+  ////////////////////////
+  //  Descriptor queue  //
+  ////////////////////////
+
+  desc_t desc;
+  logic  desc_full, desc_empty, desc_pop;
+
+  fifo_v3 #(
+    .DEPTH(NrDescs),
+    .dtype(desc_t )
+  ) i_desc_queue (
+    .clk_i     (clk_i                  ),
+    .rst_ni    (rst_ni                 ),
+    .flush_i   (1'b0                   ),
+    .testmode_i(1'b0                   ),
+    .data_i    ('{
+      src       : addr_t'(src),
+      dst       : addr_t'(dst),
+      len       : cnt_t'(len),
+      src_stride: addr_t'(src_stride),
+      dst_stride: addr_t'(dst_stride),
+      reps      : cnt_t'(reps)
+    }),
+    .push_i    (launch_q && !desc_full ),
+    .full_o    (desc_full              ),
+    .data_o    (desc                   ),
+    .pop_i     (desc_pop               ),
+    .empty_o   (desc_empty             ),
+    .usage_o   (/* Unused */           )
+  );
+
+  assign busy_o = !desc_empty;
+
+  //////////////
+  //  Engine  //
+  //////////////
+
+  // The head of the queue is being executed
+  logic desc_active_d, desc_active_q;
+
+  // The AR and AW channels walk over the rows of the source and of the destination
+  typedef struct packed {
+    addr_t row;  // First byte of the row
+    addr_t addr; // Next beat of the row to request
+    cnt_t  cnt;  // Rows left, this one included
+  } walker_t;
+  walker_t ar_d, ar_q, aw_d, aw_q;
+
+  // Bursts written, and their B responses
+  cnt_t aw_bursts_d, aw_bursts_q;
+  cnt_t b_cnt_d, b_cnt_q;
+
+  // The W channel writes the beats of the rows of the destination, each from a window of the
+  // last two beats of the source. The window of W beat k holds the R beats k and k+1, if the
+  // row starts at a lower offset in its beat in the source than in the destination, or k-1 and
+  // k otherwise. The beats past the end of the row of the source are zeros.
+  addr_t       w_src_d, w_src_q;
+  addr_t       w_dst_d, w_dst_q;
+  cnt_t        w_cnt_d, w_cnt_q;
+  cnt_t        w_beat_d, w_beat_q;
+  cnt_t        w_loaded_d, w_loaded_q;
+  cnt_t        w_burst_d, w_burst_q;
+  data_t [1:0] win_d, win_q;
+
+  always_comb begin: p_dma
+    // Position of the row of the W channel in the beats of the source and of the destination
+    automatic addr_t src_off  = w_src_q & addr_t'(AxiBeatBytes - 1);
+    automatic addr_t dst_off  = w_dst_q & addr_t'(AxiBeatBytes - 1);
+    automatic addr_t dst_last = (w_dst_q + desc.len - 1) & addr_t'(AxiBeatBytes - 1);
+    automatic addr_t shift    = (src_off - dst_off) & addr_t'(AxiBeatBytes - 1);
+    automatic cnt_t  r_beats  = cnt_t'((beat_addr(w_src_q + desc.len - 1) - beat_addr(w_src_q)) >> AxiBeatLog) + 1;
+    automatic cnt_t  w_beats  = cnt_t'((beat_addr(w_dst_q + desc.len - 1) - beat_addr(w_dst_q)) >> AxiBeatLog) + 1;
+    // Beats shifted into the window for W beat w_beat_q
+    automatic cnt_t  need     = w_beat_q + (src_off >= dst_off) + 1;
+    automatic cnt_t  burst_left;
+    automatic logic  w_last_of_row;
+    automatic logic  w_hs;
+
+    desc_active_d = desc_active_q;
+    ar_d          = ar_q;
+    aw_d          = aw_q;
+    aw_bursts_d   = aw_bursts_q;
+    b_cnt_d       = b_cnt_q;
+    w_src_d       = w_src_q;
+    w_dst_d       = w_dst_q;
+    w_cnt_d       = w_cnt_q;
+    w_beat_d      = w_beat_q;
+    w_loaded_d    = w_loaded_q;
+    w_burst_d     = w_burst_q;
+    win_d         = win_q;
+
+    desc_pop  = 1'b0;
+    done_load = 1'b0;
+    axi_req_o = '0;
+
+    // Start the descriptor at the head of the queue. The empty ones complete right away.
+    if (!desc_empty && !desc_active_q) begin
+      automatic cnt_t rows = (desc.len == '0) ? '0 : desc.reps;
+
+      desc_active_d = 1'b1;
+      ar_d          = '{row: desc.src, addr: beat_addr(desc.src), cnt: rows};
+      aw_d          = '{row: desc.dst, addr: beat_addr(desc.dst), cnt: rows};
+      aw_bursts_d   = '0;
+      b_cnt_d       = '0;
+      w_src_d       = desc.src;
+      w_dst_d       = desc.dst;
+      w_cnt_d       = rows;
+      w_beat_d      = '0;
+      w_loaded_d    = '0;
+      w_burst_d     = '0;
+    end
+
+    /////////////
+    //  Reads  //
+    /////////////
+
+    if (desc_active_q && ar_q.cnt != '0) begin
+      automatic addr_t last  = beat_addr(ar_q.row + desc.len - 1);
+      automatic cnt_t  beats = burst_beats(ar_q.addr, last);
+
+      axi_req_o.ar_valid = 1'b1;
+      axi_req_o.ar.addr  = ar_q.addr;
+      axi_req_o.ar.len   = axi_pkg::len_t'(beats - 1);
+      axi_req_o.ar.size  = axi_pkg::size_t'(AxiBeatLog);
+      axi_req_o.ar.burst = axi_pkg::BURST_INCR;
+
+      if (axi_resp_i.ar_ready) begin
+        ar_d.addr = ar_q.addr + (addr_t'(beats) << AxiBeatLog);
+        // Next row
+        if (ar_d.addr > last) begin
+          ar_d.row  = ar_q.row + desc.src_stride;
+          ar_d.addr = beat_addr(ar_d.row);
+          ar_d.cnt  = ar_q.cnt - 1;
+        end
+      end
+    end
+
+    //////////////
+    //  Writes  //
+    //////////////
+
+    if (desc_active_q && aw_q.cnt != '0) begin
+      automatic addr_t last  = beat_addr(aw_q.row + desc.len - 1);
+      automatic cnt_t  beats = burst_beats(aw_q.addr, last);
+
+      axi_req_o.aw_valid = 1'b1;
+      axi_req_o.aw.addr  = aw_q.addr;
+      axi_req_o.aw.len   = axi_pkg::len_t'(beats - 1);
+      axi_req_o.aw.size  = axi_pkg::size_t'(AxiBeatLog);
+      axi_req_o.aw.burst = axi_pkg::BURST_INCR;
+
+      if (axi_resp_i.aw_ready) begin
+        aw_bursts_d = aw_bursts_q + 1;
+        aw_d.addr   = aw_q.addr + (addr_t'(beats) << AxiBeatLog);
+        // Next row
+        if (aw_d.addr > last) begin
+          aw_d.row  = aw_q.row + desc.dst_stride;
+          aw_d.addr = beat_addr(aw_d.row);
+          aw_d.cnt  = aw_q.cnt - 1;
+        end
+      end
+    end
+
+    w_hs = 1'b0;
+    if (desc_active_q && w_cnt_q != '0) begin
+      // The W bursts follow the AW ones
+      burst_left = (w_burst_q == '0)
+                 ? burst_beats(beat_addr(w_dst_q) + (addr_t'(w_beat_q) << AxiBeatLog),
+                     beat_addr(w_dst_q + desc.len - 1))
+                 : w_burst_q;
+      w_last_of_row = w_beat_q == w_beats - 1;
+
+      axi_req_o.w_valid = w_loaded_q == need;
+      axi_req_o.w.data  = data_t'({win_q[1], win_q[0]} >> (8 * shift));
+      axi_req_o.w.last  = burst_left == 1;
+      for (int unsigned b = 0; b < AxiBeatBytes; b++)
+        axi_req_o.w.strb[b] = (w_beat_q != '0 || b >= dst_off) && (!w_last_of_row || b <= dst_last);
+
+      w_hs = axi_req_o.w_valid && axi_resp_i.w_ready;
+      if (w_hs) begin
+        w_burst_d = burst_left - 1;
+        w_beat_d  = w_beat_q + 1;
+        // Next row
+        if (w_last_of_row) begin
+          w_src_d    = w_src_q + desc.src_stride;
+          w_dst_d    = w_dst_q + desc.dst_stride;
+          w_cnt_d    = w_cnt_q - 1;
+          w_beat_d   = '0;
+          w_loaded_d = '0;
+        end
+      end
+
+      // Shift the next beat of the source into the window
+      if (w_loaded_q < need || (w_hs && !w_last_of_row)) begin
+        if (w_loaded_q < r_beats) begin
+          axi_req_o.r_ready = 1'b1;
+          if (axi_resp_i.r_valid) begin
+            win_d      = {axi_resp_i.r.data, win_q[1]};
+            w_loaded_d = w_loaded_q + 1;
+          end
+        end else begin
+          win_d      = {data_t'(0), win_q[1]};
+          w_loaded_d = w_loaded_q + 1;
+        end
+      end
+    end
+
+    // Count the B responses
+    axi_req_o.b_ready = 1'b1;
+    if (axi_resp_i.b_valid) b_cnt_d = b_cnt_q + 1;
+
+    // The descriptor is complete once all of its writes are acknowledged
+    if (desc_active_q && ar_q.cnt == '0 && aw_q.cnt == '0 && w_cnt_q == '0 &&
+        b_cnt_q == aw_bursts_q) begin
+      desc_active_d = 1'b0;
+      desc_pop      = 1'b1;
+      done_load     = 1'b1;
+    end
+  end: p_dma
+
+  `FF(desc_active_q, desc_active_d, 1'b0)
+  `FF(ar_q, ar_d, '0)
+  `FF(aw_q, aw_d, '0)
+  `FF(aw_bursts_q, aw_bursts_d, '0)
+  `FF(b_cnt_q, b_cnt_d, '0)
+  `FF(w_src_q, w_src_d, '0)
+  `FF(w_dst_q, w_dst_d, '0)
+  `FF(w_cnt_q, w_cnt_d, '0)
+  `FF(w_beat_q, w_beat_d, '0)
+  `FF(w_loaded_q, w_loaded_d, '0)
+  `FF(w_burst_q, w_burst_d, '0)
+  `FF(win_q, win_d, '0)
+
+  //////////////////
+  //  Assertions  //
+  //////////////////
+
+  if (NrDescs == 0)
+    $error("[ara_dma] The descriptor queue must have at least one entry.");
+
+  if (AxiBeatBytes != 2**AxiBeatLog || AxiBeatBytes > 4096)
+    $error("[ara_dma] The AXI data width must be a power of two bytes, up to 4 KiB.");
+
+endmodule : ara_dma
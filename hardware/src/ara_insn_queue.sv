@@ -0,0 +1,159 @@
+// Copyright 2021 ETH Zurich and University of Bologna.
+// Solderpad Hardware License, Version 0.51, see LICENSE for details.
+// SPDX-License-Identifier: SHL-0.51
+//
+// Description:
+// Ara's instruction queue decouples Ariane's accelerator interface from Ara's
+// dispatcher. It buffers AccQueueDepth vector instructions, so that Ariane
+// does not wait for the dispatcher to accept them.
+//
+// A vector arithmetic instruction that does not write a scalar register, or
+// a configuration instruction that discards the new vl (rd = x0), is
+// acknowledged to Ariane as soon as it enters the queue, so that Ariane can
+// commit it and issue the next instructions. Its scalar operands were captured
+// with it. This only happens when all the older instructions were answered, so
+// the answers keep their order. The dispatcher's answer to such an instruction
+// is dropped. The memory operations, which can raise exceptions, and the
+// instructions with a scalar result wait in the queue for the answer of the
+// dispatcher.
+//
+// An early acknowledged instruction cannot raise an exception: if the
+// dispatcher finds it illegal, it is dropped.
+
+module ara_insn_queue import ara_pkg::*; import rvv_pkg::*; (
+    input  logic              clk_i,
+    input  logic              rst_ni,
+    // Interface with Ariane
+    input  accelerator_req_t  acc_req_i,
+    input  logic              acc_req_valid_i,
+    output logic              acc_req_ready_o,
+    output accelerator_resp_t acc_resp_o,
+    output logic              acc_resp_valid_o,
+    input  logic              acc_resp_ready_i,
+    // Interface with Ara's dispatcher
+    output accelerator_req_t  acc_req_o,
+    output logic              acc_req_valid_o,
+    input  logic              acc_req_ready_i,
+    input  accelerator_resp_t acc_resp_i,
+    input  logic              acc_resp_valid_i,
+    output logic              acc_resp_ready_o,
+    // Interface with Ara's top-level
+    output logic              empty_o,
+    // An instruction was acknowledged as it entered the queue
+    output logic              early_ack_o
+  );
+
+  import cf_math_pkg::idx_width;
+
+  if (AccQueueDepth == 0) begin: gen_no_queue
+    // Without a queue, Ariane talks to the dispatcher directly
+    assign acc_req_o        = acc_req_i;
+    assign acc_req_valid_o  = acc_req_valid_i;
+    assign acc_req_ready_o  = acc_req_ready_i;
+    assign acc_resp_o       = acc_resp_i;
+    assign acc_resp_valid_o = acc_resp_valid_i;
+    assign acc_resp_ready_o = acc_resp_ready_i;
+    assign empty_o          = 1'b1;
+    assign early_ack_o      = 1'b0;
+  end: gen_no_queue else begin: gen_queue
+    typedef struct packed {
+      accelerator_req_t req;
+      // The instruction was already acknowledged to Ariane
+      logic acked;
+    } queue_entry_t;
+
+    queue_entry_t queue_in, queue_out;
+    logic         queue_full, queue_empty, queue_push, queue_pop;
+
+    // Instructions not acknowledged early whose answer was not sent to Ariane yet. The one
+    // with an asynchronous scalar answer can leave the queue before it is answered.
+    logic [idx_width(AccQueueDepth+2)-1:0] unanswered_d, unanswered_q;
+
+    always_ff @(posedge clk_i or negedge rst_ni) begin: p_unanswered_ff
+      if (!rst_ni) unanswered_q <= '0;
+      else         unanswered_q <= unanswered_d;
+    end: p_unanswered_ff
+
+    // Can this instruction be acknowledged before it reaches the dispatcher?
+    function automatic logic early_ack(accelerator_req_t req);
+      automatic rvv_instruction_t insn = rvv_instruction_t'(req.insn.instr);
+
+      early_ack = 1'b0;
+      if (req.insn.itype.opcode == riscv::OpcodeVec) begin
+        if (insn.varith_type.func3 == OPCFG)
+          // vsetvli, vsetivli, and vsetvl, without a destination
+          early_ack = insn.vsetvl_type.rd == '0 &&
+                      (insn.vsetvli_type.func1 == 1'b0 || insn.vsetivli_type.func2 == 2'b11 ||
+                       insn.vsetvl_type.func7 == 7'b100_0000);
+        else
+          // Anything but vmv.x.s, vfmv.f.s, vcpop.m, vfirst.m, and vlend.vx
+          early_ack = !(insn.varith_type.func3 inside {OPMVV, OPFVV} &&
+                        insn.varith_type.func6 == 6'b010000) &&
+                      !(insn.varith_type.func3 == OPMVX && insn.varith_type.func6 == 6'b000100);
+      end
+    endfunction : early_ack
+
+    fifo_v3 #(
+      .DEPTH(AccQueueDepth),
+      .dtype(queue_entry_t)
+    ) i_queue (
+      .clk_i     (clk_i      ),
+      .rst_ni    (rst_ni     ),
+      .flush_i   (1'b0       ),
+      .testmode_i(1'b0       ),
+      .data_i    (queue_in   ),
+      .push_i    (queue_push ),
+      .full_o    (queue_full ),
+      .data_o    (queue_out  ),
+      .pop_i     (queue_pop  ),
+      .empty_o   (queue_empty),
+      .usage_o   (/* Unused */)
+    );
+
+    always_comb begin: p_queue
+      automatic logic drop_resp;
+
+      unanswered_d = unanswered_q;
+      early_ack_o  = 1'b0;
+
+      // Feed the dispatcher with the oldest instruction. Ariane's pending stores are the
+      // current ones, not the ones of when the instruction entered the queue.
+      acc_req_o               = queue_out.req;
+      acc_req_o.store_pending = acc_req_i.store_pending;
+      acc_req_valid_o         = !queue_empty;
+      queue_pop               = acc_req_valid_o && acc_req_ready_i;
+
+      // Drop the answer to an instruction that was acknowledged early
+      drop_resp = acc_resp_valid_i && !queue_empty && queue_out.acked &&
+                  acc_resp_i.trans_id == queue_out.req.trans_id;
+
+      acc_resp_ready_o = acc_resp_ready_i;
+      acc_resp_o       = acc_resp_i;
+      acc_resp_valid_o = acc_resp_valid_i && !drop_resp;
+      if (acc_resp_valid_o && acc_resp_ready_i) unanswered_d -= 1;
+
+      // Accept Ariane's instructions while there is space
+      queue_in        = '{req: acc_req_i, acked: 1'b0};
+      acc_req_ready_o = !queue_full;
+      queue_push      = acc_req_valid_i && acc_req_ready_o;
+
+      if (queue_push) begin
+        // Acknowledge the instruction now, if the interface is free and the older instructions
+        // were answered
+        if (early_ack(acc_req_i) && !acc_resp_valid_o && acc_resp_ready_i &&
+            unanswered_q == '0) begin
+          queue_in.acked      = 1'b1;
+          early_ack_o         = 1'b1;
+          acc_resp_valid_o    = 1'b1;
+          acc_resp_o.trans_id = acc_req_i.trans_id;
+          acc_resp_o.result   = '0;
+          acc_resp_o.error    = 1'b0;
+        end else
+          unanswered_d += 1;
+      end
+    end: p_queue
+
+    assign empty_o = queue_empty;
+  end: gen_queue
+
+endmodule : ara_insn_queue
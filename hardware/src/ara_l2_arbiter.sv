@@ -0,0 +1,64 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+// Solderpad Hardware License, Version 0.51, see LICENSE for details.
+// SPDX-License-Identifier: SHL-0.51
+//
+// Description:
+// Bank arbitration of the ports of the L2 memory. The memory words are
+// interleaved over NumBanks banks, each of which serves one port per cycle.
+// The ports that access different banks are granted in parallel, and the ones
+// that access the same bank are granted in round-robin order.
+
+module ara_l2_arbiter #(
+    parameter  int unsigned NumPorts  = 2,
+    parameter  int unsigned NumBanks  = 1,
+    parameter  int unsigned AddrWidth = 64,
+    parameter  int unsigned DataWidth = 64,
+    // Dependant parameters. DO NOT CHANGE!
+    localparam type         addr_t    = logic [AddrWidth-1:0]
+  ) (
+    input  logic                 clk_i,
+    input  logic                 rst_ni,
+    // Requests of the ports, with their byte address
+    input  logic  [NumPorts-1:0] req_i,
+    input  addr_t [NumPorts-1:0] addr_i,
+    output logic  [NumPorts-1:0] gnt_o
+  );
+
+  import cf_math_pkg::idx_width;
+
+  // Port with the highest priority on each bank
+  logic [NumBanks-1:0][idx_width(NumPorts)-1:0] prio_d, prio_q;
+
+  function automatic int unsigned bank(addr_t addr);
+    bank = (addr >> $clog2(DataWidth/8)) & (NumBanks - 1);
+  endfunction : bank
+
+  always_comb begin: p_l2_arbiter
+    gnt_o  = '0;
+    prio_d = prio_q;
+
+    for (int unsigned b = 0; b < NumBanks; b++) begin
+      automatic logic granted = 1'b0;
+
+      for (int unsigned i = 0; i < NumPorts; i++) begin
+        automatic int unsigned p = (prio_q[b] + i) % NumPorts;
+
+        if (!granted && req_i[p] && bank(addr_i[p]) == b) begin
+          gnt_o[p]  = 1'b1;
+          granted   = 1'b1;
+          // The granted port has the lowest priority on this bank from now on
+          prio_d[b] = (p + 1) % NumPorts;
+        end
+      end
+    end
+  end: p_l2_arbiter
+
+  always_ff @(posedge clk_i or negedge rst_ni) begin
+    if (!rst_ni) prio_q <= '0;
+    else prio_q <= prio_d;
+  end
+
+  if (NumBanks != 2**$clog2(NumBanks))
+    $error("[ara_l2_arbiter] The number of banks must be a power of two.");
+
+endmodule : ara_l2_arbiter
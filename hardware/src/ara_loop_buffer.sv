@@ -0,0 +1,358 @@
+// Copyright 2021 ETH Zurich and University of Bologna.
+// Solderpad Hardware License, Version 0.51, see LICENSE for details.
+// SPDX-License-Identifier: SHL-0.51
+//
+// Description:
+// Ara's loop buffer sits in front of the dispatcher, and replays the body of a
+// strip-mined loop without Ariane. The body is marked by two custom OPMVX
+// instructions: vlbeg.vx (funct6 000011) before its first instruction, and
+// vlend.vx (funct6 000100) after its last one. The first strip goes through as
+// usual, and the buffer captures its instructions, up to LoopBufDepth of them.
+//
+// The body starts with a vsetvli or vsetvl that takes the avl in rs1, and rs1
+// of vlend.vx holds the avl left after the first strip. If it is not zero, the
+// buffer holds vlend.vx, and replays the body until the avl runs out: the
+// configuration instruction gets the avl left, the unit-strided loads and
+// stores move their base by vl elements (of nf + 1 fields), and the strided
+// ones by vl strides. The indexed ones and the arithmetic instructions keep
+// their scalar operands. vlend.vx then returns 0 to rd. A body that cannot be
+// replayed is only run once, and vlend.vx returns rs1, so that the software
+// loop goes on: one with an instruction with a scalar result, a vsetivli, a
+// second configuration instruction, a memory operation that is not a plain
+// unit-strided, strided, or indexed one, or more than LoopBufDepth
+// instructions. A replayed instruction that raises an exception stops the
+// replay, and vlend.vx returns the avl of its strip, from which the software
+// loop runs the rest again.
+//
+// The replayed instructions are answered to the buffer, and Ariane does not see
+// them. Ariane counts vlend.vx as a vector load and store
+// (cva6_accel_first_pass_decoder.sv), and the buffer signals its completions
+// only once the completions of the replayed memory operations were hidden from
+// Ariane, so that Ariane's scalar memory accesses wait for them.
+
+module ara_loop_buffer import ara_pkg::*; import rvv_pkg::*; (
+    input  logic              clk_i,
+    input  logic              rst_ni,
+    // Interface with the instruction queue
+    input  accelerator_req_t  acc_req_i,
+    input  logic              acc_req_valid_i,
+    output logic              acc_req_ready_o,
+    output accelerator_resp_t acc_resp_o,
+    output logic              acc_resp_valid_o,
+    input  logic              acc_resp_ready_i,
+    // Interface with Ara's dispatcher
+    output accelerator_req_t  acc_req_o,
+    output logic              acc_req_valid_o,
+    input  logic              acc_req_ready_i,
+    input  accelerator_resp_t acc_resp_i,
+    input  logic              acc_resp_valid_i,
+    output logic              acc_resp_ready_o,
+    // Interface with Ara's top-level
+    output logic              idle_o
+  );
+
+  import cf_math_pkg::idx_width;
+
+  if (LoopBufDepth == 0) begin: gen_no_loop_buffer
+    // Without a loop buffer, the instruction queue talks to the dispatcher directly
+    assign acc_req_o        = acc_req_i;
+    assign acc_req_valid_o  = acc_req_valid_i;
+    assign acc_req_ready_o  = acc_req_ready_i;
+    assign acc_resp_o       = acc_resp_i;
+    assign acc_resp_valid_o = acc_resp_valid_i;
+    assign acc_resp_ready_o = acc_resp_ready_i;
+    assign idle_o           = 1'b1;
+  end: gen_no_loop_buffer else begin: gen_loop_buffer
+    typedef enum logic [1:0] {
+      // Pass the instructions through
+      LB_IDLE,
+      // Pass the instructions through, and capture them
+      LB_CAPTURE,
+      // Replay the captured body, and hold vlend.vx
+      LB_REPLAY,
+      // Send vlend.vx to the dispatcher
+      LB_FINISH
+    } lb_state_e;
+
+    // Completions of replayed memory operations to hide from Ariane. The replay stalls when
+    // the counters are full.
+    typedef logic [7:0] hidden_cnt_t;
+
+    lb_state_e state_d, state_q;
+
+    // Captured body. The scalar operands are the ones of the next strip.
+    accelerator_req_t [LoopBufDepth-1:0]  body_d, body_q;
+    logic [idx_width(LoopBufDepth+1)-1:0] body_cnt_d, body_cnt_q;
+    logic [idx_width(LoopBufDepth)-1:0]   body_ptr_d, body_ptr_q;
+    // The captured body can be replayed
+    logic                                 body_ok_d, body_ok_q;
+    // vl of the current strip, avl left after it, and avl of the current strip
+    vlen_t                                vl_d, vl_q;
+    riscv::xlen_t                         avl_d, avl_q, strip_avl_d, strip_avl_q;
+    // The held vlend.vx, and its result
+    accelerator_req_t                     vlend_d, vlend_q;
+    riscv::xlen_t                         vlend_result_d, vlend_result_q;
+    // Completions of the replayed loads and stores not seen yet
+    hidden_cnt_t                          hidden_loads_d, hidden_loads_q;
+    hidden_cnt_t                          hidden_stores_d, hidden_stores_q;
+    // Completions of vlend.vx not signaled yet
+    logic                                 vlend_load_d, vlend_load_q;
+    logic                                 vlend_store_d, vlend_store_q;
+
+    always_ff @(posedge clk_i or negedge rst_ni) begin: p_loop_buffer_ff
+      if (!rst_ni) begin
+        state_q         <= LB_IDLE;
+        body_q          <= '0;
+        body_cnt_q      <= '0;
+        body_ptr_q      <= '0;
+        body_ok_q       <= 1'b0;
+        vl_q            <= '0;
+        avl_q           <= '0;
+        strip_avl_q     <= '0;
+        vlend_q         <= '0;
+        vlend_result_q  <= '0;
+        hidden_loads_q  <= '0;
+        hidden_stores_q <= '0;
+        vlend_load_q    <= 1'b0;
+        vlend_store_q   <= 1'b0;
+      end else begin
+        state_q         <= state_d;
+        body_q          <= body_d;
+        body_cnt_q      <= body_cnt_d;
+        body_ptr_q      <= body_ptr_d;
+        body_ok_q       <= body_ok_d;
+        vl_q            <= vl_d;
+        avl_q           <= avl_d;
+        strip_avl_q     <= strip_avl_d;
+        vlend_q         <= vlend_d;
+        vlend_result_q  <= vlend_result_d;
+        hidden_loads_q  <= hidden_loads_d;
+        hidden_stores_q <= hidden_stores_d;
+        vlend_load_q    <= vlend_load_d;
+        vlend_store_q   <= vlend_store_d;
+      end
+    end: p_loop_buffer_ff
+
+    // vlbeg.vx and vlend.vx
+    function automatic logic is_loop_insn(accelerator_req_t req, logic [5:0] func6);
+      automatic rvv_instruction_t insn = rvv_instruction_t'(req.insn.instr);
+
+      is_loop_insn = req.insn.itype.opcode == riscv::OpcodeVec &&
+                     insn.varith_type.func3 == OPMVX && insn.varith_type.func6 == func6;
+    endfunction : is_loop_insn
+
+    // vsetvli or vsetvl with the avl in rs1
+    function automatic logic is_avl_config(accelerator_req_t req);
+      automatic rvv_instruction_t insn = rvv_instruction_t'(req.insn.instr);
+
+      is_avl_config = req.insn.itype.opcode == riscv::OpcodeVec &&
+                      insn.varith_type.func3 == OPCFG &&
+                      (insn.vsetvli_type.func1 == 1'b0 || insn.vsetvl_type.func7 == 7'b100_0000) &&
+                      insn.vsetvl_type.rs1 != '0;
+    endfunction : is_avl_config
+
+    // Can the instruction be replayed, as the first one of the body or as a later one?
+    function automatic logic replayable(accelerator_req_t req, logic first);
+      automatic rvv_instruction_t insn = rvv_instruction_t'(req.insn.instr);
+
+      replayable = 1'b0;
+      unique case (req.insn.itype.opcode)
+        riscv::OpcodeVec: begin
+          if (insn.varith_type.func3 == OPCFG)
+            replayable = first && is_avl_config(req);
+          else
+            // Neither vmv.x.s, vfmv.f.s, vcpop.m, and vfirst.m, nor vlbeg.vx
+            replayable = !first && !is_loop_insn(req, 6'b000011) &&
+              !(insn.varith_type.func3 inside {OPMVV, OPFVV} &&
+                insn.varith_type.func6 == 6'b010000);
+        end
+        riscv::OpcodeLoadFp, riscv::OpcodeStoreFp: begin
+          // Not the whole-register, mask, and fault-only-first ones
+          replayable = !first && insn.vmem_type.mew == 1'b0 &&
+            (insn.vmem_type.mop != 2'b00 || insn.vmem_type.rs2 == '0);
+        end
+        default:;
+      endcase
+    endfunction : replayable
+
+    // Base address of the memory operation in the next strip, after vl elements
+    function automatic riscv::xlen_t next_base(accelerator_req_t req, vlen_t vl);
+      automatic rvv_instruction_t insn = rvv_instruction_t'(req.insn.instr);
+
+      next_base = req.rs1;
+      if (req.insn.itype.opcode inside {riscv::OpcodeLoadFp, riscv::OpcodeStoreFp}) begin
+        unique case (insn.vmem_type.mop)
+          2'b00: begin
+            automatic riscv::xlen_t bytes = riscv::xlen_t'(vl) * (insn.vmem_type.nf + 1);
+            unique case (insn.vmem_type.width)
+              3'b101 : bytes = bytes << 1;
+              3'b110 : bytes = bytes << 2;
+              3'b111 : bytes = bytes << 3;
+              default:;
+            endcase
+            next_base = req.rs1 + bytes;
+          end
+          2'b10  : next_base = req.rs1 + riscv::xlen_t'(vl) * req.rs2;
+          default:; // Indexed
+        endcase
+      end
+    endfunction : next_base
+
+    always_comb begin: p_loop_buffer
+      automatic accelerator_req_t req;
+      automatic logic             accepted, is_load, is_store, replaying;
+
+      state_d         = state_q;
+      body_d          = body_q;
+      body_cnt_d      = body_cnt_q;
+      body_ptr_d      = body_ptr_q;
+      body_ok_d       = body_ok_q;
+      vl_d            = vl_q;
+      avl_d           = avl_q;
+      strip_avl_d     = strip_avl_q;
+      vlend_d         = vlend_q;
+      vlend_result_d  = vlend_result_q;
+      hidden_loads_d  = hidden_loads_q;
+      hidden_stores_d = hidden_stores_q;
+      vlend_load_d    = vlend_load_q;
+      vlend_store_d   = vlend_store_q;
+
+      // Feed the dispatcher with the body, with vlend.vx, or with the instruction queue
+      replaying = state_q == LB_REPLAY;
+      req       = acc_req_i;
+      if (replaying) begin
+        req          = body_q[body_ptr_q];
+        req.trans_id = vlend_q.trans_id;
+        if (body_ptr_q == '0) req.rs1 = avl_q;
+      end else if (state_q == LB_FINISH)
+        req = vlend_q;
+      req.store_pending = acc_req_i.store_pending;
+
+      is_load  = req.insn.itype.opcode == riscv::OpcodeLoadFp;
+      is_store = req.insn.itype.opcode == riscv::OpcodeStoreFp;
+
+      // A vlend.vx waits for the completions of the previous one
+      acc_req_o        = req;
+      acc_req_valid_o  = replaying ? hidden_loads_q != '1 && hidden_stores_q != '1 :
+                         state_q == LB_FINISH || (acc_req_valid_i &&
+                           !(is_loop_insn(req, 6'b000100) && (vlend_load_q || vlend_store_q)));
+      acc_req_ready_o  = !(state_q inside {LB_REPLAY, LB_FINISH}) && acc_req_valid_o &&
+                         acc_req_ready_i;
+      accepted         = acc_req_valid_o && acc_req_ready_i;
+
+      // The dispatcher answers these instructions as it accepts them. Drop the answers to the
+      // replayed instructions.
+      acc_resp_ready_o = acc_resp_ready_i;
+      acc_resp_o       = acc_resp_i;
+      acc_resp_valid_o = acc_resp_valid_i && !(replaying && accepted);
+
+      // Hide the completions of the replayed memory operations, which follow the ones of
+      // Ariane's instructions
+      if (acc_resp_i.load_complete && hidden_loads_q != '0) begin
+        acc_resp_o.load_complete = 1'b0;
+        hidden_loads_d -= 1;
+      end
+      if (acc_resp_i.store_complete && hidden_stores_q != '0) begin
+        acc_resp_o.store_complete = 1'b0;
+        hidden_stores_d -= 1;
+      end
+      // Then signal the ones of vlend.vx, in a cycle without the completions of the dispatcher
+      if (vlend_load_q && hidden_loads_q == '0 && !acc_resp_i.load_complete) begin
+        acc_resp_o.load_complete = 1'b1;
+        vlend_load_d             = 1'b0;
+      end
+      if (vlend_store_q && hidden_stores_q == '0 && !acc_resp_i.store_complete) begin
+        acc_resp_o.store_complete = 1'b1;
+        vlend_store_d             = 1'b0;
+      end
+
+      unique case (state_q)
+        LB_IDLE, LB_CAPTURE: begin
+          if (accepted) begin
+            if (is_loop_insn(req, 6'b000011)) begin
+              // vlbeg.vx: capture the next instructions
+              state_d    = LB_CAPTURE;
+              body_cnt_d = '0;
+              body_ok_d  = 1'b1;
+            end else if (is_loop_insn(req, 6'b000100)) begin
+              // vlend.vx: replay the body if the avl is not over
+              if (state_q == LB_CAPTURE && body_ok_q && body_cnt_q != '0 && req.rs1 != '0 &&
+                  !acc_resp_i.error) begin
+                // The dispatcher gets vlend.vx again once the replay is over
+                state_d          = LB_REPLAY;
+                acc_resp_valid_o = 1'b0;
+                vlend_d          = req;
+                avl_d            = req.rs1;
+                body_ptr_d       = '0;
+              end else begin
+                state_d           = LB_IDLE;
+                acc_resp_o.result = req.rs1;
+                vlend_load_d      = !acc_resp_i.error;
+                vlend_store_d     = !acc_resp_i.error;
+              end
+            end else if (state_q == LB_CAPTURE && body_ok_q) begin
+              // Capture the instruction, with its scalar operands of the next strip
+              if (body_cnt_q == LoopBufDepth || !replayable(req, body_cnt_q == '0) ||
+                  acc_resp_i.error)
+                body_ok_d = 1'b0;
+              else begin
+                body_d[body_cnt_q] = req;
+                body_cnt_d         = body_cnt_q + 1;
+                if (body_cnt_q == '0)
+                  vl_d = vlen_t'(acc_resp_i.result);
+                else
+                  body_d[body_cnt_q].rs1 = next_base(req, vl_q);
+              end
+            end
+          end
+        end
+
+        LB_REPLAY: begin
+          if (accepted) begin
+            if (acc_resp_i.error) begin
+              // Stop at the exception, and let the software run this strip again
+              state_d        = LB_FINISH;
+              vlend_result_d = strip_avl_q;
+            end else begin
+              if (body_ptr_q == '0) begin
+                // New strip
+                vl_d        = vlen_t'(acc_resp_i.result);
+                strip_avl_d = avl_q;
+                avl_d       = avl_q - acc_resp_i.result;
+              end else
+                body_d[body_ptr_q].rs1 = next_base(req, vl_q);
+              hidden_loads_d  += is_load;
+              hidden_stores_d += is_store;
+
+              body_ptr_d = body_ptr_q + 1;
+              if (body_ptr_q == body_cnt_q - 1) begin
+                body_ptr_d = '0;
+                // Last strip
+                if (avl_d == '0) begin
+                  state_d        = LB_FINISH;
+                  vlend_result_d = '0;
+                end
+              end
+            end
+          end
+        end
+
+        LB_FINISH: begin
+          // The dispatcher answers vlend.vx to Ariane
+          if (accepted) begin
+            state_d           = LB_IDLE;
+            acc_resp_o.result = vlend_result_q;
+            vlend_load_d      = 1'b1;
+            vlend_store_d     = 1'b1;
+          end
+        end
+
+        default:;
+      endcase
+    end: p_loop_buffer
+
+    // No replay in progress, and all the completions signaled
+    assign idle_o = !(state_q inside {LB_REPLAY, LB_FINISH}) && !vlend_load_q && !vlend_store_q;
+  end: gen_loop_buffer
+
+endmodule : ara_loop_buffer
@@ -0,0 +1,364 @@
+// Copyright 2021 ETH Zurich and University of Bologna.
+// Solderpad Hardware License, Version 0.51, see LICENSE for details.
+// SPDX-License-Identifier: SHL-0.51
+//
+// Description:
+// Ara's stream prefetcher, between the VLSU and the L2. It watches the read
+// bursts of Ara: after two constant strides between the first addresses of
+// bursts with the same length and size, it reads the next bursts of the stream
+// ahead of Ara, into a buffer of NrBeats AXI beats. The consecutive bursts of a
+// unit-stride stream are a stream whose stride is the length of a burst.
+//
+// A read burst of Ara that is the oldest prefetched one is answered from the
+// buffer, even if its beats are still on their way. Any other read burst goes
+// to the L2, and drops the prefetched bursts that were not claimed yet, as well
+// as any write of Ara or of another master (inval_i). The dropped beats are
+// discarded as they arrive. Ara uses a single AXI ID, so all the R beats come
+// back in the order of the bursts.
+//
+// The prefetches stay inside [RegionBase, RegionBase + RegionLength), and do
+// not cross a 4 KiB page.
+
+module ara_prefetcher #(
+    // Beats of the prefetch buffer, 0 to pass everything through
+    parameter int  unsigned NrBeats      = 32'd0,
+    // Read bursts of Ara in flight
+    parameter int  unsigned MaxTxns      = 32'd0,
+    // Memory region that can be prefetched
+    parameter logic [63:0]  RegionBase   = 64'h0,
+    parameter logic [63:0]  RegionLength = 64'h0,
+    // AXI Bus Types
+    parameter int  unsigned AxiAddrWidth = 32'd0,
+    parameter int  unsigned AxiDataWidth = 32'd0,
+    parameter type          axi_req_t    = logic,
+    parameter type          axi_resp_t   = logic
+  ) (
+    input  logic      clk_i,
+    input  logic      rst_ni,
+    // Interface with Ara
+    input  axi_req_t  slv_req_i,
+    output axi_resp_t slv_resp_o,
+    // Interface with the L2
+    output axi_req_t  mst_req_o,
+    input  axi_resp_t mst_resp_i,
+    // Another master writes the memory
+    input  logic      inval_i,
+    // Performance events: an R beat of a prefetch comes from the L2, or an R beat of Ara is
+    // answered from the prefetch buffer
+    output logic      prefetch_beat_o,
+    output logic      prefetch_hit_o
+  );
+
+  import cf_math_pkg::idx_width;
+
+  `include "common_cells/registers.svh"
+
+  if (NrBeats == 0) begin: gen_no_prefetcher
+    assign mst_req_o       = slv_req_i;
+    assign slv_resp_o      = mst_resp_i;
+    assign prefetch_beat_o = 1'b0;
+    assign prefetch_hit_o  = 1'b0;
+  end: gen_no_prefetcher else begin: gen_prefetcher
+    // Prefetched bursts in the buffer
+    localparam int unsigned NrBursts = 4;
+
+    typedef logic [AxiAddrWidth-1:0]         addr_t;
+    typedef logic [AxiDataWidth-1:0]         data_t;
+    typedef logic [$bits(slv_req_i.ar)-1:0]  ar_t;
+
+    ///////////////
+    //  History  //
+    ///////////////
+
+    // Last read burst of Ara, and the stride from the previous one
+    logic  hist_valid_d, hist_valid_q;
+    ar_t   hist_ar_d, hist_ar_q;
+    addr_t stride_d, stride_q;
+    // The stride repeated: prefetch from pf_addr on
+    logic  confident_d, confident_q;
+    addr_t pf_addr_d, pf_addr_q;
+
+    `FF(hist_valid_q, hist_valid_d, 1'b0)
+    `FF(hist_ar_q, hist_ar_d, '0)
+    `FF(stride_q, stride_d, '0)
+    `FF(confident_q, confident_d, 1'b0)
+    `FF(pf_addr_q, pf_addr_d, '0)
+
+    ////////////////////////
+    //  Prefetched bursts  //
+    ////////////////////////
+
+    typedef struct packed {
+      addr_t          addr;
+      axi_pkg::len_t  len;
+      axi_pkg::size_t size;
+      // A read burst of Ara is answered with it
+      logic           claimed;
+      // Its beats are discarded
+      logic           dead;
+    } burst_t;
+
+    burst_t [NrBursts-1:0]          burst_d, burst_q;
+    logic [idx_width(NrBursts)-1:0] burst_wr_pnt_d, burst_wr_pnt_q, burst_rd_pnt_d, burst_rd_pnt_q;
+    logic [idx_width(NrBursts):0]   burst_cnt_d, burst_cnt_q;
+    // Beats of the oldest burst already read from the buffer
+    axi_pkg::len_t                  burst_beat_d, burst_beat_q;
+
+    `FF(burst_q, burst_d, '0)
+    `FF(burst_wr_pnt_q, burst_wr_pnt_d, '0)
+    `FF(burst_rd_pnt_q, burst_rd_pnt_d, '0)
+    `FF(burst_cnt_q, burst_cnt_d, '0)
+    `FF(burst_beat_q, burst_beat_d, '0)
+
+    // Their beats
+    data_t [NrBeats-1:0]              beat_data_d, beat_data_q;
+    axi_pkg::resp_t [NrBeats-1:0]     beat_resp_d, beat_resp_q;
+    logic [idx_width(NrBeats)-1:0]    beat_wr_pnt_d, beat_wr_pnt_q, beat_rd_pnt_d, beat_rd_pnt_q;
+    // Beats in the buffer, and beats in the buffer or on their way
+    logic [idx_width(NrBeats+1)-1:0]  beat_cnt_d, beat_cnt_q, beat_rsvd_d, beat_rsvd_q;
+
+    `FF(beat_data_q, beat_data_d, '0)
+    `FF(beat_resp_q, beat_resp_d, '0)
+    `FF(beat_wr_pnt_q, beat_wr_pnt_d, '0)
+    `FF(beat_rd_pnt_q, beat_rd_pnt_d, '0)
+    `FF(beat_cnt_q, beat_cnt_d, '0)
+    `FF(beat_rsvd_q, beat_rsvd_d, '0)
+
+    //////////////////////
+    //  Burst ordering  //
+    //////////////////////
+
+    // Read bursts of Ara: answered from the buffer, or from the L2
+    logic up_from_buf, up_push, up_pop, up_full, up_empty, up_in;
+    // Read bursts to the L2: prefetches, or bursts of Ara
+    logic dn_prefetch, dn_push, dn_pop, dn_full, dn_empty, dn_in;
+
+    fifo_v3 #(
+      .DEPTH(MaxTxns),
+      .dtype(logic  )
+    ) i_up_order (
+      .clk_i     (clk_i      ),
+      .rst_ni    (rst_ni     ),
+      .flush_i   (1'b0       ),
+      .testmode_i(1'b0       ),
+      .data_i    (up_in      ),
+      .push_i    (up_push    ),
+      .full_o    (up_full    ),
+      .data_o    (up_from_buf),
+      .pop_i     (up_pop     ),
+      .empty_o   (up_empty   ),
+      .usage_o   (/* Unused */)
+    );
+
+    fifo_v3 #(
+      .DEPTH(MaxTxns + NrBursts),
+      .dtype(logic            )
+    ) i_dn_order (
+      .clk_i     (clk_i      ),
+      .rst_ni    (rst_ni     ),
+      .flush_i   (1'b0       ),
+      .testmode_i(1'b0       ),
+      .data_i    (dn_in      ),
+      .push_i    (dn_push    ),
+      .full_o    (dn_full    ),
+      .data_o    (dn_prefetch),
+      .pop_i     (dn_pop     ),
+      .empty_o   (dn_empty   ),
+      .usage_o   (/* Unused */)
+    );
+
+    always_comb begin: p_prefetcher
+      automatic burst_t   head = burst_q[burst_rd_pnt_q];
+      automatic axi_req_t slv_ar = '0;
+      automatic axi_req_t hist   = '0;
+      // Oldest prefetched burst that was neither claimed nor dropped
+      automatic logic     next_valid = 1'b0;
+      automatic logic [idx_width(NrBursts)-1:0] next_idx = '0;
+
+      hist_valid_d   = hist_valid_q;
+      hist_ar_d      = hist_ar_q;
+      stride_d       = stride_q;
+      confident_d    = confident_q;
+      pf_addr_d      = pf_addr_q;
+      burst_d        = burst_q;
+      burst_wr_pnt_d = burst_wr_pnt_q;
+      burst_rd_pnt_d = burst_rd_pnt_q;
+      burst_cnt_d    = burst_cnt_q;
+      burst_beat_d   = burst_beat_q;
+      beat_data_d    = beat_data_q;
+      beat_resp_d    = beat_resp_q;
+      beat_wr_pnt_d  = beat_wr_pnt_q;
+      beat_rd_pnt_d  = beat_rd_pnt_q;
+      beat_cnt_d     = beat_cnt_q;
+      beat_rsvd_d    = beat_rsvd_q;
+
+      up_in   = 1'b0;
+      up_push = 1'b0;
+      up_pop  = 1'b0;
+      dn_in   = 1'b0;
+      dn_push = 1'b0;
+      dn_pop  = 1'b0;
+
+      prefetch_beat_o = 1'b0;
+      prefetch_hit_o  = 1'b0;
+
+      // The write channels go straight to the L2
+      mst_req_o           = slv_req_i;
+      mst_req_o.ar_valid  = 1'b0;
+      mst_req_o.r_ready   = 1'b0;
+      slv_resp_o          = mst_resp_i;
+      slv_resp_o.ar_ready = 1'b0;
+      slv_resp_o.r_valid  = 1'b0;
+
+      slv_ar.ar = slv_req_i.ar;
+      hist.ar   = hist_ar_q;
+
+      for (int b = NrBursts-1; b >= 0; b--) begin
+        automatic int unsigned idx = (burst_rd_pnt_q + b) % NrBursts;
+        if (b < burst_cnt_q && !burst_q[idx].claimed && !burst_q[idx].dead) begin
+          next_valid = 1'b1;
+          next_idx   = idx;
+        end
+      end
+
+      //////////////////
+      //  R channel  //
+      //////////////////
+
+      // Beats from the L2
+      if (!dn_empty) begin
+        if (dn_prefetch) begin
+          // Into the buffer, where they have a reserved slot
+          mst_req_o.r_ready = 1'b1;
+          if (mst_resp_i.r_valid) begin
+            prefetch_beat_o            = 1'b1;
+            beat_data_d[beat_wr_pnt_q] = mst_resp_i.r.data;
+            beat_resp_d[beat_wr_pnt_q] = mst_resp_i.r.resp;
+            beat_wr_pnt_d              = beat_wr_pnt_q == NrBeats-1 ? '0 : beat_wr_pnt_q + 1;
+            beat_cnt_d                 = beat_cnt_d + 1;
+            dn_pop                     = mst_resp_i.r.last;
+          end
+        end else if (!up_empty && !up_from_buf) begin
+          // To Ara
+          slv_resp_o.r_valid = mst_resp_i.r_valid;
+          mst_req_o.r_ready  = slv_req_i.r_ready;
+          if (mst_resp_i.r_valid && slv_req_i.r_ready && mst_resp_i.r.last) begin
+            dn_pop = 1'b1;
+            up_pop = 1'b1;
+          end
+        end
+      end
+
+      // Beats from the buffer
+      if (beat_cnt_q != '0 && burst_cnt_q != '0) begin
+        automatic logic pop = 1'b0;
+
+        if (head.dead)
+          // Discard them
+          pop = 1'b1;
+        else if (head.claimed && !up_empty && up_from_buf) begin
+          // To Ara
+          slv_resp_o.r_valid = 1'b1;
+          slv_resp_o.r.id    = hist.ar.id;
+          slv_resp_o.r.data  = beat_data_q[beat_rd_pnt_q];
+          slv_resp_o.r.resp  = beat_resp_q[beat_rd_pnt_q];
+          slv_resp_o.r.last  = burst_beat_q == head.len;
+          if (slv_req_i.r_ready) begin
+            pop            = 1'b1;
+            prefetch_hit_o = 1'b1;
+            up_pop         = burst_beat_q == head.len;
+          end
+        end
+
+        if (pop) begin
+          beat_rd_pnt_d = beat_rd_pnt_q == NrBeats-1 ? '0 : beat_rd_pnt_q + 1;
+          beat_cnt_d    = beat_cnt_d - 1;
+          beat_rsvd_d   = beat_rsvd_d - 1;
+          burst_beat_d  = burst_beat_q + 1;
+          if (burst_beat_q == head.len) begin
+            burst_beat_d   = '0;
+            burst_rd_pnt_d = burst_rd_pnt_q == NrBursts-1 ? '0 : burst_rd_pnt_q + 1;
+            burst_cnt_d    = burst_cnt_d - 1;
+          end
+        end
+      end
+
+      ///////////////////
+      //  AR channel  //
+      ///////////////////
+
+      if (slv_req_i.ar_valid) begin
+        automatic logic match = next_valid && slv_ar.ar.burst == axi_pkg::BURST_INCR &&
+          burst_q[next_idx].addr == slv_ar.ar.addr && burst_q[next_idx].len == slv_ar.ar.len &&
+          burst_q[next_idx].size == slv_ar.ar.size;
+        automatic addr_t stride = slv_ar.ar.addr - hist.ar.addr;
+
+        if (match) begin
+          // Answer it from the buffer
+          slv_resp_o.ar_ready = !up_full;
+          if (!up_full) begin
+            burst_d[next_idx].claimed = 1'b1;
+            up_in                     = 1'b1;
+            up_push                   = 1'b1;
+          end
+        end else begin
+          // Read it from the L2, and drop the prefetched bursts
+          mst_req_o.ar_valid  = !up_full && !dn_full;
+          slv_resp_o.ar_ready = mst_resp_i.ar_ready && !up_full && !dn_full;
+          if (slv_resp_o.ar_ready) begin
+            up_push = 1'b1;
+            dn_push = 1'b1;
+            for (int b = 0; b < NrBursts; b++)
+              if (!burst_q[b].claimed) burst_d[b].dead = 1'b1;
+
+            // Start a new stream
+            confident_d = hist_valid_q && stride == stride_q && stride != '0 &&
+                          slv_ar.ar.burst == axi_pkg::BURST_INCR &&
+                          slv_ar.ar.len == hist.ar.len && slv_ar.ar.size == hist.ar.size;
+            pf_addr_d   = slv_ar.ar.addr + stride;
+          end
+        end
+
+        if (slv_req_i.ar_valid && slv_resp_o.ar_ready) begin
+          hist_valid_d = 1'b1;
+          hist_ar_d    = slv_req_i.ar;
+          stride_d     = stride;
+        end
+      end else if (confident_q && burst_cnt_q != NrBursts && !dn_full &&
+                   beat_rsvd_q + hist.ar.len + 1 <= NrBeats) begin
+        automatic logic [63:0] bytes = (64'(hist.ar.len) + 1) << hist.ar.size;
+
+        // Prefetch the next burst of the stream, if it is in the region and in its page
+        if (64'(pf_addr_q) >= RegionBase &&
+            64'(pf_addr_q) + bytes <= RegionBase + RegionLength &&
+            64'(pf_addr_q[11:0]) + bytes <= 64'd4096) begin
+          mst_req_o.ar_valid = 1'b1;
+          mst_req_o.ar       = hist_ar_q;
+          mst_req_o.ar.addr  = pf_addr_q;
+          if (mst_resp_i.ar_ready) begin
+            burst_d[burst_wr_pnt_q] = '{
+              addr   : pf_addr_q,
+              len    : hist.ar.len,
+              size   : hist.ar.size,
+              default: '0
+            };
+            burst_wr_pnt_d = burst_wr_pnt_q == NrBursts-1 ? '0 : burst_wr_pnt_q + 1;
+            burst_cnt_d    = burst_cnt_d + 1;
+            beat_rsvd_d    = beat_rsvd_d + hist.ar.len + 1;
+            dn_in          = 1'b1;
+            dn_push        = 1'b1;
+            pf_addr_d      = pf_addr_q + stride_q;
+          end
+        end else
+          // The stream left the region, or its page
+          confident_d = 1'b0;
+      end
+
+      // Writes can make the prefetched data stale
+      if (slv_req_i.aw_valid && mst_resp_i.aw_ready || inval_i)
+        for (int b = 0; b < NrBursts; b++)
+          if (!burst_d[b].claimed) burst_d[b].dead = 1'b1;
+    end: p_prefetcher
+  end: gen_prefetcher
+
+endmodule : ara_prefetcher
@@ -0,0 +1,176 @@
+// Copyright 2021 ETH Zurich and University of Bologna.
+// Solderpad Hardware License, Version 0.51, see LICENSE for details.
+// SPDX-License-Identifier: SHL-0.51
+//
+// Description:
+// Ara's register renamer maps the architectural vector registers of the
+// dispatcher's requests onto the physical registers of the VRF, which holds
+// NrSpareVRegs spare registers on top of the 32 architectural ones.
+//
+// An instruction that overwrites a whole register, with LMUL <= 1, writes to a
+// free physical register instead of the current one. The sequencer tracks the
+// hazards on the physical registers, so the instruction does not wait for the
+// readers (WAR) and the writer (WAW) of the old value. Each architectural
+// register alternates between its home register (the physical register with
+// the same index) and a spare one.
+//
+// The units access a register group as contiguous physical registers. Before
+// an instruction that accesses a group, each renamed register is copied back
+// to its home register with a whole register move.
+
+module ara_rename import ara_pkg::*; import rvv_pkg::*; (
+    input  logic     clk_i,
+    input  logic     rst_ni,
+    // Interface with Ara's dispatcher
+    input  ara_req_t ara_req_i,
+    input  logic     ara_req_valid_i,
+    output logic     ara_req_ready_o,
+    // Interface with Ara's sequencer
+    output ara_req_t ara_req_o,
+    output logic     ara_req_valid_o,
+    input  logic     ara_req_ready_i
+  );
+
+  if (NrSpareVRegs == 0) begin: gen_no_rename
+    // Without spare registers, the architectural registers are the physical ones
+    assign ara_req_o       = ara_req_i;
+    assign ara_req_valid_o = ara_req_valid_i;
+    assign ara_req_ready_o = ara_req_ready_i;
+  end: gen_no_rename else begin: gen_rename
+    ///////////////////
+    //  Rename table //
+    ///////////////////
+
+    // Physical register of each architectural register
+    vreg_t [31:0]            map_d, map_q;
+    // Spare registers holding the value of an architectural register
+    logic [NrSpareVRegs-1:0] spare_busy_d, spare_busy_q;
+    // The injected moves are new requests for the sequencer, so the renamer keeps its own token
+    logic                    token_d, token_q;
+
+    always_ff @(posedge clk_i or negedge rst_ni) begin: p_rename_ff
+      if (!rst_ni) begin
+        for (int unsigned r = 0; r < 32; r++) map_q[r] <= vreg_t'(r);
+        spare_busy_q <= '0;
+        token_q      <= 1'b0;
+      end else begin
+        map_q        <= map_d;
+        spare_busy_q <= spare_busy_d;
+        token_q      <= token_d;
+      end
+    end: p_rename_ff
+
+    // Does the instruction access only single registers? A wider source or destination is a
+    // register group, as well as an index register of an indexed memory operation, whose EEW
+    // is not the one of the data.
+    function automatic logic single_vregs(ara_req_t req);
+      single_vregs = !(req.emul inside {LMUL_2, LMUL_4, LMUL_8}) &&
+                     !(req.vtype.vlmul inside {LMUL_2, LMUL_4, LMUL_8}) &&
+                     !(req.op inside {VLXE, [VSXE:VAMOMAXU]}) &&
+                     !(req.use_vs1 && int'(req.eew_vs1) > int'(req.vtype.vsew)) &&
+                     !(req.use_vs2 && int'(req.eew_vs2) > int'(req.vtype.vsew)) &&
+                     !(req.use_vd_op && int'(req.eew_vd_op) > int'(req.vtype.vsew));
+    endfunction : single_vregs
+
+    // Does the instruction overwrite all the elements of vd, without reading it? Only the VALU,
+    // the VMFPU, and the loads write vl elements of vtype.vsew, from the first one.
+    // The mask register is never renamed, since the units read it from v0.
+    function automatic logic overwrites_vd(ara_req_t req);
+      overwrites_vd = req.use_vd && req.vd != VMASK && !req.use_vd_op && req.vm &&
+                      req.emul == LMUL_1 && req.vstart == '0 &&
+                      req.vl == (VLENB >> req.vtype.vsew) &&
+                      req.op inside {[VADD:VMERGE], [VMUL:VFCVTFF], [VLE:VLSE]};
+    endfunction : overwrites_vd
+
+    // Lowest architectural register away from its home
+    logic       renamed;
+    logic [4:0] restore_vreg;
+    // Free physical register for the destination: its home, or a spare one
+    logic       dst_free;
+    vreg_t      dst_vreg;
+
+    always_comb begin: p_rename
+      automatic logic [4:0] vd = ara_req_i.vd[4:0];
+
+      map_d        = map_q;
+      spare_busy_d = spare_busy_q;
+      token_d      = token_q;
+
+      renamed      = 1'b0;
+      restore_vreg = '0;
+      for (int r = 31; r >= 0; r--)
+        if (map_q[r] != vreg_t'(r)) begin
+          renamed      = 1'b1;
+          restore_vreg = r;
+        end
+
+      dst_free = map_q[vd] != vreg_t'(vd);
+      dst_vreg = vreg_t'(vd);
+      if (!dst_free)
+        for (int s = NrSpareVRegs-1; s >= 0; s--)
+          if (!spare_busy_q[s]) begin
+            dst_free = 1'b1;
+            dst_vreg = vreg_t'(32 + s);
+          end
+
+      // Forward the request on the physical registers
+      ara_req_o       = ara_req_i;
+      ara_req_o.vs1   = map_q[ara_req_i.vs1[4:0]];
+      ara_req_o.vs2   = map_q[ara_req_i.vs2[4:0]];
+      // The tile of an outer product is not a vector register
+      ara_req_o.vd    = ara_req_i.use_vd ? map_q[vd] : ara_req_i.vd;
+      ara_req_o.token = token_q;
+      ara_req_valid_o = ara_req_valid_i;
+      ara_req_ready_o = ara_req_ready_i;
+
+      if (renamed && !single_vregs(ara_req_i)) begin
+        // Stall the request, and move the renamed register back to its home register, as a
+        // vmv1r.v. The 64-bit elements keep the encoding of the register.
+        ara_req_o = '{
+          op        : VMERGE,
+          vm        : 1'b1,
+          vs1       : map_q[restore_vreg],
+          use_vs1   : 1'b1,
+          eew_vs1   : EW64,
+          eew_vs2   : EW64,
+          eew_vd_op : EW64,
+          eew_vmask : ara_req_i.eew_vmask,
+          vd        : vreg_t'(restore_vreg),
+          use_vd    : 1'b1,
+          emul      : LMUL_1,
+          cvt_resize: CVT_SAME,
+          vl        : VLENB >> EW64,
+          vtype     : '{vsew: EW64, vlmul: LMUL_1, default: '0},
+          token     : token_q,
+          default   : '0
+        };
+        ara_req_ready_o = 1'b0;
+
+        if (ara_req_valid_i && ara_req_ready_i) begin
+          spare_busy_d[map_q[restore_vreg] - 32] = 1'b0;
+          map_d[restore_vreg]                    = vreg_t'(restore_vreg);
+        end
+      end else if (overwrites_vd(ara_req_i) && dst_free) begin
+        // Write to the free register, and release the old one
+        ara_req_o.vd = dst_vreg;
+
+        if (ara_req_valid_i && ara_req_ready_i) begin
+          if (map_q[vd] >= 32) spare_busy_d[map_q[vd] - 32] = 1'b0;
+          if (dst_vreg >= 32) spare_busy_d[dst_vreg - 32] = 1'b1;
+          map_d[vd] = dst_vreg;
+        end
+      end
+
+      // The token changes at every new request
+      if (ara_req_valid_i && ara_req_ready_i) token_d = ~token_q;
+    end: p_rename
+  end: gen_rename
+
+  //////////////////
+  //  Assertions  //
+  //////////////////
+
+  if (NrSpareVRegs > 32)
+    $error("[ara_rename] Ara supports at most 32 spare vector registers.");
+
+endmodule : ara_rename
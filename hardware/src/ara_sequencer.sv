@@ -32,16 +32,32 @@ module ara_sequencer import ara_pkg::*; import rvv_pkg::*; import cf_math_pkg::i
     input  pe_resp_t            [NrPEs-1:0] pe_resp_i,
     input  logic                            alu_vinsn_done_i,
     input  logic                            mfpu_vinsn_done_i,
+    input  logic                            mfpu2_vinsn_done_i,
+    input  logic                            mxu_vinsn_done_i,
     // Interface with the operand requesters
     output logic [NrVInsn-1:0][NrVInsn-1:0] global_hazard_table_o,
     // Only the slide unit can answer with a scalar response
     input  elen_t                           pe_scalar_resp_i,
     input  logic                            pe_scalar_resp_valid_i,
     output logic                            pe_scalar_resp_ready_o,
+    // The scalar result comes from the MASKU (vcpop.m, vfirst.m), and not from lane 0
+    output logic                            pe_scalar_resp_masku_o,
     // Interface with the Address Generation
     input  logic                            addrgen_ack_i,
     input  logic                            addrgen_error_i,
-    input  vlen_t                           addrgen_error_vl_i
+    input  vlen_t                           addrgen_error_vl_i,
+    // Performance events
+    output logic                            perf_valu_busy_o,
+    output logic                            perf_vmfpu_busy_o,
+    output logic                            perf_vmfpu2_busy_o,
+    output logic                            perf_vmxu_busy_o,
+    output logic                            perf_vldu_busy_o,
+    output logic                            perf_vstu_busy_o,
+    output logic                            perf_sldu_busy_o,
+    output logic                            perf_masku_busy_o,
+    output logic                            perf_stall_lanes_desynch_o,
+    output logic                            perf_stall_vinsn_full_o,
+    output logic                            perf_stall_hazard_o
   );
 
   ///////////////////////////////////
@@ -88,6 +104,8 @@ module ara_sequencer import ara_pkg::*; import rvv_pkg::*; import cf_math_pkg::i
 
   assign pe_vinsn_running_o = vinsn_running_q;
 
+  assign pe_scalar_resp_masku_o = scalar_masku_q;
+
   // Transpose the matrix
   for (genvar r = 0; r < NrVInsn; r++) begin : gen_trans_mtx_r
     for (genvar c = 0; c < NrPEs; c++) begin : gen_trans_mtx_c
@@ -138,13 +156,13 @@ module ara_sequencer import ara_pkg::*; import rvv_pkg::*; import cf_math_pkg::i
   enum logic { IDLE, WAIT } state_d, state_q;
 
   // For hazard detection, we need to know which vector instruction is reading/writing to each
-  // vector register
+  // physical vector register
   typedef struct packed {
     vid_t vid;
     logic valid;
   } vreg_access_t;
-  vreg_access_t [31:0] read_list_d, read_list_q;
-  vreg_access_t [31:0] write_list_d, write_list_q;
+  vreg_access_t [NrPhysVRegs-1:0] read_list_d, read_list_q;
+  vreg_access_t [NrPhysVRegs-1:0] write_list_d, write_list_q;
 
   pe_req_t pe_req_d;
   logic    pe_req_valid_d;
@@ -154,11 +172,12 @@ module ara_sequencer import ara_pkg::*; import rvv_pkg::*; import cf_math_pkg::i
     unique case (op) inside
       [VADD:VWREDSUM]      : vfu = VFU_Alu;
       [VMUL:VFWREDOSUM]    : vfu = VFU_MFpu;
-      [VMFEQ:VMXNOR]       : vfu = VFU_MaskUnit;
+      [VMFEQ:VGMUL]        : vfu = VFU_MaskUnit;
       [VLE:VLXE]           : vfu = VFU_LoadUnit;
-      [VSE:VSXE]           : vfu = VFU_StoreUnit;
+      [VSE:VAMOMAXU]       : vfu = VFU_StoreUnit;
       [VSLIDEUP:VSLIDEDOWN]: vfu = VFU_SlideUnit;
       [VMVXS:VFMVFS]       : vfu = VFU_None;
+      [VFMOP:VFMTR]        : vfu = VFU_MxUnit;
     endcase
   endfunction : vfu
 
@@ -180,16 +199,19 @@ module ara_sequencer import ara_pkg::*; import rvv_pkg::*; import cf_math_pkg::i
       [VMUL:VFCVTFF]:
         for (int i = 0; i < NrVFUs; i++)
           if (i == VFU_MFpu) target_vfus[i] = 1'b1;
-      [VMSEQ:VMXNOR]:
+      [VMSEQ:VRGATHEREI16], [VAESEF:VGMUL]:
         for (int i = 0; i < NrVFUs; i++)
           if (i == VFU_Alu || i == VFU_MaskUnit) target_vfus[i] = 1'b1;
+      VCOMPRESS, VAESKF1:
+        for (int i = 0; i < NrVFUs; i++)
+          if (i == VFU_MaskUnit) target_vfus[i] = 1'b1;
       [VMFEQ:VMFGE]:
         for (int i = 0; i < NrVFUs; i++)
           if (i == VFU_MFpu || i == VFU_MaskUnit) target_vfus[i] = 1'b1;
       [VLE:VLXE]:
         for (int i = 0; i < NrVFUs; i++)
           if (i == VFU_LoadUnit) target_vfus[i] = 1'b1;
-      [VSE:VSXE]:
+      [VSE:VAMOMAXU]:
         for (int i = 0; i < NrVFUs; i++)
           if (i == VFU_StoreUnit) target_vfus[i] = 1'b1;
       [VSLIDEUP:VSLIDEDOWN]:
@@ -198,12 +220,17 @@ module ara_sequencer import ara_pkg::*; import rvv_pkg::*; import cf_math_pkg::i
       [VMVXS:VFMVFS]:
         for (int i = 0; i < NrVFUs; i++)
           if (i == VFU_None) target_vfus[i] = 1'b1;
+      [VFMOP:VFMTR]:
+        for (int i = 0; i < NrVFUs; i++)
+          if (i == VFU_MxUnit) target_vfus[i] = 1'b1;
     endcase
   endfunction : target_vfus
 
   localparam int unsigned InsnQueueDepth [NrVFUs] = '{
     ValuInsnQueueDepth,
     MfpuInsnQueueDepth,
+    MfpuInsnQueueDepth,
+    MfpuInsnQueueDepth,
     SlduInsnQueueDepth,
     MaskuInsnQueueDepth,
     VlduInsnQueueDepth,
@@ -244,12 +271,95 @@ module ara_sequencer import ara_pkg::*; import rvv_pkg::*; import cf_math_pkg::i
   // the MASKU insn to be sure that the forwarded value is the scalar one
   logic running_mask_insn_d, running_mask_insn_q;
 
+  // With ScalarRespAsync, the instructions that return a scalar do not stall the sequencer.
+  // The scalar is returned when ready, while the next instructions are issued. Until then,
+  // the register read by vmv.x.s/vfmv.f.s cannot be overwritten (these do not run on any PE,
+  // so they are not tracked), and the instructions that use the MaskB operand queue of
+  // lane 0, from which the scalar comes, wait.
+  logic       scalar_pending_d, scalar_pending_q;
+  logic       scalar_vs2_track_d, scalar_vs2_track_q;
+  vreg_t      scalar_vs2_d, scalar_vs2_q;
+  logic       scalar_masku_d, scalar_masku_q;
+  logic       scalar_stall;
+
+  // Number of vector registers written by an instruction with EMUL emul
+  function automatic int unsigned emul_regs(vlmul_e emul);
+    unique case (emul)
+      LMUL_2 : emul_regs = 2;
+      LMUL_4 : emul_regs = 4;
+      LMUL_8 : emul_regs = 8;
+      default: emul_regs = 1;
+    endcase
+  endfunction : emul_regs
+
+  // The lanes keep the mask bits of the last cacheable masked instruction (lane_mask_cache.sv),
+  // which are valid for the next ones with the same vl and SEW, until v0 is written. These hits do
+  // not run on the Mask Unit. Since the lanes take their mask bits in order, the instructions that
+  // use the cache are not in flight together with other masked instructions of the lanes, or with
+  // those of the other lane VFU.
+  logic               mask_cache_valid_d, mask_cache_valid_q;
+  vlen_t              mask_cache_vl_d, mask_cache_vl_q;
+  vew_e               mask_cache_vsew_d, mask_cache_vsew_q;
+  // Masked instructions in flight that take their mask bits in the lanes, and the ones among
+  // them that use the cache
+  logic [NrVInsn-1:0] mask_lane_vinsn_d, mask_lane_vinsn_q;
+  logic [NrVInsn-1:0] mask_cached_vinsn_d, mask_cached_vinsn_q;
+  vfu_e [NrVInsn-1:0] mask_vinsn_vfu_d, mask_vinsn_vfu_q;
+  logic               mask_lane, mask_cacheable, mask_hit, mask_cache_stall;
+
+  always_comb begin: p_mask_cache
+    mask_lane = !ara_req_i.vm && vfu(ara_req_i.op) inside {VFU_Alu, VFU_MFpu, VFU_MaskUnit};
+    // The mask bits must fit the cache of every lane
+    mask_cacheable = MaskCacheBeats != 0 && !ara_req_i.vm &&
+      vfu(ara_req_i.op) inside {VFU_Alu, VFU_MFpu} &&
+      !(ara_req_i.op inside {[VREDSUM:VWREDSUM], [VFREDUSUM:VFWREDOSUM]}) &&
+      ara_req_i.vstart == '0 &&
+      ara_req_i.vl <= (MaskCacheBeats * NrLanes * 8) >> int'(ara_req_i.vtype.vsew);
+    mask_hit = mask_cacheable && mask_cache_valid_q && ara_req_i.vl == mask_cache_vl_q &&
+      ara_req_i.vtype.vsew == mask_cache_vsew_q;
+
+    mask_cache_stall = 1'b0;
+    for (int unsigned v = 0; v < NrVInsn; v++)
+      if (vinsn_running_q[v] && mask_lane_vinsn_q[v]) begin
+        if (mask_cacheable)
+          mask_cache_stall |= !mask_cached_vinsn_q[v] || mask_vinsn_vfu_q[v] != vfu(ara_req_i.op);
+        else if (mask_lane)
+          mask_cache_stall |= mask_cached_vinsn_q[v];
+      end
+  end: p_mask_cache
+
+  // With DualMfpu, the unmasked element-wise floating-point instructions, which need neither the
+  // Mask Unit nor the SLDU, go to the second VMFPU if it has fewer instructions in its queue. The
+  // choice is taken when the instruction is accepted, since it is then counted in the queue of
+  // its VMFPU, and kept until it is issued.
+  logic mfpu2_sel, mfpu2_sel_q;
+  vfu_e req_vfu;
+
+  assign mfpu2_sel = accepted_insn ?
+    DualMfpu && ara_req_i.vm && ara_req_i.op inside {[VFADD:VFCVTFF]} &&
+    insn_queue_cnt_q[VFU_MFpu2] < insn_queue_cnt_q[VFU_MFpu] :
+    mfpu2_sel_q;
+  assign req_vfu = mfpu2_sel ? VFU_MFpu2 : vfu(ara_req_i.op);
+
+  always_ff @(posedge clk_i or negedge rst_ni) begin: p_mfpu2_sel_ff
+    if (!rst_ni) mfpu2_sel_q <= 1'b0;
+    else         mfpu2_sel_q <= mfpu2_sel;
+  end: p_mfpu2_sel_ff
+
   // pe_req_ready_i comes from all the lanes
   // It is deasserted if the current request is stuck
   // because the target operand requesters are not ready in that lane
   logic [NrLanes-1:0] operand_requester_ready;
   assign operand_requester_ready = pe_req_ready_i[NrLanes-1:0];
 
+  // The incoming slide by one chains with the producer of its source
+  logic slide1_chain;
+
+  // The sequencer tried to issue the incoming request
+  logic issue_attempt;
+  // The incoming request is held back by a hazard
+  logic hazard_stall;
+
   // Update the token only upon new instructions
   assign ara_req_token_d = (ara_req_valid_i) ? ara_req_i.token : ara_req_token_q;
 
@@ -275,8 +385,34 @@ module ara_sequencer import ara_pkg::*; import rvv_pkg::*; import cf_math_pkg::i
     // Not ready by default
     pe_scalar_resp_ready_o = 1'b0;
 
+    scalar_pending_d   = scalar_pending_q;
+    scalar_vs2_track_d = scalar_vs2_track_q;
+    scalar_vs2_d       = scalar_vs2_q;
+    scalar_masku_d     = scalar_masku_q;
+
+    mask_cache_valid_d  = mask_cache_valid_q;
+    mask_cache_vl_d     = mask_cache_vl_q;
+    mask_cache_vsew_d   = mask_cache_vsew_q;
+    mask_lane_vinsn_d   = mask_lane_vinsn_q;
+    mask_cached_vinsn_d = mask_cached_vinsn_q;
+    mask_vinsn_vfu_d    = mask_vinsn_vfu_q;
+
+    // Hold the instructions that could disturb the pending scalar result, and the ones
+    // that answer to the dispatcher as well
+    scalar_stall = scalar_pending_q && (target_vfus_vec[VFU_MaskUnit] ||
+      (!ara_req_i.use_vd && !writes_tile(ara_req_i.op)) ||
+      is_load(ara_req_i.op) ||
+      (scalar_vs2_track_q && ara_req_i.use_vd && ara_req_i.vd <= scalar_vs2_q &&
+       scalar_vs2_q < ara_req_i.vd + emul_regs(ara_req_i.emul)));
+
+    slide1_chain = 1'b0;
+
+    // No stall by default
+    issue_attempt = 1'b0;
+    hazard_stall  = 1'b0;
+
     // Update vector register's access list
-    for (int unsigned v = 0; v < 32; v++) begin
+    for (int unsigned v = 0; v < NrPhysVRegs; v++) begin
       read_list_d[v].valid &= vinsn_running_q[read_list_q[v].vid] ;
       write_list_d[v].valid &= vinsn_running_q[write_list_q[v].vid];
     end
@@ -297,9 +433,11 @@ module ara_sequencer import ara_pkg::*; import rvv_pkg::*; import cf_math_pkg::i
           ara_req_ready_o = 1'b0;
         // Received a new request
         end else if (ara_req_valid_i) begin
+          issue_attempt = 1'b1;
           // The target PE is ready, and we can handle another running vector instruction
           // Let instructions with priority pass be issued
-          if (&vinsn_queue_issue && !stall_lanes_desynch && !vinsn_running_full) begin
+          if (&vinsn_queue_issue && !stall_lanes_desynch && !vinsn_running_full && !scalar_stall &&
+              !mask_cache_stall) begin
             ///////////////
             //  Hazards  //
             ///////////////
@@ -333,7 +471,7 @@ module ara_sequencer import ara_pkg::*; import rvv_pkg::*; import cf_math_pkg::i
               op            : ara_req_i.op,
               vm            : ara_req_i.vm,
               eew_vmask     : ara_req_i.eew_vmask,
-              vfu           : vfu(ara_req_i.op),
+              vfu           : req_vfu,
               vs1           : ara_req_i.vs1,
               use_vs1       : ara_req_i.use_vs1,
               conversion_vs1: ara_req_i.conversion_vs1,
@@ -349,6 +487,8 @@ module ara_sequencer import ara_pkg::*; import rvv_pkg::*; import cf_math_pkg::i
               swap_vs2_vd_op: ara_req_i.swap_vs2_vd_op,
               stride        : ara_req_i.stride,
               is_stride_np2 : ara_req_i.is_stride_np2,
+              is_ordered    : ara_req_i.is_ordered,
+              is_broadcast  : ara_req_i.is_broadcast,
               vd            : ara_req_i.vd,
               use_vd        : ara_req_i.use_vd,
               emul          : ara_req_i.emul,
@@ -363,6 +503,8 @@ module ara_sequencer import ara_pkg::*; import rvv_pkg::*; import cf_math_pkg::i
               hazard_vm     : pe_req_d.hazard_vm,
               hazard_vs1    : pe_req_d.hazard_vs1,
               hazard_vs2    : pe_req_d.hazard_vs2,
+              mask_fill     : mask_cacheable && !mask_hit,
+              mask_hit      : mask_hit,
               default       : '0
             };
 
@@ -370,42 +512,80 @@ module ara_sequencer import ara_pkg::*; import rvv_pkg::*; import cf_math_pkg::i
             global_hazard_table_d[vinsn_id_n] = pe_req_d.hazard_vd  | pe_req_d.hazard_vm |
                                                 pe_req_d.hazard_vs1 | pe_req_d.hazard_vs2;
 
+            // The slides by one element chain with the producer of vs2, since every lane reads
+            // vs2 from its first word on. They still wait for the older readers of vd (WAR, also
+            // in hazard_vs1), and vslide1up for the older writer of vd. With one lane,
+            // vslidedown skips the first word.
+            slide1_chain = Slide1Chain && ara_req_i.stride == 1 && !(|pe_req_d.hazard_vs1) &&
+              (ara_req_i.op == VSLIDEUP ? !(|pe_req_d.hazard_vd) : NrLanes > 1);
+
             // We only issue instructions that take no operands if they have no hazards.
-            // Moreover, SLIDE instructions cannot be always chained
-            // ToDo: optimize the case for vslide1down, vslide1up (wait 2 cycles, then chain)
-            if (!(|{ara_req_i.use_vs1, ara_req_i.use_vs2, ara_req_i.use_vd_op, !ara_req_i.vm}) &&
+            // The hits of the mask cache do not read v0.
+            // Moreover, SLIDE instructions cannot be always chained, but for the slides by one
+            if (!(|{ara_req_i.use_vs1, ara_req_i.use_vs2, ara_req_i.use_vd_op,
+                    !ara_req_i.vm && !mask_hit}) &&
                 |{pe_req_d.hazard_vs1, pe_req_d.hazard_vs2, pe_req_d.hazard_vm, pe_req_d.hazard_vd} ||
-                (pe_req_d.op == VSLIDEUP && |{pe_req_d.hazard_vd, pe_req_d.hazard_vs1, pe_req_d.hazard_vs2}) ||
-                (pe_req_d.op == VSLIDEDOWN && |{pe_req_d.hazard_vs1, pe_req_d.hazard_vs2}))
+                (pe_req_d.op == VSLIDEUP && |{pe_req_d.hazard_vd, pe_req_d.hazard_vs1, pe_req_d.hazard_vs2} &&
+                 !slide1_chain) ||
+                (pe_req_d.op == VSLIDEDOWN && |{pe_req_d.hazard_vs1, pe_req_d.hazard_vs2} && !slide1_chain))
             begin
               ara_req_ready_o = 1'b0;
               pe_req_valid_d  = 1'b0;
+              hazard_stall    = 1'b1;
             end else begin
               // Acknowledge instruction
               ara_req_ready_o = 1'b1;
 
               // Remember that the vector instruction is running
-              unique case (vfu(ara_req_i.op))
+              unique case (req_vfu)
                 VFU_LoadUnit : pe_vinsn_running_d[NrLanes + OffsetLoad][vinsn_id_n]  = 1'b1;
                 VFU_StoreUnit: pe_vinsn_running_d[NrLanes + OffsetStore][vinsn_id_n] = 1'b1;
                 VFU_SlideUnit: pe_vinsn_running_d[NrLanes + OffsetSlide][vinsn_id_n] = 1'b1;
                 VFU_MaskUnit : pe_vinsn_running_d[NrLanes + OffsetMask][vinsn_id_n]  = 1'b1;
                 VFU_None     : ;
                 default: for (int l = 0; l < NrLanes; l++)
-                    // Instruction is running on the lanes
-                    pe_vinsn_running_d[l][vinsn_id_n] = 1'b1;
+                    // Instruction is running on the lanes, but not on the ones without elements
+                    if (!ShortVlFastPath || !lane_skips_vinsn(ara_req_i.op, req_vfu, ara_req_i.vl, l))
+                      pe_vinsn_running_d[l][vinsn_id_n] = 1'b1;
               endcase
 
-              // Masked vector instructions also run on the mask unit
-              pe_vinsn_running_d[NrLanes + OffsetMask][vinsn_id_n] |= !ara_req_i.vm;
+              // Masked vector instructions also run on the mask unit, but for the hits of the
+              // mask cache
+              pe_vinsn_running_d[NrLanes + OffsetMask][vinsn_id_n] |= !ara_req_i.vm && !mask_hit;
+
+              // Track the masked instructions of the lanes
+              mask_lane_vinsn_d[vinsn_id_n]   = mask_lane;
+              mask_cached_vinsn_d[vinsn_id_n] = mask_cacheable;
+              mask_vinsn_vfu_d[vinsn_id_n]    = req_vfu;
+              // The lanes keep the mask bits of the new instruction, which are stale once v0 is
+              // written
+              if (mask_cacheable) begin
+                mask_cache_valid_d = 1'b1;
+                mask_cache_vl_d    = ara_req_i.vl;
+                mask_cache_vsew_d  = ara_req_i.vtype.vsew;
+              end
+              if (ara_req_i.use_vd && ara_req_i.vd == VMASK) mask_cache_valid_d = 1'b0;
 
               // Some instructions need to wait for an acknowledgment
-              // before being committed with Ariane
-              if (is_load(ara_req_i.op) || is_store(ara_req_i.op) || !ara_req_i.use_vd) begin
+              // before being committed with Ariane. The outer products write no vector
+              // register, but have no scalar result either.
+              if (is_load(ara_req_i.op) || is_store(ara_req_i.op) ||
+                  (!ara_req_i.use_vd && !writes_tile(ara_req_i.op) && !ScalarRespAsync)) begin
                 ara_req_ready_o = 1'b0;
                 state_d         = WAIT;
               end
 
+              // The scalar result is returned later, from IDLE
+              if (ScalarRespAsync && !is_load(ara_req_i.op) && !is_store(ara_req_i.op) &&
+                  !ara_req_i.use_vd && !writes_tile(ara_req_i.op)) begin
+                scalar_pending_d   = 1'b1;
+                scalar_vs2_track_d = vfu(ara_req_i.op) == VFU_None;
+                scalar_vs2_d       = ara_req_i.vs2;
+              end
+
+              if (!ara_req_i.use_vd && !writes_tile(ara_req_i.op))
+                scalar_masku_d = ara_req_i.op inside {[VCPOP:VFIRST]};
+
               // Issue the instruction
               pe_req_valid_d = 1'b1;
 
@@ -454,6 +634,14 @@ module ara_sequencer import ara_pkg::*; import rvv_pkg::*; import cf_math_pkg::i
       end
     endcase
 
+    // Return the pending scalar result
+    if (ScalarRespAsync && state_q == IDLE && scalar_pending_q && pe_scalar_resp_valid_i) begin
+      ara_resp_o.resp        = pe_scalar_resp_i;
+      ara_resp_valid_o       = 1'b1;
+      pe_scalar_resp_ready_o = pe_scalar_resp_valid_i & ~running_mask_insn_q;
+      scalar_pending_d       = 1'b0;
+    end
+
     // Update the global hazard table
     for (int id = 0; id < NrVInsn; id++) global_hazard_table_d[id] &= vinsn_running_d;
   end : p_sequencer
@@ -474,6 +662,18 @@ module ara_sequencer import ara_pkg::*; import rvv_pkg::*; import cf_math_pkg::i
       global_hazard_table_o <= '0;
 
       running_mask_insn_q <= 1'b0;
+
+      scalar_pending_q   <= 1'b0;
+      scalar_vs2_track_q <= 1'b0;
+      scalar_vs2_q       <= '0;
+      scalar_masku_q     <= 1'b0;
+
+      mask_cache_valid_q  <= 1'b0;
+      mask_cache_vl_q     <= '0;
+      mask_cache_vsew_q   <= EW8;
+      mask_lane_vinsn_q   <= '0;
+      mask_cached_vinsn_q <= '0;
+      mask_vinsn_vfu_q    <= '{default: VFU_None};
     end else begin
       state_q <= state_d;
 
@@ -489,6 +689,18 @@ module ara_sequencer import ara_pkg::*; import rvv_pkg::*; import cf_math_pkg::i
       global_hazard_table_o <= global_hazard_table_d;
 
       running_mask_insn_q <= running_mask_insn_d;
+
+      scalar_pending_q   <= scalar_pending_d;
+      scalar_vs2_track_q <= scalar_vs2_track_d;
+      scalar_vs2_q       <= scalar_vs2_d;
+      scalar_masku_q     <= scalar_masku_d;
+
+      mask_cache_valid_q  <= mask_cache_valid_d;
+      mask_cache_vl_q     <= mask_cache_vl_d;
+      mask_cache_vsew_q   <= mask_cache_vsew_d;
+      mask_lane_vinsn_q   <= mask_lane_vinsn_d;
+      mask_cached_vinsn_q <= mask_cached_vinsn_d;
+      mask_vinsn_vfu_q    <= mask_vinsn_vfu_d;
     end
   end
 
@@ -520,6 +732,8 @@ module ara_sequencer import ara_pkg::*; import rvv_pkg::*; import cf_math_pkg::i
   // ALU and MFPU has different signal sources
   assign insn_queue_done[VFU_Alu]       = alu_vinsn_done_i;
   assign insn_queue_done[VFU_MFpu]      = mfpu_vinsn_done_i;
+  assign insn_queue_done[VFU_MFpu2]     = mfpu2_vinsn_done_i;
+  assign insn_queue_done[VFU_MxUnit]    = mxu_vinsn_done_i;
   assign insn_queue_done[VFU_LoadUnit]  = |pe_resp_i[NrLanes+OffsetLoad].vinsn_done;
   assign insn_queue_done[VFU_StoreUnit] = |pe_resp_i[NrLanes+OffsetStore].vinsn_done;
   assign insn_queue_done[VFU_MaskUnit]  = |pe_resp_i[NrLanes+OffsetMask].vinsn_done;
@@ -533,10 +747,14 @@ module ara_sequencer import ara_pkg::*; import rvv_pkg::*; import cf_math_pkg::i
   // The new accepted instruction will not be immediately issued
   assign accepted_insn_stalled = accepted_insn & ~ara_req_ready_o;
 
-  // Masked instructions do use the mask unit as well
+  // Masked instructions do use the mask unit as well, but for the hits of the mask cache
   always_comb begin
     target_vfus_vec                = target_vfus(ara_req_i.op);
-    target_vfus_vec[VFU_MaskUnit] |= ~ara_req_i.vm;
+    target_vfus_vec[VFU_MaskUnit] |= ~ara_req_i.vm & ~mask_hit;
+    if (mfpu2_sel) begin
+      target_vfus_vec[VFU_MFpu]  = 1'b0;
+      target_vfus_vec[VFU_MFpu2] = 1'b1;
+    end
   end
 
   // One counter per VFU
@@ -586,4 +804,43 @@ module ara_sequencer import ara_pkg::*; import rvv_pkg::*; import cf_math_pkg::i
     assign vinsn_queue_issue[i] = ~target_vfus_vec[i] | (vinsn_queue_ready[i] | priority_pass[i]);
   end
 
+  //////////////////////////
+  //  Performance events  //
+  //////////////////////////
+
+  // The lanes run both the VALU and the VMFPU instructions.
+  // Keep track of the unit of each running instruction to tell them apart.
+  vfu_e [NrVInsn-1:0] vinsn_vfu_q;
+
+  always_ff @(posedge clk_i or negedge rst_ni) begin : p_vinsn_vfu_ff
+    if (!rst_ni) begin
+      vinsn_vfu_q <= '{default: VFU_None};
+    end else if (pe_req_valid_o) begin
+      vinsn_vfu_q[pe_req_o.id] <= pe_req_o.vfu;
+    end
+  end : p_vinsn_vfu_ff
+
+  always_comb begin : p_perf_busy
+    perf_valu_busy_o   = 1'b0;
+    perf_vmfpu_busy_o  = 1'b0;
+    perf_vmfpu2_busy_o = 1'b0;
+    perf_vmxu_busy_o   = 1'b0;
+    for (int unsigned v = 0; v < NrVInsn; v++) begin
+      perf_valu_busy_o   |= pe_vinsn_running_q[0][v] && vinsn_vfu_q[v] == VFU_Alu;
+      perf_vmfpu_busy_o  |= pe_vinsn_running_q[0][v] && vinsn_vfu_q[v] == VFU_MFpu;
+      perf_vmfpu2_busy_o |= pe_vinsn_running_q[0][v] && vinsn_vfu_q[v] == VFU_MFpu2;
+      perf_vmxu_busy_o   |= pe_vinsn_running_q[0][v] && vinsn_vfu_q[v] == VFU_MxUnit;
+    end
+  end : p_perf_busy
+
+  assign perf_vldu_busy_o  = |pe_vinsn_running_q[NrLanes + OffsetLoad];
+  assign perf_vstu_busy_o  = |pe_vinsn_running_q[NrLanes + OffsetStore];
+  assign perf_sldu_busy_o  = |pe_vinsn_running_q[NrLanes + OffsetSlide];
+  assign perf_masku_busy_o = |pe_vinsn_running_q[NrLanes + OffsetMask];
+
+  // Stall causes of the incoming request
+  assign perf_stall_lanes_desynch_o = issue_attempt && stall_lanes_desynch;
+  assign perf_stall_vinsn_full_o    = issue_attempt && vinsn_running_full;
+  assign perf_stall_hazard_o        = hazard_stall;
+
 endmodule : ara_sequencer
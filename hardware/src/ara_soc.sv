@@ -5,10 +5,12 @@
 // Author: Matheus Cavalcante <matheusd@iis.ee.ethz.ch>
 // Description:
 // Ara's SoC, containing Ariane, Ara, and a L2 cache.
+// NrCores systems (Ariane + Ara) and a DMA engine share the L2 through the crossbar.
 
 module ara_soc import axi_pkg::*; import ara_pkg::*; #(
     // RVV Parameters
     parameter  int           unsigned NrLanes      = 0,                          // Number of parallel vector lanes.
+    parameter  int           unsigned NrCores      = 1,                          // Number of systems (Ariane + Ara).
     // Support for floating-point data types
     parameter  fpu_support_e          FPUSupport   = FPUSupportHalfSingleDouble,
     // External support for vfrec7, vfrsqrt7
@@ -19,11 +21,26 @@ module ara_soc import axi_pkg::*; import ara_pkg::*; #(
     parameter  int           unsigned AxiDataWidth = 32*NrLanes,
     parameter  int           unsigned AxiAddrWidth = 64,
     parameter  int           unsigned AxiUserWidth = 1,
-    parameter  int           unsigned AxiIdWidth   = 5,
+    // ID width of the crossbar's master ports: each system uses AxiIdWidth - $clog2(NrCores + 1) bits
+    parameter  int           unsigned AxiIdWidth   = 5 + $clog2(NrCores + 1),
     // AXI Resp Delay [ps] for gate-level simulation
     parameter  int           unsigned AxiRespDelay = 200,
     // Main memory
     parameter  int           unsigned L2NumWords   = 2**20,
+    // Timing of the main memory. Simulation only, to model a DRAM (see ara_dram_model).
+    // Latencies in cycles, bandwidth in bytes per cycle (0 is the full AXI width).
+    // The banks are interleaved every AXI word, and serve one port of the L2 each per cycle.
+    parameter  int           unsigned L2ReadLatency   = 1,
+    parameter  int           unsigned L2WriteLatency  = 1,
+    parameter  int           unsigned L2BytesPerCycle = 0,
+    parameter  int           unsigned L2NumBanks      = 8,
+`ifdef TARGET_FPGA
+    // AXI types of the main memory port, which replaces the L2 memory on the FPGA. They must match
+    // the wide AXI bus of the SoC (ID, address, and data widths of AxiIdWidth, AxiAddrWidth, and
+    // AxiDataWidth).
+    parameter  type                   dram_axi_req_t  = logic,
+    parameter  type                   dram_axi_resp_t = logic,
+`endif
     // Dependant parameters. DO NOT CHANGE!
     localparam type                   axi_data_t   = logic [AxiDataWidth-1:0],
     localparam type                   axi_strb_t   = logic [AxiDataWidth/8-1:0],
@@ -48,6 +65,14 @@ module ara_soc import axi_pkg::*; import ara_pkg::*; #(
     input  logic [31:0] uart_prdata_i,
     input  logic        uart_pready_i,
     input  logic        uart_pslverr_i
+`ifdef TARGET_FPGA
+    ,
+    // Main memory (e.g., a DDR controller)
+    output dram_axi_req_t  dram_axi_req_o,
+    input  dram_axi_resp_t dram_axi_resp_i,
+    // Events counted by the performance counters, to expose them to the host
+    output perf_events_t   perf_events_o
+`endif
   );
 
   `include "axi/assign.svh"
@@ -59,25 +84,29 @@ module ara_soc import axi_pkg::*; import ara_pkg::*; #(
   //  Memory Regions  //
   //////////////////////
 
-  localparam NrAXIMasters = 1; // Actually masters, but slaves on the crossbar
+  // The systems, then the DMA engine
+  localparam NrAXIMasters = NrCores + 1; // Actually masters, but slaves on the crossbar
 
   typedef enum int unsigned {
     L2MEM = 0,
     UART  = 1,
-    CTRL  = 2
+    CTRL  = 2,
+    DMA   = 3
   } axi_slaves_e;
-  localparam NrAXISlaves = CTRL + 1;
+  localparam NrAXISlaves = DMA + 1;
 
   // Memory Map
   // 1GByte of DDR (split between two chips on Genesys2)
   localparam logic [63:0] DRAMLength = 64'h40000000;
   localparam logic [63:0] UARTLength = 64'h1000;
   localparam logic [63:0] CTRLLength = 64'h1000;
+  localparam logic [63:0] DMALength  = 64'h1000;
 
   typedef enum logic [63:0] {
     DRAMBase = 64'h8000_0000,
     UARTBase = 64'hC000_0000,
-    CTRLBase = 64'hD000_0000
+    CTRLBase = 64'hD000_0000,
+    DMABase  = 64'hD000_1000
   } soc_bus_start_e;
 
   ///////////
@@ -101,21 +130,21 @@ module ara_soc import axi_pkg::*; import ara_pkg::*; #(
   typedef logic [AxiCoreIdWidth-1:0] axi_core_id_t;
 
   // AXI Typedefs
-  `AXI_TYPEDEF_ALL(system, axi_addr_t, axi_id_t, axi_data_t, axi_strb_t, axi_user_t)
+  `AXI_TYPEDEF_ALL(system, axi_addr_t, axi_soc_id_t, axi_data_t, axi_strb_t, axi_user_t)
   `AXI_TYPEDEF_ALL(ara_axi, axi_addr_t, axi_core_id_t, axi_data_t, axi_strb_t, axi_user_t)
   `AXI_TYPEDEF_ALL(ariane_axi, axi_addr_t, axi_core_id_t, axi_narrow_data_t, axi_narrow_strb_t,
     axi_user_t)
-  `AXI_TYPEDEF_ALL(soc_narrow, axi_addr_t, axi_soc_id_t, axi_narrow_data_t, axi_narrow_strb_t,
+  `AXI_TYPEDEF_ALL(soc_narrow, axi_addr_t, axi_id_t, axi_narrow_data_t, axi_narrow_strb_t,
     axi_user_t)
-  `AXI_TYPEDEF_ALL(soc_wide, axi_addr_t, axi_soc_id_t, axi_data_t, axi_strb_t, axi_user_t)
+  `AXI_TYPEDEF_ALL(soc_wide, axi_addr_t, axi_id_t, axi_data_t, axi_strb_t, axi_user_t)
   `AXI_LITE_TYPEDEF_ALL(soc_narrow_lite, axi_addr_t, axi_narrow_data_t, axi_narrow_strb_t)
 
-  // Buses
-  system_req_t  system_axi_req_spill;
-  system_resp_t system_axi_resp_spill;
-  system_resp_t system_axi_resp_spill_del;
-  system_req_t  system_axi_req;
-  system_resp_t system_axi_resp;
+  // Buses, one per system. The bus of the DMA engine follows the ones of the systems.
+  system_req_t  [NrCores-1:0]      system_axi_req_spill;
+  system_resp_t [NrCores-1:0]      system_axi_resp_spill;
+  system_resp_t [NrCores-1:0]      system_axi_resp_spill_del;
+  system_req_t  [NrAXIMasters-1:0] system_axi_req;
+  system_resp_t [NrAXIMasters-1:0] system_axi_resp;
 
   soc_wide_req_t    [NrAXISlaves-1:0] periph_wide_axi_req;
   soc_wide_resp_t   [NrAXISlaves-1:0] periph_wide_axi_resp;
@@ -129,8 +158,9 @@ module ara_soc import axi_pkg::*; import ara_pkg::*; #(
   localparam axi_pkg::xbar_cfg_t XBarCfg = '{
     NoSlvPorts        : NrAXIMasters,
     NoMstPorts        : NrAXISlaves,
-    MaxMstTrans       : 4,
-    MaxSlvTrans       : 4,
+    // CVA6 and Ara of a system share the same master port
+    MaxMstTrans       : 4 + VaddrgenInsnQueueDepth,
+    MaxSlvTrans       : 4 + VaddrgenInsnQueueDepth,
     FallThrough       : 1'b0,
     LatencyMode       : axi_pkg::CUT_MST_PORTS,
     AxiIdWidthSlvPorts: AxiSocIdWidth,
@@ -143,6 +173,7 @@ module ara_soc import axi_pkg::*; import ara_pkg::*; #(
 
   axi_pkg::xbar_rule_64_t [NrAXISlaves-1:0] routing_rules;
   assign routing_rules = '{
+    '{idx: DMA, start_addr: DMABase, end_addr: DMABase + DMALength},
     '{idx: CTRL, start_addr: CTRLBase, end_addr: CTRLBase + CTRLLength},
     '{idx: UART, start_addr: UARTBase, end_addr: UARTBase + UARTLength},
     '{idx: L2MEM, start_addr: DRAMBase, end_addr: DRAMBase + DRAMLength}
@@ -181,16 +212,17 @@ module ara_soc import axi_pkg::*; import ara_pkg::*; #(
   //  L2  //
   //////////
 
-  // The L2 memory does not support atomics
+  // The L2 memory does not support atomics: the adapter executes them as a read and a write, with
+  // all the other transactions held
 
   soc_wide_req_t  l2mem_wide_axi_req_wo_atomics;
   soc_wide_resp_t l2mem_wide_axi_resp_wo_atomics;
-  axi_atop_filter #(
-    .AxiIdWidth     (AxiSocIdWidth  ),
-    .AxiMaxWriteTxns(4              ),
-    .req_t          (soc_wide_req_t ),
-    .resp_t         (soc_wide_resp_t)
-  ) i_l2mem_atop_filter (
+  axi_amo_adapter #(
+    .MaxTxns     (256             ),
+    .AxiDataWidth(AxiDataWidth    ),
+    .req_t       (soc_wide_req_t  ),
+    .resp_t      (soc_wide_resp_t )
+  ) i_l2mem_amo_adapter (
     .clk_i     (clk_i                         ),
     .rst_ni    (rst_ni                        ),
     .slv_req_i (periph_wide_axi_req[L2MEM]    ),
@@ -199,66 +231,181 @@ module ara_soc import axi_pkg::*; import ara_pkg::*; #(
     .mst_resp_i(l2mem_wide_axi_resp_wo_atomics)
   );
 
-  logic                      l2_req;
-  logic                      l2_we;
-  logic [AxiAddrWidth-1:0]   l2_addr;
-  logic [AxiDataWidth/8-1:0] l2_be;
-  logic [AxiDataWidth-1:0]   l2_wdata;
-  logic [AxiDataWidth-1:0]   l2_rdata;
-  logic                      l2_rvalid;
-
-  axi_to_mem #(
-    .AddrWidth (AxiAddrWidth   ),
-    .DataWidth (AxiDataWidth   ),
-    .IdWidth   (AxiSocIdWidth  ),
-    .NumBanks  (1              ),
-    .axi_req_t (soc_wide_req_t ),
-    .axi_resp_t(soc_wide_resp_t)
-  ) i_axi_to_mem (
-    .clk_i       (clk_i                         ),
-    .rst_ni      (rst_ni                        ),
-    .axi_req_i   (l2mem_wide_axi_req_wo_atomics ),
-    .axi_resp_o  (l2mem_wide_axi_resp_wo_atomics),
-    .mem_req_o   (l2_req                        ),
-    .mem_gnt_i   (l2_req                        ), // Always available
-    .mem_we_o    (l2_we                         ),
-    .mem_addr_o  (l2_addr                       ),
-    .mem_strb_o  (l2_be                         ),
-    .mem_wdata_o (l2_wdata                      ),
-    .mem_rdata_i (l2_rdata                      ),
-    .mem_rvalid_i(l2_rvalid                     ),
-    .mem_atop_o  (/* Unused */                  ),
-    .busy_o      (/* Unused */                  )
+`ifdef TARGET_FPGA
+  // The main memory is outside of the SoC
+  assign dram_axi_req_o                 = l2mem_wide_axi_req_wo_atomics;
+  assign l2mem_wide_axi_resp_wo_atomics = dram_axi_resp_i;
+`else
+
+  // The L2 memory has a port for each master of ara_system's mux, selected by the MSB of the ID of
+  // the system: CVA6 (0) and Ara (1). The crossbar prepends the index of the system to the ID, so
+  // the port of CVA6 of system c is 2*c, and the one of its Ara is 2*c+1. The DMA engine uses IDs
+  // with a cleared MSB, and gets the last port. The ports access the banks of the memory in parallel.
+  localparam int unsigned NrL2Ports = 2*NrCores + 1;
+
+  soc_wide_req_t  [NrL2Ports-1:0] l2mem_port_axi_req;
+  soc_wide_resp_t [NrL2Ports-1:0] l2mem_port_axi_resp;
+
+  axi_demux #(
+    .AxiIdWidth (AxiIdWidth                 ),
+    .aw_chan_t  (soc_wide_aw_chan_t         ),
+    .w_chan_t   (soc_wide_w_chan_t          ),
+    .b_chan_t   (soc_wide_b_chan_t          ),
+    .ar_chan_t  (soc_wide_ar_chan_t         ),
+    .r_chan_t   (soc_wide_r_chan_t          ),
+    .req_t      (soc_wide_req_t             ),
+    .resp_t     (soc_wide_resp_t            ),
+    .NoMstPorts (NrL2Ports                  ),
+    .MaxTrans   (4 + VaddrgenInsnQueueDepth ),
+    .AxiLookBits(AxiIdWidth                 )
+  ) i_l2mem_demux (
+    .clk_i          (clk_i                                                ),
+    .rst_ni         (rst_ni                                               ),
+    .test_i         (1'b0                                                 ),
+    .slv_req_i      (l2mem_wide_axi_req_wo_atomics                        ),
+    .slv_aw_select_i(l2mem_wide_axi_req_wo_atomics.aw.id[AxiIdWidth-1:AxiSocIdWidth-1]),
+    .slv_ar_select_i(l2mem_wide_axi_req_wo_atomics.ar.id[AxiIdWidth-1:AxiSocIdWidth-1]),
+    .slv_resp_o     (l2mem_wide_axi_resp_wo_atomics                       ),
+    .mst_reqs_o     (l2mem_port_axi_req                                   ),
+    .mst_resps_i    (l2mem_port_axi_resp                                  )
+  );
+
+  logic [NrL2Ports-1:0]                     l2_req;
+  logic [NrL2Ports-1:0]                     l2_we;
+  logic [NrL2Ports-1:0][AxiAddrWidth-1:0]   l2_addr;
+  logic [NrL2Ports-1:0][AxiDataWidth/8-1:0] l2_be;
+  logic [NrL2Ports-1:0][AxiDataWidth-1:0]   l2_wdata;
+  logic [NrL2Ports-1:0][AxiDataWidth-1:0]   l2_rdata;
+  logic [NrL2Ports-1:0]                     l2_rvalid;
+  logic [NrL2Ports-1:0]                     l2_gnt;
+  // Requests to the banks of the memory macro, which answers one cycle after their grant
+  logic [NrL2Ports-1:0]                     l2_mem_req;
+  logic [NrL2Ports-1:0]                     l2_mem_gnt;
+  logic [NrL2Ports-1:0][AxiDataWidth-1:0]   l2_mem_rdata;
+  logic [NrL2Ports-1:0][$clog2(L2NumWords)-1:0] l2_mem_addr;
+
+  // Requests in flight in the memory model, enough to hide the latency
+  localparam int unsigned L2BufDepth = (L2ReadLatency > L2WriteLatency ? L2ReadLatency : L2WriteLatency) + 1;
+
+  for (genvar p = 0; p < NrL2Ports; p++) begin: gen_l2_ports
+    axi_to_mem #(
+      .AddrWidth (AxiAddrWidth   ),
+      .DataWidth (AxiDataWidth   ),
+      .IdWidth   (AxiIdWidth     ),
+      .NumBanks  (1              ),
+      .BufDepth  (L2BufDepth     ),
+      .axi_req_t (soc_wide_req_t ),
+      .axi_resp_t(soc_wide_resp_t)
+    ) i_axi_to_mem (
+      .clk_i       (clk_i                 ),
+      .rst_ni      (rst_ni                ),
+      .axi_req_i   (l2mem_port_axi_req[p] ),
+      .axi_resp_o  (l2mem_port_axi_resp[p]),
+      .mem_req_o   (l2_req[p]             ),
+      .mem_gnt_i   (l2_gnt[p]             ),
+      .mem_we_o    (l2_we[p]              ),
+      .mem_addr_o  (l2_addr[p]            ),
+      .mem_strb_o  (l2_be[p]              ),
+      .mem_wdata_o (l2_wdata[p]           ),
+      .mem_rdata_i (l2_rdata[p]           ),
+      .mem_rvalid_i(l2_rvalid[p]          ),
+      .mem_atop_o  (/* Unused */          ),
+      .busy_o      (/* Unused */          )
+    );
+
+    assign l2_mem_addr[p] = l2_addr[p][$clog2(L2NumWords)-1+$clog2(AxiDataWidth/8):$clog2(AxiDataWidth/8)];
+
+`ifndef SPYGLASS
+    ara_dram_model #(
+      .AddrWidth    (AxiAddrWidth   ),
+      .DataWidth    (AxiDataWidth   ),
+      .ReadLatency  (L2ReadLatency  ),
+      .WriteLatency (L2WriteLatency ),
+      .BytesPerCycle(L2BytesPerCycle),
+      .NumBanks     (L2NumBanks     ),
+      .BufDepth     (L2BufDepth     )
+    ) i_dram_model (
+      .clk_i      (clk_i          ),
+      .rst_ni     (rst_ni         ),
+      .req_i      (l2_req[p]      ),
+      .gnt_o      (l2_gnt[p]      ),
+      .we_i       (l2_we[p]       ),
+      .addr_i     (l2_addr[p]     ),
+      .rvalid_o   (l2_rvalid[p]   ),
+      .rdata_o    (l2_rdata[p]    ),
+      .mem_req_o  (l2_mem_req[p]  ),
+      .mem_gnt_i  (l2_mem_gnt[p]  ),
+      .mem_rdata_i(l2_mem_rdata[p])
+    );
+`else
+    // One-cycle latency
+    assign l2_mem_req[p] = l2_req[p];
+    assign l2_gnt[p]     = l2_mem_gnt[p];
+    assign l2_rdata[p]   = '0;
+    `FF(l2_rvalid[p], l2_gnt[p], 1'b0);
+`endif
+  end: gen_l2_ports
+
+  // Each bank of the memory serves one port per cycle
+  ara_l2_arbiter #(
+    .NumPorts (NrL2Ports   ),
+    .NumBanks (L2NumBanks   ),
+    .AddrWidth(AxiAddrWidth),
+    .DataWidth(AxiDataWidth)
+  ) i_l2_arbiter (
+    .clk_i (clk_i     ),
+    .rst_ni(rst_ni    ),
+    .req_i (l2_mem_req),
+    .addr_i(l2_addr   ),
+    .gnt_o (l2_mem_gnt)
   );
 
 `ifndef SPYGLASS
+  // The ports never access the same bank in the same cycle, so the banks are modeled by the ports of a
+  // single memory, which the testbenches preload
+`ifdef SPARSE_DRAM
+  // Verilator only: the memory is a sparse DPI-C model, allocated on first touch
+  ara_sparse_dram #(
+    .NumWords (L2NumWords  ),
+    .NumPorts (NrL2Ports   ),
+    .DataWidth(AxiDataWidth)
+  ) i_dram (
+    .clk_i  (clk_i       ),
+    .rst_ni (rst_ni      ),
+    .req_i  (l2_mem_gnt  ),
+    .we_i   (l2_we       ),
+    .addr_i (l2_mem_addr ),
+    .wdata_i(l2_wdata    ),
+    .be_i   (l2_be       ),
+    .rdata_o(l2_mem_rdata)
+  );
+`else
   tc_sram #(
     .NumWords (L2NumWords  ),
-    .NumPorts (1           ),
+    .NumPorts (NrL2Ports   ),
     .DataWidth(AxiDataWidth),
     .SimInit("random")
   ) i_dram (
-    .clk_i  (clk_i                                                                      ),
-    .rst_ni (rst_ni                                                                     ),
-    .req_i  (l2_req                                                                     ),
-    .we_i   (l2_we                                                                      ),
-    .addr_i (l2_addr[$clog2(L2NumWords)-1+$clog2(AxiDataWidth/8):$clog2(AxiDataWidth/8)]),
-    .wdata_i(l2_wdata                                                                   ),
-    .be_i   (l2_be                                                                      ),
-    .rdata_o(l2_rdata                                                                   )
+    .clk_i  (clk_i       ),
+    .rst_ni (rst_ni      ),
+    .req_i  (l2_mem_gnt  ),
+    .we_i   (l2_we       ),
+    .addr_i (l2_mem_addr ),
+    .wdata_i(l2_wdata    ),
+    .be_i   (l2_be       ),
+    .rdata_o(l2_mem_rdata)
   );
+`endif
 `else
-  assign l2_rdata = '0;
+  assign l2_mem_rdata = '0;
+`endif
 `endif
-
-  // One-cycle latency
-  `FF(l2_rvalid, l2_req, 1'b0);
 
   ////////////
   //  UART  //
   ////////////
 
-  `AXI_TYPEDEF_ALL(uart_axi, axi_addr_t, axi_soc_id_t, logic [31:0], logic [3:0], axi_user_t)
+  `AXI_TYPEDEF_ALL(uart_axi, axi_addr_t, axi_id_t, logic [31:0], logic [3:0], axi_user_t)
   `AXI_LITE_TYPEDEF_ALL(uart_lite, axi_addr_t, logic [31:0], logic [3:0])
   `APB_TYPEDEF_ALL(uart_apb, axi_addr_t, logic [31:0], logic [3:0])
 
@@ -311,7 +458,7 @@ module ara_soc import axi_pkg::*; import ara_pkg::*; #(
   axi_to_axi_lite #(
     .AxiAddrWidth   (AxiAddrWidth    ),
     .AxiDataWidth   (32'd32          ),
-    .AxiIdWidth     (AxiSocIdWidth   ),
+    .AxiIdWidth     (AxiIdWidth      ),
     .AxiUserWidth   (AxiUserWidth    ),
     .AxiMaxWriteTxns(32'd1           ),
     .AxiMaxReadTxns (32'd1           ),
@@ -334,7 +481,7 @@ module ara_soc import axi_pkg::*; import ara_pkg::*; #(
     .AxiSlvPortDataWidth(AxiWideDataWidth  ),
     .AxiMstPortDataWidth(32                ),
     .AxiAddrWidth       (AxiAddrWidth      ),
-    .AxiIdWidth         (AxiSocIdWidth     ),
+    .AxiIdWidth         (AxiIdWidth        ),
     .AxiMaxReads        (1                 ),
     .ar_chan_t          (soc_wide_ar_chan_t),
     .mst_r_chan_t       (uart_axi_r_chan_t ),
@@ -364,11 +511,16 @@ module ara_soc import axi_pkg::*; import ara_pkg::*; #(
   soc_narrow_lite_resp_t axi_lite_ctrl_registers_resp;
 
   logic [63:0] event_trigger;
+  // Lanes used by the vector instructions, set by the software
+  logic [63:0] active_lanes;
+
+  // Events counted by the performance counters
+  perf_events_t perf_events;
 
   axi_to_axi_lite #(
     .AxiAddrWidth   (AxiAddrWidth          ),
     .AxiDataWidth   (AxiNarrowDataWidth    ),
-    .AxiIdWidth     (AxiSocIdWidth         ),
+    .AxiIdWidth     (AxiIdWidth            ),
     .AxiUserWidth   (AxiUserWidth          ),
     .AxiMaxReadTxns (1                     ),
     .AxiMaxWriteTxns(1                     ),
@@ -403,14 +555,19 @@ module ara_soc import axi_pkg::*; import ara_pkg::*; #(
     .dram_base_addr_o     (/* Unused */                ),
     .dram_end_addr_o      (/* Unused */                ),
     .exit_o               (exit_o                      ),
-    .event_trigger_o      (event_trigger)
+    .event_trigger_o      (event_trigger               ),
+    .trace_value_o        (/* Unused */                ),
+    .trace_tag_o          (/* Unused */                ),
+    .trace_valid_o        (/* Unused */                ),
+    .active_lanes_o       (active_lanes                ),
+    .perf_events_i        (perf_events                 )
   );
 
   axi_dw_converter #(
     .AxiSlvPortDataWidth(AxiWideDataWidth    ),
     .AxiMstPortDataWidth(AxiNarrowDataWidth  ),
     .AxiAddrWidth       (AxiAddrWidth        ),
-    .AxiIdWidth         (AxiSocIdWidth       ),
+    .AxiIdWidth         (AxiIdWidth          ),
     .AxiMaxReads        (2                   ),
     .ar_chan_t          (soc_wide_ar_chan_t  ),
     .mst_r_chan_t       (soc_narrow_r_chan_t ),
@@ -432,14 +589,85 @@ module ara_soc import axi_pkg::*; import ara_pkg::*; #(
     .mst_resp_i(periph_narrow_axi_resp[CTRL])
   );
 
+  //////////////////
+  //  DMA engine  //
+  //////////////////
+
+  soc_narrow_lite_req_t  axi_lite_dma_req;
+  soc_narrow_lite_resp_t axi_lite_dma_resp;
+
+  axi_to_axi_lite #(
+    .AxiAddrWidth   (AxiAddrWidth          ),
+    .AxiDataWidth   (AxiNarrowDataWidth    ),
+    .AxiIdWidth     (AxiIdWidth            ),
+    .AxiUserWidth   (AxiUserWidth          ),
+    .AxiMaxReadTxns (1                     ),
+    .AxiMaxWriteTxns(1                     ),
+    .FallThrough    (1'b0                  ),
+    .full_req_t     (soc_narrow_req_t      ),
+    .full_resp_t    (soc_narrow_resp_t     ),
+    .lite_req_t     (soc_narrow_lite_req_t ),
+    .lite_resp_t    (soc_narrow_lite_resp_t)
+  ) i_dma_axi_to_axi_lite (
+    .clk_i     (clk_i                      ),
+    .rst_ni    (rst_ni                     ),
+    .test_i    (1'b0                       ),
+    .slv_req_i (periph_narrow_axi_req[DMA] ),
+    .slv_resp_o(periph_narrow_axi_resp[DMA]),
+    .mst_req_o (axi_lite_dma_req           ),
+    .mst_resp_i(axi_lite_dma_resp          )
+  );
+
+  axi_dw_converter #(
+    .AxiSlvPortDataWidth(AxiWideDataWidth    ),
+    .AxiMstPortDataWidth(AxiNarrowDataWidth  ),
+    .AxiAddrWidth       (AxiAddrWidth        ),
+    .AxiIdWidth         (AxiIdWidth          ),
+    .AxiMaxReads        (2                   ),
+    .ar_chan_t          (soc_wide_ar_chan_t  ),
+    .mst_r_chan_t       (soc_narrow_r_chan_t ),
+    .slv_r_chan_t       (soc_wide_r_chan_t   ),
+    .aw_chan_t          (soc_narrow_aw_chan_t),
+    .b_chan_t           (soc_narrow_b_chan_t ),
+    .mst_w_chan_t       (soc_narrow_w_chan_t ),
+    .slv_w_chan_t       (soc_wide_w_chan_t   ),
+    .axi_mst_req_t      (soc_narrow_req_t    ),
+    .axi_mst_resp_t     (soc_narrow_resp_t   ),
+    .axi_slv_req_t      (soc_wide_req_t      ),
+    .axi_slv_resp_t     (soc_wide_resp_t     )
+  ) i_axi_slave_dma_dwc (
+    .clk_i     (clk_i                      ),
+    .rst_ni    (rst_ni                     ),
+    .slv_req_i (periph_wide_axi_req[DMA]   ),
+    .slv_resp_o(periph_wide_axi_resp[DMA]  ),
+    .mst_req_o (periph_narrow_axi_req[DMA] ),
+    .mst_resp_i(periph_narrow_axi_resp[DMA])
+  );
+
+  // The copies go to the L2 through the crossbar, with the ID 0
+  ara_dma #(
+    .NrDescs        (4                     ),
+    .RegDataWidth   (AxiNarrowDataWidth    ),
+    .axi_lite_req_t (soc_narrow_lite_req_t ),
+    .axi_lite_resp_t(soc_narrow_lite_resp_t),
+    .AxiAddrWidth   (AxiAddrWidth          ),
+    .AxiDataWidth   (AxiWideDataWidth      ),
+    .axi_req_t      (system_req_t          ),
+    .axi_resp_t     (system_resp_t         )
+  ) i_dma (
+    .clk_i                (clk_i                   ),
+    .rst_ni               (rst_ni                  ),
+    .axi_lite_slave_req_i (axi_lite_dma_req        ),
+    .axi_lite_slave_resp_o(axi_lite_dma_resp       ),
+    .axi_req_o            (system_axi_req[NrCores] ),
+    .axi_resp_i           (system_axi_resp[NrCores]),
+    .busy_o               (/* Unused */            )
+  );
+
   //////////////
   //  System  //
   //////////////
 
-  logic [2:0] hart_id;
-
-  assign hart_id = '0;
-
   localparam ariane_pkg::ariane_cfg_t ArianeAraConfig = '{
     RASDepth             : 2,
     BTBEntries           : 32,
@@ -464,80 +692,107 @@ module ara_soc import axi_pkg::*; import ara_pkg::*; #(
     NrPMPEntries         : 0
   };
 
+  // The performance counters count the events of the first system
+  perf_events_t [NrCores-1:0] perf_events_sys;
+
+  assign perf_events = perf_events_sys[0];
+
+`ifdef TARGET_FPGA
+  assign perf_events_o = perf_events;
+`endif
+
+  for (genvar c = 0; c < NrCores; c++) begin: gen_systems
 `ifndef TARGET_GATESIM
-  ara_system #(
-    .NrLanes           (NrLanes              ),
-    .FPUSupport        (FPUSupport           ),
-    .FPExtSupport      (FPExtSupport         ),
-    .FixPtSupport      (FixPtSupport         ),
-    .ArianeCfg         (ArianeAraConfig      ),
-    .AxiAddrWidth      (AxiAddrWidth         ),
-    .AxiIdWidth        (AxiCoreIdWidth       ),
-    .AxiNarrowDataWidth(AxiNarrowDataWidth   ),
-    .AxiWideDataWidth  (AxiDataWidth         ),
-    .ara_axi_ar_t      (ara_axi_ar_chan_t    ),
-    .ara_axi_aw_t      (ara_axi_aw_chan_t    ),
-    .ara_axi_b_t       (ara_axi_b_chan_t     ),
-    .ara_axi_r_t       (ara_axi_r_chan_t     ),
-    .ara_axi_w_t       (ara_axi_w_chan_t     ),
-    .ara_axi_req_t     (ara_axi_req_t        ),
-    .ara_axi_resp_t    (ara_axi_resp_t       ),
-    .ariane_axi_ar_t   (ariane_axi_ar_chan_t ),
-    .ariane_axi_aw_t   (ariane_axi_aw_chan_t ),
-    .ariane_axi_b_t    (ariane_axi_b_chan_t  ),
-    .ariane_axi_r_t    (ariane_axi_r_chan_t  ),
-    .ariane_axi_w_t    (ariane_axi_w_chan_t  ),
-    .ariane_axi_req_t  (ariane_axi_req_t     ),
-    .ariane_axi_resp_t (ariane_axi_resp_t    ),
-    .system_axi_ar_t   (system_ar_chan_t     ),
-    .system_axi_aw_t   (system_aw_chan_t     ),
-    .system_axi_b_t    (system_b_chan_t      ),
-    .system_axi_r_t    (system_r_chan_t      ),
-    .system_axi_w_t    (system_w_chan_t      ),
-    .system_axi_req_t  (system_req_t         ),
-    .system_axi_resp_t (system_resp_t        ))
+    // The writes of the other systems and of the DMA engine invalidate the vector cache
+    logic ext_write;
+
+    always_comb begin: p_ext_write
+      ext_write = 1'b0;
+      for (int m = 0; m < NrAXIMasters; m++)
+        if (m != c && system_axi_req[m].aw_valid && system_axi_resp[m].aw_ready)
+          ext_write = 1'b1;
+    end: p_ext_write
+
+    ara_system #(
+      .NrLanes           (NrLanes              ),
+      .FPUSupport        (FPUSupport           ),
+      .FPExtSupport      (FPExtSupport         ),
+      .FixPtSupport      (FixPtSupport         ),
+      .ArianeCfg         (ArianeAraConfig      ),
+      .AxiAddrWidth      (AxiAddrWidth         ),
+      .AxiIdWidth        (AxiCoreIdWidth       ),
+      .AxiNarrowDataWidth(AxiNarrowDataWidth   ),
+      .AxiWideDataWidth  (AxiDataWidth         ),
+      .ara_axi_ar_t      (ara_axi_ar_chan_t    ),
+      .ara_axi_aw_t      (ara_axi_aw_chan_t    ),
+      .ara_axi_b_t       (ara_axi_b_chan_t     ),
+      .ara_axi_r_t       (ara_axi_r_chan_t     ),
+      .ara_axi_w_t       (ara_axi_w_chan_t     ),
+      .ara_axi_req_t     (ara_axi_req_t        ),
+      .ara_axi_resp_t    (ara_axi_resp_t       ),
+      .ariane_axi_ar_t   (ariane_axi_ar_chan_t ),
+      .ariane_axi_aw_t   (ariane_axi_aw_chan_t ),
+      .ariane_axi_b_t    (ariane_axi_b_chan_t  ),
+      .ariane_axi_r_t    (ariane_axi_r_chan_t  ),
+      .ariane_axi_w_t    (ariane_axi_w_chan_t  ),
+      .ariane_axi_req_t  (ariane_axi_req_t     ),
+      .ariane_axi_resp_t (ariane_axi_resp_t    ),
+      .system_axi_ar_t   (system_ar_chan_t     ),
+      .system_axi_aw_t   (system_aw_chan_t     ),
+      .system_axi_b_t    (system_b_chan_t      ),
+      .system_axi_r_t    (system_r_chan_t      ),
+      .system_axi_w_t    (system_w_chan_t      ),
+      .system_axi_req_t  (system_req_t         ),
+      .system_axi_resp_t (system_resp_t        ))
 `else
-  ara_system
+    ara_system
 `endif
-  i_system (
-    .clk_i        (clk_i                    ),
-    .rst_ni       (rst_ni                   ),
-    .boot_addr_i  (DRAMBase                 ), // start fetching from DRAM
-    .hart_id_i    (hart_id                  ),
-    .scan_enable_i(1'b0                     ),
-    .scan_data_i  (1'b0                     ),
-    .scan_data_o  (/* Unconnected */        ),
+    i_system (
+      .clk_i        (clk_i                    ),
+      .rst_ni       (rst_ni                   ),
+      .boot_addr_i  (DRAMBase                 ), // start fetching from DRAM
+      .hart_id_i    (3'(c)                    ),
+      .scan_enable_i(1'b0                     ),
+      .scan_data_i  (1'b0                     ),
+      .scan_data_o  (/* Unconnected */        ),
 `ifndef TARGET_GATESIM
-    .axi_req_o    (system_axi_req           ),
-    .axi_resp_i   (system_axi_resp          )
-  );
+      .axi_req_o    (system_axi_req[c]        ),
+      .axi_resp_i   (system_axi_resp[c]       ),
+      .ext_write_i  (ext_write                ),
+      .active_lanes_i(active_lanes            ),
+      .perf_events_o(perf_events_sys[c]       )
+    );
 `else
-    .axi_req_o    (system_axi_req_spill     ),
-    .axi_resp_i   (system_axi_resp_spill_del)
-  );
+      .axi_req_o    (system_axi_req_spill[c]     ),
+      .axi_resp_i   (system_axi_resp_spill_del[c])
+    );
+
+    // The netlist does not expose the performance events
+    assign perf_events_sys[c] = '0;
 `endif
 
 
 `ifdef TARGET_GATESIM
-  assign #(AxiRespDelay*1ps) system_axi_resp_spill_del = system_axi_resp_spill;
-
-  axi_cut #(
-    .ar_chan_t   (system_ar_chan_t     ),
-    .aw_chan_t   (system_aw_chan_t     ),
-    .b_chan_t    (system_b_chan_t      ),
-    .r_chan_t    (system_r_chan_t      ),
-    .w_chan_t    (system_w_chan_t      ),
-    .req_t       (system_req_t         ),
-    .resp_t      (system_resp_t        )
-  ) i_system_cut (
-    .clk_i       (clk_i),
-    .rst_ni      (rst_ni),
-    .slv_req_i   (system_axi_req_spill),
-    .slv_resp_o  (system_axi_resp_spill),
-    .mst_req_o   (system_axi_req),
-    .mst_resp_i  (system_axi_resp)
-  );
+    assign #(AxiRespDelay*1ps) system_axi_resp_spill_del[c] = system_axi_resp_spill[c];
+
+    axi_cut #(
+      .ar_chan_t   (system_ar_chan_t     ),
+      .aw_chan_t   (system_aw_chan_t     ),
+      .b_chan_t    (system_b_chan_t      ),
+      .r_chan_t    (system_r_chan_t      ),
+      .w_chan_t    (system_w_chan_t      ),
+      .req_t       (system_req_t         ),
+      .resp_t      (system_resp_t        )
+    ) i_system_cut (
+      .clk_i       (clk_i),
+      .rst_ni      (rst_ni),
+      .slv_req_i   (system_axi_req_spill[c]),
+      .slv_resp_o  (system_axi_resp_spill[c]),
+      .mst_req_o   (system_axi_req[c]),
+      .mst_resp_i  (system_axi_resp[c])
+    );
 `endif
+  end: gen_systems
 
   //////////////////
   //  Assertions  //
@@ -546,6 +801,9 @@ module ara_soc import axi_pkg::*; import ara_pkg::*; #(
   if (NrLanes == 0)
     $error("[ara_soc] Ara needs to have at least one lane.");
 
+  if (NrCores == 0 || NrCores > 8 || NrCores != 2**$clog2(NrCores))
+    $error("[ara_soc] The number of systems must be a power of two, up to eight.");
+
   if (AxiDataWidth == 0)
     $error("[ara_soc] The AXI data width must be greater than zero.");
 
@@ -558,4 +816,21 @@ module ara_soc import axi_pkg::*; import ara_pkg::*; #(
   if (AxiIdWidth == 0)
     $error("[ara_soc] The AXI ID width must be greater than zero.");
 
+  if (L2NumWords != 2**$clog2(L2NumWords))
+    $error("[ara_soc] The number of words of the L2 memory must be a power of two.");
+
+`ifndef TARGET_FPGA
+  if (L2NumWords * (AxiDataWidth/8) > DRAMLength)
+    $error("[ara_soc] The L2 memory does not fit in the DRAM region.");
+
+  if (L2NumBanks != 2**$clog2(L2NumBanks))
+    $error("[ara_soc] The number of banks of the L2 memory must be a power of two.");
+
+  if (L2ReadLatency == 0 || L2WriteLatency == 0)
+    $error("[ara_soc] The latencies of the L2 memory must be at least one cycle.");
+`else
+  if ($bits(dram_axi_req_t) != $bits(soc_wide_req_t) || $bits(dram_axi_resp_t) != $bits(soc_wide_resp_t))
+    $error("[ara_soc] The AXI types of the main memory port do not match the wide AXI bus.");
+`endif
+
 endmodule : ara_soc
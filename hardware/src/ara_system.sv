@@ -54,7 +54,13 @@ module ara_system import axi_pkg::*; import ara_pkg::*; #(
     output logic                    scan_data_o,
     // AXI Interface
     output system_axi_req_t         axi_req_o,
-    input  system_axi_resp_t        axi_resp_i
+    input  system_axi_resp_t        axi_resp_i,
+    // Another master of the L2 writes the memory
+    input  logic                    ext_write_i,
+    // Lanes used by the vector instructions, from the control registers
+    input  logic             [63:0] active_lanes_i,
+    // Performance events
+    output perf_events_t            perf_events_o
   );
 
   `include "axi/assign.svh"
@@ -66,8 +72,12 @@ module ara_system import axi_pkg::*; import ara_pkg::*; #(
 
   ariane_axi_req_t  ariane_narrow_axi_req;
   ariane_axi_resp_t ariane_narrow_axi_resp;
-  ara_axi_req_t     ariane_axi_req, ara_axi_req_inval, ara_axi_req;
-  ara_axi_resp_t    ariane_axi_resp, ara_axi_resp_inval, ara_axi_resp;
+  ara_axi_req_t     ariane_axi_req_dwc, ariane_axi_req, ara_axi_req_raw, ara_axi_req_inval, ara_axi_req_pf, ara_axi_req_vcache, ara_axi_req;
+  ara_axi_resp_t    ariane_axi_resp_dwc, ariane_axi_resp, ara_axi_resp_raw, ara_axi_resp_inval, ara_axi_resp_pf, ara_axi_resp_vcache, ara_axi_resp;
+
+  // Performance events
+  perf_events_t ara_perf_events;
+  logic         vcache_hit, vcache_miss, prefetch_beat, prefetch_hit;
 
   //////////////////////
   //  Ara and Ariane  //
@@ -80,18 +90,22 @@ module ara_system import axi_pkg::*; import ara_pkg::*; #(
   accelerator_req_t                     acc_req;
   logic                                 acc_req_valid;
   logic                                 acc_req_ready;
-  accelerator_resp_t                    acc_resp;
+  accelerator_resp_t                    acc_resp, ara_acc_resp;
   logic                                 acc_resp_valid;
   logic                                 acc_resp_ready;
   logic                                 acc_cons_en;
   logic              [AxiAddrWidth-1:0] inval_addr;
   logic                                 inval_valid;
   logic                                 inval_ready;
+  logic                                 inval_busy;
 
   // Support max 8 cores, for now
   logic [63:0] hart_id;
   assign hart_id = {'0, hart_id_i};
 
+  // Spike writes the DRAM through its backdoor, and not over AXI
+  logic spike_write;
+
 `ifdef IDEAL_DISPATCHER
   // Perfect dispatcher to Ara
   accel_dispatcher_ideal i_accel_dispatcher_ideal (
@@ -104,6 +118,31 @@ module ara_system import axi_pkg::*; import ara_pkg::*; #(
     .acc_resp_valid_i (acc_resp_valid        ),
     .acc_resp_ready_o (acc_resp_ready        )
   );
+  assign spike_write = 1'b0;
+`elsif SPIKE_CORE
+  // Spike as the scalar core
+  accel_dispatcher_spike #(
+    .axi_req_t (ariane_axi_req_t ),
+    .axi_resp_t(ariane_axi_resp_t)
+  ) i_spike_core (
+    .clk_i            (clk_i                 ),
+    .rst_ni           (rst_ni                ),
+    .boot_addr_i      (boot_addr_i           ),
+    .hart_id_i        (hart_id               ),
+    .acc_req_o        (acc_req               ),
+    .acc_req_valid_o  (acc_req_valid         ),
+    .acc_req_ready_i  (acc_req_ready         ),
+    .acc_resp_i       (acc_resp              ),
+    .acc_resp_valid_i (acc_resp_valid        ),
+    .acc_resp_ready_o (acc_resp_ready        ),
+    .axi_req_o        (ariane_narrow_axi_req ),
+    .axi_resp_i       (ariane_narrow_axi_resp),
+    .write_o          (spike_write           ),
+    .pc_o             (/* Unused */          )
+  );
+  // Spike has no L1 cache to keep coherent
+  assign acc_cons_en = 1'b0;
+  assign inval_ready = 1'b0;
 `else
   ariane #(
     .ArianeCfg(ArianeCfg)
@@ -130,6 +169,7 @@ module ara_system import axi_pkg::*; import ara_pkg::*; #(
     .inval_valid_i    (inval_valid           ),
     .inval_ready_o    (inval_ready           )
   );
+  assign spike_write = 1'b0;
 `endif
 
   axi_dw_converter #(
@@ -158,17 +198,60 @@ module ara_system import axi_pkg::*; import ara_pkg::*; #(
     .slv_req_i (ariane_narrow_axi_req ),
 `endif
     .slv_resp_o(ariane_narrow_axi_resp),
-    .mst_req_o (ariane_axi_req        ),
-    .mst_resp_i(ariane_axi_resp       )
+    .mst_req_o (ariane_axi_req_dwc    ),
+    .mst_resp_i(ariane_axi_resp_dwc   )
+  );
+
+  // Ara's vector cache. CVA6's writes, and the ones of the other masters, invalidate it.
+  ara_vcache #(
+    .NrLines     (VCacheSize / (AxiWideDataWidth/8)),
+    .AxiAddrWidth(AxiAddrWidth                     ),
+    .AxiDataWidth(AxiWideDataWidth                 ),
+    .axi_req_t   (ara_axi_req_t                    ),
+    .axi_resp_t  (ara_axi_resp_t                   )
+  ) i_vcache (
+    .clk_i     (clk_i                                                   ),
+    .rst_ni    (rst_ni                                                  ),
+    .slv_req_i (ara_axi_req                                             ),
+    .slv_resp_o(ara_axi_resp                                            ),
+    .mst_req_o (ara_axi_req_vcache                                      ),
+    .mst_resp_i(ara_axi_resp_vcache                                     ),
+    .inval_i   (ariane_axi_req.aw_valid && ariane_axi_resp.aw_ready || ext_write_i || spike_write),
+    .hit_o     (vcache_hit                                              ),
+    .miss_o    (vcache_miss                                             )
+  );
+
+  // Ara's stream prefetcher, which reads ahead in the cached region of CVA6
+  ara_prefetcher #(
+    .NrBeats     (PrefetchBeats                           ),
+    .MaxTxns     (4 * VaddrgenInsnQueueDepth              ),
+    .RegionBase  (ArianeCfg.CachedRegionAddrBase[0]       ),
+    .RegionLength(ArianeCfg.CachedRegionLength[0]         ),
+    .AxiAddrWidth(AxiAddrWidth                            ),
+    .AxiDataWidth(AxiWideDataWidth                        ),
+    .axi_req_t   (ara_axi_req_t                           ),
+    .axi_resp_t  (ara_axi_resp_t                          )
+  ) i_prefetcher (
+    .clk_i          (clk_i                                                   ),
+    .rst_ni         (rst_ni                                                  ),
+    .slv_req_i      (ara_axi_req_vcache                                      ),
+    .slv_resp_o     (ara_axi_resp_vcache                                     ),
+    .mst_req_o      (ara_axi_req_pf                                          ),
+    .mst_resp_i     (ara_axi_resp_pf                                         ),
+    .inval_i        (ariane_axi_req.aw_valid && ariane_axi_resp.aw_ready || ext_write_i || spike_write),
+    .prefetch_beat_o(prefetch_beat                                           ),
+    .prefetch_hit_o (prefetch_hit                                            )
   );
 
   axi_inval_filter #(
-    .MaxTxns    (4                              ),
-    .AddrWidth  (AxiAddrWidth                   ),
-    .L1LineWidth(ariane_pkg::DCACHE_LINE_WIDTH/8),
-    .aw_chan_t  (ara_axi_aw_t                   ),
-    .req_t      (ara_axi_req_t                  ),
-    .resp_t     (ara_axi_resp_t                 )
+    .MaxTxns        (4                              ),
+    // 4 MiB of 4 KiB regions, aliased over the memory
+    .NumSnoopRegions(1024                           ),
+    .AddrWidth      (AxiAddrWidth                   ),
+    .L1LineWidth    (ariane_pkg::DCACHE_LINE_WIDTH/8),
+    .aw_chan_t      (ara_axi_aw_t                   ),
+    .req_t          (ara_axi_req_t                  ),
+    .resp_t         (ara_axi_resp_t                 )
   ) i_axi_inval_filter (
     .clk_i        (clk_i             ),
     .rst_ni       (rst_ni            ),
@@ -177,19 +260,109 @@ module ara_system import axi_pkg::*; import ara_pkg::*; #(
 `else
     .en_i         (acc_cons_en       ),
 `endif
-    .slv_req_i    (ara_axi_req       ),
-    .slv_resp_o   (ara_axi_resp      ),
+    .slv_req_i    (ara_axi_req_pf    ),
+    .slv_resp_o   (ara_axi_resp_pf   ),
     .mst_req_o    (ara_axi_req_inval ),
     .mst_resp_i   (ara_axi_resp_inval),
     .inval_addr_o (inval_addr        ),
     .inval_valid_o(inval_valid       ),
+    .busy_o       (inval_busy        ),
 `ifdef IDEAL_DISPATCHER
-    .inval_ready_i(1'b0              )
+    .inval_ready_i(1'b0              ),
 `else
-    .inval_ready_i(inval_ready       )
+    .inval_ready_i(inval_ready       ),
 `endif
+    // The L1 caches only fill their lines with reads
+    .l1_ar_addr_i (ariane_axi_req.ar.addr                             ),
+    .l1_ar_valid_i(ariane_axi_req.ar_valid && ariane_axi_resp.ar_ready)
+  );
+
+  // CVA6 reads after the Ara writes that it overlaps, and writes after all of them
+  axi_raw_filter #(
+    .MaxTxns  (4 * VaddrgenInsnQueueDepth),
+    .AddrWidth(AxiAddrWidth              ),
+    .req_t    (ara_axi_req_t             ),
+    .resp_t   (ara_axi_resp_t            )
+  ) i_axi_raw_filter (
+    .clk_i         (clk_i              ),
+    .rst_ni        (rst_ni             ),
+    .trk_slv_req_i (ara_axi_req_inval  ),
+    .trk_slv_resp_o(ara_axi_resp_inval ),
+    .trk_mst_req_o (ara_axi_req_raw    ),
+    .trk_mst_resp_i(ara_axi_resp_raw   ),
+    .slv_req_i     (ariane_axi_req_dwc ),
+    .slv_resp_o    (ariane_axi_resp_dwc),
+    .mst_req_o     (ariane_axi_req     ),
+    .mst_resp_i    (ariane_axi_resp    )
   );
 
+  // Ara reports its vector stores as pending until their last W beat, since the later scalar
+  // accesses are ordered by the filters. The L1 must also be done with their invalidations.
+  always_comb begin
+    acc_resp               = ara_acc_resp;
+    acc_resp.store_pending = ara_acc_resp.store_pending | inval_busy;
+  end
+
+  // Ara's clock
+  logic ara_clk;
+
+`ifdef IDLE_CLOCK_GATE
+  // Simulation only: stop Ara's clock during the stretches in which it is idle
+  // and its interface is quiescent, so that the simulator does not evaluate
+  // the lanes. The gate closes after IdleGateDelay cycles in which Ara was idle
+  // and neither its inputs nor its outputs changed, so that its state has
+  // settled, and reopens in the same cycle in which any of them changes. The
+  // cycle counts are therefore the same as with the free-running clock.
+  localparam int unsigned IdleGateDelay = 16;
+
+  accelerator_req_t  acc_req_q;
+  logic              acc_req_ready_q;
+  accelerator_resp_t acc_resp_q;
+  logic              acc_resp_ready_q;
+  ara_axi_req_t      ara_axi_req_q;
+  ara_axi_resp_t     ara_axi_resp_q;
+  logic [$clog2(IdleGateDelay+1)-1:0] ara_quiet_cnt_q;
+  logic ara_quiet, ara_clk_en, ara_clk_en_latch;
+
+  assign ara_quiet = i_ara.ara_idle && !acc_req_valid && !acc_resp_valid &&
+    acc_req == acc_req_q && acc_req_ready == acc_req_ready_q &&
+    acc_resp == acc_resp_q && acc_resp_ready == acc_resp_ready_q &&
+    ara_axi_req == ara_axi_req_q && ara_axi_resp == ara_axi_resp_q;
+
+  always_ff @(posedge clk_i or negedge rst_ni) begin
+    if (!rst_ni) begin
+      acc_req_q        <= '0;
+      acc_req_ready_q  <= 1'b0;
+      acc_resp_q       <= '0;
+      acc_resp_ready_q <= 1'b0;
+      ara_axi_req_q    <= '0;
+      ara_axi_resp_q   <= '0;
+      ara_quiet_cnt_q  <= '0;
+    end else begin
+      acc_req_q        <= acc_req;
+      acc_req_ready_q  <= acc_req_ready;
+      acc_resp_q       <= acc_resp;
+      acc_resp_ready_q <= acc_resp_ready;
+      ara_axi_req_q    <= ara_axi_req;
+      ara_axi_resp_q   <= ara_axi_resp;
+      if (!ara_quiet)
+        ara_quiet_cnt_q <= '0;
+      else if (ara_quiet_cnt_q != IdleGateDelay)
+        ara_quiet_cnt_q <= ara_quiet_cnt_q + 1;
+    end
+  end
+
+  assign ara_clk_en = !rst_ni || !ara_quiet || ara_quiet_cnt_q != IdleGateDelay;
+
+  // Latch the enable while the clock is low, to avoid glitches
+  always_latch begin
+    if (!clk_i) ara_clk_en_latch = ara_clk_en;
+  end
+  assign ara_clk = clk_i & ara_clk_en_latch;
+`else
+  assign ara_clk = clk_i;
+`endif
+
   ara #(
     .NrLanes     (NrLanes         ),
     .FPUSupport  (FPUSupport      ),
@@ -205,7 +378,7 @@ module ara_system import axi_pkg::*; import ara_pkg::*; #(
     .axi_req_t   (ara_axi_req_t   ),
     .axi_resp_t  (ara_axi_resp_t  )
   ) i_ara (
-    .clk_i           (clk_i         ),
+    .clk_i           (ara_clk       ),
     .rst_ni          (rst_ni        ),
     .scan_enable_i   (scan_enable_i ),
     .scan_data_i     (1'b0          ),
@@ -213,13 +386,32 @@ module ara_system import axi_pkg::*; import ara_pkg::*; #(
     .acc_req_i       (acc_req       ),
     .acc_req_valid_i (acc_req_valid ),
     .acc_req_ready_o (acc_req_ready ),
-    .acc_resp_o      (acc_resp      ),
+    .acc_resp_o      (ara_acc_resp  ),
     .acc_resp_valid_o(acc_resp_valid),
     .acc_resp_ready_i(acc_resp_ready),
     .axi_req_o       (ara_axi_req   ),
-    .axi_resp_i      (ara_axi_resp  )
+    .axi_resp_i      (ara_axi_resp  ),
+    // This CVA6 does not expose its MMU to the accelerator: Ara uses physical addresses
+    .en_ld_st_translation_i(1'b0        ),
+    .flush_tlb_i           (1'b0        ),
+    .mmu_req_o             (/* Unused */),
+    .mmu_vaddr_o           (/* Unused */),
+    .mmu_is_store_o        (/* Unused */),
+    .mmu_valid_i           (1'b0        ),
+    .mmu_paddr_i           ('0          ),
+    .mmu_exception_i       (1'b0        ),
+    .active_lanes_i        (active_lanes_i),
+    .perf_events_o   (ara_perf_events)
   );
 
+  always_comb begin: p_perf_events
+    perf_events_o               = ara_perf_events;
+    perf_events_o.vcache_hit    = vcache_hit;
+    perf_events_o.vcache_miss   = vcache_miss;
+    perf_events_o.prefetch_beat = prefetch_beat;
+    perf_events_o.prefetch_hit  = prefetch_hit;
+  end: p_perf_events
+
   axi_mux #(
     .SlvAxiIDWidth(AxiIdWidth       ),
     .slv_ar_chan_t(ara_axi_ar_t     ),
@@ -245,8 +437,8 @@ module ara_system import axi_pkg::*; import ara_pkg::*; #(
     .clk_i      (clk_i                                ),
     .rst_ni     (rst_ni                               ),
     .test_i     (1'b0                                 ),
-    .slv_reqs_i ({ara_axi_req_inval, ariane_axi_req}  ),
-    .slv_resps_o({ara_axi_resp_inval, ariane_axi_resp}),
+    .slv_reqs_i ({ara_axi_req_raw, ariane_axi_req}  ),
+    .slv_resps_o({ara_axi_resp_raw, ariane_axi_resp}),
     .mst_req_o  (axi_req_o                            ),
     .mst_resp_i (axi_resp_i                           )
   );
@@ -0,0 +1,345 @@
+// Copyright 2021 ETH Zurich and University of Bologna.
+// Solderpad Hardware License, Version 0.51, see LICENSE for details.
+// SPDX-License-Identifier: SHL-0.51
+//
+// Description:
+// Ara's vector cache, a direct-mapped read cache between Ara and the L2. Its
+// lines are as wide as the AXI data bus, so that each beat of a unit-stride
+// burst is a line.
+//
+// The read bursts are looked up one beat after the other. The hits are answered
+// from the cache, until the first miss: the rest of the burst is requested to
+// the L2 as a single burst, and its full-width beats fill the lines. The R beats
+// go back to Ara in the order of the bursts.
+//
+// The writes of Ara are passed through without allocating lines: their W beats
+// update the lines that they hit. The writes of the other masters (CVA6, the
+// DMA engine, the other cores) invalidate the whole cache, through inval_i, and
+// the fills of the reads in flight at that moment are dropped. The atomic
+// operations of Ara drop the line they hit.
+
+module ara_vcache #(
+    // Lines of the cache (a power of two), 0 to pass everything through
+    parameter int  unsigned NrLines      = 32'd0,
+    // Read bursts answered, but not yet sent back to Ara
+    parameter int  unsigned NrBeats      = 32'd4,
+    // AXI Bus Types
+    parameter int  unsigned AxiAddrWidth = 32'd0,
+    parameter int  unsigned AxiDataWidth = 32'd0,
+    parameter type          axi_req_t    = logic,
+    parameter type          axi_resp_t   = logic
+  ) (
+    input  logic      clk_i,
+    input  logic      rst_ni,
+    // Interface with Ara
+    input  axi_req_t  slv_req_i,
+    output axi_resp_t slv_resp_o,
+    // Interface with the L2
+    output axi_req_t  mst_req_o,
+    input  axi_resp_t mst_resp_i,
+    // Another master writes the memory
+    input  logic      inval_i,
+    // Performance events: an R beat hits, or misses, the cache
+    output logic      hit_o,
+    output logic      miss_o
+  );
+
+  import cf_math_pkg::idx_width;
+
+  `include "common_cells/registers.svh"
+
+  if (NrLines == 0) begin: gen_no_cache
+    assign mst_req_o  = slv_req_i;
+    assign slv_resp_o = mst_resp_i;
+    assign hit_o      = 1'b0;
+    assign miss_o     = 1'b0;
+  end: gen_no_cache else begin: gen_cache
+    localparam int unsigned LineBytes = AxiDataWidth / 8;
+    localparam int unsigned OffsetW   = $clog2(LineBytes);
+    localparam int unsigned IndexW    = $clog2(NrLines);
+
+    typedef logic [AxiAddrWidth-1:0]                 addr_t;
+    typedef logic [AxiDataWidth-1:0]                 data_t;
+    typedef logic [LineBytes-1:0]                    strb_t;
+    typedef logic [IndexW-1:0]                       index_t;
+    typedef logic [AxiAddrWidth-OffsetW-IndexW-1:0]  tag_t;
+    typedef logic [$bits(slv_req_i.ar.id)-1:0]       id_t;
+
+    function automatic index_t line_index(addr_t addr);
+      line_index = index_t'(addr >> OffsetW);
+    endfunction : line_index
+
+    function automatic tag_t line_tag(addr_t addr);
+      line_tag = tag_t'(addr >> (OffsetW + IndexW));
+    endfunction : line_tag
+
+    // Address of the beat of an INCR burst
+    function automatic addr_t beat_addr(addr_t addr, axi_pkg::size_t size, axi_pkg::len_t beat);
+      beat_addr = beat == '0 ? addr :
+        (addr & ~((addr_t'(1) << size) - 1)) + (addr_t'(beat) << size);
+    endfunction : beat_addr
+
+    /////////////
+    //  Lines  //
+    /////////////
+
+    data_t [NrLines-1:0] line_data_d, line_data_q;
+    tag_t  [NrLines-1:0] line_tag_d, line_tag_q;
+    logic  [NrLines-1:0] line_valid_d, line_valid_q;
+
+    `FF(line_data_q, line_data_d, '0)
+    `FF(line_tag_q, line_tag_d, '0)
+    `FF(line_valid_q, line_valid_d, '0)
+
+    ///////////////////
+    //  Beat queue  //
+    ///////////////////
+
+    // The R beats to send back to Ara, in order. A hit holds the data of its beat. A miss stands
+    // for all the beats of the burst requested to the L2, whose R beats it forwards.
+    typedef struct packed {
+      logic  hit;
+      data_t data;
+      logic  last;
+      id_t   id;
+      // For the misses: the address of the first beat, and whether their beats fill the cache
+      addr_t addr;
+      axi_pkg::size_t size;
+      logic  fill;
+    } beat_t;
+
+    beat_t [NrBeats-1:0]        beat_d, beat_q;
+    logic [idx_width(NrBeats)-1:0] beat_wr_pnt_d, beat_wr_pnt_q, beat_rd_pnt_d, beat_rd_pnt_q;
+    logic [idx_width(NrBeats):0]   beat_cnt_d, beat_cnt_q;
+    // Beats of the miss at the head of the queue already forwarded
+    axi_pkg::len_t                 fill_beat_d, fill_beat_q;
+
+    `FF(beat_q, beat_d, '0)
+    `FF(beat_wr_pnt_q, beat_wr_pnt_d, '0)
+    `FF(beat_rd_pnt_q, beat_rd_pnt_d, '0)
+    `FF(beat_cnt_q, beat_cnt_d, '0)
+    `FF(fill_beat_q, fill_beat_d, '0)
+
+    ///////////////////////
+    //  Burst lookup  //
+    ///////////////////////
+
+    // Read burst being looked up, and its next beat
+    logic          ar_valid_d, ar_valid_q;
+    logic [$bits(slv_req_i.ar)-1:0] ar_d, ar_q;
+    axi_pkg::len_t ar_beat_d, ar_beat_q;
+
+    `FF(ar_valid_q, ar_valid_d, 1'b0)
+    `FF(ar_q, ar_d, '0)
+    `FF(ar_beat_q, ar_beat_d, '0)
+
+    ////////////////////
+    //  Write bursts  //
+    ////////////////////
+
+    // Ara's write bursts whose W beats update the cache
+    typedef struct packed {
+      addr_t          addr;
+      axi_pkg::size_t size;
+      // Atomic operation, whose result is only known by the memory
+      logic           atomic;
+    } aw_t;
+
+    localparam int unsigned NrWrites = 4;
+
+    aw_t [NrWrites-1:0]             aw_d, aw_q;
+    logic [idx_width(NrWrites)-1:0] aw_wr_pnt_d, aw_wr_pnt_q, aw_rd_pnt_d, aw_rd_pnt_q;
+    logic [idx_width(NrWrites):0]   aw_cnt_d, aw_cnt_q;
+    axi_pkg::len_t                  w_beat_d, w_beat_q;
+
+    `FF(aw_q, aw_d, '0)
+    `FF(aw_wr_pnt_q, aw_wr_pnt_d, '0)
+    `FF(aw_rd_pnt_q, aw_rd_pnt_d, '0)
+    `FF(aw_cnt_q, aw_cnt_d, '0)
+    `FF(w_beat_q, w_beat_d, '0)
+
+    always_comb begin: p_vcache
+      automatic beat_t head = beat_q[beat_rd_pnt_q];
+
+      line_data_d  = line_data_q;
+      line_tag_d   = line_tag_q;
+      line_valid_d = line_valid_q;
+      beat_d       = beat_q;
+      beat_wr_pnt_d = beat_wr_pnt_q;
+      beat_rd_pnt_d = beat_rd_pnt_q;
+      beat_cnt_d    = beat_cnt_q;
+      fill_beat_d   = fill_beat_q;
+      ar_valid_d    = ar_valid_q;
+      ar_d          = ar_q;
+      ar_beat_d     = ar_beat_q;
+      aw_d          = aw_q;
+      aw_wr_pnt_d   = aw_wr_pnt_q;
+      aw_rd_pnt_d   = aw_rd_pnt_q;
+      aw_cnt_d      = aw_cnt_q;
+      w_beat_d      = w_beat_q;
+
+      hit_o  = 1'b0;
+      miss_o = 1'b0;
+
+      // The write channels go straight to the L2
+      mst_req_o          = slv_req_i;
+      mst_req_o.ar_valid = 1'b0;
+      mst_req_o.r_ready  = 1'b0;
+      slv_resp_o         = mst_resp_i;
+      slv_resp_o.ar_ready = 1'b0;
+      slv_resp_o.r_valid  = 1'b0;
+
+      //////////////////
+      //  R channel  //
+      //////////////////
+
+      if (beat_cnt_q != '0) begin
+        if (head.hit) begin
+          // Answer from the cache
+          slv_resp_o.r_valid = 1'b1;
+          slv_resp_o.r.id    = head.id;
+          slv_resp_o.r.data  = head.data;
+          slv_resp_o.r.resp  = axi_pkg::RESP_OKAY;
+          slv_resp_o.r.last  = head.last;
+          if (slv_req_i.r_ready) begin
+            hit_o         = 1'b1;
+            beat_cnt_d    = beat_cnt_d - 1;
+            beat_rd_pnt_d = beat_rd_pnt_q == NrBeats-1 ? '0 : beat_rd_pnt_q + 1;
+          end
+        end else begin
+          // Forward the beats from the L2, and fill the cache with them
+          slv_resp_o.r_valid = mst_resp_i.r_valid;
+          mst_req_o.r_ready  = slv_req_i.r_ready;
+          if (mst_resp_i.r_valid && slv_req_i.r_ready) begin
+            automatic addr_t addr = beat_addr(head.addr, head.size, fill_beat_q);
+
+            miss_o = 1'b1;
+            if (head.fill && mst_resp_i.r.resp == axi_pkg::RESP_OKAY) begin
+              line_data_d[line_index(addr)]  = mst_resp_i.r.data;
+              line_tag_d[line_index(addr)]   = line_tag(addr);
+              line_valid_d[line_index(addr)] = 1'b1;
+            end
+
+            fill_beat_d = fill_beat_q + 1;
+            if (mst_resp_i.r.last) begin
+              fill_beat_d   = '0;
+              beat_cnt_d    = beat_cnt_d - 1;
+              beat_rd_pnt_d = beat_rd_pnt_q == NrBeats-1 ? '0 : beat_rd_pnt_q + 1;
+            end
+          end
+        end
+      end
+
+      ///////////////////
+      //  AR channel  //
+      ///////////////////
+
+      // Accept a new read burst
+      if (!ar_valid_q) begin
+        slv_resp_o.ar_ready = 1'b1;
+        if (slv_req_i.ar_valid) begin
+          ar_valid_d = 1'b1;
+          ar_d       = slv_req_i.ar;
+          ar_beat_d  = '0;
+        end
+      end else if (beat_cnt_q != NrBeats) begin
+        automatic axi_req_t ar_req = '0;
+        automatic addr_t    addr;
+        // Only the full-width beats of INCR bursts are cached, or the single beats
+        automatic logic     cached;
+
+        ar_req.ar = ar_q;
+        addr      = beat_addr(ar_req.ar.addr, ar_req.ar.size, ar_beat_q);
+        cached    = ar_req.ar.burst == axi_pkg::BURST_INCR &&
+                    (ar_req.ar.size == OffsetW || ar_req.ar.len == '0);
+
+        if (cached && line_valid_q[line_index(addr)] &&
+            line_tag_q[line_index(addr)] == line_tag(addr)) begin
+          // Hit
+          beat_d[beat_wr_pnt_q] = '{
+            hit    : 1'b1,
+            data   : line_data_q[line_index(addr)],
+            last   : ar_beat_q == ar_req.ar.len,
+            id     : ar_req.ar.id,
+            default: '0
+          };
+          beat_wr_pnt_d = beat_wr_pnt_q == NrBeats-1 ? '0 : beat_wr_pnt_q + 1;
+          beat_cnt_d    = beat_cnt_d + 1;
+          ar_beat_d     = ar_beat_q + 1;
+          if (ar_beat_q == ar_req.ar.len) ar_valid_d = 1'b0;
+        end else begin
+          // Miss: request the rest of the burst
+          mst_req_o.ar_valid = 1'b1;
+          mst_req_o.ar       = ar_req.ar;
+          mst_req_o.ar.addr  = addr;
+          mst_req_o.ar.len   = ar_req.ar.len - ar_beat_q;
+          if (mst_resp_i.ar_ready) begin
+            beat_d[beat_wr_pnt_q] = '{
+              hit    : 1'b0,
+              id     : ar_req.ar.id,
+              addr   : addr,
+              size   : ar_req.ar.size,
+              fill   : ar_req.ar.size == OffsetW,
+              default: '0
+            };
+            beat_wr_pnt_d = beat_wr_pnt_q == NrBeats-1 ? '0 : beat_wr_pnt_q + 1;
+            beat_cnt_d    = beat_cnt_d + 1;
+            ar_valid_d    = 1'b0;
+          end
+        end
+      end
+
+      /////////////////////////
+      //  AW and W channels  //
+      /////////////////////////
+
+      // Track the write bursts, to know the addresses of their W beats
+      if (aw_cnt_q == NrWrites) begin
+        mst_req_o.aw_valid  = 1'b0;
+        slv_resp_o.aw_ready = 1'b0;
+      end else if (slv_req_i.aw_valid && mst_resp_i.aw_ready) begin
+        aw_d[aw_wr_pnt_q] = '{
+          addr  : slv_req_i.aw.addr,
+          size  : slv_req_i.aw.size,
+          atomic: slv_req_i.aw.atop != '0
+        };
+        aw_wr_pnt_d       = aw_wr_pnt_q == NrWrites-1 ? '0 : aw_wr_pnt_q + 1;
+        aw_cnt_d          = aw_cnt_d + 1;
+      end
+
+      // Update the lines that the W beats hit
+      if (slv_req_i.w_valid && mst_resp_i.w_ready) begin
+        if (aw_cnt_q == '0) begin
+          // The W beat came before its AW: drop the lines, to be safe
+          line_valid_d = '0;
+        end else begin
+          automatic addr_t addr = beat_addr(aw_q[aw_rd_pnt_q].addr, aw_q[aw_rd_pnt_q].size,
+            w_beat_q);
+
+          if (line_valid_q[line_index(addr)] && line_tag_q[line_index(addr)] == line_tag(addr))
+            if (aw_q[aw_rd_pnt_q].atomic) line_valid_d[line_index(addr)] = 1'b0;
+            else for (int b = 0; b < LineBytes; b++)
+              if (slv_req_i.w.strb[b])
+                line_data_d[line_index(addr)][8*b +: 8] = slv_req_i.w.data[8*b +: 8];
+
+          w_beat_d = w_beat_q + 1;
+          if (slv_req_i.w.last) begin
+            w_beat_d    = '0;
+            aw_rd_pnt_d = aw_rd_pnt_q == NrWrites-1 ? '0 : aw_rd_pnt_q + 1;
+            aw_cnt_d    = aw_cnt_d - 1;
+          end
+        end
+      end
+
+      // Another master wrote the memory: drop all the lines, and the fills in flight
+      if (inval_i) begin
+        line_valid_d = '0;
+        for (int b = 0; b < NrBeats; b++) beat_d[b].fill = 1'b0;
+      end
+    end: p_vcache
+
+    if (2**IndexW != NrLines)
+      $error("[ara_vcache] The number of lines must be a power of two.");
+  end: gen_cache
+
+endmodule : ara_vcache
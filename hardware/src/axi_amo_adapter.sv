@@ -0,0 +1,281 @@
+// Copyright 2021 ETH Zurich and University of Bologna.
+// Solderpad Hardware License, Version 0.51, see LICENSE for details.
+// SPDX-License-Identifier: SHL-0.51
+//
+// Description:
+// Executes the AXI atomic operations (ATOPs) in front of a memory that does
+// not support them, e.g., the L2 memory. An atomic operation waits for all the
+// transactions in flight, and is then executed as a read of its element,
+// followed by a write of the result, without any other transaction in between.
+// The atomic loads and swaps return the old value on the R channel.
+//
+// The AtomicStore, AtomicLoad, and AtomicSwap operations of a single little-
+// endian beat of up to 64 bits are supported. The other ones, AtomicCompare
+// included, are answered with SLVERR. The W beats that come before their AW are
+// held until the AW arrives. The other channels are passed through.
+
+module axi_amo_adapter #(
+    // Maximum number of transactions in flight on each channel
+    parameter int  unsigned MaxTxns      = 32'd0,
+    // AXI Bus Types
+    parameter int  unsigned AxiDataWidth = 32'd0,
+    parameter type          req_t        = logic,
+    parameter type          resp_t       = logic
+  ) (
+    input  logic  clk_i,
+    input  logic  rst_ni,
+    // Input / Slave Port
+    input  req_t  slv_req_i,
+    output resp_t slv_resp_o,
+    // Output / Master Port
+    output req_t  mst_req_o,
+    input  resp_t mst_resp_i
+  );
+
+  import cf_math_pkg::idx_width;
+  import axi_pkg::*;
+
+  `include "common_cells/registers.svh"
+
+  typedef logic [AxiDataWidth-1:0]   data_t;
+  typedef logic [AxiDataWidth/8-1:0] strb_t;
+  typedef logic [$bits(slv_req_i.aw)-1:0] aw_t;
+
+  // New value of the element of an atomic operation, from the zero-extended old value and operand
+  function automatic logic [63:0] amo_result(atop_t atop, logic [63:0] mem, logic [63:0] op,
+      size_t size);
+    automatic logic [63:0] sign = 64'h1 << ((8 << size) - 1);
+    // Flip the sign bits, to compare the signed values as unsigned ones
+    automatic logic [63:0] mem_s = mem ^ sign;
+    automatic logic [63:0] op_s  = op ^ sign;
+
+    if (atop == ATOP_ATOMICSWAP)
+      amo_result = op;
+    else unique case (atop[2:0])
+      ATOP_ADD : amo_result = mem + op;
+      ATOP_CLR : amo_result = mem & ~op;
+      ATOP_EOR : amo_result = mem ^ op;
+      ATOP_SET : amo_result = mem | op;
+      ATOP_SMAX: amo_result = mem_s > op_s ? mem : op;
+      ATOP_SMIN: amo_result = mem_s < op_s ? mem : op;
+      ATOP_UMAX: amo_result = mem > op ? mem : op;
+      default  : amo_result = mem < op ? mem : op; // ATOP_UMIN
+    endcase
+  endfunction : amo_result
+
+  ////////////////////////////////
+  //  Transactions in flight  //
+  ////////////////////////////////
+
+  // Forwarded write bursts without their last W beat, without their B, and read bursts
+  logic [idx_width(MaxTxns+1)-1:0] w_pend_d, w_pend_q, b_pend_d, b_pend_q, r_pend_d, r_pend_q;
+
+  `FF(w_pend_q, w_pend_d, '0)
+  `FF(b_pend_q, b_pend_d, '0)
+  `FF(r_pend_q, r_pend_d, '0)
+
+  //////////////////////////
+  //  Atomic operations  //
+  //////////////////////////
+
+  enum logic [2:0] {
+    PASS, DRAIN, AMO_AW, AMO_W, AMO_READ, AMO_WRITE, AMO_B, AMO_RESP
+  } state_d, state_q;
+
+  aw_t   aw_d, aw_q;
+  data_t wdata_d, wdata_q, rdata_d, rdata_q;
+  strb_t wstrb_d, wstrb_q;
+  logic  error_d, error_q;
+  // Handshakes done in the current state
+  logic  done_a_d, done_a_q, done_b_d, done_b_q;
+
+  `FF(state_q, state_d, PASS)
+  `FF(aw_q, aw_d, '0)
+  `FF(wdata_q, wdata_d, '0)
+  `FF(rdata_q, rdata_d, '0)
+  `FF(wstrb_q, wstrb_d, '0)
+  `FF(error_q, error_d, 1'b0)
+  `FF(done_a_q, done_a_d, 1'b0)
+  `FF(done_b_q, done_b_d, 1'b0)
+
+  always_comb begin: p_amo
+    automatic req_t amo = '0;
+
+    state_d  = state_q;
+    aw_d     = aw_q;
+    wdata_d  = wdata_q;
+    rdata_d  = rdata_q;
+    wstrb_d  = wstrb_q;
+    error_d  = error_q;
+    done_a_d = done_a_q;
+    done_b_d = done_b_q;
+    w_pend_d = w_pend_q;
+    b_pend_d = b_pend_q;
+    r_pend_d = r_pend_q;
+
+    amo.aw = aw_q;
+
+    // Pass everything through by default
+    mst_req_o  = slv_req_i;
+    slv_resp_o = mst_resp_i;
+
+    // New bursts only pass without an atomic operation
+    if (state_q != PASS || (slv_req_i.aw_valid && slv_req_i.aw.atop != '0) ||
+        w_pend_q == MaxTxns || b_pend_q == MaxTxns) begin
+      mst_req_o.aw_valid  = 1'b0;
+      slv_resp_o.aw_ready = 1'b0;
+    end
+    if (state_q != PASS || (slv_req_i.aw_valid && slv_req_i.aw.atop != '0) ||
+        r_pend_q == MaxTxns) begin
+      mst_req_o.ar_valid  = 1'b0;
+      slv_resp_o.ar_ready = 1'b0;
+    end
+    // The W beats pass after their AW
+    if (w_pend_q == '0 && !(mst_req_o.aw_valid && mst_resp_i.aw_ready)) begin
+      mst_req_o.w_valid  = 1'b0;
+      slv_resp_o.w_ready = 1'b0;
+    end
+
+    // Count the transactions in flight
+    if (mst_req_o.aw_valid && mst_resp_i.aw_ready) begin
+      w_pend_d += 1;
+      b_pend_d += 1;
+    end
+    if (mst_req_o.w_valid && mst_resp_i.w_ready && slv_req_i.w.last) w_pend_d -= 1;
+    if (mst_req_o.ar_valid && mst_resp_i.ar_ready) r_pend_d += 1;
+    if (mst_resp_i.b_valid && slv_req_i.b_ready && b_pend_q != '0) b_pend_d -= 1;
+    if (mst_resp_i.r_valid && slv_req_i.r_ready && mst_resp_i.r.last && r_pend_q != '0)
+      r_pend_d -= 1;
+
+    unique case (state_q)
+      PASS: if (slv_req_i.aw_valid && slv_req_i.aw.atop != '0) state_d = DRAIN;
+
+      DRAIN: if (w_pend_q == '0 && b_pend_q == '0 && r_pend_q == '0) state_d = AMO_AW;
+
+      // Take the atomic operation
+      AMO_AW: begin
+        slv_resp_o.aw_ready = 1'b1;
+        if (slv_req_i.aw_valid) begin
+          aw_d    = slv_req_i.aw;
+          amo.aw  = slv_req_i.aw;
+          error_d = !(amo.aw.atop == ATOP_ATOMICSWAP ||
+                      (amo.aw.atop[5:4] inside {ATOP_ATOMICSTORE, ATOP_ATOMICLOAD} &&
+                       amo.aw.atop[3] == ATOP_LITTLE_END)) ||
+                    amo.aw.len != '0 || amo.aw.size > 3 || (8 << amo.aw.size) > AxiDataWidth;
+          state_d = AMO_W;
+        end
+      end
+
+      AMO_W: begin
+        slv_resp_o.w_ready = 1'b1;
+        if (slv_req_i.w_valid) begin
+          wdata_d = slv_req_i.w.data;
+          wstrb_d = slv_req_i.w.strb;
+          // A longer burst is discarded
+          if (slv_req_i.w.last) begin
+            state_d  = error_q ? AMO_RESP : AMO_READ;
+            done_a_d = 1'b0;
+            done_b_d = 1'b0;
+          end
+        end
+      end
+
+      // Read the old value
+      AMO_READ: begin
+        mst_req_o.ar_valid = !done_a_q;
+        mst_req_o.ar       = '{
+          id     : amo.aw.id,
+          addr   : amo.aw.addr,
+          len    : '0,
+          size   : amo.aw.size,
+          burst  : BURST_INCR,
+          cache  : amo.aw.cache,
+          prot   : amo.aw.prot,
+          default: '0
+        };
+        mst_req_o.r_ready  = done_a_q;
+        slv_resp_o.r_valid = 1'b0;
+        if (mst_resp_i.ar_ready) done_a_d = 1'b1;
+        if (done_a_q && mst_resp_i.r_valid) begin
+          automatic int unsigned off = amo.aw.addr[$clog2(AxiDataWidth/8)-1:0] >> amo.aw.size
+            << amo.aw.size;
+          automatic logic [63:0] mask = amo.aw.size == 3 ? '1 : (64'h1 << (8 << amo.aw.size)) - 1;
+          automatic logic [63:0] mem  = 64'(mst_resp_i.r.data >> (8*off)) & mask;
+          automatic logic [63:0] op   = 64'(wdata_q >> (8*off)) & mask;
+          automatic logic [63:0] res  = amo_result(amo.aw.atop, mem, op, amo.aw.size);
+
+          rdata_d = mst_resp_i.r.data;
+          error_d = mst_resp_i.r.resp != RESP_OKAY;
+          // Write the result back in the old beat
+          wdata_d = mst_resp_i.r.data;
+          for (int b = 0; b < AxiDataWidth/8; b++)
+            if (b >= off && b < off + (1 << amo.aw.size)) wdata_d[8*b +: 8] = res[8*(b-off) +: 8];
+          state_d  = error_d ? AMO_RESP : AMO_WRITE;
+          done_a_d = 1'b0;
+        end
+      end
+
+      // Write the new value
+      AMO_WRITE: begin
+        mst_req_o.aw_valid = !done_a_q;
+        mst_req_o.aw       = aw_q;
+        mst_req_o.aw.atop  = '0;
+        mst_req_o.w_valid  = !done_b_q;
+        mst_req_o.w        = '{data: wdata_q, strb: wstrb_q, last: 1'b1, default: '0};
+        slv_resp_o.w_ready = 1'b0;
+        if (mst_resp_i.aw_ready) done_a_d = 1'b1;
+        if (mst_resp_i.w_ready) done_b_d = 1'b1;
+        if (done_a_d && done_b_d) begin
+          state_d  = AMO_B;
+          done_a_d = 1'b0;
+          done_b_d = 1'b0;
+        end
+      end
+
+      AMO_B: begin
+        mst_req_o.b_ready  = 1'b1;
+        slv_resp_o.b_valid = 1'b0;
+        if (mst_resp_i.b_valid) begin
+          error_d = mst_resp_i.b.resp != RESP_OKAY;
+          state_d = AMO_RESP;
+        end
+      end
+
+      // Answer on B, and with the old value on R for the atomic loads and swaps
+      AMO_RESP: begin
+        mst_req_o.b_ready  = 1'b0;
+        mst_req_o.r_ready  = 1'b0;
+        slv_resp_o.b_valid = !done_a_q;
+        slv_resp_o.b       = '{id: amo.aw.id, resp: error_q ? RESP_SLVERR : RESP_OKAY, default: '0};
+        slv_resp_o.r_valid = !done_b_q && amo.aw.atop[5];
+        slv_resp_o.r       = '{
+          id     : amo.aw.id,
+          data   : rdata_q,
+          resp   : error_q ? RESP_SLVERR : RESP_OKAY,
+          last   : 1'b1,
+          default: '0
+        };
+        if (slv_req_i.b_ready) done_a_d = 1'b1;
+        if (slv_req_i.r_ready || !amo.aw.atop[5]) done_b_d = 1'b1;
+        if (done_a_d && done_b_d) begin
+          state_d  = PASS;
+          done_a_d = 1'b0;
+          done_b_d = 1'b0;
+        end
+      end
+
+      default:;
+    endcase
+
+    // No B or R beat of the memory is answered with an atomic operation in flight
+    if (!(state_q inside {PASS, DRAIN})) begin
+      if (state_q != AMO_READ) mst_req_o.r_ready = 1'b0;
+      if (state_q != AMO_B)    mst_req_o.b_ready = 1'b0;
+      if (state_q != AMO_RESP) begin
+        slv_resp_o.b_valid = 1'b0;
+        slv_resp_o.r_valid = 1'b0;
+      end
+    end
+  end: p_amo
+
+endmodule : axi_amo_adapter
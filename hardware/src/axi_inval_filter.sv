@@ -6,20 +6,28 @@
 // Description:
 // Listens to AXI4 AW channel and issue single cacheline invalidations.
 // All other channels are passed through.
+// A snoop filter skips the bursts that write to 4 KiB regions from which the
+// L1 never read, i.e., which it cannot cache. The regions are tracked by a
+// presence bit each, indexed by the low bits of the page number, and set on
+// the read requests of the L1.
 
 module axi_inval_filter #(
     // Maximum number of AXI write bursts outstanding at the same time
-    parameter int  unsigned MaxTxns     = 32'd0,
+    parameter int  unsigned MaxTxns         = 32'd0,
+    // Presence bits of the snoop filter. With 0, all the bursts are invalidated.
+    parameter int  unsigned NumSnoopRegions = 32'd0,
     // AXI Bus Types
-    parameter int  unsigned AddrWidth   = 32'd0,
-    parameter int  unsigned L1LineWidth = 32'd0,
-    parameter type          aw_chan_t   = logic,
-    parameter type          req_t       = logic,
-    parameter type          resp_t      = logic
+    parameter int  unsigned AddrWidth       = 32'd0,
+    parameter int  unsigned L1LineWidth     = 32'd0,
+    parameter type          aw_chan_t       = logic,
+    parameter type          req_t           = logic,
+    parameter type          resp_t          = logic
   ) (
     input logic clk_i,
     input logic rst_ni,
     input logic en_i,
+    // Invalidations are pending
+    output logic busy_o,
 
     // Input / Slave Port
     input  req_t  slv_req_i,
@@ -32,7 +40,11 @@ module axi_inval_filter #(
     // Output / Cache invalidation requests
     output logic [AddrWidth-1:0] inval_addr_o,
     output logic                 inval_valid_o,
-    input  logic                 inval_ready_i
+    input  logic                 inval_ready_i,
+
+    // Input / Read requests of the L1, accepted by the memory
+    input  logic [AddrWidth-1:0] l1_ar_addr_i,
+    input  logic                 l1_ar_valid_i
   );
 
   import cf_math_pkg::idx_width;
@@ -46,13 +58,41 @@ module axi_inval_filter #(
   logic     aw_fifo_push, aw_fifo_pop;
   aw_chan_t aw_fifo_data;
 
-  assign aw_fifo_push = en_i & slv_req_i.aw_valid & slv_resp_o.aw_ready;
+  // Can the L1 cache the lines written by the incoming AW?
+  logic aw_in_l1;
+
+  assign aw_fifo_push = en_i & slv_req_i.aw_valid & slv_resp_o.aw_ready & aw_in_l1;
+
+  ////////////////////
+  //  Snoop filter  //
+  ////////////////////
+
+  // The bursts do not cross 4 KiB, so each of them writes to a single region
+  localparam int unsigned RegionOffset = 12;
+
+  if (NumSnoopRegions != 0) begin: gen_snoop_filter
+    logic [NumSnoopRegions-1:0] l1_present_d, l1_present_q;
+
+    always_comb begin
+      l1_present_d = l1_present_q;
+      if (l1_ar_valid_i)
+        l1_present_d[l1_ar_addr_i[RegionOffset +: $clog2(NumSnoopRegions)]] = 1'b1;
+    end
+
+    // Also check the read request of this cycle
+    assign aw_in_l1 = l1_present_d[slv_req_i.aw.addr[RegionOffset +: $clog2(NumSnoopRegions)]];
+
+    `FF(l1_present_q, l1_present_d, '0)
+  end: gen_snoop_filter else begin: gen_no_snoop_filter
+    assign aw_in_l1 = 1'b1;
+  end: gen_no_snoop_filter
 
   // Invalidation requests
   logic [AddrWidth-1:0] inval_offset_d, inval_offset_q;
 
   assign inval_addr_o  = aw_fifo_data.addr + inval_offset_q;
   assign inval_valid_o = ~aw_fifo_empty;
+  assign busy_o        = ~aw_fifo_empty;
 
   //////////////////
   // AXI Handling //
@@ -145,4 +185,7 @@ module axi_inval_filter #(
     .pop_i      ( aw_fifo_pop   )
   );
 
+  if (NumSnoopRegions != 0 && NumSnoopRegions != 2**$clog2(NumSnoopRegions))
+    $error("[axi_inval_filter] The number of regions of the snoop filter must be a power of two.");
+
 endmodule : axi_inval_filter
@@ -0,0 +1,150 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+// Solderpad Hardware License, Version 0.51, see LICENSE for details.
+// SPDX-License-Identifier: SHL-0.51
+//
+// Description:
+// Orders the requests of a master (CVA6) after the write bursts in flight of
+// another one (Ara). The address ranges of the write bursts are tracked from
+// their AW to their B. A read of the filtered master waits only for the bursts
+// that it overlaps, while its writes wait for all of them, so that their order
+// is kept also outside of the memory. All the other channels are passed through.
+
+module axi_raw_filter #(
+    // Maximum number of write bursts tracked at the same time
+    parameter int  unsigned MaxTxns   = 32'd0,
+    // AXI Bus Types
+    parameter int  unsigned AddrWidth = 32'd0,
+    parameter type          req_t     = logic,
+    parameter type          resp_t    = logic
+  ) (
+    input  logic  clk_i,
+    input  logic  rst_ni,
+
+    // Input / Slave Port of the tracked master
+    input  req_t  trk_slv_req_i,
+    output resp_t trk_slv_resp_o,
+    // Output / Master Port of the tracked master
+    output req_t  trk_mst_req_o,
+    input  resp_t trk_mst_resp_i,
+
+    // Input / Slave Port of the filtered master
+    input  req_t  slv_req_i,
+    output resp_t slv_resp_o,
+    // Output / Master Port of the filtered master
+    output req_t  mst_req_o,
+    input  resp_t mst_resp_i
+  );
+
+  import cf_math_pkg::idx_width;
+
+  `include "common_cells/registers.svh"
+
+  typedef logic [AddrWidth-1:0] addr_t;
+
+  // Bytes [first, last] of an AXI burst
+  typedef struct packed {
+    addr_t first;
+    addr_t last;
+  } range_t;
+
+  function automatic range_t burst_range(addr_t addr, axi_pkg::len_t len, axi_pkg::size_t size);
+    burst_range.first = addr & ~((addr_t'(1) << size) - 1);
+    burst_range.last  = burst_range.first + ((addr_t'(len) + 1) << size) - 1;
+  endfunction : burst_range
+
+  ////////////////////////////
+  //  Tracked write bursts  //
+  ////////////////////////////
+
+  // The tracked master uses a single ID, so its B responses come back in order
+  range_t [MaxTxns-1:0]              burst_d, burst_q;
+  logic   [idx_width(MaxTxns)-1:0]   burst_wpnt_d, burst_wpnt_q;
+  logic   [idx_width(MaxTxns)-1:0]   burst_rpnt_d, burst_rpnt_q;
+  logic   [idx_width(MaxTxns+1)-1:0] burst_cnt_d, burst_cnt_q;
+
+  // Valid entries of the table
+  logic [MaxTxns-1:0] burst_valid;
+
+  always_comb begin: p_burst_valid
+    for (int unsigned i = 0; i < MaxTxns; i++) begin
+      automatic int unsigned age = (i + MaxTxns - burst_rpnt_q) % MaxTxns;
+      burst_valid[i] = age < burst_cnt_q;
+    end
+  end: p_burst_valid
+
+  always_comb begin: p_tracker
+    // Default: Feed through
+    trk_mst_req_o  = trk_slv_req_i;
+    trk_slv_resp_o = trk_mst_resp_i;
+
+    burst_d      = burst_q;
+    burst_wpnt_d = burst_wpnt_q;
+    burst_rpnt_d = burst_rpnt_q;
+    burst_cnt_d  = burst_cnt_q;
+
+    // Do not accept new AWs if the table is full
+    if (burst_cnt_q == MaxTxns) begin
+      trk_slv_resp_o.aw_ready = 1'b0;
+      trk_mst_req_o.aw_valid  = 1'b0;
+    end
+
+    // Track the new burst
+    if (trk_mst_req_o.aw_valid && trk_slv_resp_o.aw_ready) begin
+      burst_d[burst_wpnt_q] = burst_range(trk_slv_req_i.aw.addr, trk_slv_req_i.aw.len,
+        trk_slv_req_i.aw.size);
+      burst_wpnt_d = (burst_wpnt_q == MaxTxns-1) ? '0 : burst_wpnt_q + 1;
+      burst_cnt_d += 1;
+    end
+
+    // The oldest burst is written
+    if (trk_mst_resp_i.b_valid && trk_slv_req_i.b_ready) begin
+      burst_rpnt_d = (burst_rpnt_q == MaxTxns-1) ? '0 : burst_rpnt_q + 1;
+      burst_cnt_d -= 1;
+    end
+  end: p_tracker
+
+  `FF(burst_q, burst_d, '0)
+  `FF(burst_wpnt_q, burst_wpnt_d, '0)
+  `FF(burst_rpnt_q, burst_rpnt_d, '0)
+  `FF(burst_cnt_q, burst_cnt_d, '0)
+
+  /////////////////////////
+  //  Filtered requests  //
+  /////////////////////////
+
+  // A request that was let through stays valid until its handshake
+  logic ar_pending_d, ar_pending_q;
+  logic aw_pending_d, aw_pending_q;
+
+  always_comb begin: p_filter
+    automatic range_t ar_range = burst_range(slv_req_i.ar.addr, slv_req_i.ar.len, slv_req_i.ar.size);
+    automatic logic   ar_hazard = 1'b0;
+
+    for (int unsigned i = 0; i < MaxTxns; i++)
+      if (burst_valid[i] && ar_range.first <= burst_q[i].last && burst_q[i].first <= ar_range.last)
+        ar_hazard = 1'b1;
+
+    // Default: Feed through
+    mst_req_o  = slv_req_i;
+    slv_resp_o = mst_resp_i;
+
+    // Wait for the overlapping writes before reading
+    if (ar_hazard && !ar_pending_q) begin
+      slv_resp_o.ar_ready = 1'b0;
+      mst_req_o.ar_valid  = 1'b0;
+    end
+
+    // Write after all the tracked writes
+    if (burst_cnt_q != '0 && !aw_pending_q) begin
+      slv_resp_o.aw_ready = 1'b0;
+      mst_req_o.aw_valid  = 1'b0;
+    end
+
+    ar_pending_d = mst_req_o.ar_valid && !mst_resp_i.ar_ready;
+    aw_pending_d = mst_req_o.aw_valid && !mst_resp_i.aw_ready;
+  end: p_filter
+
+  `FF(ar_pending_q, ar_pending_d, 1'b0)
+  `FF(aw_pending_q, aw_pending_d, 1'b0)
+
+endmodule : axi_raw_filter
@@ -4,9 +4,10 @@
 //
 // Author: Matheus Cavalcante <matheusd@iis.ee.ethz.ch>
 // Description: AXI-LITE accessible control registers, holding
-// static information about Ara's SoC.
+// static information about Ara's SoC, the trace records, the lanes left active, and
+// the performance counters.
 
-module ctrl_registers #(
+module ctrl_registers import ara_pkg::*; #(
     parameter int   unsigned                 DataWidth       = 32,
     parameter int   unsigned                 AddrWidth       = 32,
     // Parameters
@@ -26,7 +27,15 @@ module ctrl_registers #(
     output logic           [DataWidth-1:0] dram_base_addr_o,
     output logic           [DataWidth-1:0] dram_end_addr_o,
     output logic           [DataWidth-1:0] event_trigger_o,
-    output logic           [DataWidth-1:0] hw_cnt_en_o
+    output logic           [DataWidth-1:0] hw_cnt_en_o,
+    // Trace records, valid for one cycle after the write of the tag
+    output logic           [DataWidth-1:0] trace_value_o,
+    output logic           [DataWidth-1:0] trace_tag_o,
+    output logic                           trace_valid_o,
+    // Lanes used by the vector instructions (0 for all of them)
+    output logic           [DataWidth-1:0] active_lanes_o,
+    // Performance events
+    input  perf_events_t                   perf_events_i
   );
 
   `include "common_cells/registers.svh"
@@ -35,32 +44,35 @@ module ctrl_registers #(
   //  Definitions  //
   ///////////////////
 
-  localparam int unsigned NumRegs          = 5;
+  // Control registers, followed by one counter per performance event
+  localparam int unsigned NumCtrlRegs      = 8;
+  localparam int unsigned NumRegs          = NumCtrlRegs + NrPerfEvents;
   localparam int unsigned DataWidthInBytes = (DataWidth + 7) / 8;
+  localparam int unsigned CtrlRegNumBytes  = NumCtrlRegs * DataWidthInBytes;
   localparam int unsigned RegNumBytes      = NumRegs * DataWidthInBytes;
 
   localparam logic [DataWidthInBytes-1:0] ReadOnlyReg  = {DataWidthInBytes{1'b1}};
   localparam logic [DataWidthInBytes-1:0] ReadWriteReg = {DataWidthInBytes{1'b0}};
 
   // Memory map
+  // [64+8*NrPerfEvents-1:64]: perf_cnt (rw), one per field of perf_events_t
+  // [63:56]: active_lanes   (rw)
+  // [55:48]: trace_tag      (rw)
+  // [47:40]: trace_value    (rw)
   // [39:32]: hw_cnt_en      (rw)
   // [25:31]: event_trigger  (rw)
   // [23:16]: dram_end_addr  (ro)
   // [15:8]:  dram_base_addr (ro)
   // [7:0]:   exit           (rw)
   localparam logic [NumRegs-1:0][DataWidth-1:0] RegRstVal = '{
-    0,
-    0,
-    DRAMBaseAddr + DRAMLength,
-    DRAMBaseAddr,
-    0
+    2      : DRAMBaseAddr + DRAMLength,
+    1      : DRAMBaseAddr,
+    default: 0
   };
   localparam logic [NumRegs-1:0][DataWidthInBytes-1:0] AxiReadOnly = '{
-    ReadWriteReg,
-    ReadWriteReg,
-    ReadOnlyReg,
-    ReadOnlyReg,
-    ReadWriteReg
+    2      : ReadOnlyReg,
+    1      : ReadOnlyReg,
+    default: ReadWriteReg
   };
 
   /////////////////
@@ -69,6 +81,11 @@ module ctrl_registers #(
 
   logic [RegNumBytes-1:0] wr_active_d, wr_active_q;
 
+  logic [NrPerfEvents-1:0][DataWidth-1:0] perf_cnt_d, perf_cnt_q;
+  logic [NrPerfEvents-1:0][DataWidthInBytes-1:0] perf_cnt_load;
+  logic [DataWidth-1:0] active_lanes;
+  logic [DataWidth-1:0] trace_tag;
+  logic [DataWidth-1:0] trace_value;
   logic [DataWidth-1:0] hw_cnt_en;
   logic [DataWidth-1:0] event_trigger;
   logic [DataWidth-1:0] dram_base_address;
@@ -84,17 +101,28 @@ module ctrl_registers #(
     .req_lite_t  (axi_lite_req_t ),
     .resp_lite_t (axi_lite_resp_t)
   ) i_axi_lite_regs (
-    .clk_i      (clk_i                                      ),
-    .rst_ni     (rst_ni                                     ),
-    .axi_req_i  (axi_lite_slave_req_i                       ),
-    .axi_resp_o (axi_lite_slave_resp_o                      ),
-    .wr_active_o(wr_active_d                                ),
-    .rd_active_o(/* Unused */                               ),
-    .reg_d_i    ('0                                         ),
-    .reg_load_i ('0                                         ),
-    .reg_q_o    ({hw_cnt_en, event_trigger, dram_end_address, dram_base_address, exit})
+    .clk_i      (clk_i                                                                     ),
+    .rst_ni     (rst_ni                                                                    ),
+    .axi_req_i  (axi_lite_slave_req_i                                                      ),
+    .axi_resp_o (axi_lite_slave_resp_o                                                     ),
+    .wr_active_o(wr_active_d                                                               ),
+    .rd_active_o(/* Unused */                                                              ),
+    .reg_d_i    ({perf_cnt_d, {CtrlRegNumBytes{8'h00}}}                                    ),
+    .reg_load_i ({perf_cnt_load, {CtrlRegNumBytes{1'b0}}}                                  ),
+    .reg_q_o    ({perf_cnt_q, active_lanes, trace_tag, trace_value, hw_cnt_en, event_trigger, dram_end_address, dram_base_address, exit})
   );
 
+  ////////////////////////////
+  //  Performance counters  //
+  ////////////////////////////
+
+  // The counters count only when the hardware counter is enabled, like the runtime
+  // counter. The software can clear a counter by writing to it while counting is disabled.
+  for (genvar c = 0; c < NrPerfEvents; c++) begin : gen_perf_cnt
+    assign perf_cnt_d[c]    = perf_cnt_q[c] + 1;
+    assign perf_cnt_load[c] = {DataWidthInBytes{hw_cnt_en[0] & perf_events_i[c]}};
+  end : gen_perf_cnt
+
   `FF(wr_active_q, wr_active_d, '0);
 
   /////////////////
@@ -102,7 +130,12 @@ module ctrl_registers #(
   /////////////////
 
   assign hw_cnt_en_o      = hw_cnt_en;
+  // The software writes the value of a record, and then its tag
+  assign trace_value_o    = trace_value;
+  assign trace_tag_o      = trace_tag;
+  assign trace_valid_o    = |wr_active_q[6*DataWidthInBytes +: DataWidthInBytes];
   assign event_trigger_o  = event_trigger;
+  assign active_lanes_o   = active_lanes;
   assign dram_base_addr_o = dram_base_address;
   assign dram_end_addr_o  = dram_end_address;
   assign exit_o           = {exit, logic'(|wr_active_q[7:0])};
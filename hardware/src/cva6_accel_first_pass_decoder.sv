@@ -55,7 +55,16 @@ module cva6_accel_first_pass_decoder import rvv_pkg::*; (
             is_fs1_o = 1'b1;
             is_vfp_o = 1'b1;
           end
-          OPMVX: is_rs1_o = 1'b1 ;
+          OPMVX: begin
+            is_rs1_o = 1'b1 ;
+            // vlend.vx (custom) returns the avl left, and stands for the memory operations
+            // that the loop buffer replays
+            if (instr.varith_type.func6 == 6'b000_100) begin
+              is_rd_o    = 1'b1;
+              is_load_o  = 1'b1;
+              is_store_o = 1'b1;
+            end
+          end
           OPCFG: begin
             is_rs1_o = instr.vsetivli_type.func2 != 2'b11; // not vsetivli
             is_rs2_o = instr.vsetvl_type.func7 == 7'b100_0000; // vsetvl
@@ -64,6 +73,9 @@ module cva6_accel_first_pass_decoder import rvv_pkg::*; (
         endcase
       end
 
+      // Vector crypto operations, without scalar operands
+      OpcodeVecCrypto: is_accel_o = 1'b1;
+
       // Memory vector operations
       riscv::OpcodeLoadFp,
       riscv::OpcodeStoreFp: begin
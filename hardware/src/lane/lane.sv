@@ -21,8 +21,8 @@ module lane import ara_pkg::*; import rvv_pkg::*; #(
     // VRF Parameters
     localparam int           unsigned MaxVLenPerLane  = VLEN / NrLanes,       // In bits
     localparam int           unsigned MaxVLenBPerLane = VLENB / NrLanes,      // In bytes
-    localparam int           unsigned VRFSizePerLane  = MaxVLenPerLane * 32,  // In bits
-    localparam int           unsigned VRFBSizePerLane = MaxVLenBPerLane * 32, // In bytes
+    localparam int           unsigned VRFSizePerLane  = MaxVLenPerLane * NrPhysVRegs,  // In bits
+    localparam int           unsigned VRFBSizePerLane = MaxVLenBPerLane * NrPhysVRegs, // In bytes
     // Address of an element in the lane's VRF
     localparam type                   vaddr_t         = logic [$clog2(VRFBSizePerLane)-1:0],
     localparam int           unsigned DataWidth       = $bits(elen_t), // Width of the lane datapath
@@ -49,6 +49,8 @@ module lane import ara_pkg::*; import rvv_pkg::*; #(
     output `STRUCT_PORT(pe_resp_t)                         pe_resp_o,
     output logic                                           alu_vinsn_done_o,
     output logic                                           mfpu_vinsn_done_o,
+    output logic                                           mfpu2_vinsn_done_o,
+    output logic                                           mxu_vinsn_done_o,
     input  logic                [NrVInsn-1:0][NrVInsn-1:0] global_hazard_table_i,
     // Interface with the Store unit
     output elen_t                                          stu_operand_o,
@@ -70,6 +72,11 @@ module lane import ara_pkg::*; import rvv_pkg::*; #(
     output logic                                           sldu_result_gnt_o,
     input  logic                                           sldu_red_valid_i,
     output logic                                           sldu_result_final_gnt_o,
+    // Interface with the neighbour lanes, for the ordered reductions
+    output elen_t                                          osum_result_o,
+    output logic                                           osum_result_valid_o,
+    input  elen_t                                          osum_operand_i,
+    input  logic                                           osum_operand_valid_i,
     // Interface with the Load unit
     input  logic                                           ldu_result_req_i,
     input  vid_t                                           ldu_result_id_i,
@@ -92,7 +99,13 @@ module lane import ara_pkg::*; import rvv_pkg::*; #(
     // Interface between the Mask unit and the VFUs
     input  strb_t                                          mask_i,
     input  logic                                           mask_valid_i,
-    output logic                                           mask_ready_o
+    output logic                                           mask_ready_o,
+    // Performance events
+    output logic                                           perf_vrf_bank_conflict_o,
+    output logic                                           perf_vrf_rw_conflict_o,
+    output logic                                           perf_valu_clk_on_o,
+    output logic                                           perf_vmfpu_clk_on_o,
+    output logic                                           perf_vmfpu2_clk_on_o
   );
 
   /////////////////
@@ -116,6 +129,39 @@ module lane import ara_pkg::*; import rvv_pkg::*; #(
     .data_o (mask        )
   );
 
+  //////////////////
+  //  Mask Cache  //
+  //////////////////
+
+  // Mask beats of the VFUs
+  strb_t fu_mask;
+  logic  fu_mask_valid, fu_mask_ready;
+
+  // Mask cache entry of the VFU operation
+  logic                                                mask_cache_push;
+  logic                                                mask_cache_hit;
+  logic [cf_math_pkg::idx_width(MaskCacheBeats+1)-1:0] mask_cache_beats;
+
+  if (MaskCacheBeats != 0) begin: gen_mask_cache
+    lane_mask_cache i_mask_cache (
+      .clk_i       (clk_i           ),
+      .rst_ni      (rst_ni          ),
+      .push_i      (mask_cache_push ),
+      .hit_i       (mask_cache_hit  ),
+      .beats_i     (mask_cache_beats),
+      .mask_i      (mask            ),
+      .mask_valid_i(mask_valid      ),
+      .mask_ready_o(mask_ready      ),
+      .mask_o      (fu_mask         ),
+      .mask_valid_o(fu_mask_valid   ),
+      .mask_ready_i(fu_mask_ready   )
+    );
+  end: gen_mask_cache else begin: gen_no_mask_cache
+    assign fu_mask       = mask;
+    assign fu_mask_valid = mask_valid;
+    assign mask_ready    = fu_mask_ready;
+  end: gen_no_mask_cache
+
   /////////////////
   //  Sequencer  //
   /////////////////
@@ -131,6 +177,12 @@ module lane import ara_pkg::*; import rvv_pkg::*; #(
   logic                 [NrVInsn-1:0]         alu_vinsn_done;
   logic                                       mfpu_ready;
   logic                 [NrVInsn-1:0]         mfpu_vinsn_done;
+  logic                                       mfpu2_ready;
+  logic                 [NrVInsn-1:0]         mfpu2_vinsn_done;
+  logic                 [NrVInsn-1:0]         mxu_vinsn_done;
+  logic                                       alu_clk_en;
+  logic                                       mfpu_clk_en;
+  logic                                       mfpu2_clk_en;
 
   lane_sequencer #(.NrLanes(NrLanes)) i_lane_sequencer (
     .clk_i                  (clk_i                ),
@@ -148,15 +200,31 @@ module lane import ara_pkg::*; import rvv_pkg::*; #(
     .operand_request_ready_i(operand_request_ready),
     .alu_vinsn_done_o       (alu_vinsn_done_o     ),
     .mfpu_vinsn_done_o      (mfpu_vinsn_done_o    ),
+    .mfpu2_vinsn_done_o     (mfpu2_vinsn_done_o   ),
+    .mxu_vinsn_done_o       (mxu_vinsn_done_o     ),
     // Interface with the VFUs
     .vfu_operation_o        (vfu_operation        ),
     .vfu_operation_valid_o  (vfu_operation_valid  ),
     .alu_ready_i            (alu_ready            ),
     .alu_vinsn_done_i       (alu_vinsn_done       ),
     .mfpu_ready_i           (mfpu_ready           ),
-    .mfpu_vinsn_done_i      (mfpu_vinsn_done      )
+    .mfpu_vinsn_done_i      (mfpu_vinsn_done      ),
+    .mfpu2_ready_i          (mfpu2_ready          ),
+    .mfpu2_vinsn_done_i     (mfpu2_vinsn_done     ),
+    .mxu_vinsn_done_i       (mxu_vinsn_done       ),
+    .alu_clk_en_o           (alu_clk_en           ),
+    .mfpu_clk_en_o          (mfpu_clk_en          ),
+    .mfpu2_clk_en_o         (mfpu2_clk_en         ),
+    // Interface with the mask cache
+    .mask_cache_push_o      (mask_cache_push      ),
+    .mask_cache_hit_o       (mask_cache_hit       ),
+    .mask_cache_beats_o     (mask_cache_beats     )
   );
 
+  assign perf_valu_clk_on_o   = alu_clk_en;
+  assign perf_vmfpu_clk_on_o  = mfpu_clk_en;
+  assign perf_vmfpu2_clk_on_o = mfpu2_clk_en;
+
   /////////////////////////
   //  Operand Requester  //
   /////////////////////////
@@ -168,6 +236,10 @@ module lane import ara_pkg::*; import rvv_pkg::*; #(
   elen_t              [NrVRFBanksPerLane-1:0] vrf_wdata;
   strb_t              [NrVRFBanksPerLane-1:0] vrf_be;
   opqueue_e           [NrVRFBanksPerLane-1:0] vrf_tgt_opqueue;
+  logic               [NrVRFBanksPerLane-1:0] vrf_wr_req;
+  vaddr_t             [NrVRFBanksPerLane-1:0] vrf_wr_addr;
+  elen_t              [NrVRFBanksPerLane-1:0] vrf_wr_wdata;
+  strb_t              [NrVRFBanksPerLane-1:0] vrf_wr_be;
   // Interface with the operand queues
   logic               [NrOperandQueues-1:0]   operand_queue_ready;
   logic               [NrOperandQueues-1:0]   operand_issued;
@@ -188,8 +260,25 @@ module lane import ara_pkg::*; import rvv_pkg::*; #(
   elen_t                                      mfpu_result_wdata;
   strb_t                                      mfpu_result_be;
   logic                                       mfpu_result_gnt;
+  // Second Multiplier/FPU
+  logic                                       mfpu2_result_req;
+  vid_t                                       mfpu2_result_id;
+  vaddr_t                                     mfpu2_result_addr;
+  elen_t                                      mfpu2_result_wdata;
+  strb_t                                      mfpu2_result_be;
+  logic                                       mfpu2_result_gnt;
+  // Matrix outer-product unit
+  logic                                       mxu_result_req;
+  vid_t                                       mxu_result_id;
+  vaddr_t                                     mxu_result_addr;
+  elen_t                                      mxu_result_wdata;
+  strb_t                                      mxu_result_be;
+  logic                                       mxu_result_gnt;
   // To the slide unit (reductions)
   logic                                       sldu_result_gnt_opqueues;
+  // Store operands forwarded from the VFU results
+  elen_t                                      stu_bypass_operand;
+  logic                                       stu_bypass_operand_valid;
 
   operand_requester #(
     .NrBanks(NrVRFBanksPerLane),
@@ -211,11 +300,17 @@ module lane import ara_pkg::*; import rvv_pkg::*; #(
     .vrf_wdata_o              (vrf_wdata               ),
     .vrf_be_o                 (vrf_be                  ),
     .vrf_tgt_opqueue_o        (vrf_tgt_opqueue         ),
+    .vrf_wr_req_o             (vrf_wr_req              ),
+    .vrf_wr_addr_o            (vrf_wr_addr             ),
+    .vrf_wr_wdata_o           (vrf_wr_wdata            ),
+    .vrf_wr_be_o              (vrf_wr_be               ),
     // Interface with the operand queues
     .operand_issued_o         (operand_issued          ),
     .operand_queue_ready_i    (operand_queue_ready     ),
     .operand_queue_cmd_o      (operand_queue_cmd       ),
     .operand_queue_cmd_valid_o(operand_queue_cmd_valid ),
+    .stu_bypass_operand_o     (stu_bypass_operand      ),
+    .stu_bypass_valid_o       (stu_bypass_operand_valid),
     // Interface with the VFUs
     // ALU
     .alu_result_req_i         (alu_result_req          ),
@@ -231,6 +326,20 @@ module lane import ara_pkg::*; import rvv_pkg::*; #(
     .mfpu_result_wdata_i      (mfpu_result_wdata       ),
     .mfpu_result_be_i         (mfpu_result_be          ),
     .mfpu_result_gnt_o        (mfpu_result_gnt         ),
+    // Second MFPU
+    .mfpu2_result_req_i       (mfpu2_result_req        ),
+    .mfpu2_result_id_i        (mfpu2_result_id         ),
+    .mfpu2_result_addr_i      (mfpu2_result_addr       ),
+    .mfpu2_result_wdata_i     (mfpu2_result_wdata      ),
+    .mfpu2_result_be_i        (mfpu2_result_be         ),
+    .mfpu2_result_gnt_o       (mfpu2_result_gnt        ),
+    // MXU
+    .mxu_result_req_i         (mxu_result_req          ),
+    .mxu_result_id_i          (mxu_result_id           ),
+    .mxu_result_addr_i        (mxu_result_addr         ),
+    .mxu_result_wdata_i       (mxu_result_wdata        ),
+    .mxu_result_be_i          (mxu_result_be           ),
+    .mxu_result_gnt_o         (mxu_result_gnt          ),
     // Mask Unit
     .masku_result_req_i       (masku_result_req_i      ),
     .masku_result_id_i        (masku_result_id_i       ),
@@ -254,7 +363,10 @@ module lane import ara_pkg::*; import rvv_pkg::*; #(
     .ldu_result_wdata_i       (ldu_result_wdata_i      ),
     .ldu_result_be_i          (ldu_result_be_i         ),
     .ldu_result_gnt_o         (ldu_result_gnt_o        ),
-    .ldu_result_final_gnt_o   (ldu_result_final_gnt_o  )
+    .ldu_result_final_gnt_o   (ldu_result_final_gnt_o  ),
+    // Performance events
+    .vrf_bank_conflict_o      (perf_vrf_bank_conflict_o),
+    .vrf_rw_conflict_o        (perf_vrf_rw_conflict_o  )
   );
 
   ////////////////////////////
@@ -279,11 +391,28 @@ module lane import ara_pkg::*; import rvv_pkg::*; #(
     .wdata_i        (vrf_wdata        ),
     .be_i           (vrf_be           ),
     .tgt_opqueue_i  (vrf_tgt_opqueue  ),
+    .wr_req_i       (vrf_wr_req       ),
+    .wr_addr_i      (vrf_wr_addr      ),
+    .wr_wdata_i     (vrf_wr_wdata     ),
+    .wr_be_i        (vrf_wr_be        ),
     // Interface with the operand queues
     .operand_o      (vrf_operand      ),
     .operand_valid_o(vrf_operand_valid)
   );
 
+  // The forwarded store operands replace a VRF read, so they never collide with one
+  elen_t [NrOperandQueues-1:0] opqueue_operand;
+  logic  [NrOperandQueues-1:0] opqueue_operand_valid;
+
+  always_comb begin: p_stu_bypass
+    opqueue_operand       = vrf_operand;
+    opqueue_operand_valid = vrf_operand_valid;
+    if (stu_bypass_operand_valid) begin
+      opqueue_operand[StA]       = stu_bypass_operand;
+      opqueue_operand_valid[StA] = 1'b1;
+    end
+  end: p_stu_bypass
+
   //////////////////////
   //  Operand queues  //
   //////////////////////
@@ -297,6 +426,14 @@ module lane import ara_pkg::*; import rvv_pkg::*; #(
   elen_t [2:0] mfpu_operand;
   logic  [2:0] mfpu_operand_valid;
   logic  [2:0] mfpu_operand_ready;
+  // Second Multiplier/FPU
+  elen_t [2:0] mfpu2_operand;
+  logic  [2:0] mfpu2_operand_valid;
+  logic  [2:0] mfpu2_operand_ready;
+  // Matrix outer-product unit
+  elen_t       mxu_operand;
+  logic        mxu_operand_valid;
+  logic        mxu_operand_ready;
 
   elen_t sldu_addrgen_operand_opqueues;
 
@@ -311,8 +448,8 @@ module lane import ara_pkg::*; import rvv_pkg::*; #(
     .rst_ni                           (rst_ni                             ),
     .lane_id_i                        (lane_id_i                          ),
     // Interface with the Vector Register File
-    .operand_i                        (vrf_operand                        ),
-    .operand_valid_i                  (vrf_operand_valid                  ),
+    .operand_i                        (opqueue_operand                    ),
+    .operand_valid_i                  (opqueue_operand_valid              ),
     // Interface with the operand requester
     .operand_issued_i                 (operand_issued                     ),
     .operand_queue_ready_o            (operand_queue_ready                ),
@@ -327,6 +464,14 @@ module lane import ara_pkg::*; import rvv_pkg::*; #(
     .mfpu_operand_o                   (mfpu_operand                       ),
     .mfpu_operand_valid_o             (mfpu_operand_valid                 ),
     .mfpu_operand_ready_i             (mfpu_operand_ready                 ),
+    // Second Multiplier/FPU
+    .mfpu2_operand_o                  (mfpu2_operand                      ),
+    .mfpu2_operand_valid_o            (mfpu2_operand_valid                ),
+    .mfpu2_operand_ready_i            (mfpu2_operand_ready                ),
+    // Matrix outer-product unit
+    .mxu_operand_o                    (mxu_operand                        ),
+    .mxu_operand_valid_o              (mxu_operand_valid                  ),
+    .mxu_operand_ready_i              (mxu_operand_ready                  ),
     // Store Unit
     .stu_operand_o                    (stu_operand_o                      ),
     .stu_operand_valid_o              (stu_operand_valid_o                ),
@@ -376,6 +521,12 @@ module lane import ara_pkg::*; import rvv_pkg::*; #(
     .alu_vinsn_done_o     (alu_vinsn_done                         ),
     .mfpu_ready_o         (mfpu_ready                             ),
     .mfpu_vinsn_done_o    (mfpu_vinsn_done                        ),
+    .mfpu2_ready_o        (mfpu2_ready                            ),
+    .mfpu2_vinsn_done_o   (mfpu2_vinsn_done                       ),
+    .mxu_vinsn_done_o     (mxu_vinsn_done                         ),
+    .alu_clk_en_i         (alu_clk_en                             ),
+    .mfpu_clk_en_i        (mfpu_clk_en                            ),
+    .mfpu2_clk_en_i       (mfpu2_clk_en                           ),
     // Interface with the operand requester
     // ALU
     .alu_result_req_o     (alu_result_req                         ),
@@ -391,6 +542,20 @@ module lane import ara_pkg::*; import rvv_pkg::*; #(
     .mfpu_result_wdata_o  (mfpu_result_wdata                      ),
     .mfpu_result_be_o     (mfpu_result_be                         ),
     .mfpu_result_gnt_i    (mfpu_result_gnt                        ),
+    // Second MFPU
+    .mfpu2_result_req_o   (mfpu2_result_req                       ),
+    .mfpu2_result_id_o    (mfpu2_result_id                        ),
+    .mfpu2_result_addr_o  (mfpu2_result_addr                      ),
+    .mfpu2_result_wdata_o (mfpu2_result_wdata                     ),
+    .mfpu2_result_be_o    (mfpu2_result_be                        ),
+    .mfpu2_result_gnt_i   (mfpu2_result_gnt                       ),
+    // MXU
+    .mxu_result_req_o     (mxu_result_req                         ),
+    .mxu_result_id_o      (mxu_result_id                          ),
+    .mxu_result_addr_o    (mxu_result_addr                        ),
+    .mxu_result_wdata_o   (mxu_result_wdata                       ),
+    .mxu_result_be_o      (mxu_result_be                          ),
+    .mxu_result_gnt_i     (mxu_result_gnt                         ),
     // Interface with the Slide Unit
     .sldu_alu_req_valid_o (sldu_alu_req_valid_o                   ),
     .sldu_alu_valid_i     (sldu_alu_valid                         ),
@@ -401,6 +566,11 @@ module lane import ara_pkg::*; import rvv_pkg::*; #(
     .sldu_mfpu_ready_o    (sldu_mfpu_ready                        ),
     .sldu_mfpu_gnt_i      (sldu_mfpu_gnt                          ),
     .sldu_operand_i       (sldu_result_wdata_i                    ),
+    // Interface with the neighbour lanes
+    .osum_result_o        (osum_result_o                          ),
+    .osum_result_valid_o  (osum_result_valid_o                    ),
+    .osum_operand_i       (osum_operand_i                         ),
+    .osum_operand_valid_i (osum_operand_valid_i                   ),
     // Interface with the operand queues
     // ALU
     .alu_operand_i        (alu_operand                            ),
@@ -410,13 +580,21 @@ module lane import ara_pkg::*; import rvv_pkg::*; #(
     .mfpu_operand_i       (mfpu_operand                           ),
     .mfpu_operand_valid_i (mfpu_operand_valid                     ),
     .mfpu_operand_ready_o (mfpu_operand_ready                     ),
+    // Second Multiplier/FPU
+    .mfpu2_operand_i      (mfpu2_operand                          ),
+    .mfpu2_operand_valid_i(mfpu2_operand_valid                    ),
+    .mfpu2_operand_ready_o(mfpu2_operand_ready                    ),
+    // Matrix outer-product unit
+    .mxu_operand_i        (mxu_operand                            ),
+    .mxu_operand_valid_i  (mxu_operand_valid                      ),
+    .mxu_operand_ready_o  (mxu_operand_ready                      ),
     // Interface with the Mask unit
     .mask_operand_o       (mask_operand_o[2 +: NrMaskFUnits]      ),
     .mask_operand_valid_o (mask_operand_valid_o[2 +: NrMaskFUnits]),
     .mask_operand_ready_i (mask_operand_ready_i[2 +: NrMaskFUnits]),
-    .mask_i               (mask                                   ),
-    .mask_valid_i         (mask_valid                             ),
-    .mask_ready_o         (mask_ready                             )
+    .mask_i               (fu_mask                                ),
+    .mask_valid_i         (fu_mask_valid                          ),
+    .mask_ready_o         (fu_mask_ready                          )
   );
 
   /********************
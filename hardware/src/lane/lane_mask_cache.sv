@@ -0,0 +1,102 @@
+// Copyright 2021 ETH Zurich and University of Bologna.
+// Solderpad Hardware License, Version 0.51, see LICENSE for details.
+// SPDX-License-Identifier: SHL-0.51
+//
+// Description:
+// The mask cache of one lane sits between the mask beats of the Mask Unit and
+// the lane's VFUs. It keeps the beats of the masked instructions marked as
+// fills by the main sequencer, and gives them back to the hits, which have the
+// same vl and SEW under the same v0, so that these do not read v0 and do not
+// run on the Mask Unit.
+//
+// The instructions that use the cache are not in flight together with the other
+// masked instructions of the lane, so that the beats of the VFUs follow the
+// order of the fills and of the hits in the queue.
+
+module lane_mask_cache import ara_pkg::*; import cf_math_pkg::idx_width; (
+    input  logic                                   clk_i,
+    input  logic                                   rst_ni,
+    // Interface with the lane sequencer
+    input  logic                                   push_i,
+    input  logic                                   hit_i,
+    input  logic [idx_width(MaskCacheBeats+1)-1:0] beats_i,
+    // Interface with the Mask Unit
+    input  strb_t                                  mask_i,
+    input  logic                                   mask_valid_i,
+    output logic                                   mask_ready_o,
+    // Interface with the VFUs
+    output strb_t                                  mask_o,
+    output logic                                   mask_valid_o,
+    input  logic                                   mask_ready_i
+  );
+
+  typedef struct packed {
+    logic hit;
+    logic [idx_width(MaskCacheBeats+1)-1:0] beats;
+  } entry_t;
+
+  // Fills and hits in flight
+  entry_t entry;
+  logic   entry_empty, entry_pop;
+
+  fifo_v3 #(
+    .DEPTH(NrVInsn),
+    .dtype(entry_t)
+  ) i_entry_queue (
+    .clk_i     (clk_i                           ),
+    .rst_ni    (rst_ni                          ),
+    .flush_i   (1'b0                            ),
+    .testmode_i(1'b0                            ),
+    .data_i    ('{hit: hit_i, beats: beats_i}  ),
+    .push_i    (push_i                          ),
+    .full_o    (/* Unused */                    ),
+    .data_o    (entry                           ),
+    .pop_i     (entry_pop                       ),
+    .empty_o   (entry_empty                     ),
+    .usage_o   (/* Unused */                    )
+  );
+
+  strb_t [MaskCacheBeats-1:0]             cache_d, cache_q;
+  logic  [idx_width(MaskCacheBeats+1)-1:0] beat_d, beat_q;
+
+  always_comb begin: p_mask_cache
+    cache_d   = cache_q;
+    beat_d    = beat_q;
+    entry_pop = 1'b0;
+
+    // Pass the beats of the Mask Unit through, by default
+    mask_o       = mask_i;
+    mask_valid_o = mask_valid_i;
+    mask_ready_o = mask_ready_i;
+
+    if (!entry_empty) begin
+      // Give the beats back, without the Mask Unit
+      if (entry.hit) begin
+        mask_o       = cache_q[beat_q];
+        mask_valid_o = 1'b1;
+        mask_ready_o = 1'b0;
+      end
+
+      if (mask_valid_o && mask_ready_i) begin
+        // Keep the beats of a fill
+        if (!entry.hit) cache_d[beat_q] = mask_i;
+        beat_d = beat_q + 1;
+        if (beat_d == entry.beats) begin
+          beat_d    = '0;
+          entry_pop = 1'b1;
+        end
+      end
+    end
+  end: p_mask_cache
+
+  always_ff @(posedge clk_i or negedge rst_ni) begin: p_mask_cache_ff
+    if (!rst_ni) begin
+      cache_q <= '0;
+      beat_q  <= '0;
+    end else begin
+      cache_q <= cache_d;
+      beat_q  <= beat_d;
+    end
+  end: p_mask_cache_ff
+
+endmodule : lane_mask_cache
@@ -27,13 +27,26 @@ module lane_sequencer import ara_pkg::*; import rvv_pkg::*; import cf_math_pkg::
     input  logic                 [NrOperandQueues-1:0]    operand_request_ready_i,
     output logic                                          alu_vinsn_done_o,
     output logic                                          mfpu_vinsn_done_o,
+    output logic                                          mfpu2_vinsn_done_o,
+    output logic                                          mxu_vinsn_done_o,
     // Interface with the lane's VFUs
     output vfu_operation_t                                vfu_operation_o,
     output logic                                          vfu_operation_valid_o,
     input  logic                                          alu_ready_i,
     input  logic                 [NrVInsn-1:0]            alu_vinsn_done_i,
     input  logic                                          mfpu_ready_i,
-    input  logic                 [NrVInsn-1:0]            mfpu_vinsn_done_i
+    input  logic                 [NrVInsn-1:0]            mfpu_vinsn_done_i,
+    input  logic                                          mfpu2_ready_i,
+    input  logic                 [NrVInsn-1:0]            mfpu2_vinsn_done_i,
+    input  logic                 [NrVInsn-1:0]            mxu_vinsn_done_i,
+    // Clock enables of the lane's VFUs
+    output logic                                          alu_clk_en_o,
+    output logic                                          mfpu_clk_en_o,
+    output logic                                          mfpu2_clk_en_o,
+    // Interface with the mask cache
+    output logic                                          mask_cache_push_o,
+    output logic                                          mask_cache_hit_o,
+    output logic                 [idx_width(MaskCacheBeats+1)-1:0] mask_cache_beats_o
   );
 
   ////////////////////////////
@@ -55,20 +68,36 @@ module lane_sequencer import ara_pkg::*; import rvv_pkg::*; import cf_math_pkg::
   logic    pe_req_valid;
   logic    pe_req_ready;
 
-  fall_through_register #(
-    .T(pe_req_t)
-  ) i_pe_req_register (
-    .clk_i     (clk_i             ),
-    .rst_ni    (rst_ni            ),
-    .clr_i     (1'b0              ),
-    .testmode_i(1'b0              ),
-    .data_i    (pe_req_i          ),
-    .valid_i   (pe_req_valid_i_msk),
-    .ready_o   (pe_req_ready_o    ),
-    .data_o    (pe_req            ),
-    .valid_o   (pe_req_valid      ),
-    .ready_i   (pe_req_ready      )
-  );
+  if (PeReqCut) begin: gen_pe_req_spill_register
+    // Cut the paths from the main sequencer, also the one of the ready
+    spill_register #(
+      .T(pe_req_t)
+    ) i_pe_req_register (
+      .clk_i  (clk_i             ),
+      .rst_ni (rst_ni            ),
+      .data_i (pe_req_i          ),
+      .valid_i(pe_req_valid_i_msk),
+      .ready_o(pe_req_ready_o    ),
+      .data_o (pe_req            ),
+      .valid_o(pe_req_valid      ),
+      .ready_i(pe_req_ready      )
+    );
+  end else begin: gen_pe_req_fall_through_register
+    fall_through_register #(
+      .T(pe_req_t)
+    ) i_pe_req_register (
+      .clk_i     (clk_i             ),
+      .rst_ni    (rst_ni            ),
+      .clr_i     (1'b0              ),
+      .testmode_i(1'b0              ),
+      .data_i    (pe_req_i          ),
+      .valid_i   (pe_req_valid_i_msk),
+      .ready_o   (pe_req_ready_o    ),
+      .data_o    (pe_req            ),
+      .valid_o   (pe_req_valid      ),
+      .ready_i   (pe_req_ready      )
+    );
+  end
 
   always_comb begin
     // Default assignment
@@ -161,16 +190,27 @@ module lane_sequencer import ara_pkg::*; import rvv_pkg::*; import cf_math_pkg::
   vfu_operation_t vfu_operation_d;
   logic           vfu_operation_valid_d;
 
+  // Mask cache entry of the VFU operation
+  logic                                   mask_cache_push_d;
+  logic                                   mask_cache_hit_d;
+  logic [idx_width(MaskCacheBeats+1)-1:0] mask_cache_beats_d;
+
   // Cut the path
-  logic alu_vinsn_done_d, mfpu_vinsn_done_d;
+  logic alu_vinsn_done_d, mfpu_vinsn_done_d, mfpu2_vinsn_done_d, mxu_vinsn_done_d;
+
+  // This lane has no elements of the incoming unmasked instruction and drops it right away.
+  // The masked ones still request their mask, which the Mask Unit expects from all the lanes.
+  logic drop_vinsn;
 
   // Returns true if the corresponding lane VFU is ready.
-  function automatic logic vfu_ready(vfu_e vfu, logic alu_ready_i, logic mfpu_ready_i);
+  function automatic logic vfu_ready(vfu_e vfu, logic alu_ready_i, logic mfpu_ready_i,
+      logic mfpu2_ready_i);
     vfu_ready = 1'b1;
     unique case (vfu)
       VFU_Alu,
       VFU_MaskUnit: vfu_ready = alu_ready_i;
       VFU_MFpu    : vfu_ready = mfpu_ready_i;
+      VFU_MFpu2   : vfu_ready = mfpu2_ready_i;
       default:;
     endcase
   endfunction : vfu_ready
@@ -182,10 +222,16 @@ module lane_sequencer import ara_pkg::*; import rvv_pkg::*; import cf_math_pkg::
     // Ready to accept a new request, by default
     pe_req_ready = 1'b1;
 
+    drop_vinsn = ShortVlFastPath && pe_req.vm &&
+      lane_skips_vinsn(pe_req.op, pe_req.vfu, pe_req.vl, lane_id_i);
+
     // Loops that finished execution
-    vinsn_done_d         = alu_vinsn_done_i | mfpu_vinsn_done_i;
+    vinsn_done_d         = alu_vinsn_done_i | mfpu_vinsn_done_i | mfpu2_vinsn_done_i |
+                           mxu_vinsn_done_i;
     alu_vinsn_done_d     = |alu_vinsn_done_i;
     mfpu_vinsn_done_d    = |mfpu_vinsn_done_i;
+    mfpu2_vinsn_done_d   = |mfpu2_vinsn_done_i;
+    mxu_vinsn_done_d     = |mxu_vinsn_done_i;
     pe_resp_o.vinsn_done = vinsn_done_q;
 
     // Make no requests to the operand requester
@@ -196,6 +242,10 @@ module lane_sequencer import ara_pkg::*; import rvv_pkg::*; import cf_math_pkg::
     vfu_operation_d       = '0;
     vfu_operation_valid_d = 1'b0;
 
+    mask_cache_push_d  = 1'b0;
+    mask_cache_hit_d   = 1'b0;
+    mask_cache_beats_d = '0;
+
     // If the operand requesters are busy, abort the request and wait for another cycle.
     if (pe_req_valid) begin
       unique case (pe_req.vfu)
@@ -210,13 +260,19 @@ module lane_sequencer import ara_pkg::*; import rvv_pkg::*; import cf_math_pkg::
             operand_request_valid_o[MulFPUC] ||
             operand_request_valid_o[MaskM]);
         end
+        VFU_MFpu2 : begin
+          pe_req_ready = !(operand_request_valid_o[MulFPU2A] ||
+            operand_request_valid_o[MulFPU2B] ||
+            operand_request_valid_o[MulFPU2C]);
+        end
+        VFU_MxUnit   : pe_req_ready = !(operand_request_valid_o[MulFPUA]);
         VFU_LoadUnit : pe_req_ready = !(operand_request_valid_o[MaskM] ||
             (pe_req_i.op == VLXE && operand_request_valid_o[SlideAddrGenA]));
         VFU_SlideUnit: pe_req_ready = !(operand_request_valid_o[SlideAddrGenA]);
         VFU_StoreUnit: begin
           pe_req_ready = !(operand_request_valid_o[StA] ||
             operand_request_valid_o[MaskM] ||
-            (pe_req_i.op == VSXE && operand_request_valid_o[SlideAddrGenA]));
+            (pe_req_i.op inside {[VSXE:VAMOMAXU]} && operand_request_valid_o[SlideAddrGenA]));
         end
         VFU_MaskUnit : begin
           pe_req_ready = !(operand_request_valid_o[AluA] ||
@@ -231,6 +287,9 @@ module lane_sequencer import ara_pkg::*; import rvv_pkg::*; import cf_math_pkg::
         end
         default:;
       endcase
+
+      // The dropped instructions do not need the operand requesters
+      if (drop_vinsn) pe_req_ready = 1'b1;
     end
 
     // We received a new vector instruction
@@ -257,6 +316,17 @@ module lane_sequencer import ara_pkg::*; import rvv_pkg::*; import cf_math_pkg::
       };
       vfu_operation_valid_d = (vfu_operation_d.vfu != VFU_None) ? 1'b1 : 1'b0;
 
+      // The Mask Unit masks the permutations, and receives their vs2 directly
+      if (pe_req.op inside {[VRGATHER:VCOMPRESS]}) begin
+        vfu_operation_d.vm      = 1'b1;
+        vfu_operation_d.use_vs2 = 1'b0;
+      end
+      // The ALU forwards vd of the crypto instructions to the Mask Unit, on its first operand
+      if (pe_req.op inside {[VAESEF:VGMUL]}) begin
+        vfu_operation_d.use_vs1 = 1'b1;
+        vfu_operation_d.use_vs2 = 1'b0;
+      end
+
       // Vector length calculation
       vfu_operation_d.vl = pe_req.vl / NrLanes;
       // If lane_id_i < vl % NrLanes, this lane has to execute one extra micro-operation.
@@ -267,6 +337,12 @@ module lane_sequencer import ara_pkg::*; import rvv_pkg::*; import cf_math_pkg::
       // If lane_id_i < vstart % NrLanes, this lane needs to execute one micro-operation less.
       if (lane_id_i < pe_req.vstart[idx_width(NrLanes)-1:0]) vfu_operation_d.vstart -= 1;
 
+      // Element vl-1 of an ordered reduction is in lane (vl-1) % NrLanes
+      if (pe_req.op inside {VFREDOSUM, VFWREDOSUM}) begin
+        automatic vlen_t osum_last_elem = pe_req.vl - 1;
+        vfu_operation_d.osum_last = lane_id_i == osum_last_elem[idx_width(NrLanes)-1:0];
+      end
+
       // Mark the vector instruction as running
       vinsn_running_d[pe_req.id] = (vfu_operation_d.vfu != VFU_None) ? 1'b1 : 1'b0;
 
@@ -274,13 +350,31 @@ module lane_sequencer import ara_pkg::*; import rvv_pkg::*; import cf_math_pkg::
       // Exception 1: insn on mask vectors, as MASKU has to receive something from all lanes
       // and the partial results come from VALU and VMFPU.
       // Exception 2: during a reduction, all the lanes must cooperate anyway.
-      if (vfu_operation_d.vl == '0 && (vfu_operation_d.vfu inside {VFU_Alu, VFU_MFpu}) && !(vfu_operation_d.op inside {[VREDSUM:VWREDSUM], [VFREDUSUM:VFWREDOSUM]})) begin
+      if (lane_skips_vinsn(pe_req.op, pe_req.vfu, pe_req.vl, lane_id_i)) begin
         vfu_operation_valid_d = 1'b0;
         // We are already done with this instruction
         vinsn_done_d[pe_req.id] |= 1'b1;
         vinsn_running_d[pe_req.id] = 1'b0;
       end
 
+      // The ALU only forwards the indices of vrgather, and vd of the crypto instructions, to the
+      // Mask Unit
+      if (pe_req.op inside {VCOMPRESS, VAESKF1} ||
+          (pe_req.op inside {[VRGATHER:VRGATHEREI16], [VAESEF:VGMUL]} && vfu_operation_d.vl == '0)) begin
+        vfu_operation_valid_d = 1'b0;
+        vinsn_done_d[pe_req.id] |= 1'b1;
+        vinsn_running_d[pe_req.id] = 1'b0;
+      end
+
+      // The mask cache keeps, or gives back, the mask beats of this lane, one per word of
+      // results
+      if ((pe_req.mask_fill || pe_req.mask_hit) && vfu_operation_valid_d) begin
+        mask_cache_push_d  = 1'b1;
+        mask_cache_hit_d   = pe_req.mask_hit;
+        mask_cache_beats_d = (vfu_operation_d.vl + (8 >> int'(pe_req.vtype.vsew)) - 1) >>
+          (int'(EW64) - int'(pe_req.vtype.vsew));
+      end
+
       ////////////////////////
       //  Operand requests  //
       ////////////////////////
@@ -342,10 +436,16 @@ module lane_sequencer import ara_pkg::*; import rvv_pkg::*; import cf_math_pkg::
           };
           if ((operand_request_i[MaskM].vl << int'(pe_req.vtype.vsew)) *
               NrLanes * 8 != pe_req.vl) operand_request_i[MaskM].vl += 1;
-          operand_request_push[MaskM] = !pe_req.vm;
+          // The hits of the mask cache do not read v0
+          operand_request_push[MaskM] = !pe_req.vm && !pe_req.mask_hit;
         end
-        VFU_MFpu: begin
-          operand_request_i[MulFPUA] = '{
+        VFU_MFpu, VFU_MFpu2: begin
+          // Operand queues of the VMFPU of the instruction
+          automatic opqueue_e opq_a = pe_req.vfu == VFU_MFpu2 ? MulFPU2A : MulFPUA;
+          automatic opqueue_e opq_b = pe_req.vfu == VFU_MFpu2 ? MulFPU2B : MulFPUB;
+          automatic opqueue_e opq_c = pe_req.vfu == VFU_MFpu2 ? MulFPU2C : MulFPUC;
+
+          operand_request_i[opq_a] = '{
             id         : pe_req.id,
             vs         : pe_req.vs1,
             eew        : pe_req.eew_vs1,
@@ -363,9 +463,9 @@ module lane_sequencer import ara_pkg::*; import rvv_pkg::*; import cf_math_pkg::
             target_fu  : MFPU_ADDRGEN,
             default    : '0
           };
-          operand_request_push[MulFPUA] = pe_req.use_vs1;
+          operand_request_push[opq_a] = pe_req.use_vs1;
 
-          operand_request_i[MulFPUB] = '{
+          operand_request_i[opq_b] = '{
             id         : pe_req.id,
             vs         : pe_req.swap_vs2_vd_op ? pe_req.vd        : pe_req.vs2,
             eew        : pe_req.swap_vs2_vd_op ? pe_req.eew_vd_op : pe_req.eew_vs2,
@@ -385,10 +485,10 @@ module lane_sequencer import ara_pkg::*; import rvv_pkg::*; import cf_math_pkg::
             target_fu  : MFPU_ADDRGEN,
             default: '0
           };
-          operand_request_push[MulFPUB] = pe_req.swap_vs2_vd_op ?
+          operand_request_push[opq_b] = pe_req.swap_vs2_vd_op ?
           pe_req.use_vd_op : pe_req.use_vs2;
 
-          operand_request_i[MulFPUC] = '{
+          operand_request_i[opq_c] = '{
             id         : pe_req.id,
             vs         : pe_req.swap_vs2_vd_op ? pe_req.vs2            : pe_req.vd,
             eew        : pe_req.swap_vs2_vd_op ? pe_req.eew_vs2        : pe_req.eew_vd_op,
@@ -407,7 +507,7 @@ module lane_sequencer import ara_pkg::*; import rvv_pkg::*; import cf_math_pkg::
             target_fu  : MFPU_ADDRGEN,
             default : '0
           };
-          operand_request_push[MulFPUC] = pe_req.swap_vs2_vd_op ?
+          operand_request_push[opq_c] = pe_req.swap_vs2_vd_op ?
           pe_req.use_vs2 : pe_req.use_vd_op;
 
           // This vector instruction uses masks
@@ -425,7 +525,23 @@ module lane_sequencer import ara_pkg::*; import rvv_pkg::*; import cf_math_pkg::
           };
           if ((operand_request_i[MaskM].vl << int'(pe_req.vtype.vsew)) *
               NrLanes * 8 != pe_req.vl) operand_request_i[MaskM].vl += 1;
-          operand_request_push[MaskM] = !pe_req.vm;
+          operand_request_push[MaskM] = !pe_req.vm && !pe_req.mask_hit;
+        end
+        VFU_MxUnit: begin
+          // The outer products read vs2 from the MulFPUA opqueue, marked for the MXU
+          operand_request_i[MulFPUA] = '{
+            id       : pe_req.id,
+            vs       : pe_req.vs2,
+            eew      : pe_req.eew_vs2,
+            conv     : pe_req.conversion_vs2,
+            vtype    : pe_req.vtype,
+            vl       : vfu_operation_d.vl,
+            vstart   : vfu_operation_d.vstart,
+            hazard   : pe_req.hazard_vs2,
+            target_fu: MXU,
+            default  : '0
+          };
+          operand_request_push[MulFPUA] = pe_req.use_vs2;
         end
         VFU_LoadUnit : begin
           // This vector instruction uses masks
@@ -519,7 +635,7 @@ module lane_sequencer import ara_pkg::*; import rvv_pkg::*; import cf_math_pkg::
           // extra operand regardless of whether it is valid in this lane or not.
           if (operand_request_i[SlideAddrGenA].vl * NrLanes != pe_req_i.vl)
             operand_request_i[SlideAddrGenA].vl += 1;
-          operand_request_push[SlideAddrGenA] = pe_req_i.op == VSXE;
+          operand_request_push[SlideAddrGenA] = pe_req_i.op inside {[VSXE:VAMOMAXU]};
         end
 
         VFU_SlideUnit: begin
@@ -630,6 +746,7 @@ module lane_sequencer import ara_pkg::*; import rvv_pkg::*; import cf_math_pkg::
             id      : pe_req.id,
             vs      : pe_req.vs1,
             eew     : pe_req.eew_vs1,
+            conv    : pe_req.conversion_vs1,
             scale_vl: pe_req.scale_vl,
             vtype   : pe_req.vtype,
             vstart  : vfu_operation_d.vstart,
@@ -639,9 +756,17 @@ module lane_sequencer import ara_pkg::*; import rvv_pkg::*; import cf_math_pkg::
 
           // This is an operation that runs normally on the ALU, and then gets *condensed* and
           // reshuffled at the Mask Unit.
-          if (pe_req.op inside {[VMSEQ:VMSBC]}) begin
+          if (pe_req.op inside {[VMSEQ:VMSBC], [VRGATHER:VRGATHEREI16]}) begin
             operand_request_i[AluA].vl = vfu_operation_d.vl;
           end
+          // The crypto instructions read vd through the ALU, which forwards it to the Mask Unit
+          else if (pe_req.op inside {[VAESKF1:VGMUL]}) begin
+            operand_request_i[AluA].vs     = pe_req.vd;
+            operand_request_i[AluA].eew    = pe_req.eew_vd_op;
+            operand_request_i[AluA].conv   = OpQueueConversionNone;
+            operand_request_i[AluA].hazard = pe_req.hazard_vd;
+            operand_request_i[AluA].vl     = vfu_operation_d.vl;
+          end
           // This is an operation that runs normally on the ALU, and then gets reshuffled at the
           // Mask Unit.
           else begin
@@ -652,7 +777,9 @@ module lane_sequencer import ara_pkg::*; import rvv_pkg::*; import cf_math_pkg::
             if ((operand_request_i[AluA].vl << (int'(EW64) - int'(pe_req.eew_vs1))) * NrLanes !=
                 pe_req.vl) operand_request_i[AluA].vl += 1;
           end
-          operand_request_push[AluA] = pe_req.use_vs1 && !(pe_req.op inside {[VMFEQ:VMFGE]});
+          operand_request_push[AluA] = pe_req.use_vs1 && !(pe_req.op inside {[VMFEQ:VMFGE], VCOMPRESS});
+          if (pe_req.op inside {[VAESKF1:VGMUL]})
+            operand_request_push[AluA] = pe_req.use_vd_op && vfu_operation_d.vl != '0;
 
           operand_request_i[AluB] = '{
             id      : pe_req.id,
@@ -679,7 +806,7 @@ module lane_sequencer import ara_pkg::*; import rvv_pkg::*; import cf_math_pkg::
             if ((operand_request_i[AluB].vl << (int'(EW64) - int'(pe_req.eew_vs2))) * NrLanes !=
                 pe_req.vl) operand_request_i[AluB].vl += 1;
           end
-          operand_request_push[AluB] = pe_req.use_vs2 && !(pe_req.op inside {[VMFEQ:VMFGE]});
+          operand_request_push[AluB] = pe_req.use_vs2 && !(pe_req.op inside {[VMFEQ:VMFGE], [VRGATHER:VGMUL]});
 
           operand_request_i[MulFPUA] = '{
             id      : pe_req.id,
@@ -729,6 +856,38 @@ module lane_sequencer import ara_pkg::*; import rvv_pkg::*; import cf_math_pkg::
             pe_req.vl) operand_request_i[MaskB].vl += 1;
           operand_request_push[MaskB] = pe_req.use_vd_op;
 
+          // The permutations read vs2 on MaskB instead
+          if (pe_req.op inside {[VRGATHER:VCOMPRESS]}) begin
+            operand_request_i[MaskB].vs     = pe_req.vs2;
+            operand_request_i[MaskB].eew    = pe_req.eew_vs2;
+            operand_request_i[MaskB].hazard = pe_req.hazard_vs2;
+            // vrgather reads the whole register of this pass
+            if (pe_req.op != VCOMPRESS) begin
+              operand_request_i[MaskB].vl     = (VLENB / NrLanes) >> int'(pe_req.eew_vs2);
+              operand_request_i[MaskB].vstart = pe_req.stride / NrLanes;
+            end
+            // vcompress reads all the beats with valid elements, whole
+            else begin
+              automatic vlen_t beats = (pe_req.vl + (NrLanes << (int'(EW64) - int'(pe_req.eew_vs2))) - 1) >>
+                ($clog2(NrLanes) + int'(EW64) - int'(pe_req.eew_vs2));
+              operand_request_i[MaskB].vl     = beats << (int'(EW64) - int'(pe_req.eew_vs2));
+              operand_request_i[MaskB].vstart = '0;
+            end
+            operand_request_push[MaskB] = 1'b1;
+          end
+
+          // The crypto instructions read vs2 on MaskB as well, all the beats with valid element
+          // groups, whole. The .vs forms only need the first element group, in the first beat.
+          if (pe_req.op inside {[VAESKF1:VGMUL]}) begin
+            automatic vlen_t beats = (pe_req.vl + 2*NrLanes - 1) >> ($clog2(NrLanes) + 1);
+            operand_request_i[MaskB].vs     = pe_req.vs2;
+            operand_request_i[MaskB].eew    = pe_req.eew_vs2;
+            operand_request_i[MaskB].hazard = pe_req.hazard_vs2;
+            operand_request_i[MaskB].vl     = pe_req.is_broadcast ? 2 : beats << 1;
+            operand_request_i[MaskB].vstart = '0;
+            operand_request_push[MaskB]     = 1'b1;
+          end
+
           operand_request_i[MaskM] = '{
             id     : pe_req.id,
             vs     : VMASK,
@@ -745,6 +904,27 @@ module lane_sequencer import ara_pkg::*; import rvv_pkg::*; import cf_math_pkg::
             operand_request_i[MaskM].vl += 1;
           end
           operand_request_push[MaskM] = !pe_req.vm;
+
+          // The Mask Unit counts the mask bits of the permutations in words. vcompress reads its
+          // selection mask from vs1.
+          if (pe_req.op inside {[VRGATHER:VCOMPRESS]}) begin
+            operand_request_i[MaskM].eew = EW64;
+            if (pe_req.op == VCOMPRESS) begin
+              operand_request_i[MaskM].vs     = pe_req.vs1;
+              operand_request_i[MaskM].hazard = pe_req.hazard_vs1;
+              operand_request_push[MaskM]     = 1'b1;
+            end
+          end
+
+          // The SHA-2 and GHASH instructions read vs1 on MaskM, like vs2
+          if (pe_req.op inside {[VAESKF1:VGMUL]}) begin
+            operand_request_i[MaskM].vs     = pe_req.vs1;
+            operand_request_i[MaskM].eew    = pe_req.eew_vs1;
+            operand_request_i[MaskM].hazard = pe_req.hazard_vs1;
+            operand_request_i[MaskM].vl     = operand_request_i[MaskB].vl;
+            operand_request_i[MaskM].vstart = '0;
+            operand_request_push[MaskM]     = pe_req.use_vs1;
+          end
         end
         VFU_None: begin
           operand_request_i[MaskB] = '{
@@ -764,6 +944,8 @@ module lane_sequencer import ara_pkg::*; import rvv_pkg::*; import cf_math_pkg::
         end
         default:;
       endcase
+
+      if (drop_vinsn) operand_request_push = '0;
     end
   end: sequencer
 
@@ -775,8 +957,14 @@ module lane_sequencer import ara_pkg::*; import rvv_pkg::*; import cf_math_pkg::
       vfu_operation_o       <= '0;
       vfu_operation_valid_o <= 1'b0;
 
-      alu_vinsn_done_o  <= 1'b0;
-      mfpu_vinsn_done_o <= 1'b0;
+      mask_cache_push_o  <= 1'b0;
+      mask_cache_hit_o   <= 1'b0;
+      mask_cache_beats_o <= '0;
+
+      alu_vinsn_done_o   <= 1'b0;
+      mfpu_vinsn_done_o  <= 1'b0;
+      mfpu2_vinsn_done_o <= 1'b0;
+      mxu_vinsn_done_o   <= 1'b0;
     end else begin
       vinsn_done_q    <= vinsn_done_d;
       vinsn_running_q <= vinsn_running_d;
@@ -784,9 +972,62 @@ module lane_sequencer import ara_pkg::*; import rvv_pkg::*; import cf_math_pkg::
       vfu_operation_o       <= vfu_operation_d;
       vfu_operation_valid_o <= vfu_operation_valid_d;
 
-      alu_vinsn_done_o  <= alu_vinsn_done_d;
-      mfpu_vinsn_done_o <= mfpu_vinsn_done_d;
+      mask_cache_push_o  <= mask_cache_push_d;
+      mask_cache_hit_o   <= mask_cache_hit_d;
+      mask_cache_beats_o <= mask_cache_beats_d;
+
+      alu_vinsn_done_o   <= alu_vinsn_done_d;
+      mfpu_vinsn_done_o  <= mfpu_vinsn_done_d;
+      mfpu2_vinsn_done_o <= mfpu2_vinsn_done_d;
+      mxu_vinsn_done_o   <= mxu_vinsn_done_d;
     end
   end
 
+  /////////////////////////
+  //  VFU clock enables  //
+  /////////////////////////
+
+  // Instructions issued to the VALU and to the VMFPUs and still running. A unit keeps its
+  // clock from the cycle its operation is issued until one cycle after the main sequencer
+  // retired all of its instructions. The mask instructions are accepted by the VALU and by the
+  // first VMFPU.
+  logic [NrVInsn-1:0] alu_vinsn_d, alu_vinsn_q;
+  logic [NrVInsn-1:0] mfpu_vinsn_d, mfpu_vinsn_q;
+  logic [NrVInsn-1:0] mfpu2_vinsn_d, mfpu2_vinsn_q;
+  logic               alu_clk_en_q, mfpu_clk_en_q, mfpu2_clk_en_q;
+
+  always_comb begin: p_vfu_clk_en
+    alu_vinsn_d   = alu_vinsn_q & pe_vinsn_running_i;
+    mfpu_vinsn_d  = mfpu_vinsn_q & pe_vinsn_running_i;
+    mfpu2_vinsn_d = mfpu2_vinsn_q & pe_vinsn_running_i;
+
+    if (vfu_operation_valid_d) begin
+      if (vfu_operation_d.vfu inside {VFU_Alu, VFU_MaskUnit}) alu_vinsn_d[vfu_operation_d.id] = 1'b1;
+      if (vfu_operation_d.vfu inside {VFU_MFpu, VFU_MaskUnit}) mfpu_vinsn_d[vfu_operation_d.id] = 1'b1;
+      if (vfu_operation_d.vfu == VFU_MFpu2) mfpu2_vinsn_d[vfu_operation_d.id] = 1'b1;
+    end
+
+    alu_clk_en_o   = |alu_vinsn_q || alu_clk_en_q;
+    mfpu_clk_en_o  = |mfpu_vinsn_q || mfpu_clk_en_q;
+    mfpu2_clk_en_o = |mfpu2_vinsn_q || mfpu2_clk_en_q;
+  end: p_vfu_clk_en
+
+  always_ff @(posedge clk_i or negedge rst_ni) begin: p_vfu_clk_en_ff
+    if (!rst_ni) begin
+      alu_vinsn_q    <= '0;
+      mfpu_vinsn_q   <= '0;
+      mfpu2_vinsn_q  <= '0;
+      alu_clk_en_q   <= 1'b0;
+      mfpu_clk_en_q  <= 1'b0;
+      mfpu2_clk_en_q <= 1'b0;
+    end else begin
+      alu_vinsn_q    <= alu_vinsn_d;
+      mfpu_vinsn_q   <= mfpu_vinsn_d;
+      mfpu2_vinsn_q  <= mfpu2_vinsn_d;
+      alu_clk_en_q   <= |alu_vinsn_q;
+      mfpu_clk_en_q  <= |mfpu_vinsn_q;
+      mfpu2_clk_en_q <= |mfpu2_vinsn_q;
+    end
+  end: p_vfu_clk_en_ff
+
 endmodule : lane_sequencer
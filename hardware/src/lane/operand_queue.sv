@@ -199,8 +199,8 @@ module operand_queue import ara_pkg::*; import rvv_pkg::*; import cf_math_pkg::i
             unique case (cmd.eew)
               EW16: begin
                 unique case (cmd.ntr_red)
-                  2'b01: ntr.w64 = {4{16'h7c00}};
-                  2'b10: ntr.w64 = {4{16'hfc00}};
+                  2'b01: ntr.w64 = cmd.altfmt ? {4{16'h7f80}} : {4{16'h7c00}};
+                  2'b10: ntr.w64 = cmd.altfmt ? {4{16'hff80}} : {4{16'hfc00}};
                   default:;
                 endcase
               end
@@ -339,6 +339,9 @@ module operand_queue import ara_pkg::*; import rvv_pkg::*; import cf_math_pkg::i
                 fp32.m = {fp16.m, 13'b0};
 
                 conv_operand[32*e +: 32] = fp32;
+                // BF16 is the upper half of FP32
+                if (FPAltFmtSupport && cmd.altfmt)
+                  conv_operand[32*e +: 32] = {ibuf_operand[8*select + 32*e +: 16], 16'b0};
               end
             end
             {EW32, 1'b?, 1'b1, 1'b1}: begin
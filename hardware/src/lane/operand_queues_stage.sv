@@ -31,6 +31,14 @@ module operand_queues_stage import ara_pkg::*; import rvv_pkg::*; import cf_math
     output elen_t              [2:0]                 mfpu_operand_o,
     output logic               [2:0]                 mfpu_operand_valid_o,
     input  logic               [2:0]                 mfpu_operand_ready_i,
+    // Second Multiplier/FPU
+    output elen_t              [2:0]                 mfpu2_operand_o,
+    output logic               [2:0]                 mfpu2_operand_valid_o,
+    input  logic               [2:0]                 mfpu2_operand_ready_i,
+    // Matrix outer-product unit
+    output elen_t                                    mxu_operand_o,
+    output logic                                     mxu_operand_valid_o,
+    input  logic                                     mxu_operand_ready_i,
     // Store unit
     output elen_t                                    stu_operand_o,
     output logic                                     stu_operand_valid_o,
@@ -107,14 +115,26 @@ module operand_queues_stage import ara_pkg::*; import rvv_pkg::*; import cf_math
   //  Multiplier/FPU  //
   //////////////////////
 
+  // The MulFPUA opqueue also holds vs2 of the outer products, for the MXU
+  elen_t      mfpu_a_operand;
+  target_fu_e mfpu_a_target_fu;
+  logic       mfpu_a_valid, mfpu_a_ready;
+
+  assign mfpu_operand_o[0]       = mfpu_a_operand;
+  assign mfpu_operand_valid_o[0] = mfpu_a_valid && mfpu_a_target_fu != MXU;
+  assign mxu_operand_o           = mfpu_a_operand;
+  assign mxu_operand_valid_o     = mfpu_a_valid && mfpu_a_target_fu == MXU;
+  assign mfpu_a_ready            = mfpu_a_target_fu == MXU ? mxu_operand_ready_i :
+                                                             mfpu_operand_ready_i[0];
+
   operand_queue #(
-    .CmdBufDepth   (MfpuInsnQueueDepth ),
-    .DataBufDepth  (5                  ),
-    .FPUSupport    (FPUSupport         ),
-    .NrLanes       (NrLanes            ),
-    .SupportIntExt2(1'b1               ),
-    .SupportReduct (1'b1               ),
-    .SupportNtrVal (1'b0               )
+    .CmdBufDepth   (MfpuInsnQueueDepth + (MxuTiles != 0 ? MfpuInsnQueueDepth : 0)),
+    .DataBufDepth  (5                                                           ),
+    .FPUSupport    (FPUSupport                                                  ),
+    .NrLanes       (NrLanes                                                     ),
+    .SupportIntExt2(1'b1                                                        ),
+    .SupportReduct (1'b1                                                        ),
+    .SupportNtrVal (1'b0                                                        )
   ) i_operand_queue_mfpu_a (
     .clk_i                    (clk_i                             ),
     .rst_ni                   (rst_ni                            ),
@@ -125,10 +145,10 @@ module operand_queues_stage import ara_pkg::*; import rvv_pkg::*; import cf_math
     .operand_valid_i          (operand_valid_i[MulFPUA]          ),
     .operand_issued_i         (operand_issued_i[MulFPUA]         ),
     .operand_queue_ready_o    (operand_queue_ready_o[MulFPUA]    ),
-    .operand_o                (mfpu_operand_o[0]                 ),
-    .operand_target_fu_o      (/* Unused */                      ),
-    .operand_valid_o          (mfpu_operand_valid_o[0]           ),
-    .operand_ready_i          (mfpu_operand_ready_i[0]           )
+    .operand_o                (mfpu_a_operand                    ),
+    .operand_target_fu_o      (mfpu_a_target_fu                  ),
+    .operand_valid_o          (mfpu_a_valid                      ),
+    .operand_ready_i          (mfpu_a_ready                      )
   );
 
   operand_queue #(
@@ -179,6 +199,88 @@ module operand_queues_stage import ara_pkg::*; import rvv_pkg::*; import cf_math
     .operand_ready_i          (mfpu_operand_ready_i[2]           )
   );
 
+  ///////////////////////////////
+  //  Second Multiplier/FPU  //
+  ///////////////////////////////
+
+  if (DualMfpu) begin: gen_mfpu2_opqueues
+    operand_queue #(
+      .CmdBufDepth   (MfpuInsnQueueDepth ),
+      .DataBufDepth  (5                  ),
+      .FPUSupport    (FPUSupport         ),
+      .NrLanes       (NrLanes            ),
+      .SupportIntExt2(1'b1               ),
+      .SupportReduct (1'b1               ),
+      .SupportNtrVal (1'b0               )
+    ) i_operand_queue_mfpu2_a (
+      .clk_i                    (clk_i                             ),
+      .rst_ni                   (rst_ni                            ),
+      .lane_id_i                (lane_id_i                         ),
+      .operand_queue_cmd_i      (operand_queue_cmd_i[MulFPU2A]     ),
+      .operand_queue_cmd_valid_i(operand_queue_cmd_valid_i[MulFPU2A]),
+      .operand_i                (operand_i[MulFPU2A]               ),
+      .operand_valid_i          (operand_valid_i[MulFPU2A]         ),
+      .operand_issued_i         (operand_issued_i[MulFPU2A]        ),
+      .operand_queue_ready_o    (operand_queue_ready_o[MulFPU2A]   ),
+      .operand_o                (mfpu2_operand_o[0]                ),
+      .operand_target_fu_o      (/* Unused */                      ),
+      .operand_valid_o          (mfpu2_operand_valid_o[0]          ),
+      .operand_ready_i          (mfpu2_operand_ready_i[0]          )
+    );
+
+    operand_queue #(
+      .CmdBufDepth   (MfpuInsnQueueDepth ),
+      .DataBufDepth  (5                  ),
+      .FPUSupport    (FPUSupport         ),
+      .NrLanes       (NrLanes            ),
+      .SupportIntExt2(1'b1               ),
+      .SupportReduct (1'b1               ),
+      .SupportNtrVal (1'b1               )
+    ) i_operand_queue_mfpu2_b (
+      .clk_i                    (clk_i                             ),
+      .rst_ni                   (rst_ni                            ),
+      .lane_id_i                (lane_id_i                         ),
+      .operand_queue_cmd_i      (operand_queue_cmd_i[MulFPU2B]     ),
+      .operand_queue_cmd_valid_i(operand_queue_cmd_valid_i[MulFPU2B]),
+      .operand_i                (operand_i[MulFPU2B]               ),
+      .operand_valid_i          (operand_valid_i[MulFPU2B]         ),
+      .operand_issued_i         (operand_issued_i[MulFPU2B]        ),
+      .operand_queue_ready_o    (operand_queue_ready_o[MulFPU2B]   ),
+      .operand_o                (mfpu2_operand_o[1]                ),
+      .operand_target_fu_o      (/* Unused */                      ),
+      .operand_valid_o          (mfpu2_operand_valid_o[1]          ),
+      .operand_ready_i          (mfpu2_operand_ready_i[1]          )
+    );
+
+    operand_queue #(
+      .CmdBufDepth   (MfpuInsnQueueDepth ),
+      .DataBufDepth  (5                  ),
+      .FPUSupport    (FPUSupport         ),
+      .NrLanes       (NrLanes            ),
+      .SupportIntExt2(1'b1               ),
+      .SupportReduct (1'b1               ),
+      .SupportNtrVal (1'b1               )
+    ) i_operand_queue_mfpu2_c (
+      .clk_i                    (clk_i                             ),
+      .rst_ni                   (rst_ni                            ),
+      .lane_id_i                (lane_id_i                         ),
+      .operand_queue_cmd_i      (operand_queue_cmd_i[MulFPU2C]     ),
+      .operand_queue_cmd_valid_i(operand_queue_cmd_valid_i[MulFPU2C]),
+      .operand_i                (operand_i[MulFPU2C]               ),
+      .operand_valid_i          (operand_valid_i[MulFPU2C]         ),
+      .operand_issued_i         (operand_issued_i[MulFPU2C]        ),
+      .operand_queue_ready_o    (operand_queue_ready_o[MulFPU2C]   ),
+      .operand_o                (mfpu2_operand_o[2]                ),
+      .operand_target_fu_o      (/* Unused */                      ),
+      .operand_valid_o          (mfpu2_operand_valid_o[2]          ),
+      .operand_ready_i          (mfpu2_operand_ready_i[2]          )
+    );
+  end: gen_mfpu2_opqueues else begin: gen_no_mfpu2_opqueues
+    assign operand_queue_ready_o[MulFPU2C:MulFPU2A] = '0;
+    assign mfpu2_operand_o                          = '0;
+    assign mfpu2_operand_valid_o                    = '0;
+  end: gen_no_mfpu2_opqueues
+
   ///////////////////////
   //  Load/Store Unit  //
   ///////////////////////
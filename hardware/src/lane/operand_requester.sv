@@ -7,6 +7,8 @@
 // This stage is responsible for requesting individual elements from the vector
 // register file, in order, and sending them to the corresponding operand
 // queues. This stage also includes the VRF arbiter.
+// The store operands that the ALU or the MFPU are writing are forwarded to the
+// store operand queue, instead of being read back from the VRF.
 
 module operand_requester import ara_pkg::*; import rvv_pkg::*; #(
     parameter  int  unsigned NrLanes = 0,
@@ -30,11 +32,19 @@ module operand_requester import ara_pkg::*; import rvv_pkg::*; #(
     output elen_t                [NrBanks-1:0]         vrf_wdata_o,
     output strb_t                [NrBanks-1:0]         vrf_be_o,
     output opqueue_e             [NrBanks-1:0]         vrf_tgt_opqueue_o,
+    // Write port of the VRF banks, with VrfDualPort
+    output logic                 [NrBanks-1:0]         vrf_wr_req_o,
+    output vaddr_t               [NrBanks-1:0]         vrf_wr_addr_o,
+    output elen_t                [NrBanks-1:0]         vrf_wr_wdata_o,
+    output strb_t                [NrBanks-1:0]         vrf_wr_be_o,
     // Interface with the operand queues
     input  logic                 [NrOperandQueues-1:0] operand_queue_ready_i,
     output logic                 [NrOperandQueues-1:0] operand_issued_o,
     output operand_queue_cmd_t   [NrOperandQueues-1:0] operand_queue_cmd_o,
     output logic                 [NrOperandQueues-1:0] operand_queue_cmd_valid_o,
+    // Store operands forwarded from the VFU results, with the latency of the VRF
+    output elen_t                                      stu_bypass_operand_o,
+    output logic                                       stu_bypass_valid_o,
     // Interface with the VFUs
     // ALU
     input  logic                                       alu_result_req_i,
@@ -50,6 +60,19 @@ module operand_requester import ara_pkg::*; import rvv_pkg::*; #(
     input  elen_t                                      mfpu_result_wdata_i,
     input  strb_t                                      mfpu_result_be_i,
     output logic                                       mfpu_result_gnt_o,
+    input  logic                                       mfpu2_result_req_i,
+    input  vid_t                                       mfpu2_result_id_i,
+    input  vaddr_t                                     mfpu2_result_addr_i,
+    input  elen_t                                      mfpu2_result_wdata_i,
+    input  strb_t                                      mfpu2_result_be_i,
+    output logic                                       mfpu2_result_gnt_o,
+    // Matrix outer-product unit
+    input  logic                                       mxu_result_req_i,
+    input  vid_t                                       mxu_result_id_i,
+    input  vaddr_t                                     mxu_result_addr_i,
+    input  elen_t                                      mxu_result_wdata_i,
+    input  strb_t                                      mxu_result_be_i,
+    output logic                                       mxu_result_gnt_o,
     // Mask unit
     input  logic                                       masku_result_req_i,
     input  vid_t                                       masku_result_id_i,
@@ -73,7 +96,10 @@ module operand_requester import ara_pkg::*; import rvv_pkg::*; #(
     input  elen_t                                      ldu_result_wdata_i,
     input  strb_t                                      ldu_result_be_i,
     output logic                                       ldu_result_gnt_o,
-    output logic                                       ldu_result_final_gnt_o
+    output logic                                       ldu_result_final_gnt_o,
+    // Performance events
+    output logic                                       vrf_bank_conflict_o,
+    output logic                                       vrf_rw_conflict_o
   );
 
   import cf_math_pkg::idx_width;
@@ -116,18 +142,31 @@ module operand_requester import ara_pkg::*; import rvv_pkg::*; #(
   strb_t  sldu_result_be;
   logic   sldu_result_req;
   logic   sldu_result_gnt;
-  stream_register #(.T(stream_register_payload_t)) i_sldu_stream_register (
-    .clk_i     (clk_i                                                                        ),
-    .rst_ni    (rst_ni                                                                       ),
-    .clr_i     (1'b0                                                                         ),
-    .testmode_i(1'b0                                                                         ),
-    .data_i    ({sldu_result_id_i, sldu_result_addr_i, sldu_result_wdata_i, sldu_result_be_i}),
-    .valid_i   (sldu_result_req_i                                                            ),
-    .ready_o   (sldu_result_gnt_o                                                            ),
-    .data_o    ({sldu_result_id, sldu_result_addr, sldu_result_wdata, sldu_result_be}        ),
-    .valid_o   (sldu_result_req                                                              ),
-    .ready_i   (sldu_result_gnt                                                              )
-  );
+  if (SlideMaskCut) begin: gen_sldu_spill_register
+    spill_register #(.T(stream_register_payload_t)) i_sldu_spill_register (
+      .clk_i  (clk_i                                                                        ),
+      .rst_ni (rst_ni                                                                       ),
+      .data_i ({sldu_result_id_i, sldu_result_addr_i, sldu_result_wdata_i, sldu_result_be_i}),
+      .valid_i(sldu_result_req_i                                                            ),
+      .ready_o(sldu_result_gnt_o                                                            ),
+      .data_o ({sldu_result_id, sldu_result_addr, sldu_result_wdata, sldu_result_be}        ),
+      .valid_o(sldu_result_req                                                              ),
+      .ready_i(sldu_result_gnt                                                              )
+    );
+  end else begin: gen_sldu_stream_register
+    stream_register #(.T(stream_register_payload_t)) i_sldu_stream_register (
+      .clk_i     (clk_i                                                                        ),
+      .rst_ni    (rst_ni                                                                       ),
+      .clr_i     (1'b0                                                                         ),
+      .testmode_i(1'b0                                                                         ),
+      .data_i    ({sldu_result_id_i, sldu_result_addr_i, sldu_result_wdata_i, sldu_result_be_i}),
+      .valid_i   (sldu_result_req_i                                                            ),
+      .ready_o   (sldu_result_gnt_o                                                            ),
+      .data_o    ({sldu_result_id, sldu_result_addr, sldu_result_wdata, sldu_result_be}        ),
+      .valid_o   (sldu_result_req                                                              ),
+      .ready_i   (sldu_result_gnt                                                              )
+    );
+  end
 
   // Mask unit
   vid_t   masku_result_id;
@@ -136,18 +175,31 @@ module operand_requester import ara_pkg::*; import rvv_pkg::*; #(
   strb_t  masku_result_be;
   logic   masku_result_req;
   logic   masku_result_gnt;
-  stream_register #(.T(stream_register_payload_t)) i_masku_stream_register (
-    .clk_i     (clk_i                                                                            ),
-    .rst_ni    (rst_ni                                                                           ),
-    .clr_i     (1'b0                                                                             ),
-    .testmode_i(1'b0                                                                             ),
-    .data_i    ({masku_result_id_i, masku_result_addr_i, masku_result_wdata_i, masku_result_be_i}),
-    .valid_i   (masku_result_req_i                                                               ),
-    .ready_o   (masku_result_gnt_o                                                               ),
-    .data_o    ({masku_result_id, masku_result_addr, masku_result_wdata, masku_result_be}        ),
-    .valid_o   (masku_result_req                                                                 ),
-    .ready_i   (masku_result_gnt                                                                 )
-  );
+  if (SlideMaskCut) begin: gen_masku_spill_register
+    spill_register #(.T(stream_register_payload_t)) i_masku_spill_register (
+      .clk_i  (clk_i                                                                            ),
+      .rst_ni (rst_ni                                                                           ),
+      .data_i ({masku_result_id_i, masku_result_addr_i, masku_result_wdata_i, masku_result_be_i}),
+      .valid_i(masku_result_req_i                                                               ),
+      .ready_o(masku_result_gnt_o                                                               ),
+      .data_o ({masku_result_id, masku_result_addr, masku_result_wdata, masku_result_be}        ),
+      .valid_o(masku_result_req                                                                 ),
+      .ready_i(masku_result_gnt                                                                 )
+    );
+  end else begin: gen_masku_stream_register
+    stream_register #(.T(stream_register_payload_t)) i_masku_stream_register (
+      .clk_i     (clk_i                                                                            ),
+      .rst_ni    (rst_ni                                                                           ),
+      .clr_i     (1'b0                                                                             ),
+      .testmode_i(1'b0                                                                             ),
+      .data_i    ({masku_result_id_i, masku_result_addr_i, masku_result_wdata_i, masku_result_be_i}),
+      .valid_i   (masku_result_req_i                                                               ),
+      .ready_o   (masku_result_gnt_o                                                               ),
+      .data_o    ({masku_result_id, masku_result_addr, masku_result_wdata, masku_result_be}        ),
+      .valid_o   (masku_result_req                                                                 ),
+      .ready_i   (masku_result_gnt                                                                 )
+    );
+  end
 
   // The very last grant must happen when the instruction actually write in the VRF
   // Otherwise the dependency is freed in advance
@@ -182,6 +234,8 @@ module operand_requester import ara_pkg::*; import rvv_pkg::*; #(
     // Which vector instructions are writing something?
     vinsn_result_written_d[alu_result_id_i] |= alu_result_gnt_o;
     vinsn_result_written_d[mfpu_result_id_i] |= mfpu_result_gnt_o;
+    vinsn_result_written_d[mfpu2_result_id_i] |= mfpu2_result_gnt_o;
+    vinsn_result_written_d[mxu_result_id_i] |= mxu_result_gnt_o;
     vinsn_result_written_d[masku_result_id] |= masku_result_gnt;
     vinsn_result_written_d[ldu_result_id] |= ldu_result_gnt;
     vinsn_result_written_d[sldu_result_id] |= sldu_result_gnt;
@@ -195,6 +249,25 @@ module operand_requester import ara_pkg::*; import rvv_pkg::*; #(
     end
   end
 
+  /////////////////
+  //  VRF banks  //
+  /////////////////
+
+  // Words of a vector register in a lane
+  localparam int unsigned VRegWords = VLENB / NrLanes / 8;
+  // The hash needs the vector register ID to be above the bank index in the address
+  localparam bit BankHash = VrfBankHash && VRegWords >= NrBanks;
+
+  // Bank of a VRF word. The hash XORs the vector register ID, folded on the width of the
+  // bank index, with the element bits of the bank index. For a given row, it only
+  // permutes the banks, so every word still has its own place.
+  function automatic logic [idx_width(NrBanks)-1:0] vrf_bank(vaddr_t addr);
+    vrf_bank = addr[idx_width(NrBanks)-1:0];
+    if (BankHash)
+      for (int unsigned i = 0; i < $bits(vreg_t); i += idx_width(NrBanks))
+        vrf_bank ^= (addr >> ($clog2(VRegWords) + i));
+  endfunction : vrf_bank
+
   ///////////////////////
   //  Operand request  //
   ///////////////////////
@@ -208,8 +281,9 @@ module operand_requester import ara_pkg::*; import rvv_pkg::*; #(
 
   // A set bit indicates that the the master q is requesting access to the bank b
   // Masters 0 to NrOperandQueues-1 correspond to the operand queues.
-  // The remaining four masters correspond to the ALU, the MFPU, the MASKU, the VLDU, and the SLDU.
-  localparam NrMasters = NrOperandQueues + 5;
+  // The remaining masters correspond to the ALU, the two MFPUs, the MXU, the MASKU, the VLDU, and
+  // the SLDU.
+  localparam NrMasters = NrOperandQueues + 7;
 
   typedef struct packed {
     vaddr_t addr;
@@ -241,7 +315,7 @@ module operand_requester import ara_pkg::*; import rvv_pkg::*; #(
       // Hazards between vector instructions
       logic [NrVInsn-1:0] hazard;
 
-      // Widening instructions produces two writes of every read
+      // Widening instructions produces two writes of every read of their narrow operands
       // In case of a WAW with a previous instruction,
       // read once every two writes of the previous instruction
       logic is_widening;
@@ -250,10 +324,44 @@ module operand_requester import ara_pkg::*; import rvv_pkg::*; #(
     } requester_d, requester_q;
 
 
+    // The store operands are taken from the results of the ALU and the MFPU while they are
+    // written to the VRF. Only whole words of the instruction the store waits for are forwarded.
+    logic bypass_alu, bypass_mfpu, bypass;
+    // An operand was forwarded in the previous cycle
+    logic bypass_q;
+    if (requester == StA) begin: gen_stu_bypass
+      assign bypass_alu  = alu_result_gnt_o && requester_q.hazard[alu_result_id_i] &&
+                           alu_result_addr_i == requester_q.addr && &alu_result_be_i;
+      assign bypass_mfpu = mfpu_result_gnt_o && requester_q.hazard[mfpu_result_id_i] &&
+                           mfpu_result_addr_i == requester_q.addr && &mfpu_result_be_i;
+      assign bypass      = state_q == REQUESTING && operand_queue_ready_i[requester] &&
+                           (bypass_alu || bypass_mfpu);
+
+      // The forwarded operand reaches the operand queue when the VRF read would have
+      always_ff @(posedge clk_i or negedge rst_ni) begin
+        if (!rst_ni) begin
+          stu_bypass_valid_o   <= 1'b0;
+          stu_bypass_operand_o <= '0;
+        end else begin
+          stu_bypass_valid_o <= bypass;
+          if (bypass)
+            stu_bypass_operand_o <= bypass_mfpu ? mfpu_result_wdata_i : alu_result_wdata_i;
+        end
+      end
+      assign bypass_q = stu_bypass_valid_o;
+    end: gen_stu_bypass else begin: gen_no_bypass
+      assign bypass_alu  = 1'b0;
+      assign bypass_mfpu = 1'b0;
+      assign bypass      = 1'b0;
+      assign bypass_q    = 1'b0;
+    end: gen_no_bypass
+
     // Is there a hazard during this cycle?
+    // The write of a forwarded operand does not allow another read
     logic stall;
     assign stall = |(requester_q.hazard & ~(vinsn_result_written_q &
-                   (~{NrVInsn{requester_q.is_widening}} | requester_q.waw_hazard_counter)));
+                   (~{NrVInsn{requester_q.is_widening}} | requester_q.waw_hazard_counter))) ||
+                   (bypass_q && |requester_q.hazard);
 
     // Did we get a grant?
     logic [NrBanks-1:0] operand_requester_gnt;
@@ -262,7 +370,7 @@ module operand_requester import ara_pkg::*; import rvv_pkg::*; #(
     end
 
     // Did we issue a word to this operand queue?
-    assign operand_issued_o[requester] = |(operand_requester_gnt);
+    assign operand_issued_o[requester] = |(operand_requester_gnt) || bypass;
 
     always_comb begin: operand_requester
       // Maintain state
@@ -303,7 +411,8 @@ module operand_requester import ara_pkg::*; import rvv_pkg::*; #(
               conv     : operand_request_i[requester].conv,
               ntr_red  : operand_request_i[requester].cvt_resize,
               target_fu: operand_request_i[requester].target_fu,
-              is_reduct: operand_request_i[requester].is_reduct
+              is_reduct: operand_request_i[requester].is_reduct,
+              altfmt   : operand_request_i[requester].vtype.altfmt
             };
             // The length should be at least one after the rescaling
             if (operand_queue_cmd_o[requester].vl == '0)
@@ -327,7 +436,10 @@ module operand_requester import ara_pkg::*; import rvv_pkg::*; #(
                               operand_request_i[requester].vl,
               vew         : operand_request_i[requester].eew,
               hazard      : operand_request_i[requester].hazard,
-              is_widening : operand_request_i[requester].cvt_resize == CVT_WIDE,
+              // The operands of the EEW of vd, e.g., the accumulator of vfwmacc, are read once
+              // per write, so that a chain of widening MACs keeps one word per cycle
+              is_widening : operand_request_i[requester].cvt_resize == CVT_WIDE &&
+                            operand_request_i[requester].eew != operand_request_i[requester].vtype.vsew,
               default: '0
             };
             // The length should be at least one after the rescaling
@@ -350,18 +462,18 @@ module operand_requester import ara_pkg::*; import rvv_pkg::*; #(
 
           if (operand_queue_ready_i[requester]) begin
             // Bank we are currently requesting
-            automatic int bank = requester_q.addr[idx_width(NrBanks)-1:0];
+            automatic int bank = vrf_bank(requester_q.addr);
 
-            // Operand request
-            operand_req[bank][requester] = !stall;
+            // Operand request. A forwarded operand is not read.
+            operand_req[bank][requester] = !stall && !bypass;
             operand_payload[requester]   = '{
               addr   : requester_q.addr >> $clog2(NrBanks),
               opqueue: opqueue_e'(requester),
               default: '0
             };
 
-            // Received a grant.
-            if (|operand_requester_gnt) begin
+            // Received a grant, or forwarded the operand.
+            if (|operand_requester_gnt || bypass) begin
               // Bump the address pointer
               requester_d.addr = requester_q.addr + 1'b1;
 
@@ -392,7 +504,8 @@ module operand_requester import ara_pkg::*; import rvv_pkg::*; #(
                   conv     : operand_request_i[requester].conv,
                   ntr_red  : operand_request_i[requester].cvt_resize,
                   target_fu: operand_request_i[requester].target_fu,
-                  is_reduct: operand_request_i[requester].is_reduct
+                  is_reduct: operand_request_i[requester].is_reduct,
+                  altfmt   : operand_request_i[requester].vtype.altfmt
                 };
                 operand_queue_cmd_valid_o[requester] = 1'b1;
                 // The length should be at least one after the rescaling
@@ -447,6 +560,8 @@ module operand_requester import ara_pkg::*; import rvv_pkg::*; #(
     for (int bank = 0; bank < NrBanks; bank++) begin
       operand_req[bank][NrOperandQueues + VFU_Alu]       = 1'b0;
       operand_req[bank][NrOperandQueues + VFU_MFpu]      = 1'b0;
+      operand_req[bank][NrOperandQueues + VFU_MFpu2]     = 1'b0;
+      operand_req[bank][NrOperandQueues + VFU_MxUnit]    = 1'b0;
       operand_req[bank][NrOperandQueues + VFU_MaskUnit]  = 1'b0;
       operand_req[bank][NrOperandQueues + VFU_SlideUnit] = 1'b0;
       operand_req[bank][NrOperandQueues + VFU_LoadUnit]  = 1'b0;
@@ -467,6 +582,20 @@ module operand_requester import ara_pkg::*; import rvv_pkg::*; #(
       be     : mfpu_result_be_i,
       default: '0
     };
+    operand_payload[NrOperandQueues + VFU_MFpu2] = '{
+      addr   : mfpu2_result_addr_i >> $clog2(NrBanks),
+      wen    : 1'b1,
+      wdata  : mfpu2_result_wdata_i,
+      be     : mfpu2_result_be_i,
+      default: '0
+    };
+    operand_payload[NrOperandQueues + VFU_MxUnit] = '{
+      addr   : mxu_result_addr_i >> $clog2(NrBanks),
+      wen    : 1'b1,
+      wdata  : mxu_result_wdata_i,
+      be     : mxu_result_be_i,
+      default: '0
+    };
     operand_payload[NrOperandQueues + VFU_MaskUnit] = '{
       addr   : masku_result_addr >> $clog2(NrBanks),
       wen    : 1'b1,
@@ -490,104 +619,172 @@ module operand_requester import ara_pkg::*; import rvv_pkg::*; #(
     };
 
     // Store their request value
-    operand_req[alu_result_addr_i[idx_width(NrBanks)-1:0]][NrOperandQueues + VFU_Alu] =
+    operand_req[vrf_bank(alu_result_addr_i)][NrOperandQueues + VFU_Alu] =
     alu_result_req_i;
-    operand_req[mfpu_result_addr_i[idx_width(NrBanks)-1:0]][NrOperandQueues + VFU_MFpu] =
+    operand_req[vrf_bank(mfpu_result_addr_i)][NrOperandQueues + VFU_MFpu] =
     mfpu_result_req_i;
-    operand_req[masku_result_addr[idx_width(NrBanks)-1:0]][NrOperandQueues + VFU_MaskUnit] =
+    operand_req[vrf_bank(mfpu2_result_addr_i)][NrOperandQueues + VFU_MFpu2] =
+    mfpu2_result_req_i;
+    operand_req[vrf_bank(mxu_result_addr_i)][NrOperandQueues + VFU_MxUnit] =
+    mxu_result_req_i;
+    operand_req[vrf_bank(masku_result_addr)][NrOperandQueues + VFU_MaskUnit] =
     masku_result_req;
-    operand_req[sldu_result_addr[idx_width(NrBanks)-1:0]][NrOperandQueues + VFU_SlideUnit] =
+    operand_req[vrf_bank(sldu_result_addr)][NrOperandQueues + VFU_SlideUnit] =
     sldu_result_req;
-    operand_req[ldu_result_addr[idx_width(NrBanks)-1:0]][NrOperandQueues + VFU_LoadUnit] =
+    operand_req[vrf_bank(ldu_result_addr)][NrOperandQueues + VFU_LoadUnit] =
     ldu_result_req;
 
     // Generate the grant signals
-    alu_result_gnt_o  = 1'b0;
-    mfpu_result_gnt_o = 1'b0;
-    masku_result_gnt  = 1'b0;
-    sldu_result_gnt   = 1'b0;
-    ldu_result_gnt    = 1'b0;
+    alu_result_gnt_o   = 1'b0;
+    mfpu_result_gnt_o  = 1'b0;
+    mfpu2_result_gnt_o = 1'b0;
+    mxu_result_gnt_o   = 1'b0;
+    masku_result_gnt   = 1'b0;
+    sldu_result_gnt    = 1'b0;
+    ldu_result_gnt     = 1'b0;
     for (int bank = 0; bank < NrBanks; bank++) begin
-      alu_result_gnt_o  = alu_result_gnt_o | operand_gnt[bank][NrOperandQueues + VFU_Alu];
-      mfpu_result_gnt_o = mfpu_result_gnt_o | operand_gnt[bank][NrOperandQueues + VFU_MFpu];
-      masku_result_gnt  = masku_result_gnt | operand_gnt[bank][NrOperandQueues + VFU_MaskUnit];
-      sldu_result_gnt   = sldu_result_gnt | operand_gnt[bank][NrOperandQueues + VFU_SlideUnit];
-      ldu_result_gnt    = ldu_result_gnt | operand_gnt[bank][NrOperandQueues + VFU_LoadUnit];
+      alu_result_gnt_o   = alu_result_gnt_o | operand_gnt[bank][NrOperandQueues + VFU_Alu];
+      mfpu_result_gnt_o  = mfpu_result_gnt_o | operand_gnt[bank][NrOperandQueues + VFU_MFpu];
+      mfpu2_result_gnt_o = mfpu2_result_gnt_o | operand_gnt[bank][NrOperandQueues + VFU_MFpu2];
+      mxu_result_gnt_o   = mxu_result_gnt_o | operand_gnt[bank][NrOperandQueues + VFU_MxUnit];
+      masku_result_gnt   = masku_result_gnt | operand_gnt[bank][NrOperandQueues + VFU_MaskUnit];
+      sldu_result_gnt    = sldu_result_gnt | operand_gnt[bank][NrOperandQueues + VFU_SlideUnit];
+      ldu_result_gnt     = ldu_result_gnt | operand_gnt[bank][NrOperandQueues + VFU_LoadUnit];
     end
   end
 
-  // Instantiate a RR arbiter per bank
-  for (genvar bank = 0; bank < NrBanks; bank++) begin: gen_vrf_arbiters
-    // High-priority requests
-    payload_t payload_hp;
-    logic payload_hp_req;
-    logic payload_hp_gnt;
-    rr_arb_tree #(
-      .NumIn    (int'(MulFPUC) - int'(AluA) + 1 + int'(VFU_MFpu) - int'(VFU_Alu) + 1),
-      .DataWidth($bits(payload_t)                                                   ),
-      .AxiVldRdy(1'b0                                                               )
-    ) i_hp_vrf_arbiter (
-      .clk_i  (clk_i ),
-      .rst_ni (rst_ni),
-      .flush_i(1'b0  ),
-      .rr_i   ('0    ),
-      .data_i ({operand_payload[MulFPUC:AluA],
-          operand_payload[NrOperandQueues + VFU_MFpu:NrOperandQueues + VFU_Alu]} ),
-      .req_i ({operand_req[bank][MulFPUC:AluA],
-          operand_req[bank][NrOperandQueues + VFU_MFpu:NrOperandQueues + VFU_Alu]}),
-      .gnt_o ({operand_gnt[bank][MulFPUC:AluA],
-          operand_gnt[bank][NrOperandQueues + VFU_MFpu:NrOperandQueues + VFU_Alu]}),
-      .data_o (payload_hp    ),
-      .idx_o  (/* Unused */  ),
-      .req_o  (payload_hp_req),
-      .gnt_i  (payload_hp_gnt)
-    );
+  // Masters of each port of the VRF banks. The single port serves all of them. With VrfDualPort,
+  // the read port serves the operand queues, and the write port the VFU results.
+  localparam int unsigned NrVrfPorts = VrfDualPort ? 2 : 1;
 
-    // Low-priority requests
-    payload_t payload_lp;
-    logic payload_lp_req;
-    logic payload_lp_gnt;
-    rr_arb_tree #(
-      .NumIn(int'(SlideAddrGenA)- int'(MaskB) + 1 + int'(VFU_LoadUnit) - int'(VFU_SlideUnit) + 1),
-      .DataWidth($bits(payload_t)                                                               ),
-      .AxiVldRdy(1'b0                                                                           )
-    ) i_lp_vrf_arbiter (
-      .clk_i  (clk_i ),
-      .rst_ni (rst_ni),
-      .flush_i(1'b0  ),
-      .rr_i   ('0    ),
-      .data_i ({operand_payload[SlideAddrGenA:MaskB],
-          operand_payload[NrOperandQueues + VFU_LoadUnit:NrOperandQueues + VFU_SlideUnit]} ),
-      .req_i ({operand_req[bank][SlideAddrGenA:MaskB],
-          operand_req[bank][NrOperandQueues + VFU_LoadUnit:NrOperandQueues + VFU_SlideUnit]}),
-      .gnt_o ({operand_gnt[bank][SlideAddrGenA:MaskB],
-          operand_gnt[bank][NrOperandQueues + VFU_LoadUnit:NrOperandQueues + VFU_SlideUnit]}),
-      .data_o (payload_lp    ),
-      .idx_o  (/* Unused */  ),
-      .req_o  (payload_lp_req),
-      .gnt_i  (payload_lp_gnt)
-    );
+  function automatic logic [NrMasters-1:0] vrf_port_masters(int unsigned port);
+    vrf_port_masters = '1;
+    if (VrfDualPort)
+      for (int unsigned m = 0; m < NrMasters; m++)
+        vrf_port_masters[m] = (m >= NrOperandQueues) == (port == 1);
+  endfunction : vrf_port_masters
 
-    // High-priority requests always mask low-priority requests
-    rr_arb_tree #(
-      .NumIn    (2               ),
-      .DataWidth($bits(payload_t)),
-      .AxiVldRdy(1'b0            ),
-      .ExtPrio  (1'b1            )
-    ) i_vrf_arbiter (
-      .clk_i  (clk_i                            ),
-      .rst_ni (rst_ni                           ),
-      .flush_i(1'b0                             ),
-      .rr_i   (1'b0                             ),
-      .data_i ({payload_lp, payload_hp}         ),
-      .req_i  ({payload_lp_req, payload_hp_req} ),
-      .gnt_o  ({payload_lp_gnt, payload_hp_gnt} ),
-      .data_o ({vrf_addr_o[bank], vrf_wen_o[bank], vrf_wdata_o[bank], vrf_be_o[bank],
-          vrf_tgt_opqueue_o[bank]}),
-      .idx_o (/* Unused */    ),
-      .req_o (vrf_req_o[bank] ),
-      .gnt_i (vrf_req_o[bank] ) // Acknowledge it directly
-    );
+  // Instantiate a RR arbiter per bank and port
+  for (genvar bank = 0; bank < NrBanks; bank++) begin: gen_vrf_arbiters
+    logic     [NrVrfPorts-1:0][NrMasters-1:0] port_gnt;
+    payload_t [NrVrfPorts-1:0]                port_payload;
+    logic     [NrVrfPorts-1:0]                port_req;
+
+    for (genvar port = 0; port < NrVrfPorts; port++) begin: gen_vrf_ports
+      logic [NrMasters-1:0] req;
+      assign req = operand_req[bank] & vrf_port_masters(port);
+
+      // High-priority requests
+      payload_t payload_hp;
+      logic payload_hp_req;
+      logic payload_hp_gnt;
+      rr_arb_tree #(
+        .NumIn    (int'(MulFPU2C) - int'(AluA) + 1 + int'(VFU_MxUnit) - int'(VFU_Alu) + 1),
+        .DataWidth($bits(payload_t)                                                      ),
+        .AxiVldRdy(1'b0                                                                  )
+      ) i_hp_vrf_arbiter (
+        .clk_i  (clk_i ),
+        .rst_ni (rst_ni),
+        .flush_i(1'b0  ),
+        .rr_i   ('0    ),
+        .data_i ({operand_payload[MulFPU2C:AluA],
+            operand_payload[NrOperandQueues + VFU_MxUnit:NrOperandQueues + VFU_Alu]}),
+        .req_i ({req[MulFPU2C:AluA], req[NrOperandQueues + VFU_MxUnit:NrOperandQueues + VFU_Alu]}),
+        .gnt_o ({port_gnt[port][MulFPU2C:AluA],
+            port_gnt[port][NrOperandQueues + VFU_MxUnit:NrOperandQueues + VFU_Alu]}),
+        .data_o (payload_hp    ),
+        .idx_o  (/* Unused */  ),
+        .req_o  (payload_hp_req),
+        .gnt_i  (payload_hp_gnt)
+      );
+
+      // Low-priority requests
+      payload_t payload_lp;
+      logic payload_lp_req;
+      logic payload_lp_gnt;
+      rr_arb_tree #(
+        .NumIn(int'(SlideAddrGenA)- int'(MaskB) + 1 + int'(VFU_LoadUnit) - int'(VFU_SlideUnit) + 1),
+        .DataWidth($bits(payload_t)                                                               ),
+        .AxiVldRdy(1'b0                                                                           )
+      ) i_lp_vrf_arbiter (
+        .clk_i  (clk_i ),
+        .rst_ni (rst_ni),
+        .flush_i(1'b0  ),
+        .rr_i   ('0    ),
+        .data_i ({operand_payload[SlideAddrGenA:MaskB],
+            operand_payload[NrOperandQueues + VFU_LoadUnit:NrOperandQueues + VFU_SlideUnit]}),
+        .req_i ({req[SlideAddrGenA:MaskB],
+            req[NrOperandQueues + VFU_LoadUnit:NrOperandQueues + VFU_SlideUnit]}),
+        .gnt_o ({port_gnt[port][SlideAddrGenA:MaskB],
+            port_gnt[port][NrOperandQueues + VFU_LoadUnit:NrOperandQueues + VFU_SlideUnit]}),
+        .data_o (payload_lp    ),
+        .idx_o  (/* Unused */  ),
+        .req_o  (payload_lp_req),
+        .gnt_i  (payload_lp_gnt)
+      );
+
+      // High-priority requests always mask low-priority requests
+      rr_arb_tree #(
+        .NumIn    (2               ),
+        .DataWidth($bits(payload_t)),
+        .AxiVldRdy(1'b0            ),
+        .ExtPrio  (1'b1            )
+      ) i_vrf_arbiter (
+        .clk_i  (clk_i                           ),
+        .rst_ni (rst_ni                          ),
+        .flush_i(1'b0                            ),
+        .rr_i   (1'b0                            ),
+        .data_i ({payload_lp, payload_hp}        ),
+        .req_i  ({payload_lp_req, payload_hp_req}),
+        .gnt_o  ({payload_lp_gnt, payload_hp_gnt}),
+        .data_o (port_payload[port]              ),
+        .idx_o  (/* Unused */                    ),
+        .req_o  (port_req[port]                  ),
+        .gnt_i  (port_req[port]                  ) // Acknowledge it directly
+      );
+    end : gen_vrf_ports
+
+    // Each master requests a single port
+    always_comb begin
+      operand_gnt[bank] = '0;
+      for (int unsigned port = 0; port < NrVrfPorts; port++)
+        operand_gnt[bank] |= port_gnt[port];
+    end
+
+    assign vrf_req_o[bank]         = port_req[0];
+    assign vrf_addr_o[bank]        = port_payload[0].addr;
+    assign vrf_wen_o[bank]         = port_payload[0].wen;
+    assign vrf_wdata_o[bank]       = port_payload[0].wdata;
+    assign vrf_be_o[bank]          = port_payload[0].be;
+    assign vrf_tgt_opqueue_o[bank] = port_payload[0].opqueue;
+
+    if (VrfDualPort) begin: gen_vrf_write_port
+      assign vrf_wr_req_o[bank]   = port_req[1];
+      assign vrf_wr_addr_o[bank]  = port_payload[1].addr;
+      assign vrf_wr_wdata_o[bank] = port_payload[1].wdata;
+      assign vrf_wr_be_o[bank]    = port_payload[1].be;
+    end else begin: gen_no_vrf_write_port
+      assign vrf_wr_req_o[bank]   = 1'b0;
+      assign vrf_wr_addr_o[bank]  = '0;
+      assign vrf_wr_wdata_o[bank] = '0;
+      assign vrf_wr_be_o[bank]    = '0;
+    end
   end : gen_vrf_arbiters
 
+  // A bank conflict happens when a bank has more requests than grants
+  always_comb begin : p_vrf_bank_conflict
+    vrf_bank_conflict_o = 1'b0;
+    for (int bank = 0; bank < NrBanks; bank++)
+      vrf_bank_conflict_o |= |(operand_req[bank] & ~operand_gnt[bank]);
+  end : p_vrf_bank_conflict
+
+  // A read and a write target the same bank. They conflict on the single-ported banks, and
+  // use the two ports of the dual-ported ones.
+  always_comb begin : p_vrf_rw_conflict
+    vrf_rw_conflict_o = 1'b0;
+    for (int bank = 0; bank < NrBanks; bank++)
+      vrf_rw_conflict_o |= (|operand_req[bank][NrOperandQueues-1:0]) &&
+        (|operand_req[bank][NrMasters-1:NrOperandQueues]);
+  end : p_vrf_rw_conflict
+
 endmodule : operand_requester
@@ -59,6 +59,22 @@ module simd_alu import ara_pkg::*; import rvv_pkg::*; #(
 
   assign vxrm = vxrm_i;
   assign vxsat_o = vxsat;
+
+  // Bit counts of the lowest width bits of x, for the Zvbb instructions
+  function automatic logic [6:0] leading_zeros(logic [63:0] x, int unsigned width);
+    leading_zeros = width;
+    for (int i = 0; i < width; i++) if (x[i]) leading_zeros = width - 1 - i;
+  endfunction : leading_zeros
+
+  function automatic logic [6:0] trailing_zeros(logic [63:0] x, int unsigned width);
+    trailing_zeros = width;
+    for (int i = width-1; i >= 0; i--) if (x[i]) trailing_zeros = i;
+  endfunction : trailing_zeros
+
+  function automatic logic [6:0] pop_count(logic [63:0] x, int unsigned width);
+    pop_count = '0;
+    for (int i = 0; i < width; i++) pop_count += x[i];
+  endfunction : pop_count
   ///////////////////
   //  Comparisons  //
   ///////////////////
@@ -121,6 +137,7 @@ module simd_alu import ara_pkg::*; import rvv_pkg::*; #(
         VAND, VREDAND: res = operand_a_i & operand_b_i;
         VOR, VREDOR  : res = operand_a_i | operand_b_i;
         VXOR, VREDXOR: res = operand_a_i ^ operand_b_i;
+        VANDN        : res = operand_b_i & ~operand_a_i;
 
         // Mask logical operations
         VMAND   : res = operand_a_i & operand_b_i;
@@ -132,6 +149,11 @@ module simd_alu import ara_pkg::*; import rvv_pkg::*; #(
         VMXOR   : res = operand_a_i ^ operand_b_i;
         VMXNOR  : res = ~(operand_a_i ^ operand_b_i);
 
+        // The indices of vrgather, and vd of the crypto instructions, are just forwarded to the
+        // Mask Unit
+        VRGATHER, VRGATHEREI16, VAESEF, VAESEM, VAESDF, VAESDM, VAESZ, VAESKF2, VSHA2MS, VSHA2CH,
+        VSHA2CL, VGHSH, VGMUL: res = operand_a_i;
+
         // vmsbf, vmsof, vmsif and viota operand generation
         VMSBF, VMSOF, VMSIF, VIOTA : res = opb;
 
@@ -398,6 +420,75 @@ module simd_alu import ara_pkg::*; import rvv_pkg::*; #(
                 $signed(opb.w64[b]) >>> opa.w64[b][5:0];
           endcase
 
+        // Rotations and bit manipulation (Zvbb)
+        VROL: unique case (vew_i)
+            EW8 : for (int b = 0; b < 8; b++) begin
+                automatic logic [ 15:0] rot = {opb.w8 [b], opb.w8 [b]} << opa.w8 [b][2:0];
+                res.w8 [b] = rot[15:8];
+              end
+            EW16: for (int b = 0; b < 4; b++) begin
+                automatic logic [ 31:0] rot = {opb.w16[b], opb.w16[b]} << opa.w16[b][3:0];
+                res.w16[b] = rot[31:16];
+              end
+            EW32: for (int b = 0; b < 2; b++) begin
+                automatic logic [ 63:0] rot = {opb.w32[b], opb.w32[b]} << opa.w32[b][4:0];
+                res.w32[b] = rot[63:32];
+              end
+            EW64: for (int b = 0; b < 1; b++) begin
+                automatic logic [127:0] rot = {opb.w64[b], opb.w64[b]} << opa.w64[b][5:0];
+                res.w64[b] = rot[127:64];
+              end
+          endcase
+        VROR: unique case (vew_i)
+            EW8 : for (int b = 0; b < 8; b++) begin
+                automatic logic [ 15:0] rot = {opb.w8 [b], opb.w8 [b]} >> opa.w8 [b][2:0];
+                res.w8 [b] = rot[7:0];
+              end
+            EW16: for (int b = 0; b < 4; b++) begin
+                automatic logic [ 31:0] rot = {opb.w16[b], opb.w16[b]} >> opa.w16[b][3:0];
+                res.w16[b] = rot[15:0];
+              end
+            EW32: for (int b = 0; b < 2; b++) begin
+                automatic logic [ 63:0] rot = {opb.w32[b], opb.w32[b]} >> opa.w32[b][4:0];
+                res.w32[b] = rot[31:0];
+              end
+            EW64: for (int b = 0; b < 1; b++) begin
+                automatic logic [127:0] rot = {opb.w64[b], opb.w64[b]} >> opa.w64[b][5:0];
+                res.w64[b] = rot[63:0];
+              end
+          endcase
+        VBREV8: for (int b = 0; b < 8; b++) res.w8[b] = {<<{opb.w8[b]}};
+        VREV8: unique case (vew_i)
+            EW8 : for (int b = 0; b < 8; b++) res.w8 [b] = opb.w8 [b];
+            EW16: for (int b = 0; b < 4; b++) res.w16[b] = {<<8{opb.w16[b]}};
+            EW32: for (int b = 0; b < 2; b++) res.w32[b] = {<<8{opb.w32[b]}};
+            EW64: for (int b = 0; b < 1; b++) res.w64[b] = {<<8{opb.w64[b]}};
+          endcase
+        VBREV: unique case (vew_i)
+            EW8 : for (int b = 0; b < 8; b++) res.w8 [b] = {<<{opb.w8 [b]}};
+            EW16: for (int b = 0; b < 4; b++) res.w16[b] = {<<{opb.w16[b]}};
+            EW32: for (int b = 0; b < 2; b++) res.w32[b] = {<<{opb.w32[b]}};
+            EW64: for (int b = 0; b < 1; b++) res.w64[b] = {<<{opb.w64[b]}};
+          endcase
+        VCLZ: unique case (vew_i)
+            EW8 : for (int b = 0; b < 8; b++) res.w8 [b] = leading_zeros(opb.w8 [b],  8);
+            EW16: for (int b = 0; b < 4; b++) res.w16[b] = leading_zeros(opb.w16[b], 16);
+            EW32: for (int b = 0; b < 2; b++) res.w32[b] = leading_zeros(opb.w32[b], 32);
+            EW64: for (int b = 0; b < 1; b++) res.w64[b] = leading_zeros(opb.w64[b], 64);
+          endcase
+        VCTZ: unique case (vew_i)
+            EW8 : for (int b = 0; b < 8; b++) res.w8 [b] = trailing_zeros(opb.w8 [b],  8);
+            EW16: for (int b = 0; b < 4; b++) res.w16[b] = trailing_zeros(opb.w16[b], 16);
+            EW32: for (int b = 0; b < 2; b++) res.w32[b] = trailing_zeros(opb.w32[b], 32);
+            EW64: for (int b = 0; b < 1; b++) res.w64[b] = trailing_zeros(opb.w64[b], 64);
+          endcase
+        VCPOPV: unique case (vew_i)
+            EW8 : for (int b = 0; b < 8; b++) res.w8 [b] = pop_count(opb.w8 [b],  8);
+            EW16: for (int b = 0; b < 4; b++) res.w16[b] = pop_count(opb.w16[b], 16);
+            EW32: for (int b = 0; b < 2; b++) res.w32[b] = pop_count(opb.w32[b], 32);
+            EW64: for (int b = 0; b < 1; b++) res.w64[b] = pop_count(opb.w64[b], 64);
+          endcase
+
         // Fixed point shift instructions
         VSSRA: if (FixPtSupport == FixedPointEnable) unique case (vew_i)
             EW8: for (int b = 0; b < 8; b++) begin
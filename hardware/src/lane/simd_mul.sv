@@ -203,6 +203,26 @@ module simd_mul import ara_pkg::*; import rvv_pkg::*; #(
         assign vxsat.w32[l] = '0;
     end: gen_mul
 
+    // 4-way 8-bit dot products of the 32-bit elements, added to opc.
+    // The bytes of opb (vs2) and opa (vs1 or rs1) are signed or unsigned depending on the op.
+    logic [1:0][31:0] dot_res;
+    logic             dot_signed_a, dot_signed_b;
+
+    assign dot_signed_a = op inside {VQDOT, VQDOTUS};
+    assign dot_signed_b = op inside {VQDOT, VQDOTSU};
+
+    always_comb begin : p_dot
+      for (int l = 0; l < 2; l++) begin
+        dot_res[l] = opc.w32[l];
+        for (int b = 0; b < 4; b++) begin
+          automatic logic signed [17:0] prod =
+            $signed({opa.w8[4*l+b][7] & dot_signed_a, opa.w8[4*l+b]}) *
+            $signed({opb.w8[4*l+b][7] & dot_signed_b, opb.w8[4*l+b]});
+          dot_res[l] += {{14{prod[17]}}, prod};
+        end
+      end
+    end : p_dot
+
     always_comb begin : p_mul
       unique case (op)
         // Single-Width integer multiply instructions
@@ -227,6 +247,11 @@ module simd_mul import ara_pkg::*; import rvv_pkg::*; #(
         VNMSUB: for (int l = 0; l < 2; l++) begin
             result_o[32*l +: 32] = -mul_res.w64[l][31:0] + opc.w32[l];
           end
+        // Dot-product instructions
+        VQDOT,
+        VQDOTU,
+        VQDOTSU,
+        VQDOTUS: result_o = dot_res;
         default: result_o = '0;
       endcase
     end
@@ -0,0 +1,194 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+// Solderpad Hardware License, Version 0.51, see LICENSE for details.
+// SPDX-License-Identifier: SHL-0.51
+//
+// Description:
+// Ara's SIMD Divider, operating on elements 64-bit wide.
+// Same interface as simd_div, but the elements of a 64-bit word are divided in
+// parallel, each by its own serial divider. Element i is at most 64 >> ceil(log2(i+1))
+// bits wide, so the eight dividers are 64, 32, 16, 16, 8, 8, 8, and 8 bits wide.
+// Since a serial divider takes one cycle per quotient bit, a word of EW8 elements
+// takes as long as a single EW8 element.
+
+module simd_pardiv import ara_pkg::*; import rvv_pkg::*; #(
+    // Dependant parameters. DO NOT CHANGE!
+    localparam int  unsigned DataWidth = $bits(elen_t),
+    localparam int  unsigned StrbWidth = DataWidth/8,
+    localparam type          strb_t    = logic [DataWidth/8-1:0]
+  ) (
+    input  logic    clk_i,
+    input  logic    rst_ni,
+    input  elen_t   operand_a_i,
+    input  elen_t   operand_b_i,
+    input  strb_t   mask_i,
+    input  ara_op_e op_i,
+    input  strb_t   be_i,
+    input  vew_e    vew_i,
+    output elen_t   result_o,
+    output strb_t   mask_o,
+    input  logic    valid_i,
+    output logic    ready_o,
+    input  logic    ready_i,
+    output logic    valid_o
+  );
+
+  `include "common_cells/registers.svh"
+
+  ///////////////////
+  //  Definitions  //
+  ///////////////////
+
+  // Maximum number of elements of a 64-bit word
+  localparam int unsigned NrElems = StrbWidth;
+
+  // Width of the divider of element e
+  function automatic int unsigned div_width(int unsigned e);
+    div_width = DataWidth >> $clog2(e + 1);
+  endfunction : div_width
+
+  // Element e of a 64-bit word, zero- or sign-extended to 64 bits
+  function automatic elen_t elem(elen_t op, int unsigned e, vew_e vew, logic sgn);
+    automatic elen_t shifted = op >> ((8 << vew) * e);
+
+    unique case (vew)
+      EW8    : elem = sgn ? {{56{shifted[7]}}, shifted[7:0]}   : {56'b0, shifted[7:0]};
+      EW16   : elem = sgn ? {{48{shifted[15]}}, shifted[15:0]} : {48'b0, shifted[15:0]};
+      EW32   : elem = sgn ? {{32{shifted[31]}}, shifted[31:0]} : {32'b0, shifted[31:0]};
+      default: elem = shifted;
+    endcase
+  endfunction : elem
+
+  // Input registers, kept stable until the complete 64-bit result is formed
+  elen_t   opa_q, opb_q;
+  vew_e    vew_q;
+  ara_op_e op_q;
+  strb_t   mask_q;
+
+  // Is the divider busy with a word?
+  logic busy_d, busy_q;
+  // Elements of the word to be divided, issued to their divider, and done
+  logic [NrElems-1:0] active_d, active_q;
+  logic [NrElems-1:0] issued_d, issued_q;
+  logic [NrElems-1:0] done_d, done_q;
+
+  // Output buffer, directly linked to result_o
+  elen_t result_d, result_q;
+  assign result_o = result_q;
+  assign mask_o   = mask_q;
+
+  // Serial dividers
+  logic  [1:0]         serdiv_opcode;
+  logic  [NrElems-1:0] serdiv_in_valid, serdiv_in_ready, serdiv_out_valid, serdiv_out_ready;
+  elen_t [NrElems-1:0] serdiv_opa, serdiv_opb, serdiv_result;
+
+  // Opcode selection
+  always_comb begin
+    case (op_q)
+      VDIVU: serdiv_opcode   = 2'b00;
+      VDIV : serdiv_opcode   = 2'b01;
+      VREMU: serdiv_opcode   = 2'b10;
+      VREM : serdiv_opcode   = 2'b11;
+      default: serdiv_opcode = 2'b00;
+    endcase
+  end
+
+  ///////////////
+  //  Control  //
+  ///////////////
+
+  always_comb begin : p_control
+    busy_d   = busy_q;
+    active_d = active_q;
+    issued_d = issued_q;
+    done_d   = done_q;
+    result_d = result_q;
+
+    // Accept a new word when idle
+    ready_o = !busy_q;
+    // The word is complete once all of its elements are done
+    valid_o = busy_q && done_q == active_q;
+
+    // Issue the operands of the active elements
+    serdiv_in_valid  = busy_q ? active_q & ~issued_q : '0;
+    serdiv_out_ready = busy_q ? issued_q & ~done_q : '0;
+
+    for (int unsigned e = 0; e < NrElems; e++) begin
+      if (serdiv_in_valid[e] && serdiv_in_ready[e]) issued_d[e] = 1'b1;
+
+      // Write the result of the element in place
+      if (serdiv_out_valid[e] && serdiv_out_ready[e]) begin
+        automatic int unsigned off   = (8 << vew_q) * e;
+        automatic elen_t       wmask = (vew_q == EW64) ? '1 : (elen_t'(1) << (8 << vew_q)) - 1;
+
+        result_d = (result_d & ~(wmask << off)) | ((serdiv_result[e] & wmask) << off);
+        done_d[e] = 1'b1;
+      end
+    end
+
+    if (valid_o && ready_i) busy_d = 1'b0;
+
+    if (valid_i && ready_o) begin
+      busy_d   = 1'b1;
+      issued_d = '0;
+      done_d   = '0;
+      // The disabled elements are zero
+      result_d = '0;
+      for (int unsigned e = 0; e < NrElems; e++)
+        active_d[e] = e < (NrElems >> vew_i) && be_i[e << vew_i];
+    end
+  end : p_control
+
+  ////////////////
+  //  Datapath  //
+  ////////////////
+
+  always_comb begin : p_operands
+    for (int unsigned e = 0; e < NrElems; e++) begin
+      serdiv_opa[e] = elem(opa_q, e, vew_q, op_q inside {VDIV, VREM});
+      serdiv_opb[e] = elem(opb_q, e, vew_q, op_q inside {VDIV, VREM});
+    end
+  end : p_operands
+
+  for (genvar e = 0; e < NrElems; e++) begin : gen_serdiv
+    localparam int unsigned Width = div_width(e);
+
+    logic [Width-1:0] res;
+
+    serdiv #(
+      .WIDTH           (Width),
+      .STABLE_HANDSHAKE(1    )
+    ) i_serdiv (
+      .clk_i    (clk_i                    ),
+      .rst_ni   (rst_ni                   ),
+      .id_i     ('0                       ),
+      .op_a_i   (serdiv_opa[e][Width-1:0] ),
+      .op_b_i   (serdiv_opb[e][Width-1:0] ),
+      .opcode_i (serdiv_opcode            ),
+      .in_vld_i (serdiv_in_valid[e]       ),
+      .in_rdy_o (serdiv_in_ready[e]       ),
+      .flush_i  (1'b0                     ),
+      .out_vld_o(serdiv_out_valid[e]      ),
+      .out_rdy_i(serdiv_out_ready[e]      ),
+      .id_o     (/* unconnected */        ),
+      .res_o    (res                      )
+    );
+
+    assign serdiv_result[e] = elen_t'(res);
+  end : gen_serdiv
+
+  //////////////////////////////
+  //  Sequential assignments  //
+  //////////////////////////////
+
+  `FFL(opa_q, operand_a_i, valid_i && ready_o, '0)
+  `FFL(opb_q, operand_b_i, valid_i && ready_o, '0)
+  `FFL(vew_q, vew_i, valid_i && ready_o, EW8)
+  `FFL(op_q, op_i, valid_i && ready_o, VDIV)
+  `FFL(mask_q, mask_i, valid_i && ready_o, '0)
+  `FF(busy_q, busy_d, 1'b0)
+  `FF(active_q, active_d, '0)
+  `FF(issued_q, issued_d, '0)
+  `FF(done_q, done_d, '0)
+  `FF(result_q, result_d, '0)
+
+endmodule : simd_pardiv
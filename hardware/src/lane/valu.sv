@@ -268,37 +268,22 @@ module valu import ara_pkg::*; import rvv_pkg::*; import cf_math_pkg::idx_width;
   reduction_rx_cnt_t reduction_rx_cnt_d, reduction_rx_cnt_q;
   reduction_rx_cnt_t simd_red_cnt_max_d, simd_red_cnt_max_q;
 
-  // Use this function to assign a counter value to each lane if you can use in-lane parameters with your flow
-  //  function automatic reduction_rx_cnt_t reduction_rx_cnt_init(int unsigned NrLanes, int unsigned LaneIdx);
-  //    // The even lanes do not receive intermediate results. Only Lane 0 will receive the final result, but this is not checked here.
-  //    int adjusted_idx = LaneIdx + 1;
-  //    reduction_rx_cnt_init = '0;
-  //    for (int i = 2; i <= NrLanes; i *= 2) if (!(adjusted_idx % i)) reduction_rx_cnt_init++;
-  //  endfunction: reduction_rx_cnt_init
-  // Otherwise, use the following function (okay until 16 lanes)
-  function automatic reduction_rx_cnt_t reduction_rx_cnt_init(int unsigned NrLanes, logic [3:0] lane_id);
-     // The even lanes do not receive intermediate results. Only Lane 0 will receive the final result, but this is not checked here.
-     case (lane_id)
-      0:  reduction_rx_cnt_init = reduction_rx_cnt_t'(0);
-      1:  reduction_rx_cnt_init = reduction_rx_cnt_t'(1);
-      2:  reduction_rx_cnt_init = reduction_rx_cnt_t'(0);
-      3:  reduction_rx_cnt_init = reduction_rx_cnt_t'(2);
-      4:  reduction_rx_cnt_init = reduction_rx_cnt_t'(0);
-      5:  reduction_rx_cnt_init = reduction_rx_cnt_t'(1);
-      6:  reduction_rx_cnt_init = reduction_rx_cnt_t'(0);
-      7:  reduction_rx_cnt_init = reduction_rx_cnt_t'(3);
-      8:  reduction_rx_cnt_init = reduction_rx_cnt_t'(0);
-      9:  reduction_rx_cnt_init = reduction_rx_cnt_t'(1);
-      10: reduction_rx_cnt_init = reduction_rx_cnt_t'(0);
-      11: reduction_rx_cnt_init = reduction_rx_cnt_t'(2);
-      12: reduction_rx_cnt_init = reduction_rx_cnt_t'(0);
-      13: reduction_rx_cnt_init = reduction_rx_cnt_t'(1);
-      14: reduction_rx_cnt_init = reduction_rx_cnt_t'(0);
-      15: reduction_rx_cnt_init = reduction_rx_cnt_t'(4);
-    endcase
+  // Counter value of each lane
+  function automatic reduction_rx_cnt_t reduction_rx_cnt_init(int unsigned NrLanes,
+      logic [idx_width(MaxNrLanes)-1:0] lane_id);
+    // The even lanes do not receive intermediate results. Only Lane 0 will receive the final result, but this is not checked here.
+    // A lane receives one intermediate result per trailing one of its index.
+    automatic logic ones = 1'b1;
+    reduction_rx_cnt_init = '0;
+    for (int i = 0; i < $clog2(NrLanes); i++) begin
+      ones &= lane_id[i];
+      reduction_rx_cnt_init += ones;
+    end
   endfunction: reduction_rx_cnt_init
 
-  // Count how many transactions we must do in total to complete the reduction operation
+  // Count how many transactions we must do in total to complete the reduction operation.
+  // With SlduRedTree, the SLDU reduces the partial results itself, and sends the result to
+  // Lane 0 in a single transaction.
   logic [idx_width($clog2(NrLanes)+1):0] sldu_transactions_cnt_d, sldu_transactions_cnt_q;
 
   // Counter to drive SIMD reductions
@@ -720,12 +705,11 @@ module valu import ara_pkg::*; import rvv_pkg::*; import cf_math_pkg::idx_width;
     //  Write results into the VRF  //
     //////////////////////////////////
 
+    // The partial result of a reduction is never valid in the result queue, so that the results
+    // of the older instructions, e.g., of the previous reduction, are written while the next
+    // reduction is still running.
     alu_result_wdata_o = result_queue_q[result_queue_read_pnt_q].wdata;
-    if (alu_state_q == NO_REDUCTION || (alu_state_q == SIMD_REDUCTION && simd_red_cnt_q == simd_red_cnt_max_q)) begin
-      alu_result_req_o = result_queue_valid_q[result_queue_read_pnt_q] & ((alu_state_q == SIMD_REDUCTION) || !result_queue_q[result_queue_read_pnt_q].mask);
-    end else begin
-      alu_result_req_o = 1'b0;
-    end
+    alu_result_req_o   = result_queue_valid_q[result_queue_read_pnt_q] & !result_queue_q[result_queue_read_pnt_q].mask;
     alu_result_addr_o = result_queue_q[result_queue_read_pnt_q].addr;
     alu_result_id_o   = result_queue_q[result_queue_read_pnt_q].id;
     alu_result_be_o   = result_queue_q[result_queue_read_pnt_q].be;
@@ -748,10 +732,12 @@ module valu import ara_pkg::*; import rvv_pkg::*; import cf_math_pkg::idx_width;
       result_queue_cnt_d -= 1;
 
       // Decrement the counter of remaining vector elements waiting to be written
-      // Don't do it in case of a reduction
-      if (!is_reduction(vinsn_commit.op))
+      // Don't do it in case of a reduction, which might be running while the result of
+      // the previous one is written
+      if (!is_reduction(vinsn_commit.op)) begin
         commit_cnt_d = commit_cnt_q - (1 << (int'(EW64) - vinsn_commit.vtype.vsew));
-      if (commit_cnt_q < (1 << (int'(EW64) - vinsn_commit.vtype.vsew))) commit_cnt_d = '0;
+        if (commit_cnt_q < (1 << (int'(EW64) - vinsn_commit.vtype.vsew))) commit_cnt_d = '0;
+      end
     end
 
     // Finished committing the results of a vector instruction
@@ -781,8 +767,8 @@ module valu import ara_pkg::*; import rvv_pkg::*; import cf_math_pkg::idx_width;
       if (is_reduction(vinsn_queue_q.vinsn[vinsn_queue_d.issue_pnt].op) && (vinsn_queue_d.issue_cnt != '0)) begin
         // Initialize reduction-related sequential elements
         first_op_d              = 1'b1;
-        reduction_rx_cnt_d      = reduction_rx_cnt_init(NrLanes, lane_id_i);
-        sldu_transactions_cnt_d = $clog2(NrLanes) + 1;
+        reduction_rx_cnt_d      = SlduRedTree ? '0 : reduction_rx_cnt_init(NrLanes, lane_id_i);
+        sldu_transactions_cnt_d = SlduRedTree ? 1 : $clog2(NrLanes) + 1;
 
         alu_state_d = INTRA_LANE_REDUCTION;
       end else begin
@@ -795,7 +781,8 @@ module valu import ara_pkg::*; import rvv_pkg::*; import cf_math_pkg::idx_width;
     //////////////////////////////
 
     if (!vinsn_queue_full && vfu_operation_valid_i &&
-      (vfu_operation_i.vfu == VFU_Alu || vfu_operation_i.op inside {[VMSEQ:VMXNOR]})) begin
+      (vfu_operation_i.vfu == VFU_Alu ||
+       vfu_operation_i.op inside {[VMSEQ:VRGATHEREI16], [VAESEF:VGMUL]})) begin
       vinsn_queue_d.vinsn[vinsn_queue_q.accept_pnt] = vfu_operation_i;
       // Do not wait for masks if, during a reduction, this lane is just a pass-through
       // The only valid instructions here with vl == '0 are reductions
@@ -809,8 +796,8 @@ module valu import ara_pkg::*; import rvv_pkg::*; import cf_math_pkg::idx_width;
         // This information is useful for reduction operation
         // Initialize reduction-related sequential elements
         first_op_d              = 1'b1;
-        reduction_rx_cnt_d      = reduction_rx_cnt_init(NrLanes, lane_id_i);
-        sldu_transactions_cnt_d = $clog2(NrLanes) + 1;
+        reduction_rx_cnt_d      = SlduRedTree ? '0 : reduction_rx_cnt_init(NrLanes, lane_id_i);
+        sldu_transactions_cnt_d = SlduRedTree ? 1 : $clog2(NrLanes) + 1;
 
         issue_cnt_d = vfu_operation_i.vl;
         if (!(vfu_operation_i.op inside {[VMANDNOT:VMXNOR]}))
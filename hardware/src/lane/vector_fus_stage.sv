@@ -37,6 +37,12 @@ module vector_fus_stage import ara_pkg::*; import rvv_pkg::*; import cf_math_pkg
     output logic           [NrVInsn-1:0]      alu_vinsn_done_o,
     output logic                              mfpu_ready_o,
     output logic           [NrVInsn-1:0]      mfpu_vinsn_done_o,
+    output logic                              mfpu2_ready_o,
+    output logic           [NrVInsn-1:0]      mfpu2_vinsn_done_o,
+    output logic           [NrVInsn-1:0]      mxu_vinsn_done_o,
+    input  logic                              alu_clk_en_i,
+    input  logic                              mfpu_clk_en_i,
+    input  logic                              mfpu2_clk_en_i,
     // Interface with the operand queues
     input  elen_t          [1:0]              alu_operand_i,
     input  logic           [1:0]              alu_operand_valid_i,
@@ -44,6 +50,12 @@ module vector_fus_stage import ara_pkg::*; import rvv_pkg::*; import cf_math_pkg
     input  elen_t          [2:0]              mfpu_operand_i,
     input  logic           [2:0]              mfpu_operand_valid_i,
     output logic           [2:0]              mfpu_operand_ready_o,
+    input  elen_t          [2:0]              mfpu2_operand_i,
+    input  logic           [2:0]              mfpu2_operand_valid_i,
+    output logic           [2:0]              mfpu2_operand_ready_o,
+    input  elen_t                             mxu_operand_i,
+    input  logic                              mxu_operand_valid_i,
+    output logic                              mxu_operand_ready_o,
     // Interface with the vector register file
     output logic                              alu_result_req_o,
     output vid_t                              alu_result_id_o,
@@ -58,6 +70,20 @@ module vector_fus_stage import ara_pkg::*; import rvv_pkg::*; import cf_math_pkg
     output elen_t                             mfpu_result_wdata_o,
     output strb_t                             mfpu_result_be_o,
     input  logic                              mfpu_result_gnt_i,
+    // Second Multiplier/FPU
+    output logic                              mfpu2_result_req_o,
+    output vid_t                              mfpu2_result_id_o,
+    output vaddr_t                            mfpu2_result_addr_o,
+    output elen_t                             mfpu2_result_wdata_o,
+    output strb_t                             mfpu2_result_be_o,
+    input  logic                              mfpu2_result_gnt_i,
+    // Matrix outer-product unit
+    output logic                              mxu_result_req_o,
+    output vid_t                              mxu_result_id_o,
+    output vaddr_t                            mxu_result_addr_o,
+    output elen_t                             mxu_result_wdata_o,
+    output strb_t                             mxu_result_be_o,
+    input  logic                              mxu_result_gnt_i,
     // Interface with the Slide Unit
     input  elen_t                             sldu_operand_i,
     output logic                              sldu_alu_req_valid_o,
@@ -68,6 +94,11 @@ module vector_fus_stage import ara_pkg::*; import rvv_pkg::*; import cf_math_pkg
     input  logic                              sldu_mfpu_valid_i,
     output logic                              sldu_mfpu_ready_o,
     input  logic                              sldu_mfpu_gnt_i,
+    // Interface with the neighbour lanes, for the ordered reductions
+    output elen_t                             osum_result_o,
+    output logic                              osum_result_valid_o,
+    input  elen_t                             osum_operand_i,
+    input  logic                              osum_operand_valid_i,
     // Interface with the Mask unit
     output elen_t          [NrMaskFUnits-1:0] mask_operand_o,
     output logic           [NrMaskFUnits-1:0] mask_operand_valid_o,
@@ -90,8 +121,47 @@ module vector_fus_stage import ara_pkg::*; import rvv_pkg::*; import cf_math_pkg
   assign mask_ready_o = alu_mask_ready | mfpu_mask_ready;
 
   // saturation selection
-  logic alu_vxsat, mfpu_vxsat;
-  assign vxsat_flag_o = mfpu_vxsat | alu_vxsat;
+  logic alu_vxsat, mfpu_vxsat, mfpu2_vxsat;
+  assign vxsat_flag_o = mfpu_vxsat | mfpu2_vxsat | alu_vxsat;
+
+  // Exception flags of the two VMFPUs and of the MXU
+  logic [4:0] mfpu_fflags, mfpu2_fflags, mxu_fflags;
+  logic       mfpu_fflags_valid, mfpu2_fflags_valid, mxu_fflags_valid;
+  assign fflags_ex_o       = (mfpu_fflags_valid ? mfpu_fflags : '0) |
+                             (mfpu2_fflags_valid ? mfpu2_fflags : '0) |
+                             (mxu_fflags_valid ? mxu_fflags : '0);
+  assign fflags_ex_valid_o = mfpu_fflags_valid | mfpu2_fflags_valid | mxu_fflags_valid;
+
+  ///////////////////
+  //  Clock gates  //
+  ///////////////////
+
+  // The VALU and the VMFPU are clocked only while the lane sequencer has instructions for them
+  logic alu_clk, mfpu_clk;
+
+`ifndef VERILATOR
+  if (FuClkGating) begin: gen_vfu_clk_gating
+    tc_clk_gating i_valu_ckg (
+      .clk_i    (clk_i       ),
+      .en_i     (alu_clk_en_i),
+      .test_en_i(1'b0        ),
+      .clk_o    (alu_clk     )
+    );
+
+    tc_clk_gating i_vmfpu_ckg (
+      .clk_i    (clk_i        ),
+      .en_i     (mfpu_clk_en_i),
+      .test_en_i(1'b0         ),
+      .clk_o    (mfpu_clk     )
+    );
+  end else begin: gen_vfu_clk
+    assign alu_clk  = clk_i;
+    assign mfpu_clk = clk_i;
+  end: gen_vfu_clk
+`else
+  assign alu_clk  = clk_i;
+  assign mfpu_clk = clk_i;
+`endif
 
   //////////////////
   //  Vector ALU  //
@@ -102,7 +172,7 @@ module vector_fus_stage import ara_pkg::*; import rvv_pkg::*; import cf_math_pkg
     .FixPtSupport(FixPtSupport),
     .vaddr_t(vaddr_t)
   ) i_valu (
-    .clk_i                (clk_i                          ),
+    .clk_i                (alu_clk                        ),
     .rst_ni               (rst_ni                         ),
     .lane_id_i            (lane_id_i                      ),
     // Interface with Dispatcher
@@ -151,15 +221,15 @@ module vector_fus_stage import ara_pkg::*; import rvv_pkg::*; import cf_math_pkg
     .FixPtSupport(FixPtSupport),
     .vaddr_t   (vaddr_t   )
   ) i_vmfpu (
-    .clk_i                (clk_i                           ),
+    .clk_i                (mfpu_clk                        ),
     .rst_ni               (rst_ni                          ),
     .lane_id_i            (lane_id_i                       ),
     // Interface with Dispatcher
     .mfpu_vxsat_o         (mfpu_vxsat                      ),
     .mfpu_vxrm_i          (alu_vxrm_i                      ),
     // Interface with CVA6
-    .fflags_ex_o          (fflags_ex_o                     ),
-    .fflags_ex_valid_o    (fflags_ex_valid_o               ),
+    .fflags_ex_o          (mfpu_fflags                     ),
+    .fflags_ex_valid_o    (mfpu_fflags_valid               ),
     // Interface with the lane sequencer
     .vfu_operation_i      (vfu_operation_i                 ),
     .vfu_operation_valid_i(vfu_operation_valid_i           ),
@@ -182,6 +252,11 @@ module vector_fus_stage import ara_pkg::*; import rvv_pkg::*; import cf_math_pkg
     .sldu_mfpu_valid_i    (sldu_mfpu_valid_i               ),
     .sldu_mfpu_ready_o    (sldu_mfpu_ready_o               ),
     .mfpu_red_ready_i     (sldu_mfpu_gnt_i                 ),
+    // Interface with the neighbour lanes
+    .osum_result_o        (osum_result_o                   ),
+    .osum_result_valid_o  (osum_result_valid_o             ),
+    .osum_operand_i       (osum_operand_i                  ),
+    .osum_operand_valid_i (osum_operand_valid_i            ),
     // Interface with the Mask unit
     .mask_operand_o       (mask_operand_o[MaskFUMFpu]      ),
     .mask_operand_valid_o (mask_operand_valid_o[MaskFUMFpu]),
@@ -191,4 +266,136 @@ module vector_fus_stage import ara_pkg::*; import rvv_pkg::*; import cf_math_pkg
     .mask_ready_o         (mfpu_mask_ready                 )
   );
 
+  //////////////////////////
+  //  Second Vector MFPU  //
+  //////////////////////////
+
+  // It only runs the unmasked floating-point instructions that do not reduce, which the main
+  // sequencer gives it instead of the first VMFPU
+  if (DualMfpu) begin: gen_vmfpu2
+    logic mfpu2_clk;
+
+`ifndef VERILATOR
+    if (FuClkGating) begin: gen_vmfpu2_clk_gating
+      tc_clk_gating i_vmfpu2_ckg (
+        .clk_i    (clk_i         ),
+        .en_i     (mfpu2_clk_en_i),
+        .test_en_i(1'b0          ),
+        .clk_o    (mfpu2_clk     )
+      );
+    end else begin: gen_vmfpu2_clk
+      assign mfpu2_clk = clk_i;
+    end: gen_vmfpu2_clk
+`else
+    assign mfpu2_clk = clk_i;
+`endif
+
+    vmfpu #(
+      .NrLanes     (NrLanes     ),
+      .FPUSupport  (FPUSupport  ),
+      .FPExtSupport(FPExtSupport),
+      .FixPtSupport(FixPtSupport),
+      .vaddr_t     (vaddr_t     ),
+      .VFUId       (VFU_MFpu2   )
+    ) i_vmfpu2 (
+      .clk_i                (mfpu2_clk            ),
+      .rst_ni               (rst_ni               ),
+      .lane_id_i            (lane_id_i            ),
+      // Interface with Dispatcher
+      .mfpu_vxsat_o         (mfpu2_vxsat          ),
+      .mfpu_vxrm_i          (alu_vxrm_i           ),
+      // Interface with CVA6
+      .fflags_ex_o          (mfpu2_fflags         ),
+      .fflags_ex_valid_o    (mfpu2_fflags_valid   ),
+      // Interface with the lane sequencer
+      .vfu_operation_i      (vfu_operation_i      ),
+      .vfu_operation_valid_i(vfu_operation_valid_i),
+      .mfpu_ready_o         (mfpu2_ready_o        ),
+      .mfpu_vinsn_done_o    (mfpu2_vinsn_done_o   ),
+      // Interface with the operand queues
+      .mfpu_operand_i       (mfpu2_operand_i      ),
+      .mfpu_operand_valid_i (mfpu2_operand_valid_i),
+      .mfpu_operand_ready_o (mfpu2_operand_ready_o),
+      // Interface with the vector register file
+      .mfpu_result_req_o    (mfpu2_result_req_o   ),
+      .mfpu_result_id_o     (mfpu2_result_id_o    ),
+      .mfpu_result_addr_o   (mfpu2_result_addr_o  ),
+      .mfpu_result_wdata_o  (mfpu2_result_wdata_o ),
+      .mfpu_result_be_o     (mfpu2_result_be_o    ),
+      .mfpu_result_gnt_i    (mfpu2_result_gnt_i   ),
+      // No reductions
+      .mfpu_red_valid_o     (/* Unused */         ),
+      .sldu_operand_i       (sldu_operand_i       ),
+      .sldu_mfpu_valid_i    (1'b0                 ),
+      .sldu_mfpu_ready_o    (/* Unused */         ),
+      .mfpu_red_ready_i     (1'b0                 ),
+      .osum_result_o        (/* Unused */         ),
+      .osum_result_valid_o  (/* Unused */         ),
+      .osum_operand_i       ('0                   ),
+      .osum_operand_valid_i (1'b0                 ),
+      // No masked instructions, nor comparisons
+      .mask_operand_o       (/* Unused */         ),
+      .mask_operand_valid_o (/* Unused */         ),
+      .mask_operand_ready_i (1'b0                 ),
+      .mask_i               ('0                   ),
+      .mask_valid_i         (1'b0                 ),
+      .mask_ready_o         (/* Unused */         )
+    );
+  end: gen_vmfpu2 else begin: gen_no_vmfpu2
+    assign mfpu2_vxsat           = 1'b0;
+    assign mfpu2_fflags          = '0;
+    assign mfpu2_fflags_valid    = 1'b0;
+    assign mfpu2_ready_o         = 1'b0;
+    assign mfpu2_vinsn_done_o    = '0;
+    assign mfpu2_operand_ready_o = '0;
+    assign mfpu2_result_req_o    = 1'b0;
+    assign mfpu2_result_id_o     = '0;
+    assign mfpu2_result_addr_o   = '0;
+    assign mfpu2_result_wdata_o  = '0;
+    assign mfpu2_result_be_o     = '0;
+  end: gen_no_vmfpu2
+
+  /////////////////////////////////
+  //  Matrix Outer-Product Unit  //
+  /////////////////////////////////
+
+  // It runs the outer products and the tile moves, with vs2 from the MulFPUA opqueue
+  if (MxuTiles != 0) begin: gen_vmxu
+    vmxu #(
+      .NrLanes(NrLanes),
+      .vaddr_t(vaddr_t)
+    ) i_vmxu (
+      .clk_i                (clk_i                ),
+      .rst_ni               (rst_ni               ),
+      // Interface with CVA6
+      .fflags_ex_o          (mxu_fflags           ),
+      .fflags_ex_valid_o    (mxu_fflags_valid     ),
+      // Interface with the lane sequencer
+      .vfu_operation_i      (vfu_operation_i      ),
+      .vfu_operation_valid_i(vfu_operation_valid_i),
+      .mxu_vinsn_done_o     (mxu_vinsn_done_o     ),
+      // Interface with the operand queues
+      .mxu_operand_i        (mxu_operand_i        ),
+      .mxu_operand_valid_i  (mxu_operand_valid_i  ),
+      .mxu_operand_ready_o  (mxu_operand_ready_o  ),
+      // Interface with the vector register file
+      .mxu_result_req_o     (mxu_result_req_o     ),
+      .mxu_result_id_o      (mxu_result_id_o      ),
+      .mxu_result_addr_o    (mxu_result_addr_o    ),
+      .mxu_result_wdata_o   (mxu_result_wdata_o   ),
+      .mxu_result_be_o      (mxu_result_be_o      ),
+      .mxu_result_gnt_i     (mxu_result_gnt_i     )
+    );
+  end: gen_vmxu else begin: gen_no_vmxu
+    assign mxu_fflags          = '0;
+    assign mxu_fflags_valid    = 1'b0;
+    assign mxu_vinsn_done_o    = '0;
+    assign mxu_operand_ready_o = 1'b0;
+    assign mxu_result_req_o    = 1'b0;
+    assign mxu_result_id_o     = '0;
+    assign mxu_result_addr_o   = '0;
+    assign mxu_result_wdata_o  = '0;
+    assign mxu_result_be_o     = '0;
+  end: gen_no_vmxu
+
 endmodule : vector_fus_stage
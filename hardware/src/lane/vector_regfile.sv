@@ -4,7 +4,8 @@
 //
 // Author: Matheus Cavalcante <matheusd@iis.ee.ethz.ch>
 // Description:
-// This is the vector register file of one lane.
+// This is the vector register file of one lane. With VrfDualPort, each bank has a
+// read and a write port.
 
 module vector_regfile import ara_pkg::*; #(
     parameter  int  unsigned NrBanks   = 0,     // Number of banks in the vector register file
@@ -24,6 +25,11 @@ module vector_regfile import ara_pkg::*; #(
     input  logic     [NrBanks-1:0]         wen_i,
     input  elen_t    [NrBanks-1:0]         wdata_i,
     input  strb_t    [NrBanks-1:0]         be_i,
+    // Write port of the banks, with VrfDualPort
+    input  logic     [NrBanks-1:0]         wr_req_i,
+    input  vaddr_t   [NrBanks-1:0]         wr_addr_i,
+    input  elen_t    [NrBanks-1:0]         wr_wdata_i,
+    input  strb_t    [NrBanks-1:0]         wr_be_i,
     // Operands
     output elen_t    [NrOperandQueues-1:0] operand_o,
     output logic     [NrOperandQueues-1:0] operand_valid_o
@@ -35,7 +41,8 @@ module vector_regfile import ara_pkg::*; #(
   //  Parameters  //
   //////////////////
 
-  localparam int unsigned NumWords = VRFSize / NrBanks / DataWidth;
+  // The spare vector registers do not always fill up the last row of the banks
+  localparam int unsigned NumWords = (VRFSize / DataWidth + NrBanks - 1) / NrBanks;
 
   ///////////////
   //  Signals  //
@@ -65,13 +72,13 @@ module vector_regfile import ara_pkg::*; #(
     // Clock gate
     logic vrf_clk;
     logic sram_active_q;
-    `FF(sram_active_q, req_i[bank], 1'b0)
+    `FF(sram_active_q, req_i[bank] || wr_req_i[bank], 1'b0)
 
     tc_clk_gating i_vrf_ckg (
-      .clk_i    (clk_i                       ),
-      .test_en_i(1'b0                        ),
-      .en_i     (req_i[bank] || sram_active_q),
-      .clk_o    (vrf_clk                     )
+      .clk_i    (clk_i                                          ),
+      .test_en_i(1'b0                                           ),
+      .en_i     (req_i[bank] || wr_req_i[bank] || sram_active_q),
+      .clk_o    (vrf_clk                                        )
     );
 `else
     logic vrf_clk;
@@ -79,20 +86,40 @@ module vector_regfile import ara_pkg::*; #(
     assign vrf_clk = clk_i;
 `endif
 
-    tc_sram #(
-      .NumWords (NumWords ),
-      .DataWidth(DataWidth),
-      .NumPorts (1        )
-    ) data_sram (
-      .clk_i  (vrf_clk                           ),
-      .rst_ni (rst_ni                            ),
-      .req_i  (req_i[bank]                       ),
-      .we_i   (wen_i[bank]                       ),
-      .rdata_o(rdata[bank]                       ),
-      .wdata_i(wdata_i[bank]                     ),
-      .be_i   (be_i[bank]                        ),
-      .addr_i (addr_i[bank][$clog2(NumWords)-1:0])
-    );
+    if (VrfDualPort) begin: gen_dual_port
+      // Port 0 reads, and port 1 writes
+      elen_t unused_rdata;
+
+      tc_sram #(
+        .NumWords (NumWords ),
+        .DataWidth(DataWidth),
+        .NumPorts (2        )
+      ) data_sram (
+        .clk_i  (vrf_clk                                                                    ),
+        .rst_ni (rst_ni                                                                     ),
+        .req_i  ({wr_req_i[bank], req_i[bank]}                                              ),
+        .we_i   ({1'b1, 1'b0}                                                               ),
+        .rdata_o({unused_rdata, rdata[bank]}                                                ),
+        .wdata_i({wr_wdata_i[bank], elen_t'('0)}                                            ),
+        .be_i   ({wr_be_i[bank], strb_t'('0)}                                               ),
+        .addr_i ({wr_addr_i[bank][$clog2(NumWords)-1:0], addr_i[bank][$clog2(NumWords)-1:0]})
+      );
+    end else begin: gen_single_port
+      tc_sram #(
+        .NumWords (NumWords ),
+        .DataWidth(DataWidth),
+        .NumPorts (1        )
+      ) data_sram (
+        .clk_i  (vrf_clk                           ),
+        .rst_ni (rst_ni                            ),
+        .req_i  (req_i[bank]                       ),
+        .we_i   (wen_i[bank]                       ),
+        .rdata_o(rdata[bank]                       ),
+        .wdata_i(wdata_i[bank]                     ),
+        .be_i   (be_i[bank]                        ),
+        .addr_i (addr_i[bank][$clog2(NumWords)-1:0])
+      );
+    end
   end : gen_banks
 
   ///////////////////
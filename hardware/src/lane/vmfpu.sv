@@ -18,6 +18,8 @@ module vmfpu import ara_pkg::*; import rvv_pkg::*; import fpnew_pkg::*;
     parameter  fixpt_support_e        FixPtSupport = FixedPointEnable,
     // Type used to address vector register file elements
     parameter  type                   vaddr_t      = logic,
+    // VFU of the instructions of this unit, VFU_MFpu2 for the second VMFPU of the lane
+    parameter  vfu_e                  VFUId        = VFU_MFpu,
     // Dependant parameters. DO NOT CHANGE!
     localparam int           unsigned DataWidth    = $bits(elen_t),
     localparam int           unsigned StrbWidth    = DataWidth/8,
@@ -54,6 +56,11 @@ module vmfpu import ara_pkg::*; import rvv_pkg::*; import fpnew_pkg::*;
     input  elen_t                        sldu_operand_i,
     input  logic                         sldu_mfpu_valid_i,
     output logic                         sldu_mfpu_ready_o,
+    // Interface with the neighbour lanes, for the ordered reductions
+    output elen_t                        osum_result_o,
+    output logic                         osum_result_valid_o,
+    input  elen_t                        osum_operand_i,
+    input  logic                         osum_operand_valid_i,
     // Interface with the Mask unit
     output elen_t                        mask_operand_o,
     output logic                         mask_operand_valid_o,
@@ -194,19 +201,19 @@ module vmfpu import ara_pkg::*; import rvv_pkg::*; import fpnew_pkg::*;
   assign vinsn_issue_fpu = vinsn_issue_q.op inside {[VFADD:VMFGE]};
 
   // This function returns the latency of the FPU operation,
-  // depending on the sew as well
+  // depending on the sew and on the FP format as well
   typedef logic [idx_width(LatFMax)-1:0] fpu_latency_t;
-  function automatic fpu_latency_t fpu_latency(vew_e sew, ara_op_e op);
+  function automatic fpu_latency_t fpu_latency(vtype_t vtype, ara_op_e op);
     case (op) inside
       VFDIV, VFRDIV, VFSQRT:  fpu_latency = LatFDivSqrt;
       [VFREDMIN:VFREDMAX]:    fpu_latency = LatFNonComp;
       [VFCVTXUF:VFCVTFF]:     fpu_latency = LatFConv;
       [VFMIN:VFSGNJX]:        fpu_latency = LatFNonComp;
       default: begin
-        case (sew)
+        case (vtype.vsew)
           EW64:    fpu_latency = LatFCompEW64;
           EW32:    fpu_latency = LatFCompEW32;
-          default: fpu_latency = LatFCompEW16;
+          default: fpu_latency = vtype.altfmt ? LatFCompEW16Alt : LatFCompEW16;
         endcase
       end
     endcase
@@ -538,22 +545,41 @@ module vmfpu import ara_pkg::*; import rvv_pkg::*; import fpnew_pkg::*;
   // committed.
   strb_t vdiv_mask;
 
-  simd_div i_simd_div (
-    .clk_i      (clk_i                                                      ),
-    .rst_ni     (rst_ni                                                     ),
-    .operand_a_i(mfpu_operand_i[1]                                          ),
-    .operand_b_i(vinsn_issue_q.use_scalar_op ? scalar_op : mfpu_operand_i[0]),
-    .mask_i     (mask_i                                                     ),
-    .op_i       (vinsn_issue_q.op                                           ),
-    .be_i       (issue_be                                                   ),
-    .vew_i      (vinsn_issue_q.vtype.vsew                                   ),
-    .result_o   (vdiv_result                                                ),
-    .mask_o     (vdiv_mask                                                  ),
-    .valid_i    (vdiv_in_valid                                              ),
-    .ready_o    (vdiv_in_ready                                              ),
-    .ready_i    (vdiv_out_ready                                             ),
-    .valid_o    (vdiv_out_valid                                             )
-  );
+  if (SimdDivParallel) begin : gen_simd_pardiv
+    simd_pardiv i_simd_div (
+      .clk_i      (clk_i                                                      ),
+      .rst_ni     (rst_ni                                                     ),
+      .operand_a_i(mfpu_operand_i[1]                                          ),
+      .operand_b_i(vinsn_issue_q.use_scalar_op ? scalar_op : mfpu_operand_i[0]),
+      .mask_i     (mask_i                                                     ),
+      .op_i       (vinsn_issue_q.op                                           ),
+      .be_i       (issue_be                                                   ),
+      .vew_i      (vinsn_issue_q.vtype.vsew                                   ),
+      .result_o   (vdiv_result                                                ),
+      .mask_o     (vdiv_mask                                                  ),
+      .valid_i    (vdiv_in_valid                                              ),
+      .ready_o    (vdiv_in_ready                                              ),
+      .ready_i    (vdiv_out_ready                                             ),
+      .valid_o    (vdiv_out_valid                                             )
+    );
+  end : gen_simd_pardiv else begin : gen_simd_div
+    simd_div i_simd_div (
+      .clk_i      (clk_i                                                      ),
+      .rst_ni     (rst_ni                                                     ),
+      .operand_a_i(mfpu_operand_i[1]                                          ),
+      .operand_b_i(vinsn_issue_q.use_scalar_op ? scalar_op : mfpu_operand_i[0]),
+      .mask_i     (mask_i                                                     ),
+      .op_i       (vinsn_issue_q.op                                           ),
+      .be_i       (issue_be                                                   ),
+      .vew_i      (vinsn_issue_q.vtype.vsew                                   ),
+      .result_o   (vdiv_result                                                ),
+      .mask_o     (vdiv_mask                                                  ),
+      .valid_i    (vdiv_in_valid                                              ),
+      .ready_o    (vdiv_in_ready                                              ),
+      .ready_i    (vdiv_out_ready                                             ),
+      .valid_o    (vdiv_out_valid                                             )
+    );
+  end : gen_simd_div
 
   //////////////////
   //  Reductions  //
@@ -576,6 +602,12 @@ module vmfpu import ara_pkg::*; import rvv_pkg::*; import fpnew_pkg::*;
     .data_o (sldu_operand_q  )
   );
 
+  // The partial sums of an ordered reduction go from one lane to the next one
+  // without the SLDU, which only brings the last one back to lane 0. There is
+  // only one partial sum in flight, so the lanes always accept it.
+  elen_t osum_d, osum_q;
+  logic  osum_valid_d, osum_valid_q;
+
   // During an inter-lane reduction (after the intra-lane reduction), the NrLanes partial results
   // must be reduced to only one. The first reduction is done by NrLanes/2 FUs, then NrLanes/4, and
   // so on. In the end, the result is collected in Lane 0 and the last SIMD reduction is performed.
@@ -699,27 +731,17 @@ module vmfpu import ara_pkg::*; import rvv_pkg::*; import fpnew_pkg::*;
     endcase
   endfunction : processed_osum_operand
 
-  // Use this function to assign a counter value to each lane if you can use in-lane parameters with your flow
-  function automatic reduction_rx_cnt_t reduction_rx_cnt_init(int unsigned NrLanes, logic [3:0] lane_id);
+  // Counter value of each lane
+  function automatic reduction_rx_cnt_t reduction_rx_cnt_init(int unsigned NrLanes,
+      logic [idx_width(MaxNrLanes)-1:0] lane_id);
     // The even lanes do not receive intermediate results. Only Lane 0 will receive the final result, but this is not checked here.
-    case (lane_id)
-      0:  reduction_rx_cnt_init = reduction_rx_cnt_t'(0);
-      1:  reduction_rx_cnt_init = reduction_rx_cnt_t'(1);
-      2:  reduction_rx_cnt_init = reduction_rx_cnt_t'(0);
-      3:  reduction_rx_cnt_init = reduction_rx_cnt_t'(2);
-      4:  reduction_rx_cnt_init = reduction_rx_cnt_t'(0);
-      5:  reduction_rx_cnt_init = reduction_rx_cnt_t'(1);
-      6:  reduction_rx_cnt_init = reduction_rx_cnt_t'(0);
-      7:  reduction_rx_cnt_init = reduction_rx_cnt_t'(3);
-      8:  reduction_rx_cnt_init = reduction_rx_cnt_t'(0);
-      9:  reduction_rx_cnt_init = reduction_rx_cnt_t'(1);
-      10: reduction_rx_cnt_init = reduction_rx_cnt_t'(0);
-      11: reduction_rx_cnt_init = reduction_rx_cnt_t'(2);
-      12: reduction_rx_cnt_init = reduction_rx_cnt_t'(0);
-      13: reduction_rx_cnt_init = reduction_rx_cnt_t'(1);
-      14: reduction_rx_cnt_init = reduction_rx_cnt_t'(0);
-      15: reduction_rx_cnt_init = reduction_rx_cnt_t'(4);
-    endcase
+    // A lane receives one intermediate result per trailing one of its index.
+    automatic logic ones = 1'b1;
+    reduction_rx_cnt_init = '0;
+    for (int i = 0; i < $clog2(NrLanes); i++) begin
+      ones &= lane_id[i];
+      reduction_rx_cnt_init += ones;
+    end
   endfunction: reduction_rx_cnt_init
   ///////////
   //  FPU  //
@@ -736,6 +758,9 @@ module vmfpu import ara_pkg::*; import rvv_pkg::*; import fpnew_pkg::*;
   logic          fflags_ex_valid_d, fflags_ex_valid_q;
   logic    [4:0] fflags_ex_d, fflags_ex_q;
 
+  // The partial sums of the ordered reductions leave the FPU to the next lane
+  assign osum_result_o = vfpu_processed_result;
+
   // In floating-point comparisons the tag is used as mask,
   // In unordered reductions the tag is used as ntr indicator.
   // 0: no neutral value,
@@ -762,7 +787,7 @@ module vmfpu import ara_pkg::*; import rvv_pkg::*; import fpnew_pkg::*;
       Width        : 64,
       EnableVectors: 1'b1,
       EnableNanBox : 1'b1,
-      FpFmtMask    : {RVVF(FPUSupport), RVVD(FPUSupport), RVVH(FPUSupport), 1'b0, 1'b0},
+      FpFmtMask    : {RVVF(FPUSupport), RVVD(FPUSupport), RVVH(FPUSupport), 1'b0, FPAltFmtSupport},
       IntFmtMask   : {1'b0, 1'b1, 1'b1, 1'b1}
     };
 
@@ -775,7 +800,8 @@ module vmfpu import ara_pkg::*; import rvv_pkg::*; import fpnew_pkg::*;
         '{default: LatFConv}},
       UnitTypes: '{
         '{default: PARALLEL}, // ADDMUL
-        '{default: MERGED},   // DIVSQRT
+        // The divisions and square roots have their own units if there are more than one
+        '{default: (FDivSqrtUnits > 1) ? DISABLED : MERGED}, // DIVSQRT
         '{default: PARALLEL}, // NONCOMP
         '{default: MERGED}}, // CONV
       PipeConfig: DISTRIBUTED
@@ -918,7 +944,7 @@ module vmfpu import ara_pkg::*; import rvv_pkg::*; import fpnew_pkg::*;
           fp_rm = RNE;
           // positive infinity
           case (vinsn_issue_q.vtype.vsew)
-            EW16: ntr_val = {4{16'h7c00}};
+            EW16: ntr_val = vinsn_issue_q.vtype.altfmt ? {4{16'h7f80}} : {4{16'h7c00}};
             EW32: ntr_val = {2{32'h7f800000}};
             default: // EW64
               ntr_val = 64'h7ff0000000000000;
@@ -929,7 +955,7 @@ module vmfpu import ara_pkg::*; import rvv_pkg::*; import fpnew_pkg::*;
           fp_rm = RTZ;
           // negative infinity
           case (vinsn_issue_q.vtype.vsew)
-            EW16: ntr_val = {4{16'hfc00}};
+            EW16: ntr_val = vinsn_issue_q.vtype.altfmt ? {4{16'hff80}} : {4{16'hfc00}};
             EW32: ntr_val = {2{32'hff800000}};
             default: // EW64
               ntr_val = 64'hfff0000000000000;
@@ -938,16 +964,18 @@ module vmfpu import ara_pkg::*; import rvv_pkg::*; import fpnew_pkg::*;
         default:;
       endcase
 
-      // vtype.vsew encodes the destination format
+      // vtype.vsew encodes the destination format, and vtype.altfmt the 16-bit FP format
       // cvt_resize is reused as neutral value for reductions
       unique case (vinsn_issue_q.vtype.vsew)
         EW16: begin
-          fp_src_fmt = (vinsn_issue_q.cvt_resize == CVT_NARROW && !is_reduction(vinsn_issue_q.op)) ? FP32 : FP16;
-          fp_dst_fmt = FP16;
+          fp_src_fmt = (vinsn_issue_q.cvt_resize == CVT_NARROW && !is_reduction(vinsn_issue_q.op)) ? FP32 :
+            (vinsn_issue_q.vtype.altfmt ? FP16ALT : FP16);
+          fp_dst_fmt = vinsn_issue_q.vtype.altfmt ? FP16ALT : FP16;
           fp_int_fmt = (vinsn_issue_q.cvt_resize == CVT_NARROW && !is_reduction(vinsn_issue_q.op) && fp_op == I2F) ? INT32 : INT16;
         end
         EW32: begin
-          fp_src_fmt = (vinsn_issue_q.cvt_resize == CVT_WIDE && !is_reduction(vinsn_issue_q.op)) ? FP16 :
+          fp_src_fmt = (vinsn_issue_q.cvt_resize == CVT_WIDE && !is_reduction(vinsn_issue_q.op)) ?
+            (vinsn_issue_q.vtype.altfmt ? FP16ALT : FP16) :
             ((vinsn_issue_q.cvt_resize == CVT_NARROW && !is_reduction(vinsn_issue_q.op)) ? FP64 : FP32);
           fp_dst_fmt = FP32;
           fp_int_fmt = (vinsn_issue_q.cvt_resize == CVT_WIDE && !is_reduction(vinsn_issue_q.op) && fp_op == I2F) ? INT16 :
@@ -979,6 +1007,12 @@ module vmfpu import ara_pkg::*; import rvv_pkg::*; import fpnew_pkg::*;
       assign vfpu_simd_mask[b] = issue_be[2*b];
     end: gen_vfpu_simd_mask
 
+    // Handshake and results of the bulk FPU
+    logic    bulk_in_valid, bulk_in_ready, bulk_out_valid, bulk_out_ready;
+    elen_t   bulk_result;
+    status_t bulk_ex_flag;
+    strb_t   bulk_tag_out;
+
     fpnew_top #(
       .Features      (FPUFeatures      ),
       .Implementation(FPUImplementation),
@@ -1000,16 +1034,131 @@ module vmfpu import ara_pkg::*; import rvv_pkg::*; import fpnew_pkg::*;
       .src_fmt_i     (fp_src_fmt     ),
       .dst_fmt_i     (fp_dst_fmt     ),
       .int_fmt_i     (fp_int_fmt     ),
-      .in_valid_i    (vfpu_in_valid  ),
-      .in_ready_o    (vfpu_in_ready  ),
-      .result_o      (vfpu_result    ),
-      .status_o      (vfpu_ex_flag_fn),
-      .tag_o         (vfpu_tag_out   ),
-      .out_valid_o   (vfpu_out_valid ),
-      .out_ready_i   (vfpu_out_ready ),
+      .in_valid_i    (bulk_in_valid  ),
+      .in_ready_o    (bulk_in_ready  ),
+      .result_o      (bulk_result    ),
+      .status_o      (bulk_ex_flag   ),
+      .tag_o         (bulk_tag_out   ),
+      .out_valid_o   (bulk_out_valid ),
+      .out_ready_i   (bulk_out_ready ),
       .busy_o        (/* Unused */   )
     );
 
+    if (FDivSqrtUnits == 1) begin : gen_fdivsqrt_bulk
+      // The bulk FPU executes all the operations
+      assign bulk_in_valid   = vfpu_in_valid;
+      assign bulk_out_ready  = vfpu_out_ready;
+      assign vfpu_in_ready   = bulk_in_ready;
+      assign vfpu_result     = bulk_result;
+      assign vfpu_ex_flag_fn = bulk_ex_flag;
+      assign vfpu_tag_out    = bulk_tag_out;
+      assign vfpu_out_valid  = bulk_out_valid;
+    end : gen_fdivsqrt_bulk else begin : gen_fdivsqrt_units
+      // Each unit is an iterative division and square root of fpnew
+      localparam fpu_implementation_t FDivSqrtImplementation = '{
+        PipeRegs: '{
+          '{default: 0},
+          '{default: LatFDivSqrt},
+          '{default: 0},
+          '{default: 0}},
+        UnitTypes: '{
+          '{default: DISABLED}, // ADDMUL
+          '{default: MERGED},   // DIVSQRT
+          '{default: DISABLED}, // NONCOMP
+          '{default: DISABLED}}, // CONV
+        PipeConfig: DISTRIBUTED
+      };
+
+      logic    [FDivSqrtUnits-1:0] fdivsqrt_in_valid, fdivsqrt_in_ready;
+      logic    [FDivSqrtUnits-1:0] fdivsqrt_out_valid, fdivsqrt_out_ready;
+      elen_t   [FDivSqrtUnits-1:0] fdivsqrt_result;
+      status_t [FDivSqrtUnits-1:0] fdivsqrt_ex_flag;
+      strb_t   [FDivSqrtUnits-1:0] fdivsqrt_tag_out;
+
+      // Unit of the next word to issue, and of the next result to collect
+      logic [idx_width(FDivSqrtUnits)-1:0] issue_pnt_d, issue_pnt_q, commit_pnt_d, commit_pnt_q;
+
+      // Is the word being issued, or the result being collected, a division or a square root?
+      logic issue_fdivsqrt, commit_fdivsqrt;
+      assign issue_fdivsqrt  = fp_op inside {DIV, SQRT};
+      assign commit_fdivsqrt = vinsn_processing_q.op inside {VFDIV, VFRDIV, VFSQRT};
+
+      for (genvar u = 0; u < FDivSqrtUnits; u++) begin : gen_fdivsqrt
+        fpnew_top #(
+          .Features      (FPUFeatures           ),
+          .Implementation(FDivSqrtImplementation),
+          .TagType       (strb_t                ),
+          .NumLanes      (FPULanes              ),
+          .TrueSIMDClass (TrueSIMDClass         ),
+          .MaskType      (fpu_mask_t            )
+        ) i_fpnew_divsqrt (
+          .clk_i         (clk_i                 ),
+          .rst_ni        (rst_ni                ),
+          .flush_i       (1'b0                  ),
+          .rnd_mode_i    (fp_rm                 ),
+          .op_i          (fp_op                 ),
+          .op_mod_i      (fp_opmod              ),
+          .vectorial_op_i(1'b1                  ),
+          .operands_i    (vfpu_operands         ),
+          .tag_i         (vfpu_tag_in           ),
+          .simd_mask_i   (vfpu_simd_mask        ),
+          .src_fmt_i     (fp_src_fmt            ),
+          .dst_fmt_i     (fp_dst_fmt            ),
+          .int_fmt_i     (fp_int_fmt            ),
+          .in_valid_i    (fdivsqrt_in_valid[u]  ),
+          .in_ready_o    (fdivsqrt_in_ready[u]  ),
+          .result_o      (fdivsqrt_result[u]    ),
+          .status_o      (fdivsqrt_ex_flag[u]   ),
+          .tag_o         (fdivsqrt_tag_out[u]   ),
+          .out_valid_o   (fdivsqrt_out_valid[u] ),
+          .out_ready_i   (fdivsqrt_out_ready[u] ),
+          .busy_o        (/* Unused */          )
+        );
+      end : gen_fdivsqrt
+
+      // The words go to the units in round-robin order, and their results are collected in
+      // the same order. The results of the bulk FPU wait for the end of the division.
+      always_comb begin : p_fdivsqrt_rr
+        issue_pnt_d  = issue_pnt_q;
+        commit_pnt_d = commit_pnt_q;
+
+        bulk_in_valid                  = vfpu_in_valid && !issue_fdivsqrt;
+        fdivsqrt_in_valid              = '0;
+        fdivsqrt_in_valid[issue_pnt_q] = vfpu_in_valid && issue_fdivsqrt;
+        vfpu_in_ready = issue_fdivsqrt ? fdivsqrt_in_ready[issue_pnt_q] : bulk_in_ready;
+
+        bulk_out_ready                   = vfpu_out_ready && !commit_fdivsqrt;
+        fdivsqrt_out_ready               = '0;
+        fdivsqrt_out_ready[commit_pnt_q] = vfpu_out_ready && commit_fdivsqrt;
+        if (commit_fdivsqrt) begin
+          vfpu_out_valid  = fdivsqrt_out_valid[commit_pnt_q];
+          vfpu_result     = fdivsqrt_result[commit_pnt_q];
+          vfpu_ex_flag_fn = fdivsqrt_ex_flag[commit_pnt_q];
+          vfpu_tag_out    = fdivsqrt_tag_out[commit_pnt_q];
+        end else begin
+          vfpu_out_valid  = bulk_out_valid;
+          vfpu_result     = bulk_result;
+          vfpu_ex_flag_fn = bulk_ex_flag;
+          vfpu_tag_out    = bulk_tag_out;
+        end
+
+        if (fdivsqrt_in_valid[issue_pnt_q] && fdivsqrt_in_ready[issue_pnt_q])
+          issue_pnt_d = (issue_pnt_q == FDivSqrtUnits-1) ? '0 : issue_pnt_q + 1;
+        if (fdivsqrt_out_valid[commit_pnt_q] && fdivsqrt_out_ready[commit_pnt_q])
+          commit_pnt_d = (commit_pnt_q == FDivSqrtUnits-1) ? '0 : commit_pnt_q + 1;
+      end : p_fdivsqrt_rr
+
+      always_ff @(posedge clk_i or negedge rst_ni) begin
+        if (!rst_ni) begin
+          issue_pnt_q  <= '0;
+          commit_pnt_q <= '0;
+        end else begin
+          issue_pnt_q  <= issue_pnt_d;
+          commit_pnt_q <= commit_pnt_d;
+        end
+      end
+    end : gen_fdivsqrt_units
+
     ////////////////////////
     // VFREC7 & VFRSQRT7 //
     ///////////////////////
@@ -1304,8 +1453,8 @@ module vmfpu import ara_pkg::*; import rvv_pkg::*; import fpnew_pkg::*;
     issue_be = '0;
 
     // Get latencies
-    vinsn_issue_lat_d      = fpu_latency(vinsn_issue_d.vtype.vsew, vinsn_issue_d.op);
-    vinsn_processing_lat_d = fpu_latency(vinsn_processing_d.vtype.vsew, vinsn_processing_d.op);
+    vinsn_issue_lat_d      = fpu_latency(vinsn_issue_d.vtype, vinsn_issue_d.op);
+    vinsn_processing_lat_d = fpu_latency(vinsn_processing_d.vtype, vinsn_processing_d.op);
 
     // fpnew allows out-of-order execution and different instruction
     // types have different latencies. We have to enforce in-order execution.
@@ -1358,6 +1507,9 @@ module vmfpu import ara_pkg::*; import rvv_pkg::*; import fpnew_pkg::*;
     intra_op_rx_cnt_en      = 1'b0;
 
     osum_issue_cnt_d        = osum_issue_cnt_q;
+    osum_d                  = osum_q;
+    osum_valid_d            = osum_valid_q;
+    osum_result_valid_o     = 1'b0;
 
     // Don't prevent commit by default
     prevent_commit = 1'b0;
@@ -1704,7 +1856,7 @@ module vmfpu import ara_pkg::*; import rvv_pkg::*; import fpnew_pkg::*;
 
             // Is FPU in use ready?
             if (vfpu_in_ready) begin
-              automatic int unsigned latency = fpu_latency(vinsn_issue_q.vtype.vsew, vinsn_issue_q.op);
+              automatic int unsigned latency = fpu_latency(vinsn_issue_q.vtype, vinsn_issue_q.op);
 
               if (vfpu_tag_in == strb_t'(2))
                 issue_cnt_d = issue_cnt_q + (1 << (int'(EW64) - int'(vinsn_issue_q.vtype.vsew)));
@@ -1886,7 +2038,7 @@ module vmfpu import ara_pkg::*; import rvv_pkg::*; import fpnew_pkg::*;
         operand_c = processed_osum_operand(mfpu_operand_i[2], osum_issue_cnt_q, vinsn_issue_q.vtype.vsew, ~vinsn_issue_q.vm, mask_i, ntr_val);
         operand_b = (first_op_q && (lane_id_i == '0)) ?
                     (vinsn_issue_q.use_scalar_op ? scalar_op : mfpu_operand_i[0]) :
-                    sldu_operand_q;
+                    osum_q;
 
         if (mfpu_operand_valid_i[2] && (mask_valid_i || vinsn_issue_q.vm)) begin
           if (first_op_q) begin
@@ -1894,9 +2046,9 @@ module vmfpu import ara_pkg::*; import rvv_pkg::*; import fpnew_pkg::*;
               operands_valid = mfpu_operand_valid_i[0];
             else
               // Also check op_b, because it needs to be acknowledged
-              operands_valid = mfpu_operand_valid_i[0] && sldu_mfpu_valid_q;
+              operands_valid = mfpu_operand_valid_i[0] && osum_valid_q;
           end else begin
-            operands_valid = sldu_mfpu_valid_q;
+            operands_valid = osum_valid_q;
           end
         end else begin
           operands_valid = 1'b0;
@@ -1927,9 +2079,9 @@ module vmfpu import ara_pkg::*; import rvv_pkg::*; import fpnew_pkg::*;
             // Acknowledge scalar operand_b
             if (first_op_q) mfpu_operand_ready_o[0] = 1'b1;
 
-            // Acknowledge operand_c from the slide unit
+            // Consume the partial sum of the previous lane
             // Note: Also ack even if this is the first operation in lane 0
-            sldu_mfpu_ready_d = 1'b1;
+            osum_valid_d = 1'b0;
 
             // Give the correct be signal to the divider/FPU
             issue_be = be(1, vinsn_issue_q.vtype.vsew) & (vinsn_issue_q.vm ? {StrbWidth{1'b1}} : mask_i);
@@ -1950,8 +2102,13 @@ module vmfpu import ara_pkg::*; import rvv_pkg::*; import fpnew_pkg::*;
         if (vfpu_out_valid && !result_queue_full) begin
           to_process_cnt_d = to_process_cnt_q - 1;
 
-          result_queue_d[result_queue_write_pnt_q].wdata = vfpu_processed_result;
-          result_queue_valid_d[result_queue_write_pnt_q] = 1'b1;
+          // Only the last element goes to lane 0 through the SLDU, the
+          // partial sums go straight to the next lane
+          if (vinsn_processing_q.osum_last && to_process_cnt_q == 1) begin
+            result_queue_d[result_queue_write_pnt_q].wdata = vfpu_processed_result;
+            result_queue_valid_d[result_queue_write_pnt_q] = 1'b1;
+          end else
+            osum_result_valid_o = 1'b1;
         end
 
         // Slide unit has acknowledged the operand, set next valid to 0
@@ -1965,7 +2122,8 @@ module vmfpu import ara_pkg::*; import rvv_pkg::*; import fpnew_pkg::*;
 
         // Finish this instruction if the last result is acknowledged
         // In the case of vl=0, wait until the redundant data is acknowledged
-        if (!(lane_id_i == '0) && to_process_cnt_d == '0 && ((vinsn_processing_q.vl == '0) ? !first_op_q : red_hs_synch_q)) begin
+        if (!(lane_id_i == '0) && to_process_cnt_d == '0 && ((vinsn_processing_q.vl == '0) ? !first_op_q :
+            (!vinsn_processing_q.osum_last || red_hs_synch_q))) begin
           // Give the done to the main sequencer
           commit_cnt_d = '0;
           mfpu_state_d = MFPU_WAIT;
@@ -2036,6 +2194,12 @@ module vmfpu import ara_pkg::*; import rvv_pkg::*; import fpnew_pkg::*;
       default:;
     endcase
 
+    // Keep the partial sum of the previous lane until its element arrives
+    if (osum_operand_valid_i) begin
+      osum_d       = osum_operand_i;
+      osum_valid_d = 1'b1;
+    end
+
     //////////////////////////////////
     //  Write results into the VRF  //
     //////////////////////////////////
@@ -2122,7 +2286,8 @@ module vmfpu import ara_pkg::*; import rvv_pkg::*; import fpnew_pkg::*;
     //////////////////////////////
 
     if (!vinsn_queue_full && vfu_operation_valid_i &&
-      (vfu_operation_i.vfu == VFU_MFpu || vfu_operation_i.op inside {[VMFEQ:VMFGE]})) begin
+      (vfu_operation_i.vfu == VFUId ||
+       (VFUId == VFU_MFpu && vfu_operation_i.op inside {[VMFEQ:VMFGE]}))) begin
       vinsn_queue_d.vinsn[vinsn_queue_q.accept_pnt] = vfu_operation_i;
 
       // Initialize counters
@@ -2165,6 +2330,8 @@ module vmfpu import ara_pkg::*; import rvv_pkg::*; import fpnew_pkg::*;
                 fp32.s = fp16.s;
                 fp32.e = (fp16.e - 15) + 127;
                 fp32.m = {fp16.m, 13'b0};
+                // BF16 is the upper half of FP32
+                if (FPAltFmtSupport && vfu_operation_i.vtype.altfmt) fp32 = {fp16, 16'b0};
 
                 vinsn_queue_d.vinsn[vinsn_queue_q.accept_pnt].scalar_op[32*e +: 32] = fp32;
               end
@@ -2214,6 +2381,8 @@ module vmfpu import ara_pkg::*; import rvv_pkg::*; import fpnew_pkg::*;
       intra_issued_op_cnt_q   <= '0;
       intra_op_rx_cnt_q       <= '0;
       osum_issue_cnt_q        <= '0;
+      osum_q                  <= '0;
+      osum_valid_q            <= 1'b0;
       mfpu_vxsat_q            <= '0;
       clkgate_en_q            <= 1'b0;
     end else begin
@@ -2238,6 +2407,8 @@ module vmfpu import ara_pkg::*; import rvv_pkg::*; import fpnew_pkg::*;
       intra_issued_op_cnt_q   <= intra_issued_op_cnt_d;
       intra_op_rx_cnt_q       <= intra_op_rx_cnt_d;
       osum_issue_cnt_q        <= osum_issue_cnt_d;
+      osum_q                  <= osum_d;
+      osum_valid_q            <= osum_valid_d;
       mfpu_vxsat_q            <= mfpu_vxsat_d;
       clkgate_en_q            <= clkgate_en_d;
     end
@@ -0,0 +1,300 @@
+// Copyright 2021 ETH Zurich and University of Bologna.
+// Solderpad Hardware License, Version 0.51, see LICENSE for details.
+// SPDX-License-Identifier: SHL-0.51
+//
+// Description:
+// Ara's matrix outer-product unit (MXU). Each lane keeps its slice of MxuTiles tiles, of two
+// rows of one FP32 vector register each. vfmop.vx and vfmopa.vx write, or accumulate into, the
+// tile rd the outer product of the two FP32 values packed in rs1 with the elements of vs2:
+//   T[rd][r][i] (+)= rs1[32*r +: 32] * vs2[i], with r = 0, 1
+// i.e., four FP32 multiply-adds per cycle, on one operand word. vfmtr.vx moves the row rs1 % 2
+// of the tile rs1 / 2 to vd. The tiles never leave the lane, so that the MXU reads one vector
+// register operand for two rows of results, while vfmacc reads two of them for one row.
+//
+// The instructions are executed in order. An outer product waits for the words of its tile
+// still in the FPU, and a move waits for all of them. The outer products wait for the last word
+// of a move to be written, so that two instructions never finish in the same cycle.
+
+module vmxu import ara_pkg::*; import rvv_pkg::*; import fpnew_pkg::*;
+  import cf_math_pkg::idx_width; #(
+    parameter  int  unsigned NrLanes   = 0,
+    // Type used to address vector register file elements
+    parameter  type          vaddr_t   = logic,
+    // Dependant parameters. DO NOT CHANGE!
+    localparam int  unsigned DataWidth = $bits(elen_t),
+    localparam type          strb_t    = logic [DataWidth/8-1:0]
+  ) (
+    input  logic                 clk_i,
+    input  logic                 rst_ni,
+    // Interface with CVA6
+    output logic [4:0]           fflags_ex_o,
+    output logic                 fflags_ex_valid_o,
+    // Interface with the lane sequencer
+    input  vfu_operation_t       vfu_operation_i,
+    input  logic                 vfu_operation_valid_i,
+    output logic [NrVInsn-1:0]   mxu_vinsn_done_o,
+    // Interface with the operand queues
+    input  elen_t                mxu_operand_i,
+    input  logic                 mxu_operand_valid_i,
+    output logic                 mxu_operand_ready_o,
+    // Interface with the vector register file
+    output logic                 mxu_result_req_o,
+    output vid_t                 mxu_result_id_o,
+    output vaddr_t               mxu_result_addr_o,
+    output elen_t                mxu_result_wdata_o,
+    output strb_t                mxu_result_be_o,
+    input  logic                 mxu_result_gnt_i
+  );
+
+  `include "common_cells/registers.svh"
+
+  // Words of a vector register in each lane
+  localparam int unsigned NrWords = VLENB / NrLanes / 8;
+
+  typedef logic [idx_width(MxuTiles)-1:0] tile_t;
+  typedef logic [idx_width(NrWords)-1:0]  word_t;
+
+  ////////////////////////////////
+  //  Vector instruction queue  //
+  ////////////////////////////////
+
+  vfu_operation_t vinsn;
+  logic           vinsn_empty, vinsn_pop;
+
+  fifo_v3 #(
+    .DEPTH(MfpuInsnQueueDepth),
+    .dtype(vfu_operation_t   )
+  ) i_vinsn_queue (
+    .clk_i     (clk_i                                                    ),
+    .rst_ni    (rst_ni                                                   ),
+    .flush_i   (1'b0                                                     ),
+    .testmode_i(1'b0                                                     ),
+    .data_i    (vfu_operation_i                                          ),
+    .push_i    (vfu_operation_valid_i && vfu_operation_i.vfu == VFU_MxUnit),
+    .full_o    (/* Unused */                                             ),
+    .data_o    (vinsn                                                    ),
+    .pop_i     (vinsn_pop                                                ),
+    .empty_o   (vinsn_empty                                              ),
+    .usage_o   (/* Unused */                                             )
+  );
+
+  /////////////
+  //  Tiles  //
+  /////////////
+
+  elen_t [MxuTiles-1:0][1:0][NrWords-1:0] tile_d, tile_q;
+  // Words of the tiles with a result still in the FPU
+  logic  [MxuTiles-1:0][NrWords-1:0]      pend_d, pend_q;
+
+  `FF(tile_q, tile_d, '0)
+  `FF(pend_q, pend_d, '0)
+
+  ///////////
+  //  FPU  //
+  ///////////
+
+  // Tile word of the results in the FPU, and active elements of the word
+  typedef struct packed {
+    vid_t       id;
+    tile_t      tile;
+    word_t      word;
+    logic [1:0] mask;
+    logic       last;
+  } fpu_tag_t;
+
+  localparam fpu_features_t FPUFeatures = '{
+    Width        : 64,
+    EnableVectors: 1'b1,
+    EnableNanBox : 1'b1,
+    FpFmtMask    : 5'b10000, // FP32
+    IntFmtMask   : 4'b0010  // INT32
+  };
+
+  localparam fpu_implementation_t FPUImplementation = '{
+    PipeRegs: '{
+      '{default: LatFCompEW32},
+      '{default: 0},
+      '{default: 0},
+      '{default: 0}},
+    UnitTypes: '{
+      '{default: PARALLEL}, // ADDMUL
+      '{default: DISABLED}, // DIVSQRT
+      '{default: DISABLED}, // NONCOMP
+      '{default: DISABLED}}, // CONV
+    PipeConfig: DISTRIBUTED
+  };
+
+  typedef logic [1:0] fpu_mask_t;
+
+  logic                 fpu_in_valid;
+  logic     [1:0]       fpu_in_ready, fpu_out_valid;
+  elen_t    [1:0][2:0]  fpu_operands;
+  fpu_tag_t             fpu_tag_in;
+  fpu_tag_t [1:0]       fpu_tag_out;
+  elen_t    [1:0]       fpu_result;
+  status_t  [1:0]       fpu_status;
+
+  // One FPU per row of the tiles, in lockstep
+  for (genvar r = 0; r < 2; r++) begin: gen_fpnew
+    fpnew_top #(
+      .Features      (FPUFeatures                     ),
+      .Implementation(FPUImplementation),
+      .TagType       (fpu_tag_t                       ),
+      .NumLanes      (2                               ),
+      .MaskType      (fpu_mask_t                      )
+    ) i_fpnew (
+      .clk_i         (clk_i                           ),
+      .rst_ni        (rst_ni                          ),
+      .flush_i       (1'b0                            ),
+      .rnd_mode_i    (vinsn.fp_rm                     ),
+      .op_i          (vinsn.op == VFMOPA ? FMADD : MUL),
+      .op_mod_i      (1'b0                            ),
+      .vectorial_op_i(1'b1                            ),
+      .operands_i    (fpu_operands[r]                 ),
+      .tag_i         (fpu_tag_in                      ),
+      .simd_mask_i   (fpu_tag_in.mask                 ),
+      .src_fmt_i     (FP32                            ),
+      .dst_fmt_i     (FP32                            ),
+      .int_fmt_i     (INT32                           ),
+      .in_valid_i    (fpu_in_valid                    ),
+      .in_ready_o    (fpu_in_ready[r]                 ),
+      .result_o      (fpu_result[r]                   ),
+      .status_o      (fpu_status[r]                   ),
+      .tag_o         (fpu_tag_out[r]                  ),
+      .out_valid_o   (fpu_out_valid[r]                ),
+      .out_ready_i   (1'b1                            ),
+      .busy_o        (/* Unused */                    )
+    );
+  end: gen_fpnew
+
+  ///////////////
+  //  Control  //
+  ///////////////
+
+  // Next word of the instruction at the head of the queue
+  vlen_t word_d, word_q;
+
+  `FF(word_q, word_d, '0)
+
+  // Result of the tile moves, towards the VRF
+  logic   result_valid_d, result_valid_q;
+  vid_t   result_id_d, result_id_q;
+  vaddr_t result_addr_d, result_addr_q;
+  elen_t  result_wdata_d, result_wdata_q;
+  strb_t  result_be_d, result_be_q;
+  logic   result_last_d, result_last_q;
+
+  `FF(result_valid_q, result_valid_d, 1'b0)
+  `FF(result_id_q, result_id_d, '0)
+  `FF(result_addr_q, result_addr_d, '0)
+  `FF(result_wdata_q, result_wdata_d, '0)
+  `FF(result_be_q, result_be_d, '0)
+  `FF(result_last_q, result_last_d, 1'b0)
+
+  logic [NrVInsn-1:0] vinsn_done_d, vinsn_done_q;
+  logic [4:0]         fflags_d, fflags_q;
+  logic               fflags_valid_d, fflags_valid_q;
+
+  `FF(vinsn_done_q, vinsn_done_d, '0)
+  `FF(fflags_q, fflags_d, '0)
+  `FF(fflags_valid_q, fflags_valid_d, 1'b0)
+
+  assign mxu_vinsn_done_o   = vinsn_done_q;
+  assign fflags_ex_o        = fflags_q;
+  assign fflags_ex_valid_o  = fflags_valid_q;
+  assign mxu_result_req_o   = result_valid_q;
+  assign mxu_result_id_o    = result_id_q;
+  assign mxu_result_addr_o  = result_addr_q;
+  assign mxu_result_wdata_o = result_wdata_q;
+  assign mxu_result_be_o    = result_be_q;
+
+  always_comb begin: p_vmxu
+    // Words and elements of the instruction at the head of the queue
+    automatic vlen_t      words = (vinsn.vl + 1) >> 1;
+    automatic logic       last  = word_q == words - 1;
+    automatic logic [3:0] cnt   = vinsn.vl - (word_q << 1) > 1 ? 2 : 1;
+    automatic tile_t      tile  = vinsn.op == VFMTR ? tile_t'(vinsn.scalar_op >> 1) :
+                                                      tile_t'(vinsn.vd);
+    automatic logic       row   = vinsn.scalar_op[0];
+
+    tile_d         = tile_q;
+    pend_d         = pend_q;
+    word_d         = word_q;
+    result_valid_d = result_valid_q;
+    result_id_d    = result_id_q;
+    result_addr_d  = result_addr_q;
+    result_wdata_d = result_wdata_q;
+    result_be_d    = result_be_q;
+    result_last_d  = result_last_q;
+    vinsn_done_d   = '0;
+    fflags_d       = '0;
+    fflags_valid_d = 1'b0;
+
+    vinsn_pop           = 1'b0;
+    fpu_in_valid        = 1'b0;
+    mxu_operand_ready_o = 1'b0;
+
+    // Outer product of the two FP32 scalars with the operand word
+    for (int r = 0; r < 2; r++) begin
+      fpu_operands[r][0] = mxu_operand_i;
+      fpu_operands[r][1] = {2{vinsn.scalar_op[32*r +: 32]}};
+      fpu_operands[r][2] = tile_q[tile][r][word_q[idx_width(NrWords)-1:0]];
+    end
+    fpu_tag_in = '{
+      id  : vinsn.id,
+      tile: tile,
+      word: word_q[idx_width(NrWords)-1:0],
+      mask: cnt == 2 ? 2'b11 : 2'b01,
+      last: last
+    };
+
+    // Write the results back in the tiles
+    if (fpu_out_valid[0]) begin
+      for (int r = 0; r < 2; r++)
+        for (int e = 0; e < 2; e++)
+          if (fpu_tag_out[0].mask[e])
+            tile_d[fpu_tag_out[0].tile][r][fpu_tag_out[0].word][32*e +: 32] =
+              fpu_result[r][32*e +: 32];
+      pend_d[fpu_tag_out[0].tile][fpu_tag_out[0].word] = 1'b0;
+      if (fpu_tag_out[0].last) vinsn_done_d[fpu_tag_out[0].id] = 1'b1;
+      fflags_d       = fpu_status[0] | fpu_status[1];
+      fflags_valid_d = 1'b1;
+    end
+
+    // The VRF took the word of the tile move
+    if (result_valid_q && mxu_result_gnt_i) begin
+      result_valid_d = 1'b0;
+      if (result_last_q) vinsn_done_d[result_id_q] = 1'b1;
+    end
+
+    if (!vinsn_empty) begin
+      if (vinsn.op == VFMTR) begin
+        // Move the row once all the results are in the tiles
+        if (pend_q == '0 && (!result_valid_q || mxu_result_gnt_i)) begin
+          result_valid_d = 1'b1;
+          result_id_d    = vinsn.id;
+          result_addr_d  = vaddr(vinsn.vd, NrLanes) + word_q;
+          result_wdata_d = tile_q[tile][row][word_q[idx_width(NrWords)-1:0]];
+          result_be_d    = be(cnt, EW32);
+          result_last_d  = last;
+          word_d         = word_q + 1;
+        end
+      end else begin
+        // Only one result of each tile word is in the FPU, and the moves finish first
+        fpu_in_valid        = mxu_operand_valid_i && !result_valid_q &&
+                              !pend_q[tile][word_q[idx_width(NrWords)-1:0]];
+        mxu_operand_ready_o = fpu_in_valid && fpu_in_ready[0];
+        if (fpu_in_valid && fpu_in_ready[0]) begin
+          pend_d[tile][word_q[idx_width(NrWords)-1:0]] = 1'b1;
+          word_d = word_q + 1;
+        end
+      end
+
+      if (word_d != word_q && last) begin
+        word_d    = '0;
+        vinsn_pop = 1'b1;
+      end
+    end
+  end: p_vmxu
+
+endmodule : vmxu
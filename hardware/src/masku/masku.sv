@@ -66,6 +66,9 @@ module masku import ara_pkg::*; import rvv_pkg::*; #(
   elen_t [NrLanes-1:0] masku_operand_b_i;
   logic  [NrLanes-1:0] masku_operand_b_valid_i;
   logic  [NrLanes-1:0] masku_operand_b_ready_o;
+  // Value merged into the inactive bits of a mask result. The dispatcher does not request the
+  // old destination under a tail- and mask-agnostic policy, so these bits are set to ones.
+  elen_t [NrLanes-1:0] masku_operand_old_vd;
 
   // Mask
   elen_t [NrLanes-1:0] masku_operand_m_i;
@@ -91,47 +94,65 @@ module masku import ara_pkg::*; import rvv_pkg::*; #(
     assign masku_operand_ready_o[lane][0] = masku_operand_m_ready_o[lane];
   end: gen_unpack_masku_operands
 
+  assign masku_operand_old_vd = vinsn_issue.use_vd_op ? masku_operand_b_i : '1;
+
   ////////////////////////////////
   //  Vector instruction queue  //
   ////////////////////////////////
 
   // We store a certain number of in-flight vector instructions.
   // To avoid any hazards between masked vector instructions, the mask
-  // unit is only capable of handling one vector instruction at a time.
-  // Optimizing this unit is left as future work.
+  // unit handles one vector instruction at a time: the oldest one is
+  // issued and committed before the next one starts. The others wait
+  // in the queue, so that the main sequencer can go on issuing.
 
   localparam VInsnQueueDepth = MaskuInsnQueueDepth;
 
   struct packed {
     pe_req_t [VInsnQueueDepth-1:0] vinsn;
 
+    // Each instruction is accepted at the accept pointer, and is issued
+    // and committed at the commit pointer.
+    logic [idx_width(VInsnQueueDepth)-1:0] accept_pnt;
+    logic [idx_width(VInsnQueueDepth)-1:0] commit_pnt;
+
     // We also need to count how many instructions are queueing to be
     // issued/committed, to avoid accepting more instructions than
     // we can handle.
-    logic [idx_width(VInsnQueueDepth)-1:0] issue_cnt;
-    logic [idx_width(VInsnQueueDepth)-1:0] commit_cnt;
+    logic [idx_width(VInsnQueueDepth):0] issue_cnt;
+    logic [idx_width(VInsnQueueDepth):0] commit_cnt;
   } vinsn_queue_d, vinsn_queue_q;
 
   // Is the vector instruction queue full?
   logic vinsn_queue_full;
   assign vinsn_queue_full = (vinsn_queue_q.commit_cnt == VInsnQueueDepth);
 
+  // The oldest instruction was committed, and the next one in the queue starts in the
+  // next cycle. This leaves the same idle cycle between them as with a single-entry queue.
+  logic vinsn_switch_d, vinsn_switch_q;
+
+  // No instruction is running
+  logic vinsn_idle;
+  assign vinsn_idle = (vinsn_queue_q.commit_cnt == '0) || vinsn_switch_q;
+
   // Do we have a vector instruction ready to be issued?
   logic    vinsn_issue_valid;
-  assign vinsn_issue       = vinsn_queue_q.vinsn[0];
-  assign vinsn_issue_valid = (vinsn_queue_q.issue_cnt != '0);
+  assign vinsn_issue       = vinsn_queue_q.vinsn[vinsn_queue_q.commit_pnt];
+  assign vinsn_issue_valid = !vinsn_idle && (vinsn_queue_q.issue_cnt == vinsn_queue_q.commit_cnt);
 
   // Do we have a vector instruction with results being committed?
   pe_req_t vinsn_commit;
   logic    vinsn_commit_valid;
-  assign vinsn_commit       = vinsn_queue_q.vinsn[0];
-  assign vinsn_commit_valid = (vinsn_queue_q.commit_cnt != '0);
+  assign vinsn_commit       = vinsn_queue_q.vinsn[vinsn_queue_q.commit_pnt];
+  assign vinsn_commit_valid = !vinsn_idle;
 
   always_ff @(posedge clk_i or negedge rst_ni) begin
     if (!rst_ni) begin
-      vinsn_queue_q <= '0;
+      vinsn_queue_q  <= '0;
+      vinsn_switch_q <= 1'b0;
     end else begin
-      vinsn_queue_q <= vinsn_queue_d;
+      vinsn_queue_q  <= vinsn_queue_d;
+      vinsn_switch_q <= vinsn_switch_d;
     end
   end
 
@@ -248,10 +269,10 @@ module masku import ara_pkg::*; import rvv_pkg::*; #(
       result_queue_read_pnt_m  <= result_queue_write_pnt_q;
       result_queue_read_pnt_q  <= (vinsn_issue.op inside {[VMSBF:VID]}) ? result_queue_read_pnt_m : result_queue_read_pnt_d;
       result_queue_cnt_q       <= result_queue_cnt_d;
-      alu_result_f             <= (pe_req_ready_o) ? '0 : (!vinsn_issue.vm) ? alu_result_vm : alu_result_vm_seq;
+      alu_result_f             <= (vinsn_idle) ? '0 : (!vinsn_issue.vm) ? alu_result_vm : alu_result_vm_seq;
       alu_result_ff            <= alu_result_f;
       not_found_one_q          <= not_found_one_d;
-      alu_operand_b_seq_f      <= (pe_req_ready_o) ? '0 : alu_operand_b_seq_m;
+      alu_operand_b_seq_f      <= (vinsn_idle) ? '0 : alu_operand_b_seq_m;
       alu_operand_b_seq_ff     <= alu_operand_b_seq_f;
       iteration_count_q        <= iteration_count_d;
     end
@@ -264,7 +285,7 @@ module masku import ara_pkg::*; import rvv_pkg::*; #(
     end else begin
       iteration_count_d = iteration_count_q;
     end
-    if (pe_req_ready_o && !vinsn_issue_valid) begin
+    if (vinsn_idle) begin
       iteration_count_d = '0;
     end
   end
@@ -302,6 +323,22 @@ module masku import ara_pkg::*; import rvv_pkg::*; #(
   logic  [$clog2(DataWidth*NrLanes)-1:0] vfirst_count;
   logic  [$clog2(VLEN)-1:0]              vfirst_count_d, vfirst_count_q;
   logic                                  vfirst_empty;
+  // Was the first set bit found in a previous beat?
+  logic                                  vfirst_found_d, vfirst_found_q;
+
+  // viota: number of set mask bits before each element of the beat (up to NrLanes*DataWidth/8
+  // elements), computed with a parallel prefix in log2(NrLanes*DataWidth/8) steps
+  typedef logic [NrLanes*DataWidth/8-1:0][idx_width(NrLanes*DataWidth/8):0] iota_prefix_t;
+  iota_prefix_t iota_cnt;
+
+  function automatic iota_prefix_t iota_prefix(logic [NrLanes*DataWidth/8-1:0] bits);
+    iota_prefix = '0;
+    for (int i = 1; i < NrLanes*DataWidth/8; i++) iota_prefix[i] = bits[i-1];
+    // Kogge-Stone: after the step s, iota_prefix[i] counts the bits [i-2s, i-1]
+    for (int s = 1; s < NrLanes*DataWidth/8; s *= 2)
+      for (int i = NrLanes*DataWidth/8-1; i >= s; i--)
+        iota_prefix[i] += iota_prefix[i-s];
+  endfunction : iota_prefix
 
   // Pointers
   //
@@ -340,7 +377,7 @@ module masku import ara_pkg::*; import rvv_pkg::*; #(
     bit_enable          = '0;
     bit_enable_shuffle  = '0;
     bit_enable_mask     = '0;
-    not_found_one_d     = pe_req_ready_o ? 1'b1 : not_found_one_q;
+    not_found_one_d     = vinsn_idle ? 1'b1 : not_found_one_q;
     alu_result_vm       = '0;
     alu_result_vm_m     = '0;
     alu_result_vm_seq   = '0;
@@ -349,6 +386,7 @@ module masku import ara_pkg::*; import rvv_pkg::*; #(
     mask                = '0;
     masku_operand_vd    = '0;
     vcpop_operand       = '0;
+    iota_cnt            = '0;
 
     // Comparisons work on vtype.vsew from VALU or VMFPU
     bit_enable_shuffle_eew = vinsn_issue.op inside {[VMFEQ:VMSGTU], [VMSGT:VMSBC]}
@@ -418,7 +456,7 @@ module masku import ara_pkg::*; import rvv_pkg::*; #(
       // Evaluate the instruction
       unique case (vinsn_issue.op) inside
         [VMANDNOT:VMXNOR]: alu_result = (masku_operand_a_i & bit_enable_mask) |
-          (masku_operand_b_i & ~bit_enable_mask);
+          (masku_operand_old_vd & ~bit_enable_mask);
         [VMFEQ:VMSGTU], [VMSGT:VMSBC] : begin
           automatic logic [ELEN*NrLanes-1:0] alu_result_flat = '0;
 
@@ -437,7 +475,7 @@ module masku import ara_pkg::*; import rvv_pkg::*; #(
 
                 alu_result_flat[StrbWidth*dest_byte + dest_bit_seq[idx_width(StrbWidth)-1:0]] =
                 (!vinsn_issue.vm && !masku_operand_a_i[src_byte_lane][8*src_byte_offset+1]) ?
-                masku_operand_b_i[src_byte_lane][8*src_byte_offset] :
+                masku_operand_old_vd[src_byte_lane][8*src_byte_offset] :
                 masku_operand_a_i[src_byte_lane][8*src_byte_offset];
               end
             EW16: for (int b = 0; b < 4*NrLanes; b++) begin
@@ -454,7 +492,7 @@ module masku import ara_pkg::*; import rvv_pkg::*; #(
 
                 alu_result_flat[StrbWidth*dest_byte + dest_bit_seq[idx_width(StrbWidth)-1:0]] =
                 (!vinsn_issue.vm && !masku_operand_a_i[src_byte_lane][8*src_byte_offset+1]) ?
-                masku_operand_b_i[src_byte_lane][8*src_byte_offset] :
+                masku_operand_old_vd[src_byte_lane][8*src_byte_offset] :
                 masku_operand_a_i[src_byte_lane][8*src_byte_offset];
               end
             EW32: for (int b = 0; b < 2*NrLanes; b++) begin
@@ -471,7 +509,7 @@ module masku import ara_pkg::*; import rvv_pkg::*; #(
 
                 alu_result_flat[StrbWidth*dest_byte + dest_bit_seq[idx_width(StrbWidth)-1:0]] =
                 (!vinsn_issue.vm && !masku_operand_a_i[src_byte_lane][8*src_byte_offset+1]) ?
-                masku_operand_b_i[src_byte_lane][8*src_byte_offset] :
+                masku_operand_old_vd[src_byte_lane][8*src_byte_offset] :
                 masku_operand_a_i[src_byte_lane][8*src_byte_offset];
               end
             EW64: for (int b = 0; b < 1*NrLanes; b++) begin
@@ -488,7 +526,7 @@ module masku import ara_pkg::*; import rvv_pkg::*; #(
 
                 alu_result_flat[StrbWidth*dest_byte + dest_bit_seq[idx_width(StrbWidth)-1:0]] =
                   (!vinsn_issue.vm && !masku_operand_a_i[src_byte_lane][8*src_byte_offset+1]) ?
-                  masku_operand_b_i[src_byte_lane][8*src_byte_offset] :
+                  masku_operand_old_vd[src_byte_lane][8*src_byte_offset] :
                   masku_operand_a_i[src_byte_lane][8*src_byte_offset];
               end
             default:;
@@ -496,7 +534,7 @@ module masku import ara_pkg::*; import rvv_pkg::*; #(
 
           // Final assignment
           alu_result = (alu_result_flat & bit_enable_shuffle) |
-            (masku_operand_b_i & ~bit_enable_shuffle);
+            (masku_operand_old_vd & ~bit_enable_shuffle);
         end
         [VMSBF:VMSIF] : begin
             if (&masku_operand_a_valid_i) begin
@@ -517,6 +555,7 @@ module masku import ara_pkg::*; import rvv_pkg::*; #(
         VIOTA: begin
           if (&masku_operand_a_valid_i) begin
             alu_operand_b_seq_m = alu_operand_b_seq & bit_enable_mask;
+            iota_cnt            = iota_prefix(alu_operand_b_seq_m[NrLanes*DataWidth/8-1:0]);
             unique case (vinsn_issue.vtype.vsew)
               EW8 : begin
                 if (issue_cnt_q < vinsn_issue.vl) begin
@@ -525,7 +564,7 @@ module masku import ara_pkg::*; import rvv_pkg::*; #(
                   alu_result_vm [7:0] = '0;
                 end
                 for (int index = 1; index < (NrLanes*DataWidth)/8; index++) begin
-                  alu_result_vm   [(index*8) +: 7] = alu_operand_b_seq_m [index-1] + alu_result_vm [((index-1)*8) +: 7];
+                  alu_result_vm   [(index*8) +: 7] = alu_result_vm [0 +: 7] + iota_cnt[index];
                   alu_result_vm_m [(index*8) +: 7] = (|mask[(index*8) +: 7]) ? alu_result_vm [(index*8) +: 7] : masku_operand_vd [(index*8) +: 7];
                 end
               end
@@ -536,7 +575,7 @@ module masku import ara_pkg::*; import rvv_pkg::*; #(
                   alu_result_vm [15:0] = '0;
                 end
                 for (int index = 1; index < (NrLanes*DataWidth)/16; index++) begin
-                  alu_result_vm   [(index*16) +: 15] = alu_operand_b_seq_m [index-1] + alu_result_vm [((index-1)*16) +: 15];
+                  alu_result_vm   [(index*16) +: 15] = alu_result_vm [0 +: 15] + iota_cnt[index];
                   alu_result_vm_m [(index*16) +: 15] = (|mask[(index*16) +: 15]) ? alu_result_vm [(index*16) +: 15] : masku_operand_vd [(index*16) +: 15];
                 end
               end
@@ -547,7 +586,7 @@ module masku import ara_pkg::*; import rvv_pkg::*; #(
                   alu_result_vm [31:0] = '0;
                 end
                 for (int index = 1; index < (NrLanes*DataWidth)/32; index++) begin
-                  alu_result_vm   [(index*32) +: 31] = alu_operand_b_seq_m [index-1] + alu_result_vm [((index-1)*32) +: 31];
+                  alu_result_vm   [(index*32) +: 31] = alu_result_vm [0 +: 31] + iota_cnt[index];
                   alu_result_vm_m [(index*32) +: 31] = (|mask[(index*32) +: 31]) ? alu_result_vm [(index*32) +: 31] : masku_operand_vd [(index*32) +: 31];
                 end
               end
@@ -558,7 +597,7 @@ module masku import ara_pkg::*; import rvv_pkg::*; #(
                   alu_result_vm [63:0] = '0;
                 end
                 for (int index = 1; index < (NrLanes*DataWidth)/64; index++) begin
-                  alu_result_vm   [(index*64) +: 63] = alu_operand_b_seq_m [index-1] + alu_result_vm [((index-1)*64) +: 63];
+                  alu_result_vm   [(index*64) +: 63] = alu_result_vm [0 +: 63] + iota_cnt[index];
                   alu_result_vm_m [(index*64) +: 63] = (|mask[(index*64) +: 63]) ? alu_result_vm [(index*64) +: 63] : masku_operand_vd [(index*64) +: 63];
                 end
               end
@@ -634,6 +673,8 @@ module masku import ara_pkg::*; import rvv_pkg::*; #(
   // and trims all the unused 64 * NrLanes mask bits chunks
   // Therefore, the stride needs to be trimmed, too
   elen_t trimmed_stride;
+  // Instruction whose counters are initialized: a new one, or the next one of the queue
+  pe_req_t vinsn_init;
 
   logic [NrLanes-1:0] fake_a_valid;
   logic last_incoming_a;
@@ -642,6 +683,262 @@ module masku import ara_pkg::*; import rvv_pkg::*; #(
   // Information about which is the target FU of the request
   assign masku_operand_fu = (vinsn_issue.op inside {[VMFEQ:VMFGE]}) ? MaskFUMFpu : MaskFUAlu;
 
+  ////////////////////
+  //  Permutations  //
+  ////////////////////
+
+  // vrgather and vcompress move elements across the lanes, so they run here.
+  // vrgather: the source register, from operand b, is first buffered in sequential order.
+  //   Then, every beat of indices from the ALU (operand a) becomes a beat of results. The
+  //   dispatcher runs a vrgather once per register of the source group, with the index of the
+  //   first element of that register in the stride field.
+  // vcompress: the active elements of vs2 (operand b) under the mask vs1 (operand m) are
+  //   packed in a window, which is written to the lanes one full beat at a time.
+
+  // Beats, i.e., words of all the lanes, of a vector register
+  localparam int unsigned PermBufBeats = VLEN / (NrLanes * DataWidth);
+
+  // Source register of vrgather
+  logic [PermBufBeats-1:0][NrLanes*DataWidth-1:0] perm_buf_d, perm_buf_q;
+  // Beats of the source register that were buffered
+  logic [idx_width(PermBufBeats+1)-1:0]           perm_fill_cnt_d, perm_fill_cnt_q;
+  // Beat of operands being processed
+  vlen_t                                          perm_beat_d, perm_beat_q;
+  // vcompress: packed elements not written yet, how many they are, and the next beat of vd
+  logic [NrLanes*DataWidth-1:0]                   perm_win_d, perm_win_q;
+  vlen_t                                          perm_win_cnt_d, perm_win_cnt_q;
+  vlen_t                                          perm_out_beat_d, perm_out_beat_q;
+  // vcompress: all the operands were received
+  logic                                           perm_in_done_d, perm_in_done_q;
+
+  // Operands of all the lanes, as a VRF word
+  logic [NrLanes*DataWidth-1:0] perm_operand_a, perm_operand_b, perm_operand_m;
+  assign perm_operand_a = masku_operand_a_i;
+  assign perm_operand_b = masku_operand_b_i;
+  assign perm_operand_m = masku_operand_m_i;
+
+  // Element idx, of width sew, of a vector whose elements are in sequential order
+  function automatic elen_t perm_element(logic [VLEN-1:0] vec, vlen_t idx, vew_e sew);
+    perm_element = elen_t'(vec >> (idx << (int'(sew) + 3))) & ({ELEN{1'b1}} >> (ELEN - (8 << int'(sew))));
+  endfunction : perm_element
+
+  /////////////////////
+  //  Vector crypto  //
+  /////////////////////
+
+  // The crypto instructions (Zvkned, Zvknha, Zvkg) work on element groups of four 32-bit
+  // elements, whose elements are in different lanes, so they run here. A beat of operands has
+  // NrLanes/2 groups, all of them computed in the same cycle. vd comes from the ALU (operand a),
+  // vs2 from operand b, and vs1 from operand m. For the AES instructions, the element c of a
+  // group is the column c of the state, and its byte r is the row r.
+
+  // Element groups in a beat
+  localparam int unsigned CryptoGroups = NrLanes / 2;
+
+  // Key of the .vs forms, i.e., the first element group of vs2
+  logic [127:0] crypto_key_d, crypto_key_q;
+
+  // AES S-box, indexed by the input byte
+  localparam logic [0:255][7:0] AesSbox = {
+    8'h63, 8'h7c, 8'h77, 8'h7b, 8'hf2, 8'h6b, 8'h6f, 8'hc5, 8'h30, 8'h01, 8'h67, 8'h2b, 8'hfe, 8'hd7, 8'hab, 8'h76,
+    8'hca, 8'h82, 8'hc9, 8'h7d, 8'hfa, 8'h59, 8'h47, 8'hf0, 8'had, 8'hd4, 8'ha2, 8'haf, 8'h9c, 8'ha4, 8'h72, 8'hc0,
+    8'hb7, 8'hfd, 8'h93, 8'h26, 8'h36, 8'h3f, 8'hf7, 8'hcc, 8'h34, 8'ha5, 8'he5, 8'hf1, 8'h71, 8'hd8, 8'h31, 8'h15,
+    8'h04, 8'hc7, 8'h23, 8'hc3, 8'h18, 8'h96, 8'h05, 8'h9a, 8'h07, 8'h12, 8'h80, 8'he2, 8'heb, 8'h27, 8'hb2, 8'h75,
+    8'h09, 8'h83, 8'h2c, 8'h1a, 8'h1b, 8'h6e, 8'h5a, 8'ha0, 8'h52, 8'h3b, 8'hd6, 8'hb3, 8'h29, 8'he3, 8'h2f, 8'h84,
+    8'h53, 8'hd1, 8'h00, 8'hed, 8'h20, 8'hfc, 8'hb1, 8'h5b, 8'h6a, 8'hcb, 8'hbe, 8'h39, 8'h4a, 8'h4c, 8'h58, 8'hcf,
+    8'hd0, 8'hef, 8'haa, 8'hfb, 8'h43, 8'h4d, 8'h33, 8'h85, 8'h45, 8'hf9, 8'h02, 8'h7f, 8'h50, 8'h3c, 8'h9f, 8'ha8,
+    8'h51, 8'ha3, 8'h40, 8'h8f, 8'h92, 8'h9d, 8'h38, 8'hf5, 8'hbc, 8'hb6, 8'hda, 8'h21, 8'h10, 8'hff, 8'hf3, 8'hd2,
+    8'hcd, 8'h0c, 8'h13, 8'hec, 8'h5f, 8'h97, 8'h44, 8'h17, 8'hc4, 8'ha7, 8'h7e, 8'h3d, 8'h64, 8'h5d, 8'h19, 8'h73,
+    8'h60, 8'h81, 8'h4f, 8'hdc, 8'h22, 8'h2a, 8'h90, 8'h88, 8'h46, 8'hee, 8'hb8, 8'h14, 8'hde, 8'h5e, 8'h0b, 8'hdb,
+    8'he0, 8'h32, 8'h3a, 8'h0a, 8'h49, 8'h06, 8'h24, 8'h5c, 8'hc2, 8'hd3, 8'hac, 8'h62, 8'h91, 8'h95, 8'he4, 8'h79,
+    8'he7, 8'hc8, 8'h37, 8'h6d, 8'h8d, 8'hd5, 8'h4e, 8'ha9, 8'h6c, 8'h56, 8'hf4, 8'hea, 8'h65, 8'h7a, 8'hae, 8'h08,
+    8'hba, 8'h78, 8'h25, 8'h2e, 8'h1c, 8'ha6, 8'hb4, 8'hc6, 8'he8, 8'hdd, 8'h74, 8'h1f, 8'h4b, 8'hbd, 8'h8b, 8'h8a,
+    8'h70, 8'h3e, 8'hb5, 8'h66, 8'h48, 8'h03, 8'hf6, 8'h0e, 8'h61, 8'h35, 8'h57, 8'hb9, 8'h86, 8'hc1, 8'h1d, 8'h9e,
+    8'he1, 8'hf8, 8'h98, 8'h11, 8'h69, 8'hd9, 8'h8e, 8'h94, 8'h9b, 8'h1e, 8'h87, 8'he9, 8'hce, 8'h55, 8'h28, 8'hdf,
+    8'h8c, 8'ha1, 8'h89, 8'h0d, 8'hbf, 8'he6, 8'h42, 8'h68, 8'h41, 8'h99, 8'h2d, 8'h0f, 8'hb0, 8'h54, 8'hbb, 8'h16
+  };
+  // Inverse AES S-box, indexed by the input byte
+  localparam logic [0:255][7:0] AesInvSbox = {
+    8'h52, 8'h09, 8'h6a, 8'hd5, 8'h30, 8'h36, 8'ha5, 8'h38, 8'hbf, 8'h40, 8'ha3, 8'h9e, 8'h81, 8'hf3, 8'hd7, 8'hfb,
+    8'h7c, 8'he3, 8'h39, 8'h82, 8'h9b, 8'h2f, 8'hff, 8'h87, 8'h34, 8'h8e, 8'h43, 8'h44, 8'hc4, 8'hde, 8'he9, 8'hcb,
+    8'h54, 8'h7b, 8'h94, 8'h32, 8'ha6, 8'hc2, 8'h23, 8'h3d, 8'hee, 8'h4c, 8'h95, 8'h0b, 8'h42, 8'hfa, 8'hc3, 8'h4e,
+    8'h08, 8'h2e, 8'ha1, 8'h66, 8'h28, 8'hd9, 8'h24, 8'hb2, 8'h76, 8'h5b, 8'ha2, 8'h49, 8'h6d, 8'h8b, 8'hd1, 8'h25,
+    8'h72, 8'hf8, 8'hf6, 8'h64, 8'h86, 8'h68, 8'h98, 8'h16, 8'hd4, 8'ha4, 8'h5c, 8'hcc, 8'h5d, 8'h65, 8'hb6, 8'h92,
+    8'h6c, 8'h70, 8'h48, 8'h50, 8'hfd, 8'hed, 8'hb9, 8'hda, 8'h5e, 8'h15, 8'h46, 8'h57, 8'ha7, 8'h8d, 8'h9d, 8'h84,
+    8'h90, 8'hd8, 8'hab, 8'h00, 8'h8c, 8'hbc, 8'hd3, 8'h0a, 8'hf7, 8'he4, 8'h58, 8'h05, 8'hb8, 8'hb3, 8'h45, 8'h06,
+    8'hd0, 8'h2c, 8'h1e, 8'h8f, 8'hca, 8'h3f, 8'h0f, 8'h02, 8'hc1, 8'haf, 8'hbd, 8'h03, 8'h01, 8'h13, 8'h8a, 8'h6b,
+    8'h3a, 8'h91, 8'h11, 8'h41, 8'h4f, 8'h67, 8'hdc, 8'hea, 8'h97, 8'hf2, 8'hcf, 8'hce, 8'hf0, 8'hb4, 8'he6, 8'h73,
+    8'h96, 8'hac, 8'h74, 8'h22, 8'he7, 8'had, 8'h35, 8'h85, 8'he2, 8'hf9, 8'h37, 8'he8, 8'h1c, 8'h75, 8'hdf, 8'h6e,
+    8'h47, 8'hf1, 8'h1a, 8'h71, 8'h1d, 8'h29, 8'hc5, 8'h89, 8'h6f, 8'hb7, 8'h62, 8'h0e, 8'haa, 8'h18, 8'hbe, 8'h1b,
+    8'hfc, 8'h56, 8'h3e, 8'h4b, 8'hc6, 8'hd2, 8'h79, 8'h20, 8'h9a, 8'hdb, 8'hc0, 8'hfe, 8'h78, 8'hcd, 8'h5a, 8'hf4,
+    8'h1f, 8'hdd, 8'ha8, 8'h33, 8'h88, 8'h07, 8'hc7, 8'h31, 8'hb1, 8'h12, 8'h10, 8'h59, 8'h27, 8'h80, 8'hec, 8'h5f,
+    8'h60, 8'h51, 8'h7f, 8'ha9, 8'h19, 8'hb5, 8'h4a, 8'h0d, 8'h2d, 8'he5, 8'h7a, 8'h9f, 8'h93, 8'hc9, 8'h9c, 8'hef,
+    8'ha0, 8'he0, 8'h3b, 8'h4d, 8'hae, 8'h2a, 8'hf5, 8'hb0, 8'hc8, 8'heb, 8'hbb, 8'h3c, 8'h83, 8'h53, 8'h99, 8'h61,
+    8'h17, 8'h2b, 8'h04, 8'h7e, 8'hba, 8'h77, 8'hd6, 8'h26, 8'he1, 8'h69, 8'h14, 8'h63, 8'h55, 8'h21, 8'h0c, 8'h7d
+  };
+
+  // Multiplication by x in GF(2^8)
+  function automatic logic [7:0] aes_xtime(logic [7:0] b);
+    aes_xtime = {b[6:0], 1'b0} ^ (b[7] ? 8'h1b : 8'h00);
+  endfunction : aes_xtime
+
+  function automatic logic [7:0] aes_gmul(logic [7:0] a, logic [7:0] b);
+    aes_gmul = '0;
+    for (int i = 0; i < 8; i++) begin
+      if (b[i]) aes_gmul ^= a;
+      a = aes_xtime(a);
+    end
+  endfunction : aes_gmul
+
+  // (Inv)MixColumns of a column
+  function automatic logic [31:0] aes_mixcolumn(logic [31:0] col, logic inv);
+    // First row of the matrix, which the other rows rotate
+    automatic logic [3:0][7:0] m = inv ? {8'h09, 8'h0d, 8'h0b, 8'h0e} : {8'h01, 8'h01, 8'h03, 8'h02};
+    aes_mixcolumn = '0;
+    for (int r = 0; r < 4; r++)
+      for (int j = 0; j < 4; j++)
+        aes_mixcolumn[8*r +: 8] ^= aes_gmul(m[(j - r) & 3], col[8*j +: 8]);
+  endfunction : aes_mixcolumn
+
+  function automatic logic [31:0] aes_subword(logic [31:0] w);
+    for (int i = 0; i < 4; i++) aes_subword[8*i +: 8] = AesSbox[w[8*i +: 8]];
+  endfunction : aes_subword
+
+  // Round constant of the i-th expansion, from i = 0
+  function automatic logic [7:0] aes_rcon(logic [3:0] i);
+    aes_rcon = 8'h01;
+    for (int k = 0; k < 10; k++)
+      if (k < i) aes_rcon = aes_xtime(aes_rcon);
+  endfunction : aes_rcon
+
+  // Final (vaesef, vaesdf) and middle (vaesem, vaesdm) rounds, and the round zero (vaesz)
+  function automatic logic [127:0] aes_round(ara_op_e op, logic [127:0] state, logic [127:0] key);
+    automatic logic inv = op inside {VAESDF, VAESDM};
+
+    // (Inv)ShiftRows and (Inv)SubBytes: the row r of column c comes from column c + r (c - r)
+    for (int c = 0; c < 4; c++)
+      for (int r = 0; r < 4; r++) begin
+        automatic logic [7:0] b = state[32*((inv ? c - r : c + r) & 3) + 8*r +: 8];
+        aes_round[32*c + 8*r +: 8] = inv ? AesInvSbox[b] : AesSbox[b];
+      end
+    if (op == VAESEM)
+      for (int c = 0; c < 4; c++) aes_round[32*c +: 32] = aes_mixcolumn(aes_round[32*c +: 32], 1'b0);
+
+    aes_round ^= key;
+
+    // The decryption adds the key before InvMixColumns
+    if (op == VAESDM)
+      for (int c = 0; c < 4; c++) aes_round[32*c +: 32] = aes_mixcolumn(aes_round[32*c +: 32], 1'b1);
+    if (op == VAESZ) aes_round = state ^ key;
+  endfunction : aes_round
+
+  // AES-128 (vaeskf1) and AES-256 (vaeskf2) round keys. The round numbers out of range have
+  // their bit 3 flipped.
+  function automatic logic [127:0] aes_keyf(ara_op_e op, logic [127:0] prev, logic [127:0] key,
+      logic [3:0] rnd);
+    automatic logic [31:0] w = key[127:96];
+
+    if (op == VAESKF1) begin
+      if (rnd > 10 || rnd == 0) rnd[3] = ~rnd[3];
+      w    = aes_subword({w[7:0], w[31:8]}) ^ aes_rcon(rnd - 1);
+      // Expand from the current round key
+      prev = key;
+    end else begin
+      if (rnd < 2 || rnd > 14) rnd[3] = ~rnd[3];
+      // The odd rounds do not rotate
+      w = rnd[0] ? aes_subword(w) : aes_subword({w[7:0], w[31:8]}) ^ aes_rcon((rnd >> 1) - 1);
+    end
+
+    for (int i = 0; i < 4; i++) begin
+      w                  ^= prev[32*i +: 32];
+      aes_keyf[32*i +: 32] = w;
+    end
+  endfunction : aes_keyf
+
+  function automatic logic [31:0] sha256_sig0(logic [31:0] x);
+    sha256_sig0 = {x[6:0], x[31:7]} ^ {x[17:0], x[31:18]} ^ (x >> 3);
+  endfunction : sha256_sig0
+
+  function automatic logic [31:0] sha256_sig1(logic [31:0] x);
+    sha256_sig1 = {x[16:0], x[31:17]} ^ {x[18:0], x[31:19]} ^ (x >> 10);
+  endfunction : sha256_sig1
+
+  function automatic logic [31:0] sha256_sum0(logic [31:0] x);
+    sha256_sum0 = {x[1:0], x[31:2]} ^ {x[12:0], x[31:13]} ^ {x[21:0], x[31:22]};
+  endfunction : sha256_sum0
+
+  function automatic logic [31:0] sha256_sum1(logic [31:0] x);
+    sha256_sum1 = {x[5:0], x[31:6]} ^ {x[10:0], x[31:11]} ^ {x[24:0], x[31:25]};
+  endfunction : sha256_sum1
+
+  // Four words of the message schedule, W[16:19], from vd = W[3:0], vs2 = {W[11:9], W[4]}, and
+  // vs1 = W[15:12]
+  function automatic logic [127:0] sha256_ms(logic [127:0] vd, logic [127:0] vs2, logic [127:0] vs1);
+    automatic logic [19:0][31:0] w = '0;
+    w[3:0]   = vd;
+    w[4]     = vs2[31:0];
+    w[11:9]  = vs2[127:32];
+    w[15:12] = vs1;
+    for (int i = 16; i < 20; i++)
+      w[i] = sha256_sig1(w[i-2]) + w[i-7] + sha256_sig0(w[i-15]) + w[i-16];
+    sha256_ms = w[19:16];
+  endfunction : sha256_ms
+
+  // Two rounds of the compression, with the state {a, b, e, f} in vs2 and {c, d, g, h} in vd,
+  // and the two words of the message schedule plus the constants in wk
+  function automatic logic [127:0] sha256_rounds(logic [127:0] vd, logic [127:0] vs2,
+      logic [63:0] wk);
+    automatic logic [31:0] a = vs2[127:96], b = vs2[95:64], e = vs2[63:32], f = vs2[31:0];
+    automatic logic [31:0] c = vd[127:96], d = vd[95:64], g = vd[63:32], h = vd[31:0];
+
+    for (int i = 0; i < 2; i++) begin
+      automatic logic [31:0] t1 = h + sha256_sum1(e) + ((e & f) ^ (~e & g)) + wk[32*i +: 32];
+      automatic logic [31:0] t2 = sha256_sum0(a) + ((a & b) ^ (a & c) ^ (b & c));
+      h = g;
+      g = f;
+      f = e;
+      e = d + t1;
+      d = c;
+      c = b;
+      b = a;
+      a = t1 + t2;
+    end
+    sha256_rounds = {a, b, e, f};
+  endfunction : sha256_rounds
+
+  // Bits of each byte in reverse order
+  function automatic logic [127:0] brev8(logic [127:0] x);
+    for (int i = 0; i < 128; i++) brev8[i] = x[(i & ~7) + 7 - (i & 7)];
+  endfunction : brev8
+
+  // Multiplication in GF(2^128) of GHASH, whose bits are in reverse order in each byte
+  function automatic logic [127:0] ghash_mul(logic [127:0] y, logic [127:0] h);
+    automatic logic [127:0] s = brev8(y);
+    automatic logic [127:0] z = '0;
+
+    h = brev8(h);
+    for (int i = 0; i < 128; i++) begin
+      if (s[i]) z ^= h;
+      h = {h[126:0], 1'b0} ^ (h[127] ? 128'h87 : 128'h0);
+    end
+    ghash_mul = brev8(z);
+  endfunction : ghash_mul
+
+  // Result of a crypto instruction on an element group
+  function automatic logic [127:0] crypto_egroup(ara_op_e op, logic [127:0] vd, logic [127:0] vs2,
+      logic [127:0] vs1, logic [3:0] rnd);
+    unique case (op) inside
+      [VAESEF:VAESZ]  : crypto_egroup = aes_round(op, vd, vs2);
+      VAESKF1, VAESKF2: crypto_egroup = aes_keyf(op, vd, vs2, rnd);
+      VSHA2MS         : crypto_egroup = sha256_ms(vd, vs2, vs1);
+      VSHA2CH         : crypto_egroup = sha256_rounds(vd, vs2, vs1[127:64]);
+      VSHA2CL         : crypto_egroup = sha256_rounds(vd, vs2, vs1[63:0]);
+      VGHSH           : crypto_egroup = ghash_mul(vd ^ vs1, vs2);
+      VGMUL           : crypto_egroup = ghash_mul(vd, vs2);
+      default         : crypto_egroup = '0;
+    endcase
+  endfunction : crypto_egroup
+
   always_comb begin: p_masku
     // Maintain state
     vinsn_queue_d  = vinsn_queue_q;
@@ -654,6 +951,7 @@ module masku import ara_pkg::*; import rvv_pkg::*; #(
 
     popcount_d     = popcount_q;
     vfirst_count_d = vfirst_count_q;
+    vfirst_found_d = vfirst_found_q;
 
     mask_queue_d           = mask_queue_q;
     mask_queue_valid_d     = mask_queue_valid_q;
@@ -669,7 +967,17 @@ module masku import ara_pkg::*; import rvv_pkg::*; #(
 
     result_final_gnt_d = result_final_gnt_q;
 
-    trimmed_stride = pe_req_i.stride;
+    perm_buf_d      = perm_buf_q;
+    perm_fill_cnt_d = perm_fill_cnt_q;
+    perm_beat_d     = perm_beat_q;
+    perm_win_d      = perm_win_q;
+    perm_win_cnt_d  = perm_win_cnt_q;
+    perm_out_beat_d = perm_out_beat_q;
+    perm_in_done_d  = perm_in_done_q;
+
+    crypto_key_d = crypto_key_q;
+
+    vinsn_switch_d = 1'b0;
 
     // Vector instructions currently running
     vinsn_running_d = vinsn_running_q & pe_vinsn_running_i;
@@ -702,7 +1010,8 @@ module masku import ara_pkg::*; import rvv_pkg::*; #(
     /////////////////////
 
     // Is there an instruction ready to be issued?
-    if (vinsn_issue_valid && !(vd_scalar(vinsn_issue.op))) begin
+    // The permutations read their mask bits on their own
+    if (vinsn_issue_valid && !(vd_scalar(vinsn_issue.op)) && !(vinsn_issue.op inside {[VRGATHER:VGMUL]})) begin
       // Is there place in the mask queue to write the mask operands?
       // Did we receive the mask bits on the MaskM channel?
       if (!vinsn_issue.vm && !mask_queue_full && &masku_operand_m_valid_i) begin
@@ -792,11 +1101,14 @@ module masku import ara_pkg::*; import rvv_pkg::*; #(
         if (!vinsn_issue.vm) masku_operand_m_ready_o = '1;
 
         popcount_d     = popcount_q + popcount;
-        vfirst_count_d = vfirst_count_q + vfirst_count;
+        // Count the bits before the first set one, across the beats
+        if (!vfirst_found_q)
+          vfirst_count_d = vfirst_count_q + (vfirst_empty ? NrLanes*DataWidth : vfirst_count);
+        vfirst_found_d = vfirst_found_q || !vfirst_empty;
 
         // if this is the last beat, commit the result to the scalar_result queue
         if (iteration_count_d >= (((8 << vinsn_issue.vtype.vsew)*vinsn_issue.vl)/(DataWidth*NrLanes))) begin
-          result_scalar_d = (vinsn_issue.op == VCPOP) ? popcount_d : (vfirst_empty) ? -1 : vfirst_count_d;
+          result_scalar_d = (vinsn_issue.op == VCPOP) ? popcount_d : (!vfirst_found_d) ? -1 : vfirst_count_d;
           result_scalar_valid_d = '1;
 
           // Decrement the commit counter by the entire number of elements,
@@ -813,7 +1125,7 @@ module masku import ara_pkg::*; import rvv_pkg::*; #(
     // Is there an instruction ready to be issued?
     if (vinsn_issue_valid && !vd_scalar(vinsn_issue.op)) begin
       // This instruction executes on the Mask Unit
-      if (vinsn_issue.vfu == VFU_MaskUnit) begin
+      if (vinsn_issue.vfu == VFU_MaskUnit && !(vinsn_issue.op inside {[VRGATHER:VGMUL]})) begin
         // Is there place in the result queue to write the results?
         // Did we receive the operands?
         if (!result_queue_full && &(masku_operand_a_valid_i | fake_a_valid) &&
@@ -920,6 +1232,214 @@ module masku import ara_pkg::*; import rvv_pkg::*; #(
       end
     end
 
+    ////////////////////
+    //  Permutations  //
+    ////////////////////
+
+    // The crypto instructions share the beat counter and the writing of the results
+    if (vinsn_issue_valid && vinsn_issue.op inside {[VRGATHER:VGMUL]} && issue_cnt_q != '0) begin
+      // Elements in a beat
+      automatic int unsigned beat_elems = (NrLanes * StrbWidth) >> int'(vinsn_issue.vtype.vsew);
+      // Index of the first element of this beat
+      automatic vlen_t beat_first = perm_beat_q * beat_elems;
+      // Is this the last beat of operands?
+      automatic logic last_beat = (beat_first + beat_elems) >= vinsn_issue.vl;
+      // Did we use all the bits of the mask operand?
+      automatic logic mask_done = last_beat ||
+        ((beat_first + beat_elems) & (NrLanes * DataWidth - 1)) == '0;
+      // Byte enable of one element
+      automatic logic [NrLanes*StrbWidth-1:0] elem_be = {StrbWidth{1'b1}} >>
+        (StrbWidth - (1 << int'(vinsn_issue.vtype.vsew)));
+      // Operands and results in sequential order
+      automatic logic [NrLanes*DataWidth-1:0] mask_seq = '0;
+      automatic logic [NrLanes*DataWidth-1:0] opnd_seq = '0;
+      automatic logic [NrLanes*DataWidth-1:0] res_seq  = '0;
+      automatic logic [NrLanes*StrbWidth-1:0] be_seq   = '0;
+      // Results in the VRF order
+      automatic logic [NrLanes*DataWidth-1:0] res_vrf  = '0;
+      automatic logic [NrLanes*StrbWidth-1:0] be_vrf   = '0;
+      // Do we write a beat of results?
+      automatic logic   res_push = 1'b0;
+      automatic vaddr_t res_addr = '0;
+
+      // The mask bits, one per element
+      for (int b = 0; b < NrLanes*StrbWidth; b++)
+        mask_seq[8*b +: 8] = perm_operand_m[8*shuffle_index(b, NrLanes, vinsn_issue.eew_vmask) +: 8];
+
+      if (vinsn_issue.op inside {[VAESKF1:VGMUL]}) begin
+        // Lanes with elements of vd in this beat. vaeskf1 does not read vd.
+        automatic logic [NrLanes-1:0] lane_valid = '0;
+        // The .vs forms only receive the first beat of vs2
+        automatic logic key_beat = !vinsn_issue.is_broadcast || perm_beat_q == '0;
+        // The SHA-2 and GHASH instructions read vs1
+        automatic logic use_m = vinsn_issue.op inside {[VSHA2MS:VGHSH]};
+        for (int lane = 0; lane < NrLanes; lane++)
+          lane_valid[lane] = vinsn_issue.op != VAESKF1 && (beat_first + lane) < vinsn_issue.vl;
+
+        if (!result_queue_full && &(masku_operand_a_valid_i | ~lane_valid) &&
+            (!key_beat || &masku_operand_b_valid_i) && (!use_m || &masku_operand_m_valid_i)) begin
+          automatic logic [NrLanes*DataWidth-1:0] vd_seq  = '0;
+          automatic logic [NrLanes*DataWidth-1:0] vs2_seq = '0;
+          automatic logic [NrLanes*DataWidth-1:0] vs1_seq = '0;
+          automatic logic [127:0]                 key     = crypto_key_q;
+
+          for (int b = 0; b < NrLanes*StrbWidth; b++) begin
+            vd_seq[8*b +: 8]  = perm_operand_a[8*shuffle_index(b, NrLanes, EW32) +: 8];
+            vs2_seq[8*b +: 8] = perm_operand_b[8*shuffle_index(b, NrLanes, EW32) +: 8];
+            vs1_seq[8*b +: 8] = perm_operand_m[8*shuffle_index(b, NrLanes, EW32) +: 8];
+          end
+          if (vinsn_issue.is_broadcast && key_beat) begin
+            key          = vs2_seq[127:0];
+            crypto_key_d = key;
+          end
+
+          for (int g = 0; g < CryptoGroups; g++)
+            if (beat_first + 4*g < vinsn_issue.vl) begin
+              res_seq[128*g +: 128] = crypto_egroup(vinsn_issue.op, vd_seq[128*g +: 128],
+                vinsn_issue.is_broadcast ? key : vs2_seq[128*g +: 128], vs1_seq[128*g +: 128],
+                vinsn_issue.scalar_op[3:0]);
+              be_seq[16*g +: 16] = '1;
+            end
+
+          res_push = 1'b1;
+          res_addr = vaddr(vinsn_issue.vd, NrLanes) + perm_beat_q;
+
+          // Acknowledge the operands
+          masku_operand_a_ready_o = masku_operand_a_valid_i & lane_valid;
+          if (key_beat) masku_operand_b_ready_o = '1;
+          if (use_m) masku_operand_m_ready_o = '1;
+          perm_beat_d = perm_beat_q + 1;
+          if (last_beat) issue_cnt_d = '0;
+        end
+      end else if (vinsn_issue.op == VCOMPRESS) begin
+        if (!perm_in_done_q) begin
+          if (!result_queue_full && &masku_operand_b_valid_i && &masku_operand_m_valid_i) begin
+            // The window can hold up to two beats
+            automatic logic [2*NrLanes*DataWidth-1:0] win = perm_win_q;
+            automatic vlen_t win_cnt                         = perm_win_cnt_q;
+
+            for (int b = 0; b < NrLanes*StrbWidth; b++)
+              opnd_seq[8*b +: 8] = perm_operand_b[8*shuffle_index(b, NrLanes, vinsn_issue.vtype.vsew) +: 8];
+
+            // Pack the active elements
+            for (int e = 0; e < NrLanes*StrbWidth; e++)
+              if (e < beat_elems && beat_first + e < vinsn_issue.vl &&
+                  mask_seq[(beat_first + e) & (NrLanes * DataWidth - 1)]) begin
+                win |= (2*NrLanes*DataWidth)'(perm_element(VLEN'(opnd_seq), e, vinsn_issue.vtype.vsew)) <<
+                  (win_cnt << (int'(vinsn_issue.vtype.vsew) + 3));
+                win_cnt += 1;
+              end
+
+            // Write a beat as soon as it is full
+            if (win_cnt >= beat_elems) begin
+              res_push        = 1'b1;
+              res_seq         = win[NrLanes*DataWidth-1:0];
+              be_seq          = '1;
+              res_addr        = vaddr(vinsn_issue.vd, NrLanes) + perm_out_beat_q;
+              perm_out_beat_d = perm_out_beat_q + 1;
+              win             = win >> (NrLanes * DataWidth);
+              win_cnt         = win_cnt - beat_elems;
+            end
+            perm_win_d     = win[NrLanes*DataWidth-1:0];
+            perm_win_cnt_d = win_cnt;
+
+            // Acknowledge the operands
+            masku_operand_b_ready_o = '1;
+            if (mask_done) masku_operand_m_ready_o = '1;
+            perm_beat_d    = perm_beat_q + 1;
+            perm_in_done_d = last_beat;
+          end
+        end else if (perm_win_cnt_q != '0 || perm_out_beat_q == '0) begin
+          // Write the last beat, even if empty, to receive the final grants of the lanes
+          if (!result_queue_full) begin
+            res_push    = 1'b1;
+            res_seq     = perm_win_q;
+            be_seq      = ((NrLanes*StrbWidth)'(1) << (perm_win_cnt_q << int'(vinsn_issue.vtype.vsew))) - 1;
+            res_addr    = vaddr(vinsn_issue.vd, NrLanes) + perm_out_beat_q;
+            issue_cnt_d = '0;
+          end
+        end else
+          issue_cnt_d = '0;
+      end else if (perm_fill_cnt_q != PermBufBeats) begin
+        // Buffer the source register of vrgather
+        if (&masku_operand_b_valid_i) begin
+          for (int b = 0; b < NrLanes*StrbWidth; b++)
+            perm_buf_d[perm_fill_cnt_q][8*b +: 8] =
+              perm_operand_b[8*shuffle_index(b, NrLanes, vinsn_issue.vtype.vsew) +: 8];
+          masku_operand_b_ready_o = '1;
+          perm_fill_cnt_d         = perm_fill_cnt_q + 1;
+        end
+      end else begin
+        // Lanes with an index in this beat
+        automatic logic [NrLanes-1:0] lane_valid = '0;
+        for (int lane = 0; lane < NrLanes; lane++)
+          lane_valid[lane] = (beat_first + lane) < vinsn_issue.vl;
+
+        if (!result_queue_full && &(masku_operand_a_valid_i | ~lane_valid) &&
+            (vinsn_issue.vm || &masku_operand_m_valid_i)) begin
+          // Elements of the source register, and of the source register group
+          automatic vlen_t src_elems = VLENB >> int'(vinsn_issue.vtype.vsew);
+          automatic vlen_t vlmax     = vinsn_issue.vtype.vlmul[2] ?
+            src_elems >> (4 - vinsn_issue.vtype.vlmul[1:0]) : src_elems << vinsn_issue.vtype.vlmul[1:0];
+
+          for (int b = 0; b < NrLanes*StrbWidth; b++)
+            opnd_seq[8*b +: 8] = perm_operand_a[8*shuffle_index(b, NrLanes, vinsn_issue.vtype.vsew) +: 8];
+
+          for (int e = 0; e < NrLanes*StrbWidth; e++)
+            if (e < beat_elems) begin
+              automatic elen_t idx = vinsn_issue.use_vs1 ?
+                perm_element(VLEN'(opnd_seq), e, vinsn_issue.vtype.vsew) : vinsn_issue.scalar_op;
+              automatic logic active = beat_first + e < vinsn_issue.vl &&
+                (vinsn_issue.vm || mask_seq[(beat_first + e) & (NrLanes * DataWidth - 1)]);
+
+              // The index points into the register of this pass
+              if (active && idx < vlmax && idx >= vinsn_issue.stride && idx - vinsn_issue.stride < src_elems) begin
+                res_seq |= (NrLanes*DataWidth)'(perm_element(perm_buf_q, vlen_t'(idx - vinsn_issue.stride),
+                  vinsn_issue.vtype.vsew)) << (e << (int'(vinsn_issue.vtype.vsew) + 3));
+                be_seq  |= elem_be << (e << int'(vinsn_issue.vtype.vsew));
+              end
+              // Out-of-range indices read zero. Write it in the first pass only.
+              else if (active && idx >= vlmax && vinsn_issue.stride == '0)
+                be_seq |= elem_be << (e << int'(vinsn_issue.vtype.vsew));
+            end
+
+          res_push = 1'b1;
+          res_addr = vaddr(vinsn_issue.vd, NrLanes) + perm_beat_q;
+
+          // Acknowledge the operands
+          masku_operand_a_ready_o = masku_operand_a_valid_i & lane_valid;
+          if (!vinsn_issue.vm && mask_done) masku_operand_m_ready_o = '1;
+          perm_beat_d = perm_beat_q + 1;
+          if (last_beat) issue_cnt_d = '0;
+        end
+      end
+
+      // Write the results, in the VRF order
+      if (res_push) begin
+        for (int b = 0; b < NrLanes*StrbWidth; b++) begin
+          automatic int vrf_byte = shuffle_index(b, NrLanes, vinsn_issue.vtype.vsew);
+          res_vrf[8*vrf_byte +: 8] = res_seq[8*b +: 8];
+          be_vrf[vrf_byte]         = be_seq[b];
+        end
+
+        for (int unsigned lane = 0; lane < NrLanes; lane++)
+          result_queue_d[result_queue_write_pnt_q][lane] = '{
+            wdata: res_vrf[lane*DataWidth +: DataWidth],
+            be   : be_vrf[lane*StrbWidth +: StrbWidth],
+            addr : res_addr,
+            id   : vinsn_issue.id
+          };
+        result_queue_valid_d[result_queue_write_pnt_q] = {NrLanes{1'b1}};
+
+        // Increment result queue pointers and counters
+        result_queue_cnt_d += 1;
+        if (result_queue_write_pnt_q == ResultQueueDepth-1)
+          result_queue_write_pnt_d = '0;
+        else
+          result_queue_write_pnt_d = result_queue_write_pnt_q + 1;
+      end
+    end
+
     ///////////////////////////
     //// Masked Instruction ///
     ///////////////////////////
@@ -1030,11 +1550,21 @@ module masku import ara_pkg::*; import rvv_pkg::*; #(
         result_queue_d[result_queue_read_pnt_q] = '0;
 
         // Decrement the counter of remaining vector elements waiting to be written
-        commit_cnt_d = commit_cnt_q - NrLanes * DataWidth;
-        if (commit_cnt_q < (NrLanes * DataWidth))
-          commit_cnt_d = '0;
+        // The permutations and the crypto instructions do not write one beat per NrLanes * DataWidth
+        // elements
+        if (!(vinsn_commit.op inside {[VRGATHER:VGMUL]})) begin
+          commit_cnt_d = commit_cnt_q - NrLanes * DataWidth;
+          if (commit_cnt_q < (NrLanes * DataWidth))
+            commit_cnt_d = '0;
+        end
       end
 
+    // The permutations and the crypto instructions are committed once all their results were
+    // written
+    if (vinsn_commit_valid && vinsn_commit.op inside {[VRGATHER:VGMUL]} && issue_cnt_q == '0 &&
+        result_queue_cnt_d == '0)
+      commit_cnt_d = '0;
+
     ///////////////////////////
     // Commit scalar results //
     ///////////////////////////
@@ -1049,79 +1579,103 @@ module masku import ara_pkg::*; import rvv_pkg::*; #(
       // reset the popcount and vfirst_count
       popcount_d     = '0;
       vfirst_count_d = '0;
+      vfirst_found_d = 1'b0;
     end
 
     // Finished committing the results of a vector instruction
     // Some instructions forward operands to the lanes before writing the VRF
     // In this case, wait for the lanes to be written
     if (vinsn_commit_valid && commit_cnt_d == '0 &&
-      (!(vinsn_commit.op inside {[VMFEQ:VID], [VMSGT:VMSBC]}) || &result_final_gnt_d)) begin
+      (!(vinsn_commit.op inside {[VMFEQ:VID], [VMSGT:VMSBC], [VRGATHER:VGMUL]}) || &result_final_gnt_d)) begin
       // Mark the vector instruction as being done
       pe_resp.vinsn_done[vinsn_commit.id] = 1'b1;
 
       // Update the commit counters and pointers
       vinsn_queue_d.commit_cnt -= 1;
+      if (vinsn_queue_d.commit_pnt == VInsnQueueDepth-1)
+        vinsn_queue_d.commit_pnt = '0;
+      else
+        vinsn_queue_d.commit_pnt += 1;
+      // Start the next instruction, if any
+      vinsn_switch_d = 1'b1;
     end
 
     //////////////////////////////
     //  Accept new instruction  //
     //////////////////////////////
 
-    // Trim the slide stride if it is higher than NrLanes * 64
-    // and we have a VSLIDEUP, as the mask bits with index lower than
-    // this stride are not used and therefore not sent to the MASKU
-    if (pe_req_i.stride >= NrLanes * 64)
-      trimmed_stride = pe_req_i.stride - ((pe_req_i.stride >> NrLanes * 64) << NrLanes * 64);
-
     if (!vinsn_queue_full && pe_req_valid_i && !vinsn_running_q[pe_req_i.id] &&
-        (!pe_req_i.vm || pe_req_i.vfu == VFU_MaskUnit)) begin
-      vinsn_queue_d.vinsn[0]       = pe_req_i;
-      vinsn_running_d[pe_req_i.id] = 1'b1;
-
-      // Initialize counters
-      if (vinsn_queue_d.issue_cnt == '0) begin
-        issue_cnt_d = pe_req_i.vl;
-        read_cnt_d  = pe_req_i.vl;
-
-        // Trim skipped words
-        if (pe_req_i.op == VSLIDEUP) begin
-          issue_cnt_d -= vlen_t'(trimmed_stride);
-          case (pe_req_i.vtype.vsew)
-            EW8:  begin
-              read_cnt_d -= (vlen_t'(trimmed_stride) >> $clog2(NrLanes << 3)) << $clog2(NrLanes << 3);
-              mask_pnt_d  = (vlen_t'(trimmed_stride) >> $clog2(NrLanes << 3)) << $clog2(NrLanes << 3);
-            end
-            EW16: begin
-              read_cnt_d -= (vlen_t'(trimmed_stride) >> $clog2(NrLanes << 2)) << $clog2(NrLanes << 2);
-              mask_pnt_d  = (vlen_t'(trimmed_stride) >> $clog2(NrLanes << 2)) << $clog2(NrLanes << 2);
-            end
-            EW32: begin
-              read_cnt_d -= (vlen_t'(trimmed_stride) >> $clog2(NrLanes << 1)) << $clog2(NrLanes << 1);
-              mask_pnt_d  = (vlen_t'(trimmed_stride) >> $clog2(NrLanes << 1)) << $clog2(NrLanes << 1);
-            end
-            EW64: begin
-              read_cnt_d -= (vlen_t'(trimmed_stride) >> $clog2(NrLanes)) << $clog2(NrLanes);
-              mask_pnt_d  = (vlen_t'(trimmed_stride) >> $clog2(NrLanes)) << $clog2(NrLanes);
-            end
-            default:;
-          endcase
-        end
-
-        // Reset the final grant vector
-        // Be aware: this works only if the insn queue length is 1
-
-        result_final_gnt_d = '0;
-      end
-      if (vinsn_queue_d.commit_cnt == '0) begin
-        commit_cnt_d = pe_req_i.vl;
-        // Trim skipped words
-        if (pe_req_i.op == VSLIDEUP)
-          commit_cnt_d -= vlen_t'(trimmed_stride);
-      end
+        ((!pe_req_i.vm && !pe_req_i.mask_hit) || pe_req_i.vfu == VFU_MaskUnit)) begin
+      vinsn_queue_d.vinsn[vinsn_queue_q.accept_pnt] = pe_req_i;
+      vinsn_running_d[pe_req_i.id]                  = 1'b1;
 
       // Bump pointers and counters of the vector instruction queue
       vinsn_queue_d.issue_cnt += 1;
       vinsn_queue_d.commit_cnt += 1;
+      if (vinsn_queue_q.accept_pnt == VInsnQueueDepth-1)
+        vinsn_queue_d.accept_pnt = '0;
+      else
+        vinsn_queue_d.accept_pnt = vinsn_queue_q.accept_pnt + 1;
+    end
+
+    // The next instruction starts only if there is one
+    vinsn_switch_d &= vinsn_queue_d.commit_cnt != '0;
+
+    // Initialize the counters of a new instruction, if the queue was empty, or of the
+    // next instruction of the queue
+    vinsn_init = vinsn_switch_q ? vinsn_queue_q.vinsn[vinsn_queue_q.commit_pnt] : pe_req_i;
+
+    // Trim the slide stride if it is higher than NrLanes * 64
+    // and we have a VSLIDEUP, as the mask bits with index lower than
+    // this stride are not used and therefore not sent to the MASKU
+    trimmed_stride = vinsn_init.stride;
+    if (vinsn_init.stride >= NrLanes * 64)
+      trimmed_stride = vinsn_init.stride - ((vinsn_init.stride >> NrLanes * 64) << NrLanes * 64);
+
+    if (vinsn_switch_q || (vinsn_queue_q.commit_cnt == '0 && vinsn_queue_d.commit_cnt != '0)) begin
+      issue_cnt_d = vinsn_init.vl;
+      read_cnt_d  = vinsn_init.vl;
+
+      // Trim skipped words
+      if (vinsn_init.op == VSLIDEUP) begin
+        issue_cnt_d -= vlen_t'(trimmed_stride);
+        case (vinsn_init.vtype.vsew)
+          EW8:  begin
+            read_cnt_d -= (vlen_t'(trimmed_stride) >> $clog2(NrLanes << 3)) << $clog2(NrLanes << 3);
+            mask_pnt_d  = (vlen_t'(trimmed_stride) >> $clog2(NrLanes << 3)) << $clog2(NrLanes << 3);
+          end
+          EW16: begin
+            read_cnt_d -= (vlen_t'(trimmed_stride) >> $clog2(NrLanes << 2)) << $clog2(NrLanes << 2);
+            mask_pnt_d  = (vlen_t'(trimmed_stride) >> $clog2(NrLanes << 2)) << $clog2(NrLanes << 2);
+          end
+          EW32: begin
+            read_cnt_d -= (vlen_t'(trimmed_stride) >> $clog2(NrLanes << 1)) << $clog2(NrLanes << 1);
+            mask_pnt_d  = (vlen_t'(trimmed_stride) >> $clog2(NrLanes << 1)) << $clog2(NrLanes << 1);
+          end
+          EW64: begin
+            read_cnt_d -= (vlen_t'(trimmed_stride) >> $clog2(NrLanes)) << $clog2(NrLanes);
+            mask_pnt_d  = (vlen_t'(trimmed_stride) >> $clog2(NrLanes)) << $clog2(NrLanes);
+          end
+          default:;
+        endcase
+      end
+
+      // Reset the final grant vector
+      // This works because the instructions run one at a time
+      result_final_gnt_d = '0;
+
+      // Initialize the permutation datapath. vcompress does not buffer its source.
+      perm_fill_cnt_d = (vinsn_init.op == VCOMPRESS) ? PermBufBeats : '0;
+      perm_beat_d     = '0;
+      perm_win_d      = '0;
+      perm_win_cnt_d  = '0;
+      perm_out_beat_d = '0;
+      perm_in_done_d  = 1'b0;
+
+      commit_cnt_d = vinsn_init.vl;
+      // Trim skipped words
+      if (vinsn_init.op == VSLIDEUP)
+        commit_cnt_d -= vlen_t'(trimmed_stride);
     end
   end: p_masku
 
@@ -1137,6 +1691,15 @@ module masku import ara_pkg::*; import rvv_pkg::*; #(
       result_final_gnt_q <= '0;
       popcount_q         <= '0;
       vfirst_count_q     <= '0;
+      vfirst_found_q     <= 1'b0;
+      perm_buf_q         <= '0;
+      perm_fill_cnt_q    <= '0;
+      perm_beat_q        <= '0;
+      perm_win_q         <= '0;
+      perm_win_cnt_q     <= '0;
+      perm_out_beat_q    <= '0;
+      perm_in_done_q     <= 1'b0;
+      crypto_key_q       <= '0;
     end else begin
       vinsn_running_q    <= vinsn_running_d;
       read_cnt_q         <= read_cnt_d;
@@ -1148,6 +1711,15 @@ module masku import ara_pkg::*; import rvv_pkg::*; #(
       result_final_gnt_q <= result_final_gnt_d;
       popcount_q         <= popcount_d;
       vfirst_count_q     <= vfirst_count_d;
+      vfirst_found_q     <= vfirst_found_d;
+      perm_buf_q         <= perm_buf_d;
+      perm_fill_cnt_q    <= perm_fill_cnt_d;
+      perm_beat_q        <= perm_beat_d;
+      perm_win_q         <= perm_win_d;
+      perm_win_cnt_q     <= perm_win_cnt_d;
+      perm_out_beat_q    <= perm_out_beat_d;
+      perm_in_done_q     <= perm_in_done_d;
+      crypto_key_q       <= crypto_key_d;
     end
   end
 
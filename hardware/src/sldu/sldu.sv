@@ -307,6 +307,56 @@ module sldu import ara_pkg::*; import rvv_pkg::*; #(
   assign is_issue_vmfpu_reduction = vinsn_issue_valid_q & (vinsn_issue_q.vfu == VFU_MFpu);
   assign is_issue_reduction       = is_issue_alu_reduction | is_issue_vmfpu_reduction;
 
+  // Number of times that the partial results of a reduction are moved between the lanes.
+  // The integer ones are reduced by the SLDU in one shot if SlduRedTree.
+  function automatic int unsigned red_steps(vfu_e vfu);
+    red_steps = (SlduRedTree && vfu == VFU_Alu) ? 1 : $clog2(NrLanes) + 1;
+  endfunction : red_steps
+
+  // One SIMD step of an integer reduction
+  function automatic elen_t red_alu(elen_t a, elen_t b, ara_op_e op, vew_e vew);
+    automatic logic sgn = op inside {VREDMIN, VREDMAX};
+
+    red_alu = '0;
+    for (int unsigned e = 0; e < (8 >> vew); e++) begin
+      automatic int unsigned off   = (8 << vew) * e;
+      automatic elen_t       wmask = (vew == EW64) ? '1 : (elen_t'(1) << (8 << vew)) - 1;
+      automatic elen_t       ea    = (a >> off) & wmask;
+      automatic elen_t       eb    = (b >> off) & wmask;
+      automatic elen_t       res;
+
+      // Sign-extend the elements for the signed comparisons
+      if (sgn && vew != EW64) begin
+        if (ea[(8 << vew) - 1]) ea |= ~wmask;
+        if (eb[(8 << vew) - 1]) eb |= ~wmask;
+      end
+
+      unique case (op)
+        VREDAND : res = ea & eb;
+        VREDOR  : res = ea | eb;
+        VREDXOR : res = ea ^ eb;
+        VREDMINU: res = (ea < eb) ? ea : eb;
+        VREDMIN : res = ($signed(ea) < $signed(eb)) ? ea : eb;
+        VREDMAXU: res = (ea < eb) ? eb : ea;
+        VREDMAX : res = ($signed(ea) < $signed(eb)) ? eb : ea;
+        // VREDSUM, VWREDSUMU, VWREDSUM
+        default : res = ea + eb;
+      endcase
+
+      red_alu |= (res & wmask) << off;
+    end
+  endfunction : red_alu
+
+  // Reduction tree of the partial results of the lanes
+  elen_t [NrLanes-1:0] red_tree;
+
+  always_comb begin: p_red_tree
+    red_tree = sldu_operand;
+    for (int unsigned s = 1; s < NrLanes; s *= 2)
+      for (int unsigned l = 0; l < NrLanes; l += 2*s)
+        red_tree[l] = red_alu(red_tree[l], red_tree[l+s], vinsn_issue_q.op, vinsn_issue_q.vtype.vsew);
+  end: p_red_tree
+
   always_comb begin
     sldu_mux_sel_o = NO_RED;
     if ((is_issue_alu_reduction && !(vinsn_commit_valid && vinsn_commit.vfu != VFU_Alu)) || (vinsn_commit_valid && vinsn_commit.vfu == VFU_Alu)) begin
@@ -499,9 +549,9 @@ module sldu import ara_pkg::*; import rvv_pkg::*; #(
               in_pnt_d  = '0;
               out_pnt_d = '0;
 
-              // The total number of transactions is vl - 1, but the last data is sent
-              // to lane 0
-              issue_cnt_d  = vinsn_issue_q.vl;
+              // The partial sums go from lane to lane without the SLDU, which only
+              // sends the last one to lane 0
+              issue_cnt_d  = vinsn_issue_q.vl != '0;
 
               state_d = SLIDE_RUN_OSUM;
             end
@@ -511,8 +561,9 @@ module sldu import ara_pkg::*; import rvv_pkg::*; #(
               in_pnt_d  = '0;
               out_pnt_d = '0;
 
-              // Initialize issue cnt. Pretend to move NrLanes 64-bit elements for (clog2(NrLanes) + 1) times.
-              issue_cnt_d  = (NrLanes * ($clog2(NrLanes) + 1)) << EW64;
+              // Initialize issue cnt. Pretend to move NrLanes 64-bit elements for (clog2(NrLanes) + 1) times,
+              // or once if the SLDU reduces them itself.
+              issue_cnt_d  = (NrLanes * red_steps(vinsn_issue_q.vfu)) << EW64;
             end
           endcase
         end
@@ -552,6 +603,10 @@ module sldu import ara_pkg::*; import rvv_pkg::*; #(
                 result_queue_d[result_queue_write_pnt_q][lane].be[b]           = 1'b1;
               end
 
+          // The reduction tree sends the result of an integer reduction to lane 0
+          if (SlduRedTree && vinsn_issue_q.vfu == VFU_Alu)
+            result_queue_d[result_queue_write_pnt_q][0].wdata = red_tree[0];
+
           // Initialize id and addr fields of the result queue requests
           for (int lane = 0; lane < NrLanes; lane++) begin
             result_queue_d[result_queue_write_pnt_q][lane].id   = vinsn_issue_q.id;
@@ -691,7 +746,8 @@ module sldu import ara_pkg::*; import rvv_pkg::*; #(
             slide_np2_buf_valid_d = 1'b0;
       end
       SLIDE_RUN_OSUM: begin
-        // Short Note: For ordered sum reduction instruction, only one lane has a valid data, and it is sent to the next lane
+        // Short Note: For ordered sum reduction instruction, only the lane with the last element has a valid data,
+        // and it is sent to lane 0
         // Don't wait for mask bits
         if (!result_queue_full) begin
           for (int lane = 0; lane < NrLanes; lane++) begin
@@ -841,7 +897,7 @@ module sldu import ara_pkg::*; import rvv_pkg::*; #(
       if (vinsn_queue_d.commit_cnt != '0) begin
         commit_cnt_d = vinsn_queue_q.vinsn[vinsn_queue_d.commit_pnt].op inside {VSLIDEUP, VSLIDEDOWN}
                      ? vinsn_queue_q.vinsn[vinsn_queue_d.commit_pnt].vl << int'(vinsn_queue_q.vinsn[vinsn_queue_d.commit_pnt].vtype.vsew)
-                     : (NrLanes * ($clog2(NrLanes) + 1)) << EW64;
+                     : (NrLanes * red_steps(vinsn_queue_q.vinsn[vinsn_queue_d.commit_pnt].vfu)) << EW64;
 
         // Trim vector elements which are not written by the slide unit
         if (vinsn_queue_q.vinsn[vinsn_queue_d.commit_pnt].op == VSLIDEUP)
@@ -862,14 +918,15 @@ module sldu import ara_pkg::*; import rvv_pkg::*; #(
       if (pe_req_i.op inside {VSLIDEUP, VSLIDEDOWN})
         vinsn_queue_d.vinsn[vinsn_queue_q.accept_pnt].stride = pe_req_i.stride <<
           int'(pe_req_i.vtype.vsew);
-      // Always move 64-bit packs of data from one lane to the other
-      if (pe_req_i.vfu inside {VFU_Alu, VFU_MFpu})
+      // Always move 64-bit packs of data from one lane to the other.
+      // The reduction tree needs the SEW of the integer reductions.
+      if (pe_req_i.vfu == VFU_MFpu || (pe_req_i.vfu == VFU_Alu && !SlduRedTree))
         vinsn_queue_d.vinsn[vinsn_queue_q.accept_pnt].vtype.vsew = EW64;
 
       if (vinsn_queue_d.commit_cnt == '0) begin
         commit_cnt_d = pe_req_i.op inside {VSLIDEUP, VSLIDEDOWN}
                      ? pe_req_i.vl << int'(pe_req_i.vtype.vsew)
-                     : (NrLanes * ($clog2(NrLanes) + 1)) << EW64;
+                     : (NrLanes * red_steps(pe_req_i.vfu)) << EW64;
         // Trim vector elements which are not written by the slide unit
         // VSLIDE1UP always writes at least 1 element
         if (pe_req_i.op == VSLIDEUP && !pe_req_i.use_scalar_op) begin
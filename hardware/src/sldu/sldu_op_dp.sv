@@ -6,6 +6,8 @@
 // Description:
 // Ara's optimized SLDU datapath.
 // Cannot reshuffle AND slide at the same time.
+// The datapaths of 1 to 16 lanes are tabulated. The larger configurations use
+// the parametric datapath at the bottom, which implements the same function.
 
 module sldu_op_dp import ara_pkg::*; import rvv_pkg::*; import cf_math_pkg::idx_width; #(
     parameter int unsigned NrLanes = 0,
@@ -16810,7 +16812,20 @@ else if (NrLanes == 16)
       default: op_o_flat = op_i_flat;
     endcase
   end
+else if (NrLanes <= MaxNrLanes && NrLanes == 2**$clog2(NrLanes))
+  always_comb begin
+    // Rotate the bytes, in their natural packing, by slamt_i elements, and/or reshuffle them
+    // from eew_src_i to eew_dst_i
+    automatic int unsigned NrBytes = 8*NrLanes;
+    automatic int unsigned shamt   = (int'(slamt_i) << int'(eew_src_i)) % NrBytes;
+
+    for (int unsigned b = 0; b < NrBytes; b++) begin
+      automatic int unsigned src = dir_i ? (b + NrBytes - shamt) % NrBytes : (b + shamt) % NrBytes;
+      op_o_flat[8*shuffle_index(b, NrLanes, eew_dst_i) +: 8] =
+        op_i_flat[8*shuffle_index(src, NrLanes, eew_src_i) +: 8];
+    end
+  end
 else
-  $error("Error. Allowed NrLanes values are 1, 2, 4, 8, or 16");
+  $error("Error. NrLanes must be a power of two, up to MaxNrLanes");
 
 endmodule
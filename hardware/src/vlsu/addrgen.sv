@@ -40,11 +40,22 @@ module addrgen import ara_pkg::*; import rvv_pkg::*; #(
     output logic                           axi_addrgen_req_valid_o,
     input  logic                           ldu_axi_addrgen_req_ready_i,
     input  logic                           stu_axi_addrgen_req_ready_i,
+    // The write-combining buffer of the VSTU has a beat whose AW did not go out yet
+    input  logic                           stu_combine_pending_i,
     // Interface with the lanes (for scatter/gather operations)
     input  elen_t            [NrLanes-1:0] addrgen_operand_i,
     input  target_fu_e       [NrLanes-1:0] addrgen_operand_target_fu_i,
     input  logic             [NrLanes-1:0] addrgen_operand_valid_i,
-    output logic                           addrgen_operand_ready_o
+    output logic                           addrgen_operand_ready_o,
+    // Interface with CVA6's MMU
+    input  logic                           en_ld_st_translation_i,
+    input  logic                           flush_tlb_i,
+    output logic                           mmu_req_o,
+    output axi_addr_t                      mmu_vaddr_o,
+    output logic                           mmu_is_store_o,
+    input  logic                           mmu_valid_i,
+    input  axi_addr_t                      mmu_paddr_i,
+    input  logic                           mmu_exception_i
   );
 
   import cf_math_pkg::idx_width;
@@ -57,6 +68,23 @@ module addrgen import ara_pkg::*; import rvv_pkg::*; #(
     is_addr_error = |(addr & (elen_t'(1 << vew) - 1));
   endfunction // is_addr_error
 
+  // AXI atomic operation executed on each element of a vector AMO
+  function automatic axi_pkg::atop_t amo_atop(ara_op_e op);
+    automatic logic [2:0] atop_op;
+    unique case (op)
+      VAMOAND : atop_op = axi_pkg::ATOP_CLR; // The store unit inverts the operand
+      VAMOOR  : atop_op = axi_pkg::ATOP_SET;
+      VAMOXOR : atop_op = axi_pkg::ATOP_EOR;
+      VAMOMIN : atop_op = axi_pkg::ATOP_SMIN;
+      VAMOMAX : atop_op = axi_pkg::ATOP_SMAX;
+      VAMOMINU: atop_op = axi_pkg::ATOP_UMIN;
+      VAMOMAXU: atop_op = axi_pkg::ATOP_UMAX;
+      default : atop_op = axi_pkg::ATOP_ADD;
+    endcase
+    amo_atop = op inside {[VAMOADD:VAMOMAXU]} ?
+      {axi_pkg::ATOP_ATOMICSTORE, axi_pkg::ATOP_LITTLE_END, atop_op} : '0;
+  endfunction // amo_atop
+
   ////////////////////
   //  PE Req Queue  //
   ////////////////////
@@ -65,7 +93,8 @@ module addrgen import ara_pkg::*; import rvv_pkg::*; #(
   // generates the AXI requests. They interact through the following signals.
   typedef struct packed {
     axi_addr_t addr;
-    vlen_t len;
+    // In bytes for the coalesced strided loads, which span up to an AXI beat per element
+    logic [$bits(vlen_t)+$clog2(AxiDataWidth/8)-1:0] len;
     elen_t stride;
     vew_e vew;
     logic is_load;
@@ -78,6 +107,35 @@ module addrgen import ara_pkg::*; import rvv_pkg::*; #(
   // Pipeline the PE requests
   pe_req_t pe_req_d, pe_req_q;
 
+  // Unit-strided and strided operations cannot raise exceptions once their base address was
+  // checked. They are acknowledged right away and queued here, so that the dispatcher goes on
+  // and the next memory operation gets its address generated while the former is requesting.
+  addrgen_req_t runahead_req;
+  logic         runahead_req_push;
+  addrgen_req_t runahead_req_head;
+  logic         runahead_req_pop;
+  logic         runahead_req_full;
+  logic         runahead_req_empty;
+  // The AXI request generation is busy
+  logic         axi_addrgen_busy;
+
+  fifo_v3 #(
+    .DEPTH(VaddrgenReqQueueDepth),
+    .dtype(addrgen_req_t        )
+  ) i_addrgen_runahead_queue (
+    .clk_i     (clk_i             ),
+    .rst_ni    (rst_ni            ),
+    .flush_i   (1'b0              ),
+    .testmode_i(1'b0              ),
+    .data_i    (runahead_req      ),
+    .push_i    (runahead_req_push ),
+    .full_o    (runahead_req_full ),
+    .data_o    (runahead_req_head ),
+    .pop_i     (runahead_req_pop  ),
+    .empty_o   (runahead_req_empty),
+    .usage_o   (/* Unused */      )
+  );
+
   /////////////////////
   //  Address Queue  //
   /////////////////////
@@ -106,24 +164,80 @@ module addrgen import ara_pkg::*; import rvv_pkg::*; #(
   );
   assign axi_addrgen_req_valid_o = !axi_addrgen_queue_empty;
 
+  ///////////
+  //  TLB  //
+  ///////////
+
+  // With virtual memory, the AXI requests are translated one page at a time. Every page can
+  // fault, so the memory operations are not acknowledged before all their requests were sent.
+  logic      translation_on;
+  logic      tlb_req;
+  axi_addr_t tlb_vaddr;
+  logic      tlb_valid;
+  axi_addr_t tlb_paddr;
+  logic      tlb_exception;
+
+  assign translation_on = VlsuTlbEntries > 0 && en_ld_st_translation_i;
+
+  if (VlsuTlbEntries > 0) begin: gen_tlb
+    vlsu_tlb #(
+      .NrEntries   (VlsuTlbEntries),
+      .AxiAddrWidth(AxiAddrWidth  )
+    ) i_tlb (
+      .clk_i           (clk_i                 ),
+      .rst_ni          (rst_ni                ),
+      .en_translation_i(en_ld_st_translation_i),
+      .flush_i         (flush_tlb_i           ),
+      .req_i           (tlb_req               ),
+      .vaddr_i         (tlb_vaddr             ),
+      .is_store_i      (!axi_addrgen_q.is_load),
+      .valid_o         (tlb_valid             ),
+      .paddr_o         (tlb_paddr             ),
+      .exception_o     (tlb_exception         ),
+      .mmu_req_o       (mmu_req_o             ),
+      .mmu_vaddr_o     (mmu_vaddr_o           ),
+      .mmu_is_store_o  (mmu_is_store_o        ),
+      .mmu_valid_i     (mmu_valid_i           ),
+      .mmu_paddr_i     (mmu_paddr_i           ),
+      .mmu_exception_i (mmu_exception_i       )
+    );
+  end: gen_tlb else begin: gen_no_tlb
+    // The addresses are physical ones
+    assign tlb_valid      = tlb_req;
+    assign tlb_paddr      = tlb_vaddr;
+    assign tlb_exception  = 1'b0;
+    assign mmu_req_o      = 1'b0;
+    assign mmu_vaddr_o    = '0;
+    assign mmu_is_store_o = 1'b0;
+  end: gen_no_tlb
+
   //////////////////////////
   //  Indexed Memory Ops  //
   //////////////////////////
 
+  // Element addresses made per cycle for the indexed operations and the strided loads
+  localparam int unsigned NrIdxAddrs = MemAddrsPerCycle < NrLanes ? MemAddrsPerCycle : NrLanes;
+
+  // Addresses of the next cnt elements of an indexed operation
+  typedef struct packed {
+    axi_addr_t [NrIdxAddrs-1:0]         addr;
+    logic [idx_width(NrIdxAddrs+1)-1:0] cnt;
+  } idx_addrs_t;
+
   // Support for indexed memory operations (scatter/gather)
-  logic [$bits(elen_t)*NrLanes-1:0] shuffled_word;
-  logic [$bits(elen_t)*NrLanes-1:0] deshuffled_word;
-  elen_t                            reduced_word;
-  axi_addr_t                        idx_final_addr_d, idx_final_addr_q;
-  elen_t                            idx_addr;
-  logic                             idx_op_error_d, idx_op_error_q;
-  vlen_t                            addrgen_error_vl_d;
-
-  // Pointer to point to the correct
-  logic [$clog2(NrLanes)-1:0] word_lane_ptr_d, word_lane_ptr_q;
-  logic [$clog2($bits(elen_t)/8)-1:0] elm_ptr_d, elm_ptr_q;
-  logic [$clog2($bits(elen_t)/8)-1:0] last_elm_subw_d, last_elm_subw_q;
-  vlen_t                              idx_op_cnt_d, idx_op_cnt_q;
+  logic [$bits(elen_t)*NrLanes-1:0]     shuffled_word;
+  // With a zero element past the end of the word, for the reads of its last indices
+  logic [$bits(elen_t)*(NrLanes+1)-1:0] deshuffled_word;
+  idx_addrs_t                           idx_addrs_d, idx_addrs_q;
+  // Next element of idx_addrs_q to request, and its address
+  logic [idx_width(NrIdxAddrs)-1:0]     idx_head_d, idx_head_q;
+  axi_addr_t                            idx_final_addr_q;
+  logic                                 idx_op_error_d, idx_op_error_q;
+  vlen_t                                addrgen_error_vl_d;
+
+  // Next index of the word of the lanes
+  logic [idx_width(8*NrLanes+1)-1:0] idx_elm_ptr_d, idx_elm_ptr_q;
+  vlen_t                             idx_op_cnt_d, idx_op_cnt_q;
 
   // Spill reg signals
   logic      idx_addr_valid_d, idx_addr_valid_q;
@@ -131,18 +245,20 @@ module addrgen import ara_pkg::*; import rvv_pkg::*; #(
 
   // Break the path from the VRF to the AXI request
   spill_register #(
-    .T(elen_t)
+    .T(idx_addrs_t)
   ) i_addrgen_idx_op_spill_reg (
     .clk_i  (clk_i           ),
     .rst_ni (rst_ni          ),
     .valid_i(idx_addr_valid_d),
     .ready_o(idx_addr_ready_q),
-    .data_i (idx_final_addr_d),
+    .data_i (idx_addrs_d     ),
     .valid_o(idx_addr_valid_q),
     .ready_i(idx_addr_ready_d),
-    .data_o (idx_final_addr_q)
+    .data_o (idx_addrs_q     )
   );
 
+  assign idx_final_addr_q = idx_addrs_q.addr[idx_head_q];
+
   //////////////////////////
   //  Address generation  //
   //////////////////////////
@@ -174,6 +290,8 @@ module addrgen import ara_pkg::*; import rvv_pkg::*; #(
     // No request, by default
     addrgen_req       = '0;
     addrgen_req_valid = 1'b0;
+    runahead_req      = '0;
+    runahead_req_push = 1'b0;
 
     // Nothing to acknowledge
     addrgen_ack_o           = 1'b0;
@@ -182,32 +300,28 @@ module addrgen import ara_pkg::*; import rvv_pkg::*; #(
     // No valid words for the spill register
     idx_addr_valid_d        = 1'b0;
     addrgen_operand_ready_o = 1'b0;
-    reduced_word            = '0;
-    elm_ptr_d               = elm_ptr_q;
+    idx_elm_ptr_d           = idx_elm_ptr_q;
     idx_op_cnt_d            = idx_op_cnt_q;
-    word_lane_ptr_d         = word_lane_ptr_q;
-    idx_final_addr_d        = idx_final_addr_q;
-    last_elm_subw_d         = last_elm_subw_q;
+    idx_addrs_d             = idx_addrs_q;
 
     // Support for indexed operations
-    shuffled_word = addrgen_operand_i;
+    shuffled_word   = addrgen_operand_i;
+    deshuffled_word = '0;
     // Deshuffle the whole NrLanes * 8 Byte word
     for (int unsigned b = 0; b < 8*NrLanes; b++) begin
       automatic shortint unsigned b_shuffled = shuffle_index(b, NrLanes, pe_req_q.eew_vs2);
       deshuffled_word[8*b +: 8] = shuffled_word[8*b_shuffled +: 8];
     end
 
-    // Extract only 1/NrLanes of the word
-    for (int unsigned lane = 0; lane < NrLanes; lane++)
-      if (lane == word_lane_ptr_q)
-        reduced_word = deshuffled_word[word_lane_ptr_q*$bits(elen_t) +: $bits(elen_t)];
-    idx_addr = reduced_word;
-
     case (state_q)
       IDLE: begin
         // Received a new request
+        // The indexed operations wait for the queued ones, since their AXI requests are
+        // generated while the indices arrive. So do all of them with virtual memory.
         if (pe_req_valid_i &&
-            (is_load(pe_req_i.op) || is_store(pe_req_i.op)) && !vinsn_running_q[pe_req_i.id]) begin
+            (is_load(pe_req_i.op) || is_store(pe_req_i.op)) && !vinsn_running_q[pe_req_i.id] &&
+            !((pe_req_i.op inside {VLXE, [VSXE:VAMOMAXU]} || translation_on) &&
+              (!runahead_req_empty || axi_addrgen_busy))) begin
           // Mark the instruction as running in this unit
           vinsn_running_d[pe_req_i.id] = 1'b1;
 
@@ -215,19 +329,9 @@ module addrgen import ara_pkg::*; import rvv_pkg::*; #(
           pe_req_d = pe_req_i;
 
           case (pe_req_i.op)
-            VLXE, VSXE: begin
+            VLXE, [VSXE:VAMOMAXU]: begin
               state_d = ADDRGEN_IDX_OP;
 
-              // Load element pointers
-              case (pe_req_i.eew_vs2)
-                EW8:  last_elm_subw_d = 7;
-                EW16: last_elm_subw_d = 3;
-                EW32: last_elm_subw_d = 1;
-                EW64: last_elm_subw_d = 0;
-                default:
-                  last_elm_subw_d = 0;
-              endcase
-
               // Load element counter
               idx_op_cnt_d = pe_req_i.vl;
             end
@@ -242,7 +346,7 @@ module addrgen import ara_pkg::*; import rvv_pkg::*; #(
           addrgen_ack_o   = 1'b1;
           addrgen_error_o = 1'b1;
         end else begin
-          addrgen_req = '{
+          runahead_req = '{
             addr    : pe_req_q.scalar_op,
             len     : pe_req_q.vl,
             stride  : pe_req_q.stride,
@@ -251,10 +355,27 @@ module addrgen import ara_pkg::*; import rvv_pkg::*; #(
             // Unit-strided loads/stores trigger incremental AXI bursts.
             is_burst: (pe_req_q.op inside {VLE, VSE})
           };
-          addrgen_req_valid = 1'b1;
-
-          if (addrgen_req_ready) begin
-            addrgen_req_valid = '0;
+          // Strided loads with a small stride are read with bursts over their footprint, byte
+          // by byte. The VLDU extracts the elements from the beats.
+          if (pe_req_q.op == VLSE &&
+              is_coalesced_stride(pe_req_q.stride, pe_req_q.vtype.vsew, AxiDataWidth/8)) begin
+            runahead_req.len      = ((pe_req_q.vl - 1) << coalesced_stride_log(pe_req_q.stride,
+              AxiDataWidth/8)) + (1 << int'(pe_req_q.vtype.vsew));
+            runahead_req.vew      = EW8;
+            runahead_req.is_burst = 1'b1;
+          end
+          // A broadcast load reads its only element once
+          if (pe_req_q.op == VLSE && pe_req_q.is_broadcast)
+            runahead_req.len = 1;
+
+          if (translation_on) begin
+            // Stall the interface until the operation is over to catch the page faults
+            addrgen_req       = runahead_req;
+            addrgen_req_valid = 1'b1;
+            if (idx_op_error_d || addrgen_req_ready)
+              state_d = ADDRGEN_IDX_OP_END;
+          end else if (!runahead_req_full) begin
+            runahead_req_push = 1'b1;
             addrgen_ack_o     = 1'b1;
             state_d           = IDLE;
           end
@@ -279,57 +400,40 @@ module addrgen import ara_pkg::*; import rvv_pkg::*; #(
         // We accept all the incoming data, without any checks
         // since Ara stalls on an indexed memory operation
         if (&addrgen_operand_valid_i & addrgen_operand_target_fu_i[0] == MFPU_ADDRGEN) begin
+          // Indices in the word
+          automatic int unsigned idx_word_elms = (8*NrLanes) >> int'(pe_req_q.eew_vs2);
 
           // Valid data for the spill register
           idx_addr_valid_d = 1'b1;
 
-          // Select the correct element, and zero extend it depending on vsew
-          case (pe_req_q.eew_vs2)
-            EW8: begin
-              for (int unsigned b = 0; b < 8; b++)
-                if (b == elm_ptr_q)
-                  idx_addr = reduced_word[b*8 +: 8];
-            end
-            EW16: begin
-              for (int unsigned h = 0; h < 4; h++)
-                if (h == elm_ptr_q)
-                  idx_addr = reduced_word[h*16 +: 16];
-            end
-            EW32: begin
-              for (int unsigned w = 0; w < 2; w++)
-                if (w == elm_ptr_q)
-                  idx_addr = reduced_word[w*32 +: 32];
-            end
-            EW64: begin
-              for (int unsigned d = 0; d < 1; d++)
-                if (d == elm_ptr_q)
-                  idx_addr = reduced_word[d*64 +: 64];
-            end
-            default: begin
-              for (int unsigned b = 0; b < 8; b++)
-                if (b == elm_ptr_q)
-                  idx_addr = reduced_word[b*8 +: 8];
+          // Compose the addresses of the next elements of the word, from their indices zero
+          // extended depending on eew_vs2
+          idx_addrs_d = '0;
+          for (int unsigned e = 0; e < NrIdxAddrs; e++) begin
+            if (idx_elm_ptr_q + e < idx_word_elms && e < idx_op_cnt_q) begin
+              automatic elen_t idx = deshuffled_word[(idx_elm_ptr_q + e) <<
+                (int'(pe_req_q.eew_vs2) + 3) +: $bits(elen_t)];
+              case (pe_req_q.eew_vs2)
+                EW8:  idx = elen_t'(idx[7:0]);
+                EW16: idx = elen_t'(idx[15:0]);
+                EW32: idx = elen_t'(idx[31:0]);
+                default:;
+              endcase
+              idx_addrs_d.addr[e] = pe_req_q.scalar_op + idx;
+              idx_addrs_d.cnt     = e + 1;
             end
-          endcase
-
-          // Compose the address
-          idx_final_addr_d = pe_req_q.scalar_op + idx_addr;
+          end
 
           // When the data is accepted
           if (idx_addr_ready_q) begin
-            // Consumed one element
-            idx_op_cnt_d = idx_op_cnt_q - 1;
+            // Consumed the elements
+            idx_op_cnt_d  = idx_op_cnt_q - idx_addrs_d.cnt;
+            idx_elm_ptr_d = idx_elm_ptr_q + idx_addrs_d.cnt;
             // Have we finished a full NrLanes*64b word?
-            if (elm_ptr_q == last_elm_subw_q) begin
-              // Bump lane pointer
-              elm_ptr_d       = '0;
-              word_lane_ptr_d += 1;
-              if (word_lane_ptr_q == NrLanes - 1)
+            if (idx_elm_ptr_d == idx_word_elms) begin
+              idx_elm_ptr_d = '0;
               // Ready for the next full word
               addrgen_operand_ready_o = 1'b1;
-            end else begin
-              // Bump element pointer
-              elm_ptr_d += 1;
             end
           end
 
@@ -351,8 +455,7 @@ module addrgen import ara_pkg::*; import rvv_pkg::*; #(
         addrgen_req_valid = '0;
         state_d           = IDLE;
         // Reset pointers
-        elm_ptr_d       = '0;
-        word_lane_ptr_d = '0;
+        idx_elm_ptr_d = '0;
         // Raise an error if necessary
         if (idx_op_error_q) begin
           addrgen_error_o = 1'b1;
@@ -366,66 +469,39 @@ module addrgen import ara_pkg::*; import rvv_pkg::*; #(
       state_q            <= IDLE;
       pe_req_q           <= '0;
       vinsn_running_q    <= '0;
-      word_lane_ptr_q    <= '0;
-      elm_ptr_q          <= '0;
+      idx_elm_ptr_q      <= '0;
       idx_op_cnt_q       <= '0;
-      last_elm_subw_q    <= '0;
       idx_op_error_q     <= '0;
       addrgen_error_vl_o <= '0;
     end else begin
       state_q            <= state_d;
       pe_req_q           <= pe_req_d;
       vinsn_running_q    <= vinsn_running_d;
-      word_lane_ptr_q    <= word_lane_ptr_d;
-      elm_ptr_q          <= elm_ptr_d;
+      idx_elm_ptr_q      <= idx_elm_ptr_d;
       idx_op_cnt_q       <= idx_op_cnt_d;
-      last_elm_subw_q    <= last_elm_subw_d;
       idx_op_error_q     <= idx_op_error_d;
       addrgen_error_vl_o <= addrgen_error_vl_d;
     end
   end
 
-  /////////////////////////////////////
-  //  Support for misaligned stores  //
-  /////////////////////////////////////
-
   // AXI Request Generation signals, declared here for convenience
   addrgen_req_t axi_addrgen_d, axi_addrgen_q;
 
-  // Narrower AXI Data Byte-Width used for misaligned stores
-  logic [$clog2(AxiDataWidth/8)-1:0]            narrow_axi_data_bwidth;
-  // Helper signal to calculate the narrow_axi_data_bwidth
-  // It carries information about the misalignment of the start address w.r.t. the AxiDataWidth
-  logic [$clog2(AxiDataWidth/8)-1:0]            axi_addr_misalignment;
-  // Number of trailing 0s of axi_addr_misalignment
-  logic [idx_width($clog2(AxiDataWidth/8))-1:0] zeroes_cnt;
-
-  // Get the misalignment information for this vector memory instruction
-  assign axi_addr_misalignment = axi_addrgen_d.addr[$clog2(AxiDataWidth/8)-1:0];
-
-  // Calculate the maximum number of Bytes we can send in a store-misaligned beat.
-  // This number must be a power of 2 not to get misaligned wrt the pack of data that the
-  // store unit receives from the lanes
-  lzc #(
-    .WIDTH($clog2(AxiDataWidth/8)),
-    .MODE (1'b0                  )
-  ) i_lzc (
-    .in_i   (axi_addr_misalignment),
-    .cnt_o  (zeroes_cnt           ),
-    .empty_o(/* Unconnected */    )
-  );
-
-  // Effective AXI data width for misaligned stores
-  assign narrow_axi_data_bwidth = (AxiDataWidth/8) >> ($clog2(AxiDataWidth/8) - zeroes_cnt);
-
   //////////////////////////////
   //  AXI Request Generation  //
   //////////////////////////////
 
   enum logic [1:0] {
-    AXI_ADDRGEN_IDLE, AXI_ADDRGEN_MISALIGNED, AXI_ADDRGEN_WAITING, AXI_ADDRGEN_REQUESTING
+    AXI_ADDRGEN_IDLE, AXI_ADDRGEN_WAITING, AXI_ADDRGEN_REQUESTING
   } axi_addrgen_state_d, axi_addrgen_state_q;
 
+  assign axi_addrgen_busy = axi_addrgen_state_q != AXI_ADDRGEN_IDLE;
+
+  // Translate the address of the next AXI request. The bursts do not cross a page.
+  assign tlb_req   = axi_addrgen_state_q == AXI_ADDRGEN_REQUESTING &&
+                     (state_q != ADDRGEN_IDX_OP || idx_addr_valid_q);
+  assign tlb_vaddr = state_q == ADDRGEN_IDX_OP ? idx_final_addr_q : axi_addrgen_q.addr;
+
   axi_addr_t aligned_start_addr_d, aligned_start_addr_q;
   axi_addr_t aligned_next_start_addr_d, aligned_next_start_addr_q;
   axi_addr_t aligned_end_addr_d, aligned_end_addr_q;
@@ -436,6 +512,13 @@ module addrgen import ara_pkg::*; import rvv_pkg::*; #(
   logic [$clog2(AxiDataWidth/8):0]            eff_axi_dw_d, eff_axi_dw_q;
   logic [idx_width($clog2(AxiDataWidth/8)):0] eff_axi_dw_log_d, eff_axi_dw_log_q;
 
+  // AXI-width blocks read by the last ARs of the indexed load, the newest first.
+  // The elements that fall in one of them reuse its R beat in the VLDU.
+  localparam int unsigned IdxBlockDepth = IdxCoalesceWindow > 0 ? IdxCoalesceWindow : 1;
+  typedef logic [AxiAddrWidth-$clog2(AxiDataWidth/8)-1:0] axi_block_t;
+  axi_block_t [IdxBlockDepth-1:0] idx_block_d, idx_block_q;
+  logic       [IdxBlockDepth-1:0] idx_block_valid_d, idx_block_valid_q;
+
   always_comb begin: axi_addrgen
     // Maintain state
     axi_addrgen_state_d = axi_addrgen_state_q;
@@ -450,6 +533,10 @@ module addrgen import ara_pkg::*; import rvv_pkg::*; #(
     eff_axi_dw_d     = eff_axi_dw_q;
     eff_axi_dw_log_d = eff_axi_dw_log_q;
 
+    idx_block_d       = idx_block_q;
+    idx_block_valid_d = idx_block_valid_q;
+    idx_head_d        = idx_head_q;
+
     idx_addr_ready_d    = 1'b0;
     addrgen_error_vl_d  = '0;
 
@@ -458,6 +545,7 @@ module addrgen import ara_pkg::*; import rvv_pkg::*; #(
 
     // No addrgen request to acknowledge
     addrgen_req_ready = 1'b0;
+    runahead_req_pop  = 1'b0;
 
     // No addrgen command to the load/store units
     axi_addrgen_queue      = '0;
@@ -471,23 +559,18 @@ module addrgen import ara_pkg::*; import rvv_pkg::*; #(
 
     case (axi_addrgen_state_q)
       AXI_ADDRGEN_IDLE: begin
-        if (addrgen_req_valid) begin
-          axi_addrgen_d       = addrgen_req;
+        // The queued operations are older than the indexed one, which waits for them
+        if (!runahead_req_empty || addrgen_req_valid) begin
+          axi_addrgen_d       = runahead_req_empty ? addrgen_req : runahead_req_head;
+          runahead_req_pop    = !runahead_req_empty;
           axi_addrgen_state_d = core_st_pending_i ? AXI_ADDRGEN_WAITING : AXI_ADDRGEN_REQUESTING;
+          idx_block_valid_d   = '0;
+          idx_head_d          = '0;
 
-          // In case of a misaligned store, reduce the effective width of the AXI transaction,
-          // since the store unit does not support misalignments between the AXI bus and the lanes
-          if ((axi_addrgen_d.addr[$clog2(AxiDataWidth/8)-1:0] != '0) && !axi_addrgen_d.is_load)
-          begin
-            // Calculate the start and the end addresses in the AXI_ADDRGEN_MISALIGNED state
-            axi_addrgen_state_d = AXI_ADDRGEN_MISALIGNED;
-
-            eff_axi_dw_d     = {1'b0, narrow_axi_data_bwidth};
-            eff_axi_dw_log_d = zeroes_cnt;
-          end else begin
-            eff_axi_dw_d     = AxiDataWidth/8;
-            eff_axi_dw_log_d = $clog2(AxiDataWidth/8);
-          end
+          // The misaligned accesses use the whole AXI width as well: the load and the store
+          // units realign the beats with the VRF words
+          eff_axi_dw_d     = AxiDataWidth/8;
+          eff_axi_dw_log_d = $clog2(AxiDataWidth/8);
 
           // The start address is found by aligning the original request address by the width of
           // the memory interface.
@@ -514,48 +597,85 @@ module addrgen import ara_pkg::*; import rvv_pkg::*; #(
           end
         end
       end
-      AXI_ADDRGEN_MISALIGNED: begin
-        axi_addrgen_state_d = core_st_pending_i ? AXI_ADDRGEN_WAITING : AXI_ADDRGEN_REQUESTING;
-
-        // The start address is found by aligning the original request address by the width of
-        // the memory interface.
-        aligned_start_addr_d = aligned_addr(axi_addrgen_q.addr, eff_axi_dw_log_q);
-        // The final address can be found similarly...
-        if (axi_addrgen_q.len << int'(axi_addrgen_q.vew) >= (256 << eff_axi_dw_log_q)) begin
-          aligned_next_start_addr_d =
-            aligned_addr(axi_addrgen_q.addr + (256 << eff_axi_dw_log_q), eff_axi_dw_log_q);
-          aligned_end_addr_d = aligned_next_start_addr_d - 1;
-        end else begin
-          aligned_next_start_addr_d =
-            aligned_addr(axi_addrgen_q.addr + (axi_addrgen_q.len << int'(axi_addrgen_q.vew)) - 1,
-            eff_axi_dw_log_q) + eff_axi_dw_q;
-          aligned_end_addr_d = aligned_next_start_addr_d - 1;
-        end
-        // But since AXI requests are aligned in 4 KiB pages, aligned_end_addr must be in the
-        // same page as aligned_start_addr
-        if (aligned_start_addr_d[AxiAddrWidth-1:12] != aligned_end_addr_d[AxiAddrWidth-1:12]) begin
-          aligned_end_addr_d = {aligned_start_addr_d[AxiAddrWidth-1:12], 12'hFFF};
-          aligned_next_start_addr_d = {                next_2page_msb_q, 12'h000};
-        end
-      end
       AXI_ADDRGEN_WAITING: begin
         if (!core_st_pending_i)
           axi_addrgen_state_d = AXI_ADDRGEN_REQUESTING;
       end
       AXI_ADDRGEN_REQUESTING : begin
-        automatic logic axi_ax_ready = (axi_addrgen_q.is_load && axi_ar_ready_i) || (!
-          axi_addrgen_q.is_load && axi_aw_ready_i);
+        // The elements of the strided and indexed stores go through the write-combining buffer
+        // of the VSTU, which sends their AWs. The atomic operations are not combined.
+        automatic logic combine_st = StoreCombine && !axi_addrgen_q.is_load &&
+          !axi_addrgen_q.is_burst && (state_q != ADDRGEN_IDX_OP || amo_atop(pe_req_q.op) == '0);
+        // The request also waits for the translation of its page
+        automatic logic axi_ax_ready = tlb_valid && ((axi_addrgen_q.is_load && axi_ar_ready_i) ||
+          (!axi_addrgen_q.is_load && (axi_aw_ready_i || combine_st)));
+        // Is the element of the indexed load in one of the last blocks it read? The ordered
+        // loads only look at the last one.
+        automatic logic [idx_width(IdxCoalesceWindow+1)-1:0] idx_reuse = '0;
+        // Addresses of the next elements of the strided or indexed operation. The leading ones
+        // of a load that fall in the AXI-width block of the first one, aligned and up to a beat
+        // of them, share its AXI request, and the VLDU takes them from its beat at elem_offs.
+        automatic axi_addr_t [NrIdxAddrs:0] elem_addr;
+        automatic vlen_t elem_avail = axi_addrgen_q.len;
+        automatic logic elem_run = axi_addrgen_q.is_load && !axi_addrgen_q.is_burst;
+        automatic logic [idx_width(MemAddrsPerCycle+1)-1:0] nr_elems = 1;
+        automatic logic [MemAddrsPerCycle-1:0][$clog2(4*MaxNrLanes)-1:0] elem_offs = '0;
+
+        for (int unsigned e = 0; e <= NrIdxAddrs; e++)
+          elem_addr[e] = axi_addrgen_q.addr + e * axi_addrgen_q.stride;
+        if (state_q == ADDRGEN_IDX_OP) begin
+          for (int unsigned e = 0; e < NrIdxAddrs; e++)
+            if (idx_head_q + e < NrIdxAddrs) elem_addr[e] = idx_addrs_q.addr[idx_head_q + e];
+          if (idx_addrs_q.cnt - idx_head_q < elem_avail)
+            elem_avail = idx_addrs_q.cnt - idx_head_q;
+        end
+        // Check the elements in parallel: their block also is in the page of the first one
+        elem_offs[0] = elem_addr[0][$clog2(AxiDataWidth/8)-1:0];
+        for (int unsigned e = 1; e < NrIdxAddrs; e++) begin
+          elem_run &= e < elem_avail && ((e + 1) << int'(axi_addrgen_q.vew)) <= AxiDataWidth/8 &&
+            elem_addr[e][AxiAddrWidth-1:$clog2(AxiDataWidth/8)] ==
+            elem_addr[0][AxiAddrWidth-1:$clog2(AxiDataWidth/8)] &&
+            !is_addr_error(elem_addr[0], axi_addrgen_q.vew) &&
+            !is_addr_error(elem_addr[e], axi_addrgen_q.vew);
+          if (elem_run) begin
+            nr_elems     = e + 1;
+            elem_offs[e] = elem_addr[e][$clog2(AxiDataWidth/8)-1:0];
+          end
+        end
+
+        for (int i = IdxBlockDepth-1; i >= 0; i--)
+          if (IdxCoalesceWindow > 0 && state_q == ADDRGEN_IDX_OP && axi_addrgen_q.is_load &&
+              idx_addr_valid_q && (i == 0 || !pe_req_q.is_ordered) && idx_block_valid_q[i] &&
+              idx_block_q[i] == idx_final_addr_q[AxiAddrWidth-1:$clog2(AxiDataWidth/8)] &&
+              !is_addr_error(idx_final_addr_q, axi_addrgen_q.vew))
+            idx_reuse = i + 1;
 
         // Pre-calculate the next_2page_msb. This should not require much energy if the addr
         // has zeroes in the upper positions.
         next_2page_msb_d = aligned_next_start_addr_q[AxiAddrWidth-1:12] + 1;
 
+        if (tlb_exception) begin
+          // Page fault: stop, and report the elements before the page. The coalesced strided
+          // loads count bytes, and restart from the first element.
+          idx_op_error_d      = 1'b1;
+          addrgen_error_vl_d  = addrgen_req.len - axi_addrgen_q.len;
+          if (axi_addrgen_q.is_burst && pe_req_q.op == VLSE)
+            addrgen_error_vl_d = '0;
+          idx_addr_ready_d    = state_q == ADDRGEN_IDX_OP;
+          idx_head_d          = '0;
+          addrgen_req_ready   = 1'b1;
+          axi_addrgen_state_d = AXI_ADDRGEN_IDLE;
+        end
         // Before starting a transaction on a different channel, wait the formers to complete
         // Otherwise, the ordering of the responses is not guaranteed, and with the current
         // implementation we can incur in deadlocks
-        if (axi_addrgen_queue_empty || (axi_addrgen_req_o.is_load && axi_addrgen_q.is_load) ||
-            (~axi_addrgen_req_o.is_load && ~axi_addrgen_q.is_load)) begin
-          if (!axi_addrgen_queue_full && axi_ax_ready) begin
+        // The AWs of the other stores also wait for the combined ones, which the VSTU sends
+        // with their W beats, so that the AWs are in the order of the W beats
+        else if ((axi_addrgen_queue_empty && (axi_addrgen_q.is_load || combine_st ||
+            !stu_combine_pending_i)) || (axi_addrgen_req_o.is_load && axi_addrgen_q.is_load) ||
+            (~axi_addrgen_req_o.is_load && ~axi_addrgen_q.is_load &&
+             axi_addrgen_req_o.combine == combine_st)) begin
+          if (!axi_addrgen_queue_full && (axi_ax_ready || idx_reuse != '0)) begin
             if (axi_addrgen_q.is_burst) begin
 
               /////////////////////////
@@ -607,7 +727,9 @@ module addrgen import ara_pkg::*; import rvv_pkg::*; #(
                 addr   : axi_addrgen_q.addr,
                 len    : burst_length - 1,
                 size   : eff_axi_dw_log_q,
-                is_load: axi_addrgen_q.is_load
+                is_load: axi_addrgen_q.is_load,
+                reuse  : '0,
+                combine: 1'b0
               };
               axi_addrgen_queue_push = 1'b1;
 
@@ -656,11 +778,13 @@ module addrgen import ara_pkg::*; import rvv_pkg::*; #(
               /////////////////////
 
               // AR Channel
+              // The elements that share the request read the whole block
               if (axi_addrgen_q.is_load) begin
                 axi_ar_o = '{
-                  addr   : axi_addrgen_q.addr,
+                  addr   : nr_elems > 1 ? aligned_addr(axi_addrgen_q.addr, $clog2(AxiDataWidth/8)) :
+                                          axi_addrgen_q.addr,
                   len    : 0,
-                  size   : axi_addrgen_q.vew,
+                  size   : nr_elems > 1 ? $clog2(AxiDataWidth/8) : axi_addrgen_q.vew,
                   cache  : CACHE_MODIFIABLE,
                   burst  : BURST_INCR,
                   default: '0
@@ -668,7 +792,7 @@ module addrgen import ara_pkg::*; import rvv_pkg::*; #(
                 axi_ar_valid_o = 1'b1;
               end
               // AW Channel
-              else begin
+              else if (!combine_st) begin
                 axi_aw_o = '{
                   addr   : axi_addrgen_q.addr,
                   len    : 0,
@@ -682,17 +806,21 @@ module addrgen import ara_pkg::*; import rvv_pkg::*; #(
 
               // Send this request to the load/store units
               axi_addrgen_queue = '{
-                addr   : axi_addrgen_q.addr,
-                size   : axi_addrgen_q.vew,
-                len    : 0,
-                is_load: axi_addrgen_q.is_load
+                addr     : axi_addrgen_q.addr,
+                size     : axi_addrgen_q.vew,
+                len      : 0,
+                is_load  : axi_addrgen_q.is_load,
+                reuse    : '0,
+                combine  : combine_st,
+                nr_elems : nr_elems > 1 ? nr_elems : '0,
+                elem_offs: elem_offs
               };
               axi_addrgen_queue_push = 1'b1;
 
               // Account for the requested operands
-              axi_addrgen_d.len  = axi_addrgen_q.len - 1;
+              axi_addrgen_d.len  = axi_addrgen_q.len - nr_elems;
               // Calculate the addresses for the next iteration, adding the correct stride
-              axi_addrgen_d.addr = axi_addrgen_q.addr + axi_addrgen_q.stride;
+              axi_addrgen_d.addr = elem_addr[nr_elems];
 
               // Finished generating AXI requests
               if (axi_addrgen_d.len == 0) begin
@@ -706,11 +834,35 @@ module addrgen import ara_pkg::*; import rvv_pkg::*; #(
               //////////////////////
 
               if (idx_addr_valid_q) begin
-                // We consumed a word
-                idx_addr_ready_d = 1'b1;
+                // We consumed the addresses of the spill register, or the next ones of them
+                idx_head_d = idx_head_q + nr_elems;
+                if (idx_head_q + nr_elems == idx_addrs_q.cnt) begin
+                  idx_addr_ready_d = 1'b1;
+                  idx_head_d       = '0;
+                end
 
                 // AR Channel
-                if (axi_addrgen_q.is_load) begin
+                // With the coalescing, the loads read the whole block, for the next elements
+                if (axi_addrgen_q.is_load && (IdxCoalesceWindow > 0 || nr_elems > 1)) begin
+                  if (idx_reuse == '0) begin
+                    axi_ar_o = '{
+                      addr   : aligned_addr(idx_final_addr_q, $clog2(AxiDataWidth/8)),
+                      len    : 0,
+                      size   : $clog2(AxiDataWidth/8),
+                      cache  : CACHE_MODIFIABLE,
+                      burst  : BURST_INCR,
+                      default: '0
+                    };
+                    axi_ar_valid_o = 1'b1;
+
+                    for (int unsigned i = IdxBlockDepth-1; i > 0; i--) begin
+                      idx_block_d[i]       = idx_block_q[i-1];
+                      idx_block_valid_d[i] = idx_block_valid_q[i-1];
+                    end
+                    idx_block_d[0]       = idx_final_addr_q[AxiAddrWidth-1:$clog2(AxiDataWidth/8)];
+                    idx_block_valid_d[0] = 1'b1;
+                  end
+                end else if (axi_addrgen_q.is_load) begin
                   axi_ar_o = '{
                     addr   : idx_final_addr_q,
                     len    : 0,
@@ -722,13 +874,14 @@ module addrgen import ara_pkg::*; import rvv_pkg::*; #(
                   axi_ar_valid_o = 1'b1;
                 end
                 // AW Channel
-                else begin
+                else if (!combine_st) begin
                   axi_aw_o = '{
                     addr   : idx_final_addr_q,
                     len    : 0,
                     size   : axi_addrgen_q.vew,
                     cache  : CACHE_MODIFIABLE,
                     burst  : BURST_INCR,
+                    atop   : amo_atop(pe_req_q.op),
                     default: '0
                   };
                   axi_aw_valid_o = 1'b1;
@@ -736,15 +889,19 @@ module addrgen import ara_pkg::*; import rvv_pkg::*; #(
 
                 // Send this request to the load/store units
                 axi_addrgen_queue = '{
-                  addr   : idx_final_addr_q,
-                  size   : axi_addrgen_q.vew,
-                  len    : 0,
-                  is_load: axi_addrgen_q.is_load
+                  addr     : idx_final_addr_q,
+                  size     : axi_addrgen_q.vew,
+                  len      : 0,
+                  is_load  : axi_addrgen_q.is_load,
+                  reuse    : idx_reuse,
+                  combine  : combine_st,
+                  nr_elems : nr_elems > 1 ? nr_elems : '0,
+                  elem_offs: elem_offs
                 };
                 axi_addrgen_queue_push = 1'b1;
 
                 // Account for the requested operands
-                axi_addrgen_d.len = axi_addrgen_q.len - 1;
+                axi_addrgen_d.len = axi_addrgen_q.len - nr_elems;
 
                 // Check if the address does generate an exception
                 if (is_addr_error(idx_final_addr_q, axi_addrgen_q.vew)) begin
@@ -752,6 +909,9 @@ module addrgen import ara_pkg::*; import rvv_pkg::*; #(
                   idx_op_error_d          = 1'b1;
                   // Forward next vstart info to the dispatcher
                   addrgen_error_vl_d      = addrgen_req.len - axi_addrgen_q.len - 1;
+                  // Drop the other addresses
+                  idx_addr_ready_d        = 1'b1;
+                  idx_head_d              = '0;
                   addrgen_req_ready       = 1'b1;
                   axi_addrgen_state_d     = AXI_ADDRGEN_IDLE;
                 end
@@ -767,6 +927,13 @@ module addrgen import ara_pkg::*; import rvv_pkg::*; #(
         end
       end
     endcase
+
+    // Send the physical addresses to the memory
+    if (axi_ar_valid_o) axi_ar_o.addr[AxiAddrWidth-1:12] = tlb_paddr[AxiAddrWidth-1:12];
+    if (axi_aw_valid_o) axi_aw_o.addr[AxiAddrWidth-1:12] = tlb_paddr[AxiAddrWidth-1:12];
+    // The VSTU sends the AWs of the combined stores
+    if (axi_addrgen_queue_push && axi_addrgen_queue.combine)
+      axi_addrgen_queue.addr[AxiAddrWidth-1:12] = tlb_paddr[AxiAddrWidth-1:12];
   end: axi_addrgen
 
   always_ff @(posedge clk_i or negedge rst_ni) begin
@@ -779,6 +946,9 @@ module addrgen import ara_pkg::*; import rvv_pkg::*; #(
       eff_axi_dw_q              <= '0;
       eff_axi_dw_log_q          <= '0;
       next_2page_msb_q          <= '0;
+      idx_block_q               <= '0;
+      idx_block_valid_q         <= '0;
+      idx_head_q                <= '0;
     end else begin
       axi_addrgen_state_q       <= axi_addrgen_state_d;
       axi_addrgen_q             <= axi_addrgen_d;
@@ -788,6 +958,9 @@ module addrgen import ara_pkg::*; import rvv_pkg::*; #(
       eff_axi_dw_q              <= eff_axi_dw_d;
       eff_axi_dw_log_q          <= eff_axi_dw_log_d;
       next_2page_msb_q          <= next_2page_msb_d;
+      idx_block_q               <= idx_block_d;
+      idx_block_valid_q         <= idx_block_valid_d;
+      idx_head_q                <= idx_head_d;
     end
   end
 
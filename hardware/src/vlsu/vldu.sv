@@ -116,7 +116,10 @@ module vldu import ara_pkg::*; import rvv_pkg::*; #(
   //  Result queues  //
   /////////////////////
 
-  localparam int unsigned ResultQueueDepth = 2;
+  // A beat misaligned with the VRF words fills the end of an entry and the start of the next one,
+  // so an entry can be filled while the one before waits for the lanes, and the one after is
+  // being completed.
+  localparam int unsigned ResultQueueDepth = 3;
 
   // There is a result queue per lane, holding the results that were not
   // yet accepted by the corresponding lane.
@@ -192,6 +195,17 @@ module vldu import ara_pkg::*; import rvv_pkg::*; #(
   // - A pointer to which byte in the full VRF word we are writing data into.
   logic [idx_width(DataWidth*NrLanes/8):0] vrf_pnt_d, vrf_pnt_q;
 
+  // Last R beats, the newest first. The coalesced indexed loads read their data from here.
+  localparam int unsigned RHistDepth = IdxCoalesceWindow > 0 ? IdxCoalesceWindow : 1;
+  logic [RHistDepth-1:0][AxiDataWidth-1:0] r_hist_d, r_hist_q;
+
+  // Current R beat
+  logic                    r_beat_valid;
+  logic [AxiDataWidth-1:0] r_beat_data;
+  assign r_beat_valid = axi_addrgen_req_i.reuse != '0 || axi_r_valid_i;
+  assign r_beat_data  = axi_addrgen_req_i.reuse != '0 ? r_hist_q[axi_addrgen_req_i.reuse - 1] :
+                        axi_r_i.data;
+
   always_comb begin: p_vldu
     // Maintain state
     vinsn_queue_d = vinsn_queue_q;
@@ -201,6 +215,7 @@ module vldu import ara_pkg::*; import rvv_pkg::*; #(
     len_d     = len_q;
     r_pnt_d   = r_pnt_q;
     vrf_pnt_d = vrf_pnt_q;
+    r_hist_d  = r_hist_q;
 
     result_queue_d           = result_queue_q;
     result_queue_valid_d     = result_queue_valid_q;
@@ -231,7 +246,7 @@ module vldu import ara_pkg::*; import rvv_pkg::*; #(
     // - There is an R beat available.
     // - The Address Generator sent us the data about the corresponding AR beat
     // - There is place in the result queue to write the data read from the R channel
-    if (axi_r_valid_i && axi_addrgen_req_valid_i
+    if (r_beat_valid && axi_addrgen_req_valid_i
         && axi_addrgen_req_i.is_load && !result_queue_full) begin
       // Bytes valid in the current R beat
       // If non-unit strided load, we do not progress within the beat
@@ -239,6 +254,35 @@ module vldu import ara_pkg::*; import rvv_pkg::*; #(
         axi_addrgen_req_i.size, axi_addrgen_req_i.len, BURST_INCR, AxiDataWidth/8, len_q);
       automatic shortint unsigned upper_byte = beat_upper_byte(axi_addrgen_req_i.addr,
         axi_addrgen_req_i.size, axi_addrgen_req_i.len, BURST_INCR, AxiDataWidth/8, len_q);
+      // Bytes of the beat to be copied into the VRF
+      automatic shortint unsigned beat_bytes = upper_byte - lower_byte + 1;
+
+      // A coalesced strided load has an element every (1 << stride_log) bytes of the beat,
+      // at the same offset in all the beats. Only their bytes are copied, from first_byte on.
+      automatic logic             coalesced  = vinsn_issue_q.op == VLSE &&
+        is_coalesced_stride(vinsn_issue_q.stride, vinsn_issue_q.vtype.vsew, AxiDataWidth/8);
+      automatic int unsigned      stride_log = coalesced_stride_log(vinsn_issue_q.stride,
+        AxiDataWidth/8);
+      automatic shortint unsigned first_byte = (lower_byte & ~((1 << stride_log) - 1)) |
+        (vinsn_issue_q.scalar_op & ((1 << stride_log) - 1));
+      // The elements of an indexed or strided load that share the beat are at elem_offs
+      automatic logic             grouped    = axi_addrgen_req_i.nr_elems > 1;
+      // The only beat of a broadcast load fills all the elements, so it is kept until the end
+      automatic logic             broadcast  = vinsn_issue_q.op == VLSE &&
+        vinsn_issue_q.is_broadcast;
+
+      // The rest of an unmasked beat can go to the next entry of the result queue, which is free
+      automatic logic             spill      = !coalesced && !grouped && !broadcast &&
+        vinsn_issue_q.vm && result_queue_cnt_q < ResultQueueDepth - 1;
+      automatic logic [idx_width(ResultQueueDepth)-1:0] spill_pnt =
+        result_queue_write_pnt_q == ResultQueueDepth-1 ? '0 : result_queue_write_pnt_q + 1;
+
+      if (coalesced) begin
+        if (first_byte < lower_byte) first_byte += 1 << stride_log;
+        beat_bytes = first_byte > upper_byte ? 0 :
+          (((upper_byte - first_byte) >> stride_log) + 1) << int'(vinsn_issue_q.vtype.vsew);
+      end
+      if (grouped) beat_bytes = axi_addrgen_req_i.nr_elems << int'(vinsn_issue_q.vtype.vsew);
 
       // Is there a vector instruction ready to be issued?
       // Do we have the operands for it?
@@ -249,38 +293,92 @@ module vldu import ara_pkg::*; import rvv_pkg::*; #(
         // How many bytes are valid in this instruction
         automatic vlen_t vinsn_valid_bytes = issue_cnt_q - vrf_pnt_q;
         // How many bytes are valid in this AXI word
-        automatic vlen_t axi_valid_bytes   = upper_byte - lower_byte - r_pnt_q + 1;
+        automatic vlen_t axi_valid_bytes   = broadcast ? vinsn_valid_bytes : beat_bytes - r_pnt_q;
 
         // How many bytes are we committing?
-        automatic logic [idx_width(DataWidth*NrLanes/8):0] valid_bytes;
-        valid_bytes = issue_cnt_q < NrLanes * 8     ? vinsn_valid_bytes : vrf_valid_bytes;
+        automatic logic [idx_width(DataWidth*NrLanes/8)+1:0] valid_bytes;
+        valid_bytes = issue_cnt_q < NrLanes * 8 || spill ? vinsn_valid_bytes : vrf_valid_bytes;
         valid_bytes = valid_bytes < axi_valid_bytes ? valid_bytes       : axi_valid_bytes;
 
-        r_pnt_d   = r_pnt_q + valid_bytes;
+        r_pnt_d   = broadcast ? '0 : r_pnt_q + valid_bytes;
         vrf_pnt_d = vrf_pnt_q + valid_bytes;
 
-        // Copy data from the R channel into the result queue
-        for (int axi_byte = 0; axi_byte < AxiDataWidth/8; axi_byte++) begin
-          // Is this byte a valid byte in the R beat?
-          if (axi_byte >= lower_byte + r_pnt_q && axi_byte <= upper_byte) begin
-            // Map axi_byte to the corresponding byte in the VRF word (sequential)
-            automatic int vrf_seq_byte = axi_byte - lower_byte - r_pnt_q + vrf_pnt_q;
-            // And then shuffle it
-            automatic int vrf_byte = shuffle_index(vrf_seq_byte, NrLanes, vinsn_issue_q.vtype.vsew);
-
-            // Is this byte a valid byte in the VRF word?
-            if (vrf_seq_byte < issue_cnt_q && vrf_seq_byte < NrLanes * 8) begin
-              // At which lane, and what is the byte offset in that lane, of the byte vrf_byte?
+        // Copy the elements of a coalesced strided load, or of a grouped request, into the
+        // result queue
+        if (coalesced || grouped) begin
+          for (int beat_byte = 0; beat_byte < AxiDataWidth/8; beat_byte++) begin
+            if (beat_byte >= r_pnt_q && beat_byte < beat_bytes) begin
+              // Byte b of the element e of the beat
+              automatic int e        = beat_byte >> int'(vinsn_issue_q.vtype.vsew);
+              automatic int b        = beat_byte & ((1 << int'(vinsn_issue_q.vtype.vsew)) - 1);
+              automatic int axi_byte = grouped ? axi_addrgen_req_i.elem_offs[e] + b :
+                first_byte + (e << stride_log) + b;
+              // Map it to the corresponding byte in the VRF word (sequential), and shuffle it
+              automatic int vrf_seq_byte = beat_byte - r_pnt_q + vrf_pnt_q;
+              automatic int vrf_byte = shuffle_index(vrf_seq_byte, NrLanes, vinsn_issue_q.vtype.vsew);
+
+              if (vrf_seq_byte < issue_cnt_q && vrf_seq_byte < NrLanes * 8) begin
+                automatic int vrf_lane   = vrf_byte >> 3;
+                automatic int vrf_offset = vrf_byte[2:0];
+
+                result_queue_d[result_queue_write_pnt_q][vrf_lane].wdata[8*vrf_offset +: 8] =
+                  r_beat_data[8*axi_byte +: 8];
+                result_queue_d[result_queue_write_pnt_q][vrf_lane].be[vrf_offset] =
+                  vinsn_issue_q.vm || mask_i[vrf_lane][vrf_offset];
+              end
+            end
+          end
+        end else if (broadcast) begin
+          // Replicate the element of a broadcast load over the VRF word
+          for (int vrf_seq_byte = 0; vrf_seq_byte < NrLanes * 8; vrf_seq_byte++) begin
+            if (vrf_seq_byte >= vrf_pnt_q && vrf_seq_byte < vrf_pnt_d) begin
+              automatic int axi_byte = lower_byte +
+                (vrf_seq_byte & ((1 << int'(vinsn_issue_q.vtype.vsew)) - 1));
+              automatic int vrf_byte = shuffle_index(vrf_seq_byte, NrLanes, vinsn_issue_q.vtype.vsew);
               automatic int vrf_lane   = vrf_byte >> 3;
               automatic int vrf_offset = vrf_byte[2:0];
 
-              // Copy data and byte strobe
               result_queue_d[result_queue_write_pnt_q][vrf_lane].wdata[8*vrf_offset +: 8] =
-                axi_r_i.data[8*axi_byte +: 8];
+                r_beat_data[8*axi_byte +: 8];
               result_queue_d[result_queue_write_pnt_q][vrf_lane].be[vrf_offset] =
                 vinsn_issue_q.vm || mask_i[vrf_lane][vrf_offset];
             end
           end
+        end else begin
+          // Copy data from the R channel into the result queue
+          for (int axi_byte = 0; axi_byte < AxiDataWidth/8; axi_byte++) begin
+            // Is this byte a valid byte in the R beat?
+            if (axi_byte >= lower_byte + r_pnt_q && axi_byte <= upper_byte) begin
+              // Map axi_byte to the corresponding byte in the VRF word (sequential)
+              automatic int vrf_seq_byte = axi_byte - lower_byte - r_pnt_q + vrf_pnt_q;
+              // And then shuffle it
+              automatic int vrf_byte = shuffle_index(vrf_seq_byte, NrLanes, vinsn_issue_q.vtype.vsew);
+
+              // Is this byte a valid byte in the VRF word?
+              if (vrf_seq_byte < issue_cnt_q && vrf_seq_byte < NrLanes * 8) begin
+                // At which lane, and what is the byte offset in that lane, of the byte vrf_byte?
+                automatic int vrf_lane   = vrf_byte >> 3;
+                automatic int vrf_offset = vrf_byte[2:0];
+
+                // Copy data and byte strobe
+                result_queue_d[result_queue_write_pnt_q][vrf_lane].wdata[8*vrf_offset +: 8] =
+                  r_beat_data[8*axi_byte +: 8];
+                result_queue_d[result_queue_write_pnt_q][vrf_lane].be[vrf_offset] =
+                  vinsn_issue_q.vm || mask_i[vrf_lane][vrf_offset];
+              end
+              // Or in the next one?
+              else if (spill && vrf_seq_byte < issue_cnt_q) begin
+                automatic int spill_byte = shuffle_index(vrf_seq_byte - NrLanes * 8, NrLanes,
+                  vinsn_issue_q.vtype.vsew);
+                automatic int vrf_lane   = spill_byte >> 3;
+                automatic int vrf_offset = spill_byte[2:0];
+
+                result_queue_d[spill_pnt][vrf_lane].wdata[8*vrf_offset +: 8] =
+                  r_beat_data[8*axi_byte +: 8];
+                result_queue_d[spill_pnt][vrf_lane].be[vrf_offset] = 1'b1;
+              end
+            end
+          end
         end
 
         // Initialize id and addr fields of the result queue requests
@@ -289,11 +387,17 @@ module vldu import ara_pkg::*; import rvv_pkg::*; #(
           result_queue_d[result_queue_write_pnt_q][lane].addr = vaddr(vinsn_issue_q.vd, NrLanes) +
             (((vinsn_issue_q.vl - (issue_cnt_q >> int'(vinsn_issue_q.vtype.vsew))) / NrLanes) >>
             (int'(EW64) - int'(vinsn_issue_q.vtype.vsew)));
+          // The next entry holds the next VRF word
+          if (vrf_pnt_d > NrLanes*8) begin
+            result_queue_d[spill_pnt][lane].id   = vinsn_issue_q.id;
+            result_queue_d[spill_pnt][lane].addr =
+              result_queue_d[result_queue_write_pnt_q][lane].addr + 1;
+          end
         end
       end
 
       // We have a word ready to be sent to the lanes
-      if (vrf_pnt_d == NrLanes*8 || vrf_pnt_d == issue_cnt_q) begin
+      if (vrf_pnt_d >= NrLanes*8 || vrf_pnt_d == issue_cnt_q) begin
         // Increment result queue pointers and counters
         result_queue_cnt_d += 1;
         if (result_queue_write_pnt_q == ResultQueueDepth-1)
@@ -307,18 +411,36 @@ module vldu import ara_pkg::*; import rvv_pkg::*; #(
         // Acknowledge the mask operands
         mask_ready_o = !vinsn_issue_q.vm;
 
-        // Reset the pointer in the VRF word
-        vrf_pnt_d   = '0;
+        // Reset the pointer in the VRF word, or move it to the next one
+        vrf_pnt_d   = vrf_pnt_d >= NrLanes*8 ? vrf_pnt_d - NrLanes*8 : '0;
         // Account for the results that were issued
         issue_cnt_d = issue_cnt_q - NrLanes * 8;
         if (issue_cnt_q < NrLanes * 8)
           issue_cnt_d = '0;
+
+        // The beat also filled the last word of the instruction
+        if (vrf_pnt_d != '0 && vrf_pnt_d == issue_cnt_d) begin
+          result_queue_cnt_d += 1;
+          if (spill_pnt == ResultQueueDepth-1)
+            result_queue_write_pnt_d = '0;
+          else
+            result_queue_write_pnt_d = spill_pnt + 1;
+          result_queue_valid_d[spill_pnt] = {NrLanes{1'b1}};
+
+          vrf_pnt_d   = '0;
+          issue_cnt_d = '0;
+        end
       end
 
       // Consumed all valid bytes in this R beat
-      if (r_pnt_d == upper_byte - lower_byte + 1 || issue_cnt_d == '0) begin
-        // Request another beat
-        axi_r_ready_o = 1'b1;
+      if ((!broadcast && r_pnt_d == beat_bytes) || issue_cnt_d == '0) begin
+        // Request another beat, and keep this one for the coalesced indexed loads
+        if (axi_addrgen_req_i.reuse == '0) begin
+          axi_r_ready_o = 1'b1;
+          for (int unsigned i = RHistDepth-1; i > 0; i--)
+            r_hist_d[i] = r_hist_q[i-1];
+          r_hist_d[0] = axi_r_i.data;
+        end
         r_pnt_d       = '0;
         // Account for the beat we consumed
         len_d         = len_q + 1;
@@ -445,6 +567,7 @@ module vldu import ara_pkg::*; import rvv_pkg::*; #(
       len_q              <= '0;
       r_pnt_q            <= '0;
       vrf_pnt_q          <= '0;
+      r_hist_q           <= '0;
       pe_resp_o          <= '0;
       result_final_gnt_q <= '0;
     end else begin
@@ -454,6 +577,7 @@ module vldu import ara_pkg::*; import rvv_pkg::*; #(
       len_q              <= len_d;
       r_pnt_q            <= r_pnt_d;
       vrf_pnt_q          <= vrf_pnt_d;
+      r_hist_q           <= r_hist_d;
       pe_resp_o          <= pe_resp;
       result_final_gnt_q <= result_final_gnt_d;
     end
@@ -66,7 +66,19 @@ module vlsu import ara_pkg::*; import rvv_pkg::*; #(
     output elen_t     [NrLanes-1:0] ldu_result_wdata_o,
     output strb_t     [NrLanes-1:0] ldu_result_be_o,
     input  logic      [NrLanes-1:0] ldu_result_gnt_i,
-    input  logic      [NrLanes-1:0] ldu_result_final_gnt_i
+    input  logic      [NrLanes-1:0] ldu_result_final_gnt_i,
+    // Interface with CVA6's MMU
+    input  logic                    en_ld_st_translation_i,
+    input  logic                    flush_tlb_i,
+    output logic                    mmu_req_o,
+    output logic [AxiAddrWidth-1:0] mmu_vaddr_o,
+    output logic                    mmu_is_store_o,
+    input  logic                    mmu_valid_i,
+    input  logic [AxiAddrWidth-1:0] mmu_paddr_i,
+    input  logic                    mmu_exception_i,
+    // Performance events
+    output logic                    perf_st_merge_o,
+    output logic                    perf_st_wcb_beat_o
   );
 
   ///////////////////
@@ -75,6 +87,11 @@ module vlsu import ara_pkg::*; import rvv_pkg::*; #(
 
   typedef logic [AxiAddrWidth-1:0] axi_addr_t;
 
+  // The AWs of the address generator, and of the write-combining buffer of the store unit
+  axi_aw_t addrgen_aw, stu_aw;
+  logic    addrgen_aw_valid, addrgen_aw_ready, stu_aw_valid;
+  logic    stu_combine_pending;
+
   ///////////////
   //  AXI Cut  //
   ///////////////
@@ -120,9 +137,9 @@ module vlsu import ara_pkg::*; import rvv_pkg::*; #(
     .clk_i                      (clk_i                      ),
     .rst_ni                     (rst_ni                     ),
     // AXI Memory Interface
-    .axi_aw_o                   (axi_req.aw                 ),
-    .axi_aw_valid_o             (axi_req.aw_valid           ),
-    .axi_aw_ready_i             (axi_resp.aw_ready          ),
+    .axi_aw_o                   (addrgen_aw                 ),
+    .axi_aw_valid_o             (addrgen_aw_valid           ),
+    .axi_aw_ready_i             (addrgen_aw_ready           ),
     .axi_ar_o                   (axi_req.ar                 ),
     .axi_ar_valid_o             (axi_req.ar_valid           ),
     .axi_ar_ready_i             (axi_resp.ar_ready          ),
@@ -144,9 +161,47 @@ module vlsu import ara_pkg::*; import rvv_pkg::*; #(
     .axi_addrgen_req_o          (axi_addrgen_req            ),
     .axi_addrgen_req_valid_o    (axi_addrgen_req_valid      ),
     .ldu_axi_addrgen_req_ready_i(ldu_axi_addrgen_req_ready  ),
-    .stu_axi_addrgen_req_ready_i(stu_axi_addrgen_req_ready  )
+    .stu_axi_addrgen_req_ready_i(stu_axi_addrgen_req_ready  ),
+    .stu_combine_pending_i      (stu_combine_pending        ),
+    // Interface with CVA6's MMU
+    .en_ld_st_translation_i     (en_ld_st_translation_i     ),
+    .flush_tlb_i                (flush_tlb_i                ),
+    .mmu_req_o                  (mmu_req_o                  ),
+    .mmu_vaddr_o                (mmu_vaddr_o                ),
+    .mmu_is_store_o             (mmu_is_store_o             ),
+    .mmu_valid_i                (mmu_valid_i                ),
+    .mmu_paddr_i                (mmu_paddr_i                ),
+    .mmu_exception_i            (mmu_exception_i            )
   );
 
+  //////////////////////////
+  //  Load Return Buffer  //
+  //////////////////////////
+
+  // Accept the R beats as long as there is space, even if the load unit is stalled by the lanes
+  axi_r_t r_buf;
+  logic   r_buf_full;
+  logic   r_buf_empty;
+  logic   r_buf_ready;
+
+  fifo_v3 #(
+    .DEPTH(VlduRBufDepth),
+    .dtype(axi_r_t      )
+  ) i_ldu_r_buf (
+    .clk_i     (clk_i                          ),
+    .rst_ni    (rst_ni                         ),
+    .flush_i   (1'b0                           ),
+    .testmode_i(1'b0                           ),
+    .data_i    (axi_resp.r                     ),
+    .push_i    (axi_resp.r_valid && !r_buf_full),
+    .full_o    (r_buf_full                     ),
+    .data_o    (r_buf                          ),
+    .pop_i     (r_buf_ready && !r_buf_empty    ),
+    .empty_o   (r_buf_empty                    ),
+    .usage_o   (/* Unused */                   )
+  );
+  assign axi_req.r_ready = !r_buf_full;
+
   ////////////////////////
   //  Vector Load Unit  //
   ////////////////////////
@@ -161,9 +216,9 @@ module vlsu import ara_pkg::*; import rvv_pkg::*; #(
     .clk_i                  (clk_i                     ),
     .rst_ni                 (rst_ni                    ),
     // AXI Memory Interface
-    .axi_r_i                (axi_resp.r                ),
-    .axi_r_valid_i          (axi_resp.r_valid          ),
-    .axi_r_ready_o          (axi_req.r_ready           ),
+    .axi_r_i                (r_buf                     ),
+    .axi_r_valid_i          (!r_buf_empty              ),
+    .axi_r_ready_o          (r_buf_ready               ),
     // Interface with the dispatcher
     .load_complete_o        (load_complete_o           ),
     // Interface with the main sequencer
@@ -197,6 +252,7 @@ module vlsu import ara_pkg::*; import rvv_pkg::*; #(
   vstu #(
     .AxiAddrWidth(AxiAddrWidth),
     .AxiDataWidth(AxiDataWidth),
+    .axi_aw_t    (axi_aw_t    ),
     .axi_w_t     (axi_w_t     ),
     .axi_b_t     (axi_b_t     ),
     .NrLanes     (NrLanes     ),
@@ -205,6 +261,9 @@ module vlsu import ara_pkg::*; import rvv_pkg::*; #(
     .clk_i                  (clk_i                      ),
     .rst_ni                 (rst_ni                     ),
     // AXI Memory Interface
+    .axi_aw_o               (stu_aw                     ),
+    .axi_aw_valid_o         (stu_aw_valid               ),
+    .axi_aw_ready_i         (axi_resp.aw_ready          ),
     .axi_w_o                (axi_req.w                  ),
     .axi_w_valid_o          (axi_req.w_valid            ),
     .axi_w_ready_i          (axi_resp.w_ready           ),
@@ -214,6 +273,8 @@ module vlsu import ara_pkg::*; import rvv_pkg::*; #(
     // Interface with the dispatcher
     .store_pending_o        (store_pending_o            ),
     .store_complete_o       (store_complete_o           ),
+    // Interface with the address generator
+    .combine_pending_o      (stu_combine_pending        ),
     // Interface with the main sequencer
     .pe_req_i               (pe_req_i                   ),
     .pe_req_valid_i         (pe_req_valid_i             ),
@@ -231,9 +292,18 @@ module vlsu import ara_pkg::*; import rvv_pkg::*; #(
     // Interface with the lanes
     .stu_operand_i          (stu_operand_i              ),
     .stu_operand_valid_i    (stu_operand_valid_i        ),
-    .stu_operand_ready_o    (stu_operand_ready_o        )
+    .stu_operand_ready_o    (stu_operand_ready_o        ),
+    // Performance events
+    .perf_st_merge_o        (perf_st_merge_o            ),
+    .perf_st_wcb_beat_o     (perf_st_wcb_beat_o         )
   );
 
+  // The address generator waits for the AWs of the buffer before sending the ones of the other
+  // stores, so that only one of them is valid at a time
+  assign axi_req.aw       = stu_aw_valid ? stu_aw : addrgen_aw;
+  assign axi_req.aw_valid = stu_aw_valid || addrgen_aw_valid;
+  assign addrgen_aw_ready = axi_resp.aw_ready && !stu_aw_valid;
+
   //////////////////
   //  Assertions  //
   //////////////////
@@ -0,0 +1,136 @@
+// Copyright 2021 ETH Zurich and University of Bologna.
+// Solderpad Hardware License, Version 0.51, see LICENSE for details.
+// SPDX-License-Identifier: SHL-0.51
+//
+// Description:
+// The VLSU's TLB translates the virtual addresses of the AXI requests of the
+// address generator, one 4 KiB page at a time. It is fully associative, with
+// NrEntries entries replaced in round-robin order.
+//
+// A miss asks the MMU of CVA6 to translate the address, with its page table
+// walker, and waits for the answer. A translation for a load does not allow the
+// stores to the page, which ask the MMU again, so that it checks that the page
+// is writable and marks it dirty. The page faults are not kept in the TLB.
+// Without translation enabled, the addresses are physical ones.
+
+module vlsu_tlb #(
+    parameter int  unsigned NrEntries    = 0,
+    parameter int  unsigned AxiAddrWidth = 0,
+    // Dependant parameters. DO NOT CHANGE!
+    parameter type          axi_addr_t   = logic [AxiAddrWidth-1:0]
+  ) (
+    input  logic      clk_i,
+    input  logic      rst_ni,
+    // Translation enabled for the loads and the stores, and sfence.vma
+    input  logic      en_translation_i,
+    input  logic      flush_i,
+    // Interface with the address generator
+    input  logic      req_i,
+    input  axi_addr_t vaddr_i,
+    input  logic      is_store_i,
+    output logic      valid_o,
+    output axi_addr_t paddr_o,
+    output logic      exception_o,
+    // Interface with CVA6's MMU
+    output logic      mmu_req_o,
+    output axi_addr_t mmu_vaddr_o,
+    output logic      mmu_is_store_o,
+    input  logic      mmu_valid_i,
+    input  axi_addr_t mmu_paddr_i,
+    input  logic      mmu_exception_i
+  );
+
+  typedef logic [AxiAddrWidth-12-1:0] page_t;
+
+  typedef struct packed {
+    logic  valid;
+    // The page was translated for a store
+    logic  store;
+    page_t vpn;
+    page_t ppn;
+  } entry_t;
+
+  entry_t [NrEntries-1:0]          entry_d, entry_q;
+  logic [$clog2(NrEntries+1)-1:0]  victim_d, victim_q;
+  // Waiting for the MMU
+  logic                            walk_d, walk_q;
+
+  always_ff @(posedge clk_i or negedge rst_ni) begin: p_tlb_ff
+    if (!rst_ni) begin
+      entry_q  <= '0;
+      victim_q <= '0;
+      walk_q   <= 1'b0;
+    end else begin
+      entry_q  <= entry_d;
+      victim_q <= victim_d;
+      walk_q   <= walk_d;
+    end
+  end: p_tlb_ff
+
+  always_comb begin: p_tlb
+    entry_d  = entry_q;
+    victim_d = victim_q;
+    walk_d   = walk_q;
+
+    valid_o     = 1'b0;
+    paddr_o     = vaddr_i;
+    exception_o = 1'b0;
+
+    mmu_req_o      = 1'b0;
+    mmu_vaddr_o    = vaddr_i;
+    mmu_is_store_o = is_store_i;
+
+    if (!en_translation_i)
+      valid_o = req_i;
+    else if (req_i) begin
+      for (int e = 0; e < NrEntries; e++)
+        if (entry_q[e].valid && entry_q[e].vpn == vaddr_i[AxiAddrWidth-1:12] &&
+            (entry_q[e].store || !is_store_i)) begin
+          valid_o = 1'b1;
+          paddr_o = {entry_q[e].ppn, vaddr_i[11:0]};
+        end
+
+      // Miss: translate the page with the MMU. The request holds the same address until it is
+      // answered.
+      if (!valid_o) begin
+        mmu_req_o = 1'b1;
+        walk_d    = 1'b1;
+        if (walk_q && mmu_valid_i) begin
+          walk_d = 1'b0;
+          if (mmu_exception_i)
+            exception_o = 1'b1;
+          else begin
+            // Replace the stale entry of the page, if any, or the next victim
+            automatic logic [$clog2(NrEntries+1)-1:0] idx = victim_q;
+            for (int e = 0; e < NrEntries; e++)
+              if (entry_q[e].valid && entry_q[e].vpn == vaddr_i[AxiAddrWidth-1:12]) idx = e;
+            entry_d[idx] = '{
+              valid: 1'b1,
+              store: is_store_i,
+              vpn  : vaddr_i[AxiAddrWidth-1:12],
+              ppn  : mmu_paddr_i[AxiAddrWidth-1:12]
+            };
+            if (idx == victim_q) victim_d = victim_q == NrEntries-1 ? '0 : victim_q + 1;
+            // Answer in the same cycle
+            valid_o = 1'b1;
+            paddr_o = {mmu_paddr_i[AxiAddrWidth-1:12], vaddr_i[11:0]};
+          end
+        end
+      end
+    end
+
+    // The page tables, or the address space, changed
+    if (flush_i || !en_translation_i) begin
+      for (int e = 0; e < NrEntries; e++) entry_d[e].valid = 1'b0;
+      walk_d = 1'b0;
+    end
+  end: p_tlb
+
+  //////////////////
+  //  Assertions  //
+  //////////////////
+
+  if (NrEntries == 0)
+    $error("[vlsu_tlb] The TLB needs at least one entry.");
+
+endmodule : vlsu_tlb
@@ -12,6 +12,9 @@
 // Description:
 // This is Ara's vector store unit. It sends transactions on the W bus,
 // upon receiving vector memory operations.
+// The elements of the strided and indexed stores go through a write-combining
+// buffer, which merges the consecutive elements of an AXI-width block into one
+// full-width W beat, and sends it with its own AW.
 
 module vstu import ara_pkg::*; import rvv_pkg::*; #(
     parameter  int  unsigned NrLanes = 0,
@@ -19,6 +22,7 @@ module vstu import ara_pkg::*; import rvv_pkg::*; #(
     // AXI Interface parameters
     parameter  int  unsigned AxiDataWidth = 0,
     parameter  int  unsigned AxiAddrWidth = 0,
+    parameter  type          axi_aw_t     = logic,
     parameter  type          axi_w_t      = logic,
     parameter  type          axi_b_t      = logic,
     // Dependant parameters. DO NOT CHANGE!
@@ -29,6 +33,9 @@ module vstu import ara_pkg::*; import rvv_pkg::*; #(
     input  logic                           clk_i,
     input  logic                           rst_ni,
     // Memory interface
+    output axi_aw_t                        axi_aw_o,
+    output logic                           axi_aw_valid_o,
+    input  logic                           axi_aw_ready_i,
     output axi_w_t                         axi_w_o,
     output logic                           axi_w_valid_o,
     input  logic                           axi_w_ready_i,
@@ -38,6 +45,8 @@ module vstu import ara_pkg::*; import rvv_pkg::*; #(
     // Interface with the dispatcher
     output logic                           store_pending_o,
     output logic                           store_complete_o,
+    // Interface with the address generator
+    output logic                           combine_pending_o,
     // Interface with the main sequencer
     input  pe_req_t                        pe_req_i,
     input  logic                           pe_req_valid_i,
@@ -55,13 +64,21 @@ module vstu import ara_pkg::*; import rvv_pkg::*; #(
     // Interface with the Mask unit
     input  strb_t            [NrLanes-1:0] mask_i,
     input  logic             [NrLanes-1:0] mask_valid_i,
-    output logic                           mask_ready_o
+    output logic                           mask_ready_o,
+    // Performance events
+    output logic                           perf_st_merge_o,
+    output logic                           perf_st_wcb_beat_o
   );
 
   import cf_math_pkg::idx_width;
   import axi_pkg::beat_lower_byte;
   import axi_pkg::beat_upper_byte;
   import axi_pkg::BURST_INCR;
+  import axi_pkg::CACHE_MODIFIABLE;
+  import axi_pkg::aligned_addr;
+
+  typedef logic [AxiDataWidth-1:0]   axi_data_t;
+  typedef logic [AxiDataWidth/8-1:0] axi_strb_t;
 
   ///////////////////////
   //  Spill registers  //
@@ -122,10 +139,11 @@ module vstu import ara_pkg::*; import rvv_pkg::*; #(
   logic vinsn_queue_full;
   assign vinsn_queue_full = (vinsn_queue_q.commit_cnt == VInsnQueueDepth);
 
-  // Is the vector instruction queue empty?
-  logic vinsn_queue_empty;
-  assign vinsn_queue_empty = (vinsn_queue_q.commit_cnt == '0);
-  assign store_pending_o   = !vinsn_queue_empty;
+  // The stores are pending until their last W beat. Then, all their AWs went out, and
+  // ara_system orders the later scalar accesses after them.
+  // The beat of the write-combining buffer goes out after the issue of its elements.
+  logic wcb_pending;
+  assign store_pending_o   = vinsn_queue_q.issue_cnt != '0 || wcb_pending;
 
   // Do we have a vector instruction ready to be issued?
   pe_req_t vinsn_issue_d, vinsn_issue_q;
@@ -171,6 +189,43 @@ module vstu import ara_pkg::*; import rvv_pkg::*; #(
   // - A pointer to which byte in the full VRF word we are reading data from.
   logic [idx_width(DataWidth*NrLanes/8):0] vrf_pnt_d, vrf_pnt_q;
 
+  // Realignment buffer
+  //
+  // A W beat of a store misaligned with the VRF words takes the last bytes of a VRF word and the
+  // first bytes of the next one. The store unit keeps the older word here, with its mask, while
+  // the lanes send the next one, so that it sends full W beats at any alignment. When the buffer
+  // is valid, the pointers refer to its word, and the one from the lanes follows it.
+  elen_t [NrLanes-1:0] realign_word_d, realign_word_q;
+  strb_t [NrLanes-1:0] realign_mask_d, realign_mask_q;
+  logic                realign_valid_d, realign_valid_q;
+
+  // Write-combining buffer
+  //
+  // The elements of the combined stores are merged in the beat of their AXI-width block, with
+  // their byte strobes. The beat goes out when an element of another block arrives, or after the
+  // last element of its instruction, through the output register, which sends its AW and its W
+  // beat. The other W beats wait for it.
+  axi_addr_t wcb_addr_d, wcb_addr_q;
+  axi_data_t wcb_data_d, wcb_data_q;
+  axi_strb_t wcb_strb_d, wcb_strb_q;
+  logic      wcb_valid_d, wcb_valid_q;
+  // The buffer holds the last element of its instruction
+  logic      wcb_last_d, wcb_last_q;
+  // Output register, with the AW and the W beat still to be sent
+  axi_addr_t wcb_out_addr_d, wcb_out_addr_q;
+  axi_data_t wcb_out_data_d, wcb_out_data_q;
+  axi_strb_t wcb_out_strb_d, wcb_out_strb_q;
+  logic      wcb_out_aw_d, wcb_out_aw_q;
+  logic      wcb_out_w_d, wcb_out_w_q;
+
+  // The element of the AXI request goes in a new beat, and the buffer can take it
+  logic   wcb_emit, wcb_ready;
+  // W beat of the element(s) of the AXI request
+  axi_w_t beat;
+
+  assign wcb_pending       = wcb_valid_q || wcb_out_aw_q || wcb_out_w_q;
+  assign combine_pending_o = wcb_pending;
+
   always_comb begin: p_vstu
     // Maintain state
     vinsn_queue_d = vinsn_queue_q;
@@ -179,33 +234,104 @@ module vstu import ara_pkg::*; import rvv_pkg::*; #(
     len_d     = len_q;
     vrf_pnt_d = vrf_pnt_q;
 
+    realign_word_d  = realign_word_q;
+    realign_mask_d  = realign_mask_q;
+    realign_valid_d = realign_valid_q;
+
+    wcb_addr_d     = wcb_addr_q;
+    wcb_data_d     = wcb_data_q;
+    wcb_strb_d     = wcb_strb_q;
+    wcb_valid_d    = wcb_valid_q;
+    wcb_last_d     = wcb_last_q;
+    wcb_out_addr_d = wcb_out_addr_q;
+    wcb_out_data_d = wcb_out_data_q;
+    wcb_out_strb_d = wcb_out_strb_q;
+    wcb_out_aw_d   = wcb_out_aw_q;
+    wcb_out_w_d    = wcb_out_w_q;
+
     // Vector instructions currently running
     vinsn_running_d = vinsn_running_q & pe_vinsn_running_i;
 
     // We are not ready, by default
     axi_addrgen_req_ready_o = 1'b0;
     pe_resp                 = '0;
+    axi_aw_o                = '0;
+    axi_aw_valid_o          = 1'b0;
     axi_w_o                 = '0;
     axi_w_valid_o           = 1'b0;
     axi_b_ready_o           = 1'b0;
     stu_operand_ready       = 1'b0;
     mask_ready_o            = 1'b0;
     store_complete_o        = 1'b0;
+    perf_st_merge_o         = 1'b0;
+    perf_st_wcb_beat_o      = 1'b0;
 
     // Inform the main sequencer if we are idle
     pe_req_ready_o = !vinsn_queue_full;
 
+    /////////////////////////////////////
+    //  Write-combining buffer output  //
+    /////////////////////////////////////
+
+    // Send the AW and the W beat of the output register
+    if (wcb_out_aw_q) begin
+      axi_aw_o = '{
+        addr   : wcb_out_addr_q,
+        len    : 0,
+        size   : $clog2(AxiDataWidth/8),
+        cache  : CACHE_MODIFIABLE,
+        burst  : BURST_INCR,
+        default: '0
+      };
+      axi_aw_valid_o = 1'b1;
+      if (axi_aw_ready_i) wcb_out_aw_d = 1'b0;
+    end
+    if (wcb_out_w_q) begin
+      axi_w_o = '{
+        data   : wcb_out_data_q,
+        strb   : wcb_out_strb_q,
+        last   : 1'b1,
+        default: '0
+      };
+      axi_w_valid_o = 1'b1;
+      if (axi_w_ready_i) begin
+        wcb_out_w_d        = 1'b0;
+        perf_st_wcb_beat_o = 1'b1;
+      end
+    end
+
+    // Send the beat with the last element of its instruction
+    if (wcb_valid_q && wcb_last_q && !wcb_out_aw_d && !wcb_out_w_d) begin
+      wcb_out_addr_d = wcb_addr_q;
+      wcb_out_data_d = wcb_data_q;
+      wcb_out_strb_d = wcb_strb_q;
+      wcb_out_aw_d   = 1'b1;
+      wcb_out_w_d    = 1'b1;
+      wcb_valid_d    = 1'b0;
+      wcb_last_d     = 1'b0;
+    end
+
     /////////////////////////////////////
     //  Write data into the W channel  //
     /////////////////////////////////////
 
+    // A combined element of another block sends the beat of the buffer out
+    wcb_emit  = wcb_valid_d && (wcb_last_d || wcb_addr_d !=
+      aligned_addr(axi_addrgen_req_i.addr, $clog2(AxiDataWidth/8)));
+    wcb_ready = !wcb_emit || (!wcb_out_aw_d && !wcb_out_w_d);
+    beat      = '0;
+
     // We are ready to send a W beat if
     // - There is an instruction ready to be issued
-    // - We received all the operands from the lanes
+    // - We have the VRF words of all its bytes, from the realignment buffer or from the lanes
     // - The address generator generated an AXI AW request for this write beat
-    // - The AXI subsystem is ready to accept this W beat
-    if (vinsn_issue_valid && &stu_operand_valid && (vinsn_issue_q.vm || (|mask_valid_i)) &&
-        axi_addrgen_req_valid_i && !axi_addrgen_req_i.is_load && axi_w_ready_i) begin
+    // - The AXI subsystem is ready to accept this W beat, after the beats of the write-
+    //   combining buffer. The combined elements only need the output register, if their
+    //   element goes in a new beat.
+
+    if (vinsn_issue_valid && axi_addrgen_req_valid_i && !axi_addrgen_req_i.is_load &&
+        (axi_addrgen_req_i.combine ? wcb_ready :
+          axi_w_ready_i && !wcb_valid_q && !wcb_out_w_q)) begin
       // Bytes valid in the current W beat
       automatic shortint unsigned lower_byte = beat_lower_byte(axi_addrgen_req_i.addr,
         axi_addrgen_req_i.size, axi_addrgen_req_i.len, BURST_INCR, AxiDataWidth/8, len_q);
@@ -213,70 +339,147 @@ module vstu import ara_pkg::*; import rvv_pkg::*; #(
         axi_addrgen_req_i.size, axi_addrgen_req_i.len, BURST_INCR, AxiDataWidth/8, len_q);
 
       // Account for the issued bytes
-      // How many bytes are valid in this VRF word
-      automatic vlen_t vrf_valid_bytes   = NrLanes * 8 - vrf_pnt_q;
       // How many bytes are valid in this instruction
       automatic vlen_t vinsn_valid_bytes = issue_cnt_q - vrf_pnt_q;
       // How many bytes are valid in this AXI word
       automatic vlen_t axi_valid_bytes   = upper_byte - lower_byte + 1;
 
       // How many bytes are we committing?
-      automatic logic [idx_width(DataWidth*NrLanes/8):0] valid_bytes;
-      valid_bytes = issue_cnt_q < NrLanes * 8     ? vinsn_valid_bytes : vrf_valid_bytes;
-      valid_bytes = valid_bytes < axi_valid_bytes ? valid_bytes       : axi_valid_bytes;
-
-      vrf_pnt_d = vrf_pnt_q + valid_bytes;
-
-      // Copy data from the operands into the W channel
-      for (int axi_byte = 0; axi_byte < AxiDataWidth/8; axi_byte++) begin
-        // Is this byte a valid byte in the W beat?
-        if (axi_byte >= lower_byte && axi_byte <= upper_byte) begin
-          // Map axy_byte to the corresponding byte in the VRF word (sequential)
-          automatic int vrf_seq_byte = axi_byte - lower_byte + vrf_pnt_q;
-          // And then shuffle it
-          automatic int vrf_byte     = shuffle_index(vrf_seq_byte, NrLanes, vinsn_issue_q.eew_vs1);
-
-          // Is this byte a valid byte in the VRF word?
-          if (vrf_seq_byte < issue_cnt_q) begin
-            // At which lane, and what is the byte offset in that lane, of the byte vrf_byte?
-            automatic int vrf_lane   = vrf_byte >> 3;
-            automatic int vrf_offset = vrf_byte[2:0];
-
-            // Copy data
-            axi_w_o.data[8*axi_byte +: 8] = stu_operand[vrf_lane][8*vrf_offset +: 8];
-            axi_w_o.strb[axi_byte]        = vinsn_issue_q.vm || mask_i[vrf_lane][vrf_offset];
+      automatic logic [idx_width(DataWidth*NrLanes/8)+1:0] valid_bytes;
+      // Is the VRF word from the lanes valid, with its mask?
+      automatic logic operand_valid = &stu_operand_valid && (vinsn_issue_q.vm || (|mask_valid_i));
+      valid_bytes = vinsn_valid_bytes < axi_valid_bytes ? vinsn_valid_bytes : axi_valid_bytes;
+
+      // The beat ends in the word of the lanes, or in the buffered one
+      if (realign_valid_q ? (vrf_pnt_q + valid_bytes <= NrLanes * 8 || operand_valid) :
+          (vrf_pnt_q + valid_bytes <= NrLanes * 8 && operand_valid)) begin
+        vrf_pnt_d = vrf_pnt_q + valid_bytes;
+
+        // Copy data from the operands into the W channel
+        for (int axi_byte = 0; axi_byte < AxiDataWidth/8; axi_byte++) begin
+          // Is this byte a valid byte in the W beat?
+          if (axi_byte >= lower_byte && axi_byte <= upper_byte) begin
+            // Map axy_byte to the corresponding byte in the VRF word (sequential)
+            automatic int vrf_seq_byte = axi_byte - lower_byte + vrf_pnt_q;
+            // Does it come from the buffered word?
+            automatic logic from_buffer = realign_valid_q && vrf_seq_byte < NrLanes * 8;
+            // And then shuffle it
+            automatic int vrf_byte     = shuffle_index(vrf_seq_byte % (NrLanes * 8), NrLanes,
+              vinsn_issue_q.eew_vs1);
+
+            // Is this byte a valid byte in the VRF word?
+            if (vrf_seq_byte < issue_cnt_q) begin
+              // At which lane, and what is the byte offset in that lane, of the byte vrf_byte?
+              automatic int vrf_lane   = vrf_byte >> 3;
+              automatic int vrf_offset = vrf_byte[2:0];
+
+              // Copy data
+              beat.data[8*axi_byte +: 8] = from_buffer ?
+                realign_word_q[vrf_lane][8*vrf_offset +: 8] :
+                stu_operand[vrf_lane][8*vrf_offset +: 8];
+              beat.strb[axi_byte]        = vinsn_issue_q.vm || (from_buffer ?
+                realign_mask_q[vrf_lane][vrf_offset] : mask_i[vrf_lane][vrf_offset]);
+            end
           end
         end
-      end
+        // The atomic AND clears the bits of the memory that are cleared in its operand
+        if (vinsn_issue_q.op == VAMOAND) beat.data = ~beat.data;
+
+        if (axi_addrgen_req_i.combine) begin
+          // Send the buffer out, and start the beat of the block of the element
+          if (wcb_emit) begin
+            wcb_out_addr_d = wcb_addr_d;
+            wcb_out_data_d = wcb_data_d;
+            wcb_out_strb_d = wcb_strb_d;
+            wcb_out_aw_d   = 1'b1;
+            wcb_out_w_d    = 1'b1;
+            wcb_valid_d    = 1'b0;
+            wcb_last_d     = 1'b0;
+          end
+          if (wcb_valid_d)
+            perf_st_merge_o = 1'b1;
+          else begin
+            wcb_addr_d = aligned_addr(axi_addrgen_req_i.addr, $clog2(AxiDataWidth/8));
+            wcb_strb_d = '0;
+          end
+          // Merge the active bytes of the element. A later element to the same bytes wins.
+          for (int b = 0; b < AxiDataWidth/8; b++)
+            if (beat.strb[b]) begin
+              wcb_data_d[8*b +: 8] = beat.data[8*b +: 8];
+              wcb_strb_d[b]        = 1'b1;
+            end
+          wcb_valid_d = 1'b1;
+        end else begin
+          // Send the W beat
+          axi_w_o       = beat;
+          axi_w_valid_o = 1'b1;
+        end
+        // Account for the beat we sent
+        len_d         = len_q + 1;
+        // We wrote all the beats for this AW burst
+        if ($unsigned(len_d) == axi_pkg::len_t'($unsigned(axi_addrgen_req_i.len) + 1)) begin
+          if (!axi_addrgen_req_i.combine) axi_w_o.last = 1'b1;
+          // Ask for another burst by the address generator
+          axi_addrgen_req_ready_o = 1'b1;
+          // Reset AXI pointers
+          len_d                   = '0;
+        end
 
-      // Send the W beat
-      axi_w_valid_o = 1'b1;
-      // Account for the beat we sent
-      len_d         = len_q + 1;
-      // We wrote all the beats for this AW burst
-      if ($unsigned(len_d) == axi_pkg::len_t'($unsigned(axi_addrgen_req_i.len) + 1)) begin
-        axi_w_o.last            = 1'b1;
-        // Ask for another burst by the address generator
-        axi_addrgen_req_ready_o = 1'b1;
-        // Reset AXI pointers
-        len_d                   = '0;
-      end
+        // We consumed a whole VRF word
+        if (realign_valid_q) begin
+          if (vrf_pnt_d >= NrLanes*8 || vrf_pnt_d == issue_cnt_q) begin
+            // Release the buffered word. The beat may have also taken the last bytes of the
+            // instruction from the word of the lanes.
+            realign_valid_d = 1'b0;
+            if (vrf_pnt_d == issue_cnt_q) begin
+              stu_operand_ready = vrf_pnt_d > NrLanes*8;
+              mask_ready_o      = vrf_pnt_d > NrLanes*8 && !vinsn_issue_q.vm;
+              vrf_pnt_d         = '0;
+              issue_cnt_d       = '0;
+            end else begin
+              vrf_pnt_d   = vrf_pnt_d - NrLanes*8;
+              issue_cnt_d = issue_cnt_q - NrLanes * 8;
+            end
+          end
+        end else if (vrf_pnt_d == NrLanes*8 || vrf_pnt_d == issue_cnt_q) begin
+          // Reset the pointer in the VRF word
+          vrf_pnt_d         = '0;
+          // Acknowledge the operands with the lanes
+          stu_operand_ready = '1;
+          // Acknowledge the mask operand
+          mask_ready_o      = !vinsn_issue_q.vm;
+          // Account for the results that were issued
+          issue_cnt_d       = issue_cnt_q - NrLanes * 8;
+          if (issue_cnt_q < NrLanes * 8)
+            issue_cnt_d = '0;
+        end
 
-      // We consumed a whole word from the lanes
-      if (vrf_pnt_d == NrLanes*8 || vrf_pnt_d == issue_cnt_q) begin
-        // Reset the pointer in the VRF word
-        vrf_pnt_d         = '0;
-        // Acknowledge the operands with the lanes
-        stu_operand_ready = '1;
-        // Acknowledge the mask operand
-        mask_ready_o      = !vinsn_issue_q.vm;
-        // Account for the results that were issued
-        issue_cnt_d       = issue_cnt_q - NrLanes * 8;
-        if (issue_cnt_q < NrLanes * 8)
-          issue_cnt_d = '0;
+        // The beat with the last element of the instruction goes out as soon as possible
+        if (axi_addrgen_req_i.combine && issue_cnt_d == '0) begin
+          wcb_last_d = 1'b1;
+          if (!wcb_out_aw_d && !wcb_out_w_d) begin
+            wcb_out_addr_d = wcb_addr_d;
+            wcb_out_data_d = wcb_data_d;
+            wcb_out_strb_d = wcb_strb_d;
+            wcb_out_aw_d   = 1'b1;
+            wcb_out_w_d    = 1'b1;
+            wcb_valid_d    = 1'b0;
+            wcb_last_d     = 1'b0;
+          end
+        end
       end
     end
 
+    // Keep the word of the lanes in the realignment buffer, so that the lanes send the next one
+    if (vinsn_issue_valid && issue_cnt_d != '0 && !realign_valid_d && !stu_operand_ready &&
+        &stu_operand_valid && (vinsn_issue_q.vm || (|mask_valid_i))) begin
+      realign_word_d    = stu_operand;
+      realign_mask_d    = mask_i;
+      realign_valid_d   = 1'b1;
+      stu_operand_ready = 1'b1;
+      mask_ready_o      = !vinsn_issue_q.vm;
+    end
+
     // Finished issuing W beats for this vector store
     if (vinsn_issue_valid && issue_cnt_d == 0) begin
       // Bump issue counters and pointers of the vector instruction queue
@@ -345,6 +548,21 @@ module vstu import ara_pkg::*; import rvv_pkg::*; #(
       len_q     <= '0;
       vrf_pnt_q <= '0;
 
+      realign_word_q  <= '0;
+      realign_mask_q  <= '0;
+      realign_valid_q <= 1'b0;
+
+      wcb_addr_q     <= '0;
+      wcb_data_q     <= '0;
+      wcb_strb_q     <= '0;
+      wcb_valid_q    <= 1'b0;
+      wcb_last_q     <= 1'b0;
+      wcb_out_addr_q <= '0;
+      wcb_out_data_q <= '0;
+      wcb_out_strb_q <= '0;
+      wcb_out_aw_q   <= 1'b0;
+      wcb_out_w_q    <= 1'b0;
+
       pe_resp_o <= '0;
     end else begin
       vinsn_running_q <= vinsn_running_d;
@@ -353,6 +571,21 @@ module vstu import ara_pkg::*; import rvv_pkg::*; #(
       len_q     <= len_d;
       vrf_pnt_q <= vrf_pnt_d;
 
+      realign_word_q  <= realign_word_d;
+      realign_mask_q  <= realign_mask_d;
+      realign_valid_q <= realign_valid_d;
+
+      wcb_addr_q     <= wcb_addr_d;
+      wcb_data_q     <= wcb_data_d;
+      wcb_strb_q     <= wcb_strb_d;
+      wcb_valid_q    <= wcb_valid_d;
+      wcb_last_q     <= wcb_last_d;
+      wcb_out_addr_q <= wcb_out_addr_d;
+      wcb_out_data_q <= wcb_out_data_d;
+      wcb_out_strb_q <= wcb_out_strb_d;
+      wcb_out_aw_q   <= wcb_out_aw_d;
+      wcb_out_w_q    <= wcb_out_w_d;
+
       pe_resp_o <= pe_resp;
     end
   end
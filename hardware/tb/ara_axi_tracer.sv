@@ -0,0 +1,105 @@
+// Copyright 2021 ETH Zurich and University of Bologna.
+// Solderpad Hardware License, Version 0.51, see LICENSE for details.
+// SPDX-License-Identifier: SHL-0.51
+//
+// Description:
+// Transaction trace of an AXI port. Every handshake on the AR, AW, R, W, and
+// B channels is sent to a DPI-C log (tb/dpi/axi_trace.cc), with the cycle and
+// the port it happened on, and so is every cycle in which a channel is valid
+// but not ready. scripts/axi_trace_plot.py derives the bandwidth, the stalls,
+// and the transactions in flight over time from it.
+// Compile with AXI_TRACE defined to enable it.
+
+import "DPI-C" function void axi_trace_open(input string filename, input byte unsigned port, input int unsigned data_bytes);
+import "DPI-C" function void axi_trace_event(input longint unsigned cycle, input byte unsigned port, input byte unsigned kind, input shortint unsigned id, input longint unsigned addr, input byte unsigned len, input byte unsigned info, input shortint unsigned bytes);
+import "DPI-C" function void axi_trace_close();
+
+module ara_axi_tracer #(
+    // Index of the traced port, see scripts/axi_trace_plot.py
+    parameter  int unsigned Port      = 0,
+    parameter  int unsigned DataBytes = 0,
+    // Default trace file, overridden by the +axi_trace=<file> plusarg
+    parameter  string       TraceFile = "axi_trace.bin"
+  ) (
+    input logic                 clk_i,
+    input logic                 rst_ni,
+    // AR channel
+    input logic                 ar_valid_i,
+    input logic                 ar_ready_i,
+    input logic [15:0]          ar_id_i,
+    input logic [63:0]          ar_addr_i,
+    input logic [7:0]           ar_len_i,
+    input logic [2:0]           ar_size_i,
+    // AW channel
+    input logic                 aw_valid_i,
+    input logic                 aw_ready_i,
+    input logic [15:0]          aw_id_i,
+    input logic [63:0]          aw_addr_i,
+    input logic [7:0]           aw_len_i,
+    input logic [2:0]           aw_size_i,
+    // W channel
+    input logic                 w_valid_i,
+    input logic                 w_ready_i,
+    input logic [DataBytes-1:0] w_strb_i,
+    input logic                 w_last_i,
+    // R channel
+    input logic                 r_valid_i,
+    input logic                 r_ready_i,
+    input logic [15:0]          r_id_i,
+    input logic                 r_last_i,
+    // B channel
+    input logic                 b_valid_i,
+    input logic                 b_ready_i,
+    input logic [15:0]          b_id_i,
+    input logic [1:0]           b_resp_i
+  );
+
+  // Event kinds, keep in sync with scripts/axi_trace_plot.py
+  typedef enum byte unsigned {
+    EvAR    = 0,
+    EvAW    = 1,
+    EvR     = 2,
+    EvW     = 3,
+    EvB     = 4,
+    // The info byte is the mask of the stalled channels, AR, AW, R, W, and B from the LSB
+    EvStall = 5
+  } axi_event_e;
+
+  logic [4:0] stall;
+  assign stall = {b_valid_i && !b_ready_i, w_valid_i && !w_ready_i, r_valid_i && !r_ready_i,
+                  aw_valid_i && !aw_ready_i, ar_valid_i && !ar_ready_i};
+
+  longint unsigned cycle;
+
+  initial begin
+    string trace_file;
+    if (!$value$plusargs("axi_trace=%s", trace_file))
+      trace_file = TraceFile;
+    axi_trace_open(trace_file, Port, DataBytes);
+  end
+  final axi_trace_close();
+
+  always_ff @(posedge clk_i or negedge rst_ni) begin
+    if (!rst_ni) begin
+      cycle <= '0;
+    end else begin
+      cycle <= cycle + 1;
+
+      // The info byte is the size of the AR and AW bursts, the last flag of the R and W beats,
+      // and the response of the B beats
+      if (ar_valid_i && ar_ready_i)
+        axi_trace_event(cycle, Port, EvAR, ar_id_i, ar_addr_i, ar_len_i, ar_size_i, '0);
+      if (aw_valid_i && aw_ready_i)
+        axi_trace_event(cycle, Port, EvAW, aw_id_i, aw_addr_i, aw_len_i, aw_size_i, '0);
+      if (r_valid_i && r_ready_i)
+        axi_trace_event(cycle, Port, EvR, r_id_i, '0, '0, r_last_i, '0);
+      if (w_valid_i && w_ready_i)
+        axi_trace_event(cycle, Port, EvW, '0, '0, '0, w_last_i, $countones(w_strb_i));
+      if (b_valid_i && b_ready_i)
+        axi_trace_event(cycle, Port, EvB, b_id_i, '0, '0, b_resp_i, '0);
+      if (stall != '0)
+        axi_trace_event(cycle, Port, EvStall, '0, '0, '0, stall, '0);
+    end
+  end
+
+endmodule : ara_axi_tracer
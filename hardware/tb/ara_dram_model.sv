@@ -0,0 +1,123 @@
+// Copyright 2022 ETH Zurich and University of Bologna.
+// Solderpad Hardware License, Version 0.51, see LICENSE for details.
+// SPDX-License-Identifier: SHL-0.51
+//
+// Description:
+// Timing model of a DRAM, between axi_to_mem and a port of the memory macro of the L2.
+// The macro answers one cycle after the grant, and this model delays the responses to
+// ReadLatency/WriteLatency cycles after the grant, in order. The requests are
+// granted at BytesPerCycle at most, spread over NumBanks banks interleaved at the
+// word granularity: each bank takes NumBanks words to serve BytesPerCycle bytes,
+// so a stream hitting a single bank gets 1/NumBanks of the bandwidth.
+// BytesPerCycle == 0 does not limit the bandwidth.
+
+`include "common_cells/registers.svh"
+
+module ara_dram_model #(
+    parameter  int unsigned AddrWidth     = 64,
+    parameter  int unsigned DataWidth     = 64,
+    parameter  int unsigned ReadLatency   = 1,
+    parameter  int unsigned WriteLatency  = 1,
+    parameter  int unsigned BytesPerCycle = 0,
+    parameter  int unsigned NumBanks      = 1,
+    // Requests in flight
+    parameter  int unsigned BufDepth      = 2,
+    // Dependant parameters. DO NOT CHANGE!
+    localparam int unsigned BankCycles    = (BytesPerCycle == 0) ? 1 :
+      (DataWidth / 8 * NumBanks + BytesPerCycle - 1) / BytesPerCycle
+  ) (
+    input  logic                 clk_i,
+    input  logic                 rst_ni,
+    // From axi_to_mem
+    input  logic                 req_i,
+    output logic                 gnt_o,
+    input  logic                 we_i,
+    input  logic [AddrWidth-1:0] addr_i,
+    output logic                 rvalid_o,
+    output logic [DataWidth-1:0] rdata_o,
+    // To the memory macro. The request is granted if mem_gnt_i and gnt_o.
+    output logic                 mem_req_o,
+    input  logic                 mem_gnt_i,
+    input  logic [DataWidth-1:0] mem_rdata_i
+  );
+
+  import cf_math_pkg::idx_width;
+
+  typedef logic [31:0] cycle_t;
+
+  // Current cycle
+  cycle_t cycle_q;
+  `FF(cycle_q, cycle_q + 1, '0)
+
+  // Has the cycle c been reached? This is wrap-safe.
+  function automatic logic reached(cycle_t now, cycle_t c);
+    reached = $signed(now - c) >= 0;
+  endfunction : reached
+
+  // First cycle in which each bank is free again
+  cycle_t [NumBanks-1:0] bank_free_d, bank_free_q;
+
+  // Responses, in the order of the requests
+  cycle_t [BufDepth-1:0]                  resp_due_d, resp_due_q;
+  logic   [BufDepth-1:0][DataWidth-1:0]   resp_data_d, resp_data_q;
+  logic   [idx_width(BufDepth)-1:0]       resp_wpnt_d, resp_wpnt_q;
+  logic   [idx_width(BufDepth)-1:0]       resp_rpnt_d, resp_rpnt_q;
+  logic   [idx_width(BufDepth+1)-1:0]     resp_cnt_d, resp_cnt_q;
+
+  // The memory macro answers one cycle after the grant, for this response
+  logic                                   mem_rvalid_q;
+  logic   [idx_width(BufDepth)-1:0]       mem_rpnt_q;
+
+  always_comb begin: p_dram_model
+    automatic int unsigned bank = (addr_i >> $clog2(DataWidth/8)) % NumBanks;
+
+    bank_free_d = bank_free_q;
+    resp_due_d  = resp_due_q;
+    resp_data_d = resp_data_q;
+    resp_wpnt_d = resp_wpnt_q;
+    resp_rpnt_d = resp_rpnt_q;
+    resp_cnt_d  = resp_cnt_q;
+
+    // Request the macro if the bank is free and the response has a place
+    mem_req_o = req_i && resp_cnt_q != BufDepth && reached(cycle_q, bank_free_q[bank]);
+    gnt_o     = mem_req_o && mem_gnt_i;
+
+    // Store the data of the macro
+    if (mem_rvalid_q)
+      resp_data_d[mem_rpnt_q] = mem_rdata_i;
+
+    // Answer in order, once the latency elapsed. The data from the macro is forwarded right away.
+    rvalid_o = resp_cnt_q != '0 && reached(cycle_q, resp_due_q[resp_rpnt_q]);
+    rdata_o  = (mem_rvalid_q && mem_rpnt_q == resp_rpnt_q) ? mem_rdata_i : resp_data_q[resp_rpnt_q];
+    if (rvalid_o) begin
+      resp_rpnt_d = (resp_rpnt_q == BufDepth-1) ? '0 : resp_rpnt_q + 1;
+      resp_cnt_d -= 1;
+    end
+
+    if (gnt_o) begin
+      bank_free_d[bank]       = cycle_q + BankCycles;
+      resp_due_d[resp_wpnt_q] = cycle_q + (we_i ? WriteLatency : ReadLatency);
+      resp_wpnt_d             = (resp_wpnt_q == BufDepth-1) ? '0 : resp_wpnt_q + 1;
+      resp_cnt_d += 1;
+    end
+  end: p_dram_model
+
+  `FF(bank_free_q, bank_free_d, '0)
+  `FF(resp_due_q, resp_due_d, '0)
+  `FF(resp_data_q, resp_data_d, '0)
+  `FF(resp_wpnt_q, resp_wpnt_d, '0)
+  `FF(resp_rpnt_q, resp_rpnt_d, '0)
+  `FF(resp_cnt_q, resp_cnt_d, '0)
+  `FF(mem_rvalid_q, gnt_o, 1'b0)
+  `FF(mem_rpnt_q, resp_wpnt_q, '0)
+
+  if (ReadLatency == 0 || WriteLatency == 0)
+    $error("[ara_dram_model] The latencies must be at least one cycle.");
+
+  if (NumBanks == 0)
+    $error("[ara_dram_model] There must be at least one bank.");
+
+  if (BufDepth < 1)
+    $error("[ara_dram_model] At least one request must be in flight.");
+
+endmodule : ara_dram_model
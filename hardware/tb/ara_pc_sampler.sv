@@ -0,0 +1,98 @@
+// Copyright 2021 ETH Zurich and University of Bologna.
+// Solderpad Hardware License, Version 0.51, see LICENSE for details.
+// SPDX-License-Identifier: SHL-0.51
+//
+// Description:
+// Sampling profile of CVA6. Every Period cycles, it samples the PC of the
+// instruction in CVA6's commit stage, and why CVA6 waits, if it does:
+//   - Ara does not accept its request (Ara full)
+//   - an instruction sent to Ara has not been answered yet
+//   - a read of the data cache is in flight on the narrow AXI port
+// The samples are counted by a DPI-C histogram (tb/dpi/pc_sample.cc), which
+// scripts/pc_report.py symbolizes with the disassembly of the binary.
+// Compile with PC_SAMPLE defined to enable it.
+
+import "DPI-C" function void pc_sample_open(input string filename, input int unsigned period);
+import "DPI-C" function void pc_sample(input longint unsigned pc, input byte unsigned cause);
+import "DPI-C" function void pc_sample_close();
+
+module ara_pc_sampler #(
+    // Default cycles between two samples, overridden by the +pc_sample_period=<N> plusarg. A prime
+    // number, so that the samples do not follow the period of a loop.
+    parameter int unsigned Period     = 97,
+    // Default sample file, overridden by the +pc_sample=<file> plusarg
+    parameter string       SampleFile = "pc_sample.txt",
+    // Maximum number of reads of the narrow port in flight
+    parameter int unsigned MaxReads   = 256
+  ) (
+    input logic        clk_i,
+    input logic        rst_ni,
+    // PC of the instruction in CVA6's commit stage
+    input logic [63:0] pc_i,
+    // Accelerator interface
+    input logic        acc_req_valid_i,
+    input logic        acc_req_ready_i,
+    input logic        acc_resp_valid_i,
+    input logic        acc_resp_ready_i,
+    // Reads of CVA6's narrow AXI port
+    input logic        ar_valid_i,
+    input logic        ar_ready_i,
+    input logic        r_valid_i,
+    input logic        r_ready_i,
+    input logic        r_last_i
+  );
+
+  // Causes, keep in sync with scripts/pc_report.py
+  typedef enum byte unsigned {
+    CauseNone    = 0,
+    CauseAraFull = 1,
+    CauseAccResp = 2,
+    CauseDCache  = 3
+  } pc_sample_cause_e;
+
+  int unsigned period;
+  int unsigned count_q;
+  // Requests of CVA6 not answered by Ara, reads of the narrow port in flight
+  int unsigned acc_pend_q;
+  logic [$clog2(MaxReads+1)-1:0] rd_pend_q;
+
+  pc_sample_cause_e cause;
+
+  always_comb begin
+    cause = CauseNone;
+    if (rd_pend_q != '0)
+      cause = CauseDCache;
+    if (acc_pend_q != 0)
+      cause = CauseAccResp;
+    if (acc_req_valid_i && !acc_req_ready_i)
+      cause = CauseAraFull;
+  end
+
+  initial begin
+    string sample_file;
+    if (!$value$plusargs("pc_sample=%s", sample_file))
+      sample_file = SampleFile;
+    if (!$value$plusargs("pc_sample_period=%d", period) || period == 0)
+      period = Period;
+    pc_sample_open(sample_file, period);
+  end
+  final pc_sample_close();
+
+  always_ff @(posedge clk_i or negedge rst_ni) begin
+    if (!rst_ni) begin
+      count_q    <= 0;
+      acc_pend_q <= 0;
+      rd_pend_q  <= '0;
+    end else begin
+      count_q <= count_q == period - 1 ? 0 : count_q + 1;
+      if (count_q == period - 1)
+        pc_sample(pc_i, cause);
+
+      acc_pend_q <= acc_pend_q + (acc_req_valid_i && acc_req_ready_i) -
+        (acc_resp_valid_i && acc_resp_ready_i && acc_pend_q != 0);
+      rd_pend_q  <= rd_pend_q + (ar_valid_i && ar_ready_i) -
+        (r_valid_i && r_ready_i && r_last_i && rd_pend_q != '0);
+    end
+  end
+
+endmodule : ara_pc_sampler
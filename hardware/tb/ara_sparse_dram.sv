@@ -0,0 +1,58 @@
+// Copyright 2021 ETH Zurich and University of Bologna.
+// Solderpad Hardware License, Version 0.51, see LICENSE for details.
+// SPDX-License-Identifier: SHL-0.51
+//
+// Description:
+// Verilator-only replacement of the tc_sram of the DRAM. The memory content
+// lives in a sparse C++ store (tb/verilator/sparse_mem.cc), allocated in 4 KiB
+// pages on first touch, instead of in a dense verilated array. The interface
+// and the one-cycle read latency are the ones of tc_sram. The DPI-C words are
+// 2048 bits wide, the AXI data width of 64 lanes.
+
+import "DPI-C" context function chandle sparse_mem_open(input longint unsigned size_byte, input int unsigned width_byte);
+import "DPI-C" function void sparse_mem_read(input chandle mem, input longint unsigned index, output bit [2047:0] data);
+import "DPI-C" function void sparse_mem_write(input chandle mem, input longint unsigned index, input bit [2047:0] data, input bit [255:0] strb);
+import "DPI-C" context function void sparse_mem_close(input chandle mem);
+
+module ara_sparse_dram #(
+    parameter  int unsigned NumWords  = 32'd1024,
+    parameter  int unsigned NumPorts  = 32'd1,
+    parameter  int unsigned DataWidth = 32'd128,
+    // Dependant parameters. DO NOT CHANGE!
+    localparam int unsigned AddrWidth = (NumWords > 32'd1) ? $clog2(NumWords) : 32'd1,
+    localparam int unsigned BeWidth   = DataWidth / 8
+  ) (
+    input  logic                               clk_i,
+    input  logic                               rst_ni,
+    input  logic [NumPorts-1:0]                req_i,
+    input  logic [NumPorts-1:0]                we_i,
+    input  logic [NumPorts-1:0][AddrWidth-1:0] addr_i,
+    input  logic [NumPorts-1:0][DataWidth-1:0] wdata_i,
+    input  logic [NumPorts-1:0][BeWidth-1:0]   be_i,
+    output logic [NumPorts-1:0][DataWidth-1:0] rdata_o
+  );
+
+  chandle mem;
+
+  initial mem = sparse_mem_open(longint'(NumWords) * BeWidth, BeWidth);
+  final sparse_mem_close(mem);
+
+  // As tc_sram, the ports are served in order within a cycle
+  always_ff @(posedge clk_i) begin
+    for (int unsigned p = 0; p < NumPorts; p++) begin
+      automatic bit [2047:0] rdata;
+      if (req_i[p]) begin
+        if (we_i[p])
+          sparse_mem_write(mem, addr_i[p], 2048'(wdata_i[p]), 256'(be_i[p]));
+        else begin
+          sparse_mem_read(mem, addr_i[p], rdata);
+          rdata_o[p] <= rdata[DataWidth-1:0];
+        end
+      end
+    end
+  end
+
+  if (DataWidth > 2048)
+    $error("[ara_sparse_dram] The data width cannot be wider than 2048 bits.");
+
+endmodule : ara_sparse_dram
@@ -6,9 +6,9 @@
 // Description:
 // Top level testbench module.
 
-import "DPI-C" function void read_elf (input string filename);
-import "DPI-C" function byte get_section (output longint address, output longint len);
-import "DPI-C" context function byte read_section(input longint address, inout byte buffer[]);
+import "DPI-C" function void result_dump_open(input string filename, input int unsigned bus_bytes);
+import "DPI-C" function void result_dump_beat(input longint unsigned addr, input longint unsigned strb, input bit [511:0] data);
+import "DPI-C" function void result_dump_close();
 
 `define STRINGIFY(x) `"x`"
 
@@ -29,6 +29,42 @@ module ara_tb;
   localparam NrLanes = 0;
   `endif
 
+  `ifdef NR_CORES
+  localparam int unsigned NrCores = `NR_CORES;
+  `else
+  localparam int unsigned NrCores = 1;
+  `endif
+
+  `ifdef DRAM_SIZE
+  localparam int unsigned DramSize = `DRAM_SIZE;
+  `else
+  localparam int unsigned DramSize = 32'h0200_0000;
+  `endif
+
+  `ifdef DRAM_RD_LATENCY
+  localparam int unsigned DramRdLatency = `DRAM_RD_LATENCY;
+  `else
+  localparam int unsigned DramRdLatency = 1;
+  `endif
+
+  `ifdef DRAM_WR_LATENCY
+  localparam int unsigned DramWrLatency = `DRAM_WR_LATENCY;
+  `else
+  localparam int unsigned DramWrLatency = 1;
+  `endif
+
+  `ifdef DRAM_BW
+  localparam int unsigned DramBytesPerCycle = `DRAM_BW;
+  `else
+  localparam int unsigned DramBytesPerCycle = 0;
+  `endif
+
+  `ifdef DRAM_BANKS
+  localparam int unsigned DramNumBanks = `DRAM_BANKS;
+  `else
+  localparam int unsigned DramNumBanks = 8;
+  `endif
+
   localparam ClockPeriod  = 1ns;
   // Axi response delay [ps]
   localparam int unsigned AxiRespDelay = 200;
@@ -78,13 +114,20 @@ module ara_tb;
   `ifndef VERILATOR
   ara_testharness #(
     .NrLanes     (NrLanes         ),
+    .NrCores     (NrCores         ),
     .AxiAddrWidth(AxiAddrWidth    ),
     .AxiDataWidth(AxiWideDataWidth),
-    .AxiRespDelay(AxiRespDelay    )
+    .AxiRespDelay(AxiRespDelay    ),
+    .DramSize    (DramSize        ),
+    .DramRdLatency    (DramRdLatency    ),
+    .DramWrLatency    (DramWrLatency    ),
+    .DramBytesPerCycle(DramBytesPerCycle),
+    .DramNumBanks     (DramNumBanks     )
   ) dut (
-    .clk_i (clk  ),
-    .rst_ni(rst_n),
-    .exit_o(exit )
+    .clk_i          (clk         ),
+    .rst_ni         (rst_n       ),
+    .exit_o         (exit        ),
+    .event_trigger_o(/* Unused */)
   );
   `endif
 
@@ -95,11 +138,13 @@ module ara_tb;
   typedef logic [AxiAddrWidth-1:0] addr_t;
   typedef logic [AxiWideDataWidth-1:0] data_t;
 
+  // Preload of the ELF segments into whole rows of the init image of the DRAM
+  // (tb/dpi/dram_preload.cc). Returns the bytes outside the image, or -1.
+  import "DPI-C" function longint dram_preload(input string filename, input longint base,
+    input int unsigned row_bytes, inout data_t image []);
+
   initial begin : dram_init
-    automatic data_t mem_row;
-    byte buffer [];
-    addr_t address;
-    addr_t length;
+    longint outside;
     string binary;
 
     // tc_sram is initialized with zeros. We need to overwrite this value.
@@ -109,29 +154,14 @@ module ara_tb;
     // Initialize memories
     void'($value$plusargs("PRELOAD=%s", binary));
     if (binary != "") begin
-      // Read ELF
-      read_elf(binary);
+      // Write the sections of the ELF to the memory, a row at a time
       $display("Loading ELF file %s", binary);
-      while (get_section(address, length)) begin
-        // Read sections
-        automatic int nwords = (length + AxiWideBeWidth - 1)/AxiWideBeWidth;
-        $display("Loading section %x of length %x", address, length);
-        buffer = new[nwords * AxiWideBeWidth];
-        void'(read_section(address, buffer));
-        // Initializing memories
-        for (int w = 0; w < nwords; w++) begin
-          mem_row = '0;
-          for (int b = 0; b < AxiWideBeWidth; b++) begin
-            mem_row[8 * b +: 8] = buffer[w * AxiWideBeWidth + b];
-          end
-          if (address >= DRAMAddrBase && address < DRAMAddrBase + DRAMLength)
-            // This requires the sections to be aligned to AxiWideByteOffset,
-            // otherwise, they can be over-written.
-            dut.i_ara_soc.i_dram.init_val[(address - DRAMAddrBase + (w << AxiWideByteOffset)) >> AxiWideByteOffset] = mem_row;
-          else
-            $display("Cannot initialize address %x, which doesn't fall into the L2 region.", address);
-        end
-      end
+      outside = dram_preload(binary, DRAMAddrBase, AxiWideBeWidth, dut.i_ara_soc.i_dram.init_val);
+      if (outside < 0) begin
+        $error("Cannot load the ELF file %s!", binary);
+        $finish;
+      end else if (outside > 0)
+        $display("Cannot initialize %0d bytes, which don't fall into the L2 region.", outside);
     end else begin
       $error("Expecting a firmware to run, none was provided!");
       $finish;
@@ -144,33 +174,43 @@ module ara_tb;
    *  PRINT STORED VALUES  *
    *************************/
 
-  // This is useful to check that the ideal dispatcher simulation was correct
+  // This is useful to check that the ideal dispatcher simulation was correct.
+  // The W beats are dumped in binary form (address, strobe, data) by a DPI-C
+  // sink, and can be compared with scripts/compare_results.py.
 
 `ifndef IDEAL_DISPATCHER
-  localparam OutResultFile = "../gold_results.txt";
+  localparam OutResultFile = "../gold_results.bin";
 `else
-  localparam OutResultFile = "../id_results.txt";
+  localparam OutResultFile = "../id_results.bin";
 `endif
 
-  int fd;
-
   data_t                     ara_w;
   logic [AxiWideBeWidth-1:0] ara_w_strb;
   logic                      ara_w_valid;
   logic                      ara_w_ready;
+  logic                      ara_w_last;
+  addr_t                     ara_aw_addr;
+  logic [2:0]                ara_aw_size;
+  logic                      ara_aw_valid;
+  logic                      ara_aw_ready;
 
   // Avoid dumping what it's not measured, e.g. cache warming
   logic dump_en_mask;
 
   initial begin
-    fd = $fopen(OutResultFile, "w");
+    result_dump_open(OutResultFile, AxiWideBeWidth);
     $display("Dump results on %s", OutResultFile);
   end
 
-  assign ara_w       = dut.i_ara_soc.i_system.i_ara.i_vlsu.axi_req.w.data;
-  assign ara_w_strb  = dut.i_ara_soc.i_system.i_ara.i_vlsu.axi_req.w.strb;
-  assign ara_w_valid = dut.i_ara_soc.i_system.i_ara.i_vlsu.axi_req.w_valid;
-  assign ara_w_ready = dut.i_ara_soc.i_system.i_ara.i_vlsu.axi_resp.w_ready;
+  assign ara_w        = dut.i_ara_soc.gen_systems[0].i_system.i_ara.i_vlsu.axi_req.w.data;
+  assign ara_w_strb   = dut.i_ara_soc.gen_systems[0].i_system.i_ara.i_vlsu.axi_req.w.strb;
+  assign ara_w_last   = dut.i_ara_soc.gen_systems[0].i_system.i_ara.i_vlsu.axi_req.w.last;
+  assign ara_w_valid  = dut.i_ara_soc.gen_systems[0].i_system.i_ara.i_vlsu.axi_req.w_valid;
+  assign ara_w_ready  = dut.i_ara_soc.gen_systems[0].i_system.i_ara.i_vlsu.axi_resp.w_ready;
+  assign ara_aw_addr  = dut.i_ara_soc.gen_systems[0].i_system.i_ara.i_vlsu.axi_req.aw.addr;
+  assign ara_aw_size  = dut.i_ara_soc.gen_systems[0].i_system.i_ara.i_vlsu.axi_req.aw.size;
+  assign ara_aw_valid = dut.i_ara_soc.gen_systems[0].i_system.i_ara.i_vlsu.axi_req.aw_valid;
+  assign ara_aw_ready = dut.i_ara_soc.gen_systems[0].i_system.i_ara.i_vlsu.axi_resp.aw_ready;
 
 `ifndef IDEAL_DISPATCHER
   assign dump_en_mask = dut.i_ara_soc.hw_cnt_en_o[0];
@@ -178,12 +218,41 @@ module ara_tb;
   // Ideal-Dispatcher system does not warm the scalar cache
   assign dump_en_mask = 1'b1;
 `endif
-  always_ff @(posedge clk)
-    if (dump_en_mask)
-      if (ara_w_valid && ara_w_ready)
-        for (int b = 0; b < AxiWideBeWidth; b++)
-          if (ara_w_strb[b])
-            $fdisplay(fd, "%0x", ara_w[b*8 +: 8]);
+
+  // Write bursts whose beats have not been dumped yet
+  typedef struct {
+    addr_t       addr;
+    logic [2:0]  size;
+  } w_burst_t;
+
+  w_burst_t    w_bursts [$];
+  int unsigned w_beat_cnt = 0;
+
+  always @(posedge clk) begin
+    automatic addr_t beat_addr = '1;
+
+    if (ara_aw_valid && ara_aw_ready)
+      w_bursts.push_back('{addr: ara_aw_addr, size: ara_aw_size});
+
+    if (ara_w_valid && ara_w_ready) begin
+      // INCR bursts: the beats after the first one are aligned to the size.
+      // The address is unknown ('1) if the beat precedes its AW.
+      if (w_bursts.size() != 0) begin
+        beat_addr = ((w_bursts[0].addr >> w_bursts[0].size) + w_beat_cnt) << w_bursts[0].size;
+        beat_addr = (beat_addr >> AxiWideByteOffset) << AxiWideByteOffset;
+      end
+
+      if (dump_en_mask)
+        result_dump_beat(beat_addr, 64'(ara_w_strb), 512'(ara_w));
+
+      w_beat_cnt++;
+      if (ara_w_last) begin
+        w_beat_cnt = 0;
+        if (w_bursts.size() != 0)
+          void'(w_bursts.pop_front());
+      end
+    end
+  end
 
 `endif
 
@@ -204,7 +273,7 @@ module ara_tb;
       end
 
 `ifndef TARGET_GATESIM
-      $fclose(fd);
+      result_dump_close();
 `endif
       $finish(exit >> 1);
     end
@@ -254,7 +323,7 @@ module ara_tb;
   initial begin
     @(start_dump_event);
     $dumpfile(vcd_path);
-    $dumpvars(0, dut.i_ara_soc.i_system);
+    $dumpvars(0, dut.i_ara_soc.gen_systems[0].i_system);
     $dumpon;
 
     #1 $display("[TB - VCD] DUMPING...\n");
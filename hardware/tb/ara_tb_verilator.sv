@@ -7,11 +7,21 @@
 // Description: Top level testbench module for Verilator.
 
 module ara_tb_verilator #(
-    parameter int unsigned NrLanes = 0
+    parameter int unsigned NrLanes  = 0,
+    // Number of systems (CVA6 + Ara) sharing the main memory
+    parameter int unsigned NrCores  = 1,
+    // Size of the main memory (in bytes)
+    parameter int unsigned DramSize    = 32'h0200_0000,
+    // Timing of the main memory
+    parameter int unsigned DramRdLatency     = 1,
+    parameter int unsigned DramWrLatency     = 1,
+    parameter int unsigned DramBytesPerCycle = 0,
+    parameter int unsigned DramNumBanks      = 8
   )(
     input  logic        clk_i,
     input  logic        rst_ni,
-    output logic [63:0] exit_o
+    output logic [63:0] exit_o,
+    output logic [63:0] event_trigger_o
   );
 
   /*****************
@@ -27,12 +37,19 @@ module ara_tb_verilator #(
 
   ara_testharness #(
     .NrLanes     (NrLanes         ),
+    .NrCores     (NrCores         ),
     .AxiAddrWidth(AxiAddrWidth    ),
-    .AxiDataWidth(AxiWideDataWidth)
+    .AxiDataWidth(AxiWideDataWidth),
+    .DramSize    (DramSize        ),
+    .DramRdLatency    (DramRdLatency    ),
+    .DramWrLatency    (DramWrLatency    ),
+    .DramBytesPerCycle(DramBytesPerCycle),
+    .DramNumBanks     (DramNumBanks     )
   ) dut (
-    .clk_i (clk_i ),
-    .rst_ni(rst_ni),
-    .exit_o(exit_o)
+    .clk_i          (clk_i          ),
+    .rst_ni         (rst_ni         ),
+    .exit_o         (exit_o         ),
+    .event_trigger_o(event_trigger_o)
   );
 
   /*********
@@ -10,17 +10,28 @@
 module ara_testharness #(
     // Ara-specific parameters
     parameter int unsigned NrLanes      = 0,
+    // Number of systems (CVA6 + Ara) sharing the main memory
+    parameter int unsigned NrCores      = 1,
     // AXI Parameters
     parameter int unsigned AxiUserWidth = 1,
-    parameter int unsigned AxiIdWidth   = 5,
+    parameter int unsigned AxiIdWidth   = 5 + $clog2(NrCores + 1),
     parameter int unsigned AxiAddrWidth = 64,
     parameter int unsigned AxiDataWidth = 64*NrLanes/2,
     // AXI Resp Delay [ps] for gate-level simulation
-    parameter int unsigned AxiRespDelay = 200
+    parameter int unsigned AxiRespDelay = 200,
+    // Size of the main memory (in bytes)
+    parameter int unsigned DramSize     = 32'h0200_0000,
+    // Timing of the main memory: latencies (in cycles), bandwidth (in bytes per cycle,
+    // 0 for the full AXI width), and number of banks
+    parameter int unsigned DramRdLatency     = 1,
+    parameter int unsigned DramWrLatency     = 1,
+    parameter int unsigned DramBytesPerCycle = 0,
+    parameter int unsigned DramNumBanks      = 8
   ) (
     input  logic        clk_i,
     input  logic        rst_ni,
-    output logic [63:0] exit_o
+    output logic [63:0] exit_o,
+    output logic [63:0] event_trigger_o
   );
 
   `include "axi/typedef.svh"
@@ -67,11 +78,17 @@ module ara_testharness #(
 
   ara_soc #(
     .NrLanes     (NrLanes      ),
+    .NrCores     (NrCores      ),
     .AxiAddrWidth(AxiAddrWidth ),
     .AxiDataWidth(AxiDataWidth ),
     .AxiIdWidth  (AxiIdWidth   ),
     .AxiUserWidth(AxiUserWidth ),
-    .AxiRespDelay(AxiRespDelay )
+    .AxiRespDelay(AxiRespDelay ),
+    .L2NumWords  (DramSize / (AxiDataWidth/8)),
+    .L2ReadLatency  (DramRdLatency    ),
+    .L2WriteLatency (DramWrLatency    ),
+    .L2BytesPerCycle(DramBytesPerCycle),
+    .L2NumBanks     (DramNumBanks     )
   ) i_ara_soc (
     .clk_i         (clk_i       ),
     .rst_ni        (rst_ni      ),
@@ -91,6 +108,13 @@ module ara_testharness #(
     .uart_pslverr_i(uart_pslverr)
   );
 
+  // Expose the SW event trigger to the testbench
+`ifndef TARGET_GATESIM
+  assign event_trigger_o = i_ara_soc.i_ctrl_registers.event_trigger_o;
+`else
+  assign event_trigger_o = '0;
+`endif
+
   /**********
    *  UART  *
    **********/
@@ -153,11 +177,11 @@ module ara_testharness #(
     // If disabled
     if (!runtime_cnt_en_q)
       // Start only if the software allowed the enable and we detect the first V instruction
-      runtime_cnt_en_d = i_ara_soc.i_system.i_ara.acc_req_valid_i & cnt_en_mask;
+      runtime_cnt_en_d = i_ara_soc.gen_systems[0].i_system.i_ara.acc_req_valid_i & cnt_en_mask;
     // If enabled
     if (runtime_cnt_en_q)
       // Stop counting only if the software disabled the counter and Ara returned idle
-      runtime_cnt_en_d = cnt_en_mask | ~i_ara_soc.i_system.i_ara.ara_idle;
+      runtime_cnt_en_d = cnt_en_mask | ~i_ara_soc.gen_systems[0].i_system.i_ara.ara_idle;
   end
 
   // Vector runtime counter
@@ -177,14 +201,14 @@ module ara_testharness #(
     runtime_to_be_updated_d = runtime_to_be_updated_q;
 
     // Assert the update flag upon a new valid vector instruction
-    if (!runtime_to_be_updated_q && i_ara_soc.i_system.i_ara.acc_req_valid_i) begin
+    if (!runtime_to_be_updated_q && i_ara_soc.gen_systems[0].i_system.i_ara.acc_req_valid_i) begin
       runtime_to_be_updated_d = 1'b1;
     end
 
     // Update the internal runtime and reset the update flag
     if (runtime_to_be_updated_q           &&
-        i_ara_soc.i_system.i_ara.ara_idle &&
-        !i_ara_soc.i_system.i_ara.acc_req_valid_i) begin
+        i_ara_soc.gen_systems[0].i_system.i_ara.ara_idle &&
+        !i_ara_soc.gen_systems[0].i_system.i_ara.acc_req_valid_i) begin
       runtime_buf_d = runtime_cnt_q;
       runtime_to_be_updated_d = 1'b0;
     end
@@ -204,5 +228,242 @@ module ara_testharness #(
     end
   end
 
+  // Performance events during the runtime measurement, printed at the end of the simulation
+  // for scripts/bottleneck_report.py. Unlike the counters of ctrl_registers, they do not need
+  // the software, so they are available with the ideal dispatcher too.
+  logic [ara_pkg::NrPerfEvents-1:0][63:0] runtime_perf_cnt_q;
+
+  always_ff @(posedge clk_i or negedge rst_ni) begin
+    if (!rst_ni) begin
+      runtime_perf_cnt_q <= '0;
+    end else if (runtime_cnt_en_q) begin
+      for (int unsigned e = 0; e < ara_pkg::NrPerfEvents; e++)
+        if (i_ara_soc.perf_events[e]) runtime_perf_cnt_q[e] <= runtime_perf_cnt_q[e] + 1;
+    end
+  end
+
+  // One counter per field of perf_events_t, starting from bit 0
+  final begin
+    automatic string cnts = "";
+    for (int unsigned e = 0; e < ara_pkg::NrPerfEvents; e++)
+      cnts = $sformatf("%s %0d", cnts, runtime_perf_cnt_q[e]);
+    $display("[perf-cnt]:%s", cnts);
+  end
+
+  /*******************
+   *  TRACE RECORDS  *
+   *******************/
+
+  // Print the (tag, value) records written by the software to the trace registers of
+  // ctrl_registers, see apps/common/trace.h. The values of a record with the TraceMore bit
+  // set in the tag are printed on the line of the next record.
+  localparam int unsigned TraceMore = 8;
+
+  function automatic string trace_name(logic [7:0] kind);
+    case (kind)
+      8'd1:    return "sw-cycles";
+      8'd2:    return "sw-cycles-stats";
+      8'd3:    return "check-errors";
+      8'd4:    return "check-mismatch";
+      8'd5:    return "prof";
+      default: return $sformatf("trace-%0d", kind);
+    endcase
+  endfunction
+
+  string trace_line = "";
+
+  always @(posedge clk_i) begin
+    if (rst_ni && i_ara_soc.i_ctrl_registers.trace_valid_o) begin
+      trace_line = $sformatf("%s %0d", trace_line,
+        $signed(i_ara_soc.i_ctrl_registers.trace_value_o));
+      if (!i_ara_soc.i_ctrl_registers.trace_tag_o[TraceMore]) begin
+        $display("[%s]:%s", trace_name(i_ara_soc.i_ctrl_registers.trace_tag_o[7:0]), trace_line);
+        trace_line = "";
+      end
+    end
+  end
+
+`ifdef VINSN_TRACE
+
+  /******************
+   *  VINSN_TRACE  *
+   ******************/
+
+  // The trace file can be chosen with +vinsn_trace=<file>
+  ara_vinsn_tracer #(
+    .NrLanes(NrLanes)
+  ) i_vinsn_tracer (
+    .clk_i          (clk_i                                               ),
+    .rst_ni         (rst_ni                                              ),
+    .ara_req_new_i  (i_ara_soc.gen_systems[0].i_system.i_ara.i_sequencer.accepted_insn  ),
+    .ara_req_op_i   (i_ara_soc.gen_systems[0].i_system.i_ara.ara_req_phys.op            ),
+    .pe_req_i       (i_ara_soc.gen_systems[0].i_system.i_ara.pe_req                     ),
+    .pe_req_valid_i (i_ara_soc.gen_systems[0].i_system.i_ara.pe_req_valid               ),
+    .pe_req_ready_i (i_ara_soc.gen_systems[0].i_system.i_ara.pe_req_ready               ),
+    .pe_resp_i      (i_ara_soc.gen_systems[0].i_system.i_ara.pe_resp                    )
+  );
+
+`endif
+
+`ifdef AXI_TRACE
+
+  /***************
+   *  AXI_TRACE  *
+   ***************/
+
+  // The trace file can be chosen with +axi_trace=<file>
+  // Ara's VLSU
+  ara_axi_tracer #(
+    .Port     (0),
+    .DataBytes(AxiDataWidth/8)
+  ) i_ara_axi_tracer (
+    .clk_i      (clk_i                                                           ),
+    .rst_ni     (rst_ni                                                          ),
+    .ar_valid_i (i_ara_soc.gen_systems[0].i_system.i_ara.i_vlsu.axi_req.ar_valid ),
+    .ar_ready_i (i_ara_soc.gen_systems[0].i_system.i_ara.i_vlsu.axi_resp.ar_ready),
+    .ar_id_i    (i_ara_soc.gen_systems[0].i_system.i_ara.i_vlsu.axi_req.ar.id    ),
+    .ar_addr_i  (i_ara_soc.gen_systems[0].i_system.i_ara.i_vlsu.axi_req.ar.addr  ),
+    .ar_len_i   (i_ara_soc.gen_systems[0].i_system.i_ara.i_vlsu.axi_req.ar.len   ),
+    .ar_size_i  (i_ara_soc.gen_systems[0].i_system.i_ara.i_vlsu.axi_req.ar.size  ),
+    .aw_valid_i (i_ara_soc.gen_systems[0].i_system.i_ara.i_vlsu.axi_req.aw_valid ),
+    .aw_ready_i (i_ara_soc.gen_systems[0].i_system.i_ara.i_vlsu.axi_resp.aw_ready),
+    .aw_id_i    (i_ara_soc.gen_systems[0].i_system.i_ara.i_vlsu.axi_req.aw.id    ),
+    .aw_addr_i  (i_ara_soc.gen_systems[0].i_system.i_ara.i_vlsu.axi_req.aw.addr  ),
+    .aw_len_i   (i_ara_soc.gen_systems[0].i_system.i_ara.i_vlsu.axi_req.aw.len   ),
+    .aw_size_i  (i_ara_soc.gen_systems[0].i_system.i_ara.i_vlsu.axi_req.aw.size  ),
+    .w_valid_i  (i_ara_soc.gen_systems[0].i_system.i_ara.i_vlsu.axi_req.w_valid  ),
+    .w_ready_i  (i_ara_soc.gen_systems[0].i_system.i_ara.i_vlsu.axi_resp.w_ready ),
+    .w_strb_i   (i_ara_soc.gen_systems[0].i_system.i_ara.i_vlsu.axi_req.w.strb   ),
+    .w_last_i   (i_ara_soc.gen_systems[0].i_system.i_ara.i_vlsu.axi_req.w.last   ),
+    .r_valid_i  (i_ara_soc.gen_systems[0].i_system.i_ara.i_vlsu.axi_resp.r_valid ),
+    .r_ready_i  (i_ara_soc.gen_systems[0].i_system.i_ara.i_vlsu.axi_req.r_ready  ),
+    .r_id_i     (i_ara_soc.gen_systems[0].i_system.i_ara.i_vlsu.axi_resp.r.id    ),
+    .r_last_i   (i_ara_soc.gen_systems[0].i_system.i_ara.i_vlsu.axi_resp.r.last  ),
+    .b_valid_i  (i_ara_soc.gen_systems[0].i_system.i_ara.i_vlsu.axi_resp.b_valid ),
+    .b_ready_i  (i_ara_soc.gen_systems[0].i_system.i_ara.i_vlsu.axi_req.b_ready  ),
+    .b_id_i     (i_ara_soc.gen_systems[0].i_system.i_ara.i_vlsu.axi_resp.b.id    ),
+    .b_resp_i   (i_ara_soc.gen_systems[0].i_system.i_ara.i_vlsu.axi_resp.b.resp  )
+  );
+
+  // CVA6's narrow port, before its data width converter
+  ara_axi_tracer #(
+    .Port     (1),
+    .DataBytes(8)
+  ) i_cva6_axi_tracer (
+    .clk_i      (clk_i                                                            ),
+    .rst_ni     (rst_ni                                                           ),
+    .ar_valid_i (i_ara_soc.gen_systems[0].i_system.ariane_narrow_axi_req.ar_valid ),
+    .ar_ready_i (i_ara_soc.gen_systems[0].i_system.ariane_narrow_axi_resp.ar_ready),
+    .ar_id_i    (i_ara_soc.gen_systems[0].i_system.ariane_narrow_axi_req.ar.id    ),
+    .ar_addr_i  (i_ara_soc.gen_systems[0].i_system.ariane_narrow_axi_req.ar.addr  ),
+    .ar_len_i   (i_ara_soc.gen_systems[0].i_system.ariane_narrow_axi_req.ar.len   ),
+    .ar_size_i  (i_ara_soc.gen_systems[0].i_system.ariane_narrow_axi_req.ar.size  ),
+    .aw_valid_i (i_ara_soc.gen_systems[0].i_system.ariane_narrow_axi_req.aw_valid ),
+    .aw_ready_i (i_ara_soc.gen_systems[0].i_system.ariane_narrow_axi_resp.aw_ready),
+    .aw_id_i    (i_ara_soc.gen_systems[0].i_system.ariane_narrow_axi_req.aw.id    ),
+    .aw_addr_i  (i_ara_soc.gen_systems[0].i_system.ariane_narrow_axi_req.aw.addr  ),
+    .aw_len_i   (i_ara_soc.gen_systems[0].i_system.ariane_narrow_axi_req.aw.len   ),
+    .aw_size_i  (i_ara_soc.gen_systems[0].i_system.ariane_narrow_axi_req.aw.size  ),
+    .w_valid_i  (i_ara_soc.gen_systems[0].i_system.ariane_narrow_axi_req.w_valid  ),
+    .w_ready_i  (i_ara_soc.gen_systems[0].i_system.ariane_narrow_axi_resp.w_ready ),
+    .w_strb_i   (i_ara_soc.gen_systems[0].i_system.ariane_narrow_axi_req.w.strb   ),
+    .w_last_i   (i_ara_soc.gen_systems[0].i_system.ariane_narrow_axi_req.w.last   ),
+    .r_valid_i  (i_ara_soc.gen_systems[0].i_system.ariane_narrow_axi_resp.r_valid ),
+    .r_ready_i  (i_ara_soc.gen_systems[0].i_system.ariane_narrow_axi_req.r_ready  ),
+    .r_id_i     (i_ara_soc.gen_systems[0].i_system.ariane_narrow_axi_resp.r.id    ),
+    .r_last_i   (i_ara_soc.gen_systems[0].i_system.ariane_narrow_axi_resp.r.last  ),
+    .b_valid_i  (i_ara_soc.gen_systems[0].i_system.ariane_narrow_axi_resp.b_valid ),
+    .b_ready_i  (i_ara_soc.gen_systems[0].i_system.ariane_narrow_axi_req.b_ready  ),
+    .b_id_i     (i_ara_soc.gen_systems[0].i_system.ariane_narrow_axi_resp.b.id    ),
+    .b_resp_i   (i_ara_soc.gen_systems[0].i_system.ariane_narrow_axi_resp.b.resp  )
+  );
+
+`endif
+
+`ifndef IDEAL_DISPATCHER
+`ifndef SPIKE_CORE
+
+  /*******************
+   *  SAMPLE WINDOW  *
+   *******************/
+
+  // Sampled simulation (scripts/simpoint.py): with +sample_insns=N, measure the cycles of the N
+  // instructions committed by CVA6 after the first +sample_warmup=W ones, and end there. The
+  // warm-up fills the caches and the predictors of a fast-forwarded image.
+  longint unsigned sample_insns, sample_warmup;
+  longint unsigned sample_cnt_q, sample_cycle_q, sample_start_q;
+  bit              sample_started_q;
+
+  initial begin
+    if (!$value$plusargs("sample_insns=%d", sample_insns))
+      sample_insns = 0;
+    if (!$value$plusargs("sample_warmup=%d", sample_warmup))
+      sample_warmup = 0;
+  end
+
+  always_ff @(posedge clk_i or negedge rst_ni) begin
+    if (!rst_ni) begin
+      sample_cnt_q     <= 0;
+      sample_cycle_q   <= 0;
+      sample_start_q   <= 0;
+      sample_started_q <= 1'b0;
+    end else if (sample_insns != 0) begin
+      automatic longint unsigned cnt =
+        sample_cnt_q + $countones(i_ara_soc.gen_systems[0].i_system.i_ariane.commit_ack);
+      sample_cnt_q   <= cnt;
+      sample_cycle_q <= sample_cycle_q + 1;
+      if (!sample_started_q && cnt >= sample_warmup) begin
+        sample_started_q <= 1'b1;
+        sample_start_q   <= sample_cycle_q;
+      end
+      if (cnt >= sample_warmup + sample_insns) begin
+        $display("[sample-cycles]: %0d", sample_cycle_q - sample_start_q);
+        $display("[sample-insns]: %0d", cnt - sample_warmup);
+        $finish(0);
+      end
+    end
+  end
+
+  // The program can end within the sample
+  final begin
+    if (sample_insns != 0 && sample_started_q && sample_cnt_q < sample_warmup + sample_insns) begin
+      $display("[sample-cycles]: %0d", sample_cycle_q - sample_start_q);
+      $display("[sample-insns]: %0d", sample_cnt_q - sample_warmup);
+    end
+  end
+
+`endif
+`endif
+
+`ifdef PC_SAMPLE
+`ifndef IDEAL_DISPATCHER
+
+  /***************
+   *  PC_SAMPLE  *
+   ***************/
+
+  // The sample file can be chosen with +pc_sample=<file>, and the period with +pc_sample_period=<N>
+  ara_pc_sampler i_pc_sampler (
+    .clk_i           (clk_i                                                          ),
+    .rst_ni          (rst_ni                                                         ),
+`ifdef SPIKE_CORE
+    .pc_i            (i_ara_soc.gen_systems[0].i_system.i_spike_core.pc_o            ),
+`else
+    .pc_i            (i_ara_soc.gen_systems[0].i_system.i_ariane.pc_commit           ),
+`endif
+    .acc_req_valid_i (i_ara_soc.gen_systems[0].i_system.acc_req_valid                ),
+    .acc_req_ready_i (i_ara_soc.gen_systems[0].i_system.acc_req_ready                ),
+    .acc_resp_valid_i(i_ara_soc.gen_systems[0].i_system.acc_resp_valid               ),
+    .acc_resp_ready_i(i_ara_soc.gen_systems[0].i_system.acc_resp_ready               ),
+    .ar_valid_i      (i_ara_soc.gen_systems[0].i_system.ariane_narrow_axi_req.ar_valid ),
+    .ar_ready_i      (i_ara_soc.gen_systems[0].i_system.ariane_narrow_axi_resp.ar_ready),
+    .r_valid_i       (i_ara_soc.gen_systems[0].i_system.ariane_narrow_axi_resp.r_valid ),
+    .r_ready_i       (i_ara_soc.gen_systems[0].i_system.ariane_narrow_axi_req.r_ready  ),
+    .r_last_i        (i_ara_soc.gen_systems[0].i_system.ariane_narrow_axi_resp.r.last  )
+  );
+
+`endif
+`endif
+
 `endif
 endmodule : ara_testharness
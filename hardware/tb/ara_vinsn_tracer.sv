@@ -0,0 +1,104 @@
+// Copyright 2021 ETH Zurich and University of Bologna.
+// Solderpad Hardware License, Version 0.51, see LICENSE for details.
+// SPDX-License-Identifier: SHL-0.51
+//
+// Description:
+// Lifecycle trace of the vector instructions. For each instruction, it records
+// when the dispatcher hands it to the sequencer, when the sequencer issues it
+// (with its hazard vectors), when each lane sequencer accepts it, and when each
+// PE completes it. The events are sent to a DPI-C ring buffer (tb/dpi/vinsn_trace.cc).
+// Compile with VINSN_TRACE defined to enable it.
+
+import "DPI-C" function void vinsn_trace_open(input string filename, input int unsigned nr_lanes, input int unsigned nr_vinsn, input int unsigned depth);
+import "DPI-C" function void vinsn_trace_event(input longint unsigned cycle, input byte unsigned kind, input byte unsigned vid, input byte unsigned pe, input byte unsigned op, input int unsigned hazard_vs1, input int unsigned hazard_vs2, input int unsigned hazard_vm, input int unsigned hazard_vd);
+import "DPI-C" function void vinsn_trace_close();
+
+module ara_vinsn_tracer import ara_pkg::*; #(
+    parameter  int unsigned NrLanes   = 0,
+    // Maximum number of events kept in memory. Older events are dropped.
+    parameter  int unsigned Depth     = 1 << 20,
+    // Default trace file, overridden by the +vinsn_trace=<file> plusarg
+    parameter  string       TraceFile = "vinsn_trace.bin",
+    // Dependant parameters. DO NOT CHANGE!
+    localparam int unsigned NrPEs     = NrLanes + 4
+  ) (
+    input logic                            clk_i,
+    input logic                            rst_ni,
+    // The dispatcher hands a new request to the sequencer
+    input logic                            ara_req_new_i,
+    input ara_op_e                         ara_req_op_i,
+    // Sequencer issue
+    input pe_req_t                         pe_req_i,
+    input logic                            pe_req_valid_i,
+    input logic      [NrPEs-1:0]           pe_req_ready_i,
+    // Completion
+    input pe_resp_t  [NrPEs-1:0]           pe_resp_i
+  );
+
+  // Event kinds, keep in sync with scripts/vinsn_trace_to_perfetto.py
+  typedef enum byte unsigned {
+    EvDispatch = 0,
+    EvIssue    = 1,
+    EvStart    = 2,
+    EvDone     = 3
+  } vinsn_event_e;
+
+  // No VID is assigned yet when the instruction is dispatched
+  localparam byte unsigned NoVid = 8'hFF;
+
+  longint unsigned cycle;
+
+  // Last issued instruction, not to trace the same issue more than once
+  logic issued_q;
+  vid_t issued_id_q;
+
+  // The sequencer broadcasts the request until every lane has sampled it.
+  // Remember which lanes have already sampled the current one.
+  logic [NrLanes-1:0] lane_started_d, lane_started_q, lane_started_prev;
+
+  always_comb begin
+    // Forget the lanes that sampled the previous instruction
+    lane_started_prev = (pe_req_valid_i && issued_q && pe_req_i.id == issued_id_q) ? lane_started_q : '0;
+    lane_started_d    = lane_started_prev | (pe_req_valid_i ? pe_req_ready_i[NrLanes-1:0] : '0);
+  end
+
+  initial begin
+    string trace_file;
+    if (!$value$plusargs("vinsn_trace=%s", trace_file))
+      trace_file = TraceFile;
+    vinsn_trace_open(trace_file, NrLanes, NrVInsn, Depth);
+  end
+  final vinsn_trace_close();
+
+  always_ff @(posedge clk_i or negedge rst_ni) begin
+    if (!rst_ni) begin
+      cycle          <= '0;
+      issued_q       <= 1'b0;
+      issued_id_q    <= '0;
+      lane_started_q <= '0;
+    end else begin
+      cycle <= cycle + 1;
+
+      if (ara_req_new_i)
+        vinsn_trace_event(cycle, EvDispatch, NoVid, '0, ara_req_op_i, '0, '0, '0, '0);
+
+      // The sequencer keeps the request valid until all the lanes sample it
+      issued_q    <= pe_req_valid_i;
+      issued_id_q <= pe_req_i.id;
+      if (pe_req_valid_i && (!issued_q || pe_req_i.id != issued_id_q))
+        vinsn_trace_event(cycle, EvIssue, pe_req_i.id, '0, pe_req_i.op, pe_req_i.hazard_vs1,
+          pe_req_i.hazard_vs2, pe_req_i.hazard_vm, pe_req_i.hazard_vd);
+
+      lane_started_q <= lane_started_d;
+      for (int unsigned l = 0; l < NrLanes; l++)
+        if (lane_started_d[l] && !lane_started_prev[l])
+          vinsn_trace_event(cycle, EvStart, pe_req_i.id, l, '0, '0, '0, '0, '0);
+
+      for (int unsigned pe = 0; pe < NrPEs; pe++)
+        for (int unsigned v = 0; v < NrVInsn; v++)
+          if (pe_resp_i[pe].vinsn_done[v])
+            vinsn_trace_event(cycle, EvDone, v, pe, '0, '0, '0, '0, '0);
+    end
+  end
+
+endmodule : ara_vinsn_tracer
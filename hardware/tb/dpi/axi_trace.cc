@@ -0,0 +1,126 @@
+// Copyright 2021 ETH Zurich and University of Bologna.
+// Solderpad Hardware License, Version 0.51, see LICENSE for details.
+// SPDX-License-Identifier: SHL-0.51
+//
+// Description:
+// DPI-C sink for the AXI transaction trace (ara_axi_tracer.sv). All the ports
+// write to the same file, which is opened by the first of them. Unlike the
+// vinsn trace, no event is dropped: the records are buffered and streamed to
+// the file, so that the bandwidth can be measured over the whole run.
+//
+// File format (little-endian):
+//   Header: char magic[4] = "ARAX", uint32_t version
+//   Record: uint64_t cycle, uint64_t addr, uint16_t id, uint16_t bytes,
+//           uint8_t port, uint8_t kind, uint8_t len, uint8_t info
+// A port record (kind 255) gives the data width of the port in bytes. The kinds
+// of the events are those of ara_axi_tracer.sv.
+//
+// scripts/axi_trace_plot.py plots the bandwidth and the transactions in flight.
+
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <svdpi.h>
+#include <vector>
+
+namespace {
+
+const char kMagic[4] = {'A', 'R', 'A', 'X'};
+const uint32_t kVersion = 1;
+const uint8_t kKindPort = 255;
+// Records buffered before they are written
+const size_t kBufferRecords = 1 << 16;
+
+struct TraceRecord {
+  uint64_t cycle;
+  uint64_t addr;
+  uint16_t id;
+  uint16_t bytes;
+  uint8_t port;
+  uint8_t kind;
+  uint8_t len;
+  uint8_t info;
+};
+static_assert(sizeof(TraceRecord) == 24, "Unexpected padding in TraceRecord");
+
+std::string trace_filename;
+FILE *trace_file = nullptr;
+std::vector<TraceRecord> trace_buffer;
+uint64_t trace_events = 0;
+
+void Flush() {
+  fwrite(trace_buffer.data(), sizeof(TraceRecord), trace_buffer.size(),
+         trace_file);
+  trace_buffer.clear();
+}
+
+void Record(const TraceRecord &rec) {
+  trace_buffer.push_back(rec);
+  if (trace_buffer.size() == kBufferRecords) {
+    Flush();
+  }
+}
+
+} // namespace
+
+extern "C" {
+
+// Add a port to the trace, opening the file for the first one
+void axi_trace_open(const char *filename, unsigned char port,
+                    unsigned int data_bytes) {
+  if (!trace_file) {
+    trace_file = fopen(filename, "wb");
+    if (!trace_file) {
+      std::cerr << "[axi_trace] Cannot open " << filename << std::endl;
+      return;
+    }
+    trace_filename = filename;
+    trace_buffer.reserve(kBufferRecords);
+    trace_events = 0;
+    fwrite(kMagic, 1, sizeof(kMagic), trace_file);
+    fwrite(&kVersion, sizeof(kVersion), 1, trace_file);
+  }
+
+  TraceRecord rec = {};
+  rec.port = port;
+  rec.kind = kKindPort;
+  rec.bytes = data_bytes;
+  Record(rec);
+}
+
+// Record one handshake
+void axi_trace_event(uint64_t cycle, unsigned char port, unsigned char kind,
+                     unsigned short id, uint64_t addr, unsigned char len,
+                     unsigned char info, unsigned short bytes) {
+  if (!trace_file) {
+    return;
+  }
+
+  TraceRecord rec;
+  rec.cycle = cycle;
+  rec.addr = addr;
+  rec.id = id;
+  rec.bytes = bytes;
+  rec.port = port;
+  rec.kind = kind;
+  rec.len = len;
+  rec.info = info;
+  Record(rec);
+  ++trace_events;
+}
+
+// Write the buffered records. Called by every port, the first call closes the
+// file.
+void axi_trace_close() {
+  if (!trace_file) {
+    return;
+  }
+  Flush();
+  fclose(trace_file);
+  trace_file = nullptr;
+
+  std::cout << "[axi_trace] " << trace_events << " events written to "
+            << trace_filename << std::endl;
+}
+}
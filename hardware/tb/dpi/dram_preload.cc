@@ -0,0 +1,115 @@
+// Copyright 2021 ETH Zurich and University of Bologna.
+// Solderpad Hardware License, Version 0.51, see LICENSE for details.
+// SPDX-License-Identifier: SHL-0.51
+//
+// Description:
+// DPI-C preload of an ELF binary into the init image of the DRAM of the
+// QuestaSim testbench. The loadable segments are written as whole rows of the
+// image, instead of byte by byte from SystemVerilog.
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <elf.h>
+#include <iostream>
+#include <svdpi.h>
+#include <vector>
+
+namespace {
+
+// Write len bytes at addr to the rows of image, a memory of row_bytes bytes per
+// row that starts at base. The rows only partly covered keep their other bytes.
+// Returns the number of bytes outside the image.
+uint64_t WriteRows(const svOpenArrayHandle image, uint64_t base,
+                   unsigned row_bytes, uint64_t addr, const uint8_t *data,
+                   uint64_t len) {
+  const int low = svLow(image, 1);
+  const uint64_t end = base + (uint64_t(svHigh(image, 1) - low) + 1) * row_bytes;
+  std::vector<svLogicVecVal> row(row_bytes / 4);
+  uint64_t outside = 0;
+
+  while (len) {
+    const unsigned offset = addr % row_bytes;
+    const uint64_t count = std::min<uint64_t>(row_bytes - offset, len);
+    if (addr < base || addr >= end) {
+      outside += count;
+    } else {
+      const int idx = low + int((addr - base) / row_bytes);
+      if (count != row_bytes)
+        svGetLogicArrElem1VecVal(row.data(), image, idx);
+      for (unsigned b = offset; b < offset + count; b++) {
+        const unsigned shift = 8 * (b % 4);
+        row[b / 4].aval = (row[b / 4].aval & ~(0xffu << shift)) |
+                          (uint32_t(data[b - offset]) << shift);
+        row[b / 4].bval &= ~(0xffu << shift);
+      }
+      svPutLogicArrElem1VecVal(image, row.data(), idx);
+    }
+    addr += count;
+    data += count;
+    len -= count;
+  }
+  return outside;
+}
+
+template <typename Ehdr, typename Phdr>
+long long LoadSegments(const std::vector<uint8_t> &elf,
+                       const svOpenArrayHandle image, uint64_t base,
+                       unsigned row_bytes) {
+  const Ehdr *eh = reinterpret_cast<const Ehdr *>(elf.data());
+  if (elf.size() < sizeof(Ehdr) ||
+      eh->e_phoff + uint64_t(eh->e_phnum) * sizeof(Phdr) > elf.size())
+    return -1;
+  const Phdr *ph = reinterpret_cast<const Phdr *>(elf.data() + eh->e_phoff);
+
+  uint64_t outside = 0;
+  for (unsigned i = 0; i < eh->e_phnum; i++) {
+    if (ph[i].p_type != PT_LOAD || ph[i].p_memsz == 0)
+      continue;
+    if (ph[i].p_offset + ph[i].p_filesz > elf.size())
+      return -1;
+    printf("Loading section %016llx of length %016llx\n",
+           (unsigned long long)ph[i].p_paddr,
+           (unsigned long long)ph[i].p_memsz);
+    // The bytes past the file size (.bss) are zeros
+    std::vector<uint8_t> mem(ph[i].p_memsz, 0);
+    memcpy(mem.data(), elf.data() + ph[i].p_offset, ph[i].p_filesz);
+    outside +=
+        WriteRows(image, base, row_bytes, ph[i].p_paddr, mem.data(), mem.size());
+  }
+  fflush(stdout);
+  return outside;
+}
+
+} // namespace
+
+// Preload the loadable segments of filename into image, the init image of a
+// memory of row_bytes bytes per row that starts at base. Returns the number of
+// bytes outside the image, or -1 if the file is not a valid ELF binary.
+extern "C" long long dram_preload(const char *filename, long long base,
+                                  unsigned int row_bytes,
+                                  const svOpenArrayHandle image) {
+  if (row_bytes == 0 || row_bytes % 4) {
+    std::cerr << "[dram_preload] Unsupported row of " << row_bytes << " bytes"
+              << std::endl;
+    return -1;
+  }
+  FILE *f = fopen(filename, "rb");
+  if (!f) {
+    std::cerr << "[dram_preload] Cannot open " << filename << std::endl;
+    return -1;
+  }
+  std::vector<uint8_t> elf;
+  uint8_t chunk[1 << 16];
+  size_t n;
+  while ((n = fread(chunk, 1, sizeof(chunk), f)) > 0)
+    elf.insert(elf.end(), chunk, chunk + n);
+  fclose(f);
+
+  if (elf.size() < EI_NIDENT || memcmp(elf.data(), ELFMAG, SELFMAG))
+    return -1;
+  if (elf[EI_CLASS] == ELFCLASS32)
+    return LoadSegments<Elf32_Ehdr, Elf32_Phdr>(elf, image, base, row_bytes);
+  return LoadSegments<Elf64_Ehdr, Elf64_Phdr>(elf, image, base, row_bytes);
+}
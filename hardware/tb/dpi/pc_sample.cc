@@ -0,0 +1,74 @@
+// Copyright 2021 ETH Zurich and University of Bologna.
+// Solderpad Hardware License, Version 0.51, see LICENSE for details.
+// SPDX-License-Identifier: SHL-0.51
+//
+// Description:
+// DPI-C sink for the sampling profile of CVA6 (ara_pc_sampler.sv). The
+// samples are counted per PC and cause, and the histogram is written when the
+// profile is closed, one line per PC and cause:
+//   # pc_sample period <cycles>
+//   <pc> <cause> <samples>
+// with the PC in hexadecimal. scripts/pc_report.py symbolizes it.
+
+#include <cinttypes>
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <map>
+#include <string>
+#include <svdpi.h>
+#include <utility>
+
+namespace {
+
+std::string sample_filename;
+unsigned int sample_period = 0;
+std::map<std::pair<uint64_t, uint8_t>, uint64_t> samples;
+uint64_t sample_count = 0;
+bool sample_open = false;
+
+} // namespace
+
+extern "C" {
+
+// Start a new profile, sampled every period cycles
+void pc_sample_open(const char *filename, unsigned int period) {
+  sample_filename = filename;
+  sample_period = period;
+  samples.clear();
+  sample_count = 0;
+  sample_open = true;
+}
+
+// Count one sample
+void pc_sample(uint64_t pc, unsigned char cause) {
+  if (!sample_open) {
+    return;
+  }
+  ++samples[std::make_pair(pc, (uint8_t)cause)];
+  ++sample_count;
+}
+
+// Write the histogram
+void pc_sample_close() {
+  if (!sample_open) {
+    return;
+  }
+  sample_open = false;
+
+  FILE *f = fopen(sample_filename.c_str(), "w");
+  if (!f) {
+    std::cerr << "[pc_sample] Cannot open " << sample_filename << std::endl;
+    return;
+  }
+  fprintf(f, "# pc_sample period %u\n", sample_period);
+  for (const auto &s : samples) {
+    fprintf(f, "%016" PRIx64 " %u %" PRIu64 "\n", s.first.first,
+            (unsigned)s.first.second, s.second);
+  }
+  fclose(f);
+
+  std::cout << "[pc_sample] " << sample_count << " samples written to "
+            << sample_filename << std::endl;
+}
+}
@@ -0,0 +1,99 @@
+// Copyright 2021 ETH Zurich and University of Bologna.
+// Solderpad Hardware License, Version 0.51, see LICENSE for details.
+// SPDX-License-Identifier: SHL-0.51
+//
+// Description:
+// DPI-C sink for the results stored by Ara. The W beats are collected in a
+// memory buffer and written to a binary file as a stream of records.
+//
+// File format (little-endian):
+//   Header: char magic[4] = "ARAW", uint32_t version, uint32_t bus_bytes
+//   Record: uint64_t addr, uint64_t strb, uint8_t data[bus_bytes]
+//
+// scripts/compare_results.py compares two of these files.
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <svdpi.h>
+#include <vector>
+
+namespace {
+
+const char kMagic[4] = {'A', 'R', 'A', 'W'};
+const uint32_t kVersion = 1;
+// Flush the buffer to the file every kFlushBytes bytes
+const size_t kFlushBytes = 1 << 20;
+// The DPI interface carries up to 512 bits of data per beat
+const uint32_t kMaxBusBytes = 64;
+
+FILE *dump_file = nullptr;
+uint32_t dump_bus_bytes = 0;
+std::vector<uint8_t> dump_buffer;
+
+template <typename T> void Append(const T &val) {
+  const uint8_t *bytes = reinterpret_cast<const uint8_t *>(&val);
+  dump_buffer.insert(dump_buffer.end(), bytes, bytes + sizeof(T));
+}
+
+void Flush() {
+  if (dump_file && !dump_buffer.empty()) {
+    fwrite(dump_buffer.data(), 1, dump_buffer.size(), dump_file);
+  }
+  dump_buffer.clear();
+}
+
+} // namespace
+
+extern "C" {
+
+// Open the binary result file. bus_bytes is the width of the W channel.
+void result_dump_open(const char *filename, unsigned int bus_bytes) {
+  if (bus_bytes > kMaxBusBytes) {
+    std::cerr << "[result_dump] Unsupported bus width of " << bus_bytes
+              << " bytes." << std::endl;
+    return;
+  }
+
+  dump_file = fopen(filename, "wb");
+  if (!dump_file) {
+    std::cerr << "[result_dump] Cannot open " << filename << std::endl;
+    return;
+  }
+
+  dump_bus_bytes = bus_bytes;
+  dump_buffer.reserve(kFlushBytes + 2 * sizeof(uint64_t) + kMaxBusBytes);
+
+  dump_buffer.insert(dump_buffer.end(), kMagic, kMagic + sizeof(kMagic));
+  Append(kVersion);
+  Append(dump_bus_bytes);
+}
+
+// Record one W beat. addr is the bus-aligned address of the beat.
+void result_dump_beat(uint64_t addr, uint64_t strb, const svBitVecVal *data) {
+  if (!dump_file) {
+    return;
+  }
+
+  Append(addr);
+  Append(strb);
+  const uint8_t *bytes = reinterpret_cast<const uint8_t *>(data);
+  dump_buffer.insert(dump_buffer.end(), bytes, bytes + dump_bus_bytes);
+
+  if (dump_buffer.size() >= kFlushBytes) {
+    Flush();
+  }
+}
+
+// Flush the buffer and close the result file
+void result_dump_close() {
+  if (!dump_file) {
+    return;
+  }
+
+  Flush();
+  fclose(dump_file);
+  dump_file = nullptr;
+}
+}
@@ -0,0 +1,137 @@
+// Copyright 2021 ETH Zurich and University of Bologna.
+// Solderpad Hardware License, Version 0.51, see LICENSE for details.
+// SPDX-License-Identifier: SHL-0.51
+//
+// Description:
+// DPI-C sink for the vector instruction lifecycle trace (ara_vinsn_tracer.sv).
+// The events are kept in a ring buffer in memory, which holds the last
+// `depth` events, and are written to a binary file when the trace is closed.
+//
+// File format (little-endian):
+//   Header: char magic[4] = "ARVT", uint32_t version, uint32_t nr_lanes,
+//           uint32_t nr_vinsn, uint64_t dropped_events
+//   Record: uint64_t cycle, uint8_t kind, uint8_t vid, uint8_t pe, uint8_t op,
+//           uint32_t hazard[4] (vs1, vs2, vm, vd), uint32_t reserved
+//
+// scripts/vinsn_trace_to_perfetto.py converts it into a Chrome/Perfetto trace.
+
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <svdpi.h>
+#include <vector>
+
+namespace {
+
+const char kMagic[4] = {'A', 'R', 'V', 'T'};
+const uint32_t kVersion = 2;
+
+struct TraceRecord {
+  uint64_t cycle;
+  uint8_t kind;
+  uint8_t vid;
+  uint8_t pe;
+  uint8_t op;
+  uint32_t hazard[4];
+  uint32_t reserved;
+};
+static_assert(sizeof(TraceRecord) == 32, "Unexpected padding in TraceRecord");
+
+std::string trace_filename;
+uint32_t trace_nr_lanes = 0;
+uint32_t trace_nr_vinsn = 0;
+std::vector<TraceRecord> trace_ring;
+// Number of events recorded since the trace was opened
+uint64_t trace_events = 0;
+bool trace_open = false;
+
+template <typename T> void Write(FILE *f, const T &val) {
+  fwrite(&val, sizeof(T), 1, f);
+}
+
+} // namespace
+
+extern "C" {
+
+// Start a new trace, which keeps the last depth events
+void vinsn_trace_open(const char *filename, unsigned int nr_lanes,
+                      unsigned int nr_vinsn, unsigned int depth) {
+  if (depth == 0) {
+    std::cerr << "[vinsn_trace] The trace depth must be positive."
+              << std::endl;
+    return;
+  }
+
+  trace_filename = filename;
+  trace_nr_lanes = nr_lanes;
+  trace_nr_vinsn = nr_vinsn;
+  trace_ring.assign(depth, TraceRecord());
+  trace_events = 0;
+  trace_open = true;
+}
+
+// Record one event
+void vinsn_trace_event(uint64_t cycle, unsigned char kind, unsigned char vid,
+                       unsigned char pe, unsigned char op,
+                       unsigned int hazard_vs1, unsigned int hazard_vs2,
+                       unsigned int hazard_vm, unsigned int hazard_vd) {
+  if (!trace_open) {
+    return;
+  }
+
+  TraceRecord &rec = trace_ring[trace_events % trace_ring.size()];
+  rec.cycle = cycle;
+  rec.kind = kind;
+  rec.vid = vid;
+  rec.pe = pe;
+  rec.op = op;
+  rec.hazard[0] = hazard_vs1;
+  rec.hazard[1] = hazard_vs2;
+  rec.hazard[2] = hazard_vm;
+  rec.hazard[3] = hazard_vd;
+  rec.reserved = 0;
+  ++trace_events;
+}
+
+// Write the content of the ring buffer, oldest event first
+void vinsn_trace_close() {
+  if (!trace_open) {
+    return;
+  }
+  trace_open = false;
+
+  FILE *f = fopen(trace_filename.c_str(), "wb");
+  if (!f) {
+    std::cerr << "[vinsn_trace] Cannot open " << trace_filename << std::endl;
+    return;
+  }
+
+  const uint64_t depth = trace_ring.size();
+  const uint64_t dropped = trace_events > depth ? trace_events - depth : 0;
+
+  fwrite(kMagic, 1, sizeof(kMagic), f);
+  Write(f, kVersion);
+  Write(f, trace_nr_lanes);
+  Write(f, trace_nr_vinsn);
+  Write(f, dropped);
+
+  // The oldest event is right after the newest one, once the ring wrapped
+  const uint64_t first = dropped % depth;
+  const uint64_t valid = trace_events - dropped;
+  if (first + valid <= depth) {
+    fwrite(&trace_ring[first], sizeof(TraceRecord), valid, f);
+  } else {
+    fwrite(&trace_ring[first], sizeof(TraceRecord), depth - first, f);
+    fwrite(&trace_ring[0], sizeof(TraceRecord), valid - (depth - first), f);
+  }
+  fclose(f);
+
+  std::cout << "[vinsn_trace] " << valid << " events written to "
+            << trace_filename;
+  if (dropped) {
+    std::cout << " (" << dropped << " older events dropped)";
+  }
+  std::cout << std::endl;
+}
+}
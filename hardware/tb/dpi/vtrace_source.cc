@@ -0,0 +1,127 @@
+// Copyright 2021 ETH Zurich and University of Bologna.
+// Solderpad Hardware License, Version 0.51, see LICENSE for details.
+// SPDX-License-Identifier: SHL-0.51
+//
+// Description:
+// DPI-C source of the ideal dispatcher (accel_dispatcher_ideal.sv). The binary
+// vtrace is memory-mapped, and the instructions are read on demand, so that
+// the same model can replay traces of any length without being rebuilt.
+//
+// File format (little-endian):
+//   Header: char magic[4] = "VTRC", uint32_t version, uint64_t nr_insn
+//   Record: uint32_t insn, uint64_t rs1, uint64_t rs2 (packed, 20 bytes)
+//   Version 2 appends to each record uint32_t gap, the number of scalar
+//   instructions executed since the previous vector instruction (24 bytes).
+//   Version 3 appends uint64_t pc, the address of the vector instruction, for
+//   the analyses of scripts/vl_report.py (32 bytes).
+
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <svdpi.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+const char kMagic[4] = {'V', 'T', 'R', 'C'};
+const uint32_t kVersion = 3;
+const size_t kHeaderBytes = 16;
+
+const uint8_t *vtrace_data = nullptr;
+size_t vtrace_bytes = 0;
+uint64_t vtrace_nr_insn = 0;
+size_t vtrace_record_bytes = 0;
+
+size_t RecordBytes(uint32_t version) {
+  switch (version) {
+    case 1:
+      return 20;
+    case 2:
+      return 24;
+    case 3:
+      return 32;
+    default:
+      return 0;
+  }
+}
+
+} // namespace
+
+extern "C" {
+
+// Map the vtrace. Return the number of instructions, or -1 on error.
+long long vtrace_open(const char *filename) {
+  int fd = open(filename, O_RDONLY);
+  if (fd < 0) {
+    std::cerr << "[vtrace] Cannot open " << filename << std::endl;
+    return -1;
+  }
+
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size < (off_t)kHeaderBytes) {
+    std::cerr << "[vtrace] " << filename << " is too short." << std::endl;
+    close(fd);
+    return -1;
+  }
+
+  void *ptr = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (ptr == MAP_FAILED) {
+    std::cerr << "[vtrace] Cannot map " << filename << std::endl;
+    return -1;
+  }
+  // The instructions are read in order
+  madvise(ptr, st.st_size, MADV_SEQUENTIAL);
+
+  const uint8_t *data = static_cast<const uint8_t *>(ptr);
+  uint32_t version;
+  uint64_t nr_insn;
+  memcpy(&version, data + 4, sizeof(version));
+  memcpy(&nr_insn, data + 8, sizeof(nr_insn));
+  size_t record_bytes = RecordBytes(version);
+  if (memcmp(data, kMagic, sizeof(kMagic)) || !record_bytes ||
+      kHeaderBytes + nr_insn * record_bytes > (uint64_t)st.st_size) {
+    std::cerr << "[vtrace] " << filename
+              << " is not a binary vtrace (version up to " << kVersion << ")."
+              << std::endl;
+    munmap(ptr, st.st_size);
+    return -1;
+  }
+
+  vtrace_data = data;
+  vtrace_bytes = st.st_size;
+  vtrace_nr_insn = nr_insn;
+  vtrace_record_bytes = record_bytes;
+  return nr_insn;
+}
+
+// Read the instruction idx. Return 0 past the end of the trace.
+unsigned char vtrace_read(uint64_t idx, svBitVecVal *insn, uint64_t *rs1,
+                          uint64_t *rs2, unsigned int *gap) {
+  if (!vtrace_data || idx >= vtrace_nr_insn) {
+    return 0;
+  }
+
+  const uint8_t *rec = vtrace_data + kHeaderBytes + idx * vtrace_record_bytes;
+  uint32_t insn_val;
+  memcpy(&insn_val, rec, sizeof(insn_val));
+  memcpy(rs1, rec + 4, sizeof(*rs1));
+  memcpy(rs2, rec + 12, sizeof(*rs2));
+  *insn = insn_val;
+  *gap = 0;
+  if (vtrace_record_bytes > 20) {
+    memcpy(gap, rec + 20, sizeof(*gap));
+  }
+  return 1;
+}
+
+void vtrace_close() {
+  if (vtrace_data) {
+    munmap(const_cast<uint8_t *>(vtrace_data), vtrace_bytes);
+    vtrace_data = nullptr;
+  }
+}
+}
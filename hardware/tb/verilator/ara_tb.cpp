@@ -9,10 +9,20 @@
 #include <fstream>
 #include <iostream>
 
+#include "golden_check.h"
+#include "sparse_mem.h"
+#ifdef SPIKE_CORE
+#include "spike_core.h"
+#endif
 #include "verilated_toplevel.h"
 #include "verilator_memutil.h"
 #include "verilator_sim_ctrl.h"
 
+// Size of the main memory, set by the configuration
+#ifndef DRAM_SIZE
+#define DRAM_SIZE 0x02000000
+#endif
+
 int main(int argc, char **argv) {
   // Create an instance of the DUT
   ara_tb_verilator *tb = new ara_tb_verilator;
@@ -22,13 +32,46 @@ int main(int argc, char **argv) {
   VerilatorSimCtrl &simctrl = VerilatorSimCtrl::GetInstance();
   simctrl.SetTop(tb, &tb->clk_i, &tb->rst_ni,
                  VerilatorSimCtrlFlags::ResetPolarityNegative);
+  simctrl.SetEventTrigger(&tb->event_trigger_o);
+  simctrl.SetExitSignal(&tb->exit_o);
 
   // Initialize the DRAM
-  MemAreaLoc l2_mem = {.base=0x80000000, .size=0x00100000};
+  const char *dram_scope = "TOP.ara_tb_verilator.dut.i_ara_soc.i_dram";
+#ifdef SPARSE_DRAM
+  // The sparse DRAM must exist before the ELF file is loaded into it
+  SparseMemCreate(dram_scope, DRAM_SIZE, 64*NR_LANES/2/8);
+#endif
+  MemAreaLoc l2_mem = {.base=0x80000000, .size=DRAM_SIZE};
   memutil.RegisterMemoryArea(
-                             "ram", "TOP.ara_tb_verilator.dut.i_ara_soc.i_dram", 64*NR_LANES/2, &l2_mem);
+                             "ram", dram_scope, 64*NR_LANES/2, &l2_mem);
   simctrl.RegisterExtension(&memutil);
 
+  // With --batch, each test starts from a cleared DRAM
+  DpiMemUtil *mem = memutil.GetUnderlying();
+#ifdef SPIKE_CORE
+  // Spike, the scalar core, shares the DRAM through its backdoor
+  SpikeCoreSetMemory(mem, "ram", l2_mem.base, l2_mem.size);
+#endif
+  simctrl.SetBatchLoader([mem](const std::string &elf) {
+    try {
+      if (!mem->ClearMemory("ram")) {
+        std::cerr << "ERROR: The DRAM has no backdoor to clear it."
+                  << std::endl;
+        return false;
+      }
+      mem->LoadFileToNamedMem(false, "ram", elf, kMemImageElf);
+    } catch (const std::exception &err) {
+      std::cerr << "ERROR: " << err.what() << std::endl;
+      return false;
+    }
+    return true;
+  });
+
+  // With --golden, the results are compared with their golden values at the
+  // end of the simulation
+  GoldenCheck golden(mem, "ram");
+  simctrl.RegisterExtension(&golden);
+
   simctrl.SetInitialResetDelay(5);
   simctrl.SetResetDuration(5);
 
@@ -44,5 +87,13 @@ int main(int argc, char **argv) {
 
   simctrl.RunSimulation();
 
-  return tb->dut().exit_o >> 1;
+  // Destroy the model, which writes the thread profile of a model verilated
+  // with --prof-pgo (make verilate-pgo)
+  int exit_code = simctrl.InBatchMode() ? !simctrl.WasSimulationSuccessful()
+                                         : tb->dut().exit_o >> 1;
+  if (golden.Failed() && !exit_code) {
+    exit_code = 1;
+  }
+  delete tb;
+  return exit_code;
 }
@@ -0,0 +1,232 @@
+// Copyright 2021 ETH Zurich and University of Bologna.
+// Solderpad Hardware License, Version 0.51, see LICENSE for details.
+// SPDX-License-Identifier: SHL-0.51
+//
+// Description:
+// Check of the results of an application at the end of the simulation.
+//
+// The golden file is a sequence of little-endian entries after the magic
+// `ARAGOLD1', one per symbol:
+//   u32 name length, name, u8 kind, u8 element size, u16 padding,
+//   f64 rtol, f64 atol, u64 size in bytes, golden bytes
+// An element matches when |x - golden| <= atol + rtol * |golden|.
+
+#include "golden_check.h"
+
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <getopt.h>
+#include <iostream>
+#include <sstream>
+
+#include "verilator_sim_ctrl.h"
+
+// Mismatching elements printed per symbol
+static const size_t kMaxPrinted = 10;
+
+static void PrintHelp() {
+  std::cout << "Golden check:\n\n"
+               "--golden=FILE\n"
+               "  At the end of the simulation, compare the symbols of the\n"
+               "  golden FILE with their values in the memory\n\n"
+               "--golden-elf=FILE\n"
+               "  ELF file with the addresses of the symbols (default: the\n"
+               "  golden FILE without its .golden extension)\n\n";
+}
+
+bool GoldenCheck::ParseCLIArguments(int argc, char **argv, bool &exit_app) {
+  const struct option long_options[] = {
+      {"golden", required_argument, nullptr, 'g'},
+      {"golden-elf", required_argument, nullptr, 'G'},
+      {"help", no_argument, nullptr, 'h'},
+      {nullptr, no_argument, nullptr, 0}};
+
+  // Reset the command parsing index in-case other utils have already parsed
+  // some arguments
+  optind = 1;
+  opterr = 0;
+  while (1) {
+    int c = getopt_long(argc, argv, ":h", long_options, nullptr);
+    if (c == -1) {
+      break;
+    }
+
+    switch (c) {
+      case 'g':
+        golden_path_ = optarg;
+        break;
+      case 'G':
+        elf_path_ = optarg;
+        break;
+      case 'h':
+        PrintHelp();
+        return true;
+      case ':':  // missing argument
+        std::cerr << "ERROR: Missing argument." << std::endl << std::endl;
+        return false;
+      case '?':
+      default:;
+        // Ignore unrecognized options since they might be consumed by
+        // other utils
+    }
+  }
+
+  if (!golden_path_.empty() && elf_path_.empty()) {
+    const std::string ext = ".golden";
+    elf_path_ = golden_path_;
+    if (elf_path_.size() > ext.size() &&
+        elf_path_.compare(elf_path_.size() - ext.size(), ext.size(), ext) ==
+            0) {
+      elf_path_.resize(elf_path_.size() - ext.size());
+    }
+  }
+  return true;
+}
+
+std::vector<GoldenCheck::Entry> GoldenCheck::ReadGolden() const {
+  std::ifstream in(golden_path_, std::ios::binary);
+  if (!in) {
+    throw std::runtime_error("Failed to open golden file `" + golden_path_ +
+                             "'.");
+  }
+  auto read = [&](void *dst, size_t len) {
+    if (!in.read(static_cast<char *>(dst), len)) {
+      throw std::runtime_error("Truncated golden file `" + golden_path_ +
+                               "'.");
+    }
+  };
+
+  char magic[8];
+  read(magic, sizeof(magic));
+  if (memcmp(magic, "ARAGOLD1", sizeof(magic)) != 0) {
+    throw std::runtime_error("`" + golden_path_ + "' is not a golden file.");
+  }
+
+  std::vector<Entry> entries;
+  while (in.peek() != std::char_traits<char>::eof()) {
+    Entry entry;
+    uint32_t name_len;
+    uint8_t kind;
+    uint16_t pad;
+    uint64_t size;
+    read(&name_len, sizeof(name_len));
+    entry.name.resize(name_len);
+    read(&entry.name[0], name_len);
+    read(&kind, sizeof(kind));
+    read(&entry.elem_byte, sizeof(entry.elem_byte));
+    read(&pad, sizeof(pad));
+    read(&entry.rtol, sizeof(entry.rtol));
+    read(&entry.atol, sizeof(entry.atol));
+    read(&size, sizeof(size));
+    entry.kind = kind;
+    entry.data.resize(size);
+    read(entry.data.data(), size);
+
+    bool float_ok = entry.kind == 'f' &&
+                    (entry.elem_byte == 4 || entry.elem_byte == 8);
+    bool int_ok = (entry.kind == 'i' || entry.kind == 'u') &&
+                  (entry.elem_byte == 1 || entry.elem_byte == 2 ||
+                   entry.elem_byte == 4 || entry.elem_byte == 8);
+    if ((!float_ok && !int_ok) || size % entry.elem_byte) {
+      std::ostringstream oss;
+      oss << "Unsupported elements of `" << entry.name << "' in golden file `"
+          << golden_path_ << "'.";
+      throw std::runtime_error(oss.str());
+    }
+    entries.push_back(std::move(entry));
+  }
+  return entries;
+}
+
+// Value of the element at p
+static double ElemValue(const uint8_t *p, char kind, uint8_t elem_byte) {
+  uint64_t raw = 0;
+  memcpy(&raw, p, elem_byte);
+  if (kind == 'f') {
+    if (elem_byte == 4) {
+      float f;
+      memcpy(&f, p, sizeof(f));
+      return f;
+    }
+    double d;
+    memcpy(&d, p, sizeof(d));
+    return d;
+  }
+  if (kind == 'i' && elem_byte < 8) {
+    // Sign-extend the element
+    unsigned shift = 64 - 8 * elem_byte;
+    return (double)((int64_t)(raw << shift) >> shift);
+  }
+  return kind == 'i' ? (double)(int64_t)raw : (double)raw;
+}
+
+size_t GoldenCheck::Compare(const Entry &entry,
+                            const std::vector<uint8_t> &data) const {
+  size_t mismatches = 0;
+  for (size_t off = 0; off < data.size(); off += entry.elem_byte) {
+    // The integers are compared exactly, without a tolerance
+    bool match;
+    double x = ElemValue(&data[off], entry.kind, entry.elem_byte);
+    double g = ElemValue(&entry.data[off], entry.kind, entry.elem_byte);
+    if (entry.kind != 'f' && entry.rtol == 0 && entry.atol == 0) {
+      match = memcmp(&data[off], &entry.data[off], entry.elem_byte) == 0;
+    } else if (std::isnan(g)) {
+      match = std::isnan(x);
+    } else {
+      match = std::fabs(x - g) <= entry.atol + entry.rtol * std::fabs(g);
+    }
+    if (match) {
+      continue;
+    }
+    if (mismatches++ < kMaxPrinted) {
+      std::cout << "  " << entry.name << "[" << off / entry.elem_byte
+                << "] = " << x << ", expected " << g << std::endl;
+    }
+  }
+  return mismatches;
+}
+
+void GoldenCheck::PostExec() {
+  if (golden_path_.empty()) {
+    return;
+  }
+  // The memory only holds the results of the last test of a batch
+  if (VerilatorSimCtrl::GetInstance().InBatchMode()) {
+    std::cerr << "WARNING: The golden check is not supported with --batch."
+              << std::endl;
+    return;
+  }
+
+  std::cout << std::endl << "Golden check of `" << golden_path_ << "'"
+            << std::endl;
+  size_t total = 0;
+  try {
+    for (const Entry &entry : ReadGolden()) {
+      uint64_t addr, size;
+      if (!DpiMemUtil::FindElfSymbol(elf_path_, entry.name, addr, size)) {
+        std::cout << "  " << entry.name << ": no such symbol in `" << elf_path_
+                  << "'" << std::endl;
+        failed_ = true;
+        continue;
+      }
+      std::vector<uint8_t> data(entry.data.size());
+      if (!mem_util_->ReadMemory(mem_name_, addr, data.size(), data.data())) {
+        std::cerr << "ERROR: The memory `" << mem_name_
+                  << "' has no backdoor to read it." << std::endl;
+        failed_ = true;
+        return;
+      }
+      size_t mismatches = Compare(entry, data);
+      std::cout << "  " << entry.name << ": " << data.size() / entry.elem_byte
+                << " elements, " << mismatches << " mismatches" << std::endl;
+      total += mismatches;
+    }
+  } catch (const std::exception &err) {
+    std::cerr << "ERROR: " << err.what() << std::endl;
+    failed_ = true;
+    return;
+  }
+  failed_ |= total != 0;
+  std::cout << "Golden check " << (failed_ ? "FAILED" : "passed") << std::endl;
+}
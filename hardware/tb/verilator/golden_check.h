@@ -0,0 +1,55 @@
+// Copyright 2021 ETH Zurich and University of Bologna.
+// Solderpad Hardware License, Version 0.51, see LICENSE for details.
+// SPDX-License-Identifier: SHL-0.51
+//
+// Description:
+// Check of the results of an application at the end of the simulation. The
+// symbols of the golden file written by the gen_data.py script of the
+// application (apps/common/script/data_emit.py) are looked up in the ELF file,
+// read from the memory through its backdoor, and compared with their golden
+// values, with the tolerances of the golden file.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "dpi_memutil.h"
+#include "sim_ctrl_extension.h"
+
+class GoldenCheck : public SimCtrlExtension {
+ public:
+  // The symbols are read from the memory |mem_name| of |mem_util|
+  GoldenCheck(DpiMemUtil *mem_util, const std::string &mem_name)
+      : mem_util_(mem_util), mem_name_(mem_name), failed_(false) {}
+
+  bool ParseCLIArguments(int argc, char **argv, bool &exit_app) override;
+
+  void PostExec() override;
+
+  // Some symbol did not match its golden value, or could not be checked
+  bool Failed() const { return failed_; }
+
+ private:
+  struct Entry {
+    std::string name;
+    // 'f' (floating point), 'i' (signed), or 'u' (unsigned) elements
+    char kind;
+    uint8_t elem_byte;
+    double rtol, atol;
+    std::vector<uint8_t> data;
+  };
+
+  DpiMemUtil *mem_util_;
+  std::string mem_name_;
+  std::string golden_path_, elf_path_;
+  bool failed_;
+
+  // Read the golden file, or raise a std::runtime_error
+  std::vector<Entry> ReadGolden() const;
+
+  // Compare the bytes of one symbol with its golden entry, and print the first
+  // mismatches. Return the number of mismatching elements.
+  size_t Compare(const Entry &entry, const std::vector<uint8_t> &data) const;
+};
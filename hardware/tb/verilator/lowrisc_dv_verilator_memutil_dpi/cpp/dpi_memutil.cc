@@ -13,7 +13,10 @@
 #include <sys/stat.h>
 #include <unistd.h>
 #include <vector>
+#include <verilated.h>
+#include <verilated_syms.h>
 
+#include "sparse_mem.h"
 #include "sv_scoped.h"
 
 // DPI Exports
@@ -64,7 +67,9 @@ class ElfFile {
       throw ElfError(path, "could not open file.");
     }
 
-    ptr_ = elf_begin(fd_, ELF_C_READ, NULL);
+    // Map the file instead of reading it, so that the segments can be copied
+    // straight from the file to the memories
+    ptr_ = elf_begin(fd_, ELF_C_READ_MMAP, NULL);
     if (!ptr_) {
       close(fd_);
       throw ElfError(path, elf_errmsg(-1));
@@ -97,6 +102,33 @@ class ElfFile {
     return phdrs;
   }
 
+  // Look |sym| up in the symbol tables
+  bool FindSymbol(const std::string &sym, Elf64_Addr &addr, Elf64_Xword &size) {
+    Elf_Scn *scn = nullptr;
+    while ((scn = elf_nextscn(ptr_, scn))) {
+      const Elf64_Shdr *shdr = elf64_getshdr(scn);
+      if (!shdr)
+        throw ElfError(path_, elf_errmsg(-1));
+      if (shdr->sh_type != SHT_SYMTAB || !shdr->sh_entsize)
+        continue;
+
+      Elf_Data *data = elf_getdata(scn, nullptr);
+      if (!data)
+        throw ElfError(path_, elf_errmsg(-1));
+      const Elf64_Sym *syms = static_cast<const Elf64_Sym *>(data->d_buf);
+      size_t num = data->d_size / sizeof(Elf64_Sym);
+      for (size_t i = 0; i < num; ++i) {
+        const char *name = elf_strptr(ptr_, shdr->sh_link, syms[i].st_name);
+        if (name && sym == name && syms[i].st_shndx != SHN_UNDEF) {
+          addr = syms[i].st_value;
+          size = syms[i].st_size;
+          return true;
+        }
+      }
+    }
+    return false;
+  }
+
   std::string path_;
   int fd_;
   Elf *ptr_;
@@ -110,6 +142,8 @@ static MemImageType GetMemImageTypeByName(const std::string &name) {
     return kMemImageElf;
   if (name == "vmem")
     return kMemImageVmem;
+  if (name == "bin")
+    return kMemImageBin;
 
   std::ostringstream oss;
   oss << "Unknown image type: `" << name << "'.";
@@ -306,7 +340,145 @@ static void WriteSegment(const MemArea &m, uint32_t offset,
   }
 }
 
+// Memory backdoor: the backing array of the memory at the scope of area m.
+// This requires the `sram' array of the memory to be public (see
+// waiver.vlt), and its words to be laid out as the bytes of the memory image,
+// i.e., the memory width must be a multiple of 32 bits. Sparse memories
+// (sparse_mem.h) are written through their store instead.
+struct MemBackdoor {
+  uint8_t *data;
+  size_t size_byte;
+  SparseMem *sparse;
+};
+
+// Look up the backdoor of the memory area m. Return false if the memory
+// cannot be accessed through a backdoor.
+static bool GetMemBackdoor(const MemArea &m, MemBackdoor &backdoor) {
+  backdoor.sparse = SparseMemFind(m.location);
+  if (backdoor.sparse) {
+    backdoor.data = nullptr;
+    backdoor.size_byte = backdoor.sparse->GetSize();
+    return true;
+  }
+
+  // In Verilator, an svScope is a pointer to the VerilatedScope
+  const VerilatedScope *scope = static_cast<const VerilatedScope *>(
+      svGetScopeFromName(m.location.c_str()));
+  if (!scope) {
+    return false;
+  }
+
+  VerilatedVar *sram = scope->varFind("sram");
+  if (!sram || sram->udims() != 1 || sram->entSize() != m.width_byte ||
+      (m.width_byte % 4)) {
+    return false;
+  }
+
+  backdoor.data = static_cast<uint8_t *>(sram->datap());
+  backdoor.size_byte = sram->totalSize();
+  return true;
+}
+
+// Copy a segment of the ELF file straight to the memory backdoor, zeroing
+// the part of the segment that is not backed by the file (e.g., .bss).
+static void WriteSegmentBackdoor(const MemBackdoor &backdoor,
+                                 const std::string &filepath, uint64_t offset,
+                                 const char *seg_data, size_t file_sz,
+                                 size_t mem_sz) {
+  if (offset + mem_sz > backdoor.size_byte) {
+    std::ostringstream oss;
+    oss << "segment at offset 0x" << std::hex << offset << " of size 0x"
+        << mem_sz << " does not fit in the memory of size 0x"
+        << backdoor.size_byte << ".";
+    throw ElfError(filepath, oss.str());
+  }
+
+  size_t src_len = std::min(file_sz, mem_sz);
+  if (backdoor.sparse) {
+    backdoor.sparse->Write(offset, reinterpret_cast<const uint8_t *>(seg_data),
+                           src_len);
+    backdoor.sparse->Zero(offset + src_len, mem_sz - src_len);
+    return;
+  }
+  memcpy(backdoor.data + offset, seg_data, src_len);
+  memset(backdoor.data + offset + src_len, 0, mem_sz - src_len);
+}
+
+// Write the ELF file to the memory m through its backdoor. As with
+// FlattenElfFile, the lowest addressed segment is placed at offset 0 and the
+// gaps between segments are zeroed.
+static void WriteElfToMemBackdoor(const MemArea &m, const MemBackdoor &backdoor,
+                                  const std::string &filepath) {
+  ElfFile elf(filepath);
+
+  size_t phnum = elf.GetPhdrNum();
+  const Elf64_Phdr *phdrs = elf.GetPhdrs();
+
+  size_t file_size;
+  const char *file_data = elf_rawfile(elf.ptr_, &file_size);
+  assert(file_data);
+
+  bool any = false;
+  Elf64_Addr low = 0, high = 0;
+  for (size_t i = 0; i < phnum; i++) {
+    const Elf64_Phdr &phdr = phdrs[i];
+    if (phdr.p_type != PT_LOAD || phdr.p_memsz == 0 || phdr.p_filesz == 0) {
+      continue;
+    }
+    if (!any || phdr.p_paddr < low) {
+      low = phdr.p_paddr;
+    }
+    if (!any || phdr.p_paddr + (phdr.p_memsz - 1) > high) {
+      high = phdr.p_paddr + (phdr.p_memsz - 1);
+    }
+    any = true;
+  }
+
+  if (!any) {
+    return;
+  }
+
+  std::cout << "Backdoor load of `" << filepath << "' into `" << m.name
+            << "' (0x" << std::hex << high - low + 1 << " bytes)" << std::dec
+            << std::endl;
+
+  if (high - low + 1 > backdoor.size_byte) {
+    std::ostringstream oss;
+    oss << "image of size 0x" << std::hex << high - low + 1
+        << " does not fit in the memory of size 0x" << backdoor.size_byte
+        << ".";
+    throw ElfError(filepath, oss.str());
+  }
+  if (backdoor.sparse) {
+    backdoor.sparse->Zero(0, high - low + 1);
+  } else {
+    memset(backdoor.data, 0, high - low + 1);
+  }
+
+  for (size_t i = 0; i < phnum; i++) {
+    const Elf64_Phdr &phdr = phdrs[i];
+    if (phdr.p_type != PT_LOAD || phdr.p_memsz == 0 || phdr.p_filesz == 0) {
+      continue;
+    }
+    if (file_size < phdr.p_offset + phdr.p_filesz) {
+      std::ostringstream oss;
+      oss << "phdr for segment " << i << " claims to end at offset 0x"
+          << std::hex << phdr.p_offset + phdr.p_filesz
+          << ", but the file only has size 0x" << file_size << ".";
+      throw ElfError(filepath, oss.str());
+    }
+    WriteSegmentBackdoor(backdoor, filepath, phdr.p_paddr - low,
+                         file_data + phdr.p_offset, phdr.p_filesz,
+                         phdr.p_memsz);
+  }
+}
+
 static void WriteElfToMem(const MemArea &m, const std::string &filepath) {
+  MemBackdoor backdoor;
+  if (GetMemBackdoor(m, backdoor)) {
+    WriteElfToMemBackdoor(m, backdoor, filepath);
+    return;
+  }
   WriteSegment(m, 0, FlattenElfFile(filepath));
 }
 
@@ -316,6 +488,67 @@ static void WriteVmemToMem(const MemArea &m, const std::string &filepath) {
   simutil_memload(filepath.data());
 }
 
+// Write the raw binary file at filepath to the memory m, from the address
+// addr (an LMA if m has an address location, an offset otherwise), or from the
+// start of m if addr is 0. The rest of the memory is left untouched, so that
+// the binary can be loaded on top of an ELF file.
+static void WriteBinToMem(const MemArea &m, const std::string &filepath,
+                          uint32_t addr) {
+  int fd = open(filepath.c_str(), O_RDONLY, 0);
+  if (fd < 0) {
+    std::ostringstream oss;
+    oss << "Failed to open file `" << filepath << "'.";
+    throw std::runtime_error(oss.str());
+  }
+  struct stat st;
+  if (fstat(fd, &st) < 0) {
+    close(fd);
+    std::ostringstream oss;
+    oss << "Failed to stat file `" << filepath << "'.";
+    throw std::runtime_error(oss.str());
+  }
+  std::vector<uint8_t> data(st.st_size);
+  ssize_t got = read(fd, data.data(), data.size());
+  close(fd);
+  if (got != (ssize_t)data.size()) {
+    std::ostringstream oss;
+    oss << "Failed to read file `" << filepath << "'.";
+    throw std::runtime_error(oss.str());
+  }
+
+  uint32_t offset = addr;
+  if (addr && m.addr_loc.size) {
+    if (addr < m.addr_loc.base) {
+      std::ostringstream oss;
+      oss << "Address 0x" << std::hex << addr << " of `" << filepath
+          << "' is below the memory `" << m.name << "'.";
+      throw std::runtime_error(oss.str());
+    }
+    offset = addr - m.addr_loc.base;
+  }
+
+  MemBackdoor backdoor;
+  if (!GetMemBackdoor(m, backdoor)) {
+    WriteSegment(m, offset, data);
+    return;
+  }
+  if ((uint64_t)offset + data.size() > backdoor.size_byte) {
+    std::ostringstream oss;
+    oss << "Binary `" << filepath << "' of size 0x" << std::hex << data.size()
+        << " at offset 0x" << offset << " does not fit in the memory `"
+        << m.name << "' of size 0x" << backdoor.size_byte << ".";
+    throw std::runtime_error(oss.str());
+  }
+  std::cout << "Backdoor load of `" << filepath << "' into `" << m.name
+            << "' at offset 0x" << std::hex << offset << " (0x" << data.size()
+            << " bytes)" << std::dec << std::endl;
+  if (backdoor.sparse) {
+    backdoor.sparse->Write(offset, data.data(), data.size());
+  } else {
+    memcpy(backdoor.data + offset, data.data(), data.size());
+  }
+}
+
 // Merge seg0 and seg1, overwriting any overlapping data in seg0 with
 // that from seg1. rng0/rng1 is the base and top address of seg0/seg1,
 // respectively.
@@ -496,7 +729,7 @@ void DpiMemUtil::PrintMemRegions() const {
 
 void DpiMemUtil::LoadFileToNamedMem(bool verbose, const std::string &name,
                                     const std::string &filepath,
-                                    MemImageType type) {
+                                    MemImageType type, uint32_t addr) {
   // If the image type isn't specified, try to figure it out from the file name
   if (type == kMemImageUnknown) {
     type = DetectMemImageType(filepath);
@@ -528,6 +761,9 @@ void DpiMemUtil::LoadFileToNamedMem(bool verbose, const std::string &name,
       case kMemImageVmem:
         WriteVmemToMem(m, filepath);
         break;
+      case kMemImageBin:
+        WriteBinToMem(m, filepath, addr);
+        break;
       default:
         assert(0);
     }
@@ -539,7 +775,157 @@ void DpiMemUtil::LoadFileToNamedMem(bool verbose, const std::string &name,
   }
 }
 
+bool DpiMemUtil::LoadElfBackdoor(bool verbose, const std::string &filepath) {
+  ElfFile elf(filepath);
+
+  size_t file_size;
+  const char *file_data = elf_rawfile(elf.ptr_, &file_size);
+  assert(file_data);
+
+  size_t phnum = elf.GetPhdrNum();
+  const Elf64_Phdr *phdrs = elf.GetPhdrs();
+
+  // Check that all the segments target memories with a backdoor before
+  // writing anything, so that we can fall back to the staging area
+  std::vector<std::pair<const MemArea *, MemBackdoor>> targets(phnum);
+  for (size_t i = 0; i < phnum; ++i) {
+    const Elf64_Phdr &phdr = phdrs[i];
+    if (phdr.p_type != PT_LOAD || phdr.p_memsz == 0)
+      continue;
+
+    const MemArea &mem_area =
+        GetRegionForSegment(filepath, i, phdr.p_paddr, phdr.p_memsz);
+    if (!GetMemBackdoor(mem_area, targets[i].second))
+      return false;
+    targets[i].first = &mem_area;
+
+    size_t off_end = (size_t)phdr.p_offset + phdr.p_filesz;
+    if (file_size < off_end) {
+      std::ostringstream oss;
+      oss << "phdr for segment " << i << " claims to end at offset 0x"
+          << std::hex << off_end - 1 << ", but the file only has size 0x"
+          << file_size << ".";
+      throw ElfError(filepath, oss.str());
+    }
+  }
+
+  for (size_t i = 0; i < phnum; ++i) {
+    const MemArea *mem_area = targets[i].first;
+    if (!mem_area)
+      continue;
+
+    const Elf64_Phdr &phdr = phdrs[i];
+    if (verbose) {
+      std::cout << "Loading segment " << i << " from ELF file `" << filepath
+                << "' into memory `" << mem_area->name << "' (backdoor)."
+                << std::endl;
+    }
+    WriteSegmentBackdoor(targets[i].second, filepath,
+                         phdr.p_paddr - mem_area->addr_loc.base,
+                         file_data + phdr.p_offset, phdr.p_filesz,
+                         phdr.p_memsz);
+  }
+
+  return true;
+}
+
+bool DpiMemUtil::ClearMemory(const std::string &name) {
+  auto it = name_to_mem_.find(name);
+  if (it == name_to_mem_.end()) {
+    std::ostringstream oss;
+    oss << "`" << name
+        << ("' is not the name of a known memory region. "
+            "Run with --meminit=list to get a list.");
+    throw std::runtime_error(oss.str());
+  }
+
+  MemBackdoor backdoor;
+  if (!GetMemBackdoor(it->second, backdoor)) {
+    return false;
+  }
+  // Dropping the pages of a sparse memory is cheaper than zeroing them
+  if (backdoor.sparse) {
+    backdoor.sparse->Clear();
+  } else {
+    memset(backdoor.data, 0, backdoor.size_byte);
+  }
+  return true;
+}
+
+bool DpiMemUtil::ReadMemory(const std::string &name, uint32_t addr,
+                            size_t len, uint8_t *data) {
+  auto it = name_to_mem_.find(name);
+  if (it == name_to_mem_.end()) {
+    std::ostringstream oss;
+    oss << "`" << name
+        << ("' is not the name of a known memory region. "
+            "Run with --meminit=list to get a list.");
+    throw std::runtime_error(oss.str());
+  }
+
+  MemBackdoor backdoor;
+  if (!GetMemBackdoor(it->second, backdoor)) {
+    return false;
+  }
+  const MemAreaLoc &loc = it->second.addr_loc;
+  uint64_t offset = (uint64_t)addr - loc.base;
+  if (addr < loc.base || offset + len > backdoor.size_byte) {
+    std::ostringstream oss;
+    oss << "The 0x" << std::hex << len << " bytes at address 0x" << addr
+        << " are not in the memory `" << name << "'.";
+    throw std::runtime_error(oss.str());
+  }
+  if (backdoor.sparse) {
+    backdoor.sparse->Read(offset, data, len);
+  } else {
+    memcpy(data, backdoor.data + offset, len);
+  }
+  return true;
+}
+
+uint8_t *DpiMemUtil::GetBackdoorPage(const std::string &name, uint64_t addr) {
+  auto it = name_to_mem_.find(name);
+  if (it == name_to_mem_.end()) {
+    std::ostringstream oss;
+    oss << "`" << name
+        << ("' is not the name of a known memory region. "
+            "Run with --meminit=list to get a list.");
+    throw std::runtime_error(oss.str());
+  }
+
+  MemBackdoor backdoor;
+  if (!GetMemBackdoor(it->second, backdoor)) {
+    return nullptr;
+  }
+  const MemAreaLoc &loc = it->second.addr_loc;
+  uint64_t offset = addr - loc.base;
+  if (addr < loc.base || offset >= backdoor.size_byte) {
+    return nullptr;
+  }
+  if (backdoor.sparse) {
+    return backdoor.sparse->GetPageData(offset);
+  }
+  return backdoor.data + offset / SparseMem::kPageBytes * SparseMem::kPageBytes;
+}
+
+bool DpiMemUtil::FindElfSymbol(const std::string &filepath,
+                               const std::string &sym, uint64_t &addr,
+                               uint64_t &size) {
+  ElfFile elf(filepath);
+  Elf64_Addr sym_addr;
+  Elf64_Xword sym_size;
+  if (!elf.FindSymbol(sym, sym_addr, sym_size))
+    return false;
+  addr = sym_addr;
+  size = sym_size;
+  return true;
+}
+
 void DpiMemUtil::LoadElfToMemories(bool verbose, const std::string &filepath) {
+  // Copy the segments straight from the mapped ELF file, if possible
+  if (LoadElfBackdoor(verbose, filepath))
+    return;
+
   // Load the contents of the ELF file into the staging area
   StageElf(verbose, filepath);
 
@@ -15,6 +15,7 @@ enum MemImageType {
   kMemImageUnknown = 0,
   kMemImageElf,
   kMemImageVmem,
+  kMemImageBin,
 };
 
 // The "load" location of a memory area. base is the lowest address in
@@ -119,10 +120,13 @@ class DpiMemUtil {
 
   /**
    * Load the file at filepath into the named memory. If type is
-   * kMemImageUnknown, the file type is determined from the path.
+   * kMemImageUnknown, the file type is determined from the path. A raw binary
+   * (kMemImageBin) is loaded at the address addr, or at the start of the
+   * memory if addr is 0.
    */
   void LoadFileToNamedMem(bool verbose, const std::string &name,
-                          const std::string &filepath, MemImageType type);
+                          const std::string &filepath, MemImageType type,
+                          uint32_t addr = 0);
 
   /**
    * Load an ELF file, placing segments in memories by LMA.
@@ -131,6 +135,59 @@ class DpiMemUtil {
    */
   void LoadElfToMemories(bool verbose, const std::string &filepath);
 
+  /**
+   * Load an ELF file, copying segments straight into the backing arrays of the
+   * memories picked by LMA.
+   *
+   * Returns false without loading anything if any segment targets a memory
+   * that cannot be accessed through a backdoor.
+   */
+  bool LoadElfBackdoor(bool verbose, const std::string &filepath);
+
+  /**
+   * Zero the named memory through its backdoor, e.g. between the tests of a
+   * batch run.
+   *
+   * Returns false if the memory cannot be accessed through a backdoor. Raises
+   * a std::runtime_error if |name| is not a known memory region.
+   */
+  bool ClearMemory(const std::string &name);
+
+  /**
+   * Read |len| bytes at the address |addr| of the named memory through its
+   * backdoor, e.g. to check the results at the end of the simulation.
+   *
+   * Returns false if the memory cannot be accessed through a backdoor. Raises
+   * a std::runtime_error if |name| is not a known memory region, or if the
+   * bytes are not in the memory.
+   */
+  bool ReadMemory(const std::string &name, uint32_t addr, size_t len,
+                  uint8_t *data);
+
+  /**
+   * Get a pointer to the 4 KiB page of the named memory that contains the
+   * address |addr|, through its backdoor, for another simulator that shares
+   * the memory with the design (e.g. Spike as the scalar core). The page of a
+   * sparse memory is allocated if required, and stays valid until the memory
+   * is cleared.
+   *
+   * Returns nullptr if the memory cannot be accessed through a backdoor, or if
+   * |addr| is not in the memory. Raises a std::runtime_error if |name| is not
+   * a known memory region.
+   */
+  uint8_t *GetBackdoorPage(const std::string &name, uint64_t addr);
+
+  /**
+   * Find the address and the size of the symbol |sym| in the symbol table of
+   * the ELF file at |filepath|.
+   *
+   * Returns false if there is no such symbol. Raises a std::exception if the
+   * file cannot be read.
+   */
+  static bool FindElfSymbol(const std::string &filepath,
+                            const std::string &sym, uint64_t &addr,
+                            uint64_t &size);
+
   /**
    * Load an ELF file into a staging area in this object, which can then be
    * accessed with GetMemoryData().
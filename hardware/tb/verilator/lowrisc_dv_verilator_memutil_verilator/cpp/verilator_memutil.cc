@@ -6,6 +6,7 @@
 
 #include <array>
 #include <cassert>
+#include <cstdlib>
 #include <cstring>
 #include <getopt.h>
 #include <iostream>
@@ -16,16 +17,19 @@
 namespace {
 // An instruction to load the file at filepath to the memory called name. If
 // name is the empty string then type must be kMemImageElf and this is an
-// instruction to load an ELF file, picking memories by LMA.
+// instruction to load an ELF file, picking memories by LMA. A raw binary
+// (kMemImageBin) is loaded at addr, or at the start of the memory if addr is 0.
 struct LoadArg {
   std::string name;
   std::string filepath;
   MemImageType type;
+  uint32_t addr;
 };
 }  // namespace
 
 // Parse a meminit command-line argument. This should be of the form
-// mem_area,file[,type]. Throw a std::runtime_error if something looks wrong.
+// mem_area,file[,type], where type can be bin@addr to load a raw binary at
+// the address addr. Throw a std::runtime_error if something looks wrong.
 static LoadArg ParseMemArg(std::string mem_argument) {
   std::array<std::string, 3> args;
   size_t pos = 0;
@@ -56,10 +60,23 @@ static LoadArg ParseMemArg(std::string mem_argument) {
     throw std::runtime_error(oss.str());
   }
 
+  // The raw binaries can be given a load address, as bin@addr
+  uint32_t addr = 0;
+  if (2 <= i && args[2].compare(0, 4, "bin@") == 0) {
+    char *end;
+    addr = strtoul(args[2].c_str() + 4, &end, 0);
+    if (*end || end == args[2].c_str() + 4) {
+      std::ostringstream oss;
+      oss << "invalid load address in: `" << mem_argument << "'.";
+      throw std::runtime_error(oss.str());
+    }
+    args[2] = "bin";
+  }
+
   const char *str_type = (2 <= i) ? args[2].c_str() : nullptr;
   MemImageType type = DpiMemUtil::GetMemImageType(args[1], str_type);
 
-  return {.name = args[0], .filepath = args[1], .type = type};
+  return {.name = args[0], .filepath = args[1], .type = type, .addr = addr};
 }
 
 // Print a usage message to stdout
@@ -73,7 +90,8 @@ static void PrintHelp() {
                "  Initialize the FLASH with FILE (elf/vmem)\n\n"
                "-l|--meminit=NAME,FILE[,TYPE]\n"
                "  Initialize memory region NAME with FILE [of TYPE]\n"
-               "  TYPE is either 'elf' or 'vmem'\n\n"
+               "  TYPE is either 'elf', 'vmem', or 'bin[@ADDR]' (a raw\n"
+               "  binary, loaded at ADDR or at the start of the region)\n\n"
                "-E|--load-elf=FILE\n"
                "  Load ELF file, using segment LMAs to pick memory regions\n\n"
                "-l list|--meminit=list\n"
@@ -123,16 +141,22 @@ bool VerilatorMemUtil::ParseCLIArguments(int argc, char **argv,
       case 0:
         break;
       case 'r':
-        load_args.push_back(
-            {.name = "rom", .filepath = optarg, .type = kMemImageUnknown});
+        load_args.push_back({.name = "rom",
+                             .filepath = optarg,
+                             .type = kMemImageUnknown,
+                             .addr = 0});
         break;
       case 'm':
-        load_args.push_back(
-            {.name = "ram", .filepath = optarg, .type = kMemImageUnknown});
+        load_args.push_back({.name = "ram",
+                             .filepath = optarg,
+                             .type = kMemImageUnknown,
+                             .addr = 0});
         break;
       case 'f':
-        load_args.push_back(
-            {.name = "flash", .filepath = optarg, .type = kMemImageUnknown});
+        load_args.push_back({.name = "flash",
+                             .filepath = optarg,
+                             .type = kMemImageUnknown,
+                             .addr = 0});
         break;
       case 'l':
         if (strcasecmp(optarg, "list") == 0) {
@@ -154,7 +178,7 @@ bool VerilatorMemUtil::ParseCLIArguments(int argc, char **argv,
         break;
       case 'E':
         load_args.push_back(
-            {.name = "", .filepath = optarg, .type = kMemImageElf});
+            {.name = "", .filepath = optarg, .type = kMemImageElf, .addr = 0});
         break;
       case 'h':
         PrintHelp();
@@ -173,7 +197,7 @@ bool VerilatorMemUtil::ParseCLIArguments(int argc, char **argv,
     try {
       if (!arg.name.empty()) {
         mem_util_->LoadFileToNamedMem(verbose, arg.name, arg.filepath,
-                                      arg.type);
+                                      arg.type, arg.addr);
       } else {
         assert(arg.type == kMemImageElf);
         mem_util_->LoadElfToMemories(verbose, arg.filepath);
@@ -4,10 +4,15 @@
 
 #include "verilator_sim_ctrl.h"
 
+#include <cstring>
+#include <cxxabi.h>
+#include <fstream>
 #include <getopt.h>
 #include <iostream>
 #include <signal.h>
+#include <sys/resource.h>
 #include <sys/stat.h>
+#include <typeinfo>
 #include <verilated.h>
 
 // This is defined by Verilator and passed through the command line
@@ -22,6 +27,36 @@
  */
 double sc_time_stamp() { return VerilatorSimCtrl::GetInstance().GetTime(); }
 
+namespace {
+
+/**
+ * Accumulate the host time spent in a scope, if enabled
+ */
+class ProfileScope {
+ public:
+  ProfileScope(bool enabled, std::chrono::steady_clock::duration &acc)
+      : acc_(enabled ? &acc : nullptr) {
+    if (acc_) {
+      begin_ = std::chrono::steady_clock::now();
+    }
+  }
+  ~ProfileScope() {
+    if (acc_) {
+      *acc_ += std::chrono::steady_clock::now() - begin_;
+    }
+  }
+
+ private:
+  std::chrono::steady_clock::duration *acc_;
+  std::chrono::steady_clock::time_point begin_;
+};
+
+double Seconds(std::chrono::steady_clock::duration d) {
+  return std::chrono::duration<double>(d).count();
+}
+
+}  // namespace
+
 #ifdef VL_USER_STOP
 /**
  * A simulation stop was requested, e.g. through $stop() or $error()
@@ -64,6 +99,14 @@ bool VerilatorSimCtrl::ParseCommandArgs(int argc, char **argv, bool &exit_app) {
   const struct option long_options[] = {
       {"term-after-cycles", required_argument, nullptr, 'c'},
       {"trace", no_argument, nullptr, 't'},
+      {"trace-from-cycle", required_argument, nullptr, 'F'},
+      {"trace-to-cycle", required_argument, nullptr, 'T'},
+      {"trace-on-event-trigger", no_argument, nullptr, 'E'},
+      {"save-checkpoint-at", required_argument, nullptr, 'S'},
+      {"restore-checkpoint", required_argument, nullptr, 'R'},
+      {"profile", optional_argument, nullptr, 'P'},
+      {"stats-json", required_argument, nullptr, 'J'},
+      {"batch", required_argument, nullptr, 'B'},
       {"help", no_argument, nullptr, 'h'},
       {nullptr, no_argument, nullptr, 0}};
 
@@ -88,9 +131,86 @@ bool VerilatorSimCtrl::ParseCommandArgs(int argc, char **argv, bool &exit_app) {
         }
         TraceOn();
         break;
+      case 'F':
+      case 'T':
+      case 'E':
+        if (!tracing_possible_) {
+          std::cerr << "ERROR: Tracing has not been enabled at compile time."
+                    << std::endl;
+          exit_app = true;
+          return false;
+        }
+        if (c == 'F') {
+          trace_from_cycle_ = strtoul(optarg, nullptr, 0);
+        } else if (c == 'T') {
+          trace_to_cycle_ = strtoul(optarg, nullptr, 0);
+        } else {
+          if (!sig_event_trigger_) {
+            std::cerr << "ERROR: No event trigger signal has been registered."
+                      << std::endl;
+            exit_app = true;
+            return false;
+          }
+          trace_on_event_ = true;
+        }
+        break;
       case 'c':
         term_after_cycles_ = atoi(optarg);
         break;
+      case 'P':
+        profiling_ = true;
+        if (optarg) {
+          profile_interval_cycles_ = strtoul(optarg, nullptr, 0);
+        }
+        break;
+      case 'J':
+        stats_json_path_ = optarg;
+        break;
+      case 'B':
+        if (!batch_loader_) {
+          std::cerr << "ERROR: No batch loader has been registered."
+                    << std::endl;
+          exit_app = true;
+          return false;
+        }
+        if (!ReadBatchFile(optarg)) {
+          std::cerr << "ERROR: Could not read a list of ELF files from `"
+                    << optarg << "'." << std::endl;
+          exit_app = true;
+          return false;
+        }
+        break;
+      case 'S':
+        if (!VM_SAVABLE) {
+          std::cerr << "ERROR: Checkpointing has not been enabled at compile "
+                       "time."
+                    << std::endl;
+          exit_app = true;
+          return false;
+        }
+        if (strcmp(optarg, "event_trigger") == 0) {
+          if (!sig_event_trigger_) {
+            std::cerr << "ERROR: No event trigger signal has been registered."
+                      << std::endl;
+            exit_app = true;
+            return false;
+          }
+          checkpoint_on_event_ = true;
+        } else {
+          checkpoint_cycle_ = strtoul(optarg, nullptr, 0);
+        }
+        checkpoint_pending_ = true;
+        break;
+      case 'R':
+        // Restore right away, so that the memory loads of the extensions are
+        // applied on top of the restored state
+        if (!RestoreCheckpoint(optarg)) {
+          std::cerr << "ERROR: Could not restore checkpoint `" << optarg
+                    << "'." << std::endl;
+          exit_app = true;
+          return false;
+        }
+        break;
       case 'h':
         PrintHelp();
         exit_app = true;
@@ -143,6 +263,16 @@ void VerilatorSimCtrl::RunSimulation() {
   }
   // Print simulation speed info
   PrintStatistics();
+  if (!stats_json_path_.empty()) {
+    WriteStatsJson();
+  }
+  if (!batch_elfs_.empty()) {
+    // The batch can be cut short, e.g. by $stop() or CTRL-c
+    if (batch_results_.size() < batch_elfs_.size()) {
+      simulation_success_ = false;
+    }
+    PrintBatchResults();
+  }
   // Print helper message for tracing
   if (TracingEverEnabled()) {
     std::cout << std::endl
@@ -180,7 +310,32 @@ VerilatorSimCtrl::VerilatorSimCtrl()
       request_stop_(false),
       simulation_success_(true),
       tracer_(VerilatedTracer()),
-      term_after_cycles_(0) {}
+      term_after_cycles_(0),
+      sig_event_trigger_(nullptr),
+      checkpoint_pending_(false),
+      checkpoint_on_event_(false),
+      checkpoint_cycle_(0),
+      trace_on_event_(false),
+      last_event_trigger_(0),
+      trace_from_cycle_(0),
+      trace_to_cycle_(0),
+      profiling_(false),
+      profile_interval_cycles_(100000),
+      time_eval_(0),
+      time_trace_(0),
+      last_sample_cycle_(0),
+      sig_exit_(nullptr) {}
+
+void VerilatorSimCtrl::SetEventTrigger(QData *sig_event_trigger) {
+  sig_event_trigger_ = sig_event_trigger;
+}
+
+void VerilatorSimCtrl::SetExitSignal(QData *sig_exit) { sig_exit_ = sig_exit; }
+
+void VerilatorSimCtrl::SetBatchLoader(
+    std::function<bool(const std::string &)> loader) {
+  batch_loader_ = loader;
+}
 
 void VerilatorSimCtrl::RegisterSignalHandler() {
   struct sigaction sigIntHandler;
@@ -214,10 +369,37 @@ void VerilatorSimCtrl::PrintHelp() const {
   std::cout << "Execute a simulation model for " << GetName() << "\n\n";
   if (tracing_possible_) {
     std::cout << "-t|--trace\n"
-                 "  Write a trace file from the start\n\n";
+                 "  Write a trace file from the start\n\n"
+                 "--trace-from-cycle=N\n"
+                 "  Start tracing after N cycles\n\n"
+                 "--trace-to-cycle=N\n"
+                 "  Stop tracing after N cycles\n\n"
+                 "--trace-on-event-trigger\n"
+                 "  Start tracing when the software writes 1 to the event "
+                 "trigger, and stop\n"
+                 "  when it writes -1 to it\n\n";
+  }
+  if (VM_SAVABLE) {
+    std::cout << "--save-checkpoint-at=N|event_trigger\n"
+                 "  Save a checkpoint after N cycles, or when the software "
+                 "raises the event trigger\n\n"
+                 "--restore-checkpoint=FILE\n"
+                 "  Start the simulation from the checkpoint FILE\n\n";
   }
   std::cout << "-c|--term-after-cycles=N\n"
                "  Terminate simulation after N cycles\n\n"
+               "--profile[=N]\n"
+               "  Attribute the host time to the model, the tracing, and "
+               "each extension,\n"
+               "  and sample the simulation speed every N cycles (default: "
+               "100000)\n\n"
+               "--stats-json=FILE\n"
+               "  Write the simulation statistics to FILE, in JSON\n\n"
+               "--batch=FILE\n"
+               "  Run the ELF files listed in FILE, one per line, one after "
+               "the other,\n"
+               "  resetting the design and clearing the memories between "
+               "them\n\n"
                "-h|--help\n"
                "  Show help\n\n"
                "All arguments are passed to the design and can be used "
@@ -258,9 +440,120 @@ void VerilatorSimCtrl::PrintStatistics() const {
             << "(" << speed_khz << " kHz)" << std::endl;
 
   int trace_size_byte;
-  if (tracing_enabled_ && FileSize(GetTraceFileName(), trace_size_byte)) {
+  if (tracing_ever_enabled_ && FileSize(GetTraceFileName(), trace_size_byte)) {
     std::cout << "Trace file size:  " << trace_size_byte << " B" << std::endl;
   }
+  std::cout << "Peak RSS:         " << GetPeakRssKb() << " KiB" << std::endl;
+
+  if (!profiling_) {
+    return;
+  }
+
+  // Host time breakdown, as a fraction of the wallclock time
+  double wall_s = GetExecutionTimeMs() / 1000.0;
+  double other_s = wall_s - Seconds(time_eval_) - Seconds(time_trace_);
+  auto print_share = [wall_s](const std::string &name, double s) {
+    std::cout << "  " << name << ": " << s << " s";
+    if (wall_s > 0) {
+      std::cout << " (" << 100.0 * s / wall_s << " %)";
+    }
+    std::cout << std::endl;
+  };
+  std::cout << std::endl
+            << "Host time" << std::endl
+            << "=========" << std::endl;
+  print_share("eval()", Seconds(time_eval_));
+  print_share("Trace()", Seconds(time_trace_));
+  for (size_t i = 0; i < time_extensions_.size(); ++i) {
+    print_share(GetExtensionName(i) + "::OnClock()",
+                Seconds(time_extensions_[i]));
+    other_s -= Seconds(time_extensions_[i]);
+  }
+  print_share("other", other_s);
+
+  if (!profile_samples_.empty()) {
+    double min_khz = profile_samples_[0].speed_khz;
+    double max_khz = min_khz;
+    for (const ProfileSample &s : profile_samples_) {
+      min_khz = std::min(min_khz, s.speed_khz);
+      max_khz = std::max(max_khz, s.speed_khz);
+    }
+    std::cout << "Simulation speed over " << profile_samples_.size()
+              << " samples of " << profile_interval_cycles_
+              << " cycles: " << min_khz << " to " << max_khz << " kHz"
+              << std::endl;
+  }
+}
+
+void VerilatorSimCtrl::WriteStatsJson() const {
+  std::ofstream os(stats_json_path_);
+  if (!os) {
+    std::cerr << "ERROR: Could not write " << stats_json_path_ << std::endl;
+    return;
+  }
+
+  double wall_s = GetExecutionTimeMs() / 1000.0;
+  os << "{\n"
+     << "  \"cycles\": " << time_ / 2 << ",\n"
+     << "  \"wall_time_s\": " << wall_s << ",\n"
+     << "  \"speed_khz\": " << (wall_s > 0 ? time_ / 2 / wall_s / 1000.0 : 0)
+     << ",\n"
+     << "  \"peak_rss_kb\": " << GetPeakRssKb() << ",\n"
+     << "  \"tracing\": " << (tracing_ever_enabled_ ? "true" : "false");
+  if (profiling_) {
+    os << ",\n"
+       << "  \"profile\": {\n"
+       << "    \"eval_s\": " << Seconds(time_eval_) << ",\n"
+       << "    \"trace_s\": " << Seconds(time_trace_) << ",\n"
+       << "    \"extensions\": [";
+    for (size_t i = 0; i < time_extensions_.size(); ++i) {
+      os << (i ? ", " : "") << "{\"name\": \"" << GetExtensionName(i)
+         << "\", \"on_clock_s\": " << Seconds(time_extensions_[i]) << "}";
+    }
+    os << "],\n"
+       << "    \"interval_cycles\": " << profile_interval_cycles_ << ",\n"
+       << "    \"samples\": [";
+    for (size_t i = 0; i < profile_samples_.size(); ++i) {
+      os << (i ? ", " : "") << "{\"cycle\": " << profile_samples_[i].cycle
+         << ", \"speed_khz\": " << profile_samples_[i].speed_khz << "}";
+    }
+    os << "]\n"
+       << "  }";
+  }
+  os << "\n}\n";
+}
+
+void VerilatorSimCtrl::ProfileSampleIfRequired() {
+  unsigned long cycle = time_ / 2;
+  if (!profiling_ || (time_ % 2) || !profile_interval_cycles_ ||
+      cycle - last_sample_cycle_ < profile_interval_cycles_) {
+    return;
+  }
+
+  std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+  double s = Seconds(now - last_sample_time_);
+  profile_samples_.push_back(
+      {cycle, s > 0 ? (cycle - last_sample_cycle_) / s / 1000.0 : 0});
+  last_sample_time_ = now;
+  last_sample_cycle_ = cycle;
+}
+
+long VerilatorSimCtrl::GetPeakRssKb() const {
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0) {
+    return 0;
+  }
+  // KiB on Linux
+  return usage.ru_maxrss;
+}
+
+std::string VerilatorSimCtrl::GetExtensionName(size_t idx) const {
+  const char *mangled = typeid(*extension_array_[idx]).name();
+  int status;
+  char *demangled = abi::__cxa_demangle(mangled, nullptr, nullptr, &status);
+  std::string name = status == 0 ? demangled : mangled;
+  free(demangled);
+  return name;
 }
 
 const char *VerilatorSimCtrl::GetTraceFileName() const {
@@ -289,12 +582,26 @@ void VerilatorSimCtrl::Run() {
             << "Simulation running, end by pressing CTRL-c." << std::endl;
 
   time_begin_ = std::chrono::steady_clock::now();
+  last_sample_time_ = time_begin_;
+  last_sample_cycle_ = time_ / 2;
+  time_extensions_.assign(extension_array_.size(),
+                          std::chrono::steady_clock::duration(0));
   UnsetReset();
 
   unsigned long start_reset_cycle_ = initial_reset_delay_cycles_;
   unsigned long end_reset_cycle_ = start_reset_cycle_ + reset_duration_cycles_;
 
-  while (1) {
+  // In batch mode, the timeout applies to each test
+  bool batch = !batch_elfs_.empty();
+  unsigned long test_start_cycle = 0;
+  if (batch && !LoadNextBatchTest()) {
+    std::cout << "No test of the batch could be loaded, shutting down "
+                 "simulation."
+              << std::endl;
+    RequestStop(false);
+  }
+
+  while (!request_stop_) {
     unsigned long cycle_ = time_ / 2;
 
     if (cycle_ == start_reset_cycle_) {
@@ -307,22 +614,57 @@ void VerilatorSimCtrl::Run() {
 
     // Call all extension on-clock methods
     if (*sig_clk_) {
-      for (auto it = extension_array_.begin(); it != extension_array_.end();
-           ++it) {
-        (*it)->OnClock(time_);
+      for (size_t i = 0; i < extension_array_.size(); ++i) {
+        ProfileScope scope(profiling_, time_extensions_[i]);
+        extension_array_[i]->OnClock(time_);
       }
     }
 
-    top_->eval();
+    {
+      ProfileScope scope(profiling_, time_eval_);
+      top_->eval();
+    }
     time_++;
 
-    Trace();
+    TraceWindowIfRequired();
+
+    {
+      ProfileScope scope(profiling_, time_trace_);
+      Trace();
+    }
+
+    CheckpointIfRequired();
+
+    ProfileSampleIfRequired();
 
     if (request_stop_) {
       std::cout << "Received stop request, shutting down simulation."
                 << std::endl;
       break;
     }
+    if (batch) {
+      unsigned long cycle = time_ / 2;
+      bool finished = Verilated::gotFinish();
+      unsigned long test_cycles = cycle - test_start_cycle;
+      if (finished ||
+          (term_after_cycles_ &&
+           test_cycles >= static_cast<unsigned long>(term_after_cycles_))) {
+        RecordBatchResult(finished, test_cycles);
+        // Hold the design in reset while the next test is loaded, so that the
+        // exit signal of the previous test is cleared before the next edge
+        SetReset();
+        if (!LoadNextBatchTest()) {
+          std::cout << "Batch of tests completed, shutting down simulation."
+                    << std::endl;
+          break;
+        }
+        Verilated::gotFinish(false);
+        start_reset_cycle_ = cycle;
+        end_reset_cycle_ = cycle + reset_duration_cycles_;
+        test_start_cycle = cycle;
+      }
+      continue;
+    }
     if (Verilated::gotFinish()) {
       std::cout << "Received $finish() from Verilog, shutting down simulation."
                 << std::endl;
@@ -383,6 +725,89 @@ bool VerilatorSimCtrl::FileSize(std::string filepath, int &size_byte) const {
   return true;
 }
 
+bool VerilatorSimCtrl::SaveCheckpoint(const std::string &filepath) {
+#if VM_SAVABLE == 1
+  VerilatedSave os;
+  os.open(filepath.c_str());
+  if (!os.isOpen()) {
+    return false;
+  }
+  os << time_;
+  top_->save(os);
+  os.close();
+  return true;
+#else
+  (void)filepath;
+  return false;
+#endif
+}
+
+bool VerilatorSimCtrl::RestoreCheckpoint(const std::string &filepath) {
+#if VM_SAVABLE == 1
+  assert(top_ && "Use SetTop() first.");
+
+  VerilatedRestore os;
+  os.open(filepath.c_str());
+  if (!os.isOpen()) {
+    return false;
+  }
+  os >> time_;
+  top_->restore(os);
+  os.close();
+  std::cout << "Restored checkpoint " << filepath << " at cycle " << time_ / 2
+            << std::endl;
+  return true;
+#else
+  (void)filepath;
+  return false;
+#endif
+}
+
+void VerilatorSimCtrl::CheckpointIfRequired() {
+  // Only checkpoint on cycle boundaries, i.e., after the falling edge
+  if (!checkpoint_pending_ || (time_ % 2)) {
+    return;
+  }
+
+  if (checkpoint_on_event_) {
+    if (*sig_event_trigger_ != 1) {
+      return;
+    }
+  } else if (time_ / 2 < checkpoint_cycle_) {
+    return;
+  }
+
+  std::string filepath = "sim_" + std::to_string(time_ / 2) + ".ckpt";
+  if (SaveCheckpoint(filepath)) {
+    std::cout << "Saved checkpoint " << filepath << " at cycle " << time_ / 2
+              << std::endl;
+  } else {
+    std::cerr << "ERROR: Could not save checkpoint " << filepath << std::endl;
+  }
+  checkpoint_pending_ = false;
+}
+
+void VerilatorSimCtrl::TraceWindowIfRequired() {
+  unsigned long cycle = time_ / 2;
+
+  // Act once per cycle boundary, so that SIGUSR1 can still override the window
+  if (trace_from_cycle_ && cycle == trace_from_cycle_ && !(time_ % 2)) {
+    TraceOn();
+  }
+  if (trace_to_cycle_ && cycle == trace_to_cycle_ && !(time_ % 2)) {
+    TraceOff();
+  }
+
+  if (trace_on_event_ && *sig_event_trigger_ != last_event_trigger_) {
+    last_event_trigger_ = *sig_event_trigger_;
+    if (last_event_trigger_ == 1) {
+      TraceOn();
+    } else if (last_event_trigger_ == ~QData(0)) {
+      TraceOff();
+    }
+  }
+}
+
 void VerilatorSimCtrl::Trace() {
   // We cannot output a message when calling TraceOn()/TraceOff() as these
   // functions can be called from a signal handler. Instead we print the message
@@ -408,3 +833,78 @@ void VerilatorSimCtrl::Trace() {
 
   tracer_.dump(GetTime());
 }
+
+bool VerilatorSimCtrl::ReadBatchFile(const std::string &filepath) {
+  std::ifstream file(filepath);
+  if (!file) {
+    return false;
+  }
+  batch_elfs_.clear();
+  std::string line;
+  while (std::getline(file, line)) {
+    size_t begin = line.find_first_not_of(" \t");
+    if (begin == std::string::npos || line[begin] == '#') {
+      continue;
+    }
+    size_t end = line.find_last_not_of(" \t\r");
+    batch_elfs_.push_back(line.substr(begin, end - begin + 1));
+  }
+  return !batch_elfs_.empty();
+}
+
+bool VerilatorSimCtrl::LoadNextBatchTest() {
+  while (batch_results_.size() < batch_elfs_.size()) {
+    const std::string &elf = batch_elfs_[batch_results_.size()];
+    std::cout << "[batch]: Running test " << batch_results_.size() + 1 << "/"
+              << batch_elfs_.size() << ": " << elf << std::endl;
+    if (batch_loader_(elf)) {
+      return true;
+    }
+    batch_results_.push_back({.elf = elf,
+                              .loaded = false,
+                              .finished = false,
+                              .exit_code = 0,
+                              .cycles = 0});
+    simulation_success_ = false;
+  }
+  return false;
+}
+
+void VerilatorSimCtrl::RecordBatchResult(bool finished, unsigned long cycles) {
+  unsigned long exit_code = sig_exit_ ? *sig_exit_ >> 1 : 0;
+  batch_results_.push_back({.elf = batch_elfs_[batch_results_.size()],
+                            .loaded = true,
+                            .finished = finished,
+                            .exit_code = exit_code,
+                            .cycles = cycles});
+  if (!finished || exit_code) {
+    simulation_success_ = false;
+  }
+}
+
+void VerilatorSimCtrl::PrintBatchResults() const {
+  size_t passed = 0;
+  std::cout << std::endl << "Batch results:" << std::endl;
+  for (const BatchResult &result : batch_results_) {
+    if (!result.loaded) {
+      std::cout << "  FAIL     " << result.elf << " (could not be loaded)";
+    } else if (!result.finished) {
+      std::cout << "  TIMEOUT  " << result.elf << " (" << result.cycles
+                << " cycles)";
+    } else if (result.exit_code) {
+      std::cout << "  FAIL     " << result.elf << " (exit code "
+                << result.exit_code << ", " << result.cycles << " cycles)";
+    } else {
+      std::cout << "  PASS     " << result.elf << " (" << result.cycles
+                << " cycles)";
+      passed++;
+    }
+    std::cout << std::endl;
+  }
+  std::cout << passed << "/" << batch_elfs_.size() << " tests passed";
+  if (batch_results_.size() < batch_elfs_.size()) {
+    std::cout << ", " << batch_elfs_.size() - batch_results_.size()
+              << " not run";
+  }
+  std::cout << std::endl;
+}
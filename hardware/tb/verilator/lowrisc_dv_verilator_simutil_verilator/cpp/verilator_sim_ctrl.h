@@ -6,6 +6,7 @@
 #define OPENTITAN_HW_DV_VERILATOR_SIMUTIL_VERILATOR_CPP_VERILATOR_SIM_CTRL_H_
 
 #include <chrono>
+#include <functional>
 #include <string>
 #include <vector>
 
@@ -86,6 +87,11 @@ class VerilatorSimCtrl {
    */
   bool WasSimulationSuccessful() const { return simulation_success_; }
 
+  /**
+   * Is a batch of tests run (--batch)?
+   */
+  bool InBatchMode() const { return !batch_elfs_.empty(); }
+
   /**
    * Set the number of clock cycles (periods) before the reset signal is
    * activated
@@ -112,6 +118,31 @@ class VerilatorSimCtrl {
    */
   unsigned long GetTime() const { return time_; }
 
+  /**
+   * Set the signal holding the software event trigger
+   *
+   * Needed to take a checkpoint with --save-checkpoint-at=event_trigger, and
+   * to trace a window with --trace-on-event-trigger.
+   */
+  void SetEventTrigger(QData *sig_event_trigger);
+
+  /**
+   * Set the signal holding the end of computation of the software
+   *
+   * Bit 0 is set when the software exits, and the other bits hold its exit
+   * code. Needed to report the result of each test with --batch.
+   */
+  void SetExitSignal(QData *sig_exit);
+
+  /**
+   * Set the function that loads an ELF file into the memories of the design
+   *
+   * With --batch, the loader is called before each test, while the design is
+   * held in reset. It is expected to clear the memories first, and to return
+   * false if the ELF file could not be loaded.
+   */
+  void SetBatchLoader(std::function<bool(const std::string &)> loader);
+
  private:
   VerilatedToplevel *top_;
   CData *sig_clk_;
@@ -131,6 +162,40 @@ class VerilatorSimCtrl {
   VerilatedTracer tracer_;
   int term_after_cycles_;
   std::vector<SimCtrlExtension *> extension_array_;
+  QData *sig_event_trigger_;
+  bool checkpoint_pending_;
+  bool checkpoint_on_event_;
+  unsigned long checkpoint_cycle_;
+  bool trace_on_event_;
+  QData last_event_trigger_;
+  unsigned long trace_from_cycle_;
+  unsigned long trace_to_cycle_;
+  // Simulation throughput profiling (--profile)
+  struct ProfileSample {
+    unsigned long cycle;
+    double speed_khz;
+  };
+  bool profiling_;
+  unsigned long profile_interval_cycles_;
+  std::string stats_json_path_;
+  std::chrono::steady_clock::duration time_eval_;
+  std::chrono::steady_clock::duration time_trace_;
+  std::vector<std::chrono::steady_clock::duration> time_extensions_;
+  std::vector<ProfileSample> profile_samples_;
+  std::chrono::steady_clock::time_point last_sample_time_;
+  unsigned long last_sample_cycle_;
+  // Batch of tests run in one process (--batch)
+  struct BatchResult {
+    std::string elf;
+    bool loaded;
+    bool finished;
+    unsigned long exit_code;
+    unsigned long cycles;
+  };
+  QData *sig_exit_;
+  std::function<bool(const std::string &)> batch_loader_;
+  std::vector<std::string> batch_elfs_;
+  std::vector<BatchResult> batch_results_;
 
   /**
    * Default constructor
@@ -195,6 +260,26 @@ class VerilatorSimCtrl {
    */
   void PrintStatistics() const;
 
+  /**
+   * Write the statistics of the run to the --stats-json file
+   */
+  void WriteStatsJson() const;
+
+  /**
+   * Sample the simulation speed since the previous sample, if profiling
+   */
+  void ProfileSampleIfRequired();
+
+  /**
+   * Get the peak resident set size of the process in KiB
+   */
+  long GetPeakRssKb() const;
+
+  /**
+   * Get a printable name of a registered extension
+   */
+  std::string GetExtensionName(size_t idx) const;
+
   /**
    * Get the file name of the trace file
    */
@@ -238,6 +323,64 @@ class VerilatorSimCtrl {
    * Perform tracing in Verilator if required
    */
   void Trace();
+
+  /**
+   * Save the simulation time and the model state, memories included
+   *
+   * @return true if the checkpoint was written
+   */
+  bool SaveCheckpoint(const std::string &filepath);
+
+  /**
+   * Restore the simulation time and the model state from a checkpoint
+   *
+   * Memory loads parsed after the restore (e.g., --meminit) are applied on
+   * top of the restored memories.
+   *
+   * @return true if the checkpoint was restored
+   */
+  bool RestoreCheckpoint(const std::string &filepath);
+
+  /**
+   * Save a checkpoint if the requested cycle or event has been reached
+   */
+  void CheckpointIfRequired();
+
+  /**
+   * Turn tracing on or off at the requested cycles or events
+   *
+   * The software turns tracing on by writing 1 to the event trigger, and off
+   * by writing all ones to it, as in the QuestaSim flow.
+   */
+  void TraceWindowIfRequired();
+
+  /**
+   * Read the list of ELF files of --batch, one per line
+   *
+   * Empty lines and lines starting with '#' are skipped.
+   *
+   * @return false if the file could not be read or lists no ELF file
+   */
+  bool ReadBatchFile(const std::string &filepath);
+
+  /**
+   * Load the next test of the batch that loads successfully
+   *
+   * The tests that fail to load are recorded as failed.
+   *
+   * @return false if there is no test left
+   */
+  bool LoadNextBatchTest();
+
+  /**
+   * Record the result of the test that just finished or timed out
+   */
+  void RecordBatchResult(bool finished, unsigned long cycles);
+
+  /**
+   * Print the result of each test of the batch, and a summary
+   */
+  void PrintBatchResults() const;
 };
 
 #endif  // OPENTITAN_HW_DV_VERILATOR_SIMUTIL_VERILATOR_CPP_VERILATOR_SIM_CTRL_H_
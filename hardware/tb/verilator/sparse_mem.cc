@@ -0,0 +1,156 @@
+// Copyright 2021 ETH Zurich and University of Bologna.
+// Solderpad Hardware License, Version 0.51, see LICENSE for details.
+// SPDX-License-Identifier: SHL-0.51
+//
+// Description:
+// Sparse backing store for the memories of the Verilator model, and DPI-C
+// interface of the memory model (ara_sparse_dram.sv).
+
+#include "sparse_mem.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <svdpi.h>
+
+namespace {
+
+// Memories by design scope
+std::map<std::string, std::unique_ptr<SparseMem>> &SparseMems() {
+  static std::map<std::string, std::unique_ptr<SparseMem>> mems;
+  return mems;
+}
+
+}  // namespace
+
+uint8_t *SparseMem::GetPage(uint64_t page, bool allocate) {
+  if (page == last_page_) {
+    return last_page_data_;
+  }
+
+  auto it = pages_.find(page);
+  if (it == pages_.end()) {
+    if (!allocate) {
+      return nullptr;
+    }
+    // Value-initialized, i.e., zeroed
+    it = pages_.emplace(page, std::unique_ptr<uint8_t[]>(new uint8_t[kPageBytes]()))
+             .first;
+  }
+
+  last_page_ = page;
+  last_page_data_ = it->second.get();
+  return last_page_data_;
+}
+
+void SparseMem::Read(uint64_t offset, uint8_t *data, size_t len) {
+  while (len) {
+    uint64_t page_offset = offset % kPageBytes;
+    size_t chunk = std::min<uint64_t>(len, kPageBytes - page_offset);
+    const uint8_t *page = GetPage(offset / kPageBytes, false);
+    if (page) {
+      memcpy(data, page + page_offset, chunk);
+    } else {
+      memset(data, 0, chunk);
+    }
+    offset += chunk;
+    data += chunk;
+    len -= chunk;
+  }
+}
+
+void SparseMem::Write(uint64_t offset, const uint8_t *data, size_t len) {
+  while (len) {
+    uint64_t page_offset = offset % kPageBytes;
+    size_t chunk = std::min<uint64_t>(len, kPageBytes - page_offset);
+    memcpy(GetPage(offset / kPageBytes, true) + page_offset, data, chunk);
+    offset += chunk;
+    data += chunk;
+    len -= chunk;
+  }
+}
+
+void SparseMem::WriteWord(uint64_t index, const uint8_t *data,
+                          const uint8_t *strb) {
+  // The words are a power of two bytes wide, and never cross a page
+  uint64_t offset = index * width_byte_;
+  uint8_t *word = GetPage(offset / kPageBytes, true) + offset % kPageBytes;
+  for (uint32_t b = 0; b < width_byte_; b++) {
+    if ((strb[b / 8] >> (b % 8)) & 1) {
+      word[b] = data[b];
+    }
+  }
+}
+
+void SparseMem::Zero(uint64_t offset, size_t len) {
+  while (len) {
+    uint64_t page_offset = offset % kPageBytes;
+    size_t chunk = std::min<uint64_t>(len, kPageBytes - page_offset);
+    uint8_t *page = GetPage(offset / kPageBytes, false);
+    if (page) {
+      memset(page + page_offset, 0, chunk);
+    }
+    offset += chunk;
+    len -= chunk;
+  }
+}
+
+void SparseMem::Clear() {
+  pages_.clear();
+  last_page_ = ~uint64_t(0);
+  last_page_data_ = nullptr;
+}
+
+SparseMem &SparseMemCreate(const std::string &scope, uint64_t size_byte,
+                           uint32_t width_byte) {
+  std::unique_ptr<SparseMem> &mem = SparseMems()[scope];
+  if (!mem) {
+    mem.reset(new SparseMem(size_byte, width_byte));
+  }
+  return *mem;
+}
+
+SparseMem *SparseMemFind(const std::string &scope) {
+  auto it = SparseMems().find(scope);
+  return it == SparseMems().end() ? nullptr : it->second.get();
+}
+
+extern "C" {
+
+// Attach the memory model at the calling scope to its sparse memory
+void *sparse_mem_open(uint64_t size_byte, unsigned int width_byte) {
+  std::string scope = svGetNameFromScope(svGetScope());
+  SparseMem &mem = SparseMemCreate(scope, size_byte, width_byte);
+  if (mem.GetSize() != size_byte || mem.GetWidth() != width_byte) {
+    std::cerr << "[sparse_mem] The memory at " << scope
+              << " does not match the size and width of the design."
+              << std::endl;
+  }
+  return &mem;
+}
+
+// Read the memory word at index
+void sparse_mem_read(void *mem, uint64_t index, svBitVecVal *data) {
+  SparseMem *m = static_cast<SparseMem *>(mem);
+  m->Read(index * m->GetWidth(), reinterpret_cast<uint8_t *>(data),
+          m->GetWidth());
+}
+
+// Write the bytes of the memory word at index enabled by strb
+void sparse_mem_write(void *mem, uint64_t index, const svBitVecVal *data,
+                      const svBitVecVal *strb) {
+  static_cast<SparseMem *>(mem)->WriteWord(
+      index, reinterpret_cast<const uint8_t *>(data),
+      reinterpret_cast<const uint8_t *>(strb));
+}
+
+// Report how much host memory the simulation used
+void sparse_mem_close(void *mem) {
+  SparseMem *m = static_cast<SparseMem *>(mem);
+  std::cout << "[sparse_mem] " << svGetNameFromScope(svGetScope()) << ": "
+            << m->GetNumPages() << " pages of " << SparseMem::kPageBytes
+            << " B allocated, out of " << m->GetSize() / SparseMem::kPageBytes
+            << std::endl;
+}
+}
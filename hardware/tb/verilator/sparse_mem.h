@@ -0,0 +1,79 @@
+// Copyright 2021 ETH Zurich and University of Bologna.
+// Solderpad Hardware License, Version 0.51, see LICENSE for details.
+// SPDX-License-Identifier: SHL-0.51
+//
+// Description:
+// Sparse backing store for the memories of the Verilator model. The memory
+// is allocated in pages on first touch, so that a large address space costs
+// only the host memory of the pages that the simulation actually uses.
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+class SparseMem {
+ public:
+  static const uint64_t kPageBytes = 4096;
+
+  SparseMem(uint64_t size_byte, uint32_t width_byte)
+      : size_byte_(size_byte),
+        width_byte_(width_byte),
+        last_page_(~uint64_t(0)),
+        last_page_data_(nullptr) {}
+
+  uint64_t GetSize() const { return size_byte_; }
+  uint32_t GetWidth() const { return width_byte_; }
+  size_t GetNumPages() const { return pages_.size(); }
+
+  // Read len bytes at offset. The untouched bytes read as zero.
+  void Read(uint64_t offset, uint8_t *data, size_t len);
+
+  // Write len bytes at offset
+  void Write(uint64_t offset, const uint8_t *data, size_t len);
+
+  // Write the bytes of one memory word whose bit is set in strb
+  void WriteWord(uint64_t index, const uint8_t *data, const uint8_t *strb);
+
+  // Zero len bytes at offset, without allocating new pages
+  void Zero(uint64_t offset, size_t len);
+
+  // Free all the pages, so that the whole memory reads as zero again
+  void Clear();
+
+  // The page that contains offset, allocated if required, for the direct
+  // accesses of another simulator. It stays valid until Clear().
+  uint8_t *GetPageData(uint64_t offset) {
+    return GetPage(offset / kPageBytes, true);
+  }
+
+ private:
+  uint64_t size_byte_;
+  uint32_t width_byte_;
+  std::unordered_map<uint64_t, std::unique_ptr<uint8_t[]>> pages_;
+  // Most recently used page, since the accesses are mostly sequential
+  uint64_t last_page_;
+  uint8_t *last_page_data_;
+
+  // Get a page, allocating it if required
+  uint8_t *GetPage(uint64_t page, bool allocate);
+};
+
+/**
+ * Create the sparse memory of the design scope |scope|
+ *
+ * The testbench creates the memory before loading the images into it, i.e.,
+ * before the simulation starts. The memory model attaches to it when it is
+ * initialized. Return the existing memory if it was already created.
+ */
+SparseMem &SparseMemCreate(const std::string &scope, uint64_t size_byte,
+                           uint32_t width_byte);
+
+/**
+ * Find the sparse memory of the design scope |scope|
+ *
+ * @return nullptr if there is no sparse memory at |scope|
+ */
+SparseMem *SparseMemFind(const std::string &scope);
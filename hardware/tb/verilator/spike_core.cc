@@ -0,0 +1,601 @@
+// Copyright 2021 ETH Zurich and University of Bologna.
+// Solderpad Hardware License, Version 0.51, see LICENSE for details.
+// SPDX-License-Identifier: SHL-0.51
+//
+// Description:
+// DPI-C side of the Spike dispatcher (accel_dispatcher_spike.sv). In each
+// cycle, the dispatcher reports the handshakes with Ara (spike_core_ara), and
+// gets the request of Spike for Ara, or for the AXI port (spike_core_tick).
+//
+// Spike executes a scalar instruction every +spike_cpi cycles, and waits:
+// - on a vector instruction, until Ara accepts it, and, if it has a scalar
+//   result (vsetvl*, vmv.x.s, vcpop.m, vfirst.m, vfmv.f.s, and the vector CSR
+//   instructions), until Ara answers
+// - on a fence, until the vector loads and stores in flight are done
+// - on a scalar load from the bytes of a vector store in flight, or on a
+//   scalar store to the bytes of a vector load or store in flight, until these
+//   are done. The bytes of the vector accesses are estimated from their base,
+//   vl, stride, and EEW. The indexed ones can access any byte.
+// - on an access outside of the DRAM, until its AXI transaction is done. The
+//   instruction then executes again, and its access gets the data of the
+//   transaction.
+// The reads of cycle and mcycle return the cycles of the RTL since the reset.
+
+#include "spike_core.h"
+
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <svdpi.h>
+#include <unordered_map>
+
+#include "mmu.h"
+#include "processor.h"
+#include "simif.h"
+
+namespace {
+
+const uint64_t kPageBytes = 4096;
+
+DpiMemUtil *mem_util = nullptr;
+std::string mem_name;
+uint64_t mem_base = 0, mem_size = 0;
+
+// Raised by an access of Spike that must wait, before the instruction changes
+// the architectural state, so that the instruction can execute again
+struct Stall {};
+
+// Bytes [lo, hi) of a vector load or store
+struct Range {
+  uint64_t lo, hi;
+
+  bool Overlaps(uint64_t addr, uint64_t len) const {
+    return addr < hi && lo < addr + len;
+  }
+};
+
+bool Overlaps(const std::deque<Range> &ranges, uint64_t addr, uint64_t len) {
+  for (const Range &r : ranges) {
+    if (r.Overlaps(addr, len))
+      return true;
+  }
+  return false;
+}
+
+// The vector CSRs of Ara
+bool IsAraCsr(uint32_t csr) {
+  switch (csr) {
+    case 0x008:  // vstart
+    case 0x009:  // vxsat
+    case 0x00a:  // vxrm
+    case 0xc20:  // vl
+    case 0xc21:  // vtype
+    case 0xc22:  // vlenb
+      return true;
+    default:
+      return false;
+  }
+}
+
+class SpikeCore : public simif_t {
+ public:
+  explicit SpikeCore(unsigned hart);
+
+  void Reset(uint64_t boot_addr, unsigned vlenb, unsigned trans_id_bits,
+             unsigned cpi);
+
+  // The handshakes of this cycle with Ara. Return false on an error of Ara.
+  bool Ara(bool req_ack, bool resp_valid, unsigned trans_id, uint64_t result,
+           bool error, bool fflags_valid, unsigned fflags, bool load_complete,
+           bool store_complete);
+
+  // Execute the next instruction, if Spike does not wait
+  void Tick(uint64_t cycle);
+
+  // The AXI transaction of the access outside of the DRAM is done
+  void MmioDone(uint64_t rdata, bool error) {
+    mmio_.done = true;
+    mmio_.error = error;
+    mmio_.data = rdata;
+  }
+
+  // Request to Ara
+  bool req_valid() const { return req_valid_; }
+  uint32_t req_insn() const { return req_insn_; }
+  uint64_t req_rs1() const { return req_rs1_; }
+  uint64_t req_rs2() const { return req_rs2_; }
+  unsigned req_frm() const { return req_frm_; }
+  unsigned req_trans_id() const { return trans_id_; }
+
+  // Access outside of the DRAM, over AXI
+  bool mmio_valid() const { return mmio_.valid && !mmio_.done; }
+  bool mmio_write() const { return mmio_.write; }
+  uint64_t mmio_addr() const { return mmio_.addr; }
+  unsigned mmio_len() const { return mmio_.len; }
+  uint64_t mmio_wdata() const { return mmio_.data; }
+
+  uint64_t pc() const { return proc_->get_state()->pc; }
+  // Spike wrote the DRAM in the last cycle
+  bool wrote() const { return wrote_; }
+
+  // simif_t: the DRAM is not mapped into the TLB of Spike, so that each access
+  // goes through mmio_load and mmio_store
+  char *addr_to_mem(reg_t addr) override { return nullptr; }
+  bool mmio_load(reg_t addr, size_t len, uint8_t *bytes) override;
+  bool mmio_store(reg_t addr, size_t len, const uint8_t *bytes) override;
+  void proc_reset(unsigned id) override {}
+  const char *get_symbol(uint64_t addr) override { return nullptr; }
+
+ private:
+  enum Kind { kNone, kLoad, kStore };
+  // Register of the scalar result of a vector instruction
+  enum Result { kNoResult, kXpr, kFpr, kVl };
+
+  struct Mmio {
+    bool valid, done, write, error;
+    uint64_t addr;
+    unsigned len;
+    uint64_t data;
+  };
+
+  std::unique_ptr<isa_parser_t> isa_;
+  std::unique_ptr<processor_t> proc_;
+  // The pages of the DRAM, through its backdoor
+  std::unordered_map<uint64_t, uint8_t *> pages_;
+
+  unsigned vlenb_ = 0, cpi_ = 1;
+  unsigned trans_id_ = 0, trans_id_mask_ = 0;
+  uint64_t cycle_ = 0, next_issue_ = 0;
+
+  bool req_valid_ = false;
+  uint32_t req_insn_ = 0;
+  uint64_t req_rs1_ = 0, req_rs2_ = 0;
+  unsigned req_frm_ = 0;
+  Kind req_kind_ = kNone;
+  Range req_range_{0, 0};
+
+  bool wait_result_ = false;
+  Result result_ = kNoResult;
+  unsigned result_rd_ = 0;
+
+  // vl and SEW, as set by the last vsetvl*
+  uint64_t vl_ = 0;
+  unsigned sew_ = 8, next_sew_ = 8;
+
+  // Vector loads and stores accepted by Ara, and not complete yet
+  std::deque<Range> vloads_, vstores_;
+
+  Mmio mmio_{};
+  bool wrote_ = false;
+
+  uint8_t *Page(uint64_t addr);
+  void Copy(uint64_t addr, size_t len, uint8_t *bytes, bool write);
+  bool InDram(uint64_t addr, size_t len) const {
+    return addr >= mem_base && len <= mem_size &&
+           addr - mem_base <= mem_size - len;
+  }
+  bool Device(uint64_t addr, size_t len, uint8_t *bytes, bool write);
+
+  uint32_t Fetch(uint64_t pc);
+  bool DecodeVector(uint32_t bits);
+  Range Bytes(uint32_t bits, uint64_t base, uint64_t stride) const;
+  void WriteBack(uint64_t result);
+};
+
+SpikeCore::SpikeCore(unsigned hart)
+    : isa_(new isa_parser_t("rv64gcv_zfh", "MSU")) {
+  // Spike does not execute the vector instructions: the vector state of its
+  // processor is not used
+  proc_.reset(new processor_t(isa_.get(), "vlen:128,elen:64", this, hart,
+                              false, stderr, std::cout));
+}
+
+void SpikeCore::Reset(uint64_t boot_addr, unsigned vlenb,
+                      unsigned trans_id_bits, unsigned cpi) {
+  proc_->reset();
+  proc_->get_mmu()->flush_tlb();
+  proc_->get_mmu()->flush_icache();
+  proc_->get_state()->pc = boot_addr;
+  // The pages of a sparse DRAM do not survive its clearing
+  pages_.clear();
+
+  vlenb_ = vlenb;
+  cpi_ = cpi ? cpi : 1;
+  trans_id_ = 0;
+  trans_id_mask_ = (1u << trans_id_bits) - 1;
+  cycle_ = next_issue_ = 0;
+  req_valid_ = wait_result_ = false;
+  vl_ = 0;
+  sew_ = next_sew_ = 8;
+  vloads_.clear();
+  vstores_.clear();
+  mmio_ = Mmio{};
+  wrote_ = false;
+}
+
+bool SpikeCore::Ara(bool req_ack, bool resp_valid, unsigned trans_id,
+                    uint64_t result, bool error, bool fflags_valid,
+                    unsigned fflags, bool load_complete, bool store_complete) {
+  state_t *state = proc_->get_state();
+
+  if (req_ack && req_valid_) {
+    req_valid_ = false;
+    if (req_kind_ == kLoad)
+      vloads_.push_back(req_range_);
+    else if (req_kind_ == kStore)
+      vstores_.push_back(req_range_);
+    if (!wait_result_)
+      state->pc += 4;
+  }
+  // The accesses complete in order
+  if (load_complete && !vloads_.empty())
+    vloads_.pop_front();
+  if (store_complete && !vstores_.empty())
+    vstores_.pop_front();
+
+  if (fflags_valid)
+    state->fflags->write(state->fflags->read() | fflags);
+
+  if (resp_valid) {
+    if (error) {
+      std::cerr << "[spike_core] Ara rejected the instruction 0x" << std::hex
+                << req_insn_ << " at 0x" << state->pc << std::dec
+                << std::endl;
+      return false;
+    }
+    if (wait_result_ && !req_valid_ && trans_id == trans_id_)
+      WriteBack(result);
+  }
+  return true;
+}
+
+void SpikeCore::WriteBack(uint64_t result) {
+  state_t *state = proc_->get_state();
+  switch (result_) {
+    case kVl:
+      vl_ = result;
+      sew_ = next_sew_;
+      state->XPR.write(result_rd_, result);
+      break;
+    case kFpr: {
+      // NaN-box the narrower elements
+      freg_t f;
+      f.v[0] = sew_ < 64 ? result | (~uint64_t(0) << sew_) : result;
+      f.v[1] = ~uint64_t(0);
+      state->FPR.write(result_rd_, f);
+      break;
+    }
+    default:
+      state->XPR.write(result_rd_, result);
+      break;
+  }
+  state->pc += 4;
+  wait_result_ = false;
+}
+
+void SpikeCore::Tick(uint64_t cycle) {
+  cycle_ = cycle;
+  wrote_ = false;
+
+  if (mmio_valid() || req_valid_ || wait_result_ || cycle < next_issue_)
+    return;
+
+  state_t *state = proc_->get_state();
+  const uint32_t bits = Fetch(state->pc);
+  const uint32_t opcode = bits & 0x7f, funct3 = (bits >> 12) & 0x7;
+  const uint32_t rd = (bits >> 7) & 0x1f, rs1 = (bits >> 15) & 0x1f;
+
+  if (DecodeVector(bits)) {
+    req_valid_ = true;
+    trans_id_ = (trans_id_ + 1) & trans_id_mask_;
+    wait_result_ = result_ != kNoResult;
+  } else if (opcode == 0x73 && funct3 == 2 && rs1 == 0 &&
+             ((bits >> 20) == 0xc00 || (bits >> 20) == 0xb00)) {
+    // cycle, mcycle
+    state->XPR.write(rd, cycle);
+    state->pc += 4;
+  } else if (opcode == 0x0f && funct3 == 0 &&
+             (!vloads_.empty() || !vstores_.empty())) {
+    // The fence waits for the vector accesses
+    return;
+  } else {
+    try {
+      proc_->step(1);
+    } catch (const Stall &) {
+      return;
+    }
+  }
+  next_issue_ = cycle + cpi_;
+}
+
+uint32_t SpikeCore::Fetch(uint64_t pc) {
+  uint16_t half[2] = {0, 0};
+  if (!InDram(pc, 2))
+    return 0;
+  Copy(pc, 2, reinterpret_cast<uint8_t *>(&half[0]), false);
+  if ((half[0] & 0x3) == 0x3 && InDram(pc + 2, 2))
+    Copy(pc + 2, 2, reinterpret_cast<uint8_t *>(&half[1]), false);
+  return uint32_t(half[1]) << 16 | half[0];
+}
+
+bool SpikeCore::DecodeVector(uint32_t bits) {
+  state_t *state = proc_->get_state();
+  const uint32_t opcode = bits & 0x7f, funct3 = (bits >> 12) & 0x7;
+  const uint32_t rs1 = (bits >> 15) & 0x1f, rs2 = (bits >> 20) & 0x1f;
+
+  req_rs1_ = req_rs2_ = 0;
+  req_kind_ = kNone;
+  result_ = kNoResult;
+
+  switch (opcode) {
+    case 0x57:
+      if (funct3 == 0x5) {
+        // OPFVF
+        req_rs1_ = state->FPR[rs1].v[0];
+        break;
+      }
+      if (funct3 == 0x4 || funct3 == 0x6) {
+        // OPIVX, OPMVX
+        req_rs1_ = state->XPR[rs1];
+        break;
+      }
+      if (funct3 == 0x7) {
+        // vsetvli, vsetivli, vsetvl
+        uint64_t vtype;
+        if ((bits >> 30) == 0x3) {
+          vtype = (bits >> 20) & 0x3ff;
+        } else {
+          req_rs1_ = state->XPR[rs1];
+          if (bits >> 31)
+            req_rs2_ = state->XPR[rs2];
+          vtype = (bits >> 31) ? req_rs2_ : (bits >> 20) & 0x7ff;
+        }
+        next_sew_ = 8u << ((vtype >> 3) & 0x7);
+        result_ = kVl;
+        break;
+      }
+      // vmv.x.s, vcpop.m, vfirst.m, and vfmv.f.s
+      if ((bits >> 26) == 0x10 && funct3 == 0x2)
+        result_ = kXpr;
+      else if ((bits >> 26) == 0x10 && funct3 == 0x1)
+        result_ = kFpr;
+      break;
+    case 0x77:
+      // OP-VE: the vector crypto instructions have no scalar operands
+      break;
+    case 0x07:
+    case 0x27:
+      // The scalar FP loads and stores have the other widths
+      if (funct3 != 0 && funct3 < 5)
+        return false;
+      req_rs1_ = state->XPR[rs1];
+      if (((bits >> 26) & 0x3) == 0x2)
+        req_rs2_ = state->XPR[rs2];
+      req_kind_ = opcode == 0x07 ? kLoad : kStore;
+      req_range_ = Bytes(bits, req_rs1_, req_rs2_);
+      break;
+    case 0x73:
+      if ((funct3 & 0x3) == 0 || !IsAraCsr(bits >> 20))
+        return false;
+      // The immediate forms have their operand in rs1
+      req_rs1_ = (funct3 & 0x4) ? rs1 : state->XPR[rs1];
+      result_ = kXpr;
+      break;
+    default:
+      return false;
+  }
+
+  req_insn_ = bits;
+  req_frm_ = state->frm->read();
+  result_rd_ = (bits >> 7) & 0x1f;
+  return true;
+}
+
+Range SpikeCore::Bytes(uint32_t bits, uint64_t base, uint64_t stride) const {
+  const uint64_t nf = (bits >> 29) + 1;
+  const uint32_t mop = (bits >> 26) & 0x3, umop = (bits >> 20) & 0x1f;
+  const uint32_t width = (bits >> 12) & 0x7;
+  const uint64_t eew = width == 0 ? 1 : uint64_t(1) << (width - 4);
+
+  switch (mop) {
+    case 0:
+      // Whole registers, mask, and unit-stride
+      if (umop == 0x08)
+        return {base, base + nf * vlenb_};
+      if (umop == 0x0b)
+        return {base, base + (vl_ + 7) / 8};
+      return {base, base + vl_ * nf * eew};
+    case 2: {
+      if (!vl_)
+        return {base, base};
+      const int64_t span = int64_t(vl_ - 1) * int64_t(stride);
+      const uint64_t lo = span < 0 ? base + span : base;
+      const uint64_t hi = (span < 0 ? base : base + span) + nf * eew;
+      return {lo, hi};
+    }
+    default:
+      // Indexed
+      return {0, ~uint64_t(0)};
+  }
+}
+
+uint8_t *SpikeCore::Page(uint64_t addr) {
+  const uint64_t page = addr / kPageBytes;
+  auto it = pages_.find(page);
+  if (it != pages_.end())
+    return it->second;
+  uint8_t *data = mem_util->GetBackdoorPage(mem_name, page * kPageBytes);
+  if (!data) {
+    throw std::runtime_error("The memory `" + mem_name +
+                             "' has no backdoor for Spike.");
+  }
+  pages_[page] = data;
+  return data;
+}
+
+void SpikeCore::Copy(uint64_t addr, size_t len, uint8_t *bytes, bool write) {
+  while (len) {
+    const uint64_t offset = addr % kPageBytes;
+    const size_t count = std::min<uint64_t>(kPageBytes - offset, len);
+    uint8_t *data = Page(addr) + offset;
+    if (write)
+      memcpy(data, bytes, count);
+    else
+      memcpy(bytes, data, count);
+    addr += count;
+    bytes += count;
+    len -= count;
+  }
+}
+
+bool SpikeCore::mmio_load(reg_t addr, size_t len, uint8_t *bytes) {
+  if (!InDram(addr, len))
+    return Device(addr, len, bytes, false);
+  // The fetches do not wait for the vector stores
+  const uint64_t pc = proc_->get_state()->pc;
+  const bool fetch = addr >= pc && addr + len <= pc + 8;
+  if (!fetch && Overlaps(vstores_, addr, len))
+    throw Stall();
+  Copy(addr, len, bytes, false);
+  return true;
+}
+
+bool SpikeCore::mmio_store(reg_t addr, size_t len, const uint8_t *bytes) {
+  uint8_t data[8];
+  if (!InDram(addr, len)) {
+    if (len > sizeof(data))
+      return false;
+    memcpy(data, bytes, len);
+    return Device(addr, len, data, true);
+  }
+  if (Overlaps(vloads_, addr, len) || Overlaps(vstores_, addr, len))
+    throw Stall();
+  Copy(addr, len, const_cast<uint8_t *>(bytes), true);
+  wrote_ = true;
+  return true;
+}
+
+bool SpikeCore::Device(uint64_t addr, size_t len, uint8_t *bytes, bool write) {
+  // A single beat of the 64-bit AXI port
+  if (len > 8 || addr % 8 + len > 8)
+    return false;
+  if (mmio_.done && mmio_.addr == addr && mmio_.len == len &&
+      mmio_.write == write) {
+    if (!write)
+      memcpy(bytes, &mmio_.data, len);
+    const bool error = mmio_.error;
+    mmio_ = Mmio{};
+    return !error;
+  }
+  mmio_ = Mmio{};
+  mmio_.valid = true;
+  mmio_.write = write;
+  mmio_.addr = addr;
+  mmio_.len = len;
+  if (write)
+    memcpy(&mmio_.data, bytes, len);
+  throw Stall();
+}
+
+std::map<unsigned, std::unique_ptr<SpikeCore>> cores;
+
+SpikeCore *GetCore(unsigned hart) {
+  auto it = cores.find(hart);
+  if (it == cores.end()) {
+    std::cerr << "[spike_core] The hart " << hart << " was not reset."
+              << std::endl;
+    return nullptr;
+  }
+  return it->second.get();
+}
+
+} // namespace
+
+void SpikeCoreSetMemory(DpiMemUtil *util, const std::string &name,
+                        uint64_t base, uint64_t size) {
+  mem_util = util;
+  mem_name = name;
+  mem_base = base;
+  mem_size = size;
+}
+
+extern "C" {
+
+// Reset the hart, which boots from boot_addr, and executes a scalar
+// instruction every cpi cycles. Ara has vlenb bytes per vector register, and
+// transaction IDs of trans_id_bits. Return 0, or -1 on error.
+int spike_core_reset(unsigned int hart, uint64_t boot_addr, unsigned int vlenb,
+                     unsigned int trans_id_bits, unsigned int cpi) {
+  if (!mem_util) {
+    std::cerr << "[spike_core] The DRAM is not shared with Spike." << std::endl;
+    return -1;
+  }
+  try {
+    auto &core = cores[hart];
+    if (!core)
+      core.reset(new SpikeCore(hart));
+    core->Reset(boot_addr, vlenb, trans_id_bits, cpi);
+  } catch (const std::exception &err) {
+    std::cerr << "[spike_core] " << err.what() << std::endl;
+    return -1;
+  }
+  return 0;
+}
+
+// The handshakes of this cycle with Ara. Return 0, or -1 on error.
+int spike_core_ara(unsigned int hart, svBit req_ack, svBit resp_valid,
+                   unsigned int trans_id, uint64_t result, svBit error,
+                   svBit fflags_valid, unsigned int fflags,
+                   svBit load_complete, svBit store_complete) {
+  SpikeCore *core = GetCore(hart);
+  if (!core)
+    return -1;
+  return core->Ara(req_ack, resp_valid, trans_id, result, error, fflags_valid,
+                   fflags, load_complete, store_complete)
+             ? 0
+             : -1;
+}
+
+// Execute the next instruction of the hart, and get its requests for Ara and
+// for the AXI port. Return 0, or -1 on error.
+int spike_core_tick(unsigned int hart, uint64_t cycle, svBit *req_valid,
+                    unsigned int *insn, uint64_t *rs1, uint64_t *rs2,
+                    unsigned int *frm, unsigned int *trans_id,
+                    svBit *mmio_valid, svBit *mmio_write, uint64_t *mmio_addr,
+                    unsigned int *mmio_len, uint64_t *mmio_wdata, uint64_t *pc,
+                    svBit *write) {
+  SpikeCore *core = GetCore(hart);
+  if (!core)
+    return -1;
+  try {
+    core->Tick(cycle);
+  } catch (const std::exception &err) {
+    std::cerr << "[spike_core] " << err.what() << std::endl;
+    return -1;
+  }
+  *req_valid = core->req_valid();
+  *insn = core->req_insn();
+  *rs1 = core->req_rs1();
+  *rs2 = core->req_rs2();
+  *frm = core->req_frm();
+  *trans_id = core->req_trans_id();
+  *mmio_valid = core->mmio_valid();
+  *mmio_write = core->mmio_write();
+  *mmio_addr = core->mmio_addr();
+  *mmio_len = core->mmio_len();
+  *mmio_wdata = core->mmio_wdata();
+  *pc = core->pc();
+  *write = core->wrote();
+  return 0;
+}
+
+// The AXI transaction of the access of the hart is done
+void spike_core_mmio_done(unsigned int hart, uint64_t rdata, svBit error) {
+  if (SpikeCore *core = GetCore(hart))
+    core->MmioDone(rdata, error);
+}
+}
@@ -0,0 +1,24 @@
+// Copyright 2021 ETH Zurich and University of Bologna.
+// Solderpad Hardware License, Version 0.51, see LICENSE for details.
+// SPDX-License-Identifier: SHL-0.51
+//
+// Description:
+// Spike as the scalar core of the Verilator model (make verilate spike_core=1).
+// Each hart is a Spike processor, stepped by its dispatcher
+// (accel_dispatcher_spike.sv) through DPI-C. The vector instructions are not
+// executed by Spike, but sent to Ara with the operands that Spike computed, and
+// their scalar results are written back to Spike's registers. The DRAM is
+// shared through its backdoor, and the other devices are accessed over the AXI
+// port of the scalar core.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "dpi_memutil.h"
+
+// The Spike cores access the memory |mem_name| of |mem_util|, at
+// [base, base + size), through its backdoor
+void SpikeCoreSetMemory(DpiMemUtil *mem_util, const std::string &mem_name,
+                        uint64_t base, uint64_t size);
@@ -0,0 +1,176 @@
+#!/usr/bin/env python3
+# Copyright 2022 ETH Zurich and University of Bologna.
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+# Autotuning of the micro-kernels on the Verilator model. For every
+# configuration and shape, the benchmark of the kernel is built once per
+# variant of its tunable parameter, an ENV_DEFINES define, and all the
+# variants are simulated as parallel processes (see regression.py). The
+# variant with the fewest [hw-cycles] wins. The winners are kept in
+# apps/common/tuned/<kernel>.json, and written to
+# apps/common/tuned/<kernel>_tuned.h, one table per (NR_LANES, VLEN), which the
+# dispatch of the kernel includes if it exists.
+#
+# Usage: autotune.py [-c config ...] [-j jobs] [-s shape ...] [--no-build] kernel
+
+import argparse
+import concurrent.futures
+import json
+import os
+import re
+import shutil
+import subprocess
+import sys
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+import regression
+
+ROOT_DIR = regression.ROOT_DIR
+APPS_DIR = regression.APPS_DIR
+HW_DIR = regression.HW_DIR
+TUNED_DIR = os.path.join(APPS_DIR, 'common', 'tuned')
+
+# Tunable kernels:
+#   define: parameter of the variants, passed with ENV_DEFINES
+#   values: variants of the parameter
+#   shapes: default shapes, arguments of gen_data.py
+#   size:   size of a shape in the table of the header
+#   table:  macro of the header, an array of {size, winner}
+tunables = {
+  'fmatmul': {
+    'define': 'FMATMUL_KERNEL',
+    'values': [4, 8, 16],
+    'shapes': ['16 16 16', '32 32 32', '64 64 64', '128 128 128', '256 256 256'],
+    'size'  : lambda args: int(args.split()[0]),
+    'table' : 'FMATMUL_TUNED_TABLE',
+  },
+}
+
+def config_params(config):
+  # nr_lanes and vlen of the configuration, as benchmark.sh reads them
+  params = {}
+  with open(os.path.join(ROOT_DIR, 'config', config + '.mk')) as f:
+    for line in f:
+      m = re.match(r'^([a-z_0-9]+) \?= (.*)$', line.strip())
+      if m:
+        params[m.group(1)] = m.group(2)
+  return int(os.environ.get('nr_lanes', params['nr_lanes'])), int(os.environ.get('vlen', params['vlen']))
+
+def prepare(kernel, config, opts):
+  # Build the model once, and the benchmark once per shape and variant
+  tune = tunables[kernel]
+  outdir = os.path.join(opts.outdir, config)
+  bindir = os.path.join(outdir, 'bin')
+  veril_library = os.path.join(HW_DIR, 'build', 'verilator_' + config)
+  os.makedirs(bindir, exist_ok=True)
+  log = os.path.join(outdir, 'build.log')
+  open(log, 'w').close()
+
+  common = ['config=' + config]
+  jobs = []
+  if not opts.no_build:
+    regression.make(['-C', HW_DIR, 'verilate', 'veril_library=' + veril_library] + common, log)
+  for shape in opts.shapes:
+    for value in tune['values']:
+      name = '{}_{}_{}'.format(kernel, shape.replace(' ', 'x'), value)
+      binary = os.path.join(bindir, name)
+      if not opts.no_build:
+        # The data and the binary of the benchmarks are shared by the variants
+        regression.make(['-C', APPS_DIR, 'clean'], log)
+        os.makedirs(os.path.join(APPS_DIR, 'benchmarks', 'data'), exist_ok=True)
+        with open(os.path.join(APPS_DIR, 'benchmarks', 'data', 'data.S'), 'w') as data:
+          if subprocess.call([sys.executable, os.path.join(APPS_DIR, kernel, 'script', 'gen_data.py')] + shape.split(),
+                             stdout=data):
+            sys.exit('Error: gen_data.py {} failed.'.format(shape))
+        defines = '-D{}=1 -D{}={}'.format(kernel.upper(), tune['define'], value)
+        regression.make(['-C', APPS_DIR, 'ENV_DEFINES=' + defines, 'bin/benchmarks'] + common, log)
+        shutil.copy(os.path.join(APPS_DIR, 'bin', 'benchmarks'), binary)
+      jobs.append(((config, binary, os.path.join(veril_library, 'V' + regression.VERIL_TOP)), shape, value))
+  return jobs
+
+def write_header(kernel, db):
+  tune = tunables[kernel]
+  path = os.path.join(TUNED_DIR, kernel + '_tuned.h')
+  with open(path, 'w') as f:
+    f.write('// Generated by scripts/autotune.py {} from {}.json. Do not edit.\n'.format(kernel, kernel))
+    f.write('// {{size, {}}} per tuned shape, by increasing size\n\n'.format(tune['define']))
+    for key in sorted(db, key=lambda k: [int(x) for x in k.split(':')]):
+      nr_lanes, vlen = key.split(':')
+      winners = sorted((tune['size'](shape), w['value']) for shape, w in db[key].items())
+      f.write('#if NR_LANES == {} && VLEN == {}\n'.format(nr_lanes, vlen))
+      f.write('#define {} {{{}}}\n'.format(tune['table'], ', '.join('{{{}, {}}}'.format(s, v) for s, v in winners)))
+      f.write('#endif\n')
+  return path
+
+def main():
+  parser = argparse.ArgumentParser(description='Pick the best variant of a kernel per configuration and shape.')
+  parser.add_argument('-c', '--config', nargs='+',
+                      default=[os.environ.get('config', os.environ.get('ARA_CONFIGURATION', 'default'))],
+                      help='Ara configurations to tune')
+  parser.add_argument('-j', '--jobs', type=int, default=os.cpu_count(), help='maximum number of parallel simulations')
+  parser.add_argument('-s', '--shapes', nargs='+', default=None, help='arguments of gen_data.py of the shapes to tune')
+  parser.add_argument('--no-build', action='store_true', help='reuse the existing model and binaries')
+  parser.add_argument('--timeout', type=int, default=None, help='timeout of each simulation, in seconds')
+  parser.add_argument('--outdir', default=os.path.join(HW_DIR, 'build', 'autotune'), help='output folder')
+  parser.add_argument('kernel', choices=sorted(tunables), help='kernel to tune')
+  opts = parser.parse_args()
+
+  tune = tunables[opts.kernel]
+  if opts.shapes is None:
+    opts.shapes = tune['shapes']
+  opts.outdir = os.path.abspath(opts.outdir)
+
+  # The binaries overwrite each other in apps/bin, so the build step is serial
+  jobs = []
+  for config in opts.config:
+    jobs += [(config,) + j for j in prepare(opts.kernel, config, opts)]
+
+  results = []
+  with concurrent.futures.ThreadPoolExecutor(max_workers=max(1, opts.jobs)) as pool:
+    futures = {pool.submit(regression.simulate, job, opts): (config, shape, value)
+               for config, job, shape, value in jobs}
+    for fut in concurrent.futures.as_completed(futures):
+      config, shape, value = futures[fut]
+      r = fut.result()
+      print('[{}] {:<8} {} {} {}={} (hw-cycles: {})'.format(len(results) + 1, r['status'], config, shape,
+                                                           tune['define'], value, r['hw_cycles']))
+      results.append((config, shape, value, r))
+
+  # Merge the winners into the database of the kernel
+  os.makedirs(TUNED_DIR, exist_ok=True)
+  db_path = os.path.join(TUNED_DIR, opts.kernel + '.json')
+  db = {}
+  if os.path.isfile(db_path):
+    with open(db_path) as f:
+      db = json.load(f)
+  for config in opts.config:
+    key = '{}:{}'.format(*config_params(config))
+    for shape in opts.shapes:
+      runs = [(r['hw_cycles'], value) for c, s, value, r in results
+              if c == config and s == shape and r['status'] == 'PASS' and r['hw_cycles'] is not None]
+      if not runs:
+        print('Warning: no passing variant of {} on {}, not tuned.'.format(shape, config))
+        continue
+      cycles, value = min(runs)
+      print('{} {}: {}={} ({} cycles)'.format(config, shape, tune['define'], value, cycles))
+      db.setdefault(key, {})[shape] = {'value': value, 'hw_cycles': cycles,
+                                       'all': {str(v): c for c, v in sorted(runs, key=lambda x: x[1])}}
+  with open(db_path, 'w') as f:
+    json.dump(db, f, indent=2, sort_keys=True)
+  print('Tuned table: ' + write_header(opts.kernel, db))
+
+if __name__ == '__main__':
+  main()
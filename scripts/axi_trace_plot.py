@@ -0,0 +1,201 @@
+#!/usr/bin/env python3
+# Copyright 2022 ETH Zurich and University of Bologna.
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+# Bandwidth timeline of the AXI transaction trace (hardware/tb/dpi/axi_trace.cc),
+# recorded with axi_trace=1.
+#
+# For each port and window of cycles, it gives the bytes per cycle read (R) and
+# written (W), the fraction of the cycles in which the W and R channels stall
+# (valid, but not ready), and the largest number of reads (AR to the last R) and
+# writes (AW to B) in flight. The bytes of an R beat are those of its AR burst,
+# matched in order by ID. A port with a low bandwidth, few transactions in flight,
+# and no stall is idle; one stalled on W or R is limited by the memory.
+#
+# Usage: axi_trace_plot.py trace.axi [-w CYCLES] [-o timeline.csv] [-p timeline.png]
+
+import argparse
+import collections
+import struct
+import sys
+
+MAGIC = b'ARAX'
+VERSION = 1
+HEADER = struct.Struct('<4sI')
+RECORD = struct.Struct('<QQHHBBBB')
+
+# Ports of hardware/tb/ara_testharness.sv
+PORTS = ['ara', 'cva6']
+
+# Event kinds of hardware/tb/ara_axi_tracer.sv
+EV_AR, EV_AW, EV_R, EV_W, EV_B, EV_STALL = range(6)
+EV_PORT = 255
+# Channels of the stall mask
+STALL_R = 1 << 2
+STALL_W = 1 << 3
+
+def port_name(port):
+  return PORTS[port] if port < len(PORTS) else 'port{}'.format(port)
+
+def read_trace(path):
+  with open(path, 'rb') as f:
+    data = f.read()
+  magic, version = HEADER.unpack_from(data, 0)
+  if magic != MAGIC:
+    sys.exit('Error: ' + path + ' is not an AXI trace')
+  if version != VERSION:
+    sys.exit('Error: unsupported AXI trace version {}'.format(version))
+  return RECORD.iter_unpack(data[HEADER.size:len(data) - (len(data) - HEADER.size) % RECORD.size])
+
+class Window:
+  def __init__(self):
+    self.rd_bytes = 0
+    self.wr_bytes = 0
+    self.r_stall = 0
+    self.w_stall = 0
+    # Largest, and last, number of transactions in flight
+    self.rd_inflight = 0
+    self.wr_inflight = 0
+    self.rd_end = 0
+    self.wr_end = 0
+
+def timeline(records, window):
+  # {port: data bytes}, {port: {window index: Window}}
+  widths = {}
+  windows = collections.defaultdict(dict)
+  # {port: {id: deque of [beat bytes]}} of the reads in flight
+  reads = collections.defaultdict(lambda: collections.defaultdict(collections.deque))
+  rd_inflight = collections.Counter()
+  wr_inflight = collections.Counter()
+  last = 0
+
+  for cycle, addr, id, nbytes, port, kind, length, info in records:
+    if kind == EV_PORT:
+      widths[port] = nbytes
+      continue
+    last = max(last, cycle)
+    w = windows[port].get(cycle // window)
+    if w is None:
+      # The transactions still in flight span the new window
+      w = windows[port][cycle // window] = Window()
+      w.rd_inflight = rd_inflight[port]
+      w.wr_inflight = wr_inflight[port]
+    if kind == EV_AR:
+      reads[port][id].append(min(1 << info, widths.get(port, 1 << info)))
+      rd_inflight[port] += 1
+    elif kind == EV_AW:
+      wr_inflight[port] += 1
+    elif kind == EV_R:
+      q = reads[port][id]
+      if q:
+        w.rd_bytes += q[0]
+        # The burst completes with its last beat
+        if info & 1:
+          q.popleft()
+          rd_inflight[port] -= 1
+    elif kind == EV_W:
+      w.wr_bytes += nbytes
+    elif kind == EV_B:
+      wr_inflight[port] = max(wr_inflight[port] - 1, 0)
+    elif kind == EV_STALL:
+      w.r_stall += bool(info & STALL_R)
+      w.w_stall += bool(info & STALL_W)
+    w.rd_inflight = max(w.rd_inflight, rd_inflight[port])
+    w.wr_inflight = max(w.wr_inflight, wr_inflight[port])
+    w.rd_end = rd_inflight[port]
+    w.wr_end = wr_inflight[port]
+  return widths, windows, last // window + 1
+
+def rows(widths, windows, nr_windows, window):
+  out = []
+  for port in sorted(set(widths) | set(windows)):
+    prev = Window()
+    for i in range(nr_windows):
+      w = windows[port].get(i)
+      if w is None:
+        # No event: the transactions in flight are those at the end of the previous window
+        w = Window()
+        w.rd_inflight = w.rd_end = prev.rd_end
+        w.wr_inflight = w.wr_end = prev.wr_end
+      prev = w
+      out.append((i * window, port_name(port), w.rd_bytes / window, w.wr_bytes / window,
+                  w.r_stall / window, w.w_stall / window, w.rd_inflight, w.wr_inflight))
+  return out
+
+def summary(widths, windows, nr_windows, window):
+  out = []
+  cycles = nr_windows * window
+  for port in sorted(set(widths) | set(windows)):
+    ws = windows[port].values()
+    rd = sum(w.rd_bytes for w in ws)
+    wr = sum(w.wr_bytes for w in ws)
+    peak = widths.get(port, 0)
+    line = '{}: {} B read, {} B written in {} cycles, {:.2f} B/cycle'.format(
+      port_name(port), rd, wr, cycles, (rd + wr) / cycles)
+    if peak:
+      # R and W are independent channels, each of them moves up to a beat per cycle
+      line += ' ({:.1%} of R, {:.1%} of W at {} B/cycle)'.format(rd / cycles / peak, wr / cycles / peak, peak)
+    line += ', R stalled {:.1%}, W stalled {:.1%} of the cycles'.format(
+      sum(w.r_stall for w in ws) / cycles, sum(w.w_stall for w in ws) / cycles)
+    out.append(line)
+  return '\n'.join(out)
+
+def plot(table, fname):
+  import matplotlib
+  matplotlib.use('Agg')
+  import matplotlib.pyplot as plt
+
+  fig, (bw, inflight) = plt.subplots(2, 1, sharex=True)
+  for i, port in enumerate(sorted({r[1] for r in table})):
+    rs = [r for r in table if r[1] == port]
+    x = [r[0] for r in rs]
+    color = 'C{}'.format(i)
+    bw.plot(x, [r[2] for r in rs], color=color, label='{} R'.format(port))
+    bw.plot(x, [r[3] for r in rs], color=color, linestyle='--', label='{} W'.format(port))
+    inflight.step(x, [r[6] for r in rs], color=color, where='post', label='{} reads'.format(port))
+    inflight.step(x, [r[7] for r in rs], color=color, where='post', linestyle='--',
+                  label='{} writes'.format(port))
+  bw.set_ylabel('Bandwidth (B/cycle)')
+  inflight.set_ylabel('In flight (max)')
+  inflight.set_xlabel('Cycle')
+  for ax in (bw, inflight):
+    ax.grid(True, linestyle=':')
+    ax.legend(loc='upper right', fontsize='small')
+  fig.savefig(fname)
+
+def main():
+  parser = argparse.ArgumentParser(description='Bandwidth timeline of an Ara AXI trace.')
+  parser.add_argument('trace', help='binary trace file')
+  parser.add_argument('-w', '--window', type=int, default=1000, help='cycles per window (default: 1000)')
+  parser.add_argument('-o', '--output', default=None, help='write the timeline to this CSV file')
+  parser.add_argument('-p', '--plot', default=None, help='plot the timeline to this file')
+  args = parser.parse_args()
+  if args.window <= 0:
+    sys.exit('Error: the window must be positive')
+
+  widths, windows, nr_windows = timeline(read_trace(args.trace), args.window)
+  table = rows(widths, windows, nr_windows, args.window)
+  print(summary(widths, windows, nr_windows, args.window))
+  if args.output:
+    with open(args.output, 'w') as f:
+      f.write('cycle,port,rd_bytes_per_cycle,wr_bytes_per_cycle,r_stall,w_stall,rd_inflight,wr_inflight\n')
+      for r in table:
+        f.write('{},{},{:.3f},{:.3f},{:.3f},{:.3f},{},{}\n'.format(*r))
+  if args.plot:
+    plot(table, args.plot)
+
+if __name__ == '__main__':
+  main()
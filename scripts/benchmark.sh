@@ -3,6 +3,10 @@
 # Pass the option "ci" if there is no QuestaSim installed
 # Pass the name of the app to benchmark
 # If no app is passed, all the apps are benchmarked
+# Set mem_sweep to benchmark the apps with several timings of the main memory
+# Set vinsn_sweep to benchmark the apps with several instruction windows
+# Set data_image=1 to compile the matmuls once, and load each size at runtime
+# The knobs of the configuration can be overridden from the environment, as with make
 
 ###########
 ## Setup ##
@@ -31,10 +35,47 @@ if [ -z ${config} ]; then
     fi
 fi
 
+# The environment has priority over the configuration, as with the ?= of make
 tmpscript=`mktemp`
-sed "s/ ?= /=/g" config/${config}.mk > $tmpscript
+sed -E 's/^([a-z_0-9]+) \?= (.*)$/: ${\1:=\2}/' config/${config}.mk > $tmpscript
 source ${tmpscript}
 
+# Depths of the instruction queues, recorded with the results
+queues="${valu_queue_depth}:${mfpu_queue_depth}:${vldu_queue_depth}:${vstu_queue_depth}:${sldu_queue_depth}:${masku_queue_depth}"
+# Pipeline stages of the hardware (see hardware/Makefile), recorded with the results
+pipe="${fpu_pipe_regs:-0}:${mul_pipe_regs:-0}:${slide_mask_cut:-0}:${pe_req_cut:-0}"
+
+# Database of the results (JSON lines, see scripts/benchmark_db.py).
+# New results are appended, to compare them with the previous ones
+results_db=${results_db:-./benchmark_results.jsonl}
+
+# Timings of the main memory to benchmark, as "rd_latency:wr_latency:bytes_per_cycle:banks"
+# (see config/*.mk), separated by spaces. For example, mem_sweep="1:1:0:8 100:100:0:8 100:100:16:4"
+# shows how memory-bound the kernels are. The default is the timing of the configuration.
+if [ -z "${mem_sweep}" ]; then
+  mem_sweep="${dram_rd_latency}:${dram_wr_latency}:${dram_bw}:${dram_banks}"
+  mem_rebuild=0
+else
+  mem_rebuild=1
+fi
+
+# Numbers of vector instructions in flight to benchmark (nr_vinsn, see hardware/Makefile),
+# separated by spaces. "scripts/benchmark_db.py window" compares their speedup and cost.
+if [ -z "${vinsn_sweep}" ]; then
+  vinsn_sweep="${nr_vinsn:-8}"
+else
+  mem_rebuild=1
+fi
+
+# With data_image=1, the sweeps of the matrix sizes compile each kernel once,
+# and load the matrices of each size at runtime, as a data image (see
+# apps/common/data_image.h). The image is loaded by the Verilator model only,
+# and the ideal dispatcher is skipped, since its vtraces depend on the data.
+if [[ ${data_image} == 1 && $ci == 0 ]]; then
+  echo "Error: data_image=1 needs the Verilator model (ci)."
+  exit 1
+fi
+
 # Initialize the error report
 timestamp=$(date +%Y%m%d%H%M%S)
 error_rpt=./benchmark_errors_${timestamp}.rpt
@@ -74,6 +115,11 @@ compile_and_run() {
     id_opt=""
   fi
 
+  # Timed repetitions of each kernel (apps/common/bench.h)
+  if [[ -n $bench_iter ]]; then
+    defines="$defines -DBENCH_ITER=${bench_iter}"
+  fi
+
   echo "Compiling ${kernel}${id_suffix} benchmark:"
   config=${config} ENV_DEFINES="-D${kernel^^}=1 $defines" \
          make -C apps/ bin/benchmarks${id_suffix} || exit
@@ -81,22 +127,54 @@ compile_and_run() {
   config=${config} make -C hardware/ -B $sim app=benchmarks ${id_opt} > $tempfile || exit
 }
 
+# Simulate the kernel on the data image of args, compiling the benchmark
+# with the first data image of the kernel only
+run_data_image() {
+  kernel=$1
+  args=$2
+  defines=$3
+  tempfile=$4
+
+  if [[ ${data_image_kernel} != $kernel ]]; then
+    clean_and_gen_data $kernel "$args" || exit
+    if [[ -n $bench_iter ]]; then
+      defines="$defines -DBENCH_ITER=${bench_iter}"
+    fi
+    echo "Compiling ${kernel} benchmark for data images:"
+    config=${config} ENV_DEFINES="-D${kernel^^}=1 $defines" \
+           make -C apps/ bin/benchmarks data_image=1 || exit
+    data_image_kernel=$kernel
+    data_image_bin=`mktemp`
+  fi
+
+  echo "Generating the data image of $kernel ($args)"
+  set -o pipefail
+  $python ./apps/$kernel/script/gen_data.py $args | \
+    $python ./scripts/data_image.py --nr-lanes ${nr_lanes} --args "$kernel $args" -o ${data_image_bin} || exit
+  set +o pipefail
+  echo "Simulating ${kernel} on the data image:"
+  config=${config} make -C hardware/ -B $sim app=benchmarks data_bin=${data_image_bin} > $tempfile || exit
+}
+
 extract_performance() {
   kernel=$1
   args=$2
   tempfile=$3
   outfile=$4
 
-  echo "Extracting cycle count measure"
-  hw_cycles=$(cat $tempfile | grep "\[hw-cycles\]" | tr -s " " | cut -d: -f 2)
-  # If we have a SW-cycle count, check that the HW one for improved reliability
-  if [[ ! $outfile =~ "ideal" ]]; then
-    sw_cycles=$(cat $tempfile | grep "\[sw-cycles\]" | tr -s " " | cut -d: -f 2)
-    echo "Checking hw and sw cycles. $python ./scripts/check_cycles.py $kernel $hw_cycles $sw_cycles"
-    $python ./scripts/check_cycles.py $kernel $hw_cycles $sw_cycles || exit
+  # The ideal dispatcher has no SW-cycle count
+  if [[ $outfile =~ "ideal" ]]; then
+    id_opt="--ideal"
+  else
+    id_opt=""
   fi
-  echo "Extracting performance from cycle count"
-  $python ./scripts/performance.py $kernel "$args" $hw_cycles >> $outfile || exit
+
+  # Check the cycle counts, extract the performance, and record the result
+  echo "Recording the result of $kernel ($args) in ${results_db}"
+  $python ./scripts/benchmark_db.py record -o ${results_db} --kernel $kernel --args "$args" \
+    --config ${config} --nr-lanes ${nr_lanes} --vlen ${vlen} ${id_opt} --mem ${mem}       \
+    --nr-vinsn ${nr_vinsn} --queues ${queues} --pipe ${pipe}                              \
+    --benchmark $outfile $tempfile || exit
 }
 
 extract_performance_dotp() {
@@ -110,6 +188,11 @@ extract_performance_dotp() {
   info_1=$(cat $tempfile | grep "\[hw-cycles\]" | tr -s " " | cut -d: -f 2)
   info="$info_0 $info_1"
   echo $info >> $outfile
+
+  $python ./scripts/benchmark_db.py record -o ${results_db} --kernel $kernel --args "$args" \
+    --config ${config} --nr-lanes ${nr_lanes} --vlen ${vlen} --sew ${sew} --mem ${mem}    \
+    --nr-vinsn ${nr_vinsn} --queues ${queues} --pipe ${pipe}                              \
+    $( [[ $outfile =~ "ideal" ]] && echo --ideal ) $tempfile || exit
 }
 
 # The two simulations can produce different results whenever they use
@@ -119,132 +202,295 @@ extract_performance_dotp() {
 # and the incoming operands can be added (subtracted) to different partial
 # accumulators, i.e. the order of the reduction operations can be different
 # also among simulations with the same source data whenever the system or
-# program are different.
+# program are different. The sums of vfredsum_repro have a fixed order, and
+# the same bits in the two simulations.
 verify_id_results() {
   threshold=$1
   sew=$2
 
-  id_results=hardware/id_results.txt
-  gold_results=hardware/gold_results.txt
+  id_results=hardware/id_results.bin
+  gold_results=hardware/gold_results.bin
 
-  echo "Summary of the first 10 lines for ID results:"
-  head -n 10 ${id_results}
-  echo "Summary of the first 10 lines for default-system results:"
-  head -n 10 ${gold_results}
   echo "Verifying ideal_dispatcher results:"
-  if [ $threshold -gt 0 ]; then
-    i=0
-    while IFS= read -r l0 && IFS= read -r l1 <&3; do
-      # Find the last byte of a floating-point word
-      i=$(($i + 1))
-      if [ $(($i % ($sew / 8))) -eq 0 ]; then
-        # abs(x-y)
-        diff=$((16#${l0} - 16#${l1}))
-        diff=${diff#-}
-        # More than threshold?
-        if [[ $diff -gt $threshold ]]; then
-          echo "Error. Test failed."
-          return -1
-        fi
-      fi
-    done < ${id_results} 3< ${gold_results}
-  else
-    diff ${id_results} ${gold_results}
-    if [ $? -ne 0 ]; then
-      echo "Error. Test failed."
-    fi
-    return $?
+  $python ./scripts/compare_results.py ${id_results} ${gold_results} ${threshold} ${sew}
+  if [ $? -ne 0 ]; then
+    echo "Error. Test failed."
+    return -1
   fi
 }
 
 sew_from_dtype() {
+  benchmark_apps() {
   case $1 in
-    "double" | "int64_t" | "uint64_t")
-    echo '64'
-    ;;
+      "double" | "int64_t" | "uint64_t")
+      echo '64'
+      ;;
 
-    "float" | "int32_t" | "uint32_t")
-    echo '32'
-    ;;
+      "float" | "int32_t" | "uint32_t")
+      echo '32'
+      ;;
 
-    "_Float16" | "int16_t" | "uint16_t")
-    echo '16'
-    ;;
+      "_Float16" | "int16_t" | "uint16_t")
+      echo '16'
+      ;;
 
-    "_Float8" | "int8_t" | "uint8_t")
-    echo '8'
-    ;;
+      "_Float8" | "int8_t" | "uint8_t")
+      echo '8'
+      ;;
 
-    *)
-    echo '-'
-    ;;
-  esac
-}
+      *)
+      echo '-'
+      ;;
+    esac
+  }
 
-#############
-## Kernels ##
-#############
+  #############
+  ## Kernels ##
+  #############
 
-############
-## MATMUL ##
-############
+  ############
+  ## MATMUL ##
+  ############
 
-matmul() {
+  matmul() {
 
-  kernel=$1
-  defines=""
+    kernel=$1
+    defines=""
 
-  tempfile=`mktemp`
+    tempfile=`mktemp`
 
-  # Log the performance results
-  > ${kernel}_${nr_lanes}.benchmark
-  > ${kernel}_${nr_lanes}_ideal.benchmark
+    # Log the performance results
+    > ${kernel}_${nr_lanes}.benchmark
+    > ${kernel}_${nr_lanes}_ideal.benchmark
 
-  # Measure the following matrix sizes
-  for size in 4 8 16 32 64 128; do
+    # Measure the following matrix sizes
+    for size in 4 8 16 32 64 128; do
 
-    args="$size $size $size"
+      args="$size $size $size"
 
-    # Clean
-    clean_and_gen_data $kernel "$args" || exit
+      # One binary for all the sizes
+      if [[ ${data_image} == 1 ]]; then
+        run_data_image $kernel "$args" "$defines" $tempfile                           || exit
+        extract_performance $kernel "$args" $tempfile ${kernel}_${nr_lanes}.benchmark || exit
+        continue
+      fi
+
+      # Clean
+      clean_and_gen_data $kernel "$args" || exit
+
+      # Default System
+      compile_and_run $kernel "$defines" $tempfile 0                                || exit
+      extract_performance $kernel "$args" $tempfile ${kernel}_${nr_lanes}.benchmark || exit
+
+      # Ideal Dispatcher System, if QuestaSim is available
+      if [ "$ci" == 0 ]; then
+        compile_and_run $kernel "$defines" $tempfile 1                                      || exit
+        extract_performance $kernel "$args" $tempfile ${kernel}_${nr_lanes}_ideal.benchmark || exit
+        # Verify ID results is non-blocking! Check the report afterwards
+        verify_id_results 0 | tee -a ${error_rpt}
+      fi
+    done
+  }
+
+  ################
+  ## CONV2D 3x3 ##
+  ################
 
-    # Default System
-    compile_and_run $kernel "$defines" $tempfile 0                                || exit
-    extract_performance $kernel "$args" $tempfile ${kernel}_${nr_lanes}.benchmark || exit
+  conv2d() {
 
-    # Ideal Dispatcher System, if QuestaSim is available
-    if [ "$ci" == 0 ]; then
-      compile_and_run $kernel "$defines" $tempfile 1                                      || exit
-      extract_performance $kernel "$args" $tempfile ${kernel}_${nr_lanes}_ideal.benchmark || exit
-      # Verify ID results is non-blocking! Check the report afterwards
-      verify_id_results 0 | tee -a ${error_rpt}
+    kernel=$1
+    defines=""
+
+    tempfile=`mktemp`
+
+    # Log the performance results
+    > ${kernel}_${nr_lanes}.benchmark
+    > ${kernel}_${nr_lanes}_ideal.benchmark
+
+    # Measure the following matrix and filter sizes
+    # The input image is also padded, and the max vl is 128
+    # MAXVL_M2_64b - F_MAX + 1 = 128 - 7 + 1 = 122 is the max number of elements
+    # Actually 120, since it must be divible by 4
+    # fconv2d also sweeps the filter sizes of the generic KxK kernel
+    fsizes="3"
+    if [ "$kernel" == "fconv2d" ]; then
+      fsizes="1 3 5 7 11"
+      > ${kernel}_kxk_${nr_lanes}.benchmark
     fi
-  done
-}
+    # iconv2d also measures the int8 kernel, requantized
+    if [ "$kernel" == "iconv2d" ]; then
+      > ${kernel}_i8_${nr_lanes}.benchmark
+    fi
+    for msize in 4 8 16 32 64 112; do
+      for fsize in $fsizes; do
 
-################
-## CONV2D 3x3 ##
-################
+        args="$msize $fsize"
 
-conv2d() {
+        clean_and_gen_data $kernel "$args" || exit
 
-  kernel=$1
-  defines=""
+        # Default System
+        compile_and_run $kernel "$defines" $tempfile 0                                || exit
+        extract_performance $kernel "$args" $tempfile ${kernel}_${nr_lanes}.benchmark || exit
+
+        # Ideal Dispatcher System, if QuestaSim is available
+        if [ "$ci" == 0 ]; then
+          compile_and_run $kernel "$defines" $tempfile 1                                      || exit
+          extract_performance $kernel "$args" $tempfile ${kernel}_${nr_lanes}_ideal.benchmark || exit
+          # Verify ID results is non-blocking! Check the report afterwards
+          verify_id_results 0 | tee -a ${error_rpt}
+        fi
+
+        # Compare the hand-tuned 3x3 and 7x7 kernels with the generic one
+        # The subshell keeps $kernel and $defines for the next sizes
+        if [ "$kernel" == "fconv2d" ] && [[ $fsize == 3 || $fsize == 7 ]]; then
+          (compile_and_run $kernel "$defines -DFCONV2D_KXK" $tempfile 0 &&
+           extract_performance ${kernel}_kxk "$args" $tempfile ${kernel}_kxk_${nr_lanes}.benchmark) || exit
+        fi
+        if [ "$kernel" == "iconv2d" ]; then
+          (compile_and_run $kernel "$defines -DICONV2D_I8" $tempfile 0 &&
+           extract_performance ${kernel}_i8 "$args" $tempfile ${kernel}_i8_${nr_lanes}.benchmark) || exit
+        fi
+      done
+    done
+  }
+
+  ##################
+  ## CONV2D LAYER ##
+  ##################
+
+  conv2d_layer() {
+
+    kernel=conv2d_layer
+    defines=""
+
+    tempfile=`mktemp`
+
+    # Log the performance results
+    > ${kernel}_${nr_lanes}.benchmark
+    > ${kernel}_${nr_lanes}_ideal.benchmark
+
+    # 16 -> 16 channels, 3x3 filters, with stride 1 and 2
+    for size in 8 16 32; do
+      for stride in 1 2; do
+
+        args="1 16 16 $size $size 3 $stride 1"
+
+        clean_and_gen_data $kernel "$args" || exit
+
+        # Default System
+        compile_and_run $kernel "$defines" $tempfile 0                                || exit
+        extract_performance $kernel "$args" $tempfile ${kernel}_${nr_lanes}.benchmark || exit
+
+        # Ideal Dispatcher System, if QuestaSim is available
+        if [ "$ci" == 0 ]; then
+          compile_and_run $kernel "$defines" $tempfile 1                                      || exit
+          extract_performance $kernel "$args" $tempfile ${kernel}_${nr_lanes}_ideal.benchmark || exit
+          # Verify ID results is non-blocking! Check the report afterwards
+          verify_id_results 0 | tee -a ${error_rpt}
+        fi
+      done
+    done
+  }
+
+  ##################################
+  ## CONV2D LAYER ALGORITHM SWEEP ##
+  ##################################
+
+  # Measure each algorithm of conv2d_layer on a grid of shapes, for the
+  # decision table of conv2d_layer_auto (scripts/conv2d_layer_table.py)
+  conv2d_layer_sweep() {
+
+    kernel=conv2d_layer
+    defines=""
+
+    tempfile=`mktemp`
+
+    for algo in direct im2col winograd; do
+      > ${kernel}_${algo}_${nr_lanes}.benchmark
+    done
+
+    for ch in 4 16 64; do
+      for size in 8 16 32; do
+        for filter in "3 1" "3 2" "1 1"; do
+
+          args="1 $ch $ch $size $size $filter $(( ${filter%% *} / 2 ))"
+
+          clean_and_gen_data $kernel "$args" || exit
+
+          # The subshell keeps $kernel and $defines for the next algorithm
+          for algo in direct im2col winograd; do
+            (compile_and_run $kernel "$defines -DCONV2D_LAYER_ALGO=CONV2D_LAYER_${algo^^}" $tempfile 0 &&
+             extract_performance ${kernel}_${algo} "$args" $tempfile ${kernel}_${algo}_${nr_lanes}.benchmark) || exit
+          done
+        done
+      done
+    done
+
+    echo "Update the decision table with:"
+    echo "  $python ./scripts/conv2d_layer_table.py ${results_db}"
+  }
+
+  ################
+  ## CONV3D 7x7 ##
+  ################
+
+  fconv3d() {
+
+    kernel=fconv3d
+    defines=""
+
+    tempfile=`mktemp`
+
+    # Log the performance results
+    > ${kernel}_${nr_lanes}.benchmark
+    > ${kernel}_${nr_lanes}_ideal.benchmark
+
+    # Measure the following matrix and filter sizes
+    # The input image is also padded, and the max vl is 128
+    # MAXVL_M2_64b - F_MAX + 1 = 128 - 7 + 1 = 122 is the max number of elements
+    # Actually 120, since it must be divible by 4
+    for msize in 4 8 16 32 64 112; do
+      for fsize in 7; do
+
+        args="$msize $fsize"
 
-  tempfile=`mktemp`
+        clean_and_gen_data $kernel "$args" || exit
 
-  # Log the performance results
-  > ${kernel}_${nr_lanes}.benchmark
-  > ${kernel}_${nr_lanes}_ideal.benchmark
+        # Default System
+        compile_and_run $kernel "$defines" $tempfile 0                                || exit
+        extract_performance $kernel "$args" $tempfile ${kernel}_${nr_lanes}.benchmark || exit
 
-  # Measure the following matrix and filter sizes
-  # The input image is also padded, and the max vl is 128
-  # MAXVL_M2_64b - F_MAX + 1 = 128 - 7 + 1 = 122 is the max number of elements
-  # Actually 120, since it must be divible by 4
-  for msize in 4 8 16 32 64 112; do
-    for fsize in 3; do
+        # Ideal Dispatcher System, if QuestaSim is available
+        if [ "$ci" == 0 ]; then
+          compile_and_run $kernel "$defines" $tempfile 1                                      || exit
+          extract_performance $kernel "$args" $tempfile ${kernel}_${nr_lanes}_ideal.benchmark || exit
+          # Verify ID results is non-blocking! Check the report afterwards
+          verify_id_results 0 | tee -a ${error_rpt}
+        fi
+      done
+    done
+  }
+
+  ##############
+  ## Jacobi2d ##
+  ##############
+
+  jacobi2d() {
+
+    kernel=jacobi2d
+    defines=""
+
+    tempfile=`mktemp`
+
+    # Log the performance results
+    > ${kernel}_${nr_lanes}.benchmark
+    > ${kernel}_${nr_lanes}_ideal.benchmark
+    > ${kernel}_tb_${nr_lanes}.benchmark
+
+    for vsize_unpadded in 4 8 16 32 64 128; do
+      vsize=$(($vsize_unpadded + 2))
 
-      args="$msize $fsize"
+      args="$vsize $vsize"
 
       clean_and_gen_data $kernel "$args" || exit
 
@@ -259,33 +505,34 @@ conv2d() {
         # Verify ID results is non-blocking! Check the report afterwards
         verify_id_results 0 | tee -a ${error_rpt}
       fi
+
+      # Temporal blocking, over four time steps
+      args_tb="$vsize $vsize 4"
+      (clean_and_gen_data $kernel "$args_tb" &&
+       compile_and_run $kernel "$defines -DJ2D_TB" $tempfile 0 &&
+       extract_performance ${kernel}_tb "$args_tb" $tempfile ${kernel}_tb_${nr_lanes}.benchmark) || exit
     done
-  done
-}
+  }
 
-################
-## CONV3D 7x7 ##
-################
+  #############
+  ## DROPOUT ##
+  #############
 
-fconv3d() {
+  dropout() {
 
-  kernel=fconv3d
-  defines=""
+    kernel=dropout
+    defines=""
 
-  tempfile=`mktemp`
+    tempfile=`mktemp`
 
-  # Log the performance results
-  > ${kernel}_${nr_lanes}.benchmark
-  > ${kernel}_${nr_lanes}_ideal.benchmark
+    # Log the performance results
+    > ${kernel}_${nr_lanes}.benchmark
+    > ${kernel}_${nr_lanes}_ideal.benchmark
+    > ${kernel}_rng_${nr_lanes}.benchmark
 
-  # Measure the following matrix and filter sizes
-  # The input image is also padded, and the max vl is 128
-  # MAXVL_M2_64b - F_MAX + 1 = 128 - 7 + 1 = 122 is the max number of elements
-  # Actually 120, since it must be divible by 4
-  for msize in 4 8 16 32 64 112; do
-    for fsize in 7; do
+    for vsize in 4 8 16 32 64 128 256 512 1024 2048; do
 
-      args="$msize $fsize"
+      args="$vsize"
 
       clean_and_gen_data $kernel "$args" || exit
 
@@ -300,326 +547,461 @@ fconv3d() {
         # Verify ID results is non-blocking! Check the report afterwards
         verify_id_results 0 | tee -a ${error_rpt}
       fi
+
+      # Mask generated at runtime
+      (compile_and_run $kernel "$defines -DDROPOUT_RNG" $tempfile 0 &&
+       extract_performance ${kernel}_rng "$args" $tempfile ${kernel}_rng_${nr_lanes}.benchmark) || exit
     done
-  done
-}
+  }
 
-##############
-## Jacobi2d ##
-##############
+  #########
+  ## FFT ##
+  #########
 
-jacobi2d() {
+  fft() {
 
-  kernel=jacobi2d
-  defines=""
+    kernel=fft
 
-  tempfile=`mktemp`
+    tempfile=`mktemp`
 
-  # Log the performance results
-  > ${kernel}_${nr_lanes}.benchmark
-  > ${kernel}_${nr_lanes}_ideal.benchmark
+    # Log the performance results
+    > ${kernel}_${nr_lanes}.benchmark
+    > ${kernel}_${nr_lanes}_ideal.benchmark
+    > ${kernel}_r4_${nr_lanes}.benchmark
+    > ${kernel}_r4_cplx_${nr_lanes}.benchmark
+    > ${kernel}_batch_${nr_lanes}.benchmark
+    > ${kernel}_2d_${nr_lanes}.benchmark
+    > ${kernel}_q15_${nr_lanes}.benchmark
+    > ${kernel}_rfft_${nr_lanes}.benchmark
 
-  for vsize_unpadded in 4 8 16 32 64 128; do
-    vsize=$(($vsize_unpadded + 2))
+    # Transforms of the batched FFT, and rows of the 2D FFT
+    batch=16
 
-    args="$vsize $vsize"
+    # Type should be in the format "floatXY"
+    dtype="float32"
+    dbits=${dtype:5:2}
 
-    clean_and_gen_data $kernel "$args" || exit
+    # 2-lanes and vlen == 4096 cannot contain 256 float32 elements
+    for vsize in 4 8 16 32 64 128 $(test $vlen -ge $(( 256 * ${dtype:5:2} )) && echo 256); do
 
-    # Default System
-    compile_and_run $kernel "$defines" $tempfile 0                                || exit
-    extract_performance $kernel "$args" $tempfile ${kernel}_${nr_lanes}.benchmark || exit
+      args="$vsize $dtype"
+      defines="-DFFT_SAMPLES=${vsize}"
 
-    # Ideal Dispatcher System, if QuestaSim is available
-    if [ "$ci" == 0 ]; then
-      compile_and_run $kernel "$defines" $tempfile 1                                      || exit
-      extract_performance $kernel "$args" $tempfile ${kernel}_${nr_lanes}_ideal.benchmark || exit
-      # Verify ID results is non-blocking! Check the report afterwards
-      verify_id_results 0 | tee -a ${error_rpt}
-    fi
-  done
-}
+      clean_and_gen_data $kernel "$args $batch" || exit
 
-#############
-## DROPOUT ##
-#############
+      # Default System
+      compile_and_run $kernel "$defines" $tempfile 0                                || exit
+      extract_performance $kernel "$args" $tempfile ${kernel}_${nr_lanes}.benchmark || exit
 
-dropout() {
+      # Ideal Dispatcher System, if QuestaSim is available
+      if [ "$ci" == 0 ]; then
+        compile_and_run $kernel "$defines" $tempfile 1                                      || exit
+        extract_performance $kernel "$args" $tempfile ${kernel}_${nr_lanes}_ideal.benchmark || exit
+        # Verify ID results is non-blocking! Check the report afterwards
+        verify_id_results 0 | tee -a ${error_rpt}
+      fi
 
-  kernel=dropout
-  defines=""
+      # Batched FFTs, vectorized across the batch, and 2D FFT
+      (compile_and_run $kernel "$defines -DFFT_BATCH" $tempfile 0 &&
+       extract_performance ${kernel}_batch "$args $batch" $tempfile ${kernel}_batch_${nr_lanes}.benchmark) || exit
+      (compile_and_run $kernel "$defines -DFFT_2D" $tempfile 0 &&
+       extract_performance ${kernel}_2d "$args $batch" $tempfile ${kernel}_2d_${nr_lanes}.benchmark) || exit
+
+      # Compare with the radix-4 Stockham FFT, on split and interleaved samples
+      # The subshell keeps $kernel and $defines for the next sizes
+      (compile_and_run $kernel "$defines -DFFT_R4" $tempfile 0 &&
+       extract_performance ${kernel}_r4 "$args" $tempfile ${kernel}_r4_${nr_lanes}.benchmark) || exit
+      (compile_and_run $kernel "$defines -DFFT_R4_CPLX" $tempfile 0 &&
+       extract_performance ${kernel}_r4_cplx "$args" $tempfile ${kernel}_r4_cplx_${nr_lanes}.benchmark) || exit
+      # Q15 version of the radix-2 DIF, at SEW=16
+      (compile_and_run $kernel "$defines -DFFT_Q15" $tempfile 0 &&
+       extract_performance ${kernel}_q15 "$args" $tempfile ${kernel}_q15_${nr_lanes}.benchmark) || exit
+      # Real-input FFT, through the complex FFT of half the samples
+      (compile_and_run $kernel "$defines -DFFT_RFFT" $tempfile 0 &&
+       extract_performance ${kernel}_rfft "$args" $tempfile ${kernel}_rfft_${nr_lanes}.benchmark) || exit
+    done
+  }
 
-  tempfile=`mktemp`
+  #########
+  ## DWT ##
+  #########
 
-  # Log the performance results
-  > ${kernel}_${nr_lanes}.benchmark
-  > ${kernel}_${nr_lanes}_ideal.benchmark
+  dwt() {
 
-  for vsize in 4 8 16 32 64 128 256 512 1024 2048; do
+    kernel=dwt
+    defines=""
 
-    args="$vsize"
+    tempfile=`mktemp`
 
-    clean_and_gen_data $kernel "$args" || exit
+    # Log the performance results
+    > ${kernel}_${nr_lanes}.benchmark
+    > ${kernel}_${nr_lanes}_ideal.benchmark
 
-    # Default System
-    compile_and_run $kernel "$defines" $tempfile 0                                || exit
-    extract_performance $kernel "$args" $tempfile ${kernel}_${nr_lanes}.benchmark || exit
+    for vsize in 4 8 16 32 64 128 256 512; do
 
-    # Ideal Dispatcher System, if QuestaSim is available
-    if [ "$ci" == 0 ]; then
-      compile_and_run $kernel "$defines" $tempfile 1                                      || exit
-      extract_performance $kernel "$args" $tempfile ${kernel}_${nr_lanes}_ideal.benchmark || exit
-      # Verify ID results is non-blocking! Check the report afterwards
-      verify_id_results 0 | tee -a ${error_rpt}
-    fi
-  done
-}
+      args="$vsize"
 
-#########
-## FFT ##
-#########
+      clean_and_gen_data $kernel "$args" || exit
 
-fft() {
+      # Default System
+      compile_and_run $kernel "$defines" $tempfile 0                                || exit
+      extract_performance $kernel "$args" $tempfile ${kernel}_${nr_lanes}.benchmark || exit
 
-  kernel=fft
+      # Ideal Dispatcher System, if QuestaSim is available
+      if [ "$ci" == 0 ]; then
+        compile_and_run $kernel "$defines" $tempfile 1                                      || exit
+        extract_performance $kernel "$args" $tempfile ${kernel}_${nr_lanes}_ideal.benchmark || exit
+        # Verify ID results is non-blocking! Check the report afterwards
+        verify_id_results 0 | tee -a ${error_rpt}
+      fi
+    done
+  }
 
-  tempfile=`mktemp`
+  #########
+  ## EXP ##
+  #########
 
-  # Log the performance results
-  > ${kernel}_${nr_lanes}.benchmark
-  > ${kernel}_${nr_lanes}_ideal.benchmark
+  exp() {
 
-  # Type should be in the format "floatXY"
-  dtype="float32"
-  dbits=${dtype:5:2}
+    kernel=exp
+    defines=""
 
-  # 2-lanes and vlen == 4096 cannot contain 256 float32 elements
-  for vsize in 4 8 16 32 64 128 $(test $vlen -ge $(( 256 * ${dtype:5:2} )) && echo 256); do
+    tempfile=`mktemp`
 
-    args="$vsize $dtype"
-    defines="-DFFT_SAMPLES=${vsize}"
+    # Log the performance results
+    > ${kernel}_${nr_lanes}.benchmark
+    > ${kernel}_${nr_lanes}_ideal.benchmark
 
-    clean_and_gen_data $kernel "$args" || exit
+    for vsize in 4 8 16 32 64 128 256 512; do
 
-    # Default System
-    compile_and_run $kernel "$defines" $tempfile 0                                || exit
-    extract_performance $kernel "$args" $tempfile ${kernel}_${nr_lanes}.benchmark || exit
+      args="$vsize"
 
-    # Ideal Dispatcher System, if QuestaSim is available
-    if [ "$ci" == 0 ]; then
-      compile_and_run $kernel "$defines" $tempfile 1                                      || exit
-      extract_performance $kernel "$args" $tempfile ${kernel}_${nr_lanes}_ideal.benchmark || exit
-      # Verify ID results is non-blocking! Check the report afterwards
-      verify_id_results 0 | tee -a ${error_rpt}
-    fi
-  done
-}
+      clean_and_gen_data $kernel "$args" || exit
 
-#########
-## DWT ##
-#########
+      # Default System
+      compile_and_run $kernel "$defines" $tempfile 0                                || exit
+      extract_performance $kernel "$args" $tempfile ${kernel}_${nr_lanes}.benchmark || exit
 
-dwt() {
+      # Ideal Dispatcher System, if QuestaSim is available
+      if [ "$ci" == 0 ]; then
+        compile_and_run $kernel "$defines" $tempfile 1                                      || exit
+        extract_performance $kernel "$args" $tempfile ${kernel}_${nr_lanes}_ideal.benchmark || exit
+        # Verify ID results is non-blocking! Check the report afterwards
+        verify_id_results 0 | tee -a ${error_rpt}
+      fi
+    done
+  }
 
-  kernel=dwt
-  defines=""
+  #############
+  ## SOFTMAX ##
+  #############
 
-  tempfile=`mktemp`
+  softmax() {
 
-  # Log the performance results
-  > ${kernel}_${nr_lanes}.benchmark
-  > ${kernel}_${nr_lanes}_ideal.benchmark
+    kernel=softmax
+    defines=""
 
-  for vsize in 4 8 16 32 64 128 256 512; do
+    chsize=32
 
-    args="$vsize"
+    tempfile=`mktemp`
 
-    clean_and_gen_data $kernel "$args" || exit
+    # Log the performance results
+    > ${kernel}_${nr_lanes}.benchmark
+    > ${kernel}_${nr_lanes}_ideal.benchmark
+    > ${kernel}_online_${nr_lanes}.benchmark
+    > ${kernel}_rows_${nr_lanes}.benchmark
+    > ${kernel}_f16_${nr_lanes}.benchmark
 
-    # Default System
-    compile_and_run $kernel "$defines" $tempfile 0                                || exit
-    extract_performance $kernel "$args" $tempfile ${kernel}_${nr_lanes}.benchmark || exit
+    for insize in 4 8 16 32 64 128 256 512; do
 
-    # Ideal Dispatcher System, if QuestaSim is available
-    if [ "$ci" == 0 ]; then
-      compile_and_run $kernel "$defines" $tempfile 1                                      || exit
-      extract_performance $kernel "$args" $tempfile ${kernel}_${nr_lanes}_ideal.benchmark || exit
-      # Verify ID results is non-blocking! Check the report afterwards
-      verify_id_results 0 | tee -a ${error_rpt}
-    fi
-  done
-}
+      args="$chsize $insize"
 
-#########
-## EXP ##
-#########
+      clean_and_gen_data $kernel "$args" || exit
 
-exp() {
+      # Default System
+      compile_and_run $kernel "$defines" $tempfile 0                                || exit
+      extract_performance $kernel "$args" $tempfile ${kernel}_${nr_lanes}.benchmark || exit
 
-  kernel=exp
-  defines=""
+      # Ideal Dispatcher System, if QuestaSim is available
+      if [ "$ci" == 0 ]; then
+        compile_and_run $kernel "$defines" $tempfile 1                                      || exit
+        extract_performance $kernel "$args" $tempfile ${kernel}_${nr_lanes}_ideal.benchmark || exit
+        # Verify ID results is non-blocking! Check the report afterwards
+        verify_id_results 0 | tee -a ${error_rpt}
+      fi
 
-  tempfile=`mktemp`
+      # Online softmax along the channels, and over the last axis
+      (compile_and_run $kernel "$defines -DSOFTMAX_ONLINE" $tempfile 0 &&
+       extract_performance ${kernel}_online "$args" $tempfile ${kernel}_online_${nr_lanes}.benchmark) || exit
+      (compile_and_run $kernel "$defines -DSOFTMAX_ROWS" $tempfile 0 &&
+       extract_performance ${kernel}_rows "$args" $tempfile ${kernel}_rows_${nr_lanes}.benchmark) || exit
+      # FP16 softmax along the channels, with FP32 exponentials and sums
+      (compile_and_run $kernel "$defines -DSOFTMAX_F16" $tempfile 0 &&
+       extract_performance ${kernel}_f16 "$args" $tempfile ${kernel}_f16_${nr_lanes}.benchmark) || exit
+    done
+  }
 
-  # Log the performance results
-  > ${kernel}_${nr_lanes}.benchmark
-  > ${kernel}_${nr_lanes}_ideal.benchmark
+  #################
+  ## FDOTPRODUCT ##
+  #################
 
-  for vsize in 4 8 16 32 64 128 256 512; do
+  fdotproduct() {
+    kernel=fdotproduct
 
-    args="$vsize"
+    tempfile=`mktemp`
 
-    clean_and_gen_data $kernel "$args" || exit
+    # Log the performance results
+    > ${kernel}_${nr_lanes}.benchmark
+    > ${kernel}_${nr_lanes}_ideal.benchmark
 
-    # Default System
-    compile_and_run $kernel "$defines" $tempfile 0                                || exit
-    extract_performance $kernel "$args" $tempfile ${kernel}_${nr_lanes}.benchmark || exit
+    for dtype in double float _Float16; do
+      for bsize in 16 32 64 128 256 512 1024 2048 4096; do
 
-    # Ideal Dispatcher System, if QuestaSim is available
-    if [ "$ci" == 0 ]; then
-      compile_and_run $kernel "$defines" $tempfile 1                                      || exit
-      extract_performance $kernel "$args" $tempfile ${kernel}_${nr_lanes}_ideal.benchmark || exit
-      # Verify ID results is non-blocking! Check the report afterwards
-      verify_id_results 0 | tee -a ${error_rpt}
-    fi
-  done
-}
+        sew=$(sew_from_dtype $dtype)
 
-#############
-## SOFTMAX ##
-#############
+        args="$bsize"
+        defines="-Ddtype=${dtype}"
 
-softmax() {
+        clean_and_gen_data $kernel "$args" || exit
 
-  kernel=softmax
-  defines=""
+        # Default System
+        compile_and_run $kernel "$defines" $tempfile 0                                           || exit
+        extract_performance_dotp $kernel "$args" $sew $tempfile ${kernel}_${nr_lanes}.benchmark  || exit
 
-  chsize=32
+        # Ideal Dispatcher System, if QuestaSim is available
+        if [ "$ci" == 0 ]; then
+          compile_and_run $kernel "$defines" $tempfile 1                                                || exit
+          extract_performance_dotp $kernel "$args" $sew $tempfile ${kernel}_${nr_lanes}_ideal.benchmark || exit
+          # Verify ID results is non-blocking! Check the report afterwards
+          verify_id_results 0 | tee -a ${error_rpt}
+        fi
+      done
+    done
+  }
 
-  tempfile=`mktemp`
+  ################
+  ## DOTPRODUCT ##
+  ################
 
-  # Log the performance results
-  > ${kernel}_${nr_lanes}.benchmark
-  > ${kernel}_${nr_lanes}_ideal.benchmark
+  dotproduct() {
 
-  for insize in 4 8 16 32 64 128 256 512; do
+    kernel=dotproduct
 
-    args="$chsize $insize"
+    tempfile=`mktemp`
 
-    clean_and_gen_data $kernel "$args" || exit
+    # Log the performance results
+    > ${kernel}_${nr_lanes}.benchmark
+    > ${kernel}_${nr_lanes}_ideal.benchmark
 
-    # Default System
-    compile_and_run $kernel "$defines" $tempfile 0                                || exit
-    extract_performance $kernel "$args" $tempfile ${kernel}_${nr_lanes}.benchmark || exit
+    # Up to one million elements, i.e., up to 8 MiB per vector with int64_t
+    for dtype in int64_t int32_t int16_t int8_t; do
+      for avl in 2 8 32 128 512 2048 8192 32768 131072 1048576; do
 
-    # Ideal Dispatcher System, if QuestaSim is available
-    if [ "$ci" == 0 ]; then
-      compile_and_run $kernel "$defines" $tempfile 1                                      || exit
-      extract_performance $kernel "$args" $tempfile ${kernel}_${nr_lanes}_ideal.benchmark || exit
-      # Verify ID results is non-blocking! Check the report afterwards
-      verify_id_results 0 | tee -a ${error_rpt}
-    fi
-  done
-}
+        sew=$(sew_from_dtype $dtype)
+        bsize=$(( avl * sew / 8 ))
+
+        args="$bsize"
+        defines="-Ddtype=${dtype}"
+
+        clean_and_gen_data $kernel "$args" || exit
+
+        # Default System
+        compile_and_run $kernel "$defines" $tempfile 0                                           || exit
+        extract_performance_dotp $kernel "$args" $sew $tempfile ${kernel}_${nr_lanes}.benchmark  || exit
+
+        # Ideal Dispatcher System, if QuestaSim is available
+        if [ "$ci" == 0 ]; then
+          compile_and_run $kernel "$defines" $tempfile 1                                                || exit
+          extract_performance_dotp $kernel "$args" $sew $tempfile ${kernel}_${nr_lanes}_ideal.benchmark || exit
+          # Verify ID results is non-blocking! Check the report afterwards
+          verify_id_results 0 | tee -a ${error_rpt}
+        fi
+      done
+    done
+  }
+
+  ################
+  ## PATHFINDER ##
+  ################
+
+  pathfinder() {
+
+    kernel=pathfinder
+    defines=""
+
+    runs=1
+
+    tempfile=`mktemp`
+
+    # Log the performance results
+    > ${kernel}_${nr_lanes}.benchmark
+    > ${kernel}_${nr_lanes}_ideal.benchmark
+
+    for cols in 4 8 16 32 64 128 256 512 1024; do
+      for rows in 64; do
 
-#################
-## FDOTPRODUCT ##
-#################
+        args="$runs $cols $rows"
 
-fdotproduct() {
-  kernel=fdotproduct
+        clean_and_gen_data $kernel "$args" || exit
 
-  tempfile=`mktemp`
+        # Default System
+        compile_and_run $kernel "$defines" $tempfile 0                                || exit
+        extract_performance $kernel "$args" $tempfile ${kernel}_${nr_lanes}.benchmark || exit
 
-  # Log the performance results
-  > ${kernel}_${nr_lanes}.benchmark
-  > ${kernel}_${nr_lanes}_ideal.benchmark
+        # Ideal Dispatcher System, if QuestaSim is available
+        if [ "$ci" == 0 ]; then
+          compile_and_run $kernel "$defines" $tempfile 1                                      || exit
+          extract_performance $kernel "$args" $tempfile ${kernel}_${nr_lanes}_ideal.benchmark || exit
+          # Verify ID results is non-blocking! Check the report afterwards
+          verify_id_results 0 | tee -a ${error_rpt}
+        fi
+      done
+    done
+  }
+
+  ###############
+  ## ROI-ALIGN ##
+  ###############
+
+  roi_align() {
 
-  for dtype in double float _Float16; do
-    for bsize in 16 32 64 128 256 512 1024 2048 4096; do
+    kernel=roi_align
+    defines=""
 
-      sew=$(sew_from_dtype $dtype)
+    batch_size=1
+    height=16
+    width=16
+    n_boxes=4
+    crop_h=4
+    crop_w=4
 
-      args="$bsize"
-      defines="-Ddtype=${dtype}"
+    tempfile=`mktemp`
+
+    # Log the performance results
+    > ${kernel}_${nr_lanes}.benchmark
+    > ${kernel}_${nr_lanes}_ideal.benchmark
+
+    for depth in 4 8 16 32 64 128 256 512; do
+
+      args="$batch_size $depth $height $width $n_boxes $crop_h $crop_w"
 
       clean_and_gen_data $kernel "$args" || exit
 
       # Default System
-      compile_and_run $kernel "$defines" $tempfile 0                                           || exit
-      extract_performance_dotp $kernel "$args" $sew $tempfile ${kernel}_${nr_lanes}.benchmark  || exit
+      compile_and_run $kernel "$defines" $tempfile 0                                || exit
+      extract_performance $kernel "$args" $tempfile ${kernel}_${nr_lanes}.benchmark || exit
 
       # Ideal Dispatcher System, if QuestaSim is available
       if [ "$ci" == 0 ]; then
-        compile_and_run $kernel "$defines" $tempfile 1                                                || exit
-        extract_performance_dotp $kernel "$args" $sew $tempfile ${kernel}_${nr_lanes}_ideal.benchmark || exit
+        compile_and_run $kernel "$defines" $tempfile 1                                      || exit
+        extract_performance $kernel "$args" $tempfile ${kernel}_${nr_lanes}_ideal.benchmark || exit
         # Verify ID results is non-blocking! Check the report afterwards
         verify_id_results 0 | tee -a ${error_rpt}
       fi
     done
-  done
-}
+  }
 
-################
-## DOTPRODUCT ##
-################
+  ###########
+  ## FGEMV ##
+  ###########
 
-dotproduct() {
+  fgemv() {
 
-  kernel=dotproduct
+    kernel=fgemv
+    defines=""
 
-  tempfile=`mktemp`
+    rows=128
 
-  # Log the performance results
-  > ${kernel}_${nr_lanes}.benchmark
-  > ${kernel}_${nr_lanes}_ideal.benchmark
+    tempfile=`mktemp`
 
-  for dtype in int64_t int32_t int16_t int8_t; do
-    for bsize in 16 32 64 128 256 512 1024 2048 4096; do
+    # Log the performance results
+    > ${kernel}_${nr_lanes}.benchmark
+    > ${kernel}_${nr_lanes}_ideal.benchmark
 
-      sew=$(sew_from_dtype $dtype)
+    for cols in 4 8 16 32 64 128 256 512; do
 
-      args="$bsize"
-      defines="-Ddtype=${dtype}"
+      args="$rows $cols"
 
       clean_and_gen_data $kernel "$args" || exit
 
       # Default System
-      compile_and_run $kernel "$defines" $tempfile 0                                           || exit
-      extract_performance_dotp $kernel "$args" $sew $tempfile ${kernel}_${nr_lanes}.benchmark  || exit
+      compile_and_run $kernel "$defines" $tempfile 0                                || exit
+      extract_performance $kernel "$args" $tempfile ${kernel}_${nr_lanes}.benchmark || exit
 
       # Ideal Dispatcher System, if QuestaSim is available
       if [ "$ci" == 0 ]; then
-        compile_and_run $kernel "$defines" $tempfile 1                                                || exit
-        extract_performance_dotp $kernel "$args" $sew $tempfile ${kernel}_${nr_lanes}_ideal.benchmark || exit
+        compile_and_run $kernel "$defines" $tempfile 1                                      || exit
+        extract_performance $kernel "$args" $tempfile ${kernel}_${nr_lanes}_ideal.benchmark || exit
         # Verify ID results is non-blocking! Check the report afterwards
         verify_id_results 0 | tee -a ${error_rpt}
       fi
     done
-  done
-}
+  }
+
+  ##########
+  ## SPMV ##
+  ##########
+
+  spmv() {
+
+    kernel=spmv
+    defines=""
+
+    size=256
+
+    tempfile=`mktemp`
 
-################
-## PATHFINDER ##
-################
+    # Log the performance results
+    > ${kernel}_${nr_lanes}.benchmark
+    > ${kernel}_${nr_lanes}_ideal.benchmark
+    > ${kernel}_sell_${nr_lanes}.benchmark
 
-pathfinder() {
+    for pattern in uniform banded powerlaw; do
+      for nnz_per_row in 2 4 8 16 32; do
 
-  kernel=pathfinder
-  defines=""
+        args="$size $size $nnz_per_row $pattern"
 
-  runs=1
+        clean_and_gen_data $kernel "$args" || exit
 
-  tempfile=`mktemp`
+        # Default System, CSR
+        compile_and_run $kernel "$defines" $tempfile 0                                || exit
+        extract_performance $kernel "$args" $tempfile ${kernel}_${nr_lanes}.benchmark || exit
 
-  # Log the performance results
-  > ${kernel}_${nr_lanes}.benchmark
-  > ${kernel}_${nr_lanes}_ideal.benchmark
+        # Ideal Dispatcher System, if QuestaSim is available
+        if [ "$ci" == 0 ]; then
+          compile_and_run $kernel "$defines" $tempfile 1                                      || exit
+          extract_performance $kernel "$args" $tempfile ${kernel}_${nr_lanes}_ideal.benchmark || exit
+          # Verify ID results is non-blocking! Check the report afterwards
+          verify_id_results 0 | tee -a ${error_rpt}
+        fi
+
+        # SELL-C-sigma
+        (compile_and_run $kernel "$defines -DSPMV_SELL" $tempfile 0 &&
+         extract_performance ${kernel}_sell "$args" $tempfile ${kernel}_sell_${nr_lanes}.benchmark) || exit
+      done
+    done
+  }
+
+  #####################
+  ## FMATMUL BATCHED ##
+  #####################
+
+  fmatmul_batched() {
+
+    kernel=fmatmul_batched
+    defines=""
+
+    size=16
+
+    tempfile=`mktemp`
 
-  for cols in 4 8 16 32 64 128 256 512 1024; do
-    for rows in 64; do
+    # Log the performance results
+    > ${kernel}_${nr_lanes}.benchmark
+    > ${kernel}_${nr_lanes}_ideal.benchmark
 
-      args="$runs $cols $rows"
+    for batch in 1 2 4 8 16 32 64; do
+
+      args="$size $size $size $batch"
 
       clean_and_gen_data $kernel "$args" || exit
 
@@ -635,120 +1017,1346 @@ pathfinder() {
         verify_id_results 0 | tee -a ${error_rpt}
       fi
     done
-  done
-}
+  }
 
-###############
-## ROI-ALIGN ##
-###############
+  ###############
+  ## LAYERNORM ##
+  ###############
 
-roi_align() {
+  layernorm() {
 
-  kernel=roi_align
-  defines=""
+    kernel=layernorm
+    defines=""
 
-  batch_size=1
-  height=16
-  width=16
-  n_boxes=4
-  crop_h=4
-  crop_w=4
+    rows=4
 
-  tempfile=`mktemp`
+    tempfile=`mktemp`
 
-  # Log the performance results
-  > ${kernel}_${nr_lanes}.benchmark
-  > ${kernel}_${nr_lanes}_ideal.benchmark
+    # Log the performance results
+    > ${kernel}_${nr_lanes}.benchmark
+    > ${kernel}_${nr_lanes}_ideal.benchmark
+    > ${kernel}_f16_${nr_lanes}.benchmark
+    > rmsnorm_${nr_lanes}.benchmark
+    > rmsnorm_f16_${nr_lanes}.benchmark
 
-  for depth in 4 8 16 32 64 128 256 512; do
+    for cols in 16 32 64 128 256 512 1024 2048; do
 
-    args="$batch_size $depth $height $width $n_boxes $crop_h $crop_w"
+      args="$rows $cols"
 
-    clean_and_gen_data $kernel "$args" || exit
+      clean_and_gen_data $kernel "$args" || exit
 
-    # Default System
-    compile_and_run $kernel "$defines" $tempfile 0                                || exit
-    extract_performance $kernel "$args" $tempfile ${kernel}_${nr_lanes}.benchmark || exit
+      # Default System, FP32 LayerNorm
+      compile_and_run $kernel "$defines" $tempfile 0                                || exit
+      extract_performance $kernel "$args" $tempfile ${kernel}_${nr_lanes}.benchmark || exit
 
-    # Ideal Dispatcher System, if QuestaSim is available
-    if [ "$ci" == 0 ]; then
-      compile_and_run $kernel "$defines" $tempfile 1                                      || exit
-      extract_performance $kernel "$args" $tempfile ${kernel}_${nr_lanes}_ideal.benchmark || exit
-      # Verify ID results is non-blocking! Check the report afterwards
-      verify_id_results 0 | tee -a ${error_rpt}
-    fi
-  done
-}
+      # Ideal Dispatcher System, if QuestaSim is available
+      if [ "$ci" == 0 ]; then
+        compile_and_run $kernel "$defines" $tempfile 1                                      || exit
+        extract_performance $kernel "$args" $tempfile ${kernel}_${nr_lanes}_ideal.benchmark || exit
+        # Verify ID results is non-blocking! Check the report afterwards
+        verify_id_results 0 | tee -a ${error_rpt}
+      fi
+
+      # FP16 LayerNorm, and FP32 and FP16 RMSNorm
+      (compile_and_run $kernel "$defines -DLAYERNORM_F16" $tempfile 0 &&
+       extract_performance ${kernel}_f16 "$args" $tempfile ${kernel}_f16_${nr_lanes}.benchmark) || exit
+      (compile_and_run $kernel "$defines -DRMSNORM" $tempfile 0 &&
+       extract_performance rmsnorm "$args" $tempfile rmsnorm_${nr_lanes}.benchmark) || exit
+      (compile_and_run $kernel "$defines -DRMSNORM -DLAYERNORM_F16" $tempfile 0 &&
+       extract_performance rmsnorm_f16 "$args" $tempfile rmsnorm_f16_${nr_lanes}.benchmark) || exit
+    done
+  }
+
+  ###############
+  ## ATTENTION ##
+  ###############
+
+  attention() {
+
+    kernel=attention
+    defines=""
+
+    tempfile=`mktemp`
+
+    # Log the performance results
+    > ${kernel}_${nr_lanes}.benchmark
+    > ${kernel}_${nr_lanes}_ideal.benchmark
+    > ${kernel}_unfused_${nr_lanes}.benchmark
 
-case $1 in
-  "imatmul" | "fmatmul")
-    matmul $1
-    ;;
-
-  "iconv2d" | "fconv2d")
-    conv2d $1
-    ;;
-
-  "fconv3d")
-    fconv3d
-    ;;
-
-  "jacobi2d")
-    jacobi2d
-    ;;
-
-  "dropout")
-    dropout
-    ;;
-
-  "fft")
-    fft
-    ;;
-
-  "dwt")
-    dwt
-    ;;
-
-  "exp")
-    exp
-    ;;
-
-  "softmax")
-    softmax
-    ;;
-
-  "fdotproduct")
-    fdotproduct
-    ;;
-
-  "dotproduct")
-    dotproduct
-    ;;
-
-  "pathfinder")
-    pathfinder
-    ;;
-
-  "roi_align")
-    roi_align
-    ;;
-
-  *)
-    echo "Benchmarking all the apps."
-    matmul imatmul
-    matmul fmatmul
-    conv2d iconv2d
-    conv2d fconv2d
-    fconv3d
-    jacobi2d
-    dropout
-    fft
-    dwt
-    exp
-    softmax
-    fdotproduct
-    dotproduct
-    pathfinder
-    roi_align
-    ;;
-esac
+    for hdim in 32 64; do
+      for seqlen in 16 32 64 128 256; do
+
+        args="$seqlen $hdim"
+
+        clean_and_gen_data $kernel "$args" || exit
+
+        # Default System, fused kernel
+        compile_and_run $kernel "$defines" $tempfile 0                                || exit
+        extract_performance $kernel "$args" $tempfile ${kernel}_${nr_lanes}.benchmark || exit
+
+        # Ideal Dispatcher System, if QuestaSim is available
+        if [ "$ci" == 0 ]; then
+          compile_and_run $kernel "$defines" $tempfile 1                                      || exit
+          extract_performance $kernel "$args" $tempfile ${kernel}_${nr_lanes}_ideal.benchmark || exit
+          # Verify ID results is non-blocking! Check the report afterwards
+          verify_id_results 0 | tee -a ${error_rpt}
+        fi
+
+        # fmatmul_f32, softmax_rows_vec, and fmatmul_f32, through the score matrix
+        (compile_and_run $kernel "$defines -DATTENTION_UNFUSED" $tempfile 0 &&
+         extract_performance ${kernel}_unfused "$args" $tempfile ${kernel}_unfused_${nr_lanes}.benchmark) || exit
+      done
+    done
+  }
+
+  ##########
+  ## SORT ##
+  ##########
+
+  # Not named sort, not to hide the command
+  sort_u32() {
+
+    kernel=sort
+    defines=""
+
+    tempfile=`mktemp`
+
+    # Log the performance results
+    > ${kernel}_${nr_lanes}.benchmark
+    > ${kernel}_${nr_lanes}_ideal.benchmark
+    > ${kernel}_merge_${nr_lanes}.benchmark
+    > ${kernel}_scalar_${nr_lanes}.benchmark
+
+    # The keys of rsort (riscv-tests), and random ones
+    for args in rsort 256 1024 4096 16384; do
+
+      clean_and_gen_data $kernel "$args" || exit
+
+      # Default System, radix sort
+      compile_and_run $kernel "$defines" $tempfile 0                                || exit
+      extract_performance $kernel "$args" $tempfile ${kernel}_${nr_lanes}.benchmark || exit
+
+      # Ideal Dispatcher System, if QuestaSim is available
+      if [ "$ci" == 0 ]; then
+        compile_and_run $kernel "$defines" $tempfile 1                                      || exit
+        extract_performance $kernel "$args" $tempfile ${kernel}_${nr_lanes}_ideal.benchmark || exit
+        # Verify ID results is non-blocking! Check the report afterwards
+        verify_id_results 0 | tee -a ${error_rpt}
+      fi
+
+      # Bitonic blocks and merge path, and the scalar radix sort
+      (compile_and_run $kernel "$defines -DSORT_MERGE" $tempfile 0 &&
+       extract_performance ${kernel}_merge "$args" $tempfile ${kernel}_merge_${nr_lanes}.benchmark) || exit
+      (compile_and_run $kernel "$defines -DSORT_SCALAR" $tempfile 0 &&
+       extract_performance ${kernel}_scalar "$args" $tempfile ${kernel}_scalar_${nr_lanes}.benchmark) || exit
+    done
+  }
+
+  ###############
+  ## HIST_SCAN ##
+  ###############
+
+  hist_scan() {
+
+    kernel=hist_scan
+    defines=""
+
+    tempfile=`mktemp`
+
+    # Log the performance results
+    > hist_u8_${nr_lanes}.benchmark
+    > hist_u8_${nr_lanes}_ideal.benchmark
+    > hist_u16_${nr_lanes}.benchmark
+    > scan_i32_${nr_lanes}.benchmark
+    > scan_f32_${nr_lanes}.benchmark
+
+    # Elements, and bins of the 16-bit histogram
+    for args in "1024 256" "4096 1024" "16384 4096"; do
+
+      clean_and_gen_data $kernel "$args" || exit
+
+      # Default System, 8-bit histogram. The subshell keeps $kernel for the next
+      # sizes, as extract_performance sets it to hist_u8.
+      (compile_and_run $kernel "$defines" $tempfile 0 &&
+       extract_performance hist_u8 "$args" $tempfile hist_u8_${nr_lanes}.benchmark) || exit
+
+      # Ideal Dispatcher System, if QuestaSim is available
+      if [ "$ci" == 0 ]; then
+        (compile_and_run $kernel "$defines" $tempfile 1 &&
+         extract_performance hist_u8 "$args" $tempfile hist_u8_${nr_lanes}_ideal.benchmark) || exit
+        # Verify ID results is non-blocking! Check the report afterwards
+        verify_id_results 0 | tee -a ${error_rpt}
+      fi
+
+      # 16-bit histogram, and the INT32 and FP32 prefix sums
+      (compile_and_run $kernel "$defines -DHIST_U16" $tempfile 0 &&
+       extract_performance hist_u16 "$args" $tempfile hist_u16_${nr_lanes}.benchmark) || exit
+      (compile_and_run $kernel "$defines -DSCAN_I32" $tempfile 0 &&
+       extract_performance scan_i32 "$args" $tempfile scan_i32_${nr_lanes}.benchmark) || exit
+      (compile_and_run $kernel "$defines -DSCAN_F32" $tempfile 0 &&
+       extract_performance scan_f32 "$args" $tempfile scan_f32_${nr_lanes}.benchmark) || exit
+    done
+  }
+
+  ###########
+  ## BLAS1 ##
+  ###########
+
+  blas1() {
+
+    kernel=blas1
+    defines=""
+
+    tempfile=`mktemp`
+
+    # Log the performance results
+    > ${kernel}_daxpy_${nr_lanes}_ideal.benchmark
+    for op in daxpy saxpy dscal dcopy dnrm2 dasum idamax; do
+      > ${kernel}_${op}_${nr_lanes}.benchmark
+    done
+
+    # Elements and strides, unit-stride (vle/vse) and strided (vlse/vsse)
+    for args in "1024 1" "4096 1" "16384 1" "4096 2" "4096 8"; do
+
+      clean_and_gen_data $kernel "$args" || exit
+
+      # Default System, all the kernels
+      for op in daxpy saxpy dscal dcopy dnrm2 dasum idamax; do
+        (compile_and_run $kernel "$defines -DBLAS1_${op^^}" $tempfile 0 &&
+         extract_performance ${kernel}_${op} "$args" $tempfile ${kernel}_${op}_${nr_lanes}.benchmark) || exit
+      done
+
+      # Ideal Dispatcher System, if QuestaSim is available
+      if [ "$ci" == 0 ]; then
+        (compile_and_run $kernel "$defines" $tempfile 1 &&
+         extract_performance ${kernel}_daxpy "$args" $tempfile ${kernel}_daxpy_${nr_lanes}_ideal.benchmark) || exit
+        # Verify ID results is non-blocking! Check the report afterwards
+        verify_id_results 0 | tee -a ${error_rpt}
+      fi
+    done
+  }
+
+  ####################
+  ## VFREDSUM_REPRO ##
+  ####################
+
+  vfredsum_repro() {
+
+    kernel=vfredsum_repro
+    defines=""
+
+    tempfile=`mktemp`
+
+    # Log the performance results
+    > ${kernel}_${nr_lanes}_ideal.benchmark
+    for sfx in "" _kahan _ordered _unordered; do
+      > ${kernel}${sfx}_${nr_lanes}.benchmark
+      > ${kernel}${sfx}_f32_${nr_lanes}.benchmark
+    done
+
+    for args in 1024 4096 16384; do
+
+      clean_and_gen_data $kernel "$args" || exit
+
+      # Default System, reproducible, compensated, vfredosum, and vfredusum
+      # sums, in FP64 and FP32
+      for sfx in "" _kahan _ordered _unordered; do
+        def=$( [[ -n $sfx ]] && echo "-DREPRO${sfx^^}" )
+        (compile_and_run $kernel "$defines $def" $tempfile 0 &&
+         extract_performance ${kernel}${sfx} "$args" $tempfile ${kernel}${sfx}_${nr_lanes}.benchmark) || exit
+        (compile_and_run $kernel "$defines $def -DREPRO_F32" $tempfile 0 &&
+         extract_performance ${kernel}${sfx}_f32 "$args" $tempfile ${kernel}${sfx}_f32_${nr_lanes}.benchmark) || exit
+      done
+
+      # Ideal Dispatcher System, if QuestaSim is available
+      if [ "$ci" == 0 ]; then
+        compile_and_run $kernel "$defines" $tempfile 1                                      || exit
+        extract_performance $kernel "$args" $tempfile ${kernel}_${nr_lanes}_ideal.benchmark || exit
+        # Verify ID results is non-blocking! Check the report afterwards
+        verify_id_results 0 | tee -a ${error_rpt}
+      fi
+    done
+  }
+
+  ############
+  ## DWCONV ##
+  ############
+
+  dwconv() {
+
+    kernel=dwconv
+    defines=""
+
+    tempfile=`mktemp`
+
+    # Log the performance results
+    > ${kernel}_${nr_lanes}_ideal.benchmark
+    for k in dwconv maxpool avgpool globalpool; do
+      > ${k}_${nr_lanes}.benchmark
+      > ${k}_nhwc_${nr_lanes}.benchmark
+    done
+
+    # Depthwise layers of MobileNetV2 (channels, height = width, stride), with
+    # 3x3 pooling windows
+    for args in "192 28 1 3" "192 28 2 3" "384 14 1 3" "576 14 2 3" "960 7 1 3"; do
+
+      clean_and_gen_data $kernel "$args" || exit
+
+      # Default System, the four layers in NCHW and NHWC
+      for k in dwconv maxpool avgpool globalpool; do
+        def=$( [[ $k != dwconv ]] && echo "-D${k^^}" )
+        (compile_and_run $kernel "$defines $def" $tempfile 0 &&
+         extract_performance ${k} "$args" $tempfile ${k}_${nr_lanes}.benchmark) || exit
+        (compile_and_run $kernel "$defines $def -DNHWC" $tempfile 0 &&
+         extract_performance ${k}_nhwc "$args" $tempfile ${k}_nhwc_${nr_lanes}.benchmark) || exit
+      done
+
+      # Ideal Dispatcher System, if QuestaSim is available
+      if [ "$ci" == 0 ]; then
+        compile_and_run $kernel "$defines" $tempfile 1                                      || exit
+        extract_performance $kernel "$args" $tempfile ${kernel}_${nr_lanes}_ideal.benchmark || exit
+        # Verify ID results is non-blocking! Check the report afterwards
+        verify_id_results 0 | tee -a ${error_rpt}
+      fi
+    done
+  }
+
+  ################
+  ## ACTIVATION ##
+  ################
+
+  activation() {
+
+    kernel=activation
+    defines=""
+
+    rows=16
+    n=32
+
+    tempfile=`mktemp`
+
+    # Log the performance results
+    > ${kernel}_${nr_lanes}_ideal.benchmark
+    for k in act_relu act_gelu act_silu; do
+      > ${k}_${nr_lanes}.benchmark
+      > ${k}_f16_${nr_lanes}.benchmark
+    done
+    > act_gemm_gelu_${nr_lanes}.benchmark
+    > act_gemm_gelu_unfused_${nr_lanes}.benchmark
+
+    for cols in 32 64 128 256; do
+
+      args="$rows $cols $n"
+
+      clean_and_gen_data $kernel "$args" || exit
+
+      # Default System, the activations with the bias in FP32 and FP16
+      for k in act_relu act_gelu act_silu; do
+        def=$( [[ $k != act_gelu ]] && echo "-D${k^^}" )
+        (compile_and_run $kernel "$defines $def" $tempfile 0 &&
+         extract_performance ${k} "$args" $tempfile ${k}_${nr_lanes}.benchmark) || exit
+        (compile_and_run $kernel "$defines $def -DACT_F16" $tempfile 0 &&
+         extract_performance ${k}_f16 "$args" $tempfile ${k}_f16_${nr_lanes}.benchmark) || exit
+      done
+
+      # FP64 GEMM with the GELU epilogue fused, and in a separate pass over C
+      (compile_and_run $kernel "$defines -DACT_GEMM" $tempfile 0 &&
+       extract_performance act_gemm_gelu "$args" $tempfile act_gemm_gelu_${nr_lanes}.benchmark) || exit
+      (compile_and_run $kernel "$defines -DACT_GEMM -DACT_UNFUSED" $tempfile 0 &&
+       extract_performance act_gemm_gelu_unfused "$args" $tempfile act_gemm_gelu_unfused_${nr_lanes}.benchmark) || exit
+
+      # Ideal Dispatcher System, if QuestaSim is available
+      if [ "$ci" == 0 ]; then
+        (compile_and_run $kernel "$defines" $tempfile 1 &&
+         extract_performance act_gelu "$args" $tempfile ${kernel}_${nr_lanes}_ideal.benchmark) || exit
+        # Verify ID results is non-blocking! Check the report afterwards
+        verify_id_results 0 | tee -a ${error_rpt}
+      fi
+    done
+  }
+
+  ###########
+  ## QUANT ##
+  ###########
+
+  quant() {
+
+    kernel=quant
+    defines=""
+
+    cols=256
+    shift=8
+
+    tempfile=`mktemp`
+
+    # Log the performance results
+    > ${kernel}_${nr_lanes}_ideal.benchmark
+    for k in quant_i8 quant_u8 quant_i8_pc dequant_i8 dequant_u8 dequant_i8_pc requant_i8; do
+      > ${k}_${nr_lanes}.benchmark
+    done
+
+    for rows in 4 16 64; do
+
+      args="$rows $cols $shift"
+
+      clean_and_gen_data $kernel "$args" || exit
+
+      # Default System, bytes per cycle with respect to the AXI peak
+      for k in quant_i8 quant_u8 quant_i8_pc dequant_i8 dequant_u8 dequant_i8_pc requant_i8; do
+        (compile_and_run $kernel "$defines -D${k^^}" $tempfile 0 &&
+         extract_performance ${k} "$args" $tempfile ${k}_${nr_lanes}.benchmark) || exit
+      done
+
+      # Ideal Dispatcher System, if QuestaSim is available
+      if [ "$ci" == 0 ]; then
+        (compile_and_run $kernel "$defines" $tempfile 1 &&
+         extract_performance quant_i8 "$args" $tempfile ${kernel}_${nr_lanes}_ideal.benchmark) || exit
+        # Verify ID results is non-blocking! Check the report afterwards
+        verify_id_results 0 | tee -a ${error_rpt}
+      fi
+    done
+  }
+
+  ###############
+  ## TRANSPOSE ##
+  ###############
+
+  transpose() {
+
+    kernel=transpose
+    defines=""
+
+    n=1
+    c=32
+
+    tempfile=`mktemp`
+
+    # Log the performance results
+    > ${kernel}_${nr_lanes}_ideal.benchmark
+    for k in transpose_e8 transpose_e16 transpose_e32 transpose_e64 nchw2nhwc nhwc2nchw interleave deinterleave; do
+      > ${k}_${nr_lanes}.benchmark
+    done
+
+    # Feature maps of 7x7, 14x14, and 28x28
+    for hw in 49 196 784; do
+
+      args="$n $c $hw"
+
+      clean_and_gen_data $kernel "$args" || exit
+
+      # Default System, bytes per cycle with respect to the AXI peak
+      for k in transpose_e8 transpose_e16 transpose_e32 transpose_e64 nchw2nhwc nhwc2nchw interleave deinterleave; do
+        (compile_and_run $kernel "$defines -D${k^^}" $tempfile 0 &&
+         extract_performance ${k} "$args" $tempfile ${k}_${nr_lanes}.benchmark) || exit
+      done
+
+      # Ideal Dispatcher System, if QuestaSim is available
+      if [ "$ci" == 0 ]; then
+        (compile_and_run $kernel "$defines" $tempfile 1 &&
+         extract_performance transpose_e32 "$args" $tempfile ${kernel}_${nr_lanes}_ideal.benchmark) || exit
+        # Verify ID results is non-blocking! Check the report afterwards
+        verify_id_results 0 | tee -a ${error_rpt}
+      fi
+    done
+  }
+
+  ##############
+  ## LINSOLVE ##
+  ##############
+
+  linsolve() {
+
+    kernel=linsolve
+    defines=""
+
+    tempfile=`mktemp`
+
+    # Log the performance results
+    > ${kernel}_${nr_lanes}_ideal.benchmark
+    for k in cholesky cholesky_scalar lu lu_scalar; do
+      > ${k}_${nr_lanes}.benchmark
+    done
+
+    for args in 32 64 128; do
+
+      clean_and_gen_data $kernel "$args" || exit
+
+      # Default System, the vector factorizations and their scalar references
+      for k in cholesky lu; do
+        def=$( [[ $k == lu ]] && echo "-DLINSOLVE_LU" )
+        (compile_and_run $kernel "$defines $def" $tempfile 0 &&
+         extract_performance ${k} "$args" $tempfile ${k}_${nr_lanes}.benchmark) || exit
+        (compile_and_run $kernel "$defines $def -DLINSOLVE_SCALAR" $tempfile 0 &&
+         extract_performance ${k}_scalar "$args" $tempfile ${k}_scalar_${nr_lanes}.benchmark) || exit
+      done
+
+      # Ideal Dispatcher System, if QuestaSim is available
+      if [ "$ci" == 0 ]; then
+        (compile_and_run $kernel "$defines" $tempfile 1 &&
+         extract_performance cholesky "$args" $tempfile ${kernel}_${nr_lanes}_ideal.benchmark) || exit
+        # Verify ID results is non-blocking! Check the report afterwards
+        verify_id_results 0 | tee -a ${error_rpt}
+      fi
+    done
+  }
+
+  #########
+  ## KNN ##
+  #########
+
+  knn() {
+
+    kernel=knn
+    defines=""
+
+    nq=4
+    dim=32
+    k=10
+
+    tempfile=`mktemp`
+
+    # Log the performance results
+    > ${kernel}_${nr_lanes}_ideal.benchmark
+    for kk in knn knn_cosine knn_topk; do
+      > ${kk}_${nr_lanes}.benchmark
+    done
+
+    # From a database that fits the VRF to ones that stream from memory
+    for ndb in 256 1024 4096; do
+
+      args="$nq $ndb $dim $k"
+
+      clean_and_gen_data $kernel "$args" || exit
+
+      # Default System
+      compile_and_run $kernel "$defines" $tempfile 0 || exit
+      extract_performance $kernel "$args" $tempfile ${kernel}_${nr_lanes}.benchmark || exit
+      for kk in knn_cosine knn_topk; do
+        (compile_and_run $kernel "$defines -D${kk^^}" $tempfile 0 &&
+         extract_performance ${kk} "$args" $tempfile ${kk}_${nr_lanes}.benchmark) || exit
+      done
+
+      # Ideal Dispatcher System, if QuestaSim is available
+      if [ "$ci" == 0 ]; then
+        compile_and_run $kernel "$defines" $tempfile 1 || exit
+        extract_performance $kernel "$args" $tempfile ${kernel}_${nr_lanes}_ideal.benchmark || exit
+        # Verify ID results is non-blocking! Check the report afterwards
+        verify_id_results 0 | tee -a ${error_rpt}
+      fi
+    done
+  }
+
+  ############
+  ## STREAM ##
+  ############
+
+  stream() {
+
+    kernel=stream
+    defines=""
+
+    n=4096
+    m=256
+
+    tempfile=`mktemp`
+
+    # Log the performance results
+    > ${kernel}_${nr_lanes}_ideal.benchmark
+    for op in copy scale add triad strided; do
+      for sew in 8 16 32 64; do
+        > ${kernel}_${op}_e${sew}_${nr_lanes}.benchmark
+      done
+    done
+    for op in gather gather_clust; do
+      for sew in 32 64; do
+        > ${kernel}_${op}_e${sew}_${nr_lanes}.benchmark
+      done
+    done
+
+    # Strides of 1 to 64 elements. Set mem_sweep to add the timings of the main memory
+    for stride in 1 2 4 8 16 32 64; do
+
+      args="$n $m $stride"
+
+      clean_and_gen_data $kernel "$args" || exit
+
+      # Default System, bytes per cycle with respect to the AXI peak
+      if [ "$stride" == 1 ]; then
+        for op in copy scale add triad; do
+          for sew in 8 16 32 64; do
+            k=${kernel}_${op}_e${sew}
+            (compile_and_run $kernel "$defines -DSTREAM_${op^^} -DSTREAM_SEW=${sew}" $tempfile 0 &&
+             extract_performance ${k} "$args" $tempfile ${k}_${nr_lanes}.benchmark) || exit
+          done
+        done
+        for sew in 32 64; do
+          k=${kernel}_gather_e${sew}
+          (compile_and_run $kernel "$defines -DSTREAM_GATHER -DSTREAM_SEW=${sew}" $tempfile 0 &&
+           extract_performance ${k} "$args" $tempfile ${k}_${nr_lanes}.benchmark) || exit
+          k=${kernel}_gather_clust_e${sew}
+          (compile_and_run $kernel "$defines -DSTREAM_GATHER -DSTREAM_CLUSTERED -DSTREAM_SEW=${sew}" $tempfile 0 &&
+           extract_performance ${k} "$args" $tempfile ${k}_${nr_lanes}.benchmark) || exit
+        done
+
+        # Ideal Dispatcher System, if QuestaSim is available
+        if [ "$ci" == 0 ]; then
+          (compile_and_run $kernel "$defines" $tempfile 1 &&
+           extract_performance stream_triad_e64 "$args" $tempfile ${kernel}_${nr_lanes}_ideal.benchmark) || exit
+          # Verify ID results is non-blocking! Check the report afterwards
+          verify_id_results 0 | tee -a ${error_rpt}
+        fi
+      fi
+
+      for sew in 8 16 32 64; do
+        k=${kernel}_strided_e${sew}
+        (compile_and_run $kernel "$defines -DSTREAM_STRIDED -DSTREAM_SEW=${sew}" $tempfile 0 &&
+         extract_performance ${k} "$args" $tempfile ${k}_${nr_lanes}.benchmark) || exit
+      done
+    done
+  }
+
+  ##########
+  ## HASH ##
+  ##########
+
+  hash_keys() {
+
+    kernel=hash
+    defines=""
+
+    tempfile=`mktemp`
+
+    # Log the performance results
+    > xxh32_${nr_lanes}.benchmark
+    > xxh32_base_${nr_lanes}.benchmark
+    > crc32_${nr_lanes}.benchmark
+    > crc32_base_${nr_lanes}.benchmark
+
+    # Keys, and bytes per key
+    for args in "256 16" "1024 64" "1024 256"; do
+
+      clean_and_gen_data $kernel "$args" || exit
+
+      # Default System, xxHash32 with Zvbb. No Ideal Dispatcher System: its
+      # vtraces come from Spike (RISCV_SIM_MOD_OPT), which has no Zvbb.
+      compile_and_run $kernel "$defines" $tempfile 0                        || exit
+      extract_performance xxh32 "$args" $tempfile xxh32_${nr_lanes}.benchmark || exit
+
+      # Without Zvbb, and the CRC-32 with and without it
+      (compile_and_run $kernel "$defines -DXXH32_BASE" $tempfile 0 &&
+       extract_performance xxh32_base "$args" $tempfile xxh32_base_${nr_lanes}.benchmark) || exit
+      (compile_and_run $kernel "$defines -DCRC32" $tempfile 0 &&
+       extract_performance crc32 "$args" $tempfile crc32_${nr_lanes}.benchmark) || exit
+      (compile_and_run $kernel "$defines -DCRC32_BASE" $tempfile 0 &&
+       extract_performance crc32_base "$args" $tempfile crc32_base_${nr_lanes}.benchmark) || exit
+    done
+  }
+
+  #############
+  ## IMGPROC ##
+  #############
+
+  imgproc() {
+
+    kernel=imgproc
+    defines=""
+
+    tempfile=`mktemp`
+
+    # Log the performance results
+    > ${kernel}_${nr_lanes}_ideal.benchmark
+    for k in imgproc imgproc_unfused imgproc_yuv imgproc_rgb imgproc_blur imgproc_resize; do
+      > ${k}_${nr_lanes}.benchmark
+    done
+    for k in 3 5; do
+      for t in u8 u16 f32 u8_scalar; do
+        > median${k}_${t}_${nr_lanes}.benchmark
+      done
+    done
+
+    # Rows and columns of the image, and of the resize of its blurred luma
+    for args in "36 68 24 48" "68 132 48 96" "132 260 96 192"; do
+
+      clean_and_gen_data $kernel "$args" || exit
+
+      # Default System, fused pipeline
+      compile_and_run $kernel "$defines" $tempfile 0                            || exit
+      extract_performance imgproc "$args" $tempfile imgproc_${nr_lanes}.benchmark || exit
+
+      # Ideal Dispatcher System, if QuestaSim is available
+      if [ "$ci" == 0 ]; then
+        compile_and_run $kernel "$defines" $tempfile 1                                  || exit
+        extract_performance imgproc "$args" $tempfile ${kernel}_${nr_lanes}_ideal.benchmark || exit
+        # Verify ID results is non-blocking! Check the report afterwards
+        verify_id_results 0 | tee -a ${error_rpt}
+      fi
+
+      # The stages one after the other, and each one of them
+      for k in imgproc_unfused imgproc_yuv imgproc_rgb imgproc_blur imgproc_resize; do
+        (compile_and_run $kernel "$defines -D${k^^}" $tempfile 0 &&
+         extract_performance ${k} "$args" $tempfile ${k}_${nr_lanes}.benchmark) || exit
+      done
+
+      # The median filters, and the scalar one
+      for k in 3 5; do
+        for t in u8 u16 f32; do
+          (compile_and_run $kernel "$defines -DIMGPROC_MEDIAN -DMEDIAN_K=$k -DMEDIAN_${t^^}" $tempfile 0 &&
+           extract_performance median${k}_${t} "$args" $tempfile median${k}_${t}_${nr_lanes}.benchmark) || exit
+        done
+        (compile_and_run $kernel "$defines -DIMGPROC_MEDIAN_SCALAR -DMEDIAN_K=$k" $tempfile 0 &&
+         extract_performance median${k}_u8_scalar "$args" $tempfile median${k}_u8_scalar_${nr_lanes}.benchmark) || exit
+      done
+    done
+  }
+
+  ############
+  ## OPTION ##
+  ############
+
+  option() {
+
+    kernel=option
+    defines=""
+
+    tempfile=`mktemp`
+
+    # Log the performance results
+    > ${kernel}_${nr_lanes}_ideal.benchmark
+    for k in black_scholes_f64 black_scholes_f32 mc_call_f32; do
+      > ${k}_${nr_lanes}.benchmark
+    done
+
+    # Options of Black-Scholes, and paths and steps of the Monte-Carlo simulation
+    for args in "64 256 16" "256 1024 16" "1024 4096 16"; do
+
+      clean_and_gen_data $kernel "$args" || exit
+
+      # Default System, options or path steps per cycle
+      for k in black_scholes_f64 black_scholes_f32 mc_call_f32; do
+        (compile_and_run $kernel "$defines -D${k^^}" $tempfile 0 &&
+         extract_performance ${k} "$args" $tempfile ${k}_${nr_lanes}.benchmark) || exit
+      done
+
+      # Ideal Dispatcher System, if QuestaSim is available
+      if [ "$ci" == 0 ]; then
+        (compile_and_run $kernel "$defines" $tempfile 1 &&
+         extract_performance black_scholes_f64 "$args" $tempfile ${kernel}_${nr_lanes}_ideal.benchmark) || exit
+        # Verify ID results is non-blocking! Check the report afterwards
+        verify_id_results 0 | tee -a ${error_rpt}
+      fi
+    done
+  }
+
+  ###############
+  ## EMBEDDING ##
+  ###############
+
+  embedding() {
+
+    kernel=embedding
+    defines=""
+
+    tempfile=`mktemp`
+
+    # Log the performance results
+    > ${kernel}_${nr_lanes}_ideal.benchmark
+    for k in embedding embedding_f16 embedding_rows embedding_bags; do
+      > ${k}_${nr_lanes}.benchmark
+    done
+
+    # Rows and columns of the table, bags, their average length, and Zipf exponent
+    # of the indices: skewed ones, and uniform ones for a reference
+    for args in "1024 4 64 8 1.05" "1024 16 64 8 1.05" "1024 64 64 8 1.05" "1024 256 64 8 1.05" "1024 16 64 8 0"; do
+
+      clean_and_gen_data $kernel "$args" || exit
+
+      # Default System, the kernel picked on the columns, and each one of them
+      compile_and_run $kernel "$defines" $tempfile 0 || exit
+      extract_performance embedding "$args" $tempfile embedding_${nr_lanes}.benchmark || exit
+      for k in embedding_f16 embedding_rows embedding_bags; do
+        (compile_and_run $kernel "$defines -D${k^^}" $tempfile 0 &&
+         extract_performance ${k} "$args" $tempfile ${k}_${nr_lanes}.benchmark) || exit
+      done
+
+      # Ideal Dispatcher System, if QuestaSim is available
+      if [ "$ci" == 0 ]; then
+        (compile_and_run $kernel "$defines" $tempfile 1 &&
+         extract_performance embedding "$args" $tempfile ${kernel}_${nr_lanes}_ideal.benchmark) || exit
+        # Verify ID results is non-blocking! Check the report afterwards
+        verify_id_results 0 | tee -a ${error_rpt}
+      fi
+    done
+  }
+
+  #########
+  ## RNN ##
+  #########
+
+  rnn() {
+
+    kernel=rnn
+    defines=""
+
+    tempfile=`mktemp`
+
+    # Log the performance results
+    > ${kernel}_${nr_lanes}_ideal.benchmark
+    for k in lstm_cell lstm_cell_unfused gru_cell; do
+      > ${k}_${nr_lanes}.benchmark
+    done
+
+    # Inputs, hidden units, batch, and timesteps, with a batch of 1 and one of 8
+    for args in "64 64 1 4" "64 128 1 4" "64 256 1 4" "64 64 8 4" "64 128 8 4" "64 256 8 4"; do
+
+      clean_and_gen_data $kernel "$args" || exit
+
+      # Default System, the fused and unfused LSTM cells and the GRU cell
+      compile_and_run $kernel "$defines" $tempfile 0 || exit
+      extract_performance lstm_cell "$args" $tempfile lstm_cell_${nr_lanes}.benchmark || exit
+      (compile_and_run $kernel "$defines -DLSTM_UNFUSED" $tempfile 0 &&
+       extract_performance lstm_cell_unfused "$args" $tempfile lstm_cell_unfused_${nr_lanes}.benchmark) || exit
+      (compile_and_run $kernel "$defines -DGRU" $tempfile 0 &&
+       extract_performance gru_cell "$args" $tempfile gru_cell_${nr_lanes}.benchmark) || exit
+
+      # Ideal Dispatcher System, if QuestaSim is available
+      if [ "$ci" == 0 ]; then
+        (compile_and_run $kernel "$defines" $tempfile 1 &&
+         extract_performance lstm_cell "$args" $tempfile ${kernel}_${nr_lanes}_ideal.benchmark) || exit
+        # Verify ID results is non-blocking! Check the report afterwards
+        verify_id_results 0 | tee -a ${error_rpt}
+      fi
+    done
+  }
+
+  ##############
+  ## SPMATMUL ##
+  ##############
+
+  spmatmul() {
+
+    kernel=spmatmul
+    defines=""
+
+    tempfile=`mktemp`
+
+    # Log the performance results
+    > ${kernel}_${nr_lanes}_ideal.benchmark
+    for k in spmatmul_f32 spmatmul_i8 spmatmul_dense spmatmul_dense_i8; do
+      > ${k}_${nr_lanes}.benchmark
+    done
+
+    # 2:4 sparse matrices of 64 rows, by dense matrices of 64 columns
+    for n in 64 128 256; do
+
+      args="64 $n 64"
+
+      clean_and_gen_data $kernel "$args" || exit
+
+      # Default System, the sparse kernels and the dense ones on the same data
+      compile_and_run $kernel "$defines" $tempfile 0 || exit
+      extract_performance spmatmul_f32 "$args" $tempfile spmatmul_f32_${nr_lanes}.benchmark || exit
+      for k in spmatmul_i8 spmatmul_dense spmatmul_dense_i8; do
+        (compile_and_run $kernel "$defines -D${k^^}" $tempfile 0 &&
+         extract_performance ${k} "$args" $tempfile ${k}_${nr_lanes}.benchmark) || exit
+      done
+
+      # Ideal Dispatcher System, if QuestaSim is available
+      if [ "$ci" == 0 ]; then
+        (compile_and_run $kernel "$defines" $tempfile 1 &&
+         extract_performance spmatmul_f32 "$args" $tempfile ${kernel}_${nr_lanes}_ideal.benchmark) || exit
+        # Verify ID results is non-blocking! Check the report afterwards
+        verify_id_results 0 | tee -a ${error_rpt}
+      fi
+    done
+  }
+
+  #####################
+  ## FFT CONVOLUTION ##
+  #####################
+
+  # Both paths of the 2D and 1D correlations, for the filter-size thresholds of
+  # fftconv2d_f32 and fftconv1d_f32 (scripts/fftconv_threshold.py)
+  fftconv() {
+
+    kernel=fftconv
+    defines=""
+
+    tempfile=`mktemp`
+
+    # Log the performance results
+    > ${kernel}_${nr_lanes}_ideal.benchmark
+    for k in fftconv2d_direct fftconv2d_fft fftconv1d_direct fftconv1d_fft; do
+      > ${k}_${nr_lanes}.benchmark
+    done
+
+    # 2D filters on 64x64 images with 2 channels, and 1D filters on 4096 samples
+    for filter in "3 16" "5 32" "7 48" "9 64" "11 96" "13 128" "15 192"; do
+
+      args="2 2 64 64 ${filter% *} 4096 ${filter#* }"
+
+      clean_and_gen_data $kernel "$args" || exit
+
+      # Default System. The subshell keeps $kernel and $defines for the next path.
+      for path in direct fft; do
+        (compile_and_run $kernel "$defines -DFFTCONV_PATH=FFTCONV_${path^^}" $tempfile 0 &&
+         extract_performance fftconv2d_${path} "$args" $tempfile fftconv2d_${path}_${nr_lanes}.benchmark) || exit
+        (compile_and_run $kernel "$defines -DFFTCONV_1D -DFFTCONV_PATH=FFTCONV_${path^^}" $tempfile 0 &&
+         extract_performance fftconv1d_${path} "$args" $tempfile fftconv1d_${path}_${nr_lanes}.benchmark) || exit
+      done
+
+      # Ideal Dispatcher System, if QuestaSim is available
+      if [ "$ci" == 0 ]; then
+        (compile_and_run $kernel "$defines" $tempfile 1 &&
+         extract_performance fftconv2d "$args" $tempfile ${kernel}_${nr_lanes}_ideal.benchmark) || exit
+        # Verify ID results is non-blocking! Check the report afterwards
+        verify_id_results 0 | tee -a ${error_rpt}
+      fi
+    done
+
+    echo "Update the thresholds with:"
+    echo "  $python ./scripts/fftconv_threshold.py ${results_db}"
+  }
+
+  ############
+  ## CRYPTO ##
+  ############
+
+  crypto() {
+
+    kernel=crypto
+    defines=""
+
+    tempfile=`mktemp`
+
+    # Log the performance results
+    > aes128_ctr_${nr_lanes}.benchmark
+    > aes128_gcm_${nr_lanes}.benchmark
+    > sha256_${nr_lanes}.benchmark
+
+    # AES blocks, SHA-256 messages, and blocks per message
+    for args in "64 8 1" "256 32 4" "1024 64 16"; do
+
+      clean_and_gen_data $kernel "$args" || exit
+
+      # Default System, AES-128 in counter mode. No Ideal Dispatcher System:
+      # its vtraces come from Spike (RISCV_SIM_MOD_OPT), which has no Zvkned.
+      compile_and_run $kernel "$defines" $tempfile 0                                || exit
+      extract_performance aes128_ctr "$args" $tempfile aes128_ctr_${nr_lanes}.benchmark || exit
+
+      # AES-128-GCM, and SHA-256
+      (compile_and_run $kernel "$defines -DGCM" $tempfile 0 &&
+       extract_performance aes128_gcm "$args" $tempfile aes128_gcm_${nr_lanes}.benchmark) || exit
+      (compile_and_run $kernel "$defines -DSHA256" $tempfile 0 &&
+       extract_performance sha256 "$args" $tempfile sha256_${nr_lanes}.benchmark) || exit
+    done
+  }
+
+  #########
+  ## BFS ##
+  #########
+
+  bfs() {
+
+    kernel=bfs
+    defines=""
+
+    tempfile=`mktemp`
+
+    # Log the performance results
+    > bfs_${nr_lanes}.benchmark
+    > bfs_${nr_lanes}_ideal.benchmark
+    > bfs_top_down_${nr_lanes}.benchmark
+    > bfs_bottom_up_${nr_lanes}.benchmark
+
+    # Scale and edge factor of the R-MAT graphs
+    for args in "8 8" "10 8" "12 16"; do
+
+      clean_and_gen_data $kernel "$args" || exit
+
+      # Default System, direction-optimizing BFS
+      compile_and_run $kernel "$defines" $tempfile 0                  || exit
+      extract_performance bfs "$args" $tempfile bfs_${nr_lanes}.benchmark || exit
+
+      # Ideal Dispatcher System, if QuestaSim is available
+      if [ "$ci" == 0 ]; then
+        compile_and_run $kernel "$defines" $tempfile 1                        || exit
+        extract_performance bfs "$args" $tempfile bfs_${nr_lanes}_ideal.benchmark || exit
+        # Verify ID results is non-blocking! Check the report afterwards
+        verify_id_results 0 | tee -a ${error_rpt}
+      fi
+
+      # Top-down and bottom-up steps only
+      (compile_and_run $kernel "$defines -DBFS_TOP_DOWN" $tempfile 0 &&
+       extract_performance bfs_top_down "$args" $tempfile bfs_top_down_${nr_lanes}.benchmark) || exit
+      (compile_and_run $kernel "$defines -DBFS_BOTTOM_UP" $tempfile 0 &&
+       extract_performance bfs_bottom_up "$args" $tempfile bfs_bottom_up_${nr_lanes}.benchmark) || exit
+    done
+  }
+
+  ############
+  ## KMEANS ##
+  ############
+
+  kmeans() {
+
+    kernel=kmeans
+    defines=""
+
+    tempfile=`mktemp`
+
+    # Log the performance results
+    > kmeans_${nr_lanes}.benchmark
+    > kmeans_${nr_lanes}_ideal.benchmark
+    > kmeans_unfused_${nr_lanes}.benchmark
+    > kmeans_iter_${nr_lanes}.benchmark
+
+    # Points, dimensions, centroids, and iterations
+    for args in "1024 8 8 1" "1024 8 32 1" "4096 16 64 1"; do
+
+      clean_and_gen_data $kernel "$args" || exit
+
+      # Default System, fused assignment
+      compile_and_run $kernel "$defines" $tempfile 0                        || exit
+      extract_performance kmeans "$args" $tempfile kmeans_${nr_lanes}.benchmark || exit
+
+      # Ideal Dispatcher System, if QuestaSim is available
+      if [ "$ci" == 0 ]; then
+        compile_and_run $kernel "$defines" $tempfile 1                              || exit
+        extract_performance kmeans "$args" $tempfile kmeans_${nr_lanes}_ideal.benchmark || exit
+        # Verify ID results is non-blocking! Check the report afterwards
+        verify_id_results 0 | tee -a ${error_rpt}
+      fi
+
+      # Distance matrix and argmin passes, and a whole iteration with the update
+      (compile_and_run $kernel "$defines -DKMEANS_UNFUSED" $tempfile 0 &&
+       extract_performance kmeans_unfused "$args" $tempfile kmeans_unfused_${nr_lanes}.benchmark) || exit
+      (compile_and_run $kernel "$defines -DKMEANS_ITER" $tempfile 0 &&
+       extract_performance kmeans_iter "$args" $tempfile kmeans_iter_${nr_lanes}.benchmark) || exit
+    done
+  }
+
+  ##############
+  ## BYTESCAN ##
+  ##############
+
+  bytescan() {
+
+    kernel=bytescan
+    defines=""
+
+    tempfile=`mktemp`
+
+    # Log the performance results
+    > bytescan_utf8_${nr_lanes}.benchmark
+    > bytescan_utf8_${nr_lanes}_ideal.benchmark
+    > bytescan_memchr_${nr_lanes}.benchmark
+    > bytescan_find_any_${nr_lanes}.benchmark
+    > bytescan_split_${nr_lanes}.benchmark
+    > bytescan_strlen_${nr_lanes}.benchmark
+
+    # Bytes of the text, and percentage of its non-ASCII words
+    for args in "16384 0" "16384 10" "65536 30"; do
+
+      clean_and_gen_data $kernel "$args" || exit
+
+      # Default System, UTF-8 validation
+      compile_and_run $kernel "$defines" $tempfile 0                                 || exit
+      extract_performance bytescan_utf8 "$args" $tempfile bytescan_utf8_${nr_lanes}.benchmark || exit
+
+      # Ideal Dispatcher System, if QuestaSim is available
+      if [ "$ci" == 0 ]; then
+        compile_and_run $kernel "$defines" $tempfile 1                                       || exit
+        extract_performance bytescan_utf8 "$args" $tempfile bytescan_utf8_${nr_lanes}_ideal.benchmark || exit
+        # Verify ID results is non-blocking! Check the report afterwards
+        verify_id_results 0 | tee -a ${error_rpt}
+      fi
+
+      for scan in memchr find_any split strlen; do
+        (compile_and_run $kernel "$defines -DBYTESCAN_${scan^^}" $tempfile 0 &&
+         extract_performance bytescan_${scan} "$args" $tempfile bytescan_${scan}_${nr_lanes}.benchmark) || exit
+      done
+    done
+  }
+
+  #####################
+  ## AUTO-VECTORIZED ##
+  #####################
+
+  # Scalar references of the kernels, built with the LLVM auto-vectorizer (autovec=1, see
+  # apps/common/runtime.mk) on the same data as the hand-written kernels, and recorded as
+  # <kernel>_autovec. "scripts/benchmark_db.py autovec" compares the two
+  autovec() {
+
+    defines=""
+
+    tempfile=`mktemp`
+
+    for kernel in fmatmul jacobi2d pathfinder dropout; do
+      # Log the performance results
+      > ${kernel}_autovec_${nr_lanes}.benchmark
+
+      case $kernel in
+        "fmatmul")    sizes="4 8 16 32 64 128" ;;
+        "jacobi2d")   sizes="6 10 18 34 66 130" ;;
+        "pathfinder") sizes="4 8 16 32 64 128 256 512 1024" ;;
+        "dropout")    sizes="4 8 16 32 64 128 256 512 1024 2048" ;;
+      esac
+
+      for size in $sizes; do
+        case $kernel in
+          "fmatmul")    args="$size $size $size" ;;
+          "jacobi2d")   args="$size $size" ;;
+          "pathfinder") args="1 $size 64" ;;
+          "dropout")    args="$size" ;;
+        esac
+
+        (clean_and_gen_data $kernel "$args" &&
+         autovec=1 compile_and_run $kernel "$defines" $tempfile 0 &&
+         extract_performance ${kernel}_autovec "$args" $tempfile ${kernel}_autovec_${nr_lanes}.benchmark) || exit
+      done
+    done
+  }
+
+  case $1 in
+    "imatmul" | "imatmul_i8" | "imatmul_i16" | "fmatmul" | "fmatmul_f32" | "fmatmul_f16")
+      matmul $1
+      ;;
+
+    "iconv2d" | "fconv2d")
+      conv2d $1
+      ;;
+
+    "fconv3d")
+      fconv3d
+      ;;
+
+    "conv2d_layer")
+      conv2d_layer
+      ;;
+
+    "conv2d_layer_sweep")
+      conv2d_layer_sweep
+      ;;
+
+    "jacobi2d")
+      jacobi2d
+      ;;
+
+    "dropout")
+      dropout
+      ;;
+
+    "fft")
+      fft
+      ;;
+
+    "dwt")
+      dwt
+      ;;
+
+    "exp")
+      exp
+      ;;
+
+    "softmax")
+      softmax
+      ;;
+
+    "fdotproduct")
+      fdotproduct
+      ;;
+
+    "dotproduct")
+      dotproduct
+      ;;
+
+    "pathfinder")
+      pathfinder
+      ;;
+
+    "roi_align")
+      roi_align
+      ;;
+
+    "fgemv")
+      fgemv
+      ;;
+
+    "fmatmul_batched")
+      fmatmul_batched
+      ;;
+
+    "spmv")
+      spmv
+      ;;
+
+    "layernorm")
+      layernorm
+      ;;
+
+    "attention")
+      attention
+      ;;
+
+    "sort")
+      sort_u32
+      ;;
+
+    "hist_scan")
+      hist_scan
+      ;;
+
+    "blas1")
+      blas1
+      ;;
+
+    "vfredsum_repro")
+      vfredsum_repro
+      ;;
+
+    "dwconv")
+      dwconv
+      ;;
+
+    "activation")
+      activation
+      ;;
+
+    "quant")
+      quant
+      ;;
+
+    "transpose")
+      transpose
+      ;;
+
+    "linsolve")
+      linsolve
+      ;;
+
+    "knn")
+      knn
+      ;;
+
+    "stream")
+      stream
+      ;;
+
+    "hash")
+      hash_keys
+      ;;
+
+    "imgproc")
+      imgproc
+      ;;
+
+    "option")
+      option
+      ;;
+
+    "embedding")
+      embedding
+      ;;
+
+    "rnn")
+      rnn
+      ;;
+
+    "spmatmul")
+      spmatmul
+      ;;
+
+    "fftconv")
+      fftconv
+      ;;
+
+    "crypto")
+      crypto
+      ;;
+
+    "bfs")
+      bfs
+      ;;
+
+    "kmeans")
+      kmeans
+      ;;
+
+    "bytescan")
+      bytescan
+      ;;
+
+    "autovec")
+      autovec
+      ;;
+
+    *)
+      echo "Benchmarking all the apps."
+      matmul imatmul
+      matmul imatmul_i8
+      matmul imatmul_i16
+      matmul fmatmul
+      matmul fmatmul_f32
+      matmul fmatmul_f16
+      conv2d iconv2d
+      conv2d fconv2d
+      fconv3d
+      conv2d_layer
+      jacobi2d
+      dropout
+      fft
+      dwt
+      exp
+      softmax
+      fdotproduct
+      dotproduct
+      pathfinder
+      roi_align
+      fgemv
+      fmatmul_batched
+      spmv
+      layernorm
+      attention
+      sort_u32
+      hist_scan
+      blas1
+      vfredsum_repro
+      dwconv
+      activation
+      quant
+      transpose
+      linsolve
+      knn
+      stream
+      hash_keys
+      imgproc
+      option
+      embedding
+      rnn
+      spmatmul
+      fftconv
+      crypto
+      bfs
+      kmeans
+      bytescan
+      autovec
+      ;;
+  esac
+}
+
+for nr_vinsn in ${vinsn_sweep}; do
+  export nr_vinsn
+  for mem in ${mem_sweep}; do
+    IFS=: read dram_rd_latency dram_wr_latency dram_bw dram_banks <<< "$mem"
+    export dram_rd_latency dram_wr_latency dram_bw dram_banks
+    echo "Main memory: read latency ${dram_rd_latency}, write latency ${dram_wr_latency}, ${dram_bw} B/cycle, ${dram_banks} banks"
+    echo "Vector instructions in flight: ${nr_vinsn}"
+
+    # The Verilator model is built for one hardware configuration. QuestaSim recompiles it in compile_and_run.
+    if [ "$ci" == 1 ] && [ "$mem_rebuild" == 1 ]; then
+      config=${config} make -C hardware/ -W Makefile verilate || exit
+    fi
+
+    benchmark_apps $1
+  done
+done
@@ -14,7 +14,7 @@ hardware=$root/hardware
 timestamp=$(date +%Y%m%d%k%M%S)
 tmp=$root/benchmark_all_tmp
 result=$root/benchmark-runs/$timestamp
-files="*.benchmark *.png"
+files="*.benchmark *.jsonl *.png"
 python=python3
 
 # Move to root directory
@@ -46,10 +46,13 @@ if [ "$kernel" -eq "*dotproduct" ]; then
   ${python} ./scripts/process_dotp.py ${kernel} ${kernel}_ideal.benchmark ${kernel}_ideal
 else
   gnuplot $script/benchmark.gnuplot
+  # One bottleneck table per lane configuration
+  ${python} $script/bottleneck_report.py -o ${kernel}_bottleneck.md benchmark_results.jsonl
+  ${python} $script/roofline.py -o ${kernel}_roofline.md -p ${kernel}_roofline.png benchmark_results.jsonl
 fi
 
 # Save results
-mv *.benchmark *.png $result/
+mv *.benchmark *.jsonl *.png *.md $result/
 
 # Take the files back
 mv $tmp/$files $root
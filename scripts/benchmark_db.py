@@ -0,0 +1,622 @@
+#!/usr/bin/env python3
+# Copyright 2022 ETH Zurich and University of Bologna.
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+# Database of the benchmark results, one JSON object per line (JSON lines).
+#
+#   record:  parse the log of a simulation and append its result to the database
+#   compare: flag the performance regressions between two databases (or two
+#            commits of the same database), against per-kernel thresholds
+#   window:  print the speedup of each instruction window (nr_vinsn) wrt the
+#            default one, next to its estimated cost in flip-flops
+#   pipeline: print the cycles of each pipeline setting (pipe) wrt the default one,
+#            next to its timing and area on the FPGA, if its reports are there
+#   energy:  print the estimated energy of each measure (energy_model.py), and what
+#            the clock gating of the units saves on it
+#
+# Each record contains:
+#   kernel, args, config, nr_lanes, vlen, ideal: what was measured
+#   git, dirty:                   the commit of the tree, and whether it had local changes
+#   hw_cycles, sw_cycles:         the cycle counts (sw_cycles is null for the ideal dispatcher)
+#   sw_cycles_{min,median,max}, iterations: the statistics of the repeated runs (apps/common/bench.h)
+#   cycles_per_elem, overhead_cycles:       the linear fit over the kernel sizes, if any
+#   size, flop_per_cycle:         the performance.py metrics, if the kernel has them
+#   sew:                          the element width, for the kernels that sweep it
+#   mem, nr_vinsn, queues, pipe:  the timing of the main memory, the instructions in flight, the depths of
+#                                 the instruction queues, and the pipeline stages, if not the default
+#   perf_cnt:                     the performance events of the measured window, by name
+#   energy_pj, pj_per_op:         the energy of the window estimated from perf_cnt (energy_model.py),
+#                                 and per operation of performance.py, if the kernel has them
+#
+# Usage: benchmark_db.py record -o DB --kernel K --args ARGS --config C --nr-lanes N --vlen V [--ideal] LOG
+#        benchmark_db.py compare [--base-git HASH] [--new-git HASH] BASE_DB [NEW_DB]
+#        benchmark_db.py window [--git HASH] DB
+#        benchmark_db.py pipeline [--git HASH] [--fpga DIR] DB
+#        benchmark_db.py energy [--git HASH] [--model JSON] DB
+
+import argparse
+import json
+import math
+import os
+import re
+import subprocess
+import sys
+import time
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+import check_cycles
+import energy_model
+import performance
+
+# Keep in sync with perf_events_t in ara_pkg.sv (bit 0 first)
+PERF_EVENTS = ['valu_busy', 'vmfpu_busy', 'vldu_busy', 'vstu_busy', 'sldu_busy', 'masku_busy',
+               'stall_lanes_desynch', 'stall_vinsn_full', 'stall_hazard', 'vrf_bank_conflict',
+               'axi_r_beat', 'axi_w_beat', 'acc_req_stall', 'valu_clk_on', 'vmfpu_clk_on',
+               'sldu_clk_on', 'acc_early_ack', 'vcache_hit', 'vcache_miss',
+               'prefetch_beat', 'prefetch_hit', 'st_merge', 'st_wcb_beat',
+               'vmfpu2_busy', 'vmxu_busy', 'vrf_rw_conflict', 'vmfpu2_clk_on']
+
+# Maximum slowdown (new/base cycles - 1) before a result is flagged as a regression
+threshold = {
+  'imatmul'     : 0.02,
+  'imatmul_i8'  : 0.02,
+  'imatmul_i16' : 0.02,
+  'fmatmul'     : 0.02,
+  'fmatmul_f32' : 0.02,
+  'fmatmul_f16' : 0.02,
+  'iconv2d'     : 0.02,
+  'iconv2d_i8'  : 0.02,
+  'fconv2d'     : 0.02,
+  'fconv2d_kxk' : 0.02,
+  'fconv3d'     : 0.02,
+  'conv2d_layer': 0.02,
+  'conv2d_layer_direct'  : 0.02,
+  'conv2d_layer_im2col'  : 0.02,
+  'conv2d_layer_winograd': 0.02,
+  'jacobi2d'    : 0.02,
+  'jacobi2d_tb' : 0.02,
+  'dropout'     : 0.02,
+  'dropout_rng' : 0.02,
+  'fft'         : 0.02,
+  'fft_r4'      : 0.02,
+  'fft_r4_cplx' : 0.02,
+  'fft_batch'   : 0.02,
+  'fft_2d'      : 0.02,
+  'fft_q15'     : 0.02,
+  'fft_rfft'    : 0.02,
+  'dwt'         : 0.02,
+  'exp'         : 0.02,
+  'softmax'     : 0.02,
+  'softmax_online': 0.02,
+  'softmax_rows'  : 0.02,
+  'softmax_f16'   : 0.02,
+  'dotproduct'  : 0.02,
+  'fdotproduct' : 0.02,
+  'pathfinder'  : 0.02,
+  'roi_align'   : 0.02,
+  'fgemv'       : 0.02,
+  'fmatmul_batched' : 0.02,
+  'spmv'        : 0.02,
+  'spmv_sell'   : 0.02,
+  'fmatmul_autovec'    : 0.02,
+  'jacobi2d_autovec'   : 0.02,
+  'pathfinder_autovec' : 0.02,
+  'dropout_autovec'    : 0.02,
+  'layernorm'   : 0.02,
+  'layernorm_f16' : 0.02,
+  'rmsnorm'     : 0.02,
+  'rmsnorm_f16' : 0.02,
+  'attention'   : 0.02,
+  'attention_unfused' : 0.02,
+  'sort'        : 0.02,
+  'sort_merge'  : 0.02,
+  'sort_scalar' : 0.02,
+  'hist_u8'     : 0.02,
+  'hist_u16'    : 0.02,
+  'scan_i32'    : 0.02,
+  'scan_f32'    : 0.02,
+  'blas1_daxpy' : 0.02,
+  'blas1_saxpy' : 0.02,
+  'blas1_dscal' : 0.02,
+  'blas1_dcopy' : 0.02,
+  'blas1_dnrm2' : 0.02,
+  'blas1_dasum' : 0.02,
+  'blas1_idamax': 0.02,
+  'vfredsum_repro'            : 0.02,
+  'vfredsum_repro_f32'        : 0.02,
+  'vfredsum_repro_kahan'      : 0.02,
+  'vfredsum_repro_kahan_f32'  : 0.02,
+  'vfredsum_repro_ordered'    : 0.02,
+  'vfredsum_repro_ordered_f32': 0.02,
+  'vfredsum_repro_unordered'  : 0.02,
+  'vfredsum_repro_unordered_f32': 0.02,
+  'dwconv'        : 0.02,
+  'dwconv_nhwc'   : 0.02,
+  'maxpool'       : 0.02,
+  'maxpool_nhwc'  : 0.02,
+  'avgpool'       : 0.02,
+  'avgpool_nhwc'  : 0.02,
+  'globalpool'    : 0.02,
+  'globalpool_nhwc': 0.02,
+  'act_relu'      : 0.02,
+  'act_relu_f16'  : 0.02,
+  'act_gelu'      : 0.02,
+  'act_gelu_f16'  : 0.02,
+  'act_silu'      : 0.02,
+  'act_silu_f16'  : 0.02,
+  'act_gemm_gelu' : 0.02,
+  'act_gemm_gelu_unfused': 0.02,
+  'quant_i8'      : 0.02,
+  'quant_u8'      : 0.02,
+  'quant_i8_pc'   : 0.02,
+  'dequant_i8'    : 0.02,
+  'dequant_u8'    : 0.02,
+  'dequant_i8_pc' : 0.02,
+  'requant_i8'    : 0.02,
+  'transpose_e8'  : 0.02,
+  'transpose_e16' : 0.02,
+  'transpose_e32' : 0.02,
+  'transpose_e64' : 0.02,
+  'nchw2nhwc'     : 0.02,
+  'nhwc2nchw'     : 0.02,
+  'interleave'    : 0.02,
+  'deinterleave'  : 0.02,
+  'cholesky'      : 0.02,
+  'cholesky_scalar': 0.02,
+  'lu'            : 0.02,
+  'lu_scalar'     : 0.02,
+  'knn'           : 0.02,
+  'knn_cosine'    : 0.02,
+  'knn_topk'      : 0.02,
+  'stream_copy_e8': 0.02,
+  'stream_copy_e16': 0.02,
+  'stream_copy_e32': 0.02,
+  'stream_copy_e64': 0.02,
+  'stream_scale_e8': 0.02,
+  'stream_scale_e16': 0.02,
+  'stream_scale_e32': 0.02,
+  'stream_scale_e64': 0.02,
+  'stream_add_e8' : 0.02,
+  'stream_add_e16': 0.02,
+  'stream_add_e32': 0.02,
+  'stream_add_e64': 0.02,
+  'stream_triad_e8': 0.02,
+  'stream_triad_e16': 0.02,
+  'stream_triad_e32': 0.02,
+  'stream_triad_e64': 0.02,
+  'stream_strided_e8': 0.02,
+  'stream_strided_e16': 0.02,
+  'stream_strided_e32': 0.02,
+  'stream_strided_e64': 0.02,
+  'stream_gather_e32': 0.02,
+  'stream_gather_e64': 0.02,
+  'stream_gather_clust_e32': 0.02,
+  'stream_gather_clust_e64': 0.02,
+  'xxh32'       : 0.02,
+  'xxh32_base'  : 0.02,
+  'crc32'       : 0.02,
+  'crc32_base'  : 0.02,
+  'imgproc'     : 0.02,
+  'imgproc_unfused': 0.02,
+  'imgproc_yuv' : 0.02,
+  'imgproc_rgb' : 0.02,
+  'imgproc_blur': 0.02,
+  'imgproc_resize': 0.02,
+  'median3_u8': 0.02,
+  'median3_u16': 0.02,
+  'median3_f32': 0.02,
+  'median5_u8': 0.02,
+  'median5_u16': 0.02,
+  'median5_f32': 0.02,
+  'median3_u8_scalar': 0.02,
+  'median5_u8_scalar': 0.02,
+  'black_scholes_f64': 0.02,
+  'black_scholes_f32': 0.02,
+  'mc_call_f32': 0.02,
+  'embedding': 0.02,
+  'embedding_f16': 0.02,
+  'embedding_rows': 0.02,
+  'embedding_bags': 0.02,
+  'lstm_cell': 0.02,
+  'lstm_cell_unfused': 0.02,
+  'gru_cell': 0.02,
+  'spmatmul_f32': 0.02,
+  'spmatmul_i8': 0.02,
+  'spmatmul_dense': 0.02,
+  'spmatmul_dense_i8': 0.02,
+  'fftconv2d': 0.02,
+  'fftconv2d_direct': 0.02,
+  'fftconv2d_fft': 0.02,
+  'fftconv1d_direct': 0.02,
+  'fftconv1d_fft': 0.02,
+  'aes128_ctr': 0.02,
+  'aes128_gcm': 0.02,
+  'sha256': 0.02,
+  'bfs': 0.02,
+  'bfs_top_down': 0.02,
+  'bfs_bottom_up': 0.02,
+  'kmeans': 0.02,
+  'kmeans_unfused': 0.02,
+  'kmeans_iter': 0.02,
+  'bytescan_utf8': 0.02,
+  'bytescan_memchr': 0.02,
+  'bytescan_find_any': 0.02,
+  'bytescan_split': 0.02,
+  'bytescan_strlen': 0.02,
+}
+
+# Fields that identify a measure
+KEY = ['kernel', 'args', 'sew', 'config', 'vlen', 'ideal', 'mem', 'nr_vinsn', 'queues', 'pipe']
+
+# Timing of the main memory of config/*.mk, as rd_latency:wr_latency:bytes_per_cycle:banks.
+# It is not recorded, to keep matching the measures that precede the memory model.
+DEFAULT_MEM = '1:1:0:8'
+# Instructions in flight (NrVInsn in ara_pkg.sv). It is not recorded either.
+DEFAULT_NR_VINSN = 8
+# Depths of the instruction queues of config/*.mk, as valu:mfpu:vldu:vstu:sldu:masku. Not recorded either.
+DEFAULT_QUEUES = '4:4:4:4:2:1'
+# Pipeline stages of hardware/Makefile, as fpu_pipe_regs:mul_pipe_regs:slide_mask_cut:pe_req_cut.
+# Not recorded either.
+DEFAULT_PIPE = '0:0:0:0'
+
+def window_ffs(nr_vinsn, nr_lanes):
+  # Estimate of the flip-flops that track the instructions in flight. It counts the
+  # state that scales with NrVInsn, not the instruction queues of the units.
+  vid = math.ceil(math.log2(nr_vinsn))
+  nr_pes = nr_lanes + 4
+  # ara_sequencer: running instructions of each PE, hazard table, and the last reader
+  # and writer of each vector register
+  sequencer = (nr_pes + 1) * nr_vinsn + nr_vinsn * nr_vinsn + 2 * 32 * (vid + 1)
+  # lane_sequencer and operand_requester: running and done instructions, and the
+  # hazards of each operand queue (NrOperandQueues = 9)
+  lane = 3 * nr_vinsn + 9 * 2 * nr_vinsn
+  # Running instructions of the VLDU, VSTU, address generator, MASKU and SLDU
+  units = 5 * nr_vinsn
+  return sequencer + nr_lanes * lane + units
+
+def git_describe():
+  root = os.path.join(os.path.dirname(os.path.abspath(__file__)), '..')
+  try:
+    sha = subprocess.check_output(['git', 'rev-parse', '--short', 'HEAD'], cwd=root,
+                                  stderr=subprocess.DEVNULL).decode().strip()
+    dirty = subprocess.call(['git', 'diff', '--quiet', 'HEAD'], cwd=root,
+                            stderr=subprocess.DEVNULL) != 0
+  except (OSError, subprocess.CalledProcessError):
+    return None, False
+  return sha, dirty
+
+def parse_log(path):
+  # Return the values printed by the simulation with [token]: value
+  values = {}
+  with open(path, errors='replace') as f:
+    for line in f:
+      m = re.search(r'\[(hw-cycles|sw-cycles|sw-cycles-stats|cycles-per-elem|perf-cnt)\]:(.*)', line)
+      if m:
+        values[m.group(1)] = m.group(2).split()
+  return values
+
+def record(args):
+  values = parse_log(args.log)
+  if 'hw-cycles' not in values:
+    sys.exit('Error: no [hw-cycles] in ' + args.log)
+  hw_cycles = int(values['hw-cycles'][0])
+  sw_cycles = int(values['sw-cycles'][0]) if 'sw-cycles' in values and not args.ideal else None
+
+  # If we have a SW-cycle count, check the HW one for improved reliability
+  if sw_cycles is not None and args.kernel in check_cycles.threshold:
+    if (abs(hw_cycles - sw_cycles) > check_cycles.threshold[args.kernel] and
+        not check_cycles.skip_check[args.kernel]):
+      sys.exit('Error: the difference in hw_cycles ({}) and sw_cycles ({}) for kernel {} is too high.'.format(
+        hw_cycles, sw_cycles, args.kernel))
+
+  entry = {
+    'kernel'    : args.kernel,
+    'args'      : ' '.join(args.args.split()),
+    'sew'       : args.sew,
+    'config'    : args.config,
+    'nr_lanes'  : args.nr_lanes,
+    'vlen'      : args.vlen,
+    'ideal'     : args.ideal,
+    'hw_cycles' : hw_cycles,
+    'sw_cycles' : sw_cycles,
+  }
+  if args.mem and args.mem != DEFAULT_MEM:
+    entry['mem'] = args.mem
+  if args.nr_vinsn and args.nr_vinsn != DEFAULT_NR_VINSN:
+    entry['nr_vinsn'] = args.nr_vinsn
+  if args.queues and args.queues != DEFAULT_QUEUES:
+    entry['queues'] = args.queues
+  if args.pipe and args.pipe != DEFAULT_PIPE:
+    entry['pipe'] = args.pipe
+  if args.kernel in performance.perfExtr:
+    size, perf = performance.perfExtr[args.kernel](entry['args'].split(), hw_cycles)
+    entry['size'] = size
+    entry['flop_per_cycle'] = float(perf)
+    # Legacy "size performance" file, plotted by benchmark.gnuplot
+    if args.benchmark:
+      with open(args.benchmark, 'a') as f:
+        f.write('{} {}\n'.format(size, perf))
+  if 'sw-cycles-stats' in values and not args.ideal:
+    stats = [int(v) for v in values['sw-cycles-stats']]
+    entry['sw_cycles_min'], entry['sw_cycles_median'], entry['sw_cycles_max'], entry['iterations'] = stats
+  if len(values.get('cycles-per-elem', [])) == 2 and not args.ideal:
+    entry['cycles_per_elem'], entry['overhead_cycles'] = [float(v) for v in values['cycles-per-elem']]
+  if 'perf-cnt' in values:
+    entry['perf_cnt'] = dict(zip(PERF_EVENTS, [int(c) for c in values['perf-cnt']]))
+    e = energy_model.energy(entry['perf_cnt'], hw_cycles, args.nr_lanes,
+                            energy_model.load_model(args.energy_model))
+    entry['energy_pj'] = round(e['total'], 1)
+    if entry.get('flop_per_cycle'):
+      entry['pj_per_op'] = round(e['total'] / (entry['flop_per_cycle'] * hw_cycles), 3)
+  entry['git'], entry['dirty'] = git_describe()
+  entry['timestamp'] = time.strftime('%Y-%m-%dT%H:%M:%S')
+
+  with open(args.output, 'a') as f:
+    f.write(json.dumps(entry) + '\n')
+
+def load(path):
+  with open(path) as f:
+    return [json.loads(line) for line in f if line.strip()]
+
+def latest(db, git):
+  # Last measure of each key, optionally of a given commit
+  measures = {}
+  for e in db:
+    if git and not (e.get('git') or '').startswith(git):
+      continue
+    measures[tuple(e.get(k) for k in KEY)] = e
+  return measures
+
+def compare(args):
+  base_db = load(args.base)
+  new_db = load(args.new) if args.new else base_db
+  if not args.new and not (args.base_git and args.new_git):
+    sys.exit('Error: comparing a database with itself needs --base-git and --new-git')
+  base = latest(base_db, args.base_git)
+  new = latest(new_db, args.new_git)
+
+  regressions = 0
+  compared = 0
+  for key, e in sorted(new.items(), key=lambda kv: str(kv[0])):
+    if key not in base:
+      continue
+    compared += 1
+    b = base[key]
+    # The median of the repeated runs is less noisy than the single HW-counted one
+    metric = 'hw_cycles'
+    if e.get('iterations', 1) > 1 and b.get('iterations', 1) > 1:
+      metric = 'sw_cycles_median'
+    slowdown = e[metric] / b[metric] - 1
+    limit = args.threshold if args.threshold is not None else threshold.get(e['kernel'], 0.02)
+    if slowdown > limit:
+      regressions += 1
+      status = 'REGRESSION'
+    elif slowdown < -limit:
+      status = 'improved'
+    else:
+      status = 'ok'
+    if status != 'ok' or args.verbose:
+      print('{:10} {:12} {:>20} {:10} {}{}{}{:>10} -> {:>10} cycles ({:+.1%})'.format(
+        status, e['kernel'], e['args'], e['config'], 'ideal ' if e['ideal'] else '',
+        'mem ' + e['mem'] + ' ' if 'mem' in e else '', 'queues ' + e['queues'] + ' ' if 'queues' in e else '',
+        b[metric], e[metric], slowdown))
+
+  print('Compared {} measures: {} regressions.'.format(compared, regressions))
+  if not compared:
+    sys.exit('Error: no common measure between the two databases')
+  if regressions:
+    sys.exit(1)
+
+def window(args):
+  measures = latest(load(args.db), args.git)
+  nr_vinsn = KEY.index('nr_vinsn')
+
+  compared = 0
+  for key, e in sorted(measures.items(), key=lambda kv: str(kv[0])):
+    if e.get('nr_vinsn') is None:
+      continue
+    # Same measure with the default window
+    default = measures.get(key[:nr_vinsn] + (None,) + key[nr_vinsn + 1:])
+    if default is None:
+      continue
+    compared += 1
+    base_ffs = window_ffs(DEFAULT_NR_VINSN, e['nr_lanes'])
+    ffs = window_ffs(e['nr_vinsn'], e['nr_lanes'])
+    print('{:12} {:>20} {:10} {}{}nr_vinsn {:2}: {:>10} -> {:>10} cycles ({:+.1%}), ~{} -> ~{} FFs ({:+.1%})'.format(
+      e['kernel'], e['args'], e['config'], 'ideal ' if e['ideal'] else '',
+      'mem ' + e['mem'] + ' ' if 'mem' in e else '', e['nr_vinsn'], default['hw_cycles'],
+      e['hw_cycles'], e['hw_cycles'] / default['hw_cycles'] - 1, base_ffs, ffs, ffs / base_ffs - 1))
+
+  if not compared:
+    sys.exit('Error: no measure with a non-default nr_vinsn and its default counterpart')
+
+def fpga_reports(path, freq_mhz):
+  # WNS, fmax, and the LUTs and FFs of Ara from the reports of hardware/fpga/scripts/run.tcl
+  timing = os.path.join(path, 'timing_impl.rpt')
+  util = os.path.join(path, 'utilization_impl.rpt')
+  if not (os.path.exists(timing) and os.path.exists(util)):
+    return None
+  with open(timing, errors='replace') as f:
+    lines = f.read().splitlines()
+  wns = None
+  for i, line in enumerate(lines):
+    if line.split()[:1] == ['WNS(ns)'] and i + 2 < len(lines):
+      wns = float(lines[i + 2].split()[0])
+      break
+  area = {}
+  with open(util, errors='replace') as f:
+    header = None
+    for line in f:
+      cols = [c.strip() for c in line.strip().strip('|').split('|')]
+      if 'Instance' in cols and 'Total LUTs' in cols:
+        header = cols
+      elif header and len(cols) == len(header) and cols[0].endswith('i_ara'):
+        area = {'luts': int(cols[header.index('Total LUTs')]), 'ffs': int(cols[header.index('FFs')])}
+        break
+  if wns is None or not area:
+    return None
+  period = 1000.0 / freq_mhz
+  return dict(area, wns=wns, fmax=1000.0 / (period - wns))
+
+def pipeline(args):
+  measures = latest(load(args.db), args.git)
+  pipe = KEY.index('pipe')
+
+  # {(config, pipe): [cycles wrt the default pipeline]}
+  ratios = {}
+  for key, e in sorted(measures.items(), key=lambda kv: str(kv[0])):
+    if e.get('pipe') is None:
+      continue
+    default = measures.get(key[:pipe] + (None,) + key[pipe + 1:])
+    if default is None:
+      continue
+    ratios.setdefault((e['config'], e['pipe']), []).append(e['hw_cycles'] / default['hw_cycles'])
+    if args.verbose:
+      print('{:12} {:>20} {:10} {}pipe {}: {:>10} -> {:>10} cycles ({:+.1%})'.format(
+        e['kernel'], e['args'], e['config'], 'ideal ' if e['ideal'] else '', e['pipe'],
+        default['hw_cycles'], e['hw_cycles'], e['hw_cycles'] / default['hw_cycles'] - 1))
+
+  if not ratios:
+    sys.exit('Error: no measure with a non-default pipe and its default counterpart')
+
+  # The FPGA reports of each setting are in DIR/<config>/ and DIR/<config>-<pipe with dashes>/
+  def reports(config, p):
+    if not args.fpga:
+      return None
+    name = config if p == DEFAULT_PIPE else '{}-{}'.format(config, p.replace(':', '-'))
+    return fpga_reports(os.path.join(args.fpga, name), args.fpga_freq)
+
+  row = '{:10} {:9} {:>8} {:>8} {:>8} {:>9} {:>9} {:>8} {:>8}'
+  print(row.format('config', 'pipe', 'measures', 'cycles', 'worst', 'fmax MHz', 'LUTs', 'FFs', 'runtime'))
+  for config in sorted({c for c, _ in ratios}):
+    base = reports(config, DEFAULT_PIPE)
+    rows = [(DEFAULT_PIPE, None, base)]
+    rows += [(p, ratios[(c, p)], reports(c, p)) for c, p in sorted(ratios) if c == config]
+    for p, r, rep in rows:
+      geomean = math.exp(sum(math.log(x) for x in r) / len(r)) if r else 1.0
+      # Runtime at the fmax of each setting, wrt the default one
+      runtime = geomean * base['fmax'] / rep['fmax'] - 1 if base and rep else None
+      print(row.format(
+        config, p, len(r) if r else '-', '{:+.1%}'.format(geomean - 1) if r else '-',
+        '{:+.1%}'.format(max(r) - 1) if r else '-', '{:.1f}'.format(rep['fmax']) if rep else '-',
+        rep['luts'] if rep else '-', rep['ffs'] if rep else '-',
+        '{:+.1%}'.format(runtime) if runtime is not None and r else '-'))
+
+def autovec(args):
+  measures = latest(load(args.db), args.git)
+  kernel = KEY.index('kernel')
+
+  compared = 0
+  for key, e in sorted(measures.items(), key=lambda kv: str(kv[0])):
+    if not e['kernel'].endswith('_autovec'):
+      continue
+    # Same measure of the hand-written kernel
+    hand = measures.get(key[:kernel] + (e['kernel'][:-len('_autovec')],) + key[kernel + 1:])
+    if hand is None:
+      continue
+    compared += 1
+    print('{:12} {:>20} {:10} {}hand-written {:>10}, auto-vectorized {:>10} cycles ({:.2f}x)'.format(
+      hand['kernel'], e['args'], e['config'], 'mem ' + e['mem'] + ' ' if 'mem' in e else '',
+      hand['hw_cycles'], e['hw_cycles'], e['hw_cycles'] / hand['hw_cycles']))
+
+  if not compared:
+    sys.exit('Error: no auto-vectorized measure with its hand-written counterpart')
+
+def energy(args):
+  measures = latest(load(args.db), args.git)
+  model = energy_model.load_model(args.model)
+
+  row = '{:12} {:>20} {:10} {:>5} {:>10} {:>12} {:>8} {:>8}'
+  print(row.format('kernel', 'args', 'config', 'lanes', 'cycles', 'energy nJ', 'pJ/op', 'gating'))
+  compared = 0
+  # The lane counts of the same kernel next to each other
+  for key, e in sorted(measures.items(), key=lambda kv: (kv[1]['kernel'], kv[1]['args'], kv[1]['nr_lanes'])):
+    if 'perf_cnt' not in e or e['ideal']:
+      continue
+    compared += 1
+    gated = energy_model.energy(e['perf_cnt'], e['hw_cycles'], e['nr_lanes'], model)['total']
+    ungated = energy_model.energy(e['perf_cnt'], e['hw_cycles'], e['nr_lanes'], model, False)['total']
+    pj_per_op = gated / (e['flop_per_cycle'] * e['hw_cycles']) if e.get('flop_per_cycle') else None
+    print(row.format(e['kernel'], e['args'], e['config'], e['nr_lanes'], e['hw_cycles'],
+                     '{:.1f}'.format(gated / 1000), '{:.2f}'.format(pj_per_op) if pj_per_op else '-',
+                     '{:+.1%}'.format(gated / ungated - 1) if ungated else '-'))
+
+  if not compared:
+    sys.exit('Error: no measure with performance counters')
+
+def main():
+  parser = argparse.ArgumentParser(description='Database of the Ara benchmark results.')
+  sub = parser.add_subparsers(dest='cmd')
+  sub.required = True
+
+  rec = sub.add_parser('record', help='append the result of a simulation log')
+  rec.add_argument('log', help='log of the simulation')
+  rec.add_argument('-o', '--output', required=True, help='database (JSON lines)')
+  rec.add_argument('--kernel', required=True)
+  rec.add_argument('--args', required=True, help='arguments of gen_data.py')
+  rec.add_argument('--config', required=True, help='Ara configuration (config/*.mk)')
+  rec.add_argument('--nr-lanes', type=int, required=True)
+  rec.add_argument('--vlen', type=int, required=True)
+  rec.add_argument('--sew', type=int, default=None, help='element width, if the kernel sweeps it')
+  rec.add_argument('--ideal', action='store_true', help='ideal dispatcher run')
+  rec.add_argument('--mem', default=None, help='timing of the main memory (rd_latency:wr_latency:bytes_per_cycle:banks)')
+  rec.add_argument('--nr-vinsn', type=int, default=None, help='vector instructions in flight (nr_vinsn)')
+  rec.add_argument('--queues', default=None, help='depths of the instruction queues (valu:mfpu:vldu:vstu:sldu:masku)')
+  rec.add_argument('--pipe', default=None,
+                   help='pipeline stages (fpu_pipe_regs:mul_pipe_regs:slide_mask_cut:pe_req_cut)')
+  rec.add_argument('--benchmark', default=None, help='also append "size performance" to this file')
+  rec.add_argument('--energy-model', default=None,
+                   help='coefficients of energy_model.py calibrate (default: its DEFAULT_MODEL)')
+  rec.set_defaults(func=record)
+
+  cmp = sub.add_parser('compare', help='flag the regressions of NEW wrt BASE')
+  cmp.add_argument('base', help='database of the reference')
+  cmp.add_argument('new', nargs='?', default=None, help='database to check (default: BASE)')
+  cmp.add_argument('--base-git', default=None, help='commit of the reference')
+  cmp.add_argument('--new-git', default=None, help='commit to check')
+  cmp.add_argument('--threshold', type=float, default=None, help='override the per-kernel thresholds')
+  cmp.add_argument('-v', '--verbose', action='store_true', help='print all the measures')
+  cmp.set_defaults(func=compare)
+
+  win = sub.add_parser('window', help='speedup and cost of the instruction windows')
+  win.add_argument('db', help='database')
+  win.add_argument('--git', default=None, help='commit of the measures')
+  win.set_defaults(func=window)
+
+  pipe = sub.add_parser('pipeline', help='cycles, timing and area of the pipeline settings')
+  pipe.add_argument('db', help='database')
+  pipe.add_argument('--git', default=None, help='commit of the measures')
+  pipe.add_argument('--fpga', default=None, help='directory of the FPGA reports (hardware/fpga/reports)')
+  pipe.add_argument('--fpga-freq', type=float, default=50, help='target frequency of the FPGA runs (MHz)')
+  pipe.add_argument('-v', '--verbose', action='store_true', help='print all the measures')
+  pipe.set_defaults(func=pipeline)
+
+  avec = sub.add_parser('autovec', help='cycles of the auto-vectorized kernels wrt the hand-written ones')
+  avec.add_argument('db', help='database')
+  avec.add_argument('--git', default=None, help='commit of the measures')
+  avec.set_defaults(func=autovec)
+
+  en = sub.add_parser('energy', help='estimated energy of the measures, and the saving of the clock gating')
+  en.add_argument('db', help='database')
+  en.add_argument('--git', default=None, help='commit of the measures')
+  en.add_argument('--model', default=None, help='coefficients of energy_model.py calibrate')
+  en.set_defaults(func=energy)
+
+  args = parser.parse_args()
+  args.func(args)
+
+if __name__ == '__main__':
+  main()
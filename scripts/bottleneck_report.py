@@ -0,0 +1,112 @@
+#!/usr/bin/env python3
+# Copyright 2022 ETH Zurich and University of Bologna.
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+# Summarize the runs of benchmark.sh into one bottleneck table per lane
+# configuration. For every kernel and problem size:
+#   - gap:  real/ideal runtime, i.e., how much the scalar core slows Ara down
+#   - perf: achieved FLOP/cycle (performance.py), and its fraction of the peak
+#           of roofline.py
+#   - unit: most utilized unit during the real run, from the performance
+#           counters that the testbench prints with [perf-cnt]
+#
+# The input is the database of benchmark.sh (see benchmark_db.py). The last
+# measure of each kernel and size is reported.
+#
+# Usage: bottleneck_report.py [-l LANES ...] [-o report.md] DB [kernel ...]
+
+import argparse
+import os
+import sys
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+import benchmark_db
+import performance
+import roofline
+
+# Events that saturate when they happen in every cycle
+UNITS = {
+  'VALU'  : 'valu_busy',
+  'VMFPU' : 'vmfpu_busy',
+  'VLDU'  : 'vldu_busy',
+  'VSTU'  : 'vstu_busy',
+  'SLDU'  : 'sldu_busy',
+  'MASKU' : 'masku_busy',
+  'AXI R' : 'axi_r_beat',
+  'AXI W' : 'axi_w_beat',
+}
+
+def peak_flop_per_cycle(entry):
+  return roofline.machine(entry['nr_lanes']).peak(roofline.entry_sew(entry))
+
+def saturated_unit(cycles, cnts):
+  if not cnts or not cycles:
+    return '-'
+  unit = max(UNITS, key=lambda u: cnts.get(UNITS[u], 0))
+  return '{} ({:.0%})'.format(unit, cnts.get(UNITS[unit], 0) / cycles)
+
+def report(measures, kernels, nr_lanes):
+  rows = []
+  real = [e for e in measures.values() if e['nr_lanes'] == nr_lanes and not e['ideal'] and
+          e['kernel'] in kernels and 'flop_per_cycle' in e]
+  real.sort(key=lambda e: (kernels.index(e['kernel']), e['size'], e['args']))
+  for e in real:
+    cycles = e['hw_cycles']
+    # The ideal dispatcher runs only with QuestaSim
+    key = tuple(e.get(k) if k != 'ideal' else True for k in benchmark_db.KEY)
+    ideal_cycles = measures[key]['hw_cycles'] if key in measures else 0
+    gap = '{:.2f}'.format(cycles / ideal_cycles) if ideal_cycles else '-'
+    rows.append([e['kernel'], str(e['size']), str(cycles), str(ideal_cycles or '-'), gap,
+                 '{:.3f}'.format(e['flop_per_cycle']), '{:.1%}'.format(e['flop_per_cycle'] / peak_flop_per_cycle(e)),
+                 saturated_unit(cycles, e.get('perf_cnt'))])
+  return rows
+
+def table(header, rows):
+  lines = ['| ' + ' | '.join(header) + ' |', '|' + '|'.join('---' for _ in header) + '|']
+  lines += ['| ' + ' | '.join(r) + ' |' for r in rows]
+  return '\n'.join(lines)
+
+def main():
+  parser = argparse.ArgumentParser(description='Ideal-vs-real bottleneck report of benchmark.sh.')
+  parser.add_argument('db', help='database of the results (JSON lines)')
+  parser.add_argument('kernels', nargs='*', help='kernels to report (default: all the measured ones)')
+  parser.add_argument('-l', '--lanes', type=int, nargs='+', default=None,
+                      help='lane configurations (default: all the measured ones)')
+  parser.add_argument('-o', '--output', default=None, help='output Markdown file (default: stdout)')
+  args = parser.parse_args()
+
+  measures = benchmark_db.latest(benchmark_db.load(args.db), None)
+  kernels = args.kernels or sorted({e['kernel'] for e in measures.values() if e['kernel'] in performance.perfExtr})
+  for kernel in kernels:
+    if kernel not in performance.perfExtr:
+      sys.exit('Error: the kernel "' + kernel + '" is not valid')
+  lanes = args.lanes or sorted({e['nr_lanes'] for e in measures.values()})
+
+  header = ['kernel', 'size', 'cycles', 'ideal cycles', 'gap', 'FLOP/cycle', 'of peak', 'saturated unit']
+  out = []
+  for nr_lanes in lanes:
+    out.append('## {} lanes\n'.format(nr_lanes))
+    out.append(table(header, report(measures, kernels, nr_lanes)) + '\n')
+  text = '\n'.join(out)
+
+  if args.output:
+    with open(args.output, 'w') as f:
+      f.write(text)
+  else:
+    print(text)
+
+if __name__ == '__main__':
+  main()
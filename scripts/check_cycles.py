@@ -25,34 +25,374 @@ import numpy as np
 
 threshold = {
   'imatmul'    : 300,
+  'imatmul_i8' : 300,
+  'imatmul_i16': 300,
   'fmatmul'    : 300,
+  'fmatmul_f32': 300,
+  'fmatmul_f16': 300,
   'iconv2d'    : 300,
+  'iconv2d_i8' : 300,
   'fconv2d'    : 300,
+  'fconv2d_kxk': 300,
   'fconv3d'    : 300,
+  'conv2d_layer' : 300,
+  'conv2d_layer_direct'   : 300,
+  'conv2d_layer_im2col'   : 300,
+  'conv2d_layer_winograd' : 300,
   'jacobi2d'   : 300,
+  'jacobi2d_tb': 300,
   'dropout'    : 300,
+  'dropout_rng': 300,
   'fft'        : 300,
+  'fft_r4'     : 300,
+  'fft_r4_cplx': 300,
+  'fft_batch'  : 300,
+  'fft_2d'     : 300,
+  'fft_q15'    : 300,
+  'fft_rfft'   : 300,
   'dwt'        : 300,
   'exp'        : 300,
   'softmax'    : 300,
+  'softmax_online': 300,
+  'softmax_rows'  : 300,
+  'softmax_f16'   : 300,
   'pathfinder' : 300,
   'roi_align'  : 300,
+  'fgemv'      : 300,
+  'fmatmul_batched' : 300,
+  'spmv'       : 300,
+  'spmv_sell'  : 300,
+  'fmatmul_autovec'    : 300,
+  'jacobi2d_autovec'   : 300,
+  'pathfinder_autovec' : 300,
+  'dropout_autovec'    : 300,
+  'layernorm'  : 300,
+  'layernorm_f16' : 300,
+  'rmsnorm'    : 300,
+  'rmsnorm_f16'   : 300,
+  'attention'  : 300,
+  'attention_unfused' : 300,
+  'sort'       : 300,
+  'sort_merge' : 300,
+  'sort_scalar': 300,
+  'hist_u8'    : 300,
+  'hist_u16'   : 300,
+  'scan_i32'   : 300,
+  'scan_f32'   : 300,
+  'blas1_daxpy': 300,
+  'blas1_saxpy': 300,
+  'blas1_dscal': 300,
+  'blas1_dcopy': 300,
+  'blas1_dnrm2': 300,
+  'blas1_dasum': 300,
+  'blas1_idamax': 300,
+  'vfredsum_repro'            : 300,
+  'vfredsum_repro_f32'        : 300,
+  'vfredsum_repro_kahan'      : 300,
+  'vfredsum_repro_kahan_f32'  : 300,
+  'vfredsum_repro_ordered'    : 300,
+  'vfredsum_repro_ordered_f32': 300,
+  'vfredsum_repro_unordered'  : 300,
+  'vfredsum_repro_unordered_f32': 300,
+  'dwconv'        : 300,
+  'dwconv_nhwc'   : 300,
+  'maxpool'       : 300,
+  'maxpool_nhwc'  : 300,
+  'avgpool'       : 300,
+  'avgpool_nhwc'  : 300,
+  'globalpool'    : 300,
+  'globalpool_nhwc': 300,
+  'act_relu'      : 300,
+  'act_relu_f16'  : 300,
+  'act_gelu'      : 300,
+  'act_gelu_f16'  : 300,
+  'act_silu'      : 300,
+  'act_silu_f16'  : 300,
+  'act_gemm_gelu' : 300,
+  'act_gemm_gelu_unfused': 300,
+  'quant_i8'      : 300,
+  'quant_u8'      : 300,
+  'quant_i8_pc'   : 300,
+  'dequant_i8'    : 300,
+  'dequant_u8'    : 300,
+  'dequant_i8_pc' : 300,
+  'requant_i8'    : 300,
+  'transpose_e8'  : 300,
+  'transpose_e16' : 300,
+  'transpose_e32' : 300,
+  'transpose_e64' : 300,
+  'nchw2nhwc'     : 300,
+  'nhwc2nchw'     : 300,
+  'interleave'    : 300,
+  'deinterleave'  : 300,
+  'cholesky'      : 300,
+  'cholesky_scalar': 300,
+  'lu'            : 300,
+  'lu_scalar'     : 300,
+  'knn'           : 300,
+  'knn_cosine'    : 300,
+  'knn_topk'      : 300,
+  'stream_copy_e8': 300,
+  'stream_copy_e16': 300,
+  'stream_copy_e32': 300,
+  'stream_copy_e64': 300,
+  'stream_scale_e8': 300,
+  'stream_scale_e16': 300,
+  'stream_scale_e32': 300,
+  'stream_scale_e64': 300,
+  'stream_add_e8' : 300,
+  'stream_add_e16': 300,
+  'stream_add_e32': 300,
+  'stream_add_e64': 300,
+  'stream_triad_e8': 300,
+  'stream_triad_e16': 300,
+  'stream_triad_e32': 300,
+  'stream_triad_e64': 300,
+  'stream_strided_e8': 300,
+  'stream_strided_e16': 300,
+  'stream_strided_e32': 300,
+  'stream_strided_e64': 300,
+  'stream_gather_e32': 300,
+  'stream_gather_e64': 300,
+  'stream_gather_clust_e32': 300,
+  'stream_gather_clust_e64': 300,
+  'xxh32'      : 300,
+  'xxh32_base' : 300,
+  'crc32'      : 300,
+  'crc32_base' : 300,
+  'imgproc'    : 300,
+  'imgproc_unfused': 300,
+  'imgproc_yuv': 300,
+  'imgproc_rgb': 300,
+  'imgproc_blur': 300,
+  'imgproc_resize': 300,
+  'median3_u8': 300,
+  'median3_u16': 300,
+  'median3_f32': 300,
+  'median5_u8': 300,
+  'median5_u16': 300,
+  'median5_f32': 300,
+  'median3_u8_scalar': 300,
+  'median5_u8_scalar': 300,
+  'black_scholes_f64': 300,
+  'black_scholes_f32': 300,
+  'mc_call_f32': 300,
+  'embedding': 300,
+  'embedding_f16': 300,
+  'embedding_rows': 300,
+  'embedding_bags': 300,
+  'lstm_cell': 300,
+  'lstm_cell_unfused': 300,
+  'gru_cell': 300,
+  'spmatmul_f32': 300,
+  'spmatmul_i8': 300,
+  'spmatmul_dense': 300,
+  'spmatmul_dense_i8': 300,
+  'fftconv2d': 300,
+  'fftconv2d_direct': 300,
+  'fftconv2d_fft': 300,
+  'fftconv1d_direct': 300,
+  'fftconv1d_fft': 300,
+  'aes128_ctr': 300,
+  'aes128_gcm': 300,
+  'sha256': 300,
+  'bfs': 300,
+  'bfs_top_down': 300,
+  'bfs_bottom_up': 300,
+  'kmeans': 300,
+  'kmeans_unfused': 300,
+  'kmeans_iter': 300,
+  'bytescan_utf8': 300,
+  'bytescan_memchr': 300,
+  'bytescan_find_any': 300,
+  'bytescan_split': 300,
+  'bytescan_strlen': 300,
 }
 
 skip_check = {
   'imatmul'    : 0,
+  'imatmul_i8' : 0,
+  'imatmul_i16': 0,
   'fmatmul'    : 0,
+  'fmatmul_f32': 0,
+  'fmatmul_f16': 0,
   'iconv2d'    : 0,
+  'iconv2d_i8' : 0,
   'fconv2d'    : 0,
+  'fconv2d_kxk': 0,
   'fconv3d'    : 0,
+  'conv2d_layer' : 0,
+  'conv2d_layer_direct'   : 0,
+  'conv2d_layer_im2col'   : 0,
+  'conv2d_layer_winograd' : 0,
   'jacobi2d'   : 0,
+  'jacobi2d_tb': 0,
   'dropout'    : 0,
+  'dropout_rng': 0,
   'fft'        : 0,
+  'fft_r4'     : 0,
+  'fft_r4_cplx': 0,
+  'fft_batch'  : 0,
+  'fft_2d'     : 0,
+  'fft_q15'    : 0,
+  'fft_rfft'   : 0,
   'dwt'        : 0,
   'exp'        : 0,
   'softmax'    : 0,
+  'softmax_online': 0,
+  'softmax_rows'  : 0,
+  'softmax_f16'   : 0,
   'pathfinder' : 0,
-  'roi_align'  : 1, # This program has a larger scalar component
+  'roi_align'  : 0,
+  'fgemv'      : 0,
+  'fmatmul_batched' : 0,
+  'spmv'       : 0,
+  'spmv_sell'  : 0,
+  'fmatmul_autovec'    : 0,
+  'jacobi2d_autovec'   : 0,
+  'pathfinder_autovec' : 0,
+  'dropout_autovec'    : 0,
+  'layernorm'  : 0,
+  'layernorm_f16' : 0,
+  'rmsnorm'    : 0,
+  'rmsnorm_f16'   : 0,
+  'attention'  : 0,
+  'attention_unfused' : 0,
+  'sort'       : 0,
+  'sort_merge' : 0,
+  'sort_scalar': 0,
+  'hist_u8'    : 0,
+  'hist_u16'   : 0,
+  'scan_i32'   : 0,
+  'scan_f32'   : 0,
+  'blas1_daxpy': 0,
+  'blas1_saxpy': 0,
+  'blas1_dscal': 0,
+  'blas1_dcopy': 0,
+  'blas1_dnrm2': 0,
+  'blas1_dasum': 0,
+  'blas1_idamax': 0,
+  'vfredsum_repro'            : 0,
+  'vfredsum_repro_f32'        : 0,
+  'vfredsum_repro_kahan'      : 0,
+  'vfredsum_repro_kahan_f32'  : 0,
+  'vfredsum_repro_ordered'    : 0,
+  'vfredsum_repro_ordered_f32': 0,
+  'vfredsum_repro_unordered'  : 0,
+  'vfredsum_repro_unordered_f32': 0,
+  'dwconv'        : 0,
+  'dwconv_nhwc'   : 0,
+  'maxpool'       : 0,
+  'maxpool_nhwc'  : 0,
+  'avgpool'       : 0,
+  'avgpool_nhwc'  : 0,
+  'globalpool'    : 0,
+  'globalpool_nhwc': 0,
+  'act_relu'      : 0,
+  'act_relu_f16'  : 0,
+  'act_gelu'      : 0,
+  'act_gelu_f16'  : 0,
+  'act_silu'      : 0,
+  'act_silu_f16'  : 0,
+  'act_gemm_gelu' : 0,
+  'act_gemm_gelu_unfused': 0,
+  'quant_i8'      : 0,
+  'quant_u8'      : 0,
+  'quant_i8_pc'   : 0,
+  'dequant_i8'    : 0,
+  'dequant_u8'    : 0,
+  'dequant_i8_pc' : 0,
+  'requant_i8'    : 0,
+  'transpose_e8'  : 0,
+  'transpose_e16' : 0,
+  'transpose_e32' : 0,
+  'transpose_e64' : 0,
+  'nchw2nhwc'     : 0,
+  'nhwc2nchw'     : 0,
+  'interleave'    : 0,
+  'deinterleave'  : 0,
+  'cholesky'      : 0,
+  'cholesky_scalar': 0,
+  'lu'            : 0,
+  'lu_scalar'     : 0,
+  'knn'           : 0,
+  'knn_cosine'    : 0,
+  'knn_topk'      : 0,
+  'stream_copy_e8': 0,
+  'stream_copy_e16': 0,
+  'stream_copy_e32': 0,
+  'stream_copy_e64': 0,
+  'stream_scale_e8': 0,
+  'stream_scale_e16': 0,
+  'stream_scale_e32': 0,
+  'stream_scale_e64': 0,
+  'stream_add_e8' : 0,
+  'stream_add_e16': 0,
+  'stream_add_e32': 0,
+  'stream_add_e64': 0,
+  'stream_triad_e8': 0,
+  'stream_triad_e16': 0,
+  'stream_triad_e32': 0,
+  'stream_triad_e64': 0,
+  'stream_strided_e8': 0,
+  'stream_strided_e16': 0,
+  'stream_strided_e32': 0,
+  'stream_strided_e64': 0,
+  'stream_gather_e32': 0,
+  'stream_gather_e64': 0,
+  'stream_gather_clust_e32': 0,
+  'stream_gather_clust_e64': 0,
+  'xxh32'      : 0,
+  'xxh32_base' : 0,
+  'crc32'      : 0,
+  'crc32_base' : 0,
+  'imgproc'    : 0,
+  'imgproc_unfused': 0,
+  'imgproc_yuv': 0,
+  'imgproc_rgb': 0,
+  'imgproc_blur': 0,
+  'imgproc_resize': 0,
+  'median3_u8': 0,
+  'median3_u16': 0,
+  'median3_f32': 0,
+  'median5_u8': 0,
+  'median5_u16': 0,
+  'median5_f32': 0,
+  'median3_u8_scalar': 0,
+  'median5_u8_scalar': 0,
+  'black_scholes_f64': 0,
+  'black_scholes_f32': 0,
+  'mc_call_f32': 0,
+  'embedding': 0,
+  'embedding_f16': 0,
+  'embedding_rows': 0,
+  'embedding_bags': 0,
+  'lstm_cell': 0,
+  'lstm_cell_unfused': 0,
+  'gru_cell': 0,
+  'spmatmul_f32': 0,
+  'spmatmul_i8': 0,
+  'spmatmul_dense': 0,
+  'spmatmul_dense_i8': 0,
+  'fftconv2d': 0,
+  'fftconv2d_direct': 0,
+  'fftconv2d_fft': 0,
+  'fftconv1d_direct': 0,
+  'fftconv1d_fft': 0,
+  'aes128_ctr': 0,
+  'aes128_gcm': 0,
+  'sha256': 0,
+  'bfs': 0,
+  'bfs_top_down': 0,
+  'bfs_bottom_up': 0,
+  'kmeans': 0,
+  'kmeans_unfused': 0,
+  'kmeans_iter': 0,
+  'bytescan_utf8': 0,
+  'bytescan_memchr': 0,
+  'bytescan_find_any': 0,
+  'bytescan_split': 0,
+  'bytescan_strlen': 0,
 }
 
 def main():
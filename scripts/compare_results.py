@@ -0,0 +1,104 @@
+#!/usr/bin/env python
+# Copyright 2022 ETH Zurich and University of Bologna.
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+# Compare two binary result dumps produced by ara_tb.sv (tb/dpi/result_dump.cc)
+# Only the strobed bytes are compared, in the order they were stored.
+# With threshold 0, the comparison is exact. Otherwise, the bytes are
+# interpreted as SEW-bit floating-point words, and the comparison fails if any
+# two corresponding words are more than threshold ULPs apart.
+#
+# Usage: compare_results.py id_results.bin gold_results.bin [threshold] [sew]
+
+import sys
+import numpy as np
+
+MAGIC = b'ARAW'
+VERSION = 1
+
+def load(filename):
+  raw = np.fromfile(filename, dtype=np.uint8)
+  if raw.size < 12 or raw[:4].tobytes() != MAGIC:
+    sys.exit("Error: {} is not a result dump.".format(filename))
+  version, bus_bytes = raw[4:12].view('<u4')
+  if version != VERSION:
+    sys.exit("Error: unsupported version {} in {}.".format(version, filename))
+
+  rec_bytes = 16 + bus_bytes
+  body = raw[12:]
+  if body.size % rec_bytes:
+    sys.exit("Error: {} is truncated.".format(filename))
+  recs = body.reshape(-1, rec_bytes)
+
+  addr = recs[:, 0:8].copy().view('<u8').ravel()
+  strb = recs[:, 8:16].copy().view('<u8').ravel()
+  data = recs[:, 16:]
+
+  # Expand the strobes to a byte mask and keep the valid bytes only
+  mask = ((strb[:, None] >> np.arange(bus_bytes, dtype=np.uint64)) & np.uint64(1)).astype(bool)
+  byte_addr = addr[:, None] + np.arange(bus_bytes, dtype=np.uint64)
+  return data[mask], byte_addr[mask]
+
+def to_ordered(words, sew):
+  # Map the IEEE-754 words to integers that are monotonic with the float order,
+  # so that the difference between two of them is their distance in ULPs
+  signed = words.view('<i{}'.format(sew // 8)).astype(np.int64)
+  int_min = np.int64(-(1 << (sew - 1)))
+  return np.where(signed < 0, int_min - signed, signed)
+
+def main():
+  if len(sys.argv) < 3:
+    sys.exit("Usage: {} id_results.bin gold_results.bin [threshold] [sew]".format(sys.argv[0]))
+
+  id_data, id_addr = load(sys.argv[1])
+  gold_data, gold_addr = load(sys.argv[2])
+  threshold = int(sys.argv[3]) if len(sys.argv) > 3 else 0
+  sew = int(sys.argv[4]) if len(sys.argv) > 4 else 8
+
+  if id_data.size != gold_data.size:
+    print("Error. Test failed: {} bytes stored vs {} expected.".format(id_data.size, gold_data.size))
+    sys.exit(1)
+
+  if threshold == 0:
+    bad = np.flatnonzero(id_data != gold_data)
+    if bad.size:
+      i = bad[0]
+      print("Error. Test failed: {} bytes differ. First at byte {} (0x{:x} vs gold 0x{:x}): 0x{:02x} != 0x{:02x}".format(
+            bad.size, i, id_addr[i], gold_addr[i], id_data[i], gold_data[i]))
+      sys.exit(1)
+  else:
+    if sew not in (16, 32, 64):
+      sys.exit("Error: unsupported SEW {} for a ULP comparison.".format(sew))
+    ew = sew // 8
+    # Ignore a trailing partial word, as the byte-wise check did
+    n = (id_data.size // ew) * ew
+    id_words = to_ordered(id_data[:n].copy(), sew)
+    gold_words = to_ordered(gold_data[:n].copy(), sew)
+    # Unsigned difference, which cannot overflow
+    hi = np.maximum(id_words, gold_words).view(np.uint64)
+    lo = np.minimum(id_words, gold_words).view(np.uint64)
+    ulp = hi - lo
+    bad = np.flatnonzero(ulp > threshold)
+    if bad.size:
+      i = bad[0]
+      print("Error. Test failed: {} words off by more than {} ULPs. First at word {} (0x{:x} vs gold 0x{:x}): {} ULPs".format(
+            bad.size, threshold, i, id_addr[i * ew], gold_addr[i * ew], ulp[i]))
+      sys.exit(1)
+
+  print("Results match ({} bytes).".format(id_data.size))
+
+if __name__ == '__main__':
+  main()
@@ -0,0 +1,101 @@
+#!/usr/bin/env python3
+# Copyright 2022 ETH Zurich and University of Bologna.
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+# Generate the decision table of conv2d_layer_auto (apps/conv2d_layer) from the
+# results of the conv2d_layer_sweep of benchmark.sh. For each number of lanes
+# and shape, the algorithm with the fewest hardware cycles in the database is
+# the one selected.
+#
+# Usage: conv2d_layer_table.py [-o HEADER] [DB ...]
+
+import argparse
+import json
+import os
+import sys
+
+# Kernel names of the sweep, and their algorithm
+ALGOS = {
+  'conv2d_layer_direct'  : 'CONV2D_LAYER_DIRECT',
+  'conv2d_layer_im2col'  : 'CONV2D_LAYER_IM2COL',
+  'conv2d_layer_winograd': 'CONV2D_LAYER_WINOGRAD',
+}
+
+HEADER = '''// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Generated by scripts/conv2d_layer_table.py from {src}. Do not edit.
+// Fastest algorithm of the measured shapes, terminated by nr_lanes = 0.
+
+#ifndef _CONV2D_LAYER_TABLE_H_
+#define _CONV2D_LAYER_TABLE_H_
+
+#include "conv2d_layer.h"
+
+static const conv2d_layer_entry_t conv2d_layer_table[] = {{
+{rows}  {{0, 0, 0, 0, 0, 0, CONV2D_LAYER_DIRECT}}}};
+
+#endif
+'''
+
+def read_db(paths):
+  # (nr_lanes, args) -> {kernel: hw_cycles}, keeping the latest record
+  best = {}
+  for path in paths:
+    with open(path) as f:
+      for line in f:
+        if not line.strip():
+          continue
+        r = json.loads(line)
+        if r.get('kernel') not in ALGOS or r.get('ideal') or r.get('hw_cycles') is None:
+          continue
+        best.setdefault((r['nr_lanes'], r['args']), {})[r['kernel']] = r['hw_cycles']
+  return best
+
+def main():
+  parser = argparse.ArgumentParser(description='Generate conv2d_layer_table.h')
+  parser.add_argument('-o', '--output', default=os.path.join(os.path.dirname(__file__),
+                      '../apps/conv2d_layer/kernel/conv2d_layer_table.h'))
+  parser.add_argument('db', nargs='*')
+  args = parser.parse_args()
+
+  rows = ''
+  for (nr_lanes, a), cycles in sorted(read_db(args.db).items()):
+    # N C_in C_out H W K stride pad
+    N, C_in, C_out, H, W, K, stride, pad = [int(x) for x in a.split()]
+    kernel = min(cycles, key=cycles.get)
+    rows += '  {%d, %d, %d, %d, %d, %d, %s},\n' % (nr_lanes, K, stride, C_in, C_out, H * W,
+                                                   ALGOS[kernel])
+
+  src = ', '.join(os.path.basename(p) for p in args.db) if args.db else 'no results'
+  with open(args.output, 'w') as f:
+    f.write(HEADER.format(src=src, rows=rows))
+
+if __name__ == '__main__':
+  main()
@@ -0,0 +1,164 @@
+#!/usr/bin/env python3
+# Copyright 2022 ETH Zurich and University of Bologna.
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+# Convert the data.S of an app (the output of its gen_data.py) into a data
+# image, a raw binary that the Verilator testbench loads at data_image, in the
+# upper half of the DRAM (make -C hardware simv data_bin=IMAGE). The programs
+# built with data_image=1 read the symbols of the image at runtime, see
+# apps/common/data_image.h, so that one binary covers a whole size sweep.
+#
+# The image is a header followed by the data of the symbols, each with the
+# alignment of data.S:
+#   uint64 magic ("ARADATA1"), uint64 bytes of the image, uint64 symbols
+#   char args[64], the description of the dataset
+#   {char name[32], uint64 offset from the header, uint64 bytes} per symbol
+#
+# Usage: data_image.py [--nr-lanes N] [--args ARGS] -o IMAGE [DATA_S]
+# With no DATA_S, the assembly is read from stdin, e.g.:
+#   python3 apps/fmatmul/script/gen_data.py 64 64 64 | \
+#     scripts/data_image.py --args "fmatmul 64 64 64" -o fmatmul_64.img
+
+import argparse
+import re
+import struct
+import sys
+
+# Keep in sync with apps/common/data_image.h
+MAGIC = 0x3141544144415241
+NAME_LEN = 32
+ARGS_LEN = 64
+HDR_BYTES = 24 + ARGS_LEN
+ENTRY_BYTES = NAME_LEN + 16
+
+# Bytes of the integer directives
+INT_DIRECTIVES = {'.byte': 1, '.half': 2, '.short': 2, '.2byte': 2, '.word': 4, '.long': 4,
+                  '.4byte': 4, '.dword': 8, '.quad': 8, '.8byte': 8}
+
+def error(lineno, msg):
+  sys.exit('Error: line {}: {}'.format(lineno, msg))
+
+def evaluate(expr, nr_lanes, lineno):
+  # The alignments of gen_data.py can depend on the number of lanes
+  expr = expr.replace('NR_LANES', str(nr_lanes))
+  if not re.fullmatch(r'[0-9a-fA-FxX+\-*/() ]+', expr):
+    error(lineno, 'cannot evaluate "{}"'.format(expr))
+  return int(eval(expr.replace('/', '//')))
+
+def parse(lines, nr_lanes):
+  # Return the data of the symbols, as [(name, offset, bytes)], and its
+  # alignment
+  data = bytearray()
+  symbols = []
+  max_align = 8
+  # End of the last data, before the padding of an alignment
+  data_end = 0
+  for lineno, line in enumerate(lines, 1):
+    line = line.split('#')[0].strip()
+    # Labels, possibly followed by a directive
+    while True:
+      m = re.match(r'([A-Za-z_.$][\w.$]*):\s*(.*)', line)
+      if not m:
+        break
+      if symbols and symbols[-1][2] is None:
+        symbols[-1][2] = data_end - symbols[-1][1]
+      symbols.append([m.group(1), len(data), None])
+      line = m.group(2)
+    if not line:
+      continue
+    directive, operands = (line.split(None, 1) + [''])[:2]
+    if directive in ('.global', '.globl', '.type', '.size'):
+      continue
+    elif directive in ('.section', '.pushsection'):
+      # The zero buffers of data_emit.py are in .bss, and go to the image as well
+      if not operands.startswith(('.data', '.l2', '.bss')):
+        error(lineno, 'only data sections can be converted, got "{}"'.format(operands))
+    elif directive == '.popsection':
+      continue
+    elif directive in ('.balign', '.align', '.p2align'):
+      align = evaluate(operands.split(',')[0], nr_lanes, lineno)
+      if directive != '.balign':
+        align = 1 << align
+      if align & (align - 1):
+        error(lineno, 'the alignment {} is not a power of two'.format(align))
+      max_align = max(max_align, align)
+      data.extend(bytes(-len(data) % align))
+      continue
+    elif directive in INT_DIRECTIVES:
+      nbytes = INT_DIRECTIVES[directive]
+      for value in operands.split(','):
+        value = int(value.strip(), 0) & ((1 << (8 * nbytes)) - 1)
+        data.extend(value.to_bytes(nbytes, 'little'))
+    elif directive in ('.zero', '.space', '.skip'):
+      data.extend(bytes(evaluate(operands.split(',')[0], nr_lanes, lineno)))
+    elif directive == '.incbin':
+      # The raw binaries of apps/common/script/data_emit.py
+      path = operands.split(',')[0].strip().strip('"')
+      try:
+        with open(path, 'rb') as f:
+          data.extend(f.read())
+      except OSError as e:
+        error(lineno, 'cannot read "{}": {}'.format(path, e.strerror))
+    elif directive in ('.asciz', '.string', '.ascii'):
+      s = operands.strip('"').encode().decode('unicode_escape').encode('latin-1')
+      data.extend(s + (b'\0' if directive != '.ascii' else b''))
+    else:
+      error(lineno, 'unsupported directive "{}"'.format(directive))
+    data_end = len(data)
+
+  # Each symbol extends up to the data of the next one
+  if symbols and symbols[-1][2] is None:
+    symbols[-1][2] = data_end - symbols[-1][1]
+  return [tuple(s) for s in symbols], data, max_align
+
+def build(symbols, data, align, args):
+  for name, _, _ in symbols:
+    if len(name) >= NAME_LEN:
+      sys.exit('Error: the symbol name {} is longer than {} characters'.format(name, NAME_LEN - 1))
+  # The data keeps its alignment with respect to the header, which the linker
+  # script aligns to a page
+  hdr_bytes = HDR_BYTES + ENTRY_BYTES * len(symbols)
+  data_off = hdr_bytes + (-hdr_bytes % align)
+  size = data_off + len(data)
+  desc = args.encode()[:ARGS_LEN - 1]
+  image = struct.pack('<QQQ', MAGIC, size, len(symbols)) + desc.ljust(ARGS_LEN, b'\0')
+  for name, off, nbytes in symbols:
+    image += name.encode().ljust(NAME_LEN, b'\0') + struct.pack('<QQ', data_off + off, nbytes)
+  return image + bytes(data_off - hdr_bytes) + data
+
+def main():
+  parser = argparse.ArgumentParser(description='Convert a data.S into a data image loaded at runtime.')
+  parser.add_argument('data_s', nargs='?', help='output of gen_data.py (default: stdin)')
+  parser.add_argument('-o', '--output', required=True, help='output data image')
+  parser.add_argument('-l', '--nr-lanes', type=int, default=4, help='number of lanes, for the alignments')
+  parser.add_argument('-a', '--args', default='', help='description of the dataset, printed by the program')
+  args = parser.parse_args()
+
+  if args.data_s:
+    with open(args.data_s) as f:
+      lines = f.readlines()
+  else:
+    lines = sys.stdin.readlines()
+  symbols, data, align = parse(lines, args.nr_lanes)
+  if not symbols:
+    sys.exit('Error: no symbols to convert')
+  image = build(symbols, data, align, args.args)
+  with open(args.output, 'wb') as f:
+    f.write(image)
+  print('{}: {} symbols, {} bytes'.format(args.output, len(symbols), len(image)))
+
+if __name__ == '__main__':
+  main()
@@ -0,0 +1,220 @@
+#!/usr/bin/env python3
+# Copyright 2022 ETH Zurich and University of Bologna.
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+# Energy model of Ara, from the performance events of a measured window.
+#
+# The energy of a window is a sum of per-event energies, in pJ:
+#   - VALU, VMFPU, VMFPU2, VMXU: per lane and busy cycle, plus a fraction
+#     (clk_idle_frac) of it per lane and cycle in which the clock of the unit
+#     is enabled without an operation (valu_clk_on, vmfpu_clk_on, vmfpu2_clk_on,
+#     sldu_clk_on).
+#     The units without a clock gate are clocked in every cycle.
+#   - SLDU, MASKU: per busy cycle, plus the clocked idle cycles of the SLDU
+#   - VRF: per lane and access, with the accesses estimated from the events:
+#     three operand reads and a write per VALU and VMFPU cycle, two per SLDU
+#     cycle, and one per AXI beat
+#   - AXI: per lane and beat, as the bus is 32 bits per lane wide
+#   - static: per lane and cycle
+# The coefficients of DEFAULT_MODEL are rough estimates, to compare the
+# features of the same configuration. "calibrate" replaces them with the ones
+# of a post-synthesis power report of a window (e.g., the VCD of VCD_DUMP),
+# and of the [perf-cnt] and [hw-cycles] of the same window.
+#
+# Usage: energy_model.py estimate [--model JSON] [--no-clock-gating] --nr-lanes N LOG
+#        energy_model.py calibrate --power RPT --freq-mhz F --nr-lanes N [-o JSON] LOG
+
+import argparse
+import json
+import os
+import re
+import sys
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+
+DEFAULT_MODEL = {
+  'valu'         : 3.0,
+  'vmfpu'        : 12.0,
+  'vmfpu2'       : 12.0,
+  'vmxu'         : 20.0,
+  'sldu'         : 6.0,
+  'masku'        : 4.0,
+  'vrf_access'   : 2.5,
+  'axi_beat'     : 4.0,
+  'static'       : 1.5,
+  'clk_idle_frac': 0.15,
+}
+
+# Functional units: their busy event, their clock-enable event if they have a gate,
+# and whether they are replicated in the lanes
+UNITS = {
+  'valu'  : ('valu_busy', 'valu_clk_on', True),
+  'vmfpu' : ('vmfpu_busy', 'vmfpu_clk_on', True),
+  'vmfpu2': ('vmfpu2_busy', 'vmfpu2_clk_on', True),
+  'vmxu'  : ('vmxu_busy', None, True),
+  'sldu'  : ('sldu_busy', 'sldu_clk_on', False),
+  'masku' : ('masku_busy', None, False),
+}
+
+# Instances of the units in a hierarchical power report, summed over the lanes
+INSTANCES = {
+  'valu'      : ['i_valu'],
+  'vmfpu'     : ['i_vmfpu'],
+  'vmfpu2'    : ['i_vmfpu2'],
+  'vmxu'      : ['i_vmxu'],
+  'sldu'      : ['i_sldu'],
+  'masku'     : ['i_masku'],
+  'vrf_access': ['i_vrf'],
+  'axi_beat'  : ['i_vlsu'],
+}
+
+def load_model(path):
+  model = dict(DEFAULT_MODEL)
+  if path:
+    with open(path) as f:
+      model.update(json.load(f))
+  return model
+
+def vrf_accesses(perf):
+  # Per lane
+  return (4 * (perf.get('valu_busy', 0) + perf.get('vmfpu_busy', 0)) + 2 * perf.get('sldu_busy', 0) +
+          perf.get('axi_r_beat', 0) + perf.get('axi_w_beat', 0))
+
+def idle_cycles(unit, perf, hw_cycles, gating):
+  # Cycles with the clock of the unit enabled and no operation
+  busy, clk_on, _ = UNITS[unit]
+  on = perf.get(clk_on, hw_cycles) if clk_on and gating else hw_cycles
+  return max(on - perf.get(busy, 0), 0)
+
+def energy(perf, hw_cycles, nr_lanes, model=DEFAULT_MODEL, gating=True):
+  # {component: pJ} of the window, and the total
+  frac = model['clk_idle_frac']
+  e = {}
+  for unit, (busy, _, in_lanes) in UNITS.items():
+    if busy not in perf:
+      continue
+    copies = nr_lanes if in_lanes else 1
+    cycles = perf[busy] + frac * idle_cycles(unit, perf, hw_cycles, gating)
+    e[unit] = model[unit] * copies * cycles
+  e['vrf'] = model['vrf_access'] * nr_lanes * vrf_accesses(perf)
+  e['axi'] = model['axi_beat'] * nr_lanes * (perf.get('axi_r_beat', 0) + perf.get('axi_w_beat', 0))
+  e['static'] = model['static'] * nr_lanes * hw_cycles
+  e['total'] = sum(e.values())
+  return e
+
+def parse_power(path, scale):
+  # {instance: (dynamic W, leakage W)} of a hierarchical report (PrimeTime or Genus
+  # report_power -hierarchy): the leaf name of the instance, then the internal,
+  # switching, leakage, and total power, summed over the instances with that name
+  power = {}
+  num = r'[-+]?\d+(?:\.\d*)?(?:[eE][-+]?\d+)?'
+  with open(path, errors='replace') as f:
+    for line in f:
+      tokens = line.split()
+      if not tokens:
+        continue
+      values = [float(t) for t in tokens[1:] if re.fullmatch(num, t)]
+      if len(values) < 4:
+        continue
+      name = tokens[0].split('/')[-1]
+      internal, switching, leakage = values[:3]
+      dyn, leak = power.get(name, (0.0, 0.0))
+      power[name] = (dyn + (internal + switching) * scale, leak + leakage * scale)
+  return power
+
+def calibrate(args):
+  import benchmark_db
+  values = benchmark_db.parse_log(args.log)
+  if 'hw-cycles' not in values or 'perf-cnt' not in values:
+    sys.exit('Error: no [hw-cycles] or [perf-cnt] in ' + args.log)
+  hw_cycles = int(values['hw-cycles'][0])
+  perf = dict(zip(benchmark_db.PERF_EVENTS, [int(c) for c in values['perf-cnt']]))
+  power = parse_power(args.power, {'W': 1.0, 'mW': 1e-3, 'uW': 1e-6}[args.unit])
+  # pJ of a power (W) over the window
+  window_s = hw_cycles / (args.freq_mhz * 1e6)
+  pj = lambda w: w * window_s * 1e12
+
+  model = dict(DEFAULT_MODEL)
+  frac = model['clk_idle_frac']
+  lanes = args.nr_lanes
+  for key, names in INSTANCES.items():
+    dyn = sum(power[n][0] for n in names if n in power)
+    if not dyn:
+      print('Warning: no instance of {} in the report, keeping {} pJ'.format(key, model[key]))
+      continue
+    if key == 'vrf_access':
+      events = lanes * vrf_accesses(perf)
+    elif key == 'axi_beat':
+      events = lanes * (perf.get('axi_r_beat', 0) + perf.get('axi_w_beat', 0))
+    else:
+      busy, _, in_lanes = UNITS[key]
+      events = (lanes if in_lanes else 1) * (perf.get(busy, 0) + frac * idle_cycles(key, perf, hw_cycles, True))
+    if events:
+      model[key] = pj(dyn) / events
+  # The leakage of all of Ara, or of the units if the report has no i_ara
+  if 'i_ara' in power:
+    leak = power['i_ara'][1]
+  else:
+    leak = sum(power[n][1] for names in INSTANCES.values() for n in names if n in power)
+  model['static'] = pj(leak) / (lanes * hw_cycles)
+
+  text = json.dumps(model, indent=2, sort_keys=True)
+  if args.output:
+    with open(args.output, 'w') as f:
+      f.write(text + '\n')
+  else:
+    print(text)
+
+def estimate(args):
+  import benchmark_db
+  values = benchmark_db.parse_log(args.log)
+  if 'hw-cycles' not in values or 'perf-cnt' not in values:
+    sys.exit('Error: no [hw-cycles] or [perf-cnt] in ' + args.log)
+  hw_cycles = int(values['hw-cycles'][0])
+  perf = dict(zip(benchmark_db.PERF_EVENTS, [int(c) for c in values['perf-cnt']]))
+  e = energy(perf, hw_cycles, args.nr_lanes, load_model(args.model), not args.no_clock_gating)
+  for k, v in sorted(e.items(), key=lambda kv: -kv[1]):
+    if k != 'total':
+      print('{:8} {:>14.1f} pJ ({:5.1%})'.format(k, v, v / e['total'] if e['total'] else 0))
+  print('{:8} {:>14.1f} pJ in {} cycles ({:.1f} pJ/cycle)'.format('total', e['total'], hw_cycles,
+                                                                 e['total'] / hw_cycles))
+
+def main():
+  parser = argparse.ArgumentParser(description='Energy model of Ara from its performance events.')
+  sub = parser.add_subparsers(dest='cmd')
+  sub.required = True
+
+  est = sub.add_parser('estimate', help='energy of the window of a simulation log')
+  est.add_argument('log', help='log of the simulation, with [hw-cycles] and [perf-cnt]')
+  est.add_argument('--nr-lanes', type=int, required=True)
+  est.add_argument('--model', default=None, help='coefficients of calibrate (default: DEFAULT_MODEL)')
+  est.add_argument('--no-clock-gating', action='store_true', help='clock the units in every cycle')
+  est.set_defaults(func=estimate)
+
+  cal = sub.add_parser('calibrate', help='per-event energies from a power report of the window of LOG')
+  cal.add_argument('log', help='log of the simulation, with [hw-cycles] and [perf-cnt]')
+  cal.add_argument('--power', required=True, help='hierarchical power report of the same window')
+  cal.add_argument('--unit', default='W', choices=['W', 'mW', 'uW'], help='unit of the report')
+  cal.add_argument('--freq-mhz', type=float, required=True, help='clock of the power analysis')
+  cal.add_argument('--nr-lanes', type=int, required=True)
+  cal.add_argument('-o', '--output', default=None, help='JSON of the coefficients (default: stdout)')
+  cal.set_defaults(func=calibrate)
+
+  args = parser.parse_args()
+  args.func(args)
+
+if __name__ == '__main__':
+  main()
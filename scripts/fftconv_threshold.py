@@ -0,0 +1,119 @@
+#!/usr/bin/env python3
+# Copyright 2022 ETH Zurich and University of Bologna.
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+# Generate the filter-size thresholds of fftconv2d_f32 and fftconv1d_f32
+# (apps/fftconv) from the results of the fftconv sweep of benchmark.sh. For
+# each number of lanes and dimension, the threshold is the smallest measured
+# filter size from which the FFT path takes fewer hardware cycles than the
+# direct one for all the larger filters, or 0 if it is never faster.
+#
+# Usage: fftconv_threshold.py [-o HEADER] [DB ...]
+
+import argparse
+import json
+import os
+import sys
+
+# Kernel names of the sweep: dimensions, and whether it is the FFT path
+PATHS = {
+  'fftconv2d_direct': (2, False),
+  'fftconv2d_fft'   : (2, True),
+  'fftconv1d_direct': (1, False),
+  'fftconv1d_fft'   : (1, True),
+}
+
+HEADER = '''// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Generated by scripts/fftconv_threshold.py from {src}. Do not edit.
+// Smallest filter size of the FFT path, terminated by nr_lanes = 0.
+
+#ifndef _FFTCONV_THRESHOLD_H_
+#define _FFTCONV_THRESHOLD_H_
+
+#include "fftconv.h"
+
+static const fftconv_threshold_t fftconv_threshold_table[] = {{
+{rows}  {{0, 0, 0}}}};
+
+#endif
+'''
+
+def read_db(paths):
+  # (nr_lanes, dims, K) -> {fft: hw_cycles}, keeping the latest record
+  best = {}
+  for path in paths:
+    with open(path) as f:
+      for line in f:
+        if not line.strip():
+          continue
+        r = json.loads(line)
+        if r.get('kernel') not in PATHS or r.get('ideal') or r.get('hw_cycles') is None:
+          continue
+        dims, fft = PATHS[r['kernel']]
+        # C_in C_out H W K L K1
+        a = [int(x) for x in r['args'].split()]
+        K = a[4] if dims == 2 else a[6]
+        best.setdefault((r['nr_lanes'], dims, K), {})[fft] = r['hw_cycles']
+  return best
+
+def thresholds(best):
+  # (nr_lanes, dims) -> [(K, FFT faster)], for the sizes with both paths
+  sweep = {}
+  for (nr_lanes, dims, K), cycles in sorted(best.items()):
+    if len(cycles) == 2:
+      sweep.setdefault((nr_lanes, dims), []).append((K, cycles[True] < cycles[False]))
+  res = {}
+  for key, ks in sweep.items():
+    k = 0
+    for K, faster in reversed(ks):
+      if not faster:
+        break
+      k = K
+    res[key] = k
+  return res
+
+def main():
+  parser = argparse.ArgumentParser(description='Generate fftconv_threshold.h')
+  parser.add_argument('-o', '--output', default=os.path.join(os.path.dirname(__file__),
+                      '../apps/fftconv/kernel/fftconv_threshold.h'))
+  parser.add_argument('db', nargs='*')
+  args = parser.parse_args()
+
+  rows = ''
+  for (nr_lanes, dims), k in sorted(thresholds(read_db(args.db)).items()):
+    rows += '  {%d, %d, %d},\n' % (nr_lanes, dims, k)
+
+  src = ', '.join(os.path.basename(p) for p in args.db) if args.db else 'no results'
+  with open(args.output, 'w') as f:
+    f.write(HEADER.format(src=src, rows=rows))
+
+if __name__ == '__main__':
+  main()
@@ -0,0 +1,148 @@
+#!/usr/bin/env python3
+# Copyright 2022 ETH Zurich and University of Bologna.
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+# Build the image of a fast-forwarded boot.
+#
+# The modified Spike, with SPIKE_FFWD=<state>, runs an Ara binary until its
+# first write to hw_cnt_en_reg and dumps the architectural state and the DRAM
+# there. This script writes that state into the ffwd_state of the binary,
+# raises ffwd_magic, and saves the DRAM as an ELF file. On the RTL, crt0.S then
+# restores the state and jumps to the fast-forwarded pc right away.
+#
+# Usage: ffwd_image.py -o IMAGE BINARY STATE
+
+import argparse
+import struct
+import sys
+
+PAGE = 4096
+
+# Layout of ffwd_state. Keep in sync with apps/common/crt0.S
+FFWD_CSRS = ['pc', 'prv', 'hw_cnt_en', 'fcsr', 'vl', 'vtype', 'vxrm', 'vxsat', 'vstart']
+FFWD_X = 72
+FFWD_F = 328
+FFWD_VREGS = 640
+
+def read_symbols(path):
+  # {name: (value, size)} of the symbol table of an ELF64 little-endian file
+  with open(path, 'rb') as f:
+    elf = f.read()
+  if elf[:4] != b'\x7fELF' or elf[4] != 2 or elf[5] != 1:
+    sys.exit('Error: ' + path + ' is not a 64-bit little-endian ELF file')
+  e_shoff, = struct.unpack_from('<Q', elf, 0x28)
+  e_shentsize, e_shnum = struct.unpack_from('<HH', elf, 0x3a)
+  sections = [struct.unpack_from('<IIQQQQIIQQ', elf, e_shoff + i * e_shentsize) for i in range(e_shnum)]
+  symbols = {}
+  for sh_type, sh_offset, sh_size, sh_link, sh_entsize in \
+      [(s[1], s[4], s[5], s[6], s[9]) for s in sections]:
+    # SHT_SYMTAB
+    if sh_type != 2:
+      continue
+    strtab = sections[sh_link][4]
+    for off in range(sh_offset, sh_offset + sh_size, sh_entsize):
+      st_name, _, _, _, st_value, st_size = struct.unpack_from('<IBBHQQ', elf, off)
+      name = elf[strtab + st_name:elf.index(b'\0', strtab + st_name)].decode()
+      symbols[name] = (st_value, st_size)
+  entry, = struct.unpack_from('<Q', elf, 0x18)
+  flags, = struct.unpack_from('<I', elf, 0x30)
+  return entry, flags, symbols
+
+def read_state(path):
+  with open(path, 'rb') as f:
+    data = f.read()
+  if data[:4] != b'FFWD':
+    sys.exit('Error: ' + path + ' is not a fast-forward state')
+  version, = struct.unpack_from('<I', data, 4)
+  if version != 1:
+    sys.exit('Error: unsupported fast-forward state version {}'.format(version))
+  off = 8
+  csrs = dict(zip(FFWD_CSRS, struct.unpack_from('<{}Q'.format(len(FFWD_CSRS)), data, off)))
+  off += 8 * len(FFWD_CSRS)
+  regs = data[off:off + 64 * 8]
+  off += 64 * 8
+  vlenb, = struct.unpack_from('<Q', data, off)
+  off += 8
+  vregs = data[off:off + 32 * vlenb]
+  off += 32 * vlenb
+  pages = {}
+  while True:
+    addr, = struct.unpack_from('<Q', data, off)
+    off += 8
+    if addr == 0xffffffffffffffff:
+      break
+    pages[addr] = bytearray(data[off:off + PAGE])
+    off += PAGE
+  return csrs, regs, vlenb, vregs, pages
+
+def poke(pages, addr, data):
+  # Write data into the paged DRAM image
+  for i, b in enumerate(data):
+    base = (addr + i) & ~(PAGE - 1)
+    if base not in pages:
+      pages[base] = bytearray(PAGE)
+    pages[base][addr + i - base] = b
+
+def write_elf(path, entry, flags, pages):
+  # One PT_LOAD segment per run of contiguous pages, no section headers
+  segments = []
+  for addr in sorted(pages):
+    if segments and segments[-1][0] + len(segments[-1][1]) == addr:
+      segments[-1][1].extend(pages[addr])
+    else:
+      segments.append((addr, bytearray(pages[addr])))
+  ehsize, phentsize = 64, 56
+  off = ehsize + phentsize * len(segments)
+  ehdr = b'\x7fELF' + bytes([2, 1, 1]) + bytes(9)
+  # ET_EXEC, EM_RISCV
+  ehdr += struct.pack('<HHIQQQIHHHHHH', 2, 243, 1, entry, ehsize, 0, flags, ehsize, phentsize,
+                      len(segments), 64, 0, 0)
+  phdrs = b''
+  for addr, data in segments:
+    # PT_LOAD, RWX
+    phdrs += struct.pack('<IIQQQQQQ', 1, 7, off, addr, addr, len(data), len(data), PAGE)
+    off += len(data)
+  with open(path, 'wb') as f:
+    f.write(ehdr + phdrs)
+    for _, data in segments:
+      f.write(data)
+
+def main():
+  parser = argparse.ArgumentParser(description='Build the image of a boot fast-forwarded by Spike.')
+  parser.add_argument('binary', help='Ara binary that Spike fast-forwarded')
+  parser.add_argument('state', help='state dumped by Spike with SPIKE_FFWD')
+  parser.add_argument('-o', '--output', required=True, help='output ELF image')
+  args = parser.parse_args()
+
+  entry, flags, symbols = read_symbols(args.binary)
+  for s in ['ffwd_state', 'ffwd_magic']:
+    if s not in symbols:
+      sys.exit('Error: no ' + s + ' in ' + args.binary + ', was it linked with crt0.S?')
+  csrs, regs, vlenb, vregs, pages = read_state(args.state)
+  state_addr, state_size = symbols['ffwd_state']
+  if FFWD_VREGS + len(vregs) != state_size:
+    sys.exit('Error: the VLEN of Spike ({}) differs from the one of {}'.format(8 * vlenb, args.binary))
+
+  state = bytearray(FFWD_VREGS)
+  struct.pack_into('<{}Q'.format(len(FFWD_CSRS)), state, 0, *[csrs[c] for c in FFWD_CSRS])
+  state[FFWD_X:FFWD_F + 32 * 8] = regs
+  poke(pages, state_addr, state + vregs)
+  poke(pages, symbols['ffwd_magic'][0], struct.pack('<Q', 1))
+  write_elf(args.output, entry, flags, pages)
+  print('Fast-forwarded {} to pc {:#x}, {} KiB of DRAM'.format(args.binary, csrs['pc'], len(pages) * PAGE // 1024))
+
+if __name__ == '__main__':
+  main()
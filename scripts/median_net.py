@@ -0,0 +1,227 @@
+#!/usr/bin/env python3
+# Copyright 2022 ETH Zurich and University of Bologna.
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+# Generate the selection networks of the K x K median filters of
+# apps/imgproc (median.c), as macros of vector min/max operations:
+#  1. The K rows of a strip, K - 1 samples wider than the output, are sorted
+#     element-wise (MEDIAN<K>_COLS): every sample of the strip is the column
+#     of K samples of one window, sorted once for the K windows that have it.
+#  2. The sorted columns are slid down by 1 to K - 1 (MEDIAN<K>_NET), and the
+#     ranks sorted across the K columns of each window. The samples with more
+#     than (K * K - 1) / 2 samples above or below in the sorted matrix cannot
+#     be the median, which is selected from the others by an odd-even merge
+#     sort.
+#  3. The compare-exchanges that never swap when the columns are sorted, and
+#     the outputs that do not reach the median, are removed.
+# Both networks are checked on all the 0-1 inputs (sorted columns for the
+# second one), which, by the 0-1 principle, covers all the inputs.
+#
+# Usage: median_net.py [-o HEADER]
+
+import argparse
+import itertools
+import os
+
+HEADER = '''// Copyright 2022 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Generated by scripts/median_net.py. Do not edit.
+// Median selection networks of the K x K windows, on the rows c0 to c<K-1>,
+// with the min and max functions MIN and MAX of the vector type VT.
+
+#ifndef _MEDIAN_NET_H_
+#define _MEDIAN_NET_H_
+
+// Compare-exchange, and its min or max output alone
+#define MED_CE(VT, MIN, MAX, a, b, VL)                                         \\
+  do {                                                                         \\
+    VT t_ = MIN(a, b, VL);                                                     \\
+    b = MAX(a, b, VL);                                                         \\
+    a = t_;                                                                    \\
+  } while (0)
+#define MED_LO(MIN, a, b, VL) a = MIN(a, b, VL)
+#define MED_HI(MAX, a, b, VL) b = MAX(a, b, VL)
+{nets}
+#endif
+'''
+
+# Optimal sorting networks of the columns
+SORTERS = {
+  3: [(1, 2), (0, 2), (0, 1)],
+  5: [(0, 1), (3, 4), (2, 4), (2, 3), (0, 3), (0, 2), (1, 4), (1, 3), (1, 2)],
+}
+
+def oddeven_merge_sort(n):
+  # Batcher's odd-even merge sort of n wires, n a power of 2
+  ces = []
+  def merge(lo, hi, r):
+    step = 2 * r
+    if step < hi - lo:
+      merge(lo, hi, step)
+      merge(lo + r, hi, step)
+      ces.extend((i, i + r) for i in range(lo + r, hi - r, step))
+    else:
+      ces.append((lo, lo + r))
+  def sort(lo, hi):
+    if hi > lo:
+      mid = lo + (hi - lo) // 2
+      sort(lo, mid)
+      sort(mid + 1, hi)
+      merge(lo, hi, 1)
+  sort(0, n - 1)
+  return ces
+
+# Bit b of wire s * K + r is the sample of rank r of column s, on the 0-1 input
+# with ones[b][s] ones in column s
+def sorted_columns(K):
+  ones = list(itertools.product(range(K + 1), repeat=K))
+  w = [0] * (K * K)
+  for b, o in enumerate(ones):
+    for s in range(K):
+      for r in range(K - o[s], K):
+        w[s * K + r] |= 1 << b
+  return ones, w
+
+def simulate(w, ops):
+  w = list(w)
+  for op, i, j in ops:
+    lo, hi = w[i] & w[j], w[i] | w[j]
+    if op != 'HI':
+      w[i] = lo
+    if op != 'LO':
+      w[j] = hi
+  return w
+
+# Keep the outputs that reach the wires of out
+def prune(ces, out):
+  need, ops = set(out), []
+  for i, j in reversed(ces):
+    lo, hi = i in need, j in need
+    if lo or hi:
+      ops.append(('CE' if lo and hi else 'LO' if lo else 'HI', i, j))
+      need |= {i, j}
+  return ops[::-1], need
+
+def window_net(K):
+  N = K * K
+  m = (N - 1) // 2
+  ces = []
+  for r in range(K):
+    ces += [(a * K + r, b * K + r) for a, b in SORTERS[K]]
+  # In a matrix with sorted rows and columns, (s, r) is above (s + 1) (r + 1) - 1
+  # samples, and below (K - s) (K - r) - 1
+  cand = [(s, r) for s in range(K) for r in range(K)
+          if (s + 1) * (r + 1) <= m + 1 and (K - s) * (K - r) <= m + 1]
+  below = sum(1 for s in range(K) for r in range(K) if (K - s) * (K - r) > m + 1)
+  cand.sort(key=lambda x: ((x[0] + 1) * (x[1] + 1), x[0]))
+  cw = [s * K + r for s, r in cand]
+  n = 1 << (len(cw) - 1).bit_length()
+  ces += [(cw[i], cw[j]) for i, j in oddeven_merge_sort(n) if j < len(cw)]
+  out = cw[m - below]
+
+  ones, w = sorted_columns(K)
+  kept = []
+  for i, j in ces:
+    if w[i] & ~w[j]:
+      kept.append((i, j))
+      w[i], w[j] = w[i] & w[j], w[i] | w[j]
+  ops, _ = prune(kept, [out])
+
+  _, w = sorted_columns(K)
+  gold = sum(1 << b for b, o in enumerate(ones) if sum(o) > m)
+  assert simulate(w, ops)[out] == gold, 'median %dx%d' % (K, K)
+  return ops, out
+
+def column_net(K, ranks):
+  ops, _ = prune(SORTERS[K], ranks)
+  for x in range(1 << K):
+    w = simulate([(x >> r) & 1 for r in range(K)], ops)
+    ones = bin(x).count('1')
+    assert all(w[r] == (r >= K - ones) for r in ranks), 'columns %d' % K
+  return ops
+
+def macro(name, args, lines):
+  text = '#define %s(%s)' % (name, ', '.join(args))
+  body = [text] + ['  ' + l for l in lines]
+  width = max(len(l) for l in body) + 1
+  width = max(width, 79)
+  return '\n'.join(l.ljust(width) + '\\' for l in body[:-1]) + '\n' + body[-1] + '\n'
+
+def emit_op(op, a, b, vl):
+  if op == 'CE':
+    return 'MED_CE(VT, MIN, MAX, %s, %s, %s);' % (a, b, vl)
+  if op == 'LO':
+    return 'MED_LO(MIN, %s, %s, %s);' % (a, b, vl)
+  return 'MED_HI(MAX, %s, %s, %s);' % (a, b, vl)
+
+def gen(K):
+  ops, out = window_net(K)
+  used = sorted({x for _, i, j in ops for x in (i, j)})
+  ranks = sorted({x % K for x in used})
+  cols = column_net(K, ranks)
+
+  def wire(x):
+    return 'w%d_%d' % (x // K, x % K)
+
+  load = ['VT c0 = LOAD(s, VL);'] + \
+         ['VT c%d = LOAD((s) + %d * (stride), VL);' % (r, r) for r in range(1, K)]
+  colsort = [emit_op(op, 'c%d' % i, 'c%d' % j, 'VL') for op, i, j in cols]
+
+  # The slid copies are defined before their first use
+  net, defined = [], set()
+  for op, i, j in ops:
+    for x in (i, j):
+      if x not in defined:
+        s, r = x // K, x % K
+        net.append('VT %s = %s;' % (wire(x), 'c%d' % r if s == 0 else
+                                   'SLIDE(c%d, c%d, %d, VL)' % (r, r, s)))
+        defined.add(x)
+    net.append(emit_op(op, wire(i), wire(j), 'VL'))
+
+  nr_ops = sum(2 if op == 'CE' else 1 for op, _, _ in ops)
+  return ('\n// %dx%d: %d min/max on the columns, %d slides, and %d min/max on the '
+          'windows\n' % (K, K, sum(2 if op == 'CE' else 1 for op, _, _ in cols),
+                         sum(1 for x in used if x >= K), nr_ops) +
+          macro('MEDIAN%d_LOAD' % K, ['VT', 'LOAD', 's', 'stride', 'VL'], load) +
+          macro('MEDIAN%d_COLS' % K, ['VT', 'MIN', 'MAX', 'VL'], colsort) +
+          macro('MEDIAN%d_NET' % K, ['VT', 'MIN', 'MAX', 'SLIDE', 'VL'], net) +
+          '#define MEDIAN%d_OUT %s\n' % (K, wire(out)))
+
+def main():
+  parser = argparse.ArgumentParser(description='Generate median_net.h')
+  parser.add_argument('-o', '--output', default=os.path.join(os.path.dirname(__file__),
+                      '../apps/imgproc/kernel/median_net.h'))
+  args = parser.parse_args()
+
+  with open(args.output, 'w') as f:
+    f.write(HEADER.replace('{nets}', ''.join(gen(K) for K in sorted(SORTERS))))
+
+if __name__ == '__main__':
+  main()
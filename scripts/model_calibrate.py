@@ -0,0 +1,256 @@
+#!/usr/bin/env python3
+# Copyright 2022 ETH Zurich and University of Bologna.
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+# Calibration of the cycle-approximate model of Ara (hardware/model) against
+# the RTL. For every configuration, the benchmarks of apps/benchmarks are built
+# for the ideal dispatcher with the default arguments of their data
+# (apps/common/default_args.mk), and their vtraces are simulated on the
+# Verilator model, as parallel processes (see regression.py), and on the model.
+# With --fit, the timing parameters of the model are tuned one at a time to
+# minimize the mean error on the [hw-cycles], and the best ones are written to
+# hardware/model/calibration/<config>.params, which make model-run reads.
+#
+# Usage: model_calibrate.py [-c config ...] [-j jobs] [-k kernel ...] [--fit]
+#                           [--no-build] [--no-sim] [-o report.csv]
+
+import argparse
+import concurrent.futures
+import csv
+import glob
+import os
+import re
+import shutil
+import subprocess
+import sys
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+import regression
+
+ROOT_DIR = regression.ROOT_DIR
+APPS_DIR = regression.APPS_DIR
+HW_DIR = regression.HW_DIR
+MODEL = os.path.join(HW_DIR, 'build', 'ara_model')
+CALIB_DIR = os.path.join(HW_DIR, 'model', 'calibration')
+
+# Target of the mean and of the largest error
+TARGET = 0.10
+
+# Timing parameters of the model tuned by --fit, with their range
+fit_params = {
+  'dispatch_lat'   : (0, 8),
+  'start_lat'      : (0, 12),
+  'opq_depth'      : (1, 8),
+  'valu_lat'       : (1, 8),
+  'mul_lat'        : (1, 8),
+  'sldu_lat'       : (1, 16),
+  'masku_lat'      : (1, 16),
+  'red_intra'      : (0, 8),
+  'red_step'       : (1, 16),
+  'osum_hop'       : (0, 8),
+  'ld_lat'         : (1, 24),
+  'st_lat'         : (0, 16),
+  'addrgen_ack_lat': (0, 12),
+  'scalar_resp_lat': (0, 12),
+}
+
+def all_kernels():
+  return sorted(os.path.basename(b)[:-len('.bmark')]
+                for b in glob.glob(os.path.join(APPS_DIR, 'benchmarks', 'benchmark', '*.bmark')))
+
+def default_args(kernel):
+  with open(os.path.join(APPS_DIR, 'common', 'default_args.mk')) as f:
+    m = re.search(r'^def_args_{}\s*=\s*"(.*)"'.format(re.escape(kernel)), f.read(), re.M)
+  return m.group(1).split() if m else []
+
+def prepare(config, opts):
+  # Build the ideal-dispatcher model, and the benchmarks with their vtraces
+  outdir = os.path.join(opts.outdir, config)
+  bindir = os.path.join(outdir, 'bin')
+  veril_library = os.path.join(HW_DIR, 'build', 'verilator_' + config + '_ideal')
+  os.makedirs(bindir, exist_ok=True)
+  log = os.path.join(outdir, 'build.log')
+  open(log, 'w').close()
+
+  common = ['config=' + config]
+  if not opts.no_build:
+    regression.make(['-C', HW_DIR, 'verilate', 'ideal_dispatcher=1', 'veril_library=' + veril_library] + common, log)
+  jobs = []
+  for kernel in opts.kernels:
+    binary = os.path.join(bindir, kernel + '.ideal')
+    vtrace = os.path.join(bindir, kernel + '.vtrace')
+    if not opts.no_build:
+      # The data and the binary of the benchmarks are shared by the kernels
+      regression.make(['-C', APPS_DIR, 'clean'], log)
+      os.makedirs(os.path.join(APPS_DIR, 'benchmarks', 'data'), exist_ok=True)
+      with open(os.path.join(APPS_DIR, 'benchmarks', 'data', 'data.S'), 'w') as data:
+        if subprocess.call([sys.executable, os.path.join(APPS_DIR, kernel, 'script', 'gen_data.py')] + default_args(kernel),
+                           stdout=data):
+          sys.exit('Error: gen_data.py of {} failed.'.format(kernel))
+      regression.make(['-C', APPS_DIR, 'ENV_DEFINES=-D{}=1'.format(kernel.upper()), 'bin/benchmarks.ideal'] + common, log)
+      shutil.copy(os.path.join(APPS_DIR, 'bin', 'benchmarks.ideal'), binary)
+      shutil.copy(os.path.join(APPS_DIR, 'ideal_dispatcher', 'vtrace', 'benchmarks.vtrace'), vtrace)
+    if not os.path.isfile(vtrace):
+      print('Warning: {} not found, skipping it.'.format(vtrace))
+      continue
+    jobs.append((config, binary, os.path.join(veril_library, 'V' + regression.VERIL_TOP), ['+vtrace=' + vtrace]))
+  return jobs
+
+def rtl_cycles(config, kernel, opts):
+  # [hw-cycles] of a previous simulation
+  log = os.path.join(opts.outdir, config, kernel + '.ideal.log')
+  if not os.path.isfile(log):
+    return None
+  with open(log, errors='replace') as f:
+    hw = regression.HW_CYCLES.findall(f.read())
+  return int(hw[-1]) if hw else None
+
+def run_model(config, kernel, params, opts):
+  vtrace = os.path.join(opts.outdir, config, 'bin', kernel + '.vtrace')
+  cmd = [MODEL, '--config', os.path.join(ROOT_DIR, 'config', config + '.mk')]
+  for name, value in sorted(params.items()):
+    cmd += ['-p', '{}={}'.format(name, value)]
+  out = subprocess.run(cmd + [vtrace], stdout=subprocess.PIPE, stderr=subprocess.STDOUT,
+                       universal_newlines=True).stdout
+  hw = regression.HW_CYCLES.findall(out)
+  return int(hw[-1]) if hw else None
+
+def read_params(config):
+  # The calibration of the configuration, over the defaults of the model
+  out = subprocess.run([MODEL, '--print-params'], stdout=subprocess.PIPE, universal_newlines=True).stdout
+  params = {}
+  for line in out.splitlines():
+    name, value = line.split('=', 1)
+    if name.strip() in fit_params:
+      params[name.strip()] = int(value)
+  path = os.path.join(CALIB_DIR, config + '.params')
+  if os.path.isfile(path):
+    with open(path) as f:
+      for line in f:
+        line = line.split('#')[0].strip()
+        if '=' in line:
+          name, value = line.split('=', 1)
+          params[name.strip()] = int(value)
+  return params
+
+def write_params(config, params, error):
+  os.makedirs(CALIB_DIR, exist_ok=True)
+  path = os.path.join(CALIB_DIR, config + '.params')
+  with open(path, 'w') as f:
+    f.write('# Generated by scripts/model_calibrate.py -c {} --fit\n'.format(config))
+    f.write('# Mean error on the [hw-cycles] of the benchmarks: {:.1f}%\n'.format(100 * error))
+    for name in sorted(params):
+      f.write('{} = {}\n'.format(name, params[name]))
+  return path
+
+def errors(config, kernels, rtl, params, pool, opts):
+  # Relative error of the model on every kernel
+  futures = {k: pool.submit(run_model, config, k, params, opts) for k in kernels}
+  model = {k: f.result() for k, f in futures.items()}
+  err = {k: (abs(model[k] - rtl[k]) / rtl[k] if model[k] is not None else 1.0) for k in kernels}
+  return model, err
+
+def fit(config, kernels, rtl, params, pool, opts):
+  # Coordinate descent on the mean error, one parameter and one step at a time
+  mean = lambda e: sum(e.values()) / len(e)
+  _, err = errors(config, kernels, rtl, params, pool, opts)
+  best = mean(err)
+  for it in range(opts.fit_rounds):
+    improved = False
+    for name, (lo, hi) in fit_params.items():
+      for step in (-1, 1):
+        while lo <= params[name] + step <= hi:
+          trial = dict(params)
+          trial[name] = params[name] + step
+          _, err = errors(config, kernels, rtl, trial, pool, opts)
+          # Not on the flat directions
+          if mean(err) > best - 1e-4:
+            break
+          best, params, improved = mean(err), trial, True
+          print('{} round {}: {}={}, mean error {:.1f}%'.format(config, it + 1, name, params[name], 100 * best))
+    if not improved:
+      break
+  return params, best
+
+def main():
+  parser = argparse.ArgumentParser(description='Calibrate the model of Ara against the RTL on the benchmarks.')
+  parser.add_argument('-c', '--config', nargs='+',
+                      default=[os.environ.get('config', os.environ.get('ARA_CONFIGURATION', 'default'))],
+                      help='Ara configurations to calibrate')
+  parser.add_argument('-j', '--jobs', type=int, default=os.cpu_count(), help='maximum number of parallel simulations')
+  parser.add_argument('-k', '--kernels', nargs='+', default=None, help='benchmarks to run (default: all)')
+  parser.add_argument('--fit', action='store_true', help='tune the timing parameters of the model')
+  parser.add_argument('--fit-rounds', type=int, default=4, help='rounds over the parameters of --fit')
+  parser.add_argument('--no-build', action='store_true', help='reuse the existing models, binaries, and vtraces')
+  parser.add_argument('--no-sim', action='store_true', help='reuse the logs of the previous RTL simulations')
+  parser.add_argument('--timeout', type=int, default=None, help='timeout of each simulation, in seconds')
+  parser.add_argument('--outdir', default=os.path.join(HW_DIR, 'build', 'model_calibrate'), help='output folder')
+  parser.add_argument('-o', '--report', default='model_calibrate.csv', help='report file (CSV)')
+  opts = parser.parse_args()
+
+  if opts.kernels is None:
+    opts.kernels = all_kernels()
+  opts.outdir = os.path.abspath(opts.outdir)
+
+  if not opts.no_build:
+    regression.make(['-C', HW_DIR, 'model'], os.path.join(opts.outdir, 'model.log'))
+
+  # The binaries overwrite each other in apps/bin, so the build step is serial
+  jobs = []
+  for config in opts.config:
+    os.makedirs(os.path.join(opts.outdir, config), exist_ok=True)
+    jobs += prepare(config, opts)
+
+  with concurrent.futures.ThreadPoolExecutor(max_workers=max(1, opts.jobs)) as pool:
+    if not opts.no_sim:
+      futures = [pool.submit(regression.simulate, job, opts) for job in jobs]
+      for i, fut in enumerate(concurrent.futures.as_completed(futures)):
+        r = fut.result()
+        print('[{}] {:<8} {}/{} (hw-cycles: {})'.format(i + 1, r['status'], r['config'], r['binary'], r['hw_cycles']))
+
+    rows = []
+    for config in opts.config:
+      rtl = {k: rtl_cycles(config, k, opts) for k in opts.kernels}
+      kernels = [k for k in opts.kernels if rtl[k]]
+      for k in sorted(set(opts.kernels) - set(kernels)):
+        print('Warning: no [hw-cycles] of {} on {}, not calibrated.'.format(k, config))
+      if not kernels:
+        continue
+      params = read_params(config)
+      if opts.fit:
+        params, _ = fit(config, kernels, rtl, params, pool, opts)
+      model, err = errors(config, kernels, rtl, params, pool, opts)
+      mean = sum(err.values()) / len(err)
+      if opts.fit:
+        print('Calibration: ' + write_params(config, params, mean))
+      print('{:<16} {:>12} {:>12} {:>8}'.format(config, 'rtl', 'model', 'error'))
+      for k in kernels:
+        print('{:<16} {:>12} {:>12} {:>7.1f}%'.format(k, rtl[k], model[k] if model[k] is not None else '-', 100 * err[k]))
+        rows.append({'config': config, 'kernel': k, 'rtl_cycles': rtl[k], 'model_cycles': model[k],
+                     'error': round(err[k], 4)})
+      worst = max(err, key=err.get)
+      print('{}: mean error {:.1f}%, largest {:.1f}% ({}), target {:.0f}%'.format(
+        config, 100 * mean, 100 * err[worst], worst, 100 * TARGET))
+
+  with open(opts.report, 'w', newline='') as f:
+    writer = csv.DictWriter(f, fieldnames=['config', 'kernel', 'rtl_cycles', 'model_cycles', 'error'])
+    writer.writeheader()
+    writer.writerows(rows)
+  print('Report: ' + opts.report)
+  sys.exit(0 if rows and all(r['error'] <= TARGET for r in rows) else 1)
+
+if __name__ == '__main__':
+  main()
@@ -0,0 +1,124 @@
+#!/usr/bin/env python3
+# Copyright 2022 ETH Zurich and University of Bologna.
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+# Report of the sampling profile of CVA6 (hardware/tb/dpi/pc_sample.cc),
+# recorded with pc_sample=1, in the style of `perf report`. The sampled PCs are
+# symbolized with the disassembly of the binary (apps/bin/<app>.dump), and the
+# samples are split by the cause of the wait of CVA6:
+#   ara_full: Ara does not accept the next instruction
+#   ara_resp: an instruction sent to Ara has not been answered yet
+#   dcache:   a read of the data cache is in flight
+#   fence:    the committing instruction is a fence, waiting for nothing else
+#   run:      none of them
+#
+# Usage: pc_report.py [-n TOP] SAMPLES DUMP
+
+import argparse
+import collections
+import re
+import sys
+
+# Causes of hardware/tb/ara_pc_sampler.sv
+CAUSES = ['run', 'ara_full', 'ara_resp', 'dcache']
+FENCE = 'fence'
+COLUMNS = CAUSES[1:] + [FENCE]
+
+def read_samples(path):
+  period = None
+  samples = []
+  with open(path) as f:
+    for line in f:
+      m = re.match(r'#\s*pc_sample period (\d+)', line)
+      if m:
+        period = int(m.group(1))
+        continue
+      if line.strip() and not line.startswith('#'):
+        pc, cause, count = line.split()
+        samples.append((int(pc, 16), int(cause), int(count)))
+  return period, samples
+
+def read_dump(path):
+  # {pc: (function, instruction)}
+  insns = {}
+  function = None
+  with open(path, errors='replace') as f:
+    for line in f:
+      m = re.match(r'^([0-9a-f]+) <(.*)>:', line)
+      if m:
+        function = m.group(2)
+        continue
+      m = re.match(r'^\s*([0-9a-f]+):\s*(.*)', line)
+      if m and function:
+        # The encoding, then the instruction, separated by tabs (GNU and LLVM objdump)
+        fields = m.group(2).rstrip().split('\t')
+        insn = ' '.join(x.strip() for x in fields[1:] if x.strip())
+        insns[int(m.group(1), 16)] = (function, re.sub(r'\s+', ' ', insn))
+  return insns
+
+def cause_name(cause, insn):
+  name = CAUSES[cause] if cause < len(CAUSES) else 'cause{}'.format(cause)
+  if name == 'run' and insn.split(' ')[0].startswith(FENCE):
+    return FENCE
+  return name
+
+def report(period, samples, insns, top):
+  total = sum(c for _, _, c in samples)
+  if not total:
+    return 'No samples.\n'
+  by_insn = collections.defaultdict(collections.Counter)
+  by_func = collections.defaultdict(collections.Counter)
+  by_cause = collections.Counter()
+  for pc, cause, count in samples:
+    function, insn = insns.get(pc, ('[unknown]', ''))
+    name = cause_name(cause, insn)
+    by_insn[pc][name] += count
+    by_func[function][name] += count
+    by_cause[name] += count
+
+  def pct(x):
+    return '{:.1%}'.format(x / total)
+
+  out = ['Samples: {}, every {} cycles (about {} cycles)'.format(total, period, total * period)
+         if period else 'Samples: {}'.format(total)]
+  out.append('Causes: ' + ', '.join('{} {}'.format(c, pct(by_cause[c])) for c in ['run'] + COLUMNS))
+  out.append('')
+  out.append('| cycles | function | ' + ' | '.join(COLUMNS) + ' |')
+  out.append('|---|---|' + '---|' * len(COLUMNS))
+  for function, c in sorted(by_func.items(), key=lambda x: -sum(x[1].values()))[:top]:
+    out.append('| {} | {} | '.format(pct(sum(c.values())), function) +
+               ' | '.join(pct(c[n]) for n in COLUMNS) + ' |')
+  out.append('')
+  out.append('| cycles | function | pc | instruction | ' + ' | '.join(COLUMNS) + ' |')
+  out.append('|---|---|---|---|' + '---|' * len(COLUMNS))
+  for pc, c in sorted(by_insn.items(), key=lambda x: -sum(x[1].values()))[:top]:
+    function, insn = insns.get(pc, ('[unknown]', ''))
+    out.append('| {} | {} | {:x} | `{}` | '.format(pct(sum(c.values())), function, pc, insn) +
+               ' | '.join(pct(c[n]) for n in COLUMNS) + ' |')
+  return '\n'.join(out) + '\n'
+
+def main():
+  parser = argparse.ArgumentParser(description='Sampling profile report of CVA6 on Ara.')
+  parser.add_argument('samples', help='sample file of the simulation (build/<app>.pcs)')
+  parser.add_argument('dump', help='disassembly of the binary (apps/bin/<app>.dump)')
+  parser.add_argument('-n', '--top', type=int, default=20, help='functions and instructions listed (default: 20)')
+  args = parser.parse_args()
+
+  period, samples = read_samples(args.samples)
+  sys.stdout.write(report(period, samples, read_dump(args.dump), args.top))
+
+if __name__ == '__main__':
+  main()
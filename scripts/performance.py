@@ -38,11 +38,9 @@ def fmatmul(args, cycles):
   m           = int(args[0])
   n           = int(args[1])
   p           = int(args[2])
-  if (m == n and n == p):
-    size = m
-  else:
-    sys.exit('Unimplemented return value for performance function if !(M == N == P) in "' + kernel)
-  performance = 2 * size * size * size / cycles
+  # The size of a rectangular matmul is the side of the square one with the same work
+  size        = m if (m == n and n == p) else round((m * n * p) ** (1 / 3))
+  performance = 2 * m * n * p / cycles
   return [size, performance]
 def iconv2d(args, cycles):
   size        = int(args[0])
@@ -59,20 +57,51 @@ def fconv3d(args, cycles):
   filter      = int(args[1])
   performance = 2 * 3 * filter * filter * size * size / cycles
   return [size, performance]
+def conv2d_layer(args, cycles):
+  n, c_in, c_out, h, w, k, stride, pad = [int(a) for a in args[0:8]]
+  ho          = (h + 2 * pad - k) // stride + 1
+  wo          = (w + 2 * pad - k) // stride + 1
+  performance = 2 * n * c_out * ho * wo * c_in * k * k / cycles
+  return [h, performance]
 def jacobi2d(args, cycles):
   size        = int(args[0])
   trash_0     = args[1]
   performance = 2 * 5 * (size-1) * (size-1) / cycles
   return [size, performance]
+def jacobi2d_tb(args, cycles):
+  size        = int(args[0])
+  tsteps      = int(args[2])
+  performance = 2 * 5 * tsteps * (size-1) * (size-1) / cycles
+  return [size, performance]
 def dropout(args, cycles):
   size        = int(args[0])
   performance = size / cycles
   return [size, performance]
+def dropout_rng(args, cycles):
+  size        = int(args[0])
+  performance = size / cycles
+  return [size, performance]
 def fft(args, cycles):
   size        = int(args[0])
   dtype       = args[1]
   performance = 10 * size * np.log2(size) / cycles
   return [size, performance]
+def fft_rfft(args, cycles):
+  # Half the FLOPs of fft, as the complex FFT of half the samples
+  size        = int(args[0])
+  performance = 5 * size * np.log2(size) / cycles
+  return [size, performance]
+def fft_batch(args, cycles):
+  size        = int(args[0])
+  batch       = int(args[2])
+  performance = 10 * size * np.log2(size) * batch / cycles
+  return [size, performance]
+def fft_2d(args, cycles):
+  # The FFTs of the rows and of the columns
+  size        = int(args[0])
+  batch       = int(args[2])
+  performance = 10 * size * batch * np.log2(size * batch) / cycles
+  return [size, performance]
 def dwt(args, cycles):
   size        = int(args[0])
   k           = 0
@@ -106,20 +135,447 @@ def roi_align(args, cycles):
   performance = 9 * batch * depth * n_boxes * crop_h * crop_w / cycles
   return [depth, performance]
 
+def fgemv(args, cycles):
+  m           = int(args[0])
+  n           = int(args[1])
+  performance = 2 * m * n / cycles
+  return [n, performance]
+def fmatmul_batched(args, cycles):
+  m           = int(args[0])
+  n           = int(args[1])
+  p           = int(args[2])
+  batch       = int(args[3])
+  performance = 2 * m * n * p * batch / cycles
+  return [batch, performance]
+def spmv(args, cycles):
+  rows        = int(args[0])
+  nnz_per_row = int(args[2])
+  performance = 2 * rows * nnz_per_row / cycles
+  return [nnz_per_row, performance]
+def layernorm(args, cycles):
+  rows        = int(args[0])
+  cols        = int(args[1])
+  performance = 8 * rows * cols / cycles
+  return [cols, performance]
+def rmsnorm(args, cycles):
+  rows        = int(args[0])
+  cols        = int(args[1])
+  performance = 4 * rows * cols / cycles
+  return [cols, performance]
+def attention(args, cycles):
+  n           = int(args[0])
+  d           = int(args[1])
+  performance = 4 * n * n * d / cycles
+  return [n, performance]
+def sort(args, cycles):
+  # Keys per cycle. rsort is the dataset of the riscv-tests
+  n           = 2048 if args[0] == 'rsort' else int(args[0])
+  performance = n / cycles
+  return [n, performance]
+def hist_scan(args, cycles):
+  # Elements per cycle
+  n           = int(args[0])
+  performance = n / cycles
+  return [n, performance]
+# Bytes per cycle, of bpe bytes per element
+def blas1(bpe, args, cycles):
+  n           = int(args[0])
+  performance = bpe * n / cycles
+  return [n, performance]
+def blas1_daxpy(args, cycles):
+  return blas1(24, args, cycles)
+def blas1_saxpy(args, cycles):
+  return blas1(12, args, cycles)
+def blas1_dscal(args, cycles):
+  return blas1(16, args, cycles)
+def blas1_dcopy(args, cycles):
+  return blas1(16, args, cycles)
+def blas1_dred(args, cycles):
+  return blas1(8, args, cycles)
+def vfredsum_repro(args, cycles):
+  # Elements per cycle
+  n           = int(args[0])
+  performance = n / cycles
+  return [n, performance]
+# Args: channels, height = width, stride, pooling window
+def dwconv(args, cycles):
+  c, h, s     = int(args[0]), int(args[1]), int(args[2])
+  ho          = (h - 1) // s + 1
+  performance = 2 * 9 * c * ho * ho / cycles
+  return [h, performance]
+def pool(args, cycles):
+  c, h, s, k  = int(args[0]), int(args[1]), int(args[2]), int(args[3])
+  ho          = (h - k) // s + 1
+  performance = k * k * c * ho * ho / cycles
+  return [h, performance]
+def globalpool(args, cycles):
+  c, h        = int(args[0]), int(args[1])
+  performance = c * h * h / cycles
+  return [h, performance]
+# Args: rows, columns, inner dimension of the GEMMs
+def activation(args, cycles):
+  # Elements per cycle
+  rows, cols  = int(args[0]), int(args[1])
+  performance = rows * cols / cycles
+  return [cols, performance]
+def act_gemm(args, cycles):
+  rows, cols, n = int(args[0]), int(args[1]), int(args[2])
+  performance = 2 * rows * n * cols / cycles
+  return [cols, performance]
+# Args: rows, columns, shift of the requantization
+def quant(args, cycles):
+  # Bytes per cycle, a 32-bit word and a byte per element
+  rows, cols  = int(args[0]), int(args[1])
+  performance = 5 * rows * cols / cycles
+  return [rows, performance]
+# Args: batches, channels, height * width
+# Bytes per cycle, of bpe bytes per element read and written
+def transpose(bpe, args, cycles):
+  n, c, hw    = int(args[0]), int(args[1]), int(args[2])
+  performance = 2 * bpe * n * c * hw / cycles
+  return [hw, performance]
+def transpose_e8(args, cycles):
+  return transpose(1, args, cycles)
+def transpose_e16(args, cycles):
+  return transpose(2, args, cycles)
+def transpose_e32(args, cycles):
+  return transpose(4, args, cycles)
+def transpose_e64(args, cycles):
+  return transpose(8, args, cycles)
+# Args: size of the systems
+def cholesky(args, cycles):
+  n           = int(args[0])
+  performance = n * n * n / 3 / cycles
+  return [n, performance]
+def lu(args, cycles):
+  n           = int(args[0])
+  performance = 2 * n * n * n / 3 / cycles
+  return [n, performance]
+# Args: queries, database vectors, vector size, neighbors
+# FLOP per cycle of the distances, or distances per cycle of the top-k
+def knn(args, cycles):
+  nq, ndb, dim = int(args[0]), int(args[1]), int(args[2])
+  performance  = 2 * nq * ndb * dim / cycles
+  return [ndb, performance]
+def knn_topk(args, cycles):
+  nq, ndb      = int(args[0]), int(args[1])
+  performance  = nq * ndb / cycles
+  return [ndb, performance]
+# Args: elements of the STREAM kernels, elements of the strided loads and of the
+# gathers, stride
+# Bytes per cycle, of the arrays read and written, or of the elements (and of
+# the offsets) loaded
+def stream(arrays, bpe, args, cycles):
+  n           = int(args[0])
+  performance = arrays * bpe * n / cycles
+  return [n, performance]
+def stream_strided(bpe, args, cycles):
+  m, stride   = int(args[1]), int(args[2])
+  performance = bpe * m / cycles
+  return [stride, performance]
+def stream_gather(bpe, args, cycles):
+  m           = int(args[1])
+  performance = 2 * bpe * m / cycles
+  return [m, performance]
+def stream_2_e8(args, cycles):
+  return stream(2, 1, args, cycles)
+def stream_3_e8(args, cycles):
+  return stream(3, 1, args, cycles)
+def stream_2_e16(args, cycles):
+  return stream(2, 2, args, cycles)
+def stream_3_e16(args, cycles):
+  return stream(3, 2, args, cycles)
+def stream_2_e32(args, cycles):
+  return stream(2, 4, args, cycles)
+def stream_3_e32(args, cycles):
+  return stream(3, 4, args, cycles)
+def stream_2_e64(args, cycles):
+  return stream(2, 8, args, cycles)
+def stream_3_e64(args, cycles):
+  return stream(3, 8, args, cycles)
+def stream_strided_e8(args, cycles):
+  return stream_strided(1, args, cycles)
+def stream_strided_e16(args, cycles):
+  return stream_strided(2, args, cycles)
+def stream_strided_e32(args, cycles):
+  return stream_strided(4, args, cycles)
+def stream_strided_e64(args, cycles):
+  return stream_strided(8, args, cycles)
+def stream_gather_e32(args, cycles):
+  return stream_gather(4, args, cycles)
+def stream_gather_e64(args, cycles):
+  return stream_gather(8, args, cycles)
+def hash_keys(args, cycles):
+  # Bytes hashed per cycle
+  n           = int(args[0]) * int(args[1])
+  performance = n / cycles
+  return [n, performance]
+# Args: rows, columns of the image, rows, columns of the resize
+def imgproc(args, cycles):
+  # Pixels of the RGB image per cycle
+  rows, cols  = int(args[0]), int(args[1])
+  performance = rows * cols / cycles
+  return [rows * cols, performance]
+# Args: options, paths, and steps
+def black_scholes(args, cycles):
+  # Options per cycle
+  n           = int(args[0])
+  performance = n / cycles
+  return [n, performance]
+def mc_call(args, cycles):
+  # Path steps per cycle
+  paths, steps = int(args[1]), int(args[2])
+  performance  = paths * steps / cycles
+  return [paths, performance]
+# Args: rows, columns of the table, bags, average length, Zipf exponent
+def embedding(args, cycles):
+  # Elements of the rows summed per cycle
+  dim, bags, length = int(args[1]), int(args[2]), int(args[3])
+  performance = bags * length * dim / cycles
+  return [dim, performance]
+# Args: inputs, hidden units, batch, timesteps
+def rnn(gates, args, cycles):
+  # FLOP of the GEMVs of the gates per cycle, over all the timesteps
+  n_in, hid, batch, steps = int(args[0]), int(args[1]), int(args[2]), int(args[3])
+  performance = 2 * batch * (n_in + hid) * gates * hid * steps / cycles
+  return [hid, performance]
+def lstm_cell(args, cycles):
+  return rnn(4, args, cycles)
+def gru_cell(args, cycles):
+  return rnn(3, args, cycles)
+# Args: rows and columns of the 2:4 sparse matrix, columns of the dense one
+def spmatmul(args, cycles):
+  # Operations of the dense GEMM per cycle, so that the sparse and the dense
+  # kernels compare
+  m, n, p     = int(args[0]), int(args[1]), int(args[2])
+  performance = 2 * m * n * p / cycles
+  return [n, performance]
+# Args: input and output channels, height, width, filter size of the 2D
+# correlation, samples and filter size of the 1D one
+def fftconv2d(args, cycles):
+  # FLOP of the direct correlation per cycle, so that the paths compare
+  C_in, C_out, H, W, K = [int(x) for x in args[:5]]
+  performance = 2 * C_out * (H - K + 1) * (W - K + 1) * C_in * K * K / cycles
+  return [K, performance]
+def fftconv1d(args, cycles):
+  L, K = int(args[5]), int(args[6])
+  performance = 2 * (L - K + 1) * K / cycles
+  return [K, performance]
+# Args: AES blocks, SHA-256 messages, and blocks per message
+def aes128(args, cycles):
+  # Bytes encrypted per cycle
+  n           = 16 * int(args[0])
+  performance = n / cycles
+  return [n, performance]
+def sha256(args, cycles):
+  # Bytes hashed per cycle
+  n           = 64 * int(args[1]) * int(args[2])
+  performance = n / cycles
+  return [n, performance]
+# Args: scale and edge factor of the graph
+def bfs(args, cycles):
+  # Edges drawn by the generator per cycle
+  n, m        = 1 << int(args[0]), (1 << int(args[0])) * int(args[1])
+  performance = m / cycles
+  return [n, performance]
+# Args: points, dimensions, centroids, and iterations. The benchmarks run one
+# assignment, or one iteration
+def kmeans(args, cycles):
+  # Point-centroid distances per cycle
+  n, k        = int(args[0]), int(args[2])
+  performance = n * k / cycles
+  return [k, performance]
+# Args: bytes of the text, and percentage of its non-ASCII words
+def bytescan(args, cycles):
+  # Bytes scanned per cycle
+  n           = int(args[0])
+  performance = n / cycles
+  return [n, performance]
+
 perfExtr = {
   'imatmul'    : imatmul,
+  'imatmul_i8' : imatmul,
+  'imatmul_i16': imatmul,
   'fmatmul'    : fmatmul,
+  'fmatmul_f32': fmatmul,
+  'fmatmul_f16': fmatmul,
   'iconv2d'    : iconv2d,
+  'iconv2d_i8' : iconv2d,
   'fconv2d'    : fconv2d,
+  'fconv2d_kxk': fconv2d,
   'fconv3d'    : fconv3d,
+  'conv2d_layer' : conv2d_layer,
+  'conv2d_layer_direct'   : conv2d_layer,
+  'conv2d_layer_im2col'   : conv2d_layer,
+  'conv2d_layer_winograd' : conv2d_layer,
   'jacobi2d'   : jacobi2d,
+  'jacobi2d_tb': jacobi2d_tb,
   'dropout'    : dropout,
+  'dropout_rng': dropout_rng,
   'fft'        : fft,
+  'fft_r4'     : fft,
+  'fft_r4_cplx': fft,
+  'fft_q15'    : fft,
+  'fft_rfft'   : fft_rfft,
+  'fft_batch'  : fft_batch,
+  'fft_2d'     : fft_2d,
   'dwt'        : dwt,
   'exp'        : exp,
   'softmax'    : softmax,
+  'softmax_online': softmax,
+  'softmax_rows'  : softmax,
+  'softmax_f16'   : softmax,
   'pathfinder' : pathfinder,
   'roi_align'  : roi_align,
+  'fgemv'      : fgemv,
+  'fmatmul_batched' : fmatmul_batched,
+  'spmv'       : spmv,
+  'spmv_sell'  : spmv,
+  'fmatmul_autovec'    : fmatmul,
+  'jacobi2d_autovec'   : jacobi2d,
+  'pathfinder_autovec' : pathfinder,
+  'dropout_autovec'    : dropout,
+  'layernorm'  : layernorm,
+  'layernorm_f16' : layernorm,
+  'rmsnorm'    : rmsnorm,
+  'rmsnorm_f16'   : rmsnorm,
+  'attention'  : attention,
+  'attention_unfused' : attention,
+  'sort'       : sort,
+  'sort_merge' : sort,
+  'sort_scalar': sort,
+  'hist_u8'    : hist_scan,
+  'hist_u16'   : hist_scan,
+  'scan_i32'   : hist_scan,
+  'scan_f32'   : hist_scan,
+  'blas1_daxpy' : blas1_daxpy,
+  'blas1_saxpy' : blas1_saxpy,
+  'blas1_dscal' : blas1_dscal,
+  'blas1_dcopy' : blas1_dcopy,
+  'blas1_dnrm2' : blas1_dred,
+  'blas1_dasum' : blas1_dred,
+  'blas1_idamax': blas1_dred,
+  'vfredsum_repro'            : vfredsum_repro,
+  'vfredsum_repro_f32'        : vfredsum_repro,
+  'vfredsum_repro_kahan'      : vfredsum_repro,
+  'vfredsum_repro_kahan_f32'  : vfredsum_repro,
+  'vfredsum_repro_ordered'    : vfredsum_repro,
+  'vfredsum_repro_ordered_f32': vfredsum_repro,
+  'vfredsum_repro_unordered'  : vfredsum_repro,
+  'vfredsum_repro_unordered_f32': vfredsum_repro,
+  'dwconv'        : dwconv,
+  'dwconv_nhwc'   : dwconv,
+  'maxpool'       : pool,
+  'maxpool_nhwc'  : pool,
+  'avgpool'       : pool,
+  'avgpool_nhwc'  : pool,
+  'globalpool'    : globalpool,
+  'globalpool_nhwc': globalpool,
+  'act_relu'      : activation,
+  'act_relu_f16'  : activation,
+  'act_gelu'      : activation,
+  'act_gelu_f16'  : activation,
+  'act_silu'      : activation,
+  'act_silu_f16'  : activation,
+  'act_gemm_gelu' : act_gemm,
+  'act_gemm_gelu_unfused': act_gemm,
+  'quant_i8'      : quant,
+  'quant_u8'      : quant,
+  'quant_i8_pc'   : quant,
+  'dequant_i8'    : quant,
+  'dequant_u8'    : quant,
+  'dequant_i8_pc' : quant,
+  'requant_i8'    : quant,
+  'transpose_e8'  : transpose_e8,
+  'transpose_e16' : transpose_e16,
+  'transpose_e32' : transpose_e32,
+  'transpose_e64' : transpose_e64,
+  'nchw2nhwc'     : transpose_e32,
+  'nhwc2nchw'     : transpose_e32,
+  'interleave'    : transpose_e32,
+  'deinterleave'  : transpose_e32,
+  'cholesky'      : cholesky,
+  'cholesky_scalar': cholesky,
+  'lu'            : lu,
+  'lu_scalar'     : lu,
+  'knn'           : knn,
+  'knn_cosine'    : knn,
+  'knn_topk'      : knn_topk,
+  'stream_copy_e8': stream_2_e8,
+  'stream_copy_e16': stream_2_e16,
+  'stream_copy_e32': stream_2_e32,
+  'stream_copy_e64': stream_2_e64,
+  'stream_scale_e8': stream_2_e8,
+  'stream_scale_e16': stream_2_e16,
+  'stream_scale_e32': stream_2_e32,
+  'stream_scale_e64': stream_2_e64,
+  'stream_add_e8' : stream_3_e8,
+  'stream_add_e16': stream_3_e16,
+  'stream_add_e32': stream_3_e32,
+  'stream_add_e64': stream_3_e64,
+  'stream_triad_e8': stream_3_e8,
+  'stream_triad_e16': stream_3_e16,
+  'stream_triad_e32': stream_3_e32,
+  'stream_triad_e64': stream_3_e64,
+  'stream_strided_e8': stream_strided_e8,
+  'stream_strided_e16': stream_strided_e16,
+  'stream_strided_e32': stream_strided_e32,
+  'stream_strided_e64': stream_strided_e64,
+  'stream_gather_e32': stream_gather_e32,
+  'stream_gather_e64': stream_gather_e64,
+  'stream_gather_clust_e32': stream_gather_e32,
+  'stream_gather_clust_e64': stream_gather_e64,
+  'xxh32'      : hash_keys,
+  'xxh32_base' : hash_keys,
+  'crc32'      : hash_keys,
+  'crc32_base' : hash_keys,
+  'imgproc'    : imgproc,
+  'imgproc_unfused': imgproc,
+  'imgproc_yuv': imgproc,
+  'imgproc_rgb': imgproc,
+  'imgproc_blur': imgproc,
+  'imgproc_resize': imgproc,
+  'median3_u8': imgproc,
+  'median3_u16': imgproc,
+  'median3_f32': imgproc,
+  'median5_u8': imgproc,
+  'median5_u16': imgproc,
+  'median5_f32': imgproc,
+  'median3_u8_scalar': imgproc,
+  'median5_u8_scalar': imgproc,
+  'black_scholes_f64': black_scholes,
+  'black_scholes_f32': black_scholes,
+  'mc_call_f32': mc_call,
+  'embedding': embedding,
+  'embedding_f16': embedding,
+  'embedding_rows': embedding,
+  'embedding_bags': embedding,
+  'lstm_cell': lstm_cell,
+  'lstm_cell_unfused': lstm_cell,
+  'gru_cell': gru_cell,
+  'spmatmul_f32': spmatmul,
+  'spmatmul_i8': spmatmul,
+  'spmatmul_dense': spmatmul,
+  'spmatmul_dense_i8': spmatmul,
+  'fftconv2d': fftconv2d,
+  'fftconv2d_direct': fftconv2d,
+  'fftconv2d_fft': fftconv2d,
+  'fftconv1d_direct': fftconv1d,
+  'fftconv1d_fft': fftconv1d,
+  'aes128_ctr': aes128,
+  'aes128_gcm': aes128,
+  'sha256': sha256,
+  'bfs': bfs,
+  'bfs_top_down': bfs,
+  'bfs_bottom_up': bfs,
+  'kmeans': kmeans,
+  'kmeans_unfused': kmeans,
+  'kmeans_iter': kmeans,
+  'bytescan_utf8': bytescan,
+  'bytescan_memchr': bytescan,
+  'bytescan_find_any': bytescan,
+  'bytescan_split': bytescan,
+  'bytescan_strlen': bytescan,
 }
 
 def main():
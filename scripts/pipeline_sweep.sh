@@ -0,0 +1,44 @@
+#!/usr/bin/env bash
+#
+# Study of the pipeline-depth knobs of the hardware.
+# pipeline_sweep.sh [$app]
+# Builds the Verilator model of $config (default 4_lanes) with each setting of
+# pipe_sweep, as fpu_pipe_regs:mul_pipe_regs:slide_mask_cut:pe_req_cut (default
+# "0:0:0:0 1:1:0:0 0:0:1:1 1:1:1:1"), runs benchmark.sh ci on it (all the apps,
+# or $app only) with a shared database, and prints the cycle cost of every
+# setting (benchmark_db.py pipeline).
+# With fpga=1, also implements each setting on the FPGA target, and the report
+# adds the fmax, the area and the runtime at the fmax from the Vivado reports.
+# When this script is called, CLANG_PATH should point to the clang directory
+# used to verilate the design.
+
+# Useful dirs
+script=$( cd -- "$( dirname -- "${BASH_SOURCE[0]}" )" &> /dev/null && pwd )
+root=${script}/..
+hardware=$root/hardware
+
+python=python3
+config=${config:-4_lanes}
+pipe_sweep=${pipe_sweep:-0:0:0:0 1:1:0:0 0:0:1:1 1:1:1:1}
+results_db=${results_db:-$root/pipeline_results.jsonl}
+
+# Move to root directory
+cd $root
+
+for p in ${pipe_sweep}
+do
+  IFS=: read fpu_pipe_regs mul_pipe_regs slide_mask_cut pe_req_cut <<< "${p}"
+  export fpu_pipe_regs mul_pipe_regs slide_mask_cut pe_req_cut
+  echo "Benchmarking ${config}, pipe ${p}"
+  config=${config} CLANG_PATH=${CLANG_PATH} make -B -C $hardware verilate || exit
+  config=${config} results_db=${results_db} $script/benchmark.sh ci $1 || exit
+  if [ "${fpga}" == "1" ]; then
+    reports=reports/${config}
+    [ "${p}" != "0:0:0:0" ] && reports=${reports}-${p//:/-}
+    config=${config} make -B -C $hardware fpga fpga_reports=${reports} || exit
+  fi
+done
+
+fpga_args=
+[ "${fpga}" == "1" ] && fpga_args="--fpga $hardware/fpga/reports --fpga-freq ${fpga_freq_mhz:-50}"
+${python} $script/benchmark_db.py pipeline ${fpga_args} ${results_db} || exit
@@ -0,0 +1,93 @@
+#!/usr/bin/env python3
+# Copyright 2022 ETH Zurich and University of Bologna.
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+# Print the region profile of a simulation log as a tree. The regions are
+# dumped by prof_dump() (apps/common/prof.h) with:
+#   [prof-name]: id name
+#   [prof]: id parent calls cycles perf_cnt...
+# For every region: its calls, its cycles, their fraction of the cycles of the
+# parent, the cycles per call, and the performance counters selected with -e
+# (default: the busy cycles of the units).
+#
+# Usage: prof_report.py [-e EVENT ...] LOG
+
+import argparse
+import os
+import re
+import sys
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+import benchmark_db
+
+# Parent of the top-level regions, PROF_NO_PARENT in prof.h
+NO_PARENT = 16
+
+DEFAULT_EVENTS = ['valu_busy', 'vmfpu_busy', 'vldu_busy', 'vstu_busy', 'sldu_busy', 'masku_busy']
+
+def parse(log):
+  names = {}
+  regions = {}
+  with open(log, errors='replace') as f:
+    for line in f:
+      m = re.search(r'\[prof-name\]:\s*(\d+)\s+(.*)', line)
+      if m:
+        names[int(m.group(1))] = m.group(2).strip()
+        continue
+      m = re.search(r'\[prof\]:(.*)', line)
+      if m:
+        v = [int(x) for x in m.group(1).split()]
+        regions[v[0]] = {
+          'parent'  : v[1],
+          'calls'   : v[2],
+          'cycles'  : v[3],
+          'perf_cnt': dict(zip(benchmark_db.PERF_EVENTS, v[4:])),
+        }
+  return names, regions
+
+def main():
+  parser = argparse.ArgumentParser(description='Print the region profile of a simulation log.')
+  parser.add_argument('-e', '--event', action='append', choices=benchmark_db.PERF_EVENTS,
+                      help='performance counter to print (default: the busy cycles of the units)')
+  parser.add_argument('log', help='simulation log')
+  args = parser.parse_args()
+
+  names, regions = parse(args.log)
+  if not regions:
+    sys.exit('Error: no [prof] records in ' + args.log)
+  events = args.event or DEFAULT_EVENTS
+
+  print('{:<32} {:>8} {:>12} {:>7} {:>10}'.format('region', 'calls', 'cycles', '%parent', 'cyc/call') +
+        ''.join(' {:>12}'.format(e) for e in events))
+
+  def visit(id, depth):
+    r = regions[id]
+    parent = regions.get(r['parent'])
+    share = 100.0 * r['cycles'] / parent['cycles'] if parent and parent['cycles'] else 100.0
+    label = '  ' * depth + names.get(id, 'region {}'.format(id))
+    print('{:<32} {:>8} {:>12} {:>7.1f} {:>10.1f}'.format(
+      label, r['calls'], r['cycles'], share, r['cycles'] / r['calls']) +
+      ''.join(' {:>12}'.format(r['perf_cnt'].get(e, 0)) for e in events))
+    for child in sorted(c for c in regions if regions[c]['parent'] == id and c != id):
+      visit(child, depth + 1)
+
+  # The regions whose parent was not dumped are printed at the top level
+  for id in sorted(regions):
+    if regions[id]['parent'] == NO_PARENT or regions[id]['parent'] not in regions:
+      visit(id, 0)
+
+if __name__ == '__main__':
+  main()
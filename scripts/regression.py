@@ -0,0 +1,180 @@
+#!/usr/bin/env python3
+# Copyright 2022 ETH Zurich and University of Bologna.
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+# Parallel regression runner for the Verilator model.
+# For each configuration, the model is verilated once (without forcing a
+# rebuild) in its own build directory, and the apps and rv64uv tests are
+# compiled and copied aside. Then, all the binaries of all the configurations
+# are simulated as parallel processes, and the results are collected in a
+# single JSON or CSV report.
+#
+# Usage: regression.py [-c config ...] [-j jobs] [--apps app ...] [--no-tests]
+#                      [-o report.json|report.csv]
+
+import argparse
+import concurrent.futures
+import csv
+import glob
+import json
+import os
+import re
+import shutil
+import subprocess
+import sys
+import time
+
+ROOT_DIR = os.path.abspath(os.path.join(os.path.dirname(__file__), '..'))
+APPS_DIR = os.path.join(ROOT_DIR, 'apps')
+HW_DIR = os.path.join(ROOT_DIR, 'hardware')
+VERIL_TOP = 'ara_tb_verilator'
+
+HW_CYCLES = re.compile(r'\[hw-cycles\]:\s*(\d+)')
+SW_CYCLES = re.compile(r'\[sw-cycles\]:\s*(\d+)')
+
+FIELDS = ['config', 'binary', 'status', 'ret_code', 'hw_cycles', 'sw_cycles', 'seconds', 'log']
+
+def all_apps():
+  apps = [os.path.basename(os.path.dirname(m)) for m in glob.glob(os.path.join(APPS_DIR, '*', 'main.c'))]
+  # The benchmark app is only a wrapper around the other apps
+  return sorted(a for a in apps if a != 'benchmarks')
+
+def make(args, log):
+  print('make ' + ' '.join(args))
+  with open(log, 'a') as f:
+    if subprocess.call(['make'] + args, stdout=f, stderr=subprocess.STDOUT):
+      sys.exit("Error: 'make {}' failed, see {}.".format(' '.join(args), log))
+
+def prepare(config, opts):
+  # Build the model and the binaries of one configuration
+  outdir = os.path.join(opts.outdir, config)
+  bindir = os.path.join(outdir, 'bin')
+  veril_library = os.path.join(HW_DIR, 'build', 'verilator_' + config +
+                               ('_mt{}'.format(opts.sim_threads) if opts.sim_threads != 1 else ''))
+  os.makedirs(bindir, exist_ok=True)
+  log = os.path.join(outdir, 'build.log')
+  open(log, 'w').close()
+
+  common = ['config=' + config]
+  if not opts.no_build:
+    make(['-C', HW_DIR, 'verilate', 'veril_library=' + veril_library,
+          'sim_threads={}'.format(opts.sim_threads)] + common, log)
+    targets = ['bin/' + a for a in opts.apps]
+    if not opts.no_tests:
+      targets.append('riscv_tests')
+    if targets:
+      make(['-C', APPS_DIR, '-j{}'.format(opts.jobs)] + common + targets, log)
+
+  # The binaries are copied aside, since apps/bin is shared among the configurations
+  binaries = [os.path.join(APPS_DIR, 'bin', a) for a in opts.apps]
+  if not opts.no_tests:
+    binaries += sorted(b for b in glob.glob(os.path.join(APPS_DIR, 'bin', 'rv64uv-ara-*')) if not b.endswith('.dump'))
+  jobs = []
+  for b in binaries:
+    if not os.path.isfile(b):
+      print('Warning: {} not found, skipping it.'.format(b))
+      continue
+    shutil.copy(b, bindir)
+    jobs.append((config, os.path.join(bindir, os.path.basename(b)), os.path.join(veril_library, 'V' + VERIL_TOP)))
+  return jobs
+
+def simulate(job, opts):
+  # job: (config, binary, model), and optionally the other arguments of the model
+  config, binary, model = job[:3]
+  extra = list(job[3]) if len(job) > 3 else []
+  name = os.path.basename(binary)
+  log = os.path.join(opts.outdir, config, name + '.log')
+  result = {'config': config, 'binary': name, 'status': 'FAIL', 'ret_code': None,
+            'hw_cycles': None, 'sw_cycles': None, 'seconds': None, 'log': log}
+
+  cmd = [model] + extra + ['-l', 'ram,{},elf'.format(binary)]
+  start = time.time()
+  with open(log, 'w') as f:
+    try:
+      # Every simulation runs in its own folder, to avoid clashes on the output files
+      rundir = os.path.join(opts.outdir, config, name + '.run')
+      os.makedirs(rundir, exist_ok=True)
+      result['ret_code'] = subprocess.call(cmd, cwd=rundir, stdout=f, stderr=subprocess.STDOUT,
+                                           timeout=opts.timeout)
+    except subprocess.TimeoutExpired:
+      result['status'] = 'TIMEOUT'
+  result['seconds'] = round(time.time() - start, 1)
+
+  with open(log, errors='replace') as f:
+    out = f.read()
+  hw = HW_CYCLES.findall(out)
+  sw = SW_CYCLES.findall(out)
+  result['hw_cycles'] = int(hw[-1]) if hw else None
+  result['sw_cycles'] = int(sw[-1]) if sw else None
+  if result['ret_code'] == 0 and 'SUCCESS' in out:
+    result['status'] = 'PASS'
+  return result
+
+def write_report(results, report):
+  if report.endswith('.csv'):
+    with open(report, 'w', newline='') as f:
+      writer = csv.DictWriter(f, fieldnames=FIELDS)
+      writer.writeheader()
+      writer.writerows(results)
+  else:
+    with open(report, 'w') as f:
+      json.dump(results, f, indent=2)
+
+def main():
+  parser = argparse.ArgumentParser(description='Run the apps and the rv64uv tests on the Verilator model in parallel.')
+  parser.add_argument('-c', '--config', nargs='+',
+                      default=[os.environ.get('config', os.environ.get('ARA_CONFIGURATION', 'default'))],
+                      help='Ara configurations to simulate')
+  parser.add_argument('-j', '--jobs', type=int, default=os.cpu_count(), help='maximum number of parallel simulations')
+  parser.add_argument('--apps', nargs='*', default=None, help='apps to simulate (default: all)')
+  parser.add_argument('--no-tests', action='store_true', help='do not simulate the rv64uv tests')
+  parser.add_argument('--no-build', action='store_true', help='reuse the existing model and binaries')
+  parser.add_argument('--sim-threads', type=int, default=1, help='threads of each Verilator model')
+  parser.add_argument('--timeout', type=int, default=None, help='timeout of each simulation, in seconds')
+  parser.add_argument('--outdir', default=os.path.join(HW_DIR, 'build', 'regression'), help='output folder')
+  parser.add_argument('-o', '--report', default='regression.json', help='report file (.json or .csv)')
+  opts = parser.parse_args()
+
+  if opts.apps is None:
+    opts.apps = all_apps()
+  opts.outdir = os.path.abspath(opts.outdir)
+
+  # The binaries of a configuration overwrite the ones of the previous one,
+  # so the build step is serial
+  jobs = []
+  for config in opts.config:
+    jobs += prepare(config, opts)
+
+  # Each simulation is a separate process, the threads only wait on them
+  results = []
+  with concurrent.futures.ThreadPoolExecutor(max_workers=max(1, opts.jobs // opts.sim_threads)) as pool:
+    futures = [pool.submit(simulate, job, opts) for job in jobs]
+    for fut in concurrent.futures.as_completed(futures):
+      r = fut.result()
+      print('[{}] {:<8} {}/{} (hw-cycles: {})'.format(len(results) + 1, r['status'], r['config'], r['binary'], r['hw_cycles']))
+      results.append(r)
+
+  results.sort(key=lambda r: (r['config'], r['binary']))
+  write_report(results, opts.report)
+
+  failed = [r for r in results if r['status'] != 'PASS']
+  print('{} passed, {} failed. Report: {}'.format(len(results) - len(failed), len(failed), opts.report))
+  for r in failed:
+    print('  {} {}/{}: {}'.format(r['status'], r['config'], r['binary'], r['log']))
+  sys.exit(1 if failed else 0)
+
+if __name__ == '__main__':
+  main()
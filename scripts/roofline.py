@@ -0,0 +1,191 @@
+#!/usr/bin/env python3
+# Copyright 2022 ETH Zurich and University of Bologna.
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+# Roofline model of an Ara configuration, with the measured benchmarks on it.
+#
+# The machine model is derived from the sources:
+#   - compute roof: one FMA (2 FLOP) per lane and cycle on 64-bit elements,
+#     and 64/SEW of them on narrower elements (ara_pkg.sv, LatFCompEW*, gives
+#     the depth of the FMA pipeline, i.e., the elements per lane in flight)
+#   - memory roof: one AXI beat per cycle, AxiDataWidth bits wide (ara_soc.sv)
+#
+# Every benchmark of the results database (benchmark_db.py) is placed on the
+# roofline of its configuration: the bytes moved are the AXI R and W beats
+# counted during the measured window ([perf-cnt]), and the performance is the
+# FLOP/cycle of performance.py.
+#
+# Usage: roofline.py [-l LANES ...] [-p roofline.png] [DB]
+
+import argparse
+import os
+import re
+import sys
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+import benchmark_db
+import performance
+
+ROOT = os.path.join(os.path.dirname(os.path.abspath(__file__)), '..')
+DEFAULT_PKG = os.path.join(ROOT, 'hardware', 'include', 'ara_pkg.sv')
+DEFAULT_SOC = os.path.join(ROOT, 'hardware', 'src', 'ara_soc.sv')
+
+SEWS = [64, 32, 16]
+
+class Machine:
+  def __init__(self, nr_lanes, axi_data_width, fma_latency):
+    self.nr_lanes = nr_lanes
+    self.axi_data_width = axi_data_width
+    # {sew: cycles}
+    self.fma_latency = fma_latency
+
+  # FLOP/cycle
+  def peak(self, sew=64):
+    return 2 * self.nr_lanes * 64 // sew
+
+  # Byte/cycle
+  def bandwidth(self):
+    return self.axi_data_width // 8
+
+  # FLOP/byte at which the kernels become compute-bound
+  def ridge(self, sew=64):
+    return self.peak(sew) / self.bandwidth()
+
+  # Attainable FLOP/cycle at a given operational intensity
+  def roof(self, intensity, sew=64):
+    return min(self.peak(sew), intensity * self.bandwidth())
+
+  # Elements in flight that hide the FMA latency
+  def min_vl(self, sew=64):
+    return self.nr_lanes * (self.fma_latency.get(sew, 0) + 1) * 64 // sew
+
+def read_fma_latency(pkg):
+  with open(pkg) as f:
+    src = f.read()
+  lat = {}
+  for sew in SEWS:
+    m = re.search(r'LatFCompEW{}\s*=\s*(?:\d*\'d)?(\d+)'.format(sew), src)
+    if m:
+      lat[sew] = int(m.group(1))
+  return lat
+
+def read_axi_data_width_per_lane(soc):
+  with open(soc) as f:
+    src = f.read()
+  m = re.search(r'AxiDataWidth\s*=\s*(\d+)\s*\*\s*NrLanes', src)
+  if not m:
+    sys.exit('Error: cannot find the AxiDataWidth of ' + soc)
+  return int(m.group(1))
+
+def machine(nr_lanes, pkg=DEFAULT_PKG, soc=DEFAULT_SOC):
+  return Machine(nr_lanes, read_axi_data_width_per_lane(soc) * nr_lanes, read_fma_latency(pkg))
+
+def entry_sew(entry):
+  # Element width of a result, 64 bits if not specified
+  sew = entry.get('sew') or 64
+  for a in entry['args'].split():
+    m = re.match(r'float(\d+)$', a)
+    if m:
+      sew = int(m.group(1))
+  return sew
+
+def place(entry, m):
+  # (intensity, FLOP/cycle, roof) of a measure, or None without AXI counts
+  cnts = entry.get('perf_cnt')
+  if not cnts or 'flop_per_cycle' not in entry:
+    return None
+  beats = cnts.get('axi_r_beat', 0) + cnts.get('axi_w_beat', 0)
+  if not beats:
+    return None
+  flop = entry['flop_per_cycle'] * entry['hw_cycles']
+  intensity = flop / (beats * m.bandwidth())
+  sew = entry_sew(entry)
+  return intensity, entry['flop_per_cycle'], m.roof(intensity, sew)
+
+def table(m, rows):
+  out = ['## {} lanes\n'.format(m.nr_lanes)]
+  out.append('Memory bandwidth: {} B/cycle.'.format(m.bandwidth()))
+  for sew in SEWS:
+    out.append('FP{}: peak {} FLOP/cycle, ridge at {:.2f} FLOP/B, {} elements in flight to hide the FMA latency.'.format(
+      sew, m.peak(sew), m.ridge(sew), m.min_vl(sew)))
+  out.append('')
+  out.append('| kernel | size | FLOP/B | FLOP/cycle | roof | of roof | bound |')
+  out.append('|---|---|---|---|---|---|---|')
+  for e, (intensity, perf, roof) in rows:
+    bound = 'compute' if intensity >= m.ridge(entry_sew(e)) else 'memory'
+    out.append('| {} | {} | {:.3f} | {:.3f} | {:.3f} | {:.1%} | {} |'.format(
+      e['kernel'], e['size'], intensity, perf, roof, perf / roof, bound))
+  return '\n'.join(out) + '\n'
+
+def plot(machines, points, fname):
+  import matplotlib
+  matplotlib.use('Agg')
+  import matplotlib.pyplot as plt
+  import numpy as np
+
+  fig, ax = plt.subplots()
+  x = np.logspace(-3, 3, 200, base=2)
+  for i, m in enumerate(machines):
+    color = 'C{}'.format(i)
+    ax.plot(x, [m.roof(v) for v in x], color=color, label='{} lanes'.format(m.nr_lanes))
+    pts = points[m.nr_lanes]
+    ax.scatter([p[1][0] for p in pts], [p[1][1] for p in pts], color=color, marker='x')
+  ax.set_xscale('log', base=2)
+  ax.set_yscale('log', base=2)
+  ax.set_xlabel('Operational intensity (FLOP/B)')
+  ax.set_ylabel('Performance (FLOP/cycle)')
+  ax.grid(True, which='both', linestyle=':')
+  ax.legend(loc='lower right')
+  fig.savefig(fname)
+
+def main():
+  parser = argparse.ArgumentParser(description='Roofline model of Ara, with the measured benchmarks.')
+  parser.add_argument('db', nargs='?', default=None, help='database of the results (JSON lines)')
+  parser.add_argument('-l', '--lanes', type=int, nargs='+', default=None,
+                      help='lane configurations (default: the measured ones, or 2 4 8 16)')
+  parser.add_argument('--pkg', default=DEFAULT_PKG, help='ara_pkg.sv, for the FPU latencies')
+  parser.add_argument('--soc', default=DEFAULT_SOC, help='ara_soc.sv, for the AXI data width')
+  parser.add_argument('-o', '--output', default=None, help='output Markdown file (default: stdout)')
+  parser.add_argument('-p', '--plot', default=None, help='also plot the rooflines to this file')
+  args = parser.parse_args()
+
+  measures = benchmark_db.latest(benchmark_db.load(args.db), None) if args.db else {}
+  real = [e for e in measures.values() if not e['ideal'] and e['kernel'] in performance.perfExtr]
+  lanes = args.lanes or sorted({e['nr_lanes'] for e in real}) or [2, 4, 8, 16]
+
+  machines = [machine(n, args.pkg, args.soc) for n in lanes]
+  points = {}
+  out = []
+  for m in machines:
+    pts = []
+    for e in sorted(real, key=lambda e: (e['kernel'], e['size'])):
+      p = place(e, m) if e['nr_lanes'] == m.nr_lanes else None
+      if p:
+        pts.append((e, p))
+    points[m.nr_lanes] = pts
+    out.append(table(m, pts))
+  text = '\n'.join(out)
+
+  if args.output:
+    with open(args.output, 'w') as f:
+      f.write(text)
+  else:
+    print(text)
+  if args.plot:
+    plot(machines, points, args.plot)
+
+if __name__ == '__main__':
+  main()
@@ -0,0 +1,40 @@
+#!/usr/bin/env bash
+#
+# Scaling study of the benchmarks across the lane configurations.
+# scaling.sh [$app]
+# Builds the Verilator model of each configuration of lanes_sweep (default
+# "2 4 8 16", see config/), runs benchmark.sh ci on it (all the apps, or $app
+# only) with a shared database, and writes the parallel efficiency of every
+# kernel and size to scaling.md (scripts/scaling_report.py).
+# Set vlen_per_lane_sweep to also sweep the VLEN, in bits per lane (default: the
+# 1024 of the configurations), e.g. vlen_per_lane_sweep="512 1024 2048".
+# When this script is called, CLANG_PATH should point to the clang directory
+# used to verilate the design.
+
+# Useful dirs
+script=$( cd -- "$( dirname -- "${BASH_SOURCE[0]}" )" &> /dev/null && pwd )
+root=${script}/..
+hardware=$root/hardware
+
+python=python3
+lanes_sweep=${lanes_sweep:-2 4 8 16}
+vlen_per_lane_sweep=${vlen_per_lane_sweep:-1024}
+results_db=${results_db:-$root/scaling_results.jsonl}
+report=${report:-$root/scaling.md}
+
+# Move to root directory
+cd $root
+
+for v in ${vlen_per_lane_sweep}
+do
+  for n in ${lanes_sweep}
+  do
+    vlen=$(( n * v ))
+    echo "Benchmarking ${n} lanes, VLEN ${vlen}"
+    config=${n}_lanes vlen=${vlen} CLANG_PATH=${CLANG_PATH} make -B -C $hardware verilate || exit
+    config=${n}_lanes vlen=${vlen} results_db=${results_db} $script/benchmark.sh ci $1 || exit
+  done
+done
+
+${python} $script/scaling_report.py -o ${report} ${results_db} || exit
+echo "Scaling report written to ${report}"
@@ -0,0 +1,141 @@
+#!/usr/bin/env python3
+# Copyright 2022 ETH Zurich and University of Bologna.
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+# Scaling report of the lane configurations measured by benchmark.sh
+# (scripts/scaling.sh measures all of them). For every kernel and problem size, it
+# gives the cycles on each number of lanes and the parallel efficiency, i.e., the
+# speedup wrt the smallest configuration divided by the ratio of the lanes.
+#
+# The configurations are compared at the same VLEN per lane, as those of config/*.mk
+# (1024 bits per lane), so that a VLEN sweep (vlen_per_lane_sweep of scaling.sh)
+# gives one scaling study per VLEN per lane. The measures in which the efficiency
+# falls below the threshold are listed first, worst first, with a hint of the
+# cause taken from the performance counters of the run:
+#   memory:     the AXI R or W channel of the VLSU is busy in most cycles
+#   inter-lane: the slide unit, which also moves the operands of the reductions
+#               across the lanes, is the most utilized unit
+#   starved:    no unit is busy in most cycles, i.e., Ara waits for CVA6 (scalar
+#               code, issue rate) or for the hazards between its instructions
+#   <unit>:     the most utilized unit otherwise
+#
+# Usage: scaling_report.py [-t THRESHOLD] [-o report.md] DB [kernel ...]
+
+import argparse
+import collections
+import os
+import sys
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+import benchmark_db
+import bottleneck_report
+
+# Fields that identify a measure across the configurations
+GROUP = [k for k in benchmark_db.KEY if k not in ('config', 'vlen')]
+
+def hint(e):
+  cnts = e.get('perf_cnt')
+  cycles = e['hw_cycles']
+  if not cnts or not cycles:
+    return '-'
+  units = bottleneck_report.UNITS
+  unit = max(units, key=lambda u: cnts.get(units[u], 0))
+  busy = cnts.get(units[unit], 0) / cycles
+  if unit.startswith('AXI') and busy > 0.8:
+    return 'memory ({} {:.0%})'.format(unit, busy)
+  if unit == 'SLDU':
+    return 'inter-lane (SLDU {:.0%})'.format(busy)
+  if busy < 0.5:
+    return 'starved ({} {:.0%})'.format(unit, busy)
+  return '{} ({:.0%})'.format(unit, busy)
+
+def groups(measures, kernels):
+  # {(vlen per lane, group key): {nr_lanes: measure}}
+  out = collections.defaultdict(dict)
+  for e in measures.values():
+    if e['ideal'] or (kernels and e['kernel'] not in kernels) or not e.get('hw_cycles'):
+      continue
+    key = (e['vlen'] // e['nr_lanes'],) + tuple(e.get(k) for k in GROUP)
+    out[key][e['nr_lanes']] = e
+  return {k: v for k, v in out.items() if len(v) > 1}
+
+def efficiency(by_lanes):
+  # {nr_lanes: efficiency} wrt the smallest configuration
+  base = min(by_lanes)
+  base_cycles = by_lanes[base]['hw_cycles']
+  return {n: base_cycles / e['hw_cycles'] / (n / base) for n, e in by_lanes.items()}
+
+def measure_name(key):
+  e = dict(zip(['vlen_per_lane'] + GROUP, key))
+  name = '{} {}'.format(e['kernel'], e['args'])
+  for k in ['sew', 'mem', 'nr_vinsn', 'queues']:
+    if e.get(k) is not None:
+      name += ' {} {}'.format(k, e[k])
+  return name
+
+def report(grouped, threshold):
+  out = []
+  lanes = sorted({n for g in grouped.values() for n in g})
+  collapses = []
+  for vlen_per_lane in sorted({k[0] for k in grouped}):
+    keys = sorted((k for k in grouped if k[0] == vlen_per_lane), key=lambda k: (k[1], str(k)))
+    out.append('## VLEN of {} bits per lane\n'.format(vlen_per_lane))
+    rows = []
+    for key in keys:
+      by_lanes = grouped[key]
+      eff = efficiency(by_lanes)
+      row = [measure_name(key)]
+      row += [str(by_lanes[n]['hw_cycles']) if n in by_lanes else '-' for n in lanes]
+      row += ['{:.0%}'.format(eff[n]) if n in eff else '-' for n in lanes]
+      rows.append(row)
+      for n, x in eff.items():
+        if x < threshold:
+          collapses.append((x, measure_name(key), vlen_per_lane, min(by_lanes), n, hint(by_lanes[n])))
+    header = ['measure'] + ['cycles {}L'.format(n) for n in lanes] + ['eff. {}L'.format(n) for n in lanes]
+    out.append(bottleneck_report.table(header, rows) + '\n')
+
+  text = ['# Scaling collapses\n']
+  if collapses:
+    text.append('Efficiency below {:.0%}, worst first.\n'.format(threshold))
+    rows = [[name, str(vpl), '{} -> {}'.format(base, n), '{:.0%}'.format(x), h]
+            for x, name, vpl, base, n, h in sorted(collapses)]
+    text.append(bottleneck_report.table(['measure', 'VLEN/lane', 'lanes', 'efficiency', 'hint'], rows) + '\n')
+  else:
+    text.append('No efficiency below {:.0%}.\n'.format(threshold))
+  return '\n'.join(text + out)
+
+def main():
+  parser = argparse.ArgumentParser(description='Lane scaling efficiency report of benchmark.sh.')
+  parser.add_argument('db', help='database of the results (JSON lines)')
+  parser.add_argument('kernels', nargs='*', help='kernels to report (default: all the measured ones)')
+  parser.add_argument('-t', '--threshold', type=float, default=0.5,
+                      help='efficiency below which the scaling collapses (default: 0.5)')
+  parser.add_argument('-o', '--output', default=None, help='output Markdown file (default: stdout)')
+  args = parser.parse_args()
+
+  grouped = groups(benchmark_db.latest(benchmark_db.load(args.db), None), args.kernels)
+  if not grouped:
+    sys.exit('Error: no measure on more than one lane configuration')
+  text = report(grouped, args.threshold)
+
+  if args.output:
+    with open(args.output, 'w') as f:
+      f.write(text)
+  else:
+    print(text)
+
+if __name__ == '__main__':
+  main()
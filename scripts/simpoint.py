@@ -0,0 +1,316 @@
+#!/usr/bin/env python3
+# Copyright 2022 ETH Zurich and University of Bologna.
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+# SimPoint-style sampled simulation of the long workloads.
+#
+# The modified Spike profiles an Ara binary (make -C apps simpoint/<app>.bbv):
+# every interval of N instructions gets a vector of the instructions executed
+# in each basic block, and of the elements (vl) processed by each vector
+# instruction. Then:
+#
+# pick:     projects the vectors to a few random dimensions, clusters them
+#           with k-means, chooses k with the BIC, and picks some intervals of
+#           each cluster.
+# run:      simulates each picked interval on the Verilator model. Spike
+#           fast-forwards the program to W instructions before the interval
+#           (bin/<app>.at<S>.ffwd), the RTL warms its caches on those W
+#           instructions, and measures the cycles of the N ones of the interval.
+# estimate: extrapolates the cycles of the whole program from the cycles per
+#           instruction of each cluster, with a confidence interval from the
+#           spread within the clusters.
+#
+# Usage: simpoint.py pick BBV [-o points.json] [--max-k K] [--samples M]
+#        simpoint.py run points.json --app APP [-c config] [--warmup W] [-j jobs]
+#                    [-o samples.json]
+#        simpoint.py estimate points.json samples.json [--full CYCLES]
+
+import argparse
+import concurrent.futures
+import json
+import math
+import os
+import random
+import re
+import shutil
+import sys
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+import regression
+
+APPS_DIR = regression.APPS_DIR
+HW_DIR = regression.HW_DIR
+
+SAMPLE_CYCLES = re.compile(r'\[sample-cycles\]:\s*(\d+)')
+SAMPLE_INSNS = re.compile(r'\[sample-insns\]:\s*(\d+)')
+
+# SimPoint 3.0 defaults
+PROJ_DIMS = 15
+BIC_THRESHOLD = 0.9
+
+def read_bbv(path):
+  # Interval length, sparse vectors {dim: count}, and instructions of the program
+  interval, insns, vectors = None, None, []
+  with open(path) as f:
+    for line in f:
+      if line.startswith('# interval'):
+        interval = int(line.split()[2])
+      elif line.startswith('# insns'):
+        insns = int(line.split()[2])
+      elif line.startswith('T'):
+        v = {}
+        for field in line[1:].split():
+          _, dim, cnt = field.split(':')
+          v[int(dim)] = int(cnt)
+        vectors.append(v)
+  if interval is None or not vectors:
+    sys.exit('Error: ' + path + ' is not a BBV of the modified Spike')
+  if insns is None:
+    # The profile did not reach the end of the program
+    insns = interval * len(vectors)
+  return interval, insns, vectors
+
+def project(vectors, dims, rng):
+  # Normalize each vector to a total of 1, then project it to dims random
+  # dimensions in [-1, 1]
+  proj = {}
+  points = []
+  for v in vectors:
+    total = float(sum(v.values())) or 1.0
+    p = [0.0] * dims
+    for dim, cnt in v.items():
+      if dim not in proj:
+        proj[dim] = [rng.uniform(-1, 1) for _ in range(dims)]
+      w = cnt / total
+      for j in range(dims):
+        p[j] += w * proj[dim][j]
+    points.append(p)
+  return points
+
+def dist2(a, b):
+  return sum((x - y) * (x - y) for x, y in zip(a, b))
+
+def kmeans(points, k, rng, iters=100):
+  # k-means++ seeding, then Lloyd's iterations
+  centers = [list(rng.choice(points))]
+  while len(centers) < k:
+    d = [min(dist2(p, c) for c in centers) for p in points]
+    total = sum(d)
+    if total == 0:
+      break
+    r = rng.uniform(0, total)
+    for p, dp in zip(points, d):
+      r -= dp
+      if r <= 0:
+        centers.append(list(p))
+        break
+  labels = [0] * len(points)
+  for _ in range(iters):
+    new = [min(range(len(centers)), key=lambda c: dist2(p, centers[c])) for p in points]
+    if new == labels and _ > 0:
+      break
+    labels = new
+    for c in range(len(centers)):
+      members = [p for p, l in zip(points, labels) if l == c]
+      if members:
+        centers[c] = [sum(x) / len(members) for x in zip(*members)]
+  return labels, centers
+
+def bic(points, labels, centers):
+  # Bayesian information criterion of a clustering (Pelleg and Moore), as in SimPoint
+  r, m, k = len(points), len(points[0]), len(centers)
+  if r <= k:
+    return -math.inf
+  var = sum(dist2(p, centers[l]) for p, l in zip(points, labels)) / (m * (r - k))
+  var = max(var, 1e-12)
+  loglik = 0.0
+  for c in range(k):
+    rc = labels.count(c)
+    if rc == 0:
+      continue
+    loglik += rc * math.log(rc) - rc * math.log(r) - rc / 2 * math.log(2 * math.pi) - \
+              rc * m / 2 * math.log(var) - (rc - k) / 2
+  params = (k - 1) + m * k + 1
+  return loglik - params / 2 * math.log(r)
+
+def pick(opts):
+  rng = random.Random(opts.seed)
+  interval, insns, vectors = read_bbv(opts.bbv)
+  points = project(vectors, PROJ_DIMS, rng)
+
+  # The smallest k whose score reaches BIC_THRESHOLD of the range of the scores
+  runs = []
+  for k in range(1, min(opts.max_k, len(points)) + 1):
+    labels, centers = kmeans(points, k, rng)
+    runs.append((bic(points, labels, centers), labels, centers))
+  scores = [s for s, _, _ in runs if s != -math.inf]
+  lo, hi = min(scores), max(scores)
+  score, labels, centers = next(r for r in runs if r[0] >= lo + BIC_THRESHOLD * (hi - lo))
+
+  clusters = []
+  for c in range(len(centers)):
+    members = [i for i, l in enumerate(labels) if l == c]
+    if not members:
+      continue
+    # The interval nearest to the centroid, as in SimPoint, and some random ones
+    # for the error bars
+    best = min(members, key=lambda i: dist2(points[i], centers[c]))
+    others = [i for i in members if i != best]
+    samples = [best] + sorted(rng.sample(others, min(opts.samples - 1, len(others))))
+    # The last interval can be shorter
+    size = sum(min(interval, insns - i * interval) for i in members)
+    clusters.append({'intervals': len(members), 'insns': size, 'samples': samples})
+
+  result = {'bbv': os.path.abspath(opts.bbv), 'interval': interval, 'insns': insns,
+            'intervals': len(vectors), 'k': len(clusters), 'bic': score, 'clusters': clusters}
+  with open(opts.output, 'w') as f:
+    json.dump(result, f, indent=2)
+  nsamples = sum(len(c['samples']) for c in clusters)
+  print('{} intervals of {} instructions, {} clusters, {} samples ({:.1%} of the instructions). Points: {}'.format(
+        len(vectors), interval, len(clusters), nsamples, nsamples * interval / insns, opts.output))
+
+def run(opts):
+  with open(opts.points) as f:
+    points = json.load(f)
+  interval = points['interval']
+  opts.outdir = os.path.abspath(opts.outdir)
+  bindir = os.path.join(opts.outdir, opts.config, 'bin')
+  os.makedirs(bindir, exist_ok=True)
+  log = os.path.join(opts.outdir, opts.config, 'build.log')
+  open(log, 'w').close()
+  veril_library = os.path.join(HW_DIR, 'build', 'verilator_' + opts.config)
+  model = os.path.join(veril_library, 'V' + regression.VERIL_TOP)
+  common = ['config=' + opts.config]
+  if not opts.no_build:
+    regression.make(['-C', HW_DIR, 'verilate', 'veril_library=' + veril_library] + common, log)
+
+  # The sample of interval i starts the warm-up at S = i * interval - W. The
+  # intervals too close to the start of the program run from the reset.
+  jobs, samples = [], []
+  for c, cluster in enumerate(points['clusters']):
+    for i in cluster['samples']:
+      start = i * interval - opts.warmup
+      if start <= 0:
+        image, warmup = 'bin/' + opts.app, i * interval
+      else:
+        image, warmup = 'bin/{}.at{}.ffwd'.format(opts.app, start), opts.warmup
+      if not opts.no_build:
+        regression.make(['-C', APPS_DIR, image] + common, log)
+      # Copied aside, for the binary name of the log of regression.simulate
+      binary = os.path.join(bindir, '{}.s{}'.format(opts.app, i))
+      shutil.copy(os.path.join(APPS_DIR, image), binary)
+      jobs.append((opts.config, binary, model,
+                   ['+sample_warmup={}'.format(warmup), '+sample_insns={}'.format(interval)]))
+      samples.append({'cluster': c, 'interval': i, 'warmup': warmup})
+
+  with concurrent.futures.ThreadPoolExecutor(max_workers=opts.jobs) as pool:
+    results = list(pool.map(lambda job: regression.simulate(job, opts), jobs))
+
+  failed = 0
+  for s, r in zip(samples, results):
+    with open(r['log'], errors='replace') as f:
+      out = f.read()
+    cycles, insns = SAMPLE_CYCLES.findall(out), SAMPLE_INSNS.findall(out)
+    s['cycles'] = int(cycles[-1]) if cycles else None
+    s['insns'] = int(insns[-1]) if insns else None
+    s['log'] = r['log']
+    if s['cycles'] is None or not s['insns'] or r['status'] == 'TIMEOUT':
+      failed += 1
+      print('Warning: no sample in {}'.format(r['log']))
+    else:
+      print('cluster {:>3} interval {:>6}: {} cycles, {} instructions'.format(
+            s['cluster'], s['interval'], s['cycles'], s['insns']))
+
+  with open(opts.output, 'w') as f:
+    json.dump(samples, f, indent=2)
+  print('{} samples, {} failed. Samples: {}'.format(len(samples), failed, opts.output))
+  sys.exit(1 if failed else 0)
+
+def estimate(opts):
+  with open(opts.points) as f:
+    points = json.load(f)
+  with open(opts.samples) as f:
+    samples = [s for s in json.load(f) if s['cycles'] is not None and s['insns']]
+
+  # Stratified estimate: the clusters are the strata, and the cycles per
+  # instruction of the samples of a cluster stand for all its instructions
+  strata = []
+  for c, cluster in enumerate(points['clusters']):
+    cpi = [s['cycles'] / s['insns'] for s in samples if s['cluster'] == c]
+    if not cpi:
+      sys.exit('Error: no sample of cluster {}'.format(c))
+    mean = sum(cpi) / len(cpi)
+    var = sum((x - mean) ** 2 for x in cpi) / (len(cpi) - 1) if len(cpi) > 1 else None
+    strata.append((cluster, cpi, mean, var))
+
+  # The clusters with a single sample borrow the coefficient of variation of the others
+  cvs = [math.sqrt(v) / m for _, _, m, v in strata if v is not None and m > 0]
+  pooled_cv = sum(cvs) / len(cvs) if cvs else None
+
+  total, variance = 0.0, 0.0
+  for cluster, cpi, mean, var in strata:
+    total += cluster['insns'] * mean
+    if var is None:
+      var = (pooled_cv * mean) ** 2 if pooled_cv is not None else None
+    if var is None or variance is None:
+      variance = None
+      continue
+    # Finite population correction: m of the n intervals of the cluster were simulated
+    n, m = cluster['intervals'], len(cpi)
+    variance += cluster['insns'] ** 2 * var / m * (1 - m / n)
+
+  print('Estimated cycles: {:.0f} ({} instructions, CPI {:.3f})'.format(total, points['insns'], total / points['insns']))
+  if variance is not None:
+    ci = 1.96 * math.sqrt(variance)
+    print('95% confidence interval: +/- {:.0f} cycles ({:.2%})'.format(ci, ci / total))
+  else:
+    print('No confidence interval: every cluster has a single sample, use --samples 2 or more in pick')
+  if opts.full:
+    print('Full simulation: {} cycles, error {:+.2%}'.format(opts.full, total / opts.full - 1))
+
+def main():
+  parser = argparse.ArgumentParser(description='SimPoint-style sampled simulation on the Verilator model.')
+  sub = parser.add_subparsers(dest='cmd', required=True)
+
+  p = sub.add_parser('pick', help='cluster the intervals of a BBV and pick the samples')
+  p.add_argument('bbv', help='BBV of the modified Spike (make -C apps simpoint/<app>.bbv)')
+  p.add_argument('-o', '--output', default='points.json', help='picked samples')
+  p.add_argument('--max-k', type=int, default=10, help='maximum number of clusters')
+  p.add_argument('--samples', type=int, default=2, help='samples per cluster')
+  p.add_argument('--seed', type=int, default=1, help='seed of the projection and of the clustering')
+
+  p = sub.add_parser('run', help='simulate the picked samples on the Verilator model')
+  p.add_argument('points', help='output of pick')
+  p.add_argument('--app', required=True, help='app of the BBV')
+  p.add_argument('-c', '--config', default=os.environ.get('config', os.environ.get('ARA_CONFIGURATION', 'default')),
+                 help='Ara configuration')
+  p.add_argument('--warmup', type=int, default=100000, help='instructions simulated before each sample')
+  p.add_argument('-j', '--jobs', type=int, default=os.cpu_count(), help='maximum number of parallel simulations')
+  p.add_argument('--no-build', action='store_true', help='reuse the existing model and images')
+  p.add_argument('--timeout', type=int, default=None, help='timeout of each simulation, in seconds')
+  p.add_argument('--outdir', default=os.path.join(HW_DIR, 'build', 'simpoint'), help='output folder')
+  p.add_argument('-o', '--output', default='samples.json', help='cycles of the samples')
+
+  p = sub.add_parser('estimate', help='extrapolate the cycles of the whole program')
+  p.add_argument('points', help='output of pick')
+  p.add_argument('samples', help='output of run')
+  p.add_argument('--full', type=int, default=None, help='cycles of a full simulation, to print the error')
+
+  opts = parser.parse_args()
+  {'pick': pick, 'run': run, 'estimate': estimate}[opts.cmd](opts)
+
+if __name__ == '__main__':
+  main()
@@ -0,0 +1,183 @@
+#!/usr/bin/env python3
+# Copyright 2022 ETH Zurich and University of Bologna.
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+# Latency and throughput tables of the vector instructions.
+# For each configuration, apps/vinsn_bench is built for every SEW and LMUL,
+# and the binaries are simulated in parallel on the Verilator model, as with
+# regression.py. The results are written as:
+#   <prefix>.csv:          config, insn, sew, lmul, vl, latency, cpi
+#   <prefix>_<config>.md:  one table per vl (1 and VLMAX), with the latency
+#                          and the cycles per instruction of each instruction
+#                          (rows) for each SEW and LMUL (columns), and the
+#                          elements per cycle and lane of the widening and
+#                          narrowing instructions at VLMAX, with respect to
+#                          the peak of one 2 * SEW word per cycle and lane
+#
+# Usage: vinsn_table.py [-c config ...] [--sew sew ...] [--lmul lmul ...]
+#                       [-j jobs] [-o prefix]
+
+import argparse
+import collections
+import concurrent.futures
+import csv
+import os
+import re
+import shutil
+import sys
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+import regression
+
+APP = 'vinsn_bench'
+
+VINSN = re.compile(r'\[vinsn\]:\s*(\S+) (\d+) (\d+) (\d+) (\S+) (\S+)')
+VINSN_RATE = re.compile(r'\[vinsn-rate\]:\s*(\S+) (\d+) (\d+) \d+ (\S+) (\S+) (\S+)')
+
+FIELDS = ['config', 'insn', 'sew', 'lmul', 'vl', 'latency', 'cpi']
+
+def prepare(config, opts):
+  # Build the model, and one binary per SEW and LMUL
+  outdir = os.path.join(opts.outdir, config)
+  bindir = os.path.join(outdir, 'bin')
+  veril_library = os.path.join(regression.HW_DIR, 'build', 'verilator_' + config)
+  os.makedirs(bindir, exist_ok=True)
+  log = os.path.join(outdir, 'build.log')
+  open(log, 'w').close()
+
+  common = ['config=' + config]
+  if not opts.no_build:
+    regression.make(['-C', regression.HW_DIR, 'verilate', 'veril_library=' + veril_library] + common, log)
+  jobs = []
+  for sew in opts.sew:
+    for lmul in opts.lmul:
+      binary = os.path.join(bindir, '{}_e{}_m{}'.format(APP, sew, lmul))
+      if not opts.no_build:
+        # The data of the app are generated with its default arguments, which
+        # are overridden on the command line
+        regression.make(['-C', regression.APPS_DIR, 'bin/' + APP,
+                         'def_args_{}={} {}'.format(APP, sew, lmul)] + common, log)
+        shutil.copy(os.path.join(regression.APPS_DIR, 'bin', APP), binary)
+      jobs.append((config, binary, os.path.join(veril_library, 'V' + regression.VERIL_TOP)))
+  return jobs
+
+def parse(result):
+  rows, rates = [], []
+  with open(result['log'], errors='replace') as f:
+    log = f.read()
+  for m in VINSN.finditer(log):
+    lat = float(m.group(5))
+    rows.append({'config': result['config'], 'insn': m.group(1), 'sew': int(m.group(2)),
+                 'lmul': int(m.group(3)), 'vl': int(m.group(4)),
+                 'latency': lat if lat >= 0 else None, 'cpi': float(m.group(6))})
+  for m in VINSN_RATE.finditer(log):
+    chain = float(m.group(5))
+    rates.append({'config': result['config'], 'insn': m.group(1), 'sew': int(m.group(2)),
+                  'lmul': int(m.group(3)), 'stream': float(m.group(4)),
+                  'chain': chain if chain >= 0 else None, 'peak': float(m.group(6))})
+  return rows, rates
+
+def write_tables(rows, rates, prefix):
+  with open(prefix + '.csv', 'w', newline='') as f:
+    writer = csv.DictWriter(f, fieldnames=FIELDS)
+    writer.writeheader()
+    writer.writerows(rows)
+
+  by_config = collections.defaultdict(list)
+  for r in rows:
+    by_config[r['config']].append(r)
+  for config, rs in by_config.items():
+    cols = sorted(set((r['sew'], r['lmul']) for r in rs))
+    # The largest vl of each binary is its VLMAX
+    vlmax = {c: max(r['vl'] for r in rs if (r['sew'], r['lmul']) == c) for c in cols}
+    with open('{}_{}.md'.format(prefix, config), 'w') as f:
+      f.write('# Vector instructions on the {} configuration\n\n'.format(config))
+      f.write('Latency / cycles per instruction, in cycles. The latency is `-` for the instructions '
+              'without a dependent chain.\n')
+      for title, pick in [('vl = 1', lambda c: 1), ('vl = VLMAX', lambda c: vlmax[c])]:
+        cells = collections.defaultdict(dict)
+        for r in rs:
+          c = (r['sew'], r['lmul'])
+          if r['vl'] == pick(c):
+            lat = '-' if r['latency'] is None else '{:.1f}'.format(r['latency'])
+            cells[r['insn']][c] = '{} / {:.1f}'.format(lat, r['cpi'])
+        f.write('\n## {}\n\n'.format(title))
+        f.write('| insn | ' + ' | '.join('e{} m{}'.format(*c) for c in cols) + ' |\n')
+        f.write('|---' * (len(cols) + 1) + '|\n')
+        # The instructions in the order of FUNCTIONALITIES.md, as generated
+        for insn in dict.fromkeys(r['insn'] for r in rs):
+          f.write('| {} | '.format(insn) + ' | '.join(cells[insn].get(c, '') for c in cols) + ' |\n')
+
+      # Fraction of the peak of the stream / of the chain
+      rs = [r for r in rates if r['config'] == config]
+      if rs:
+        cols = sorted(set((r['sew'], r['lmul']) for r in rs))
+        cells = collections.defaultdict(dict)
+        for r in rs:
+          chain = '-' if r['chain'] is None else '{:.0%}'.format(r['chain'] / r['peak'])
+          cells[r['insn']][(r['sew'], r['lmul'])] = '{:.0%} / {}'.format(r['stream'] / r['peak'], chain)
+        f.write('\n## Widening and narrowing, vl = VLMAX\n\n')
+        f.write('Elements per cycle and lane of the stream / of the chain, with respect to one '
+                '2 * SEW word per cycle and lane.\n\n')
+        f.write('| insn | ' + ' | '.join('e{} m{}'.format(*c) for c in cols) + ' |\n')
+        f.write('|---' * (len(cols) + 1) + '|\n')
+        for insn in dict.fromkeys(r['insn'] for r in rs):
+          f.write('| {} | '.format(insn) + ' | '.join(cells[insn].get(c, '') for c in cols) + ' |\n')
+    print('Table: {}_{}.md'.format(prefix, config))
+
+def main():
+  parser = argparse.ArgumentParser(description='Measure the latency and throughput of the vector instructions.')
+  parser.add_argument('-c', '--config', nargs='+',
+                      default=[os.environ.get('config', os.environ.get('ARA_CONFIGURATION', 'default'))],
+                      help='Ara configurations to simulate')
+  parser.add_argument('--sew', nargs='+', type=int, default=[8, 16, 32, 64], help='element widths')
+  parser.add_argument('--lmul', nargs='+', type=int, default=[1, 2, 4, 8], help='register group multipliers')
+  parser.add_argument('-j', '--jobs', type=int, default=os.cpu_count(), help='maximum number of parallel simulations')
+  parser.add_argument('--no-build', action='store_true', help='reuse the existing model and binaries')
+  parser.add_argument('--timeout', type=int, default=None, help='timeout of each simulation, in seconds')
+  parser.add_argument('--outdir', default=os.path.join(regression.HW_DIR, 'build', APP), help='output folder')
+  parser.add_argument('-o', '--prefix', default='vinsn', help='prefix of the CSV and Markdown tables')
+  opts = parser.parse_args()
+  opts.outdir = os.path.abspath(opts.outdir)
+
+  # The binaries of a configuration are built one after the other, since they
+  # share apps/bin
+  jobs = []
+  for config in opts.config:
+    jobs += prepare(config, opts)
+
+  results = []
+  with concurrent.futures.ThreadPoolExecutor(max_workers=max(1, opts.jobs)) as pool:
+    futures = [pool.submit(regression.simulate, job, opts) for job in jobs]
+    for fut in concurrent.futures.as_completed(futures):
+      r = fut.result()
+      print('[{}] {:<8} {}/{}'.format(len(results) + 1, r['status'], r['config'], r['binary']))
+      results.append(r)
+
+  rows, rates = [], []
+  for r in sorted(results, key=lambda r: (r['config'], r['binary'])):
+    res_rows, res_rates = parse(r)
+    rows += res_rows
+    rates += res_rates
+  write_tables(rows, rates, opts.prefix)
+
+  failed = [r for r in results if r['status'] != 'PASS']
+  for r in failed:
+    print('  {} {}/{}: {}'.format(r['status'], r['config'], r['binary'], r['log']))
+  sys.exit(1 if failed else 0)
+
+if __name__ == '__main__':
+  main()
@@ -0,0 +1,143 @@
+#!/usr/bin/env python3
+# Copyright 2022 ETH Zurich and University of Bologna.
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+# Convert the vector instruction lifecycle trace (hardware/tb/dpi/vinsn_trace.cc)
+# into a Chrome/Perfetto trace (JSON), to be opened with ui.perfetto.dev or
+# chrome://tracing. One time unit of the trace is one clock cycle.
+#
+# Tracks:
+#   sequencer: from the dispatch of an instruction to its issue. The hazards
+#              that the instruction had at issue are in its arguments.
+#   lane N:    from the lane sequencer accepting the instruction to its completion
+#   VLDU, ...: from the issue of the instruction to its completion
+#
+# Usage: vinsn_trace_to_perfetto.py trace.vinsn [-o trace.json]
+
+import argparse
+import collections
+import json
+import os
+import re
+import struct
+import sys
+
+MAGIC = b'ARVT'
+VERSION = 2
+HEADER = struct.Struct('<4sIIIQ')
+RECORD = struct.Struct('<QBBBBIIIII')
+
+# Keep in sync with ara_vinsn_tracer.sv
+EV_DISPATCH, EV_ISSUE, EV_START, EV_DONE = range(4)
+# Keep in sync with vfu_offset_e in ara_pkg.sv
+UNIT_PES = ['VLDU', 'VSTU', 'MASKU', 'SLDU']
+
+DEFAULT_PKG = os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', 'hardware', 'include', 'ara_pkg.sv')
+
+def op_names(pkg):
+  # Parse the ara_op_e enumeration, to name the instructions
+  try:
+    with open(pkg) as f:
+      src = f.read()
+  except OSError:
+    return []
+  m = re.search(r'typedef\s+enum\s+logic\s*\[7:0\]\s*\{(.*?)\}\s*ara_op_e', src, re.S)
+  if not m:
+    return []
+  body = re.sub(r'//[^\n]*', '', m.group(1))
+  return [n.strip() for n in body.split(',') if n.strip()]
+
+def hazard_vids(mask):
+  return [v for v in range(mask.bit_length()) if (mask >> v) & 1]
+
+def main():
+  parser = argparse.ArgumentParser(description='Convert an Ara vinsn trace to a Chrome/Perfetto trace.')
+  parser.add_argument('trace', help='binary trace file')
+  parser.add_argument('-o', '--output', default=None, help='output JSON file (default: <trace>.json)')
+  parser.add_argument('--pkg', default=DEFAULT_PKG, help='ara_pkg.sv, to name the operations')
+  args = parser.parse_args()
+
+  with open(args.trace, 'rb') as f:
+    raw = f.read()
+  if len(raw) < HEADER.size:
+    sys.exit('Error: {} is too short.'.format(args.trace))
+  magic, version, nr_lanes, _, dropped = HEADER.unpack_from(raw)
+  if magic != MAGIC or version != VERSION:
+    sys.exit('Error: {} is not a vinsn trace (version {}).'.format(args.trace, VERSION))
+  if dropped:
+    print('Warning: the {} oldest events were dropped by the ring buffer.'.format(dropped))
+
+  names = op_names(args.pkg)
+  def op_name(op):
+    return names[op] if op < len(names) else 'op{}'.format(op)
+
+  def pe_name(pe):
+    return 'lane {}'.format(pe) if pe < nr_lanes else UNIT_PES[pe - nr_lanes]
+
+  events = []
+  # Track names
+  events.append({'ph': 'M', 'pid': 0, 'name': 'process_name', 'args': {'name': 'Ara'}})
+  events.append({'ph': 'M', 'pid': 0, 'tid': 0, 'name': 'thread_name', 'args': {'name': 'sequencer'}})
+  for pe in range(nr_lanes + len(UNIT_PES)):
+    events.append({'ph': 'M', 'pid': 0, 'tid': pe + 1, 'name': 'thread_name', 'args': {'name': pe_name(pe)}})
+
+  dispatched = collections.deque()
+  # State of the instruction currently running with a given vid
+  running = {}
+
+  body = raw[HEADER.size:]
+  for offset in range(0, len(body) - RECORD.size + 1, RECORD.size):
+    cycle, kind, vid, pe, op, hz_vs1, hz_vs2, hz_vm, hz_vd, _ = RECORD.unpack_from(body, offset)
+
+    if kind == EV_DISPATCH:
+      dispatched.append((cycle, op))
+
+    elif kind == EV_ISSUE:
+      # The instructions are issued in order
+      dispatch = dispatched.popleft()[0] if dispatched else cycle
+      hazards = {
+        'vs1': hazard_vids(hz_vs1),
+        'vs2': hazard_vids(hz_vs2),
+        'vm': hazard_vids(hz_vm),
+        'vd': hazard_vids(hz_vd),
+      }
+      running[vid] = {'op': op_name(op), 'issue': cycle, 'start': {}}
+      events.append({'ph': 'X', 'pid': 0, 'tid': 0, 'name': op_name(op), 'ts': dispatch,
+                     'dur': max(cycle - dispatch, 1),
+                     'args': dict(vid=vid, stall_cycles=cycle - dispatch,
+                                  **{'hazard_' + k: v for k, v in hazards.items() if v})})
+
+    elif kind == EV_START:
+      if vid in running:
+        running[vid]['start'][pe] = cycle
+
+    elif kind == EV_DONE:
+      insn = running.get(vid)
+      if insn is None:
+        continue
+      start = insn['start'].get(pe, insn['issue'])
+      events.append({'ph': 'X', 'pid': 0, 'tid': pe + 1, 'name': insn['op'], 'ts': start,
+                     'dur': max(cycle - start, 1),
+                     'args': {'vid': vid, 'issue': insn['issue'], 'wait_cycles': start - insn['issue']}})
+
+  output = args.output or os.path.splitext(args.trace)[0] + '.json'
+  with open(output, 'w') as f:
+    json.dump({'traceEvents': events, 'displayTimeUnit': 'ns',
+               'otherData': {'time_unit': 'cycle', 'nr_lanes': nr_lanes}}, f)
+  print('Written {} events to {}'.format(len(events), output))
+
+if __name__ == '__main__':
+  main()
@@ -0,0 +1,213 @@
+#!/usr/bin/env python3
+# Copyright 2022 ETH Zurich and University of Bologna.
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+# Vector-length utilization of a binary vtrace (version 3, with the pcs, see
+# hardware/tb/dpi/vtrace_source.cc). The vl and the vtype of every vector
+# instruction are reconstructed from the vset{i}vl{i} instructions and their
+# scalar operands, and the report breaks down vl / VLMAX:
+#  - per class of instruction, as a histogram in eighths of VLMAX
+#  - per pc, for the instructions executed the most, symbolized with the
+#    disassembly of the binary if given
+#  - per strip-mined loop, i.e., per vset{i}vl{i} that starts the strips: the
+#    share of the vector instructions executed in the strips with vl < VLMAX,
+#    flagged when the tails (or the short rows, if no strip reaches VLMAX)
+#    dominate
+#
+# The whole-register moves and memory operations, and the moves to and from
+# the scalar registers, do not depend on vl and are not counted.
+#
+# Usage: vl_report.py [-c config | --vlen VLEN] [-d DUMP] [-n TOP] VTRACE
+
+import argparse
+import collections
+import os
+import struct
+import sys
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+import autotune
+import pc_report
+
+BINS = 8
+# Same format as hardware/tb/dpi/vtrace_source.cc
+RECORD = struct.Struct('<IQQIQ')
+
+def read_vtrace(path):
+  # Records (insn, rs1, rs2, pc)
+  with open(path, 'rb') as f:
+    data = f.read()
+  if len(data) < 16 or data[:4] != b'VTRC':
+    sys.exit('Error: ' + path + ' is not a binary vtrace')
+  version, nr_insn = struct.unpack_from('<IQ', data, 4)
+  if version < 3:
+    sys.exit('Error: ' + path + ' has no pcs (version {}), regenerate it with the modified Spike'.format(version))
+  if 16 + nr_insn * RECORD.size > len(data):
+    sys.exit('Error: ' + path + ' is truncated')
+  for insn, rs1, rs2, _, pc in RECORD.iter_unpack(data[16:16 + nr_insn * RECORD.size]):
+    yield insn, rs1, rs2, pc
+
+def vlmax(vtype, vlen):
+  # 0 if vill or reserved
+  vlmul, vsew = vtype & 7, (vtype >> 3) & 7
+  if vtype >> 63 or vlmul == 4 or vsew > 3:
+    return 0
+  lmul = 2 ** vlmul if vlmul < 4 else 2 ** (vlmul - 8)
+  return int(vlen * lmul) >> (3 + vsew)
+
+def classify(insn):
+  # Class of a vector instruction, None if it does not depend on vl
+  opcode, funct3, funct6 = insn & 0x7f, (insn >> 12) & 7, insn >> 26
+  vs1 = (insn >> 15) & 0x1f
+  if opcode in (0x07, 0x27):
+    kind = 'load' if opcode == 0x07 else 'store'
+    mop = funct6 & 3
+    if mop == 0 and (insn >> 20) & 0x1f == 0b01000:
+      return None
+    return kind + ['', '-indexed', '-strided', '-indexed'][mop]
+  if funct3 == 7:
+    return 'vset'
+  if funct3 == 3 and funct6 == 0b100111:
+    # vmv<nr>r.v
+    return None
+  if funct6 == 0b010000 and (funct3 in (5, 6) or (funct3 in (1, 2) and vs1 == 0)):
+    # vmv.x.s, vfmv.f.s, vmv.s.x, vfmv.s.f
+    return None
+  if (funct3 == 2 and funct6 < 0b001000) or \
+     (funct3 == 1 and funct6 in (0b000001, 0b000011, 0b000101, 0b000111, 0b110001, 0b110011)) or \
+     (funct3 == 0 and funct6 in (0b110000, 0b110001)):
+    return 'reduction'
+  if funct6 in (0b001110, 0b001111) or (funct6 == 0b001100 and funct3 in (0, 3, 4)) or \
+     (funct6 == 0b010111 and funct3 == 2):
+    return 'permutation'
+  return 'fp' if funct3 in (1, 5) else 'int'
+
+class Strip:
+  # Vector instructions between two vset{i}vl{i} that set a new vl
+  def __init__(self, site, vl, vlmax):
+    self.site, self.vl, self.vlmax, self.insns = site, vl, vlmax, 0
+
+def analyze(records, vlen):
+  vl, vtype, strip = 0, 1 << 63, None
+  by_class = collections.defaultdict(lambda: [0] * BINS)
+  by_pc = collections.defaultdict(lambda: [0, 0.0, 0])
+  sites = collections.defaultdict(lambda: {'strips': 0, 'tails': 0, 'insns': 0, 'tail_insns': 0,
+                                           'max_vl': 0, 'vlmax': 0})
+  skipped = 0
+
+  def close(strip):
+    if strip is not None:
+      s = sites[strip.site]
+      s['strips'] += 1
+      s['insns'] += strip.insns
+      s['max_vl'] = max(s['max_vl'], strip.vl)
+      s['vlmax'] = max(s['vlmax'], strip.vlmax)
+      if strip.vl < strip.vlmax:
+        s['tails'] += 1
+        s['tail_insns'] += strip.insns
+
+  for insn, rs1, rs2, pc in records:
+    cls = classify(insn)
+    if cls == 'vset':
+      rd, rs1f = (insn >> 7) & 0x1f, (insn >> 15) & 0x1f
+      if insn >> 30 == 3:
+        # vsetivli
+        vtype, avl = (insn >> 20) & 0x3ff, rs1f
+      else:
+        vtype = rs2 if insn >> 31 else (insn >> 20) & 0x7ff
+        avl = rs1 if rs1f else (None if rd == 0 else 1 << 64)
+      vmax = vlmax(vtype, vlen)
+      if avl is None:
+        # Only the vtype changes, within the same strip
+        vl = min(vl, vmax)
+        continue
+      vl = min(avl, vmax)
+      close(strip)
+      strip = Strip(pc, vl, vmax)
+      continue
+    vmax = vlmax(vtype, vlen)
+    if cls is None or not vmax:
+      skipped += 1
+      continue
+    util = vl / vmax
+    by_class[cls][min(BINS - 1, max(0, -(-vl * BINS // vmax) - 1))] += 1
+    p = by_pc[pc]
+    p[0] += 1
+    p[1] += util
+    p[2] += vl < vmax
+    if strip is not None:
+      strip.insns += 1
+  close(strip)
+  return by_class, by_pc, sites, skipped
+
+def report(by_class, by_pc, sites, skipped, insns, top, threshold):
+  total = sum(sum(h) for h in by_class.values())
+  if not total:
+    return 'No vector instructions.\n'
+
+  def pct(x, n=total):
+    return '{:.1%}'.format(x / n) if n else '-'
+
+  out = ['Vector instructions: {} ({} not depending on vl)'.format(total, skipped), '']
+  out.append('| class | insns | ' + ' | '.join('<={}/{}'.format(b + 1, BINS) for b in range(BINS)) + ' |')
+  out.append('|---|---|' + '---|' * BINS)
+  for cls, h in sorted(by_class.items(), key=lambda x: -sum(x[1])):
+    n = sum(h)
+    out.append('| {} | {} | '.format(cls, pct(n)) + ' | '.join(pct(x, n) for x in h) + ' |')
+
+  out.append('')
+  out.append('| insns | function | pc | instruction | vl/VLMAX | vl < VLMAX |')
+  out.append('|---|---|---|---|---|---|')
+  for pc, (n, util, short) in sorted(by_pc.items(), key=lambda x: -x[1][0])[:top]:
+    function, insn = insns.get(pc, ('[unknown]', ''))
+    out.append('| {} | {} | {:x} | `{}` | {:.1%} | {} |'.format(pct(n), function, pc, insn, util / n, pct(short, n)))
+
+  out.append('')
+  out.append('| insns | function | vsetvl pc | strips | tails | insns in tails | max vl | VLMAX | |')
+  out.append('|---|---|---|---|---|---|---|---|---|')
+  for pc, s in sorted(sites.items(), key=lambda x: -x[1]['insns'])[:top]:
+    if not s['insns']:
+      continue
+    function, _ = insns.get(pc, ('[unknown]', ''))
+    flag = ''
+    if s['max_vl'] < s['vlmax']:
+      flag = 'short vectors'
+    elif s['tail_insns'] >= threshold * s['insns']:
+      flag = 'tail-dominated'
+    out.append('| {} | {} | {:x} | {} | {} | {} | {} | {} | {} |'.format(
+               pct(s['insns']), function, pc, s['strips'], s['tails'], pct(s['tail_insns'], s['insns']),
+               s['max_vl'], s['vlmax'], flag))
+  return '\n'.join(out) + '\n'
+
+def main():
+  parser = argparse.ArgumentParser(description='Vector-length utilization of a binary vtrace.')
+  parser.add_argument('vtrace', help='binary vtrace of the modified Spike (apps/ideal_dispatcher/vtrace/<app>.vtrace)')
+  parser.add_argument('-c', '--config', default=os.environ.get('config', os.environ.get('ARA_CONFIGURATION', 'default')),
+                      help='Ara configuration, for its vlen')
+  parser.add_argument('--vlen', type=int, default=None, help='VLEN in bits (default: the one of the configuration)')
+  parser.add_argument('-d', '--dump', default=None, help='disassembly of the binary (apps/bin/<app>.spike.dump)')
+  parser.add_argument('-n', '--top', type=int, default=20, help='pcs and loops listed (default: 20)')
+  parser.add_argument('--tail-threshold', type=float, default=0.25,
+                      help='share of the instructions of a loop in its tails to flag it (default: 0.25)')
+  args = parser.parse_args()
+
+  vlen = args.vlen or autotune.config_params(args.config)[1]
+  insns = pc_report.read_dump(args.dump) if args.dump else {}
+  result = analyze(read_vtrace(args.vtrace), vlen)
+  sys.stdout.write(report(*result, insns, args.top, args.tail_threshold))
+
+if __name__ == '__main__':
+  main()